@@ -106,6 +106,20 @@ CLI.prototype.benchmarks = function() {
   return paths;
 };
 
+// Passes --cpu-set and --perf-events to the benchmark processes, see
+// _perf-counters.js.
+CLI.prototype.setupIsolation = function() {
+  if (this.optional['cpu-set'] !== undefined)
+    process.env.NODE_BENCHMARK_CPUSET = this.optional['cpu-set'];
+  if (this.optional['perf-events'] !== undefined)
+    process.env.NODE_BENCHMARK_PERF_EVENTS = this.optional['perf-events'];
+};
+
+CLI.prototype.perfEvents = function() {
+  const events = this.optional['perf-events'];
+  return events ? events.split(',') : [];
+};
+
 CLI.prototype.shouldSkip = function(scripts) {
   const filters = this.optional.filter || [];
   const excludes = this.optional.exclude || [];
@@ -17,6 +17,7 @@ class AutocannonBenchmarker {
       process.platform === 'win32' ? 'autocannon.cmd' : 'autocannon';
     const result = child_process.spawnSync(this.executable, ['-h']);
     this.present = !(result.error && result.error.code === 'ENOENT');
+    this.supportsPipelining = true;
   }
 
   create(options) {
@@ -26,6 +27,9 @@ class AutocannonBenchmarker {
       '-j',
       '-n',
     ];
+    if (options.pipelining > 1) {
+      args.push('-p', options.pipelining);
+    }
     for (const field in options.headers) {
       args.push('-H', `${field}=${options.headers[field]}`);
     }
@@ -47,6 +51,19 @@ class AutocannonBenchmarker {
     }
     return result.requests.average;
   }
+
+  processLatency(output) {
+    let result;
+    try {
+      result = JSON.parse(output);
+    } catch {
+      return undefined;
+    }
+    if (!result || !result.latency) {
+      return undefined;
+    }
+    return { p50: result.latency.p50, p99: result.latency.p99 };
+  }
 }
 
 class WrkBenchmarker {
@@ -66,6 +83,7 @@ class WrkBenchmarker {
       '-d', duration,
       '-c', options.connections,
       '-t', Math.min(options.connections, require('os').cpus().length || 8),
+      '--latency',
       `${scheme}://127.0.0.1:${options.port}${options.path}`,
     ];
     for (const field in options.headers) {
@@ -84,6 +102,22 @@ class WrkBenchmarker {
     }
     return throughput;
   }
+
+  processLatency(output) {
+    // Lines of the latency distribution look like `     99%    1.20ms`.
+    const units = { us: 1e-3, ms: 1, s: 1e3 };
+    const percentile = (p) => {
+      const re = new RegExp(`^\\s+${p}%\\s+([0-9.]+)(us|ms|s)\\s*$`, 'm');
+      const match = output.match(re);
+      return match ? match[1] * units[match[2]] : undefined;
+    };
+    const p50 = percentile(50);
+    const p99 = percentile(99);
+    if (p50 === undefined || p99 === undefined) {
+      return undefined;
+    }
+    return { p50, p99 };
+  }
 }
 
 /**
@@ -194,6 +228,10 @@ http_benchmarkers.forEach((benchmarker) => {
   if (!exports.default_http_benchmarker && benchmarker.present) {
     exports.default_http_benchmarker = benchmarker.name;
   }
+  if (!exports.default_pipelining_http_benchmarker && benchmarker.present &&
+      benchmarker.supportsPipelining) {
+    exports.default_pipelining_http_benchmarker = benchmarker.name;
+  }
 });
 
 exports.run = function(options, callback) {
@@ -221,6 +259,11 @@ exports.run = function(options, callback) {
                        'is  not installed'));
     return;
   }
+  if (options.pipelining > 1 && !benchmarker.supportsPipelining) {
+    callback(new Error(`Requested benchmarker '${options.benchmarker}' ` +
+                       'does not support pipelining'));
+    return;
+  }
 
   const benchmarker_start = process.hrtime();
 
@@ -250,7 +293,10 @@ exports.run = function(options, callback) {
       return;
     }
 
-    callback(null, code, options.benchmarker, result, elapsed);
+    const latency = benchmarker.processLatency ?
+      benchmarker.processLatency(stdout) :
+      undefined;
+    callback(null, code, options.benchmarker, result, elapsed, latency);
   });
 
 };
@@ -0,0 +1,95 @@
+'use strict';
+
+// Support for recording hardware counters with `perf stat` and for pinning
+// the benchmark processes to a set of CPUs, see
+// doc/guides/writing-and-running-benchmarks.md.
+//
+// The process running a configuration is started through `taskset` and
+// `perf stat`. perf starts with the counters disabled. start() and end() of
+// the benchmark enable and disable them through perf's control FIFO, so that
+// only the measured part of the benchmark is counted.
+
+const child_process = require('child_process');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const perfEvents = process.env.NODE_BENCHMARK_PERF_EVENTS;
+const cpuSet = process.env.NODE_BENCHMARK_CPUSET;
+
+function mkfifo(file) {
+  child_process.execFileSync('mkfifo', ['-m', '600', file]);
+}
+
+// Returns the options for child_process.fork() to run a configuration, and a
+// function that returns the counters, per operation, once it has exited.
+function wrapFork(forkOptions) {
+  const wrapper = [];
+  if (cpuSet)
+    wrapper.push('taskset', '-c', cpuSet);
+
+  let dir;
+  if (perfEvents) {
+    dir = fs.mkdtempSync(path.join(os.tmpdir(), 'node-benchmark-perf-'));
+    const ctl = path.join(dir, 'ctl');
+    const ack = path.join(dir, 'ack');
+    mkfifo(ctl);
+    mkfifo(ack);
+    wrapper.push('perf', 'stat', '-x,', '-o', path.join(dir, 'stat'),
+                 '-e', perfEvents, '--delay=-1',
+                 `--control=fifo:${ctl},${ack}`, '--');
+    forkOptions.env.NODE_BENCHMARK_PERF_CTL = ctl;
+    forkOptions.env.NODE_BENCHMARK_PERF_ACK = ack;
+  }
+
+  if (wrapper.length > 0) {
+    forkOptions.execArgv = [
+      ...wrapper.slice(1),
+      forkOptions.execPath || process.execPath,
+      ...forkOptions.execArgv,
+    ];
+    forkOptions.execPath = wrapper[0];
+  }
+
+  return function readCounters(operations) {
+    if (dir === undefined)
+      return undefined;
+    const counters = {};
+    try {
+      const stat = fs.readFileSync(path.join(dir, 'stat'), 'utf8');
+      // Each line is "value,unit,event,run time,percentage,...".
+      for (const line of stat.split('\n')) {
+        if (line === '' || line[0] === '#')
+          continue;
+        const [value, , event] = line.split(',');
+        const name = event.replace(/:u$/, '');
+        counters[name] = operations > 0 ? Number(value) / operations : NaN;
+      }
+    } finally {
+      fs.rmSync(dir, { recursive: true, force: true });
+    }
+    return counters;
+  };
+}
+
+let ctlFd;
+let ackFd;
+
+function control(command) {
+  if (!process.env.NODE_BENCHMARK_PERF_CTL)
+    return;
+  if (ctlFd === undefined) {
+    ctlFd = fs.openSync(process.env.NODE_BENCHMARK_PERF_CTL, 'w');
+    ackFd = fs.openSync(process.env.NODE_BENCHMARK_PERF_ACK, 'r');
+  }
+  fs.writeSync(ctlFd, `${command}\n`);
+  // Wait for perf to apply the command before carrying on.
+  fs.readSync(ackFd, Buffer.alloc(5));
+}
+
+module.exports = {
+  enabled: Boolean(perfEvents || cpuSet),
+  wrapFork,
+  startCounters: () => control('enable'),
+  stopCounters: () => control('disable'),
+};
@@ -2,7 +2,7 @@
 const common = require('../common.js');
 
 const bench = common.createBenchmark(main, {
-  size: [0, 512, 16386],
+  size: [0, 16, 512, 16386],
   difflen: ['true', 'false'],
   n: [1e6]
 });
@@ -0,0 +1,32 @@
+'use strict';
+
+const common = require('../common.js');
+const { parseJSON } = require('buffer');
+
+const bench = common.createBenchmark(main, {
+  method: ['parseJSON', 'JSON.parse'],
+  size: [1024, 16 * 1024 * 1024],
+  n: [64 * 1024 * 1024],
+});
+
+function main({ method, size, n }) {
+  const items = [];
+  let length = 2;
+  while (length < size) {
+    const item = { id: items.length, name: `item ${items.length}`, ok: true };
+    items.push(item);
+    length += JSON.stringify(item).length + 1;
+  }
+  const buf = Buffer.from(JSON.stringify(items));
+  const iterations = Math.max(1, Math.floor(n / buf.length));
+
+  bench.start();
+  if (method === 'parseJSON') {
+    for (let i = 0; i < iterations; i++)
+      parseJSON(buf);
+  } else {
+    for (let i = 0; i < iterations; i++)
+      JSON.parse(buf.toString());
+  }
+  bench.end(iterations * buf.length / (1024 * 1024));
+}
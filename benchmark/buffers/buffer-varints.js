@@ -0,0 +1,27 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  type: ['Uint32Array', 'BigUint64Array'],
+  method: ['readVarints', 'writeVarints'],
+  bits: [7, 32],
+  len: [16, 1024],
+  n: [1e5]
+});
+
+function main({ type, method, bits, len, n }) {
+  const values = type === 'Uint32Array' ?
+    new Uint32Array(len) : new BigUint64Array(len);
+  for (let i = 0; i < len; i++) {
+    const value = Math.floor(Math.random() * 2 ** bits) % 2 ** 32;
+    values[i] = type === 'Uint32Array' ? value : BigInt(value);
+  }
+  const buf = Buffer.alloc(len * 10);
+  buf.writeVarints(values);
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    buf[method](values);
+  bench.end(n);
+}
@@ -2,6 +2,7 @@
 
 const child_process = require('child_process');
 const http_benchmarkers = require('./_http-benchmarkers.js');
+const perfCounters = require('./_perf-counters.js');
 
 class Benchmark {
   constructor(fn, configs, options = {}) {
@@ -150,9 +151,13 @@ class Benchmark {
     http_options.benchmarker = http_options.benchmarker ||
                                this.config.benchmarker ||
                                this.extra_options.benchmarker ||
-                               http_benchmarkers.default_http_benchmarker;
+                               (http_options.pipelining > 1 ?
+                                 http_benchmarkers
+                                   .default_pipelining_http_benchmarker :
+                                 http_benchmarkers.default_http_benchmarker);
     http_benchmarkers.run(
-      http_options, (error, code, used_benchmarker, result, elapsed) => {
+      http_options,
+      (error, code, used_benchmarker, result, elapsed, latency) => {
         if (cb) {
           cb(code);
         }
@@ -161,7 +166,13 @@ class Benchmark {
           process.exit(code || 1);
         }
         this.config.benchmarker = used_benchmarker;
-        this.report(result, elapsed);
+        // With `metrics: true`, also report the latency percentiles measured
+        // by the benchmarker and the peak memory use of this process.
+        let extra;
+        if (options.metrics) {
+          extra = { ...latency, maxRSS: process.resourceUsage().maxRSS };
+        }
+        this.report(result, elapsed, extra);
       }
     );
   }
@@ -194,16 +205,54 @@ class Benchmark {
         childArgs.push(`${key}=${value}`);
       }
 
-      const child = child_process.fork(require.main.filename, childArgs, {
+      const forkOptions = {
         env: childEnv,
         execArgv: this.flags.concat(process.execArgv),
+      };
+      if (!perfCounters.enabled) {
+        const child = child_process.fork(require.main.filename, childArgs,
+                                         forkOptions);
+        child.on('message', sendResult);
+        child.on('close', (code) => {
+          if (code) {
+            process.exit(code);
+          }
+
+          if (queueIndex + 1 < this.queue.length) {
+            recursive(queueIndex + 1);
+          }
+        });
+        return;
+      }
+
+      // The counters are only available once the child has exited, so its
+      // results are held back until then.
+      const readCounters = perfCounters.wrapFork(forkOptions);
+      const child = child_process.fork(require.main.filename, childArgs,
+                                       forkOptions);
+      const results = [];
+      child.on('message', (data) => {
+        if (data.type === 'report')
+          results.push(data);
+        else
+          sendResult(data);
+      });
+      child.on('error', (err) => {
+        console.error(`Failed to run ${forkOptions.execPath}: ${err.message}`);
+        process.exit(1);
       });
-      child.on('message', sendResult);
       child.on('close', (code) => {
         if (code) {
           process.exit(code);
         }
 
+        for (const data of results) {
+          const counters = readCounters(data.rate * data.time);
+          if (counters !== undefined)
+            data.extra = { ...data.extra, counters };
+          sendResult(data);
+        }
+
         if (queueIndex + 1 < this.queue.length) {
           recursive(queueIndex + 1);
         }
@@ -218,12 +267,14 @@ class Benchmark {
       throw new Error('Called start more than once in a single benchmark');
     }
     this._started = true;
+    perfCounters.startCounters();
     this._time = process.hrtime();
   }
 
-  end(operations) {
+  end(operations, extra) {
     // Get elapsed time now and do error checking later for accuracy.
     const elapsed = process.hrtime(this._time);
+    perfCounters.stopCounters();
 
     if (!this._started) {
       throw new Error('called end without start');
@@ -247,16 +298,17 @@ class Benchmark {
     this._ended = true;
     const time = elapsed[0] + elapsed[1] / 1e9;
     const rate = operations / time;
-    this.report(rate, elapsed);
+    this.report(rate, elapsed, extra);
   }
 
-  report(rate, elapsed) {
+  report(rate, elapsed, extra) {
     sendResult({
       name: this.name,
       conf: this.config,
       rate,
       time: elapsed[0] + elapsed[1] / 1e9,
       type: 'report',
+      extra,
     });
   }
 }
@@ -271,7 +323,34 @@ function formatResult(data) {
   let rate = data.rate.toString().split('.');
   rate[0] = rate[0].replace(/(\d)(?=(?:\d\d\d)+(?!\d))/g, '$1,');
   rate = (rate[1] ? rate.join('.') : rate[0]);
-  return `${data.name}${conf}: ${rate}`;
+  return `${data.name}${conf}: ${rate}${formatExtra(data.extra)}`;
+}
+
+// Formats the additional measurements of a result, e.g. those of HTTP
+// benchmarks created with `metrics: true`, as " (p50=1.2ms p99=3.4ms ...)".
+function formatExtra(extra) {
+  if (!extra)
+    return '';
+  const parts = [];
+  if (extra.p50 !== undefined)
+    parts.push(`p50=${extra.p50}ms`);
+  if (extra.p99 !== undefined)
+    parts.push(`p99=${extra.p99}ms`);
+  if (extra.maxRSS !== undefined)
+    parts.push(`maxRSS=${(extra.maxRSS / 1024).toFixed(1)}MiB`);
+  if (extra.cpuMsPerGB !== undefined)
+    parts.push(`cpu=${extra.cpuMsPerGB}ms/GB`);
+  if (extra.syscallsPerMB !== undefined)
+    parts.push(`syscalls=${extra.syscallsPerMB}/MB`);
+  if (extra.compiledWithCache !== undefined) {
+    parts.push(`compiledWithCache=${extra.compiledWithCache}`,
+               `compiledWithoutCache=${extra.compiledWithoutCache}`);
+  }
+  if (extra.counters !== undefined) {
+    for (const [event, value] of Object.entries(extra.counters))
+      parts.push(`${event}/op=${+value.toFixed(2)}`);
+  }
+  return parts.length > 0 ? ` (${parts.join(' ')})` : '';
 }
 
 function sendResult(data) {
@@ -311,6 +390,8 @@ const searchParams = {
   manypairs: 'a&b&c&d&e&f&g&h&i&j&k&l&m&n&o&p&q&r&s&t&u&v&w&x&y&z',
   manyblankpairs: '&&&&&&&&&&&&&&&&&&&&&&&&',
   altspaces: 'foo+bar=baz+quux&xyzzy+thud=quuy+quuz&abc=def+ghi',
+  formbody: 'username=alice%40example.com&password=hunter2&remember=on&' +
+            'redirect=%2Fdashboard%3Ftab%3Dsettings&csrf=3f2a9c1e7b5d4068',
 };
 
 function getUrlData(withBase) {
@@ -24,6 +24,11 @@ const cli = new CLI(`usage: ./node compare.js [options] [--] <category> ...
                                 repeated)
   --set      variable=value     set benchmark variable (can be repeated)
   --no-progress                 don't show benchmark progress indicator
+  --cpu-set  list               run the benchmarks on the given CPUs only,
+                                e.g. 2,3 (requires taskset)
+  --perf-events  list           record the given hardware counters per
+                                operation, e.g. instructions,cycles (requires
+                                perf 5.10+)
 `, { arrayArgs: ['set', 'filter', 'exclude'], boolArgs: ['no-progress'] });
 
 if (!cli.optional.new || !cli.optional.old) {
@@ -33,6 +38,8 @@ if (!cli.optional.new || !cli.optional.old) {
 const binaries = ['old', 'new'];
 const runs = cli.optional.runs ? parseInt(cli.optional.runs, 10) : 30;
 const benchmarks = cli.benchmarks();
+cli.setupIsolation();
+const counterNames = cli.perfEvents();
 
 if (benchmarks.length === 0) {
   console.error('No benchmarks found');
@@ -56,7 +63,8 @@ for (const filename of benchmarks) {
 // queue.length = binary.length * runs * benchmarks.length
 
 // Print csv header
-console.log('"binary","filename","configuration","rate","time"');
+console.log('"binary","filename","configuration","rate","time"' +
+            counterNames.map((name) => `,"${name}/op"`).join(''));
 
 const kStartOfQueue = 0;
 
@@ -85,8 +93,10 @@ if (showProgress) {
       // Escape quotes (") for correct csv formatting
       conf = conf.replace(/"/g, '""');
 
+      const counters = (data.extra && data.extra.counters) || {};
+      const columns = counterNames.map((name) => `,${counters[name] ?? ''}`);
       console.log(`"${job.binary}","${job.filename}","${conf}",` +
-                  `${data.rate},${data.time}`);
+                  `${data.rate},${data.time}${columns.join('')}`);
       if (showProgress) {
         // One item in the subqueue has been completed.
         progress.completeConfig(data);
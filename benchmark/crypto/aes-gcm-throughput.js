@@ -5,16 +5,20 @@ const keylen = { 'aes-128-gcm': 16, 'aes-192-gcm': 24, 'aes-256-gcm': 32 };
 const bench = common.createBenchmark(main, {
   n: [500],
   cipher: ['aes-128-gcm', 'aes-192-gcm', 'aes-256-gcm'],
-  len: [1024, 4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024]
+  len: [64, 1024, 4 * 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024],
+  api: ['stream', 'oneshot'],
 });
 
-function main({ n, len, cipher }) {
+function main({ n, len, cipher, api }) {
   const message = Buffer.alloc(len, 'b');
   const key = crypto.randomBytes(keylen[cipher]);
   const iv = crypto.randomBytes(12);
   const associate_data = Buffer.alloc(16, 'z');
   bench.start();
-  AEAD_Bench(cipher, message, associate_data, key, iv, n, len);
+  if (api === 'stream')
+    AEAD_Bench(cipher, message, associate_data, key, iv, n, len);
+  else
+    AEAD_OneShot_Bench(cipher, message, associate_data, key, iv, n, len);
 }
 
 function AEAD_Bench(cipher, message, associate_data, key, iv, n, len) {
@@ -37,3 +41,18 @@ function AEAD_Bench(cipher, message, associate_data, key, iv, n, len) {
 
   bench.end(mbits);
 }
+
+function AEAD_OneShot_Bench(cipher, message, associate_data, key, iv, n, len) {
+  const written = n * len;
+  const bits = written * 8;
+  const mbits = bits / (1024 * 1024);
+  const sealed = Buffer.alloc(len + 16);
+  const opened = Buffer.alloc(len);
+
+  for (let i = 0; i < n; i++) {
+    crypto.aeadSeal(cipher, key, iv, associate_data, message, sealed);
+    crypto.aeadOpen(cipher, key, iv, associate_data, sealed, opened);
+  }
+
+  bench.end(mbits);
+}
@@ -10,7 +10,7 @@ const bench = common.createBenchmark(main, {
   type: ['asc', 'utf', 'buf'],
   out: ['hex', 'binary', 'buffer'],
   len: [2, 1024, 102400, 1024 * 1024],
-  api: ['legacy', 'stream']
+  api: ['legacy', 'stream', 'oneshot']
 });
 
 function main({ api, type, len, out, writes, algo }) {
@@ -38,7 +38,8 @@ function main({ api, type, len, out, writes, algo }) {
       throw new Error(`unknown message type: ${type}`);
   }
 
-  const fn = api === 'stream' ? streamWrite : legacyWrite;
+  const fn = api === 'stream' ? streamWrite :
+    api === 'oneshot' ? oneShotWrite : legacyWrite;
 
   bench.start();
   fn(algo, message, encoding, writes, len, out);
@@ -80,3 +81,14 @@ function streamWrite(algo, message, encoding, writes, len, outEnc) {
 
   bench.end(gbits);
 }
+
+function oneShotWrite(algo, message, encoding, writes, len, outEnc) {
+  const written = writes * len;
+  const bits = written * 8;
+  const gbits = bits / (1024 * 1024 * 1024);
+
+  while (writes-- > 0)
+    crypto.hash(algo, message, outEnc);
+
+  bench.end(gbits);
+}
@@ -0,0 +1,47 @@
+'use strict';
+// Signing and verifying with crypto.sign() and crypto.verify(), with keys that
+// are given as KeyObjects or have to be parsed every time.
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+const keys = {
+  rsa: {
+    private: fs.readFileSync(`${fixtures_keydir}/rsa_private_2048.pem`),
+    public: fs.readFileSync(`${fixtures_keydir}/rsa_public_2048.pem`),
+  },
+  ec: {
+    private: fs.readFileSync(`${fixtures_keydir}/ec_p256_private.pem`),
+    public: fs.readFileSync(`${fixtures_keydir}/ec_p256_public.pem`),
+  },
+};
+
+const bench = common.createBenchmark(main, {
+  mode: ['sign', 'verify'],
+  type: ['rsa', 'ec'],
+  keyFormat: ['keyObject', 'pem'],
+  n: [1e3],
+});
+
+function main({ mode, type, keyFormat, n }) {
+  const data = Buffer.from('some data to sign');
+  let privateKey = keys[type].private;
+  let publicKey = keys[type].public;
+  if (keyFormat === 'keyObject') {
+    privateKey = crypto.createPrivateKey(privateKey);
+    publicKey = crypto.createPublicKey(publicKey);
+  }
+  const signature = crypto.sign('sha256', data, privateKey);
+
+  bench.start();
+  if (mode === 'sign') {
+    for (let i = 0; i < n; i++)
+      crypto.sign('sha256', data, privateKey);
+  } else {
+    for (let i = 0; i < n; i++)
+      crypto.verify('sha256', data, publicKey, signature);
+  }
+  bench.end(n);
+}
@@ -4,7 +4,7 @@ const common = require('../common.js');
 const { randomBytes } = require('crypto');
 
 const bench = common.createBenchmark(main, {
-  size: [64, 1024, 8192, 512 * 1024],
+  size: [16, 64, 1024, 8192, 512 * 1024],
   n: [1e3],
 });
 
@@ -0,0 +1,41 @@
+'use strict';
+// Verifying many ECDSA signatures one by one vs. in a batch.
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  api: ['verify', 'verifyBatch'],
+  size: [16, 256],
+  n: [16],
+});
+
+function main({ api, size, n }) {
+  const { privateKey, publicKey } =
+    crypto.generateKeyPairSync('ec', { namedCurve: 'P-256' });
+  const items = [];
+  for (let i = 0; i < size; i++) {
+    const data = Buffer.from(`message ${i}`);
+    items.push({ data, signature: crypto.sign('sha256', data, privateKey) });
+  }
+
+  let pending = n;
+  const done = () => {
+    if (--pending === 0)
+      bench.end(n * size);
+  };
+
+  bench.start();
+  for (let i = 0; i < n; i++) {
+    if (api === 'verifyBatch') {
+      crypto.verifyBatch(publicKey, 'sha256', items, done);
+    } else {
+      let left = size;
+      for (const { data, signature } of items) {
+        crypto.verify('sha256', data, publicKey, signature, () => {
+          if (--left === 0)
+            done();
+        });
+      }
+    }
+  }
+}
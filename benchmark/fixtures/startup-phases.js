@@ -0,0 +1,22 @@
+'use strict';
+
+// Preloaded by misc/startup-phases.js. Reports the startup milestones and how
+// the builtin modules were compiled once the main module has run.
+
+const fs = require('fs');
+const { performance } = require('perf_hooks');
+const { internalBinding } = require('internal/test/binding');
+
+process.on('exit', () => {
+  const {
+    compiledWithCache,
+    compiledWithoutCache,
+    compiledInSnapshot,
+  } = internalBinding('native_module').getCacheUsage();
+  fs.writeSync(1, JSON.stringify({
+    timing: performance.nodeTiming.toJSON(),
+    compiledWithCache: compiledWithCache.size,
+    compiledWithoutCache: compiledWithoutCache.size,
+    compiledInSnapshot: compiledInSnapshot.length,
+  }));
+});
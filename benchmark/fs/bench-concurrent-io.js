@@ -0,0 +1,69 @@
+// Measure the throughput of small file system requests at various levels of
+// concurrency. On Linux, run this once as is and once with UV_USE_IO_URING=1
+// in the environment to compare the thread pool with the io_uring backend:
+//
+//   $ node benchmark/run.js --filter bench-concurrent-io fs
+//   $ UV_USE_IO_URING=1 node benchmark/run.js --filter bench-concurrent-io fs
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  type: ['read', 'write', 'stat', 'open-close'],
+  concurrent: [1, 64, 1024],
+  n: [1e5],
+});
+
+function main({ type, concurrent, n }) {
+  tmpdir.refresh();
+  const filename = path.resolve(tmpdir.path,
+                                `.removeme-benchmark-garbage-${process.pid}`);
+  fs.writeFileSync(filename, Buffer.alloc(4096, 'x'));
+  const fd = fs.openSync(filename, 'r+');
+
+  let op;
+  switch (type) {
+    case 'read':
+      op = (buf, cb) => fs.read(fd, buf, 0, buf.length, 0, cb);
+      break;
+    case 'write':
+      op = (buf, cb) => fs.write(fd, buf, 0, buf.length, 0, cb);
+      break;
+    case 'stat':
+      op = (buf, cb) => fs.stat(filename, cb);
+      break;
+    case 'open-close':
+      op = (buf, cb) => fs.open(filename, 'r', (err, fd) => {
+        if (err) throw err;
+        fs.close(fd, cb);
+      });
+      break;
+    default:
+      throw new Error(`invalid type: ${type}`);
+  }
+
+  let started = 0;
+  let finished = 0;
+
+  function next(buf) {
+    if (started >= n)
+      return;
+    started++;
+    op(buf, (err) => {
+      if (err) throw err;
+      if (++finished === n) {
+        bench.end(n);
+        fs.closeSync(fd);
+        return;
+      }
+      next(buf);
+    });
+  }
+
+  bench.start();
+  for (let i = 0; i < concurrent; i++)
+    next(Buffer.alloc(512));
+}
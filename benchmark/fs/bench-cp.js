@@ -0,0 +1,28 @@
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  files: [1000],
+  size: [1024, 256 * 1024],
+  concurrency: [1, 4, 16]
+});
+
+async function main({ files, size, concurrency }) {
+  tmpdir.refresh();
+  const src = path.join(tmpdir.path, 'src');
+  const data = Buffer.alloc(size, 'x');
+  for (let i = 0; i < files; i++) {
+    const dir = path.join(src, `dir-${i % 10}`);
+    fs.mkdirSync(dir, { recursive: true });
+    fs.writeFileSync(path.join(dir, `file-${i}`), data);
+  }
+
+  bench.start();
+  await fs.promises.cp(src, path.join(tmpdir.path, 'dest'), { concurrency });
+  bench.end(files);
+  tmpdir.refresh();
+}
@@ -0,0 +1,47 @@
+'use strict';
+
+const common = require('../common');
+const fs = require('fs');
+const path = require('path');
+
+const bench = common.createBenchmark(main, {
+  n: [1e3],
+  paths: [10, 1000],
+  method: ['statMany', 'stat', 'statManySync', 'statSync']
+});
+
+function main({ n, paths, method }) {
+  const dir = path.join(__dirname, '..', '..', 'lib');
+  const files = fs.readdirSync(dir).map((name) => path.join(dir, name));
+  const list = [];
+  for (let i = 0; i < paths; i++)
+    list.push(files[i % files.length]);
+
+  switch (method) {
+    case 'statMany':
+      return runAsync(n, () => fs.promises.statMany(list));
+    case 'stat':
+      return runAsync(n, () => Promise.all(list.map(fs.promises.stat)));
+    case 'statManySync':
+      bench.start();
+      for (let i = 0; i < n; i++)
+        fs.statManySync(list);
+      return bench.end(n * paths);
+    case 'statSync':
+      bench.start();
+      for (let i = 0; i < n; i++) {
+        for (const file of list)
+          fs.statSync(file);
+      }
+      return bench.end(n * paths);
+    default:
+      throw new Error(`Unexpected method "${method}"`);
+  }
+
+  async function runAsync(n, fn) {
+    bench.start();
+    for (let i = 0; i < n; i++)
+      await fn();
+    bench.end(n * paths);
+  }
+}
@@ -0,0 +1,49 @@
+// Throughput of reading a file as a stream, through fs.createReadStream() or
+// filehandle.readableStream() with different numbers of reads in flight.
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const fs = require('fs');
+
+const tmpdir = require('../../test/common/tmpdir');
+tmpdir.refresh();
+const filename = path.resolve(tmpdir.path,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+
+const bench = common.createBenchmark(main, {
+  api: ['createReadStream', 'readableStream'],
+  readAhead: [1, 2, 4],
+  filesize: [64 * 1024 * 1024],
+  n: [8],
+}, {
+  test: { filesize: 1024 * 1024, n: 1 },
+});
+
+function main({ api, readAhead, filesize, n }) {
+  if (api === 'createReadStream' && readAhead !== 1) {
+    // The option does not apply.
+    bench.start();
+    bench.end(0);
+    return;
+  }
+
+  fs.writeFileSync(filename, Buffer.alloc(filesize, 'x'));
+
+  (async () => {
+    const handle = await fs.promises.open(filename, 'r');
+    let bytes = 0;
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      const stream = api === 'readableStream' ?
+        handle.readableStream({ start: 0, readAhead }) :
+        fs.createReadStream(null, { fd: handle.fd, start: 0,
+                                    autoClose: false });
+      for await (const chunk of stream)
+        bytes += chunk.length;
+    }
+    bench.end(bytes / (1024 * 1024 * 1024));
+    await handle.close();
+    fs.unlinkSync(filename);
+  })();
+}
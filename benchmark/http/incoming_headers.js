@@ -4,7 +4,8 @@ const http = require('http');
 
 const bench = common.createBenchmark(main, {
   connections: [50], // Concurrent connections
-  headers: [20], // Number of header lines to append after the common headers
+  // Number of header lines to append after the common headers
+  headers: [20, 64, 128],
   w: [0, 6], // Amount of trailing whitespace
   duration: 5
 });
@@ -15,7 +16,7 @@ function main({ connections, headers, w, duration }) {
   });
 
   server.listen(common.PORT, () => {
-    const headers = {
+    const requestHeaders = {
       'Content-Type': 'text/plain',
       'Accept': 'text/plain',
       'User-Agent': 'nodejs-benchmark',
@@ -28,12 +29,13 @@ function main({ connections, headers, w, duration }) {
       // - wrk can only send trailing OWS. This is a side-effect of wrk
       // processing requests with http-parser before sending them, causing
       // leading OWS to be stripped.
-      headers[`foo${i}`] = `some header value ${i}${' \t'.repeat(w / 2)}`;
+      requestHeaders[`foo${i}`] =
+        `some header value ${i}${' \t'.repeat(w / 2)}`;
     }
     bench.http({
       path: '/',
       connections,
-      headers,
+      headers: requestHeaders,
       duration
     }, () => {
       server.close();
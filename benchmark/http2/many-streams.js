@@ -0,0 +1,98 @@
+// Open a number of sessions that each keep many streams in flight, and
+// report the completed streams per second together with the stream latency
+// and the peak RSS of the process.
+'use strict';
+
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  sessions: [1, 8],
+  streams: [10, 100],
+  size: [64, 16 * 1024],
+  headers: [4, 32],
+  mode: ['respond', 'respondWithFile'],
+  duration: 5
+}, { flags: ['--no-warnings'] });
+
+function main({ sessions, streams, size, headers, mode, duration }) {
+  const http2 = require('http2');
+  const { createHistogram } = require('perf_hooks');
+
+  const responseHeaders = { ':status': 200 };
+  for (let i = 0; i < headers; i++)
+    responseHeaders[`x-header-${i}`] = `value-${i}`;
+  const payload = Buffer.alloc(size, 'x');
+
+  let file;
+  if (mode === 'respondWithFile') {
+    tmpdir.refresh();
+    file = path.join(tmpdir.path, `many-streams-${size}`);
+    fs.writeFileSync(file, payload);
+  }
+
+  const server = http2.createServer({
+    settings: { maxConcurrentStreams: streams }
+  });
+  server.on('stream', (stream) => {
+    stream.on('error', () => {});
+    if (mode === 'respond') {
+      stream.respond(responseHeaders);
+      stream.end(payload);
+    } else {
+      stream.respondWithFile(file, responseHeaders);
+    }
+  });
+
+  server.listen(0, () => {
+    const latency = createHistogram();
+    const url = `http://localhost:${server.address().port}`;
+    const clients = [];
+    let completed = 0;
+    let running = true;
+    let pending = sessions;
+
+    function request(client) {
+      const start = process.hrtime.bigint();
+      const req = client.request();
+      req.on('error', () => {});
+      req.resume();
+      req.on('end', () => {
+        latency.record(process.hrtime.bigint() - start);
+        completed++;
+        if (running)
+          request(client);
+      });
+    }
+
+    for (let i = 0; i < sessions; i++) {
+      const client = http2.connect(url);
+      clients.push(client);
+      client.on('connect', () => {
+        if (--pending > 0)
+          return;
+        const start = process.hrtime();
+        for (const client of clients) {
+          for (let j = 0; j < streams; j++)
+            request(client);
+        }
+        setTimeout(() => {
+          running = false;
+          const elapsed = process.hrtime(start);
+          const seconds = elapsed[0] + elapsed[1] / 1e9;
+          bench.report(completed / seconds, elapsed, {
+            p50: latency.percentile(50) / 1e6,
+            p99: latency.percentile(99) / 1e6,
+            maxRSS: process.resourceUsage().maxRSS,
+          });
+          for (const client of clients)
+            client.destroy();
+          server.close();
+        }, duration * 1000);
+      });
+    }
+  });
+}
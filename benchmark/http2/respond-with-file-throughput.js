@@ -0,0 +1,52 @@
+// Measure how fast a file is streamed with respondWithFile(), which reads
+// the file through a native FileHandle stream.
+'use strict';
+
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  filesize: [64 * 1024 * 1024],
+  n: [10]
+}, { flags: ['--no-warnings'] });
+
+function main({ filesize, n }) {
+  const http2 = require('http2');
+
+  tmpdir.refresh();
+  const file = path.join(tmpdir.path, 'respond-with-file-throughput');
+  fs.writeFileSync(file, Buffer.alloc(filesize, 'x'));
+
+  const server = http2.createServer({
+    settings: { initialWindowSize: 2 ** 31 - 1 }
+  });
+  server.on('stream', (stream) => stream.respondWithFile(file));
+
+  server.listen(0, () => {
+    const client = http2.connect(`http://localhost:${server.address().port}`, {
+      settings: { initialWindowSize: 2 ** 31 - 1 }
+    });
+    client.on('connect', () => {
+      client.setLocalWindowSize(2 ** 31 - 1);
+      let remaining = n;
+      bench.start();
+      (function request() {
+        const req = client.request();
+        let received = 0;
+        req.on('data', (chunk) => received += chunk.length);
+        req.on('end', () => {
+          if (received !== filesize)
+            throw new Error(`Received ${received} bytes of ${filesize}`);
+          if (--remaining > 0)
+            return request();
+          bench.end(n * filesize / (1024 * 1024));
+          client.close();
+          server.close();
+        });
+      })();
+    });
+  });
+}
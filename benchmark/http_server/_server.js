@@ -0,0 +1,20 @@
+'use strict';
+
+// The server that is measured by the benchmarks in this directory. It reads
+// the whole request and answers with a `len` bytes long body.
+
+const http = require('http');
+
+module.exports = function createServer(len) {
+  const body = Buffer.alloc(len, 'x');
+  return http.createServer((req, res) => {
+    req.resume();
+    req.on('end', () => {
+      res.writeHead(200, {
+        'Content-Type': 'text/plain',
+        'Content-Length': len,
+      });
+      res.end(body);
+    });
+  });
+};
@@ -0,0 +1,24 @@
+// Measure a server sending responses of different sizes.
+'use strict';
+
+const common = require('../common.js');
+const createServer = require('./_server.js');
+
+const bench = common.createBenchmark(main, {
+  len: [0, 1024, 64 * 1024, 1024 * 1024],
+  connections: [100],
+  duration: 5,
+});
+
+function main({ len, connections, duration }) {
+  const server = createServer(len);
+  server.listen(common.PORT, () => {
+    bench.http({
+      connections,
+      duration,
+      metrics: true,
+    }, () => {
+      server.close();
+    });
+  });
+}
@@ -0,0 +1,24 @@
+// Measure a server with a growing number of concurrent connections. Large
+// values require raising the limit of open files, e.g. with `ulimit -n`.
+'use strict';
+
+const common = require('../common.js');
+const createServer = require('./_server.js');
+
+const bench = common.createBenchmark(main, {
+  connections: [1000, 10000, 100000],
+  duration: 10,
+});
+
+function main({ connections, duration }) {
+  const server = createServer(64);
+  server.listen({ port: common.PORT, backlog: 65535 }, () => {
+    bench.http({
+      connections,
+      duration,
+      metrics: true,
+    }, () => {
+      server.close();
+    });
+  });
+}
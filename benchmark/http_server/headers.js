@@ -0,0 +1,29 @@
+// Measure a server receiving requests with a growing number of headers.
+'use strict';
+
+const common = require('../common.js');
+const createServer = require('./_server.js');
+
+const bench = common.createBenchmark(main, {
+  headers: [0, 16, 64],
+  connections: [100],
+  duration: 5,
+});
+
+function main({ headers: n, connections, duration }) {
+  const headers = {};
+  for (let i = 0; i < n; i++)
+    headers[`X-Header-${i}`] = `value ${i}`;
+
+  const server = createServer(64);
+  server.listen(common.PORT, () => {
+    bench.http({
+      connections,
+      duration,
+      headers,
+      metrics: true,
+    }, () => {
+      server.close();
+    });
+  });
+}
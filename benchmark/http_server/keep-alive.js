@@ -0,0 +1,26 @@
+// Measure a server with persistent connections and with a new connection for
+// every request.
+'use strict';
+
+const common = require('../common.js');
+const createServer = require('./_server.js');
+
+const bench = common.createBenchmark(main, {
+  connection: ['keep-alive', 'close'],
+  connections: [100],
+  duration: 5,
+});
+
+function main({ connection, connections, duration }) {
+  const server = createServer(64);
+  server.listen(common.PORT, () => {
+    bench.http({
+      connections,
+      duration,
+      headers: { Connection: connection },
+      metrics: true,
+    }, () => {
+      server.close();
+    });
+  });
+}
@@ -0,0 +1,25 @@
+// Measure a server with several requests in flight on each connection.
+'use strict';
+
+const common = require('../common.js');
+const createServer = require('./_server.js');
+
+const bench = common.createBenchmark(main, {
+  pipelining: [1, 4, 16],
+  connections: [100],
+  duration: 5,
+});
+
+function main({ pipelining, connections, duration }) {
+  const server = createServer(64);
+  server.listen(common.PORT, () => {
+    bench.http({
+      connections,
+      duration,
+      pipelining,
+      metrics: true,
+    }, () => {
+      server.close();
+    });
+  });
+}
@@ -0,0 +1,70 @@
+// Measures the cost of calling into internal bindings from JS, for the
+// different kinds of bindings and argument types. The bindings do little
+// work, so the result is mostly the cost of the transition itself.
+// Compare against the `js` type, which calls a JS function doing nothing.
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  type: [
+    'js',
+    'slow-none',
+    'fast-none',
+    'slow-smi',
+    'slow-object',
+    'slow-string',
+    'slow-buffer',
+  ],
+  n: [1e7]
+}, {
+  flags: ['--expose-internals']
+});
+
+function main({ n, type }) {
+  const { internalBinding } = require('internal/test/binding');
+  const types = internalBinding('types');
+  const buffer = internalBinding('buffer');
+
+  let fn;
+  let arg0;
+  let arg1;
+  switch (type) {
+    case 'js':
+      fn = (value) => value;
+      break;
+    case 'slow-none':
+      fn = internalBinding('process_methods').uptime;
+      break;
+    case 'fast-none': {
+      // Optimized calls of this function use the V8 fast API.
+      const { hrtime } = internalBinding('process_methods').getFastAPIs();
+      fn = () => hrtime.hrtime();
+      break;
+    }
+    case 'slow-smi':
+      fn = types.isDate;
+      arg0 = 1;
+      break;
+    case 'slow-object':
+      fn = types.isDate;
+      arg0 = {};
+      break;
+    case 'slow-string':
+      fn = buffer.byteLengthUtf8;
+      arg0 = 'The quick brown fox jumps over the lazy dog';
+      break;
+    case 'slow-buffer':
+      fn = buffer.compare;
+      arg0 = Buffer.from('abc');
+      arg1 = Buffer.from('abd');
+      break;
+    default:
+      throw new Error(`Unsupported type ${type}`);
+  }
+
+  bench.start();
+  for (let i = 0; i < n; i++)
+    fn(arg0, arg1);
+  bench.end(n);
+}
@@ -0,0 +1,71 @@
+// Measures the phases of the startup of a process, using the milestones of
+// performance.nodeTiming:
+//   v8:           process start to the initialization of the V8 platform
+//   environment:  creation of the isolate, from the snapshot if there is one
+//   context:      creation or deserialization of the main context
+//   bootstrap:    running the internal bootstrap scripts (none with the
+//                 snapshot)
+//   preExecution: preparing the execution of the main module, e.g. options
+//   mainModule:   loading and running the main module
+//   total:        process start to the end of the main module
+// The rate is the number of times the phase completes per second. The number
+// of builtins compiled with and without the code cache is reported too.
+'use strict';
+
+const common = require('../common.js');
+const { execFileSync } = require('child_process');
+const path = require('path');
+
+const bench = common.createBenchmark(main, {
+  script: [
+    'benchmark/fixtures/require-builtins',
+    'test/fixtures/semicolon',
+  ],
+  phase: [
+    'total',
+    'v8',
+    'environment',
+    'context',
+    'bootstrap',
+    'preExecution',
+    'mainModule',
+  ],
+  n: [30]
+});
+
+const phases = {
+  total: ['nodeStart', 'mainModuleLoaded'],
+  v8: ['nodeStart', 'v8Start'],
+  environment: ['v8Start', 'environment'],
+  context: ['environment', 'contextReady'],
+  bootstrap: ['contextReady', 'internalBootstrapComplete'],
+  preExecution: ['internalBootstrapComplete', 'bootstrapComplete'],
+  mainModule: ['bootstrapComplete', 'mainModuleLoaded'],
+};
+
+function main({ n, script, phase }) {
+  const preload = path.resolve(__dirname, '../fixtures/startup-phases.js');
+  script = path.resolve(__dirname, '../../', `${script}.js`);
+  const [from, to] = phases[phase];
+
+  let total = 0;
+  let result;
+  for (let i = 0; i < n; i++) {
+    const output = execFileSync(process.execPath, [
+      '--expose-internals', '--no-warnings', '--require', preload, script,
+    ], { encoding: 'utf8' });
+    result = JSON.parse(output);
+    const { timing } = result;
+    if (timing[from] < 0 || timing[to] < 0)
+      throw new Error(`The ${from} or ${to} milestone is missing`);
+    // Some phases overlap without the snapshot, count those as zero.
+    total += Math.max(timing[to] - timing[from], 0);
+  }
+
+  // The milestones are in milliseconds.
+  const seconds = total / 1000;
+  bench.report(n / Math.max(seconds, 1e-9), [0, total * 1e6], {
+    compiledWithCache: result.compiledWithCache,
+    compiledWithoutCache: result.compiledWithoutCache,
+  });
+}
@@ -0,0 +1,42 @@
+#include <v8.h>
+#include <node.h>
+
+// call(fn, n) and makeCallback(fn, n) call `fn` n times from C++, the latter
+// through node::MakeCallback() and therefore an InternalCallbackScope.
+
+void Call(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Function> fn = args[0].As<v8::Function>();
+  int64_t n = args[1].As<v8::Number>()->Value();
+  v8::Local<v8::Value> recv = v8::Undefined(isolate);
+  for (int64_t i = 0; i < n; i++) {
+    if (fn->Call(context, recv, 0, nullptr).IsEmpty())
+      return;
+  }
+}
+
+void MakeCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  v8::Isolate* isolate = args.GetIsolate();
+  v8::Local<v8::Function> fn = args[0].As<v8::Function>();
+  int64_t n = args[1].As<v8::Number>()->Value();
+  v8::Local<v8::Object> resource = v8::Object::New(isolate);
+  node::async_context context =
+      node::EmitAsyncInit(isolate, resource, "BenchmarkCallback");
+  for (int64_t i = 0; i < n; i++) {
+    if (node::MakeCallback(isolate, resource, fn, 0, nullptr, context)
+            .IsEmpty()) {
+      break;
+    }
+  }
+  node::EmitAsyncDestroy(isolate, context);
+}
+
+void Initialize(v8::Local<v8::Object> target,
+                v8::Local<v8::Value> module,
+                void* data) {
+  NODE_SET_METHOD(target, "call", Call);
+  NODE_SET_METHOD(target, "makeCallback", MakeCallback);
+}
+
+NODE_MODULE(NODE_GYP_MODULE_NAME, Initialize)
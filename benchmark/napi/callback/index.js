@@ -0,0 +1,46 @@
+// Show the cost of calling a JS function from C++, directly and through
+// MakeCallback(), relative to comparable N-API calls.
+// Reports n of calls per second.
+'use strict';
+
+const common = require('../../common.js');
+
+let binding;
+try {
+  binding = require(`./build/${common.buildType}/binding`);
+} catch {
+  console.error(`${__filename}: Binding failed to load`);
+  process.exit(0);
+}
+
+let napi;
+try {
+  napi = require(`./build/${common.buildType}/napi_binding`);
+} catch {
+  console.error(`${__filename}: NAPI-Binding failed to load`);
+  process.exit(0);
+}
+
+const bench = common.createBenchmark(main, {
+  type: ['call', 'makeCallback', 'napi-call', 'napi-makeCallback'],
+  n: [1e6, 1e7]
+});
+
+function main({ n, type }) {
+  let c = 0;
+  const fn = () => c++;
+
+  const call = {
+    'call': binding.call,
+    'makeCallback': binding.makeCallback,
+    'napi-call': napi.call,
+    'napi-makeCallback': napi.makeCallback,
+  }[type];
+
+  bench.start();
+  call(fn, n);
+  bench.end(n);
+
+  if (c !== n)
+    throw new Error(`Expected ${n} calls, got ${c}`);
+}
@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <node_api.h>
+
+// call(fn, n) and makeCallback(fn, n) call `fn` n times from C, the latter
+// through napi_make_callback().
+
+static napi_value Call(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_status status = napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+  assert(status == napi_ok);
+
+  int64_t n;
+  status = napi_get_value_int64(env, args[1], &n);
+  assert(status == napi_ok);
+
+  napi_value recv;
+  status = napi_get_undefined(env, &recv);
+  assert(status == napi_ok);
+
+  for (int64_t i = 0; i < n; i++) {
+    status = napi_call_function(env, recv, args[0], 0, NULL, NULL);
+    if (status != napi_ok)
+      break;
+  }
+  return NULL;
+}
+
+static napi_value MakeCallback(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  napi_status status = napi_get_cb_info(env, info, &argc, args, NULL, NULL);
+  assert(status == napi_ok);
+
+  int64_t n;
+  status = napi_get_value_int64(env, args[1], &n);
+  assert(status == napi_ok);
+
+  napi_value resource;
+  status = napi_create_object(env, &resource);
+  assert(status == napi_ok);
+
+  napi_value name;
+  status = napi_create_string_utf8(env,
+                                   "BenchmarkCallback",
+                                   NAPI_AUTO_LENGTH,
+                                   &name);
+  assert(status == napi_ok);
+
+  napi_async_context context;
+  status = napi_async_init(env, resource, name, &context);
+  assert(status == napi_ok);
+
+  for (int64_t i = 0; i < n; i++) {
+    status = napi_make_callback(env, context, resource, args[0], 0, NULL, NULL);
+    if (status != napi_ok)
+      break;
+  }
+
+  status = napi_async_destroy(env, context);
+  assert(status == napi_ok);
+  return NULL;
+}
+
+NAPI_MODULE_INIT() {
+  napi_property_descriptor properties[] = {
+    { "call", NULL, Call, NULL, NULL, NULL, napi_default, NULL },
+    { "makeCallback", NULL, MakeCallback, NULL, NULL, NULL, napi_default,
+      NULL },
+  };
+  napi_status status =
+      napi_define_properties(env,
+                             exports,
+                             sizeof(properties) / sizeof(*properties),
+                             properties);
+  assert(status == napi_ok);
+  return exports;
+}
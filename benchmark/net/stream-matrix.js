@@ -0,0 +1,179 @@
+// Throughput of the stream layers, for each transport and path through them.
+// This is meant as the benchmark to check changes to src/stream_base.cc,
+// src/stream_wrap.cc, src/stream_pipe.cc, src/js_stream.cc and
+// src/crypto/crypto_tls.cc against.
+//
+// transport: tcp, pipe (a Unix domain socket) or tls over tcp.
+// path:
+//   direct      client -> server
+//   proxy       client -> proxy -> server, the proxy using .pipe()
+//   streampipe  client -> proxy -> server, the proxy using a native StreamPipe
+//               For tls, the proxy forwards the encrypted bytes over tcp.
+//   jsduplex    client -> server, with the client written to through a JS
+//               Duplex wrapped in a JSStreamSocket
+//
+// Reports Gbits/s received by the server. Also reported per GB are the CPU
+// time of the process and, on Linux, the number of read and write system
+// calls, which cover both ends of the connections.
+'use strict';
+
+const common = require('../common.js');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const net = require('net');
+const tls = require('tls');
+const fixtures = require('../../test/common/fixtures');
+
+const bench = common.createBenchmark(main, {
+  transport: ['tcp', 'pipe', 'tls'],
+  path: ['direct', 'proxy', 'streampipe', 'jsduplex'],
+  len: [1024, 64 * 1024, 1024 * 1024],
+  conns: [1, 8],
+  dur: [5],
+}, {
+  test: { len: 1024, conns: 1, dur: 0.1 },
+  flags: ['--expose-internals'],
+});
+
+let tlsOptions;
+
+function listen(transport, server, name, cb) {
+  if (transport === 'pipe') {
+    const pipe = path.join(os.tmpdir(),
+                           `node-benchmark-${process.pid}-${name}.sock`);
+    try {
+      fs.unlinkSync(pipe);
+    } catch {
+      // The file does not exist.
+    }
+    server.listen(pipe, () => cb({ path: pipe }));
+  } else {
+    server.listen(0, '127.0.0.1', () => {
+      cb({ host: '127.0.0.1', port: server.address().port });
+    });
+  }
+}
+
+function createServer(transport, options, onConnection) {
+  if (transport === 'tls') {
+    return tls.createServer({ ...tlsOptions, ...options }, onConnection);
+  }
+  return net.createServer(options, onConnection);
+}
+
+function connect(transport, address, cb) {
+  if (transport === 'tls') {
+    return tls.connect({ ...address, rejectUnauthorized: false }, cb);
+  }
+  return net.connect(address, cb);
+}
+
+// The read and write system calls made by the process so far, on Linux.
+function readSyscalls() {
+  try {
+    const io = fs.readFileSync('/proc/self/io', 'latin1');
+    const syscr = /syscr: (\d+)/.exec(io)[1];
+    const syscw = /syscw: (\d+)/.exec(io)[1];
+    return Number(syscr) + Number(syscw);
+  } catch {
+    return undefined;
+  }
+}
+
+function main({ transport, path: streamPath, len, conns, dur }) {
+  const { StreamPipe } = require('internal/test/binding')
+    .internalBinding('stream_pipe');
+  const JSStreamSocket = require('internal/js_stream_socket');
+
+  tlsOptions = {
+    key: fixtures.readKey('rsa_private.pem'),
+    cert: fixtures.readKey('rsa_cert.crt'),
+    ca: fixtures.readKey('rsa_ca.crt'),
+    ciphers: 'AES256-GCM-SHA384',
+  };
+
+  const chunk = Buffer.alloc(len, 'x');
+  let received = 0;
+
+  const server = createServer(transport, {}, (socket) => {
+    socket.on('data', (data) => {
+      received += data.length;
+    });
+    socket.on('error', () => {});
+  });
+
+  listen(transport, server, 'server', (serverAddress) => {
+    if (streamPath === 'proxy' || streamPath === 'streampipe') {
+      // The proxy does not read from its connections until the pipes to the
+      // server are set up. It does not terminate TLS, it forwards the
+      // encrypted bytes in both directions.
+      const proxyTransport = transport === 'tls' ? 'tcp' : transport;
+      const proxy = net.createServer({ pauseOnConnect: true }, (socket) => {
+        onProxyConnection(socket, serverAddress);
+      });
+      listen(proxyTransport, proxy, 'proxy', startClients);
+    } else {
+      startClients(serverAddress);
+    }
+  });
+
+  function onProxyConnection(socket, serverAddress) {
+    socket.on('error', () => {});
+    const upstream = net.connect(serverAddress, () => {
+      if (streamPath === 'proxy') {
+        socket.pipe(upstream);
+        upstream.pipe(socket);
+        return;
+      }
+      upstream.pause();
+      for (const [source, sink] of [[socket, upstream], [upstream, socket]]) {
+        const pipe = new StreamPipe(source._handle, sink._handle);
+        pipe.onunpipe = () => {};
+        pipe.start();
+      }
+    });
+    upstream.on('error', () => {});
+  }
+
+  function startClients(address) {
+    let connected = 0;
+    const sockets = [];
+    for (let i = 0; i < conns; i++) {
+      const socket = connect(transport, address, () => {
+        sockets.push(streamPath === 'jsduplex' ?
+          new JSStreamSocket(socket) : socket);
+        if (++connected === conns)
+          run(sockets);
+      });
+      socket.on('error', () => {});
+    }
+  }
+
+  function run(sockets) {
+    const syscalls = readSyscalls();
+    const cpu = process.cpuUsage();
+    bench.start();
+    for (const socket of sockets) {
+      const write = () => {
+        while (socket.write(chunk));
+      };
+      socket.on('drain', write);
+      write();
+    }
+
+    setTimeout(() => {
+      const gbytes = received / (1024 * 1024 * 1024);
+      const { user, system } = process.cpuUsage(cpu);
+      const extra = {
+        cpuMsPerGB: +((user + system) / 1000 / gbytes).toFixed(1),
+      };
+      if (syscalls !== undefined) {
+        extra.syscallsPerMB =
+          +((readSyscalls() - syscalls) / (gbytes * 1024)).toFixed(1);
+      }
+      bench.end(gbytes * 8, extra);
+      process.exit(0);
+    }, dur * 1000);
+  }
+}
@@ -14,11 +14,16 @@ const cli = new CLI(`usage: ./node run.js [options] [--] <category> ...
                             repeated)
   --set    variable=value   set benchmark variable (can be repeated)
   --format [simple|csv]     optional value that specifies the output format
+  --cpu-set  list           run the benchmarks on the given CPUs only, e.g.
+                            2,3 (requires taskset)
+  --perf-events  list       record the given hardware counters per operation,
+                            e.g. instructions,cycles (requires perf 5.10+)
   test                      only run a single configuration from the options
                             matrix
   all                       each benchmark category is run one after the other
 `, { arrayArgs: ['set', 'filter', 'exclude'] });
 const benchmarks = cli.benchmarks();
+cli.setupIsolation();
 
 if (benchmarks.length === 0) {
   console.error('No benchmarks found');
@@ -34,8 +39,37 @@ if (!validFormats.includes(format)) {
   return;
 }
 
+const counterNames = cli.perfEvents();
 if (format === 'csv') {
-  console.log('"filename", "configuration", "rate", "time"');
+  console.log('"filename", "configuration", "rate", "time"' +
+              counterNames.map((name) => `, "${name}/op"`).join(''));
+}
+
+// Formats the additional measurements reported by some benchmarks, see
+// formatExtra() in common.js.
+function formatExtra(extra) {
+  if (!extra)
+    return '';
+  const parts = [];
+  if (extra.p50 !== undefined)
+    parts.push(`p50=${extra.p50}ms`);
+  if (extra.p99 !== undefined)
+    parts.push(`p99=${extra.p99}ms`);
+  if (extra.maxRSS !== undefined)
+    parts.push(`maxRSS=${(extra.maxRSS / 1024).toFixed(1)}MiB`);
+  if (extra.cpuMsPerGB !== undefined)
+    parts.push(`cpu=${extra.cpuMsPerGB}ms/GB`);
+  if (extra.syscallsPerMB !== undefined)
+    parts.push(`syscalls=${extra.syscallsPerMB}/MB`);
+  if (extra.compiledWithCache !== undefined) {
+    parts.push(`compiledWithCache=${extra.compiledWithCache}`,
+               `compiledWithoutCache=${extra.compiledWithoutCache}`);
+  }
+  if (extra.counters !== undefined) {
+    for (const [event, value] of Object.entries(extra.counters))
+      parts.push(`${event}/op=${+value.toFixed(2)}`);
+  }
+  return parts.length > 0 ? ` (${parts.join(' ')})` : '';
 }
 
 (function recursive(i) {
@@ -65,12 +99,15 @@ if (format === 'csv') {
     if (format === 'csv') {
       // Escape quotes (") for correct csv formatting
       conf = conf.replace(/"/g, '""');
-      console.log(`"${data.name}", "${conf}", ${data.rate}, ${data.time}`);
+      const counters = (data.extra && data.extra.counters) || {};
+      const columns = counterNames.map((name) => `, ${counters[name] ?? ''}`);
+      console.log(`"${data.name}", "${conf}", ${data.rate}, ${data.time}` +
+                  columns.join(''));
     } else {
       let rate = data.rate.toString().split('.');
       rate[0] = rate[0].replace(/(\d)(?=(?:\d\d\d)+(?!\d))/g, '$1,');
       rate = (rate[1] ? rate.join('.') : rate[0]);
-      console.log(`${data.name} ${conf}: ${rate}`);
+      console.log(`${data.name} ${conf}: ${rate}${formatExtra(data.extra)}`);
     }
   });
 
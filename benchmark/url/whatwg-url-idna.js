@@ -11,6 +11,10 @@ const domains = {
     ascii: 'passports',
     unicode: 'passports'
   },
+  uppercase: {
+    ascii: 'WWW.Example.COM',
+    unicode: 'WWW.Example.COM'
+  },
   some: {
     ascii: 'Paßstraße',
     unicode: 'xn--Pastrae-1vae'
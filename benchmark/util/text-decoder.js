@@ -0,0 +1,39 @@
+'use strict';
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  type: ['ascii', 'two-byte'],
+  fatal: [0, 1],
+  // Whether the input is fed in chunks that split a character, with a new
+  // decoder for every input as in fetch-style body decoding.
+  stream: [0, 1],
+  len: [64, 1024, 65536],
+  n: [1e5]
+});
+
+function main({ type, fatal, stream, len, n }) {
+  const char = type === 'ascii' ? 'a' : 'é';
+  const input = Buffer.from(char.repeat(len / Buffer.byteLength(char)));
+
+  if (stream) {
+    const chunks = [];
+    for (let i = 0; i < input.length; i += 61)
+      chunks.push(input.subarray(i, i + 61));
+    bench.start();
+    for (let i = 0; i < n; i++) {
+      const decoder = new TextDecoder('utf-8', { fatal: !!fatal });
+      for (const chunk of chunks)
+        decoder.decode(chunk, { stream: true });
+      decoder.decode();
+    }
+    bench.end(n);
+    return;
+  }
+
+  const decoder = new TextDecoder('utf-8', { fatal: !!fatal });
+  bench.start();
+  for (let i = 0; i < n; i++)
+    decoder.decode(input);
+  bench.end(n);
+}
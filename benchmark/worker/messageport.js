@@ -3,13 +3,15 @@
 const common = require('../common.js');
 const { MessageChannel } = require('worker_threads');
 const bench = common.createBenchmark(main, {
-  payload: ['string', 'object'],
+  payload: ['string', 'object', 'objects'],
   style: ['eventtarget', 'eventemitter'],
+  batch: [1, 100],
   n: [1e6]
 });
 
 function main(conf) {
   const n = conf.n;
+  const batch = conf.batch;
   let payload;
 
   switch (conf.payload) {
@@ -19,6 +21,11 @@ function main(conf) {
     case 'object':
       payload = { action: 'pewpewpew', powerLevel: 9001 };
       break;
+    case 'objects':
+      payload = [];
+      for (let i = 0; i < 16; i++)
+        payload.push({ action: 'pewpewpew', powerLevel: i });
+      break;
     default:
       throw new Error('Unsupported payload type');
   }
@@ -27,10 +34,10 @@ function main(conf) {
 
   let messages = 0;
   function listener() {
-    if (messages++ === n) {
+    if (++messages === n) {
       bench.end(n);
       port1.close();
-    } else {
+    } else if (messages % batch === 0) {
       write();
     }
   }
@@ -49,7 +56,9 @@ function main(conf) {
   bench.start();
   write();
 
+  // Post `batch` messages at a time, so that they are queued together.
   function write() {
-    port1.postMessage(payload);
+    for (let i = 0; i < batch; i++)
+      port1.postMessage(payload);
   }
 }
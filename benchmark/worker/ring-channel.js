@@ -0,0 +1,65 @@
+'use strict';
+
+const common = require('../common.js');
+const { MessageChannel, RingChannel } = require('worker_threads');
+const bench = common.createBenchmark(main, {
+  channel: ['ring', 'messageport'],
+  payload: ['buffer', 'object'],
+  n: [1e6]
+});
+
+function main(conf) {
+  const n = conf.n;
+  let payload;
+
+  switch (conf.payload) {
+    case 'buffer':
+      payload = Buffer.alloc(64, 'x');
+      break;
+    case 'object':
+      payload = { action: 'pewpewpew', powerLevel: 9001 };
+      break;
+    default:
+      throw new Error('Unsupported payload type');
+  }
+
+  let messages = 0;
+  let close;
+  function listener() {
+    if (++messages === n) {
+      bench.end(n);
+      close();
+    }
+  }
+
+  switch (conf.channel) {
+    case 'ring': {
+      const { writer, reader } = new RingChannel({ byteLength: 1024 * 1024 });
+      const send = conf.payload === 'buffer' ?
+        () => writer.write(payload) : () => writer.postMessage(payload);
+      let sent = 0;
+      const write = () => {
+        while (sent < n && send())
+          sent++;
+        if (sent < n)
+          writer.once('drain', write);
+      };
+      reader.on('message', listener);
+      close = () => reader.close();
+      bench.start();
+      write();
+      break;
+    }
+    case 'messageport': {
+      const { port1, port2 } = new MessageChannel();
+      port2.on('message', listener);
+      close = () => port1.close();
+      bench.start();
+      for (let i = 0; i < n; i++)
+        port1.postMessage(payload);
+      break;
+    }
+    default:
+      throw new Error('Unsupported channel type');
+  }
+}
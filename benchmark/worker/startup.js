@@ -0,0 +1,27 @@
+'use strict';
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  snapshot: ['true', 'false'],
+  n: [50]
+});
+
+function main({ n, snapshot }) {
+  const execArgv = snapshot === 'true' ? [] : ['--no-node-snapshot'];
+  let started = 0;
+
+  function spawn() {
+    const worker = new Worker('', { eval: true, execArgv });
+    worker.on('exit', () => {
+      if (++started === n)
+        bench.end(n);
+      else
+        spawn();
+    });
+  }
+
+  bench.start();
+  spawn();
+}
@@ -0,0 +1,20 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  method: ['crc32', 'adler32'],
+  type: ['buffer', 'string'],
+  len: [16, 1024, 64 * 1024, 1024 * 1024],
+  n: [1e4]
+});
+
+function main({ n, method, type, len }) {
+  const fn = zlib[method];
+  const data = type === 'buffer' ? Buffer.alloc(len, 'a') : 'a'.repeat(len);
+  let value = 0;
+  bench.start();
+  for (let i = 0; i < n; ++i)
+    value = fn(data, value);
+  bench.end(n);
+}
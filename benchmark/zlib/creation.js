@@ -8,16 +8,38 @@ const bench = common.createBenchmark(main, {
     'BrotliCompress', 'BrotliDecompress',
   ],
   options: ['true', 'false'],
+  // Whether each stream also processes a small input and is closed, which is
+  // when the compression state is actually allocated.
+  use: ['false', 'true'],
   n: [5e5]
 });
 
-function main({ n, type, options }) {
+const compressed = {
+  Inflate: zlib.deflateSync('x'),
+  InflateRaw: zlib.deflateRawSync('x'),
+  Gunzip: zlib.gzipSync('x'),
+  Unzip: zlib.gzipSync('x'),
+  BrotliDecompress: zlib.brotliCompressSync('x'),
+};
+
+function main({ n, type, options, use }) {
   const fn = zlib[`create${type}`];
   if (typeof fn !== 'function')
     throw new Error('Invalid zlib type');
 
-  if (options === 'true') {
-    const opts = {};
+  const opts = options === 'true' ? {} : undefined;
+  if (use === 'true') {
+    const input = compressed[type] || Buffer.from('x');
+    const flush = type.startsWith('Brotli') ?
+      zlib.constants.BROTLI_OPERATION_FINISH : zlib.constants.Z_FINISH;
+    bench.start();
+    for (let i = 0; i < n; ++i) {
+      const stream = fn(opts);
+      stream._processChunk(input, flush);
+      stream.close();
+    }
+    bench.end(n);
+  } else if (options === 'true') {
     bench.start();
     for (let i = 0; i < n; ++i)
       fn(opts);
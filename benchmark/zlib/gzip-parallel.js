@@ -0,0 +1,29 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  parallelBlockSize: [0, 128 * 1024, 1024 * 1024],
+  inputLen: [16 * 1024 * 1024],
+  n: [10]
+});
+
+function main({ n, parallelBlockSize, inputLen }) {
+  // Compressible, but not trivially so.
+  const words = ['alpha', 'beta', 'gamma', 'delta', 'epsilon', '{', '}', ','];
+  let text = '';
+  for (let i = 0; text.length < inputLen; i++)
+    text += words[(i * 7919) % words.length] + i % 1000;
+  const input = Buffer.from(text.slice(0, inputLen));
+  const options = parallelBlockSize ? { parallelBlockSize } : {};
+
+  let i = 0;
+  bench.start();
+  (function next(err) {
+    if (err)
+      throw err;
+    if (i++ === n)
+      return bench.end(n);
+    zlib.gzip(input, options, next);
+  })();
+}
@@ -567,7 +567,14 @@ UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
 
 enum uv_tcp_flags {
   /* Used with uv_tcp_bind, when an IPv6 address is used. */
-  UV_TCP_IPV6ONLY = 1
+  UV_TCP_IPV6ONLY = 1,
+
+  /* Enable SO_REUSEPORT socket option when binding the handle, so that
+   * several sockets can listen on the same address and the kernel spreads
+   * incoming connections across them. Only available on platforms where
+   * the kernel load balances, UV_ENOTSUP is returned elsewhere.
+   */
+  UV_TCP_REUSEPORT = 2
 };
 
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle,
@@ -1048,7 +1055,14 @@ enum uv_process_flags {
    * option is only meaningful on Windows systems. On Unix it is silently
    * ignored.
    */
-  UV_PROCESS_WINDOWS_HIDE_GUI = (1 << 6)
+  UV_PROCESS_WINDOWS_HIDE_GUI = (1 << 6),
+  /*
+   * Create the child process with vfork() instead of fork(), so that the
+   * address space of the parent is not copied. This option is only meaningful
+   * on Linux, and only when neither UV_PROCESS_SETUID nor UV_PROCESS_SETGID is
+   * set; otherwise it is silently ignored.
+   */
+  UV_PROCESS_VFORK = (1 << 7)
 };
 
 /*
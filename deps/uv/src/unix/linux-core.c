@@ -36,6 +36,7 @@
 
 #include <net/if.h>
 #include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/prctl.h>
 #include <sys/sysinfo.h>
@@ -75,6 +76,36 @@
 # define CLOCK_BOOTTIME 7
 #endif
 
+enum {
+  UV__IORING_OP_READV = 1,
+  UV__IORING_OP_WRITEV = 2,
+  UV__IORING_OP_OPENAT = 18,
+  UV__IORING_OP_CLOSE = 19,
+  UV__IORING_OP_STATX = 21,
+};
+
+enum {
+  UV__IORING_ENTER_GETEVENTS = 1u,
+};
+
+enum {
+  UV__IORING_FEAT_SINGLE_MMAP = 1u,
+  UV__IORING_FEAT_NODROP = 2u,
+  UV__IORING_FEAT_SUBMIT_STABLE = 4u,
+  UV__IORING_FEAT_RW_CUR_POS = 8u,
+};
+
+/* Number of submission queue entries. The kernel sizes the completion queue
+ * at twice that and requests beyond the completion queue's capacity are
+ * handed off to the thread pool.
+ */
+#define UV__IOU_ENTRIES 256
+
+static void uv__iou_init(uv_loop_t* loop);
+static void uv__iou_delete(uv_loop_t* loop);
+static void uv__iou_flush(uv_loop_t* loop);
+static void uv__iou_io_cb(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+
 static int read_models(unsigned int numcpus, uv_cpu_info_t* ci);
 static int read_times(FILE* statfile_fp,
                       unsigned int numcpus,
@@ -104,6 +135,8 @@ int uv__platform_loop_init(uv_loop_t* loop) {
   if (fd == -1)
     return UV__ERR(errno);
 
+  uv__iou_init(loop);
+
   return 0;
 }
 
@@ -127,6 +160,8 @@ int uv__io_fork(uv_loop_t* loop) {
 
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  uv__iou_delete(loop);
+
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -134,6 +169,407 @@ void uv__platform_loop_delete(uv_loop_t* loop) {
 }
 
 
+/* io_uring support. Opt-in through UV_USE_IO_URING=1 for now because the
+ * ring is per event loop and not every kernel that has io_uring supports
+ * all of the operations we want; the thread pool remains the default and
+ * the fallback whenever the ring is unavailable or full.
+ */
+static void uv__iou_init(uv_loop_t* loop) {
+  struct uv__io_uring_params params;
+  struct uv__iou* iou;
+  const char* val;
+  uint32_t required;
+  uint32_t i;
+  size_t cqlen;
+  size_t sqlen;
+  size_t maxlen;
+  size_t sqelen;
+  char* sq;
+  char* sqe;
+  int ringfd;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+  iou->ringfd = -1;
+  iou->in_flight = 0;
+  iou->unsubmitted = 0;
+
+  val = getenv("UV_USE_IO_URING");
+  if (val == NULL || atoi(val) == 0)
+    return;
+
+  sq = MAP_FAILED;
+  sqe = MAP_FAILED;
+  maxlen = 0;
+  sqelen = 0;
+
+  memset(&params, 0, sizeof(params));
+  ringfd = uv__io_uring_setup(UV__IOU_ENTRIES, &params);
+  if (ringfd == -1)
+    return;
+
+  /* IORING_FEAT_RW_CUR_POS is available since kernel 5.6, as are all the
+   * opcodes used below.
+   */
+  required = UV__IORING_FEAT_SINGLE_MMAP |
+             UV__IORING_FEAT_NODROP |
+             UV__IORING_FEAT_SUBMIT_STABLE |
+             UV__IORING_FEAT_RW_CUR_POS;
+  if (required != (params.features & required))
+    goto fail;
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  maxlen = sqlen < cqlen ? cqlen : sqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  sq = mmap(0,
+            maxlen,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ringfd,
+            0);  /* IORING_OFF_SQ_RING */
+
+  sqe = mmap(0,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             ringfd,
+             0x10000000ull);  /* IORING_OFF_SQES */
+
+  if (sq == MAP_FAILED || sqe == MAP_FAILED)
+    goto fail;
+
+  iou->sqhead = (uint32_t*) (sq + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (sq + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) (sq + params.sq_off.ring_mask);
+  iou->sqarray = (uint32_t*) (sq + params.sq_off.array);
+  iou->cqhead = (uint32_t*) (sq + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (sq + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (sq + params.cq_off.ring_mask);
+  iou->sq = sq;
+  iou->cqe = sq + params.cq_off.cqes;
+  iou->sqe = sqe;
+  iou->sqlen = maxlen;
+  iou->sqelen = sqelen;
+  iou->ringfd = ringfd;
+
+  /* Submission queue slot N always refers to SQE N. */
+  for (i = 0; i <= iou->sqmask; i++)
+    iou->sqarray[i] = i;
+
+  /* The ring file descriptor is O_CLOEXEC by default. */
+  uv__io_init(&iou->ringfd_watcher, uv__iou_io_cb, ringfd);
+
+  return;
+
+fail:
+  if (sq != MAP_FAILED)
+    munmap(sq, maxlen);
+
+  if (sqe != MAP_FAILED)
+    munmap(sqe, sqelen);
+
+  uv__close(ringfd);
+}
+
+
+static void uv__iou_delete(uv_loop_t* loop) {
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+  if (iou->ringfd == -1)
+    return;
+
+  uv__io_stop(loop, &iou->ringfd_watcher, POLLIN);
+  munmap(iou->sq, iou->sqlen);
+  munmap(iou->sqe, iou->sqelen);
+  uv__close(iou->ringfd);
+  iou->ringfd = -1;
+  iou->in_flight = 0;
+  iou->unsubmitted = 0;
+}
+
+
+/* Hands all queued SQEs to the kernel. Called from uv__io_poll() right
+ * before it blocks, so that every request made during a loop iteration is
+ * submitted with a single system call.
+ */
+static void uv__iou_flush(uv_loop_t* loop) {
+  struct uv__iou* iou;
+  int rc;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  while (iou->unsubmitted > 0) {
+    do
+      rc = uv__io_uring_enter(iou->ringfd, iou->unsubmitted, 0, 0);
+    while (rc == -1 && errno == EINTR);
+
+    /* EAGAIN and EBUSY are transient, try again on the next tick. */
+    if (rc == -1) {
+      if (errno == EAGAIN || errno == EBUSY)
+        return;
+      abort();
+    }
+
+    iou->unsubmitted -= rc;
+  }
+}
+
+
+static struct uv__io_uring_sqe* uv__iou_get_sqe(struct uv__iou* iou,
+                                                uv_loop_t* loop,
+                                                uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t mask;
+  uint32_t slot;
+
+  if (iou->ringfd == -1)
+    return NULL;
+
+  /* Don't have more requests in flight than there are completion queue
+   * entries. The kernel would buffer the excess (IORING_FEAT_NODROP) but
+   * the thread pool is just as good a place for them.
+   */
+  if (iou->in_flight > iou->cqmask)
+    return NULL;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  mask = iou->sqmask;
+
+  /* Submission queue full, flush it and retry. */
+  if (tail - head > mask) {
+    uv__iou_flush(loop);
+    head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+    if (tail - head > mask)
+      return NULL;
+  }
+
+  slot = tail & mask;
+  sqe = iou->sqe;
+  sqe = &sqe[slot];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+
+  /* Pacify uv_cancel(). */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  QUEUE_INIT(&req->work_req.wq);
+
+  uv__req_register(loop, req);
+  iou->in_flight++;
+
+  return sqe;
+}
+
+
+static void uv__iou_submit(struct uv__iou* iou, uv_loop_t* loop) {
+  __atomic_store_n(iou->sqtail, *iou->sqtail + 1, __ATOMIC_RELEASE);
+  iou->unsubmitted++;
+
+  if (iou->in_flight == 1)
+    uv__io_start(loop, &iou->ringfd_watcher, POLLIN);
+}
+
+
+int uv__iou_fs_close(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->opcode = UV__IORING_OP_CLOSE;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->fd = AT_FDCWD;
+  sqe->len = req->mode;
+  sqe->opcode = UV__IORING_OP_OPENAT;
+  sqe->op_flags = req->flags | O_CLOEXEC;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  /* The kernel rejects vectors longer than IOV_MAX, whereas the thread pool
+   * splits them up.
+   */
+  if (req->nbufs > IOV_MAX)
+    return 0;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  /* An offset of -1 means the current file position, which is exactly what
+   * uv_fs_read() and uv_fs_write() mean by it (IORING_FEAT_RW_CUR_POS).
+   */
+  sqe->addr = (uintptr_t) req->bufs;
+  sqe->fd = req->file;
+  sqe->len = req->nbufs;
+  sqe->off = req->off < 0 ? -1 : req->off;
+  sqe->opcode = is_read ? UV__IORING_OP_READV : UV__IORING_OP_WRITEV;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+  if (iou->ringfd == -1)
+    return 0;
+
+  statxbuf = uv__malloc(sizeof(*statxbuf));
+  if (statxbuf == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  req->ptr = statxbuf;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->off = (uintptr_t) statxbuf;  /* addr2 */
+  sqe->fd = AT_FDCWD;
+  sqe->len = 0xFFF; /* STATX_BASIC_STATS + STATX_BTIME */
+  sqe->opcode = UV__IORING_OP_STATX;
+
+  if (is_fstat) {
+    sqe->addr = (uintptr_t) "";
+    sqe->fd = req->file;
+    sqe->op_flags |= 0x1000; /* AT_EMPTY_PATH */
+  }
+
+  if (is_lstat)
+    sqe->op_flags |= AT_SYMLINK_NOFOLLOW;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+static void uv__iou_fs_done(uv_fs_t* req, int res) {
+  struct uv__statx* statxbuf;
+
+  switch (req->fs_type) {
+  case UV_FS_CLOSE:
+    /* Same as uv__fs_close(), the descriptor is gone either way. */
+    if (res == UV__ERR(EINTR) || res == UV__ERR(EINPROGRESS))
+      res = 0;
+    break;
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+    req->bufs = NULL;
+    req->nbufs = 0;
+    break;
+  case UV_FS_FSTAT:
+  case UV_FS_LSTAT:
+  case UV_FS_STAT:
+    statxbuf = req->ptr;
+    req->ptr = NULL;
+    if (res == 0) {
+      uv__statx_to_stat(statxbuf, &req->statbuf);
+      req->ptr = &req->statbuf;
+    }
+    uv__free(statxbuf);
+    break;
+  default:
+    break;
+  }
+
+  req->result = res;
+}
+
+
+static void uv__iou_io_cb(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__io_uring_cqe* e;
+  struct uv__iou* iou;
+  uv_fs_t* req;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t mask;
+  int res;
+
+  iou = container_of(w, struct uv__iou, ringfd_watcher);
+  cqe = iou->cqe;
+  mask = iou->cqmask;
+  head = *iou->cqhead;
+  tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+
+  while (head != tail) {
+    e = &cqe[head & mask];
+    req = (uv_fs_t*) (uintptr_t) e->user_data;
+    res = e->res;
+
+    /* Release the slot before running the callback, the callback may well
+     * queue and flush new requests.
+     */
+    head++;
+    __atomic_store_n(iou->cqhead, head, __ATOMIC_RELEASE);
+
+    assert(req->type == UV_FS);
+    assert(iou->in_flight > 0);
+    iou->in_flight--;
+    uv__req_unregister(loop, req);
+
+    uv__iou_fs_done(req, res);
+    req->cb(req);
+  }
+
+  if (iou->in_flight == 0)
+    uv__io_stop(loop, &iou->ringfd_watcher, POLLIN);
+}
+
+
 void uv__platform_invalidate_fd(uv_loop_t* loop, int fd) {
   struct epoll_event* events;
   struct epoll_event dummy;
@@ -294,6 +730,15 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   no_epoll_wait = uv__load_relaxed(&no_epoll_wait_cached);
 
   for (;;) {
+    /* Submit the io_uring requests queued since the last iteration. If the
+     * kernel pushed back, don't block so that they are retried soon.
+     */
+    if (uv__get_internal_fields(loop)->iou.unsubmitted > 0) {
+      uv__iou_flush(loop);
+      if (uv__get_internal_fields(loop)->iou.unsubmitted > 0)
+        timeout = 0;
+    }
+
     /* Only need to set the provider_entry_time if timeout != 0. The function
      * will return early if the loop isn't configured with UV_METRICS_IDLE_TIME.
      */
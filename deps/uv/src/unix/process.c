@@ -24,8 +24,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 
 #include <sys/types.h>
 #include <sys/wait.h>
@@ -44,6 +46,10 @@ extern char **environ;
 # include <grp.h>
 #endif
 
+#if defined(__linux__)
+# define UV__HAVE_VFORK 1
+#endif
+
 
 static void uv__chld(uv_signal_t* handle, int signum) {
   uv_process_t* process;
@@ -197,6 +203,67 @@ static void uv__write_int(int fd, int val) {
 }
 
 
+#if defined(UV__HAVE_VFORK)
+/* Like execvp(), but the PATH is looked up in envp, and environ is left alone
+ * since a vfork() child shares it with the parent. Unlike execvp(), files that
+ * are not executables are not run with /bin/sh. Returns the errno of the
+ * failure.
+ */
+static int uv__execvpe(const char* file, char* const* argv, char* const* envp) {
+  char buf[PATH_MAX];
+  char* const* e;
+  const char* path;
+  const char* p;
+  const char* end;
+  size_t file_len;
+  size_t len;
+  int err;
+
+  if (strchr(file, '/') != NULL) {
+    execve(file, argv, envp);
+    return errno;
+  }
+
+  path = "/bin:/usr/bin";
+  for (e = envp; *e != NULL; e++) {
+    if (strncmp(*e, "PATH=", 5) == 0) {
+      path = *e + 5;
+      break;
+    }
+  }
+
+  err = ENOENT;
+  file_len = strlen(file);
+  for (p = path; ; p = end + 1) {
+    end = strchr(p, ':');
+    if (end == NULL)
+      end = p + strlen(p);
+    len = end - p;
+
+    if (len + file_len + 2 <= sizeof(buf)) {
+      /* An empty entry stands for the current directory. */
+      if (len > 0) {
+        memcpy(buf, p, len);
+        buf[len++] = '/';
+      }
+      memcpy(buf + len, file, file_len + 1);
+      execve(buf, argv, envp);
+
+      if (errno == EACCES)
+        err = EACCES;
+      else if (errno != ENOENT && errno != ENOTDIR)
+        return errno;
+    }
+
+    if (*end == '\0')
+      break;
+  }
+
+  return err;
+}
+#endif
+
+
 #if !(defined(__APPLE__) && (TARGET_OS_TV || TARGET_OS_WATCH))
 /* execvp is marked __WATCHOS_PROHIBITED __TVOS_PROHIBITED, so must be
  * avoided. Since this isn't called on those targets, the function
@@ -205,7 +272,8 @@ static void uv__write_int(int fd, int val) {
 static void uv__process_child_init(const uv_process_options_t* options,
                                    int stdio_count,
                                    int (*pipes)[2],
-                                   int error_fd) {
+                                   int error_fd,
+                                   int vforked) {
   sigset_t set;
   int close_fd;
   int use_fd;
@@ -302,7 +370,7 @@ static void uv__process_child_init(const uv_process_options_t* options,
     _exit(127);
   }
 
-  if (options->env != NULL) {
+  if (options->env != NULL && !vforked) {
     environ = options->env;
   }
 
@@ -336,6 +404,16 @@ static void uv__process_child_init(const uv_process_options_t* options,
     _exit(127);
   }
 
+#if defined(UV__HAVE_VFORK)
+  if (vforked) {
+    err = uv__execvpe(options->file,
+                      options->args,
+                      options->env != NULL ? options->env : environ);
+    uv__write_int(error_fd, UV__ERR(err));
+    _exit(127);
+  }
+#endif
+
   execvp(options->file, options->args);
   uv__write_int(error_fd, UV__ERR(errno));
   _exit(127);
@@ -353,6 +431,11 @@ int uv_spawn(uv_loop_t* loop,
   int signal_pipe[2] = { -1, -1 };
   int pipes_storage[8][2];
   int (*pipes)[2];
+  int child_pipes_storage[8][2];
+  int (*child_pipes)[2];
+  int vforked;
+  sigset_t signals;
+  sigset_t saved_signals;
   int stdio_count;
   ssize_t r;
   pid_t pid;
@@ -368,7 +451,8 @@ int uv_spawn(uv_loop_t* loop,
                               UV_PROCESS_WINDOWS_HIDE |
                               UV_PROCESS_WINDOWS_HIDE_CONSOLE |
                               UV_PROCESS_WINDOWS_HIDE_GUI |
-                              UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS)));
+                              UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS |
+                              UV_PROCESS_VFORK)));
 
   uv__handle_init(loop, (uv_handle_t*)process, UV_PROCESS);
   QUEUE_INIT(&process->queue);
@@ -377,10 +461,28 @@ int uv_spawn(uv_loop_t* loop,
   if (stdio_count < 3)
     stdio_count = 3;
 
+  vforked = 0;
+#if defined(UV__HAVE_VFORK)
+  /* setuid() and setgid() are not safe in a child that shares the memory of
+   * the parent, they synchronize with the other threads of the process. */
+  if ((options->flags & UV_PROCESS_VFORK) &&
+      !(options->flags & (UV_PROCESS_SETUID | UV_PROCESS_SETGID)))
+    vforked = 1;
+#endif
+
   err = UV_ENOMEM;
   pipes = pipes_storage;
-  if (stdio_count > (int) ARRAY_SIZE(pipes_storage))
+  child_pipes = child_pipes_storage;
+  if (stdio_count > (int) ARRAY_SIZE(pipes_storage)) {
     pipes = uv__malloc(stdio_count * sizeof(*pipes));
+    if (vforked && pipes != NULL) {
+      child_pipes = uv__malloc(stdio_count * sizeof(*child_pipes));
+      if (child_pipes == NULL) {
+        uv__free(pipes);
+        pipes = NULL;
+      }
+    }
+  }
 
   if (pipes == NULL)
     goto error;
@@ -424,7 +526,29 @@ int uv_spawn(uv_loop_t* loop,
 
   /* Acquire write lock to prevent opening new fds in worker threads */
   uv_rwlock_wrlock(&loop->cloexec_lock);
-  pid = fork();
+
+  if (vforked) {
+    /* The child shares the memory of the parent until it calls execve(), so
+     * it gets its own copy of the pipes, which it changes. The signals are
+     * blocked so that the handlers of the parent do not run in the child
+     * before it has reset them. */
+    memcpy(child_pipes, pipes, stdio_count * sizeof(*pipes));
+    sigfillset(&signals);
+    pthread_sigmask(SIG_SETMASK, &signals, &saved_signals);
+    pid = vfork();
+    if (pid == 0) {
+      uv__process_child_init(options, stdio_count, child_pipes,
+                             signal_pipe[1], 1);
+      abort();
+    }
+    SAVE_ERRNO(pthread_sigmask(SIG_SETMASK, &saved_signals, NULL));
+  } else {
+    pid = fork();
+    if (pid == 0) {
+      uv__process_child_init(options, stdio_count, pipes, signal_pipe[1], 0);
+      abort();
+    }
+  }
 
   if (pid == -1) {
     err = UV__ERR(errno);
@@ -434,11 +558,6 @@ int uv_spawn(uv_loop_t* loop,
     goto error;
   }
 
-  if (pid == 0) {
-    uv__process_child_init(options, stdio_count, pipes, signal_pipe[1]);
-    abort();
-  }
-
   /* Release lock in parent process */
   uv_rwlock_wrunlock(&loop->cloexec_lock);
   uv__close(signal_pipe[1]);
@@ -488,6 +607,8 @@ int uv_spawn(uv_loop_t* loop,
 
   if (pipes != pipes_storage)
     uv__free(pipes);
+  if (child_pipes != child_pipes_storage)
+    uv__free(child_pipes);
 
   return exec_errorno;
 
@@ -507,6 +628,9 @@ error:
       uv__free(pipes);
   }
 
+  if (child_pipes != child_pipes_storage)
+    uv__free(child_pipes);
+
   return err;
 #endif
 }
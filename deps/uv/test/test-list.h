@@ -118,6 +118,7 @@ TEST_DECLARE   (tcp_connect_error_after_write)
 TEST_DECLARE   (tcp_shutdown_after_write)
 TEST_DECLARE   (tcp_bind_error_addrinuse_connect)
 TEST_DECLARE   (tcp_bind_error_addrinuse_listen)
+TEST_DECLARE   (tcp_bind_reuseport_listen)
 TEST_DECLARE   (tcp_bind_error_addrnotavail_1)
 TEST_DECLARE   (tcp_bind_error_addrnotavail_2)
 TEST_DECLARE   (tcp_bind_error_fault)
@@ -682,6 +683,7 @@ TASK_LIST_START
    */
   TEST_HELPER (tcp_bind_error_addrinuse_connect, tcp4_echo_server)
   TEST_ENTRY  (tcp_bind_error_addrinuse_listen)
+  TEST_ENTRY  (tcp_bind_reuseport_listen)
   TEST_ENTRY  (tcp_bind_error_addrnotavail_1)
   TEST_ENTRY  (tcp_bind_error_addrnotavail_2)
   TEST_ENTRY  (tcp_bind_error_fault)
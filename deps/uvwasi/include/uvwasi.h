@@ -75,6 +75,9 @@ void uvwasi_options_init(uvwasi_options_t* options);
 uvwasi_errno_t uvwasi_embedder_remap_fd(uvwasi_t* uvwasi,
                                         const uvwasi_fd_t fd,
                                         int new_host_fd);
+uvwasi_errno_t uvwasi_embedder_get_host_fd(uvwasi_t* uvwasi,
+                                           const uvwasi_fd_t fd,
+                                           int* host_fd);
 const char* uvwasi_embedder_err_code_to_string(uvwasi_errno_t code);
 
 
@@ -421,6 +421,25 @@ uvwasi_errno_t uvwasi_embedder_remap_fd(uvwasi_t* uvwasi,
 }
 
 
+uvwasi_errno_t uvwasi_embedder_get_host_fd(uvwasi_t* uvwasi,
+                                           const uvwasi_fd_t fd,
+                                           int* host_fd) {
+  struct uvwasi_fd_wrap_t* wrap;
+  uvwasi_errno_t err;
+
+  if (uvwasi == NULL || host_fd == NULL)
+    return UVWASI_EINVAL;
+
+  err = uvwasi_fd_table_get(uvwasi->fds, fd, &wrap, 0, 0);
+  if (err != UVWASI_ESUCCESS)
+    return err;
+
+  *host_fd = wrap->fd;
+  uv_mutex_unlock(&wrap->mutex);
+  return UVWASI_ESUCCESS;
+}
+
+
 uvwasi_errno_t uvwasi_args_get(uvwasi_t* uvwasi, char** argv, char* argv_buf) {
   uvwasi_size_t i;
 
@@ -2707,6 +2707,11 @@ MaybeHandle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
         compilation_cache->PutScript(source, isolate->native_context(),
                                      language_mode, inner_result);
         Handle<Script> script(Script::cast(inner_result->script()), isolate);
+        // The host-defined options are not serialized.
+        {
+          DisallowGarbageCollection no_gc;
+          SetScriptFieldsFromDetails(isolate, *script, script_details, &no_gc);
+        }
         maybe_result = inner_result;
       } else {
         // Deserializer failed. Fall through to compile.
@@ -2838,6 +2843,9 @@ MaybeHandle<JSFunction> Compiler::GetWrappedFunction(
   } else {
     is_compiled_scope = wrapped->is_compiled_scope(isolate);
     script = Handle<Script>(Script::cast(wrapped->script()), isolate);
+    // The host-defined options are not serialized.
+    DisallowGarbageCollection no_gc;
+    SetScriptFieldsFromDetails(isolate, *script, script_details, &no_gc);
   }
   DCHECK(is_compiled_scope.is_compiled());
 
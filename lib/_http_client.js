@@ -78,6 +78,11 @@ const {
 
 const { addAbortSignal, finished } = require('stream');
 
+const dc = require('diagnostics_channel');
+const onClientRequestStartChannel = dc.channel('http.client.request.start');
+const onClientResponseFinishChannel =
+  dc.channel('http.client.response.finish');
+
 const INVALID_PATH_REGEX = /[^\u0021-\u00ff]/;
 const kError = Symbol('kError');
 
@@ -288,6 +293,12 @@ function ClientRequest(input, options, cb) {
                       options.headers);
   }
 
+  if (onClientRequestStartChannel.hasSubscribers) {
+    onClientRequestStartChannel.publish({
+      request: this,
+    });
+  }
+
   // initiate connection
   if (this.agent) {
     this.agent.addRequest(this, options);
@@ -590,6 +601,12 @@ function parserOnIncomingClient(res, shouldKeepAlive) {
   }
 
   DTRACE_HTTP_CLIENT_RESPONSE(socket, req);
+  if (onClientResponseFinishChannel.hasSubscribers) {
+    onClientResponseFinishChannel.publish({
+      request: req,
+      response: res,
+    });
+  }
   req.res = res;
   res.req = req;
 
@@ -23,14 +23,21 @@
 
 const {
   ArrayPrototypePushApply,
+  FunctionPrototypeCall,
   MathMin,
   Symbol,
   RegExpPrototypeTest,
-  TypedArrayPrototypeSlice,
+  TypedArrayPrototypeSubarray,
 } = primordials;
 const { setImmediate } = require('timers');
+const { validateInteger } = require('internal/validators');
 
-const { methods, HTTPParser } = internalBinding('http_parser');
+const {
+  methods,
+  HTTPParser,
+  checkInvalidHeaderChar: nativeCheckInvalidHeaderChar,
+  checkIsHttpToken: nativeCheckIsHttpToken,
+} = internalBinding('http_parser');
 const { getOptionValue } = require('internal/options');
 const insecureHTTPParser = getOptionValue('--insecure-http-parser');
 
@@ -54,14 +61,12 @@ const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
 const kOnTimeout = HTTPParser.kOnTimeout | 0;
+const kOnRequestBatch = HTTPParser.kOnRequestBatch | 0;
 
 const MAX_HEADER_PAIRS = 2000;
 
-// Only called in the slow case where slow means
-// that the request headers were either fragmented
-// across multiple TCP packets or too large to be
-// processed in a single run. This method is also
-// called to process trailing HTTP headers.
+// Called to process trailing HTTP headers. The request headers are always
+// passed to parserOnHeadersComplete directly.
 function parserOnHeaders(headers, url) {
   // Once we exceeded headers limit - stop collecting them
   if (this.maxHeaderPairs <= 0 ||
@@ -72,12 +77,14 @@ function parserOnHeaders(headers, url) {
 }
 
 // `headers` and `url` are set only if .onHeaders() has not been called for
-// this request.
+// this request. For parsers initialized with lazy headers, `headers` is a
+// Buffer holding all header lines and `headerOffsets` a Uint32Array with the
+// end offset of every name and value in it.
 // `url` is not set for response parsers but that's not applicable here since
 // all our parsers are request parsers.
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
-                                 shouldKeepAlive) {
+                                 shouldKeepAlive, headerOffsets) {
   const parser = this;
   const { socket } = parser;
 
@@ -109,13 +116,16 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
     incoming.socket[kRequestTimeout] = undefined;
   }
 
-  let n = headers.length;
+  let n = headerOffsets !== undefined ? headerOffsets.length : headers.length;
 
   // If parser.maxHeaderPairs <= 0 assume that there's no limit.
   if (parser.maxHeaderPairs > 0)
     n = MathMin(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+  if (headerOffsets !== undefined)
+    incoming._addRawHeaderBlock(headers, headerOffsets, n);
+  else
+    incoming._addHeaderLines(headers, n);
 
   if (typeof method === 'number') {
     // server only
@@ -138,7 +148,7 @@ function parserOnBody(b, start, len) {
 
   // Pretend this was the result of a stream._read call.
   if (len > 0 && !stream._dumped) {
-    const slice = TypedArrayPrototypeSlice(b, start, start + len);
+    const slice = TypedArrayPrototypeSubarray(b, start, start + len);
     const ret = stream.push(slice);
     if (!ret)
       readStop(this.socket);
@@ -167,6 +177,22 @@ function parserOnMessageComplete() {
   readStart(parser.socket);
 }
 
+// Called by parsers in batch mode with all requests without a body that were
+// complete in one parser.execute(). `meta` holds the HTTP version, method and
+// keep-alive flag of every request, `fields` its headers, URL and, for lazy
+// headers, the header offsets.
+function parserOnRequestBatch(meta, fields) {
+  for (let i = 0, j = 0; i < meta.length; i += 4, j += 3) {
+    // The parser may have been freed by a handler of a previous request.
+    if (this.onIncoming === null)
+      return;
+    FunctionPrototypeCall(parserOnHeadersComplete, this,
+                          meta[i], meta[i + 1], fields[j], meta[i + 2],
+                          fields[j + 1], undefined, undefined, false,
+                          meta[i + 3] === 1, fields[j + 2]);
+    FunctionPrototypeCall(parserOnMessageComplete, this);
+  }
+}
 
 const parsers = new FreeList('parsers', 1000, function parsersCb() {
   const parser = new HTTPParser();
@@ -177,12 +203,29 @@ const parsers = new FreeList('parsers', 1000, function parsersCb() {
   parser[kOnHeadersComplete] = parserOnHeadersComplete;
   parser[kOnBody] = parserOnBody;
   parser[kOnMessageComplete] = parserOnMessageComplete;
+  parser[kOnRequestBatch] = parserOnRequestBatch;
 
   return parser;
 });
 
 function closeParserInstance(parser) { parser.close(); }
 
+function setMaxIdleHTTPParsers(max) {
+  validateInteger(max, 'max', 1);
+  parsers.max = max;
+  while (parsers.list.length > max)
+    closeParserInstance(parsers.list.pop());
+}
+
+function getIdleHTTPParsersStats() {
+  return {
+    idle: parsers.list.length,
+    max: parsers.max,
+    hits: parsers.hits,
+    misses: parsers.misses,
+  };
+}
+
 // Free the parser and also break any links that it
 // might have to any other things.
 // TODO: All parser data should be attached to a
@@ -213,6 +256,10 @@ function freeParser(parser, req, socket) {
   }
 }
 
+// Strings shorter than this are checked with the regular expressions below,
+// which is faster than calling into the binding for them.
+const kNativeCheckMinLength = 64;
+
 const tokenRegExp = /^[\^_`a-zA-Z\-0-9!#$%&'*+.|~]+$/;
 /**
  * Verifies that the given val is a valid HTTP token
@@ -220,6 +267,8 @@ const tokenRegExp = /^[\^_`a-zA-Z\-0-9!#$%&'*+.|~]+$/;
  * See https://tools.ietf.org/html/rfc7230#section-3.2.6
  */
 function checkIsHttpToken(val) {
+  if (typeof val === 'string' && val.length >= kNativeCheckMinLength)
+    return nativeCheckIsHttpToken(val);
   return RegExpPrototypeTest(tokenRegExp, val);
 }
 
@@ -231,6 +280,8 @@ const headerCharRegex = /[^\t\x20-\x7e\x80-\xff]/;
  *  field-vchar    = VCHAR / obs-text
  */
 function checkInvalidHeaderChar(val) {
+  if (typeof val === 'string' && val.length >= kNativeCheckMinLength)
+    return nativeCheckInvalidHeaderChar(val);
   return RegExpPrototypeTest(headerCharRegex, val);
 }
 
@@ -271,6 +322,7 @@ module.exports = {
   CRLF: '\r\n',
   debug,
   freeParser,
+  getIdleHTTPParsersStats,
   methods,
   parsers,
   kIncomingMessage,
@@ -278,4 +330,5 @@ module.exports = {
   HTTPParser,
   isLenient,
   prepareError,
+  setMaxIdleHTTPParsers,
 };
@@ -22,6 +22,7 @@
 'use strict';
 
 const {
+  Array,
   ArrayPrototypePush,
   FunctionPrototypeCall,
   ObjectDefineProperty,
@@ -36,6 +37,9 @@ const { Readable, finished } = require('stream');
 
 const kHeaders = Symbol('kHeaders');
 const kHeadersCount = Symbol('kHeadersCount');
+const kRawHeaders = Symbol('kRawHeaders');
+const kRawHeaderBlock = Symbol('kRawHeaderBlock');
+const kRawHeaderOffsets = Symbol('kRawHeaderOffsets');
 const kTrailers = Symbol('kTrailers');
 const kTrailersCount = Symbol('kTrailersCount');
 
@@ -71,7 +75,9 @@ function IncomingMessage(socket) {
   this.complete = false;
   this[kHeaders] = null;
   this[kHeadersCount] = 0;
-  this.rawHeaders = [];
+  this[kRawHeaders] = [];
+  this[kRawHeaderBlock] = null;
+  this[kRawHeaderOffsets] = null;
   this[kTrailers] = null;
   this[kTrailersCount] = 0;
   this.rawTrailers = [];
@@ -106,6 +112,46 @@ ObjectDefineProperty(IncomingMessage.prototype, 'connection', {
   }
 });
 
+// With the `lazyHeaders` server option, the parser hands over the request
+// headers as a single Buffer of `name: value\r\n` lines together with the end
+// offsets of every name and value. Strings are only created once
+// `rawHeaders` or `headers` is accessed.
+ObjectDefineProperty(IncomingMessage.prototype, 'rawHeaders', {
+  get: function() {
+    if (this[kRawHeaders] === null) {
+      const block = this[kRawHeaderBlock];
+      const offsets = this[kRawHeaderOffsets];
+      const n = this[kHeadersCount];
+      const raw = new Array(n);
+      let start = 0;
+      for (let i = 0; i < n; i++) {
+        raw[i] = block.latin1Slice(start, offsets[i]);
+        start = offsets[i] + 2;
+      }
+      this[kRawHeaders] = raw;
+    }
+    return this[kRawHeaders];
+  },
+  set: function(val) {
+    this[kRawHeaders] = val;
+  },
+  enumerable: true,
+  configurable: true
+});
+
+ObjectDefineProperty(IncomingMessage.prototype, 'rawHeadersBuffer', {
+  get: function() {
+    const block = this[kRawHeaderBlock];
+    if (block === null)
+      return null;
+    const n = this[kHeadersCount];
+    const offsets = this[kRawHeaderOffsets];
+    if (n === offsets.length)
+      return block;
+    return block.subarray(0, n > 0 ? offsets[n - 1] + 2 : 0);
+  }
+});
+
 ObjectDefineProperty(IncomingMessage.prototype, 'headers', {
   get: function() {
     if (!this[kHeaders]) {
@@ -193,6 +239,47 @@ IncomingMessage.prototype._destroy = function _destroy(err, cb) {
   }
 };
 
+IncomingMessage.prototype._addRawHeaderBlock = _addRawHeaderBlock;
+function _addRawHeaderBlock(block, offsets, n) {
+  this[kRawHeaderBlock] = block;
+  this[kRawHeaderOffsets] = offsets;
+  this[kRawHeaders] = null;
+  this[kHeadersCount] = n;
+}
+
+// Look up a single request header, joined like in `message.headers`, without
+// decoding all other headers when they are still in their raw form.
+function getHeaderValue(msg, name) {
+  if (msg[kHeaders] || msg[kRawHeaders] !== null)
+    return msg.headers[name];
+
+  const block = msg[kRawHeaderBlock];
+  const offsets = msg[kRawHeaderOffsets];
+  const n = msg[kHeadersCount];
+  const len = name.length;
+  let value;
+  let start = 0;
+  for (let i = 0; i < n; i += 2) {
+    const end = offsets[i];
+    if (end - start === len && matchesLowerCase(block, start, name)) {
+      const str = block.latin1Slice(end + 2, offsets[i + 1]);
+      value = value === undefined ? str : `${value}, ${str}`;
+    }
+    start = offsets[i + 1] + 2;
+  }
+  return value;
+}
+
+function matchesLowerCase(block, start, name) {
+  for (let i = 0; i < name.length; i++) {
+    // `name` only consists of lowercase letters, so ORing in 0x20 is enough
+    // to fold the case of the received bytes.
+    if ((block[start + i] | 0x20) !== StringPrototypeCharCodeAt(name, i))
+      return false;
+  }
+  return true;
+}
+
 IncomingMessage.prototype._addHeaderLines = _addHeaderLines;
 function _addHeaderLines(headers, n) {
   if (headers && headers.length) {
@@ -381,6 +468,7 @@ function onError(self, error, cb) {
 
 module.exports = {
   IncomingMessage,
+  getHeaderValue,
   readStart,
   readStop
 };
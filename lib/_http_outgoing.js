@@ -50,6 +50,7 @@ const { Stream, Writable } = require('stream');
 const internalUtil = require('internal/util');
 const { kOutHeaders, utcDate } = require('internal/http');
 const { Buffer } = require('buffer');
+const { serializeMessage } = internalBinding('http_parser');
 const common = require('_http_common');
 const checkIsHttpToken = common._checkIsHttpToken;
 const checkInvalidHeaderChar = common._checkInvalidHeaderChar;
@@ -83,6 +84,11 @@ const HIGH_WATER_MARK = getDefaultHighWaterMark();
 const { CRLF, debug } = common;
 
 const kCorked = Symbol('kCorked');
+const kLastChunkSent = Symbol('kLastChunkSent');
+
+// Bodies passed to end() up to this size are serialized together with the
+// message head into a single Buffer.
+const kMaxSerializedBodyLength = 16 * 1024;
 
 const nop = FunctionPrototype;
 
@@ -125,6 +131,7 @@ function OutgoingMessage(opts) {
 
   this._headerSent = false;
   this[kCorked] = 0;
+  this[kLastChunkSent] = false;
 
   this.socket = null;
   this._header = null;
@@ -779,6 +786,12 @@ function write_(msg, chunk, encoding, callback, fromEnd) {
     return true;
   }
 
+  if (fromEnd && len <= kMaxSerializedBodyLength && !msg._headerSent) {
+    const ret = sendSerialized(msg, chunk, encoding, len, callback);
+    if (ret !== undefined)
+      return ret;
+  }
+
   if (!fromEnd && !state.corked) {
     msg.cork();
     process.nextTick(uncorkNT, msg);
@@ -803,6 +816,34 @@ function uncorkNT(msg) {
   msg.uncork();
 }
 
+// Write the pending head, the whole body and, for chunked messages, the
+// last chunk in one go. Returns undefined if the message cannot be written
+// to its socket directly, in which case the regular path has to be taken.
+function sendSerialized(msg, chunk, encoding, len, callback) {
+  const conn = msg.socket;
+  // Subclasses may not store a head, e.g. with their own _implicitHeader().
+  if (typeof msg._header !== 'string' ||
+      !conn || conn._httpMessage !== msg || !conn.writable ||
+      conn.destroyed || msg.outputData.length !== 0) {
+    return;
+  }
+
+  // Encode the head the same way _send() would when prepending it.
+  let headEncoding = 'latin1';
+  if (typeof chunk === 'string') {
+    if (encoding && encoding !== 'utf8' && encoding !== 'latin1')
+      return;
+    headEncoding = encoding || 'utf8';
+  }
+
+  const chunked = msg.chunkedEncoding === true;
+  const data = serializeMessage(msg._header, headEncoding, chunk, encoding,
+                                len, chunked, msg._trailer);
+  msg._headerSent = true;
+  msg[kLastChunkSent] = chunked;
+  return conn.write(data, callback);
+}
+
 
 OutgoingMessage.prototype.addTrailers = function addTrailers(headers) {
   this._trailer = '';
@@ -883,7 +924,7 @@ OutgoingMessage.prototype.end = function end(chunk, encoding, callback) {
 
     state.finalCalled = true;
 
-    if (this._hasBody && this.chunkedEncoding) {
+    if (this._hasBody && this.chunkedEncoding && !this[kLastChunkSent]) {
       this._send('0\r\n' + this._trailer + '\r\n', 'latin1', finish);
     } else {
       // Force a flush, HACK.
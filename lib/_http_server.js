@@ -65,7 +65,7 @@ const {
   defaultTriggerAsyncIdScope,
   getOrSetAsyncId
 } = require('internal/async_hooks');
-const { IncomingMessage } = require('_http_incoming');
+const { IncomingMessage, getHeaderValue } = require('_http_incoming');
 const {
   connResetException,
   codes
@@ -88,13 +88,22 @@ const {
   DTRACE_HTTP_SERVER_REQUEST,
   DTRACE_HTTP_SERVER_RESPONSE
 } = require('internal/dtrace');
-const { setTimeout, clearTimeout } = require('timers');
+const {
+  setTimeout,
+  clearTimeout,
+  setInterval,
+  clearInterval,
+} = require('timers');
+const { ConnectionsList } = internalBinding('http_parser');
 
 const dc = require('diagnostics_channel');
 const onRequestStartChannel = dc.channel('http.server.request.start');
 const onResponseFinishChannel = dc.channel('http.server.response.finish');
 
 const kServerResponse = Symbol('ServerResponse');
+const kConnections = Symbol('http.server.connections');
+const kConnectionsCheckingInterval =
+  Symbol('http.server.connectionsCheckingInterval');
 const kServerResponseStatistics = Symbol('ServerResponseStatistics');
 
 const STATUS_CODES = {
@@ -185,8 +194,8 @@ function ServerResponse(req) {
   this._expect_continue = false;
 
   if (req.httpVersionMajor < 1 || req.httpVersionMinor < 1) {
-    this.useChunkedEncodingByDefault = RegExpPrototypeTest(chunkExpression,
-                                                           req.headers.te);
+    this.useChunkedEncodingByDefault =
+      RegExpPrototypeTest(chunkExpression, getHeaderValue(req, 'te'));
     this.shouldKeepAlive = false;
   }
 
@@ -369,6 +378,21 @@ function Server(options, requestListener) {
     validateBoolean(insecureHTTPParser, 'options.insecureHTTPParser');
   this.insecureHTTPParser = insecureHTTPParser;
 
+  const lazyHeaders = options.lazyHeaders;
+  if (lazyHeaders !== undefined)
+    validateBoolean(lazyHeaders, 'options.lazyHeaders');
+  this.lazyHeaders = lazyHeaders;
+
+  const connectionsCheckingInterval = options.connectionsCheckingInterval;
+  if (connectionsCheckingInterval !== undefined) {
+    validateInteger(connectionsCheckingInterval,
+                    'options.connectionsCheckingInterval', 0);
+  }
+  this.connectionsCheckingInterval = connectionsCheckingInterval;
+  this[kConnections] = connectionsCheckingInterval > 0 ?
+    new ConnectionsList() : null;
+  this[kConnectionsCheckingInterval] = null;
+
   FunctionPrototypeCall(net.Server, this, { allowHalfOpen: true });
 
   if (requestListener) {
@@ -381,6 +405,8 @@ function Server(options, requestListener) {
   this.httpAllowHalfOpen = false;
 
   this.on('connection', connectionListener);
+  if (this[kConnections] !== null)
+    this.on('listening', setupConnectionsTracking);
 
   this.timeout = 0;
   this.keepAliveTimeout = 5000;
@@ -392,6 +418,12 @@ ObjectSetPrototypeOf(Server.prototype, net.Server.prototype);
 ObjectSetPrototypeOf(Server, net.Server);
 
 
+Server.prototype.close = function close() {
+  clearInterval(this[kConnectionsCheckingInterval]);
+  this[kConnectionsCheckingInterval] = null;
+  return ReflectApply(net.Server.prototype.close, this, arguments);
+};
+
 Server.prototype.setTimeout = function setTimeout(msecs, callback) {
   this.timeout = msecs;
   if (callback)
@@ -450,7 +482,13 @@ function connectionListenerInternal(server, socket) {
     server.maxHeaderSize || 0,
     server.insecureHTTPParser === undefined ?
       isLenient() : server.insecureHTTPParser,
-    server.headersTimeout || 0,
+    // With connection tracking, the headers timeout is checked by the
+    // connections list instead of on every parser.execute().
+    server[kConnections] ? 0 : server.headersTimeout || 0,
+    server.lazyHeaders === true,
+    server[kConnections],
+    // Deliver pipelined requests without a body in batches.
+    true,
   );
   parser.socket = socket;
   socket.parser = parser;
@@ -515,16 +553,20 @@ function connectionListenerInternal(server, socket) {
     FunctionPrototypeBind(onParserTimeout, undefined,
                           server, socket);
 
-  // When receiving new requests on the same socket (pipelining or keep alive)
-  // make sure the requestTimeout is active.
-  parser[kOnMessageBegin] =
-    FunctionPrototypeBind(setRequestTimeout, undefined,
-                          server, socket);
+  // The native connections list takes care of the request timeout if the
+  // server tracks its connections.
+  if (!server[kConnections]) {
+    // When receiving new requests on the same socket (pipelining or keep
+    // alive) make sure the requestTimeout is active.
+    parser[kOnMessageBegin] =
+      FunctionPrototypeBind(setRequestTimeout, undefined,
+                            server, socket);
 
-  // This protects from DOS attack where an attacker establish the connection
-  // without sending any data on applications where server.timeout is left to
-  // the default value of zero.
-  setRequestTimeout(server, socket);
+    // This protects from DOS attack where an attacker establish the
+    // connection without sending any data on applications where
+    // server.timeout is left to the default value of zero.
+    setRequestTimeout(server, socket);
+  }
 
   socket._paused = false;
 }
@@ -622,6 +664,38 @@ function onParserExecute(server, socket, parser, state, ret) {
   onParserExecuteCommon(server, socket, parser, state, ret, undefined);
 }
 
+function setupConnectionsTracking() {
+  clearInterval(this[kConnectionsCheckingInterval]);
+  this[kConnectionsCheckingInterval] =
+    setInterval(checkConnections, this.connectionsCheckingInterval, this)
+    .unref();
+}
+
+// Expire the connections that ran into one of the server's timeouts, using
+// the same handling as the per-socket timers used without connection
+// tracking.
+function checkConnections(server) {
+  const expired = server[kConnections].expired(server.headersTimeout || 0,
+                                               server.requestTimeout || 0,
+                                               server.keepAliveTimeout || 0);
+  for (let i = 0; i < expired.length; i += 2) {
+    const socket = expired[i].socket;
+    if (!socket)
+      continue;
+    switch (expired[i + 1]) {
+      case ConnectionsList.kHeadersTimeout:
+        onParserTimeout(server, socket);
+        break;
+      case ConnectionsList.kRequestTimeout:
+        onRequestTimeout(socket);
+        break;
+      case ConnectionsList.kKeepAliveTimeout:
+        FunctionPrototypeCall(socketOnTimeout, socket);
+        break;
+    }
+  }
+}
+
 function onParserTimeout(server, socket) {
   const serverTimeout = server.emit('timeout', socket);
 
@@ -711,7 +785,7 @@ function onParserExecuteCommon(server, socket, parser, state, ret, d) {
       // Got CONNECT method, but have no handler.
       socket.destroy();
     }
-  } else {
+  } else if (!server[kConnections]) {
     // When receiving new requests on the same socket (pipelining or keep alive)
     // make sure the requestTimeout is active.
     parser[kOnMessageBegin] =
@@ -805,7 +879,11 @@ function resOnFinish(req, res, socket, state, server) {
       socket.end();
     }
   } else if (state.outgoing.length === 0) {
-    if (server.keepAliveTimeout && typeof socket.setTimeout === 'function') {
+    if (server[kConnections]) {
+      if (state.incoming.length === 0 && socket.parser)
+        socket.parser.markIdle();
+    } else if (server.keepAliveTimeout &&
+               typeof socket.setTimeout === 'function') {
       socket.setTimeout(server.keepAliveTimeout);
       state.keepAliveTimeoutSet = true;
     }
@@ -877,9 +955,10 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
          FunctionPrototypeBind(resOnFinish, undefined,
                                req, res, socket, state, server));
 
-  if (req.headers.expect !== undefined &&
+  const expect = getHeaderValue(req, 'expect');
+  if (expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
-    if (RegExpPrototypeTest(continueExpression, req.headers.expect)) {
+    if (RegExpPrototypeTest(continueExpression, expect)) {
       res._expect_continue = true;
 
       if (server.listenerCount('checkContinue') > 0) {
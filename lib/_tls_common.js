@@ -28,6 +28,7 @@ const {
   ArrayPrototypeJoin,
   ArrayPrototypePush,
   ObjectCreate,
+  RegExpPrototypeTest,
   StringPrototypeReplace,
   StringPrototypeSplit,
   StringPrototypeStartsWith,
@@ -38,6 +39,7 @@ const { isArrayBufferView } = require('internal/util/types');
 const tls = require('tls');
 const {
   ERR_CRYPTO_CUSTOM_ENGINE_NOT_SUPPORTED,
+  ERR_FEATURE_UNAVAILABLE_ON_PLATFORM,
   ERR_INVALID_ARG_TYPE,
   ERR_INVALID_ARG_VALUE,
   ERR_TLS_INVALID_PROTOCOL_VERSION,
@@ -52,6 +54,8 @@ const {
 } = internalBinding('constants').crypto;
 
 const {
+  validateBoolean,
+  validateObject,
   validateString,
   validateInteger,
   validateInt32,
@@ -70,6 +74,9 @@ function toV(which, v, def) {
   throw new ERR_TLS_INVALID_PROTOCOL_VERSION(v, which);
 }
 
+const isWindows = process.platform === 'win32';
+const kDefaultSessionStoreSize = 1024;
+
 const { SecureContext: NativeSecureContext } = internalBinding('crypto');
 function SecureContext(secureProtocol, secureOptions, minVersion, maxVersion) {
   if (!(this instanceof SecureContext)) {
@@ -161,6 +168,7 @@ exports.createSecureContext = function createSecureContext(options) {
   if (!options) options = {};
 
   const {
+    asyncPrivateKey,
     ca,
     cert,
     ciphers,
@@ -178,6 +186,7 @@ exports.createSecureContext = function createSecureContext(options) {
     privateKeyEngine,
     secureProtocol,
     sessionIdContext,
+    sessionStore,
     sessionTimeout,
     sigalgs,
     singleUse,
@@ -354,6 +363,24 @@ exports.createSecureContext = function createSecureContext(options) {
     c.context.setClientCertEngine(clientCertEngine);
   }
 
+  // The shared store provides the initial ticket keys, so that explicit
+  // ticketKeys take precedence over (and are shared through) the store.
+  if (sessionStore !== undefined) {
+    if (isWindows)
+      throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('options.sessionStore');
+    validateObject(sessionStore, 'options.sessionStore');
+    const { name, size = kDefaultSessionStoreSize } = sessionStore;
+    validateString(name, 'options.sessionStore.name');
+    if (!RegExpPrototypeTest(/^[\w.-]{1,20}$/, name)) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'options.sessionStore.name',
+        name,
+        'must be 1 to 20 letters, digits, "_", "-" or "."');
+    }
+    validateInteger(size, 'options.sessionStore.size', 1, 2 ** 20);
+    c.context.setSessionStore(name, size);
+  }
+
   if (ticketKeys !== undefined) {
     if (!isArrayBufferView(ticketKeys)) {
       throw new ERR_INVALID_ARG_TYPE(
@@ -375,6 +402,13 @@ exports.createSecureContext = function createSecureContext(options) {
     c.context.setSessionTimeout(sessionTimeout);
   }
 
+  // This has to come last, it applies to the keys that were set above.
+  if (asyncPrivateKey !== undefined) {
+    validateBoolean(asyncPrivateKey, 'options.asyncPrivateKey');
+    if (asyncPrivateKey)
+      c.context.enableAsyncPrivateKey();
+  }
+
   return c;
 };
 
@@ -1342,6 +1342,10 @@ Server.prototype.setSecureContext = function(options) {
   if (options.ticketKeys)
     this.ticketKeys = options.ticketKeys;
 
+  this.sessionStore = options.sessionStore;
+
+  this.asyncPrivateKey = options.asyncPrivateKey;
+
   this.privateKeyIdentifier = options.privateKeyIdentifier;
   this.privateKeyEngine = options.privateKeyEngine;
 
@@ -1363,6 +1367,8 @@ Server.prototype.setSecureContext = function(options) {
     honorCipherOrder: this.honorCipherOrder,
     crl: this.crl,
     sessionIdContext: this.sessionIdContext,
+    sessionStore: this.sessionStore,
+    asyncPrivateKey: this.asyncPrivateKey,
     ticketKeys: this.ticketKeys,
     sessionTimeout: this.sessionTimeout,
     privateKeyIdentifier: this.privateKeyIdentifier,
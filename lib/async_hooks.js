@@ -23,6 +23,10 @@ const {
   validateString,
 } = require('internal/validators');
 const internal_async_hooks = require('internal/async_hooks');
+const {
+  AsyncContextFrame,
+  kContextFrame,
+} = require('internal/async_context_frame');
 
 // Get functions
 // For userland AsyncResources, make sure to emit a destroy event when the
@@ -173,6 +177,7 @@ class AsyncResource {
     const asyncId = newAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
+    this[kContextFrame] = AsyncContextFrame.current();
 
     if (initHooksExist()) {
       if (enabledHooksExist() && type.length === 0) {
@@ -194,12 +199,18 @@ class AsyncResource {
     const asyncId = this[async_id_symbol];
     emitBefore(asyncId, this[trigger_async_id_symbol], this);
 
+    let priorContextFrame;
+    if (AsyncContextFrame.enabled)
+      priorContextFrame = AsyncContextFrame.exchange(this[kContextFrame]);
+
     try {
       const ret =
         ReflectApply(fn, thisArg, args);
 
       return ret;
     } finally {
+      if (AsyncContextFrame.enabled)
+        AsyncContextFrame.set(priorContextFrame);
       if (hasAsyncIdStack())
         emitAfter(asyncId);
     }
@@ -273,6 +284,8 @@ class AsyncLocalStorage {
   disable() {
     if (this.enabled) {
       this.enabled = false;
+      if (AsyncContextFrame.enabled)
+        return;
       // If this.enabled, the instance must be in storageList
       ArrayPrototypeSplice(storageList,
                            ArrayPrototypeIndexOf(storageList, this), 1);
@@ -285,6 +298,8 @@ class AsyncLocalStorage {
   _enable() {
     if (!this.enabled) {
       this.enabled = true;
+      if (AsyncContextFrame.enabled)
+        return;
       ArrayPrototypePush(storageList, this);
       storageHook.enable();
     }
@@ -300,6 +315,10 @@ class AsyncLocalStorage {
 
   enterWith(store) {
     this._enable();
+    if (AsyncContextFrame.enabled) {
+      AsyncContextFrame.set(new AsyncContextFrame(this, store));
+      return;
+    }
     const resource = executionAsyncResource();
     resource[this.kResourceStore] = store;
   }
@@ -309,6 +328,16 @@ class AsyncLocalStorage {
     if (ObjectIs(store, this.getStore())) {
       return ReflectApply(callback, null, args);
     }
+    if (AsyncContextFrame.enabled) {
+      const prior = AsyncContextFrame.exchange(
+        new AsyncContextFrame(this, store));
+      this._enable();
+      try {
+        return ReflectApply(callback, null, args);
+      } finally {
+        AsyncContextFrame.set(prior);
+      }
+    }
     const resource = new AsyncResource('AsyncLocalStorage',
                                        defaultAlsResourceOpts);
     // Calling emitDestroy before runInAsyncScope avoids a try/finally
@@ -323,6 +352,12 @@ class AsyncLocalStorage {
     if (!this.enabled) {
       return ReflectApply(callback, null, args);
     }
+    // The frames that the callback captures must not have the store either,
+    // which disabling the storage for the duration of the callback would not
+    // achieve.
+    if (AsyncContextFrame.enabled) {
+      return ReflectApply(this.run, this, [undefined, callback, ...args]);
+    }
     this.disable();
     try {
       return ReflectApply(callback, null, args);
@@ -333,6 +368,10 @@ class AsyncLocalStorage {
 
   getStore() {
     if (this.enabled) {
+      if (AsyncContextFrame.enabled) {
+        const frame = AsyncContextFrame.current();
+        return frame === undefined ? undefined : frame.get(this);
+      }
       const resource = executionAsyncResource();
       return resource[this.kResourceStore];
     }
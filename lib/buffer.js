@@ -54,11 +54,13 @@ const {
   byteLengthUtf8,
   compare: _compare,
   compareOffset,
+  concat: _concat,
   createFromString,
   fill: bindingFill,
   indexOfBuffer,
   indexOfNumber,
   indexOfString,
+  parseJSON: _parseJSON,
   swap16: _swap16,
   swap32: _swap32,
   swap64: _swap64,
@@ -511,6 +513,29 @@ Buffer.isBuffer = function isBuffer(b) {
   return b instanceof Buffer;
 };
 
+// Calling into C++ costs more than comparing a few bytes, so short Buffers
+// are compared here instead.
+const kMaxInlineCompareLength = 16;
+
+function compareInline(a, b) {
+  const length = MathMin(a.length, b.length);
+  for (let i = 0; i < length; i++) {
+    if (a[i] !== b[i])
+      return a[i] < b[i] ? -1 : 1;
+  }
+  if (a.length === b.length)
+    return 0;
+  return a.length < b.length ? -1 : 1;
+}
+
+function compareBuffers(a, b) {
+  if (a.length <= kMaxInlineCompareLength &&
+      b.length <= kMaxInlineCompareLength) {
+    return compareInline(a, b);
+  }
+  return _compare(a, b);
+}
+
 Buffer.compare = function compare(buf1, buf2) {
   if (!isUint8Array(buf1)) {
     throw new ERR_INVALID_ARG_TYPE('buf1', ['Buffer', 'Uint8Array'], buf1);
@@ -524,7 +549,7 @@ Buffer.compare = function compare(buf1, buf2) {
     return 0;
   }
 
-  return _compare(buf1, buf2);
+  return compareBuffers(buf1, buf2);
 };
 
 Buffer.isEncoding = function isEncoding(encoding) {
@@ -550,6 +575,17 @@ Buffer.concat = function concat(list, length) {
     validateOffset(length, 'length');
   }
 
+  // Results that do not come from the pool are put together natively, which
+  // copies all elements in one call.
+  if (length >= (Buffer.poolSize >>> 1)) {
+    const buffer = _concat(list, length);
+    if (typeof buffer === 'number') {
+      throw new ERR_INVALID_ARG_TYPE(
+        `list[${buffer}]`, ['Buffer', 'Uint8Array'], list[buffer]);
+    }
+    return buffer;
+  }
+
   const buffer = Buffer.allocUnsafe(length);
   let pos = 0;
   for (let i = 0; i < list.length; i++) {
@@ -824,7 +860,7 @@ Buffer.prototype.equals = function equals(otherBuffer) {
   if (this.byteLength !== otherBuffer.byteLength)
     return false;
 
-  return this.byteLength === 0 || _compare(this, otherBuffer) === 0;
+  return this.byteLength === 0 || compareBuffers(this, otherBuffer) === 0;
 };
 
 let INSPECT_MAX_BYTES = 50;
@@ -872,7 +908,7 @@ Buffer.prototype.compare = function compare(target,
     throw new ERR_INVALID_ARG_TYPE('target', ['Buffer', 'Uint8Array'], target);
   }
   if (arguments.length === 1)
-    return _compare(this, target);
+    return compareBuffers(this, target);
 
   if (targetStart === undefined)
     targetStart = 0;
@@ -1180,6 +1216,17 @@ Buffer.prototype.swap64 = function swap64() {
 
 Buffer.prototype.toLocaleString = Buffer.prototype.toString;
 
+// Parses UTF-8 encoded JSON text without converting all of it to a string
+// first.
+function parseJSON(source) {
+  if (!isArrayBufferView(source)) {
+    throw new ERR_INVALID_ARG_TYPE('source',
+                                   ['Buffer', 'TypedArray', 'DataView'],
+                                   source);
+  }
+  return _parseJSON(source);
+}
+
 let transcode;
 if (internalBinding('config').hasIntl) {
   const {
@@ -1214,6 +1261,7 @@ if (internalBinding('config').hasIntl) {
 module.exports = {
   Blob,
   Buffer,
+  parseJSON,
   SlowBuffer,
   transcode,
   // Legacy
@@ -258,6 +258,7 @@ function execFile(file /* , args, options, callback */) {
     shell: options.shell,
     signal: options.signal,
     uid: options.uid,
+    vfork: !!options.vfork,
     windowsHide: !!options.windowsHide,
     windowsVerbatimArguments: !!options.windowsVerbatimArguments
   });
@@ -485,6 +486,12 @@ function normalizeSpawnArguments(file, args, options) {
     validateString(options.argv0, 'options.argv0');
   }
 
+  // Validate vfork, if present.
+  if (options.vfork != null &&
+      typeof options.vfork !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE('options.vfork', 'boolean', options.vfork);
+  }
+
   // Validate windowsHide, if present.
   if (options.windowsHide != null &&
       typeof options.windowsHide !== 'boolean') {
@@ -580,6 +587,7 @@ function normalizeSpawnArguments(file, args, options) {
     detached: !!options.detached,
     envPairs,
     file,
+    vfork: !!options.vfork,
     windowsHide: !!options.windowsHide,
     windowsVerbatimArguments: !!windowsVerbatimArguments
   };
@@ -89,6 +89,8 @@ const {
   diffieHellman
 } = require('internal/crypto/diffiehellman');
 const {
+  aeadOpen,
+  aeadSeal,
   Cipher,
   Cipheriv,
   Decipher,
@@ -103,11 +105,13 @@ const {
   Sign,
   signOneShot,
   Verify,
+  verifyBatch,
   verifyOneShot
 } = require('internal/crypto/sig');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hash,
 } = require('internal/crypto/hash');
 const {
   X509Certificate
@@ -117,6 +121,7 @@ const {
   getCurves,
   getDefaultEncoding,
   getHashes,
+  getKeyDerivationQueueStats,
   setDefaultEncoding,
   setEngine,
   lazyRequire,
@@ -172,6 +177,8 @@ function createVerify(algorithm, options) {
 
 module.exports = {
   // Methods
+  aeadOpen,
+  aeadSeal,
   checkPrime,
   checkPrimeSync,
   createCipheriv,
@@ -194,6 +201,8 @@ module.exports = {
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  getKeyDerivationQueueStats,
+  hash,
   hkdf,
   hkdfSync,
   pbkdf2,
@@ -219,6 +228,7 @@ module.exports = {
   getFips: fipsForced ? getFipsForced : getFipsCrypto,
   setFips: fipsForced ? setFipsForced : setFipsCrypto,
   verify: verifyOneShot,
+  verifyBatch,
 
   // Classes
   Certificate,
@@ -27,6 +27,8 @@ const {
   ArrayPrototypePush,
   FunctionPrototypeBind,
   FunctionPrototypeCall,
+  MathMax,
+  MathMin,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
   ReflectApply,
@@ -40,7 +42,9 @@ const {
 } = require('internal/dgram');
 const { guessHandleType } = internalBinding('util');
 const {
+  ERR_FEATURE_UNAVAILABLE_ON_PLATFORM,
   ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_ARG_VALUE,
   ERR_MISSING_ARGS,
   ERR_SOCKET_ALREADY_BOUND,
   ERR_SOCKET_BAD_BUFFER_SIZE,
@@ -53,10 +57,17 @@ const {
 const {
   isInt32,
   validateAbortSignal,
+  validateArray,
+  validateBoolean,
+  validateFunction,
+  validateInteger,
+  validateObject,
   validateString,
   validateNumber,
   validatePort,
+  validateUint32,
 } = require('internal/validators');
+const { isIP } = require('internal/net');
 const { Buffer } = require('buffer');
 const { deprecate } = require('internal/util');
 const { isArrayBufferView } = require('internal/util/types');
@@ -96,6 +107,9 @@ function Socket(type, listener) {
   let lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let udpSegmentSize;
+  let udpGro;
+  let recvBatchSize;
 
   let options;
   if (type !== null && typeof type === 'object') {
@@ -104,9 +118,26 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    udpSegmentSize = options.udpSegmentSize;
+    udpGro = options.udpGro;
+    recvBatchSize = options.recvBatchSize;
+
+    // UDP_SEGMENT and UDP_GRO are Linux-specific, see udp(7).
+    if (udpSegmentSize !== undefined) {
+      validateInteger(udpSegmentSize, 'options.udpSegmentSize', 1, 65535);
+      if (process.platform !== 'linux')
+        throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('options.udpSegmentSize');
+    }
+    if (udpGro !== undefined) {
+      validateBoolean(udpGro, 'options.udpGro');
+      if (udpGro && process.platform !== 'linux')
+        throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('options.udpGro');
+    }
+    if (recvBatchSize !== undefined)
+      validateUint32(recvBatchSize, 'options.recvBatchSize', true);
   }
 
-  const handle = newHandle(type, lookup);
+  const handle = newHandle(type, lookup, recvBatchSize);
   handle[owner_symbol] = this;
 
   this[async_id_symbol] = handle.getAsyncId();
@@ -124,7 +155,9 @@ function Socket(type, listener) {
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
     ipv6Only: options && options.ipv6Only,
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    udpSegmentSize,
+    udpGro,
   };
 
   if (options?.signal !== undefined) {
@@ -154,6 +187,21 @@ function startListening(socket) {
   const state = socket[kStateSymbol];
 
   state.handle.onmessage = onMessage;
+
+  // Must happen before recvStart(), which sets up receiving differently when
+  // GRO is enabled.
+  if (state.udpGro) {
+    const err = state.handle.setUDPGro(true);
+    if (err)
+      throw errnoException(err, 'setUDPGro');
+  }
+
+  if (state.udpSegmentSize) {
+    const err = state.handle.setUDPSegment(state.udpSegmentSize);
+    if (err)
+      throw errnoException(err, 'setUDPSegment');
+  }
+
   // Todo: handle errors
   state.handle.recvStart();
   state.receiving = true;
@@ -176,6 +224,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = oldHandle.lookup;
   newHandle.bind = oldHandle.bind;
   newHandle.send = oldHandle.send;
+  newHandle.sendBatch = oldHandle.sendBatch;
   newHandle[owner_symbol] = self;
 
   // Replace the existing handle by the handle we got from primary.
@@ -725,6 +774,142 @@ function afterSend(err, sent) {
   this.callback(err, sent);
 }
 
+
+// sendBatch(messages[, callback])
+// Each message is an object { msg, port, address } for connectionless
+// sockets, or { msg } for connected ones. All batches started during the
+// same tick are handed to the kernel together, using sendmmsg() on Linux.
+Socket.prototype.sendBatch = function(messages, callback) {
+  validateArray(messages, 'messages');
+  if (callback !== undefined)
+    validateFunction(callback, 'callback');
+
+  const state = this[kStateSymbol];
+  const connected = state.connectState === CONNECT_STATE_CONNECTED;
+  const list = new Array(messages.length * 3);
+
+  for (let i = 0; i < messages.length; i++) {
+    const message = messages[i];
+    validateObject(message, `messages[${i}]`);
+    const { address } = message;
+    let { msg, port } = message;
+
+    if (typeof msg === 'string') {
+      msg = Buffer.from(msg);
+    } else if (!isArrayBufferView(msg)) {
+      throw new ERR_INVALID_ARG_TYPE(`messages[${i}].msg`,
+                                     ['Buffer',
+                                      'TypedArray',
+                                      'DataView',
+                                      'string'],
+                                     msg);
+    }
+
+    if (connected) {
+      if (port !== undefined || address !== undefined)
+        throw new ERR_SOCKET_DGRAM_IS_CONNECTED();
+    } else {
+      port = validatePort(port, `messages[${i}].port`, { allowZero: false });
+      validateString(address, `messages[${i}].address`);
+      // Resolving host names one datagram at a time would defeat the purpose.
+      if (isIP(address) === 0) {
+        throw new ERR_INVALID_ARG_VALUE(`messages[${i}].address`, address,
+                                        'must be an IP address');
+      }
+    }
+
+    list[3 * i] = msg;
+    list[3 * i + 1] = port;
+    list[3 * i + 2] = address;
+  }
+
+  healthCheck(this);
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (state.batch === undefined) {
+    state.batch = { list: [], calls: [] };
+    process.nextTick(flushBatch, this);
+  }
+
+  const batch = state.batch;
+  ArrayPrototypePush(batch.calls, {
+    start: batch.list.length / 3,
+    count: messages.length,
+    callback,
+  });
+  for (let i = 0; i < list.length; i++)
+    ArrayPrototypePush(batch.list, list[i]);
+};
+
+function flushBatch(self) {
+  const state = self[kStateSymbol];
+  const batch = state.batch;
+  state.batch = undefined;
+
+  // If the socket hasn't been bound yet, send the batch once that is done.
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(self, FunctionPrototypeBind(flushBatchAfterBind, self, batch));
+    return;
+  }
+
+  defaultTriggerAsyncIdScope(self[async_id_symbol], doSendBatch, self, batch);
+}
+
+function flushBatchAfterBind(batch) {
+  defaultTriggerAsyncIdScope(this[async_id_symbol], doSendBatch, this, batch);
+}
+
+function doSendBatch(self, batch) {
+  const state = self[kStateSymbol];
+  if (!state.handle)
+    return;
+
+  const { list, calls } = batch;
+  const count = list.length / 3;
+  let hasCallback = false;
+  for (const call of calls) {
+    if (call.callback !== undefined)
+      hasCallback = true;
+  }
+
+  const req = new SendWrap();
+  req.list = list;  // Keep reference alive.
+  req.calls = calls;
+  if (hasCallback)
+    req.oncomplete = afterSendBatch;
+
+  const err = state.handle.sendBatch(req, list, count, hasCallback);
+
+  // A non-negative return value is the number of datagrams sent right away.
+  // The rest, if any, are queued and reported through req.oncomplete.
+  if (err < 0) {
+    if (hasCallback)
+      process.nextTick(finishBatch, calls, err, req.sent);
+  } else if (err === count && hasCallback) {
+    process.nextTick(finishBatch, calls, 0, count);
+  }
+}
+
+function afterSendBatch(err, sent) {
+  finishBatch(this.calls, err, sent);
+}
+
+// Tell every coalesced caller how many of its own datagrams made it, so that
+// it can retry the tail of its batch.
+function finishBatch(calls, status, sent) {
+  for (const { start, count, callback } of calls) {
+    if (callback === undefined)
+      continue;
+    const n = MathMin(MathMax(sent - start, 0), count);
+    const err = n < count && status !== 0 ?
+      errnoException(status, 'sendBatch') : null;
+    callback(err, n);
+  }
+}
+
+
 Socket.prototype.close = function(callback) {
   const state = this[kStateSymbol];
   const queue = state.queue;
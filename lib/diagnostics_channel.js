@@ -6,6 +6,7 @@ const {
   ArrayPrototypeSplice,
   ObjectCreate,
   ObjectGetPrototypeOf,
+  ObjectPrototypeHasOwnProperty,
   ObjectSetPrototypeOf,
   SymbolHasInstance,
 } = primordials;
@@ -23,17 +24,38 @@ const { triggerUncaughtException } = internalBinding('errors');
 
 const { WeakReference } = internalBinding('util');
 
-// TODO(qard): should there be a C++ channel interface?
+// Native code publishes to a fixed set of channels. It checks whether they have
+// subscribers with the counts in `binding.subscribers`, which are kept up to
+// date here, so that it only calls into JavaScript when there is a subscriber.
+const binding = internalBinding('diagnostics_channel');
+const { nativeChannels } = binding;
+
+// The channels that native code publishes to, by their index. They are kept
+// alive so that their subscribers always receive the messages.
+const nativeChannelsByIndex = [];
+
+function publishNative(index, message) {
+  const channel = nativeChannelsByIndex[index];
+  if (channel !== undefined)
+    channel.publish(message);
+}
+
+binding.setPublishFunction(publishNative);
+
 class ActiveChannel {
   subscribe(subscription) {
     validateFunction(subscription, 'subscription');
     ArrayPrototypePush(this._subscribers, subscription);
+    if (this._nativeIndex !== undefined)
+      binding.subscribers[this._nativeIndex]++;
   }
 
   unsubscribe(subscription) {
     const index = ArrayPrototypeIndexOf(this._subscribers, subscription);
     if (index >= 0) {
       ArrayPrototypeSplice(this._subscribers, index, 1);
+      if (this._nativeIndex !== undefined)
+        binding.subscribers[this._nativeIndex]--;
 
       // When there are no more active subscribers, restore to fast prototype.
       if (!this._subscribers.length) {
@@ -65,6 +87,10 @@ class Channel {
   constructor(name) {
     this._subscribers = undefined;
     this.name = name;
+    this._nativeIndex =
+      typeof name === 'string' &&
+      ObjectPrototypeHasOwnProperty(nativeChannels, name) ?
+        nativeChannels[name] : undefined;
   }
 
   static [SymbolHasInstance](instance) {
@@ -100,6 +126,8 @@ function channel(name) {
 
   channel = new Channel(name);
   channels[name] = new WeakReference(channel);
+  if (channel._nativeIndex !== undefined)
+    nativeChannelsByIndex[channel._nativeIndex] = channel;
   return channel;
 }
 
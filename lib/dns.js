@@ -23,6 +23,7 @@
 
 const {
   ArrayPrototypeMap,
+  ArrayPrototypeSlice,
   ObjectCreate,
   ObjectDefineProperties,
   ObjectDefineProperty,
@@ -36,10 +37,20 @@ const { customPromisifyArgs } = require('internal/util');
 const errors = require('internal/errors');
 const {
   bindDefaultResolver,
+  getaddrinfo,
   getDefaultResolver,
+  getLookupCache,
+  getLookupCacheStatistics,
+  getLookupResolver,
+  resolveManyResults,
   setDefaultResolver,
+  setLookupCache,
+  setLookupResolver,
+  validateLookupResolver,
   Resolver,
   validateHints,
+  validateResolveManyNames,
+  validateResolveManyType,
   emitInvalidHostnameWarning,
 } = require('internal/dns/utils');
 const {
@@ -97,6 +108,7 @@ function lookup(hostname, options, callback) {
   let family = -1;
   let all = false;
   let verbatim = false;
+  let resolver = getLookupResolver();
 
   // Parse arguments
   if (hostname) {
@@ -114,6 +126,10 @@ function lookup(hostname, options, callback) {
       family = options.family >>> 0;
       all = options.all === true;
       verbatim = options.verbatim === true;
+      if (options.resolver !== undefined) {
+        validateLookupResolver(options.resolver, 'options.resolver');
+        resolver = options.resolver;
+      }
 
       validateHints(hints);
     } else {
@@ -150,9 +166,11 @@ function lookup(hostname, options, callback) {
   req.hostname = hostname;
   req.oncomplete = all ? onlookupall : onlookup;
 
-  const err = cares.getaddrinfo(
-    req, toASCII(hostname), family, hints, verbatim
-  );
+  const name = toASCII(hostname);
+  const lookupCache = getLookupCache();
+  const err = lookupCache !== null ?
+    lookupCache.getaddrinfo(req, name, family, hints, verbatim, resolver) :
+    getaddrinfo(req, name, family, hints, verbatim, resolver);
   if (err) {
     process.nextTick(callback, dnsException(err, 'getaddrinfo', hostname));
     return {};
@@ -252,6 +270,7 @@ Resolver.prototype.resolveSoa = resolveMap.SOA = resolver('querySoa');
 Resolver.prototype.reverse = resolver('getHostByAddr');
 
 Resolver.prototype.resolve = resolve;
+Resolver.prototype.resolveMany = resolveMany;
 
 function resolve(hostname, rrtype, callback) {
   let resolver;
@@ -270,6 +289,29 @@ function resolve(hostname, rrtype, callback) {
   throw new ERR_INVALID_ARG_VALUE('rrtype', rrtype);
 }
 
+function onresolvemany(codes, records) {
+  this.callback(null, resolveManyResults(this.names, this.bindingName,
+                                         codes, records));
+}
+
+function resolveMany(names, rrtype, callback) {
+  if (typeof rrtype === 'function') {
+    callback = rrtype;
+    rrtype = 'A';
+  }
+  const asciiNames = validateResolveManyNames(names);
+  const { type, bindingName } = validateResolveManyType(rrtype);
+  validateCallback(callback);
+
+  const req = new QueryReqWrap();
+  req.bindingName = bindingName;
+  req.callback = callback;
+  req.names = ArrayPrototypeSlice(names);
+  req.oncomplete = onresolvemany;
+  this._handle.queryMany(req, asciiNames, type);
+  return req;
+}
+
 function defaultResolverSetServers(servers) {
   const resolver = new Resolver();
 
@@ -284,6 +326,9 @@ function defaultResolverSetServers(servers) {
 module.exports = {
   lookup,
   lookupService,
+  getLookupCacheStatistics,
+  setLookupCache,
+  setLookupResolver,
 
   Resolver,
   setServers: defaultResolverSetServers,
@@ -33,6 +33,7 @@ const kIoMaxLength = 2 ** 31 - 1;
 // in case they are created but never used due to an exception.
 
 const {
+  ArrayPrototypeMap,
   ArrayPrototypePush,
   BigIntPrototypeToString,
   MathMax,
@@ -40,6 +41,7 @@ const {
   ObjectCreate,
   ObjectDefineProperties,
   ObjectDefineProperty,
+  ObjectKeys,
   Promise,
   ReflectApply,
   RegExpPrototypeExec,
@@ -72,13 +74,15 @@ const { isArrayBufferView } = require('internal/util/types');
 // it's re-initialized after deserialization.
 
 const binding = internalBinding('fs');
-const { Buffer } = require('buffer');
+const { Buffer, kMaxLength } = require('buffer');
+const { transferToString } = require('internal/buffer');
 const {
   codes: {
     ERR_FS_FILE_TOO_LARGE,
     ERR_INVALID_ARG_VALUE,
     ERR_INVALID_ARG_TYPE,
     ERR_FEATURE_UNAVAILABLE_ON_PLATFORM,
+    ERR_OUT_OF_RANGE,
   },
   AbortError,
   uvErrmapGet,
@@ -95,12 +99,14 @@ const {
   getOptions,
   getValidatedFd,
   getValidatedPath,
+  getValidatedPaths,
   getValidMode,
   handleErrorFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   Stats,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   realpathCacheKey,
   stringToFlags,
   stringToSymlinkType,
@@ -133,6 +139,8 @@ const {
   validateCallback,
   validateFunction,
   validateInteger,
+  validateObject,
+  validateOneOf,
 } = require('internal/validators');
 // 2 ** 32 - 1
 const kMaxUserId = 4294967295;
@@ -156,6 +164,7 @@ let FileWriteStream;
 
 const isWindows = process.platform === 'win32';
 const isOSX = process.platform === 'darwin';
+const isLinux = process.platform === 'linux';
 
 
 function showTruncateDeprecation() {
@@ -442,7 +451,7 @@ function readFileSync(path, options) {
     buffer = buffer.slice(0, pos);
   }
 
-  if (options.encoding) buffer = buffer.toString(options.encoding);
+  if (options.encoding) buffer = transferToString(buffer, options.encoding);
   return buffer;
 }
 
@@ -506,6 +515,16 @@ function openSync(path, flags, mode) {
   return result;
 }
 
+function openAsBlob(path, options = {}) {
+  path = getValidatedPath(path);
+  validateObject(options, 'options');
+  const { type = '' } = options;
+  const { createBlobFromFilePath } = require('internal/blob');
+  // The path is resolved now, since the file is opened again for each read.
+  return createBlobFromFilePath(
+    pathModule.toNamespacedPath(pathModule.resolve(`${path}`)), type);
+}
+
 // usage:
 // fs.read(fd, buffer, offset, length, position, callback);
 // OR
@@ -1142,6 +1161,52 @@ function statSync(path, options = { bigint: false, throwIfNoEntry: true }) {
   return getStatsFromBinding(stats);
 }
 
+function statManySync(paths,
+                      options = { bigint: false, throwIfNoEntry: true }) {
+  paths = getValidatedPaths(paths);
+  if (paths.length === 0)
+    return [];
+  const result = binding.statMany(
+    ArrayPrototypeMap(paths, (path) => pathModule.toNamespacedPath(path)),
+    options.bigint);
+  return getStatsManyFromBinding(result, paths, options.throwIfNoEntry);
+}
+
+const kMapFileAdvice = {
+  normal: binding.kMapFileAdviceNormal,
+  sequential: binding.kMapFileAdviceSequential,
+  random: binding.kMapFileAdviceRandom,
+  willneed: binding.kMapFileAdviceWillNeed,
+};
+
+function mapFile(fd, offset = 0, length, options = {}) {
+  fd = getValidatedFd(fd);
+  validateInteger(offset, 'offset', 0);
+  validateObject(options, 'options');
+  const { populate = false, advice = 'normal' } = options;
+  validateBoolean(populate, 'options.populate');
+  validateOneOf(advice, 'options.advice', ObjectKeys(kMapFileAdvice));
+
+  // Accessing a mapped page past the end of the file raises SIGBUS, so the
+  // range has to be within the file.
+  const { size } = fstatSync(fd);
+  if (length === undefined)
+    length = MathMax(size - offset, 0);
+  validateInteger(length, 'length', 0, kMaxLength);
+  if (offset + length > size) {
+    throw new ERR_OUT_OF_RANGE('offset + length', `<= ${size}`,
+                               offset + length);
+  }
+  if (length === 0)
+    return Buffer.alloc(0);
+
+  const ctx = {};
+  const buffer = binding.mapFile(fd, offset, length, populate,
+                                 kMapFileAdvice[advice], ctx);
+  handleErrorFromBinding(ctx);
+  return buffer;
+}
+
 function readlink(path, options, callback) {
   callback = makeCallback(typeof options === 'function' ? options : callback);
   options = getOptions(options, {});
@@ -1586,7 +1651,7 @@ function watch(filename, options, listener) {
 
   if (options.persistent === undefined) options.persistent = true;
   if (options.recursive === undefined) options.recursive = false;
-  if (options.recursive && !(isOSX || isWindows))
+  if (options.recursive && !(isOSX || isWindows || isLinux))
     throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('watch recursively');
   if (!watchers)
     watchers = require('internal/fs/watchers');
@@ -2128,11 +2193,13 @@ module.exports = fs = {
   lstatSync,
   lutimes,
   lutimesSync,
+  mapFile,
   mkdir,
   mkdirSync,
   mkdtemp,
   mkdtempSync,
   open,
+  openAsBlob,
   openSync,
   opendir,
   opendirSync,
@@ -2156,6 +2223,7 @@ module.exports = fs = {
   rmdirSync,
   stat,
   statSync,
+  statManySync,
   symlink,
   symlinkSync,
   truncate,
@@ -29,7 +29,11 @@ const {
 
 const httpAgent = require('_http_agent');
 const { ClientRequest } = require('_http_client');
-const { methods } = require('_http_common');
+const {
+  getIdleHTTPParsersStats,
+  methods,
+  setMaxIdleHTTPParsers,
+} = require('_http_common');
 const { IncomingMessage } = require('_http_incoming');
 const {
   validateHeaderName,
@@ -72,7 +76,9 @@ module.exports = {
   validateHeaderName,
   validateHeaderValue,
   get,
-  request
+  getIdleHTTPParsersStats,
+  request,
+  setMaxIdleHTTPParsers,
 };
 
 ObjectDefineProperty(module.exports, 'maxHeaderSize', {
@@ -5,6 +5,7 @@ const {
   constants,
   createServer,
   createSecureServer,
+  detachSocket,
   getDefaultSettings,
   getPackedSettings,
   getUnpackedSettings,
@@ -18,6 +19,7 @@ module.exports = {
   constants,
   createServer,
   createSecureServer,
+  detachSocket,
   getDefaultSettings,
   getPackedSettings,
   getUnpackedSettings,
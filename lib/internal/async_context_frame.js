@@ -0,0 +1,72 @@
+'use strict';
+
+// With --experimental-async-context-frame, the stores of AsyncLocalStorage are
+// kept in the current async context frame rather than on the resources of
+// async_hooks. A frame maps each AsyncLocalStorage to its store, and is never
+// modified once it is current: run() and enterWith() create a new frame
+// instead. The resources capture the frame that is current when they are
+// created, and make it current again while their callbacks run. This is done
+// by AsyncWrap and by promises in C++ (see src/async_context_frame.h), and by
+// the resources that are implemented in JavaScript, i.e. AsyncResource,
+// timers, immediates and process.nextTick(), with the helpers below. No
+// async_hooks are enabled for any of this.
+
+const {
+  SafeMap,
+  Symbol,
+} = primordials;
+
+const {
+  getContextFrame,
+  setContextFrame,
+  setupPromiseHook,
+} = internalBinding('async_context_frame');
+
+// The frame that a resource that is implemented in JavaScript captured.
+const kContextFrame = Symbol('kContextFrame');
+
+let enabled = false;
+
+class AsyncContextFrame extends SafeMap {
+  constructor(storage, store) {
+    super(getContextFrame());
+    this.set(storage, store);
+  }
+
+  static get enabled() {
+    return enabled;
+  }
+
+  // Returns the frame to capture for a resource, or undefined if frames are
+  // not enabled.
+  static current() {
+    if (enabled)
+      return getContextFrame();
+  }
+
+  static set(frame) {
+    setContextFrame(frame);
+  }
+
+  // Makes the frame of a resource current and returns the frame that it
+  // replaced, which is to be restored with set() once the callback of the
+  // resource returns. Only to be called if frames are enabled.
+  static exchange(frame) {
+    const prior = getContextFrame();
+    setContextFrame(frame);
+    return prior;
+  }
+}
+
+// Called by pre-execution, as the option is not known when this module is
+// loaded into the startup snapshot.
+function setupAsyncContextFrame() {
+  enabled = true;
+  setupPromiseHook();
+}
+
+module.exports = {
+  AsyncContextFrame,
+  kContextFrame,
+  setupAsyncContextFrame,
+};
@@ -4,8 +4,13 @@ const {
   ArrayFrom,
   MathMax,
   MathMin,
+  MathTrunc,
+  Number,
+  NumberIsSafeInteger,
+  NumberMAX_SAFE_INTEGER,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
+  PromisePrototypeThen,
   PromiseResolve,
   RegExpPrototypeTest,
   StringPrototypeToLowerCase,
@@ -17,8 +22,11 @@ const {
 
 const {
   createBlob,
+  createBlobFromFile,
   FixedSizeBlobCopyJob,
+  kMaxLength,
 } = internalBinding('buffer');
+const { UV_ECANCELED } = internalBinding('uv');
 
 const {
   JSTransferable,
@@ -42,22 +50,28 @@ const {
   AbortError,
   codes: {
     ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
     ERR_BUFFER_TOO_LARGE,
   }
 } = require('internal/errors');
 
 const {
   validateObject,
-  isUint32,
 } = require('internal/validators');
 
 const kHandle = Symbol('kHandle');
 const kType = Symbol('kType');
 const kLength = Symbol('kLength');
 
+// The size of the chunks that blob.stream() reads.
+const kStreamChunkSize = 64 * 1024;
+
 const disallowedTypeCharacters = /[^\u{0020}-\u{007E}]/u;
 
 let Buffer;
+let DOMException;
+let FastBuffer;
+let Readable;
 
 function lazyBuffer() {
   if (Buffer === undefined)
@@ -65,6 +79,12 @@ function lazyBuffer() {
   return Buffer;
 }
 
+function lazyDOMException(message, name) {
+  if (DOMException === undefined)
+    DOMException = internalBinding('messaging').DOMException;
+  return new DOMException(message, name);
+}
+
 function isBlob(object) {
   return object?.[kHandle] !== undefined;
 }
@@ -115,8 +135,9 @@ class Blob extends JSTransferable {
       return src;
     });
 
-    if (!isUint32(length))
-      throw new ERR_BUFFER_TOO_LARGE(0xFFFFFFFF);
+    // Only the parts of files can make a Blob grow this large.
+    if (!NumberIsSafeInteger(length))
+      throw new ERR_BUFFER_TOO_LARGE(NumberMAX_SAFE_INTEGER);
 
     super();
     this[kHandle] = createBlob(sources_, length);
@@ -168,14 +189,14 @@ class Blob extends JSTransferable {
     } else {
       start = MathMin(start, this[kLength]);
     }
-    start |= 0;
+    start = MathTrunc(start) || 0;
 
     if (end < 0) {
       end = MathMax(this[kLength] + end, 0);
     } else {
       end = MathMin(end, this[kLength]);
     }
-    end |= 0;
+    end = MathTrunc(end) || 0;
 
     contentType = `${contentType}`;
     if (RegExpPrototypeTest(disallowedTypeCharacters, contentType)) {
@@ -191,6 +212,9 @@ class Blob extends JSTransferable {
   }
 
   async arrayBuffer() {
+    if (this[kLength] > kMaxLength)
+      throw new ERR_BUFFER_TOO_LARGE(kMaxLength);
+
     const job = new FixedSizeBlobCopyJob(this[kHandle]);
 
     const ret = job.run();
@@ -203,8 +227,12 @@ class Blob extends JSTransferable {
       reject
     } = createDeferredPromise();
     job.ondone = (err, ab) => {
-      if (err !== undefined)
+      if (err === UV_ECANCELED)
         return reject(new AbortError());
+      if (err !== undefined) {
+        return reject(lazyDOMException('The blob could not be read',
+                                       'NotReadableError'));
+      }
       resolve(ab);
     };
 
@@ -215,6 +243,32 @@ class Blob extends JSTransferable {
     const dec = new TextDecoder();
     return dec.decode(await this.arrayBuffer());
   }
+
+  stream() {
+    if (Readable === undefined) {
+      ({ Readable } = require('stream'));
+      ({ FastBuffer } = require('internal/buffer'));
+    }
+    const blob = this;
+    let offset = 0;
+    // Each chunk is read on its own, so the contents are never held in
+    // memory all at once.
+    return new Readable({
+      highWaterMark: kStreamChunkSize,
+      read() {
+        const size = blob[kLength];
+        if (offset >= size)
+          return this.push(null);
+        const end = MathMin(offset + kStreamChunkSize, size);
+        const chunk = blob.slice(offset, end);
+        offset = end;
+        PromisePrototypeThen(
+          chunk.arrayBuffer(),
+          (ab) => this.push(new FastBuffer(ab)),
+          (err) => this.destroy(err));
+      }
+    });
+  }
 }
 
 ObjectDefineProperty(Blob.prototype, SymbolToStringTag, {
@@ -227,8 +281,28 @@ ObjectSetPrototypeOf(
   InternalBlob.prototype,
   Blob.prototype);
 
+function normalizeType(type) {
+  type = `${type}`;
+  return RegExpPrototypeTest(disallowedTypeCharacters, type) ?
+    '' : StringPrototypeToLowerCase(type);
+}
+
+// Creates a Blob of the contents of the file at the path. The contents are
+// only read when they are used, and reading them fails once the file has
+// been modified.
+async function createBlobFromFilePath(path, type) {
+  const { stat } = require('internal/fs/promises').exports;
+  const stats = await stat(path, { bigint: true });
+  if (!stats.isFile())
+    throw new ERR_INVALID_ARG_VALUE('path', path, 'must be a regular file');
+  const handle = createBlobFromFile(path, stats.size, stats.mtimeNs);
+  return new InternalBlob(handle, Number(stats.size), normalizeType(type));
+}
+
 module.exports = {
   Blob,
   InternalBlob,
+  createBlobFromFilePath,
   isBlob,
+  kHandle,
 };
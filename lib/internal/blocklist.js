@@ -1,7 +1,12 @@
 'use strict';
 
 const {
+  ArrayPrototypePush,
   Boolean,
+  NumberParseInt,
+  RegExpPrototypeTest,
+  StringPrototypeIndexOf,
+  StringPrototypeSlice,
   Symbol
 } = primordials;
 
@@ -24,7 +29,11 @@ const {
   ERR_INVALID_ARG_VALUE,
 } = require('internal/errors').codes;
 
-const { validateInt32, validateString } = require('internal/validators');
+const {
+  validateArray,
+  validateInt32,
+  validateString,
+} = require('internal/validators');
 
 class BlockList {
   constructor(handle = new BlockListHandle()) {
@@ -94,6 +103,41 @@ class BlockList {
     this[kHandle].addSubnet(network, type, prefix);
   }
 
+  addSubnets(subnets, family = 'ipv4') {
+    validateArray(subnets, 'subnets');
+    validateString(family, 'family');
+    family = family.toLowerCase();
+    if (family !== 'ipv4' && family !== 'ipv6')
+      throw new ERR_INVALID_ARG_VALUE('family', family);
+    const type = family === 'ipv4' ? AF_INET : AF_INET6;
+    const maxPrefix = family === 'ipv4' ? 32 : 128;
+    const networks = [];
+    const prefixes = [];
+    for (let n = 0; n < subnets.length; n++) {
+      const subnet = subnets[n];
+      validateString(subnet, `subnets[${n}]`);
+      const slash = StringPrototypeIndexOf(subnet, '/');
+      let prefix = maxPrefix;
+      if (slash !== -1) {
+        const bits = StringPrototypeSlice(subnet, slash + 1);
+        prefix = NumberParseInt(bits, 10);
+        if (!RegExpPrototypeTest(/^\d{1,3}$/, bits) || prefix > maxPrefix) {
+          throw new ERR_INVALID_ARG_VALUE(`subnets[${n}]`, subnet,
+                                          'must have a valid prefix');
+        }
+      }
+      ArrayPrototypePush(networks,
+                         slash === -1 ? subnet :
+                           StringPrototypeSlice(subnet, 0, slash));
+      ArrayPrototypePush(prefixes, prefix);
+    }
+    const invalid = this[kHandle].addSubnets(networks, prefixes, type);
+    if (invalid !== -1) {
+      throw new ERR_INVALID_ARG_VALUE(`subnets[${invalid}]`, subnets[invalid],
+                                      `must be an ${family} subnet`);
+    }
+  }
+
   check(address, family = 'ipv4') {
     validateString(address, 'address');
     validateString(family, 'family');
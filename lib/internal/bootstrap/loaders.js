@@ -241,8 +241,13 @@ class NativeModule {
       const internal = StringPrototypeStartsWith(this.id, 'internal/');
       this.exportKeys = internal ? [] : ObjectKeys(this.exports);
     }
-    this.getESMFacade();
-    this.syncExports();
+    // The facade is a ModuleWrap, which cannot be included in a snapshot.
+    // While building one, it is only created if the module is imported.
+    const { getOptionValue } = nativeModuleRequire('internal/options');
+    if (!getOptionValue('--build-snapshot')) {
+      this.getESMFacade();
+      this.syncExports();
+    }
     return this.exports;
   }
 
@@ -140,6 +140,7 @@ const rawMethods = internalBinding('process_methods');
 {
   process.dlopen = rawMethods.dlopen;
   process.uptime = rawMethods.uptime;
+  process.threadpoolUsage = rawMethods.threadpoolUsage;
 
   // TODO(joyeecheung): either remove them or make them public
   process._getActiveRequests = rawMethods._getActiveRequests;
@@ -152,8 +153,6 @@ const rawMethods = internalBinding('process_methods');
   const wrapped = perThreadSetup.wrapProcessMethods(rawMethods);
   process._rawDebug = wrapped._rawDebug;
   process.cpuUsage = wrapped.cpuUsage;
-  process.resourceUsage = wrapped.resourceUsage;
-  process.memoryUsage = wrapped.memoryUsage;
   process.kill = wrapped.kill;
   process.exit = wrapped.exit;
 
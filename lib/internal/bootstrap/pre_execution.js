@@ -10,6 +10,7 @@ const {
 
 const {
   getOptionValue,
+  refreshOptions,
   shouldNotRegisterESMLoader
 } = require('internal/options');
 const { reconnectZeroFillToggle } = require('internal/buffer');
@@ -19,6 +20,10 @@ const { ERR_MANIFEST_ASSERT_INTEGRITY } = require('internal/errors').codes;
 const assert = require('internal/assert');
 
 function prepareMainThreadExecution(expandArgv1 = false) {
+  // The options may have been read while building the user-land snapshot
+  // that this process starts from.
+  refreshOptions();
+
   // TODO(joyeecheung): this is also necessary for workers when they deserialize
   // this toggle from the snapshot.
   reconnectZeroFillToggle();
@@ -39,6 +44,8 @@ function prepareMainThreadExecution(expandArgv1 = false) {
 
 
   setupDebugEnv();
+  initializeTimerWheel();
+  initializeAsyncContextFrame();
 
   // Print stack trace on `SIGINT` if option `--trace-sigint` presents.
   setupStacktracePrinterOnSigint();
@@ -48,6 +55,7 @@ function prepareMainThreadExecution(expandArgv1 = false) {
   initializeReportSignalHandlers();  // Main-thread-only.
 
   initializeHeapSnapshotSignalHandlers();
+  initializeHeapProfileSignalHandlers();
 
   // If the process is spawned with env NODE_CHANNEL_FD, it's probably
   // spawned by our child_process module, then initialize IPC.
@@ -69,12 +77,34 @@ function prepareMainThreadExecution(expandArgv1 = false) {
   initializeCJSLoader();
   initializeESMLoader();
 
-  const CJSLoader = require('internal/modules/cjs/loader');
-  assert(!CJSLoader.hasLoadedAnyUserCJSModule);
+  const {
+    isDeserializingSnapshot,
+    runDeserializeCallbacks,
+  } = require('internal/v8/startup_snapshot');
+  if (isDeserializingSnapshot()) {
+    // The process that built the snapshot has run its event loop to the
+    // end, and has loaded the application already.
+    process._exiting = false;
+    runDeserializeCallbacks();
+  } else {
+    const CJSLoader = require('internal/modules/cjs/loader');
+    assert(!CJSLoader.hasLoadedAnyUserCJSModule);
+  }
   loadPreloadModules();
   initializeFrozenIntrinsics();
 }
 
+function initializeTimerWheel() {
+  const slack = getOptionValue('--timer-slack');
+  if (slack > 0)
+    require('internal/timers').enableTimerWheel(slack);
+}
+
+function initializeAsyncContextFrame() {
+  if (getOptionValue('--experimental-async-context-frame'))
+    require('internal/async_context_frame').setupAsyncContextFrame();
+}
+
 function patchProcessObject(expandArgv1) {
   const binding = internalBinding('process_methods');
   binding.patchProcessObject(process);
@@ -84,11 +114,15 @@ function patchProcessObject(expandArgv1) {
   // deserialization).
   const {
     hrtime,
-    hrtimeBigInt
+    hrtimeBigInt,
+    memoryUsage,
+    resourceUsage,
   } = require('internal/process/per_thread').getFastAPIs(binding);
 
   process.hrtime = hrtime;
   process.hrtime.bigint = hrtimeBigInt;
+  process.memoryUsage = memoryUsage;
+  process.resourceUsage = resourceUsage;
 
   ObjectDefineProperty(process, 'argv0', {
     enumerable: true,
@@ -177,11 +211,13 @@ function setupStacktracePrinterOnSigint() {
 }
 
 function initializeReport() {
-  const { report } = require('internal/process/report');
+  let report;
   ObjectDefineProperty(process, 'report', {
     enumerable: false,
     configurable: true,
     get() {
+      if (report === undefined)
+        report = require('internal/process/report').report;
       return report;
     }
   });
@@ -196,6 +232,10 @@ function setupDebugEnv() {
 
 // This has to be called after initializeReport() is called
 function initializeReportSignalHandlers() {
+  // Otherwise the handler is only added if process.report.reportOnSignal is
+  // set, which loads the report module anyway.
+  if (!getOptionValue('--report-on-signal'))
+    return;
   const { addSignalHandler } = require('internal/process/report');
 
   addSignalHandler();
@@ -215,6 +255,30 @@ function initializeHeapSnapshotSignalHandlers() {
   });
 }
 
+function initializeHeapProfileSignalHandlers() {
+  const signal = getOptionValue('--heap-prof-signal');
+
+  if (!signal)
+    return;
+
+  require('internal/validators').validateSignalName(signal);
+  const { writeHeapProfile } = require('v8');
+
+  let writing = false;
+  process.on(signal, () => {
+    // Signals that arrive while a profile is being taken are ignored.
+    if (writing)
+      return;
+    writing = true;
+    writeHeapProfile().then(() => {
+      writing = false;
+    }, (err) => {
+      writing = false;
+      process.emitWarning(`Failed to write heap profile: ${err.message}`);
+    });
+  });
+}
+
 function setupTraceCategoryState() {
   const { isTraceCategoryEnabled } = internalBinding('trace_events');
   const { toggleTraceCategoryState } = require('internal/process/per_thread');
@@ -228,11 +292,16 @@ function setupInspectorHooks() {
   // notification in the inspector agent if it's sent in the middle of
   // bootstrap, and process the notification later here.
   if (internalBinding('config').hasInspector) {
-    const {
-      enable,
-      disable
-    } = require('internal/inspector_async_hook');
-    internalBinding('inspector').registerAsyncHook(enable, disable);
+    // The hooks are only loaded once an inspector client asks for async
+    // stack traces.
+    internalBinding('inspector').registerAsyncHook(
+      () => require('internal/inspector_async_hook').enable(),
+      () => require('internal/inspector_async_hook').disable());
+    // Outgoing requests are only tracked while a session has enabled the
+    // Network domain.
+    internalBinding('inspector').registerNetworkTracking(
+      () => require('internal/inspector_network_tracking').enable(),
+      () => require('internal/inspector_network_tracking').disable());
   }
 }
 
@@ -420,7 +489,11 @@ function initializeCJSLoader() {
 
 function initializeESMLoader() {
   // Create this WeakMap in js-land because V8 has no C++ API for WeakMap.
-  internalBinding('module_wrap').callbackMap = new SafeWeakMap();
+  // It already exists if the process starts from a user-land snapshot, in
+  // which case it holds the callbacks of the modules that are loaded.
+  const moduleWrap = internalBinding('module_wrap');
+  if (moduleWrap.callbackMap === undefined)
+    moduleWrap.callbackMap = new SafeWeakMap();
 
   if (shouldNotRegisterESMLoader) return;
 
@@ -470,5 +543,7 @@ module.exports = {
   setupInspectorHooks,
   initializeReport,
   initializeCJSLoader,
+  initializeTimerWheel,
+  initializeAsyncContextFrame,
   initializeWASI
 };
@@ -38,10 +38,39 @@ process.on('removeListener', stopListeningIfSignal);
 
 const { guessHandleType } = internalBinding('util');
 
+// While building a user-land snapshot, the stdio streams are written to
+// synchronously, so that they do not hold on to handles that cannot be
+// serialized. They are created again once the snapshot is deserialized.
+function guessStdioHandleType(fd) {
+  const type = guessHandleType(fd);
+  if (type !== 'TTY' && type !== 'PIPE' && type !== 'TCP')
+    return type;
+  const {
+    isBuildingSnapshot,
+    namespace: { addDeserializeCallback },
+  } = require('internal/v8/startup_snapshot');
+  if (!isBuildingSnapshot())
+    return type;
+  addDeserializeCallback(resetStdioStream, fd);
+  return 'FILE';
+}
+
+function resetStdioStream(fd) {
+  // The global console keeps the streams that it has used.
+  const globalConsole = require('internal/console/global');
+  if (fd === 1) {
+    stdout = undefined;
+    globalConsole._stdout = undefined;
+  } else {
+    stderr = undefined;
+    globalConsole._stderr = undefined;
+  }
+}
+
 function createWritableStdioStream(fd) {
   let stream;
   // Note stream._type is used for test-module-load-list.js
-  switch (guessHandleType(fd)) {
+  switch (guessStdioHandleType(fd)) {
     case 'TTY':
       const tty = require('tty');
       stream = new tty.WriteStream(fd);
@@ -117,12 +146,17 @@ let stdin;
 let stdout;
 let stderr;
 
+function addCoalescing(stream) {
+  require('internal/process/stdio_coalescing').addCoalescing(stream);
+}
+
 function getStdout() {
   if (stdout) return stdout;
   stdout = createWritableStdioStream(1);
   stdout.destroySoon = stdout.destroy;
   // Override _destroy so that the fd is never actually closed.
   stdout._destroy = dummyDestroy;
+  addCoalescing(stdout);
   if (stdout.isTTY) {
     process.on('SIGWINCH', () => stdout._refreshSize());
   }
@@ -135,6 +169,7 @@ function getStderr() {
   stderr.destroySoon = stderr.destroy;
   // Override _destroy so that the fd is never actually closed.
   stderr._destroy = dummyDestroy;
+  addCoalescing(stderr);
   if (stderr.isTTY) {
     process.on('SIGWINCH', () => stderr._refreshSize());
   }
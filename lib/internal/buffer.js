@@ -14,7 +14,12 @@ const {
   ERR_INVALID_ARG_TYPE,
   ERR_OUT_OF_RANGE
 } = require('internal/errors').codes;
+const { normalizeEncoding } = require('internal/util');
 const { validateNumber } = require('internal/validators');
+const {
+  isBigUint64Array,
+  isUint32Array,
+} = require('internal/util/types');
 const {
   asciiSlice,
   base64Slice,
@@ -30,6 +35,9 @@ const {
   hexWrite,
   ucs2Write,
   utf8Write,
+  transferToString: _transferToString,
+  readVarints: _readVarints,
+  writeVarints: _writeVarints,
   getZeroFillToggle
 } = internalBinding('buffer');
 const {
@@ -951,6 +959,31 @@ function writeFloatBackwards(val, offset = 0) {
   return offset;
 }
 
+// Unsigned LEB128 varints. The number of values is the length of the typed
+// array, which is filled from or written to the Buffer in one call.
+function validateVarintArray(value, name) {
+  if (!isUint32Array(value) && !isBigUint64Array(value)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      name, ['Uint32Array', 'BigUint64Array'], value);
+  }
+}
+
+function readVarints(target, offset = 0) {
+  validateVarintArray(target, 'target');
+  validateNumber(offset, 'offset');
+  if (MathFloor(offset) !== offset || offset < 0 || offset > this.length)
+    boundsError(offset, this.length);
+  return _readVarints(this, target, offset);
+}
+
+function writeVarints(source, offset = 0) {
+  validateVarintArray(source, 'source');
+  validateNumber(offset, 'offset');
+  if (MathFloor(offset) !== offset || offset < 0 || offset > this.length)
+    boundsError(offset, this.length);
+  return _writeVarints(this, source, offset);
+}
+
 class FastBuffer extends Uint8Array {
   // Using an explicit constructor here is necessary to avoid relying on
   // `Array.prototype[Symbol.iterator]`, which can be mutated by users.
@@ -1018,6 +1051,9 @@ function addBufferPrototypeMethods(proto) {
   proto.writeInt32BE = writeInt32BE;
   proto.writeInt16BE = writeInt16BE;
 
+  proto.readVarints = readVarints;
+  proto.writeVarints = writeVarints;
+
   proto.readFloatLE = bigEndian ? readFloatBackwards : readFloatForwards;
   proto.readFloatBE = bigEndian ? readFloatForwards : readFloatBackwards;
   proto.readDoubleLE = bigEndian ? readDoubleBackwards : readDoubleForwards;
@@ -1073,6 +1109,18 @@ function reconnectZeroFillToggle() {
   zeroFill = getZeroFillToggle();
 }
 
+// Returns `buf.toString(encoding)` for a Buffer that is not used afterwards.
+// Large ASCII and Latin-1 contents are not copied but shared with the
+// string, which detaches the Buffer.
+function transferToString(buf, encoding) {
+  const normalized = normalizeEncoding(encoding);
+  if (normalized === 'utf8' || normalized === 'latin1' ||
+      normalized === 'ascii') {
+    return _transferToString(buf, normalized);
+  }
+  return buf.toString(encoding);
+}
+
 module.exports = {
   FastBuffer,
   addBufferPrototypeMethods,
@@ -1080,5 +1128,6 @@ module.exports = {
   createUnsafeBuffer,
   readUInt16BE,
   readUInt32BE,
-  reconnectZeroFillToggle
+  reconnectZeroFillToggle,
+  transferToString,
 };
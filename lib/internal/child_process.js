@@ -359,7 +359,7 @@ ChildProcess.prototype.spawn = function(options) {
 
 
   validateOneOf(options.serialization, 'options.serialization',
-                [undefined, 'json', 'advanced']);
+                [undefined, 'json', 'advanced', 'binary']);
   const serialization = options.serialization || 'json';
 
   if (ipc !== undefined) {
@@ -5,15 +5,14 @@ const {
   JSONStringify,
   StringPrototypeSplit,
   Symbol,
-  TypedArrayPrototypeSubarray,
 } = primordials;
 const { Buffer } = require('buffer');
+const { FastBuffer } = require('internal/buffer');
 const { StringDecoder } = require('string_decoder');
 const v8 = require('v8');
 const { isArrayBufferView } = require('internal/util/types');
 const assert = require('internal/assert');
 
-const kMessageBuffer = Symbol('kMessageBuffer');
 const kJSONBuffer = Symbol('kJSONBuffer');
 const kStringDecoder = Symbol('kStringDecoder');
 
@@ -47,32 +46,22 @@ class ChildProcessDeserializer extends v8.DefaultDeserializer {
 // Messages are parsed in either of the following formats:
 // - Newline-delimited JSON, or
 // - V8-serialized buffers, prefixed with their length as a big endian uint32
-//   (aka 'advanced')
+//   (aka 'advanced'), or
+// - Buffers prefixed with their length like 'advanced' ones, whose first byte
+//   tells whether the rest is JSON or the raw bytes of an ArrayBufferView
+//   (aka 'binary').
+// The length-prefixed frames are split natively, every read of such a channel
+// is one complete message.
 const advanced = {
   initMessageChannel(channel) {
-    channel[kMessageBuffer] = Buffer.alloc(0);
+    channel.useFraming();
     channel.buffering = false;
   },
 
   *parseChannelMessages(channel, readData) {
-    if (readData.length === 0) return;
-
-    let messageBuffer = Buffer.concat([channel[kMessageBuffer], readData]);
-    while (messageBuffer.length > 4) {
-      const size = messageBuffer.readUInt32BE();
-      if (messageBuffer.length < 4 + size) {
-        break;
-      }
-
-      const deserializer = new ChildProcessDeserializer(
-        TypedArrayPrototypeSubarray(messageBuffer, 4, 4 + size));
-      messageBuffer = TypedArrayPrototypeSubarray(messageBuffer, 4 + size);
-
-      deserializer.readHeader();
-      yield deserializer.readValue();
-    }
-    channel[kMessageBuffer] = messageBuffer;
-    channel.buffering = messageBuffer.length > 0;
+    const deserializer = new ChildProcessDeserializer(readData);
+    deserializer.readHeader();
+    yield deserializer.readValue();
   },
 
   writeChannelMessage(channel, req, message, handle) {
@@ -89,6 +78,43 @@ const advanced = {
   },
 };
 
+const kJSONMessage = 0;
+const kBinaryMessage = 1;
+
+const binary = {
+  initMessageChannel: advanced.initMessageChannel,
+
+  *parseChannelMessages(channel, readData) {
+    const body = new FastBuffer(readData.buffer,
+                                readData.byteOffset + 1,
+                                readData.length - 1);
+    if (readData[0] === kBinaryMessage)
+      yield body;
+    else
+      yield JSONParse(body.utf8Slice());
+  },
+
+  writeChannelMessage(channel, req, message, handle) {
+    if (isArrayBufferView(message) && !handle) {
+      // The bytes are written as they are, the view is kept alive until the
+      // write is done.
+      const header = Buffer.allocUnsafe(5);
+      header.writeUInt32BE(message.byteLength + 1);
+      header[4] = kBinaryMessage;
+      req.buffer = message;
+      return channel.writev(req, [header, message], true);
+    }
+
+    const string = JSONStringify(message);
+    const length = Buffer.byteLength(string);
+    const buffer = Buffer.allocUnsafe(5 + length);
+    buffer.writeUInt32BE(length + 1);
+    buffer[4] = kJSONMessage;
+    buffer.utf8Write(string, 5);
+    return channel.writeBuffer(req, buffer, handle);
+  },
+};
+
 const json = {
   initMessageChannel(channel) {
     channel[kJSONBuffer] = '';
@@ -122,4 +148,4 @@ const json = {
   },
 };
 
-module.exports = { advanced, json };
+module.exports = { advanced, binary, json };
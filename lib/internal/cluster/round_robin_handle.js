@@ -15,10 +15,17 @@ const { constants } = internalBinding('tcp_wrap');
 
 module.exports = RoundRobinHandle;
 
+// The number of connections that are handed to a worker before it has
+// replied to the first one. Waiting for each reply limits the accept rate
+// to one round trip to every worker, which includes running the user's
+// 'connection' listener.
+const kMaxPendingPerWorker = 4;
+
 function RoundRobinHandle(key, address, { port, fd, flags }) {
   this.key = key;
   this.all = new SafeMap();
   this.free = new SafeMap();
+  this.pending = new SafeMap();
   this.handles = [];
   this.handle = null;
   this.server = net.createServer(assert.fail);
@@ -77,6 +84,7 @@ RoundRobinHandle.prototype.remove = function(worker) {
     return false;
 
   this.free.delete(worker.id);
+  this.pending.delete(worker.id);
 
   if (this.all.size !== 0)
     return false;
@@ -93,6 +101,10 @@ RoundRobinHandle.prototype.remove = function(worker) {
 
 RoundRobinHandle.prototype.distribute = function(err, handle) {
   ArrayPrototypePush(this.handles, handle);
+  this.handoffToNextFree();
+};
+
+RoundRobinHandle.prototype.handoffToNextFree = function() {
   // eslint-disable-next-line node-core/no-array-destructuring
   const [ workerEntry ] = this.free; // this.free is a SafeMap
 
@@ -116,6 +128,8 @@ RoundRobinHandle.prototype.handoff = function(worker) {
   }
 
   const message = { act: 'newconn', key: this.key };
+  const pending = (this.pending.get(worker.id) || 0) + 1;
+  this.pending.set(worker.id, pending);
 
   sendHelper(worker.process, message, handle, (reply) => {
     if (reply.accepted)
@@ -123,6 +137,19 @@ RoundRobinHandle.prototype.handoff = function(worker) {
     else
       this.distribute(0, handle);  // Worker is shutting down. Send to another.
 
-    this.handoff(worker);
+    if (!this.all.has(worker.id))
+      return;
+    this.pending.set(worker.id, this.pending.get(worker.id) - 1);
+    // A worker that is not in the ready queue had reached the limit.
+    if (!this.free.has(worker.id))
+      this.handoff(worker);
   });
+
+  if (pending < kMaxPendingPerWorker) {
+    // The worker can take more connections. Queuing it behind the other
+    // ready workers keeps the distribution round-robin.
+    this.free.set(worker.id, worker);
+    if (this.handles.length !== 0)
+      this.handoffToNextFree();
+  }
 };
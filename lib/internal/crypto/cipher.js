@@ -8,6 +8,8 @@ const {
 
 const {
   CipherBase,
+  aeadOpen: _aeadOpen,
+  aeadSeal: _aeadSeal,
   privateDecrypt: _privateDecrypt,
   privateEncrypt: _privateEncrypt,
   publicDecrypt: _publicDecrypt,
@@ -27,6 +29,7 @@ const {
     ERR_CRYPTO_INVALID_STATE,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
+    ERR_OUT_OF_RANGE,
   }
 } = require('internal/errors');
 
@@ -35,6 +38,7 @@ const {
   validateInt32,
   validateObject,
   validateString,
+  validateUint32,
 } = require('internal/validators');
 
 const {
@@ -323,7 +327,53 @@ function getCipherInfo(nameOrNid, options) {
   return ret;
 }
 
+function aeadCipher(fn, encrypt, algorithm, key, iv, aad, input, output,
+                    options) {
+  validateString(algorithm, 'algorithm');
+  key = prepareSecretKey(key);
+  iv = getArrayBufferOrView(iv, 'iv');
+  aad = aad == null ? undefined : getArrayBufferOrView(aad, 'aad');
+  input = getArrayBufferOrView(input, encrypt ? 'plaintext' : 'ciphertext');
+  if (!isArrayBufferView(output)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'output',
+      ['Buffer', 'TypedArray', 'DataView'],
+      output);
+  }
+
+  let authTagLength = 16;
+  if (options !== undefined) {
+    validateObject(options, 'options');
+    if (options.authTagLength !== undefined) {
+      validateUint32(options.authTagLength, 'options.authTagLength');
+      authTagLength = options.authTagLength;
+    }
+  }
+
+  const length = encrypt ?
+    input.byteLength + authTagLength :
+    input.byteLength - authTagLength;
+  if (output.byteLength < length) {
+    throw new ERR_OUT_OF_RANGE(
+      'output.byteLength', `>= ${length}`, output.byteLength);
+  }
+
+  return fn(algorithm, key, iv, aad, input, output, authTagLength);
+}
+
+function aeadSeal(algorithm, key, iv, aad, plaintext, output, options) {
+  return aeadCipher(_aeadSeal, true, algorithm, key, iv, aad, plaintext,
+                    output, options);
+}
+
+function aeadOpen(algorithm, key, iv, aad, ciphertext, output, options) {
+  return aeadCipher(_aeadOpen, false, algorithm, key, iv, aad, ciphertext,
+                    output, options);
+}
+
 module.exports = {
+  aeadOpen,
+  aeadSeal,
   Cipher,
   Cipheriv,
   Decipher,
@@ -8,9 +8,11 @@ const {
 
 const {
   Hash: _Hash,
+  HashFileJob,
   HashJob,
   Hmac: _Hmac,
   kCryptoJobAsync,
+  oneShotDigest,
 } = internalBinding('crypto');
 
 const {
@@ -161,6 +163,17 @@ Hmac.prototype.digest = function digest(outputEncoding) {
 Hmac.prototype._flush = Hash.prototype._flush;
 Hmac.prototype._transform = Hash.prototype._transform;
 
+// One-shot digest of `data`, without the overhead of creating a Hash object.
+function hash(algorithm, data, outputEncoding = 'hex') {
+  validateString(algorithm, 'algorithm');
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE(
+      'data', ['string', 'Buffer', 'TypedArray', 'DataView'], data);
+  }
+  validateString(outputEncoding, 'outputEncoding');
+  return oneShotDigest(algorithm, data, outputEncoding);
+}
+
 // Implementation for WebCrypto subtle.digest()
 
 async function asyncDigest(algorithm, data) {
@@ -178,8 +191,21 @@ async function asyncDigest(algorithm, data) {
     algorithm.length));
 }
 
+// Implementation for filehandle.hash(). The file is read and hashed in the
+// threadpool, without passing its contents to JS.
+async function hashFile(fd, algorithm, outputLength) {
+  const result = await jobPromise(new HashFileJob(
+    kCryptoJobAsync,
+    fd,
+    algorithm,
+    outputLength === undefined ? undefined : outputLength * 8));
+  return Buffer.from(result);
+}
+
 module.exports = {
   Hash,
   Hmac,
   asyncDigest,
+  hash,
+  hashFile,
 };
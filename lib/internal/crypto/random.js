@@ -18,6 +18,7 @@ const {
   CheckPrimeJob,
   kCryptoJobAsync,
   kCryptoJobSync,
+  randomFillFromPool,
   secureBuffer,
 } = internalBinding('crypto');
 
@@ -55,6 +56,8 @@ const { FastBuffer } = require('internal/buffer');
 
 const kMaxUint32 = 2 ** 32 - 1;
 const kMaxPossibleLength = MathMin(kMaxLength, kMaxUint32);
+// Must match RandomBytesPool::kMaxRequestSize.
+const kMaxPoolRequestSize = 256;
 
 function assertOffset(offset, elementSize, length) {
   validateNumber(offset, 'offset');
@@ -125,6 +128,11 @@ function randomFillSync(buf, offset = 0, size) {
   if (size === 0)
     return buf;
 
+  // Small requests are usually served from a pool that is filled in the
+  // threadpool ahead of time.
+  if (size <= kMaxPoolRequestSize && randomFillFromPool(buf, offset, size))
+    return buf;
+
   const job = new RandomBytesJob(
     kCryptoJobSync,
     buf,
@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ArrayPrototypePush,
   FunctionPrototypeCall,
   ObjectSetPrototypeOf,
   ReflectApply,
@@ -15,8 +16,10 @@ const {
 } = require('internal/errors');
 
 const {
+  validateArray,
   validateCallback,
   validateEncoding,
+  validateObject,
   validateString,
 } = require('internal/validators');
 
@@ -24,9 +27,11 @@ const {
   Sign: _Sign,
   SignJob,
   Verify: _Verify,
+  VerifyBatchJob,
   signOneShot: _signOneShot,
   verifyOneShot: _verifyOneShot,
   kCryptoJobAsync,
+  kCryptoJobSync,
   kSigEncDER,
   kSigEncP1363,
   kSignJobModeSign,
@@ -312,9 +317,82 @@ function verifyOneShot(algorithm, data, key, signature, callback) {
   job.run();
 }
 
+function verifyBatch(key, algorithm, items, callback) {
+  if (algorithm != null)
+    validateString(algorithm, 'algorithm');
+
+  if (callback !== undefined)
+    validateCallback(callback);
+
+  validateArray(items, 'items');
+  const data = [];
+  const signatures = [];
+  for (let i = 0; i < items.length; i++) {
+    const item = items[i];
+    validateObject(item, `items[${i}]`);
+    const itemData = getArrayBufferOrView(item.data, `items[${i}].data`);
+    if (!isArrayBufferView(itemData)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        `items[${i}].data`,
+        ['Buffer', 'TypedArray', 'DataView'],
+        itemData
+      );
+    }
+    if (!isArrayBufferView(item.signature)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        `items[${i}].signature`,
+        ['Buffer', 'TypedArray', 'DataView'],
+        item.signature
+      );
+    }
+    ArrayPrototypePush(data, itemData);
+    ArrayPrototypePush(signatures, item.signature);
+  }
+
+  // Options specific to RSA
+  const rsaPadding = getPadding(key);
+  const pssSaltLength = getSaltLength(key);
+
+  // Options specific to (EC)DSA
+  const dsaSigEnc = getDSASignatureEncoding(key);
+
+  let keyData;
+  if (isKeyObject(key) || isCryptoKey(key)) {
+    ({ data: keyData } = preparePublicOrPrivateKey(key));
+  } else if (key != null && (isKeyObject(key.key) || isCryptoKey(key.key))) {
+    ({ data: keyData } = preparePublicOrPrivateKey(key.key));
+  } else {
+    keyData = createPublicKey(key)[kHandle];
+  }
+
+  const job = new VerifyBatchJob(
+    callback ? kCryptoJobAsync : kCryptoJobSync,
+    keyData,
+    data,
+    signatures,
+    algorithm,
+    pssSaltLength,
+    rsaPadding,
+    dsaSigEnc);
+
+  if (!callback) {
+    const { 0: err, 1: results } = job.run();
+    if (err !== undefined)
+      throw err;
+    return results;
+  }
+
+  job.ondone = (error, results) => {
+    if (error) return FunctionPrototypeCall(callback, job, error);
+    FunctionPrototypeCall(callback, job, null, results);
+  };
+  job.run();
+}
+
 module.exports = {
   Sign,
   signOneShot,
   Verify,
+  verifyBatch,
   verifyOneShot,
 };
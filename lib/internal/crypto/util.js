@@ -4,6 +4,7 @@ const {
   ArrayPrototypeIncludes,
   ArrayPrototypePush,
   BigInt,
+  Float64Array,
   FunctionPrototypeBind,
   Number,
   Promise,
@@ -18,6 +19,7 @@ const {
   getHashes: _getHashes,
   setEngine: _setEngine,
   secureHeapUsed: _secureHeapUsed,
+  getKeyDerivationQueueStats: _getKeyDerivationQueueStats,
 } = internalBinding('crypto');
 
 const { getOptionValue } = require('internal/options');
@@ -404,6 +406,18 @@ function secureHeapUsed() {
   return { total, used, utilization, min };
 }
 
+const keyDerivationQueueStats = new Float64Array(4);
+
+function getKeyDerivationQueueStats() {
+  _getKeyDerivationQueueStats(keyDerivationQueueStats);
+  return {
+    threads: keyDerivationQueueStats[0],
+    pending: keyDerivationQueueStats[1],
+    running: keyDerivationQueueStats[2],
+    completed: keyDerivationQueueStats[3],
+  };
+}
+
 module.exports = {
   getArrayBufferOrView,
   getCiphers,
@@ -437,4 +451,5 @@ module.exports = {
   getUsagesUnion,
   getHashLength,
   secureHeapUsed,
+  getKeyDerivationQueueStats,
 };
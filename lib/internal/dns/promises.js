@@ -2,6 +2,7 @@
 
 const {
   ArrayPrototypeMap,
+  ArrayPrototypeSlice,
   ObjectCreate,
   ObjectDefineProperty,
   Promise,
@@ -10,18 +11,23 @@ const {
 
 const {
   bindDefaultResolver,
+  createChannel,
+  getaddrinfo,
+  getLookupCache,
+  getLookupResolver,
+  resolveManyResults,
   Resolver: CallbackResolver,
   validateHints,
-  validateTimeout,
+  validateLookupResolver,
+  validateResolveManyNames,
+  validateResolveManyType,
   emitInvalidHostnameWarning,
 } = require('internal/dns/utils');
 const { codes, dnsException } = require('internal/errors');
 const { toASCII } = require('internal/idna');
 const { isIP } = require('internal/net');
 const {
-  getaddrinfo,
   getnameinfo,
-  ChannelWrap,
   GetAddrInfoReqWrap,
   GetNameInfoReqWrap,
   QueryReqWrap
@@ -67,7 +73,8 @@ function onlookupall(err, addresses) {
   this.resolve(addresses);
 }
 
-function createLookupPromise(family, hostname, all, hints, verbatim) {
+function createLookupPromise(family, hostname, all, hints, verbatim,
+                             resolver) {
   return new Promise((resolve, reject) => {
     if (!hostname) {
       emitInvalidHostnameWarning(hostname);
@@ -91,7 +98,11 @@ function createLookupPromise(family, hostname, all, hints, verbatim) {
     req.resolve = resolve;
     req.reject = reject;
 
-    const err = getaddrinfo(req, toASCII(hostname), family, hints, verbatim);
+    const name = toASCII(hostname);
+    const lookupCache = getLookupCache();
+    const err = lookupCache !== null ?
+      lookupCache.getaddrinfo(req, name, family, hints, verbatim, resolver) :
+      getaddrinfo(req, name, family, hints, verbatim, resolver);
 
     if (err) {
       reject(dnsException(err, 'getaddrinfo', hostname));
@@ -104,6 +115,7 @@ function lookup(hostname, options) {
   var family = -1;
   var all = false;
   var verbatim = false;
+  var resolver = getLookupResolver();
 
   // Parse arguments
   if (hostname && typeof hostname !== 'string') {
@@ -113,6 +125,10 @@ function lookup(hostname, options) {
     family = options.family >>> 0;
     all = options.all === true;
     verbatim = options.verbatim === true;
+    if (options.resolver !== undefined) {
+      validateLookupResolver(options.resolver, 'options.resolver');
+      resolver = options.resolver;
+    }
 
     validateHints(hints);
   } else {
@@ -121,7 +137,7 @@ function lookup(hostname, options) {
 
   validateOneOf(family, 'family', [0, 4, 6], true);
 
-  return createLookupPromise(family, hostname, all, hints, verbatim);
+  return createLookupPromise(family, hostname, all, hints, verbatim, resolver);
 }
 
 
@@ -207,20 +223,43 @@ function resolver(bindingName) {
   return query;
 }
 
+function onresolvemany(codes, records) {
+  this.resolve(resolveManyResults(this.names, this.bindingName,
+                                  codes, records));
+}
+
+function resolveMany(names, rrtype = 'A') {
+  const asciiNames = validateResolveManyNames(names);
+  const { type, bindingName } = validateResolveManyType(rrtype);
+
+  return new Promise((resolve) => {
+    const req = new QueryReqWrap();
+
+    req.bindingName = bindingName;
+    req.names = ArrayPrototypeSlice(names);
+    req.oncomplete = onresolvemany;
+    req.resolve = resolve;
+
+    this._handle.queryMany(req, asciiNames, type);
+  });
+}
+
 
 const resolveMap = ObjectCreate(null);
 
 // Resolver instances correspond 1:1 to c-ares channels.
 class Resolver {
   constructor(options = undefined) {
-    const timeout = validateTimeout(options);
-    this._handle = new ChannelWrap(timeout);
+    this._handle = createChannel(options);
   }
 }
 
 Resolver.prototype.getServers = CallbackResolver.prototype.getServers;
 Resolver.prototype.setServers = CallbackResolver.prototype.setServers;
 Resolver.prototype.cancel = CallbackResolver.prototype.cancel;
+Resolver.prototype.clearCache = CallbackResolver.prototype.clearCache;
+Resolver.prototype.getCacheStatistics =
+  CallbackResolver.prototype.getCacheStatistics;
 Resolver.prototype.setLocalAddress = CallbackResolver.prototype.setLocalAddress;
 Resolver.prototype.resolveAny = resolveMap.ANY = resolver('queryAny');
 Resolver.prototype.resolve4 = resolveMap.A = resolver('queryA');
@@ -251,6 +290,7 @@ Resolver.prototype.resolve = function resolve(hostname, rrtype) {
 
   return ReflectApply(resolver, this, [hostname]);
 };
+Resolver.prototype.resolveMany = resolveMany;
 
 
 module.exports = { lookup, lookupService, Resolver };
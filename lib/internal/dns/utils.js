@@ -5,26 +5,41 @@ const {
   ArrayPrototypeJoin,
   ArrayPrototypeMap,
   ArrayPrototypePush,
+  ArrayPrototypeSlice,
+  Float64Array,
   FunctionPrototypeBind,
   NumberParseInt,
+  ObjectKeys,
+  ReflectApply,
+  SafeMap,
   StringPrototypeMatch,
   StringPrototypeReplace,
+  StringPrototypeToLowerCase,
 } = primordials;
 
 const errors = require('internal/errors');
+const { dnsException } = errors;
+const { toASCII } = require('internal/idna');
 const { isIP } = require('internal/net');
 const {
   validateArray,
   validateInt32,
+  validateObject,
   validateString,
+  validateUint32,
 } = require('internal/validators');
+const cares = internalBinding('cares_wrap');
 const {
   ChannelWrap,
+  GetAddrInfoReqWrap,
+  QueryReqWrap,
   strerror,
   AI_ADDRCONFIG,
   AI_ALL,
   AI_V4MAPPED,
-} = internalBinding('cares_wrap');
+} = cares;
+const { getLibuvNow } = internalBinding('timers');
+const { UV_EAI_NODATA, UV_EAI_NONAME } = internalBinding('uv');
 const IANA_DNS_PORT = 53;
 const IPv6RE = /^\[([^[\]]*)\]/;
 const addrSplitRE = /(^.+?)(?::(\d+))?$/;
@@ -41,17 +56,64 @@ function validateTimeout(options) {
   return timeout;
 }
 
+// Validates the options of a cache, where `true` stands for the defaults.
+function validateCacheOptions(cache, name, defaults) {
+  if (cache === true)
+    return defaults;
+  validateObject(cache, name);
+  const options = {};
+  ArrayPrototypeForEach(ObjectKeys(defaults), (key) => {
+    const value = cache[key] === undefined ? defaults[key] : cache[key];
+    validateUint32(value, `${name}.${key}`, key === 'maxEntries');
+    options[key] = value;
+  });
+  return options;
+}
+
+function validateResolverCache(options) {
+  const { cache = false } = { ...options };
+  if (cache === false)
+    return { maxEntries: 0, maxTtl: 0, negativeTtl: 0, staleTtl: 0 };
+  return validateCacheOptions(cache, 'options.cache', {
+    maxEntries: 1000,
+    maxTtl: 86400,
+    negativeTtl: 30,
+    staleTtl: 0,
+  });
+}
+
+function createChannel(options) {
+  const timeout = validateTimeout(options);
+  const { maxEntries, maxTtl, negativeTtl, staleTtl } =
+    validateResolverCache(options);
+  return new ChannelWrap(timeout, maxEntries, maxTtl, negativeTtl, staleTtl);
+}
+
 // Resolver instances correspond 1:1 to c-ares channels.
 class Resolver {
   constructor(options = undefined) {
-    const timeout = validateTimeout(options);
-    this._handle = new ChannelWrap(timeout);
+    this._handle = createChannel(options);
   }
 
   cancel() {
     this._handle.cancel();
   }
 
+  clearCache() {
+    this._handle.clearCache();
+  }
+
+  getCacheStatistics() {
+    const fields = new Float64Array(4);
+    this._handle.getCacheStatistics(fields);
+    return {
+      hits: fields[0],
+      staleHits: fields[1],
+      misses: fields[2],
+      entries: fields[3],
+    };
+  }
+
   getServers() {
     return ArrayPrototypeMap(this._handle.getServers(), (val) => {
       if (!val[1] || val[1] === IANA_DNS_PORT)
@@ -139,6 +201,7 @@ const resolverKeys = [
   'resolveAny',
   'resolveCaa',
   'resolveCname',
+  'resolveMany',
   'resolveMx',
   'resolveNaptr',
   'resolveNs',
@@ -169,6 +232,209 @@ function validateHints(hints) {
   }
 }
 
+// The record types that resolver.resolveMany() queries, with the binding
+// names that the errors of the single queries of that type are reported for.
+const resolveManyTypes = {
+  __proto__: null,
+  A: { type: 1, bindingName: 'queryA' },
+  AAAA: { type: 28, bindingName: 'queryAaaa' },
+  CAA: { type: 257, bindingName: 'queryCaa' },
+  CNAME: { type: 5, bindingName: 'queryCname' },
+  MX: { type: 15, bindingName: 'queryMx' },
+  NAPTR: { type: 35, bindingName: 'queryNaptr' },
+  NS: { type: 2, bindingName: 'queryNs' },
+  PTR: { type: 12, bindingName: 'queryPtr' },
+  SOA: { type: 6, bindingName: 'querySoa' },
+  SRV: { type: 33, bindingName: 'querySrv' },
+  TXT: { type: 16, bindingName: 'queryTxt' },
+};
+
+function validateResolveManyType(rrtype) {
+  validateString(rrtype, 'rrtype');
+  const type = resolveManyTypes[rrtype];
+  if (type === undefined)
+    throw new ERR_INVALID_ARG_VALUE('rrtype', rrtype);
+  return type;
+}
+
+function validateResolveManyNames(names) {
+  validateArray(names, 'names');
+  return ArrayPrototypeMap(names, (name, i) => {
+    validateString(name, `names[${i}]`);
+    return toASCII(name);
+  });
+}
+
+// Turns the answers of the batch into one result per name.
+function resolveManyResults(names, bindingName, codes, records) {
+  return ArrayPrototypeMap(names, (name, i) => {
+    if (codes[i] !== 0)
+      return { name, error: dnsException(codes[i], bindingName, name) };
+    return { name, records: records[i] };
+  });
+}
+
+function validateLookupResolver(resolver, name) {
+  if (resolver !== null &&
+      !(resolver !== undefined && resolver._handle instanceof ChannelWrap)) {
+    throw new ERR_INVALID_ARG_TYPE(name, ['Resolver', 'null'], resolver);
+  }
+}
+
+// The resolver that dns.lookup() and dnsPromises.lookup() use instead of
+// getaddrinfo(3), see dns.setLookupResolver().
+let lookupResolver = null;
+
+function getLookupResolver() {
+  return lookupResolver;
+}
+
+function setLookupResolver(resolver) {
+  validateLookupResolver(resolver, 'resolver');
+  lookupResolver = resolver;
+}
+
+function onchannellookup(err, addresses) {
+  // getaddrinfo(3) reports both of these as ENOTFOUND.
+  if (err === 'ENODATA' || err === 'ENONAME')
+    err = 'ENOTFOUND';
+  ReflectApply(this.req.oncomplete, this.req, [err, addresses]);
+}
+
+// Starts the lookup of hostname with getaddrinfo(3) on the threadpool, or on
+// the channel of resolver when it is not null.
+function getaddrinfo(req, hostname, family, hints, verbatim, resolver) {
+  if (resolver === null)
+    return cares.getaddrinfo(req, hostname, family, hints, verbatim);
+
+  const query = new QueryReqWrap();
+  query.req = req;
+  query.oncomplete = onchannellookup;
+  return resolver._handle.getaddrinfo(query, hostname, family, hints, verbatim);
+}
+
+function callOnComplete(req, err, addresses) {
+  if (addresses !== null)
+    addresses = ArrayPrototypeSlice(addresses);
+  ReflectApply(req.oncomplete, req, [err, addresses]);
+}
+
+// Caches the results of getaddrinfo() for a fixed time, since they do not
+// come with TTLs. It is used by dns.lookup() and dnsPromises.lookup() once it
+// is enabled with dns.setLookupCache().
+class LookupCache {
+  constructor({ maxEntries, ttl, negativeTtl, staleTtl }) {
+    this.maxEntries = maxEntries;
+    this.ttl = ttl;
+    this.negativeTtl = negativeTtl;
+    this.staleTtl = staleTtl;
+    // Ordered from the least to the most recently used.
+    this.entries = new SafeMap();
+    this.hits = 0;
+    this.staleHits = 0;
+    this.misses = 0;
+  }
+
+  // Completes req from the cache, or calls getaddrinfo() and caches
+  // its result.
+  getaddrinfo(req, hostname, family, hints, verbatim, resolver) {
+    const key =
+      `${family}:${hints}:${verbatim}:${StringPrototypeToLowerCase(hostname)}`;
+    const entry = this.entries.get(key);
+    if (entry !== undefined) {
+      const now = getLibuvNow();
+      this.entries.delete(key);
+      if (now < entry.expiresAt + this.staleTtl * 1000) {
+        this.entries.set(key, entry);
+        this.hits++;
+        if (now >= entry.expiresAt) {
+          this.staleHits++;
+          if (!entry.refreshing)
+            this.refresh(key, entry, hostname, family, hints, verbatim,
+                         resolver);
+        }
+        process.nextTick(callOnComplete, req, entry.err, entry.addresses);
+        return 0;
+      }
+    }
+
+    this.misses++;
+    const { oncomplete } = req;
+    req.oncomplete = (err, addresses) => {
+      this.store(key, err, addresses);
+      ReflectApply(oncomplete, req, [err, addresses]);
+    };
+    return getaddrinfo(req, hostname, family, hints, verbatim, resolver);
+  }
+
+  // Looks the hostname up again in the background, while its stale entry is
+  // served.
+  refresh(key, entry, hostname, family, hints, verbatim, resolver) {
+    const req = new GetAddrInfoReqWrap();
+    req.oncomplete = (err, addresses) => this.store(key, err, addresses);
+    entry.refreshing =
+      getaddrinfo(req, hostname, family, hints, verbatim, resolver) === 0;
+  }
+
+  store(key, err, addresses) {
+    let ttl;
+    if (err === 0) {
+      ttl = this.ttl;
+    } else if (err === UV_EAI_NONAME || err === UV_EAI_NODATA ||
+               err === 'ENOTFOUND') {
+      ttl = this.negativeTtl;
+    } else {
+      // The stale entry, if there is one, is served until it can be refreshed.
+      const entry = this.entries.get(key);
+      if (entry !== undefined)
+        entry.refreshing = false;
+      return;
+    }
+
+    this.entries.delete(key);
+    if (ttl === 0)
+      return;
+    this.entries.set(key, {
+      err,
+      addresses: err === 0 ? ArrayPrototypeSlice(addresses) : null,
+      expiresAt: getLibuvNow() + ttl * 1000,
+      refreshing: false,
+    });
+    if (this.entries.size > this.maxEntries)
+      this.entries.delete(this.entries.keys().next().value);
+  }
+}
+
+let lookupCache = null;
+
+function getLookupCache() {
+  return lookupCache;
+}
+
+function setLookupCache(options) {
+  if (options === false) {
+    lookupCache = null;
+    return;
+  }
+  lookupCache = new LookupCache(validateCacheOptions(options, 'options', {
+    maxEntries: 1000,
+    ttl: 30,
+    negativeTtl: 10,
+    staleTtl: 0,
+  }));
+}
+
+function getLookupCacheStatistics() {
+  if (lookupCache === null)
+    return { hits: 0, staleHits: 0, misses: 0, entries: 0 };
+  return {
+    hits: lookupCache.hits,
+    staleHits: lookupCache.staleHits,
+    misses: lookupCache.misses,
+    entries: lookupCache.entries.size,
+  };
+}
+
 let invalidHostnameWarningEmitted = false;
 
 function emitInvalidHostnameWarning(hostname) {
@@ -186,10 +452,20 @@ function emitInvalidHostnameWarning(hostname) {
 
 module.exports = {
   bindDefaultResolver,
+  createChannel,
+  getaddrinfo,
   getDefaultResolver,
+  getLookupCache,
+  getLookupCacheStatistics,
+  getLookupResolver,
+  resolveManyResults,
   setDefaultResolver,
+  setLookupCache,
+  setLookupResolver,
+  validateLookupResolver,
   validateHints,
-  validateTimeout,
+  validateResolveManyNames,
+  validateResolveManyType,
   Resolver,
   emitInvalidHostnameWarning,
 };
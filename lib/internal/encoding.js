@@ -419,6 +419,9 @@ function makeTextDecoderICU() {
         flags |= options.stream ? 0 : CONVERTER_FLAGS_FLUSH;
 
       const ret = _decode(this[kHandle], input, flags);
+      // Well-formed UTF-8 is decoded to a string directly.
+      if (typeof ret === 'string')
+        return ret;
       if (typeof ret === 'number') {
         throw new ERR_ENCODING_INVALID_ENCODED_DATA(this.encoding, ret);
       }
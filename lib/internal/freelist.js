@@ -10,12 +10,19 @@ class FreeList {
     this.ctor = ctor;
     this.max = max;
     this.list = [];
+    // Number of alloc() calls served from the list and by creating a new
+    // object, respectively.
+    this.hits = 0;
+    this.misses = 0;
   }
 
   alloc() {
-    return this.list.length > 0 ?
-      this.list.pop() :
-      ReflectApply(this.ctor, this, arguments);
+    if (this.list.length > 0) {
+      this.hits++;
+      return this.list.pop();
+    }
+    this.misses++;
+    return ReflectApply(this.ctor, this, arguments);
   }
 
   free(obj) {
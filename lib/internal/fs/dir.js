@@ -22,19 +22,25 @@ const {
   }
 } = require('internal/errors');
 
-const { FSReqCallback } = binding;
+const { FSReqCallback, kFsStatsFieldsNumber, kUsePromises } = binding;
 const internalUtil = require('internal/util');
 const {
+  Dirent,
   getDirent,
   getOptions,
+  getStatsFromBinding,
   getValidatedPath,
   handleErrorFromBinding
 } = require('internal/fs/utils');
 const {
+  validateBoolean,
   validateCallback,
+  validateObject,
   validateUint32
 } = require('internal/validators');
 
+const kDefaultWalkBatchSize = 4096;
+
 const kDirHandle = Symbol('kDirHandle');
 const kDirPath = Symbol('kDirPath');
 const kDirBufferedEntries = Symbol('kDirBufferedEntries');
@@ -277,8 +283,41 @@ function opendirSync(path, options) {
   return new Dir(handle, path, options);
 }
 
+// Yields a Dirent for every entry of the tree below path. The tree is read
+// natively, batchSize entries at a time.
+async function* walk(path, options = {}) {
+  path = getValidatedPath(path);
+  validateObject(options, 'options');
+  const {
+    stats = false,
+    bigint = false,
+    batchSize = kDefaultWalkBatchSize,
+  } = options;
+  validateBoolean(stats, 'options.stats');
+  validateBoolean(bigint, 'options.bigint');
+  validateUint32(batchSize, 'options.batchSize', true);
+
+  const root = pathModule.toNamespacedPath(path);
+  let pending = [''];
+  while (pending.length > 0) {
+    const { 0: entries, 1: values, 2: rest } =
+      await binding.walkDir(root, pending, stats, bigint, batchSize,
+                            kUsePromises);
+    pending = rest;
+    for (let i = 0; i < entries.length; i += 2) {
+      const dirent = new Dirent(entries[i], entries[i + 1]);
+      if (values !== undefined) {
+        dirent.stats =
+          getStatsFromBinding(values, (i / 2) * kFsStatsFieldsNumber);
+      }
+      yield dirent;
+    }
+  }
+}
+
 module.exports = {
   Dir,
   opendir,
-  opendirSync
+  opendirSync,
+  walk,
 };
@@ -7,24 +7,33 @@ const kIoMaxLength = 2 ** 31 - 1;
 const kReadFileBufferLength = 512 * 1024;
 const kReadFileUnknownBufferLength = 64 * 1024;
 const kWriteFileMaxChunkSize = 512 * 1024;
+const kCpDefaultConcurrency = 4;
+const kStreamDefaultReadAhead = 2;
+const kStreamMaxReadAhead = 64;
 
 const {
+  AggregateError,
+  ArrayPrototypeMap,
   ArrayPrototypePush,
   Error,
   MathMax,
   MathMin,
   NumberIsSafeInteger,
   Promise,
+  PromiseAll,
   PromisePrototypeFinally,
   PromisePrototypeThen,
+  PromiseRace,
   PromiseResolve,
   SafeArrayIterator,
+  SafeSet,
   Symbol,
   Uint8Array,
 } = primordials;
 
 const {
   F_OK,
+  COPYFILE_EXCL,
   O_SYMLINK,
   O_WRONLY,
   S_IFMT,
@@ -32,9 +41,11 @@ const {
 } = internalBinding('constants').fs;
 const binding = internalBinding('fs');
 const { Buffer } = require('buffer');
+const { transferToString } = require('internal/buffer');
 
 const {
   codes: {
+    ERR_FS_CP_UNKNOWN,
     ERR_FS_FILE_TOO_LARGE,
     ERR_INVALID_ARG_TYPE,
     ERR_INVALID_ARG_VALUE,
@@ -49,7 +60,9 @@ const {
   getDirents,
   getOptions,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   getValidatedPath,
+  getValidatedPaths,
   getValidMode,
   nullCheck,
   preprocessSymlinkDestination,
@@ -64,17 +77,20 @@ const {
   validateStringAfterArrayBufferView,
   warnOnNonPortableTemplate
 } = require('internal/fs/utils');
-const { opendir } = require('internal/fs/dir');
+const { opendir, walk } = require('internal/fs/dir');
 const {
   parseFileMode,
   validateAbortSignal,
   validateBoolean,
   validateBuffer,
+  validateInt32,
   validateInteger,
+  validateObject,
+  validateString,
   validateUint32
 } = require('internal/validators');
 const pathModule = require('path');
-const { promisify } = require('internal/util');
+const { assertCrypto, promisify } = require('internal/util');
 const { EventEmitterMixin } = require('internal/event_target');
 const { watch } = require('internal/fs/watchers');
 
@@ -92,6 +108,15 @@ const {
   JSTransferable, kDeserialize, kTransfer, kTransferList
 } = require('internal/worker/js_transferable');
 
+// Lazy loaded for readableStream().
+let Readable;
+let FastBuffer;
+let errnoException;
+let UV_EOF;
+let streamBaseState;
+let kReadBytesOrError;
+let kArrayBufferOffset;
+
 const getDirectoryEntriesPromise = promisify(getDirents);
 const validateRmOptionsPromise = promisify(validateRmOptions);
 
@@ -133,6 +158,10 @@ class FileHandle extends EventEmitterMixin(JSTransferable) {
     return fsCall(fsync, this);
   }
 
+  hash(algorithm, options) {
+    return fsCall(fhash, this, algorithm, options);
+  }
+
   read(buffer, offset, length, position) {
     return fsCall(read, this, buffer, offset, length, position);
   }
@@ -141,6 +170,10 @@ class FileHandle extends EventEmitterMixin(JSTransferable) {
     return fsCall(readv, this, buffers, position);
   }
 
+  readableStream(options) {
+    return readableStream(this, options);
+  }
+
   readFile(options) {
     return fsCall(readFile, this, options);
   }
@@ -161,8 +194,8 @@ class FileHandle extends EventEmitterMixin(JSTransferable) {
     return fsCall(write, this, buffer, offset, length, position);
   }
 
-  writev(buffers, position) {
-    return fsCall(writev, this, buffers, position);
+  writev(buffers, position, flags) {
+    return fsCall(writev, this, buffers, position, flags);
   }
 
   writeFile(data, options) {
@@ -349,7 +382,8 @@ async function readFileHandle(filehandle, options) {
                                                                totalRead);
   }
 
-  return options.encoding ? result.toString(options.encoding) : result;
+  return options.encoding ?
+    transferToString(result, options.encoding) : result;
 }
 
 // All of the functions are defined as async in order to ensure that errors
@@ -372,6 +406,76 @@ async function copyFile(src, dest, mode) {
                           kUsePromises);
 }
 
+// Copies the tree below src to dest. The files are copied with copyFile(),
+// at most options.concurrency of them at a time, and the copy goes on when
+// some of them fail: their errors are thrown together once it is done.
+async function cp(src, dest, options = {}) {
+  src = `${getValidatedPath(src, 'src')}`;
+  dest = `${getValidatedPath(dest, 'dest')}`;
+  validateObject(options, 'options');
+  const { mode = 0, concurrency = kCpDefaultConcurrency } = options;
+  const copyMode = getValidMode(mode, 'copyFile');
+  validateInteger(concurrency, 'options.concurrency', 1);
+
+  const stats = await lstat(src);
+  if (!stats.isDirectory())
+    return cpEntry(stats, src, dest, copyMode);
+
+  await mkdir(dest, { recursive: true });
+  const errors = [];
+  const running = new SafeSet();
+  try {
+    for await (const dirent of walk(src)) {
+      const from = pathModule.join(src, dirent.name);
+      const to = pathModule.join(dest, dirent.name);
+      if (dirent.isDirectory()) {
+        // The entries of a directory are only walked after it, so creating
+        // it before going on is enough to order the copies of its entries.
+        try {
+          await mkdir(to, { recursive: true });
+        } catch (err) {
+          ArrayPrototypePush(errors, err);
+        }
+        continue;
+      }
+      const copy = PromisePrototypeThen(
+        cpEntry(dirent, from, to, copyMode),
+        () => running.delete(copy),
+        (err) => {
+          ArrayPrototypePush(errors, err);
+          running.delete(copy);
+        });
+      running.add(copy);
+      if (running.size >= concurrency)
+        await PromiseRace(running);
+    }
+  } finally {
+    await PromiseAll(running);
+  }
+  if (errors.length > 0) {
+    // eslint-disable-next-line no-restricted-syntax
+    throw new AggregateError(errors, `Failed to copy ${errors.length} ` +
+                                     `entries of ${src} to ${dest}`);
+  }
+}
+
+async function cpEntry(entry, from, to, mode) {
+  if (entry.isFile())
+    return copyFile(from, to, mode);
+  if (!entry.isSymbolicLink())
+    throw new ERR_FS_CP_UNKNOWN(from);
+  const target = await readlink(from);
+  try {
+    await symlink(target, to);
+  } catch (err) {
+    // Like copyFile(), replace the destination unless COPYFILE_EXCL is set.
+    if (err.code !== 'EEXIST' || (mode & COPYFILE_EXCL) !== 0)
+      throw err;
+    await unlink(to);
+    await symlink(target, to);
+  }
+}
+
 // Note that unlike fs.open() which uses numeric file descriptors,
 // fsPromises.open() uses the fs.FileHandle class.
 async function open(path, flags, mode) {
@@ -383,6 +487,123 @@ async function open(path, flags, mode) {
                                  flagsNumber, mode, kUsePromises));
 }
 
+async function fhash(handle, algorithm, options) {
+  validateString(algorithm, 'algorithm');
+  let outputLength;
+  if (options !== undefined) {
+    validateObject(options, 'options');
+    outputLength = options.outputLength;
+    if (outputLength !== undefined)
+      validateUint32(outputLength, 'options.outputLength');
+  }
+  assertCrypto();
+  const { hashFile } = require('internal/crypto/hash');
+  return hashFile(handle.fd, algorithm, outputLength);
+}
+
+// Streams the file through a native FileHandle on the same fd, which keeps
+// `readAhead` reads in flight and pushes the buffers they were read into.
+function readableStream(filehandle, options = {}) {
+  validateObject(options, 'options');
+  const {
+    start,
+    end = Infinity,
+    highWaterMark = kReadFileUnknownBufferLength,
+    readAhead = kStreamDefaultReadAhead,
+  } = options;
+  if (start !== undefined)
+    validateInteger(start, 'options.start', 0);
+  if (end !== Infinity)
+    validateInteger(end, 'options.end', start ?? 0);
+  validateInteger(highWaterMark, 'options.highWaterMark', 0);
+  validateInteger(readAhead, 'options.readAhead', 1, kStreamMaxReadAhead);
+
+  if (filehandle.fd === -1) {
+    // eslint-disable-next-line no-restricted-syntax
+    const err = new Error('file closed');
+    err.code = 'EBADF';
+    err.syscall = 'readableStream';
+    throw err;
+  }
+
+  if (Readable === undefined) {
+    ({ Readable } = require('stream'));
+    ({ FastBuffer } = require('internal/buffer'));
+    ({ errnoException } = require('internal/errors'));
+    ({ UV_EOF } = internalBinding('uv'));
+    ({
+      streamBaseState,
+      kReadBytesOrError,
+      kArrayBufferOffset,
+    } = internalBinding('stream_wrap'));
+  }
+
+  const length = end === Infinity ? -1 : end - (start ?? 0) + 1;
+  const handle = new binding.FileHandle(filehandle.fd, start ?? -1, length,
+                                        readAhead);
+  let reading = false;
+  let onReleased;
+
+  // The fd is only closed once the stream is done with it.
+  filehandle[kRef]();
+  const onClose = () => stream.destroy();
+  filehandle.once('close', onClose);
+
+  const stream = new Readable({
+    highWaterMark,
+    read() {
+      if (reading)
+        return;
+      reading = true;
+      const err = handle.readStart();
+      if (err)
+        this.destroy(errnoException(err, 'read'));
+    },
+    destroy(err, cb) {
+      filehandle.off('close', onClose);
+      reading = false;
+      handle.readStop();
+      const release = () => {
+        filehandle[kUnref]();
+        cb(err);
+      };
+      // Reads that are in flight still use the fd. They are followed by a
+      // read of UV_EOF once they are done.
+      if (handle.releaseFD())
+        release();
+      else
+        onReleased = release;
+    },
+  });
+
+  handle.onread = (arrayBuffer) => {
+    const nread = streamBaseState[kReadBytesOrError];
+    if (stream.destroyed) {
+      if (nread === UV_EOF && onReleased !== undefined) {
+        const release = onReleased;
+        onReleased = undefined;
+        release();
+      }
+      return;
+    }
+    if (nread > 0) {
+      const offset = streamBaseState[kArrayBufferOffset];
+      if (!stream.push(new FastBuffer(arrayBuffer, offset, nread))) {
+        reading = false;
+        handle.readStop();
+      }
+    } else if (nread === UV_EOF) {
+      reading = false;
+      handle.readStop();
+      stream.push(null);
+    } else if (nread < 0) {
+      stream.destroy(errnoException(nread, 'read'));
+    }
+  };
+
+  return stream;
+}
+
 async function read(handle, bufferOrOptions, offset, length, position) {
   let buffer = bufferOrOptions;
   if (!isArrayBufferView(buffer)) {
@@ -462,14 +683,18 @@ async function write(handle, buffer, offset, length, position) {
   return { bytesWritten, buffer };
 }
 
-async function writev(handle, buffers, position) {
+async function writev(handle, buffers, position, flags = 0) {
   validateBufferArray(buffers);
+  validateInt32(flags, 'flags');
 
   if (typeof position !== 'number')
     position = null;
 
-  const bytesWritten = (await binding.writeBuffers(handle.fd, buffers, position,
-                                                   kUsePromises)) || 0;
+  // Only the writes with flags need pwritev2(), which libuv does not wrap.
+  const bytesWritten = (await (flags === 0 ?
+    binding.writeBuffers(handle.fd, buffers, position, kUsePromises) :
+    binding.writeBuffersWithFlags(handle.fd, buffers, position, flags,
+                                  kUsePromises))) || 0;
   return { bytesWritten, buffers };
 }
 
@@ -581,6 +806,17 @@ async function stat(path, options = { bigint: false }) {
   return getStatsFromBinding(result);
 }
 
+async function statMany(paths,
+                        options = { bigint: false, throwIfNoEntry: true }) {
+  paths = getValidatedPaths(paths);
+  if (paths.length === 0)
+    return [];
+  const result = await binding.statMany(
+    ArrayPrototypeMap(paths, (path) => pathModule.toNamespacedPath(path)),
+    options.bigint, kUsePromises);
+  return getStatsManyFromBinding(result, paths, options.throwIfNoEntry);
+}
+
 async function link(existingPath, newPath) {
   existingPath = getValidatedPath(existingPath, 'existingPath');
   newPath = getValidatedPath(newPath, 'newPath');
@@ -709,6 +945,21 @@ async function readFile(path, options) {
 
   checkAborted(options.signal);
 
+  // Without a signal to check between the reads, the whole file is read
+  // natively in a single threadpool request.
+  if (options.signal === undefined) {
+    path = getValidatedPath(path);
+    const flagsNumber = stringToFlags(flag);
+    const { encoding } = options;
+    if (encoding === 'utf8' || encoding === 'utf-8') {
+      return binding.readFileUtf8(pathModule.toNamespacedPath(path),
+                                  flagsNumber, kUsePromises);
+    }
+    const buffer = await binding.readFileBuffer(
+      pathModule.toNamespacedPath(path), flagsNumber, kUsePromises);
+    return encoding ? buffer.toString(encoding) : buffer;
+  }
+
   const fd = await open(path, flag, 0o666);
   return PromisePrototypeFinally(readFileHandle(fd, options), fd.close);
 }
@@ -717,8 +968,10 @@ module.exports = {
   exports: {
     access,
     copyFile,
+    cp,
     open,
     opendir: promisify(opendir),
+    walk,
     rename,
     truncate,
     rm,
@@ -729,6 +982,7 @@ module.exports = {
     symlink,
     lstat,
     stat,
+    statMany,
     link,
     unlink,
     chmod,
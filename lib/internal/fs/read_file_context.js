@@ -7,6 +7,7 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
+const { transferToString } = require('internal/buffer');
 
 const { FSReqCallback, close, read } = internalBinding('fs');
 
@@ -61,7 +62,7 @@ function readFileAfterClose(err) {
       buffer = context.buffer;
 
     if (context.encoding)
-      buffer = buffer.toString(context.encoding);
+      buffer = transferToString(buffer, context.encoding);
   } catch (err) {
     return callback(err);
   }
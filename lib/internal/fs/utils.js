@@ -2,6 +2,8 @@
 
 const {
   ArrayIsArray,
+  ArrayPrototypeMap,
+  ArrayPrototypePush,
   BigInt,
   Date,
   DateNow,
@@ -46,6 +48,7 @@ const { once } = require('internal/util');
 const { toPathIfFileURL } = require('internal/url');
 const {
   validateAbortSignal,
+  validateArray,
   validateBoolean,
   validateInt32,
   validateInteger,
@@ -99,6 +102,11 @@ const {
     }
   }
 } = internalBinding('constants');
+const {
+  cachedRealpath: cachedRealpathBinding,
+  kFsStatsFieldsNumber,
+} = internalBinding('fs');
+const { UV_ENOENT } = internalBinding('uv');
 
 // The access modes can be any of F_OK, R_OK, W_OK or X_OK. Some might not be
 // available on specific systems. They can be used in combination as well
@@ -526,6 +534,34 @@ function getStatsFromBinding(stats, offset = 0) {
   );
 }
 
+// Turns the [values, errors] result of binding.statMany() into an array with
+// the Stats of each of the paths.
+function getStatsManyFromBinding(result, paths, throwIfNoEntry) {
+  const { 0: values, 1: errors } = result;
+  const stats = [];
+  for (let i = 0; i < paths.length; i++) {
+    const errno = errors[i];
+    if (errno === 0) {
+      ArrayPrototypePush(stats,
+                         getStatsFromBinding(values, i * kFsStatsFieldsNumber));
+    } else if (errno === UV_ENOENT && throwIfNoEntry === false) {
+      ArrayPrototypePush(stats, undefined);
+    } else {
+      throw uvException({ errno, syscall: 'stat', path: paths[i] });
+    }
+  }
+  return stats;
+}
+
+// Resolves an absolute path through the native realpath cache of the module
+// loaders, see --realpath-cache-size.
+function cachedRealpath(path) {
+  const ctx = { path };
+  const result = cachedRealpathBinding(pathModule.toNamespacedPath(path), ctx);
+  handleErrorFromBinding(ctx);
+  return result;
+}
+
 function stringToFlags(flags, name = 'flags') {
   if (typeof flags === 'number') {
     validateInt32(flags, name);
@@ -651,6 +687,13 @@ const getValidatedPath = hideStackFrames((fileURLOrPath, propName = 'path') => {
   return path;
 });
 
+const getValidatedPaths = hideStackFrames((paths, propName = 'paths') => {
+  validateArray(paths, propName);
+  return ArrayPrototypeMap(paths,
+                           (path, i) => getValidatedPath(path,
+                                                         `${propName}[${i}]`));
+});
+
 const getValidatedFd = hideStackFrames((fd, propName = 'fd') => {
   if (ObjectIs(fd, -0)) {
     return 0;
@@ -850,6 +893,7 @@ const validatePosition = hideStackFrames((position, name) => {
 module.exports = {
   assertEncoding,
   BigIntStats,  // for testing
+  cachedRealpath,
   copyObject,
   Dirent,
   getDirent,
@@ -857,12 +901,14 @@ module.exports = {
   getOptions,
   getValidatedFd,
   getValidatedPath,
+  getValidatedPaths,
   getValidMode,
   handleErrorFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   realpathCacheKey: Symbol('realpathCacheKey'),
   getStatsFromBinding,
+  getStatsManyFromBinding,
   stringToFlags,
   stringToSymlinkType,
   Stats,
@@ -1,9 +1,11 @@
 'use strict';
 
 const {
+  ArrayFrom,
   FunctionPrototypeCall,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
+  SafeMap,
   Symbol,
 } = primordials;
 
@@ -21,7 +23,7 @@ const {
   StatWatcher: _StatWatcher
 } = internalBinding('fs');
 
-const { FSEvent } = internalBinding('fs_event_wrap');
+const { FSEvent, Inotify } = internalBinding('fs_event_wrap');
 const { UV_ENOSPC } = internalBinding('uv');
 const { EventEmitter } = require('events');
 
@@ -52,6 +54,11 @@ const {
 
 const assert = require('internal/assert');
 
+const isLinux = process.platform === 'linux';
+
+// How long the events of the recursive watchers are coalesced, in ms.
+const kInotifyDebounce = 10;
+
 const kOldStatus = Symbol('kOldStatus');
 const kUseBigint = Symbol('kUseBigint');
 
@@ -184,6 +191,100 @@ StatWatcher.prototype.unref = function() {
 };
 
 
+// On Linux, where libuv cannot watch recursively, the recursive watchers of
+// the thread share a native Inotify instead, and each of them gets a handle
+// that works like an FSEvent.
+let inotify = null;
+let inotifyRefs = 0;
+let inotifyLastId = 0;
+const inotifyWatches = new SafeMap();
+
+function onInotifyChange(status, events) {
+  if (status < 0) {
+    for (const watch of ArrayFrom(inotifyWatches.values()))
+      watch.onchange(status, '', null);
+    return;
+  }
+  for (let i = 0; i < events.length; i += 3) {
+    // A watch can be closed by the listeners of the previous events.
+    const watch = inotifyWatches.get(events[i]);
+    if (watch !== undefined)
+      watch.onchange(0, events[i + 1], events[i + 2]);
+  }
+}
+
+class InotifyWatch {
+  constructor() {
+    this.onchange = null;
+    this.id = 0;
+    this.referenced = false;
+  }
+
+  get initialized() {
+    return this.id !== 0;
+  }
+
+  start(filename, persistent, recursive, encoding) {
+    if (inotify === null) {
+      const handle = new Inotify();
+      handle.onchange = onInotifyChange;
+      const err = handle.start(kInotifyDebounce);
+      if (err)
+        return err;
+      handle.unref();
+      inotify = handle;
+    }
+    const id = ++inotifyLastId;
+    const err = inotify.watch(id, filename, encoding);
+    if (err) {
+      maybeCloseInotify();
+      return err;
+    }
+    this.id = id;
+    inotifyWatches.set(id, this);
+    if (persistent)
+      this.ref();
+    return 0;
+  }
+
+  close() {
+    if (this.id === 0)
+      return;
+    this.unref();
+    inotify.unwatch(this.id);
+    inotifyWatches.delete(this.id);
+    this.id = 0;
+    maybeCloseInotify();
+  }
+
+  ref() {
+    if (this.id === 0 || this.referenced)
+      return;
+    this.referenced = true;
+    if (inotifyRefs++ === 0)
+      inotify.ref();
+  }
+
+  unref() {
+    if (!this.referenced)
+      return;
+    this.referenced = false;
+    if (--inotifyRefs === 0)
+      inotify.unref();
+  }
+}
+
+function maybeCloseInotify() {
+  if (inotifyWatches.size === 0) {
+    inotify.close();
+    inotify = null;
+  }
+}
+
+function createFSEvent(recursive) {
+  return recursive && isLinux ? new InotifyWatch() : new FSEvent();
+}
+
 function FSWatcher() {
   FunctionPrototypeCall(EventEmitter, this);
 
@@ -229,13 +330,21 @@ FSWatcher.prototype[kFSWatchStart] = function(filename,
   if (this._handle === null) {  // closed
     return;
   }
-  assert(this._handle instanceof FSEvent, 'handle must be a FSEvent');
+  assert(this._handle instanceof FSEvent ||
+         this._handle instanceof InotifyWatch, 'handle must be a FSEvent');
   if (this._handle.initialized) {  // already started
     return;
   }
 
   filename = getValidatedPath(filename, 'filename');
 
+  if (recursive && isLinux && !(this._handle instanceof InotifyWatch)) {
+    const handle = createFSEvent(recursive);
+    handle[owner_symbol] = this;
+    handle.onchange = this._handle.onchange;
+    this._handle = handle;
+  }
+
   const err = this._handle.start(toNamespacedPath(filename),
                                  persistent,
                                  recursive,
@@ -265,7 +374,8 @@ FSWatcher.prototype.close = function() {
   if (this._handle === null) {  // closed
     return;
   }
-  assert(this._handle instanceof FSEvent, 'handle must be a FSEvent');
+  assert(this._handle instanceof FSEvent ||
+         this._handle instanceof InotifyWatch, 'handle must be a FSEvent');
   if (!this._handle.initialized) {  // not started
     return;
   }
@@ -318,7 +428,7 @@ async function* watch(filename, options = {}) {
   if (signal?.aborted)
     throw new AbortError();
 
-  const handle = new FSEvent();
+  const handle = createFSEvent(recursive);
   let { promise, resolve, reject } = createDeferredPromise();
   const oncancel = () => {
     handle.close();
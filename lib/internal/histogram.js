@@ -11,9 +11,12 @@ const {
 } = primordials;
 
 const {
-  Histogram: _Histogram
+  Histogram: _Histogram,
+  decodeHistogram: _decodeHistogram,
 } = internalBinding('performance');
 
+const { Buffer } = require('buffer');
+
 const {
   customInspectSymbol: kInspect,
 } = require('internal/util');
@@ -30,6 +33,7 @@ const {
 
 const {
   validateNumber,
+  validateString,
 } = require('internal/validators');
 
 const kDestroy = Symbol('kDestroy');
@@ -111,6 +115,10 @@ class Histogram extends JSTransferable {
     this[kHandle]?.reset();
   }
 
+  encode() {
+    return this[kHandle]?.encode().toString('base64');
+  }
+
   [kDestroy]() {
     this[kHandle] = undefined;
   }
@@ -153,6 +161,12 @@ class RecordableHistogram extends Histogram {
     this[kHandle]?.recordDelta();
   }
 
+  add(other) {
+    if (!isHistogram(other))
+      throw new ERR_INVALID_ARG_TYPE('other', 'Histogram', other);
+    this[kHandle]?.add(other[kHandle]);
+  }
+
   [kClone]() {
     const handle = this[kHandle];
     return {
@@ -192,6 +206,16 @@ function createHistogram() {
   return new InternalRecordableHistogram(new _Histogram());
 }
 
+function decodeHistogram(encoded) {
+  validateString(encoded, 'encoded');
+  const handle = _decodeHistogram(Buffer.from(encoded, 'base64'));
+  if (handle === undefined) {
+    throw new ERR_INVALID_ARG_VALUE('encoded', encoded,
+                                    'is not an encoded histogram');
+  }
+  return new InternalRecordableHistogram(handle);
+}
+
 module.exports = {
   Histogram,
   RecordableHistogram,
@@ -201,4 +225,5 @@ module.exports = {
   kDestroy,
   kHandle,
   createHistogram,
+  decodeHistogram,
 };
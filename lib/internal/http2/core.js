@@ -108,9 +108,11 @@ const {
     ERR_INVALID_ARG_VALUE,
     ERR_INVALID_CHAR,
     ERR_INVALID_HTTP_TOKEN,
+    ERR_INVALID_STATE,
     ERR_OUT_OF_RANGE,
     ERR_SOCKET_CLOSED
   },
+  errnoException,
   hideStackFrames,
   AbortError
 } = require('internal/errors');
@@ -158,6 +160,7 @@ const {
 const {
   writeGeneric,
   writevGeneric,
+  releaseWriteWrap,
   onStreamRead,
   kAfterAsyncWrite,
   kMaybeDestroy,
@@ -167,6 +170,7 @@ const {
   setStreamTimeout
 } = require('internal/stream_base_commons');
 const { kTimeout } = require('internal/timers');
+const { InternalHistogram } = require('internal/histogram');
 const { isArrayBufferView } = require('internal/util/types');
 const { format } = require('internal/util/inspect');
 
@@ -224,6 +228,7 @@ const TLSServer = tls.Server;
 const kAlpnProtocol = Symbol('alpnProtocol');
 const kAuthority = Symbol('authority');
 const kEncrypted = Symbol('encrypted');
+const kHistograms = Symbol('histograms');
 const kID = Symbol('id');
 const kInit = Symbol('init');
 const kInfoHeaders = Symbol('sent-info-headers');
@@ -1373,6 +1378,24 @@ class Http2Session extends EventEmitter {
       {} : getSessionState(this[kHandle]);
   }
 
+  // The stream latency histograms, if enabled using the latencyHistograms
+  // option. The histograms keep working after the session is destroyed.
+  get histograms() {
+    let histograms = this[kHistograms];
+    if (histograms !== undefined || this.connecting || this.destroyed)
+      return histograms;
+
+    const handles = this[kHandle].getHistograms();
+    if (handles === undefined)
+      return undefined;
+    histograms = this[kHistograms] = {
+      timeToFirstHeader: new InternalHistogram(handles[0]),
+      timeToFirstByte: new InternalHistogram(handles[1]),
+      streamDuration: new InternalHistogram(handles[2]),
+    };
+    return histograms;
+  }
+
   // The settings currently in effect for the local peer. These will
   // be updated only when a settings acknowledgement has been received.
   get localSettings() {
@@ -2114,6 +2137,7 @@ class Http2Stream extends Duplex {
       req = writeGeneric(this, data, encoding, writeCallback);
 
     trackWriteState(this, req.bytes);
+    releaseWriteWrap(req);
   }
 
   _write(data, encoding, cb) {
@@ -2433,6 +2457,12 @@ function processRespondWithFD(self, fd, headers, offset = 0, length = -1,
                              self, fd, offset, length);
 }
 
+// The file contents are read into buffers that are queued on the native
+// stream as they are, and nghttp2 frames them with NGHTTP2_DATA_FLAG_NO_COPY,
+// so each byte is copied out of the kernel exactly once. sendfile() is not
+// used here: the payload has to be interleaved with a frame header at least
+// every SETTINGS_MAX_FRAME_SIZE (usually 16 KiB) bytes and it is encrypted
+// for TLS sessions, so it cannot be handed to the socket in one piece.
 function startFilePipe(self, fd, offset, length) {
   const handle = new FileHandle(fd, offset, length);
   handle.onread = onPipedFileHandleRead;
@@ -3277,6 +3307,25 @@ function getPackedSettings(settings) {
   return binding.packSettings();
 }
 
+// Takes an accepted connection away from this thread, so that it can be
+// handed to a server running in a Worker. The returned file descriptor is a
+// duplicate that remains open once this thread's socket is destroyed.
+function detachSocket(socket) {
+  if (!(socket instanceof net.Socket))
+    throw new ERR_INVALID_ARG_TYPE('socket', 'net.Socket', socket);
+  const handle = socket._handle;
+  if (socket.encrypted || handle == null || typeof handle.dupFd !== 'function')
+    throw new ERR_INVALID_ARG_VALUE('socket', socket, 'must be a TCP socket');
+  if (socket.bytesRead > 0 || socket[kSession] !== undefined)
+    throw new ERR_INVALID_STATE('The socket is already in use');
+
+  const fd = handle.dupFd();
+  if (fd < 0)
+    throw errnoException(fd, 'dupFd');
+  socket.destroy();
+  return fd;
+}
+
 function getUnpackedSettings(buf, options = {}) {
   if (!isArrayBufferView(buf) || buf.length === undefined) {
     throw new ERR_INVALID_ARG_TYPE('buf',
@@ -3341,6 +3390,7 @@ module.exports = {
   constants,
   createServer,
   createSecureServer,
+  detachSocket,
   getDefaultSettings,
   getPackedSettings,
   getUnpackedSettings,
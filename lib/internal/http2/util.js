@@ -6,7 +6,9 @@ const {
   ArrayPrototypeMap,
   ArrayPrototypePush,
   Error,
+  Float64Array,
   MathMax,
+  MathMin,
   Number,
   ObjectCreate,
   ObjectKeys,
@@ -181,6 +183,15 @@ const { settingsBuffer, optionsBuffer } = binding;
 // Node.js core as a performance optimization.
 const { sessionState, streamState } = binding;
 
+const {
+  kSessionHeaderStatsOffset,
+  kSessionHeaderStatsCount,
+  kHeaderBytesReceived,
+  kHeaderBytesSent,
+  kMaxHeaderListSizeReceived,
+  kRejectedHeaderBlocks,
+} = binding;
+
 const IDX_SETTINGS_HEADER_TABLE_SIZE = 0;
 const IDX_SETTINGS_ENABLE_PUSH = 1;
 const IDX_SETTINGS_INITIAL_WINDOW_SIZE = 2;
@@ -216,7 +227,9 @@ const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
 const IDX_OPTIONS_MAX_SETTINGS = 9;
-const IDX_OPTIONS_FLAGS = 10;
+const IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE = 10;
+const IDX_OPTIONS_LATENCY_HISTOGRAMS = 11;
+const IDX_OPTIONS_FLAGS = 12;
 
 function updateOptionsBuffer(options) {
   let flags = 0;
@@ -270,6 +283,16 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_MAX_SETTINGS] =
       MathMax(1, options.maxSettings);
   }
+  if (typeof options.maxAdaptiveWindowSize === 'number' &&
+      options.maxAdaptiveWindowSize > 0) {
+    flags |= (1 << IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE);
+    optionsBuffer[IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE] =
+      MathMin(2 ** 31 - 1, options.maxAdaptiveWindowSize);
+  }
+  if (options.latencyHistograms === true) {
+    flags |= (1 << IDX_OPTIONS_LATENCY_HISTOGRAMS);
+    optionsBuffer[IDX_OPTIONS_LATENCY_HISTOGRAMS] = 1;
+  }
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
 
@@ -398,6 +421,11 @@ function updateSettingsBuffer(settings) {
 
 function getSessionState(session) {
   session.refreshState();
+  // The header statistics are updated natively in the session's fields and
+  // do not need to be refreshed.
+  const headerStats = new Float64Array(session.fields.buffer,
+                                       kSessionHeaderStatsOffset,
+                                       kSessionHeaderStatsCount);
   return {
     effectiveLocalWindowSize:
       sessionState[IDX_SESSION_STATE_EFFECTIVE_LOCAL_WINDOW_SIZE],
@@ -416,7 +444,11 @@ function getSessionState(session) {
     deflateDynamicTableSize:
       sessionState[IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE],
     inflateDynamicTableSize:
-      sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE]
+      sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE],
+    headerBytesReceived: headerStats[kHeaderBytesReceived],
+    headerBytesSent: headerStats[kHeaderBytesSent],
+    maxHeaderListSizeReceived: headerStats[kMaxHeaderListSizeReceived],
+    rejectedHeaderBlocks: headerStats[kRejectedHeaderBlocks],
   };
 }
 
@@ -0,0 +1,113 @@
+'use strict';
+
+// Reports the outgoing HTTP requests to the inspector sessions that enabled
+// the Network domain. The diagnostics channels are only subscribed while at
+// least one session has the domain enabled, so that requests pay nothing
+// otherwise.
+
+const {
+  ArrayIsArray,
+  ArrayPrototypeJoin,
+  DateNow,
+  JSONStringify,
+  ObjectKeys,
+  String,
+  Symbol,
+} = primordials;
+
+const { emitProtocolEvent } = internalBinding('inspector');
+const dc = require('diagnostics_channel');
+const { now } = require('internal/perf/perf');
+
+const requestStartChannel = dc.channel('http.client.request.start');
+const responseFinishChannel = dc.channel('http.client.response.finish');
+
+const kRequestId = Symbol('kRequestId');
+
+let requestId = 0;
+
+function emit(event, params) {
+  emitProtocolEvent(`Network.${event}`, JSONStringify(params));
+}
+
+function getTimestamp() {
+  // The protocol uses seconds for both the monotonic time and the wall time.
+  return now() / 1000;
+}
+
+function toHeaders(headers) {
+  const result = {};
+  const keys = ObjectKeys(headers);
+  for (let i = 0; i < keys.length; i++) {
+    const value = headers[keys[i]];
+    result[keys[i]] = ArrayIsArray(value) ?
+      ArrayPrototypeJoin(value, ', ') : String(value);
+  }
+  return result;
+}
+
+function onRequestError(err) {
+  emit('loadingFailed', {
+    requestId: this[kRequestId],
+    timestamp: getTimestamp(),
+    errorText: err.message,
+  });
+}
+
+function onResponseEnd() {
+  emit('loadingFinished', {
+    requestId: this.req[kRequestId],
+    timestamp: getTimestamp(),
+  });
+}
+
+function onRequestStart({ request }) {
+  const id = `node-network-event-${++requestId}`;
+  request[kRequestId] = id;
+  const host = request.getHeader('host') || request.host;
+  emit('requestWillBeSent', {
+    requestId: id,
+    timestamp: getTimestamp(),
+    wallTime: DateNow() / 1000,
+    request: {
+      url: `${request.protocol}//${host}${request.path}`,
+      method: request.method,
+      headers: toHeaders(request.getHeaders()),
+    },
+  });
+  request.once('error', onRequestError);
+}
+
+function onResponseFinish({ request, response }) {
+  const id = request[kRequestId];
+  // The request started before the domain was enabled.
+  if (id === undefined)
+    return;
+  const host = request.getHeader('host') || request.host;
+  emit('responseReceived', {
+    requestId: id,
+    timestamp: getTimestamp(),
+    response: {
+      url: `${request.protocol}//${host}${request.path}`,
+      status: response.statusCode,
+      statusText: response.statusMessage || '',
+      headers: toHeaders(response.headers),
+    },
+  });
+  response.once('end', onResponseEnd);
+}
+
+function enable() {
+  requestStartChannel.subscribe(onRequestStart);
+  responseFinishChannel.subscribe(onResponseFinish);
+}
+
+function disable() {
+  requestStartChannel.unsubscribe(onRequestStart);
+  responseFinishChannel.unsubscribe(onResponseFinish);
+}
+
+module.exports = {
+  enable,
+  disable,
+};
@@ -21,6 +21,7 @@ const { ERR_STREAM_WRAP } = require('internal/errors').codes;
 const kCurrentWriteRequest = Symbol('kCurrentWriteRequest');
 const kCurrentShutdownRequest = Symbol('kCurrentShutdownRequest');
 const kPendingShutdownRequest = Symbol('kPendingShutdownRequest');
+const kPendingReads = Symbol('kPendingReads');
 
 function isClosing() { return this[owner_symbol].isClosing(); }
 
@@ -32,6 +33,20 @@ function onshutdown(req) { return this[owner_symbol].doShutdown(req); }
 
 function onwrite(req, bufs) { return this[owner_symbol].doWrite(req, bufs); }
 
+// Passes the chunks that the stream emitted since the last call to the
+// handle at once, so that e.g. TLS decrypts them in one go instead of calling
+// into JS for every one of them.
+function flushReads(socket) {
+  const chunks = socket[kPendingReads];
+  socket[kPendingReads] = [];
+  if (!socket._handle || chunks.length === 0)
+    return;
+  if (chunks.length === 1)
+    socket._handle.readBuffer(chunks[0]);
+  else
+    socket._handle.readBuffers(chunks);
+}
+
 /* This class serves as a wrapper for when the C++ side of Node wants access
  * to a standard JS stream. For example, TLS or HTTP do not operate on network
  * resources conceptually, although that is the common case and what we are
@@ -73,12 +88,13 @@ class JSStreamSocket extends Socket {
       }
 
       debug('data', chunk.length);
-      if (this._handle)
-        this._handle.readBuffer(chunk);
+      if (this[kPendingReads].push(chunk) === 1)
+        process.nextTick(flushReads, this);
     };
     stream.on('data', ondata);
     stream.once('end', () => {
       debug('end');
+      flushReads(this);
       if (this._handle)
         this._handle.emitEOF();
     });
@@ -91,6 +107,7 @@ class JSStreamSocket extends Socket {
 
     super({ handle, manualStart: true });
     this.stream = stream;
+    this[kPendingReads] = [];
     this[kCurrentWriteRequest] = null;
     this[kCurrentShutdownRequest] = null;
     this[kPendingShutdownRequest] = null;
@@ -190,7 +207,15 @@ class JSStreamSocket extends Socket {
         errCode = uv[`UV_${err.code}`] || uv.UV_EPIPE;
       }
 
-      // Ensure that write was dispatched
+      // Writable streams call back asynchronously, so the write can be
+      // finished right away rather than in another turn of the event loop.
+      // Ensure that write was dispatched for streams that do not, and leave
+      // writes of a closing socket to doClose(), which cancels them.
+      if (self[kCurrentWriteRequest] === req &&
+          handle !== null && self._handle === handle) {
+        self.finishWrite(handle, errCode);
+        return;
+      }
       setImmediate(() => {
         self.finishWrite(handle, errCode);
       });
@@ -0,0 +1,37 @@
+'use strict';
+
+// Runs the entry point of an application with --build-snapshot. Once the
+// event loop is empty, the state of the application is serialized into a
+// snapshot that it can later be started from with --snapshot-blob.
+
+const {
+  initializeCJSLoader,
+  initializeESMLoader,
+  setupDebugEnv,
+} = require('internal/bootstrap/pre_execution');
+const {
+  namespace: { addDeserializeCallback },
+  runSerializeCallbacks,
+} = require('internal/v8/startup_snapshot');
+const path = require('path');
+
+// Only the parts of prepareMainThreadExecution() that are needed to load
+// the application are run here. The rest of it depends on the process that
+// starts from the snapshot, and is run in that process instead.
+internalBinding('process_methods').patchProcessObject(process);
+process.argv[0] = process.execPath;
+process.argv[1] = path.resolve(process.argv[1]);
+
+setupDebugEnv();
+initializeCJSLoader();
+initializeESMLoader();
+
+markBootstrapComplete();
+
+process.on('beforeExit', runSerializeCallbacks);
+addDeserializeCallback(() => {
+  process.removeListener('beforeExit', runSerializeCallbacks);
+});
+
+const { Module } = require('internal/modules/cjs/loader');
+Module._load(process.argv[1], null, true);
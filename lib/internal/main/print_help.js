@@ -170,7 +170,12 @@ function format(
 }
 
 function print(stream) {
-  const { options, aliases } = require('internal/options');
+  const {
+    getOptionsAsMap,
+    getAliasesAsMap,
+  } = require('internal/options');
+  const options = getOptionsAsMap();
+  const aliases = getAliasesAsMap();
 
   // Use 75 % of the available width, and at least 70 characters.
   const width = MathMax(70, (stream.columns || 0) * 0.75);
@@ -23,6 +23,8 @@ const {
   initializeESMLoader,
   initializeFrozenIntrinsics,
   initializeReport,
+  initializeTimerWheel,
+  initializeAsyncContextFrame,
   loadPreloadModules,
   setupTraceCategoryState
 } = require('internal/bootstrap/pre_execution');
@@ -62,6 +64,8 @@ const assert = require('internal/assert');
 patchProcessObject();
 setupInspectorHooks();
 setupDebugEnv();
+initializeTimerWheel();
+initializeAsyncContextFrame();
 
 setupWarningHandler();
 
@@ -106,6 +110,7 @@ port.on('message', (message) => {
       doEval,
       workerData,
       publicPort,
+      poolPort,
       manifestSrc,
       manifestURL,
       hasStdin
@@ -171,6 +176,9 @@ port.on('message', (message) => {
       PromisePrototypeCatch(evalModule(filename), (e) => {
         workerOnGlobalUncaughtException(e, true);
       });
+    } else if (poolPort !== undefined) {
+      ArrayPrototypeSplice(process.argv, 1, 0, filename);
+      require('internal/worker/pool').runPoolWorker(filename, poolPort);
     } else {
       // script filename
       // runMain here might be monkey-patched by users in --require.
@@ -78,7 +78,7 @@ const {
   rekeySourceMap
 } = require('internal/source_map/source_map_cache');
 const { pathToFileURL, fileURLToPath, isURLInstance } = require('internal/url');
-const { deprecate } = require('internal/util');
+const { deprecate, kVmUseCodeCacheSymbol } = require('internal/util');
 const vm = require('vm');
 const assert = require('internal/assert');
 const fs = require('fs');
@@ -97,6 +97,7 @@ const {
 } = require('internal/modules/cjs/helpers');
 const { getOptionValue } = require('internal/options');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
+const realpathCacheSize = getOptionValue('--realpath-cache-size');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
 // Do not eagerly grab .manifest, it may be in TDZ
 const policy = getOptionValue('--experimental-policy') ?
@@ -288,28 +289,28 @@ function readPackage(requestPath) {
   if (existing !== undefined) return existing;
 
   const result = packageJsonReader.read(jsonPath);
-  const json = result.containsKeys === false ? '{}' : result.string;
-  if (json === undefined) {
+  if (!result.exists) {
     packageJsonCache.set(jsonPath, false);
     return false;
   }
 
-  try {
-    const parsed = JSONParse(json);
-    const filtered = {
-      name: parsed.name,
-      main: parsed.main,
-      exports: parsed.exports,
-      imports: parsed.imports,
-      type: parsed.type
-    };
-    packageJsonCache.set(jsonPath, filtered);
-    return filtered;
-  } catch (e) {
+  if (result.containsKeys && result.error !== undefined) {
+    // The error is shared with the ES module loader, so it is not modified.
+    const { error } = result;
+    const e = new error.constructor(
+      'Error parsing ' + jsonPath + ': ' + error.message);
     e.path = jsonPath;
-    e.message = 'Error parsing ' + jsonPath + ': ' + e.message;
     throw e;
   }
+  const filtered = {
+    name: result.name,
+    main: result.main,
+    exports: result.exports,
+    imports: result.imports,
+    type: result.type
+  };
+  packageJsonCache.set(jsonPath, filtered);
+  return filtered;
 }
 
 function readPackageScope(checkPath) {
@@ -385,6 +386,8 @@ function tryFile(requestPath, isMain) {
 }
 
 function toRealPath(requestPath) {
+  if (realpathCacheSize > 0)
+    return internalFS.cachedRealpath(requestPath);
   return fs.realpathSync(requestPath, {
     [internalFS.realpathCacheKey]: realpathCache
   });
@@ -1034,6 +1037,7 @@ function wrapSafe(filename, content, cjsModuleInstance) {
         const loader = asyncESM.ESMLoader;
         return loader.import(specifier, normalizeReferrerURL(filename));
       },
+      [kVmUseCodeCacheSymbol]: true,
     });
   } catch (err) {
     if (process.mainModule === cjsModuleInstance)
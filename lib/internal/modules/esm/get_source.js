@@ -2,6 +2,7 @@
 
 const {
   RegExpPrototypeExec,
+  StringPrototypeStartsWith,
   decodeURIComponent,
 } = primordials;
 const { getOptionValue } = require('internal/options');
@@ -12,13 +13,14 @@ const policy = getOptionValue('--experimental-policy') ?
 
 const { Buffer } = require('buffer');
 
-const fs = require('internal/fs/promises').exports;
 const { URL } = require('internal/url');
 const {
   ERR_INVALID_URL,
   ERR_INVALID_URL_SCHEME,
 } = require('internal/errors').codes;
-const readFileAsync = fs.readFile;
+// internal/fs/promises is loaded on first use, since it is not needed by
+// applications that do not import ES modules.
+let readFileAsync;
 
 const DATA_URL_PATTERN = /^[^/]+\/[^,;]+(?:[^,]*?)(;base64)?,([\s\S]*)$/;
 
@@ -26,6 +28,8 @@ async function defaultGetSource(url, { format } = {}, defaultGetSource) {
   const parsed = new URL(url);
   let source;
   if (parsed.protocol === 'file:') {
+    if (readFileAsync === undefined)
+      readFileAsync = require('internal/fs/promises').exports.readFile;
     source = await readFileAsync(parsed);
   } else if (parsed.protocol === 'data:') {
     const match = RegExpPrototypeExec(DATA_URL_PATTERN, parsed.pathname);
@@ -43,3 +47,15 @@ async function defaultGetSource(url, { format } = {}, defaultGetSource) {
   return { source };
 }
 exports.defaultGetSource = defaultGetSource;
+
+// Returns the source of a file: URL as a string, read and decoded in a
+// single native request. Returns undefined if the source has to go through
+// a Buffer for other reasons, e.g. to check its integrity.
+async function getFileSourceString(url) {
+  if (!StringPrototypeStartsWith(url, 'file:') || policy?.manifest)
+    return undefined;
+  if (readFileAsync === undefined)
+    readFileAsync = require('internal/fs/promises').exports.readFile;
+  return readFileAsync(new URL(url), 'utf8');
+}
+exports.getFileSourceString = getFileSourceString;
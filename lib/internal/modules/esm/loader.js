@@ -126,16 +126,19 @@ class Loader {
       }
     }
 
-    if (this._resolve === defaultResolve &&
-      !StringPrototypeStartsWith(url, 'file:') &&
-      !StringPrototypeStartsWith(url, 'data:')
-    ) {
+    if (this._resolve === defaultResolve)
+      this._checkDefaultResolveURL(url);
+
+    return format;
+  }
+
+  _checkDefaultResolveURL(url) {
+    if (!StringPrototypeStartsWith(url, 'file:') &&
+        !StringPrototypeStartsWith(url, 'data:')) {
       throw new ERR_INVALID_RETURN_PROPERTY(
         'file: or data: url', 'loader resolve', 'url', url
       );
     }
-
-    return format;
   }
 
   async eval(
@@ -227,8 +230,28 @@ class Loader {
   }
 
   async getModuleJob(specifier, parentURL) {
-    const url = await this.resolve(specifier, parentURL);
-    const format = await this.getFormat(url);
+    let url;
+    let format;
+    if (this._resolve === defaultResolve &&
+        this._getFormat === defaultGetFormat) {
+      // The default hooks are synchronous and return valid results, so
+      // there is no need to wait for them.
+      if (parentURL !== undefined)
+        validateString(parentURL, 'parentURL');
+      ({ url } = defaultResolve(
+        specifier, { parentURL, conditions: DEFAULT_CONDITIONS }));
+      ({ format } = defaultGetFormat(url, {}));
+      // It has no format for data: URLs of unknown MIME types.
+      if (typeof format !== 'string') {
+        throw new ERR_INVALID_RETURN_PROPERTY_VALUE(
+          'string', 'loader getFormat', 'format', format);
+      }
+      if (format !== 'builtin')
+        this._checkDefaultResolveURL(url);
+    } else {
+      url = await this.resolve(specifier, parentURL);
+      format = await this.getFormat(url);
+    }
     let job = this.moduleMap.get(url);
     // CommonJS will set functions for lazy job evaluation.
     if (typeof job === 'function')
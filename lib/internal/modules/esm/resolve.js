@@ -4,7 +4,6 @@ const {
   ArrayIsArray,
   ArrayPrototypeJoin,
   ArrayPrototypeShift,
-  JSONParse,
   JSONStringify,
   ObjectFreeze,
   ObjectGetOwnPropertyNames,
@@ -25,18 +24,16 @@ const {
 } = primordials;
 const internalFS = require('internal/fs/utils');
 const { NativeModule } = require('internal/bootstrap/loaders');
-const {
-  realpathSync,
-  statSync,
-  Stats,
-} = require('fs');
+const { realpathSync } = require('fs');
+const { internalModuleStat } = internalBinding('fs');
 const { getOptionValue } = require('internal/options');
 // Do not eagerly grab .manifest, it may be in TDZ
 const policy = getOptionValue('--experimental-policy') ?
   require('internal/process/policy') :
   null;
-const { sep, relative } = require('path');
+const { sep, relative, toNamespacedPath } = require('path');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
+const realpathCacheSize = getOptionValue('--realpath-cache-size');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
 const typeFlag = getOptionValue('--input-type');
 const { URL, pathToFileURL, fileURLToPath } = require('internal/url');
@@ -134,16 +131,16 @@ function getConditionsSet(conditions) {
 const realpathCache = new SafeMap();
 const packageJSONCache = new SafeMap();  /* string -> PackageConfig */
 
-const tryStatSync =
-  (path) => statSync(path, { throwIfNoEntry: false }) ?? new Stats();
+// Returns 0 for files, 1 for directories and a negative number otherwise.
+const stat = (path) => internalModuleStat(toNamespacedPath(path));
 
 function getPackageConfig(path, specifier, base) {
   const existing = packageJSONCache.get(path);
   if (existing !== undefined) {
     return existing;
   }
-  const source = packageJsonReader.read(path).string;
-  if (source === undefined) {
+  const packageJSON = packageJsonReader.read(path, true);
+  if (!packageJSON.exists) {
     const packageConfig = {
       pjsonPath: path,
       exists: false,
@@ -157,14 +154,11 @@ function getPackageConfig(path, specifier, base) {
     return packageConfig;
   }
 
-  let packageJSON;
-  try {
-    packageJSON = JSONParse(source);
-  } catch (error) {
+  if (packageJSON.error !== undefined) {
     throw new ERR_INVALID_PACKAGE_CONFIG(
       path,
       (base ? `"${specifier}" from ` : '') + fileURLToPath(base || specifier),
-      error.message
+      packageJSON.error.message
     );
   }
 
@@ -229,7 +223,7 @@ function getPackageScopeConfig(resolved) {
  * 5. NOT_FOUND
  */
 function fileExists(url) {
-  return tryStatSync(fileURLToPath(url)).isFile();
+  return stat(fileURLToPath(url)) === 0;
 }
 
 function legacyMainResolve(packageJSONUrl, packageConfig, base) {
@@ -313,13 +307,13 @@ function finalizeResolution(resolved, base) {
       resolved.pathname, fileURLToPath(base), 'module');
   }
 
-  const stats = tryStatSync(StringPrototypeEndsWith(path, '/') ?
+  const rc = stat(StringPrototypeEndsWith(path, '/') ?
     StringPrototypeSlice(path, -1) : path);
-  if (stats.isDirectory()) {
+  if (rc === 1) {
     const err = new ERR_UNSUPPORTED_DIR_IMPORT(path, fileURLToPath(base));
     err.url = String(resolved);
     throw err;
-  } else if (!stats.isFile()) {
+  } else if (rc !== 0) {
     throw new ERR_MODULE_NOT_FOUND(
       path || resolved.pathname, base && fileURLToPath(base), 'module');
   }
@@ -686,9 +680,9 @@ function packageResolve(specifier, base, conditions) {
   let packageJSONPath = fileURLToPath(packageJSONUrl);
   let lastPath;
   do {
-    const stat = tryStatSync(StringPrototypeSlice(packageJSONPath, 0,
-                                                  packageJSONPath.length - 13));
-    if (!stat.isDirectory()) {
+    const rc = stat(StringPrototypeSlice(packageJSONPath, 0,
+                                         packageJSONPath.length - 13));
+    if (rc !== 1) {
       lastPath = packageJSONPath;
       packageJSONUrl = new URL((isScoped ?
         '../../../../node_modules/' : '../../../node_modules/') +
@@ -892,9 +886,11 @@ function defaultResolve(specifier, context = {}, defaultResolveUnused) {
 
   if (isMain ? !preserveSymlinksMain : !preserveSymlinks) {
     const urlPath = fileURLToPath(url);
-    const real = realpathSync(urlPath, {
-      [internalFS.realpathCacheKey]: realpathCache
-    });
+    const real = realpathCacheSize > 0 ?
+      internalFS.cachedRealpath(urlPath) :
+      realpathSync(urlPath, {
+        [internalFS.realpathCacheKey]: realpathCache
+      });
     const old = url;
     url = pathToFileURL(
       real + (StringPrototypeEndsWith(urlPath, sep) ? '/' : ''));
@@ -40,8 +40,10 @@ const {
   cjsParseCache
 } = require('internal/modules/cjs/loader');
 const internalURLModule = require('internal/url');
-const { defaultGetSource } = require(
-  'internal/modules/esm/get_source');
+const {
+  defaultGetSource,
+  getFileSourceString,
+} = require('internal/modules/esm/get_source');
 const { defaultTransformSource } = require(
   'internal/modules/esm/transform_source');
 const createDynamicModule = require(
@@ -136,15 +138,26 @@ function initializeImportMeta(meta, { url }) {
 
 // Strategy for loading a standard JavaScript module.
 translators.set('module', async function moduleStrategy(url) {
-  let { source } = await this._getSource(
-    url, { format: 'module' }, defaultGetSource);
-  assertBufferSource(source, true, 'getSource');
-  ({ source } = await this._transformSource(
-    source, { url, format: 'module' }, defaultTransformSource));
-  source = stringify(source);
+  let source;
+  // Without loader hooks for the source, read files as strings right away
+  // instead of decoding a Buffer.
+  if (this._getSource === defaultGetSource &&
+      this._transformSource === defaultTransformSource) {
+    source = await getFileSourceString(url);
+    if (source !== undefined)
+      source = stripBOM(source);
+  }
+  if (source === undefined) {
+    ({ source } = await this._getSource(
+      url, { format: 'module' }, defaultGetSource));
+    assertBufferSource(source, true, 'getSource');
+    ({ source } = await this._transformSource(
+      source, { url, format: 'module' }, defaultTransformSource));
+    source = stringify(source);
+  }
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  const module = new ModuleWrap(url, undefined, source, 0, 0, undefined, true);
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta,
     importModuleDynamically,
@@ -1,29 +1,62 @@
 'use strict';
 
-const { SafeMap } = primordials;
+const {
+  JSONParse,
+  SafeMap,
+} = primordials;
 const { internalModuleReadJSON } = internalBinding('fs');
 const { pathToFileURL } = require('url');
 const { toNamespacedPath } = require('path');
 
+// The package.json files that the CommonJS and ES module loaders have read,
+// of which only the fields that the loaders use are kept.
 const cache = new SafeMap();
 
 let manifest;
 
 /**
+ * @typedef {{
+ *   exists: boolean,
+ *   containsKeys: boolean,
+ *   parsed: boolean,
+ *   error?: Error,
+ *   name?: any,
+ *   main?: any,
+ *   exports?: any,
+ *   imports?: any,
+ *   type?: any,
+ * }} PackageJSON
+ *
+ * `containsKeys` is false if the file does not mention any of the fields,
+ * in which case it is not `parsed` unless it has to be validated. `error` is
+ * set if the file could not be parsed, and is left for the caller to report.
  *
  * @param {string} jsonPath
+ * @param {boolean} [validate] Whether to parse the file even if it does not
+ *   contain any of the fields.
+ * @returns {PackageJSON}
  */
-function read(jsonPath) {
-  if (cache.has(jsonPath)) {
-    return cache.get(jsonPath);
-  }
+function read(jsonPath, validate = false) {
+  const existing = cache.get(jsonPath);
+  if (existing !== undefined && (existing.parsed || !validate))
+    return existing;
 
   const { 0: string, 1: containsKeys } = internalModuleReadJSON(
     toNamespacedPath(jsonPath)
   );
-  const result = { string, containsKeys };
-  const { getOptionValue } = require('internal/options');
-  if (string !== undefined) {
+  const result = {
+    exists: string !== undefined,
+    containsKeys: containsKeys !== false,
+    parsed: false,
+    error: undefined,
+    name: undefined,
+    main: undefined,
+    exports: undefined,
+    imports: undefined,
+    type: undefined,
+  };
+  if (result.exists) {
+    const { getOptionValue } = require('internal/options');
     if (manifest === undefined) {
       manifest = getOptionValue('--experimental-policy') ?
         require('internal/process/policy').manifest :
@@ -33,6 +66,21 @@ function read(jsonPath) {
       const jsonURL = pathToFileURL(jsonPath);
       manifest.assertIntegrity(jsonURL, string);
     }
+    if (result.containsKeys || validate) {
+      result.parsed = true;
+      try {
+        const parsed = JSONParse(string);
+        result.name = parsed.name;
+        result.main = parsed.main;
+        result.exports = parsed.exports;
+        result.imports = parsed.imports;
+        result.type = parsed.type;
+      } catch (error) {
+        result.error = error;
+      }
+    }
+  } else {
+    result.parsed = true;
   }
   cache.set(jsonPath, result);
   return result;
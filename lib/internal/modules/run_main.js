@@ -2,6 +2,7 @@
 
 const {
   PromisePrototypeFinally,
+  PromisePrototypeThen,
   StringPrototypeEndsWith,
 } = primordials;
 const CJSLoader = require('internal/modules/cjs/loader');
@@ -9,6 +10,19 @@ const { Module, toRealPath, readPackageScope } = CJSLoader;
 const { getOptionValue } = require('internal/options');
 const path = require('path');
 
+function markMainModuleLoaded() {
+  // The performance binding cannot be loaded while building a snapshot.
+  if (getOptionValue('--build-snapshot'))
+    return;
+  const {
+    constants: {
+      NODE_PERFORMANCE_MILESTONE_MAIN_MODULE_LOADED,
+    },
+    markMilestone,
+  } = internalBinding('performance');
+  markMilestone(NODE_PERFORMANCE_MILESTONE_MAIN_MODULE_LOADED);
+}
+
 function resolveMainPath(main) {
   // Note extension resolution for the main entry point can be deprecated in a
   // future major.
@@ -47,7 +61,7 @@ function runMainESM(mainPath) {
   handleMainPromise(esmLoader.loadESM((ESMLoader) => {
     const main = path.isAbsolute(mainPath) ?
       pathToFileURL(mainPath).href : mainPath;
-    return ESMLoader.import(main);
+    return PromisePrototypeThen(ESMLoader.import(main), markMainModuleLoaded);
   }));
 }
 
@@ -74,6 +88,7 @@ function executeUserEntryPoint(main = process.argv[1]) {
   } else {
     // Module._load is the monkey-patchable CJS module loader.
     Module._load(main, null, true);
+    markMainModuleLoaded();
   }
 }
 
@@ -1,12 +1,37 @@
 'use strict';
 
 const { getOptions, shouldNotRegisterESMLoader } = internalBinding('options');
-const { options, aliases } = getOptions();
 
 let warnOnAllowUnauthorized = true;
 
+// The options are only read from the binding once they are needed, so that
+// the values of a process that starts from a user-land snapshot are not the
+// ones of the process that built the snapshot.
+let options;
+let aliases;
+
+function loadOptions() {
+  if (options === undefined)
+    ({ options, aliases } = getOptions());
+}
+
+function getOptionsAsMap() {
+  loadOptions();
+  return options;
+}
+
+function getAliasesAsMap() {
+  loadOptions();
+  return aliases;
+}
+
+function refreshOptions() {
+  options = undefined;
+  aliases = undefined;
+}
+
 function getOptionValue(option) {
-  return options.get(option)?.value;
+  return getOptionsAsMap().get(option)?.value;
 }
 
 function getAllowUnauthorized() {
@@ -24,9 +49,10 @@ function getAllowUnauthorized() {
 }
 
 module.exports = {
-  options,
-  aliases,
+  getOptionsAsMap,
+  getAliasesAsMap,
   getOptionValue,
   getAllowUnauthorized,
+  refreshOptions,
   shouldNotRegisterESMLoader
 };
@@ -0,0 +1,29 @@
+'use strict';
+
+const {
+  ObjectKeys,
+} = primordials;
+
+const {
+  getEventLoopPhaseHistograms,
+} = internalBinding('performance');
+
+const { InternalHistogram } = require('internal/histogram');
+
+// Recording starts with the first call, and continues for as long as the
+// environment exists. All calls return views of the same histograms.
+function monitorEventLoopPhases() {
+  const handles = getEventLoopPhaseHistograms();
+  const result = {};
+  const phases = ObjectKeys(handles);
+  for (let i = 0; i < phases.length; i++) {
+    const { 0: time, 1: callbacks } = handles[phases[i]];
+    result[phases[i]] = {
+      time: new InternalHistogram(time),
+      callbacks: new InternalHistogram(callbacks),
+    };
+  }
+  return result;
+}
+
+module.exports = monitorEventLoopPhases;
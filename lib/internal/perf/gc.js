@@ -0,0 +1,76 @@
+'use strict';
+
+const {
+  ObjectKeys,
+} = primordials;
+
+const {
+  getGCMonitor,
+} = internalBinding('performance');
+
+const { InternalHistogram } = require('internal/histogram');
+
+// The fields that follow the count and the pause time of each type of GC,
+// see GCMonitorFields in src/env.h.
+const kBytesAllocated = 0;
+const kBytesFreed = 1;
+const kBytesPromoted = 2;
+const kHeapSpaceFields = 3;
+
+class GCMonitor {
+  #fields;
+  #heapSpaces;
+  #types;
+
+  constructor(fields, heapSpaces, pause, allocationRate) {
+    this.#fields = fields;
+    this.#heapSpaces = heapSpaces;
+    this.#types = ObjectKeys(pause);
+    this.pause = {};
+    for (let i = 0; i < this.#types.length; i++)
+      this.pause[this.#types[i]] = new InternalHistogram(pause[this.#types[i]]);
+    this.allocationRate = new InternalHistogram(allocationRate);
+  }
+
+  // Reads the counters that the GC callbacks keep up to date, without
+  // calling into C++.
+  stats() {
+    const fields = this.#fields;
+    const types = this.#types;
+    const result = {};
+    for (let i = 0; i < types.length; i++) {
+      result[types[i]] = {
+        count: fields[2 * i],
+        pauseTime: fields[2 * i + 1],
+      };
+    }
+    const offset = 2 * types.length;
+    result.bytesAllocated = fields[offset + kBytesAllocated];
+    result.bytesFreed = fields[offset + kBytesFreed];
+    result.bytesPromoted = fields[offset + kBytesPromoted];
+    result.heapSpaces = {};
+    for (let i = 0; i < this.#heapSpaces.length; i++) {
+      const index = offset + kHeapSpaceFields + 2 * i;
+      result.heapSpaces[this.#heapSpaces[i]] = {
+        used: fields[index],
+        size: fields[index + 1],
+      };
+    }
+    return result;
+  }
+}
+
+// Recording starts with the first call, and continues for as long as the
+// environment exists. All calls return views of the same histograms and
+// counters.
+function monitorGC() {
+  const {
+    0: fields,
+    1: heapSpaces,
+    2: pause,
+    3: allocationRate,
+  } = getGCMonitor();
+  return new GCMonitor(fields, heapSpaces, pause, allocationRate);
+}
+
+module.exports = monitorGC;
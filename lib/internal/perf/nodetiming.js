@@ -26,7 +26,10 @@ const {
     NODE_PERFORMANCE_MILESTONE_LOOP_START,
     NODE_PERFORMANCE_MILESTONE_LOOP_EXIT,
     NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
-    NODE_PERFORMANCE_MILESTONE_ENVIRONMENT
+    NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
+    NODE_PERFORMANCE_MILESTONE_CONTEXT_READY,
+    NODE_PERFORMANCE_MILESTONE_INTERNAL_BOOTSTRAP_COMPLETE,
+    NODE_PERFORMANCE_MILESTONE_MAIN_MODULE_LOADED,
   },
   loopIdleTime,
   milestones,
@@ -47,6 +50,9 @@ const readOnlyAttributes = new SafeSet(new SafeArrayIterator([
   'loopStart',
   'loopExit',
   'bootstrapComplete',
+  'contextReady',
+  'internalBootstrapComplete',
+  'mainModuleLoaded',
 ]));
 
 class PerformanceNodeTiming {
@@ -100,6 +106,24 @@ class PerformanceNodeTiming {
         }
       },
 
+      contextReady: {
+        enumerable: true,
+        configurable: true,
+        get() {
+          return getMilestoneTimestamp(
+            NODE_PERFORMANCE_MILESTONE_CONTEXT_READY);
+        }
+      },
+
+      internalBootstrapComplete: {
+        enumerable: true,
+        configurable: true,
+        get() {
+          return getMilestoneTimestamp(
+            NODE_PERFORMANCE_MILESTONE_INTERNAL_BOOTSTRAP_COMPLETE);
+        }
+      },
+
       loopStart: {
         enumerable: true,
         configurable: true,
@@ -125,6 +149,15 @@ class PerformanceNodeTiming {
         }
       },
 
+      mainModuleLoaded: {
+        enumerable: true,
+        configurable: true,
+        get() {
+          return getMilestoneTimestamp(
+            NODE_PERFORMANCE_MILESTONE_MAIN_MODULE_LOADED);
+        }
+      },
+
       idleTime: {
         enumerable: true,
         configurable: true,
@@ -154,6 +187,9 @@ class PerformanceNodeTiming {
       v8Start: this.v8Start,
       bootstrapComplete: this.bootstrapComplete,
       environment: this.environment,
+      contextReady: this.contextReady,
+      internalBootstrapComplete: this.internalBootstrapComplete,
+      mainModuleLoaded: this.mainModuleLoaded,
       loopStart: this.loopStart,
       loopExit: this.loopExit,
       idleTime: this.idleTime,
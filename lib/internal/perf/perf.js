@@ -1,13 +1,14 @@
 'use strict';
 
 const {
+  Float64Array,
   ObjectSetPrototypeOf,
   Symbol,
   TypeError,
 } = primordials;
 
 const {
-  timeOrigin,
+  fastNow,
 } = internalBinding('performance');
 
 const {
@@ -23,9 +24,11 @@ const kDuration = Symbol('kDuration');
 const kDetail = Symbol('kDetail');
 const kReadOnlyAttributes = Symbol('kReadOnlyAttributes');
 
+const nowValues = new Float64Array(fastNow.buffer);
+
 function now() {
-  const hr = process.hrtime();
-  return (hr[0] * 1000 + hr[1] / 1e6) - timeOrigin;
+  fastNow.now();
+  return nowValues[0];
 }
 
 function isPerformanceEntry(obj) {
@@ -0,0 +1,29 @@
+'use strict';
+
+const {
+  ObjectKeys,
+} = primordials;
+
+const {
+  getThreadpoolHistograms,
+} = internalBinding('performance');
+
+const { InternalHistogram } = require('internal/histogram');
+
+// Recording starts with the first call, and continues for as long as the
+// environment exists. All calls return views of the same histograms.
+function monitorThreadpool() {
+  const handles = getThreadpoolHistograms();
+  const result = {};
+  const classes = ObjectKeys(handles);
+  for (let i = 0; i < classes.length; i++) {
+    const { 0: wait, 1: run } = handles[classes[i]];
+    result[classes[i]] = {
+      wait: new InternalHistogram(wait),
+      run: new InternalHistogram(run),
+    };
+  }
+  return result;
+}
+
+module.exports = monitorThreadpool;
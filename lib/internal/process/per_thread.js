@@ -32,6 +32,7 @@ const {
 
 const {
   errnoException,
+  uvException,
   codes: {
     ERR_ASSERTION,
     ERR_INVALID_ARG_TYPE,
@@ -43,6 +44,7 @@ const {
 const format = require('internal/util/inspect').format;
 const {
   validateArray,
+  validateInteger,
   validateObject,
 } = require('internal/validators');
 const constants = internalBinding('constants').os.signals;
@@ -55,7 +57,8 @@ function assert(x, msg) {
 
 function getFastAPIs(binding) {
   const {
-    hrtime: _hrtime
+    hrtime: _hrtime,
+    usage: _usage,
   } = binding.getFastAPIs();
 
   // The 3 entries filled in by the original process.hrtime contains
@@ -92,9 +95,85 @@ function getFastAPIs(binding) {
     return hrBigintValues[0];
   }
 
+  // The values of memoryUsage() come first, followed by the status of the
+  // last call and the values of resourceUsage().
+  const usageValues = new Float64Array(_usage.buffer);
+  const kUsageStatus = 5;
+  const kResourceUsage = 6;
+
+  function memoryUsage(options) {
+    let maxRssAge = 0;
+    if (options !== undefined) {
+      validateObject(options, 'options');
+      if (options.maxRssAge !== undefined) {
+        validateInteger(options.maxRssAge, 'options.maxRssAge', 0);
+        maxRssAge = options.maxRssAge;
+      }
+    }
+    _usage.memoryUsage(maxRssAge);
+    if (usageValues[kUsageStatus] !== 0) {
+      throw uvException({
+        errno: usageValues[kUsageStatus],
+        syscall: 'uv_resident_set_memory'
+      });
+    }
+    return {
+      rss: usageValues[0],
+      heapTotal: usageValues[1],
+      heapUsed: usageValues[2],
+      external: usageValues[3],
+      arrayBuffers: usageValues[4]
+    };
+  }
+
+  function heap() {
+    _usage.heapUsage();
+    return {
+      heapTotal: usageValues[1],
+      heapUsed: usageValues[2],
+      external: usageValues[3],
+      arrayBuffers: usageValues[4]
+    };
+  }
+
+  memoryUsage.rss = binding.rss;
+  memoryUsage.heap = heap;
+  memoryUsage.arrayBufferPool = binding.arrayBufferPoolStatistics;
+  memoryUsage.largePages = binding.largePagesStatistics;
+
+  function resourceUsage() {
+    _usage.resourceUsage();
+    if (usageValues[kUsageStatus] !== 0) {
+      throw uvException({
+        errno: usageValues[kUsageStatus],
+        syscall: 'uv_getrusage'
+      });
+    }
+    return {
+      userCPUTime: usageValues[kResourceUsage],
+      systemCPUTime: usageValues[kResourceUsage + 1],
+      maxRSS: usageValues[kResourceUsage + 2],
+      sharedMemorySize: usageValues[kResourceUsage + 3],
+      unsharedDataSize: usageValues[kResourceUsage + 4],
+      unsharedStackSize: usageValues[kResourceUsage + 5],
+      minorPageFault: usageValues[kResourceUsage + 6],
+      majorPageFault: usageValues[kResourceUsage + 7],
+      swappedOut: usageValues[kResourceUsage + 8],
+      fsRead: usageValues[kResourceUsage + 9],
+      fsWrite: usageValues[kResourceUsage + 10],
+      ipcSent: usageValues[kResourceUsage + 11],
+      ipcReceived: usageValues[kResourceUsage + 12],
+      signalsCount: usageValues[kResourceUsage + 13],
+      voluntaryContextSwitches: usageValues[kResourceUsage + 14],
+      involuntaryContextSwitches: usageValues[kResourceUsage + 15]
+    };
+  }
+
   return {
     hrtime,
     hrtimeBigInt,
+    memoryUsage,
+    resourceUsage,
   };
 }
 
@@ -102,9 +181,6 @@ function getFastAPIs(binding) {
 function wrapProcessMethods(binding) {
   const {
     cpuUsage: _cpuUsage,
-    memoryUsage: _memoryUsage,
-    rss,
-    resourceUsage: _resourceUsage
   } = binding;
 
   function _rawDebug(...args) {
@@ -166,20 +242,6 @@ function wrapProcessMethods(binding) {
         num >= 0;
   }
 
-  const memValues = new Float64Array(5);
-  function memoryUsage() {
-    _memoryUsage(memValues);
-    return {
-      rss: memValues[0],
-      heapTotal: memValues[1],
-      heapUsed: memValues[2],
-      external: memValues[3],
-      arrayBuffers: memValues[4]
-    };
-  }
-
-  memoryUsage.rss = rss;
-
   function exit(code) {
     if (code || code === 0)
       process.exitCode = code;
@@ -222,35 +284,9 @@ function wrapProcessMethods(binding) {
     return true;
   }
 
-  const resourceValues = new Float64Array(16);
-  function resourceUsage() {
-    _resourceUsage(resourceValues);
-    return {
-      userCPUTime: resourceValues[0],
-      systemCPUTime: resourceValues[1],
-      maxRSS: resourceValues[2],
-      sharedMemorySize: resourceValues[3],
-      unsharedDataSize: resourceValues[4],
-      unsharedStackSize: resourceValues[5],
-      minorPageFault: resourceValues[6],
-      majorPageFault: resourceValues[7],
-      swappedOut: resourceValues[8],
-      fsRead: resourceValues[9],
-      fsWrite: resourceValues[10],
-      ipcSent: resourceValues[11],
-      ipcReceived: resourceValues[12],
-      signalsCount: resourceValues[13],
-      voluntaryContextSwitches: resourceValues[14],
-      involuntaryContextSwitches: resourceValues[15]
-    };
-  }
-
-
   return {
     _rawDebug,
     cpuUsage,
-    resourceUsage,
-    memoryUsage,
     kill,
     exit
   };
@@ -266,7 +302,12 @@ function buildAllowedFlags() {
   const {
     envSettings: { kAllowedInEnvironment }
   } = internalBinding('options');
-  const { options, aliases } = require('internal/options');
+  const {
+    getOptionsAsMap,
+    getAliasesAsMap,
+  } = require('internal/options');
+  const options = getOptionsAsMap();
+  const aliases = getAliasesAsMap();
 
   const allowedNodeEnvironmentFlags = [];
   for (const { 0: name, 1: info } of options) {
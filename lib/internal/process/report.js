@@ -1,9 +1,11 @@
 'use strict';
 const {
   ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_ARG_VALUE,
   ERR_SYNTHETIC
 } = require('internal/errors').codes;
 const {
+  validateArray,
   validateBoolean,
   validateObject,
   validateSignalName,
@@ -11,23 +13,36 @@ const {
 } = require('internal/validators');
 const nr = internalBinding('report');
 const {
+  ArrayPrototypeFilter,
+  ArrayPrototypeIncludes,
+  ArrayPrototypeJoin,
   JSONParse,
+  StringPrototypeSplit,
 } = primordials;
+
+function getReportArguments(file, err) {
+  if (typeof file === 'object' && file !== null) {
+    err = file;
+    file = undefined;
+  } else if (file !== undefined && typeof file !== 'string') {
+    throw new ERR_INVALID_ARG_TYPE('file', 'String', file);
+  } else if (err === undefined) {
+    err = new ERR_SYNTHETIC();
+  } else {
+    validateObject(err, 'err');
+  }
+  return { file, err };
+}
+
 const report = {
   writeReport(file, err) {
-    if (typeof file === 'object' && file !== null) {
-      err = file;
-      file = undefined;
-    } else if (file !== undefined && typeof file !== 'string') {
-      throw new ERR_INVALID_ARG_TYPE('file', 'String', file);
-    } else if (err === undefined) {
-      err = new ERR_SYNTHETIC();
-    } else {
-      validateObject(err, 'err');
-    }
-
+    ({ file, err } = getReportArguments(file, err));
     return nr.writeReport('JavaScript API', 'API', file, err);
   },
+  writeReportAsync(file, err) {
+    ({ file, err } = getReportArguments(file, err));
+    return nr.writeReportAsync('JavaScript API', 'API', file, err);
+  },
   getReport(err) {
     if (err === undefined)
       err = new ERR_SYNTHETIC();
@@ -43,6 +58,20 @@ const report = {
     validateString(dir, 'directory');
     nr.setDirectory(dir);
   },
+  get exclude() {
+    return ArrayPrototypeFilter(
+      StringPrototypeSplit(nr.getExclude(), ','), (section) => section !== '');
+  },
+  set exclude(sections) {
+    validateArray(sections, 'exclude');
+    for (let i = 0; i < sections.length; i++) {
+      if (!ArrayPrototypeIncludes(nr.excludableSections, sections[i])) {
+        throw new ERR_INVALID_ARG_VALUE(`exclude[${i}]`, sections[i],
+                                        'is not a report section');
+      }
+    }
+    nr.setExclude(ArrayPrototypeJoin(sections, ','));
+  },
   get filename() {
     return nr.getFilename();
   },
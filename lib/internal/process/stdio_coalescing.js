@@ -0,0 +1,133 @@
+'use strict';
+
+// Coalescing of the writes to process.stdout and process.stderr. While it is
+// enabled, the stream is corked on the first write and uncorked once enough
+// bytes are pending or the interval has passed, so that a flood of small
+// writes, e.g. from console.log(), reaches the consumer in a single writev
+// call instead of one system call per write.
+
+const {
+  FunctionPrototypeCall,
+  NumberMAX_SAFE_INTEGER,
+  Symbol,
+} = primordials;
+
+const { setTimeout, clearTimeout } = require('timers');
+const {
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+
+const kCoalescing = Symbol('kCoalescing');
+
+function flush(stream) {
+  const state = stream[kCoalescing];
+  if (state === undefined || !state.corked)
+    return;
+  if (state.timer !== undefined) {
+    clearTimeout(state.timer);
+    state.timer = undefined;
+  }
+  state.corked = false;
+  stream.uncork();
+}
+
+function coalescedWrite(chunk, encoding, cb) {
+  const state = this[kCoalescing];
+
+  // The consumer does not keep up, drop the write instead of buffering
+  // without limit or blocking the event loop.
+  if (this.writableLength >= state.maxBuffered) {
+    this.droppedWrites++;
+    if (typeof encoding === 'function')
+      cb = encoding;
+    if (typeof cb === 'function')
+      process.nextTick(cb);
+    return true;
+  }
+
+  if (!state.corked) {
+    state.corked = true;
+    this.cork();
+    if (state.interval === 0) {
+      process.nextTick(flush, this);
+    } else {
+      state.timer = setTimeout(flush, state.interval, this);
+      state.timer.unref();
+    }
+  }
+
+  const ret = FunctionPrototypeCall(state.write, this, chunk, encoding, cb);
+  if (this.writableLength >= state.size)
+    flush(this);
+  return ret;
+}
+
+function setCoalescing(options) {
+  const stream = this;
+  const current = stream[kCoalescing];
+
+  if (options === false) {
+    if (current !== undefined) {
+      flush(stream);
+      process.removeListener('exit', current.onExit);
+      stream.write = current.write;
+      stream[kCoalescing] = undefined;
+    }
+    return stream;
+  }
+
+  let size = 64 * 1024;
+  let interval = 0;
+  let maxBuffered = NumberMAX_SAFE_INTEGER;
+  if (options !== undefined) {
+    validateObject(options, 'options');
+    if (options.size !== undefined) {
+      validateInteger(options.size, 'options.size', 1);
+      size = options.size;
+    }
+    if (options.interval !== undefined) {
+      validateInteger(options.interval, 'options.interval', 0);
+      interval = options.interval;
+    }
+    if (options.maxBuffered !== undefined) {
+      validateInteger(options.maxBuffered, 'options.maxBuffered', 0);
+      maxBuffered = options.maxBuffered;
+    }
+  }
+
+  if (current !== undefined) {
+    // Apply the new options to the writes that come after the pending ones.
+    flush(stream);
+    current.size = size;
+    current.interval = interval;
+    current.maxBuffered = maxBuffered;
+    return stream;
+  }
+
+  const state = {
+    size,
+    interval,
+    maxBuffered,
+    corked: false,
+    timer: undefined,
+    write: stream.write,
+    onExit: () => flush(stream),
+  };
+  stream[kCoalescing] = state;
+  stream.write = coalescedWrite;
+  // Pending writes must not be lost when the process exits before they
+  // are flushed.
+  process.on('exit', state.onExit);
+  return stream;
+}
+
+function addCoalescing(stream) {
+  stream[kCoalescing] = undefined;
+  stream.droppedWrites = 0;
+  stream.setCoalescing = setCoalescing;
+}
+
+module.exports = {
+  addCoalescing,
+};
@@ -33,6 +33,10 @@ const {
   emitDestroy,
   symbols: { async_id_symbol, trigger_async_id_symbol }
 } = require('internal/async_hooks');
+const {
+  AsyncContextFrame,
+  kContextFrame,
+} = require('internal/async_context_frame');
 const FixedQueue = require('internal/fixed_queue');
 
 const {
@@ -70,6 +74,10 @@ function processTicksAndRejections() {
       const asyncId = tock[async_id_symbol];
       emitBefore(asyncId, tock[trigger_async_id_symbol], tock);
 
+      let priorContextFrame;
+      if (AsyncContextFrame.enabled)
+        priorContextFrame = AsyncContextFrame.exchange(tock[kContextFrame]);
+
       try {
         const callback = tock.callback;
         if (tock.args === undefined) {
@@ -85,6 +93,9 @@ function processTicksAndRejections() {
           }
         }
       } finally {
+        if (AsyncContextFrame.enabled)
+          AsyncContextFrame.set(priorContextFrame);
+
         if (destroyHooksExist())
           emitDestroy(asyncId);
       }
@@ -124,6 +135,7 @@ function nextTick(callback) {
   const tickObject = {
     [async_id_symbol]: asyncId,
     [trigger_async_id_symbol]: triggerAsyncId,
+    [kContextFrame]: AsyncContextFrame.current(),
     callback,
     args
   };
@@ -173,5 +185,6 @@ module.exports = {
       runNextTicks
     };
   },
-  queueMicrotask
+  queueMicrotask,
+  runNextTicks
 };
@@ -25,14 +25,22 @@ let debug = require('internal/util/debuglog').debuglog('source_map', (fn) => {
 });
 const fs = require('fs');
 const { getOptionValue } = require('internal/options');
-const { IterableWeakMap } = require('internal/util/iterable_weak_map');
 const {
   normalizeReferrerURL,
 } = require('internal/modules/cjs/helpers');
 // Since the CJS module cache is mutable, which leads to memory leaks when
 // modules are deleted, we use a WeakMap so that the source map cache will
-// be purged automatically:
-const cjsSourceMapCache = new IterableWeakMap();
+// be purged automatically. It is created on first use, because the loaders
+// load this module while a startup snapshot is built, and V8 does not install
+// FinalizationRegistry in the contexts of such snapshots:
+let cjsSourceMapCache;
+function getCJSSourceMapCache() {
+  if (cjsSourceMapCache === undefined) {
+    const { IterableWeakMap } = require('internal/util/iterable_weak_map');
+    cjsSourceMapCache = new IterableWeakMap();
+  }
+  return cjsSourceMapCache;
+}
 // The esm cache is not mutable, so we can use a Map without memory concerns:
 const esmSourceMapCache = new SafeMap();
 const { fileURLToPath, pathToFileURL, URL } = require('internal/url');
@@ -76,7 +84,7 @@ function maybeCacheSourceMap(filename, content, cjsModuleInstance) {
     const data = dataFromUrl(filename, match.groups.sourceMappingURL);
     const url = data ? null : match.groups.sourceMappingURL;
     if (cjsModuleInstance) {
-      cjsSourceMapCache.set(cjsModuleInstance, {
+      getCJSSourceMapCache().set(cjsModuleInstance, {
         filename,
         lineLengths: lineLengths(content),
         data,
@@ -174,6 +182,7 @@ function sourcesToAbsolute(baseURL, data) {
 
 // Move source map from garbage collected module to alternate key.
 function rekeySourceMap(cjsModuleInstance, newInstance) {
+  if (cjsSourceMapCache === undefined) return;
   const sourceMap = cjsSourceMapCache.get(cjsModuleInstance);
   if (sourceMap) {
     cjsSourceMapCache.set(newInstance, sourceMap);
@@ -203,6 +212,7 @@ function sourceMapCacheToObject() {
 }
 
 function appendCJSCache(obj) {
+  if (cjsSourceMapCache === undefined) return;
   for (const value of cjsSourceMapCache) {
     obj[ObjectGetValueSafe(value, 'filename')] = {
       lineLengths: ObjectGetValueSafe(value, 'lineLengths'),
@@ -220,7 +230,7 @@ function findSourceMap(sourceURL) {
     SourceMap = require('internal/source_map/source_map').SourceMap;
   }
   let sourceMap = esmSourceMapCache.get(sourceURL);
-  if (sourceMap === undefined) {
+  if (sourceMap === undefined && cjsSourceMapCache !== undefined) {
     for (const value of cjsSourceMapCache) {
       const filename = ObjectGetValueSafe(value, 'filename');
       if (sourceURL === filename) {
@@ -34,6 +34,7 @@ const kUpdateTimer = Symbol('kUpdateTimer');
 const kAfterAsyncWrite = Symbol('kAfterAsyncWrite');
 const kHandle = Symbol('kHandle');
 const kSession = Symbol('kSession');
+const kReusable = Symbol('kReusable');
 
 let debug = require('internal/util/debuglog').debuglog('stream', (fn) => {
   debug = fn;
@@ -106,8 +107,14 @@ function onWriteComplete(status) {
     this.callback(null);
 }
 
+// Write requests that were done synchronously were never handed to the
+// native side or to async_hooks, so their objects are kept for reuse.
+const kMaxReusableWriteWraps = 16;
+const reusableWriteWraps = [];
+
 function createWriteWrap(handle, callback) {
-  const req = new WriteWrap();
+  const req = reusableWriteWraps.length > 0 ?
+    reusableWriteWraps.pop() : new WriteWrap();
 
   req.handle = handle;
   req.oncomplete = onWriteComplete;
@@ -115,10 +122,22 @@ function createWriteWrap(handle, callback) {
   req.bytes = 0;
   req.buffer = null;
   req.callback = callback;
+  req[kReusable] = false;
 
   return req;
 }
 
+// Called by the users of writeGeneric() and writevGeneric() once they are
+// done with the returned request.
+function releaseWriteWrap(req) {
+  if (!req[kReusable] || reusableWriteWraps.length >= kMaxReusableWriteWraps)
+    return;
+  req.handle = null;
+  req.callback = null;
+  req[kReusable] = false;
+  reusableWriteWraps.push(req);
+}
+
 function writevGeneric(self, data, cb) {
   const req = createWriteWrap(self[kHandle], cb);
   const allBuffers = data.allBuffers;
@@ -138,7 +157,7 @@ function writevGeneric(self, data, cb) {
   const err = req.handle.writev(req, chunks, allBuffers);
 
   // Retain chunks
-  if (err === 0) req._chunks = chunks;
+  if (err === 0 && streamBaseState[kLastWriteWasAsync]) req._chunks = chunks;
 
   afterWriteDispatched(req, err, cb);
   return req;
@@ -159,8 +178,11 @@ function afterWriteDispatched(req, err, cb) {
   if (err !== 0)
     return cb(errnoException(err, 'write', req.error));
 
-  if (!req.async && typeof req.callback === 'function') {
-    req.callback();
+  if (!req.async) {
+    // An `error` may still have been put on the request by the native side.
+    req[kReusable] = req.error === undefined;
+    if (typeof req.callback === 'function')
+      req.callback();
   }
 }
 
@@ -275,6 +297,7 @@ function setStreamTimeout(msecs, callback) {
 module.exports = {
   writevGeneric,
   writeGeneric,
+  releaseWriteWrap,
   onStreamRead,
   kAfterAsyncWrite,
   kMaybeDestroy,
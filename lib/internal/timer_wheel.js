@@ -0,0 +1,144 @@
+'use strict';
+
+const {
+  Array,
+  MathCeil,
+  MathFloor,
+  MathTrunc,
+} = primordials;
+
+const L = require('internal/linkedlist');
+
+// The TimerWheel is a hierarchical timing wheel, as described in "Hashed and
+// Hierarchical Timing Wheels" by Varghese and Lauck. Time is divided into
+// ticks of a fixed number of milliseconds. Each level of the wheel has kSlots
+// slots, and every slot is a linked list of the items that are due within
+// the same kSlots ** level ticks. Once the wheel reaches the start of such a
+// range, the items of its slot are moved down to the lower levels, until
+// they reach level 0, where every slot corresponds to a single tick.
+//
+// This makes inserting and removing items constant-time operations, no matter
+// how many items there are and how many different durations they use. Items
+// are linked list nodes, see lib/internal/linkedlist.js, that are due at
+// `item._idleStart + item._idleTimeout`, like Timeouts. They may be removed
+// from the wheel with L.remove() at any time.
+
+const kSlots = 64;
+// 64 ** 6 ticks are enough for timers of up to TIMEOUT_MAX milliseconds.
+const kLevels = 6;
+
+function createSlots() {
+  const slots = new Array(kSlots);
+  for (let i = 0; i < kSlots; i++) {
+    slots[i] = { _idleNext: null, _idlePrev: null };
+    L.init(slots[i]);
+  }
+  return slots;
+}
+
+module.exports = class TimerWheel {
+  constructor(tickMs, now) {
+    this.tickMs = tickMs;
+    // All items that are due until the end of this tick have been moved to
+    // the `expired` list.
+    this.currentTick = MathFloor(now / tickMs);
+    this.levels = new Array(kLevels);
+    for (let level = 0; level < kLevels; level++)
+      this.levels[level] = createSlots();
+    this.expired = { _idleNext: null, _idlePrev: null };
+    L.init(this.expired);
+  }
+
+  // Adds an item to the wheel, and returns the time at which the wheel must
+  // be advanced for it. Items are never considered due before their expiry,
+  // but may be up to one tick late.
+  insert(item) {
+    let tick = this.#dueTick(item);
+    if (tick <= this.currentTick)
+      tick = this.currentTick + 1;
+    const delta = tick - this.currentTick;
+    let level = 0;
+    let span = 1;
+    while (delta >= span * kSlots && level < kLevels - 1) {
+      span *= kSlots;
+      level++;
+    }
+    const range = MathFloor(tick / span);
+    L.append(this.levels[level][range % kSlots], item);
+    return (level === 0 ? tick : range * span) * this.tickMs;
+  }
+
+  // Moves the items that are due by `now` to the `expired` list, in the order
+  // of their ticks.
+  advance(now) {
+    const target = MathFloor(now / this.tickMs);
+    let tick;
+    while ((tick = this.#nextTick(target)) !== -1) {
+      this.currentTick = tick;
+      let span = 1;
+      for (let level = 1; level < kLevels; level++) {
+        span *= kSlots;
+        if (tick % span !== 0)
+          break;
+        const slot = this.levels[level][MathFloor(tick / span) % kSlots];
+        let item;
+        while ((item = L.peek(slot)) !== null) {
+          if (this.#dueTick(item) <= tick)
+            L.append(this.expired, item);
+          else
+            this.insert(item);
+        }
+      }
+      const slot = this.levels[0][tick % kSlots];
+      let item;
+      while ((item = L.peek(slot)) !== null)
+        L.append(this.expired, item);
+    }
+    if (target > this.currentTick)
+      this.currentTick = target;
+  }
+
+  // Returns the time at which the wheel must be advanced next, or Infinity if
+  // it is empty.
+  nextExpiry() {
+    const tick = this.#nextTick(Infinity);
+    return tick === -1 ? Infinity : tick * this.tickMs;
+  }
+
+  #dueTick(item) {
+    return MathCeil(
+      (item._idleStart + MathTrunc(item._idleTimeout)) / this.tickMs);
+  }
+
+  // The first tick after the current one and not after `limit` at which
+  // items are due or have to be moved to a lower level, or -1.
+  #nextTick(limit) {
+    const current = this.currentTick;
+    let next = -1;
+    const slots = this.levels[0];
+    for (let tick = current + 1; tick < current + kSlots; tick++) {
+      if (tick > limit)
+        break;
+      if (!L.isEmpty(slots[tick % kSlots])) {
+        next = tick;
+        break;
+      }
+    }
+    let span = 1;
+    for (let level = 1; level < kLevels; level++) {
+      span *= kSlots;
+      const slots = this.levels[level];
+      const range = MathFloor(current / span);
+      for (let i = 1; i <= kSlots; i++) {
+        const tick = (range + i) * span;
+        if (tick > limit || (next !== -1 && tick >= next))
+          break;
+        if (!L.isEmpty(slots[(range + i) % kSlots])) {
+          next = tick;
+          break;
+        }
+      }
+    }
+    return next;
+  }
+};
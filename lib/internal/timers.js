@@ -71,6 +71,11 @@
 // Timeout lists and the object map lookup of a specific list by the duration of
 // timers within (or creation of a new list). However, these operations combined
 // have shown to be trivial in comparison to other timers architectures.
+//
+// That is no longer true once there are very many lists, e.g. when timers use
+// durations that are all slightly different. For that case, --timer-slack
+// keeps timers in a hierarchical timing wheel instead, see
+// lib/internal/timer_wheel.js, at the cost of some precision.
 
 const {
   MathMax,
@@ -101,6 +106,10 @@ const {
   emitAfter,
   emitDestroy,
 } = require('internal/async_hooks');
+const {
+  AsyncContextFrame,
+  kContextFrame,
+} = require('internal/async_context_frame');
 
 // Symbols for storing async id state.
 const async_id_symbol = Symbol('asyncId');
@@ -147,6 +156,10 @@ let refCount = 0;
 // individual IDs to determine which list was created first.
 const timerListQueue = new PriorityQueue(compareTimersLists, setPosition);
 
+// With --timer-slack, new timers are kept in a TimerWheel instead of the
+// lists below. See enableTimerWheel().
+let timerWheel = null;
+
 // Object map containing linked lists of timers, keyed and sorted by their
 // duration in milliseconds.
 //
@@ -158,6 +171,7 @@ function initAsyncResource(resource, type) {
   const asyncId = resource[async_id_symbol] = newAsyncId();
   const triggerAsyncId =
     resource[trigger_async_id_symbol] = getDefaultTriggerAsyncId();
+  resource[kContextFrame] = AsyncContextFrame.current();
   if (initHooksExist())
     emitInit(asyncId, type, triggerAsyncId, resource);
 }
@@ -352,6 +366,15 @@ function insert(item, msecs, start = getLibuvNow()) {
   msecs = MathTrunc(msecs);
   item._idleStart = start;
 
+  if (timerWheel !== null) {
+    const expiry = timerWheel.insert(item);
+    if (nextExpiry > expiry) {
+      scheduleTimer(MathMax(expiry - start, 1));
+      nextExpiry = expiry;
+    }
+    return;
+  }
+
   // Use an existing list if there is one, otherwise we need to make a new one.
   let list = timerListMap[msecs];
   if (list === undefined) {
@@ -369,6 +392,18 @@ function insert(item, msecs, start = getLibuvNow()) {
   L.append(list, item);
 }
 
+// Timers that are inserted from now on are kept in a hierarchical timing
+// wheel with ticks of `slack` milliseconds. This makes inserting and removing
+// them constant-time operations, even if they use many different durations,
+// and lets all the timers of a tick expire in a single processTimers() call.
+// Timers may be up to `slack` milliseconds late, though, and the ones that
+// expire in the same tick are not necessarily run in the order in which they
+// were scheduled.
+function enableTimerWheel(slack) {
+  const TimerWheel = require('internal/timer_wheel');
+  timerWheel = new TimerWheel(slack, getLibuvNow());
+}
+
 function setUnrefTimeout(callback, after) {
   // Type checking identical to setTimeout()
   validateCallback(callback);
@@ -458,6 +493,11 @@ function getTimerCallbacks(runNextTicks) {
       const asyncId = immediate[async_id_symbol];
       emitBefore(asyncId, immediate[trigger_async_id_symbol], immediate);
 
+      let priorContextFrame;
+      if (AsyncContextFrame.enabled)
+        priorContextFrame =
+          AsyncContextFrame.exchange(immediate[kContextFrame]);
+
       try {
         const argv = immediate._argv;
         if (!argv)
@@ -467,6 +507,9 @@ function getTimerCallbacks(runNextTicks) {
       } finally {
         immediate._onImmediate = null;
 
+        if (AsyncContextFrame.enabled)
+          AsyncContextFrame.set(priorContextFrame);
+
         if (destroyHooksExist())
           emitDestroy(asyncId);
 
@@ -491,7 +534,7 @@ function getTimerCallbacks(runNextTicks) {
     while (list = timerListQueue.peek()) {
       if (list.expiry > now) {
         nextExpiry = list.expiry;
-        return refCount > 0 ? nextExpiry : -nextExpiry;
+        break;
       }
       if (ranAtLeastOneList)
         runNextTicks();
@@ -499,7 +542,34 @@ function getTimerCallbacks(runNextTicks) {
         ranAtLeastOneList = true;
       listOnTimeout(list, now);
     }
-    return 0;
+
+    if (timerWheel !== null) {
+      wheelOnTimeout(now, ranAtLeastOneList);
+      const wheelExpiry = timerWheel.nextExpiry();
+      if (nextExpiry > wheelExpiry)
+        nextExpiry = wheelExpiry;
+    }
+
+    if (nextExpiry === Infinity)
+      return 0;
+    return refCount > 0 ? nextExpiry : -nextExpiry;
+  }
+
+  function wheelOnTimeout(now, ranAtLeastOneTimer) {
+    // Expired timers stay in the list until they run, so that the remaining
+    // ones still run if one of them throws.
+    timerWheel.advance(now);
+    const expired = timerWheel.expired;
+    let timer;
+    while (timer = L.peek(expired)) {
+      if (ranAtLeastOneTimer)
+        runNextTicks();
+      else
+        ranAtLeastOneTimer = true;
+
+      L.remove(timer);
+      runTimer(timer);
+    }
   }
 
   function listOnTimeout(list, now) {
@@ -527,52 +597,8 @@ function getTimerCallbacks(runNextTicks) {
       else
         ranAtLeastOneTimer = true;
 
-      // The actual logic for when a timeout happens.
       L.remove(timer);
-
-      const asyncId = timer[async_id_symbol];
-
-      if (!timer._onTimeout) {
-        if (!timer._destroyed) {
-          timer._destroyed = true;
-
-          if (timer[kRefed])
-            refCount--;
-
-          if (destroyHooksExist())
-            emitDestroy(asyncId);
-        }
-        continue;
-      }
-
-      emitBefore(asyncId, timer[trigger_async_id_symbol], timer);
-
-      let start;
-      if (timer._repeat)
-        start = getLibuvNow();
-
-      try {
-        const args = timer._timerArgs;
-        if (args === undefined)
-          timer._onTimeout();
-        else
-          ReflectApply(timer._onTimeout, timer, args);
-      } finally {
-        if (timer._repeat && timer._idleTimeout !== -1) {
-          timer._idleTimeout = timer._repeat;
-          insert(timer, timer._idleTimeout, start);
-        } else if (!timer._idleNext && !timer._idlePrev && !timer._destroyed) {
-          timer._destroyed = true;
-
-          if (timer[kRefed])
-            refCount--;
-
-          if (destroyHooksExist())
-            emitDestroy(asyncId);
-        }
-      }
-
-      emitAfter(asyncId);
+      runTimer(timer);
     }
 
     // If `L.peek(list)` returned nothing, the list was either empty or we have
@@ -590,6 +616,60 @@ function getTimerCallbacks(runNextTicks) {
     }
   }
 
+  // The actual logic for when a timeout happens.
+  function runTimer(timer) {
+    const asyncId = timer[async_id_symbol];
+
+    if (!timer._onTimeout) {
+      if (!timer._destroyed) {
+        timer._destroyed = true;
+
+        if (timer[kRefed])
+          refCount--;
+
+        if (destroyHooksExist())
+          emitDestroy(asyncId);
+      }
+      return;
+    }
+
+    emitBefore(asyncId, timer[trigger_async_id_symbol], timer);
+
+    let start;
+    if (timer._repeat)
+      start = getLibuvNow();
+
+    let priorContextFrame;
+    if (AsyncContextFrame.enabled)
+      priorContextFrame = AsyncContextFrame.exchange(timer[kContextFrame]);
+
+    try {
+      const args = timer._timerArgs;
+      if (args === undefined)
+        timer._onTimeout();
+      else
+        ReflectApply(timer._onTimeout, timer, args);
+    } finally {
+      if (AsyncContextFrame.enabled)
+        AsyncContextFrame.set(priorContextFrame);
+
+      if (timer._repeat && timer._idleTimeout !== -1) {
+        timer._idleTimeout = timer._repeat;
+        insert(timer, timer._idleTimeout, start);
+      } else if (!timer._idleNext && !timer._idlePrev && !timer._destroyed) {
+        timer._destroyed = true;
+
+        if (timer[kRefed])
+          refCount--;
+
+        if (destroyHooksExist())
+          emitDestroy(asyncId);
+      }
+    }
+
+    emitAfter(asyncId);
+  }
+
   return {
     processImmediate,
     processTimers
@@ -658,6 +738,7 @@ module.exports = {
   active,
   unrefActive,
   insert,
+  enableTimerWheel,
   timerListMap,
   timerListQueue,
   decRefCount,
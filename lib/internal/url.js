@@ -8,6 +8,8 @@ const {
   ArrayPrototypeReduce,
   ArrayPrototypeSlice,
   FunctionPrototypeBind,
+  FunctionPrototypeCall,
+  Int32Array,
   Int8Array,
   Number,
   ObjectCreate,
@@ -56,6 +58,7 @@ const {
 const {
   CHAR_AMPERSAND,
   CHAR_BACKWARD_SLASH,
+  CHAR_COLON,
   CHAR_EQUAL,
   CHAR_FORWARD_SLASH,
   CHAR_LOWERCASE_A,
@@ -81,7 +84,10 @@ const {
   domainToUnicode: _domainToUnicode,
   encodeAuth,
   toUSVString: _toUSVString,
+  fastParse,
   parse,
+  parseSearchParams,
+  serializeSearchParams,
   setURLConstructor,
   URL_FLAGS_CANNOT_BE_BASE,
   URL_FLAGS_HAS_FRAGMENT,
@@ -139,21 +145,215 @@ function serializeTupleOrigin(scheme, host, port) {
 // and getters. It roughly corresponds to the concept of a URL record in the
 // URL Standard, with a few differences. It is also the object transported to
 // the C++ binding.
+// Only the serialized URL is stored, together with the offsets of its
+// components. The components are sliced out of `href` when they are read, and
+// `href` is serialized again when one of them is changed.
 // Refs: https://url.spec.whatwg.org/#concept-url
 class URLContext {
   constructor() {
     this.flags = 0;
-    this.scheme = ':';
-    this.username = '';
-    this.password = '';
-    this.host = null;
-    this.port = null;
-    this.path = [];
-    this.query = null;
-    this.fragment = null;
+    this.href = ':';
+    // The end of the scheme, including the ':'.
+    this.schemeEnd = 1;
+    // These are -1 if the host is null. The username starts at
+    // `schemeEnd + 2` and is followed by the ':' and the password, if any.
+    this.usernameEnd = -1;
+    this.hostStart = -1;
+    this.hostEnd = -1;
+    // The port follows a ':' after `hostEnd` if this is greater than
+    // `hostEnd + 1`.
+    this.pathStart = 1;
+    // The '?' and the '#', or -1.
+    this.queryStart = -1;
+    this.fragmentStart = -1;
+  }
+
+  // https://url.spec.whatwg.org/#url-serializing
+  setComponents(scheme, username, password, host, port, path, query,
+                fragment) {
+    let href = scheme;
+    this.schemeEnd = href.length;
+    if (host !== null) {
+      href += '//';
+      if (username !== '' || password !== '') {
+        href += username;
+        this.usernameEnd = href.length;
+        if (password !== '')
+          href += `:${password}`;
+        href += '@';
+      } else {
+        this.usernameEnd = href.length;
+      }
+      this.hostStart = href.length;
+      href += host;
+      this.hostEnd = href.length;
+      if (port !== null)
+        href += `:${port}`;
+    } else {
+      this.usernameEnd = -1;
+      this.hostStart = -1;
+      this.hostEnd = -1;
+    }
+    if ((this.flags & URL_FLAGS_CANNOT_BE_BASE) !== 0) {
+      this.pathStart = href.length;
+      href += path[0];
+    } else {
+      if (host === null && path.length > 1 && path[0] === '')
+        href += '/.';
+      this.pathStart = href.length;
+      if (path.length)
+        href += '/' + ArrayPrototypeJoin(path, '/');
+    }
+    this.queryStart = -1;
+    if (query !== null) {
+      this.queryStart = href.length;
+      href += `?${query}`;
+    }
+    this.fragmentStart = -1;
+    if (fragment !== null) {
+      this.fragmentStart = href.length;
+      href += `#${fragment}`;
+    }
+    this.href = href;
+  }
+
+  get pathEnd() {
+    if (this.queryStart !== -1)
+      return this.queryStart;
+    if (this.fragmentStart !== -1)
+      return this.fragmentStart;
+    return this.href.length;
+  }
+
+  get scheme() {
+    return StringPrototypeSlice(this.href, 0, this.schemeEnd);
+  }
+
+  set scheme(scheme) {
+    replaceComponent(this, kSchemeIndex, scheme);
+  }
+
+  get username() {
+    if (this.hostStart === -1)
+      return '';
+    return StringPrototypeSlice(this.href, this.schemeEnd + 2,
+                                this.usernameEnd);
+  }
+
+  set username(username) {
+    replaceComponent(this, kUsernameIndex, username);
+  }
+
+  get password() {
+    if (this.hostStart === -1 || this.usernameEnd === this.hostStart ||
+        StringPrototypeCharCodeAt(this.href, this.usernameEnd) !== CHAR_COLON)
+      return '';
+    return StringPrototypeSlice(this.href, this.usernameEnd + 1,
+                                this.hostStart - 1);
+  }
+
+  set password(password) {
+    replaceComponent(this, kPasswordIndex, password);
+  }
+
+  get host() {
+    if (this.hostStart === -1)
+      return null;
+    return StringPrototypeSlice(this.href, this.hostStart, this.hostEnd);
+  }
+
+  set host(host) {
+    replaceComponent(this, kHostIndex, host);
+  }
+
+  get port() {
+    if (this.hostStart === -1 || this.pathStart === this.hostEnd)
+      return null;
+    return +StringPrototypeSlice(this.href, this.hostEnd + 1, this.pathStart);
+  }
+
+  set port(port) {
+    replaceComponent(this, kPortIndex, port);
+  }
+
+  get pathname() {
+    return StringPrototypeSlice(this.href, this.pathStart, this.pathEnd);
+  }
+
+  get path() {
+    const pathname = this.pathname;
+    if ((this.flags & URL_FLAGS_CANNOT_BE_BASE) !== 0)
+      return [pathname];
+    if (pathname === '')
+      return [];
+    return StringPrototypeSplit(StringPrototypeSlice(pathname, 1), '/');
+  }
+
+  set path(path) {
+    replaceComponent(this, kPathIndex, path);
+  }
+
+  get query() {
+    if (this.queryStart === -1)
+      return null;
+    const end = this.fragmentStart !== -1 ?
+      this.fragmentStart : this.href.length;
+    return StringPrototypeSlice(this.href, this.queryStart + 1, end);
+  }
+
+  // The query and the fragment are at the end of `href`, so only they have
+  // to be serialized again.
+  set query(query) {
+    const fragment = this.fragment;
+    let href = StringPrototypeSlice(this.href, 0, this.pathEnd);
+    this.queryStart = -1;
+    if (query !== null) {
+      this.queryStart = href.length;
+      href += `?${query}`;
+    }
+    this.fragmentStart = -1;
+    if (fragment !== null) {
+      this.fragmentStart = href.length;
+      href += `#${fragment}`;
+    }
+    this.href = href;
+  }
+
+  get fragment() {
+    if (this.fragmentStart === -1)
+      return null;
+    return StringPrototypeSlice(this.href, this.fragmentStart + 1);
+  }
+
+  set fragment(fragment) {
+    let href = this.href;
+    if (this.fragmentStart !== -1)
+      href = StringPrototypeSlice(href, 0, this.fragmentStart);
+    this.fragmentStart = -1;
+    if (fragment !== null) {
+      this.fragmentStart = href.length;
+      href += `#${fragment}`;
+    }
+    this.href = href;
   }
 }
 
+const kSchemeIndex = 0;
+const kUsernameIndex = 1;
+const kPasswordIndex = 2;
+const kHostIndex = 3;
+const kPortIndex = 4;
+const kPathIndex = 5;
+
+function replaceComponent(ctx, index, value) {
+  const components = [
+    ctx.scheme, ctx.username, ctx.password, ctx.host, ctx.port, ctx.path,
+    ctx.query, ctx.fragment,
+  ];
+  components[index] = value;
+  ReflectApply(ctx.setComponents, ctx, components);
+}
+
 class URLSearchParams {
   // URL Standard says the default value is '', but as undefined and '' have
   // the same result, undefined is used to prevent unnecessary parsing.
@@ -514,23 +714,83 @@ ObjectDefineProperties(URLSearchParams.prototype, {
   },
 });
 
+function setContext(ctx, flags, protocol, username, password,
+                    host, port, path, query, fragment) {
+  ctx.flags = flags;
+  ctx.setComponents(
+    protocol,
+    (flags & URL_FLAGS_HAS_USERNAME) !== 0 ? username : '',
+    (flags & URL_FLAGS_HAS_PASSWORD) !== 0 ? password : '',
+    host,
+    port,
+    (flags & URL_FLAGS_HAS_PATH) !== 0 ? path : [],
+    query,
+    fragment);
+}
+
+function initURLSearchParams(url, query) {
+  if (!url[searchParams]) { // Invoked from URL constructor
+    url[searchParams] = new URLSearchParams();
+    url[searchParams][context] = url;
+  }
+  initSearchParams(url[searchParams], query);
+}
+
 function onParseComplete(flags, protocol, username, password,
                          host, port, path, query, fragment) {
-  const ctx = this[context];
-  ctx.flags = flags;
-  ctx.scheme = protocol;
-  ctx.username = (flags & URL_FLAGS_HAS_USERNAME) !== 0 ? username : '';
-  ctx.password = (flags & URL_FLAGS_HAS_PASSWORD) !== 0 ? password : '';
-  ctx.port = port;
-  ctx.path = (flags & URL_FLAGS_HAS_PATH) !== 0 ? path : [];
-  ctx.query = query;
-  ctx.fragment = fragment;
-  ctx.host = host;
-  if (!this[searchParams]) { // Invoked from URL constructor
-    this[searchParams] = new URLSearchParams();
-    this[searchParams][context] = this;
-  }
-  initSearchParams(this[searchParams], query);
+  setContext(this[context], flags, protocol, username, password,
+             host, port, path, query, fragment);
+  initURLSearchParams(this, query);
+}
+
+// Filled by fastParse(): flags, the end of the scheme, the start and end of
+// the host, the port, and the start of the path, query and fragment.
+const fastParseOffsets = new Int32Array(8);
+
+// Returns false if `input` needs to go through the full parser.
+function tryFastParse(url, input) {
+  if (!fastParse(input, fastParseOffsets))
+    return false;
+  const port = fastParseOffsets[4];
+  const pathStart = fastParseOffsets[5];
+  const queryStart = fastParseOffsets[6];
+  const fragmentStart = fastParseOffsets[7];
+  // The input is the serialized URL unless it has a default port or no path.
+  const hasDefaultPort = port === -1 && pathStart !== fastParseOffsets[3];
+  if (!hasDefaultPort &&
+      StringPrototypeCharCodeAt(input, pathStart) === CHAR_FORWARD_SLASH) {
+    const ctx = url[context];
+    ctx.flags = fastParseOffsets[0];
+    ctx.href = input;
+    ctx.schemeEnd = fastParseOffsets[1] + 1;
+    ctx.usernameEnd = fastParseOffsets[2];
+    ctx.hostStart = fastParseOffsets[2];
+    ctx.hostEnd = fastParseOffsets[3];
+    ctx.pathStart = pathStart;
+    ctx.queryStart = queryStart;
+    ctx.fragmentStart = fragmentStart;
+    initURLSearchParams(url, ctx.query);
+    return true;
+  }
+  let end = input.length;
+  let fragment = null;
+  if (fragmentStart !== -1) {
+    fragment = StringPrototypeSlice(input, fragmentStart + 1);
+    end = fragmentStart;
+  }
+  let query = null;
+  if (queryStart !== -1) {
+    query = StringPrototypeSlice(input, queryStart + 1, end);
+    end = queryStart;
+  }
+  const path = StringPrototypeSlice(input, fastParseOffsets[5] + 1, end);
+  FunctionPrototypeCall(
+    onParseComplete, url, fastParseOffsets[0],
+    StringPrototypeSlice(input, 0, fastParseOffsets[1] + 1), '', '',
+    StringPrototypeSlice(input, fastParseOffsets[2], fastParseOffsets[3]),
+    port === -1 ? null : port, StringPrototypeSplit(path, '/'),
+    query, fragment);
+  return true;
 }
 
 function onParseError(flags, input) {
@@ -610,8 +870,10 @@ class URL {
       base_context = new URL(base)[context];
     }
     this[context] = new URLContext();
-    parse(input, -1, base_context, undefined,
-          FunctionPrototypeBind(onParseComplete, this), onParseError);
+    if (!tryFastParse(this, input)) {
+      parse(input, -1, base_context, undefined,
+            FunctionPrototypeBind(onParseComplete, this), onParseError);
+    }
   }
 
   get [special]() {
@@ -713,11 +975,11 @@ class URL {
 
   // https://heycam.github.io/webidl/#es-stringifier
   toString() {
-    return this[kFormat]({});
+    return this[context].href;
   }
 
   get href() {
-    return this[kFormat]({});
+    return this[context].href;
   }
 
   set href(input) {
@@ -858,12 +1120,7 @@ class URL {
   }
 
   get pathname() {
-    const ctx = this[context];
-    if (this[cannotBeBase])
-      return ctx.path[0];
-    if (ctx.path.length === 0)
-      return '';
-    return `/${ArrayPrototypeJoin(ctx.path, '/')}`;
+    return this[context].pathname;
   }
 
   set pathname(path) {
@@ -929,7 +1186,7 @@ class URL {
   }
 
   toJSON() {
-    return this[kFormat]({});
+    return this[context].href;
   }
 }
 
@@ -975,9 +1232,16 @@ function initSearchParams(url, init) {
   url[searchParams] = parseParams(init);
 }
 
+// Shorter inputs are parsed and serialized in JS, where they don't pay for
+// the call into C++.
+const kNativeParseMinLength = 64;
+const kNativeSerializeMinLength = 16;
+
 // application/x-www-form-urlencoded parser
 // Ref: https://url.spec.whatwg.org/#concept-urlencoded-parser
 function parseParams(qs) {
+  if (qs.length >= kNativeParseMinLength)
+    return parseSearchParams(qs);
   const out = [];
   let pairStart = 0;
   let lastPos = 0;
@@ -1101,6 +1365,8 @@ function serializeParams(array) {
   const len = array.length;
   if (len === 0)
     return '';
+  if (len >= kNativeSerializeMinLength)
+    return serializeSearchParams(array);
 
   const firstEncodedParam = encodeStr(array[0], noEscape, paramHexTable);
   const firstEncodedValue = encodeStr(array[1], noEscape, paramHexTable);
@@ -1457,15 +1723,8 @@ function toPathIfFileURL(fileURLOrPath) {
 function constructUrl(flags, protocol, username, password,
                       host, port, path, query, fragment) {
   const ctx = new URLContext();
-  ctx.flags = flags;
-  ctx.scheme = protocol;
-  ctx.username = (flags & URL_FLAGS_HAS_USERNAME) !== 0 ? username : '';
-  ctx.password = (flags & URL_FLAGS_HAS_PASSWORD) !== 0 ? password : '';
-  ctx.port = port;
-  ctx.path = (flags & URL_FLAGS_HAS_PATH) !== 0 ? path : [];
-  ctx.query = query;
-  ctx.fragment = fragment;
-  ctx.host = host;
+  setContext(ctx, flags, protocol, username, password,
+             host, port, path, query, fragment);
 
   const url = ObjectCreate(URL.prototype);
   url[context] = ctx;
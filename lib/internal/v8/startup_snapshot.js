@@ -0,0 +1,102 @@
+'use strict';
+
+const {
+  ArrayPrototypePush,
+  ArrayPrototypeShift,
+  ArrayPrototypeSplice,
+} = primordials;
+
+const {
+  codes: {
+    ERR_DUPLICATE_STARTUP_SNAPSHOT_MAIN_FUNCTION,
+    ERR_NOT_BUILDING_SNAPSHOT,
+  },
+} = require('internal/errors');
+const { validateFunction } = require('internal/validators');
+const { getOptionValue } = require('internal/options');
+
+function isBuildingSnapshot() {
+  return getOptionValue('--build-snapshot');
+}
+
+// Whether the process was started from a user-land snapshot, i.e. the
+// application has already been loaded.
+function isDeserializingSnapshot() {
+  return !isBuildingSnapshot() && getOptionValue('--snapshot-blob') !== '';
+}
+
+function throwIfNotBuildingSnapshot() {
+  if (!isBuildingSnapshot())
+    throw new ERR_NOT_BUILDING_SNAPSHOT();
+}
+
+const serializeCallbacks = [];
+const deserializeCallbacks = [];
+let deserializeMainIsSet = false;
+
+function addSerializeCallback(callback, data) {
+  throwIfNotBuildingSnapshot();
+  validateFunction(callback, 'callback');
+  ArrayPrototypePush(serializeCallbacks, [callback, data]);
+}
+
+function addDeserializeCallback(callback, data) {
+  throwIfNotBuildingSnapshot();
+  validateFunction(callback, 'callback');
+  ArrayPrototypePush(deserializeCallbacks, [callback, data]);
+}
+
+// The callbacks may add more callbacks, which are run as well.
+function runCallbacks(callbacks) {
+  while (callbacks.length > 0) {
+    const { 0: callback, 1: data } = ArrayPrototypeShift(callbacks);
+    callback(data);
+  }
+}
+
+// Run on 'beforeExit' of the process that builds the snapshot, i.e. once
+// the event loop of the entry point is empty.
+function runSerializeCallbacks() {
+  runCallbacks(serializeCallbacks);
+}
+
+// Run by prepareMainThreadExecution() once the process that starts from
+// the snapshot is set up, before the preload modules are loaded.
+function runDeserializeCallbacks() {
+  runCallbacks(deserializeCallbacks);
+}
+
+function setDeserializeMainFunction(callback, data) {
+  throwIfNotBuildingSnapshot();
+  validateFunction(callback, 'callback');
+  if (deserializeMainIsSet)
+    throw new ERR_DUPLICATE_STARTUP_SNAPSHOT_MAIN_FUNCTION();
+  deserializeMainIsSet = true;
+
+  const { setDeserializeMainFunction } = internalBinding('mksnapshot');
+  setDeserializeMainFunction(function deserializeMain(markBootstrapComplete) {
+    const {
+      prepareMainThreadExecution
+    } = require('internal/bootstrap/pre_execution');
+    prepareMainThreadExecution(false);
+    // The entry point is part of the snapshot, so there is no script in
+    // argv. The arguments start at process.argv[2] as they would otherwise.
+    ArrayPrototypeSplice(process.argv, 1, 0, process.execPath);
+    markBootstrapComplete();
+    callback(data);
+  });
+}
+
+module.exports = {
+  isBuildingSnapshot,
+  isDeserializingSnapshot,
+  runDeserializeCallbacks,
+  runSerializeCallbacks,
+  // Exposed to the user as v8.startupSnapshot.
+  namespace: {
+    addSerializeCallback,
+    addDeserializeCallback,
+    isBuildingSnapshot,
+    setDeserializeMainFunction,
+  },
+};
@@ -39,6 +39,8 @@ const {
   ERR_WORKER_INVALID_EXEC_ARGV,
   ERR_INVALID_ARG_TYPE,
   ERR_INVALID_ARG_VALUE,
+  ERR_FEATURE_UNAVAILABLE_ON_PLATFORM,
+  ERR_OUT_OF_RANGE,
 } = errorCodes;
 const { getOptionValue } = require('internal/options');
 
@@ -57,7 +59,12 @@ const {
 } = workerIo;
 const { deserializeError } = require('internal/error_serdes');
 const { fileURLToPath, isURLInstance, pathToFileURL } = require('internal/url');
-const { validateArray } = require('internal/validators');
+const {
+  validateArray,
+  validateInteger,
+  validateNumber,
+  validateOneOf,
+} = require('internal/validators');
 
 const {
   ownsProcessState,
@@ -65,6 +72,7 @@ const {
   resourceLimits: resourceLimitsRaw,
   threadId,
   Worker: WorkerImpl,
+  notifyMemoryPressure: _notifyMemoryPressure,
   kMaxYoungGenerationSizeMb,
   kMaxOldGenerationSizeMb,
   kCodeRangeSizeMb,
@@ -82,6 +90,8 @@ const kOnErrorMessage = Symbol('kOnErrorMessage');
 const kParentSideStdio = Symbol('kParentSideStdio');
 const kLoopStartTime = Symbol('kLoopStartTime');
 const kIsOnline = Symbol('kIsOnline');
+// The port through which a worker of a `Pool` receives its tasks.
+const kPoolPort = Symbol('kPoolPort');
 
 const SHARE_ENV = SymbolFor('nodejs.worker_threads.SHARE_ENV');
 let debug = require('internal/util/debuglog').debuglog('worker', (fn) => {
@@ -170,12 +180,38 @@ class Worker extends EventEmitter {
         options.env);
     }
 
+    let cpuAffinity;
+    if (options.cpuAffinity !== undefined) {
+      validateArray(options.cpuAffinity, 'options.cpuAffinity',
+                    { minLength: 1 });
+      cpuAffinity = [];
+      for (let i = 0; i < options.cpuAffinity.length; i++) {
+        const cpu = options.cpuAffinity[i];
+        validateInteger(cpu, `options.cpuAffinity[${i}]`, 0, 1023);
+        ArrayPrototypePush(cpuAffinity, cpu);
+      }
+      // sched_setaffinity(2) is Linux-specific.
+      if (process.platform !== 'linux')
+        throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('options.cpuAffinity');
+    }
+
+    const { heapGrowthReportMb } = options;
+    if (heapGrowthReportMb !== undefined) {
+      validateNumber(heapGrowthReportMb, 'options.heapGrowthReportMb');
+      if (!(heapGrowthReportMb > 0)) {
+        throw new ERR_OUT_OF_RANGE('options.heapGrowthReportMb', '> 0',
+                                   heapGrowthReportMb);
+      }
+    }
+
     // Set up the C++ handle for the worker, as well as some internal wiring.
     this[kHandle] = new WorkerImpl(url,
                                    env === process.env ? null : env,
                                    options.execArgv,
                                    parseResourceLimits(options.resourceLimits),
-                                   !!(options.trackUnmanagedFds ?? true));
+                                   !!(options.trackUnmanagedFds ?? true),
+                                   cpuAffinity,
+                                   heapGrowthReportMb);
     if (this[kHandle].invalidExecArgv) {
       throw new ERR_WORKER_INVALID_EXEC_ARGV(this[kHandle].invalidExecArgv);
     }
@@ -186,6 +222,11 @@ class Worker extends EventEmitter {
     this[kHandle].onexit = (code, customErr, customErrReason) => {
       this[kOnExit](code, customErr, customErrReason);
     };
+    if (heapGrowthReportMb !== undefined) {
+      this[kHandle].onheapgrowth = (usedHeapSize, heapSizeLimit) => {
+        this.emit('heapGrowth', { usedHeapSize, heapSizeLimit });
+      };
+    }
     this[kPort] = this[kHandle].messagePort;
     this[kPort].on('message', (data) => this[kOnMessage](data));
     this[kPort].start();
@@ -215,6 +256,9 @@ class Worker extends EventEmitter {
     if (options.transferList)
       ArrayPrototypePush(transferList,
                          ...new SafeArrayIterator(options.transferList));
+    const poolPort = options[kPoolPort];
+    if (poolPort !== undefined)
+      ArrayPrototypePush(transferList, poolPort);
 
     this[kPublicPort] = port1;
     ArrayPrototypeForEach(['message', 'messageerror'], (event) => {
@@ -229,6 +273,7 @@ class Worker extends EventEmitter {
       cwdCounter: cwdCounter || workerIo.sharedCwdCounter,
       workerData: options.workerData,
       publicPort: port2,
+      poolPort,
       manifestURL: getOptionValue('--experimental-policy') ?
         require('internal/process/policy').url :
         null,
@@ -305,6 +350,7 @@ class Worker extends EventEmitter {
 
   [kDispose]() {
     this[kHandle].onexit = null;
+    this[kHandle].onheapgrowth = null;
     this[kHandle] = null;
     this[kPort] = null;
     this[kPublicPort] = null;
@@ -481,6 +527,11 @@ function eventLoopUtilization(util1, util2) {
   return { idle: idle_delta, active: active_delta, utilization };
 }
 
+function notifyMemoryPressure(level = 'moderate') {
+  validateOneOf(level, 'level', ['moderate', 'critical']);
+  _notifyMemoryPressure(level === 'critical');
+}
+
 // Duplicate code from performance.now() so don't need to require perf_hooks.
 function now() {
   const hr = process.hrtime();
@@ -490,9 +541,11 @@ function now() {
 module.exports = {
   ownsProcessState,
   isMainThread,
+  notifyMemoryPressure,
   SHARE_ENV,
   resourceLimits:
     !isMainThread ? makeResourceLimits(resourceLimitsRaw) : {},
   threadId,
   Worker,
+  kPoolPort,
 };
@@ -0,0 +1,107 @@
+'use strict';
+
+const {
+  ObjectSetPrototypeOf,
+  Symbol,
+  SymbolToStringTag,
+  Uint8Array,
+} = primordials;
+
+const {
+  ImmutableBuffer: ImmutableBufferHandle,
+} = internalBinding('messaging');
+
+const {
+  JSTransferable,
+  kClone,
+  kDeserialize,
+} = require('internal/worker/js_transferable');
+const { isAnyArrayBuffer, isArrayBufferView } = require('internal/util/types');
+const { customInspectSymbol: kInspect } = require('internal/util');
+const { inspect } = require('internal/util/inspect');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+  },
+} = require('internal/errors');
+
+const kHandle = Symbol('kHandle');
+const kLength = Symbol('kLength');
+const kArrayBuffer = Symbol('kArrayBuffer');
+
+class InternalImmutableBuffer extends JSTransferable {
+  constructor(handle, length) {
+    super();
+    this[kHandle] = handle;
+    this[kLength] = length;
+    this[kArrayBuffer] = undefined;
+  }
+}
+
+class ImmutableBuffer extends JSTransferable {
+  constructor(source) {
+    if (isAnyArrayBuffer(source)) {
+      source = new Uint8Array(source);
+    } else if (!isArrayBufferView(source)) {
+      throw new ERR_INVALID_ARG_TYPE(
+        'source',
+        ['ArrayBuffer', 'SharedArrayBuffer', 'Buffer', 'TypedArray',
+         'DataView'],
+        source);
+    }
+    super();
+    this[kHandle] = new ImmutableBufferHandle(source);
+    this[kLength] = source.byteLength;
+    this[kArrayBuffer] = undefined;
+  }
+
+  [kInspect](depth, options) {
+    if (depth < 0)
+      return this;
+
+    const opts = {
+      ...options,
+      depth: options.depth == null ? null : options.depth - 1
+    };
+
+    return `ImmutableBuffer ${inspect({
+      byteLength: this.byteLength,
+    }, opts)}`;
+  }
+
+  [kClone]() {
+    const handle = this[kHandle];
+    const length = this[kLength];
+    return {
+      data: { handle, length },
+      deserializeInfo:
+        'internal/worker/immutable_buffer:InternalImmutableBuffer'
+    };
+  }
+
+  [kDeserialize]({ handle, length }) {
+    this[kHandle] = handle;
+    this[kLength] = length;
+    this[kArrayBuffer] = undefined;
+  }
+
+  get byteLength() { return this[kLength]; }
+
+  get [SymbolToStringTag]() { return 'ImmutableBuffer'; }
+
+  toArrayBuffer() {
+    if (this[kArrayBuffer] === undefined)
+      this[kArrayBuffer] = this[kHandle].toArrayBuffer();
+    return this[kArrayBuffer];
+  }
+}
+
+InternalImmutableBuffer.prototype.constructor = ImmutableBuffer;
+ObjectSetPrototypeOf(
+  InternalImmutableBuffer.prototype,
+  ImmutableBuffer.prototype);
+
+module.exports = {
+  ImmutableBuffer,
+  InternalImmutableBuffer,
+};
@@ -3,6 +3,7 @@
 const {
   ArrayPrototypeForEach,
   ArrayPrototypeMap,
+  ArrayPrototypePop,
   ArrayPrototypePush,
   FunctionPrototypeBind,
   FunctionPrototypeCall,
@@ -21,6 +22,7 @@ const {
 const {
   handle_onclose: handleOnCloseSymbol,
   oninit: onInitSymbol,
+  onmessages: onMessagesSymbol,
   no_message_symbol: noMessageSymbol
 } = internalBinding('symbols');
 const {
@@ -38,6 +40,7 @@ const {
   getEnvMessagePort
 } = internalBinding('worker');
 
+const { runNextTicks } = require('internal/process/task_queues');
 const { Readable, Writable } = require('stream');
 const {
   Event,
@@ -195,6 +198,27 @@ ObjectDefineProperty(MessagePort.prototype, handleOnCloseSymbol, {
   value: onclose
 });
 
+// This is called instead of the per-context emitMessage() function when
+// several messages can be delivered at once. `messages` holds the payloads in
+// reverse order. The C++ side empties it if the rest of the messages must not
+// be delivered anymore, e.g. because the port was transferred.
+function onmessages(emitMessage, messages) {
+  while (messages.length > 0) {
+    FunctionPrototypeCall(emitMessage, this, ArrayPrototypePop(messages),
+                          undefined, 'message');
+    // Run ticks and microtasks in between, as if each message had been
+    // emitted by a separate callback.
+    if (messages.length > 0)
+      runNextTicks();
+  }
+}
+
+ObjectDefineProperty(MessagePort.prototype, onMessagesSymbol, {
+  enumerable: false,
+  writable: false,
+  value: onmessages
+});
+
 MessagePort.prototype.close = function(cb) {
   if (typeof cb === 'function')
     this.once('close', cb);
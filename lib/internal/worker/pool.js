@@ -0,0 +1,331 @@
+'use strict';
+
+const {
+  ArrayPrototypeIndexOf,
+  ArrayPrototypePop,
+  ArrayPrototypePush,
+  ArrayPrototypeSplice,
+  ObjectAssign,
+  PromisePrototypeThen,
+  PromiseReject,
+} = primordials;
+
+const {
+  AbortError,
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_STATE,
+    ERR_WORKER_EXITED,
+  },
+} = require('internal/errors');
+const {
+  validateAbortSignal,
+  validateArray,
+  validateInteger,
+  validateObject,
+} = require('internal/validators');
+const { createDeferredPromise } = require('internal/util');
+const { Worker, kPoolPort } = require('internal/worker');
+const { MessageChannel } = require('internal/worker/io');
+
+// Tasks are sent to the workers as [id, value], and their results are sent
+// back as [id, value, failed].
+const kTaskId = 0;
+const kTaskValue = 1;
+const kTaskFailed = 2;
+
+let defaultSize;
+function getDefaultSize() {
+  if (defaultSize === undefined)
+    defaultSize = require('os').cpus().length || 1;
+  return defaultSize;
+}
+
+// A Worker of the pool, together with the task that it is running, if any.
+class PoolWorker {
+  constructor(worker, port) {
+    this.worker = worker;
+    this.port = port;
+    this.task = null;
+    this.error = null;
+    this.heapUsed = 0;
+  }
+}
+
+// Tasks are kept in a single queue for the whole pool, and are only handed
+// to workers that are idle. A slow task therefore never holds up the tasks
+// that were queued after it while other workers are available.
+class Pool {
+  #filename;
+  #workerOptions;
+  #size;
+  #workers = [];
+  #idle = [];
+  // The queue is an array with a moving head, so that taking the next task
+  // does not have to shift the remaining ones.
+  #queue = [];
+  #queueHead = 0;
+  #nextTaskId = 0;
+  #completed = 0;
+  #failed = 0;
+  #cancelled = 0;
+  #closing = null;
+  #stopping = false;
+
+  constructor(filename, options = {}) {
+    validateObject(options, 'options');
+    const { size = getDefaultSize() } = options;
+    validateInteger(size, 'options.size', 1);
+    if (options.eval) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'options.eval', options.eval, 'is not supported by Pool');
+    }
+    if (options.transferList !== undefined) {
+      throw new ERR_INVALID_ARG_VALUE(
+        'options.transferList', options.transferList,
+        'is not supported by Pool');
+    }
+    this.#filename = filename;
+    this.#workerOptions = ObjectAssign({}, options);
+    delete this.#workerOptions.size;
+    this.#size = size;
+    // Start one worker right away, which also validates the filename and the
+    // other options.
+    ArrayPrototypePush(this.#idle, this.#spawn());
+  }
+
+  get size() {
+    return this.#size;
+  }
+
+  get stats() {
+    let utilization = 0;
+    let heapUsed = 0;
+    for (let i = 0; i < this.#workers.length; i++) {
+      utilization +=
+        this.#workers[i].worker.performance.eventLoopUtilization().utilization;
+      heapUsed += this.#workers[i].heapUsed;
+    }
+    if (this.#workers.length > 0)
+      utilization /= this.#workers.length;
+    return {
+      workers: this.#workers.length,
+      idle: this.#idle.length,
+      queued: this.#queue.length - this.#queueHead,
+      running: this.#workers.length - this.#idle.length,
+      completed: this.#completed,
+      failed: this.#failed,
+      cancelled: this.#cancelled,
+      utilization,
+      heapUsed,
+    };
+  }
+
+  run(value, options = {}) {
+    try {
+      validateObject(options, 'options');
+      const { signal, transferList } = options;
+      if (signal !== undefined)
+        validateAbortSignal(signal, 'options.signal');
+      if (transferList !== undefined)
+        validateArray(transferList, 'options.transferList');
+      if (this.#closing !== null)
+        throw new ERR_INVALID_STATE('The pool is closed');
+      if (signal?.aborted)
+        throw new AbortError();
+
+      const { promise, resolve, reject } = createDeferredPromise();
+      const task = {
+        id: this.#nextTaskId++,
+        value,
+        transferList,
+        resolve,
+        reject,
+        signal,
+        onAbort: null,
+        worker: null,
+      };
+      if (signal !== undefined) {
+        task.onAbort = () => this.#cancel(task);
+        signal.addEventListener('abort', task.onAbort, { once: true });
+      }
+      ArrayPrototypePush(this.#queue, task);
+      this.#dispatch();
+      return promise;
+    } catch (err) {
+      return PromiseReject(err);
+    }
+  }
+
+  // Waits for all queued and running tasks, and then stops the workers.
+  close() {
+    if (this.#closing === null) {
+      this.#closing = createDeferredPromise();
+      this.#maybeFinishClosing();
+    }
+    return this.#closing.promise;
+  }
+
+  #dispatch() {
+    while (this.#queueHead < this.#queue.length) {
+      let poolWorker = ArrayPrototypePop(this.#idle);
+      if (poolWorker === undefined) {
+        if (this.#workers.length >= this.#size)
+          return;
+        poolWorker = this.#spawn();
+      }
+      const task = this.#queue[this.#queueHead];
+      this.#queue[this.#queueHead++] = undefined;
+      if (this.#queueHead === this.#queue.length) {
+        this.#queue = [];
+        this.#queueHead = 0;
+      }
+      this.#start(poolWorker, task);
+    }
+  }
+
+  #spawn() {
+    const { port1, port2 } = new MessageChannel();
+    const worker = new Worker(
+      this.#filename,
+      ObjectAssign({}, this.#workerOptions, { [kPoolPort]: port2 }));
+    const poolWorker = new PoolWorker(worker, port1);
+    ArrayPrototypePush(this.#workers, poolWorker);
+    worker.unref();
+    port1.on('message', (message) => this.#onResult(poolWorker, message));
+    port1.unref();
+    worker.on('error', (err) => { poolWorker.error = err; });
+    worker.on('heapGrowth', ({ usedHeapSize }) => {
+      poolWorker.heapUsed = usedHeapSize;
+    });
+    worker.on('exit', (code) => this.#onExit(poolWorker, code));
+    return poolWorker;
+  }
+
+  #start(poolWorker, task) {
+    try {
+      poolWorker.port.postMessage([task.id, task.value], task.transferList);
+    } catch (err) {
+      this.#settle(task, err, true);
+      ArrayPrototypePush(this.#idle, poolWorker);
+      return;
+    }
+    task.value = undefined;
+    task.worker = poolWorker;
+    poolWorker.task = task;
+    poolWorker.worker.ref();
+  }
+
+  #onResult(poolWorker, message) {
+    const task = poolWorker.task;
+    if (task === null || task.id !== message[kTaskId])
+      return;
+    poolWorker.task = null;
+    poolWorker.worker.unref();
+    ArrayPrototypePush(this.#idle, poolWorker);
+    this.#settle(task, message[kTaskValue], message[kTaskFailed]);
+    this.#dispatch();
+    this.#maybeFinishClosing();
+  }
+
+  #onExit(poolWorker, code) {
+    ArrayPrototypeSplice(
+      this.#workers, ArrayPrototypeIndexOf(this.#workers, poolWorker), 1);
+    const idleIndex = ArrayPrototypeIndexOf(this.#idle, poolWorker);
+    if (idleIndex !== -1)
+      ArrayPrototypeSplice(this.#idle, idleIndex, 1);
+    const task = poolWorker.task;
+    if (task !== null) {
+      poolWorker.task = null;
+      this.#settle(task, poolWorker.error ?? new ERR_WORKER_EXITED(code), true);
+    }
+    // Replace the worker if there are tasks waiting for it.
+    this.#dispatch();
+    this.#maybeFinishClosing();
+  }
+
+  #cancel(task) {
+    if (task.worker === null) {
+      const index = ArrayPrototypeIndexOf(this.#queue, task, this.#queueHead);
+      if (index === -1)
+        return;
+      ArrayPrototypeSplice(this.#queue, index, 1);
+    } else {
+      // There is no way to interrupt a running task other than stopping its
+      // worker, which is replaced by a new one once it has exited.
+      if (task.worker.task !== task)
+        return;
+      task.worker.task = null;
+      task.worker.worker.terminate();
+    }
+    this.#cancelled++;
+    this.#settle(task, new AbortError(), true, false);
+    this.#maybeFinishClosing();
+  }
+
+  #settle(task, result, failed, count = true) {
+    if (task.onAbort !== null)
+      task.signal.removeEventListener('abort', task.onAbort);
+    if (count) {
+      if (failed)
+        this.#failed++;
+      else
+        this.#completed++;
+    }
+    if (failed)
+      task.reject(result);
+    else
+      task.resolve(result);
+  }
+
+  #maybeFinishClosing() {
+    if (this.#closing === null || this.#stopping ||
+        this.#queueHead < this.#queue.length ||
+        this.#idle.length < this.#workers.length) {
+      return;
+    }
+    this.#stopping = true;
+    const { resolve } = this.#closing;
+    const workers = this.#workers;
+    let pending = workers.length;
+    if (pending === 0)
+      return resolve();
+    for (let i = 0; i < workers.length; i++) {
+      PromisePrototypeThen(workers[i].worker.terminate(), () => {
+        if (--pending === 0)
+          resolve();
+      });
+    }
+  }
+}
+
+// Runs in the pool's workers: loads the module that exports the task
+// function, and calls it for every task that is received on `port`.
+function runPoolWorker(filename, port) {
+  const { loadESM } = require('internal/process/esm_loader');
+  const { pathToFileURL } = require('internal/url');
+  let handler;
+  const loaded = loadESM(async (loader) => {
+    const namespace = await loader.import(pathToFileURL(filename).href);
+    handler = namespace.default;
+  });
+
+  port.on('message', async (message) => {
+    const id = message[kTaskId];
+    try {
+      await loaded;
+      if (typeof handler !== 'function')
+        throw new ERR_INVALID_ARG_TYPE('module.exports', 'function', handler);
+      const result = await handler(message[kTaskValue]);
+      port.postMessage([id, result, false]);
+    } catch (err) {
+      port.postMessage([id, err, true]);
+    }
+  });
+}
+
+module.exports = {
+  Pool,
+  runPoolWorker,
+};
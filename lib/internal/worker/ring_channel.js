@@ -0,0 +1,341 @@
+'use strict';
+
+/* global SharedArrayBuffer */
+
+const {
+  Int32Array,
+  MathMax,
+  Symbol,
+  TypedArrayPrototypeSet,
+  TypedArrayPrototypeSubarray,
+  Uint8Array,
+} = primordials;
+
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_STATE,
+    ERR_OUT_OF_RANGE,
+  },
+} = require('internal/errors');
+const { validateInteger, validateObject } = require('internal/validators');
+const { isAnyArrayBuffer, isArrayBufferView } = require('internal/util/types');
+const { EventEmitterMixin } = require('internal/event_target');
+const {
+  JSTransferable,
+  kDeserialize,
+  kTransfer,
+  kTransferList,
+} = require('internal/worker/js_transferable');
+const { MessageChannel } = require('internal/worker/io');
+const { FastBuffer } = require('internal/buffer');
+
+let v8;
+function lazyV8() {
+  if (v8 === undefined)
+    v8 = require('v8');
+  return v8;
+}
+
+// The SharedArrayBuffer starts with a header of Int32 fields, followed by the
+// ring itself. The write and read indices only ever grow (modulo 2 ** 32);
+// the writer owns the first one and the reader owns the second one.
+const kWriteIndex = 0;
+const kReadIndex = 1;
+// Set by the reader when it has run out of frames. The writer clears it and
+// wakes the reader up through the MessagePort.
+const kReaderIdle = 2;
+// Set by the writer when a frame did not fit. The reader clears it and emits
+// 'drain' on the writer through the MessagePort once it has made room.
+const kWriterWaiting = 3;
+const kHeaderBytes = 16;
+
+// Each frame starts with a 4-byte word that holds the length of its body and
+// its type, and is padded to a multiple of 4 bytes.
+const kFrameHeaderBytes = 4;
+const kBinaryFrame = 0;
+const kCloneFrame = 1;
+
+const kMinByteLength = 64;
+const kMaxByteLength = 2 ** 30;
+const kDefaultByteLength = 64 * 1024;
+
+const kState = Symbol('kState');
+const kRing = Symbol('kRing');
+const kFrameHeaders = Symbol('kFrameHeaders');
+const kPort = Symbol('kPort');
+const kPosition = Symbol('kPosition');
+const kInit = Symbol('kInit');
+const kStarted = Symbol('kStarted');
+const kDrain = Symbol('kDrain');
+
+function frameSize(bodyLength) {
+  return kFrameHeaderBytes + ((bodyLength + 3) & ~3);
+}
+
+function nextPowerOfTwo(value) {
+  let result = kMinByteLength;
+  while (result < value)
+    result *= 2;
+  return result;
+}
+
+function validateOpen(channelEnd, name) {
+  if (channelEnd[kPort] === null)
+    throw new ERR_INVALID_STATE(`The ${name} is closed or was transferred`);
+}
+
+class RingEnd extends EventEmitterMixin(JSTransferable) {
+  constructor() {
+    super();
+    this[kState] = null;
+    this[kRing] = null;
+    this[kFrameHeaders] = null;
+    this[kPort] = null;
+    this[kPosition] = 0;
+    this[kStarted] = false;
+  }
+
+  [kInit](buffer, port) {
+    const capacity = buffer.byteLength - kHeaderBytes;
+    this[kState] = new Int32Array(buffer, 0, kHeaderBytes / 4);
+    this[kRing] = new Uint8Array(buffer, kHeaderBytes, capacity);
+    this[kFrameHeaders] = new Int32Array(buffer, kHeaderBytes, capacity / 4);
+    this[kPort] = port;
+    port.on('close', () => {
+      // Frames that were written before the channel was closed are still
+      // emitted.
+      if (this[kStarted])
+        this[kDrain]();
+      this[kPort] = null;
+      this.emit('close');
+    });
+  }
+
+  close() {
+    if (this[kPort] !== null)
+      this[kPort].close();
+  }
+
+  ref() {
+    if (this[kPort] !== null)
+      this[kPort].ref();
+    return this;
+  }
+
+  unref() {
+    if (this[kPort] !== null)
+      this[kPort].unref();
+    return this;
+  }
+
+  [kTransfer]() {
+    validateOpen(this, this.constructor.name);
+    const port = this[kPort];
+    const buffer = this[kState].buffer;
+    port.removeAllListeners();
+    this[kPort] = null;
+    return {
+      data: { buffer, port },
+      deserializeInfo: `internal/worker/ring_channel:${this.constructor.name}`
+    };
+  }
+
+  [kTransferList]() {
+    return [this[kPort]];
+  }
+
+  [kDeserialize]({ buffer, port }) {
+    this[kInit](buffer, port);
+  }
+}
+
+class RingWriter extends RingEnd {
+  [kInit](buffer, port) {
+    super[kInit](buffer, port);
+    this[kPosition] = Atomics.load(this[kState], kWriteIndex);
+    // The port is only kept alive while waiting for room in the ring.
+    port.on('message', () => {
+      port.unref();
+      this.emit('drain');
+    });
+    port.unref();
+  }
+
+  // Returns false without writing anything if the frame does not fit into the
+  // ring at the moment. 'drain' is emitted once the reader has made room.
+  write(data) {
+    if (isArrayBufferView(data)) {
+      data = new Uint8Array(data.buffer, data.byteOffset, data.byteLength);
+    } else if (isAnyArrayBuffer(data)) {
+      data = new Uint8Array(data);
+    } else {
+      throw new ERR_INVALID_ARG_TYPE(
+        'data', ['ArrayBuffer', 'Buffer', 'TypedArray', 'DataView'], data);
+    }
+    return this.#writeFrame(data, kBinaryFrame);
+  }
+
+  postMessage(value) {
+    return this.#writeFrame(lazyV8().serialize(value), kCloneFrame);
+  }
+
+  #writeFrame(body, type) {
+    validateOpen(this, 'RingWriter');
+    const state = this[kState];
+    const ring = this[kRing];
+    const capacity = ring.length;
+    const size = frameSize(body.length);
+    if (size > capacity) {
+      throw new ERR_OUT_OF_RANGE(
+        'The frame size', `<= ${capacity - kFrameHeaderBytes}`, body.length);
+    }
+
+    const position = this[kPosition];
+    if (!this.#fits(position, size)) {
+      Atomics.store(state, kWriterWaiting, 1);
+      this[kPort].ref();
+      // The reader may have made room in the meantime. If it has already
+      // cleared the flag, the 'drain' event is on its way.
+      if (!this.#fits(position, size) ||
+          Atomics.compareExchange(state, kWriterWaiting, 1, 0) !== 1) {
+        return false;
+      }
+      this[kPort].unref();
+    }
+
+    const offset = position & (capacity - 1);
+    this[kFrameHeaders][offset / 4] = (body.length << 1) | type;
+    const start = (offset + kFrameHeaderBytes) & (capacity - 1);
+    const first = capacity - start;
+    if (body.length <= first) {
+      TypedArrayPrototypeSet(ring, body, start);
+    } else {
+      TypedArrayPrototypeSet(ring, TypedArrayPrototypeSubarray(body, 0, first),
+                             start);
+      TypedArrayPrototypeSet(ring, TypedArrayPrototypeSubarray(body, first), 0);
+    }
+    this[kPosition] = (position + size) | 0;
+    Atomics.store(state, kWriteIndex, this[kPosition]);
+
+    if (Atomics.load(state, kReaderIdle) === 1 &&
+        Atomics.compareExchange(state, kReaderIdle, 1, 0) === 1) {
+      this[kPort].postMessage(null);
+    }
+    return true;
+  }
+
+  #fits(position, size) {
+    const used = (position - Atomics.load(this[kState], kReadIndex)) >>> 0;
+    return this[kRing].length - used >= size;
+  }
+}
+
+class RingReader extends RingEnd {
+  [kInit](buffer, port) {
+    super[kInit](buffer, port);
+    this[kPosition] = Atomics.load(this[kState], kReadIndex);
+    port.on('message', () => this[kDrain]());
+    port.unref();
+    // Frames are only emitted while there are 'message' listeners. Until
+    // then, they can be taken out of the ring with read().
+    this.on('newListener', (name) => {
+      if (name === 'message' && !this[kStarted] && this[kPort] !== null) {
+        this[kStarted] = true;
+        this[kPort].ref();
+        process.nextTick(() => this[kDrain]());
+      }
+    });
+    this.on('removeListener', (name) => {
+      if (name === 'message' && this.listenerCount('message') === 0 &&
+          this[kPort] !== null) {
+        this[kStarted] = false;
+        this[kPort].unref();
+      }
+    });
+  }
+
+  // Returns `{ message }` for the next frame, or undefined if there is none.
+  // Binary frames are returned as Buffers.
+  read() {
+    validateOpen(this, 'RingReader');
+    return this.#readFrame();
+  }
+
+  #readFrame() {
+    const state = this[kState];
+    const position = this[kPosition];
+    if (Atomics.load(state, kWriteIndex) === position)
+      return undefined;
+
+    const ring = this[kRing];
+    const capacity = ring.length;
+    const offset = position & (capacity - 1);
+    const header = this[kFrameHeaders][offset / 4];
+    const length = header >>> 1;
+    const body = new FastBuffer(length);
+    const start = (offset + kFrameHeaderBytes) & (capacity - 1);
+    const first = capacity - start;
+    if (length <= first) {
+      TypedArrayPrototypeSet(
+        body, TypedArrayPrototypeSubarray(ring, start, start + length));
+    } else {
+      TypedArrayPrototypeSet(body, TypedArrayPrototypeSubarray(ring, start));
+      TypedArrayPrototypeSet(
+        body, TypedArrayPrototypeSubarray(ring, 0, length - first), first);
+    }
+    this[kPosition] = (position + frameSize(length)) | 0;
+    Atomics.store(state, kReadIndex, this[kPosition]);
+
+    if (Atomics.load(state, kWriterWaiting) === 1 &&
+        Atomics.compareExchange(state, kWriterWaiting, 1, 0) === 1) {
+      this[kPort].postMessage(null);
+    }
+    return { message: (header & 1) === kCloneFrame ?
+      lazyV8().deserialize(body) : body };
+  }
+
+  [kDrain]() {
+    while (this[kStarted] && this[kPort] !== null) {
+      let frame;
+      while (this[kStarted] && this[kPort] !== null &&
+             (frame = this.#readFrame()) !== undefined) {
+        this.emit('message', frame.message);
+      }
+      if (!this[kStarted] || this[kPort] === null)
+        return;
+      const state = this[kState];
+      Atomics.store(state, kReaderIdle, 1);
+      // If the writer has added a frame in the meantime, either continue
+      // here, or, if it has already cleared the flag, wait for its wakeup.
+      if (Atomics.load(state, kWriteIndex) === this[kPosition] ||
+          Atomics.compareExchange(state, kReaderIdle, 1, 0) !== 1) {
+        return;
+      }
+    }
+  }
+}
+
+class RingChannel {
+  constructor(options = {}) {
+    validateObject(options, 'options');
+    const { byteLength = kDefaultByteLength } = options;
+    validateInteger(byteLength, 'options.byteLength', 1, kMaxByteLength);
+    const capacity = nextPowerOfTwo(MathMax(byteLength, kMinByteLength));
+    const buffer = new SharedArrayBuffer(kHeaderBytes + capacity);
+    // The reader starts out idle, so the first frame wakes it up.
+    Atomics.store(new Int32Array(buffer, 0, kHeaderBytes / 4), kReaderIdle, 1);
+
+    const { port1, port2 } = new MessageChannel();
+    this.writer = new RingWriter();
+    this.writer[kInit](buffer, port1);
+    this.reader = new RingReader();
+    this.reader[kInit](buffer, port2);
+  }
+}
+
+module.exports = {
+  RingChannel,
+  RingReader,
+  RingWriter,
+};
@@ -27,7 +27,9 @@ const {
   ArrayPrototypePush,
   ArrayPrototypeSplice,
   Boolean,
+  MathMax,
   Error,
+  Float64Array,
   FunctionPrototype,
   FunctionPrototypeCall,
   Number,
@@ -36,6 +38,7 @@ const {
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
   ReflectApply,
+  SafeSet,
   Symbol,
 } = primordials;
 
@@ -55,7 +58,8 @@ const assert = require('internal/assert');
 const {
   UV_EADDRINUSE,
   UV_EINVAL,
-  UV_ENOTCONN
+  UV_ENOTCONN,
+  UV_ENOTSUP,
 } = internalBinding('uv');
 
 const { Buffer } = require('buffer');
@@ -79,9 +83,11 @@ const {
 const {
   writevGeneric,
   writeGeneric,
+  releaseWriteWrap,
   onStreamRead,
   kAfterAsyncWrite,
   kHandle,
+  kSession,
   kUpdateTimer,
   setStreamTimeout,
   kBuffer,
@@ -95,6 +101,7 @@ const {
     ERR_INVALID_ARG_VALUE,
     ERR_INVALID_FD_TYPE,
     ERR_INVALID_IP_ADDRESS,
+    ERR_OUT_OF_RANGE,
     ERR_SERVER_ALREADY_LISTEN,
     ERR_SERVER_NOT_RUNNING,
     ERR_SOCKET_CLOSED,
@@ -107,12 +114,16 @@ const {
 const { isUint8Array } = require('internal/util/types');
 const {
   validateAbortSignal,
+  validateBoolean,
   validateInt32,
   validateNumber,
+  validateObject,
   validatePort,
-  validateString
+  validateString,
+  validateUint32,
 } = require('internal/validators');
 const kLastWriteQueueSize = Symbol('lastWriteQueueSize');
+const kRTTHistogram = Symbol('kRTTHistogram');
 const {
   DTRACE_NET_SERVER_CONNECTION,
   DTRACE_NET_STREAM_END
@@ -122,8 +133,12 @@ const {
 let cluster;
 let dns;
 let BlockList;
+let getNativeMemoryUsage;
+let RecordableHistogram;
+let tcpInfoFields;
+let IOThreadStream;
 
-const { clearTimeout } = require('timers');
+const { clearTimeout, setTimeout } = require('timers');
 const { kTimeout } = require('internal/timers');
 
 const DEFAULT_IPV4_ADDR = '0.0.0.0';
@@ -133,8 +148,17 @@ const isWindows = process.platform === 'win32';
 
 const noop = FunctionPrototype;
 
-function getFlags(ipv6Only) {
-  return ipv6Only === true ? TCPConstants.UV_TCP_IPV6ONLY : 0;
+// The Connection Attempt Delay that RFC 8305 recommends.
+const kDefaultAutoSelectFamilyAttemptDelay = 250;
+let autoSelectFamilyDefault = false;
+
+function getFlags(options) {
+  let flags = 0;
+  if (options.ipv6Only === true)
+    flags |= TCPConstants.UV_TCP_IPV6ONLY;
+  if (options.reusePort === true)
+    flags |= TCPConstants.UV_TCP_REUSEPORT;
+  return flags;
 }
 
 function createHandle(fd, is_server) {
@@ -249,22 +273,25 @@ function initSocketHandle(self) {
   self._sockname = null;
 
   // Handle creation may be deferred to bind() or connect() time.
-  if (self._handle) {
-    self._handle[owner_symbol] = self;
-    self._handle.onread = onStreamRead;
-    self[async_id_symbol] = getNewAsyncId(self._handle);
-
-    let userBuf = self[kBuffer];
-    if (userBuf) {
-      const bufGen = self[kBufferGen];
-      if (bufGen !== null) {
-        userBuf = bufGen();
-        if (!isUint8Array(userBuf))
-          return;
-        self[kBuffer] = userBuf;
-      }
-      self._handle.useUserBuffer(userBuf);
+  if (self._handle)
+    attachSocketHandle(self);
+}
+
+function attachSocketHandle(self) {
+  self._handle[owner_symbol] = self;
+  self._handle.onread = onStreamRead;
+  self[async_id_symbol] = getNewAsyncId(self._handle);
+
+  let userBuf = self[kBuffer];
+  if (userBuf) {
+    const bufGen = self[kBufferGen];
+    if (bufGen !== null) {
+      userBuf = bufGen();
+      if (!isUint8Array(userBuf))
+        return;
+      self[kBuffer] = userBuf;
     }
+    self._handle.useUserBuffer(userBuf);
   }
 }
 
@@ -272,6 +299,11 @@ function initSocketHandle(self) {
 const kBytesRead = Symbol('kBytesRead');
 const kBytesWritten = Symbol('kBytesWritten');
 const kSetNoDelay = Symbol('kSetNoDelay');
+const kConnectAttempts = Symbol('kConnectAttempts');
+const kAutoCork = Symbol('kAutoCork');
+const kAutoCorked = Symbol('kAutoCorked');
+const kConnectionRateLimit = Symbol('kConnectionRateLimit');
+const kIOThread = Symbol('kIOThread');
 
 function Socket(options) {
   if (!(this instanceof Socket)) return new Socket(options);
@@ -286,17 +318,25 @@ function Socket(options) {
   this._parent = null;
   this._host = null;
   this[kSetNoDelay] = false;
+  this[kConnectAttempts] = null;
   this[kLastWriteQueueSize] = 0;
   this[kTimeout] = null;
   this[kBuffer] = null;
   this[kBufferCb] = null;
   this[kBufferGen] = null;
+  this[kAutoCork] = false;
+  this[kAutoCorked] = false;
 
   if (typeof options === 'number')
     options = { fd: options }; // Legacy interface.
   else
     options = { ...options };
 
+  if (options.autoCork !== undefined) {
+    validateBoolean(options.autoCork, 'options.autoCork');
+    this[kAutoCork] = options.autoCork;
+  }
+
   // Default to *not* allowing half open sockets.
   options.allowHalfOpen = Boolean(options.allowHalfOpen);
   // For backwards compat do not emit close on destroy.
@@ -387,6 +427,7 @@ function Socket(options) {
   // Used after `.destroy()`
   this[kBytesRead] = 0;
   this[kBytesWritten] = 0;
+  this[kRTTHistogram] = undefined;
 }
 ObjectSetPrototypeOf(Socket.prototype, stream.Duplex.prototype);
 ObjectSetPrototypeOf(Socket, stream.Duplex);
@@ -435,6 +476,34 @@ function afterShutdown() {
   this.callback();
 }
 
+// With autoCork, all writes from the same tick are handed to the handle as
+// a single writev() once the tick is over, or earlier if they add up to the
+// high water mark.
+Socket.prototype.write = function(chunk, encoding, cb) {
+  if (this[kAutoCork] && !this[kAutoCorked] && !this.writableEnded) {
+    this[kAutoCorked] = true;
+    this.cork();
+    process.nextTick(autoUncorkNT, this);
+  }
+
+  const ret = ReflectApply(
+    stream.Duplex.prototype.write, this, [chunk, encoding, cb]);
+
+  if (this[kAutoCorked] &&
+      this.writableLength >= this.writableHighWaterMark) {
+    this[kAutoCorked] = false;
+    this.uncork();
+  }
+  return ret;
+};
+
+function autoUncorkNT(socket) {
+  if (socket[kAutoCorked]) {
+    socket[kAutoCorked] = false;
+    socket.uncork();
+  }
+}
+
 // Provide a better error message when we call end() as a result
 // of the other side sending a FIN.  The standard 'write after end'
 // is overly vague, and makes it seem like the user's code is to blame.
@@ -517,6 +586,83 @@ Socket.prototype.address = function() {
 };
 
 
+Socket.prototype.memoryUsage = function() {
+  if (getNativeMemoryUsage === undefined)
+    ({ getNativeMemoryUsage } = internalBinding('heap_utils'));
+  // The HTTP parser and the HTTP/2 session of the socket belong to it, too.
+  const session = this[kSession];
+  return getNativeMemoryUsage(this._handle,
+                              this.parser,
+                              session !== undefined ?
+                                session[kHandle] : undefined);
+};
+
+
+// Returns the fields of TCPWrap::GetTCPInfo(), or undefined if the handle is
+// not a TCP socket or the platform does not support it. The array is reused.
+function readTCPInfo(handle) {
+  if (typeof handle?.getTCPInfo !== 'function')
+    return undefined;
+  if (tcpInfoFields === undefined)
+    tcpInfoFields = new Float64Array(TCPConstants.kTCPInfoFieldsCount);
+  const err = handle.getTCPInfo(tcpInfoFields);
+  if (err === UV_ENOTSUP)
+    return undefined;
+  if (err)
+    throw errnoException(err, 'getTCPInfo');
+  return tcpInfoFields;
+}
+
+
+Socket.prototype.getTCPInfo = function() {
+  const fields = readTCPInfo(this._handle);
+  if (fields === undefined)
+    return undefined;
+  return {
+    state: fields[0],
+    rtt: fields[1],
+    rttVar: fields[2],
+    minRtt: fields[3],
+    rto: fields[4],
+    sndCwnd: fields[5],
+    sndSsthresh: fields[6],
+    sndMss: fields[7],
+    unacked: fields[8],
+    lost: fields[9],
+    retransmits: fields[10],
+    totalRetrans: fields[11],
+    deliveryRate: fields[12],
+    bytesAcked: fields[13],
+    bytesReceived: fields[14],
+  };
+};
+
+
+Socket.prototype.setRTTHistogram = function(histogram) {
+  if (RecordableHistogram === undefined)
+    ({ RecordableHistogram } = require('internal/histogram'));
+  if (!(histogram instanceof RecordableHistogram)) {
+    throw new ERR_INVALID_ARG_TYPE('histogram', 'RecordableHistogram',
+                                   histogram);
+  }
+  this[kRTTHistogram] = histogram;
+  return this;
+};
+
+
+function recordRTT(socket) {
+  let fields;
+  try {
+    fields = readTCPInfo(socket._handle);
+  } catch {
+    // The connection is gone already, there is nothing to record.
+    return;
+  }
+  if (fields !== undefined && fields[1] > 0)
+    socket[kRTTHistogram].record(fields[1]);
+}
+
+
 ObjectDefineProperty(Socket.prototype, '_connecting', {
   get: function() {
     return this.connecting;
@@ -646,6 +792,8 @@ Socket.prototype._destroy = function(exception, cb) {
   debug('destroy');
 
   this.connecting = false;
+  if (this[kConnectAttempts] !== null)
+    abortConnectAttempts(this);
 
   for (let s = this; s !== null; s = s._parent) {
     clearTimeout(s[kTimeout]);
@@ -659,6 +807,8 @@ Socket.prototype._destroy = function(exception, cb) {
     // `bytesRead` and `kBytesWritten` should be accessible after `.destroy()`
     this[kBytesRead] = this._handle.bytesRead;
     this[kBytesWritten] = this._handle.bytesWritten;
+    if (this[kRTTHistogram] !== undefined)
+      recordRTT(this);
 
     this._handle.close(() => {
       debug('emit close');
@@ -779,6 +929,7 @@ Socket.prototype._writeGeneric = function(writev, data, encoding, cb) {
     req = writeGeneric(this, data, encoding, cb);
   if (req.async)
     this[kLastWriteQueueSize] = req.bytes;
+  releaseWriteWrap(req);
 };
 
 
@@ -1017,6 +1168,19 @@ function lookupAndConnect(self, options) {
                                    'Function', options.lookup);
 
 
+  let autoSelectFamily = autoSelectFamilyDefault;
+  if (options.autoSelectFamily !== undefined) {
+    validateBoolean(options.autoSelectFamily, 'options.autoSelectFamily');
+    autoSelectFamily = options.autoSelectFamily;
+  }
+  let attemptDelay = kDefaultAutoSelectFamilyAttemptDelay;
+  if (options.autoSelectFamilyAttemptDelay !== undefined) {
+    // RFC 8305 sets a lower bound of 10 milliseconds.
+    validateInt32(options.autoSelectFamilyAttemptDelay,
+                  'options.autoSelectFamilyAttemptDelay', 10);
+    attemptDelay = options.autoSelectFamilyAttemptDelay;
+  }
+
   if (dns === undefined) dns = require('dns');
   const dnsopts = {
     family: options.family,
@@ -1034,6 +1198,68 @@ function lookupAndConnect(self, options) {
   debug('connect: dns options', dnsopts);
   self._host = host;
   const lookup = options.lookup || dns.lookup;
+
+  if (autoSelectFamily && dnsopts.family !== 4 && dnsopts.family !== 6) {
+    dnsopts.all = true;
+    defaultTriggerAsyncIdScope(self[async_id_symbol], function() {
+      lookup(host, dnsopts, function emitLookup(err, addresses, addressType) {
+        // A custom lookup function may not support the `all` option.
+        if (!err && !ArrayIsArray(addresses))
+          addresses = [{ address: addresses, family: addressType }];
+
+        if (err) {
+          self.emit('lookup', err, undefined, undefined, host);
+        } else {
+          for (let i = 0; i < addresses.length; i++) {
+            const { address, family } = addresses[i];
+            self.emit('lookup', err, address, family, host);
+          }
+        }
+
+        // It's possible we were destroyed while looking this up.
+        if (!self.connecting) return;
+
+        if (!err) {
+          for (let i = 0; i < addresses.length; i++) {
+            const { address, family } = addresses[i];
+            if (!isIP(address)) {
+              err = new ERR_INVALID_IP_ADDRESS(address);
+              break;
+            }
+            if (family !== 4 && family !== 6) {
+              err = new ERR_INVALID_ADDRESS_FAMILY(family,
+                                                   options.host,
+                                                   options.port);
+              break;
+            }
+          }
+          if (!err && addresses.length === 0)
+            err = new ERR_INVALID_IP_ADDRESS(addresses);
+        }
+
+        if (err) {
+          process.nextTick(connectErrorNT, self, err);
+        } else if (addresses.length === 1) {
+          self._unrefTimer();
+          defaultTriggerAsyncIdScope(
+            self[async_id_symbol],
+            internalConnect,
+            self, addresses[0].address, port, addresses[0].family,
+            localAddress, localPort
+          );
+        } else {
+          self._unrefTimer();
+          defaultTriggerAsyncIdScope(
+            self[async_id_symbol],
+            internalConnectMultiple,
+            self, addresses, port, localAddress, localPort, attemptDelay
+          );
+        }
+      });
+    });
+    return;
+  }
+
   defaultTriggerAsyncIdScope(self[async_id_symbol], function() {
     lookup(host, dnsopts, function emitLookup(err, ip, addressType) {
       self.emit('lookup', err, ip, addressType, host);
@@ -1074,6 +1300,184 @@ function connectErrorNT(self, err) {
 }
 
 
+// Orders the addresses as RFC 8305 section 4 describes, alternating between
+// the families and starting with the family of the first address.
+function interleaveAddresses(addresses) {
+  const preferred = [];
+  const other = [];
+  for (let i = 0; i < addresses.length; i++) {
+    if (addresses[i].family === addresses[0].family)
+      ArrayPrototypePush(preferred, addresses[i]);
+    else
+      ArrayPrototypePush(other, addresses[i]);
+  }
+
+  const result = [];
+  for (let i = 0; i < MathMax(preferred.length, other.length); i++) {
+    if (i < preferred.length)
+      ArrayPrototypePush(result, preferred[i]);
+    if (i < other.length)
+      ArrayPrototypePush(result, other[i]);
+  }
+  return result;
+}
+
+// Races connections to the addresses, starting a new attempt each time that
+// the attempt delay elapses or that an attempt fails, until one of them
+// succeeds. The other attempts are then cancelled.
+function internalConnectMultiple(
+  self, addresses, port, localAddress, localPort, delay) {
+  assert(self.connecting);
+
+  // A local address can only be bound for the addresses of its family.
+  if (localAddress) {
+    const localFamily = isIP(localAddress);
+    const matching = [];
+    for (let i = 0; i < addresses.length; i++) {
+      if (addresses[i].family === localFamily)
+        ArrayPrototypePush(matching, addresses[i]);
+    }
+    if (matching.length > 0)
+      addresses = matching;
+  }
+
+  self[kConnectAttempts] = {
+    self,
+    addresses: interleaveAddresses(addresses),
+    port,
+    localAddress,
+    localPort,
+    delay,
+    next: 0,
+    pending: new SafeSet(),
+    errors: [],
+    timer: null,
+  };
+  startConnectAttempt(self[kConnectAttempts]);
+}
+
+function startConnectAttempt(attempts) {
+  const { self, addresses, port, localPort } = attempts;
+  clearTimeout(attempts.timer);
+  attempts.timer = null;
+
+  while (attempts.next < addresses.length) {
+    const { address, family } = addresses[attempts.next++];
+    // The first attempt uses the handle of the socket, the others get their
+    // own until one of them wins.
+    let handle = self._handle;
+    if (attempts.next > 1) {
+      handle = new TCP(TCPConstants.SOCKET);
+      handle[owner_symbol] = self;
+    }
+    debug('connect: attempting %s:%d', address, port);
+
+    let err = 0;
+    let localAddress = attempts.localAddress;
+    if (localAddress || localPort) {
+      if (family === 4) {
+        localAddress = localAddress || DEFAULT_IPV4_ADDR;
+        err = handle.bind(localAddress, localPort);
+      } else {
+        localAddress = localAddress || DEFAULT_IPV6_ADDR;
+        err = handle.bind6(localAddress, localPort, 0);
+      }
+      err = checkBindError(err, localPort, handle);
+    }
+
+    if (err === 0) {
+      const req = new TCPConnectWrap();
+      req.oncomplete = afterConnectAttempt;
+      req.address = address;
+      req.port = port;
+      req.localAddress = localAddress;
+      req.localPort = localPort;
+      req.attempts = attempts;
+
+      if (family === 4)
+        err = handle.connect(req, address, port);
+      else
+        err = handle.connect6(req, address, port);
+    }
+
+    if (err === 0) {
+      attempts.pending.add(handle);
+      if (attempts.next < addresses.length) {
+        attempts.timer = setTimeout(startConnectAttempt, attempts.delay,
+                                    attempts);
+      }
+      return;
+    }
+
+    ArrayPrototypePush(attempts.errors,
+                       exceptionWithHostPort(err, 'connect', address, port));
+    if (handle !== self._handle)
+      handle.close();
+  }
+
+  if (attempts.pending.size === 0)
+    failConnectAttempts(attempts);
+}
+
+function afterConnectAttempt(status, handle, req, readable, writable) {
+  const { attempts } = req;
+  const { self } = attempts;
+  attempts.pending.delete(handle);
+
+  // The attempts were aborted, or another one won.
+  if (self[kConnectAttempts] !== attempts) {
+    if (handle !== self._handle)
+      handle.close();
+    return;
+  }
+
+  if (status !== 0) {
+    debug('connect: attempt to %s:%d failed', req.address, req.port);
+    ArrayPrototypePush(attempts.errors,
+                       exceptionWithHostPort(status, 'connect',
+                                             req.address, req.port));
+    if (handle !== self._handle)
+      handle.close();
+    startConnectAttempt(attempts);
+    return;
+  }
+
+  debug('connect: attempt to %s:%d won', req.address, req.port);
+  abortConnectAttempts(self, handle);
+  if (handle !== self._handle) {
+    const previous = self._handle;
+    previous.onread = noop;
+    previous.close();
+    self._handle = handle;
+    attachSocketHandle(self);
+    if (self[kSetNoDelay] && handle.setNoDelay)
+      handle.setNoDelay(true);
+  }
+  afterConnect(status, handle, req, readable, writable);
+}
+
+// Closes the handles of the pending attempts, except for the winner.
+function abortConnectAttempts(self, winner) {
+  const attempts = self[kConnectAttempts];
+  self[kConnectAttempts] = null;
+  clearTimeout(attempts.timer);
+  for (const handle of attempts.pending) {
+    if (handle !== winner && handle !== self._handle)
+      handle.close();
+  }
+  attempts.pending.clear();
+}
+
+function failConnectAttempts(attempts) {
+  const { self, errors } = attempts;
+  self[kConnectAttempts] = null;
+  // The error of the last attempt is reported, with all of them attached.
+  const error = errors[errors.length - 1];
+  error.errors = errors;
+  self.destroy(error);
+}
+
+
 Socket.prototype.ref = function() {
   if (!this._handle) {
     this.once('connect', this.ref);
@@ -1200,6 +1604,31 @@ function Server(options, connectionListener) {
 
   this.allowHalfOpen = options.allowHalfOpen || false;
   this.pauseOnConnect = !!options.pauseOnConnect;
+  if (options.autoCork !== undefined)
+    validateBoolean(options.autoCork, 'options.autoCork');
+  this[kAutoCork] = options.autoCork === true;
+  if (options.ioThread !== undefined)
+    validateBoolean(options.ioThread, 'options.ioThread');
+  this[kIOThread] = options.ioThread === true;
+  this[kConnectionRateLimit] = null;
+  if (options.connectionRateLimit !== undefined) {
+    const limit = options.connectionRateLimit;
+    validateObject(limit, 'options.connectionRateLimit');
+    const { rate, burst = rate, maxAddresses = 10000 } = limit;
+    validateNumber(rate, 'options.connectionRateLimit.rate');
+    if (!(rate > 0) || rate === Infinity) {
+      throw new ERR_OUT_OF_RANGE('options.connectionRateLimit.rate',
+                                 'a positive finite number', rate);
+    }
+    validateNumber(burst, 'options.connectionRateLimit.burst');
+    if (!(burst >= 1) || burst === Infinity) {
+      throw new ERR_OUT_OF_RANGE('options.connectionRateLimit.burst',
+                                 '>= 1 and finite', burst);
+    }
+    validateUint32(maxAddresses, 'options.connectionRateLimit.maxAddresses',
+                   true);
+    this[kConnectionRateLimit] = { rate, burst, maxAddresses };
+  }
 }
 ObjectSetPrototypeOf(Server.prototype, EventEmitter.prototype);
 ObjectSetPrototypeOf(Server, EventEmitter);
@@ -1249,12 +1678,14 @@ function createServerHandle(address, port, addressType, fd, flags) {
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle(DEFAULT_IPV4_ADDR, port);
+        return createServerHandle(DEFAULT_IPV4_ADDR, port, undefined,
+                                  undefined, flags);
       }
     } else if (addressType === 6) {
       err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port,
+                        flags & ~TCPConstants.UV_TCP_IPV6ONLY);
     }
   }
 
@@ -1307,6 +1738,14 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
   this._handle.onconnection = onconnection;
   this._handle[owner_symbol] = this;
 
+  // Servers in cluster workers that get their connections from the primary
+  // do not accept them themselves, so the limit cannot apply to them.
+  const limit = this[kConnectionRateLimit];
+  if (limit !== null && this._handle instanceof TCP) {
+    this._handle.setConnectionRateLimit(limit.rate, limit.burst,
+                                        limit.maxAddresses);
+  }
+
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
@@ -1411,7 +1850,10 @@ Server.prototype.listen = function(...args) {
     toNumber(args.length > 2 && args[2]);  // (port, host, backlog)
 
   options = options._handle || options.handle || options;
-  const flags = getFlags(options.ipv6Only);
+  const flags = getFlags(options);
+  // Every socket of a SO_REUSEPORT group has its own accept queue, so
+  // cluster workers must not share the primary's handle.
+  const exclusive = options.exclusive || options.reusePort === true;
   // (handle[, backlog][, cb]) where handle is an object with a handle
   if (options instanceof TCP) {
     this._handle = options;
@@ -1445,11 +1887,12 @@ Server.prototype.listen = function(...args) {
     // start TCP server listening on host:port
     if (options.host) {
       lookupAndListen(this, options.port | 0, options.host, backlog,
-                      options.exclusive, flags);
+                      exclusive, flags);
     } else { // Undefined host, listens on unspecified address
       // Default addressType 4 will be used to search for primary server
       listenInCluster(this, null, options.port | 0, 4,
-                      backlog, undefined, options.exclusive);
+                      backlog, undefined, exclusive,
+                      flags & TCPConstants.UV_TCP_REUSEPORT);
     }
     return this;
   }
@@ -1543,10 +1986,14 @@ function onconnection(err, clientHandle) {
     return;
   }
 
+  if (self[kIOThread] && clientHandle instanceof TCP)
+    clientHandle = moveToIOThread(clientHandle);
+
   const socket = new Socket({
     handle: clientHandle,
     allowHalfOpen: self.allowHalfOpen,
     pauseOnCreate: self.pauseOnConnect,
+    autoCork: self[kAutoCork],
     readable: true,
     writable: true
   });
@@ -1560,6 +2007,20 @@ function onconnection(err, clientHandle) {
 }
 
 
+// Hands the socket of `handle` over to the I/O thread of this thread. The
+// original handle is kept if its file descriptor cannot be duplicated, e.g.
+// on Windows.
+function moveToIOThread(handle) {
+  const fd = handle.dupFd();
+  if (fd < 0)
+    return handle;
+  if (IOThreadStream === undefined)
+    ({ IOThreadStream } = internalBinding('io_thread_stream'));
+  handle.close();
+  return new IOThreadStream(fd);
+}
+
+
 Server.prototype.getConnections = function(cb) {
   const self = this;
 
@@ -1755,6 +2216,15 @@ if (isWindows) {
   };
 }
 
+function getDefaultAutoSelectFamily() {
+  return autoSelectFamilyDefault;
+}
+
+function setDefaultAutoSelectFamily(value) {
+  validateBoolean(value, 'value');
+  autoSelectFamilyDefault = value;
+}
+
 module.exports = {
   _createServerHandle: createServerHandle,
   _normalizeArgs: normalizeArgs,
@@ -1767,10 +2237,12 @@ module.exports = {
   connect,
   createConnection: connect,
   createServer,
+  getDefaultAutoSelectFamily,
   isIP: isIP,
   isIPv4: isIPv4,
   isIPv6: isIPv6,
   Server,
   Socket,
+  setDefaultAutoSelectFamily,
   Stream: Socket, // Legacy naming
 };
@@ -38,14 +38,17 @@ const isWindows = process.platform === 'win32';
 
 const {
   codes: {
+    ERR_INVALID_ARG_TYPE,
     ERR_SYSTEM_ERROR
   },
   hideStackFrames
 } = require('internal/errors');
+const { isFloat64Array } = require('internal/util/types');
 const { validateInt32 } = require('internal/validators');
 
 const {
   getCPUs,
+  getCPUTimes: _getCPUTimes,
   getFreeMem,
   getHomeDirectory: _getHomeDirectory,
   getHostname: _getHostname,
@@ -123,6 +126,24 @@ function cpus() {
   return result;
 }
 
+function cpuTimes(times) {
+  if (times !== undefined && !isFloat64Array(times)) {
+    throw new ERR_INVALID_ARG_TYPE('times', 'Float64Array', times);
+  }
+  const ctx = {};
+  const count = _getCPUTimes(times, ctx);
+  if (count === undefined)
+    throw new ERR_SYSTEM_ERROR(ctx);
+  if (times !== undefined && times.length >= count * 5)
+    return times;
+  // The array is too small, which is expected on the first call. Later calls
+  // can reuse the returned one.
+  times = new Float64Array(count * 5);
+  if (_getCPUTimes(times, ctx) === undefined)
+    throw new ERR_SYSTEM_ERROR(ctx);
+  return times;
+}
+
 function arch() {
   return process.arch;
 }
@@ -280,6 +301,7 @@ function userInfo(options) {
 module.exports = {
   arch,
   cpus,
+  cpuTimes,
   endianness,
   freemem: getFreeMem,
   getPriority,
@@ -30,11 +30,15 @@ const {
 } = require('internal/perf/usertiming');
 
 const {
-  createHistogram
+  createHistogram,
+  decodeHistogram,
 } = require('internal/histogram');
 
 const eventLoopUtilization = require('internal/perf/event_loop_utilization');
 const monitorEventLoopDelay = require('internal/perf/event_loop_delay');
+const monitorEventLoopPhases = require('internal/perf/event_loop_phases');
+const monitorGC = require('internal/perf/gc');
+const monitorThreadpool = require('internal/perf/threadpool');
 const nodeTiming = require('internal/perf/nodetiming');
 const timerify = require('internal/perf/timerify');
 const { customInspectSymbol: kInspect } = require('internal/util');
@@ -113,7 +117,11 @@ module.exports = {
   PerformanceMark,
   PerformanceObserver,
   monitorEventLoopDelay,
+  monitorEventLoopPhases,
+  monitorGC,
+  monitorThreadpool,
   createHistogram,
+  decodeHistogram,
   performance: new InternalPerformance(),
 };
 
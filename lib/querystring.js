@@ -43,6 +43,11 @@ const {
   hexTable,
   isHexTable
 } = require('internal/querystring');
+const {
+  escapeQueryString,
+  parseQueryString,
+  unescapeQueryStringBuffer,
+} = internalBinding('url');
 const QueryString = module.exports = {
   unescapeBuffer,
   // `unescape()` is a JS global, so we need to use a different local name
@@ -76,8 +81,15 @@ const unhexTable = new Int8Array([
   -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
   -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // ... 255
 ]);
+
+// Shorter inputs are handled in JS, where they don't pay for the call into
+// C++.
+const kNativeMinLength = 64;
+
 // A safe fast alternative to decodeURIComponent
 function unescapeBuffer(s, decodeSpaces) {
+  if (s.length >= kNativeMinLength)
+    return unescapeQueryStringBuffer(s, !!decodeSpaces);
   const out = Buffer.allocUnsafe(s.length);
   let index = 0;
   let outIndex = 0;
@@ -155,6 +167,11 @@ function qsEscape(str) {
       str += '';
   }
 
+  if (str.length >= kNativeMinLength) {
+    const escaped = escapeQueryString(str);
+    if (escaped !== undefined)
+      return escaped;
+  }
   return encodeStr(str, noEscape, hexTable);
 }
 
@@ -297,6 +314,19 @@ function parse(qs, sep, eq, options) {
   }
   const customDecode = (decode !== qsUnescape);
 
+  if (qs.length >= kNativeMinLength && !customDecode &&
+      QueryString.unescapeBuffer === unescapeBuffer &&
+      sepLen === 1 && eqLen === 1 && sepCodes[0] < 0x80 &&
+      eqCodes[0] < 0x80 && sepCodes[0] !== eqCodes[0] &&
+      (pairs | 0) === pairs) {
+    const list = parseQueryString(qs, sepCodes[0], eqCodes[0], pairs);
+    if (list !== undefined) {
+      for (let i = 0; i < list.length; i += 2)
+        addKeyVal(obj, list[i], list[i + 1], false, false, decode);
+      return obj;
+    }
+  }
+
   let lastPos = 0;
   let sepIdx = 0;
   let eqIdx = 0;
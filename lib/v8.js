@@ -26,6 +26,7 @@ const {
   Int16Array,
   Int32Array,
   Int8Array,
+  JSONStringify,
   ObjectPrototypeToString,
   SafeMap,
   Uint16Array,
@@ -35,7 +36,17 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
-const { validateString } = require('internal/validators');
+const {
+  ERR_INVALID_ARG_TYPE,
+  ERR_OUT_OF_RANGE,
+} = require('internal/errors').codes;
+const { isArrayBufferView } = require('internal/util/types');
+const {
+  validateBoolean,
+  validateInteger,
+  validateObject,
+  validateString,
+} = require('internal/validators');
 const {
   Serializer,
   Deserializer
@@ -54,16 +65,76 @@ const { getValidatedPath } = require('internal/fs/utils');
 const { toNamespacedPath } = require('path');
 const {
   createHeapSnapshotStream,
+  getHeapProfile: _getHeapProfile,
+  getHeapProfileFilename,
+  startHeapProfile,
+  stopHeapProfile,
   triggerHeapSnapshot
 } = internalBinding('heap_utils');
 const { HeapSnapshotStream } = require('internal/heap_utils');
+const {
+  namespace: startupSnapshot
+} = require('internal/v8/startup_snapshot');
+
+function writeHeapSnapshot(filename, options = {}) {
+  if (filename !== undefined) {
+    filename = getValidatedPath(filename);
+    filename = toNamespacedPath(filename);
+  }
+  validateObject(options, 'options');
+  const { gzip = false } = options;
+  validateBoolean(gzip, 'options.gzip');
+  return triggerHeapSnapshot(filename, gzip);
+}
+
+// The default interval of V8, and of --heap-prof-interval.
+const kDefaultHeapProfileSamplingInterval = 512 * 1024;
+
+function getHeapProfile(options = {}) {
+  validateObject(options, 'options');
+  const {
+    samplingInterval = kDefaultHeapProfileSamplingInterval,
+  } = options;
+  validateInteger(samplingInterval, 'options.samplingInterval', 1);
+  return _getHeapProfile(samplingInterval);
+}
+
+const kDefaultHeapProfileDuration = 10 * 1000;
 
-function writeHeapSnapshot(filename) {
+// Samples the allocations for `duration` milliseconds and writes them to a
+// .heapprofile file, without the inspector.
+async function writeHeapProfile(filename, options = {}) {
+  if (typeof filename === 'object' && filename !== null) {
+    options = filename;
+    filename = undefined;
+  }
   if (filename !== undefined) {
     filename = getValidatedPath(filename);
     filename = toNamespacedPath(filename);
+  } else {
+    filename = getHeapProfileFilename();
   }
-  return triggerHeapSnapshot(filename);
+  validateObject(options, 'options');
+  const {
+    duration = kDefaultHeapProfileDuration,
+    samplingInterval = kDefaultHeapProfileSamplingInterval,
+  } = options;
+  validateInteger(duration, 'options.duration', 0);
+  validateInteger(samplingInterval, 'options.samplingInterval', 1);
+
+  const started = startHeapProfile(samplingInterval);
+  let profile;
+  try {
+    const { setTimeout } = require('timers/promises');
+    await setTimeout(duration);
+    profile = _getHeapProfile(samplingInterval);
+  } finally {
+    // Leave a profiler that was started by someone else running.
+    if (started)
+      stopHeapProfile();
+  }
+  await require('fs').promises.writeFile(filename, JSONStringify(profile));
+  return filename;
 }
 
 function getHeapSnapshot() {
@@ -78,6 +149,7 @@ const binding = internalBinding('v8');
 
 const {
   cachedDataVersionTag,
+  requestIdleGC,
   setFlagsFromString: _setFlagsFromString,
   updateHeapStatisticsBuffer,
   updateHeapSpaceStatisticsBuffer,
@@ -254,14 +326,51 @@ class DefaultDeserializer extends Deserializer {
   }
 }
 
-function serialize(value) {
+function validateArrayBufferView(value, name) {
+  if (!isArrayBufferView(value)) {
+    throw new ERR_INVALID_ARG_TYPE(name,
+                                   ['Buffer', 'TypedArray', 'DataView'],
+                                   value);
+  }
+}
+
+function serialize(value, options) {
   const ser = new DefaultSerializer();
+  let into;
+  let offset = 0;
+  if (options !== undefined) {
+    validateObject(options, 'options');
+    ({ into, offset = 0 } = options);
+    if (into !== undefined) {
+      validateArrayBufferView(into, 'options.into');
+      validateInteger(offset, 'options.offset', 0, into.byteLength);
+      ser._setTarget(into, offset);
+    }
+  }
   ser.writeHeader();
   ser.writeValue(value);
-  return ser.releaseBuffer();
+  if (into === undefined)
+    return ser.releaseBuffer();
+
+  const written = ser._releaseTarget();
+  if (written < 0) {
+    throw new ERR_OUT_OF_RANGE('options.into.byteLength',
+                               `>= ${offset - written}`,
+                               into.byteLength);
+  }
+  return written;
 }
 
-function deserialize(buffer) {
+function deserialize(buffer, options) {
+  if (options !== undefined) {
+    validateObject(options, 'options');
+    validateArrayBufferView(buffer, 'buffer');
+    const { offset = 0 } = options;
+    validateInteger(offset, 'options.offset', 0, buffer.byteLength);
+    const { length = buffer.byteLength - offset } = options;
+    validateInteger(length, 'options.length', 0, buffer.byteLength - offset);
+    buffer = new FastBuffer(buffer.buffer, buffer.byteOffset + offset, length);
+  }
   const der = new DefaultDeserializer(buffer);
   der.readHeader();
   return der.readValue();
@@ -269,10 +378,12 @@ function deserialize(buffer) {
 
 module.exports = {
   cachedDataVersionTag,
+  getHeapProfile,
   getHeapSnapshot,
   getHeapStatistics,
   getHeapSpaceStatistics,
   getHeapCodeStatistics,
+  requestIdleGC,
   setFlagsFromString,
   Serializer,
   Deserializer,
@@ -281,6 +392,9 @@ module.exports = {
   deserialize,
   takeCoverage: profiler.takeCoverage,
   stopCoverage: profiler.stopCoverage,
+  takeCpuProfile: profiler.takeCpuProfile,
   serialize,
+  writeHeapProfile,
   writeHeapSnapshot,
+  startupSnapshot,
 };
@@ -24,6 +24,8 @@
 const {
   ArrayPrototypeForEach,
   ArrayPrototypeUnshift,
+  Float64Array,
+  ObjectFreeze,
   Symbol,
   PromiseReject,
   ReflectApply,
@@ -37,6 +39,7 @@ const {
   constants,
   compileFunction: _compileFunction,
   measureMemory: _measureMemory,
+  getCompileCacheStatistics: _getCompileCacheStatistics,
 } = internalBinding('contextify');
 const {
   ERR_CONTEXT_NOT_INITIALIZED,
@@ -57,10 +60,16 @@ const {
 } = require('internal/validators');
 const {
   kVmBreakFirstLineSymbol,
+  kVmUseCodeCacheSymbol,
   emitExperimentalWarning,
 } = require('internal/util');
 const kParsingContext = Symbol('script parsing context');
 
+const vmConstants = ObjectFreeze({
+  __proto__: null,
+  DONT_CONTEXTIFY: Symbol('vm_dont_contextify'),
+});
+
 class Script extends ContextifyScript {
   constructor(code, options = {}) {
     code = `${code}`;
@@ -216,7 +225,8 @@ function isContext(object) {
 
 let defaultContextNameIndex = 1;
 function createContext(contextObject = {}, options = {}) {
-  if (isContext(contextObject)) {
+  const dontContextify = contextObject === vmConstants.DONT_CONTEXTIFY;
+  if (!dontContextify && isContext(contextObject)) {
     return contextObject;
   }
 
@@ -252,6 +262,11 @@ function createContext(contextObject = {}, options = {}) {
       microtaskQueue = new MicrotaskQueue();
   }
 
+  if (dontContextify) {
+    // The global proxy of the new context is returned in place of the
+    // contextified object.
+    return makeContext(undefined, name, origin, strings, wasm, microtaskQueue);
+  }
   makeContext(contextObject, name, origin, strings, wasm, microtaskQueue);
   return contextObject;
 }
@@ -325,6 +340,7 @@ function compileFunction(code, params, options = {}) {
     parsingContext = undefined,
     contextExtensions = [],
     importModuleDynamically,
+    [kVmUseCodeCacheSymbol]: useCodeCache = false,
   } = options;
 
   validateString(filename, 'options.filename');
@@ -361,7 +377,8 @@ function compileFunction(code, params, options = {}) {
     produceCachedData,
     parsingContext,
     contextExtensions,
-    params
+    params,
+    useCodeCache
   );
 
   if (produceCachedData) {
@@ -415,6 +432,19 @@ function measureMemory(options = {}) {
   return result;
 }
 
+const compileCacheStatistics = new Float64Array(5);
+
+function getCompileCacheStatistics() {
+  _getCompileCacheStatistics(compileCacheStatistics);
+  return {
+    hits: compileCacheStatistics[0],
+    misses: compileCacheStatistics[1],
+    rejections: compileCacheStatistics[2],
+    entries: compileCacheStatistics[3],
+    size: compileCacheStatistics[4],
+  };
+}
+
 module.exports = {
   Script,
   createContext,
@@ -425,6 +455,8 @@ module.exports = {
   isContext,
   compileFunction,
   measureMemory,
+  getCompileCacheStatistics,
+  constants: vmConstants,
 };
 
 if (require('internal/options').getOptionValue('--experimental-vm-modules')) {
@@ -87,7 +87,10 @@ class WASI {
     validateInt32(stderr, 'options.stderr', 0);
     const stdio = [stdin, stdout, stderr];
 
-    const wrap = new _WASI(args, env, preopens, stdio);
+    const { mapReadOnlyFiles = false } = options;
+    validateBoolean(mapReadOnlyFiles, 'options.mapReadOnlyFiles');
+
+    const wrap = new _WASI(args, env, preopens, stdio, mapReadOnlyFiles);
 
     for (const prop in wrap) {
       wrap[prop] = FunctionPrototypeBind(wrap[prop], wrap);
@@ -2,6 +2,7 @@
 
 const {
   isMainThread,
+  notifyMemoryPressure,
   SHARE_ENV,
   resourceLimits,
   threadId,
@@ -16,18 +17,34 @@ const {
   BroadcastChannel,
 } = require('internal/worker/io');
 
+const {
+  Pool,
+} = require('internal/worker/pool');
+
+const {
+  RingChannel,
+} = require('internal/worker/ring_channel');
+
+const {
+  ImmutableBuffer,
+} = require('internal/worker/immutable_buffer');
+
 const {
   markAsUntransferable,
 } = require('internal/buffer');
 
 module.exports = {
+  ImmutableBuffer,
   isMainThread,
   MessagePort,
   MessageChannel,
   markAsUntransferable,
   moveMessagePortToContext,
+  notifyMemoryPressure,
+  Pool,
   receiveMessageOnPort,
   resourceLimits,
+  RingChannel,
   threadId,
   SHARE_ENV,
   Worker,
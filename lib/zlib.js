@@ -71,6 +71,7 @@ const {
 const { owner_symbol } = require('internal/async_hooks').symbols;
 const {
   validateFunction,
+  validateUint32,
 } = require('internal/validators');
 
 const kFlushFlag = Symbol('kFlushFlag');
@@ -161,6 +162,70 @@ function zlibBufferOnEnd() {
     this.cb(null, buf);
 }
 
+const kMinParallelBlockSize = 32 * 1024;
+const kMaxParallelBlockSize = 2 ** 30;
+
+// Compresses `buffer` in blocks of `options.parallelBlockSize` bytes that are
+// compressed in parallel in the threadpool. Options that this does not support
+// fall back to a single stream.
+function zlibBufferParallel(ctor, mode, buffer, opts, callback) {
+  validateFunction(callback, 'callback');
+  const blockSize = checkRangesOrGetDefault(
+    opts.parallelBlockSize, 'options.parallelBlockSize',
+    kMinParallelBlockSize, kMaxParallelBlockSize);
+  if (typeof buffer === 'string') {
+    buffer = Buffer.from(buffer);
+  } else if (isArrayBufferView(buffer) &&
+             ObjectGetPrototypeOf(buffer) !== Buffer.prototype) {
+    buffer = Buffer.from(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+  } else if (isAnyArrayBuffer(buffer)) {
+    buffer = Buffer.from(buffer);
+  }
+  if (!isArrayBufferView(buffer) || buffer.length <= blockSize ||
+      opts.dictionary !== undefined || opts.info) {
+    return zlibBuffer(new ctor(opts), buffer, callback);
+  }
+
+  // Mirrors the validation of Zlib().
+  if (mode === DEFLATERAW && opts.windowBits === 8)
+    opts.windowBits = 9;
+  const windowBits = checkRangesOrGetDefault(
+    opts.windowBits, 'options.windowBits',
+    Z_MIN_WINDOWBITS + (mode === GZIP ? 1 : 0), Z_MAX_WINDOWBITS,
+    Z_DEFAULT_WINDOWBITS);
+  const level = checkRangesOrGetDefault(
+    opts.level, 'options.level',
+    Z_MIN_LEVEL, Z_MAX_LEVEL, Z_DEFAULT_COMPRESSION);
+  const memLevel = checkRangesOrGetDefault(
+    opts.memLevel, 'options.memLevel',
+    Z_MIN_MEMLEVEL, Z_MAX_MEMLEVEL, Z_DEFAULT_MEMLEVEL);
+  const strategy = checkRangesOrGetDefault(
+    opts.strategy, 'options.strategy',
+    Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
+  const maxOutputLength = checkRangesOrGetDefault(
+    opts.maxOutputLength, 'options.maxOutputLength',
+    1, kMaxLength, kMaxLength);
+
+  const handle = new binding.ParallelDeflate();
+  // Keeps the input alive while it is being compressed.
+  handle.buffer = buffer;
+  handle.oncomplete = (errno, message, result) => {
+    handle.buffer = null;
+    if (errno !== null) {
+      // eslint-disable-next-line no-restricted-syntax
+      const error = new Error(message);
+      error.errno = errno;
+      error.code = codes[errno];
+      return callback(error);
+    }
+    if (result.byteLength > maxOutputLength)
+      return callback(new ERR_BUFFER_TOO_LARGE(maxOutputLength));
+    callback(null, Buffer.from(result));
+  };
+  handle.start(mode, buffer, level, windowBits, memLevel, strategy,
+               blockSize);
+}
+
 function zlibBufferSync(engine, buffer) {
   if (typeof buffer === 'string') {
     buffer = Buffer.from(buffer);
@@ -614,6 +679,14 @@ const zlibDefaultOpts = {
   finishFlush: Z_FINISH,
   fullFlush: Z_FULL_FLUSH
 };
+
+// Writes of fewer bytes than `options.inlineThreshold` are processed on the
+// main thread, which is faster than a round trip through the threadpool for
+// them. This is opt-in because their output, e.g. the trailer of the final
+// flush, is then ready earlier than stream users are used to.
+const kDefaultInlineThreshold = 0;
+const kMaxUint32 = 2 ** 32 - 1;
+
 // Base class for all streams actually backed by zlib and using zlib-specific
 // parameters.
 function Zlib(opts, mode) {
@@ -621,6 +694,7 @@ function Zlib(opts, mode) {
   let level = Z_DEFAULT_COMPRESSION;
   let memLevel = Z_DEFAULT_MEMLEVEL;
   let strategy = Z_DEFAULT_STRATEGY;
+  let inlineThreshold = kDefaultInlineThreshold;
   let dictionary;
 
   if (opts) {
@@ -652,6 +726,10 @@ function Zlib(opts, mode) {
       opts.strategy, 'options.strategy',
       Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
 
+    inlineThreshold = checkRangesOrGetDefault(
+      opts.inlineThreshold, 'options.inlineThreshold',
+      0, kMaxUint32, kDefaultInlineThreshold);
+
     dictionary = opts.dictionary;
     if (dictionary !== undefined && !isArrayBufferView(dictionary)) {
       if (isAnyArrayBuffer(dictionary)) {
@@ -678,6 +756,7 @@ function Zlib(opts, mode) {
               this._writeState,
               processCallback,
               dictionary);
+  handle.setInlineThreshold(inlineThreshold);
 
   ReflectApply(ZlibBase, this, [opts, mode, handle, zlibDefaultOpts]);
 
@@ -773,7 +852,9 @@ function Unzip(opts) {
 ObjectSetPrototypeOf(Unzip.prototype, Zlib.prototype);
 ObjectSetPrototypeOf(Unzip, Zlib);
 
-function createConvenienceMethod(ctor, sync) {
+// `parallelMode` is the mode of the compressors that support
+// `options.parallelBlockSize`.
+function createConvenienceMethod(ctor, sync, parallelMode) {
   if (sync) {
     return function syncBufferWrapper(buffer, opts) {
       return zlibBufferSync(new ctor(opts), buffer);
@@ -784,6 +865,8 @@ function createConvenienceMethod(ctor, sync) {
       callback = opts;
       opts = {};
     }
+    if (parallelMode !== undefined && opts?.parallelBlockSize !== undefined)
+      return zlibBufferParallel(ctor, parallelMode, buffer, opts, callback);
     return zlibBuffer(new ctor(opts), buffer, callback);
   };
 }
@@ -875,6 +958,28 @@ ObjectDefineProperty(binding.Zlib.prototype, 'jsref', {
   set(v) { return this[owner_symbol] = v; }
 });
 
+function crc32(data, value = 0) {
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE('data',
+                                   ['Buffer', 'TypedArray', 'DataView',
+                                    'string'],
+                                   data);
+  }
+  validateUint32(value, 'value');
+  return binding.crc32(data, value);
+}
+
+function adler32(data, value = 1) {
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new ERR_INVALID_ARG_TYPE('data',
+                                   ['Buffer', 'TypedArray', 'DataView',
+                                    'string'],
+                                   data);
+  }
+  validateUint32(value, 'value');
+  return binding.adler32(data, value);
+}
+
 module.exports = {
   Deflate,
   Inflate,
@@ -888,11 +993,11 @@ module.exports = {
 
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
-  deflate: createConvenienceMethod(Deflate, false),
+  deflate: createConvenienceMethod(Deflate, false, DEFLATE),
   deflateSync: createConvenienceMethod(Deflate, true),
-  gzip: createConvenienceMethod(Gzip, false),
+  gzip: createConvenienceMethod(Gzip, false, GZIP),
   gzipSync: createConvenienceMethod(Gzip, true),
-  deflateRaw: createConvenienceMethod(DeflateRaw, false),
+  deflateRaw: createConvenienceMethod(DeflateRaw, false, DEFLATERAW),
   deflateRawSync: createConvenienceMethod(DeflateRaw, true),
   unzip: createConvenienceMethod(Unzip, false),
   unzipSync: createConvenienceMethod(Unzip, true),
@@ -906,6 +1011,9 @@ module.exports = {
   brotliCompressSync: createConvenienceMethod(BrotliCompress, true),
   brotliDecompress: createConvenienceMethod(BrotliDecompress, false),
   brotliDecompressSync: createConvenienceMethod(BrotliDecompress, true),
+
+  crc32,
+  adler32,
 };
 
 ObjectDefineProperties(module.exports, {
@@ -107,6 +107,7 @@
       'lib/internal/assert.js',
       'lib/internal/assert/assertion_error.js',
       'lib/internal/assert/calltracker.js',
+      'lib/internal/async_context_frame.js',
       'lib/internal/async_hooks.js',
       'lib/internal/blob.js',
       'lib/internal/blocklist.js',
@@ -167,12 +168,14 @@
       'lib/internal/histogram.js',
       'lib/internal/idna.js',
       'lib/internal/inspector_async_hook.js',
+      'lib/internal/inspector_network_tracking.js',
       'lib/internal/js_stream_socket.js',
       'lib/internal/linkedlist.js',
       'lib/internal/main/check_syntax.js',
       'lib/internal/main/eval_string.js',
       'lib/internal/main/eval_stdin.js',
       'lib/internal/main/inspect.js',
+      'lib/internal/main/mksnapshot.js',
       'lib/internal/main/print_help.js',
       'lib/internal/main/prof_process.js',
       'lib/internal/main/repl.js',
@@ -198,7 +201,10 @@
       'lib/internal/perf/usertiming.js',
       'lib/internal/perf/observe.js',
       'lib/internal/perf/event_loop_delay.js',
+      'lib/internal/perf/event_loop_phases.js',
+      'lib/internal/perf/gc.js',
       'lib/internal/perf/event_loop_utilization.js',
+      'lib/internal/perf/threadpool.js',
       'lib/internal/perf/timerify.js',
       'lib/internal/policy/manifest.js',
       'lib/internal/policy/sri.js',
@@ -212,6 +218,7 @@
       'lib/internal/process/worker_thread_only.js',
       'lib/internal/process/report.js',
       'lib/internal/process/signal.js',
+      'lib/internal/process/stdio_coalescing.js',
       'lib/internal/process/task_queues.js',
       'lib/internal/querystring.js',
       'lib/internal/readline/utils.js',
@@ -224,6 +231,7 @@
       'lib/internal/source_map/source_map.js',
       'lib/internal/source_map/source_map_cache.js',
       'lib/internal/test/binding.js',
+      'lib/internal/timer_wheel.js',
       'lib/internal/timers.js',
       'lib/internal/tls.js',
       'lib/internal/trace_events_async_hooks.js',
@@ -239,14 +247,18 @@
       'lib/internal/http2/core.js',
       'lib/internal/http2/compat.js',
       'lib/internal/http2/util.js',
+      'lib/internal/v8/startup_snapshot.js',
       'lib/internal/v8_prof_polyfill.js',
       'lib/internal/v8_prof_processor.js',
       'lib/internal/validators.js',
       'lib/internal/stream_base_commons.js',
       'lib/internal/vm/module.js',
       'lib/internal/worker.js',
+      'lib/internal/worker/immutable_buffer.js',
       'lib/internal/worker/io.js',
       'lib/internal/worker/js_transferable.js',
+      'lib/internal/worker/pool.js',
+      'lib/internal/worker/ring_channel.js',
       'lib/internal/watchdog.js',
       'lib/internal/streams/lazy_transform.js',
       'lib/internal/streams/add-abort-signal.js',
@@ -591,8 +603,11 @@
         'src/api/exceptions.cc',
         'src/api/hooks.cc',
         'src/api/utils.cc',
+        'src/async_context_frame.cc',
         'src/async_wrap.cc',
+        'src/base64.cc',
         'src/cares_wrap.cc',
+        'src/compile_cache.cc',
         'src/connect_wrap.cc',
         'src/connection_wrap.cc',
         'src/debug_utils.cc',
@@ -601,6 +616,7 @@
         'src/handle_wrap.cc',
         'src/heap_utils.cc',
         'src/histogram.cc',
+        'src/io_thread_stream.cc',
         'src/js_native_api.h',
         'src/js_native_api_types.h',
         'src/js_native_api_v8.cc',
@@ -619,6 +635,7 @@
         'src/node_constants.cc',
         'src/node_contextify.cc',
         'src/node_credentials.cc',
+        'src/node_diagnostics_channel.cc',
         'src/node_dir.cc',
         'src/node_env_var.cc',
         'src/node_errors.cc',
@@ -627,6 +644,7 @@
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
+        'src/node_immutable_buffer.cc',
         'src/node_main_instance.cc',
         'src/node_messaging.cc',
         'src/node_metadata.cc',
@@ -685,6 +703,7 @@
         'src/aliased_struct-inl.h',
         'src/allocated_buffer.h',
         'src/allocated_buffer-inl.h',
+        'src/async_context_frame.h',
         'src/async_wrap.h',
         'src/async_wrap-inl.h',
         'src/base_object.h',
@@ -693,6 +712,7 @@
         'src/base64-inl.h',
         'src/callback_queue.h',
         'src/callback_queue-inl.h',
+        'src/compile_cache.h',
         'src/connect_wrap.h',
         'src/connection_wrap.h',
         'src/debug_utils.h',
@@ -702,9 +722,11 @@
         'src/handle_wrap.h',
         'src/histogram.h',
         'src/histogram-inl.h',
+        'src/io_thread_stream.h',
         'src/js_stream.h',
         'src/json_utils.h',
         'src/large_pages/node_large_page.cc',
+        'src/large_pages/node_large_page_allocator.cc',
         'src/large_pages/node_large_page.h',
         'src/memory_tracker.h',
         'src/memory_tracker-inl.h',
@@ -718,6 +740,7 @@
         'src/node_constants.h',
         'src/node_context_data.h',
         'src/node_contextify.h',
+        'src/node_diagnostics_channel.h',
         'src/node_dir.h',
         'src/node_errors.h',
         'src/node_external_reference.h',
@@ -728,6 +751,7 @@
         'src/node_http2.h',
         'src/node_http2_state.h',
         'src/node_i18n.h',
+        'src/node_immutable_buffer.h',
         'src/node_internals.h',
         'src/node_main_instance.h',
         'src/node_mem.h',
@@ -949,6 +973,8 @@
             'src/crypto/crypto_keys.cc',
             'src/crypto/crypto_keygen.cc',
             'src/crypto/crypto_scrypt.cc',
+            'src/crypto/crypto_session_store.cc',
+            'src/crypto/crypto_async_key.cc',
             'src/crypto/crypto_tls.cc',
             'src/crypto/crypto_aes.cc',
             'src/crypto/crypto_x509.cc',
@@ -967,6 +993,8 @@
             'src/crypto/crypto_keys.h',
             'src/crypto/crypto_keygen.h',
             'src/crypto/crypto_scrypt.h',
+            'src/crypto/crypto_session_store.h',
+            'src/crypto/crypto_async_key.h',
             'src/crypto/crypto_tls.h',
             'src/crypto/crypto_clienthello.h',
             'src/crypto/crypto_context.h',
@@ -1331,6 +1359,7 @@
         'test/cctest/test_node_postmortem_metadata.cc',
         'test/cctest/test_environment.cc',
         'test/cctest/test_linked_binding.cc',
+        'test/cctest/test_node_mem.cc',
         'test/cctest/test_per_process.cc',
         'test/cctest/test_platform.cc',
         'test/cctest/test_json_utils.cc',
@@ -1548,8 +1577,6 @@
         'src/node_snapshot_stub.cc',
         'src/node_code_cache_stub.cc',
         'tools/snapshot/node_mksnapshot.cc',
-        'tools/snapshot/snapshot_builder.cc',
-        'tools/snapshot/snapshot_builder.h',
       ],
 
       'conditions': [
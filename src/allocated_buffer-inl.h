@@ -101,6 +101,15 @@ v8::MaybeLocal<v8::Object> AllocatedBuffer::ToBuffer() {
       .FromMaybe(v8::Local<v8::Uint8Array>());
 }
 
+v8::MaybeLocal<v8::Object> AllocatedBuffer::ToPooledBuffer() {
+  if (size() > 0 && size() < BufferPool::kMaxPoolAllocation) {
+    v8::MaybeLocal<v8::Object> ret = env_->buffer_pool()->Copy(data(), size());
+    clear();
+    return ret;
+  }
+  return ToBuffer();
+}
+
 v8::Local<v8::ArrayBuffer> AllocatedBuffer::ToArrayBuffer() {
   return v8::ArrayBuffer::New(env_->isolate(), std::move(backing_store_));
 }
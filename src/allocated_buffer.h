@@ -52,6 +52,10 @@ struct AllocatedBuffer {
   inline void clear();
 
   inline v8::MaybeLocal<v8::Object> ToBuffer();
+  // Small buffers are copied into the Environment's BufferPool, so the
+  // result may be a slice of a larger ArrayBuffer that other Buffers share
+  // and that cannot be transferred. Only for data that is not secret.
+  inline v8::MaybeLocal<v8::Object> ToPooledBuffer();
   inline v8::Local<v8::ArrayBuffer> ToArrayBuffer();
 
   AllocatedBuffer(AllocatedBuffer&& other) = default;
@@ -66,6 +70,33 @@ struct AllocatedBuffer {
   friend class Environment;
 };
 
+// Small Buffers that are created from native code are carved out of slabs
+// that are shared by all of an Environment, in the same way Buffer.from() and
+// Buffer.allocUnsafe() use a pool in JS, so that they do not each need an
+// ArrayBuffer and BackingStore of their own.
+class BufferPool : public MemoryRetainer {
+ public:
+  explicit BufferPool(Environment* env) : env_(env) {}
+
+  // Copies `length` bytes from `data` into the pool. `length` must be less
+  // than kMaxPoolAllocation.
+  v8::MaybeLocal<v8::Object> Copy(const char* data, size_t length);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(BufferPool)
+  SET_SELF_SIZE(BufferPool)
+
+  // The same sizes as Buffer.poolSize and its allocation limit in JS.
+  static constexpr size_t kSlabSize = 8 * 1024;
+  static constexpr size_t kMaxPoolAllocation = kSlabSize / 2;
+
+ private:
+  Environment* env_;
+  v8::Global<v8::ArrayBuffer> array_buffer_;
+  char* data_ = nullptr;
+  size_t used_ = 0;
+};
+
 }  // namespace node
 
 #endif  // NODE_WANT_INTERNALS
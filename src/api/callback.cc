@@ -37,25 +37,35 @@ InternalCallbackScope::InternalCallbackScope(AsyncWrap* async_wrap, int flags)
                             async_wrap->object(),
                             { async_wrap->get_async_id(),
                               async_wrap->get_trigger_async_id() },
-                            flags) {}
+                            flags,
+                            async_wrap->context_frame()) {}
 
 InternalCallbackScope::InternalCallbackScope(Environment* env,
                                              Local<Object> object,
                                              const async_context& asyncContext,
-                                             int flags)
+                                             int flags,
+                                             Local<Value> context_frame)
   : env_(env),
     async_context_(asyncContext),
     object_(object),
     skip_hooks_(flags & kSkipAsyncHooks),
-    skip_task_queues_(flags & kSkipTaskQueues) {
+    skip_task_queues_(flags & kSkipTaskQueues),
+    no_task_queue_deferral_(flags & kNoTaskQueueDeferral) {
   CHECK_NOT_NULL(env);
   env->PushAsyncCallbackScope();
+  env->CountEventLoopCallback();
 
   if (!env->can_call_into_js()) {
     failed_ = true;
     return;
   }
 
+  // This is the caller's HandleScope, which outlives the callback scope.
+  if (!context_frame.IsEmpty()) {
+    prior_context_frame_ = env->async_context_frame();
+    env->set_async_context_frame(context_frame);
+  }
+
   HandleScope handle_scope(env->isolate());
   // If you hit this assertion, you forgot to enter the v8::Context first.
   CHECK_EQ(Environment::GetCurrent(env->isolate()), env);
@@ -81,6 +91,9 @@ void InternalCallbackScope::Close() {
   if (closed_) return;
   closed_ = true;
 
+  if (!prior_context_frame_.IsEmpty())
+    env_->set_async_context_frame(prior_context_frame_);
+
   if (!env_->can_call_into_js()) return;
   auto perform_stopping_check = [&]() {
     if (env_->is_stopping()) {
@@ -103,6 +116,9 @@ void InternalCallbackScope::Close() {
     return;
   }
 
+  if (!no_task_queue_deferral_ && env_->DeferTaskQueues())
+    return;
+
   TickInfo* tick_info = env_->tick_info();
 
   if (!env_->can_call_into_js()) return;
@@ -149,7 +165,8 @@ MaybeLocal<Value> InternalMakeCallback(Environment* env,
                                        const Local<Function> callback,
                                        int argc,
                                        Local<Value> argv[],
-                                       async_context asyncContext) {
+                                       async_context asyncContext,
+                                       Local<Value> context_frame) {
   CHECK(!recv.IsEmpty());
 #ifdef DEBUG
   for (int i = 0; i < argc; i++)
@@ -170,7 +187,8 @@ MaybeLocal<Value> InternalMakeCallback(Environment* env,
         async_hooks->fields()[AsyncHooks::kUsesExecutionAsyncResource] > 0;
   }
 
-  InternalCallbackScope scope(env, resource, asyncContext, flags);
+  InternalCallbackScope scope(
+      env, resource, asyncContext, flags, context_frame);
   if (scope.Failed()) {
     return MaybeLocal<Value>();
   }
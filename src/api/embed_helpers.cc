@@ -14,6 +14,33 @@ using v8::SealHandleScope;
 
 namespace node {
 
+namespace {
+// Runs the loop like uv_run(UV_RUN_DEFAULT) does. With --event-loop-busy-poll,
+// each time the loop wakes up it keeps polling for I/O without blocking for
+// that many microseconds before it blocks again, so that events arriving in
+// that time are handled without waiting for the thread to be woken up.
+void RunEventLoop(Environment* env) {
+  uv_loop_t* loop = env->event_loop();
+  env->set_running_event_loop(true);
+  auto running = OnScopeLeave([&]() { env->set_running_event_loop(false); });
+  const uint64_t busy_poll_ns = env->options()->event_loop_busy_poll * 1000;
+  if (busy_poll_ns == 0) {
+    uv_run(loop, UV_RUN_DEFAULT);
+    return;
+  }
+
+  while (!env->is_stopping()) {
+    const uint64_t deadline = uv_hrtime() + busy_poll_ns;
+    int alive;
+    do {
+      alive = uv_run(loop, UV_RUN_NOWAIT);
+    } while (alive != 0 && !env->is_stopping() && uv_hrtime() < deadline);
+    if (alive == 0 || env->is_stopping()) return;
+    if (uv_run(loop, UV_RUN_ONCE) == 0) return;
+  }
+}
+}  // anonymous namespace
+
 Maybe<int> SpinEventLoop(Environment* env) {
   CHECK_NOT_NULL(env);
   MultiIsolatePlatform* platform = GetMultiIsolatePlatform(env);
@@ -32,7 +59,7 @@ Maybe<int> SpinEventLoop(Environment* env) {
         node::performance::NODE_PERFORMANCE_MILESTONE_LOOP_START);
     do {
       if (env->is_stopping()) break;
-      uv_run(env->event_loop(), UV_RUN_DEFAULT);
+      RunEventLoop(env);
       if (env->is_stopping()) break;
 
       platform->DrainTasks(env->isolate());
@@ -1,3 +1,4 @@
+#include "large_pages/node_large_page.h"
 #include "node.h"
 #include "node_context_data.h"
 #include "node_errors.h"
@@ -83,28 +84,42 @@ void* NodeArrayBufferAllocator::Allocate(size_t size) {
     ret = UncheckedCalloc(size);
   else
     ret = UncheckedMalloc(size);
-  if (LIKELY(ret != nullptr))
+  if (LIKELY(ret != nullptr)) {
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
+    if (UNLIKELY(size >= kLargePageSize))
+      AdviseLargePages(ret, size);
+  }
   return ret;
 }
 
 void* NodeArrayBufferAllocator::AllocateUninitialized(size_t size) {
   void* ret = node::UncheckedMalloc(size);
-  if (LIKELY(ret != nullptr))
+  if (LIKELY(ret != nullptr)) {
     total_mem_usage_.fetch_add(size, std::memory_order_relaxed);
+    if (UNLIKELY(size >= kLargePageSize))
+      AdviseLargePages(ret, size);
+  }
   return ret;
 }
 
 void* NodeArrayBufferAllocator::Reallocate(
     void* data, size_t old_size, size_t size) {
+  if (UNLIKELY(old_size >= kLargePageSize))
+    ForgetLargePages(data, old_size);
   void* ret = UncheckedRealloc<char>(static_cast<char*>(data), size);
   if (LIKELY(ret != nullptr) || UNLIKELY(size == 0))
     total_mem_usage_.fetch_add(size - old_size, std::memory_order_relaxed);
+  if (UNLIKELY(ret == nullptr && size != 0 && old_size >= kLargePageSize))
+    AdviseLargePages(data, old_size);
+  else if (UNLIKELY(ret != nullptr && size >= kLargePageSize))
+    AdviseLargePages(ret, size);
   return ret;
 }
 
 void NodeArrayBufferAllocator::Free(void* data, size_t size) {
   total_mem_usage_.fetch_sub(size, std::memory_order_relaxed);
+  if (UNLIKELY(size >= kLargePageSize))
+    ForgetLargePages(data, size);
   free(data);
 }
 
@@ -185,9 +200,275 @@ void DebuggingArrayBufferAllocator::RegisterPointerInternal(void* data,
   allocations_[data] = size;
 }
 
+namespace {
+using SizeClassStatistics = PoolingArrayBufferAllocator::SizeClassStatistics;
+
+constexpr size_t kSizeClassStep = PoolingArrayBufferAllocator::kSizeClassStep;
+constexpr size_t kSizeClassCount =
+    PoolingArrayBufferAllocator::kSizeClassCount;
+// The most memory that the free lists of one size class keep, per thread and
+// in the shared list.
+constexpr size_t kLocalFreeListBytes = 32 * 1024;
+constexpr size_t kSharedFreeListBytes = 1024 * 1024;
+// How often the blocks that were not needed are dropped from the shared lists.
+constexpr uint64_t kTrimIntervalNs = 1000 * 1000 * 1000;
+constexpr uint32_t kPoolBlockMagic = 0x6e626170;
+
+// Precedes each pooled block, so that Free() can check its size class. It
+// keeps the blocks as aligned as malloc() does.
+struct alignas(16) PoolBlockHeader {
+  uint32_t magic;
+  uint32_t size_class;
+};
+
+inline bool IsPooledSize(size_t size) {
+  return size >= PoolingArrayBufferAllocator::kMinPooledSize &&
+         size <= PoolingArrayBufferAllocator::kMaxPooledSize;
+}
+
+inline size_t SizeClassOf(size_t size) {
+  return (size - 1) / kSizeClassStep;
+}
+
+inline size_t SizeClassSize(size_t size_class) {
+  return (size_class + 1) * kSizeClassStep;
+}
+
+inline size_t LocalCapacity(size_t size_class) {
+  return std::max<size_t>(2, kLocalFreeListBytes / SizeClassSize(size_class));
+}
+
+inline size_t SharedCapacity(size_t size_class) {
+  return kSharedFreeListBytes / SizeClassSize(size_class);
+}
+
+inline void* BlockData(PoolBlockHeader* header) {
+  return header + 1;
+}
+
+inline PoolBlockHeader* BlockHeader(void* data) {
+  PoolBlockHeader* header = static_cast<PoolBlockHeader*>(data) - 1;
+  CHECK_EQ(header->magic, kPoolBlockMagic);
+  return header;
+}
+
+struct SharedFreeList {
+  Mutex mutex;
+  std::vector<PoolBlockHeader*> blocks;
+  // The fewest blocks that the list held since it was last trimmed. They
+  // were not needed in that time, so they are the ones that are dropped.
+  size_t low_water = 0;
+  std::atomic<uint64_t> allocations {0};
+  std::atomic<uint64_t> reused {0};
+};
+
+// The lists are never destroyed, since threads may still free blocks while
+// the process exits.
+SharedFreeList* GetSharedFreeLists() {
+  static SharedFreeList* lists = new SharedFreeList[kSizeClassCount];
+  return lists;
+}
+
+std::atomic<uint64_t> last_trim {0};
+
+// Drops the blocks that were not needed since the previous trim, once every
+// kTrimIntervalNs. It is only called when blocks move between the lists.
+void MaybeTrimSharedFreeLists() {
+  uint64_t now = uv_hrtime();
+  uint64_t last = last_trim.load(std::memory_order_relaxed);
+  if (now - last < kTrimIntervalNs ||
+      !last_trim.compare_exchange_strong(last, now)) {
+    return;
+  }
+  SharedFreeList* lists = GetSharedFreeLists();
+  for (size_t n = 0; n < kSizeClassCount; n++) {
+    Mutex::ScopedLock lock(lists[n].mutex);
+    std::vector<PoolBlockHeader*>& blocks = lists[n].blocks;
+    for (size_t i = 0; i < lists[n].low_water; i++) {
+      free(blocks.back());
+      blocks.pop_back();
+    }
+    lists[n].low_water = blocks.size();
+  }
+}
+
+// Moves blocks from the local list to the shared one, or frees them if the
+// shared list is full.
+void ReleaseBlocks(size_t size_class,
+                   std::vector<PoolBlockHeader*>* local,
+                   size_t count) {
+  {
+    SharedFreeList& shared = GetSharedFreeLists()[size_class];
+    Mutex::ScopedLock lock(shared.mutex);
+    size_t capacity = SharedCapacity(size_class);
+    for (; count > 0 && !local->empty(); count--) {
+      if (shared.blocks.size() < capacity)
+        shared.blocks.push_back(local->back());
+      else
+        free(local->back());
+      local->pop_back();
+    }
+  }
+  MaybeTrimSharedFreeLists();
+}
+
+// Moves up to count blocks from the shared list to the local one.
+void AcquireBlocks(size_t size_class,
+                   std::vector<PoolBlockHeader*>* local,
+                   size_t count) {
+  {
+    SharedFreeList& shared = GetSharedFreeLists()[size_class];
+    Mutex::ScopedLock lock(shared.mutex);
+    for (; count > 0 && !shared.blocks.empty(); count--) {
+      local->push_back(shared.blocks.back());
+      shared.blocks.pop_back();
+    }
+    shared.low_water = std::min(shared.low_water, shared.blocks.size());
+  }
+  MaybeTrimSharedFreeLists();
+}
+
+thread_local bool local_free_lists_destroyed = false;
+
+struct LocalFreeLists {
+  ~LocalFreeLists() {
+    for (size_t n = 0; n < kSizeClassCount; n++)
+      ReleaseBlocks(n, &blocks[n], blocks[n].size());
+    local_free_lists_destroyed = true;
+  }
+
+  std::vector<PoolBlockHeader*> blocks[kSizeClassCount];
+};
+
+// Returns nullptr once the lists of the thread are gone, while it exits.
+LocalFreeLists* GetLocalFreeLists() {
+  if (local_free_lists_destroyed)
+    return nullptr;
+  thread_local LocalFreeLists lists;
+  return &lists;
+}
+}  // anonymous namespace
+
+void* PoolingArrayBufferAllocator::AllocatePooled(size_t size, bool zero_fill) {
+  size_t size_class = SizeClassOf(size);
+  SharedFreeList& shared = GetSharedFreeLists()[size_class];
+  PoolBlockHeader* header = nullptr;
+
+  std::vector<PoolBlockHeader*> fallback;
+  LocalFreeLists* local_lists = GetLocalFreeLists();
+  std::vector<PoolBlockHeader*>* local =
+      local_lists != nullptr ? &local_lists->blocks[size_class] : &fallback;
+  if (local->empty())
+    AcquireBlocks(size_class, local, (LocalCapacity(size_class) + 1) / 2);
+  if (!local->empty()) {
+    header = local->back();
+    local->pop_back();
+    shared.reused.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    header = reinterpret_cast<PoolBlockHeader*>(
+        UncheckedMalloc(sizeof(PoolBlockHeader) + SizeClassSize(size_class)));
+    if (UNLIKELY(header == nullptr))
+      return nullptr;
+    header->magic = kPoolBlockMagic;
+    header->size_class = size_class;
+  }
+  if (!fallback.empty())
+    ReleaseBlocks(size_class, &fallback, fallback.size());
+  shared.allocations.fetch_add(1, std::memory_order_relaxed);
+
+  void* data = BlockData(header);
+  if (zero_fill)
+    memset(data, 0, size);
+  NodeArrayBufferAllocator::RegisterPointer(data, size);
+  return data;
+}
+
+void* PoolingArrayBufferAllocator::Allocate(size_t size) {
+  if (!IsPooledSize(size))
+    return NodeArrayBufferAllocator::Allocate(size);
+  return AllocatePooled(
+      size,
+      *zero_fill_field() || per_process::cli_options->zero_fill_all_buffers);
+}
+
+void* PoolingArrayBufferAllocator::AllocateUninitialized(size_t size) {
+  if (!IsPooledSize(size))
+    return NodeArrayBufferAllocator::AllocateUninitialized(size);
+  return AllocatePooled(size, false);
+}
+
+void PoolingArrayBufferAllocator::Free(void* data, size_t size) {
+  if (!IsPooledSize(size))
+    return NodeArrayBufferAllocator::Free(data, size);
+
+  NodeArrayBufferAllocator::UnregisterPointer(data, size);
+  PoolBlockHeader* header = BlockHeader(data);
+  size_t size_class = header->size_class;
+  CHECK_EQ(size_class, SizeClassOf(size));
+
+  LocalFreeLists* local_lists = GetLocalFreeLists();
+  if (local_lists == nullptr) {
+    std::vector<PoolBlockHeader*> blocks { header };
+    return ReleaseBlocks(size_class, &blocks, 1);
+  }
+  std::vector<PoolBlockHeader*>* local = &local_lists->blocks[size_class];
+  local->push_back(header);
+  size_t capacity = LocalCapacity(size_class);
+  if (local->size() > capacity)
+    ReleaseBlocks(size_class, local, local->size() - capacity / 2);
+}
+
+void* PoolingArrayBufferAllocator::Reallocate(
+    void* data, size_t old_size, size_t size) {
+  if (!IsPooledSize(old_size) && !IsPooledSize(size))
+    return NodeArrayBufferAllocator::Reallocate(data, old_size, size);
+
+  if (size == 0) {
+    Free(data, old_size);
+    return nullptr;
+  }
+  // V8 expects the bytes past `old_size` to be zero. Pooled blocks may still
+  // hold the contents of a buffer that was freed before.
+  if (IsPooledSize(old_size) && IsPooledSize(size) &&
+      SizeClassOf(old_size) == SizeClassOf(size)) {
+    NodeArrayBufferAllocator::UnregisterPointer(data, old_size);
+    NodeArrayBufferAllocator::RegisterPointer(data, size);
+    if (size > old_size)
+      memset(static_cast<char*>(data) + old_size, 0, size - old_size);
+    return data;
+  }
+  void* ret = AllocateUninitialized(size);
+  if (UNLIKELY(ret == nullptr))
+    return nullptr;
+  if (data != nullptr) {
+    memcpy(ret, data, std::min(old_size, size));
+    Free(data, old_size);
+  }
+  if (size > old_size)
+    memset(static_cast<char*>(ret) + old_size, 0, size - old_size);
+  return ret;
+}
+
+std::vector<SizeClassStatistics> PoolingArrayBufferAllocator::GetStatistics() {
+  std::vector<SizeClassStatistics> statistics;
+  SharedFreeList* lists = GetSharedFreeLists();
+  for (size_t n = 0; n < kSizeClassCount; n++) {
+    Mutex::ScopedLock lock(lists[n].mutex);
+    statistics.push_back(SizeClassStatistics {
+      SizeClassSize(n),
+      lists[n].allocations.load(std::memory_order_relaxed),
+      lists[n].reused.load(std::memory_order_relaxed),
+      lists[n].blocks.size()
+    });
+  }
+  return statistics;
+}
+
 std::unique_ptr<ArrayBufferAllocator> ArrayBufferAllocator::Create(bool debug) {
   if (debug || per_process::cli_options->debug_arraybuffer_allocations)
     return std::make_unique<DebuggingArrayBufferAllocator>();
+  else if (per_process::cli_options->pool_array_buffers)
+    return std::make_unique<PoolingArrayBufferAllocator>();
   else
     return std::make_unique<NodeArrayBufferAllocator>();
 }
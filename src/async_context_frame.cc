@@ -0,0 +1,104 @@
+#include "async_context_frame.h"
+#include "env-inl.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8.h"
+
+namespace node {
+namespace async_context_frame {
+
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Object;
+using v8::Promise;
+using v8::PromiseHookType;
+using v8::Value;
+
+void RunPromiseHook(Environment* env,
+                    PromiseHookType type,
+                    Local<Promise> promise) {
+  switch (type) {
+    case PromiseHookType::kInit: {
+      // Most promises are created outside of any frame, and there is
+      // nothing to restore for them.
+      Local<Value> frame = env->async_context_frame();
+      if (!frame->IsUndefined()) {
+        USE(promise->SetPrivate(env->context(),
+                                env->async_context_frame_private_symbol(),
+                                frame));
+      }
+      break;
+    }
+    case PromiseHookType::kBefore: {
+      Local<Value> frame;
+      if (promise->GetPrivate(env->context(),
+                              env->async_context_frame_private_symbol())
+              .ToLocal(&frame)) {
+        env->set_async_context_frame(frame);
+      }
+      break;
+    }
+    case PromiseHookType::kAfter:
+      // Promise reactions only run from a microtask checkpoint, which does
+      // not nest and which is outside of the callbacks that enter a frame,
+      // so there is no frame to go back to.
+      env->set_async_context_frame(Undefined(env->isolate()));
+      break;
+    case PromiseHookType::kResolve:
+      break;
+  }
+}
+
+void PromiseHook(PromiseHookType type,
+                 Local<Promise> promise,
+                 Local<Value> parent) {
+  Environment* env = Environment::GetCurrent(promise->CreationContext());
+  if (env == nullptr) return;
+  RunPromiseHook(env, type, promise);
+}
+
+namespace {
+
+void GetContextFrame(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(env->async_context_frame());
+}
+
+void SetContextFrame(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->set_async_context_frame(args[0]);
+}
+
+void SetupPromiseHook(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(env->async_context_frame_enabled());
+  args.GetIsolate()->SetPromiseHook(PromiseHook);
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+
+  env->SetMethodNoSideEffect(target, "getContextFrame", GetContextFrame);
+  env->SetMethod(target, "setContextFrame", SetContextFrame);
+  env->SetMethod(target, "setupPromiseHook", SetupPromiseHook);
+}
+
+}  // anonymous namespace
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(GetContextFrame);
+  registry->Register(SetContextFrame);
+  registry->Register(SetupPromiseHook);
+}
+
+}  // namespace async_context_frame
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(async_context_frame,
+                                   node::async_context_frame::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(
+    async_context_frame, node::async_context_frame::RegisterExternalReferences)
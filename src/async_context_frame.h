@@ -0,0 +1,38 @@
+#ifndef SRC_ASYNC_CONTEXT_FRAME_H_
+#define SRC_ASYNC_CONTEXT_FRAME_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+// With --experimental-async-context-frame, AsyncLocalStorage keeps its stores
+// in an immutable frame (see lib/internal/async_context_frame.js) instead of
+// on the async_hooks resources. The current frame is kept on the main context
+// of the Environment. It is captured when an AsyncWrap is initialized and
+// when a promise is created, and made current again while the callbacks of
+// that AsyncWrap or the reactions of that promise run, so that the stores
+// propagate without the init/before/after hooks.
+namespace async_context_frame {
+
+// Captures and restores the frame for a promise. This is called from
+// the PromiseHook that async_hooks installs, if it is enabled, because V8
+// only supports one PromiseHook per Isolate.
+void RunPromiseHook(Environment* env,
+                    v8::PromiseHookType type,
+                    v8::Local<v8::Promise> promise);
+
+// The PromiseHook that is installed while async_hooks does not need one.
+void PromiseHook(v8::PromiseHookType type,
+                 v8::Local<v8::Promise> promise,
+                 v8::Local<v8::Value> parent);
+
+}  // namespace async_context_frame
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_ASYNC_CONTEXT_FRAME_H_
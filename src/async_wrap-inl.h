@@ -50,6 +50,15 @@ inline double AsyncWrap::get_trigger_async_id() const {
 }
 
 
+inline v8::Local<v8::Value> AsyncWrap::context_frame() const {
+  if (!env()->async_context_frame_enabled())
+    return v8::Local<v8::Value>();
+  if (context_frame_.IsEmpty())
+    return v8::Undefined(env()->isolate());
+  return PersistentToLocal::Strong(context_frame_);
+}
+
+
 inline v8::MaybeLocal<v8::Value> AsyncWrap::MakeCallback(
     const v8::Local<v8::String> symbol,
     int argc,
@@ -21,6 +21,7 @@
 
 #include "async_wrap.h"  // NOLINT(build/include_inline)
 #include "async_wrap-inl.h"
+#include "async_context_frame.h"
 #include "env-inl.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
@@ -302,6 +303,9 @@ static void FastPromiseHook(PromiseHookType type, Local<Promise> promise,
   Environment* env = Environment::GetCurrent(context);
   if (env == nullptr) return;
 
+  if (env->async_context_frame_enabled())
+    async_context_frame::RunPromiseHook(env, type, promise);
+
   if (type == PromiseHookType::kBefore &&
       env->async_hooks()->fields()[AsyncHooks::kBefore] == 0) {
     double async_id;
@@ -361,6 +365,8 @@ static void FullPromiseHook(PromiseHookType type, Local<Promise> promise,
 
   Environment* env = Environment::GetCurrent(context);
   if (env == nullptr) return;
+  if (env->async_context_frame_enabled())
+    async_context_frame::RunPromiseHook(env, type, promise);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "EnvPromiseHook", env);
 
@@ -460,7 +466,9 @@ static void DisablePromiseHook(const FunctionCallbackInfo<Value>& args) {
   // The per-Isolate API provides no way of knowing whether there are multiple
   // users of the PromiseHook. That hopefully goes away when V8 introduces
   // a per-context API.
-  args.GetIsolate()->SetPromiseHook(nullptr);
+  args.GetIsolate()->SetPromiseHook(env->async_context_frame_enabled() ?
+                                        async_context_frame::PromiseHook :
+                                        nullptr);
 }
 
 
@@ -864,6 +872,14 @@ void AsyncWrap::AsyncReset(Local<Object> resource, double execution_async_id,
     if (resource != obj) {
       USE(obj->Set(env()->context(), env()->resource_symbol(), resource));
     }
+
+    if (env()->async_context_frame_enabled()) {
+      Local<Value> frame = env()->async_context_frame();
+      if (frame->IsUndefined())
+        context_frame_.Reset();
+      else
+        context_frame_.Reset(env()->isolate(), frame);
+    }
   }
 
   switch (provider_type()) {
@@ -933,7 +949,7 @@ MaybeLocal<Value> AsyncWrap::MakeCallback(const Local<Function> cb,
   ProviderType provider = provider_type();
   async_context context { get_async_id(), get_trigger_async_id() };
   MaybeLocal<Value> ret = InternalMakeCallback(
-      env(), object(), object(), cb, argc, argv, context);
+      env(), object(), object(), cb, argc, argv, context, context_frame());
 
   // This is a static call with cached values because the `this` object may
   // no longer be alive at this point.
@@ -51,6 +51,7 @@ namespace node {
   V(HTTP2SETTINGS)                                                            \
   V(HTTPINCOMINGMESSAGE)                                                      \
   V(HTTPCLIENTREQUEST)                                                        \
+  V(IOTHREADSTREAM)                                                           \
   V(JSSTREAM)                                                                 \
   V(JSUDPWRAP)                                                                \
   V(MESSAGEPORT)                                                              \
@@ -185,6 +186,11 @@ class AsyncWrap : public BaseObject {
   inline double get_async_id() const;
   inline double get_trigger_async_id() const;
 
+  // The async context frame that was current when this resource was
+  // initialized, which is made current again while its callbacks run.
+  // Empty unless --experimental-async-context-frame is used.
+  inline v8::Local<v8::Value> context_frame() const;
+
   void AsyncReset(v8::Local<v8::Object> resource,
                   double execution_async_id = kInvalidAsyncId,
                   bool silent = false);
@@ -237,6 +243,7 @@ class AsyncWrap : public BaseObject {
   // Because the values may be Reset(), cannot be made const.
   double async_id_ = kInvalidAsyncId;
   double trigger_async_id_;
+  v8::Global<v8::Value> context_frame_;
 };
 
 }  // namespace node
@@ -0,0 +1,321 @@
+#include "base64.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(_MSC_VER)
+#define NODE_BASE64_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NODE_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace node {
+
+extern const int8_t unbase64_table[256];
+
+namespace {
+
+// The vectorized codecs follow the algorithms by Wojciech Muła and Daniel
+// Lemire, see https://arxiv.org/abs/1704.00605, as used by libbase64.
+
+#if NODE_BASE64_AVX2
+
+// Each 128-bit lane turns 12 input bytes into 16 characters. The lanes are
+// loaded separately, so 28 bytes of input need to be readable.
+__attribute__((target("avx2")))
+size_t EncodeAVX2(const char* src, size_t slen, char* dst, Base64Mode mode) {
+  const __m256i shuffle = _mm256_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  const char c62 = mode == Base64Mode::URL ? '-' : '+';
+  const char c63 = mode == Base64Mode::URL ? '_' : '/';
+  // Offsets from the 6-bit values to their characters, indexed by the
+  // range the value is in.
+  const __m256i offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, c62 - 62,
+      c63 - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, c62 - 62,
+      c63 - 63, 'A', 0, 0);
+
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 28 <= slen; i += 24, k += 32) {
+    __m256i in = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12)),
+        1);
+
+    // Spread each group of 3 bytes over 4 bytes holding 6 bits each.
+    in = _mm256_shuffle_epi8(in, shuffle);
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+
+    // 0..25 map to 13, 26..51 to 0 and 52..63 to 1..12.
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less =
+        _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range,
+                            _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i out =
+        _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+  }
+  return i;
+}
+
+// Decodes 32 characters into 24 bytes, unless there are characters other
+// than those of the two base64 alphabets.
+__attribute__((target("avx2")))
+inline bool DecodeBlockAVX2(__m256i in, char* dst) {
+  // Classify characters by their low and high nibbles. A character is
+  // invalid if the classes have a bit in common.
+  const __m256i lut_lo = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  // Offsets from characters to their 6-bit values, by high nibble. '/' is
+  // moved to index 1 because it shares its high nibble with '+'.
+  const __m256i lut_roll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+  const __m256i pack = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  // Both alphabets are accepted, so map '-' and '_' to '+' and '/'.
+  in = _mm256_add_epi8(
+      in, _mm256_and_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('-')),
+                           _mm256_set1_epi8('+' - '-')));
+  in = _mm256_add_epi8(
+      in, _mm256_and_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('_')),
+                           _mm256_set1_epi8('/' - '_')));
+
+  const __m256i hi_nibbles =
+      _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_2f);
+  const __m256i lo_nibbles = _mm256_and_si256(in, mask_2f);
+  const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+  const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+  if (!_mm256_testz_si256(lo, hi))
+    return false;
+
+  const __m256i eq_2f = _mm256_cmpeq_epi8(in, mask_2f);
+  const __m256i roll =
+      _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+  in = _mm256_add_epi8(in, roll);
+
+  // Pack the 6-bit values of each group of 4 into 3 bytes.
+  const __m256i merged =
+      _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+  __m256i out = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+  out = _mm256_shuffle_epi8(out, pack);
+
+  // Only write the 12 bytes of each lane that are part of the output, so
+  // that the rest of `dst` is left alone.
+  const __m128i lo_out = _mm256_castsi256_si128(out);
+  const __m128i hi_out = _mm256_extracti128_si256(out, 1);
+  const uint32_t lo_tail = _mm_extract_epi32(lo_out, 2);
+  const uint32_t hi_tail = _mm_extract_epi32(hi_out, 2);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), lo_out);
+  memcpy(dst + 8, &lo_tail, sizeof(lo_tail));
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 12), hi_out);
+  memcpy(dst + 20, &hi_tail, sizeof(hi_tail));
+  return true;
+}
+
+__attribute__((target("avx2")))
+void DecodeAVX2(char* dst, size_t dstlen,
+                const char* src, size_t srclen,
+                size_t* i, size_t* k) {
+  while (*i + 32 <= srclen && *k + 24 <= dstlen) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[*i]));
+    if (!DecodeBlockAVX2(in, &dst[*k]))
+      break;
+    *i += 32;
+    *k += 24;
+  }
+}
+
+__attribute__((target("avx2")))
+void DecodeAVX2(char* dst, size_t dstlen,
+                const uint16_t* src, size_t srclen,
+                size_t* i, size_t* k) {
+  while (*i + 32 <= srclen && *k + 24 <= dstlen) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[*i]));
+    const __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[*i + 16]));
+    // Characters that do not fit into a byte saturate to 0 or 255, which are
+    // not part of either alphabet, so that such blocks are left to the
+    // caller. packus works within lanes, so restore the order of the 64-bit
+    // halves afterwards.
+    const __m256i in =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xd8);
+    if (!DecodeBlockAVX2(in, &dst[*k]))
+      break;
+    *i += 32;
+    *k += 24;
+  }
+}
+
+bool HasAVX2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+const bool has_avx2 = HasAVX2();
+
+#elif NODE_BASE64_NEON
+
+inline uint8x16x4_t LoadTable(const uint8_t* table) {
+  uint8x16x4_t result;
+  result.val[0] = vld1q_u8(table);
+  result.val[1] = vld1q_u8(table + 16);
+  result.val[2] = vld1q_u8(table + 32);
+  result.val[3] = vld1q_u8(table + 48);
+  return result;
+}
+
+// Turns 48 input bytes into 64 characters per iteration.
+size_t EncodeNEON(const char* src, size_t slen, char* dst, Base64Mode mode) {
+  const uint8x16x4_t table = LoadTable(
+      reinterpret_cast<const uint8_t*>(base64_select_table(mode)));
+
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 48 <= slen; i += 48, k += 64) {
+    const uint8x16x3_t in =
+        vld3q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vorrq_u8(vandq_u8(vshlq_n_u8(in.val[0], 4), vdupq_n_u8(0x30)),
+                          vshrq_n_u8(in.val[1], 4));
+    out.val[2] = vorrq_u8(vandq_u8(vshlq_n_u8(in.val[1], 2), vdupq_n_u8(0x3c)),
+                          vshrq_n_u8(in.val[2], 6));
+    out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3f));
+    for (int j = 0; j < 4; j++)
+      out.val[j] = vqtbl4q_u8(table, out.val[j]);
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+  }
+  return i;
+}
+
+// Decodes 64 characters, as loaded by vld4q_u8(), into 48 bytes, unless
+// there are characters other than those of the two base64 alphabets.
+inline bool DecodeBlockNEON(const uint8x16x4_t& in, char* dst) {
+  // unbase64_table has the high bit set for everything that is not a base64
+  // character of either alphabet.
+  const uint8_t* table = reinterpret_cast<const uint8_t*>(unbase64_table);
+  const uint8x16x4_t table_lo = LoadTable(table);
+  const uint8x16x4_t table_hi = LoadTable(table + 64);
+
+  uint8x16x4_t values;
+  uint8x16_t invalid = vdupq_n_u8(0);
+  for (int j = 0; j < 4; j++) {
+    // Indices out of range of a table yield 0 for vqtbl4q_u8() and keep the
+    // previous value for vqtbx4q_u8(). Characters >= 128 are caught through
+    // their own high bit.
+    uint8x16_t value = vqtbl4q_u8(table_lo, in.val[j]);
+    value = vqtbx4q_u8(value, table_hi, vsubq_u8(in.val[j], vdupq_n_u8(64)));
+    invalid = vorrq_u8(invalid, vorrq_u8(value, in.val[j]));
+    values.val[j] = value;
+  }
+  if (vmaxvq_u8(invalid) & 0x80)
+    return false;
+
+  uint8x16x3_t out;
+  out.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2),
+                        vshrq_n_u8(values.val[1], 4));
+  out.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4),
+                        vshrq_n_u8(values.val[2], 2));
+  out.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+  vst3q_u8(reinterpret_cast<uint8_t*>(dst), out);
+  return true;
+}
+
+void DecodeNEON(char* dst, size_t dstlen,
+                const char* src, size_t srclen,
+                size_t* i, size_t* k) {
+  while (*i + 64 <= srclen && *k + 48 <= dstlen) {
+    const uint8x16x4_t in =
+        vld4q_u8(reinterpret_cast<const uint8_t*>(&src[*i]));
+    if (!DecodeBlockNEON(in, &dst[*k]))
+      break;
+    *i += 64;
+    *k += 48;
+  }
+}
+
+void DecodeNEON(char* dst, size_t dstlen,
+                const uint16_t* src, size_t srclen,
+                size_t* i, size_t* k) {
+  while (*i + 64 <= srclen && *k + 48 <= dstlen) {
+    const uint16x8x4_t a = vld4q_u16(&src[*i]);
+    const uint16x8x4_t b = vld4q_u16(&src[*i + 32]);
+    // Characters that do not fit into a byte saturate to 255, which is not
+    // part of either alphabet, so that such blocks are left to the caller.
+    uint8x16x4_t in;
+    for (int j = 0; j < 4; j++)
+      in.val[j] = vcombine_u8(vqmovn_u16(a.val[j]), vqmovn_u16(b.val[j]));
+    if (!DecodeBlockNEON(in, &dst[*k]))
+      break;
+    *i += 64;
+    *k += 48;
+  }
+}
+
+#endif
+
+}  // anonymous namespace
+
+size_t base64_encode_simd(const char* src,
+                          size_t slen,
+                          char* dst,
+                          Base64Mode mode) {
+#if NODE_BASE64_AVX2
+  if (has_avx2)
+    return EncodeAVX2(src, slen, dst, mode);
+#elif NODE_BASE64_NEON
+  return EncodeNEON(src, slen, dst, mode);
+#endif
+  return 0;
+}
+
+void base64_decode_simd(char* const dst, const size_t dstlen,
+                        const char* const src, const size_t srclen,
+                        size_t* const i, size_t* const k) {
+#if NODE_BASE64_AVX2
+  if (has_avx2)
+    DecodeAVX2(dst, dstlen, src, srclen, i, k);
+#elif NODE_BASE64_NEON
+  DecodeNEON(dst, dstlen, src, srclen, i, k);
+#endif
+}
+
+void base64_decode_simd(char* const dst, const size_t dstlen,
+                        const uint16_t* const src, const size_t srclen,
+                        size_t* const i, size_t* const k) {
+#if NODE_BASE64_AVX2
+  if (has_avx2)
+    DecodeAVX2(dst, dstlen, src, srclen, i, k);
+#elif NODE_BASE64_NEON
+  DecodeNEON(dst, dstlen, src, srclen, i, k);
+#endif
+}
+
+}  // namespace node
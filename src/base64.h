@@ -61,6 +61,25 @@ inline size_t base64_encode(const char* src,
                             char* dst,
                             size_t dlen,
                             Base64Mode mode = Base64Mode::NORMAL);
+
+// Vectorized versions of the inner loops, for CPUs that support AVX2 or NEON.
+// base64_encode_simd() encodes a prefix of `src` and returns its length,
+// which is a multiple of 3. base64_decode_simd() decodes from src[*i] to
+// dst[*k] and advances both, stopping before the first block that contains
+// whitespace, padding or other characters that are not part of either
+// base64 alphabet.
+size_t base64_encode_simd(const char* src,
+                          size_t slen,
+                          char* dst,
+                          Base64Mode mode);
+
+void base64_decode_simd(char* const dst, const size_t dstlen,
+                        const char* const src, const size_t srclen,
+                        size_t* const i, size_t* const k);
+
+void base64_decode_simd(char* const dst, const size_t dstlen,
+                        const uint16_t* const src, const size_t srclen,
+                        size_t* const i, size_t* const k);
 }  // namespace node
 
 
@@ -39,13 +39,15 @@ BaseObject::BaseObject(Environment* env, v8::Local<v8::Object> object)
   object->SetAlignedPointerInInternalField(
       BaseObject::kSlot,
       static_cast<void*>(this));
-  env->AddCleanupHook(DeleteMe, static_cast<void*>(this));
+  cleanup_hook_slot_ =
+      env->AddCleanupHookSlot(DeleteMe, static_cast<void*>(this));
   env->modify_base_object_count(1);
 }
 
 BaseObject::~BaseObject() {
   env()->modify_base_object_count(-1);
-  env()->RemoveCleanupHook(DeleteMe, static_cast<void*>(this));
+  env()->RemoveCleanupHookSlot(
+      cleanup_hook_slot_, DeleteMe, static_cast<void*>(this));
 
   if (UNLIKELY(has_pointer_data())) {
     PointerData* metadata = pointer_data();
@@ -208,6 +208,9 @@ class BaseObject : public MemoryRetainer {
 
   Environment* env_;
   PointerData* pointer_data_ = nullptr;
+  // The slot of the cleanup hook that deletes this object, which is a
+  // CleanupHookSlot (see env.h).
+  uint32_t cleanup_hook_slot_;
 };
 
 // Global alias for FromJSObject() to avoid churn.
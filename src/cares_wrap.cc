@@ -31,10 +31,14 @@
 #include "uv.h"
 #include "node_errors.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
+#include <list>
 #include <memory>
+#include <string>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #ifdef __POSIX__
@@ -65,6 +69,7 @@ namespace cares_wrap {
 using v8::Array;
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -75,6 +80,8 @@ using v8::Local;
 using v8::Null;
 using v8::Object;
 using v8::String;
+using v8::Uint32;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -85,6 +92,20 @@ inline uint16_t cares_get_16bit(const unsigned char* p) {
   return static_cast<uint32_t>(p[0] << 8U) | (static_cast<uint32_t>(p[1]));
 }
 
+inline uint32_t cares_get_32bit(const unsigned char* p) {
+  return (static_cast<uint32_t>(p[0]) << 24U) |
+         (static_cast<uint32_t>(p[1]) << 16U) |
+         (static_cast<uint32_t>(p[2]) << 8U) |
+         static_cast<uint32_t>(p[3]);
+}
+
+inline void cares_set_32bit(unsigned char* p, uint32_t value) {
+  p[0] = static_cast<unsigned char>(value >> 24U);
+  p[1] = static_cast<unsigned char>(value >> 16U);
+  p[2] = static_cast<unsigned char>(value >> 8U);
+  p[3] = static_cast<unsigned char>(value);
+}
+
 const int ns_t_cname_or_a = -1;
 
 #define DNS_ESETSRVPENDING -1000
@@ -121,6 +142,237 @@ inline const char* ToErrorCodeString(int status) {
   return "UNKNOWN_ARES_ERROR";
 }
 
+// Returns the offset that follows the domain name at offset in buf, or -1 if
+// the name does not fit in the message.
+int SkipName(const unsigned char* buf, int len, int offset) {
+  while (offset < len) {
+    const unsigned char label = buf[offset];
+    if ((label & 0xc0) == 0xc0)
+      return offset + 2 <= len ? offset + 2 : -1;
+    if (label == 0)
+      return offset + 1;
+    offset += label + 1;
+  }
+  return -1;
+}
+
+// Caches the raw answers to the queries made on a channel, for as long as
+// their TTLs allow. The answers are replayed through the same parsers as the
+// answers that come from the network.
+class AnswerCache {
+ public:
+  enum class Result { kMiss, kFresh, kStale };
+
+  struct Entry {
+    std::string key;
+    int status;
+    std::vector<unsigned char> answer;
+    // The offsets of the TTLs of the records in answer.
+    std::vector<int> ttl_offsets;
+    uint64_t stored_at;
+    uint64_t expires_at;
+    bool refreshing;
+
+    // Returns a copy of the answer, with its TTLs decreased by the time that
+    // it spent in the cache.
+    MallocedBuffer<unsigned char> CopyAnswer(uint64_t now) const;
+  };
+
+  AnswerCache(size_t max_entries,
+              uint32_t max_ttl,
+              uint32_t negative_ttl,
+              uint32_t stale_ttl)
+      : max_entries_(max_entries),
+        max_ttl_(max_ttl),
+        negative_ttl_(negative_ttl),
+        stale_ttl_(stale_ttl) {}
+
+  static std::string GetKey(const char* name, int dnsclass, int type);
+
+  // Looks the key up and sets entry when it is found. Expired entries are
+  // returned as kStale for stale_ttl more seconds, so that they can be served
+  // while they are refreshed.
+  Result Get(const std::string& key, uint64_t now, Entry** entry);
+  // Stores the answer to a query, if its status is one that can be cached.
+  void Store(const std::string& key,
+             int status,
+             const unsigned char* answer,
+             int len,
+             uint64_t now);
+  void Clear();
+
+  size_t hits() const { return hits_; }
+  size_t stale_hits() const { return stale_hits_; }
+  size_t misses() const { return misses_; }
+  size_t size() const { return index_.size(); }
+
+ private:
+  void Erase(std::list<Entry>::iterator it);
+
+  const size_t max_entries_;
+  const uint32_t max_ttl_;
+  const uint32_t negative_ttl_;
+  const uint32_t stale_ttl_;
+  size_t hits_ = 0;
+  size_t stale_hits_ = 0;
+  size_t misses_ = 0;
+  // Ordered from the most to the least recently used.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
+// Reads the TTLs of the records in the answer and authority sections of a DNS
+// message. answer_ttl is set to the smallest TTL of the answers, and
+// negative_ttl is lowered to the one of the SOA record, if there is one.
+bool ReadTtls(const unsigned char* buf,
+              int len,
+              std::vector<int>* ttl_offsets,
+              uint32_t* answer_ttl,
+              uint32_t* negative_ttl) {
+  if (len < NS_HFIXEDSZ)
+    return false;
+  const unsigned int qdcount = cares_get_16bit(buf + 4);
+  const unsigned int ancount = cares_get_16bit(buf + 6);
+  const unsigned int nscount = cares_get_16bit(buf + 8);
+
+  int offset = NS_HFIXEDSZ;
+  for (unsigned int i = 0; i < qdcount; i++) {
+    offset = SkipName(buf, len, offset);
+    if (offset < 0 || offset + NS_QFIXEDSZ > len)
+      return false;
+    offset += NS_QFIXEDSZ;
+  }
+
+  for (unsigned int i = 0; i < ancount + nscount; i++) {
+    offset = SkipName(buf, len, offset);
+    if (offset < 0 || offset + NS_RRFIXEDSZ > len)
+      return false;
+    const int type = cares_get_16bit(buf + offset);
+    const uint32_t ttl = cares_get_32bit(buf + offset + 4);
+    const int rdlength = cares_get_16bit(buf + offset + 8);
+    const int rdata = offset + NS_RRFIXEDSZ;
+    if (rdata + rdlength > len)
+      return false;
+    ttl_offsets->push_back(offset + 4);
+
+    if (i < ancount) {
+      *answer_ttl = std::min(*answer_ttl, ttl);
+    } else if (type == ns_t_soa && rdlength >= 22) {
+      // The negative answers are cached for the smallest of the TTL and of
+      // the MINIMUM field of the SOA record, which is its last one.
+      const uint32_t minimum = cares_get_32bit(buf + rdata + rdlength - 4);
+      *negative_ttl = std::min(*negative_ttl, std::min(ttl, minimum));
+    }
+    offset = rdata + rdlength;
+  }
+
+  return true;
+}
+
+MallocedBuffer<unsigned char> AnswerCache::Entry::CopyAnswer(
+    uint64_t now) const {
+  MallocedBuffer<unsigned char> copy(answer.size());
+  if (answer.empty())
+    return copy;
+  memcpy(copy.data, answer.data(), answer.size());
+
+  const uint32_t age = static_cast<uint32_t>((now - stored_at) / 1000);
+  for (int offset : ttl_offsets) {
+    const uint32_t ttl = cares_get_32bit(copy.data + offset);
+    cares_set_32bit(copy.data + offset, ttl > age ? ttl - age : 0);
+  }
+  return copy;
+}
+
+std::string AnswerCache::GetKey(const char* name, int dnsclass, int type) {
+  // The domain names are case-insensitive.
+  return std::to_string(type) + ':' + std::to_string(dnsclass) + ':' +
+         ToLower(name);
+}
+
+AnswerCache::Result AnswerCache::Get(const std::string& key,
+                                     uint64_t now,
+                                     Entry** entry) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    misses_++;
+    return Result::kMiss;
+  }
+
+  if (now >= it->second->expires_at + stale_ttl_ * uint64_t{1000}) {
+    Erase(it->second);
+    misses_++;
+    return Result::kMiss;
+  }
+
+  entries_.splice(entries_.begin(), entries_, it->second);
+  *entry = &*it->second;
+  hits_++;
+  if (now < (*entry)->expires_at)
+    return Result::kFresh;
+  stale_hits_++;
+  return Result::kStale;
+}
+
+void AnswerCache::Store(const std::string& key,
+                        int status,
+                        const unsigned char* answer,
+                        int len,
+                        uint64_t now) {
+  auto it = index_.find(key);
+
+  std::vector<int> ttl_offsets;
+  uint32_t answer_ttl = UINT32_MAX;
+  uint32_t ttl = negative_ttl_;
+  const bool cacheable =
+      (status == ARES_SUCCESS ||
+       status == ARES_ENOTFOUND ||
+       status == ARES_ENODATA) &&
+      (answer == nullptr ||
+       ReadTtls(answer, len, &ttl_offsets, &answer_ttl, &ttl));
+  if (!cacheable) {
+    // The stale entry, if there is one, is served until it can be refreshed.
+    if (it != index_.end())
+      it->second->refreshing = false;
+    return;
+  }
+
+  if (it != index_.end())
+    Erase(it->second);
+
+  // The successful answers without records are negative answers too.
+  if (status == ARES_SUCCESS && answer_ttl != UINT32_MAX)
+    ttl = std::min(answer_ttl, max_ttl_);
+  if (ttl == 0)
+    return;
+
+  Entry entry;
+  entry.key = key;
+  entry.status = status;
+  if (status == ARES_SUCCESS) {
+    entry.answer.assign(answer, answer + len);
+    entry.ttl_offsets = std::move(ttl_offsets);
+  }
+  entry.stored_at = now;
+  entry.expires_at = now + ttl * uint64_t{1000};
+  entry.refreshing = false;
+  entries_.push_front(std::move(entry));
+  index_.emplace(key, entries_.begin());
+
+  while (index_.size() > max_entries_)
+    Erase(std::prev(entries_.end()));
+}
+
+void AnswerCache::Clear() {
+  index_.clear();
+  entries_.clear();
+}
+
+void AnswerCache::Erase(std::list<Entry>::iterator it) {
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
 class ChannelWrap;
 
 struct node_ares_task : public MemoryRetainer {
@@ -150,7 +402,10 @@ using node_ares_task_list =
 
 class ChannelWrap : public AsyncWrap {
  public:
-  ChannelWrap(Environment* env, Local<Object> object, int timeout);
+  ChannelWrap(Environment* env,
+              Local<Object> object,
+              int timeout,
+              std::unique_ptr<AnswerCache> answer_cache);
   ~ChannelWrap() override;
 
   static void New(const FunctionCallbackInfo<Value>& args);
@@ -161,6 +416,11 @@ class ChannelWrap : public AsyncWrap {
   void CloseTimer();
 
   void ModifyActivityQueryCount(int count);
+  // Queries the name again to refresh the entry of the answer cache for key.
+  void RefreshAnswer(std::string key,
+                     const char* name,
+                     int dnsclass,
+                     int type);
 
   inline uv_timer_t* timer_handle() { return timer_handle_; }
   inline ares_channel cares_channel() { return channel_; }
@@ -170,6 +430,7 @@ class ChannelWrap : public AsyncWrap {
   }
   inline int active_query_count() { return active_query_count_; }
   inline node_ares_task_list* task_list() { return &task_list_; }
+  inline AnswerCache* answer_cache() { return answer_cache_.get(); }
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     if (timer_handle_ != nullptr)
@@ -191,11 +452,13 @@ class ChannelWrap : public AsyncWrap {
   int timeout_;
   int active_query_count_;
   node_ares_task_list task_list_;
+  std::unique_ptr<AnswerCache> answer_cache_;
 };
 
 ChannelWrap::ChannelWrap(Environment* env,
                          Local<Object> object,
-                         int timeout)
+                         int timeout,
+                         std::unique_ptr<AnswerCache> answer_cache)
   : AsyncWrap(env, object, PROVIDER_DNSCHANNEL),
     timer_handle_(nullptr),
     channel_(nullptr),
@@ -203,7 +466,8 @@ ChannelWrap::ChannelWrap(Environment* env,
     is_servers_default_(true),
     library_inited_(false),
     timeout_(timeout),
-    active_query_count_(0) {
+    active_query_count_(0),
+    answer_cache_(std::move(answer_cache)) {
   MakeWeak();
 
   Setup();
@@ -211,11 +475,24 @@ ChannelWrap::ChannelWrap(Environment* env,
 
 void ChannelWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
-  CHECK_EQ(args.Length(), 1);
+  CHECK_EQ(args.Length(), 5);
   CHECK(args[0]->IsInt32());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsUint32());
+  CHECK(args[4]->IsUint32());
   const int timeout = args[0].As<Int32>()->Value();
+  const uint32_t max_entries = args[1].As<Uint32>()->Value();
+  std::unique_ptr<AnswerCache> answer_cache;
+  if (max_entries > 0) {
+    answer_cache = std::make_unique<AnswerCache>(
+        max_entries,
+        args[2].As<Uint32>()->Value(),
+        args[3].As<Uint32>()->Value(),
+        args[4].As<Uint32>()->Value());
+  }
   Environment* env = Environment::GetCurrent(args);
-  new ChannelWrap(env, args.This(), timeout);
+  new ChannelWrap(env, args.This(), timeout, std::move(answer_cache));
 }
 
 class GetAddrInfoReqWrap : public ReqWrap<uv_getaddrinfo_t> {
@@ -531,6 +808,33 @@ void ChannelWrap::ModifyActivityQueryCount(int count) {
 }
 
 
+void ChannelWrap::RefreshAnswer(std::string key,
+                                const char* name,
+                                int dnsclass,
+                                int type) {
+  struct Refresh {
+    ChannelWrap* channel;
+    std::string key;
+  };
+
+  // The refresh is not tied to a QueryWrap. It is counted as an active query
+  // so that the servers are not changed while it is pending, and it is
+  // completed with ARES_EDESTRUCTION if the channel goes away first.
+  ModifyActivityQueryCount(1);
+  ares_query(channel_, name, dnsclass, type,
+             [](void* arg, int status, int timeouts,
+                unsigned char* answer_buf, int answer_len) {
+               std::unique_ptr<Refresh> refresh { static_cast<Refresh*>(arg) };
+               ChannelWrap* channel = refresh->channel;
+               channel->ModifyActivityQueryCount(-1);
+               channel->answer_cache()->Store(
+                   refresh->key, status, answer_buf, answer_len,
+                   uv_now(channel->env()->event_loop()));
+             },
+             new Refresh { this, std::move(key) });
+}
+
+
 /**
  * This function is to check whether current servers are fallback servers
  * when cares initialized.
@@ -612,6 +916,28 @@ class QueryWrap : public AsyncWrap {
     TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
       TRACING_CATEGORY_NODE2(dns, native), trace_name_, this,
       "name", TRACE_STR_COPY(name));
+
+    AnswerCache* cache = channel_->answer_cache();
+    if (cache != nullptr) {
+      std::string key = AnswerCache::GetKey(name, dnsclass, type);
+      const uint64_t now = uv_now(env()->event_loop());
+      AnswerCache::Entry* entry;
+      const AnswerCache::Result result = cache->Get(key, now, &entry);
+      if (result != AnswerCache::Result::kMiss) {
+        response_data_ = std::make_unique<ResponseData>();
+        response_data_->status = entry->status;
+        response_data_->is_host = false;
+        response_data_->buf = entry->CopyAnswer(now);
+        if (result == AnswerCache::Result::kStale && !entry->refreshing) {
+          entry->refreshing = true;
+          channel_->RefreshAnswer(std::move(key), name, dnsclass, type);
+        }
+        QueueResponseCallback(response_data_->status);
+        return;
+      }
+      cache_key_ = std::move(key);
+    }
+
     ares_query(channel_->cares_channel(), name, dnsclass, type, Callback,
                MakeCallbackPointer());
   }
@@ -621,6 +947,7 @@ class QueryWrap : public AsyncWrap {
     bool is_host;
     DeleteFnPtr<hostent, safe_free_hostent> host;
     MallocedBuffer<unsigned char> buf;
+    DeleteFnPtr<ares_addrinfo, ares_freeaddrinfo> addrinfo;
   };
 
   void AfterResponse() {
@@ -630,6 +957,8 @@ class QueryWrap : public AsyncWrap {
 
     if (status != ARES_SUCCESS) {
       ParseError(status);
+    } else if (response_data_->addrinfo) {
+      Parse(response_data_->addrinfo.get());
     } else if (!response_data_->is_host) {
       Parse(response_data_->buf.data, response_data_->buf.size);
     } else {
@@ -656,6 +985,12 @@ class QueryWrap : public AsyncWrap {
     QueryWrap* wrap = FromCallbackPointer(arg);
     if (wrap == nullptr) return;
 
+    if (!wrap->cache_key_.empty()) {
+      wrap->channel_->answer_cache()->Store(
+          wrap->cache_key_, status, answer_buf, answer_len,
+          uv_now(wrap->env()->event_loop()));
+    }
+
     unsigned char* buf_copy = nullptr;
     if (status == ARES_SUCCESS) {
       buf_copy = node::Malloc<unsigned char>(answer_len);
@@ -691,6 +1026,23 @@ class QueryWrap : public AsyncWrap {
     wrap->QueueResponseCallback(status);
   }
 
+  static void Callback(void* arg, int status, int timeouts,
+                       struct ares_addrinfo* res) {
+    // The result is owned by the callback.
+    DeleteFnPtr<ares_addrinfo, ares_freeaddrinfo> addrinfo { res };
+    QueryWrap* wrap = FromCallbackPointer(arg);
+    if (wrap == nullptr) return;
+
+    wrap->response_data_ = std::make_unique<ResponseData>();
+    ResponseData* data = wrap->response_data_.get();
+    data->status = status;
+    data->is_host = false;
+    if (status == ARES_SUCCESS)
+      data->addrinfo = std::move(addrinfo);
+
+    wrap->QueueResponseCallback(status);
+  }
+
   void QueueResponseCallback(int status) {
     BaseObjectPtr<QueryWrap> strong_ref{this};
     env()->SetImmediate([this, strong_ref](Environment*) {
@@ -741,10 +1093,16 @@ class QueryWrap : public AsyncWrap {
     UNREACHABLE();
   }
 
+  virtual void Parse(struct ares_addrinfo* res) {
+    UNREACHABLE();
+  }
+
   BaseObjectPtr<ChannelWrap> channel_;
 
  private:
   std::unique_ptr<ResponseData> response_data_;
+  // The key of the answer cache entry that the answer is stored in.
+  std::string cache_key_;
   const char* trace_name_;
   // Pointer to pointer to 'this' that can be reset from the destructor,
   // in order to let Callback() know that 'this' no longer exists.
@@ -1210,6 +1568,40 @@ int ParseSoaReply(Environment* env,
 }
 
 
+Local<Object> SoaReplyToObject(Environment* env,
+                               const ares_soa_reply* soa) {
+  EscapableHandleScope handle_scope(env->isolate());
+  auto context = env->context();
+
+  Local<Object> soa_record = Object::New(env->isolate());
+  soa_record->Set(context,
+                  env->nsname_string(),
+                  OneByteString(env->isolate(), soa->nsname)).Check();
+  soa_record->Set(context,
+                  env->hostqueen_string(),
+                  OneByteString(env->isolate(), soa->hostqueen)).Check();
+  soa_record->Set(context,
+                  env->serial_string(),
+                  Integer::NewFromUnsigned(env->isolate(),
+                                           soa->serial)).Check();
+  soa_record->Set(context,
+                  env->refresh_string(),
+                  Integer::New(env->isolate(), soa->refresh)).Check();
+  soa_record->Set(context,
+                  env->retry_string(),
+                  Integer::New(env->isolate(), soa->retry)).Check();
+  soa_record->Set(context,
+                  env->expire_string(),
+                  Integer::New(env->isolate(), soa->expire)).Check();
+  soa_record->Set(context,
+                  env->minttl_string(),
+                  Integer::NewFromUnsigned(env->isolate(),
+                                           soa->minttl)).Check();
+
+  return handle_scope.Escape(soa_record);
+}
+
+
 class QueryAnyWrap: public QueryWrap {
  public:
   QueryAnyWrap(ChannelWrap* channel, Local<Object> req_wrap_obj)
@@ -1777,35 +2169,7 @@ class QuerySoaWrap: public QueryWrap {
       return;
     }
 
-    Local<Object> soa_record = Object::New(env()->isolate());
-
-    soa_record->Set(context,
-                    env()->nsname_string(),
-                    OneByteString(env()->isolate(),
-                                  soa_out->nsname)).Check();
-    soa_record->Set(context,
-                    env()->hostqueen_string(),
-                    OneByteString(env()->isolate(),
-                                  soa_out->hostqueen)).Check();
-    soa_record->Set(context,
-                    env()->serial_string(),
-                    Integer::NewFromUnsigned(
-                      env()->isolate(), soa_out->serial)).Check();
-    soa_record->Set(context,
-                    env()->refresh_string(),
-                    Integer::New(env()->isolate(),
-                                 soa_out->refresh)).Check();
-    soa_record->Set(context,
-                    env()->retry_string(),
-                    Integer::New(env()->isolate(), soa_out->retry)).Check();
-    soa_record->Set(context,
-                    env()->expire_string(),
-                    Integer::New(env()->isolate(), soa_out->expire)).Check();
-    soa_record->Set(context,
-                    env()->minttl_string(),
-                    Integer::NewFromUnsigned(
-                      env()->isolate(), soa_out->minttl)).Check();
-
+    Local<Object> soa_record = SoaReplyToObject(env(), soa_out);
     ares_free_data(soa_out);
 
     this->CallOnComplete(soa_record);
@@ -1860,6 +2224,323 @@ class GetHostByAddrWrap: public QueryWrap {
 };
 
 
+// Performs the equivalent of getaddrinfo() on the channel, without using the
+// threadpool. The hosts file and the order of the sources in nsswitch.conf
+// are taken into account by c-ares.
+class GetAddrInfoWrap: public QueryWrap {
+ public:
+  GetAddrInfoWrap(ChannelWrap* channel,
+                  Local<Object> req_wrap_obj,
+                  int family,
+                  int flags,
+                  bool verbatim)
+      : QueryWrap(channel, req_wrap_obj, "lookup"),
+        family_(family),
+        flags_(flags),
+        verbatim_(verbatim) {
+  }
+
+  int Send(const char* name) override {
+    struct ares_addrinfo_hints hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = family_;
+    hints.ai_socktype = SOCK_STREAM;
+    if (flags_ & AI_ADDRCONFIG)
+      hints.ai_flags |= ARES_AI_ADDRCONFIG;
+    if (flags_ & AI_ALL)
+      hints.ai_flags |= ARES_AI_ALL;
+    if (flags_ & AI_V4MAPPED)
+      hints.ai_flags |= ARES_AI_V4MAPPED;
+
+    channel_->EnsureServers();
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN2(
+        TRACING_CATEGORY_NODE2(dns, native), "lookup", this,
+        "hostname", TRACE_STR_COPY(name),
+        "family",
+        family_ == AF_INET ? "ipv4" : family_ == AF_INET6 ? "ipv6" : "unspec");
+
+    ares_getaddrinfo(channel_->cares_channel(), name, nullptr, &hints,
+                     Callback, MakeCallbackPointer());
+    return 0;
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(GetAddrInfoWrap)
+  SET_SELF_SIZE(GetAddrInfoWrap)
+
+ protected:
+  void Parse(struct ares_addrinfo* res) override {
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    std::vector<Local<Value>> addresses;
+    auto add = [&] (bool want_ipv4, bool want_ipv6) {
+      for (auto p = res->nodes; p != nullptr; p = p->ai_next) {
+        const char* addr;
+        if (want_ipv4 && p->ai_family == AF_INET) {
+          addr = reinterpret_cast<char*>(
+              &(reinterpret_cast<struct sockaddr_in*>(p->ai_addr)->sin_addr));
+        } else if (want_ipv6 && p->ai_family == AF_INET6) {
+          addr = reinterpret_cast<char*>(
+              &(reinterpret_cast<struct sockaddr_in6*>(p->ai_addr)->sin6_addr));
+        } else {
+          continue;
+        }
+
+        char ip[INET6_ADDRSTRLEN];
+        if (uv_inet_ntop(p->ai_family, addr, ip, sizeof(ip)))
+          continue;
+        addresses.push_back(OneByteString(env()->isolate(), ip));
+      }
+    };
+
+    add(true, verbatim_);
+    if (verbatim_ == false)
+      add(false, true);
+
+    if (addresses.empty())
+      return ParseError(ARES_ENODATA);
+
+    this->CallOnComplete(
+        Array::New(env()->isolate(), addresses.data(), addresses.size()));
+  }
+
+ private:
+  const int family_;
+  const int flags_;
+  const bool verbatim_;
+};
+
+
+// Parses the answer to a query of the given type into the records that the
+// matching Query*Wrap reports, without their TTLs.
+int ParseAnswer(Environment* env,
+                int type,
+                unsigned char* buf,
+                int len,
+                Local<Value>* ret) {
+  EscapableHandleScope handle_scope(env->isolate());
+  Local<Array> records = Array::New(env->isolate());
+
+  int status;
+  switch (type) {
+    case ns_t_a:
+    case ns_t_aaaa:
+    case ns_t_cname:
+    case ns_t_ns:
+    case ns_t_ptr:
+      status = ParseGeneralReply(env, buf, len, &type, records);
+      break;
+    case ns_t_mx:
+      status = ParseMxReply(env, buf, len, records);
+      break;
+    case ns_t_txt:
+      status = ParseTxtReply(env, buf, len, records);
+      break;
+    case ns_t_srv:
+      status = ParseSrvReply(env, buf, len, records);
+      break;
+    case ns_t_naptr:
+      status = ParseNaptrReply(env, buf, len, records);
+      break;
+    case T_CAA:
+      status = ParseCaaReply(env, buf, len, records);
+      break;
+    case ns_t_soa: {
+      ares_soa_reply* soa_out;
+      status = ares_parse_soa_reply(buf, len, &soa_out);
+      if (status != ARES_SUCCESS)
+        return status;
+      *ret = handle_scope.Escape(SoaReplyToObject(env, soa_out));
+      ares_free_data(soa_out);
+      return ARES_SUCCESS;
+    }
+    default:
+      UNREACHABLE();
+  }
+
+  if (status == ARES_SUCCESS)
+    *ret = handle_scope.Escape(records);
+  return status;
+}
+
+
+// Sends the queries for a list of names on the channel and reports all of
+// their answers with a single callback, once the last of them has completed.
+class BatchQueryWrap : public AsyncWrap {
+ public:
+  BatchQueryWrap(ChannelWrap* channel,
+                 Local<Object> req_wrap_obj,
+                 int type,
+                 size_t count)
+      : AsyncWrap(channel->env(), req_wrap_obj, AsyncWrap::PROVIDER_QUERYWRAP),
+        channel_(channel),
+        type_(type),
+        answers_(count),
+        pending_(new Pending { this, count }) {
+  }
+
+  ~BatchQueryWrap() override {
+    CHECK_EQ(false, persistent().IsEmpty());
+
+    // Let Callback() know that this object no longer exists.
+    if (pending_ != nullptr)
+      pending_->wrap = nullptr;
+  }
+
+  void Send(const std::vector<std::string>& names) {
+    CHECK_EQ(names.size(), answers_.size());
+    channel_->EnsureServers();
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN1(
+      TRACING_CATEGORY_NODE2(dns, native), "resolveMany", this,
+      "count", static_cast<uint64_t>(names.size()));
+
+    if (names.empty()) {
+      Complete();
+      return;
+    }
+
+    AnswerCache* cache = channel_->answer_cache();
+    const uint64_t now = uv_now(env()->event_loop());
+    for (size_t i = 0; i < names.size(); i++) {
+      const char* name = names[i].c_str();
+      Answer* answer = &answers_[i];
+      if (cache != nullptr) {
+        std::string key = AnswerCache::GetKey(name, ns_c_in, type_);
+        AnswerCache::Entry* entry;
+        const AnswerCache::Result result = cache->Get(key, now, &entry);
+        if (result != AnswerCache::Result::kMiss) {
+          answer->status = entry->status;
+          answer->buf = entry->CopyAnswer(now);
+          if (result == AnswerCache::Result::kStale && !entry->refreshing) {
+            entry->refreshing = true;
+            channel_->RefreshAnswer(std::move(key), name, ns_c_in, type_);
+          }
+          OnAnswer();
+          continue;
+        }
+        answer->cache_key = std::move(key);
+      }
+
+      ares_query(channel_->cares_channel(), name, ns_c_in, type_, Callback,
+                 new Query { pending_, i });
+    }
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(BatchQueryWrap)
+  SET_SELF_SIZE(BatchQueryWrap)
+
+ private:
+  struct Answer {
+    int status = ARES_SUCCESS;
+    MallocedBuffer<unsigned char> buf;
+    // The key of the answer cache entry that the answer is stored in.
+    std::string cache_key;
+  };
+
+  // The state that the queries share. It outlives the wrap when the wrap is
+  // destroyed before all of the queries have completed.
+  struct Pending {
+    BatchQueryWrap* wrap;
+    size_t remaining;
+  };
+
+  struct Query {
+    Pending* pending;
+    size_t index;
+  };
+
+  static void Callback(void* arg, int status, int timeouts,
+                       unsigned char* answer_buf, int answer_len) {
+    std::unique_ptr<Query> query { static_cast<Query*>(arg) };
+    Pending* pending = query->pending;
+    BatchQueryWrap* wrap = pending->wrap;
+    if (wrap == nullptr) {
+      if (--pending->remaining == 0)
+        delete pending;
+      return;
+    }
+
+    Answer* answer = &wrap->answers_[query->index];
+    if (!answer->cache_key.empty()) {
+      wrap->channel_->answer_cache()->Store(
+          answer->cache_key, status, answer_buf, answer_len,
+          uv_now(wrap->env()->event_loop()));
+    }
+
+    answer->status = status;
+    if (status == ARES_SUCCESS) {
+      unsigned char* buf_copy = node::Malloc<unsigned char>(answer_len);
+      memcpy(buf_copy, answer_buf, answer_len);
+      answer->buf = MallocedBuffer<unsigned char>(buf_copy, answer_len);
+    }
+
+    wrap->channel_->set_query_last_ok(status != ARES_ECONNREFUSED);
+    wrap->OnAnswer();
+  }
+
+  // Called once for every name, whether it is answered from the cache or not.
+  void OnAnswer() {
+    CHECK_GT(pending_->remaining, 0);
+    if (--pending_->remaining == 0)
+      Complete();
+  }
+
+  void Complete() {
+    delete pending_;
+    pending_ = nullptr;
+
+    BaseObjectPtr<BatchQueryWrap> strong_ref{this};
+    env()->SetImmediate([this, strong_ref](Environment*) {
+      AfterResponse();
+
+      // Delete once strong_ref goes out of scope.
+      Detach();
+    });
+
+    channel_->ModifyActivityQueryCount(-1);
+  }
+
+  void AfterResponse() {
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env()->context());
+
+    std::vector<Local<Value>> codes(answers_.size());
+    std::vector<Local<Value>> records(answers_.size());
+    for (size_t i = 0; i < answers_.size(); i++) {
+      Answer* answer = &answers_[i];
+      int status = answer->status;
+      if (status == ARES_SUCCESS) {
+        status = ParseAnswer(env(), type_, answer->buf.data,
+                             static_cast<int>(answer->buf.size), &records[i]);
+      }
+      if (status == ARES_SUCCESS) {
+        codes[i] = Integer::New(isolate, 0);
+      } else {
+        codes[i] = OneByteString(isolate, ToErrorCodeString(status));
+        records[i] = Undefined(isolate);
+      }
+    }
+
+    Local<Value> argv[] = {
+      Array::New(isolate, codes.data(), codes.size()),
+      Array::New(isolate, records.data(), records.size())
+    };
+    TRACE_EVENT_NESTABLE_ASYNC_END0(
+        TRACING_CATEGORY_NODE2(dns, native), "resolveMany", this);
+
+    MakeCallback(env()->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  BaseObjectPtr<ChannelWrap> channel_;
+  const int type_;
+  std::vector<Answer> answers_;
+  Pending* pending_;
+};
+
+
 template <class Wrap>
 static void Query(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -1888,6 +2569,42 @@ static void Query(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void QueryMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  CHECK_EQ(false, args.IsConstructCall());
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsInt32());
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  Local<Array> names_array = args[1].As<Array>();
+  const int type = args[2].As<Int32>()->Value();
+
+  std::vector<std::string> names;
+  names.reserve(names_array->Length());
+  for (uint32_t i = 0; i < names_array->Length(); i++) {
+    Local<Value> name;
+    if (!names_array->Get(env->context(), i).ToLocal(&name))
+      return;
+    CHECK(name->IsString());
+    node::Utf8Value utf8_name(env->isolate(), name);
+    names.emplace_back(*utf8_name, utf8_name.length());
+  }
+
+  auto wrap = std::make_unique<BatchQueryWrap>(
+      channel, req_wrap_obj, type, names.size());
+  channel->ModifyActivityQueryCount(1);
+  wrap->Send(names);
+  // Release ownership of the pointer allowing the ownership to be transferred
+  USE(wrap.release());
+
+  args.GetReturnValue().Set(0);
+}
+
+
 void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
   std::unique_ptr<GetAddrInfoReqWrap> req_wrap {
       static_cast<GetAddrInfoReqWrap*>(req->data)};
@@ -2076,6 +2793,55 @@ void GetAddrInfo(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void ChannelGetAddrInfo(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsInt32());
+  CHECK(args[4]->IsBoolean());
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  node::Utf8Value hostname(env->isolate(), args[1]);
+
+  int32_t flags = 0;
+  if (args[3]->IsInt32()) {
+    flags = args[3].As<Int32>()->Value();
+  }
+
+  int family;
+
+  switch (args[2].As<Int32>()->Value()) {
+    case 0:
+      family = AF_UNSPEC;
+      break;
+    case 4:
+      family = AF_INET;
+      break;
+    case 6:
+      family = AF_INET6;
+      break;
+    default:
+      CHECK(0 && "bad address family");
+  }
+
+  auto wrap = std::make_unique<GetAddrInfoWrap>(
+      channel, req_wrap_obj, family, flags, args[4]->IsTrue());
+
+  channel->ModifyActivityQueryCount(1);
+  int err = wrap->Send(*hostname);
+  if (err) {
+    channel->ModifyActivityQueryCount(-1);
+  } else {
+    // Release ownership of the pointer allowing the ownership to be transferred
+    USE(wrap.release());
+  }
+
+  args.GetReturnValue().Set(err);
+}
+
+
 void GetNameInfo(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -2222,8 +2988,12 @@ void SetServers(const FunctionCallbackInfo<Value>& args) {
   else
     err = ARES_EBADSTR;
 
-  if (err == ARES_SUCCESS)
+  if (err == ARES_SUCCESS) {
     channel->set_is_servers_default(false);
+    // The answers of the previous servers may not hold for the new ones.
+    if (channel->answer_cache() != nullptr)
+      channel->answer_cache()->Clear();
+  }
 
   args.GetReturnValue().Set(err);
 }
@@ -2302,6 +3072,33 @@ void Cancel(const FunctionCallbackInfo<Value>& args) {
   ares_cancel(channel->cares_channel());
 }
 
+// Fills the Float64Array with the statistics of the answer cache.
+void GetCacheStatistics(const FunctionCallbackInfo<Value>& args) {
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 4);
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+
+  AnswerCache* cache = channel->answer_cache();
+  fields[0] = cache != nullptr ? cache->hits() : 0;
+  fields[1] = cache != nullptr ? cache->stale_hits() : 0;
+  fields[2] = cache != nullptr ? cache->misses() : 0;
+  fields[3] = cache != nullptr ? cache->size() : 0;
+}
+
+void ClearCache(const FunctionCallbackInfo<Value>& args) {
+  ChannelWrap* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+
+  if (channel->answer_cache() != nullptr)
+    channel->answer_cache()->Clear();
+}
+
 const char EMSG_ESETSRVPENDING[] = "There are pending queries.";
 void StrError(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -2376,11 +3173,15 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(channel_wrap, "queryNaptr", Query<QueryNaptrWrap>);
   env->SetProtoMethod(channel_wrap, "querySoa", Query<QuerySoaWrap>);
   env->SetProtoMethod(channel_wrap, "getHostByAddr", Query<GetHostByAddrWrap>);
+  env->SetProtoMethod(channel_wrap, "getaddrinfo", ChannelGetAddrInfo);
+  env->SetProtoMethod(channel_wrap, "queryMany", QueryMany);
 
   env->SetProtoMethodNoSideEffect(channel_wrap, "getServers", GetServers);
   env->SetProtoMethod(channel_wrap, "setServers", SetServers);
   env->SetProtoMethod(channel_wrap, "setLocalAddress", SetLocalAddress);
   env->SetProtoMethod(channel_wrap, "cancel", Cancel);
+  env->SetProtoMethod(channel_wrap, "getCacheStatistics", GetCacheStatistics);
+  env->SetProtoMethod(channel_wrap, "clearCache", ClearCache);
 
   env->SetConstructorFunction(target, "ChannelWrap", channel_wrap);
 }
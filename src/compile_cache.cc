@@ -0,0 +1,396 @@
+#include "compile_cache.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_file.h"
+#include "node_internals.h"
+#include "node_metadata.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cinttypes>
+#include <cstring>
+
+namespace node {
+
+using v8::Function;
+using v8::Isolate;
+using v8::Local;
+using v8::Module;
+using v8::ScriptCompiler;
+using v8::String;
+
+namespace {
+
+constexpr uint32_t kCacheMagic = 0x0c0dec4e;
+
+// Written in front of the code cache in every entry. The entries are only
+// ever read by the binary that wrote them, so the native byte order is used.
+struct CacheHeader {
+  uint32_t magic;
+  uint32_t source_hash;
+  uint32_t size;
+  uint32_t data_hash;
+};
+
+uint32_t GetHash(const void* data, size_t size, uint32_t crc = 0) {
+  return crc32(crc, reinterpret_cast<const Bytef*>(data), size);
+}
+
+uint32_t GetSourceHash(Isolate* isolate, Local<String> code) {
+  if (code->IsOneByte()) {
+    MaybeStackBuffer<uint8_t> buf(code->Length());
+    code->WriteOneByte(isolate, *buf, 0, -1, String::NO_NULL_TERMINATION);
+    return GetHash(*buf, code->Length());
+  }
+  TwoByteValue value(isolate, code);
+  return GetHash(*value, value.length() * sizeof(uint16_t));
+}
+
+bool IsAbsolutePath(const std::string& path) {
+#ifdef _WIN32
+  return (path.size() > 1 && path[1] == ':') ||
+         (!path.empty() && (path[0] == '\\' || path[0] == '/'));
+#else
+  return !path.empty() && path[0] == '/';
+#endif
+}
+
+bool ReadAll(uv_file fd, void* data, size_t size, int64_t offset) {
+  char* out = static_cast<char*>(data);
+  while (size > 0) {
+    uv_fs_t req;
+    uv_buf_t buf = uv_buf_init(out, size);
+    int n = uv_fs_read(nullptr, &req, fd, &buf, 1, offset, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (n <= 0)
+      return false;
+    out += n;
+    size -= n;
+    offset += n;
+  }
+  return true;
+}
+
+// Returns the reason why the cache could not be read, or nullptr if it was.
+const char* ReadCacheFile(CompileCacheEntry* entry) {
+  uv_fs_t req;
+  uv_file fd = uv_fs_open(nullptr,
+                          &req,
+                          entry->cache_filename.c_str(),
+                          O_RDONLY,
+                          0,
+                          nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0)
+    return uv_strerror(fd);
+  auto close_fd = OnScopeLeave([&]() {
+    uv_fs_close(nullptr, &req, fd, nullptr);
+    uv_fs_req_cleanup(&req);
+  });
+
+  CacheHeader header;
+  if (!ReadAll(fd, &header, sizeof(header), 0) || header.magic != kCacheMagic)
+    return "invalid header";
+  if (header.source_hash != entry->source_hash)
+    return "source changed";
+  if (header.size > CompileCacheHandler::kMaxCacheSize)
+    return "cache too large";
+
+  std::unique_ptr<uint8_t[]> data(new uint8_t[header.size]);
+  if (!ReadAll(fd, data.get(), header.size, sizeof(header)) ||
+      GetHash(data.get(), header.size) != header.data_hash) {
+    return "corrupted cache";
+  }
+  entry->data = std::move(data);
+  entry->size = header.size;
+  return nullptr;
+}
+
+}  // anonymous namespace
+
+ScriptCompiler::CachedData* CompileCacheEntry::CreateCachedData() const {
+  if (!data)
+    return nullptr;
+  return new ScriptCompiler::CachedData(
+      data.get(), static_cast<int>(size),
+      ScriptCompiler::CachedData::BufferNotOwned);
+}
+
+CompileCacheHandler::CompileCacheHandler(Environment* env) : env_(env) {}
+
+bool CompileCacheHandler::InitializeDirectory(const std::string& dir) {
+  std::string root =
+      IsAbsolutePath(dir) ? dir : env_->GetCwd() + kPathSeparator + dir;
+  // V8 rejects caches from other versions or with other flags anyway, so
+  // they are kept apart instead of overwriting each other.
+  char version[128];
+  snprintf(version,
+           sizeof(version),
+           "%s-%s-%08x",
+           per_process::metadata.versions.node.c_str(),
+           per_process::metadata.arch.c_str(),
+           ScriptCompiler::CachedDataVersionTag());
+  std::string cache_dir = root + kPathSeparator + version;
+
+  fs::FSReqWrapSync req_wrap_sync;
+  int err = fs::MKDirpSync(nullptr, &req_wrap_sync.req, cache_dir, 0777,
+                           nullptr);
+  if (err < 0 && err != UV_EEXIST) {
+    char err_buf[128];
+    uv_err_name_r(err, err_buf, sizeof(err_buf));
+    fprintf(stderr,
+            "%s: Failed to create code cache directory %s\n",
+            err_buf,
+            cache_dir.c_str());
+    return false;
+  }
+  Debug(env_, DebugCategory::CODE_CACHE,
+        "Using code cache directory %s\n", cache_dir);
+  cache_dir_ = std::move(cache_dir);
+  return true;
+}
+
+std::unique_ptr<CompileCacheEntry> CompileCacheHandler::Get(
+    Local<String> filename, Local<String> code, CachedCodeType type) {
+  Isolate* isolate = env_->isolate();
+  Utf8Value filename_utf8(isolate, filename);
+  uint32_t key = GetHash(*filename_utf8, filename_utf8.length());
+  key = GetHash(&type, sizeof(type), key);
+  char name[16];
+  snprintf(name, sizeof(name), "%08x", key);
+
+  auto entry = std::make_unique<CompileCacheEntry>();
+  entry->cache_filename = cache_dir_ + kPathSeparator + name;
+  entry->source_hash = GetSourceHash(isolate, code);
+  entry->type = type;
+
+  const char* reason = ReadCacheFile(entry.get());
+  if (reason == nullptr) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "Read %d bytes of code cache for %s from %s\n",
+          entry->size, *filename_utf8, entry->cache_filename);
+  } else {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "No code cache for %s in %s: %s\n",
+          *filename_utf8, entry->cache_filename, reason);
+  }
+  return entry;
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Function> fn,
+                                    bool rejected) {
+  if (entry->data && !rejected)
+    return;
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      ScriptCompiler::CreateCodeCacheForFunction(fn));
+  Save(entry, cached_data.get());
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Module> module,
+                                    bool rejected) {
+  if (entry->data && !rejected)
+    return;
+  std::unique_ptr<ScriptCompiler::CachedData> cached_data(
+      ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+  Save(entry, cached_data.get());
+}
+
+void CompileCacheHandler::Save(
+    CompileCacheEntry* entry, const ScriptCompiler::CachedData* cached_data) {
+  if (cached_data == nullptr || cached_data->length <= 0 ||
+      static_cast<size_t>(cached_data->length) > kMaxCacheSize) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "Not writing code cache to %s\n", entry->cache_filename);
+    return;
+  }
+
+  CacheHeader header;
+  header.magic = kCacheMagic;
+  header.source_hash = entry->source_hash;
+  header.size = cached_data->length;
+  header.data_hash = GetHash(cached_data->data, cached_data->length);
+
+  // The cache is written to a temporary file that is then renamed, so that
+  // other processes that use the same directory never read a partial entry.
+  char suffix[64];
+  snprintf(suffix, sizeof(suffix), ".%d.%" PRIu64 ".tmp",
+           uv_os_getpid(), env_->thread_id());
+  std::string temp_filename = entry->cache_filename + suffix;
+
+  uv_fs_t req;
+  uv_file fd = uv_fs_open(nullptr,
+                          &req,
+                          temp_filename.c_str(),
+                          O_WRONLY | O_CREAT | O_TRUNC,
+                          S_IWUSR | S_IRUSR,
+                          nullptr);
+  uv_fs_req_cleanup(&req);
+  int err = fd;
+  if (fd >= 0) {
+    uv_buf_t bufs[] = {
+      uv_buf_init(reinterpret_cast<char*>(&header), sizeof(header)),
+      uv_buf_init(
+          const_cast<char*>(reinterpret_cast<const char*>(cached_data->data)),
+          cached_data->length),
+    };
+    err = uv_fs_write(nullptr, &req, fd, bufs, arraysize(bufs), 0, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err >= 0 &&
+        static_cast<size_t>(err) != sizeof(header) + header.size) {
+      err = UV_EIO;
+    }
+    int close_err = uv_fs_close(nullptr, &req, fd, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err >= 0)
+      err = close_err;
+    if (err >= 0) {
+      err = uv_fs_rename(nullptr,
+                         &req,
+                         temp_filename.c_str(),
+                         entry->cache_filename.c_str(),
+                         nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+    if (err < 0) {
+      uv_fs_unlink(nullptr, &req, temp_filename.c_str(), nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  if (err < 0) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "Failed to write code cache to %s: %s\n",
+          entry->cache_filename, uv_strerror(err));
+  } else {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "Wrote %d bytes of code cache to %s\n",
+          header.size, entry->cache_filename);
+  }
+}
+
+namespace per_process {
+VMCompileCache vm_compile_cache;
+}  // namespace per_process
+
+namespace {
+
+// Appends the length, the encoding and the characters of the string, so that
+// the keys of different lists of strings never collide.
+void AppendString(Isolate* isolate, Local<String> string, std::string* key) {
+  uint32_t length = string->Length();
+  bool one_byte = string->IsOneByte();
+  key->append(reinterpret_cast<const char*>(&length), sizeof(length));
+  key->push_back(one_byte ? 1 : 2);
+  size_t offset = key->size();
+  if (one_byte) {
+    key->resize(offset + length);
+    string->WriteOneByte(isolate,
+                         reinterpret_cast<uint8_t*>(&(*key)[offset]),
+                         0,
+                         length,
+                         String::NO_NULL_TERMINATION);
+  } else {
+    key->resize(offset + length * sizeof(uint16_t));
+    MaybeStackBuffer<uint16_t> buf(length);
+    string->Write(isolate, *buf, 0, length, String::NO_NULL_TERMINATION);
+    memcpy(&(*key)[offset], *buf, length * sizeof(uint16_t));
+  }
+}
+
+}  // anonymous namespace
+
+std::string VMCompileCache::GetKey(Isolate* isolate,
+                                   CachedCodeType type,
+                                   Local<String> filename,
+                                   Local<String> code,
+                                   const std::vector<Local<String>>& params) {
+  std::string key(1, static_cast<char>(type));
+  key.push_back(filename.IsEmpty() ? 0 : 1);
+  if (!filename.IsEmpty())
+    AppendString(isolate, filename, &key);
+  uint32_t param_count = params.size();
+  key.append(reinterpret_cast<const char*>(&param_count),
+             sizeof(param_count));
+  for (Local<String> param : params)
+    AppendString(isolate, param, &key);
+  AppendString(isolate, code, &key);
+  return key;
+}
+
+VMCompileCache::Data VMCompileCache::Get(const std::string& key) {
+  Mutex::ScopedLock lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return nullptr;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->second;
+}
+
+void VMCompileCache::EvictUntil(size_t size) {
+  while (!lru_.empty() && statistics_.size > size) {
+    const auto& entry = lru_.back();
+    statistics_.size -= entry.first.size() + entry.second->size();
+    statistics_.entries--;
+    entries_.erase(entry.first);
+    lru_.pop_back();
+  }
+}
+
+ScriptCompiler::CachedData* VMCompileCache::CreateCachedData(
+    const Data& data) {
+  return new ScriptCompiler::CachedData(
+      data->data(), static_cast<int>(data->size()),
+      ScriptCompiler::CachedData::BufferNotOwned);
+}
+
+void VMCompileCache::RecordHit() {
+  Mutex::ScopedLock lock(mutex_);
+  statistics_.hits++;
+}
+
+void VMCompileCache::RecordMiss(const std::string& key,
+                                const ScriptCompiler::CachedData* cached_data,
+                                bool rejected) {
+  Data data;
+  if (cached_data != nullptr && cached_data->length > 0) {
+    data = std::make_shared<const std::vector<uint8_t>>(
+        cached_data->data, cached_data->data + cached_data->length);
+  }
+
+  Mutex::ScopedLock lock(mutex_);
+  statistics_.misses++;
+  if (rejected)
+    statistics_.rejections++;
+  if (!data)
+    return;
+
+  size_t size = key.size() + data->size();
+  if (size > kMaxSize)
+    return;
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    // Another thread compiled the same code in the meantime, or V8 rejected
+    // the entry, e.g. because the thread that compiled it used other flags.
+    // Threads that still use the old data keep it alive.
+    statistics_.size -= it->second->second->size();
+    statistics_.size += data->size();
+    it->second->second = std::move(data);
+    lru_.splice(lru_.begin(), lru_, it->second);
+  } else {
+    lru_.emplace_front(key, std::move(data));
+    entries_.emplace(key, lru_.begin());
+    statistics_.size += size;
+    statistics_.entries++;
+  }
+  EvictUntil(kMaxSize);
+}
+
+VMCompileCache::Statistics VMCompileCache::GetStatistics() {
+  Mutex::ScopedLock lock(mutex_);
+  return statistics_;
+}
+
+}  // namespace node
@@ -0,0 +1,150 @@
+#ifndef SRC_COMPILE_CACHE_H_
+#define SRC_COMPILE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "node_mutex.h"
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+enum class CachedCodeType : uint8_t {
+  kCommonJS = 0,
+  kESM,
+  kVMScript,
+  kVMFunction,
+};
+
+struct CompileCacheEntry {
+  std::string cache_filename;
+  uint32_t source_hash;
+  CachedCodeType type;
+  // The code cache that was read from the disk, if there is a valid one.
+  std::unique_ptr<uint8_t[]> data;
+  size_t size = 0;
+
+  // ScriptCompiler::Source takes ownership of the CachedData that it is
+  // given, so this returns a new one that refers to `data` without owning it.
+  // Returns nullptr if there is no cache to consume.
+  v8::ScriptCompiler::CachedData* CreateCachedData() const;
+};
+
+// An on-disk cache of the code that V8 compiles for the CommonJS and ES
+// modules of the application, enabled with --code-cache-dir. The entries
+// are keyed by the filename or URL of the module and verified against a hash
+// of its source, and are kept in a subdirectory that is specific to the
+// versions of Node.js and V8 and to the V8 flags, so that a cache that V8
+// cannot use is never read.
+class CompileCacheHandler {
+ public:
+  explicit CompileCacheHandler(Environment* env);
+
+  // Creates the subdirectory of `dir` that the entries are kept in.
+  bool InitializeDirectory(const std::string& dir);
+
+  // Returns the entry for the source. Its data is only set if a cache for
+  // that exact source was found.
+  std::unique_ptr<CompileCacheEntry> Get(v8::Local<v8::String> filename,
+                                         v8::Local<v8::String> code,
+                                         CachedCodeType type);
+  // Writes a new cache for the entry if it did not have one, or if the one
+  // that it had was rejected by V8.
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Function> fn,
+                 bool rejected);
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Module> module,
+                 bool rejected);
+
+  // Caches larger than this are neither read nor written.
+  static constexpr size_t kMaxCacheSize = 64 * 1024 * 1024;
+
+  const std::string& cache_dir() const { return cache_dir_; }
+
+ private:
+  void Save(CompileCacheEntry* entry,
+            const v8::ScriptCompiler::CachedData* cached_data);
+
+  Environment* env_;
+  std::string cache_dir_;
+};
+
+// A cache of the code that V8 compiles for vm.Script, vm.compileFunction()
+// and the CommonJS and ES modules of the application, enabled with
+// --experimental-vm-compile-cache. It is shared by all the threads of the
+// process. The entries for vm.Script and vm.compileFunction() are keyed by the
+// exact source of the code (and the parameters of the functions), so that the
+// same code is only compiled once whatever the context or the filename that it
+// is compiled for. The entries for modules are keyed by their filename or URL
+// and their source. The least recently used entries are removed once the cache
+// holds more than kMaxSize bytes.
+class VMCompileCache {
+ public:
+  using Data = std::shared_ptr<const std::vector<uint8_t>>;
+
+  struct Statistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t rejections = 0;
+    size_t entries = 0;
+    size_t size = 0;
+  };
+
+  // `filename` is only part of the key if it is not empty.
+  static std::string GetKey(v8::Isolate* isolate,
+                            CachedCodeType type,
+                            v8::Local<v8::String> filename,
+                            v8::Local<v8::String> code,
+                            const std::vector<v8::Local<v8::String>>& params);
+
+  // Returns the code cache for the key, or nullptr if there is none. The
+  // returned data stays valid even if the entry is replaced in the meantime.
+  Data Get(const std::string& key);
+  // Like CompileCacheEntry::CreateCachedData(), the CachedData refers to
+  // `data` without owning it.
+  static v8::ScriptCompiler::CachedData* CreateCachedData(const Data& data);
+
+  // Records that the code cache returned by Get() was used.
+  void RecordHit();
+  // Records that the code for the key had to be compiled, because there was
+  // no code cache for it or because V8 rejected it, and keeps `cached_data`
+  // for the next time.
+  void RecordMiss(const std::string& key,
+                  const v8::ScriptCompiler::CachedData* cached_data,
+                  bool rejected);
+
+  Statistics GetStatistics();
+
+  static constexpr size_t kMaxSize = 64 * 1024 * 1024;
+
+ private:
+  using LRUList = std::list<std::pair<std::string, Data>>;
+
+  // Must be called with mutex_ held.
+  void EvictUntil(size_t size);
+
+  Mutex mutex_;
+  // Most recently used entries first.
+  LRUList lru_;
+  std::unordered_map<std::string, LRUList::iterator> entries_;
+  Statistics statistics_;
+};
+
+namespace per_process {
+extern VMCompileCache vm_compile_cache;
+}  // namespace per_process
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_COMPILE_CACHE_H_
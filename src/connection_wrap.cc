@@ -2,12 +2,15 @@
 
 #include "connect_wrap.h"
 #include "env-inl.h"
+#include "node_diagnostics_channel.h"
 #include "pipe_wrap.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "tcp_wrap.h"
 #include "util-inl.h"
 
+#include <type_traits>
+
 namespace node {
 
 using v8::Boolean;
@@ -18,6 +21,23 @@ using v8::Local;
 using v8::Object;
 using v8::Value;
 
+namespace {
+// Returns false if the accepted connection has to be closed before it is
+// passed to JS.
+inline bool AllowConnection(TCPWrap* server, TCPWrap* client) {
+  return server->AllowConnection(client);
+}
+
+inline bool AllowConnection(PipeWrap* server, PipeWrap* client) {
+  return true;
+}
+
+inline void OnAccepted(TCPWrap* client) {
+  client->ApplyBusyPoll();
+}
+
+inline void OnAccepted(PipeWrap* client) {}
+}  // namespace
 
 template <typename WrapType, typename UVType>
 ConnectionWrap<WrapType, UVType>::ConnectionWrap(Environment* env,
@@ -63,6 +83,12 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
     if (uv_accept(handle, client))
       return;
 
+    if (!AllowConnection(wrap_data, wrap)) {
+      wrap->Close();
+      return;
+    }
+    OnAccepted(wrap);
+
     // Successful accept. Call the onconnection callback in JavaScript land.
     client_handle = client_obj;
   } else {
@@ -100,6 +126,20 @@ void ConnectionWrap<WrapType, UVType>::AfterConnect(uv_connect_t* req,
     writable = uv_is_writable(req->handle) != 0;
   }
 
+  if (std::is_same<WrapType, TCPWrap>::value &&
+      diagnostics_channel::HasSubscribers(
+          env, diagnostics_channel::kNetTcpConnect)) {
+    Local<Object> message = Object::New(env->isolate());
+    USE(message->Set(env->context(),
+                     FIXED_ONE_BYTE_STRING(env->isolate(), "socket"),
+                     wrap->GetOwner()));
+    USE(message->Set(env->context(),
+                     env->status_string(),
+                     Integer::New(env->isolate(), status)));
+    diagnostics_channel::Publish(
+        env, diagnostics_channel::kNetTcpConnect, message);
+  }
+
   Local<Value> argv[5] = {
     Integer::New(env->isolate(), status),
     wrap->object(),
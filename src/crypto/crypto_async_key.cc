@@ -0,0 +1,229 @@
+#include "crypto/crypto_async_key.h"
+#include "env-inl.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+
+#include <openssl/ec.h>
+#include <openssl/rsa.h>
+
+#include <vector>
+
+namespace node {
+namespace crypto {
+
+namespace {
+thread_local std::shared_ptr<AsyncKeyOperation> pending_operation;
+thread_local DeferredCall* deferred_call = nullptr;
+
+using RsaPrivateFn = int (*)(int, const unsigned char*, unsigned char*, RSA*,
+                             int);
+using EcdsaSignFn = int (*)(int, const unsigned char*, int, unsigned char*,
+                            unsigned int*, const BIGNUM*, const BIGNUM*,
+                            EC_KEY*);
+
+// Runs an RSA private key operation of the default implementation in the
+// threadpool. The input and output are copied, because the buffers of the
+// handshake may not outlive a connection that is closed meanwhile.
+int RunRsaPrivate(RsaPrivateFn fn,
+                  int flen,
+                  const unsigned char* from,
+                  unsigned char* to,
+                  RSA* rsa,
+                  int padding) {
+  if (ASYNC_get_current_job() == nullptr)
+    return fn(flen, from, to, rsa, padding);
+
+  RSA_up_ref(rsa);
+  std::shared_ptr<RSA> key(rsa, RSA_free);
+  auto in = std::make_shared<std::vector<unsigned char>>(from, from + flen);
+  auto out = std::make_shared<std::vector<unsigned char>>(RSA_size(rsa));
+  int ret = AsyncKeyOperation::Run([=]() {
+    return fn(in->size(), in->data(), out->data(), key.get(), padding);
+  });
+  if (ret > 0)
+    memcpy(to, out->data(), ret);
+  return ret;
+}
+
+int AsyncRsaPrivateEncrypt(int flen,
+                           const unsigned char* from,
+                           unsigned char* to,
+                           RSA* rsa,
+                           int padding) {
+  return RunRsaPrivate(RSA_meth_get_priv_enc(RSA_PKCS1_OpenSSL()),
+                       flen, from, to, rsa, padding);
+}
+
+int AsyncRsaPrivateDecrypt(int flen,
+                           const unsigned char* from,
+                           unsigned char* to,
+                           RSA* rsa,
+                           int padding) {
+  return RunRsaPrivate(RSA_meth_get_priv_dec(RSA_PKCS1_OpenSSL()),
+                       flen, from, to, rsa, padding);
+}
+
+EcdsaSignFn DefaultEcdsaSign() {
+  EcdsaSignFn sign = nullptr;
+  EC_KEY_METHOD_get_sign(EC_KEY_OpenSSL(), &sign, nullptr, nullptr);
+  return sign;
+}
+
+int AsyncEcdsaSign(int type,
+                   const unsigned char* dgst,
+                   int dlen,
+                   unsigned char* sig,
+                   unsigned int* siglen,
+                   const BIGNUM* kinv,
+                   const BIGNUM* r,
+                   EC_KEY* eckey) {
+  EcdsaSignFn sign = DefaultEcdsaSign();
+  if (ASYNC_get_current_job() == nullptr || kinv != nullptr || r != nullptr)
+    return sign(type, dgst, dlen, sig, siglen, kinv, r, eckey);
+
+  EC_KEY_up_ref(eckey);
+  std::shared_ptr<EC_KEY> key(eckey, EC_KEY_free);
+  auto in = std::make_shared<std::vector<unsigned char>>(dgst, dgst + dlen);
+  auto out = std::make_shared<std::vector<unsigned char>>(ECDSA_size(eckey));
+  auto out_length = std::make_shared<unsigned int>(0);
+  int ret = AsyncKeyOperation::Run([=]() {
+    return sign(type, in->data(), in->size(), out->data(), out_length.get(),
+                nullptr, nullptr, key.get());
+  });
+  if (ret == 1) {
+    memcpy(sig, out->data(), *out_length);
+    *siglen = *out_length;
+  }
+  return ret;
+}
+
+const RSA_METHOD* AsyncRsaMethod() {
+  static RSA_METHOD* method = []() {
+    RSA_METHOD* method = RSA_meth_dup(RSA_PKCS1_OpenSSL());
+    CHECK_NOT_NULL(method);
+    CHECK_EQ(RSA_meth_set1_name(method, "Node.js async RSA method"), 1);
+    CHECK_EQ(RSA_meth_set_priv_enc(method, AsyncRsaPrivateEncrypt), 1);
+    CHECK_EQ(RSA_meth_set_priv_dec(method, AsyncRsaPrivateDecrypt), 1);
+    return method;
+  }();
+  return method;
+}
+
+const EC_KEY_METHOD* AsyncEcKeyMethod() {
+  static EC_KEY_METHOD* method = []() {
+    EC_KEY_METHOD* method = EC_KEY_METHOD_new(EC_KEY_OpenSSL());
+    CHECK_NOT_NULL(method);
+    int (*sign_setup)(EC_KEY*, BN_CTX*, BIGNUM**, BIGNUM**) = nullptr;
+    ECDSA_SIG* (*sign_sig)(const unsigned char*, int, const BIGNUM*,
+                           const BIGNUM*, EC_KEY*) = nullptr;
+    EC_KEY_METHOD_get_sign(method, nullptr, &sign_setup, &sign_sig);
+    EC_KEY_METHOD_set_sign(method, AsyncEcdsaSign, sign_setup, sign_sig);
+    return method;
+  }();
+  return method;
+}
+}  // anonymous namespace
+
+class AsyncKeyOperation::Work final : public ThreadPoolWork {
+ public:
+  Work(Environment* env,
+       std::shared_ptr<AsyncKeyOperation> operation,
+       std::function<void()> done)
+      : ThreadPoolWork(env, ThreadPoolWorkClass::kCrypto),
+        operation_(std::move(operation)),
+        done_(std::move(done)) {}
+
+  void DoThreadPoolWork() override {
+    operation_->result_ = operation_->fn_();
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<Work> self(this);
+    operation_->done_ = true;
+    done_();
+  }
+
+ private:
+  std::shared_ptr<AsyncKeyOperation> operation_;
+  std::function<void()> done_;
+};
+
+int AsyncKeyOperation::Run(std::function<int()> fn) {
+  if (ASYNC_get_current_job() == nullptr)
+    return fn();
+
+  auto operation = std::make_shared<AsyncKeyOperation>(std::move(fn));
+  CHECK(!pending_operation);
+  pending_operation = operation;
+  // The job can be resumed before the operation completed, if the handshake
+  // is driven again in the meantime.
+  while (!operation->done_) {
+    if (operation->cancelled_)
+      return -1;
+    CHECK_EQ(ASYNC_pause_job(), 1);
+  }
+  return operation->result_;
+}
+
+std::shared_ptr<AsyncKeyOperation> AsyncKeyOperation::TakePending() {
+  return std::move(pending_operation);
+}
+
+void AsyncKeyOperation::Schedule(Environment* env,
+                                 std::function<void()> done) {
+  (new Work(env, shared_from_this(), std::move(done)))->ScheduleWork();
+}
+
+void EnableAsyncPrivateKeys(SSL_CTX* ctx) {
+  ClearErrorOnReturn clear_error_on_return;
+  for (int rv = SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_FIRST);
+       rv == 1;
+       rv = SSL_CTX_set_current_cert(ctx, SSL_CERT_SET_NEXT)) {
+    EVP_PKEY* pkey = SSL_CTX_get0_privatekey(ctx);
+    if (pkey == nullptr)
+      continue;
+    // Keys of engines are left alone.
+    int id = EVP_PKEY_base_id(pkey);
+    if (id == EVP_PKEY_RSA || id == EVP_PKEY_RSA_PSS) {
+      if (RSA_get_method(EVP_PKEY_get0_RSA(pkey)) != RSA_PKCS1_OpenSSL())
+        continue;
+    } else if (id == EVP_PKEY_EC) {
+      if (EC_KEY_get_method(EVP_PKEY_get0_EC_KEY(pkey)) != EC_KEY_OpenSSL())
+        continue;
+    } else {
+      continue;
+    }
+
+    // The key can be shared with other contexts and KeyObjects, so the method
+    // is set on a copy of it. OpenSSL 1.1.1 has no EVP_PKEY_dup(), and
+    // PKCS#8 keeps the parameters of RSA-PSS keys.
+    PKCS8Pointer p8(EVP_PKEY2PKCS8(pkey));
+    if (!p8)
+      continue;
+    EVPKeyPointer copy(EVP_PKCS82PKEY(p8.get()));
+    if (!copy)
+      continue;
+    if (id == EVP_PKEY_EC)
+      EC_KEY_set_method(EVP_PKEY_get0_EC_KEY(copy.get()), AsyncEcKeyMethod());
+    else
+      RSA_set_method(EVP_PKEY_get0_RSA(copy.get()), AsyncRsaMethod());
+    // Replaces the key of the current certificate.
+    SSL_CTX_use_PrivateKey(ctx, copy.get());
+  }
+}
+
+void DeferToLoopStack(DeferredCall* call) {
+  CHECK_NULL(deferred_call);
+  deferred_call = call;
+  while (!call->done)
+    CHECK_EQ(ASYNC_pause_job(), 1);
+}
+
+DeferredCall* TakeDeferredCall() {
+  DeferredCall* call = deferred_call;
+  deferred_call = nullptr;
+  return call;
+}
+
+}  // namespace crypto
+}  // namespace node
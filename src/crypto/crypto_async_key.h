@@ -0,0 +1,106 @@
+#ifndef SRC_CRYPTO_CRYPTO_ASYNC_KEY_H_
+#define SRC_CRYPTO_CRYPTO_ASYNC_KEY_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "crypto/crypto_util.h"
+#include "env.h"
+#include "util.h"
+
+#include <openssl/async.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace node {
+namespace crypto {
+
+// Private key operations of contexts with the asyncPrivateKey option run in
+// the threadpool rather than on the event loop thread.
+//
+// OpenSSL 1.1.1 has no hook for asynchronous private key methods, so TLSWrap
+// instead runs the handshakes of these contexts in an OpenSSL async job (see
+// SSL_MODE_ASYNC). The RSA and EC key methods installed by
+// EnableAsyncPrivateKeys() pause the job, TLSWrap takes the pending
+// AsyncKeyOperation and schedules it, and it resumes the handshake once the
+// operation completed.
+class AsyncKeyOperation final
+    : public std::enable_shared_from_this<AsyncKeyOperation> {
+ public:
+  // Runs `fn` in the threadpool if called in an async job, and directly
+  // otherwise. Returns the result of `fn`.
+  static int Run(std::function<int()> fn);
+
+  // Returns the operation that paused the current async job, if any.
+  static std::shared_ptr<AsyncKeyOperation> TakePending();
+
+  // Calls `done` on the event loop thread once the operation completed.
+  void Schedule(Environment* env, std::function<void()> done);
+
+  // Makes Run() fail instead of waiting for the result, so that the job can
+  // end before its connection is freed.
+  void Cancel() { cancelled_ = true; }
+
+  explicit AsyncKeyOperation(std::function<int()> fn) : fn_(std::move(fn)) {}
+
+ private:
+  class Work;
+
+  std::function<int()> fn_;
+  int result_ = -1;
+  bool done_ = false;
+  bool cancelled_ = false;
+};
+
+// Makes the RSA and EC private keys of `ctx` use AsyncKeyOperation.
+void EnableAsyncPrivateKeys(SSL_CTX* ctx);
+
+// Async jobs run on a small stack of their own, which V8 cannot run on.
+// Callbacks that OpenSSL invokes during a handshake and that call into V8 use
+// RunOnLoopStack(), which pauses the job until TLSWrap took the call with
+// TakeDeferredCall() and ran it. A job that is cancelled is resumed with
+// `done` set but without running the call.
+struct DeferredCall {
+  std::function<void()> fn;
+  bool done = false;
+};
+
+void DeferToLoopStack(DeferredCall* call);
+DeferredCall* TakeDeferredCall();
+
+template <typename Fn>
+inline void RunOnLoopStack(Fn&& fn) {
+  if (LIKELY(ASYNC_get_current_job() == nullptr))
+    return fn();
+  DeferredCall call { std::forward<Fn>(fn) };
+  DeferToLoopStack(&call);
+}
+
+// Wraps an OpenSSL callback in RunOnLoopStack(), e.g.
+// OnLoopStack<decltype(KeylogCallback), KeylogCallback>::Call.
+template <typename Fn, Fn* fn>
+struct OnLoopStack;
+
+template <typename R, typename... Args, R (*fn)(Args...)>
+struct OnLoopStack<R(Args...), fn> {
+  static R Call(Args... args) {
+    R result {};
+    RunOnLoopStack([&]() { result = fn(args...); });
+    return result;
+  }
+};
+
+template <typename... Args, void (*fn)(Args...)>
+struct OnLoopStack<void(Args...), fn> {
+  static void Call(Args... args) {
+    RunOnLoopStack([&]() { fn(args...); });
+  }
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_CRYPTO_CRYPTO_ASYNC_KEY_H_
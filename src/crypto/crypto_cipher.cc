@@ -48,6 +48,143 @@ bool IsValidGCMTagLength(unsigned int tag_len) {
   return tag_len == 4 || tag_len == 8 || (tag_len >= 12 && tag_len <= 16);
 }
 
+void ThrowInvalidAuthTagLength(Environment* env, unsigned int tag_len) {
+  char msg[50];
+  snprintf(msg, sizeof(msg), "Invalid authentication tag length: %u", tag_len);
+  THROW_ERR_CRYPTO_INVALID_AUTH_TAG(env, msg);
+}
+
+// aeadSeal(cipher, key, iv, aad, plaintext, output, authTagLength) and
+// aeadOpen(cipher, key, iv, aad, ciphertext, output, authTagLength) process a
+// whole message in one call, without allocating. The ciphertext is followed
+// by the authentication tag. Both return the number of bytes written to
+// `output`, which may be the same memory as the input.
+template <bool encrypt>
+void AEADCipher(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  MarkPopErrorOnReturn mark_pop_error_on_return;
+
+  const Utf8Value cipher_type(env->isolate(), args[0]);
+  const EVP_CIPHER* const cipher = EVP_get_cipherbyname(*cipher_type);
+  if (cipher == nullptr)
+    return THROW_ERR_CRYPTO_UNKNOWN_CIPHER(env);
+  if (!IsSupportedAuthenticatedMode(cipher)) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s is not an AEAD cipher", *cipher_type);
+    return THROW_ERR_CRYPTO_UNSUPPORTED_OPERATION(env, msg);
+  }
+  const int mode = EVP_CIPHER_mode(cipher);
+
+  // The key is either a KeyObjectHandle or a byte source, which is used
+  // without copying it.
+  ArrayBufferOrViewContents<char> key_contents;
+  ByteSource key;
+  if (IsAnyByteSource(args[1])) {
+    key_contents = ArrayBufferOrViewContents<char>(args[1]);
+    key = ByteSource::Foreign(key_contents.data(), key_contents.size());
+  } else {
+    key = ByteSource::FromSymmetricKeyObjectHandle(args[1]);
+  }
+
+  ArrayBufferOrViewContents<unsigned char> iv(args[2]);
+  ArrayBufferOrViewContents<unsigned char> aad;
+  if (!args[3]->IsUndefined())
+    aad = ArrayBufferOrViewContents<unsigned char>(args[3]);
+  ArrayBufferOrViewContents<unsigned char> input(args[4]);
+  ArrayBufferOrViewContents<unsigned char> output(args[5]);
+  CHECK(args[6]->IsUint32());
+  const unsigned int tag_len = args[6].As<Uint32>()->Value();
+
+  if (UNLIKELY(key.size() > INT_MAX))
+    return THROW_ERR_OUT_OF_RANGE(env, "key is too big");
+  if (UNLIKELY(!iv.CheckSizeInt32()))
+    return THROW_ERR_OUT_OF_RANGE(env, "iv is too big");
+  if (UNLIKELY(!aad.CheckSizeInt32()))
+    return THROW_ERR_OUT_OF_RANGE(env, "aad is too big");
+  if (UNLIKELY(!input.CheckSizeInt32() ||
+               input.size() + (encrypt ? tag_len : 0) > INT_MAX)) {
+    return THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+  }
+
+  if (mode == EVP_CIPH_GCM_MODE && !IsValidGCMTagLength(tag_len))
+    return ThrowInvalidAuthTagLength(env, tag_len);
+  if (!encrypt && input.size() < tag_len)
+    return THROW_ERR_CRYPTO_INVALID_AUTH_TAG(env);
+  const size_t text_len = encrypt ? input.size() : input.size() - tag_len;
+  CHECK_GE(output.size(), encrypt ? text_len + tag_len : text_len);
+
+  // See CipherBase::InitIv().
+  if (EVP_CIPHER_nid(cipher) == NID_chacha20_poly1305 && iv.size() > 12)
+    return THROW_ERR_CRYPTO_INVALID_IV(env);
+
+  CipherCtxPointer ctx(EVP_CIPHER_CTX_new());
+  if (!ctx ||
+      !EVP_CipherInit_ex(ctx.get(), cipher, nullptr, nullptr, nullptr,
+                         encrypt)) {
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Failed to initialize cipher");
+  }
+
+  if (!EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_IVLEN, iv.size(),
+                           nullptr)) {
+    return THROW_ERR_CRYPTO_INVALID_IV(env);
+  }
+
+  // The length of GCM tags is only chosen when the tag is retrieved. All
+  // other tags are passed to OpenSSL ahead of the data when decrypting.
+  if (!encrypt || mode != EVP_CIPH_GCM_MODE) {
+    unsigned char* tag =
+        encrypt ? nullptr : const_cast<unsigned char*>(input.data()) + text_len;
+    if (!EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_TAG, tag_len, tag))
+      return ThrowInvalidAuthTagLength(env, tag_len);
+  }
+
+  if (!EVP_CIPHER_CTX_set_key_length(ctx.get(), key.size()))
+    return THROW_ERR_CRYPTO_INVALID_KEYLEN(env);
+
+  if (!EVP_CipherInit_ex(ctx.get(), nullptr, nullptr,
+                         key.data<unsigned char>(), iv.data(), encrypt)) {
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Failed to initialize cipher");
+  }
+
+  int len;
+  if (mode == EVP_CIPH_CCM_MODE &&
+      !EVP_CipherUpdate(ctx.get(), nullptr, &len, nullptr, text_len)) {
+    return THROW_ERR_CRYPTO_INVALID_MESSAGELEN(env);
+  }
+
+  unsigned char* out = output.data();
+  int out_len = 0;
+  bool ok = aad.size() == 0 ||
+            EVP_CipherUpdate(ctx.get(), nullptr, &len, aad.data(),
+                             aad.size()) == 1;
+  ok = ok && EVP_CipherUpdate(ctx.get(), out, &out_len, input.data(),
+                              text_len) == 1;
+  // In CCM mode, the tag is verified by the update and EVP_CipherFinal_ex()
+  // must not be called when decrypting.
+  if (ok && (encrypt || mode != EVP_CIPH_CCM_MODE)) {
+    ok = EVP_CipherFinal_ex(ctx.get(), out + out_len, &len) == 1;
+    out_len += len;
+  }
+
+  if (!ok) {
+    // Unauthenticated plaintext must not be used.
+    if (!encrypt)
+      OPENSSL_cleanse(out, text_len);
+    return ThrowCryptoError(env, ERR_get_error(), encrypt ?
+        "Unsupported state" :
+        "Unsupported state or unable to authenticate data");
+  }
+
+  if (encrypt) {
+    CHECK_EQ(1, EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_GET_TAG,
+                                    tag_len, out + out_len));
+    out_len += tag_len;
+  }
+
+  args.GetReturnValue().Set(out_len);
+}
 // Collects and returns information on the given cipher
 void GetCipherInfo(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -289,6 +426,9 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
 
   env->SetMethodNoSideEffect(target, "getCipherInfo", GetCipherInfo);
 
+  env->SetMethod(target, "aeadSeal", AEADCipher<true>);
+  env->SetMethod(target, "aeadOpen", AEADCipher<false>);
+
   NODE_DEFINE_CONSTANT(target, kWebCryptoCipherEncrypt);
   NODE_DEFINE_CONSTANT(target, kWebCryptoCipherDecrypt);
 }
@@ -882,18 +1022,19 @@ bool PublicKeyCipher::Cipher(
     const ArrayBufferOrViewContents<unsigned char>& oaep_label,
     const ArrayBufferOrViewContents<unsigned char>& data,
     AllocatedBuffer* out) {
-  EVPKeyCtxPointer ctx(EVP_PKEY_CTX_new(pkey.get(), nullptr));
+  // The context is copied from one that is cached on the key, see
+  // ManagedEVPPKey::NewCtx(). OAEP labels are set on the copy.
+  KeyCtxParams params;
+  params.init = EVP_PKEY_cipher_init;
+  params.md = digest;
+  params.padding = padding;
+  EVPKeyCtxPointer ctx = pkey.NewCtx(params, [&](EVP_PKEY_CTX* ctx) {
+    if (EVP_PKEY_CTX_set_rsa_padding(ctx, padding) <= 0)
+      return false;
+    return digest == nullptr || EVP_PKEY_CTX_set_rsa_oaep_md(ctx, digest) > 0;
+  });
   if (!ctx)
     return false;
-  if (EVP_PKEY_cipher_init(ctx.get()) <= 0)
-    return false;
-  if (EVP_PKEY_CTX_set_rsa_padding(ctx.get(), padding) <= 0)
-    return false;
-
-  if (digest != nullptr) {
-    if (EVP_PKEY_CTX_set_rsa_oaep_md(ctx.get(), digest) <= 0)
-      return false;
-  }
 
   if (oaep_label.size() != 0) {
     // OpenSSL takes ownership of the label, so we need to create a copy.
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace node {
 
@@ -424,11 +425,18 @@ StackOfX509 CloneSSLCerts(X509Pointer&& cert,
   return peer_certs;
 }
 
+MaybeLocal<Object> PeerCertToObject(Environment* env,
+                                    X509* cert,
+                                    X509ObjectCache* cache) {
+  return cache != nullptr ? cache->Get(env, cert) : X509ToObject(env, cert);
+}
+
 MaybeLocal<Object> AddIssuerChainToObject(
     X509Pointer* cert,
     Local<Object> object,
     StackOfX509&& peer_certs,
-    Environment* const env) {
+    Environment* const env,
+    X509ObjectCache* cache) {
   Local<Context> context = env->isolate()->GetCurrentContext();
   cert->reset(sk_X509_delete(peer_certs.get(), 0));
   for (;;) {
@@ -439,7 +447,7 @@ MaybeLocal<Object> AddIssuerChainToObject(
         continue;
 
       Local<Object> ca_info;
-      MaybeLocal<Object> maybe_ca_info = X509ToObject(env, ca);
+      MaybeLocal<Object> maybe_ca_info = PeerCertToObject(env, ca, cache);
       if (!maybe_ca_info.ToLocal(&ca_info))
         return MaybeLocal<Object>();
 
@@ -464,7 +472,8 @@ MaybeLocal<Object> GetLastIssuedCert(
     X509Pointer* cert,
     const SSLPointer& ssl,
     Local<Object> issuer_chain,
-    Environment* const env) {
+    Environment* const env,
+    X509ObjectCache* cache) {
   Local<Context> context = env->isolate()->GetCurrentContext();
   while (X509_check_issued(cert->get(), cert->get()) != X509_V_OK) {
     X509* ca;
@@ -472,7 +481,7 @@ MaybeLocal<Object> GetLastIssuedCert(
       break;
 
     Local<Object> ca_info;
-    MaybeLocal<Object> maybe_ca_info = X509ToObject(env, ca);
+    MaybeLocal<Object> maybe_ca_info = PeerCertToObject(env, ca, cache);
     if (!maybe_ca_info.ToLocal(&ca_info))
       return MaybeLocal<Object>();
 
@@ -888,7 +897,8 @@ MaybeLocal<Value> GetPeerCert(
     Environment* env,
     const SSLPointer& ssl,
     bool abbreviated,
-    bool is_server) {
+    bool is_server,
+    X509ObjectCache* cache) {
   ClearErrorOnReturn clear_error_on_return;
   Local<Object> result;
   MaybeLocal<Object> maybe_cert;
@@ -902,8 +912,8 @@ MaybeLocal<Value> GetPeerCert(
 
   // Short result requested.
   if (abbreviated) {
-    maybe_cert =
-        X509ToObject(env, cert ? cert.get() : sk_X509_value(ssl_certs, 0));
+    maybe_cert = PeerCertToObject(
+        env, cert ? cert.get() : sk_X509_value(ssl_certs, 0), cache);
     return maybe_cert.ToLocal(&result) ? result : MaybeLocal<Value>();
   }
 
@@ -914,7 +924,7 @@ MaybeLocal<Value> GetPeerCert(
   // First and main certificate.
   X509Pointer first_cert(sk_X509_value(peer_certs.get(), 0));
   CHECK(first_cert);
-  maybe_cert = X509ToObject(env, first_cert.release());
+  maybe_cert = PeerCertToObject(env, first_cert.release(), cache);
   if (!maybe_cert.ToLocal(&result))
     return MaybeLocal<Value>();
 
@@ -926,7 +936,8 @@ MaybeLocal<Value> GetPeerCert(
           &cert,
           result,
           std::move(peer_certs),
-          env);
+          env,
+          cache);
   if (!maybe_issuer_chain.ToLocal(&issuer_chain))
     return MaybeLocal<Value>();
 
@@ -935,7 +946,8 @@ MaybeLocal<Value> GetPeerCert(
           &cert,
           ssl,
           issuer_chain,
-          env);
+          env,
+          cache);
 
   issuer_chain.Clear();
   if (!maybe_issuer_chain.ToLocal(&issuer_chain))
@@ -1091,5 +1103,76 @@ MaybeLocal<Object> X509ToObject(Environment* env, X509* cert) {
   return scope.Escape(info);
 }
 
+constexpr size_t X509ObjectCache::kMaxEntries;
+
+MaybeLocal<Object> X509ObjectCache::Get(Environment* env, X509* cert) {
+  unsigned char md[EVP_MAX_MD_SIZE];
+  unsigned int md_size;
+  if (!X509_digest(cert, EVP_sha256(), md, &md_size))
+    return X509ToObject(env, cert);
+
+  EscapableHandleScope scope(env->isolate());
+  Local<Context> context = env->context();
+  std::string fingerprint(reinterpret_cast<char*>(md), md_size);
+
+  Local<Object> object;
+  auto it = index_.find(fingerprint);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    object = it->second->object.Get(env->isolate());
+  } else {
+    if (!X509ToObject(env, cert).ToLocal(&object))
+      return MaybeLocal<Object>();
+    if (entries_.size() == kMaxEntries) {
+      index_.erase(entries_.back().fingerprint);
+      entries_.pop_back();
+    }
+    entries_.push_front(
+        Entry { fingerprint, v8::Global<Object>(env->isolate(), object) });
+    index_.emplace(std::move(fingerprint), entries_.begin());
+  }
+
+  // The cached object itself is never handed out. Its strings and numbers
+  // are immutable, but the buffers and the array are copied so that no
+  // caller can modify what another one sees.
+  Local<Object> copy = object->Clone();
+  for (Local<String> key : { env->raw_string(), env->pubkey_string() }) {
+    Local<Value> value;
+    if (!copy->Get(context, key).ToLocal(&value))
+      return MaybeLocal<Object>();
+    if (!value->IsArrayBufferView())
+      continue;
+    ArrayBufferViewContents<char> contents(value);
+    Local<Object> buffer;
+    if (!Buffer::Copy(env, contents.data(), contents.length())
+             .ToLocal(&buffer) ||
+        !Set<Object>(context, copy, key, buffer)) {
+      return MaybeLocal<Object>();
+    }
+  }
+
+  Local<Value> usage;
+  if (!copy->Get(context, env->ext_key_usage_string()).ToLocal(&usage))
+    return MaybeLocal<Object>();
+  if (usage->IsArray()) {
+    Local<Array> array = usage.As<Array>();
+    std::vector<Local<Value>> elements(array->Length());
+    for (uint32_t i = 0; i < elements.size(); i++) {
+      if (!array->Get(context, i).ToLocal(&elements[i]))
+        return MaybeLocal<Object>();
+    }
+    Local<Array> usage_copy =
+        Array::New(env->isolate(), elements.data(), elements.size());
+    if (!Set<Object>(context, copy, env->ext_key_usage_string(), usage_copy))
+      return MaybeLocal<Object>();
+  }
+
+  return scope.Escape(copy);
+}
+
+void X509ObjectCache::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("entries", entries_.size() * sizeof(Entry));
+}
+
 }  // namespace crypto
 }  // namespace node
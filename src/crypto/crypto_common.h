@@ -8,6 +8,7 @@
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
 
+#include <list>
 #include <string>
 #include <unordered_map>
 
@@ -107,11 +108,38 @@ v8::MaybeLocal<v8::Object> GetEphemeralKey(
     Environment* env,
     const SSLPointer& ssl);
 
+// Caches the objects that X509ToObject() creates for the peer certificates of
+// the connections of a SecureContext, keyed by their SHA-256 fingerprint.
+// Peers that connect repeatedly present the same certificates, which then are
+// only converted once. The least recently used entries are evicted first.
+class X509ObjectCache final : public MemoryRetainer {
+ public:
+  static constexpr size_t kMaxEntries = 4096;
+
+  // Returns a copy of the object for `cert`, which the caller may modify.
+  v8::MaybeLocal<v8::Object> Get(Environment* env, X509* cert);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(X509ObjectCache)
+  SET_SELF_SIZE(X509ObjectCache)
+
+ private:
+  struct Entry {
+    std::string fingerprint;
+    v8::Global<v8::Object> object;
+  };
+
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+};
+
 v8::MaybeLocal<v8::Value> GetPeerCert(
     Environment* env,
     const SSLPointer& ssl,
     bool abbreviated = false,
-    bool is_server = false);
+    bool is_server = false,
+    X509ObjectCache* cache = nullptr);
 
 v8::MaybeLocal<v8::Object> ECPointToBuffer(
     Environment* env,
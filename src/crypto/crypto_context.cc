@@ -1,4 +1,5 @@
 #include "crypto/crypto_context.h"
+#include "crypto/crypto_async_key.h"
 #include "crypto/crypto_bio.h"
 #include "crypto/crypto_common.h"
 #include "crypto/crypto_util.h"
@@ -36,6 +37,7 @@ using v8::PropertyAttribute;
 using v8::ReadOnly;
 using v8::Signature;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace crypto {
@@ -281,6 +283,8 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
 #endif  // !OPENSSL_NO_ENGINE
   env->SetProtoMethodNoSideEffect(t, "getTicketKeys", GetTicketKeys);
   env->SetProtoMethod(t, "setTicketKeys", SetTicketKeys);
+  env->SetProtoMethod(t, "setSessionStore", SetSessionStore);
+  env->SetProtoMethod(t, "enableAsyncPrivateKey", EnableAsyncPrivateKey);
   env->SetProtoMethod(t, "setFreeListLength", SetFreeListLength);
   env->SetProtoMethod(t, "enableTicketKeyCallback", EnableTicketKeyCallback);
   env->SetProtoMethodNoSideEffect(t, "getCertificate", GetCertificate<true>);
@@ -334,12 +338,20 @@ inline void SecureContext::Reset() {
   ctx_.reset();
   cert_.reset();
   issuer_.reset();
+  session_store_.reset();
+  peer_certificate_cache_.reset();
 }
 
 SecureContext::~SecureContext() {
   Reset();
 }
 
+X509ObjectCache* SecureContext::peer_certificate_cache() {
+  if (!peer_certificate_cache_)
+    peer_certificate_cache_ = std::make_unique<X509ObjectCache>();
+  return peer_certificate_cache_.get();
+}
+
 void SecureContext::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   new SecureContext(env, args.This());
@@ -1014,6 +1026,8 @@ void SecureContext::GetTicketKeys(const FunctionCallbackInfo<Value>& args) {
   if (!Buffer::New(wrap->env(), 48).ToLocal(&buff))
     return;
 
+  wrap->LoadTicketKeysFromStore();
+
   memcpy(Buffer::Data(buff), wrap->ticket_key_name_, 16);
   memcpy(Buffer::Data(buff) + 16, wrap->ticket_key_hmac_, 16);
   memcpy(Buffer::Data(buff) + 32, wrap->ticket_key_aes_, 16);
@@ -1037,10 +1051,59 @@ void SecureContext::SetTicketKeys(const FunctionCallbackInfo<Value>& args) {
   memcpy(wrap->ticket_key_hmac_, buf.data() + 16, 16);
   memcpy(wrap->ticket_key_aes_, buf.data() + 32, 16);
 
+  // Share the new keys with every context that uses the same store.
+  if (wrap->session_store_) {
+    wrap->session_store_->SetTicketKeys(
+        reinterpret_cast<const unsigned char*>(buf.data()));
+  }
+
   args.GetReturnValue().Set(true);
 #endif  // !def(OPENSSL_NO_TLSEXT) && def(SSL_CTX_get_tlsext_ticket_keys)
 }
 
+void SecureContext::SetSessionStore(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+
+  CHECK_EQ(args.Length(), 2);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsUint32());
+
+  const Utf8Value name(env->isolate(), args[0]);
+  int err = 0;
+  std::shared_ptr<SessionStore> store =
+      SessionStore::Open(*name, args[1].As<Uint32>()->Value(), &err);
+  if (!store)
+    return env->ThrowErrnoException(err, "shm_open", nullptr, *name);
+
+  sc->session_store_ = std::move(store);
+  sc->LoadTicketKeysFromStore();
+}
+
+void SecureContext::LoadTicketKeysFromStore() {
+  if (!session_store_)
+    return;
+  unsigned char keys[SessionStore::kTicketKeysLength];
+  session_store_->GetTicketKeys(keys);
+  memcpy(ticket_key_name_, keys, 16);
+  memcpy(ticket_key_hmac_, keys + 16, 16);
+  memcpy(ticket_key_aes_, keys + 32, 16);
+}
+
+void SecureContext::EnableAsyncPrivateKey(
+    const FunctionCallbackInfo<Value>& args) {
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+
+  // Without support for async jobs, private key operations stay synchronous.
+  if (ASYNC_is_capable() != 1)
+    return;
+
+  EnableAsyncPrivateKeys(sc->ctx_.get());
+  sc->async_private_key_ = true;
+}
+
 void SecureContext::SetFreeListLength(const FunctionCallbackInfo<Value>& args) {
 }
 
@@ -1051,7 +1114,9 @@ void SecureContext::EnableTicketKeyCallback(
   SecureContext* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
 
-  SSL_CTX_set_tlsext_ticket_key_cb(wrap->ctx_.get(), TicketKeyCallback);
+  SSL_CTX_set_tlsext_ticket_key_cb(
+      wrap->ctx_.get(),
+      (OnLoopStack<decltype(TicketKeyCallback), TicketKeyCallback>::Call));
 }
 
 int SecureContext::TicketKeyCallback(SSL* ssl,
@@ -1164,6 +1229,9 @@ int SecureContext::TicketCompatibilityCallback(SSL* ssl,
   SecureContext* sc = static_cast<SecureContext*>(
       SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
 
+  // The keys may have been rotated through another context.
+  sc->LoadTicketKeysFromStore();
+
   if (enc) {
     memcpy(name, sc->ticket_key_name_, sizeof(sc->ticket_key_name_));
     if (RAND_bytes(iv, 16) <= 0 ||
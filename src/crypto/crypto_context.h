@@ -3,12 +3,15 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "crypto/crypto_session_store.h"
 #include "crypto/crypto_util.h"
 #include "base_object.h"
 #include "env.h"
 #include "memory_tracker.h"
 #include "v8.h"
 
+#include <memory>
+
 namespace node {
 namespace crypto {
 // A maxVersion of 0 means "any", but OpenSSL may support TLS versions that
@@ -25,6 +28,8 @@ X509_STORE* NewRootCertStore();
 
 BIOPointer LoadBIO(Environment* env, v8::Local<v8::Value> v);
 
+class X509ObjectCache;
+
 class SecureContext final : public BaseObject {
  public:
   using GetSessionCb = SSL_SESSION* (*)(SSL*, const unsigned char*, int, int*);
@@ -47,6 +52,10 @@ class SecureContext final : public BaseObject {
   void SetNewSessionCallback(NewSessionCb cb);
   void SetSelectSNIContextCallback(SelectSNIContextCb cb);
 
+  SessionStore* session_store() const { return session_store_.get(); }
+  bool async_private_key() const { return async_private_key_; }
+  X509ObjectCache* peer_certificate_cache();
+
   // TODO(joyeecheung): track the memory used by OpenSSL types
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SecureContext)
@@ -73,6 +82,16 @@ class SecureContext final : public BaseObject {
   unsigned char ticket_key_aes_[16];
   unsigned char ticket_key_hmac_[16];
 
+  // Set by setSessionStore(). Server sessions are stored in it, and the
+  // ticket keys above are kept in sync with the ones in the store.
+  std::shared_ptr<SessionStore> session_store_;
+
+  // Set by enableAsyncPrivateKey(), see crypto_async_key.h.
+  bool async_private_key_ = false;
+
+  // Created on first use by TLSWrap::GetPeerCertificate().
+  std::unique_ptr<X509ObjectCache> peer_certificate_cache_;
+
  protected:
   // OpenSSL structures are opaque. This is sizeof(SSL_CTX) for OpenSSL 1.1.1b:
   static const int64_t kExternalSize = 1024;
@@ -109,6 +128,9 @@ class SecureContext final : public BaseObject {
 #endif  // !OPENSSL_NO_ENGINE
   static void GetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetTicketKeys(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetSessionStore(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableAsyncPrivateKey(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetFreeListLength(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableTicketKeyCallback(
@@ -134,6 +156,7 @@ class SecureContext final : public BaseObject {
 
   SecureContext(Environment* env, v8::Local<v8::Object> wrap);
   void Reset();
+  void LoadTicketKeysFromStore();
 };
 
 }  // namespace crypto
@@ -6,14 +6,19 @@
 #include "memory_tracker-inl.h"
 #include "string_bytes.h"
 #include "threadpoolwork-inl.h"
+#include "uv.h"
 #include "v8.h"
 
 #include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace node {
 
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Int32;
 using v8::Just;
 using v8::Local;
 using v8::Maybe;
@@ -21,6 +26,7 @@ using v8::MaybeLocal;
 using v8::Nothing;
 using v8::Object;
 using v8::Uint32;
+using v8::Undefined;
 using v8::Value;
 
 namespace crypto {
@@ -53,8 +59,10 @@ void Hash::Initialize(Environment* env, Local<Object> target) {
   env->SetConstructorFunction(target, "Hash", t);
 
   env->SetMethodNoSideEffect(target, "getHashes", GetHashes);
+  env->SetMethodNoSideEffect(target, "oneShotDigest", OneShotDigest);
 
   HashJob::Initialize(env, target);
+  HashFileJob::Initialize(env, target);
 }
 
 void Hash::New(const FunctionCallbackInfo<Value>& args) {
@@ -193,6 +201,146 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(rc.FromMaybe(Local<Value>()));
 }
 
+namespace {
+// Digests computed by OneShotDigest() reuse a per-thread EVP_MD_CTX, so that
+// hashing many small inputs does not allocate a context (or the digest's
+// internal state, which OpenSSL keeps as long as the digest does not change)
+// per call. Digest lookups by name take a global lock in OpenSSL, so their
+// results are cached as well.
+struct OneShotDigestState {
+  EVPMDPointer mdctx;
+  std::unordered_map<std::string, const EVP_MD*> digests;
+};
+
+thread_local OneShotDigestState one_shot_digest_state;
+
+const EVP_MD* GetOneShotDigest(const char* name) {
+  auto& digests = one_shot_digest_state.digests;
+  auto it = digests.find(name);
+  if (it != digests.end())
+    return it->second;
+  const EVP_MD* md = EVP_get_digestbyname(name);
+  if (md != nullptr)
+    digests.emplace(name, md);
+  return md;
+}
+}  // anonymous namespace
+
+// oneShotDigest(algorithm, data, outputEncoding) computes the digest of a
+// string (as UTF-8) or ArrayBufferView without creating a Hash object.
+void Hash::OneShotDigest(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_EQ(args.Length(), 3);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString() || IsAnyByteSource(args[1]));
+
+  const Utf8Value hash_type(env->isolate(), args[0]);
+  const EVP_MD* md = GetOneShotDigest(*hash_type);
+  if (md == nullptr)
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Digest method not supported");
+
+  enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  EVPMDPointer& mdctx = one_shot_digest_state.mdctx;
+  if (!mdctx)
+    mdctx.reset(EVP_MD_CTX_new());
+  if (!mdctx || EVP_DigestInit_ex(mdctx.get(), md, nullptr) <= 0) {
+    mdctx.reset();
+    return ThrowCryptoError(env, ERR_get_error(),
+                            "Digest method not supported");
+  }
+
+  int ret;
+  if (args[1]->IsString()) {
+    const Utf8Value data(env->isolate(), args[1]);
+    ret = EVP_DigestUpdate(mdctx.get(), *data, data.length());
+  } else {
+    ArrayBufferOrViewContents<char> data(args[1]);
+    if (UNLIKELY(!data.CheckSizeInt32()))
+      return THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+    ret = EVP_DigestUpdate(mdctx.get(), data.data(), data.size());
+  }
+
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  unsigned int md_len = 0;
+  if (ret != 1 ||
+      EVP_DigestFinal_ex(mdctx.get(), md_value, &md_len) != 1) {
+    return ThrowCryptoError(env, ERR_get_error());
+  }
+
+  Local<Value> error;
+  MaybeLocal<Value> rc =
+      StringBytes::Encode(env->isolate(),
+                          reinterpret_cast<const char*>(md_value),
+                          md_len,
+                          encoding,
+                          &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    env->isolate()->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(rc.FromMaybe(Local<Value>()));
+}
+
+namespace {
+// Finishes the digest of `ctx` with an output of `length` bytes, which may
+// differ from the default for XOFs.
+bool FinishDigest(EVP_MD_CTX* ctx, unsigned int length, ByteSource* out) {
+  if (UNLIKELY(length == 0))
+    return true;
+
+  char* data = MallocOpenSSL<char>(length);
+  ByteSource buf = ByteSource::Allocated(data, length);
+  unsigned char* ptr = reinterpret_cast<unsigned char*>(data);
+
+  size_t expected = EVP_MD_CTX_size(ctx);
+
+  int ret = (length == expected)
+      ? EVP_DigestFinal_ex(ctx, ptr, &length)
+      : EVP_DigestFinalXOF(ctx, ptr, length);
+
+  if (UNLIKELY(ret != 1))
+    return false;
+
+  *out = std::move(buf);
+  return true;
+}
+
+// Parses the algorithm and the optional output length in bits, as passed to
+// HashJob and HashFileJob.
+Maybe<bool> GetDigestParams(Environment* env,
+                            Local<Value> algorithm,
+                            Local<Value> output_length,
+                            const EVP_MD** digest,
+                            unsigned int* length) {
+  CHECK(algorithm->IsString());  // Hash algorithm
+  Utf8Value name(env->isolate(), algorithm);
+  *digest = EVP_get_digestbyname(*name);
+  if (UNLIKELY(*digest == nullptr)) {
+    THROW_ERR_CRYPTO_INVALID_DIGEST(env);
+    return Nothing<bool>();
+  }
+
+  unsigned int expected = EVP_MD_size(*digest);
+  *length = expected;
+  if (UNLIKELY(output_length->IsUint32())) {
+    // length is expressed in terms of bits
+    *length =
+        static_cast<uint32_t>(output_length.As<Uint32>()->Value()) / CHAR_BIT;
+    if (*length != expected) {
+      if ((EVP_MD_flags(*digest) & EVP_MD_FLAG_XOF) == 0) {
+        THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Digest method not supported");
+        return Nothing<bool>();
+      }
+    }
+  }
+
+  return Just(true);
+}
+}  // anonymous namespace
+
 HashConfig::HashConfig(HashConfig&& other) noexcept
     : mode(other.mode),
       in(std::move(other.in)),
@@ -229,13 +377,8 @@ Maybe<bool> HashTraits::AdditionalConfig(
 
   params->mode = mode;
 
-  CHECK(args[offset]->IsString());  // Hash algorithm
-  Utf8Value digest(env->isolate(), args[offset]);
-  params->digest = EVP_get_digestbyname(*digest);
-  if (UNLIKELY(params->digest == nullptr)) {
-    char msg[1024];
-    snprintf(msg, sizeof(msg), "Invalid digest: %s", *digest);
-    THROW_ERR_CRYPTO_INVALID_DIGEST(env);
+  if (GetDigestParams(env, args[offset], args[offset + 2], &params->digest,
+                      &params->length).IsNothing()) {
     return Nothing<bool>();
   }
 
@@ -248,21 +391,6 @@ Maybe<bool> HashTraits::AdditionalConfig(
       ? data.ToCopy()
       : data.ToByteSource();
 
-  unsigned int expected = EVP_MD_size(params->digest);
-  params->length = expected;
-  if (UNLIKELY(args[offset + 2]->IsUint32())) {
-    // length is expressed in terms of bits
-    params->length =
-        static_cast<uint32_t>(args[offset + 2]
-            .As<Uint32>()->Value()) / CHAR_BIT;
-    if (params->length != expected) {
-      if ((EVP_MD_flags(params->digest) & EVP_MD_FLAG_XOF) == 0) {
-        THROW_ERR_CRYPTO_INVALID_DIGEST(env, "Digest method not supported");
-        return Nothing<bool>();
-      }
-    }
-  }
-
   return Just(true);
 }
 
@@ -281,25 +409,101 @@ bool HashTraits::DeriveBits(
     return false;
   }
 
-  if (LIKELY(params.length > 0)) {
-    unsigned int length = params.length;
-    char* data = MallocOpenSSL<char>(length);
-    ByteSource buf = ByteSource::Allocated(data, length);
-    unsigned char* ptr = reinterpret_cast<unsigned char*>(data);
+  return FinishDigest(ctx.get(), params.length, out);
+}
 
-    size_t expected = EVP_MD_CTX_size(ctx.get());
+constexpr size_t HashFileJob::kReadSize;
 
-    int ret = (length == expected)
-        ? EVP_DigestFinal_ex(ctx.get(), ptr, &length)
-        : EVP_DigestFinalXOF(ctx.get(), ptr, length);
+void HashFileJob::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CryptoJobMode mode = GetCryptoJobMode(args[0]);
 
-    if (UNLIKELY(ret != 1))
-      return false;
+  CHECK(args[1]->IsInt32());  // File descriptor
+  HashFileConfig params;
+  params.fd = args[1].As<Int32>()->Value();
+  if (GetDigestParams(env, args[2], args[3], &params.digest, &params.length)
+          .IsNothing()) {
+    return;
+  }
 
-    *out = std::move(buf);
+  new HashFileJob(env, args.This(), mode, std::move(params));
+}
+
+void HashFileJob::Initialize(Environment* env, Local<Object> target) {
+  CryptoJob<HashFileTraits>::Initialize(New, env, target);
+}
+
+HashFileJob::HashFileJob(
+    Environment* env,
+    Local<Object> object,
+    CryptoJobMode mode,
+    HashFileConfig&& params)
+    : CryptoJob<HashFileTraits>(
+          env,
+          object,
+          HashFileTraits::Provider,
+          mode,
+          std::move(params)) {}
+
+void HashFileJob::DoThreadPoolWork() {
+  const HashFileConfig& params = *CryptoJob<HashFileTraits>::params();
+  CryptoErrorStore* errors = CryptoJob<HashFileTraits>::errors();
+  EVPMDPointer ctx(EVP_MD_CTX_new());
+  if (UNLIKELY(!ctx ||
+               EVP_DigestInit_ex(ctx.get(), params.digest, nullptr) <= 0)) {
+    errors->Capture();
+    return;
   }
 
-  return true;
+  std::unique_ptr<char[]> buffer(new char[kReadSize]);
+  for (;;) {
+    uv_buf_t buf = uv_buf_init(buffer.get(), kReadSize);
+    uv_fs_t req;
+    const int bytes =
+        uv_fs_read(nullptr, &req, params.fd, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (bytes < 0) {
+      read_error_ = bytes;
+      return;
+    }
+    if (bytes == 0)
+      break;
+    if (UNLIKELY(EVP_DigestUpdate(ctx.get(), buffer.get(), bytes) <= 0)) {
+      errors->Capture();
+      return;
+    }
+  }
+
+  success_ = FinishDigest(ctx.get(), params.length, &out_);
+  if (!success_)
+    errors->Capture();
+}
+
+Maybe<bool> HashFileJob::ToResult(
+    Local<Value>* err,
+    Local<Value>* result) {
+  Environment* env = AsyncWrap::env();
+  if (success_) {
+    *err = Undefined(env->isolate());
+    *result = out_.ToArrayBuffer(env);
+    return Just(!result->IsEmpty());
+  }
+
+  *result = Undefined(env->isolate());
+  if (read_error_ != 0) {
+    *err = UVException(env->isolate(), read_error_, "read");
+    return Just(true);
+  }
+
+  CryptoErrorStore* errors = CryptoJob<HashFileTraits>::errors();
+  if (errors->Empty())
+    errors->Insert(NodeCryptoError::DERIVING_BITS_FAILED);
+  return Just(errors->ToException(env).ToLocal(err));
+}
+
+void HashFileJob::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("out", out_.size());
+  CryptoJob<HashFileTraits>::MemoryInfo(tracker);
 }
 
 }  // namespace crypto
@@ -25,6 +25,7 @@ class Hash final : public BaseObject {
   bool HashUpdate(const char* data, size_t len);
 
   static void GetHashes(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void OneShotDigest(const v8::FunctionCallbackInfo<v8::Value>& args);
 
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -82,6 +83,55 @@ struct HashTraits final {
 
 using HashJob = DeriveBitsJob<HashTraits>;
 
+struct HashFileConfig final : public MemoryRetainer {
+  uv_file fd;
+  const EVP_MD* digest;
+  unsigned int length;
+
+  SET_NO_MEMORY_INFO();
+  SET_MEMORY_INFO_NAME(HashFileConfig);
+  SET_SELF_SIZE(HashFileConfig);
+};
+
+struct HashFileTraits final {
+  using AdditionalParameters = HashFileConfig;
+  static constexpr const char* JobName = "HashFileJob";
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_HASHREQUEST;
+};
+
+// Reads a file from its current position to the end and hashes it, all in
+// one job, so that the data never has to be passed to JS. Read errors are
+// reported as the usual fs errors rather than as crypto errors.
+class HashFileJob final : public CryptoJob<HashFileTraits> {
+ public:
+  static constexpr size_t kReadSize = 1024 * 1024;
+
+  // HashFileJob(mode, fd, algorithm[, outputLength])
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  HashFileJob(
+      Environment* env,
+      v8::Local<v8::Object> object,
+      CryptoJobMode mode,
+      HashFileConfig&& params);
+
+  void DoThreadPoolWork() override;
+
+  v8::Maybe<bool> ToResult(
+      v8::Local<v8::Value>* err,
+      v8::Local<v8::Value>* result) override;
+
+  SET_SELF_SIZE(HashFileJob);
+  void MemoryInfo(MemoryTracker* tracker) const override;
+
+ private:
+  ByteSource out_;
+  int read_error_ = 0;
+  bool success_ = false;
+};
+
 }  // namespace crypto
 }  // namespace node
 
@@ -16,6 +16,8 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
+
 namespace node {
 
 using v8::Array;
@@ -551,8 +553,20 @@ Maybe<bool> GetAsymmetricKeyDetail(
 }
 }  // namespace
 
+// The contexts hold references to the key, they are released along with the
+// last ManagedEVPPKey that refers to it.
+struct ManagedEVPPKey::CtxCache {
+  // Enough for a few combinations of operations and options per key.
+  static constexpr size_t kMaxEntries = 8;
+
+  Mutex mutex;
+  // A null context means that the key's contexts cannot be copied.
+  std::vector<std::pair<KeyCtxParams, EVPKeyCtxPointer>> entries;
+};
+
 ManagedEVPPKey::ManagedEVPPKey(EVPKeyPointer&& pkey) : pkey_(std::move(pkey)),
-    mutex_(std::make_shared<Mutex>()) {}
+    mutex_(std::make_shared<Mutex>()),
+    ctx_cache_(std::make_shared<CtxCache>()) {}
 
 ManagedEVPPKey::ManagedEVPPKey(const ManagedEVPPKey& that) {
   *this = that;
@@ -565,6 +579,7 @@ ManagedEVPPKey& ManagedEVPPKey::operator=(const ManagedEVPPKey& that) {
     EVP_PKEY_up_ref(pkey_.get());
 
   mutex_ = that.mutex_;
+  ctx_cache_ = that.ctx_cache_;
 
   return *this;
 }
@@ -581,6 +596,52 @@ Mutex* ManagedEVPPKey::mutex() const {
   return mutex_.get();
 }
 
+EVPKeyCtxPointer ManagedEVPPKey::NewCtx(
+    const KeyCtxParams& params,
+    const std::function<bool(EVP_PKEY_CTX*)>& apply) const {
+  EVPKeyCtxPointer copy;
+  if (ctx_cache_) {
+    Mutex::ScopedLock lock(ctx_cache_->mutex);
+    for (const auto& entry : ctx_cache_->entries) {
+      if (entry.first == params) {
+        if (entry.second)
+          copy.reset(EVP_PKEY_CTX_dup(entry.second.get()));
+        break;
+      }
+    }
+  }
+  // EVP_PKEY_CTX_dup() does not copy every parameter, e.g. the RSA-PSS salt
+  // length, so they are applied to the copy again.
+  if (copy) {
+    if (!apply(copy.get()))
+      return EVPKeyCtxPointer();
+    return copy;
+  }
+
+  EVPKeyCtxPointer ctx(EVP_PKEY_CTX_new(pkey_.get(), nullptr));
+  if (!ctx || params.init(ctx.get()) <= 0 || !apply(ctx.get()))
+    return EVPKeyCtxPointer();
+
+  if (ctx_cache_) {
+    // Keys whose method cannot copy contexts are remembered with a null
+    // context, there is no point in trying again.
+    EVPKeyCtxPointer cached(EVP_PKEY_CTX_dup(ctx.get()));
+    Mutex::ScopedLock lock(ctx_cache_->mutex);
+    auto& entries = ctx_cache_->entries;
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&](const auto& entry) {
+                             return entry.first == params;
+                           });
+    if (it == entries.end()) {
+      if (entries.size() == CtxCache::kMaxEntries)
+        entries.erase(entries.begin());
+      entries.emplace_back(params, std::move(cached));
+    }
+  }
+
+  return ctx;
+}
+
 void ManagedEVPPKey::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("pkey",
                               !pkey_ ? 0 : kSizeOf_EVP_PKEY +
@@ -13,8 +13,10 @@
 
 #include <openssl/evp.h>
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace node {
 namespace crypto {
@@ -69,6 +71,23 @@ struct PrivateKeyEncodingConfig : public AsymmetricKeyEncodingConfig {
   NonCopyableMaybe<ByteSource> passphrase_;
 };
 
+// Identifies an initialized EVP_PKEY_CTX of a key, see ManagedEVPPKey::NewCtx.
+struct KeyCtxParams {
+  int (*init)(EVP_PKEY_CTX* ctx);  // E.g. EVP_PKEY_sign_init.
+  const EVP_MD* md = nullptr;
+  int padding = 0;
+  bool has_salt_length = false;
+  int salt_length = 0;
+
+  bool operator==(const KeyCtxParams& other) const {
+    return init == other.init &&
+           md == other.md &&
+           padding == other.padding &&
+           has_salt_length == other.has_salt_length &&
+           salt_length == other.salt_length;
+  }
+};
+
 // This uses the built-in reference counter of OpenSSL to manage an EVP_PKEY
 // which is slightly more efficient than using a shared pointer and easier to
 // use.
@@ -83,6 +102,16 @@ class ManagedEVPPKey : public MemoryRetainer {
   EVP_PKEY* get() const;
   Mutex* mutex() const;
 
+  // Returns a new EVP_PKEY_CTX for the operation that `params` describe.
+  // The first context is created with `params.init` and set up by `apply`,
+  // which sets the options given in `params`. Later ones are copied from a
+  // cached one, so that repeated operations with the same key do not
+  // initialize a context again. `apply` still runs on every copy. Returns
+  // nullptr if `init` or `apply` fail.
+  EVPKeyCtxPointer NewCtx(
+      const KeyCtxParams& params,
+      const std::function<bool(EVP_PKEY_CTX*)>& apply) const;
+
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(ManagedEVPPKey)
   SET_SELF_SIZE(ManagedEVPPKey)
@@ -127,8 +156,11 @@ class ManagedEVPPKey : public MemoryRetainer {
   size_t size_of_private_key() const;
   size_t size_of_public_key() const;
 
+  struct CtxCache;
+
   EVPKeyPointer pkey_;
   std::shared_ptr<Mutex> mutex_;
+  std::shared_ptr<CtxCache> ctx_cache_;
 };
 
 // Objects of this class can safely be shared among threads.
@@ -8,11 +8,15 @@
 #include "v8.h"
 
 #include <openssl/bn.h>
+#include <openssl/crypto.h>
+
+#include <atomic>
 
 namespace node {
 
 using v8::ArrayBuffer;
 using v8::BackingStore;
+using v8::Boolean;
 using v8::False;
 using v8::FunctionCallbackInfo;
 using v8::Just;
@@ -70,6 +74,112 @@ bool RandomBytesTraits::DeriveBits(
   return RAND_bytes(params.buffer, params.size) != 0;
 }
 
+constexpr size_t RandomBytesPool::kBufferSize;
+constexpr size_t RandomBytesPool::kMaxRequestSize;
+// TODO(addaleax): Remove once we're on C++17.
+constexpr FastStringKey RandomBytesPool::type_name;
+
+struct RandomBytesPool::Buffer {
+  ~Buffer() { OPENSSL_cleanse(data, sizeof(data)); }
+
+  // Makes the bytes of a completed refill available. This does not need to
+  // wait for AfterThreadPoolWork(), so that a busy event loop does not starve
+  // the pool.
+  void Collect() {
+    if (filled.exchange(false, std::memory_order_acquire))
+      available = kBufferSize;
+  }
+
+  unsigned char data[kBufferSize];
+  // The number of unused bytes, which are taken from the end of `data`.
+  size_t available = 0;
+  // Whether a RefillWork for the buffer exists.
+  bool refilling = false;
+  // Set by the threadpool once `data` was written.
+  std::atomic<bool> filled { false };
+};
+
+class RandomBytesPool::RefillWork final : public ThreadPoolWork {
+ public:
+  RefillWork(Environment* env, std::shared_ptr<Buffer> buffer)
+      : ThreadPoolWork(env, ThreadPoolWorkClass::kCrypto),
+        buffer_(std::move(buffer)) {}
+
+  void DoThreadPoolWork() override {
+    CheckEntropy();
+    if (RAND_bytes(buffer_->data, kBufferSize) == 1)
+      buffer_->filled.store(true, std::memory_order_release);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<RefillWork> self(this);
+    buffer_->refilling = false;
+    buffer_->Collect();
+  }
+
+ private:
+  std::shared_ptr<Buffer> buffer_;
+};
+
+RandomBytesPool::RandomBytesPool(Environment* env, Local<Object> object)
+    : BaseObject(env, object) {
+  // The buffers are filled on first use, so that Environments that do not
+  // need random bytes do not pay for them.
+  buffers_[0] = std::make_shared<Buffer>();
+  buffers_[1] = std::make_shared<Buffer>();
+}
+
+void RandomBytesPool::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("buffers", 2 * sizeof(Buffer));
+}
+
+void RandomBytesPool::Refill(int index) {
+  Buffer* buffer = buffers_[index].get();
+  if (buffer->refilling)
+    return;
+  // Bytes that are left over are too few for the current request and are
+  // overwritten rather than served.
+  buffer->available = 0;
+  buffer->refilling = true;
+  (new RefillWork(env(), buffers_[index]))->ScheduleWork();
+}
+
+bool RandomBytesPool::Take(unsigned char* out, size_t size) {
+  if (size > kMaxRequestSize)
+    return false;
+  Buffer* buffer = buffers_[active_].get();
+  if (buffer->available < size) {
+    Refill(active_);
+    active_ ^= 1;
+    buffer = buffers_[active_].get();
+    buffer->Collect();
+    if (buffer->available < size)
+      return false;
+  }
+  buffer->available -= size;
+  unsigned char* data = buffer->data + buffer->available;
+  memcpy(out, data, size);
+  // Served bytes must never be handed out again.
+  OPENSSL_cleanse(data, size);
+  return true;
+}
+
+void RandomBytesPool::Fill(const FunctionCallbackInfo<Value>& args) {
+  RandomBytesPool* pool = Environment::GetBindingData<RandomBytesPool>(args);
+  CHECK(IsAnyByteSource(args[0]));  // Buffer to fill
+  CHECK(args[1]->IsUint32());  // Offset
+  CHECK(args[2]->IsUint32());  // Size
+
+  ArrayBufferOrViewContents<unsigned char> in(args[0]);
+  const uint32_t byte_offset = args[1].As<Uint32>()->Value();
+  const uint32_t size = args[2].As<Uint32>()->Value();
+  CHECK_GE(byte_offset + size, byte_offset);  // Overflow check.
+  CHECK_LE(byte_offset + size, in.size());  // Bounds check.
+
+  const bool taken = pool->Take(in.data() + byte_offset, size);
+  args.GetReturnValue().Set(Boolean::New(args.GetIsolate(), taken));
+}
+
 void RandomPrimeConfig::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("prime", prime ? bits * 8 : 0);
 }
@@ -242,6 +352,8 @@ Maybe<bool> CheckPrimeTraits::EncodeOutput(
 namespace Random {
 void Initialize(Environment* env, Local<Object> target) {
   RandomBytesJob::Initialize(env, target);
+  if (env->AddBindingData<RandomBytesPool>(env->context(), target) != nullptr)
+    env->SetMethod(target, "randomFillFromPool", RandomBytesPool::Fill);
   RandomPrimeJob::Initialize(env, target);
   CheckPrimeJob::Initialize(env, target);
 }
@@ -11,6 +11,8 @@
 #include "node_internals.h"
 #include "v8.h"
 
+#include <memory>
+
 namespace node {
 namespace crypto {
 struct RandomBytesConfig final : public MemoryRetainer {
@@ -47,6 +49,42 @@ struct RandomBytesTraits final {
 
 using RandomBytesJob = DeriveBitsJob<RandomBytesTraits>;
 
+// Serves small synchronous randomFillSync() and randomBytes() requests from
+// memory. The pool consists of two buffers: requests are served from the
+// active one while the other one is refilled in the threadpool, and they are
+// swapped once the active one is used up. Both buffers are only accessed on
+// the thread of the Environment while they are not being refilled, so no
+// locking is needed.
+class RandomBytesPool final : public BaseObject {
+ public:
+  static constexpr size_t kBufferSize = 4096;
+  static constexpr size_t kMaxRequestSize = 256;
+
+  RandomBytesPool(Environment* env, v8::Local<v8::Object> object);
+
+  // Copies `size` bytes to `out` and returns true, or returns false if the
+  // pool cannot serve the request right now.
+  bool Take(unsigned char* out, size_t size);
+
+  // randomFillFromPool(buffer, offset, size)
+  static void Fill(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static constexpr FastStringKey type_name { "node::crypto::RandomBytesPool" };
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(RandomBytesPool)
+  SET_SELF_SIZE(RandomBytesPool)
+
+ private:
+  struct Buffer;
+  class RefillWork;
+
+  void Refill(int index);
+
+  std::shared_ptr<Buffer> buffers_[2];
+  int active_ = 0;
+};
+
 struct RandomPrimeConfig final : public MemoryRetainer {
   BignumPointer prime;
   BignumPointer rem;
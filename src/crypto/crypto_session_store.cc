@@ -0,0 +1,330 @@
+#include "crypto/crypto_session_store.h"
+#include "node_mutex.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace node {
+namespace crypto {
+
+constexpr size_t SessionStore::kTicketKeysLength;
+
+#ifndef _WIN32
+
+namespace {
+constexpr uint32_t kReady = 0x6e6f6465;
+constexpr uint32_t kStripes = 64;
+constexpr uint32_t kWays = 4;
+constexpr size_t kMaxEntryLength = 4096;
+// How long to wait for another process to finish creating a store, in ms.
+constexpr int kOpenTimeout = 1000;
+
+Mutex stores_mutex;
+std::unordered_map<std::string, std::weak_ptr<SessionStore>> stores;
+
+// Locks a process-shared mutex. If the process that held the lock died,
+// `*owner_died` is set and the caller must repair the state it guards.
+void LockSharedMutex(pthread_mutex_t* mutex, bool* owner_died) {
+  int err = pthread_mutex_lock(mutex);
+  *owner_died = false;
+#if defined(__linux__) && !defined(__ANDROID__)
+  if (err == EOWNERDEAD) {
+    *owner_died = true;
+    err = pthread_mutex_consistent(mutex);
+  }
+#endif
+  CHECK_EQ(err, 0);
+}
+
+void InitSharedMutex(pthread_mutex_t* mutex) {
+  pthread_mutexattr_t attr;
+  CHECK_EQ(pthread_mutexattr_init(&attr), 0);
+  CHECK_EQ(pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED), 0);
+#if defined(__linux__) && !defined(__ANDROID__)
+  CHECK_EQ(pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST), 0);
+#endif
+  CHECK_EQ(pthread_mutex_init(mutex, &attr), 0);
+  pthread_mutexattr_destroy(&attr);
+}
+}  // anonymous namespace
+
+struct SessionStore::Header {
+  std::atomic<uint32_t> state;
+  uint32_t entries;
+  pthread_mutex_t ticket_keys_lock;
+  unsigned char ticket_keys[kTicketKeysLength];
+  pthread_mutex_t locks[kStripes];
+};
+
+struct SessionStore::Entry {
+  int64_t expires;  // Zero if the entry is unused.
+  uint32_t id_length;
+  uint32_t length;
+  unsigned char id[SSL_MAX_SSL_SESSION_ID_LENGTH];
+  unsigned char data[kMaxEntryLength];
+};
+
+std::shared_ptr<SessionStore> SessionStore::Open(const std::string& name,
+                                                 uint32_t entries,
+                                                 int* err) {
+  Mutex::ScopedLock lock(stores_mutex);
+  auto it = stores.find(name);
+  if (it != stores.end()) {
+    std::shared_ptr<SessionStore> store = it->second.lock();
+    if (store)
+      return store;
+  }
+
+  const std::string path = "/node-tls." + name;
+  bool created = true;
+  int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1 && errno == EEXIST) {
+    created = false;
+    fd = shm_open(path.c_str(), O_RDWR, 0);
+  }
+  if (fd == -1) {
+    *err = errno;
+    return nullptr;
+  }
+
+  entries = RoundUp(std::max<uint32_t>(entries, kWays), kWays);
+  size_t size = sizeof(Header) + entries * sizeof(Entry);
+  if (created) {
+    if (ftruncate(fd, size) != 0) {
+      *err = errno;
+      close(fd);
+      shm_unlink(path.c_str());
+      return nullptr;
+    }
+  } else {
+    // The process that created the store may not have sized it yet.
+    struct stat s;
+    for (int waited = 0;; waited++) {
+      if (fstat(fd, &s) != 0) {
+        *err = errno;
+        close(fd);
+        return nullptr;
+      }
+      if (static_cast<size_t>(s.st_size) >= sizeof(Header))
+        break;
+      if (waited == kOpenTimeout) {
+        *err = ETIMEDOUT;
+        close(fd);
+        return nullptr;
+      }
+      uv_sleep(1);
+    }
+    size = s.st_size;
+  }
+
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  *err = errno;
+  close(fd);
+  if (data == MAP_FAILED)
+    return nullptr;
+
+  Header* header = static_cast<Header*>(data);
+  if (created) {
+    InitSharedMutex(&header->ticket_keys_lock);
+    for (uint32_t i = 0; i < kStripes; i++)
+      InitSharedMutex(&header->locks[i]);
+    if (RAND_bytes(header->ticket_keys, kTicketKeysLength) <= 0) {
+      *err = EIO;
+      munmap(data, size);
+      shm_unlink(path.c_str());
+      return nullptr;
+    }
+    header->entries = entries;
+    header->state.store(kReady, std::memory_order_release);
+  } else {
+    for (int waited = 0;
+         header->state.load(std::memory_order_acquire) != kReady;
+         waited++) {
+      if (waited == kOpenTimeout) {
+        *err = ETIMEDOUT;
+        munmap(data, size);
+        return nullptr;
+      }
+      uv_sleep(1);
+    }
+    // The size of an existing store is the one it was created with.
+    if (header->entries % kWays != 0 ||
+        size < sizeof(Header) + header->entries * sizeof(Entry)) {
+      *err = EINVAL;
+      munmap(data, size);
+      return nullptr;
+    }
+  }
+
+  std::shared_ptr<SessionStore> store(new SessionStore(name, data, size));
+  stores[name] = store;
+  return store;
+}
+
+SessionStore::SessionStore(std::string name, void* data, size_t size)
+    : name_(std::move(name)),
+      data_(data),
+      size_(size),
+      header_(static_cast<Header*>(data)) {}
+
+SessionStore::~SessionStore() {
+  {
+    Mutex::ScopedLock lock(stores_mutex);
+    auto it = stores.find(name_);
+    if (it != stores.end() && it->second.expired())
+      stores.erase(it);
+  }
+  CHECK_EQ(munmap(data_, size_), 0);
+}
+
+uint32_t SessionStore::BucketOf(const unsigned char* id,
+                                unsigned int id_length) const {
+  // FNV-1a. Session IDs are random, but clients choose their own.
+  uint32_t hash = 2166136261u;
+  for (unsigned int i = 0; i < id_length; i++)
+    hash = (hash ^ id[i]) * 16777619u;
+  return hash % (header_->entries / kWays);
+}
+
+SessionStore::Entry* SessionStore::BucketEntries(uint32_t bucket) const {
+  Entry* entries = reinterpret_cast<Entry*>(header_ + 1);
+  return entries + bucket * kWays;
+}
+
+void SessionStore::LockBucket(uint32_t bucket) {
+  bool owner_died;
+  const uint32_t stripe = bucket % kStripes;
+  LockSharedMutex(&header_->locks[stripe], &owner_died);
+  if (owner_died) {
+    // The entries guarded by the lock may have been left half written.
+    const uint32_t buckets = header_->entries / kWays;
+    for (uint32_t i = stripe; i < buckets; i += kStripes)
+      memset(BucketEntries(i), 0, kWays * sizeof(Entry));
+  }
+}
+
+void SessionStore::UnlockBucket(uint32_t bucket) {
+  CHECK_EQ(pthread_mutex_unlock(&header_->locks[bucket % kStripes]), 0);
+}
+
+void SessionStore::Put(SSL_SESSION* session) {
+  unsigned int id_length;
+  const unsigned char* id = SSL_SESSION_get_id(session, &id_length);
+  if (id_length == 0 || id_length > SSL_MAX_SSL_SESSION_ID_LENGTH)
+    return;
+
+  int length = i2d_SSL_SESSION(session, nullptr);
+  if (length <= 0 || static_cast<size_t>(length) > kMaxEntryLength)
+    return;
+
+  const int64_t expires = static_cast<int64_t>(SSL_SESSION_get_time(session)) +
+                          SSL_SESSION_get_timeout(session);
+
+  const uint32_t bucket = BucketOf(id, id_length);
+  LockBucket(bucket);
+  Entry* entries = BucketEntries(bucket);
+  // Replace the entry for the same ID, or else the one that expires first.
+  // Unused entries never expire later than used ones.
+  Entry* entry = &entries[0];
+  for (uint32_t i = 0; i < kWays; i++) {
+    if (entries[i].expires != 0 &&
+        entries[i].id_length == id_length &&
+        memcmp(entries[i].id, id, id_length) == 0) {
+      entry = &entries[i];
+      break;
+    }
+    if (entries[i].expires < entry->expires)
+      entry = &entries[i];
+  }
+  unsigned char* data = entry->data;
+  entry->id_length = id_length;
+  memcpy(entry->id, id, id_length);
+  entry->length = i2d_SSL_SESSION(session, &data);
+  entry->expires = expires;
+  UnlockBucket(bucket);
+}
+
+SSL_SESSION* SessionStore::Get(const unsigned char* id,
+                               unsigned int id_length) {
+  if (id_length == 0 || id_length > SSL_MAX_SSL_SESSION_ID_LENGTH)
+    return nullptr;
+
+  const int64_t now = time(nullptr);
+  SSL_SESSION* session = nullptr;
+  const uint32_t bucket = BucketOf(id, id_length);
+  LockBucket(bucket);
+  Entry* entries = BucketEntries(bucket);
+  for (uint32_t i = 0; i < kWays; i++) {
+    if (entries[i].expires > now &&
+        entries[i].id_length == id_length &&
+        memcmp(entries[i].id, id, id_length) == 0) {
+      const unsigned char* data = entries[i].data;
+      session = d2i_SSL_SESSION(nullptr, &data, entries[i].length);
+      break;
+    }
+  }
+  UnlockBucket(bucket);
+  return session;
+}
+
+void SessionStore::GetTicketKeys(unsigned char* keys) {
+  bool owner_died;
+  LockSharedMutex(&header_->ticket_keys_lock, &owner_died);
+  memcpy(keys, header_->ticket_keys, kTicketKeysLength);
+  CHECK_EQ(pthread_mutex_unlock(&header_->ticket_keys_lock), 0);
+}
+
+void SessionStore::SetTicketKeys(const unsigned char* keys) {
+  bool owner_died;
+  LockSharedMutex(&header_->ticket_keys_lock, &owner_died);
+  memcpy(header_->ticket_keys, keys, kTicketKeysLength);
+  CHECK_EQ(pthread_mutex_unlock(&header_->ticket_keys_lock), 0);
+}
+
+#else  // _WIN32
+
+std::shared_ptr<SessionStore> SessionStore::Open(const std::string& name,
+                                                 uint32_t entries,
+                                                 int* err) {
+  *err = ENOSYS;
+  return nullptr;
+}
+
+SessionStore::~SessionStore() {}
+
+void SessionStore::Put(SSL_SESSION* session) {
+  UNREACHABLE();
+}
+
+SSL_SESSION* SessionStore::Get(const unsigned char* id,
+                               unsigned int id_length) {
+  UNREACHABLE();
+}
+
+void SessionStore::GetTicketKeys(unsigned char* keys) {
+  UNREACHABLE();
+}
+
+void SessionStore::SetTicketKeys(const unsigned char* keys) {
+  UNREACHABLE();
+}
+
+#endif  // _WIN32
+
+}  // namespace crypto
+}  // namespace node
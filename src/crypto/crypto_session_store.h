@@ -0,0 +1,69 @@
+#ifndef SRC_CRYPTO_CRYPTO_SESSION_STORE_H_
+#define SRC_CRYPTO_CRYPTO_SESSION_STORE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "crypto/crypto_util.h"
+
+#include <memory>
+#include <string>
+
+namespace node {
+namespace crypto {
+
+// A TLS session cache kept in a named shared memory object, so that servers
+// in different worker threads and processes on the same host can resume
+// each other's sessions. The store also holds the ticket keys that are used
+// by all SecureContexts attached to it, so that session tickets issued by
+// one server are accepted by the others.
+//
+// The table is a set-associative cache: a session ID maps to a bucket of
+// kWays entries, and a full bucket evicts the entry that expires first.
+// Buckets are guarded by a fixed number of process-shared mutexes.
+class SessionStore final {
+ public:
+  static constexpr size_t kTicketKeysLength = 48;
+
+  // Opens the store called `name`, creating it with room for `entries`
+  // sessions if it does not exist yet. Stores that are opened more than once
+  // in the same process share their mapping. Returns nullptr and sets `*err`
+  // to an errno value on failure.
+  static std::shared_ptr<SessionStore> Open(const std::string& name,
+                                            uint32_t entries,
+                                            int* err);
+
+  ~SessionStore();
+
+  SessionStore(const SessionStore&) = delete;
+  SessionStore& operator=(const SessionStore&) = delete;
+
+  // Sessions whose serialized form does not fit into an entry are not stored.
+  void Put(SSL_SESSION* session);
+  SSL_SESSION* Get(const unsigned char* id, unsigned int id_length);
+
+  void GetTicketKeys(unsigned char* keys);
+  void SetTicketKeys(const unsigned char* keys);
+
+  struct Header;
+  struct Entry;
+
+ private:
+  SessionStore(std::string name, void* data, size_t size);
+
+  uint32_t BucketOf(const unsigned char* id, unsigned int id_length) const;
+  Entry* BucketEntries(uint32_t bucket) const;
+  void LockBucket(uint32_t bucket);
+  void UnlockBucket(uint32_t bucket);
+
+  std::string name_;
+  void* data_;
+  size_t size_;
+  Header* header_;
+};
+
+}  // namespace crypto
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_CRYPTO_CRYPTO_SESSION_STORE_H_
@@ -12,6 +12,7 @@
 
 namespace node {
 
+using v8::Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
@@ -22,6 +23,7 @@ using v8::Maybe;
 using v8::Nothing;
 using v8::Object;
 using v8::Uint32;
+using v8::Uint8Array;
 using v8::Value;
 
 namespace crypto {
@@ -64,6 +66,35 @@ bool ApplyRSAOptions(const ManagedEVPPKey& pkey,
   return true;
 }
 
+// Returns a context for signing or verifying digests with `pkey`, with the
+// digest and the RSA options applied. The context is copied from one that is
+// cached on the key, see ManagedEVPPKey::NewCtx().
+EVPKeyCtxPointer NewSignatureCtx(const ManagedEVPPKey& pkey,
+                                 int (*init)(EVP_PKEY_CTX*),
+                                 const EVP_MD* md,
+                                 int padding,
+                                 const Maybe<int>& salt_len) {
+  KeyCtxParams params;
+  params.init = init;
+  params.md = md;
+  params.padding = padding;
+  params.has_salt_length = salt_len.IsJust();
+  params.salt_length = salt_len.FromMaybe(0);
+  return pkey.NewCtx(params, [&](EVP_PKEY_CTX* ctx) {
+    return ApplyRSAOptions(pkey, ctx, padding, salt_len) &&
+           EVP_PKEY_CTX_set_signature_md(ctx, md) > 0;
+  });
+}
+
+// The digest that EVP_DigestSignInit() and EVP_DigestVerifyInit() use for
+// `pkey` if none is given.
+const EVP_MD* GetDefaultSignDigest(const ManagedEVPPKey& pkey) {
+  int nid;
+  if (EVP_PKEY_get_default_digest_nid(pkey.get(), &nid) <= 0)
+    return nullptr;
+  return EVP_get_digestbynid(nid);
+}
+
 AllocatedBuffer Node_SignFinal(Environment* env,
                                EVPMDPointer&& mdctx,
                                const ManagedEVPPKey& pkey,
@@ -81,12 +112,12 @@ AllocatedBuffer Node_SignFinal(Environment* env,
   AllocatedBuffer sig = AllocatedBuffer::AllocateManaged(env, sig_len);
   unsigned char* ptr = reinterpret_cast<unsigned char*>(sig.data());
 
-  EVPKeyCtxPointer pkctx(EVP_PKEY_CTX_new(pkey.get(), nullptr));
-  if (pkctx &&
-      EVP_PKEY_sign_init(pkctx.get()) &&
-      ApplyRSAOptions(pkey, pkctx.get(), padding, pss_salt_len) &&
-      EVP_PKEY_CTX_set_signature_md(pkctx.get(), EVP_MD_CTX_md(mdctx.get())) &&
-      EVP_PKEY_sign(pkctx.get(), ptr, &sig_len, m, m_len)) {
+  EVPKeyCtxPointer pkctx = NewSignatureCtx(pkey,
+                                           EVP_PKEY_sign_init,
+                                           EVP_MD_CTX_md(mdctx.get()),
+                                           padding,
+                                           pss_salt_len);
+  if (pkctx && EVP_PKEY_sign(pkctx.get(), ptr, &sig_len, m, m_len)) {
     sig.Resize(sig_len);
     return sig;
   }
@@ -449,6 +480,8 @@ void Verify::Initialize(Environment* env, Local<Object> target) {
   env->SetConstructorFunction(target, "Verify", t);
 
   env->SetMethod(target, "verifyOneShot", Verify::VerifySync);
+
+  VerifyBatchJob::Initialize(env, target);
 }
 
 void Verify::New(const FunctionCallbackInfo<Value>& args) {
@@ -493,12 +526,12 @@ SignBase::Error Verify::VerifyFinal(const ManagedEVPPKey& pkey,
   if (!EVP_DigestFinal_ex(mdctx.get(), m, &m_len))
     return kSignPublicKey;
 
-  EVPKeyCtxPointer pkctx(EVP_PKEY_CTX_new(pkey.get(), nullptr));
-  if (pkctx &&
-      EVP_PKEY_verify_init(pkctx.get()) > 0 &&
-      ApplyRSAOptions(pkey, pkctx.get(), padding, saltlen) &&
-      EVP_PKEY_CTX_set_signature_md(pkctx.get(),
-                                    EVP_MD_CTX_md(mdctx.get())) > 0) {
+  EVPKeyCtxPointer pkctx = NewSignatureCtx(pkey,
+                                           EVP_PKEY_verify_init,
+                                           EVP_MD_CTX_md(mdctx.get()),
+                                           padding,
+                                           saltlen);
+  if (pkctx) {
     const unsigned char* s = reinterpret_cast<const unsigned char*>(sig.get());
     const int r = EVP_PKEY_verify(pkctx.get(), s, sig.size(), m, m_len);
     *verify_result = r == 1;
@@ -597,30 +630,57 @@ void Sign::SignSync(const FunctionCallbackInfo<Value>& args) {
   DSASigEnc dsa_sig_enc =
       static_cast<DSASigEnc>(args[offset + 4].As<Int32>()->Value());
 
-  EVP_PKEY_CTX* pkctx = nullptr;
-  EVPMDPointer mdctx(EVP_MD_CTX_new());
-
-  if (!mdctx ||
-      !EVP_DigestSignInit(mdctx.get(), &pkctx, md, nullptr, key.get())) {
-    return crypto::CheckThrow(env, SignBase::Error::kSignInit);
-  }
-
-  if (!ApplyRSAOptions(key, pkctx, rsa_padding, rsa_salt_len))
-    return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
-
   const unsigned char* input =
     reinterpret_cast<const unsigned char*>(data.data());
   size_t sig_len;
-  if (!EVP_DigestSign(mdctx.get(), nullptr, &sig_len, input, data.size()))
-    return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
+  AllocatedBuffer signature;
 
-  AllocatedBuffer signature = AllocatedBuffer::AllocateManaged(env, sig_len);
-  if (!EVP_DigestSign(mdctx.get(),
+  if (IsOneShot(key)) {
+    EVP_PKEY_CTX* pkctx = nullptr;
+    EVPMDPointer mdctx(EVP_MD_CTX_new());
+
+    if (!mdctx ||
+        !EVP_DigestSignInit(mdctx.get(), &pkctx, md, nullptr, key.get())) {
+      return crypto::CheckThrow(env, SignBase::Error::kSignInit);
+    }
+
+    if (!EVP_DigestSign(mdctx.get(), nullptr, &sig_len, input, data.size()))
+      return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
+
+    signature = AllocatedBuffer::AllocateManaged(env, sig_len);
+    if (!EVP_DigestSign(mdctx.get(),
+                        reinterpret_cast<unsigned char*>(signature.data()),
+                        &sig_len,
+                        input,
+                        data.size())) {
+      return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
+    }
+  } else {
+    // Sign the digest with a context that is cached on the key, rather than
+    // setting up a new one with EVP_DigestSignInit() every time.
+    if (md == nullptr && (md = GetDefaultSignDigest(key)) == nullptr)
+      return crypto::CheckThrow(env, SignBase::Error::kSignInit);
+
+    unsigned char m[EVP_MAX_MD_SIZE];
+    unsigned int m_len;
+    if (!EVP_Digest(input, data.size(), m, &m_len, md, nullptr))
+      return crypto::CheckThrow(env, SignBase::Error::kSignInit);
+
+    EVPKeyCtxPointer pkctx = NewSignatureCtx(
+        key, EVP_PKEY_sign_init, md, rsa_padding, rsa_salt_len);
+    if (!pkctx ||
+        EVP_PKEY_sign(pkctx.get(), nullptr, &sig_len, m, m_len) <= 0) {
+      return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
+    }
+
+    signature = AllocatedBuffer::AllocateManaged(env, sig_len);
+    if (EVP_PKEY_sign(pkctx.get(),
                       reinterpret_cast<unsigned char*>(signature.data()),
                       &sig_len,
-                      input,
-                      data.size())) {
-    return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
+                      m,
+                      m_len) <= 0) {
+      return crypto::CheckThrow(env, SignBase::Error::kSignPrivateKey);
+    }
   }
 
   signature.Resize(sig_len);
@@ -676,15 +736,35 @@ void Verify::VerifySync(const FunctionCallbackInfo<Value>& args) {
   DSASigEnc dsa_sig_enc =
       static_cast<DSASigEnc>(args[offset + 5].As<Int32>()->Value());
 
-  EVP_PKEY_CTX* pkctx = nullptr;
-  EVPMDPointer mdctx(EVP_MD_CTX_new());
-  if (!mdctx ||
-      !EVP_DigestVerifyInit(mdctx.get(), &pkctx, md, nullptr, key.get())) {
-    return crypto::CheckThrow(env, SignBase::Error::kSignInit);
-  }
+  const unsigned char* input =
+    reinterpret_cast<const unsigned char*>(data.data());
+  unsigned char m[EVP_MAX_MD_SIZE];
+  unsigned int m_len = 0;
+  EVPKeyCtxPointer pkctx;
+  EVPMDPointer mdctx;
+
+  if (IsOneShot(key)) {
+    EVP_PKEY_CTX* one_shot_pkctx = nullptr;
+    mdctx.reset(EVP_MD_CTX_new());
+    if (!mdctx ||
+        !EVP_DigestVerifyInit(
+            mdctx.get(), &one_shot_pkctx, md, nullptr, key.get())) {
+      return crypto::CheckThrow(env, SignBase::Error::kSignInit);
+    }
+  } else {
+    // Verify the digest with a context that is cached on the key, rather
+    // than setting up a new one with EVP_DigestVerifyInit() every time.
+    if (md == nullptr && (md = GetDefaultSignDigest(key)) == nullptr)
+      return crypto::CheckThrow(env, SignBase::Error::kSignInit);
+
+    if (!EVP_Digest(input, data.size(), m, &m_len, md, nullptr))
+      return crypto::CheckThrow(env, SignBase::Error::kSignInit);
 
-  if (!ApplyRSAOptions(key, pkctx, rsa_padding, rsa_salt_len))
-    return crypto::CheckThrow(env, SignBase::Error::kSignPublicKey);
+    pkctx = NewSignatureCtx(
+        key, EVP_PKEY_verify_init, md, rsa_padding, rsa_salt_len);
+    if (!pkctx)
+      return crypto::CheckThrow(env, SignBase::Error::kSignPublicKey);
+  }
 
   ByteSource sig_bytes = ByteSource::Foreign(sig.data(), sig.size());
   if (dsa_sig_enc == kSigEncP1363) {
@@ -694,12 +774,19 @@ void Verify::VerifySync(const FunctionCallbackInfo<Value>& args) {
   }
 
   bool verify_result;
-  const int r = EVP_DigestVerify(
-    mdctx.get(),
-    sig_bytes.data<unsigned char>(),
-    sig_bytes.size(),
-    reinterpret_cast<const unsigned char*>(data.data()),
-    data.size());
+  const int r = mdctx
+      ? EVP_DigestVerify(
+            mdctx.get(),
+            sig_bytes.data<unsigned char>(),
+            sig_bytes.size(),
+            input,
+            data.size())
+      : EVP_PKEY_verify(
+            pkctx.get(),
+            sig_bytes.data<unsigned char>(),
+            sig_bytes.size(),
+            m,
+            m_len);
   switch (r) {
     case 1:
       verify_result = true;
@@ -954,5 +1041,225 @@ Maybe<bool> SignTraits::EncodeOutput(
   return Just(!result->IsEmpty());
 }
 
+VerifyBatchConfiguration::VerifyBatchConfiguration(
+    VerifyBatchConfiguration&& other) noexcept
+    : job_mode(other.job_mode),
+      key(std::move(other.key)),
+      data(std::move(other.data)),
+      signatures(std::move(other.signatures)),
+      digest(other.digest),
+      flags(other.flags),
+      padding(other.padding),
+      salt_length(other.salt_length) {}
+
+VerifyBatchConfiguration& VerifyBatchConfiguration::operator=(
+    VerifyBatchConfiguration&& other) noexcept {
+  if (&other == this) return *this;
+  this->~VerifyBatchConfiguration();
+  return *new (this) VerifyBatchConfiguration(std::move(other));
+}
+
+void VerifyBatchConfiguration::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("key", key.get());
+  if (job_mode == kCryptoJobAsync) {
+    size_t size = 0;
+    for (size_t i = 0; i < data.size(); i++)
+      size += data[i].size() + signatures[i].size();
+    tracker->TrackFieldWithSize("items", size);
+  }
+}
+
+Maybe<bool> VerifyBatchTraits::AdditionalConfig(
+    CryptoJobMode mode,
+    const FunctionCallbackInfo<Value>& args,
+    unsigned int offset,
+    VerifyBatchConfiguration* params) {
+  Environment* env = Environment::GetCurrent(args);
+
+  params->job_mode = mode;
+
+  CHECK(args[offset]->IsObject());  // Key
+  CHECK(args[offset + 1]->IsArray());  // Data
+  CHECK(args[offset + 2]->IsArray());  // Signatures
+
+  KeyObjectHandle* key;
+  ASSIGN_OR_RETURN_UNWRAP(&key, args[offset], Nothing<bool>());
+  params->key = key->Data();
+
+  if (args[offset + 3]->IsString()) {
+    Utf8Value digest(env->isolate(), args[offset + 3]);
+    params->digest = EVP_get_digestbyname(*digest);
+    if (params->digest == nullptr) {
+      THROW_ERR_CRYPTO_INVALID_DIGEST(env);
+      return Nothing<bool>();
+    }
+  }
+
+  if (args[offset + 4]->IsInt32()) {  // Salt length
+    params->flags |= SignConfiguration::kHasSaltLength;
+    params->salt_length = args[offset + 4].As<Int32>()->Value();
+  }
+  if (args[offset + 5]->IsUint32()) {  // Padding
+    params->flags |= SignConfiguration::kHasPadding;
+    params->padding = args[offset + 5].As<Uint32>()->Value();
+  }
+
+  DSASigEnc dsa_encoding = kSigEncDER;
+  if (args[offset + 6]->IsUint32()) {  // DSA Encoding
+    dsa_encoding =
+        static_cast<DSASigEnc>(args[offset + 6].As<Uint32>()->Value());
+    if (dsa_encoding != kSigEncDER && dsa_encoding != kSigEncP1363) {
+      THROW_ERR_OUT_OF_RANGE(env, "invalid signature encoding");
+      return Nothing<bool>();
+    }
+  }
+
+  Local<Array> data = args[offset + 1].As<Array>();
+  Local<Array> signatures = args[offset + 2].As<Array>();
+  CHECK_EQ(data->Length(), signatures->Length());
+
+  ManagedEVPPKey m_pkey = params->key->GetAsymmetricKey();
+  Mutex::ScopedLock lock(*m_pkey.mutex());
+  const bool use_p1363 = UseP1363Encoding(m_pkey, dsa_encoding);
+
+  params->data.reserve(data->Length());
+  params->signatures.reserve(data->Length());
+  for (uint32_t i = 0; i < data->Length(); i++) {
+    Local<Value> item;
+    Local<Value> signature_item;
+    if (!data->Get(env->context(), i).ToLocal(&item) ||
+        !signatures->Get(env->context(), i).ToLocal(&signature_item)) {
+      return Nothing<bool>();
+    }
+
+    ArrayBufferOrViewContents<char> item_data(item);
+    ArrayBufferOrViewContents<char> signature(signature_item);
+    if (UNLIKELY(!item_data.CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "data is too big");
+      return Nothing<bool>();
+    }
+    if (UNLIKELY(!signature.CheckSizeInt32())) {
+      THROW_ERR_OUT_OF_RANGE(env, "signature is too big");
+      return Nothing<bool>();
+    }
+
+    params->data.push_back(mode == kCryptoJobAsync
+        ? item_data.ToCopy()
+        : item_data.ToByteSource());
+    if (use_p1363) {
+      params->signatures.push_back(
+          ConvertSignatureToDER(m_pkey, signature.ToByteSource()));
+    } else {
+      params->signatures.push_back(mode == kCryptoJobAsync
+          ? signature.ToCopy()
+          : signature.ToByteSource());
+    }
+  }
+
+  return Just(true);
+}
+
+bool VerifyBatchTraits::DeriveBits(
+    Environment* env,
+    const VerifyBatchConfiguration& params,
+    ByteSource* out) {
+  ManagedEVPPKey m_pkey = params.key->GetAsymmetricKey();
+  Mutex::ScopedLock lock(*m_pkey.mutex());
+
+  const size_t count = params.data.size();
+  char* results = MallocOpenSSL<char>(count);
+  ByteSource buf = ByteSource::Allocated(results, count);
+
+  if (IsOneShot(m_pkey)) {
+    // Ed25519 and Ed448 hash the data themselves, the context cannot be
+    // prepared ahead of time.
+    EVPMDPointer context(EVP_MD_CTX_new());
+    for (size_t i = 0; i < count; i++) {
+      if (!EVP_DigestVerifyInit(
+              context.get(),
+              nullptr,
+              nullptr,
+              nullptr,
+              m_pkey.get())) {
+        return false;
+      }
+      results[i] = EVP_DigestVerify(
+          context.get(),
+          params.signatures[i].data<unsigned char>(),
+          params.signatures[i].size(),
+          params.data[i].data<unsigned char>(),
+          params.data[i].size()) == 1;
+      // Invalid signatures are not errors of the job.
+      if (!results[i])
+        ERR_clear_error();
+      EVP_MD_CTX_reset(context.get());
+    }
+    *out = std::move(buf);
+    return true;
+  }
+
+  const EVP_MD* md = params.digest;
+  if (md == nullptr) {
+    int nid;
+    if (EVP_PKEY_get_default_digest_nid(m_pkey.get(), &nid) <= 0)
+      return false;
+    md = EVP_get_digestbynid(nid);
+    if (md == nullptr)
+      return false;
+  }
+
+  int padding = params.flags & SignConfiguration::kHasPadding
+      ? params.padding
+      : GetDefaultSignPadding(m_pkey);
+
+  Maybe<int> salt_length = params.flags & SignConfiguration::kHasSaltLength
+      ? Just<int>(params.salt_length) : Nothing<int>();
+
+  EVPMDPointer mdctx(EVP_MD_CTX_new());
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_length;
+  for (size_t i = 0; i < count; i++) {
+    if (!mdctx ||
+        !EVP_DigestInit_ex(mdctx.get(), md, nullptr) ||
+        !EVP_DigestUpdate(
+            mdctx.get(),
+            params.data[i].data<unsigned char>(),
+            params.data[i].size()) ||
+        !EVP_DigestFinal_ex(mdctx.get(), digest, &digest_length)) {
+      return false;
+    }
+    // A verification leaves state behind in the context (e.g. for RSA-PSS),
+    // so every signature is verified with a fresh one.
+    EVPKeyCtxPointer pkctx(EVP_PKEY_CTX_new(m_pkey.get(), nullptr));
+    if (!pkctx ||
+        EVP_PKEY_verify_init(pkctx.get()) <= 0 ||
+        EVP_PKEY_CTX_set_signature_md(pkctx.get(), md) <= 0 ||
+        !ApplyRSAOptions(m_pkey, pkctx.get(), padding, salt_length)) {
+      return false;
+    }
+    results[i] = EVP_PKEY_verify(
+        pkctx.get(),
+        params.signatures[i].data<unsigned char>(),
+        params.signatures[i].size(),
+        digest,
+        digest_length) == 1;
+    if (!results[i])
+      ERR_clear_error();
+  }
+
+  *out = std::move(buf);
+  return true;
+}
+
+Maybe<bool> VerifyBatchTraits::EncodeOutput(
+    Environment* env,
+    const VerifyBatchConfiguration& params,
+    ByteSource* out,
+    Local<Value>* result) {
+  const size_t length = out->size();
+  *result = Uint8Array::New(out->ToArrayBuffer(env), 0, length);
+  return Just(!result->IsEmpty());
+}
+
 }  // namespace crypto
 }  // namespace node
@@ -10,6 +10,8 @@
 #include "env.h"
 #include "memory_tracker.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 static const unsigned int kNoDsaSignature = static_cast<unsigned int>(-1);
@@ -160,6 +162,58 @@ struct SignTraits final {
 
 using SignJob = DeriveBitsJob<SignTraits>;
 
+// Verifies a list of signatures with the same key and algorithm in a single
+// job. The key context is prepared once and reused for all of them, and the
+// result holds 1 for each valid signature and 0 for each invalid one.
+struct VerifyBatchConfiguration final : public MemoryRetainer {
+  CryptoJobMode job_mode;
+  std::shared_ptr<KeyObjectData> key;
+  std::vector<ByteSource> data;
+  std::vector<ByteSource> signatures;
+  const EVP_MD* digest = nullptr;
+  int flags = SignConfiguration::kHasNone;
+  int padding = 0;
+  int salt_length = 0;
+
+  VerifyBatchConfiguration() = default;
+
+  explicit VerifyBatchConfiguration(VerifyBatchConfiguration&& other) noexcept;
+
+  VerifyBatchConfiguration& operator=(
+      VerifyBatchConfiguration&& other) noexcept;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(VerifyBatchConfiguration);
+  SET_SELF_SIZE(VerifyBatchConfiguration);
+};
+
+struct VerifyBatchTraits final {
+  using AdditionalParameters = VerifyBatchConfiguration;
+  static constexpr const char* JobName = "VerifyBatchJob";
+
+  static constexpr AsyncWrap::ProviderType Provider =
+      AsyncWrap::PROVIDER_VERIFYREQUEST;
+
+  static v8::Maybe<bool> AdditionalConfig(
+      CryptoJobMode mode,
+      const v8::FunctionCallbackInfo<v8::Value>& args,
+      unsigned int offset,
+      VerifyBatchConfiguration* params);
+
+  static bool DeriveBits(
+      Environment* env,
+      const VerifyBatchConfiguration& params,
+      ByteSource* out);
+
+  static v8::Maybe<bool> EncodeOutput(
+      Environment* env,
+      const VerifyBatchConfiguration& params,
+      ByteSource* out,
+      v8::Local<v8::Value>* result);
+};
+
+using VerifyBatchJob = DeriveBitsJob<VerifyBatchTraits>;
+
 }  // namespace crypto
 }  // namespace node
 
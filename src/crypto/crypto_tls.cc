@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "crypto/crypto_tls.h"
+#include "crypto/crypto_async_key.h"
 #include "crypto/crypto_context.h"
 #include "crypto/crypto_common.h"
 #include "crypto/crypto_util.h"
@@ -71,7 +72,16 @@ SSL_SESSION* GetSessionCallback(
     int* copy) {
   TLSWrap* w = static_cast<TLSWrap*>(SSL_get_app_data(s));
   *copy = 0;
-  return w->ReleaseSession();
+  SSL_SESSION* session = w->ReleaseSession();
+  if (session != nullptr)
+    return session;
+
+  // Not loaded from JS, look the session up in the shared store, if any.
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(s)));
+  if (sc->session_store() != nullptr)
+    return sc->session_store()->Get(key, len);
+  return nullptr;
 }
 
 void OnClientHello(
@@ -135,6 +145,11 @@ int NewSessionCallback(SSL* s, SSL_SESSION* sess) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  SecureContext* sc = static_cast<SecureContext*>(
+      SSL_CTX_get_app_data(SSL_get_SSL_CTX(s)));
+  if (sc->session_store() != nullptr && SSL_is_server(s))
+    sc->session_store()->Put(sess);
+
   if (!w->has_session_callbacks())
     return 0;
 
@@ -302,7 +317,10 @@ int TLSExtStatusCallback(SSL* s, void* arg) {
 
 void ConfigureSecureContext(SecureContext* sc) {
   // OCSP stapling
-  SSL_CTX_set_tlsext_status_cb(sc->ctx_.get(), TLSExtStatusCallback);
+  SSL_CTX_set_tlsext_status_cb(
+      sc->ctx_.get(),
+      (OnLoopStack<decltype(TLSExtStatusCallback),
+                   TLSExtStatusCallback>::Call));
   SSL_CTX_set_tlsext_status_arg(sc->ctx_.get(), nullptr);
 }
 
@@ -338,7 +356,10 @@ TLSWrap::TLSWrap(Environment* env,
   CHECK(ssl_);
 
   sc_->SetGetSessionCallback(GetSessionCallback);
-  sc_->SetNewSessionCallback(NewSessionCallback);
+  sc_->SetNewSessionCallback(
+      OnLoopStack<decltype(NewSessionCallback), NewSessionCallback>::Call);
+
+  async_handshake_ = sc_->async_private_key();
 
   StreamBase::AttachToObject(GetObject());
   stream->PushStreamListener(this);
@@ -417,14 +438,19 @@ void TLSWrap::InitSSL() {
   //
   // Note on when this gets called on various openssl versions:
   //   https://github.com/openssl/openssl/issues/7199#issuecomment-420670544
-  SSL_set_info_callback(ssl_.get(), SSLInfoCallback);
+  SSL_set_info_callback(ssl_.get(), AsyncSSLInfoCallback);
 
-  if (is_server())
-    sc_->SetSelectSNIContextCallback(SelectSNIContextCallback);
+  if (is_server()) {
+    sc_->SetSelectSNIContextCallback(
+        OnLoopStack<decltype(SelectSNIContextCallback),
+                    SelectSNIContextCallback>::Call);
+  }
 
   ConfigureSecureContext(sc_.get());
 
-  SSL_set_cert_cb(ssl_.get(), SSLCertCallback, this);
+  SSL_set_cert_cb(ssl_.get(),
+                  OnLoopStack<decltype(SSLCertCallback), SSLCertCallback>::Call,
+                  this);
 
   if (is_server()) {
     SSL_set_accept_state(ssl_.get());
@@ -544,6 +570,22 @@ void TLSWrap::SSLInfoCallback(const SSL* ssl_, int where, int ret) {
   }
 }
 
+// OpenSSL reports SSL_CB_HANDSHAKE_DONE while SSL_in_init() is false, and
+// SSL_do_handshake() does not resume a paused job then. Pausing the job to call
+// into JS would leave the handshake unfinished, e.g. before a TLS 1.3 server
+// sent its session tickets, so AsyncHandshake() reports it after the job.
+void TLSWrap::AsyncSSLInfoCallback(const SSL* ssl, int where, int ret) {
+  if ((where & SSL_CB_HANDSHAKE_DONE) && ASYNC_get_current_job() != nullptr) {
+    TLSWrap* c = static_cast<TLSWrap*>(SSL_get_app_data(ssl));
+    c->handshake_done_pending_ = true;
+    where &= ~SSL_CB_HANDSHAKE_DONE;
+  }
+  if (!(where & (SSL_CB_HANDSHAKE_START | SSL_CB_HANDSHAKE_DONE)))
+    return;
+  OnLoopStack<decltype(SSLInfoCallback), SSLInfoCallback>::Call(
+      ssl, where, ret);
+}
+
 void TLSWrap::EncOut() {
   Debug(this, "Trying to write encrypted output");
 
@@ -685,6 +727,7 @@ MaybeLocal<Value> TLSWrap::GetSSLError(int status, int* err, std::string* msg) {
     case SSL_ERROR_WANT_READ:
     case SSL_ERROR_WANT_WRITE:
     case SSL_ERROR_WANT_X509_LOOKUP:
+    case SSL_ERROR_WANT_ASYNC:
       return MaybeLocal<Value>();
 
     case SSL_ERROR_ZERO_RETURN:
@@ -773,9 +816,27 @@ void TLSWrap::ClearOut() {
 
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
+  int read = 1;
+  if (InAsyncHandshake()) {
+    if (async_key_operation_) {
+      Debug(this, "Returning from ClearOut(), key operation pending");
+      return;
+    }
+    read = AsyncHandshake();
+    if (ssl_ == nullptr) {
+      Debug(this, "Returning from ClearOut(), ssl_ == nullptr");
+      return;
+    }
+    // Write the cleartext input that was held back during the handshake.
+    if (read > 0) {
+      ClearIn();
+      if (ssl_ == nullptr)
+        return;
+    }
+  }
+
   char out[kClearOutChunkSize];
-  int read;
-  for (;;) {
+  while (read > 0) {
     read = SSL_read(ssl_.get(), out, sizeof(out));
     Debug(this, "Read %d bytes of cleartext output", read);
 
@@ -783,8 +844,9 @@ void TLSWrap::ClearOut() {
       break;
 
     char* current = out;
-    while (read > 0) {
-      int avail = read;
+    int remaining = read;
+    while (remaining > 0) {
+      int avail = remaining;
 
       uv_buf_t buf = EmitAlloc(avail);
       if (static_cast<int>(buf.len) < avail)
@@ -800,7 +862,7 @@ void TLSWrap::ClearOut() {
         return;
       }
 
-      read -= avail;
+      remaining -= avail;
       current += avail;
     }
   }
@@ -837,6 +899,87 @@ void TLSWrap::ClearOut() {
   }
 }
 
+bool TLSWrap::InAsyncHandshake() const {
+  return async_handshake_ && ssl_ && !SSL_is_init_finished(ssl_.get());
+}
+
+int TLSWrap::AsyncHandshake() {
+  for (;;) {
+    // Only the handshake runs in an async job, see crypto_async_key.h.
+    SSL_set_mode(ssl_.get(), SSL_MODE_ASYNC);
+    int ret = SSL_do_handshake(ssl_.get());
+    SSL_clear_mode(ssl_.get(), SSL_MODE_ASYNC);
+    Debug(this, "SSL_do_handshake() returned %d", ret);
+    if (ret > 0) {
+      // Later renegotiations are handled by SSL_read() and SSL_write() and
+      // run their key operations synchronously.
+      async_handshake_ = false;
+      if (handshake_done_pending_) {
+        handshake_done_pending_ = false;
+        SSLInfoCallback(ssl_.get(), SSL_CB_HANDSHAKE_DONE, 1);
+      }
+      return ret;
+    }
+    if (SSL_get_error(ssl_.get(), ret) != SSL_ERROR_WANT_ASYNC)
+      return ret;
+
+    // A callback of the handshake wants to call into JS.
+    if (DeferredCall* call = TakeDeferredCall()) {
+      SSL* ssl = ssl_.get();
+      in_deferred_call_ = true;
+      call->fn();
+      in_deferred_call_ = false;
+      call->done = true;
+      if (ssl_ == nullptr) {
+        // Destroy() was called by the callback, while the job could not be
+        // resumed yet.
+        CancelAsyncHandshake(ssl);
+        SSL_free(ssl);
+        return ret;
+      }
+      continue;
+    }
+
+    async_key_operation_ = AsyncKeyOperation::TakePending();
+    if (async_key_operation_) {
+      Debug(this, "Scheduling private key operation");
+      BaseObjectPtr<TLSWrap> strong_ref{this};
+      async_key_operation_->Schedule(env(), [this, strong_ref]() {
+        Debug(this, "Private key operation done");
+        async_key_operation_.reset();
+        HandleScope handle_scope(env()->isolate());
+        Context::Scope context_scope(env()->context());
+        Cycle();
+      });
+    }
+    return ret;
+  }
+}
+
+void TLSWrap::CancelAsyncHandshake(SSL* ssl) {
+  if (async_key_operation_) {
+    async_key_operation_->Cancel();
+    async_key_operation_.reset();
+  }
+
+  // Resume the job until it ended, skipping the callbacks into JS and failing
+  // the key operations that it still makes.
+  while (SSL_waiting_for_async(ssl)) {
+    Debug(this, "Resuming the async job to end it");
+    SSL_set_mode(ssl, SSL_MODE_ASYNC);
+    int ret = SSL_do_handshake(ssl);
+    SSL_clear_mode(ssl, SSL_MODE_ASYNC);
+    if (SSL_get_error(ssl, ret) != SSL_ERROR_WANT_ASYNC)
+      break;
+    if (DeferredCall* call = TakeDeferredCall())
+      call->done = true;
+    if (std::shared_ptr<AsyncKeyOperation> operation =
+            AsyncKeyOperation::TakePending()) {
+      operation->Cancel();
+    }
+  }
+}
+
 void TLSWrap::ClearIn() {
   Debug(this, "Trying to write cleartext input");
   // Ignore cycling data if ClientHello wasn't yet parsed
@@ -855,6 +998,12 @@ void TLSWrap::ClearIn() {
     return;
   }
 
+  // SSL_write() would drive the handshake outside of its async job.
+  if (InAsyncHandshake()) {
+    Debug(this, "Returning from ClearIn(), async handshake in progress");
+    return;
+  }
+
   AllocatedBuffer data = std::move(pending_cleartext_input_);
   MarkPopErrorOnReturn mark_pop_error_on_return;
 
@@ -1010,6 +1159,23 @@ int TLSWrap::DoWrite(WriteWrap* w,
 
   int written = 0;
 
+  if (InAsyncHandshake()) {
+    // Hold the data back until the handshake is done, see ClearIn().
+    Debug(this, "Async handshake in progress, saving data for later write");
+    data = AllocatedBuffer::AllocateManaged(env(), length);
+    size_t offset = 0;
+    for (i = 0; i < count; i++) {
+      memcpy(data.data() + offset, bufs[i].base, bufs[i].len);
+      offset += bufs[i].len;
+    }
+    CHECK_EQ(pending_cleartext_input_.size(), 0);
+    pending_cleartext_input_ = std::move(data);
+    in_dowrite_ = true;
+    EncOut();
+    in_dowrite_ = false;
+    return 0;
+  }
+
   // It is common for zero length buffers to be written,
   // don't copy data if there there is one buffer with data
   // and one or more zero length buffers.
@@ -1189,7 +1355,8 @@ void TLSWrap::EnableKeylogCallback(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
   CHECK(wrap->sc_);
-  wrap->sc_->SetKeylogCallback(KeylogCallback);
+  wrap->sc_->SetKeylogCallback(
+      OnLoopStack<decltype(KeylogCallback), KeylogCallback>::Call);
 }
 
 // Check required capabilities were not excluded from the OpenSSL build:
@@ -1243,7 +1410,13 @@ void TLSWrap::Destroy() {
   InvokeQueued(UV_ECANCELED, "Canceled because of SSL destruction");
 
   env()->isolate()->AdjustAmountOfExternalAllocatedMemory(-kExternalSize);
-  ssl_.reset();
+  if (in_deferred_call_) {
+    // AsyncHandshake() frees the SSL once the callback returned.
+    USE(ssl_.release());
+  } else {
+    CancelAsyncHandshake(ssl_.get());
+    ssl_.reset();
+  }
 
   enc_in_ = nullptr;
   enc_out_ = nullptr;
@@ -1377,8 +1550,12 @@ void TLSWrap::EnablePskCallback(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
   CHECK_NOT_NULL(wrap->ssl_);
 
-  SSL_set_psk_server_callback(wrap->ssl_.get(), PskServerCallback);
-  SSL_set_psk_client_callback(wrap->ssl_.get(), PskClientCallback);
+  SSL_set_psk_server_callback(
+      wrap->ssl_.get(),
+      OnLoopStack<decltype(PskServerCallback), PskServerCallback>::Call);
+  SSL_set_psk_client_callback(
+      wrap->ssl_.get(),
+      OnLoopStack<decltype(PskClientCallback), PskClientCallback>::Call);
 }
 
 unsigned int TLSWrap::PskServerCallback(
@@ -1569,9 +1746,10 @@ void TLSWrap::SetALPNProtocols(const FunctionCallbackInfo<Value>& args) {
             env->alpn_buffer_private_symbol(),
             args[0]).FromJust());
     // Server should select ALPN protocol from list of advertised by client
-    SSL_CTX_set_alpn_select_cb(SSL_get_SSL_CTX(w->ssl_.get()),
-                               SelectALPNCallback,
-                               nullptr);
+    SSL_CTX_set_alpn_select_cb(
+        SSL_get_SSL_CTX(w->ssl_.get()),
+        OnLoopStack<decltype(SelectALPNCallback), SelectALPNCallback>::Call,
+        nullptr);
   }
 }
 
@@ -1587,7 +1765,8 @@ void TLSWrap::GetPeerCertificate(const FunctionCallbackInfo<Value>& args) {
           env,
           w->ssl_,
           abbreviated,
-          w->is_server()).ToLocal(&ret))
+          w->is_server(),
+          w->sc_ ? w->sc_->peer_certificate_cache() : nullptr).ToLocal(&ret))
     args.GetReturnValue().Set(ret);
 }
 
@@ -34,11 +34,14 @@
 
 #include <openssl/ssl.h>
 
+#include <memory>
 #include <string>
 
 namespace node {
 namespace crypto {
 
+class AsyncKeyOperation;
+
 class TLSWrap : public AsyncWrap,
                 public StreamBase,
                 public StreamListener {
@@ -138,6 +141,7 @@ class TLSWrap : public AsyncWrap,
           SecureContext* sc);
 
   static void SSLInfoCallback(const SSL* ssl_, int where, int ret);
+  static void AsyncSSLInfoCallback(const SSL* ssl, int where, int ret);
   void InitSSL();
   // SSL has a "clear" text (unencrypted) side (to/from the node API) and
   // encrypted ("enc") text side (to/from the underlying socket/stream).
@@ -148,6 +152,12 @@ class TLSWrap : public AsyncWrap,
   void EncOut();  // Write encrypted data from enc_out_ to underlying stream.
   void ClearIn();  // SSL_write() clear data "in" to SSL.
   void ClearOut();  // SSL_read() clear text "out" from SSL.
+  // Handshakes of contexts with asyncPrivateKey are driven by AsyncHandshake()
+  // rather than SSL_read() and SSL_write(), see crypto_async_key.h.
+  bool InAsyncHandshake() const;
+  int AsyncHandshake();
+  // Ends the paused async job of `ssl`, which must be done before it is freed.
+  void CancelAsyncHandshake(SSL* ssl);
   void Destroy();
 
   // Call Done() on outstanding WriteWrap request.
@@ -266,6 +276,14 @@ class TLSWrap : public AsyncWrap,
   bool shutdown_ = false;
   bool cert_cb_running_ = false;
   bool eof_ = false;
+  // Set for contexts with asyncPrivateKey until the first handshake is done.
+  bool async_handshake_ = false;
+  std::shared_ptr<AsyncKeyOperation> async_key_operation_;
+  // Destroy() leaves the SSL to AsyncHandshake() while this is set.
+  bool in_deferred_call_ = false;
+  // SSL_CB_HANDSHAKE_DONE was reported inside the async job, see
+  // AsyncSSLInfoCallback().
+  bool handshake_done_pending_ = false;
 
   // TODO(@jasnell): These state flags should be revisited.
   // The established_ flag indicates that the handshake is
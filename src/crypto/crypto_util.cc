@@ -14,6 +14,8 @@
 
 #include "math.h"
 
+#include <deque>
+
 namespace node {
 
 using v8::ArrayBuffer;
@@ -21,6 +23,7 @@ using v8::BackingStore;
 using v8::BigInt;
 using v8::Context;
 using v8::Exception;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Isolate;
@@ -657,8 +660,126 @@ void SecureHeapUsed(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(
         BigInt::New(env->isolate(), CRYPTO_secure_used()));
 }
+
+// The threads of --crypto-kdf-threads. They are shared by all Environments
+// of the process, started on first use and never stopped. Each scheduled
+// work item is completed through a uv_async_t of its own on the loop that
+// scheduled it, which also keeps that loop alive until the item is done.
+class KeyDerivationQueue final {
+ public:
+  enum Stat {
+    kThreads,
+    kPending,
+    kRunning,
+    kCompleted,
+    kStatCount
+  };
+
+  // Returns nullptr if --crypto-kdf-threads is not set.
+  static KeyDerivationQueue* Get() {
+    static KeyDerivationQueue* queue = []() -> KeyDerivationQueue* {
+      int64_t threads = per_process::cli_options->crypto_kdf_threads;
+      return threads > 0 ? new KeyDerivationQueue(threads) : nullptr;
+    }();
+    return queue;
+  }
+
+  void Schedule(ThreadPoolWork* work) {
+    Environment* env = work->env();
+    Item* item = new Item();
+    item->work = work;
+    CHECK_EQ(uv_async_init(env->event_loop(), &item->async, Done), 0);
+    env->IncreaseWaitingRequestCounter();
+    Mutex::ScopedLock lock(mutex_);
+    pending_.push_back(item);
+    cond_.Signal(lock);
+  }
+
+  void GetStats(double* stats) {
+    Mutex::ScopedLock lock(mutex_);
+    stats[kThreads] = threads_.size();
+    stats[kPending] = pending_.size();
+    stats[kRunning] = running_;
+    stats[kCompleted] = completed_;
+  }
+
+ private:
+  struct Item {
+    uv_async_t async;
+    ThreadPoolWork* work;
+  };
+
+  explicit KeyDerivationQueue(size_t threads) : threads_(threads) {
+    for (uv_thread_t& thread : threads_)
+      CHECK_EQ(uv_thread_create(&thread, Run, this), 0);
+  }
+
+  static void Run(void* data) {
+    KeyDerivationQueue* queue = static_cast<KeyDerivationQueue*>(data);
+    for (;;) {
+      Item* item;
+      {
+        Mutex::ScopedLock lock(queue->mutex_);
+        while (queue->pending_.empty())
+          queue->cond_.Wait(lock);
+        item = queue->pending_.front();
+        queue->pending_.pop_front();
+        queue->running_++;
+      }
+      item->work->DoThreadPoolWork();
+      {
+        Mutex::ScopedLock lock(queue->mutex_);
+        queue->running_--;
+        queue->completed_++;
+      }
+      // The item may be deleted as soon as this returns.
+      CHECK_EQ(uv_async_send(&item->async), 0);
+    }
+  }
+
+  static void Done(uv_async_t* async) {
+    Item* item = ContainerOf(&Item::async, async);
+    ThreadPoolWork* work = item->work;
+    Environment* env = work->env();
+    env->CloseHandle(&item->async, [](uv_async_t* async) {
+      Item* item = ContainerOf(&Item::async, async);
+      delete item;
+    });
+    env->DecreaseWaitingRequestCounter();
+    work->AfterThreadPoolWork(0);
+  }
+
+  Mutex mutex_;
+  ConditionVariable cond_;
+  std::deque<Item*> pending_;
+  std::vector<uv_thread_t> threads_;
+  size_t running_ = 0;
+  uint64_t completed_ = 0;
+};
+
+void GetKeyDerivationQueueStats(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), KeyDerivationQueue::kStatCount);
+  double* stats =
+      static_cast<double*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset() / sizeof(double);
+  KeyDerivationQueue* queue = KeyDerivationQueue::Get();
+  if (queue == nullptr) {
+    std::fill(stats, stats + KeyDerivationQueue::kStatCount, 0);
+    return;
+  }
+  queue->GetStats(stats);
+}
 }  // namespace
 
+void ScheduleKeyDerivationWork(ThreadPoolWork* work) {
+  KeyDerivationQueue* queue = KeyDerivationQueue::Get();
+  if (queue == nullptr)
+    return work->ScheduleWork();
+  queue->Schedule(work);
+}
+
 namespace Util {
 void Initialize(Environment* env, Local<Object> target) {
 #ifndef OPENSSL_NO_ENGINE
@@ -674,6 +795,8 @@ void Initialize(Environment* env, Local<Object> target) {
 
   env->SetMethod(target, "secureBuffer", SecureBuffer);
   env->SetMethod(target, "secureHeapUsed", SecureHeapUsed);
+  env->SetMethodNoSideEffect(target, "getKeyDerivationQueueStats",
+                             GetKeyDerivationQueueStats);
 }
 }  // namespace Util
 
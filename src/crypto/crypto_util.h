@@ -320,6 +320,18 @@ enum CryptoJobMode {
 
 CryptoJobMode GetCryptoJobMode(v8::Local<v8::Value> args);
 
+// PBKDF2 and scrypt jobs run on threads of their own when
+// --crypto-kdf-threads is set, so that bursts of key derivations do not
+// occupy the libuv threadpool.
+inline constexpr bool IsKeyDerivationProvider(AsyncWrap::ProviderType type) {
+  return type == AsyncWrap::PROVIDER_PBKDF2REQUEST ||
+         type == AsyncWrap::PROVIDER_SCRYPTREQUEST;
+}
+
+// Schedules `work` on the key derivation threads if there are any, and in
+// the libuv threadpool otherwise.
+void ScheduleKeyDerivationWork(ThreadPoolWork* work);
+
 template <typename CryptoJobTraits>
 class CryptoJob : public AsyncWrap, public ThreadPoolWork {
  public:
@@ -332,7 +344,7 @@ class CryptoJob : public AsyncWrap, public ThreadPoolWork {
       CryptoJobMode mode,
       AdditionalParams&& params)
       : AsyncWrap(env, object, type),
-        ThreadPoolWork(env),
+        ThreadPoolWork(env, ThreadPoolWorkClass::kCrypto),
         mode_(mode),
         params_(std::move(params)) {
     // If the CryptoJob is async, then the instance will be
@@ -387,8 +399,11 @@ class CryptoJob : public AsyncWrap, public ThreadPoolWork {
 
     CryptoJob<CryptoJobTraits>* job;
     ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
-    if (job->mode() == kCryptoJobAsync)
+    if (job->mode() == kCryptoJobAsync) {
+      if (IsKeyDerivationProvider(job->provider_type()))
+        return ScheduleKeyDerivationWork(job);
       return job->ScheduleWork();
+    }
 
     v8::Local<v8::Value> ret[2];
     env->PrintSyncTrace();
@@ -45,6 +45,7 @@ void FWrite(FILE* file, const std::string& str);
   V(HUGEPAGES)                                                                 \
   V(INSPECTOR_SERVER)                                                          \
   V(INSPECTOR_PROFILER)                                                        \
+  V(LOADER)                                                                    \
   V(CODE_CACHE)                                                                \
   V(NGTCP2_DEBUG)                                                              \
   V(WASI)                                                                      \
@@ -300,6 +300,9 @@ inline void Environment::AssignToContext(v8::Local<v8::Context> context,
   // Used to retrieve bindings
   context->SetAlignedPointerInEmbedderData(
       ContextEmbedderIndex::kBindingListIndex, &(this->bindings_));
+  // Used to keep track of the current async context frame.
+  context->SetEmbedderData(ContextEmbedderIndex::kAsyncContextFrame,
+                           v8::Undefined(isolate()));
 
 #if HAVE_INSPECTOR
   inspector_agent()->ContextCreated(context, info);
@@ -445,6 +448,33 @@ void Environment::DecreaseWaitingRequestCounter() {
   CHECK_GE(request_waiting_, 0);
 }
 
+ThreadPoolWorkClassState* Environment::threadpool_work_class_state(
+    ThreadPoolWorkClass work_class) {
+  return &threadpool_work_class_states_[static_cast<size_t>(work_class)];
+}
+
+EventLoopPhaseMonitor* Environment::event_loop_phase_monitor() {
+  return event_loop_phase_monitor_.get();
+}
+
+void Environment::EnterEventLoopPhase(EventLoopPhase phase) {
+  if (UNLIKELY(event_loop_phase_monitor_))
+    RecordEventLoopPhase(phase);
+}
+
+void Environment::CountEventLoopCallback() {
+  if (UNLIKELY(event_loop_phase_monitor_) && async_callback_scope_depth_ == 1)
+    event_loop_phase_monitor_->callbacks++;
+}
+
+GCMonitor* Environment::gc_monitor() {
+  return gc_monitor_.get();
+}
+
+void Environment::set_gc_monitor(std::unique_ptr<GCMonitor> monitor) {
+  gc_monitor_ = std::move(monitor);
+}
+
 inline uv_loop_t* Environment::event_loop() const {
   return isolate_data()->event_loop();
 }
@@ -505,6 +535,10 @@ inline void Environment::set_trace_sync_io(bool value) {
   trace_sync_io_ = value;
 }
 
+inline void Environment::set_running_event_loop(bool value) {
+  running_event_loop_ = value;
+}
+
 inline bool Environment::abort_on_uncaught_exception() const {
   return options_->abort_on_uncaught_exception;
 }
@@ -538,6 +572,10 @@ inline uint32_t Environment::get_next_script_id() {
 inline uint32_t Environment::get_next_function_id() {
   return function_id_counter_++;
 }
+inline void Environment::reserve_function_id(uint32_t id) {
+  if (function_id_counter_ <= id)
+    function_id_counter_ = id + 1;
+}
 
 ShouldNotAbortOnUncaughtScope::ShouldNotAbortOnUncaughtScope(
     Environment* env)
@@ -572,6 +610,16 @@ inline std::vector<double>* Environment::destroy_async_id_list() {
   return &destroy_async_id_list_;
 }
 
+inline std::vector<v8::Global<v8::Object>>*
+Environment::write_wrap_objects() {
+  return &write_wrap_objects_;
+}
+
+inline std::vector<v8::Global<v8::Object>>*
+Environment::shutdown_wrap_objects() {
+  return &shutdown_wrap_objects_;
+}
+
 inline double Environment::new_async_id() {
   async_hooks()->async_id_fields()[AsyncHooks::kAsyncIdCounter] += 1;
   return async_hooks()->async_id_fields()[AsyncHooks::kAsyncIdCounter];
@@ -594,6 +642,18 @@ inline double Environment::get_default_trigger_async_id() {
   return default_trigger_async_id;
 }
 
+inline bool Environment::async_context_frame_enabled() const {
+  return async_context_frame_enabled_;
+}
+
+inline v8::Local<v8::Value> Environment::async_context_frame() {
+  return context()->GetEmbedderData(ContextEmbedderIndex::kAsyncContextFrame);
+}
+
+inline void Environment::set_async_context_frame(v8::Local<v8::Value> frame) {
+  context()->SetEmbedderData(ContextEmbedderIndex::kAsyncContextFrame, frame);
+}
+
 inline std::shared_ptr<EnvironmentOptions> Environment::options() {
   return options_;
 }
@@ -782,6 +842,8 @@ inline bool Environment::has_run_bootstrapping_code() const {
 
 inline void Environment::DoneBootstrapping() {
   has_run_bootstrapping_code_ = true;
+  performance_state_->Mark(
+      performance::NODE_PERFORMANCE_MILESTONE_INTERNAL_BOOTSTRAP_COMPLETE);
   // This adjusts the return value of base_object_created_after_bootstrap() so
   // that tests that check the count do not have to account for internally
   // created BaseObjects.
@@ -896,6 +958,18 @@ std::unordered_map<char*, std::unique_ptr<v8::BackingStore>>*
   return &released_allocated_buffers_;
 }
 
+inline StreamReadSlab* Environment::stream_read_slab() {
+  return stream_read_slab_.get();
+}
+
+inline BufferPool* Environment::buffer_pool() {
+  return buffer_pool_.get();
+}
+
+inline CompileCacheHandler* Environment::compile_cache_handler() {
+  return compile_cache_handler_.get();
+}
+
 inline void Environment::ThrowError(const char* errmsg) {
   ThrowError(v8::Exception::Error, errmsg);
 }
@@ -1042,16 +1116,49 @@ inline void Environment::SetConstructorFunction(
 }
 
 void Environment::AddCleanupHook(CleanupCallback fn, void* arg) {
-  auto insertion_info = cleanup_hooks_.emplace(CleanupHookCallback {
-    fn, arg, cleanup_hook_counter_++
-  });
+  auto insertion_info = cleanup_hook_slots_.emplace(
+      CleanupHookCallback { fn, arg, 0 }, 0);
   // Make sure there was no existing element with these values.
   CHECK_EQ(insertion_info.second, true);
+  insertion_info.first->second = AddCleanupHookSlot(fn, arg);
 }
 
 void Environment::RemoveCleanupHook(CleanupCallback fn, void* arg) {
-  CleanupHookCallback search { fn, arg, 0 };
-  cleanup_hooks_.erase(search);
+  auto it = cleanup_hook_slots_.find(CleanupHookCallback { fn, arg, 0 });
+  if (it == cleanup_hook_slots_.end()) return;
+  RemoveCleanupHookSlot(it->second, fn, arg);
+  cleanup_hook_slots_.erase(it);
+}
+
+CleanupHookSlot Environment::AddCleanupHookSlot(CleanupCallback fn,
+                                                void* arg) {
+  DCHECK_NOT_NULL(fn);
+  CleanupHookCallback hook { fn, arg, cleanup_hook_counter_++ };
+  CleanupHookSlot slot;
+  if (free_cleanup_hook_slots_.empty()) {
+    slot = static_cast<CleanupHookSlot>(cleanup_hooks_.size());
+    CHECK_EQ(slot, cleanup_hooks_.size());
+    cleanup_hooks_.push_back(hook);
+  } else {
+    slot = free_cleanup_hook_slots_.back();
+    free_cleanup_hook_slots_.pop_back();
+    cleanup_hooks_[slot] = hook;
+  }
+  cleanup_hook_count_++;
+  return slot;
+}
+
+void Environment::RemoveCleanupHookSlot(CleanupHookSlot slot,
+                                        CleanupCallback fn,
+                                        void* arg) {
+  CHECK_LT(slot, cleanup_hooks_.size());
+  CleanupHookCallback& hook = cleanup_hooks_[slot];
+  // The slot may be free or in use by another hook, if this hook has already
+  // been removed.
+  if (hook.fn_ != fn || hook.arg_ != arg) return;
+  hook.fn_ = nullptr;
+  free_cleanup_hook_slots_.push_back(slot);
+  cleanup_hook_count_--;
 }
 
 size_t CleanupHookCallback::Hash::operator()(
@@ -2,11 +2,15 @@
 #include "allocated_buffer-inl.h"
 #include "async_wrap.h"
 #include "base_object-inl.h"
+#include "compile_cache.h"
 #include "debug_utils-inl.h"
 #include "diagnosticfilename-inl.h"
+#include "histogram-inl.h"
+#include "io_thread_stream.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_context_data.h"
+#include "node_contextify.h"
 #include "node_errors.h"
 #include "node_internals.h"
 #include "node_options-inl.h"
@@ -397,6 +401,16 @@ Environment::Environment(IsolateData* isolate_data,
   }
 
   destroy_async_id_list_.reserve(512);
+  async_context_frame_enabled_ = options_->experimental_async_context_frame;
+
+  stream_read_slab_ = std::make_unique<StreamReadSlab>(this);
+  buffer_pool_ = std::make_unique<BufferPool>(this);
+
+  if (!options_->code_cache_dir.empty()) {
+    compile_cache_handler_ = std::make_unique<CompileCacheHandler>(this);
+    if (!compile_cache_handler_->InitializeDirectory(options_->code_cache_dir))
+      compile_cache_handler_.reset();
+  }
 
   performance_state_ = std::make_unique<performance::PerformanceState>(
       isolate, MAYBE_FIELD_PTR(env_info, performance_state));
@@ -458,6 +472,8 @@ void Environment::InitializeMainContext(Local<Context> context,
                            per_process::node_start_time);
   performance_state_->Mark(performance::NODE_PERFORMANCE_MILESTONE_V8_START,
                            performance::performance_v8_start);
+  performance_state_->Mark(
+      performance::NODE_PERFORMANCE_MILESTONE_CONTEXT_READY);
 }
 
 Environment::~Environment() {
@@ -533,6 +549,12 @@ Environment::~Environment() {
   CHECK_EQ(base_object_count_, 0);
 }
 
+IOThread* Environment::io_thread() {
+  if (!io_thread_)
+    io_thread_ = std::make_unique<IOThread>();
+  return io_thread_.get();
+}
+
 void Environment::InitializeLibuv() {
   HandleScope handle_scope(isolate());
   Context::Scope context_scope(context());
@@ -544,6 +566,7 @@ void Environment::InitializeLibuv() {
   uv_unref(reinterpret_cast<uv_handle_t*>(immediate_check_handle()));
 
   uv_idle_init(event_loop(), immediate_idle_handle());
+  uv_idle_init(event_loop(), &deferred_task_queues_idle_handle_);
 
   uv_check_start(immediate_check_handle(), CheckImmediate);
 
@@ -600,6 +623,8 @@ void Environment::RegisterHandleCleanups() {
   register_handle(reinterpret_cast<uv_handle_t*>(timer_handle()));
   register_handle(reinterpret_cast<uv_handle_t*>(immediate_check_handle()));
   register_handle(reinterpret_cast<uv_handle_t*>(immediate_idle_handle()));
+  register_handle(
+      reinterpret_cast<uv_handle_t*>(&deferred_task_queues_idle_handle_));
   register_handle(reinterpret_cast<uv_handle_t*>(&task_queues_async_));
 }
 
@@ -648,34 +673,56 @@ void Environment::RunCleanup() {
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "RunCleanup", this);
   bindings_.clear();
+  write_wrap_objects_.clear();
+  shutdown_wrap_objects_.clear();
   CleanupHandles();
 
-  while (!cleanup_hooks_.empty() ||
+  while (cleanup_hook_count_ > 0 ||
          native_immediates_.size() > 0 ||
          native_immediates_threadsafe_.size() > 0 ||
          native_immediates_interrupts_.size() > 0) {
-    // Copy into a vector, since we can't sort an unordered_set in-place.
-    std::vector<CleanupHookCallback> callbacks(
-        cleanup_hooks_.begin(), cleanup_hooks_.end());
-    // We can't erase the copied elements from `cleanup_hooks_` yet, because we
-    // need to be able to check whether they were un-scheduled by another hook.
+    // Copy the hooks that are in use, since hooks may add or remove others.
+    std::vector<std::pair<CleanupHookSlot, CleanupHookCallback>> callbacks;
+    callbacks.reserve(cleanup_hook_count_);
+    for (size_t i = 0; i < cleanup_hooks_.size(); i++) {
+      if (cleanup_hooks_[i].fn_ != nullptr)
+        callbacks.emplace_back(static_cast<CleanupHookSlot>(i),
+                               cleanup_hooks_[i]);
+    }
 
     std::sort(callbacks.begin(), callbacks.end(),
-              [](const CleanupHookCallback& a, const CleanupHookCallback& b) {
+              [](const auto& a, const auto& b) {
       // Sort in descending order so that the most recently inserted callbacks
       // are run first.
-      return a.insertion_order_counter_ > b.insertion_order_counter_;
+      return a.second.insertion_order_counter_ >
+             b.second.insertion_order_counter_;
     });
 
-    for (const CleanupHookCallback& cb : callbacks) {
-      if (cleanup_hooks_.count(cb) == 0) {
-        // This hook was removed from the `cleanup_hooks_` set during another
-        // hook that was run earlier. Nothing to do here.
+    // A slot still holds the same hook if its insertion order counter, which
+    // is unique, has not changed.
+    auto is_in_slot = [&](CleanupHookSlot slot, const CleanupHookCallback& cb) {
+      return cleanup_hooks_[slot].fn_ != nullptr &&
+             cleanup_hooks_[slot].insertion_order_counter_ ==
+                 cb.insertion_order_counter_;
+    };
+
+    for (const auto& entry : callbacks) {
+      const CleanupHookSlot slot = entry.first;
+      const CleanupHookCallback& cb = entry.second;
+      if (!is_in_slot(slot, cb)) {
+        // This hook was removed during another hook that was run earlier.
+        // Nothing to do here.
         continue;
       }
 
       cb.fn_(cb.arg_);
-      cleanup_hooks_.erase(cb);
+      // Remove the hook unless it has removed itself.
+      if (is_in_slot(slot, cb)) {
+        auto it = cleanup_hook_slots_.find(cb);
+        if (it != cleanup_hook_slots_.end() && it->second == slot)
+          cleanup_hook_slots_.erase(it);
+        RemoveCleanupHookSlot(slot, cb.fn_, cb.arg_);
+      }
     }
     CleanupHandles();
   }
@@ -826,11 +873,20 @@ void Environment::RunTimers(uv_timer_t* handle) {
   if (!env->can_call_into_js())
     return;
 
+  env->EnterEventLoopPhase(EventLoopPhase::kTimers);
+  auto enter_pending = OnScopeLeave([&]() {
+    env->EnterEventLoopPhase(EventLoopPhase::kPending);
+  });
+
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
   Local<Object> process = env->process_object();
-  InternalCallbackScope scope(env, process, {0, 0});
+  // The timers that are due are already run as one batch.
+  InternalCallbackScope scope(env,
+                              process,
+                              {0, 0},
+                              InternalCallbackScope::kNoTaskQueueDeferral);
 
   Local<Function> cb = env->timers_callback_function();
   MaybeLocal<Value> ret;
@@ -885,10 +941,21 @@ void Environment::CheckImmediate(uv_check_t* handle) {
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
 
+  // The immediate check handle is started first, so it is the last one of
+  // the check phase.
+  auto enter_close = OnScopeLeave([&]() {
+    env->EnterEventLoopPhase(EventLoopPhase::kClose);
+  });
+
   HandleScope scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  // The I/O callbacks of the poll phase come first. Native immediates and
+  // immediates are processed as one batch each.
+  env->RunDeferredTaskQueues();
+
   env->RunAndClearNativeImmediates();
+  env->RunDeferredTaskQueues();
 
   if (env->immediate_info()->count() == 0 || !env->can_call_into_js())
     return;
@@ -902,6 +969,8 @@ void Environment::CheckImmediate(uv_check_t* handle) {
                  {0, 0}).ToLocalChecked();
   } while (env->immediate_info()->has_outstanding() && env->can_call_into_js());
 
+  env->RunDeferredTaskQueues();
+
   if (env->immediate_info()->ref_count() == 0)
     env->ToggleImmediateRef(false);
 }
@@ -917,6 +986,163 @@ void Environment::ToggleImmediateRef(bool ref) {
   }
 }
 
+EventLoopPhaseMonitor* Environment::StartEventLoopPhaseMonitor() {
+  if (event_loop_phase_monitor_ || started_cleanup_)
+    return event_loop_phase_monitor_.get();
+
+  auto monitor = std::make_unique<EventLoopPhaseMonitor>();
+  for (size_t i = 0; i < kEventLoopPhaseCount; i++) {
+    monitor->time_histograms[i] = std::make_shared<Histogram>(1, 3.6e12, 3);
+    monitor->callback_histograms[i] = std::make_shared<Histogram>();
+  }
+
+  uv_prepare_t* prepare = &monitor->prepare_handle;
+  uv_check_t* check = &monitor->check_handle;
+  CHECK_EQ(0, uv_prepare_init(event_loop(), prepare));
+  CHECK_EQ(0, uv_check_init(event_loop(), check));
+  prepare->data = this;
+  check->data = this;
+  uv_prepare_start(prepare, [](uv_prepare_t* handle) {
+    static_cast<Environment*>(handle->data)->RecordEventLoopPhase(
+        EventLoopPhase::kPoll);
+  });
+  uv_check_start(check, [](uv_check_t* handle) {
+    static_cast<Environment*>(handle->data)->RecordEventLoopPhase(
+        EventLoopPhase::kCheck);
+  });
+  uv_unref(reinterpret_cast<uv_handle_t*>(prepare));
+  uv_unref(reinterpret_cast<uv_handle_t*>(check));
+
+  HandleCleanupCb close = [](Environment* env, uv_handle_t* handle, void*) {
+    env->CloseHandle(handle, [](uv_handle_t* handle) {});
+  };
+  RegisterHandleCleanup(reinterpret_cast<uv_handle_t*>(prepare), close,
+                        nullptr);
+  RegisterHandleCleanup(reinterpret_cast<uv_handle_t*>(check), close, nullptr);
+
+  event_loop_phase_monitor_ = std::move(monitor);
+  return event_loop_phase_monitor_.get();
+}
+
+void Environment::RecordEventLoopPhase(EventLoopPhase next) {
+  EventLoopPhaseMonitor* monitor = event_loop_phase_monitor_.get();
+  uint64_t now = uv_hrtime();
+  // The phase is not known until the first one starts after the monitor was
+  // created.
+  if (monitor->phase != EventLoopPhase::kCount) {
+    size_t index = static_cast<size_t>(monitor->phase);
+    uint64_t time = now - monitor->phase_start;
+    if (monitor->phase == EventLoopPhase::kPoll) {
+      uint64_t idle = uv_metrics_idle_time(event_loop()) - monitor->idle_time;
+      time = time > idle ? time - idle : 0;
+    }
+    monitor->time_histograms[index]->Record(time);
+    monitor->callback_histograms[index]->Record(monitor->callbacks);
+  }
+  if (next == EventLoopPhase::kPoll)
+    monitor->idle_time = uv_metrics_idle_time(event_loop());
+  monitor->phase = next;
+  monitor->phase_start = now;
+  monitor->callbacks = 0;
+}
+
+// The time that a step of a garbage collection requested by RequestIdleGC()
+// may take, unless --idle-gc-time is set.
+constexpr double kDefaultIdleGCTime = 0.01;
+
+void Environment::RequestIdleGC() {
+  if (started_cleanup_)
+    return;
+
+  if (!idle_gc_prepare_handle_initialized_) {
+    CHECK_EQ(0, uv_prepare_init(event_loop(), &idle_gc_prepare_handle_));
+    uv_unref(reinterpret_cast<uv_handle_t*>(&idle_gc_prepare_handle_));
+    RegisterHandleCleanup(
+        reinterpret_cast<uv_handle_t*>(&idle_gc_prepare_handle_),
+        [](Environment* env, uv_handle_t* handle, void*) {
+          env->CloseHandle(handle, [](uv_handle_t* handle) {});
+        },
+        nullptr);
+    idle_gc_prepare_handle_initialized_ = true;
+  }
+  uv_prepare_start(&idle_gc_prepare_handle_, RunIdleGC);
+}
+
+void Environment::RunIdleGC(uv_prepare_t* handle) {
+  Environment* env =
+      ContainerOf(&Environment::idle_gc_prepare_handle_, handle);
+  // Only use the time that the loop would otherwise spend waiting.
+  int timeout = uv_backend_timeout(env->event_loop());
+  if (timeout == 0)
+    return;
+
+  double idle_time = kDefaultIdleGCTime;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    if (per_process::cli_options->idle_gc_time > 0)
+      idle_time = per_process::cli_options->idle_gc_time / 1e3;
+  }
+  if (timeout > 0)
+    idle_time = std::min(idle_time, timeout / 1e3);
+
+  HandleScope handle_scope(env->isolate());
+  if (!env->idle_gc_started_) {
+    // Starts incremental marking that reduces the memory footprint, which the
+    // idle notifications below advance and finalize.
+    env->isolate()->MemoryPressureNotification(
+        v8::MemoryPressureLevel::kModerate);
+    env->idle_gc_started_ = true;
+  }
+  double deadline =
+      env->isolate_data()->platform()->MonotonicallyIncreasingTime() +
+      idle_time;
+  if (env->isolate()->IdleNotificationDeadline(deadline)) {
+    env->idle_gc_started_ = false;
+    uv_prepare_stop(handle);
+  }
+}
+
+bool Environment::DeferTaskQueues() {
+  const uint64_t batch_size = options_->tick_batch_size;
+  if (batch_size <= 1 || !running_event_loop_ || started_cleanup_)
+    return false;
+
+  if (++deferred_callbacks_ >= batch_size) {
+    // This bounds the time that a tick or a microtask may have to wait.
+    deferred_callbacks_ = 0;
+    uv_idle_stop(&deferred_task_queues_idle_handle_);
+    return false;
+  }
+
+  if (deferred_callbacks_ == 1) {
+    // The queues are processed in the check phase, after the poll phase
+    // callbacks, or in the idle phase of the next loop iteration for the
+    // callbacks of the later phases. The idle handle also keeps the loop from
+    // blocking in poll until then.
+    uv_idle_start(&deferred_task_queues_idle_handle_, [](uv_idle_t* handle) {
+      Environment* env = ContainerOf(
+          &Environment::deferred_task_queues_idle_handle_, handle);
+      HandleScope handle_scope(env->isolate());
+      Context::Scope context_scope(env->context());
+      env->RunDeferredTaskQueues();
+    });
+  }
+  return true;
+}
+
+void Environment::RunDeferredTaskQueues() {
+  if (deferred_callbacks_ == 0)
+    return;
+  deferred_callbacks_ = 0;
+  uv_idle_stop(&deferred_task_queues_idle_handle_);
+  if (!can_call_into_js())
+    return;
+
+  InternalCallbackScope scope(this,
+                              process_object(),
+                              {0, 0},
+                              InternalCallbackScope::kNoTaskQueueDeferral);
+}
 
 Local<Value> Environment::GetNow() {
   uv_update_time(event_loop());
@@ -1217,6 +1443,19 @@ void Environment::PrintAllBaseObjects() {
   });
 }
 
+bool Environment::VerifyBaseObjectsSnapshotable() {
+  bool snapshotable = true;
+  ForEachBaseObject([&](BaseObject* obj) {
+    if (!obj->is_snapshotable()) {
+      fprintf(stderr,
+              "Cannot include %s in the snapshot\n",
+              obj->MemoryInfoName().c_str());
+      snapshotable = false;
+    }
+  });
+  return snapshotable;
+}
+
 void Environment::VerifyNoStrongBaseObjects() {
   // When a process exits cleanly, i.e. because the event loop ends up without
   // things to wait for, the Node.js objects that are left on the heap should
@@ -1251,11 +1490,21 @@ EnvSerializeInfo Environment::Serialize(SnapshotCreator* creator) {
   EnvSerializeInfo info;
   Local<Context> ctx = context();
 
+  write_wrap_objects_.clear();
+  shutdown_wrap_objects_.clear();
+
   SerializeBindingData(this, creator, &info);
   // Currently all modules are compiled without cache in builtin snapshot
-  // builder.
+  // builder, but the ones that are loaded by the application when building
+  // a user-land snapshot may have been compiled with cache.
   info.native_modules = std::vector<std::string>(
       native_modules_without_cache.begin(), native_modules_without_cache.end());
+  info.native_modules.insert(info.native_modules.end(),
+                             native_modules_with_cache.begin(),
+                             native_modules_with_cache.end());
+
+  for (const auto& entry : id_to_function_map)
+    entry.second->PrepareForSerialization(ctx, creator);
 
   info.async_hooks = async_hooks_.Serialize(ctx, creator);
   info.immediate_info = immediate_info_.Serialize(ctx, creator);
@@ -1606,8 +1855,15 @@ void Environment::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("should_abort_on_uncaught_toggle",
                       should_abort_on_uncaught_toggle_);
   tracker->TrackField("stream_base_state", stream_base_state_);
+  tracker->TrackField("stream_read_slab", stream_read_slab_);
+  tracker->TrackField("buffer_pool", buffer_pool_);
+  tracker->TrackFieldWithSize(
+      "cleanup_hooks", cleanup_hooks_.capacity() * sizeof(CleanupHookCallback));
+  tracker->TrackField("free_cleanup_hook_slots", free_cleanup_hook_slots_);
   tracker->TrackFieldWithSize(
-      "cleanup_hooks", cleanup_hooks_.size() * sizeof(CleanupHookCallback));
+      "cleanup_hook_slots",
+      cleanup_hook_slots_.size() *
+          (sizeof(CleanupHookCallback) + sizeof(CleanupHookSlot)));
   tracker->TrackField("async_hooks", async_hooks_);
   tracker->TrackField("immediate_info", immediate_info_);
   tracker->TrackField("tick_info", tick_info_);
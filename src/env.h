@@ -46,6 +46,7 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <list>
@@ -106,6 +107,146 @@ struct PackageConfig {
 };
 }  // namespace loader
 
+// The classes of ThreadPoolWork that --threadpool-limits can limit.
+#define THREADPOOL_WORK_CLASSES(V)                                            \
+  V(kCrypto, "crypto")                                                        \
+  V(kZlib, "zlib")                                                            \
+  V(kNapi, "napi")                                                            \
+  V(kOther, "other")
+
+enum class ThreadPoolWorkClass {
+#define V(name, _) name,
+  THREADPOOL_WORK_CLASSES(V)
+#undef V
+  kCount
+};
+
+constexpr size_t kThreadPoolWorkClassCount =
+    static_cast<size_t>(ThreadPoolWorkClass::kCount);
+
+class Histogram;
+class ThreadPoolWork;
+
+// The work of one class that an Environment has handed to the threadpool,
+// and the work that waits for the class to get below its limit.
+struct ThreadPoolWorkClassState {
+  uint64_t scheduled = 0;
+  uint64_t completed = 0;
+  uint32_t running = 0;
+  std::deque<ThreadPoolWork*> pending;
+  // Set by perf_hooks.monitorThreadpool(). The queue wait and the run time
+  // of the work are recorded on the threadpool threads, in nanoseconds.
+  std::shared_ptr<Histogram> wait_histogram;
+  std::shared_ptr<Histogram> run_histogram;
+};
+
+// The phases of the event loop that perf_hooks.monitorEventLoopPhases()
+// records, in the order that libuv runs them in.
+#define EVENT_LOOP_PHASES(V)                                                  \
+  V(kTimers, "timers")                                                        \
+  V(kPending, "pending")                                                      \
+  V(kPoll, "poll")                                                            \
+  V(kCheck, "check")                                                          \
+  V(kClose, "close")
+
+enum class EventLoopPhase {
+#define V(name, _) name,
+  EVENT_LOOP_PHASES(V)
+#undef V
+  kCount
+};
+
+constexpr size_t kEventLoopPhaseCount =
+    static_cast<size_t>(EventLoopPhase::kCount);
+
+// Created by perf_hooks.monitorEventLoopPhases(). libuv has no hooks for the
+// start and the end of its phases, so they are inferred from the callbacks
+// of Environment::RunTimers(), CheckImmediate() and the handles below, which
+// mark the start of the phases. The time of a phase is recorded when the
+// next one starts. Since there is nothing that marks the start of the pending
+// phase when no timers are due, its time is counted in the close phase of the
+// previous iteration then.
+struct EventLoopPhaseMonitor {
+  // Started after the other prepare and check handles of the Environment, so
+  // that libuv runs them first in their phases.
+  uv_prepare_t prepare_handle;
+  uv_check_t check_handle;
+  EventLoopPhase phase = EventLoopPhase::kCount;
+  uint64_t phase_start = 0;
+  // The loop idle time at the start of the poll phase. The time that the
+  // loop is blocked for in the poll phase is not counted as its time.
+  uint64_t idle_time = 0;
+  uint32_t callbacks = 0;
+  // The time of each phase, in nanoseconds, and the number of calls into
+  // JavaScript that were made in it.
+  std::array<std::shared_ptr<Histogram>, kEventLoopPhaseCount> time_histograms;
+  std::array<std::shared_ptr<Histogram>, kEventLoopPhaseCount>
+      callback_histograms;
+};
+
+// The types of GC that perf_hooks.monitorGC() records separately.
+#define GC_MONITOR_TYPES(V)                                                   \
+  V(kScavenge, v8::kGCTypeScavenge, "scavenge")                               \
+  V(kMarkSweepCompact, v8::kGCTypeMarkSweepCompact, "markSweepCompact")       \
+  V(kIncrementalMarking,                                                      \
+    v8::kGCTypeIncrementalMarking,                                            \
+    "incrementalMarking")                                                     \
+  V(kProcessWeakCallbacks,                                                    \
+    v8::kGCTypeProcessWeakCallbacks,                                          \
+    "processWeakCallbacks")
+
+enum class GCMonitorType {
+#define V(name, _, __) name,
+  GC_MONITOR_TYPES(V)
+#undef V
+  kCount
+};
+
+constexpr size_t kGCMonitorTypeCount =
+    static_cast<size_t>(GCMonitorType::kCount);
+
+// The fields of GCMonitor::fields. They are followed by the used and the
+// total size of each heap space after the last GC, in bytes.
+enum GCMonitorFields {
+  // The number of GCs of each type, and their total pause time in
+  // nanoseconds, in the order of GC_MONITOR_TYPES.
+  kGCMonitorTypeFields = 0,
+  kGCMonitorBytesAllocated = kGCMonitorTypeFields + 2 * kGCMonitorTypeCount,
+  kGCMonitorBytesFreed,
+  kGCMonitorBytesPromoted,
+  kGCMonitorHeapSpaceFields
+};
+
+// Created by perf_hooks.monitorGC(). It is updated by GC prologue and
+// epilogue callbacks that neither allocate on the JavaScript heap nor call
+// into JavaScript, so that even frequent scavenges stay cheap to record.
+// The heap grows only by allocation between GCs, so the bytes allocated are
+// the growth of the heap from the end of one GC to the start of the next.
+struct GCMonitor {
+  GCMonitor(v8::Isolate* isolate, size_t heap_space_count)
+      : fields(isolate,
+               kGCMonitorHeapSpaceFields + 2 * heap_space_count) {}
+
+  // The pause time of each type of GC, in nanoseconds.
+  std::array<std::shared_ptr<Histogram>, kGCMonitorTypeCount>
+      pause_histograms;
+  // The rate at which the heap grew between a GC and the start of the next
+  // one, in bytes per second.
+  std::shared_ptr<Histogram> allocation_rate_histogram;
+  AliasedFloat64Array fields;
+
+  // The indexes of new_space and new_large_object_space. The bytes promoted
+  // by a scavenge are the growth of the other spaces.
+  std::vector<size_t> young_spaces;
+  // V8 may start a GC of one type while one of another type runs, so the
+  // start of each is kept separately.
+  std::array<uint64_t, kGCMonitorTypeCount> start_time {};
+  std::array<size_t, kGCMonitorTypeCount> start_used {};
+  std::array<size_t, kGCMonitorTypeCount> start_young_used {};
+  uint64_t last_end_time = 0;
+  size_t last_end_used = 0;
+};
+
 enum class FsStatsOffset {
   kDev = 0,
   kMode,
@@ -150,6 +291,7 @@ constexpr size_t kFsStatsBufferLength =
 #define PER_ISOLATE_PRIVATE_SYMBOL_PROPERTIES(V)                              \
   V(alpn_buffer_private_symbol, "node:alpnBuffer")                            \
   V(arrow_message_private_symbol, "node:arrowMessage")                        \
+  V(async_context_frame_private_symbol, "node:asyncContextFrame")             \
   V(contextify_context_private_symbol, "node:contextify:context")             \
   V(contextify_global_private_symbol, "node:contextify:global")               \
   V(decorated_private_symbol, "node:decorated")                               \
@@ -168,6 +310,7 @@ constexpr size_t kFsStatsBufferLength =
   V(messaging_clone_symbol, "messaging_clone_symbol")                          \
   V(messaging_transfer_list_symbol, "messaging_transfer_list_symbol")          \
   V(oninit_symbol, "oninit")                                                   \
+  V(onmessages_symbol, "onmessages")                                           \
   V(owner_symbol, "owner_symbol")                                              \
   V(onpskexchange_symbol, "onpskexchange")                                     \
   V(resource_symbol, "resource_symbol")                                        \
@@ -177,11 +320,13 @@ constexpr size_t kFsStatsBufferLength =
 // for the sake of convenience.  Strings should be ASCII-only.
 #define PER_ISOLATE_STRING_PROPERTIES(V)                                       \
   V(ack_string, "ack")                                                         \
+  V(adaptive_window_size_string, "adaptiveWindowSize")                         \
   V(address_string, "address")                                                 \
   V(aliases_string, "aliases")                                                 \
   V(args_string, "args")                                                       \
   V(asn1curve_string, "asn1Curve")                                             \
   V(async_ids_stack_string, "async_ids_stack")                                 \
+  V(bdp_estimate_string, "bdpEstimate")                                        \
   V(bits_string, "bits")                                                       \
   V(block_list_string, "blockList")                                            \
   V(buffer_string, "buffer")                                                   \
@@ -335,6 +480,7 @@ constexpr size_t kFsStatsBufferLength =
   V(ondone_string, "ondone")                                                   \
   V(onerror_string, "onerror")                                                 \
   V(onexit_string, "onexit")                                                   \
+  V(onheapgrowth_string, "onheapgrowth")                                       \
   V(onhandshakedone_string, "onhandshakedone")                                 \
   V(onhandshakestart_string, "onhandshakestart")                               \
   V(onkeylog_string, "onkeylog")                                               \
@@ -386,6 +532,7 @@ constexpr size_t kFsStatsBufferLength =
   V(retry_string, "retry")                                                     \
   V(scheme_string, "scheme")                                                   \
   V(scopeid_string, "scopeid")                                                 \
+  V(sent_string, "sent")                                                       \
   V(serial_number_string, "serialNumber")                                      \
   V(serial_string, "serial")                                                   \
   V(servername_string, "servername")                                           \
@@ -436,6 +583,7 @@ constexpr size_t kFsStatsBufferLength =
   V(value_string, "value")                                                     \
   V(verify_error_string, "verifyError")                                        \
   V(version_string, "version")                                                 \
+  V(vfork_string, "vfork")                                                     \
   V(weight_string, "weight")                                                   \
   V(windows_hide_string, "windowsHide")                                        \
   V(windows_verbatim_arguments_string, "windowsVerbatimArguments")             \
@@ -465,6 +613,7 @@ constexpr size_t kFsStatsBufferLength =
   V(http2stream_constructor_template, v8::ObjectTemplate)                      \
   V(http2ping_constructor_template, v8::ObjectTemplate)                        \
   V(i18n_converter_template, v8::ObjectTemplate)                               \
+  V(immutable_buffer_constructor_template, v8::FunctionTemplate)               \
   V(intervalhistogram_constructor_template, v8::FunctionTemplate)              \
   V(libuv_stream_wrap_ctor_template, v8::FunctionTemplate)                     \
   V(message_port_constructor_template, v8::FunctionTemplate)                   \
@@ -497,6 +646,7 @@ constexpr size_t kFsStatsBufferLength =
   V(crypto_key_object_private_constructor, v8::Function)                       \
   V(crypto_key_object_public_constructor, v8::Function)                        \
   V(crypto_key_object_secret_constructor, v8::Function)                        \
+  V(diagnostics_channel_publish_function, v8::Function)                        \
   V(domexception_function, v8::Function)                                       \
   V(enhance_fatal_stack_after_inspector, v8::Function)                         \
   V(enhance_fatal_stack_before_inspector, v8::Function)                        \
@@ -531,7 +681,7 @@ constexpr size_t kFsStatsBufferLength =
   V(primordials_safe_weak_set_prototype_object, v8::Object)                    \
   V(promise_hook_handler, v8::Function)                                        \
   V(promise_reject_callback, v8::Function)                                     \
-  V(script_data_constructor_function, v8::Function)                            \
+  V(snapshot_deserialize_main, v8::Function)                                   \
   V(source_map_cache_getter, v8::Function)                                     \
   V(tick_callback_function, v8::Function)                                      \
   V(timers_callback_function, v8::Function)                                    \
@@ -541,6 +691,10 @@ constexpr size_t kFsStatsBufferLength =
   V(url_constructor_function, v8::Function)
 
 class Environment;
+class StreamReadSlab;
+class IOThread;
+class BufferPool;
+class CompileCacheHandler;
 struct AllocatedBuffer;
 
 typedef size_t SnapshotIndex;
@@ -872,6 +1026,10 @@ class ShouldNotAbortOnUncaughtScope {
   Environment* env_;
 };
 
+// The index of a cleanup hook in the Environment's list of hooks. See
+// Environment::AddCleanupHookSlot().
+typedef uint32_t CleanupHookSlot;
+
 class CleanupHookCallback {
  public:
   typedef void (*Callback)(void*);
@@ -896,6 +1054,7 @@ class CleanupHookCallback {
 
  private:
   friend class Environment;
+  // `nullptr` for slots that are not in use.
   Callback fn_;
   void* arg_;
 
@@ -941,6 +1100,27 @@ struct EnvSerializeInfo {
   friend std::ostream& operator<<(std::ostream& o, const EnvSerializeInfo& i);
 };
 
+// Everything that is needed to start from a snapshot that is built at
+// runtime with --build-snapshot, as opposed to the one that is embedded
+// into the binary at build time.
+struct SnapshotData {
+  SnapshotData() = default;
+  ~SnapshotData();
+  SnapshotData(const SnapshotData&) = delete;
+  SnapshotData& operator=(const SnapshotData&) = delete;
+
+  // The result of v8::SnapshotCreator::CreateBlob(), owned by this object.
+  v8::StartupData blob = {nullptr, 0};
+  std::vector<size_t> isolate_data_indices;
+  EnvSerializeInfo env_info;
+
+  // Returns false if the blob could not be written completely.
+  bool ToBlob(FILE* out) const;
+  // Returns false if the file is not a snapshot blob written by this
+  // version of Node.js.
+  static bool FromBlob(SnapshotData* out, FILE* in);
+};
+
 class Environment : public MemoryRetainer {
  public:
   Environment(const Environment&) = delete;
@@ -959,6 +1139,9 @@ class Environment : public MemoryRetainer {
   void DeserializeProperties(const EnvSerializeInfo* info);
 
   void PrintAllBaseObjects();
+  // Prints the BaseObjects that cannot be serialized into a snapshot to
+  // stderr, and returns false if there are any.
+  bool VerifyBaseObjectsSnapshotable();
   void VerifyNoStrongBaseObjects();
   void EnqueueDeserializeRequest(DeserializeRequestCallback cb,
                                  v8::Local<v8::Object> holder,
@@ -1081,6 +1264,25 @@ class Environment : public MemoryRetainer {
   inline void IncreaseWaitingRequestCounter();
   inline void DecreaseWaitingRequestCounter();
 
+  inline ThreadPoolWorkClassState* threadpool_work_class_state(
+      ThreadPoolWorkClass work_class);
+
+  inline EventLoopPhaseMonitor* event_loop_phase_monitor();
+  // Starts the handles that perf_hooks.monitorEventLoopPhases() needs.
+  EventLoopPhaseMonitor* StartEventLoopPhaseMonitor();
+  // Called at the start of the phases of the event loop that the handles of
+  // the monitor do not see, and for every outermost call into JavaScript.
+  inline void EnterEventLoopPhase(EventLoopPhase phase);
+  inline void CountEventLoopCallback();
+
+  // Has V8 collect garbage to reduce memory use, in steps that are made when
+  // the event loop is about to wait for events. Used by v8.requestIdleGC().
+  void RequestIdleGC();
+
+  // Set by perf_hooks.monitorGC().
+  inline GCMonitor* gc_monitor();
+  inline void set_gc_monitor(std::unique_ptr<GCMonitor> monitor);
+
   inline AsyncHooks* async_hooks();
   inline ImmediateInfo* immediate_info();
   inline TickInfo* tick_info();
@@ -1116,8 +1318,19 @@ class Environment : public MemoryRetainer {
   inline double trigger_async_id();
   inline double get_default_trigger_async_id();
 
+  // The async context frame that is current on the main context, see
+  // src/async_context_frame.h. Only used with
+  // --experimental-async-context-frame.
+  inline bool async_context_frame_enabled() const;
+  inline v8::Local<v8::Value> async_context_frame();
+  inline void set_async_context_frame(v8::Local<v8::Value> frame);
+
   // List of id's that have been destroyed and need the destroy() cb called.
   inline std::vector<double>* destroy_async_id_list();
+  // Objects of the write and shutdown requests that Node.js makes itself,
+  // kept for reuse by StreamBase::Write() and StreamBase::Shutdown().
+  inline std::vector<v8::Global<v8::Object>>* write_wrap_objects();
+  inline std::vector<v8::Global<v8::Object>>* shutdown_wrap_objects();
 
   std::set<std::string> native_modules_with_cache;
   std::set<std::string> native_modules_without_cache;
@@ -1134,6 +1347,9 @@ class Environment : public MemoryRetainer {
   inline uint32_t get_next_module_id();
   inline uint32_t get_next_script_id();
   inline uint32_t get_next_function_id();
+  // Makes sure that |id| is not handed out again, e.g. because the function
+  // that was compiled with it has been deserialized from a snapshot.
+  inline void reserve_function_id(uint32_t id);
 
   EnabledDebugList* enabled_debug_list() { return &enabled_debug_list_; }
 
@@ -1318,6 +1534,17 @@ class Environment : public MemoryRetainer {
   // This needs to be available for the JS-land setImmediate().
   void ToggleImmediateRef(bool ref);
 
+  // With --tick-batch-size, the nextTick and microtask queues are processed
+  // once after a batch of callbacks instead of after every one of them.
+  // Returns true if the callback scope that is being closed should leave
+  // them to RunDeferredTaskQueues().
+  bool DeferTaskQueues();
+  void RunDeferredTaskQueues();
+  // The queues are only deferred while the event loop runs. Callbacks from
+  // outside of it, like 'beforeExit', would otherwise start the idle handle
+  // and keep the loop alive.
+  inline void set_running_event_loop(bool value);
+
   inline void PushShouldNotAbortOnUncaughtScope();
   inline void PopShouldNotAbortOnUncaughtScope();
   inline bool inside_should_not_abort_on_uncaught_scope() const;
@@ -1331,6 +1558,15 @@ class Environment : public MemoryRetainer {
   using CleanupCallback = CleanupHookCallback::Callback;
   inline void AddCleanupHook(CleanupCallback cb, void* arg);
   inline void RemoveCleanupHook(CleanupCallback cb, void* arg);
+  // Like AddCleanupHook(), but returns the slot of the hook, through which it
+  // is removed in constant time and without hashing. This is meant for
+  // objects that are created and destroyed often, like BaseObjects, which
+  // keep track of the slot themselves. As with RemoveCleanupHook(), removing
+  // a hook that has already run or been removed does nothing.
+  inline CleanupHookSlot AddCleanupHookSlot(CleanupCallback cb, void* arg);
+  inline void RemoveCleanupHookSlot(CleanupHookSlot slot,
+                                    CleanupCallback cb,
+                                    void* arg);
   void RunCleanup();
 
   static size_t NearHeapLimitCallback(void* data,
@@ -1397,6 +1633,12 @@ class Environment : public MemoryRetainer {
 
   inline std::unordered_map<char*, std::unique_ptr<v8::BackingStore>>*
       released_allocated_buffers();
+  inline StreamReadSlab* stream_read_slab();
+  // Started the first time that a socket is moved to it.
+  IOThread* io_thread();
+  inline BufferPool* buffer_pool();
+  // nullptr unless --code-cache-dir is used.
+  inline CompileCacheHandler* compile_cache_handler();
 
   void AddUnmanagedFd(int fd);
   void RemoveUnmanagedFd(int fd);
@@ -1414,6 +1656,15 @@ class Environment : public MemoryRetainer {
   uv_timer_t timer_handle_;
   uv_check_t immediate_check_handle_;
   uv_idle_t immediate_idle_handle_;
+  uv_idle_t deferred_task_queues_idle_handle_;
+  // Initialized by the first RequestIdleGC() call, and started while a
+  // garbage collection is requested.
+  uv_prepare_t idle_gc_prepare_handle_;
+  bool idle_gc_prepare_handle_initialized_ = false;
+  bool idle_gc_started_ = false;
+  // The number of callbacks for which the task queues have been deferred.
+  uint64_t deferred_callbacks_ = 0;
+  bool running_event_loop_ = false;
   uv_async_t task_queues_async_;
   int64_t task_queues_async_refs_ = 0;
 
@@ -1431,6 +1682,8 @@ class Environment : public MemoryRetainer {
 
   size_t async_callback_scope_depth_ = 0;
   std::vector<double> destroy_async_id_list_;
+  std::vector<v8::Global<v8::Object>> write_wrap_objects_;
+  std::vector<v8::Global<v8::Object>> shutdown_wrap_objects_;
 
 #if HAVE_INSPECTOR
   std::unique_ptr<profiler::V8CoverageConnection> coverage_connection_;
@@ -1479,6 +1732,7 @@ class Environment : public MemoryRetainer {
   bool has_serialized_options_ = false;
 
   std::atomic_bool can_call_into_js_ { true };
+  bool async_context_frame_enabled_ = false;
   uint64_t flags_;
   uint64_t thread_id_;
   std::unordered_set<worker::Worker*> sub_worker_contexts_;
@@ -1505,6 +1759,11 @@ class Environment : public MemoryRetainer {
   std::list<HandleCleanup> handle_cleanup_queue_;
   int handle_cleanup_waiting_ = 0;
   int request_waiting_ = 0;
+  std::array<ThreadPoolWorkClassState, kThreadPoolWorkClassCount>
+      threadpool_work_class_states_;
+  std::unique_ptr<EventLoopPhaseMonitor> event_loop_phase_monitor_;
+  std::unique_ptr<GCMonitor> gc_monitor_;
+  void RecordEventLoopPhase(EventLoopPhase next);
 
   EnabledDebugList enabled_debug_list_;
 
@@ -1534,13 +1793,21 @@ class Environment : public MemoryRetainer {
   std::atomic<Environment**> interrupt_data_ {nullptr};
   void RequestInterruptFromV8();
   static void CheckImmediate(uv_check_t* handle);
+  static void RunIdleGC(uv_prepare_t* handle);
 
   BindingDataStore bindings_;
 
-  // Use an unordered_set, so that we have efficient insertion and removal.
-  std::unordered_set<CleanupHookCallback,
+  // Cleanup hooks are kept in slots, and the slots of removed hooks are
+  // reused, so that adding and removing hooks only takes a few stores.
+  std::vector<CleanupHookCallback> cleanup_hooks_;
+  std::vector<CleanupHookSlot> free_cleanup_hook_slots_;
+  size_t cleanup_hook_count_ = 0;
+  // The slots of the hooks that are added through AddCleanupHook(), which
+  // are removed by their function and argument.
+  std::unordered_map<CleanupHookCallback,
+                     CleanupHookSlot,
                      CleanupHookCallback::Hash,
-                     CleanupHookCallback::Equal> cleanup_hooks_;
+                     CleanupHookCallback::Equal> cleanup_hook_slots_;
   uint64_t cleanup_hook_counter_ = 0;
   bool started_cleanup_ = false;
 
@@ -1572,6 +1839,17 @@ class Environment : public MemoryRetainer {
   // a given pointer.
   std::unordered_map<char*, std::unique_ptr<v8::BackingStore>>
       released_allocated_buffers_;
+
+  // Used by EmitToJSStreamListener for read buffers.
+  std::unique_ptr<StreamReadSlab> stream_read_slab_;
+
+  // Makes the system calls of IOThreadStreams.
+  std::unique_ptr<IOThread> io_thread_;
+
+  // Used by AllocatedBuffer::ToPooledBuffer() for small Buffers.
+  std::unique_ptr<BufferPool> buffer_pool_;
+
+  std::unique_ptr<CompileCacheHandler> compile_cache_handler_;
 };
 
 }  // namespace node
@@ -25,15 +25,28 @@
 #include "handle_wrap.h"
 #include "string_bytes.h"
 
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#endif  // __linux__
 
 namespace node {
 
+using v8::Array;
 using v8::Context;
 using v8::DontDelete;
 using v8::DontEnum;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
 using v8::Integer;
 using v8::Local;
 using v8::MaybeLocal;
@@ -42,6 +55,7 @@ using v8::PropertyAttribute;
 using v8::ReadOnly;
 using v8::Signature;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace {
@@ -74,6 +88,411 @@ class FSEventWrap: public HandleWrap {
 };
 
 
+#ifdef __linux__
+// Watches whole trees on Linux, where uv_fs_event_t cannot watch recursively.
+// lib/internal/fs/watchers.js creates one per Environment, and the recursive
+// watchers of the Environment share its inotify instance: it holds a watch
+// descriptor for every directory below their roots, and the directories that
+// several of them watch are only watched once. The events read within the
+// debounce window are coalesced and passed to JS in one batch.
+class InotifyWrap : public HandleWrap {
+ public:
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Start(const FunctionCallbackInfo<Value>& args);
+  static void Watch(const FunctionCallbackInfo<Value>& args);
+  static void Unwatch(const FunctionCallbackInfo<Value>& args);
+
+  void Close(Local<Value> close_callback) override;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(InotifyWrap)
+  SET_SELF_SIZE(InotifyWrap)
+
+ private:
+  struct Directory {
+    std::string path;
+    // The watchers that receive the events of the directory, with the path
+    // of the directory relative to their roots.
+    std::vector<std::pair<int32_t, std::string>> watchers;
+  };
+
+  struct Watcher {
+    std::string root;
+    enum encoding encoding;
+  };
+
+  struct Event {
+    int32_t watcher;
+    bool rename;
+    // Empty when the events of the watcher were dropped by the kernel.
+    std::string filename;
+  };
+
+  InotifyWrap(Environment* env, Local<Object> object);
+  ~InotifyWrap() override = default;
+
+  int AddTree(int32_t watcher,
+              const std::string& path,
+              const std::string& relative,
+              bool root);
+  void RemoveTree(const std::string& path);
+  void RemoveWatcher(int32_t watcher);
+  void OnInotifyEvent(const struct inotify_event* event);
+  void AddEvent(int32_t watcher, bool rename, std::string&& filename);
+  void Flush();
+  void OnError(int status);
+  void OnClose() override;
+
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+  static void OnTimeout(uv_timer_t* timer);
+
+  static constexpr uint32_t kInotifyMask =
+      IN_ATTRIB | IN_CREATE | IN_MODIFY | IN_DELETE | IN_DELETE_SELF |
+      IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO;
+
+  uv_poll_t handle_;
+  uv_timer_t* timer_ = nullptr;
+  int fd_ = -1;
+  uint64_t debounce_ = 0;
+  std::unordered_map<int, Directory> directories_;
+  std::unordered_map<int32_t, Watcher> watchers_;
+  std::vector<Event> events_;
+  std::unordered_set<std::string> event_keys_;
+};
+
+constexpr uint32_t InotifyWrap::kInotifyMask;
+
+inline std::string JoinRelative(const std::string& relative,
+                                const char* name) {
+  return relative.empty() ? name : relative + '/' + name;
+}
+
+inline std::string Basename(std::string path) {
+  while (path.size() > 1 && path.back() == '/')
+    path.pop_back();
+  size_t slash = path.rfind('/');
+  return slash == std::string::npos || path.size() == 1 ?
+      path : path.substr(slash + 1);
+}
+
+InotifyWrap::InotifyWrap(Environment* env, Local<Object> object)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&handle_),
+                 AsyncWrap::PROVIDER_FSEVENTWRAP) {
+  MarkAsUninitialized();
+}
+
+void InotifyWrap::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new InotifyWrap(env, args.This());
+}
+
+// inotify.start(debounce)
+void InotifyWrap::Start(const FunctionCallbackInfo<Value>& args) {
+  InotifyWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(wrap->IsHandleClosing());  // Check that Start() has not been called.
+  Environment* env = wrap->env();
+
+  CHECK(args[0]->IsUint32());
+  wrap->debounce_ = args[0].As<Uint32>()->Value();
+
+  wrap->fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (wrap->fd_ == -1)
+    return args.GetReturnValue().Set(-errno);
+
+  int err = uv_poll_init(env->event_loop(), &wrap->handle_, wrap->fd_);
+  if (err != 0) {
+    close(wrap->fd_);
+    wrap->fd_ = -1;
+    return args.GetReturnValue().Set(err);
+  }
+  wrap->MarkAsInitialized();
+
+  wrap->timer_ = new uv_timer_t();
+  CHECK_EQ(uv_timer_init(env->event_loop(), wrap->timer_), 0);
+  wrap->timer_->data = wrap;
+  uv_unref(reinterpret_cast<uv_handle_t*>(wrap->timer_));
+
+  err = uv_poll_start(&wrap->handle_, UV_READABLE, OnPoll);
+  if (err != 0)
+    wrap->Close(Local<Value>());
+  args.GetReturnValue().Set(err);
+}
+
+// inotify.watch(id, path, encoding)
+void InotifyWrap::Watch(const FunctionCallbackInfo<Value>& args) {
+  InotifyWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(!wrap->IsHandleClosing());
+  Environment* env = wrap->env();
+
+  CHECK(args[0]->IsInt32());
+  const int32_t id = args[0].As<Int32>()->Value();
+  BufferValue path(env->isolate(), args[1]);
+  CHECK_NOT_NULL(*path);
+  std::string root(*path, path.length());
+
+  wrap->watchers_[id] =
+      Watcher { root, ParseEncoding(env->isolate(), args[2], UTF8) };
+  int err = wrap->AddTree(id, root, std::string(), true);
+  if (err != 0)
+    wrap->RemoveWatcher(id);
+  args.GetReturnValue().Set(err);
+}
+
+// inotify.unwatch(id)
+void InotifyWrap::Unwatch(const FunctionCallbackInfo<Value>& args) {
+  InotifyWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsInt32());
+  wrap->RemoveWatcher(args[0].As<Int32>()->Value());
+}
+
+void InotifyWrap::Close(Local<Value> close_callback) {
+  if (timer_ != nullptr) {
+    env()->CloseHandle(timer_, [](uv_timer_t* timer) { delete timer; });
+    timer_ = nullptr;
+  }
+  HandleWrap::Close(close_callback);
+}
+
+void InotifyWrap::OnClose() {
+  // The descriptor is only closed once libuv has stopped polling it.
+  if (fd_ != -1) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+// Watches path and, unless it is the root of the watcher, the directories
+// below it. Only running out of watch descriptors is an error: the entries
+// that disappear or cannot be read while the tree is walked are skipped.
+int InotifyWrap::AddTree(int32_t watcher,
+                         const std::string& path,
+                         const std::string& relative,
+                         bool root) {
+  const uint32_t mask =
+      kInotifyMask | (root ? 0 : IN_DONT_FOLLOW | IN_ONLYDIR);
+  int wd = inotify_add_watch(fd_, path.c_str(), mask);
+  if (wd == -1)
+    return root || errno == ENOSPC ? -errno : 0;
+
+  Directory& directory = directories_[wd];
+  if (directory.path.empty())
+    directory.path = path;
+  for (const auto& entry : directory.watchers) {
+    if (entry.first == watcher)
+      return 0;
+  }
+  directory.watchers.emplace_back(watcher, relative);
+
+  uv_fs_t req;
+  int err = uv_fs_scandir(env()->event_loop(), &req, path.c_str(), 0, nullptr);
+  if (err < 0) {
+    // The root of the watcher can be a file.
+    uv_fs_req_cleanup(&req);
+    return 0;
+  }
+  uv_dirent_t ent;
+  err = 0;
+  while (err == 0 && uv_fs_scandir_next(&req, &ent) != UV_EOF) {
+    std::string child = path + '/' + ent.name;
+    if (ent.type == UV_DIRENT_UNKNOWN) {
+      uv_fs_t stat_req;
+      if (uv_fs_lstat(env()->event_loop(), &stat_req, child.c_str(),
+                      nullptr) == 0 &&
+          S_ISDIR(stat_req.statbuf.st_mode)) {
+        ent.type = UV_DIRENT_DIR;
+      }
+      uv_fs_req_cleanup(&stat_req);
+    }
+    if (ent.type == UV_DIRENT_DIR)
+      err = AddTree(watcher, child, JoinRelative(relative, ent.name), false);
+  }
+  uv_fs_req_cleanup(&req);
+  return err;
+}
+
+// Stops watching the directory at path and the directories below it.
+void InotifyWrap::RemoveTree(const std::string& path) {
+  for (auto it = directories_.begin(); it != directories_.end();) {
+    const std::string& dir = it->second.path;
+    if (dir.compare(0, path.size(), path) == 0 &&
+        (dir.size() == path.size() || dir[path.size()] == '/')) {
+      inotify_rm_watch(fd_, it->first);
+      it = directories_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void InotifyWrap::RemoveWatcher(int32_t watcher) {
+  for (auto it = directories_.begin(); it != directories_.end();) {
+    auto& watchers = it->second.watchers;
+    watchers.erase(std::remove_if(watchers.begin(), watchers.end(),
+                                  [&](const auto& entry) {
+                                    return entry.first == watcher;
+                                  }),
+                   watchers.end());
+    if (watchers.empty()) {
+      inotify_rm_watch(fd_, it->first);
+      it = directories_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  watchers_.erase(watcher);
+}
+
+void InotifyWrap::OnInotifyEvent(const struct inotify_event* event) {
+  if (event->mask & IN_Q_OVERFLOW) {
+    // Events were dropped, so anything may have changed in any of the trees.
+    for (const auto& entry : watchers_)
+      AddEvent(entry.first, true, std::string());
+    return;
+  }
+
+  auto it = directories_.find(event->wd);
+  if (it == directories_.end())
+    return;
+  if (event->mask & IN_IGNORED) {
+    directories_.erase(it);
+    return;
+  }
+
+  // Like libuv, only report attribute and content changes as 'change'.
+  const bool rename =
+      (event->mask & ~(IN_ATTRIB | IN_MODIFY | IN_ISDIR)) != 0;
+  for (const auto& entry : it->second.watchers) {
+    if (event->len > 0) {
+      AddEvent(entry.first, rename, JoinRelative(entry.second, event->name));
+    } else if (entry.second.empty()) {
+      // Events of the root itself. The other directories are reported
+      // through their parents.
+      AddEvent(entry.first, rename, Basename(watchers_[entry.first].root));
+    }
+  }
+
+  if (event->len == 0 || !(event->mask & IN_ISDIR))
+    return;
+  std::string path = it->second.path + '/' + event->name;
+  if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+    RemoveTree(path);
+  if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+    // AddTree() can rehash directories_, so do not keep references into it.
+    auto watchers = it->second.watchers;
+    for (const auto& entry : watchers) {
+      AddTree(entry.first, path, JoinRelative(entry.second, event->name),
+              false);
+    }
+  }
+}
+
+void InotifyWrap::AddEvent(int32_t watcher,
+                           bool rename,
+                           std::string&& filename) {
+  std::string key = std::to_string(watcher) + (rename ? 'r' : 'c') + filename;
+  if (event_keys_.insert(std::move(key)).second)
+    events_.push_back(Event { watcher, rename, std::move(filename) });
+}
+
+void InotifyWrap::OnPoll(uv_poll_t* handle, int status, int events) {
+  InotifyWrap* wrap = static_cast<InotifyWrap*>(handle->data);
+  if (status < 0)
+    return wrap->OnError(status);
+
+  alignas(struct inotify_event) char buf[4096];
+  for (;;) {
+    ssize_t size;
+    do {
+      size = read(wrap->fd_, buf, sizeof(buf));
+    } while (size == -1 && errno == EINTR);
+    if (size == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+      return wrap->OnError(-errno);
+    }
+    for (char* p = buf; p < buf + size;) {
+      const struct inotify_event* event =
+          reinterpret_cast<const struct inotify_event*>(p);
+      wrap->OnInotifyEvent(event);
+      p += sizeof(*event) + event->len;
+    }
+  }
+
+  if (wrap->events_.empty())
+    return;
+  if (wrap->debounce_ == 0)
+    return wrap->Flush();
+  if (!uv_is_active(reinterpret_cast<uv_handle_t*>(wrap->timer_)))
+    uv_timer_start(wrap->timer_, OnTimeout, wrap->debounce_, 0);
+}
+
+void InotifyWrap::OnTimeout(uv_timer_t* timer) {
+  static_cast<InotifyWrap*>(timer->data)->Flush();
+}
+
+// Calls onchange(0, [id, eventType, filename, ...]) with the events that were
+// read since the last call.
+void InotifyWrap::Flush() {
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  std::vector<Local<Value>> values;
+  values.reserve(events_.size() * 3);
+  for (const Event& event : events_) {
+    auto it = watchers_.find(event.watcher);
+    if (it == watchers_.end())
+      continue;
+    Local<Value> filename = Null(env->isolate());
+    if (!event.filename.empty()) {
+      Local<Value> error;
+      MaybeLocal<Value> fn = StringBytes::Encode(env->isolate(),
+                                                 event.filename.data(),
+                                                 event.filename.size(),
+                                                 it->second.encoding,
+                                                 &error);
+      if (!fn.ToLocal(&filename)) {
+        filename = StringBytes::Encode(env->isolate(),
+                                       event.filename.data(),
+                                       event.filename.size(),
+                                       BUFFER,
+                                       &error).ToLocalChecked();
+      }
+    }
+    values.push_back(Integer::New(env->isolate(), event.watcher));
+    values.push_back(event.rename ? env->rename_string() :
+                                    env->change_string());
+    values.push_back(filename);
+  }
+  events_.clear();
+  event_keys_.clear();
+  if (values.empty())
+    return;
+
+  Local<Value> argv[] = {
+    Integer::New(env->isolate(), 0),
+    Array::New(env->isolate(), values.data(), values.size())
+  };
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+
+void InotifyWrap::OnError(int status) {
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<Value> argv[] = { Integer::New(env->isolate(), status) };
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+#endif  // __linux__
+
+
 FSEventWrap::FSEventWrap(Environment* env, Local<Object> object)
     : HandleWrap(env,
                  object,
@@ -115,6 +534,17 @@ void FSEventWrap::Initialize(Local<Object> target,
       static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum));
 
   env->SetConstructorFunction(target, "FSEvent", t);
+
+#ifdef __linux__
+  Local<FunctionTemplate> inotify = env->NewFunctionTemplate(InotifyWrap::New);
+  inotify->InstanceTemplate()->SetInternalFieldCount(
+      InotifyWrap::kInternalFieldCount);
+  inotify->Inherit(HandleWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(inotify, "start", InotifyWrap::Start);
+  env->SetProtoMethod(inotify, "watch", InotifyWrap::Watch);
+  env->SetProtoMethod(inotify, "unwatch", InotifyWrap::Unwatch);
+  env->SetConstructorFunction(target, "Inotify", inotify);
+#endif  // __linux__
 }
 
 
@@ -4,6 +4,10 @@
 #include "node_external_reference.h"
 #include "stream_base-inl.h"
 #include "util-inl.h"
+#include "zlib.h"
+
+#include <deque>
+#include <string>
 
 using v8::Array;
 using v8::Boolean;
@@ -203,10 +207,49 @@ void BuildEmbedderGraph(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(ret);
 }
 
+// getNativeMemoryUsage(...handles)
+// Adds up the native memory of the objects behind `handles` and of everything
+// they track, without taking a heap snapshot. Memory that is shared between
+// the handles is only counted once.
+void GetNativeMemoryUsage(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  MemoryTracker tracker(env->isolate());
+  for (int i = 0; i < args.Length(); i++) {
+    if (!args[i]->IsObject() ||
+        !env->base_object_ctor_template()->HasInstance(args[i])) {
+      continue;
+    }
+    BaseObject* obj = Unwrap<BaseObject>(args[i].As<Object>());
+    if (obj != nullptr)
+      tracker.Track(obj);
+  }
+  args.GetReturnValue().Set(static_cast<double>(tracker.TotalSize()));
+}
+
 namespace {
+// Writes a heap snapshot to a file on a helper thread, optionally compressed
+// with gzip, so that V8 can serialize the next chunks of the snapshot while
+// the previous ones are compressed and written. At most kMaxPendingChunks are
+// queued, which bounds the memory that is used on top of the snapshot itself.
 class FileOutputStream : public v8::OutputStream {
  public:
-  explicit FileOutputStream(FILE* stream) : stream_(stream) {}
+  FileOutputStream(FILE* stream, bool gzip) : stream_(stream), gzip_(gzip) {
+    if (gzip_) {
+      memset(&zstream_, 0, sizeof(zstream_));
+      // 16 + MAX_WBITS selects the gzip format.
+      CHECK_EQ(deflateInit2(&zstream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                            16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    }
+    CHECK_EQ(uv_thread_create(&thread_, [](void* arg) {
+      static_cast<FileOutputStream*>(arg)->Run();
+    }, this), 0);
+  }
+
+  ~FileOutputStream() override {
+    Finish();
+    if (gzip_)
+      deflateEnd(&zstream_);
+  }
 
   int GetChunkSize() override {
     return 65536;  // big chunks == faster
@@ -215,17 +258,101 @@ class FileOutputStream : public v8::OutputStream {
   void EndOfStream() override {}
 
   WriteResult WriteAsciiChunk(char* data, int size) override {
-    const size_t len = static_cast<size_t>(size);
+    Mutex::ScopedLock lock(mutex_);
+    while (chunks_.size() >= kMaxPendingChunks && !failed_)
+      cond_.Wait(lock);
+    if (failed_)
+      return kAbort;
+    chunks_.emplace_back(data, size);
+    cond_.Broadcast(lock);
+    return kContinue;
+  }
+
+  // Waits until all of the chunks have been written, and returns whether
+  // they were written successfully.
+  bool Finish() {
+    {
+      Mutex::ScopedLock lock(mutex_);
+      if (!ended_) {
+        ended_ = true;
+        cond_.Broadcast(lock);
+      }
+    }
+    if (!joined_) {
+      CHECK_EQ(uv_thread_join(&thread_), 0);
+      joined_ = true;
+    }
+    return !failed_;
+  }
+
+ private:
+  static constexpr size_t kMaxPendingChunks = 64;
+
+  void Run() {
+    bool ok = true;
+    for (;;) {
+      std::string chunk;
+      {
+        Mutex::ScopedLock lock(mutex_);
+        while (chunks_.empty() && !ended_)
+          cond_.Wait(lock);
+        if (chunks_.empty())
+          break;
+        chunk = std::move(chunks_.front());
+        chunks_.pop_front();
+        cond_.Broadcast(lock);
+      }
+      ok = ok && Write(chunk.data(), chunk.size(), false);
+      if (!ok) {
+        Mutex::ScopedLock lock(mutex_);
+        failed_ = true;
+        chunks_.clear();
+        cond_.Broadcast(lock);
+      }
+    }
+    if (ok && gzip_ && !Write(nullptr, 0, true)) {
+      Mutex::ScopedLock lock(mutex_);
+      failed_ = true;
+    }
+  }
+
+  bool Write(const char* data, size_t size, bool end) {
+    if (!gzip_)
+      return WriteAll(data, size);
+    char out[65536];
+    zstream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    zstream_.avail_in = size;
+    int err;
+    do {
+      zstream_.next_out = reinterpret_cast<Bytef*>(out);
+      zstream_.avail_out = sizeof(out);
+      err = deflate(&zstream_, end ? Z_FINISH : Z_NO_FLUSH);
+      CHECK_NE(err, Z_STREAM_ERROR);
+      if (!WriteAll(out, sizeof(out) - zstream_.avail_out))
+        return false;
+    } while (zstream_.avail_out == 0 || (end && err != Z_STREAM_END));
+    return true;
+  }
+
+  bool WriteAll(const char* data, size_t len) {
     size_t off = 0;
 
     while (off < len && !feof(stream_) && !ferror(stream_))
       off += fwrite(data + off, 1, len - off, stream_);
 
-    return off == len ? kContinue : kAbort;
+    return off == len;
   }
 
- private:
   FILE* stream_;
+  bool gzip_;
+  z_stream zstream_;
+  uv_thread_t thread_;
+  bool joined_ = false;
+  Mutex mutex_;
+  ConditionVariable cond_;
+  std::deque<std::string> chunks_;
+  bool ended_ = false;
+  bool failed_ = false;
 };
 
 class HeapSnapshotStream : public AsyncWrap,
@@ -316,14 +443,17 @@ inline void TakeSnapshot(Isolate* isolate, v8::OutputStream* out) {
 
 }  // namespace
 
-bool WriteSnapshot(Isolate* isolate, const char* filename) {
-  FILE* fp = fopen(filename, "w");
+bool WriteSnapshot(Isolate* isolate, const char* filename, bool gzip) {
+  FILE* fp = fopen(filename, gzip ? "wb" : "w");
   if (fp == nullptr)
     return false;
-  FileOutputStream stream(fp);
-  TakeSnapshot(isolate, &stream);
-  fclose(fp);
-  return true;
+  bool ok;
+  {
+    FileOutputStream stream(fp, gzip);
+    TakeSnapshot(isolate, &stream);
+    ok = stream.Finish();
+  }
+  return fclose(fp) == 0 && ok;
 }
 
 void DeleteHeapSnapshot(const HeapSnapshot* snapshot) {
@@ -371,10 +501,12 @@ void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
 
   Local<Value> filename_v = args[0];
+  bool gzip = args[1]->IsTrue();
 
   if (filename_v->IsUndefined()) {
-    DiagnosticFilename name(env, "Heap", "heapsnapshot");
-    if (!WriteSnapshot(isolate, *name))
+    DiagnosticFilename name(env, "Heap",
+                            gzip ? "heapsnapshot.gz" : "heapsnapshot");
+    if (!WriteSnapshot(isolate, *name, gzip))
       return;
     if (String::NewFromUtf8(isolate, *name).ToLocal(&filename_v)) {
       args.GetReturnValue().Set(filename_v);
@@ -384,11 +516,144 @@ void TriggerHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
 
   BufferValue path(isolate, filename_v);
   CHECK_NOT_NULL(*path);
-  if (!WriteSnapshot(isolate, *path))
+  if (!WriteSnapshot(isolate, *path, gzip))
     return;
   return args.GetReturnValue().Set(filename_v);
 }
 
+namespace {
+// Converts a node of the sampled allocation profile to the format of the
+// .heapprofile files that --heap-prof writes.
+MaybeLocal<Object> CreateHeapProfileNode(Environment* env,
+                                         v8::AllocationProfile::Node* node) {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  EscapableHandleScope scope(isolate);
+
+  Local<Object> call_frame = Object::New(isolate);
+  Local<String> script_id;
+  if (!String::NewFromUtf8(isolate, std::to_string(node->script_id).c_str())
+           .ToLocal(&script_id) ||
+      call_frame->Set(context, FIXED_ONE_BYTE_STRING(isolate, "functionName"),
+                      node->name).IsNothing() ||
+      call_frame->Set(context, FIXED_ONE_BYTE_STRING(isolate, "scriptId"),
+                      script_id).IsNothing() ||
+      call_frame->Set(context, FIXED_ONE_BYTE_STRING(isolate, "url"),
+                      node->script_name).IsNothing() ||
+      // The lines and columns are 0-based in the file format.
+      call_frame->Set(context, FIXED_ONE_BYTE_STRING(isolate, "lineNumber"),
+                      Number::New(isolate, node->line_number - 1))
+          .IsNothing() ||
+      call_frame->Set(context, FIXED_ONE_BYTE_STRING(isolate, "columnNumber"),
+                      Number::New(isolate, node->column_number - 1))
+          .IsNothing()) {
+    return MaybeLocal<Object>();
+  }
+
+  double self_size = 0;
+  for (const v8::AllocationProfile::Allocation& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  std::vector<Local<Value>> children;
+  children.reserve(node->children.size());
+  for (v8::AllocationProfile::Node* child : node->children) {
+    Local<Object> child_obj;
+    if (!CreateHeapProfileNode(env, child).ToLocal(&child_obj))
+      return MaybeLocal<Object>();
+    children.push_back(child_obj);
+  }
+
+  Local<Object> obj = Object::New(isolate);
+  if (obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "callFrame"),
+               call_frame).IsNothing() ||
+      obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "selfSize"),
+               Number::New(isolate, self_size)).IsNothing() ||
+      obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "id"),
+               Number::New(isolate, node->node_id)).IsNothing() ||
+      obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "children"),
+               Array::New(isolate, children.data(), children.size()))
+          .IsNothing()) {
+    return MaybeLocal<Object>();
+  }
+  return scope.Escape(obj);
+}
+}  // namespace
+
+// Returns the allocations sampled by the sampling heap profiler of V8, which
+// is started with the given sampling interval if it is not running yet.
+void GetHeapProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  v8::HeapProfiler* heap_profiler = isolate->GetHeapProfiler();
+
+  std::unique_ptr<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  if (!profile) {
+    CHECK(args[0]->IsNumber());
+    uint64_t interval = static_cast<uint64_t>(args[0].As<Number>()->Value());
+    heap_profiler->StartSamplingHeapProfiler(interval);
+    profile.reset(heap_profiler->GetAllocationProfile());
+    CHECK(profile);
+  }
+
+  Local<Object> head;
+  if (!CreateHeapProfileNode(env, profile->GetRootNode()).ToLocal(&head))
+    return;
+
+  const std::vector<v8::AllocationProfile::Sample>& samples =
+      profile->GetSamples();
+  Local<Array> samples_arr = Array::New(isolate, samples.size());
+  for (size_t i = 0; i < samples.size(); i++) {
+    const v8::AllocationProfile::Sample& sample = samples[i];
+    Local<Object> sample_obj = Object::New(isolate);
+    if (sample_obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "size"),
+                        Number::New(isolate, static_cast<double>(sample.size) *
+                                                 sample.count))
+            .IsNothing() ||
+        sample_obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "nodeId"),
+                        Number::New(isolate, sample.node_id)).IsNothing() ||
+        sample_obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "ordinal"),
+                        Number::New(isolate,
+                                    static_cast<double>(sample.sample_id)))
+            .IsNothing() ||
+        samples_arr->Set(context, i, sample_obj).IsNothing()) {
+      return;
+    }
+  }
+
+  Local<Object> result = Object::New(isolate);
+  if (result->Set(context, FIXED_ONE_BYTE_STRING(isolate, "head"), head)
+          .IsNothing() ||
+      result->Set(context, FIXED_ONE_BYTE_STRING(isolate, "samples"),
+                  samples_arr).IsNothing()) {
+    return;
+  }
+  args.GetReturnValue().Set(result);
+}
+
+// Starts the sampling heap profiler for a profile session. Returns false if
+// it is already running, in which case the session must not stop it.
+void StartHeapProfile(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsNumber());
+  uint64_t interval = static_cast<uint64_t>(args[0].As<Number>()->Value());
+  args.GetReturnValue().Set(
+      args.GetIsolate()->GetHeapProfiler()->StartSamplingHeapProfiler(
+          interval));
+}
+
+void StopHeapProfile(const FunctionCallbackInfo<Value>& args) {
+  args.GetIsolate()->GetHeapProfiler()->StopSamplingHeapProfiler();
+}
+
+void GetHeapProfileFilename(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  DiagnosticFilename name(env, "Heap", "heapprofile");
+  Local<String> filename;
+  if (String::NewFromUtf8(env->isolate(), *name).ToLocal(&filename))
+    args.GetReturnValue().Set(filename);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -398,12 +663,22 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "buildEmbedderGraph", BuildEmbedderGraph);
   env->SetMethod(target, "triggerHeapSnapshot", TriggerHeapSnapshot);
   env->SetMethod(target, "createHeapSnapshotStream", CreateHeapSnapshotStream);
+  env->SetMethod(target, "getHeapProfile", GetHeapProfile);
+  env->SetMethod(target, "startHeapProfile", StartHeapProfile);
+  env->SetMethod(target, "stopHeapProfile", StopHeapProfile);
+  env->SetMethod(target, "getHeapProfileFilename", GetHeapProfileFilename);
+  env->SetMethod(target, "getNativeMemoryUsage", GetNativeMemoryUsage);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(BuildEmbedderGraph);
   registry->Register(TriggerHeapSnapshot);
   registry->Register(CreateHeapSnapshotStream);
+  registry->Register(GetHeapProfile);
+  registry->Register(StartHeapProfile);
+  registry->Register(StopHeapProfile);
+  registry->Register(GetHeapProfileFilename);
+  registry->Register(GetNativeMemoryUsage);
 }
 
 }  // namespace heap
@@ -2,7 +2,13 @@
 #include "histogram-inl.h"
 #include "base_object-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_buffer.h"
 #include "node_errors.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cstring>
+
 namespace node {
 
 using v8::BigInt;
@@ -15,12 +21,238 @@ using v8::Object;
 using v8::String;
 using v8::Value;
 
+namespace {
+
+// The cookies of the V2 format of HdrHistogram. The bits 4 to 7 are used by
+// the older formats for the word size, and are ignored when the cookies are
+// read back. HdrHistogram sets them to 0x10, which makes the base64 of a log
+// entry start with "HISTF".
+constexpr uint32_t kEncodingCookie = 0x1c849313;
+constexpr uint32_t kCompressedEncodingCookie = 0x1c849314;
+constexpr uint32_t kCookieMask = ~0xf0U;
+
+// The encoding starts with the cookie, the size of the payload, the
+// normalizing index offset and the significant figures (32 bits each), the
+// lowest and the highest trackable values and the integer to double
+// conversion ratio (64 bits each), all of them in network byte order. The
+// payload then holds the counts, with runs of zeros replaced by the negated
+// length of the run, as ZigZag LEB128 integers of up to 9 bytes.
+constexpr size_t kEncodingHeaderSize = 40;
+// The compressed encoding is the cookie and the size of the zlib stream of
+// the encoding that follows it.
+constexpr size_t kCompressedHeaderSize = 8;
+constexpr size_t kMaxZigZagSize = 9;
+
+void WriteUint32(uint8_t* dest, uint32_t value) {
+  for (int i = 3; i >= 0; i--, value >>= 8)
+    dest[i] = static_cast<uint8_t>(value);
+}
+
+void WriteUint64(uint8_t* dest, uint64_t value) {
+  for (int i = 7; i >= 0; i--, value >>= 8)
+    dest[i] = static_cast<uint8_t>(value);
+}
+
+uint32_t ReadUint32(const uint8_t* src) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++)
+    value = (value << 8) | src[i];
+  return value;
+}
+
+uint64_t ReadUint64(const uint8_t* src) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++)
+    value = (value << 8) | src[i];
+  return value;
+}
+
+void WriteZigZag(std::vector<uint8_t>* dest, int64_t signed_value) {
+  uint64_t value = (static_cast<uint64_t>(signed_value) << 1) ^
+                   static_cast<uint64_t>(signed_value >> 63);
+  for (size_t i = 1; i < kMaxZigZagSize; i++) {
+    if (value < 0x80) {
+      dest->push_back(static_cast<uint8_t>(value));
+      return;
+    }
+    dest->push_back(static_cast<uint8_t>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  // The last byte holds the remaining 8 bits.
+  dest->push_back(static_cast<uint8_t>(value));
+}
+
+bool ReadZigZag(const uint8_t** src, const uint8_t* end, int64_t* result) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < kMaxZigZagSize; i++) {
+    if (*src == end)
+      return false;
+    uint8_t byte = *(*src)++;
+    if (i == kMaxZigZagSize - 1) {
+      value |= static_cast<uint64_t>(byte) << 56;
+      break;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if ((byte & 0x80) == 0)
+      break;
+  }
+  *result = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  return true;
+}
+
+}  // anonymous namespace
+
 Histogram::Histogram(int64_t lowest, int64_t highest, int figures) {
   hdr_histogram* histogram;
   CHECK_EQ(0, hdr_init(lowest, highest, figures, &histogram));
   histogram_.reset(histogram);
 }
 
+int64_t Histogram::Add(const Histogram& other) {
+  if (&other == this) {
+    // hdr_add() would iterate over the counts that it is modifying.
+    hdr_histogram* h = histogram_.get();
+    Histogram copy(h->lowest_trackable_value,
+                   h->highest_trackable_value,
+                   h->significant_figures);
+    copy.Add(*this);
+    return Add(copy);
+  }
+
+  // The locks are always taken in the same order, so that two threads that
+  // add two histograms to each other cannot deadlock.
+  bool other_first = std::less<const Histogram*>()(&other, this);
+  Mutex::ScopedLock first_lock(other_first ? other.mutex_ : mutex_);
+  Mutex::ScopedLock second_lock(other_first ? mutex_ : other.mutex_);
+  int64_t dropped = hdr_add(histogram_.get(), other.histogram_.get());
+  exceeds_ += other.exceeds_ + dropped;
+  return dropped;
+}
+
+std::vector<uint8_t> Histogram::Encode() {
+  std::vector<uint8_t> encoded(kEncodingHeaderSize);
+  {
+    Mutex::ScopedLock lock(mutex_);
+    hdr_histogram* h = histogram_.get();
+    int32_t limit = h->counts_len;
+    while (limit > 0 && hdr_count_at_index(h, limit - 1) == 0)
+      limit--;
+    for (int32_t index = 0; index < limit;) {
+      int64_t count = hdr_count_at_index(h, index++);
+      int64_t zeros = 0;
+      if (count == 0) {
+        zeros = 1;
+        while (index < limit && hdr_count_at_index(h, index) == 0) {
+          zeros++;
+          index++;
+        }
+      }
+      WriteZigZag(&encoded, zeros > 1 ? -zeros : count);
+    }
+
+    uint64_t ratio_bits;
+    static_assert(sizeof(ratio_bits) == sizeof(h->conversion_ratio),
+                  "double must be 64 bits");
+    memcpy(&ratio_bits, &h->conversion_ratio, sizeof(ratio_bits));
+    uint8_t* header = encoded.data();
+    WriteUint32(header, kEncodingCookie);
+    WriteUint32(header + 4, encoded.size() - kEncodingHeaderSize);
+    WriteUint32(header + 8, h->normalizing_index_offset);
+    WriteUint32(header + 12, h->significant_figures);
+    WriteUint64(header + 16, h->lowest_trackable_value);
+    WriteUint64(header + 24, h->highest_trackable_value);
+    WriteUint64(header + 32, ratio_bits);
+  }
+
+  uLongf compressed_size = compressBound(encoded.size());
+  std::vector<uint8_t> compressed(kCompressedHeaderSize + compressed_size);
+  CHECK_EQ(Z_OK, compress(compressed.data() + kCompressedHeaderSize,
+                          &compressed_size,
+                          encoded.data(),
+                          encoded.size()));
+  compressed.resize(kCompressedHeaderSize + compressed_size);
+  WriteUint32(compressed.data(), kCompressedEncodingCookie);
+  WriteUint32(compressed.data() + 4, compressed_size);
+  return compressed;
+}
+
+std::shared_ptr<Histogram> Histogram::Decode(const uint8_t* data,
+                                             size_t size) {
+  if (size < kCompressedHeaderSize ||
+      (ReadUint32(data) & kCookieMask) !=
+          (kCompressedEncodingCookie & kCookieMask) ||
+      ReadUint32(data + 4) > size - kCompressedHeaderSize) {
+    return nullptr;
+  }
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (inflateInit(&stream) != Z_OK)
+    return nullptr;
+  auto cleanup = OnScopeLeave([&]() { inflateEnd(&stream); });
+  stream.next_in = const_cast<Bytef*>(data + kCompressedHeaderSize);
+  stream.avail_in = ReadUint32(data + 4);
+
+  // Inflates exactly `length` bytes of the encoding.
+  auto inflate_into = [&](uint8_t* dest, size_t length) {
+    stream.next_out = dest;
+    stream.avail_out = length;
+    while (stream.avail_out > 0) {
+      int err = inflate(&stream, Z_NO_FLUSH);
+      if (err == Z_STREAM_END)
+        break;
+      if (err != Z_OK)
+        return false;
+    }
+    return stream.avail_out == 0;
+  };
+
+  uint8_t header[kEncodingHeaderSize];
+  if (!inflate_into(header, sizeof(header)) ||
+      (ReadUint32(header) & kCookieMask) != (kEncodingCookie & kCookieMask)) {
+    return nullptr;
+  }
+  // The payload holds the counts in the order of their logical indices, so
+  // the normalizing index offset and the conversion ratio do not matter here.
+  uint32_t payload_size = ReadUint32(header + 4);
+  int32_t figures = static_cast<int32_t>(ReadUint32(header + 12));
+  int64_t lowest = static_cast<int64_t>(ReadUint64(header + 16));
+  int64_t highest = static_cast<int64_t>(ReadUint64(header + 24));
+  if (lowest < 1 || highest / 2 < lowest || figures < 1 || figures > 5)
+    return nullptr;
+
+  auto histogram = std::make_shared<Histogram>(lowest, highest, figures);
+  hdr_histogram* h = histogram->histogram_.get();
+  if (payload_size > static_cast<size_t>(h->counts_len) * kMaxZigZagSize)
+    return nullptr;
+  std::vector<uint8_t> payload(payload_size);
+  if (!inflate_into(payload.data(), payload.size()))
+    return nullptr;
+
+  const uint8_t* src = payload.data();
+  const uint8_t* end = src + payload.size();
+  int32_t index = 0;
+  while (src < end) {
+    int64_t count;
+    if (!ReadZigZag(&src, end, &count))
+      return nullptr;
+    if (count < 0) {
+      if (count < static_cast<int64_t>(index) - h->counts_len)
+        return nullptr;
+      index += static_cast<int32_t>(-count);
+      continue;
+    }
+    if (index >= h->counts_len)
+      return nullptr;
+    if (count > 0 &&
+        !hdr_record_values(h, hdr_value_at_index(h, index), count)) {
+      return nullptr;
+    }
+    index++;
+  }
+  return histogram;
+}
+
 void Histogram::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("histogram", GetMemorySize());
 }
@@ -31,6 +263,13 @@ HistogramImpl::HistogramImpl(int64_t lowest, int64_t highest, int figures)
 HistogramImpl::HistogramImpl(std::shared_ptr<Histogram> histogram)
     : histogram_(std::move(histogram)) {}
 
+HistogramImpl* HistogramImpl::FromJSObject(Local<Value> value) {
+  Local<Object> obj = value.As<Object>();
+  DCHECK_GE(obj->InternalFieldCount(), HistogramImpl::kInternalFieldCount);
+  return static_cast<HistogramImpl*>(
+      obj->GetAlignedPointerFromInternalField(HistogramImpl::kImplField));
+}
+
 HistogramBase::HistogramBase(
     Environment* env,
     Local<Object> wrap,
@@ -40,6 +279,8 @@ HistogramBase::HistogramBase(
     : BaseObject(env, wrap),
       HistogramImpl(lowest, highest, figures) {
   MakeWeak();
+  wrap->SetAlignedPointerInInternalField(
+      HistogramImpl::kImplField, static_cast<HistogramImpl*>(this));
 }
 
 HistogramBase::HistogramBase(
@@ -49,6 +290,8 @@ HistogramBase::HistogramBase(
     : BaseObject(env, wrap),
       HistogramImpl(std::move(histogram)) {
   MakeWeak();
+  wrap->SetAlignedPointerInInternalField(
+      HistogramImpl::kImplField, static_cast<HistogramImpl*>(this));
 }
 
 void HistogramBase::MemoryInfo(MemoryTracker* tracker) const {
@@ -136,6 +379,41 @@ void HistogramBase::Record(const FunctionCallbackInfo<Value>& args) {
   (*histogram)->Record(value);
 }
 
+void HistogramBase::Add(const FunctionCallbackInfo<Value>& args) {
+  HistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsObject());
+  HistogramImpl* other = HistogramImpl::FromJSObject(args[0]);
+  (*histogram)->Add(*other->histogram());
+}
+
+void HistogramBase::DoEncode(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  HistogramBase* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  std::vector<uint8_t> encoded = (*histogram)->Encode();
+  Local<Object> buffer;
+  if (Buffer::Copy(env,
+                   reinterpret_cast<const char*>(encoded.data()),
+                   encoded.size()).ToLocal(&buffer)) {
+    args.GetReturnValue().Set(buffer);
+  }
+}
+
+// Returns undefined if the data is not an encoded histogram.
+void HistogramBase::DoDecode(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsArrayBufferView());
+  ArrayBufferViewContents<uint8_t> data(args[0]);
+  std::shared_ptr<Histogram> decoded =
+      Histogram::Decode(data.data(), data.length());
+  if (!decoded)
+    return;
+  BaseObjectPtr<HistogramBase> histogram = Create(env, std::move(decoded));
+  if (histogram)
+    args.GetReturnValue().Set(histogram->object());
+}
+
 BaseObjectPtr<HistogramBase> HistogramBase::Create(
     Environment* env,
     int64_t lowest,
@@ -181,7 +459,7 @@ Local<FunctionTemplate> HistogramBase::GetConstructorTemplate(
     tmpl->Inherit(BaseObject::GetConstructorTemplate(env));
 
     tmpl->InstanceTemplate()->SetInternalFieldCount(
-        HistogramBase::kInternalFieldCount);
+        HistogramImpl::kInternalFieldCount);
     env->SetProtoMethodNoSideEffect(tmpl, "exceeds", GetExceeds);
     env->SetProtoMethodNoSideEffect(tmpl, "min", GetMin);
     env->SetProtoMethodNoSideEffect(tmpl, "max", GetMax);
@@ -192,6 +470,8 @@ Local<FunctionTemplate> HistogramBase::GetConstructorTemplate(
     env->SetProtoMethod(tmpl, "reset", DoReset);
     env->SetProtoMethod(tmpl, "record", Record);
     env->SetProtoMethod(tmpl, "recordDelta", RecordDelta);
+    env->SetProtoMethod(tmpl, "add", Add);
+    env->SetProtoMethodNoSideEffect(tmpl, "encode", DoEncode);
     env->set_histogram_ctor_template(tmpl);
   }
   return tmpl;
@@ -199,6 +479,7 @@ Local<FunctionTemplate> HistogramBase::GetConstructorTemplate(
 
 void HistogramBase::Initialize(Environment* env, Local<Object> target) {
   env->SetConstructorFunction(target, "Histogram", GetConstructorTemplate(env));
+  env->SetMethod(target, "decodeHistogram", DoDecode);
 }
 
 BaseObjectPtr<BaseObject> HistogramBase::HistogramTransferData::Deserialize(
@@ -224,7 +505,7 @@ Local<FunctionTemplate> IntervalHistogram::GetConstructorTemplate(
     tmpl = FunctionTemplate::New(env->isolate());
     tmpl->Inherit(HandleWrap::GetConstructorTemplate(env));
     tmpl->InstanceTemplate()->SetInternalFieldCount(
-        HistogramBase::kInternalFieldCount);
+        HistogramImpl::kInternalFieldCount);
     env->SetProtoMethodNoSideEffect(tmpl, "exceeds", GetExceeds);
     env->SetProtoMethodNoSideEffect(tmpl, "min", GetMin);
     env->SetProtoMethodNoSideEffect(tmpl, "max", GetMax);
@@ -233,6 +514,7 @@ Local<FunctionTemplate> IntervalHistogram::GetConstructorTemplate(
     env->SetProtoMethodNoSideEffect(tmpl, "percentile", GetPercentile);
     env->SetProtoMethodNoSideEffect(tmpl, "percentiles", GetPercentiles);
     env->SetProtoMethod(tmpl, "reset", DoReset);
+    env->SetProtoMethodNoSideEffect(tmpl, "encode", DoEncode);
     env->SetProtoMethod(tmpl, "start", Start);
     env->SetProtoMethod(tmpl, "stop", Stop);
     env->set_intervalhistogram_constructor_template(tmpl);
@@ -256,6 +538,8 @@ IntervalHistogram::IntervalHistogram(
       HistogramImpl(lowest, highest, figures),
       interval_(interval) {
   MakeWeak();
+  wrap->SetAlignedPointerInInternalField(
+      HistogramImpl::kImplField, static_cast<HistogramImpl*>(this));
   uv_timer_init(env->event_loop(), &timer_);
 }
 
@@ -358,6 +642,19 @@ void IntervalHistogram::DoReset(const FunctionCallbackInfo<Value>& args) {
   (*histogram)->Reset();
 }
 
+void IntervalHistogram::DoEncode(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  IntervalHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  std::vector<uint8_t> encoded = (*histogram)->Encode();
+  Local<Object> buffer;
+  if (Buffer::Copy(env,
+                   reinterpret_cast<const char*>(encoded.data()),
+                   encoded.size()).ToLocal(&buffer)) {
+    args.GetReturnValue().Set(buffer);
+  }
+}
+
 std::unique_ptr<worker::TransferData>
 IntervalHistogram::CloneForMessaging() const {
   return std::make_unique<HistogramBase::HistogramTransferData>(histogram());
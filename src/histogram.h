@@ -14,7 +14,9 @@
 #include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace node {
 
@@ -39,6 +41,20 @@ class Histogram : public MemoryRetainer {
 
   inline uint64_t RecordDelta();
 
+  // Adds the counts of another histogram to this one. Returns the number of
+  // values that were out of the range of this histogram, which are counted
+  // in Exceeds() instead.
+  int64_t Add(const Histogram& other);
+
+  // Encodes the histogram in the compressed V2 format of HdrHistogram, which
+  // is the format of the Interval_Compressed_Histogram column of its logs
+  // once it is base64 encoded.
+  std::vector<uint8_t> Encode();
+
+  // Returns a new histogram with the range and the counts of an encoded
+  // histogram, or nullptr if the data is not one.
+  static std::shared_ptr<Histogram> Decode(const uint8_t* data, size_t size);
+
   // Iterator is a function type that takes two doubles as argument, one for
   // percentile and one for the value at that percentile.
   template <typename Iterator>
@@ -61,12 +77,22 @@ class Histogram : public MemoryRetainer {
 
 class HistogramImpl {
  public:
+  enum InternalFields {
+    kSlot = BaseObject::kSlot,
+    kImplField = BaseObject::kInternalFieldCount,
+    kInternalFieldCount
+  };
+
   HistogramImpl(int64_t lowest, int64_t highest, int figures);
   explicit HistogramImpl(std::shared_ptr<Histogram> histogram);
 
+  // Returns the HistogramImpl of the handle of any JS histogram, i.e. of a
+  // HistogramBase or of an IntervalHistogram. Native code can keep the
+  // histogram() of it and record into it directly.
+  static HistogramImpl* FromJSObject(v8::Local<v8::Value> value);
+
   Histogram* operator->() { return histogram_.get(); }
 
- protected:
   const std::shared_ptr<Histogram>& histogram() const { return histogram_; }
 
  private:
@@ -107,6 +133,9 @@ class HistogramBase : public BaseObject, public HistogramImpl {
   static void DoReset(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Record(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecordDelta(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Add(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DoEncode(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DoDecode(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   HistogramBase(
       Environment* env,
@@ -186,6 +215,7 @@ class IntervalHistogram : public HandleWrap, public HistogramImpl {
   static void GetPercentiles(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DoReset(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DoEncode(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
 
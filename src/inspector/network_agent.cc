@@ -0,0 +1,76 @@
+#include "network_agent.h"
+
+#include "env-inl.h"
+#include "inspector_agent.h"
+
+namespace node {
+namespace inspector {
+namespace protocol {
+
+NetworkAgent::NetworkAgent(Environment* env) : env_(env) {}
+
+void NetworkAgent::Wire(UberDispatcher* dispatcher) {
+  frontend_ = std::make_unique<Network::Frontend>(dispatcher->channel());
+  Network::Dispatcher::wire(dispatcher, this);
+}
+
+DispatchResponse NetworkAgent::enable() {
+  if (!enabled_) {
+    enabled_ = true;
+    env_->inspector_agent()->EnableNetworkTracking();
+  }
+  return DispatchResponse::OK();
+}
+
+DispatchResponse NetworkAgent::disable() {
+  if (enabled_) {
+    enabled_ = false;
+    env_->inspector_agent()->DisableNetworkTracking();
+  }
+  return DispatchResponse::OK();
+}
+
+void NetworkAgent::emitNotification(const std::string& event,
+                                    protocol::DictionaryValue* params) {
+  if (!enabled_)
+    return;
+
+  ErrorSupport errors;
+  if (event == "Network.requestWillBeSent") {
+    auto notification =
+        Network::RequestWillBeSentNotification::fromValue(params, &errors);
+    if (!notification)
+      return;
+    frontend_->requestWillBeSent(notification->getRequestId(),
+                                 notification->getRequest()->clone(),
+                                 notification->getTimestamp(),
+                                 notification->getWallTime());
+  } else if (event == "Network.responseReceived") {
+    auto notification =
+        Network::ResponseReceivedNotification::fromValue(params, &errors);
+    if (!notification)
+      return;
+    frontend_->responseReceived(notification->getRequestId(),
+                                notification->getTimestamp(),
+                                notification->getResponse()->clone());
+  } else if (event == "Network.loadingFailed") {
+    auto notification =
+        Network::LoadingFailedNotification::fromValue(params, &errors);
+    if (!notification)
+      return;
+    frontend_->loadingFailed(notification->getRequestId(),
+                             notification->getTimestamp(),
+                             notification->getErrorText());
+  } else if (event == "Network.loadingFinished") {
+    auto notification =
+        Network::LoadingFinishedNotification::fromValue(params, &errors);
+    if (!notification)
+      return;
+    frontend_->loadingFinished(notification->getRequestId(),
+                               notification->getTimestamp());
+  }
+}
+
+}  // namespace protocol
+}  // namespace inspector
+}  // namespace node
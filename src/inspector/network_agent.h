@@ -0,0 +1,35 @@
+#ifndef SRC_INSPECTOR_NETWORK_AGENT_H_
+#define SRC_INSPECTOR_NETWORK_AGENT_H_
+
+#include "node/inspector/protocol/Network.h"
+
+namespace node {
+class Environment;
+
+namespace inspector {
+namespace protocol {
+
+class NetworkAgent : public Network::Backend {
+ public:
+  explicit NetworkAgent(Environment* env);
+
+  void Wire(UberDispatcher* dispatcher);
+
+  DispatchResponse enable() override;
+  DispatchResponse disable() override;
+
+  // Sends an event that the JS network tracking has emitted to the frontend,
+  // if this session has enabled the domain.
+  void emitNotification(const std::string& event,
+                        protocol::DictionaryValue* params);
+
+ private:
+  Environment* env_;
+  std::shared_ptr<Network::Frontend> frontend_;
+  bool enabled_ = false;
+};
+}  // namespace protocol
+}  // namespace inspector
+}  // namespace node
+
+#endif  // SRC_INSPECTOR_NETWORK_AGENT_H_
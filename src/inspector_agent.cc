@@ -2,6 +2,7 @@
 
 #include "env-inl.h"
 #include "inspector/main_thread_interface.h"
+#include "inspector/network_agent.h"
 #include "inspector/node_string.h"
 #include "inspector/runtime_agent.h"
 #include "inspector/tracing_agent.h"
@@ -230,6 +231,8 @@ class ChannelImpl final : public v8_inspector::V8Inspector::Channel,
     }
     runtime_agent_ = std::make_unique<protocol::RuntimeAgent>();
     runtime_agent_->Wire(node_dispatcher_.get());
+    network_agent_ = std::make_unique<protocol::NetworkAgent>(env);
+    network_agent_->Wire(node_dispatcher_.get());
   }
 
   ~ChannelImpl() override {
@@ -241,6 +244,8 @@ class ChannelImpl final : public v8_inspector::V8Inspector::Channel,
     }
     runtime_agent_->disable();
     runtime_agent_.reset();  // Dispose before the dispatchers
+    network_agent_->disable();
+    network_agent_.reset();  // Dispose before the dispatchers
   }
 
   void dispatchProtocolMessage(const StringView& message) {
@@ -278,6 +283,11 @@ class ChannelImpl final : public v8_inspector::V8Inspector::Channel,
     return retaining_context_;
   }
 
+  void emitNetworkNotification(const std::string& event,
+                               protocol::DictionaryValue* params) {
+    network_agent_->emitNotification(event, params);
+  }
+
  private:
   void sendResponse(
       int callId,
@@ -320,6 +330,7 @@ class ChannelImpl final : public v8_inspector::V8Inspector::Channel,
   std::unique_ptr<protocol::RuntimeAgent> runtime_agent_;
   std::unique_ptr<protocol::TracingAgent> tracing_agent_;
   std::unique_ptr<protocol::WorkerAgent> worker_agent_;
+  std::unique_ptr<protocol::NetworkAgent> network_agent_;
   std::unique_ptr<InspectorSessionDelegate> delegate_;
   std::unique_ptr<v8_inspector::V8InspectorSession> session_;
   std::unique_ptr<protocol::UberDispatcher> node_dispatcher_;
@@ -572,6 +583,17 @@ class NodeInspectorClient : public V8InspectorClient {
     return false;
   }
 
+  void emitNetworkNotification(const std::string& event,
+                               const std::string& params) {
+    std::unique_ptr<protocol::DictionaryValue> value =
+        protocol::DictionaryValue::cast(
+            protocol::StringUtil::parseMessage(params, false));
+    if (!value)
+      return;
+    for (const auto& id_channel : channels_)
+      id_channel.second->emitNetworkNotification(event, value.get());
+  }
+
   bool notifyWaitingForDisconnect() {
     bool retaining_context = false;
     for (const auto& id_channel : channels_) {
@@ -837,6 +859,51 @@ void Agent::DisableAsyncHook() {
   }
 }
 
+void Agent::RegisterNetworkTracking(Isolate* isolate,
+                                    Local<Function> enable_function,
+                                    Local<Function> disable_function) {
+  enable_network_tracking_function_.Reset(isolate, enable_function);
+  disable_network_tracking_function_.Reset(isolate, disable_function);
+  // Sessions may have enabled the domain during bootstrap.
+  if (network_tracking_sessions_ > 0)
+    ToggleNetworkTracking(enable_network_tracking_function_);
+}
+
+void Agent::EnableNetworkTracking() {
+  if (network_tracking_sessions_++ == 0 &&
+      !enable_network_tracking_function_.IsEmpty()) {
+    ToggleNetworkTracking(enable_network_tracking_function_);
+  }
+}
+
+void Agent::DisableNetworkTracking() {
+  CHECK_GT(network_tracking_sessions_, 0);
+  if (--network_tracking_sessions_ == 0 &&
+      !disable_network_tracking_function_.IsEmpty()) {
+    ToggleNetworkTracking(disable_network_tracking_function_);
+  }
+}
+
+void Agent::ToggleNetworkTracking(const Global<Function>& fn) {
+  if (!parent_env_->can_call_into_js()) return;
+  Isolate* isolate = parent_env_->isolate();
+  HandleScope handle_scope(isolate);
+  Local<Context> context = parent_env_->context();
+  v8::TryCatch try_catch(isolate);
+  USE(fn.Get(isolate)->Call(context, Undefined(isolate), 0, nullptr));
+  if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
+    PrintCaughtException(isolate, context, try_catch);
+    FatalError("\nnode::inspector::Agent::ToggleNetworkTracking",
+               "Cannot toggle Inspector's network tracking, please report "
+               "this.");
+  }
+}
+
+void Agent::EmitProtocolEvent(const std::string& event,
+                              const std::string& params) {
+  client_->emitNetworkNotification(event, params);
+}
+
 void Agent::ToggleAsyncHook(Isolate* isolate,
                             const Global<Function>& fn) {
   // Guard against running this during cleanup -- no async events will be
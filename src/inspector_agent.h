@@ -82,6 +82,16 @@ class Agent {
   void EnableAsyncHook();
   void DisableAsyncHook();
 
+  // Network tracking is enabled in JS while at least one session has
+  // enabled the Network domain.
+  void RegisterNetworkTracking(v8::Isolate* isolate,
+                               v8::Local<v8::Function> enable_function,
+                               v8::Local<v8::Function> disable_function);
+  void EnableNetworkTracking();
+  void DisableNetworkTracking();
+  // Sends a Network event, with its parameters as JSON, to the sessions.
+  void EmitProtocolEvent(const std::string& event, const std::string& params);
+
   void SetParentHandle(std::unique_ptr<ParentInspectorHandle> parent_handle);
   std::unique_ptr<ParentInspectorHandle> GetParentHandle(
       uint64_t thread_id, const std::string& url);
@@ -121,6 +131,7 @@ class Agent {
  private:
   void ToggleAsyncHook(v8::Isolate* isolate,
                        const v8::Global<v8::Function>& fn);
+  void ToggleNetworkTracking(const v8::Global<v8::Function>& fn);
 
   node::Environment* parent_env_;
   // Encapsulates majority of the Inspector functionality
@@ -141,6 +152,10 @@ class Agent {
   bool pending_disable_async_hook_ = false;
   v8::Global<v8::Function> enable_async_hook_function_;
   v8::Global<v8::Function> disable_async_hook_function_;
+
+  int network_tracking_sessions_ = 0;
+  v8::Global<v8::Function> enable_network_tracking_function_;
+  v8::Global<v8::Function> disable_network_tracking_function_;
 };
 
 }  // namespace inspector
@@ -270,6 +270,28 @@ static void RegisterAsyncHookWrapper(const FunctionCallbackInfo<Value>& args) {
     enable_function, disable_function);
 }
 
+static void RegisterNetworkTrackingWrapper(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsFunction());
+  Local<Function> enable_function = args[0].As<Function>();
+  CHECK(args[1]->IsFunction());
+  Local<Function> disable_function = args[1].As<Function>();
+  env->inspector_agent()->RegisterNetworkTracking(env->isolate(),
+    enable_function, disable_function);
+}
+
+static void EmitProtocolEvent(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  Utf8Value event(env->isolate(), args[0]);
+  CHECK(args[1]->IsString());
+  Utf8Value params(env->isolate(), args[1]);
+  env->inspector_agent()->EmitProtocolEvent(*event, *params);
+}
+
 void IsEnabled(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   args.GetReturnValue().Set(InspectorEnabled(env));
@@ -341,6 +363,10 @@ void Initialize(Local<Object> target, Local<Value> unused,
       InvokeAsyncTaskFnWithId<&Agent::AsyncTaskFinished>);
 
   env->SetMethod(target, "registerAsyncHook", RegisterAsyncHookWrapper);
+  env->SetMethod(target,
+                 "registerNetworkTracking",
+                 RegisterNetworkTrackingWrapper);
+  env->SetMethod(target, "emitProtocolEvent", EmitProtocolEvent);
   env->SetMethodNoSideEffect(target, "isEnabled", IsEnabled);
 
   JSBindingsConnection<LocalConnection>::Bind(env, target);
@@ -363,6 +389,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(InvokeAsyncTaskFnWithId<&Agent::AsyncTaskFinished>);
 
   registry->Register(RegisterAsyncHookWrapper);
+  registry->Register(RegisterNetworkTrackingWrapper);
+  registry->Register(EmitProtocolEvent);
   registry->Register(IsEnabled);
 
   registry->Register(JSBindingsConnection<LocalConnection>::New);
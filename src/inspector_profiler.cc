@@ -316,7 +316,13 @@ std::string V8CpuProfilerConnection::GetDirectory() const {
 }
 
 std::string V8CpuProfilerConnection::GetFilename() const {
-  return env()->cpu_prof_name();
+  if (window_ == 0)
+    return env()->cpu_prof_name();
+  // Every window is written to a file of its own.
+  if (!env()->options()->cpu_prof_name.empty())
+    return env()->cpu_prof_name() + "." + std::to_string(profile_count_);
+  DiagnosticFilename filename(env(), "CPU", "cpuprofile");
+  return *filename;
 }
 
 MaybeLocal<Object> V8CpuProfilerConnection::GetProfile(Local<Object> result) {
@@ -335,6 +341,37 @@ MaybeLocal<Object> V8CpuProfilerConnection::GetProfile(Local<Object> result) {
   return profile_v.As<Object>();
 }
 
+void V8CpuProfilerConnection::WriteProfile(Local<Object> result) {
+  Isolate* isolate = env_->isolate();
+  Local<Context> context = env_->context();
+  profile_count_++;
+
+  Local<Object> profile;
+  if (!GetProfile(result).ToLocal(&profile)) {
+    return;
+  }
+
+  Local<String> result_s;
+  if (!v8::JSON::Stringify(context, profile).ToLocal(&result_s)) {
+    fprintf(stderr, "Failed to stringify %s profile result\n", type());
+    return;
+  }
+  if (taking_profile_)
+    taken_profile_.Reset(isolate, result_s);
+
+  std::string directory = GetDirectory();
+  DCHECK(!directory.empty());
+  if (!EnsureDirectory(directory, type())) {
+    return;
+  }
+
+  std::string filename = GetFilename();
+  DCHECK(!filename.empty());
+  std::string path = directory + kPathSeparator + filename;
+
+  WriteResult(env_, path.c_str(), result_s);
+}
+
 void V8CpuProfilerConnection::Start() {
   DispatchMessage("Profiler.enable");
   DispatchMessage("Profiler.start");
@@ -342,6 +379,48 @@ void V8CpuProfilerConnection::Start() {
   params += std::to_string(env()->cpu_prof_interval());
   params += " }";
   DispatchMessage("Profiler.setSamplingInterval", params.c_str());
+
+  window_ = env()->options()->cpu_prof_window;
+  if (window_ == 0)
+    return;
+  CHECK_EQ(0, uv_timer_init(env()->event_loop(), &window_timer_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&window_timer_));
+  uint64_t window_ms = window_ * 1000;
+  uv_timer_start(&window_timer_, [](uv_timer_t* handle) {
+    V8CpuProfilerConnection* connection =
+        ContainerOf(&V8CpuProfilerConnection::window_timer_, handle);
+    connection->RotateProfile();
+  }, window_ms, window_ms);
+  env()->RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&window_timer_),
+      [](Environment* env, uv_handle_t* handle, void* arg) {
+        env->CloseHandle(handle, [](uv_handle_t* handle) {});
+      },
+      nullptr);
+}
+
+void V8CpuProfilerConnection::RotateProfile() {
+  if (ending_)
+    return;
+  Debug(env_, DebugCategory::INSPECTOR_PROFILER,
+        "Rotating CPU profile %d\n", profile_count_);
+  // The response to the stop request, with the profile, is dispatched
+  // synchronously.
+  DispatchMessage("Profiler.stop", nullptr, true);
+  DispatchMessage("Profiler.start");
+}
+
+MaybeLocal<String> V8CpuProfilerConnection::TakeProfile() {
+  if (ending_)
+    return MaybeLocal<String>();
+  taking_profile_ = true;
+  RotateProfile();
+  taking_profile_ = false;
+  if (taken_profile_.IsEmpty())
+    return MaybeLocal<String>();
+  Local<String> profile = taken_profile_.Get(env_->isolate());
+  taken_profile_.Reset();
+  return profile;
 }
 
 void V8CpuProfilerConnection::End() {
@@ -352,6 +431,8 @@ void V8CpuProfilerConnection::End() {
     return;
   }
   ending_ = true;
+  if (window_ > 0)
+    uv_timer_stop(&window_timer_);
   DispatchMessage("Profiler.stop", nullptr, true);
 }
 
@@ -509,6 +590,20 @@ static void StopCoverage(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+static void TakeCpuProfile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  V8CpuProfilerConnection* connection = env->cpu_profiler_connection();
+
+  Debug(env,
+        DebugCategory::INSPECTOR_PROFILER,
+        "TakeCpuProfile, connection %s nullptr\n",
+        connection == nullptr ? "==" : "!=");
+
+  Local<String> profile;
+  if (connection != nullptr && connection->TakeProfile().ToLocal(&profile))
+    args.GetReturnValue().Set(profile);
+}
+
 static void Initialize(Local<Object> target,
                        Local<Value> unused,
                        Local<Context> context,
@@ -518,6 +613,7 @@ static void Initialize(Local<Object> target,
   env->SetMethod(target, "setSourceMapCacheGetter", SetSourceMapCacheGetter);
   env->SetMethod(target, "takeCoverage", TakeCoverage);
   env->SetMethod(target, "stopCoverage", StopCoverage);
+  env->SetMethod(target, "takeCpuProfile", TakeCpuProfile);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -525,6 +621,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SetSourceMapCacheGetter);
   registry->Register(TakeCoverage);
   registry->Register(StopCoverage);
+  registry->Register(TakeCpuProfile);
 }
 
 }  // namespace profiler
@@ -116,10 +116,25 @@ class V8CpuProfilerConnection : public V8ProfilerConnection {
   std::string GetDirectory() const override;
   std::string GetFilename() const override;
   v8::MaybeLocal<v8::Object> GetProfile(v8::Local<v8::Object> result) override;
+  void WriteProfile(v8::Local<v8::Object> result) override;
+
+  // Ends the current profile, which is written to disk as usual, and starts
+  // a new one. Returns the profile that was ended, as JSON.
+  v8::MaybeLocal<v8::String> TakeProfile();
 
  private:
+  // With --cpu-prof-window, the profile is ended and a new one is started
+  // every window, so that the profiles of a long running process are
+  // written as it runs, and are each of a bounded size.
+  void RotateProfile();
+
   std::unique_ptr<inspector::InspectorSession> session_;
   bool ending_ = false;
+  uv_timer_t window_timer_;
+  uint64_t window_ = 0;
+  uint32_t profile_count_ = 0;
+  bool taking_profile_ = false;
+  v8::Global<v8::String> taken_profile_;
 };
 
 class V8HeapProfilerConnection : public V8ProfilerConnection {
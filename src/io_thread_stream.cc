@@ -0,0 +1,571 @@
+#include "io_thread_stream.h"
+
+#include "base_object-inl.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_internals.h"
+#include "stream_base-inl.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace node {
+
+using v8::Boolean;
+using v8::Context;
+using v8::DontDelete;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Local;
+using v8::Object;
+using v8::PropertyAttribute;
+using v8::ReadOnly;
+using v8::Signature;
+using v8::Uint32;
+using v8::Value;
+
+IOThread::IOThread() {
+  CHECK_EQ(uv_loop_init(&loop_), 0);
+  CHECK_EQ(uv_async_init(&loop_, &tasks_async_, RunTasks), 0);
+  tasks_async_.data = this;
+  CHECK_EQ(uv_thread_create(&thread_, Run, this), 0);
+}
+
+IOThread::~IOThread() {
+  // The sockets have been closed by now, the tasks that close them run before
+  // this one. The loop ends once the async handle is closed, too.
+  Post([](uv_loop_t* loop) {
+    uv_walk(loop, [](uv_handle_t* handle, void*) {
+      if (!uv_is_closing(handle))
+        uv_close(handle, nullptr);
+    }, nullptr);
+  });
+  CHECK_EQ(uv_thread_join(&thread_), 0);
+  CheckedUvLoopClose(&loop_);
+}
+
+void IOThread::Post(std::function<void(uv_loop_t*)> task) {
+  {
+    Mutex::ScopedLock lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  CHECK_EQ(uv_async_send(&tasks_async_), 0);
+}
+
+void IOThread::Run(void* arg) {
+  IOThread* thread = static_cast<IOThread*>(arg);
+  uv_run(&thread->loop_, UV_RUN_DEFAULT);
+}
+
+void IOThread::RunTasks(uv_async_t* async) {
+  IOThread* thread = static_cast<IOThread*>(async->data);
+  std::deque<std::function<void(uv_loop_t*)>> tasks;
+  {
+    Mutex::ScopedLock lock(thread->mutex_);
+    tasks.swap(thread->tasks_);
+  }
+  for (auto& task : tasks)
+    task(&thread->loop_);
+}
+
+bool IOThreadStream::Connection::Deliver(Event&& event) {
+  Mutex::ScopedLock lock(mutex);
+  if (owner == nullptr)
+    return false;
+  events.push_back(std::move(event));
+  CHECK_EQ(uv_async_send(&owner->async_), 0);
+  return true;
+}
+
+bool IOThreadStream::Connection::DeliverData(const char* data, size_t len) {
+  Mutex::ScopedLock lock(mutex);
+  if (owner == nullptr)
+    return false;
+  pending_bytes += len;
+  if (pending_bytes >= kMaxPendingBytes)
+    throttled = true;
+
+  if (!events.empty()) {
+    Event& last = events.back();
+    if (last.type == Event::kRead && last.status > 0 &&
+        last.capacity - static_cast<size_t>(last.status) >= len) {
+      memcpy(last.data.get() + last.status, data, len);
+      last.status += len;
+      return true;
+    }
+  }
+
+  Event event { Event::kRead, static_cast<ssize_t>(len) };
+  event.capacity = std::max(len, kReadBufferSize);
+  event.data.reset(new char[event.capacity]);
+  memcpy(event.data.get(), data, len);
+  events.push_back(std::move(event));
+  CHECK_EQ(uv_async_send(&owner->async_), 0);
+  return true;
+}
+
+IOThreadStream::IOThreadStream(Environment* env, Local<Object> object, int fd)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&async_),
+                 AsyncWrap::PROVIDER_IOTHREADSTREAM),
+      StreamBase(env),
+      io_thread_(env->io_thread()),
+      fd_(fd),
+      conn_(std::make_shared<Connection>()) {
+  CHECK_EQ(uv_async_init(env->event_loop(), &async_, OnEvents), 0);
+  async_.data = static_cast<HandleWrap*>(this);
+  conn_->owner = this;
+  StreamBase::AttachToObject(object);
+
+  std::shared_ptr<Connection> conn = conn_;
+  io_thread_->Post([conn, fd](uv_loop_t* loop) {
+    Open(conn, loop, fd);
+  });
+}
+
+void IOThreadStream::Initialize(Local<Object> target,
+                                Local<Value> unused,
+                                Local<Context> context,
+                                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      StreamBase::kInternalFieldCount);
+  t->InstanceTemplate()->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "reading"),
+                             Boolean::New(env->isolate(), false));
+  t->Inherit(HandleWrap::GetConstructorTemplate(env));
+
+  Local<FunctionTemplate> get_write_queue_size =
+      FunctionTemplate::New(env->isolate(),
+                            GetWriteQueueSize,
+                            Local<Value>(),
+                            Signature::New(env->isolate(), t));
+  t->PrototypeTemplate()->SetAccessorProperty(
+      env->write_queue_size_string(),
+      get_write_queue_size,
+      Local<FunctionTemplate>(),
+      static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+
+  StreamBase::AddMethods(env, t);
+  env->SetProtoMethod(t, "setNoDelay", SetNoDelay);
+  env->SetProtoMethod(t, "setKeepAlive", SetKeepAlive);
+  env->SetProtoMethod(t, "getsockname", GetSockName);
+  env->SetProtoMethod(t, "getpeername", GetPeerName);
+
+  env->SetConstructorFunction(target, "IOThreadStream", t);
+}
+
+// new IOThreadStream(fd) takes over the file descriptor of a connected TCP
+// socket, which is closed along with the stream.
+void IOThreadStream::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsInt32());
+  Environment* env = Environment::GetCurrent(args);
+  new IOThreadStream(env, args.This(), args[0].As<v8::Int32>()->Value());
+}
+
+void IOThreadStream::Open(std::shared_ptr<Connection> conn,
+                          uv_loop_t* loop,
+                          int fd) {
+  CHECK_EQ(uv_tcp_init(loop, &conn->tcp), 0);
+  conn->tcp.data = conn.get();
+  conn->self = conn;
+  conn->read_buffer.reset(new char[kReadBufferSize]);
+  int err = uv_tcp_open(&conn->tcp, fd);
+  if (err != 0) {
+#ifndef _WIN32
+    close(fd);
+#endif
+    conn->Deliver(Event { Event::kRead, err });
+    CloseSocket(conn.get());
+    return;
+  }
+  conn->open = true;
+  StartReading(conn.get());
+}
+
+void IOThreadStream::StartReading(Connection* conn) {
+  if (!conn->open || conn->closing || !conn->reading)
+    return;
+  {
+    Mutex::ScopedLock lock(conn->mutex);
+    if (conn->throttled)
+      return;
+  }
+  uv_read_start(reinterpret_cast<uv_stream_t*>(&conn->tcp),
+                [](uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
+    Connection* conn = static_cast<Connection*>(handle->data);
+    *buf = uv_buf_init(conn->read_buffer.get(), kReadBufferSize);
+  }, [](uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+    Connection* conn = static_cast<Connection*>(stream->data);
+    if (nread == 0)
+      return;
+    if (nread < 0) {
+      uv_read_stop(stream);
+      conn->Deliver(Event { Event::kRead, nread });
+      return;
+    }
+    if (!conn->DeliverData(buf->base, nread)) {
+      uv_read_stop(stream);
+      return;
+    }
+    Mutex::ScopedLock lock(conn->mutex);
+    if (conn->throttled)
+      uv_read_stop(stream);
+  });
+}
+
+void IOThreadStream::Write(Connection* conn,
+                           WriteWrap* w,
+                           std::vector<uv_buf_t> bufs) {
+  struct WriteReq {
+    uv_write_t req;
+    Connection* conn;
+    WriteWrap* wrap;
+  };
+
+  if (!conn->open || conn->closing) {
+    conn->Deliver(Event { Event::kWriteDone, UV_EBADF, nullptr, 0, w });
+    return;
+  }
+  WriteReq* req = new WriteReq { {}, conn, w };
+  int err = uv_write(&req->req,
+                     reinterpret_cast<uv_stream_t*>(&conn->tcp),
+                     bufs.data(),
+                     bufs.size(),
+                     [](uv_write_t* write_req, int status) {
+    std::unique_ptr<WriteReq> req(
+        ContainerOf(&WriteReq::req, write_req));
+    req->conn->Deliver(
+        Event { Event::kWriteDone, status, nullptr, 0, req->wrap });
+  });
+  if (err != 0) {
+    delete req;
+    conn->Deliver(Event { Event::kWriteDone, err, nullptr, 0, w });
+  }
+}
+
+void IOThreadStream::Shutdown(Connection* conn, ShutdownWrap* req_wrap) {
+  struct ShutdownReq {
+    uv_shutdown_t req;
+    Connection* conn;
+    ShutdownWrap* wrap;
+  };
+
+  if (!conn->open || conn->closing) {
+    conn->Deliver(
+        Event { Event::kShutdownDone, UV_EBADF, nullptr, 0, req_wrap });
+    return;
+  }
+  ShutdownReq* req = new ShutdownReq { {}, conn, req_wrap };
+  int err = uv_shutdown(&req->req,
+                        reinterpret_cast<uv_stream_t*>(&conn->tcp),
+                        [](uv_shutdown_t* shutdown_req, int status) {
+    std::unique_ptr<ShutdownReq> req(
+        ContainerOf(&ShutdownReq::req, shutdown_req));
+    req->conn->Deliver(
+        Event { Event::kShutdownDone, status, nullptr, 0, req->wrap });
+  });
+  if (err != 0) {
+    delete req;
+    conn->Deliver(Event { Event::kShutdownDone, err, nullptr, 0, req_wrap });
+  }
+}
+
+void IOThreadStream::CloseSocket(Connection* conn) {
+  if (conn->closing)
+    return;
+  conn->closing = true;
+  uv_close(reinterpret_cast<uv_handle_t*>(&conn->tcp), [](uv_handle_t* handle) {
+    Connection* conn = static_cast<Connection*>(handle->data);
+    // This may delete the connection.
+    std::shared_ptr<Connection> self = std::move(conn->self);
+  });
+}
+
+void IOThreadStream::Post(std::function<void(Connection*)> task) {
+  std::shared_ptr<Connection> conn = conn_;
+  io_thread_->Post([conn, task](uv_loop_t* loop) {
+    task(conn.get());
+  });
+}
+
+void IOThreadStream::OnEvents(uv_async_t* async) {
+  IOThreadStream* stream = static_cast<IOThreadStream*>(
+      static_cast<HandleWrap*>(async->data));
+  HandleScope handle_scope(stream->env()->isolate());
+  Context::Scope context_scope(stream->env()->context());
+  stream->EmitEvents();
+}
+
+void IOThreadStream::EmitEvents() {
+  std::vector<Event> events;
+  {
+    Mutex::ScopedLock lock(conn_->mutex);
+    events.swap(conn_->events);
+  }
+
+  // Requests that are still pending when the stream closes are cancelled in
+  // OnClose().
+  for (Event& event : events) {
+    if (IsHandleClosing())
+      return;
+    switch (event.type) {
+      case Event::kRead:
+        backlog_.push_back(std::move(event));
+        break;
+      case Event::kWriteDone: {
+        WriteWrap* w = static_cast<WriteWrap*>(event.req);
+        auto it = std::find_if(
+            pending_writes_.begin(), pending_writes_.end(),
+            [&](const PendingWrite& write) { return write.wrap == w; });
+        CHECK_NE(it, pending_writes_.end());
+        write_queue_size_ -= it->bytes;
+        BaseObjectPtr<AsyncWrap> keep_alive = std::move(it->keep_alive);
+        pending_writes_.erase(it);
+        w->Done(static_cast<int>(event.status));
+        break;
+      }
+      case Event::kShutdownDone: {
+        ShutdownWrap* req_wrap = static_cast<ShutdownWrap*>(event.req);
+        auto it = std::find_if(
+            pending_shutdowns_.begin(), pending_shutdowns_.end(),
+            [&](const PendingShutdown& shutdown) {
+              return shutdown.wrap == req_wrap;
+            });
+        CHECK_NE(it, pending_shutdowns_.end());
+        BaseObjectPtr<AsyncWrap> keep_alive = std::move(it->keep_alive);
+        pending_shutdowns_.erase(it);
+        req_wrap->Done(static_cast<int>(event.status));
+        break;
+      }
+    }
+  }
+
+  size_t emitted = 0;
+  while (reading_ && !backlog_.empty() && !IsHandleClosing()) {
+    Event event = std::move(backlog_.front());
+    backlog_.pop_front();
+    if (event.status < 0) {
+      EmitRead(event.status);
+      continue;
+    }
+    // Listeners may provide smaller buffers than what there is to emit.
+    const char* data = event.data.get();
+    size_t left = event.status;
+    emitted += left;
+    while (left > 0 && !IsHandleClosing()) {
+      uv_buf_t buf = EmitAlloc(left);
+      CHECK_GT(buf.len, 0);
+      size_t len = std::min<size_t>(left, buf.len);
+      memcpy(buf.base, data, len);
+      data += len;
+      left -= len;
+      EmitRead(len, buf);
+    }
+  }
+
+  if (emitted > 0) {
+    bool resume;
+    {
+      Mutex::ScopedLock lock(conn_->mutex);
+      conn_->pending_bytes -= emitted;
+      resume = conn_->throttled &&
+               conn_->pending_bytes < kMaxPendingBytes / 2;
+      if (resume)
+        conn_->throttled = false;
+    }
+    if (resume)
+      Post(StartReading);
+  }
+}
+
+bool IOThreadStream::IsAlive() {
+  return HandleWrap::IsAlive(this);
+}
+
+bool IOThreadStream::IsClosing() {
+  return IsHandleClosing();
+}
+
+int IOThreadStream::GetFD() {
+  return fd_;
+}
+
+AsyncWrap* IOThreadStream::GetAsyncWrap() {
+  return static_cast<AsyncWrap*>(this);
+}
+
+int IOThreadStream::ReadStart() {
+  reading_ = true;
+  Post([](Connection* conn) {
+    conn->reading = true;
+    StartReading(conn);
+  });
+  // Emit what was read while JS did not want to read, from the event loop.
+  if (!backlog_.empty())
+    CHECK_EQ(uv_async_send(&async_), 0);
+  return 0;
+}
+
+int IOThreadStream::ReadStop() {
+  reading_ = false;
+  Post([](Connection* conn) {
+    conn->reading = false;
+    if (conn->open && !conn->closing)
+      uv_read_stop(reinterpret_cast<uv_stream_t*>(&conn->tcp));
+  });
+  return 0;
+}
+
+int IOThreadStream::DoWrite(WriteWrap* w,
+                            uv_buf_t* bufs,
+                            size_t count,
+                            uv_stream_t* send_handle) {
+  CHECK_NULL(send_handle);
+  // The data stays alive until the request is done, the array does not.
+  std::vector<uv_buf_t> buffers(bufs, bufs + count);
+  size_t bytes = 0;
+  for (const uv_buf_t& buf : buffers)
+    bytes += buf.len;
+  pending_writes_.push_back(
+      PendingWrite { w, bytes, BaseObjectPtr<AsyncWrap>(w->GetAsyncWrap()) });
+  write_queue_size_ += bytes;
+  Post([w, buffers](Connection* conn) {
+    Write(conn, w, buffers);
+  });
+  return 0;
+}
+
+int IOThreadStream::DoShutdown(ShutdownWrap* req_wrap) {
+  pending_shutdowns_.push_back(PendingShutdown {
+      req_wrap, BaseObjectPtr<AsyncWrap>(req_wrap->GetAsyncWrap()) });
+  Post([req_wrap](Connection* conn) {
+    Shutdown(conn, req_wrap);
+  });
+  return 0;
+}
+
+void IOThreadStream::Close(Local<Value> close_callback) {
+  if (IsHandleClosing())
+    return;
+  {
+    Mutex::ScopedLock lock(conn_->mutex);
+    conn_->owner = nullptr;
+  }
+  Post(CloseSocket);
+  HandleWrap::Close(close_callback);
+}
+
+void IOThreadStream::OnClose() {
+  backlog_.clear();
+  CancelPending(UV_ECANCELED);
+}
+
+void IOThreadStream::CancelPending(int status) {
+  std::vector<PendingWrite> writes;
+  writes.swap(pending_writes_);
+  std::vector<PendingShutdown> shutdowns;
+  shutdowns.swap(pending_shutdowns_);
+  write_queue_size_ = 0;
+  for (const PendingWrite& write : writes)
+    write.wrap->Done(status);
+  for (const PendingShutdown& shutdown : shutdowns)
+    shutdown.wrap->Done(status);
+}
+
+void IOThreadStream::SetNoDelay(const FunctionCallbackInfo<Value>& args) {
+  IOThreadStream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+  const bool enable = args[0]->IsTrue();
+  stream->Post([enable](Connection* conn) {
+    if (conn->open && !conn->closing)
+      uv_tcp_nodelay(&conn->tcp, enable);
+  });
+  args.GetReturnValue().Set(0);
+}
+
+void IOThreadStream::SetKeepAlive(const FunctionCallbackInfo<Value>& args) {
+  IOThreadStream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream, args.Holder());
+  const bool enable = args[0]->IsTrue();
+  const unsigned int delay = args[1].As<Uint32>()->Value();
+  stream->Post([enable, delay](Connection* conn) {
+    if (conn->open && !conn->closing)
+      uv_tcp_keepalive(&conn->tcp, enable, delay);
+  });
+  args.GetReturnValue().Set(0);
+}
+
+void IOThreadStream::GetWriteQueueSize(
+    const FunctionCallbackInfo<Value>& info) {
+  IOThreadStream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream, info.This());
+  info.GetReturnValue().Set(static_cast<double>(stream->write_queue_size_));
+}
+
+#ifndef _WIN32
+namespace {
+// The addresses are looked up on this thread, the file descriptor stays
+// valid until the stream is closed.
+template <int (*F)(int, sockaddr*, socklen_t*)>
+int GetSocketAddress(Environment* env, int fd, Local<Value> target) {
+  CHECK(target->IsObject());
+  sockaddr_storage storage;
+  socklen_t addrlen = sizeof(storage);
+  sockaddr* const addr = reinterpret_cast<sockaddr*>(&storage);
+  if (F(fd, addr, &addrlen) != 0)
+    return uv_translate_sys_error(errno);
+  AddressToJS(env, addr, target.As<Object>());
+  return 0;
+}
+}  // anonymous namespace
+#endif
+
+void IOThreadStream::GetSockName(const FunctionCallbackInfo<Value>& args) {
+  IOThreadStream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+#ifdef _WIN32
+  args.GetReturnValue().Set(UV_ENOTSUP);
+#else
+  args.GetReturnValue().Set(
+      GetSocketAddress<getsockname>(stream->env(), stream->fd_, args[0]));
+#endif
+}
+
+void IOThreadStream::GetPeerName(const FunctionCallbackInfo<Value>& args) {
+  IOThreadStream* stream;
+  ASSIGN_OR_RETURN_UNWRAP(&stream,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+#ifdef _WIN32
+  args.GetReturnValue().Set(UV_ENOTSUP);
+#else
+  args.GetReturnValue().Set(
+      GetSocketAddress<getpeername>(stream->env(), stream->fd_, args[0]));
+#endif
+}
+
+void IOThreadStream::MemoryInfo(MemoryTracker* tracker) const {
+  size_t backlog = 0;
+  for (const Event& event : backlog_)
+    backlog += event.capacity;
+  tracker->TrackFieldWithSize("backlog", backlog);
+}
+
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(io_thread_stream,
+                                   node::IOThreadStream::Initialize)
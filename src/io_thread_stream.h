@@ -0,0 +1,172 @@
+#ifndef SRC_IO_THREAD_STREAM_H_
+#define SRC_IO_THREAD_STREAM_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "handle_wrap.h"
+#include "node_mutex.h"
+#include "stream_base.h"
+#include "uv.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace node {
+
+// A thread with an event loop of its own, on which the system calls of the
+// sockets of an Environment that are moved to it are made. It is started the
+// first time a socket is moved to it, and stopped when the Environment is
+// torn down, after all of the sockets have been closed.
+class IOThread {
+ public:
+  IOThread();
+  ~IOThread();
+
+  IOThread(const IOThread&) = delete;
+  IOThread& operator=(const IOThread&) = delete;
+
+  // Runs `task` on the I/O thread, in the order in which tasks are posted.
+  void Post(std::function<void(uv_loop_t*)> task);
+
+ private:
+  static void Run(void* arg);
+  static void RunTasks(uv_async_t* async);
+
+  uv_thread_t thread_;
+  uv_loop_t loop_;
+  uv_async_t tasks_async_;
+
+  Mutex mutex_;
+  std::deque<std::function<void(uv_loop_t*)>> tasks_;
+};
+
+// A TCP connection whose reads and writes are done on the IOThread. Data that
+// is read is handed to this thread in batches, through an async handle, and
+// emitted to the stream listener from there, so that listeners such as
+// TLSWrap or the HTTP parser work on it like on a TCPWrap.
+class IOThreadStream : public HandleWrap, public StreamBase {
+ public:
+  static void Initialize(v8::Local<v8::Object> target,
+                         v8::Local<v8::Value> unused,
+                         v8::Local<v8::Context> context,
+                         void* priv);
+
+  // While this many bytes that were read are waiting to be emitted, the I/O
+  // thread stops reading from the socket.
+  static constexpr size_t kMaxPendingBytes = 1024 * 1024;
+  static constexpr size_t kReadBufferSize = 64 * 1024;
+
+  bool IsAlive() override;
+  bool IsClosing() override;
+  int GetFD() override;
+  int ReadStart() override;
+  int ReadStop() override;
+
+  int DoShutdown(ShutdownWrap* req_wrap) override;
+  int DoWrite(WriteWrap* w,
+              uv_buf_t* bufs,
+              size_t count,
+              uv_stream_t* send_handle) override;
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(IOThreadStream)
+  SET_SELF_SIZE(IOThreadStream)
+
+ protected:
+  AsyncWrap* GetAsyncWrap() override;
+  void OnClose() override;
+
+ private:
+  struct Event {
+    enum Type { kRead, kWriteDone, kShutdownDone };
+    Type type;
+    // The number of bytes read or an error code for kRead, the status of the
+    // request otherwise.
+    ssize_t status;
+    std::unique_ptr<char[]> data;
+    size_t capacity = 0;
+    void* req = nullptr;
+  };
+
+  // The part of the stream that the I/O thread uses. It outlives the
+  // IOThreadStream until the socket is closed on the I/O thread.
+  struct Connection {
+    // Only used on the I/O thread.
+    uv_tcp_t tcp;
+    bool open = false;
+    bool reading = false;
+    bool closing = false;
+    std::unique_ptr<char[]> read_buffer;
+    // Keeps the connection alive while the socket is open.
+    std::shared_ptr<Connection> self;
+
+    // Shared with the thread of the Environment.
+    Mutex mutex;
+    IOThreadStream* owner;
+    std::vector<Event> events;
+    size_t pending_bytes = 0;
+    bool throttled = false;
+
+    // Called on the I/O thread to hand events to the thread of the
+    // Environment. Data is appended to the last event if it fits there.
+    // Return false if the stream is closed.
+    bool Deliver(Event&& event);
+    bool DeliverData(const char* data, size_t len);
+  };
+
+  IOThreadStream(Environment* env, v8::Local<v8::Object> object, int fd);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetNoDelay(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetKeepAlive(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetWriteQueueSize(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetSockName(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetPeerName(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Runs on the I/O thread.
+  static void Open(std::shared_ptr<Connection> conn, uv_loop_t* loop, int fd);
+  static void StartReading(Connection* conn);
+  static void Write(Connection* conn, WriteWrap* w, std::vector<uv_buf_t> bufs);
+  static void Shutdown(Connection* conn, ShutdownWrap* req_wrap);
+  static void CloseSocket(Connection* conn);
+
+  static void OnEvents(uv_async_t* async);
+  void EmitEvents();
+  void CancelPending(int status);
+  void Post(std::function<void(Connection*)> task);
+
+  uv_async_t async_;
+  IOThread* const io_thread_;
+  const int fd_;
+  std::shared_ptr<Connection> conn_;
+
+  bool reading_ = false;
+  // Reads that were handed over while JS did not want to read.
+  std::deque<Event> backlog_;
+  // The requests that the I/O thread has not completed yet. Their objects are
+  // kept alive until then, because nothing else needs to refer to them.
+  struct PendingWrite {
+    WriteWrap* wrap;
+    size_t bytes;
+    BaseObjectPtr<AsyncWrap> keep_alive;
+  };
+  struct PendingShutdown {
+    ShutdownWrap* wrap;
+    BaseObjectPtr<AsyncWrap> keep_alive;
+  };
+  std::vector<PendingWrite> pending_writes_;
+  std::vector<PendingShutdown> pending_shutdowns_;
+  size_t write_queue_size_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_IO_THREAD_STREAM_H_
@@ -556,6 +556,50 @@ NAPI_EXTERN napi_status napi_object_seal(napi_env env,
                                          napi_value object);
 #endif  // NAPI_VERSION >= 8
 
+#ifdef NAPI_EXPERIMENTAL
+NAPI_EXTERN napi_status
+node_api_create_fast_function(napi_env env,
+                              const char* utf8name,
+                              size_t length,
+                              napi_callback cb,
+                              void* data,
+                              const node_api_fast_function* fast_function,
+                              napi_value* result);
+
+NAPI_EXTERN napi_status
+node_api_create_property_key_utf8(napi_env env,
+                                  const char* str,
+                                  size_t length,
+                                  napi_value* result);
+NAPI_EXTERN napi_status
+node_api_create_external_string_latin1(napi_env env,
+                                       char* str,
+                                       size_t length,
+                                       napi_finalize finalize_callback,
+                                       void* finalize_hint,
+                                       napi_value* result,
+                                       bool* copied);
+NAPI_EXTERN napi_status
+node_api_create_external_string_utf16(napi_env env,
+                                      char16_t* str,
+                                      size_t length,
+                                      napi_finalize finalize_callback,
+                                      void* finalize_hint,
+                                      napi_value* result,
+                                      bool* copied);
+NAPI_EXTERN napi_status node_api_get_properties(napi_env env,
+                                                napi_value object,
+                                                size_t count,
+                                                const napi_value* keys,
+                                                napi_value* values);
+NAPI_EXTERN napi_status
+node_api_create_object_with_properties(napi_env env,
+                                       size_t count,
+                                       const napi_value* keys,
+                                       const napi_value* values,
+                                       napi_value* result);
+#endif  // NAPI_EXPERIMENTAL
+
 EXTERN_C_END
 
 #endif  // SRC_JS_NATIVE_API_H_
@@ -4,6 +4,7 @@
 // This file needs to be compatible with C compilers.
 // This is a public include file, and these includes have essentially
 // became part of it's API.
+#include <stdbool.h>  // NOLINT(modernize-deprecated-headers)
 #include <stddef.h>  // NOLINT(modernize-deprecated-headers)
 #include <stdint.h>  // NOLINT(modernize-deprecated-headers)
 
@@ -157,4 +158,40 @@ typedef struct {
 } napi_type_tag;
 #endif  // NAPI_VERSION >= 8
 
+#ifdef NAPI_EXPERIMENTAL
+typedef enum {
+  node_api_fast_void,
+  node_api_fast_bool,
+  node_api_fast_int32,
+  node_api_fast_uint32,
+  node_api_fast_int64,
+  node_api_fast_uint64,
+  node_api_fast_float32,
+  node_api_fast_float64
+} node_api_fast_type;
+
+// The first argument of a fast function. It refers to the receiver of the
+// call, which can not be used from the fast function.
+typedef struct {
+  uintptr_t address;
+} node_api_fast_receiver;
+
+// The last argument of a fast function. Setting `fallback` to true makes the
+// engine call the slow callback with the same arguments once the fast
+// function returns, e.g. to throw an exception.
+typedef struct {
+  bool fallback;
+} node_api_fast_options;
+
+// Describes the C function
+// `return_type function(node_api_fast_receiver receiver, ...arguments,
+//                       node_api_fast_options* options)`.
+typedef struct {
+  const void* function;
+  node_api_fast_type return_type;
+  size_t argument_count;
+  const node_api_fast_type* argument_types;
+} node_api_fast_function;
+#endif  // NAPI_EXPERIMENTAL
+
 #endif  // SRC_JS_NATIVE_API_TYPES_H_
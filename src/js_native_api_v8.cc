@@ -534,6 +534,31 @@ class FunctionCallbackWrapper
     return napi_clear_last_error(env);
   }
 
+  static inline napi_status NewFastFunction(napi_env env,
+                                            napi_callback cb,
+                                            void* cb_data,
+                                            const v8::CFunction* c_function,
+                                            v8::Local<v8::Function>* result) {
+    v8::Local<v8::Value> cbdata = v8impl::CallbackBundle::New(env, cb, cb_data);
+    RETURN_STATUS_IF_FALSE(env, !cbdata.IsEmpty(), napi_generic_failure);
+
+    v8::Local<v8::FunctionTemplate> tpl =
+        v8::FunctionTemplate::New(env->isolate,
+                                  Invoke,
+                                  cbdata,
+                                  v8::Local<v8::Signature>(),
+                                  0,
+                                  v8::ConstructorBehavior::kThrow,
+                                  v8::SideEffectType::kHasSideEffect,
+                                  c_function);
+    v8::MaybeLocal<v8::Function> maybe_function =
+        tpl->GetFunction(env->context());
+    CHECK_MAYBE_EMPTY(env, maybe_function, napi_generic_failure);
+
+    *result = maybe_function.ToLocalChecked();
+    return napi_clear_last_error(env);
+  }
+
   static inline napi_status NewTemplate(napi_env env,
                     napi_callback cb,
                     void* cb_data,
@@ -639,6 +664,124 @@ inline napi_status Wrap(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+// The resource of a string created by node_api_create_external_string_*().
+// V8 disposes of it when the string is collected, or when the isolate is torn
+// down. The finalizer is run at whichever of that and the teardown of the
+// napi_env comes first, so it is linked into the finalizing_reflist.
+template <typename ResourceType, typename CharType>
+class ExternalStringResource : public ResourceType,
+                               private Finalizer,
+                               RefTracker {
+ public:
+  ExternalStringResource(napi_env env,
+                         const CharType* data,
+                         size_t length,
+                         napi_finalize finalize_callback,
+                         void* finalize_hint)
+      : Finalizer(env,
+                  finalize_callback,
+                  const_cast<CharType*>(data),
+                  finalize_hint),
+        _data(data),
+        _length(length) {
+    if (finalize_callback != nullptr)
+      Link(&env->finalizing_reflist);
+  }
+
+  using Char = CharType;
+
+  ~ExternalStringResource() override { Unlink(); }
+
+  const CharType* data() const override { return _data; }
+  size_t length() const override { return _length; }
+
+  // Deletes the resource without running the finalizer, when V8 did not take
+  // it over.
+  void Release() {
+    _finalize_callback = nullptr;
+    delete this;
+  }
+
+  void Dispose() override {
+    Finalize(false);
+    delete this;
+  }
+
+  void Finalize(bool is_env_teardown) override {
+    Unlink();
+    if (_finalize_callback == nullptr)
+      return;
+    napi_finalize finalize_callback = _finalize_callback;
+    _finalize_callback = nullptr;
+    _env->CallFinalizer(finalize_callback, _finalize_data, _finalize_hint);
+  }
+
+ private:
+  const CharType* _data;
+  size_t _length;
+};
+
+using ExternalOneByteStringResource =
+    ExternalStringResource<v8::String::ExternalOneByteStringResource, char>;
+using ExternalTwoByteStringResource =
+    ExternalStringResource<v8::String::ExternalStringResource, uint16_t>;
+
+inline v8::MaybeLocal<v8::String> NewExternal(
+    v8::Isolate* isolate, ExternalOneByteStringResource* resource) {
+  return v8::String::NewExternalOneByte(isolate, resource);
+}
+
+inline v8::MaybeLocal<v8::String> NewExternal(
+    v8::Isolate* isolate, ExternalTwoByteStringResource* resource) {
+  return v8::String::NewExternalTwoByte(isolate, resource);
+}
+
+template <typename Resource, typename CharType>
+inline napi_status NewExternalString(
+    napi_env env,
+    CharType* str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void* finalize_hint,
+    napi_value* result,
+    bool* copied) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      (length == NAPI_AUTO_LENGTH) || length <= INT_MAX,
+      napi_invalid_arg);
+  RETURN_STATUS_IF_FALSE(env, str != nullptr || length == 0, napi_invalid_arg);
+
+  if (length == NAPI_AUTO_LENGTH)
+    length = std::char_traits<CharType>::length(str);
+
+  if (copied != nullptr)
+    *copied = false;
+
+  if (length == 0) {
+    // V8 does not create empty external strings, there is nothing to keep.
+    *result = v8impl::JsValueFromV8LocalValue(v8::String::Empty(env->isolate));
+    if (copied != nullptr)
+      *copied = true;
+    if (finalize_callback != nullptr)
+      env->CallFinalizer(finalize_callback, str, finalize_hint);
+    return napi_clear_last_error(env);
+  }
+
+  Resource* resource = new Resource(
+      env, reinterpret_cast<const typename Resource::Char*>(str), length,
+      finalize_callback, finalize_hint);
+  v8::Local<v8::String> string;
+  if (!NewExternal(env->isolate, resource).ToLocal(&string)) {
+    // The string is too long. The caller keeps the ownership of the data.
+    resource->Release();
+    return napi_set_last_error(env, napi_invalid_arg);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(string);
+  return napi_clear_last_error(env);
+}
+
 }  // end of anonymous namespace
 
 }  // end of namespace v8impl
@@ -722,6 +865,85 @@ napi_status napi_create_function(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+static bool ToFastCType(node_api_fast_type type,
+                        v8::CTypeInfo::Type* result) {
+  switch (type) {
+    case node_api_fast_void: *result = v8::CTypeInfo::Type::kVoid; break;
+    case node_api_fast_bool: *result = v8::CTypeInfo::Type::kBool; break;
+    case node_api_fast_int32: *result = v8::CTypeInfo::Type::kInt32; break;
+    case node_api_fast_uint32: *result = v8::CTypeInfo::Type::kUint32; break;
+    case node_api_fast_int64: *result = v8::CTypeInfo::Type::kInt64; break;
+    case node_api_fast_uint64: *result = v8::CTypeInfo::Type::kUint64; break;
+    case node_api_fast_float32:
+      *result = v8::CTypeInfo::Type::kFloat32;
+      break;
+    case node_api_fast_float64:
+      *result = v8::CTypeInfo::Type::kFloat64;
+      break;
+    default: return false;
+  }
+  return true;
+}
+
+napi_status node_api_create_fast_function(
+    napi_env env,
+    const char* utf8name,
+    size_t length,
+    napi_callback cb,
+    void* callback_data,
+    const node_api_fast_function* fast_function,
+    napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, result);
+  CHECK_ARG(env, cb);
+  CHECK_ARG(env, fast_function);
+  CHECK_ARG(env, fast_function->function);
+  RETURN_STATUS_IF_FALSE(env,
+      fast_function->argument_count == 0 ||
+          fast_function->argument_types != nullptr,
+      napi_invalid_arg);
+
+  // The optimizing compiler passes the receiver as the first argument.
+  std::vector<v8::CTypeInfo> argument_info;
+  argument_info.reserve(fast_function->argument_count + 1);
+  argument_info.push_back(
+      v8::CTypeInfo::FromCType(v8::CTypeInfo::Type::kV8Value));
+  v8::CTypeInfo::Type ctype;
+  for (size_t i = 0; i < fast_function->argument_count; i++) {
+    node_api_fast_type type = fast_function->argument_types[i];
+    RETURN_STATUS_IF_FALSE(env,
+        type != node_api_fast_void && ToFastCType(type, &ctype),
+        napi_invalid_arg);
+    argument_info.push_back(v8::CTypeInfo::FromCType(ctype));
+  }
+  RETURN_STATUS_IF_FALSE(env,
+      ToFastCType(fast_function->return_type, &ctype),
+      napi_invalid_arg);
+
+  env->fast_function_infos.push_back(
+      std::make_unique<v8impl::FastFunctionInfo>(
+          v8::CTypeInfo::FromCType(ctype), std::move(argument_info)));
+  v8::CFunction c_function = v8::CFunction::Make(
+      fast_function->function, env->fast_function_infos.back().get());
+
+  v8::Local<v8::Function> return_value;
+  v8::EscapableHandleScope scope(env->isolate);
+  v8::Local<v8::Function> fn;
+  STATUS_CALL(v8impl::FunctionCallbackWrapper::NewFastFunction(
+      env, cb, callback_data, &c_function, &fn));
+  return_value = scope.Escape(fn);
+
+  if (utf8name != nullptr) {
+    v8::Local<v8::String> name_string;
+    CHECK_NEW_FROM_UTF8_LEN(env, name_string, utf8name, length);
+    return_value->SetName(name_string);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(return_value);
+
+  return GET_RETURN_STATUS(env);
+}
+
 napi_status napi_define_class(napi_env env,
                               const char* utf8name,
                               size_t length,
@@ -982,6 +1204,35 @@ napi_status napi_get_property(napi_env env,
   return GET_RETURN_STATUS(env);
 }
 
+napi_status node_api_get_properties(napi_env env,
+                                   napi_value object,
+                                   size_t count,
+                                   const napi_value* keys,
+                                   napi_value* values) {
+  NAPI_PREAMBLE(env);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+  }
+
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Object> obj;
+
+  CHECK_TO_OBJECT(env, context, obj, object);
+
+  for (size_t i = 0; i < count; i++) {
+    CHECK_ARG(env, keys[i]);
+    auto get_maybe =
+        obj->Get(context, v8impl::V8LocalValueFromJsValue(keys[i]));
+
+    CHECK_MAYBE_EMPTY(env, get_maybe, napi_generic_failure);
+
+    values[i] = v8impl::JsValueFromV8LocalValue(get_maybe.ToLocalChecked());
+  }
+
+  return GET_RETURN_STATUS(env);
+}
+
 napi_status napi_delete_property(napi_env env,
                                  napi_value object,
                                  napi_value key,
@@ -1359,6 +1610,42 @@ napi_status napi_create_object(napi_env env, napi_value* result) {
   return napi_clear_last_error(env);
 }
 
+napi_status node_api_create_object_with_properties(napi_env env,
+                                                 size_t count,
+                                                 const napi_value* keys,
+                                                 const napi_value* values,
+                                                 napi_value* result) {
+  NAPI_PREAMBLE(env);
+  CHECK_ARG(env, result);
+  if (count > 0) {
+    CHECK_ARG(env, keys);
+    CHECK_ARG(env, values);
+  }
+
+  v8::Local<v8::Context> context = env->context();
+  // v8::Object::New() can take the properties as well, but creates the object
+  // in dictionary mode, which makes the accesses to it from JavaScript slow.
+  // Adding the properties one by one instead lets objects that are created
+  // with the same keys share their hidden class.
+  v8::Local<v8::Object> obj = v8::Object::New(env->isolate);
+
+  for (size_t i = 0; i < count; i++) {
+    CHECK_ARG(env, keys[i]);
+    CHECK_ARG(env, values[i]);
+    v8::Local<v8::Value> k = v8impl::V8LocalValueFromJsValue(keys[i]);
+    RETURN_STATUS_IF_FALSE(env, k->IsName(), napi_name_expected);
+
+    auto set_maybe = obj->CreateDataProperty(
+        context, k.As<v8::Name>(), v8impl::V8LocalValueFromJsValue(values[i]));
+
+    RETURN_STATUS_IF_FALSE(env, set_maybe.FromMaybe(false),
+                           napi_generic_failure);
+  }
+
+  *result = v8impl::JsValueFromV8LocalValue(obj);
+  return GET_RETURN_STATUS(env);
+}
+
 napi_status napi_create_array(napi_env env, napi_value* result) {
   CHECK_ENV(env);
   CHECK_ARG(env, result);
@@ -1424,6 +1711,28 @@ napi_status napi_create_string_utf8(napi_env env,
   return napi_clear_last_error(env);
 }
 
+napi_status node_api_create_property_key_utf8(napi_env env,
+                                             const char* str,
+                                             size_t length,
+                                             napi_value* result) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, result);
+  RETURN_STATUS_IF_FALSE(env,
+      (length == NAPI_AUTO_LENGTH) || length <= INT_MAX,
+      napi_invalid_arg);
+
+  // Internalized strings are compared by identity when they are looked up as
+  // property keys, instead of having to be hashed and compared first.
+  auto str_maybe =
+      v8::String::NewFromUtf8(env->isolate,
+                              str,
+                              v8::NewStringType::kInternalized,
+                              static_cast<int>(length));
+  CHECK_MAYBE_EMPTY(env, str_maybe, napi_generic_failure);
+  *result = v8impl::JsValueFromV8LocalValue(str_maybe.ToLocalChecked());
+  return napi_clear_last_error(env);
+}
+
 napi_status napi_create_string_utf16(napi_env env,
                                      const char16_t* str,
                                      size_t length,
@@ -1446,6 +1755,30 @@ napi_status napi_create_string_utf16(napi_env env,
   return napi_clear_last_error(env);
 }
 
+napi_status node_api_create_external_string_latin1(
+    napi_env env,
+    char* str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void* finalize_hint,
+    napi_value* result,
+    bool* copied) {
+  return v8impl::NewExternalString<v8impl::ExternalOneByteStringResource>(
+      env, str, length, finalize_callback, finalize_hint, result, copied);
+}
+
+napi_status node_api_create_external_string_utf16(
+    napi_env env,
+    char16_t* str,
+    size_t length,
+    napi_finalize finalize_callback,
+    void* finalize_hint,
+    napi_value* result,
+    bool* copied) {
+  return v8impl::NewExternalString<v8impl::ExternalTwoByteStringResource>(
+      env, str, length, finalize_callback, finalize_hint, result, copied);
+}
+
 napi_status napi_create_double(napi_env env,
                                double value,
                                napi_value* result) {
@@ -2378,7 +2711,10 @@ napi_status napi_create_reference(napi_env env,
 
   v8::Local<v8::Value> v8_value = v8impl::V8LocalValueFromJsValue(value);
 
-  if (!(v8_value->IsObject() || v8_value->IsFunction())) {
+  // Strings and symbols can be referenced as well, so that property keys can
+  // be created once and then be used across calls.
+  if (!(v8_value->IsObject() || v8_value->IsFunction() ||
+        v8_value->IsName())) {
     return napi_set_last_error(env, napi_object_expected);
   }
 
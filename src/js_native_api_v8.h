@@ -5,6 +5,10 @@
 #include <string.h>  // NOLINT(modernize-deprecated-headers)
 #include "js_native_api_types.h"
 #include "js_native_api_v8_internals.h"
+#include "v8-fast-api-calls.h"
+
+#include <memory>
+#include <vector>
 
 static napi_status napi_clear_last_error(napi_env env);
 
@@ -49,6 +53,31 @@ class RefTracker {
   RefList* prev_ = nullptr;
 };
 
+// The signature of a function that is created with
+// node_api_create_fast_function(). V8 refers to it for as long as the
+// function exists, so it is owned by the napi_env.
+class FastFunctionInfo : public v8::CFunctionInfo {
+ public:
+  FastFunctionInfo(v8::CTypeInfo return_info,
+                   std::vector<v8::CTypeInfo>&& argument_info)
+      : return_info_(return_info), argument_info_(std::move(argument_info)) {}
+
+  const v8::CTypeInfo& ReturnInfo() const override { return return_info_; }
+  unsigned int ArgumentCount() const override {
+    return static_cast<unsigned int>(argument_info_.size());
+  }
+  const v8::CTypeInfo& ArgumentInfo(unsigned int index) const override {
+    if (index >= argument_info_.size())
+      return v8::CTypeInfo::Invalid();
+    return argument_info_[index];
+  }
+
+ private:
+  const v8::CTypeInfo return_info_;
+  // The receiver, followed by the arguments.
+  const std::vector<v8::CTypeInfo> argument_info_;
+};
+
 }  // end of namespace v8impl
 
 struct napi_env__ {
@@ -120,6 +149,7 @@ struct napi_env__ {
   int open_callback_scopes = 0;
   int refs = 1;
   void* instance_data = nullptr;
+  std::vector<std::unique_ptr<v8impl::FastFunctionInfo>> fast_function_infos;
 };
 
 static inline napi_status napi_clear_last_error(napi_env env) {
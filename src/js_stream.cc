@@ -7,11 +7,14 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
+
 namespace node {
 
 using errors::TryCatchScope;
 
 using v8::Array;
+using v8::ArrayBufferView;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -115,15 +118,26 @@ int JSStream::DoWrite(WriteWrap* w,
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
 
-  MaybeStackBuffer<Local<Value>, 16> bufs_arr(count);
-  for (size_t i = 0; i < count; i++) {
-    bufs_arr[i] =
-        Buffer::Copy(env(), bufs[i].base, bufs[i].len).ToLocalChecked();
+  // The buffers are coalesced into one, so that the JS stream is only
+  // written to, and only calls back, once per write.
+  Local<Value> buf;
+  if (count == 1) {
+    buf = Buffer::Copy(env(), bufs[0].base, bufs[0].len).ToLocalChecked();
+  } else {
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++)
+      length += bufs[i].len;
+    buf = Buffer::New(env(), length).ToLocalChecked();
+    char* data = Buffer::Data(buf);
+    for (size_t i = 0; i < count; i++) {
+      memcpy(data, bufs[i].base, bufs[i].len);
+      data += bufs[i].len;
+    }
   }
 
   Local<Value> argv[] = {
     w->object(),
-    Array::New(env()->isolate(), bufs_arr.out(), count)
+    Array::New(env()->isolate(), &buf, 1)
   };
 
   TryCatchScope try_catch(env());
@@ -184,6 +198,51 @@ void JSStream::ReadBuffer(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// readBuffers(chunks)
+// Like readBuffer(), for the chunks that the JS stream emitted at once. They
+// are copied into as few buffers as the stream's owner allows, so that it
+// processes them in one go.
+void JSStream::ReadBuffers(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  JSStream* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK(args[0]->IsArray());
+  Local<Array> chunks = args[0].As<Array>();
+  MaybeStackBuffer<Local<Value>, 16> views(chunks->Length());
+  size_t remaining = 0;
+  for (uint32_t i = 0; i < chunks->Length(); i++) {
+    if (!chunks->Get(env->context(), i).ToLocal(&views[i])) return;
+    CHECK(views[i]->IsArrayBufferView());
+    remaining += views[i].As<ArrayBufferView>()->ByteLength();
+  }
+
+  uv_buf_t buf = uv_buf_init(nullptr, 0);
+  size_t used = 0;
+  for (size_t i = 0; i < views.length(); i++) {
+    ArrayBufferViewContents<char> buffer(views[i]);
+    const char* data = buffer.data();
+    size_t len = buffer.length();
+    while (len != 0) {
+      if (used == buf.len) {
+        if (used != 0)
+          wrap->EmitRead(used, buf);
+        buf = wrap->EmitAlloc(remaining);
+        used = 0;
+      }
+      size_t avail = std::min(len, buf.len - used);
+      memcpy(buf.base + used, data, avail);
+      data += avail;
+      len -= avail;
+      used += avail;
+      remaining -= avail;
+    }
+  }
+  if (used != 0)
+    wrap->EmitRead(used, buf);
+}
+
+
 void JSStream::EmitEOF(const FunctionCallbackInfo<Value>& args) {
   JSStream* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -206,6 +265,7 @@ void JSStream::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "finishWrite", Finish<WriteWrap>);
   env->SetProtoMethod(t, "finishShutdown", Finish<ShutdownWrap>);
   env->SetProtoMethod(t, "readBuffer", ReadBuffer);
+  env->SetProtoMethod(t, "readBuffers", ReadBuffers);
   env->SetProtoMethod(t, "emitEOF", EmitEOF);
 
   StreamBase::AddMethods(env, t);
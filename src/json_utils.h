@@ -19,6 +19,12 @@ class JSONWriter {
   JSONWriter(std::ostream& out, bool compact)
     : out_(out), compact_(compact) {}
 
+  // Creates a writer for members of an object that is `depth` levels deep
+  // and already has other members. What it writes can be inserted into that
+  // object with json_fragment().
+  JSONWriter(std::ostream& out, bool compact, int depth)
+    : out_(out), compact_(compact), indent_(depth * 2), state_(kAfterValue) {}
+
  private:
   inline void indent() { indent_ += 2; }
   inline void deindent() { indent_ -= 2; }
@@ -117,6 +123,11 @@ class JSONWriter {
     state_ = kAfterValue;
   }
 
+  inline void json_fragment(const std::string& fragment) {
+    out_ << fragment;
+    state_ = kAfterValue;
+  }
+
   struct Null {};  // Usable as a JSON value.
 
   struct ForeignJSON {
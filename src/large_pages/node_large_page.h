@@ -25,9 +25,43 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <cstddef>
+
+namespace v8 {
+class PageAllocator;
+}  // namespace v8
+
 namespace node {
 int MapStaticCodeToLargePages();
 const char* LargePagesError(int status);
+
+constexpr size_t kLargePageSize = 2 * 1024 * 1024;
+
+// Makes GetLargePageAllocator() return a page allocator that backs the V8
+// heap with transparent huge pages. Returns 0 on success, or an error that
+// can be passed to LargePagesError().
+int UseLargePagesForHeap();
+// Returns nullptr unless UseLargePagesForHeap() succeeded.
+v8::PageAllocator* GetLargePageAllocator();
+
+// Advise the huge pages within an ArrayBuffer's backing store of at least
+// kLargePageSize bytes, and forget about them once it is freed. They do
+// nothing unless UseLargePagesForHeap() succeeded.
+void AdviseLargePages(void* data, size_t size);
+void ForgetLargePages(void* data, size_t size);
+
+struct LargePagesStatistics {
+  // The size of the memory that V8 reserved with the advice.
+  size_t heap;
+  // The size of the advised huge pages within the ArrayBuffers.
+  size_t array_buffers;
+  // The size of the memory of the process that is actually backed by
+  // transparent huge pages.
+  size_t anonymous_huge_pages;
+};
+
+// Returns false unless UseLargePagesForHeap() succeeded.
+bool GetLargePagesStatistics(LargePagesStatistics* statistics);
 }  // namespace node
 
 #endif  // NODE_WANT_INTERNALS
@@ -0,0 +1,308 @@
+// The page allocator in this file backs the V8 heap with transparent huge
+// pages on Linux. V8 asks its platform for the allocator of the memory that
+// it reserves for the heap, the code space and the WebAssembly memories.
+// Every one of these mappings is advised with MADV_HUGEPAGE, so that the
+// kernel backs the 2MB-aligned ranges that are touched with huge pages, and
+// khugepaged collapses the rest of them over time.
+//
+// V8 allocates its heap in chunks that are smaller than a huge page. The
+// allocator places them next to each other, instead of at the random
+// addresses that V8 suggests, so that their mappings merge and share the huge
+// pages. The ArrayBuffers that are large enough to contain a whole huge page
+// are advised the same way by the ArrayBuffer allocator.
+
+#include "node_large_page.h"
+
+#include <cerrno>
+
+#if defined(__linux__)
+#include "node_mutex.h"
+#include "util.h"
+#include "v8-platform.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <string>
+#endif  // defined(__linux__)
+
+namespace node {
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+namespace {
+
+inline uintptr_t AlignUp(uintptr_t address, size_t alignment) {
+  return (address + alignment - 1) & ~(alignment - 1);
+}
+
+inline uintptr_t AlignDown(uintptr_t address, size_t alignment) {
+  return address & ~(alignment - 1);
+}
+
+int GetProtection(v8::PageAllocator::Permission permission) {
+  switch (permission) {
+    case v8::PageAllocator::kNoAccess:
+    case v8::PageAllocator::kNoAccessWillJitLater:
+      return PROT_NONE;
+    case v8::PageAllocator::kRead:
+      return PROT_READ;
+    case v8::PageAllocator::kReadWrite:
+      return PROT_READ | PROT_WRITE;
+    case v8::PageAllocator::kReadWriteExecute:
+      return PROT_READ | PROT_WRITE | PROT_EXEC;
+    case v8::PageAllocator::kReadExecute:
+      return PROT_READ | PROT_EXEC;
+  }
+  UNREACHABLE();
+}
+
+class LargePageAllocator final : public v8::PageAllocator {
+ public:
+  size_t AllocatePageSize() override { return page_size_; }
+  size_t CommitPageSize() override { return page_size_; }
+  void SetRandomMmapSeed(int64_t seed) override {}
+  void* GetRandomMmapAddr() override { return nullptr; }
+
+  void* AllocatePages(void* address,
+                      size_t length,
+                      size_t alignment,
+                      Permission permission) override;
+  bool FreePages(void* address, size_t length) override;
+  bool ReleasePages(void* address, size_t length, size_t new_length) override;
+  bool SetPermissions(void* address,
+                      size_t length,
+                      Permission permission) override;
+  bool DiscardSystemPages(void* address, size_t size) override;
+
+  size_t reserved() const { return reserved_.load(std::memory_order_relaxed); }
+
+ private:
+  void* Map(void* hint, size_t length, Permission permission);
+
+  const size_t page_size_ = sysconf(_SC_PAGESIZE);
+  Mutex mutex_;
+  // The next mapping goes right below this address, where the previous one
+  // starts, since the kernel places the mappings from the top down.
+  uintptr_t next_address_ = 0;
+  std::atomic<size_t> reserved_ {0};
+};
+
+void* LargePageAllocator::Map(void* hint,
+                              size_t length,
+                              Permission permission) {
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  if (permission == kNoAccess || permission == kNoAccessWillJitLater)
+    flags |= MAP_NORESERVE;
+  void* result = mmap(hint, length, GetProtection(permission), flags, -1, 0);
+  return result == MAP_FAILED ? nullptr : result;
+}
+
+// The address that V8 suggests is ignored in favor of next_address_, since
+// only adjacent mappings can share huge pages.
+void* LargePageAllocator::AllocatePages(void* address,
+                                        size_t length,
+                                        size_t alignment,
+                                        Permission permission) {
+  alignment = std::max(alignment, page_size_);
+  if (length >= kLargePageSize)
+    alignment = std::max(alignment, kLargePageSize);
+
+  uintptr_t hint = 0;
+  {
+    Mutex::ScopedLock lock(mutex_);
+    if (next_address_ > length)
+      hint = AlignDown(next_address_ - length, alignment);
+  }
+  char* result = nullptr;
+  if (hint != 0) {
+    result = static_cast<char*>(
+        Map(reinterpret_cast<void*>(hint), length, permission));
+    if (result != nullptr &&
+        reinterpret_cast<uintptr_t>(result) % alignment != 0) {
+      CHECK_EQ(munmap(result, length), 0);
+      result = nullptr;
+    }
+  }
+  if (result == nullptr) {
+    // Map enough memory for an aligned range of the length, and unmap the
+    // rest of it.
+    size_t request = length + alignment - page_size_;
+    char* base = static_cast<char*>(Map(nullptr, request, permission));
+    if (base == nullptr)
+      return nullptr;
+    result = reinterpret_cast<char*>(
+        AlignUp(reinterpret_cast<uintptr_t>(base), alignment));
+    if (result != base)
+      CHECK_EQ(munmap(base, result - base), 0);
+    size_t suffix = (base + request) - (result + length);
+    if (suffix != 0)
+      CHECK_EQ(munmap(result + length, suffix), 0);
+  }
+
+  {
+    Mutex::ScopedLock lock(mutex_);
+    next_address_ = reinterpret_cast<uintptr_t>(result);
+  }
+  // This is advisory, the mapping is usable either way.
+  USE(madvise(result, length, MADV_HUGEPAGE));
+  reserved_.fetch_add(length, std::memory_order_relaxed);
+  return result;
+}
+
+bool LargePageAllocator::FreePages(void* address, size_t length) {
+  if (munmap(address, length) != 0)
+    return false;
+  reserved_.fetch_sub(length, std::memory_order_relaxed);
+  return true;
+}
+
+bool LargePageAllocator::ReleasePages(void* address,
+                                      size_t length,
+                                      size_t new_length) {
+  CHECK_LT(new_length, length);
+  if (munmap(static_cast<char*>(address) + new_length,
+             length - new_length) != 0) {
+    return false;
+  }
+  reserved_.fetch_sub(length - new_length, std::memory_order_relaxed);
+  return true;
+}
+
+bool LargePageAllocator::SetPermissions(void* address,
+                                        size_t length,
+                                        Permission permission) {
+  if (mprotect(address, length, GetProtection(permission)) != 0)
+    return false;
+  if (permission == kNoAccess)
+    USE(DiscardSystemPages(address, length));
+  return true;
+}
+
+bool LargePageAllocator::DiscardSystemPages(void* address, size_t size) {
+  int ret = madvise(address, size, MADV_FREE);
+  // MADV_FREE is only supported since Linux 4.5.
+  if (ret != 0 && errno == EINVAL)
+    ret = madvise(address, size, MADV_DONTNEED);
+  return ret == 0;
+}
+
+LargePageAllocator* heap_page_allocator = nullptr;
+std::atomic<size_t> array_buffer_large_pages {0};
+
+bool IsTransparentHugePagesAvailable() {
+  // The mode that is in use is the one in brackets, e.g. "always [madvise]
+  // never".
+  std::ifstream config("/sys/kernel/mm/transparent_hugepage/enabled");
+  std::string token;
+  while (config >> token) {
+    if (token == "[always]" || token == "[madvise]")
+      return true;
+  }
+  return false;
+}
+
+// Returns the range of whole huge pages within [data, data + size).
+bool GetLargePageRange(void* data, size_t size, char** start, size_t* length) {
+  uintptr_t from = AlignUp(reinterpret_cast<uintptr_t>(data), kLargePageSize);
+  uintptr_t to =
+      AlignDown(reinterpret_cast<uintptr_t>(data) + size, kLargePageSize);
+  if (to <= from)
+    return false;
+  *start = reinterpret_cast<char*>(from);
+  *length = to - from;
+  return true;
+}
+
+}  // anonymous namespace
+
+int UseLargePagesForHeap() {
+  if (heap_page_allocator != nullptr)
+    return 0;
+  if (!IsTransparentHugePagesAvailable())
+    return EACCES;
+
+  // Make sure that the kernel accepts the advice before relying on it.
+  void* probe = mmap(nullptr, kLargePageSize, PROT_NONE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (probe == MAP_FAILED)
+    return errno;
+  int err = madvise(probe, kLargePageSize, MADV_HUGEPAGE) == 0 ? 0 : errno;
+  CHECK_EQ(munmap(probe, kLargePageSize), 0);
+  if (err != 0)
+    return err;
+
+  // The allocator is used by V8 until the process exits.
+  heap_page_allocator = new LargePageAllocator();
+  return 0;
+}
+
+v8::PageAllocator* GetLargePageAllocator() {
+  return heap_page_allocator;
+}
+
+void AdviseLargePages(void* data, size_t size) {
+  char* start;
+  size_t length;
+  if (heap_page_allocator == nullptr ||
+      !GetLargePageRange(data, size, &start, &length) ||
+      madvise(start, length, MADV_HUGEPAGE) != 0) {
+    return;
+  }
+  array_buffer_large_pages.fetch_add(length, std::memory_order_relaxed);
+}
+
+void ForgetLargePages(void* data, size_t size) {
+  char* start;
+  size_t length;
+  // The mapping is gone once it is freed, so there is no need to undo the
+  // advice.
+  if (heap_page_allocator == nullptr ||
+      !GetLargePageRange(data, size, &start, &length)) {
+    return;
+  }
+  array_buffer_large_pages.fetch_sub(length, std::memory_order_relaxed);
+}
+
+bool GetLargePagesStatistics(LargePagesStatistics* statistics) {
+  if (heap_page_allocator == nullptr)
+    return false;
+  statistics->heap = heap_page_allocator->reserved();
+  statistics->array_buffers =
+      array_buffer_large_pages.load(std::memory_order_relaxed);
+  statistics->anonymous_huge_pages = 0;
+
+  // The value is in kB, e.g. "AnonHugePages:     4096 kB".
+  std::ifstream rollup("/proc/self/smaps_rollup");
+  std::string field;
+  while (rollup >> field) {
+    if (field == "AnonHugePages:") {
+      size_t kilobytes;
+      if (rollup >> kilobytes)
+        statistics->anonymous_huge_pages = kilobytes * 1024;
+      break;
+    }
+  }
+  return true;
+}
+#else
+int UseLargePagesForHeap() {
+  return ENOTSUP;
+}
+
+v8::PageAllocator* GetLargePageAllocator() {
+  return nullptr;
+}
+
+void AdviseLargePages(void* data, size_t size) {}
+
+void ForgetLargePages(void* data, size_t size) {}
+
+bool GetLargePagesStatistics(LargePagesStatistics* statistics) {
+  return false;
+}
+#endif  // defined(__linux__) && defined(MADV_HUGEPAGE)
+
+}  // namespace node
@@ -26,8 +26,10 @@ class MemoryRetainerNode : public v8::EmbedderGraph::Node {
       : retainer_(retainer) {
     CHECK_NOT_NULL(retainer_);
     v8::HandleScope handle_scope(tracker->isolate());
-    v8::Local<v8::Object> obj = retainer_->WrappedObject();
-    if (!obj.IsEmpty()) wrapper_node_ = tracker->graph()->V8Node(obj);
+    if (tracker->graph() != nullptr) {
+      v8::Local<v8::Object> obj = retainer_->WrappedObject();
+      if (!obj.IsEmpty()) wrapper_node_ = tracker->graph()->V8Node(obj);
+    }
 
     name_ = retainer_->MemoryInfoName();
     size_ = retainer_->SelfSize();
@@ -101,7 +103,7 @@ void MemoryTracker::TrackField(const char* edge_name,
   if (value == nullptr) return;
   auto it = seen_.find(value);
   if (it != seen_.end()) {
-    graph_->AddEdge(CurrentNode(), it->second, edge_name);
+    AddEdge(CurrentNode(), it->second, edge_name);
   } else {
     Track(value, edge_name);
   }
@@ -222,7 +224,7 @@ template <typename T>
 void MemoryTracker::TrackField(const char* edge_name,
                                const v8::Local<T>& value,
                                const char* node_name) {
-  if (!value.IsEmpty())
+  if (!value.IsEmpty() && graph_ != nullptr)
     graph_->AddEdge(CurrentNode(), graph_->V8Node(value), edge_name);
 }
 
@@ -276,7 +278,7 @@ void MemoryTracker::Track(const MemoryRetainer* retainer,
   auto it = seen_.find(retainer);
   if (it != seen_.end()) {
     if (CurrentNode() != nullptr) {
-      graph_->AddEdge(CurrentNode(), it->second, edge_name);
+      AddEdge(CurrentNode(), it->second, edge_name);
     }
     return;  // It has already been tracked, no need to call MemoryInfo again
   }
@@ -307,9 +309,12 @@ MemoryRetainerNode* MemoryTracker::AddNode(const MemoryRetainer* retainer,
   }
 
   MemoryRetainerNode* n = new MemoryRetainerNode(this, retainer);
-  graph_->AddNode(std::unique_ptr<v8::EmbedderGraph::Node>(n));
+  if (graph_ != nullptr)
+    graph_->AddNode(std::unique_ptr<v8::EmbedderGraph::Node>(n));
+  else
+    nodes_.emplace_back(n);
   seen_[retainer] = n;
-  if (CurrentNode() != nullptr) graph_->AddEdge(CurrentNode(), n, edge_name);
+  if (CurrentNode() != nullptr) AddEdge(CurrentNode(), n, edge_name);
 
   if (n->JSWrapperNode() != nullptr) {
     graph_->AddEdge(n, n->JSWrapperNode(), "wrapped");
@@ -323,9 +328,12 @@ MemoryRetainerNode* MemoryTracker::AddNode(const char* node_name,
                                            size_t size,
                                            const char* edge_name) {
   MemoryRetainerNode* n = new MemoryRetainerNode(this, node_name, size);
-  graph_->AddNode(std::unique_ptr<v8::EmbedderGraph::Node>(n));
+  if (graph_ != nullptr)
+    graph_->AddNode(std::unique_ptr<v8::EmbedderGraph::Node>(n));
+  else
+    nodes_.emplace_back(n);
 
-  if (CurrentNode() != nullptr) graph_->AddEdge(CurrentNode(), n, edge_name);
+  if (CurrentNode() != nullptr) AddEdge(CurrentNode(), n, edge_name);
 
   return n;
 }
@@ -349,6 +357,18 @@ void MemoryTracker::PopNode() {
   node_stack_.pop();
 }
 
+void MemoryTracker::AddEdge(MemoryRetainerNode* from,
+                            v8::EmbedderGraph::Node* to,
+                            const char* edge_name) {
+  if (graph_ != nullptr) graph_->AddEdge(from, to, edge_name);
+}
+
+size_t MemoryTracker::TotalSize() const {
+  size_t size = 0;
+  for (const auto& node : nodes_) size += node->SizeInBytes();
+  return size;
+}
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -8,10 +8,12 @@
 #include <uv.h>
 
 #include <limits>
+#include <memory>
 #include <queue>
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace node {
 
@@ -256,6 +258,17 @@ class MemoryTracker {
                                 v8::EmbedderGraph* graph)
     : isolate_(isolate), graph_(graph) {}
 
+  // A tracker without a graph only adds up the native memory of the retainers
+  // that are passed to Track(), e.g. to find out how much memory a single
+  // connection uses without taking a heap snapshot. References to JS objects
+  // are ignored in that case.
+  inline explicit MemoryTracker(v8::Isolate* isolate)
+    : isolate_(isolate), graph_(nullptr) {}
+
+  // Returns the size of all nodes that were added to a tracker without a
+  // graph so far.
+  inline size_t TotalSize() const;
+
  private:
   typedef std::unordered_map<const MemoryRetainer*, MemoryRetainerNode*>
       NodeMap;
@@ -273,10 +286,16 @@ class MemoryTracker {
                                       const char* edge_name = nullptr);
   inline void PopNode();
 
+  inline void AddEdge(MemoryRetainerNode* from,
+                      v8::EmbedderGraph::Node* to,
+                      const char* edge_name);
+
   v8::Isolate* isolate_;
   v8::EmbedderGraph* graph_;
   std::stack<MemoryRetainerNode*> node_stack_;
   NodeMap seen_;
+  // The nodes of a tracker without a graph.
+  std::vector<std::unique_ptr<v8::EmbedderGraph::Node>> nodes_;
 };
 
 }  // namespace node
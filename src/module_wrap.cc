@@ -1,9 +1,11 @@
 #include "module_wrap.h"
 
+#include "compile_cache.h"
 #include "env.h"
 #include "memory_tracker-inl.h"
 #include "node_contextify.h"
 #include "node_errors.h"
+#include "node_external_reference.h"
 #include "node_internals.h"
 #include "node_process.h"
 #include "node_url.h"
@@ -139,7 +141,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
     // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
     CHECK(args[3]->IsFunction());
   } else {
-    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData)
+    // new ModuleWrap(url, context, source, lineOffset, columOffset, cachedData,
+    //                useCodeCache)
     CHECK(args[2]->IsString());
     CHECK(args[3]->IsNumber());
     line_offset = args[3].As<Int32>()->Value();
@@ -175,6 +178,10 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       module = Module::CreateSyntheticModule(isolate, url, export_names,
         SyntheticModuleEvaluationStepsCallback);
     } else {
+      Local<String> source_text = args[2].As<String>();
+      std::unique_ptr<CompileCacheEntry> cache_entry;
+      CompileCacheHandler* cache_handler = env->compile_cache_handler();
+
       ScriptCompiler::CachedData* cached_data = nullptr;
       if (!args[5]->IsUndefined()) {
         CHECK(args[5]->IsArrayBufferView());
@@ -184,9 +191,25 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         cached_data =
             new ScriptCompiler::CachedData(data + cached_data_buf->ByteOffset(),
                                            cached_data_buf->ByteLength());
+      } else if (args[6]->IsTrue() && cache_handler != nullptr) {
+        cache_entry =
+            cache_handler->Get(url, source_text, CachedCodeType::kESM);
+        cached_data = cache_entry->CreateCachedData();
+      }
+
+      // Like CommonJS modules, the ES modules of the application use the
+      // --experimental-vm-compile-cache cache when it is enabled.
+      std::string vm_cache_key;
+      VMCompileCache::Data vm_cache_data;
+      if (args[6]->IsTrue() && cached_data == nullptr &&
+          env->options()->experimental_vm_compile_cache) {
+        vm_cache_key = VMCompileCache::GetKey(
+            isolate, CachedCodeType::kESM, url, source_text, {});
+        vm_cache_data = per_process::vm_compile_cache.Get(vm_cache_key);
+        if (vm_cache_data)
+          cached_data = VMCompileCache::CreateCachedData(vm_cache_data);
       }
 
-      Local<String> source_text = args[2].As<String>();
       ScriptOrigin origin(url,
                           line_offset,
                           column_offset,
@@ -215,8 +238,28 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
-      if (options == ScriptCompiler::kConsumeCodeCache &&
-          source.GetCachedData()->rejected) {
+      if (cache_entry) {
+        // A cache from --code-cache-dir that V8 rejects is not an error, it
+        // is replaced by a new one.
+        cache_handler->MaybeSave(
+            cache_entry.get(),
+            module,
+            options == ScriptCompiler::kConsumeCodeCache &&
+                source.GetCachedData()->rejected);
+      } else if (!vm_cache_key.empty()) {
+        // Neither is a rejected entry of the shared cache.
+        bool rejected = vm_cache_data && source.GetCachedData()->rejected;
+        if (vm_cache_data && !rejected) {
+          per_process::vm_compile_cache.RecordHit();
+        } else {
+          std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+              ScriptCompiler::CreateCodeCache(
+                  module->GetUnboundModuleScript()));
+          per_process::vm_compile_cache.RecordMiss(
+              vm_cache_key, new_cached_data.get(), rejected);
+        }
+      } else if (options == ScriptCompiler::kConsumeCodeCache &&
+                 source.GetCachedData()->rejected) {
         THROW_ERR_VM_MODULE_CACHED_DATA_REJECTED(
             env, "cachedData buffer was rejected");
         try_catch.ReThrow();
@@ -785,8 +828,28 @@ void ModuleWrap::Initialize(Local<Object> target,
 #undef V
 }
 
+void ModuleWrap::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+
+  registry->Register(Link);
+  registry->Register(Instantiate);
+  registry->Register(Evaluate);
+  registry->Register(SetSyntheticExport);
+  registry->Register(CreateCachedData);
+  registry->Register(GetNamespace);
+  registry->Register(GetStatus);
+  registry->Register(GetError);
+  registry->Register(GetStaticDependencySpecifiers);
+
+  registry->Register(SetImportModuleDynamicallyCallback);
+  registry->Register(SetInitializeImportMetaObjectCallback);
+}
+
 }  // namespace loader
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(module_wrap,
                                    node::loader::ModuleWrap::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(
+    module_wrap, node::loader::ModuleWrap::RegisterExternalReferences)
@@ -38,6 +38,7 @@
 #include "node_process.h"
 #include "node_report.h"
 #include "node_revert.h"
+#include "node_snapshotable.h"
 #include "node_v8_platform-inl.h"
 #include "node_version.h"
 
@@ -120,6 +121,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -477,6 +479,31 @@ MaybeLocal<Value> StartExecution(Environment* env, StartExecutionCallback cb) {
     return StartExecution(env, "internal/main/worker_thread");
   }
 
+  // The main function that was set with
+  // v8.startupSnapshot.setDeserializeMainFunction() when the snapshot that
+  // the process starts from was built. It takes the place of the entry
+  // point, and is only run once.
+  if (!env->snapshot_deserialize_main().IsEmpty()) {
+    EscapableHandleScope scope(env->isolate());
+    // The getter returns a handle to the persistent itself, which is no
+    // longer valid once the persistent is reset.
+    Local<Function> main =
+        Local<Function>::New(env->isolate(), env->snapshot_deserialize_main());
+    env->set_snapshot_deserialize_main(Local<Function>());
+    Local<Value> mark_bootstrap_complete =
+        env->NewFunctionTemplate(MarkBootstrapComplete)
+            ->GetFunction(env->context())
+            .ToLocalChecked();
+    return scope.EscapeMaybe(main->Call(env->context(),
+                                        env->process_object(),
+                                        1,
+                                        &mark_bootstrap_complete));
+  }
+
+  if (per_process::cli_options->build_snapshot) {
+    return StartExecution(env, "internal/main/mksnapshot");
+  }
+
   std::string first_argv;
   if (env->argv().size() > 1) {
     first_argv = env->argv()[1];
@@ -985,6 +1012,15 @@ InitializationResult InitializeOncePerProcess(int argc, char** argv) {
     }
   }
 
+  if (per_process::cli_options->use_largepages_for_heap == "on" ||
+      per_process::cli_options->use_largepages_for_heap == "silent") {
+    int result = node::UseLargePagesForHeap();
+    if (per_process::cli_options->use_largepages_for_heap == "on" &&
+        result != 0) {
+      fprintf(stderr, "%s\n", node::LargePagesError(result));
+    }
+  }
+
   if (per_process::cli_options->print_version) {
     printf("%s\n", NODE_VERSION);
     result.exit_code = 0;
@@ -1007,6 +1043,36 @@ InitializationResult InitializeOncePerProcess(int argc, char** argv) {
     return result;
   }
 
+  if (!per_process::cli_options->threadpool_cpus.empty()) {
+    const std::vector<int>& cpus = per_process::cli_options->threadpool_cpus;
+    // sched_setaffinity() only fails if none of the CPUs can be used, so
+    // check each of them against the CPUs that the process may run on.
+    std::vector<int> available;
+    if (GetCurrentThreadAffinity(&available) == 0) {
+      for (int cpu : cpus) {
+        if (std::find(available.begin(), available.end(), cpu) ==
+                available.end()) {
+          fprintf(stderr,
+                  "%s: invalid value for --threadpool-cpu-affinity: "
+                  "CPU %d is not available\n",
+                  result.args.at(0).c_str(), cpu);
+          result.exit_code = 9;
+          result.early_return = true;
+          return result;
+        }
+      }
+    }
+
+    int err = StartThreadpoolWithAffinity(cpus);
+    if (err != 0) {
+      fprintf(stderr, "%s: --threadpool-cpu-affinity: %s\n",
+              result.args.at(0).c_str(), uv_strerror(err));
+      result.exit_code = 9;
+      result.early_return = true;
+      return result;
+    }
+  }
+
 #if HAVE_OPENSSL
   {
     std::string extra_ca_certs;
@@ -1048,19 +1114,85 @@ void TearDownOncePerProcess() {
   per_process::v8_platform.Dispose();
 }
 
+// Builds a user-land snapshot by running the entry point given on the
+// command line, and writes it to the file given by --snapshot-blob.
+static int BuildSnapshot(const InitializationResult& result) {
+  if (result.args.size() < 2) {
+    fprintf(stderr,
+            "%s: --build-snapshot must be used with an entry point script.\n"
+            "Usage: node --snapshot-blob snapshot.blob "
+            "--build-snapshot entry.js\n",
+            result.args[0].c_str());
+    return 9;
+  }
+
+  SnapshotData snapshot_data;
+  int exit_code =
+      SnapshotBuilder::Generate(&snapshot_data, result.args, result.exec_args);
+  if (exit_code != 0) return exit_code;
+
+  std::string filename = per_process::cli_options->snapshot_blob;
+  if (filename.empty()) filename = "snapshot.blob";
+  FILE* fp = fopen(filename.c_str(), "wb");
+  if (fp == nullptr) {
+    fprintf(stderr, "Cannot open %s for writing\n", filename.c_str());
+    return 1;
+  }
+  bool written = snapshot_data.ToBlob(fp);
+  if (fclose(fp) != 0 || !written) {
+    fprintf(stderr, "Cannot write the snapshot to %s\n", filename.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+static bool ReadSnapshotBlob(const std::string& filename,
+                             SnapshotData* snapshot_data) {
+  FILE* fp = fopen(filename.c_str(), "rb");
+  if (fp == nullptr) {
+    fprintf(stderr, "Cannot open snapshot blob %s\n", filename.c_str());
+    return false;
+  }
+  bool read = SnapshotData::FromBlob(snapshot_data, fp);
+  fclose(fp);
+  if (!read) {
+    fprintf(stderr,
+            "%s is not a snapshot blob that was built by this version of "
+            "Node.js\n",
+            filename.c_str());
+  }
+  return read;
+}
+
 int Start(int argc, char** argv) {
   InitializationResult result = InitializeOncePerProcess(argc, argv);
   if (result.early_return) {
     return result.exit_code;
   }
 
+  if (per_process::cli_options->build_snapshot) {
+    result.exit_code = BuildSnapshot(result);
+    TearDownOncePerProcess();
+    return result.exit_code;
+  }
+
   {
     Isolate::CreateParams params;
     const std::vector<size_t>* indexes = nullptr;
     const EnvSerializeInfo* env_info = nullptr;
+    SnapshotData snapshot_data;
     bool force_no_snapshot =
         per_process::cli_options->per_isolate->no_node_snapshot;
-    if (!force_no_snapshot) {
+    const std::string& snapshot_blob = per_process::cli_options->snapshot_blob;
+    if (!snapshot_blob.empty()) {
+      if (!ReadSnapshotBlob(snapshot_blob, &snapshot_data)) {
+        TearDownOncePerProcess();
+        return 1;
+      }
+      params.snapshot_blob = &snapshot_data.blob;
+      indexes = &snapshot_data.isolate_data_indices;
+      env_info = &snapshot_data.env_info;
+    } else if (!force_no_snapshot) {
       v8::StartupData* blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
       if (blob != nullptr) {
         params.snapshot_blob = blob;
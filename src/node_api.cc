@@ -12,7 +12,9 @@
 #include "tracing/traced_value.h"
 #include "util-inl.h"
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 struct node_napi_env__ : public napi_env__ {
   explicit node_napi_env__(v8::Local<v8::Context> context,
@@ -37,20 +39,63 @@ struct node_napi_env__ : public napi_env__ {
         v8::True(isolate));
   }
 
+  // The finalizers are queued during GC, and are run together from one
+  // SetImmediate() callback, rather than from one callback each.
   void CallFinalizer(napi_finalize cb, void* data, void* hint) override {
-    napi_env env = static_cast<napi_env>(this);
-    node_env()->SetImmediate([=](node::Environment* node_env) {
-      v8::HandleScope handle_scope(env->isolate);
-      v8::Context::Scope context_scope(env->context());
-      env->CallIntoModule([&](napi_env env) {
-        cb(env, data, hint);
-      });
-    });
+    pending_finalizers.push_back({cb, data, hint});
+    if (pending_finalizers.size() == 1)
+      SchedulePendingFinalizers();
   }
 
   const char* GetFilename() const { return filename.c_str(); }
 
   std::string filename;
+
+ private:
+  struct PendingFinalizer {
+    napi_finalize cb;
+    void* data;
+    void* hint;
+  };
+
+  void SchedulePendingFinalizers() {
+    // Keeps the napi_env alive until the finalizers have run.
+    Ref();
+    node_env()->SetImmediate([this](node::Environment* node_env) {
+      RunPendingFinalizers();
+      Unref();
+    });
+  }
+
+  void RunPendingFinalizers() {
+    std::vector<PendingFinalizer> finalizers;
+    finalizers.swap(pending_finalizers);
+
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(context());
+    for (size_t i = 0; i < finalizers.size(); i++) {
+      const PendingFinalizer& finalizer = finalizers[i];
+      bool threw = false;
+      CallIntoModule([&](napi_env env) {
+        finalizer.cb(env, finalizer.data, finalizer.hint);
+      }, [&](napi_env env, v8::Local<v8::Value> value) {
+        threw = true;
+        HandleThrow(env, value);
+      });
+      if (threw) {
+        // The exception is reported before the remaining finalizers run.
+        bool was_empty = pending_finalizers.empty();
+        pending_finalizers.insert(pending_finalizers.begin(),
+                                  finalizers.begin() + i + 1,
+                                  finalizers.end());
+        if (was_empty && !pending_finalizers.empty())
+          SchedulePendingFinalizers();
+        return;
+      }
+    }
+  }
+
+  std::vector<PendingFinalizer> pending_finalizers;
 };
 
 typedef node_napi_env__* node_napi_env;
@@ -221,8 +266,18 @@ class ThreadSafeFunction : public node::AsyncResource {
   }
 
   void EmptyQueueAndDelete() {
-    for (; !queue.empty() ; queue.pop()) {
-      call_js_cb(nullptr, nullptr, context, queue.front());
+    if (call_js_batch_cb != nullptr) {
+      batch.clear();
+      for (; !queue.empty() ; queue.pop()) {
+        batch.push_back(queue.front());
+      }
+      if (!batch.empty()) {
+        call_js_batch_cb(nullptr, nullptr, context, batch.data(), batch.size());
+      }
+    } else {
+      for (; !queue.empty() ; queue.pop()) {
+        call_js_cb(nullptr, nullptr, context, queue.front());
+      }
     }
     delete this;
   }
@@ -239,6 +294,7 @@ class ThreadSafeFunction : public node::AsyncResource {
       }
       if (max_queue_size == 0 || cond) {
         CHECK_EQ(0, uv_idle_init(loop, &idle));
+        CHECK_EQ(0, uv_timer_init(loop, &timer));
         return napi_ok;
       }
 
@@ -264,6 +320,7 @@ class ThreadSafeFunction : public node::AsyncResource {
   napi_status Unref() {
     uv_unref(reinterpret_cast<uv_handle_t*>(&async));
     uv_unref(reinterpret_cast<uv_handle_t*>(&idle));
+    uv_unref(reinterpret_cast<uv_handle_t*>(&timer));
 
     return napi_ok;
   }
@@ -271,13 +328,26 @@ class ThreadSafeFunction : public node::AsyncResource {
   napi_status Ref() {
     uv_ref(reinterpret_cast<uv_handle_t*>(&async));
     uv_ref(reinterpret_cast<uv_handle_t*>(&idle));
+    uv_ref(reinterpret_cast<uv_handle_t*>(&timer));
 
     return napi_ok;
   }
 
-  void DispatchOne() {
-    void* data = nullptr;
-    bool popped_value = false;
+  napi_status SetBatch(size_t max_batch_size_,
+                       uint32_t max_batch_latency_,
+                       node_api_threadsafe_function_call_js_batch cb) {
+    max_batch_size = max_batch_size_;
+    max_batch_latency = max_batch_latency_;
+    call_js_batch_cb = cb;
+    batch.reserve(max_batch_size);
+
+    return napi_ok;
+  }
+
+  // Without a call_js_batch_cb, the items are dispatched one at a time.
+  void Dispatch() {
+    size_t max_count = call_js_batch_cb == nullptr ? 1 : max_batch_size;
+    batch.clear();
 
     {
       node::Mutex::ScopedLock lock(this->mutex);
@@ -285,14 +355,16 @@ class ThreadSafeFunction : public node::AsyncResource {
         CloseHandlesAndMaybeDelete();
       } else {
         size_t size = queue.size();
-        if (size > 0) {
-          data = queue.front();
-          queue.pop();
-          popped_value = true;
-          if (size == max_queue_size && max_queue_size > 0) {
+        if (size == max_queue_size && max_queue_size > 0) {
+          if (max_count == 1) {
             cond->Signal(lock);
+          } else {
+            cond->Broadcast(lock);
           }
-          size--;
+        }
+        for (; size > 0 && batch.size() < max_count; size--) {
+          batch.push_back(queue.front());
+          queue.pop();
         }
 
         if (size == 0) {
@@ -309,7 +381,7 @@ class ThreadSafeFunction : public node::AsyncResource {
       }
     }
 
-    if (popped_value) {
+    if (!batch.empty()) {
       v8::HandleScope scope(env->isolate);
       CallbackScope cb_scope(this);
       napi_value js_callback = nullptr;
@@ -319,7 +391,12 @@ class ThreadSafeFunction : public node::AsyncResource {
         js_callback = v8impl::JsValueFromV8LocalValue(js_cb);
       }
       env->CallIntoModule([&](napi_env env) {
-        call_js_cb(env, js_callback, context, data);
+        if (call_js_batch_cb != nullptr) {
+          call_js_batch_cb(
+              env, js_callback, context, batch.data(), batch.size());
+        } else {
+          call_js_cb(env, js_callback, context, batch[0]);
+        }
       });
     }
   }
@@ -365,7 +442,16 @@ class ThreadSafeFunction : public node::AsyncResource {
                 ThreadSafeFunction* ts_fn =
                     node::ContainerOf(&ThreadSafeFunction::idle,
                                       reinterpret_cast<uv_idle_t*>(handle));
-                ts_fn->Finalize();
+                v8::HandleScope scope(ts_fn->env->isolate);
+                ts_fn->env->node_env()->CloseHandle(
+                    reinterpret_cast<uv_handle_t*>(&ts_fn->timer),
+                    [](uv_handle_t* handle) -> void {
+                      ThreadSafeFunction* ts_fn =
+                          node::ContainerOf(
+                              &ThreadSafeFunction::timer,
+                              reinterpret_cast<uv_timer_t*>(handle));
+                      ts_fn->Finalize();
+                    });
               });
         });
   }
@@ -393,15 +479,40 @@ class ThreadSafeFunction : public node::AsyncResource {
     }
   }
 
+  // With a batch latency, the items are only dispatched once there are
+  // enough of them for a full batch, or once the latency has passed since
+  // the first item arrived, unless no more items can arrive.
+  bool ShouldWaitForBatch() {
+    if (call_js_batch_cb == nullptr || max_batch_latency == 0) {
+      return false;
+    }
+    node::Mutex::ScopedLock lock(this->mutex);
+    return !is_closing && thread_count > 0 && queue.size() < max_batch_size;
+  }
+
   static void IdleCb(uv_idle_t* idle) {
     ThreadSafeFunction* ts_fn =
         node::ContainerOf(&ThreadSafeFunction::idle, idle);
-    ts_fn->DispatchOne();
+    ts_fn->Dispatch();
+  }
+
+  static void TimerCb(uv_timer_t* timer) {
+    ThreadSafeFunction* ts_fn =
+        node::ContainerOf(&ThreadSafeFunction::timer, timer);
+    CHECK_EQ(0, uv_idle_start(&ts_fn->idle, IdleCb));
   }
 
   static void AsyncCb(uv_async_t* async) {
     ThreadSafeFunction* ts_fn =
         node::ContainerOf(&ThreadSafeFunction::async, async);
+    if (ts_fn->ShouldWaitForBatch()) {
+      if (!uv_is_active(reinterpret_cast<uv_handle_t*>(&ts_fn->timer))) {
+        CHECK_EQ(0, uv_timer_start(
+            &ts_fn->timer, TimerCb, ts_fn->max_batch_latency, 0));
+      }
+      return;
+    }
+    CHECK_EQ(0, uv_timer_stop(&ts_fn->timer));
     CHECK_EQ(0, uv_idle_start(&ts_fn->idle, IdleCb));
   }
 
@@ -417,6 +528,7 @@ class ThreadSafeFunction : public node::AsyncResource {
   std::queue<void*> queue;
   uv_async_t async;
   uv_idle_t idle;
+  uv_timer_t timer;
   size_t thread_count;
   bool is_closing;
 
@@ -432,6 +544,12 @@ class ThreadSafeFunction : public node::AsyncResource {
   napi_finalize finalize_cb;
   napi_threadsafe_function_call_js call_js_cb;
   bool handles_closing;
+  // Set by node_api_set_threadsafe_function_batch().
+  node_api_threadsafe_function_call_js_batch call_js_batch_cb = nullptr;
+  size_t max_batch_size = 1;
+  uint32_t max_batch_latency = 0;
+  // The items that are being dispatched.
+  std::vector<void*> batch;
 };
 
 /**
@@ -1030,7 +1148,7 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
     : AsyncResource(env->isolate,
                     async_resource,
                     *v8::String::Utf8Value(env->isolate, async_resource_name)),
-      ThreadPoolWork(env->node_env()),
+      ThreadPoolWork(env->node_env(), node::ThreadPoolWorkClass::kNapi),
       _env(env),
       _data(data),
       _execute(execute),
@@ -1054,7 +1172,27 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
     delete work;
   }
 
+  // Set by node_api_queue_async_work_with_options().
+  void SetOptions(uint32_t deadline) {
+    _has_options = true;
+    _deadline =
+        deadline > 0 ? uv_hrtime() + deadline * static_cast<uint64_t>(1e6) : 0;
+    _cancel_requested = false;
+    _skipped = false;
+  }
+
+  // Can be called while the work runs on the threadpool.
+  void RequestCancel() { _cancel_requested = true; }
+  bool IsCancelRequested() const { return _cancel_requested; }
+
   void DoThreadPoolWork() override {
+    if (_has_options) {
+      if (_cancel_requested ||
+          (_deadline != 0 && uv_hrtime() > _deadline)) {
+        _skipped = true;
+        return;
+      }
+    }
     _execute(_env, _data);
   }
 
@@ -1062,6 +1200,11 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
     if (_complete == nullptr)
       return;
 
+    // Work that is queued with options reports that it was cancelled if it
+    // was cancelled or expired before it could start, or while it ran.
+    if (status == 0 && _has_options && (_skipped || _cancel_requested))
+      status = UV_ECANCELED;
+
     // Establish a handle scope here so that every callback doesn't have to.
     // Also it is needed for the exception-handling below.
     v8::HandleScope scope(_env->isolate);
@@ -1086,6 +1229,11 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
   void* _data;
   napi_async_execute_callback _execute;
   napi_async_complete_callback _complete;
+  bool _has_options = false;
+  // The time, from uv_hrtime(), after which the work does not start any more.
+  uint64_t _deadline = 0;
+  std::atomic<bool> _cancel_requested{false};
+  bool _skipped = false;
 };
 
 }  // end of namespace uvimpl
@@ -1165,17 +1313,54 @@ napi_status napi_queue_async_work(napi_env env, napi_async_work work) {
   return napi_clear_last_error(env);
 }
 
+napi_status node_api_queue_async_work_with_options(
+    napi_env env,
+    napi_async_work work,
+    const node_api_async_work_options* options) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, work);
+  CHECK_ARG(env, options);
+
+  int32_t priority;
+  switch (options->priority) {
+    case node_api_async_work_priority_low: priority = -1; break;
+    case node_api_async_work_priority_normal: priority = 0; break;
+    case node_api_async_work_priority_high: priority = 1; break;
+    default: return napi_set_last_error(env, napi_invalid_arg);
+  }
+
+  uvimpl::Work* w = reinterpret_cast<uvimpl::Work*>(work);
+
+  w->set_priority(priority);
+  w->SetOptions(options->deadline);
+  w->ScheduleWork();
+
+  return napi_clear_last_error(env);
+}
+
 napi_status napi_cancel_async_work(napi_env env, napi_async_work work) {
   CHECK_ENV(env);
   CHECK_ARG(env, work);
 
   uvimpl::Work* w = reinterpret_cast<uvimpl::Work*>(work);
 
+  // Work that is already running can still see the request through
+  // node_api_is_async_work_cancelled().
+  w->RequestCancel();
   CALL_UV(env, w->CancelWork());
 
   return napi_clear_last_error(env);
 }
 
+napi_status node_api_is_async_work_cancelled(napi_async_work work,
+                                             bool* result) {
+  CHECK_NOT_NULL(work);
+  CHECK_NOT_NULL(result);
+
+  *result = reinterpret_cast<uvimpl::Work*>(work)->IsCancelRequested();
+  return napi_ok;
+}
+
 napi_status
 napi_create_threadsafe_function(napi_env env,
                                 napi_value func,
@@ -1283,6 +1468,25 @@ napi_ref_threadsafe_function(napi_env env, napi_threadsafe_function func) {
   return reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->Ref();
 }
 
+napi_status
+node_api_set_threadsafe_function_batch(
+    napi_env env,
+    napi_threadsafe_function func,
+    size_t max_batch_size,
+    uint32_t max_batch_latency,
+    node_api_threadsafe_function_call_js_batch call_js_batch_cb) {
+  CHECK_ENV(env);
+  CHECK_ARG(env, func);
+  CHECK_ARG(env, call_js_batch_cb);
+  RETURN_STATUS_IF_FALSE(env, max_batch_size > 0, napi_invalid_arg);
+
+  napi_status status =
+      reinterpret_cast<v8impl::ThreadSafeFunction*>(func)->SetBatch(
+          max_batch_size, max_batch_latency, call_js_batch_cb);
+  if (status != napi_ok) return napi_set_last_error(env, status);
+  return napi_clear_last_error(env);
+}
+
 napi_status node_api_get_module_file_name(napi_env env, const char** result) {
   CHECK_ENV(env);
   CHECK_ARG(env, result);
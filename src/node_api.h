@@ -268,6 +268,23 @@ NAPI_EXTERN napi_status napi_remove_async_cleanup_hook(
 NAPI_EXTERN napi_status
 node_api_get_module_file_name(napi_env env, const char** result);
 
+NAPI_EXTERN napi_status
+node_api_queue_async_work_with_options(
+    napi_env env,
+    napi_async_work work,
+    const node_api_async_work_options* options);
+
+NAPI_EXTERN napi_status
+node_api_is_async_work_cancelled(napi_async_work work, bool* result);
+
+NAPI_EXTERN napi_status
+node_api_set_threadsafe_function_batch(
+    napi_env env,
+    napi_threadsafe_function func,
+    size_t max_batch_size,
+    uint32_t max_batch_latency,
+    node_api_threadsafe_function_call_js_batch call_js_batch_cb);
+
 #endif  // NAPI_EXPERIMENTAL
 
 EXTERN_C_END
@@ -34,6 +34,28 @@ typedef void (*napi_threadsafe_function_call_js)(napi_env env,
                                                  void* data);
 #endif  // NAPI_VERSION >= 4
 
+#ifdef NAPI_EXPERIMENTAL
+typedef enum {
+  node_api_async_work_priority_low,
+  node_api_async_work_priority_normal,
+  node_api_async_work_priority_high
+} node_api_async_work_priority;
+
+typedef struct {
+  node_api_async_work_priority priority;
+  // The time, in milliseconds, after which the work is cancelled if it has
+  // not started yet, or 0.
+  uint32_t deadline;
+} node_api_async_work_options;
+
+typedef void (*node_api_threadsafe_function_call_js_batch)(
+    napi_env env,
+    napi_value js_callback,
+    void* context,
+    void** data,
+    size_t count);
+#endif  // NAPI_EXPERIMENTAL
+
 typedef struct {
   uint32_t major;
   uint32_t minor;
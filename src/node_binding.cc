@@ -1,5 +1,6 @@
 #include "node_binding.h"
 #include <atomic>
+#include "debug_utils-inl.h"
 #include "env-inl.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
@@ -39,6 +40,7 @@
 // node is built as static library. No need to depend on the
 // __attribute__((constructor)) like mechanism in GCC.
 #define NODE_BUILTIN_STANDARD_MODULES(V)                                       \
+  V(async_context_frame)                                                       \
   V(async_wrap)                                                                \
   V(block_list)                                                                \
   V(buffer)                                                                    \
@@ -46,6 +48,7 @@
   V(config)                                                                    \
   V(contextify)                                                                \
   V(credentials)                                                               \
+  V(diagnostics_channel)                                                       \
   V(errors)                                                                    \
   V(fs)                                                                        \
   V(fs_dir)                                                                    \
@@ -54,9 +57,11 @@
   V(http2)                                                                     \
   V(http_parser)                                                               \
   V(inspector)                                                                 \
+  V(io_thread_stream)                                                          \
   V(js_stream)                                                                 \
   V(js_udp_wrap)                                                               \
   V(messaging)                                                                 \
+  V(mksnapshot)                                                                \
   V(module_wrap)                                                               \
   V(native_module)                                                             \
   V(options)                                                                   \
@@ -570,6 +575,21 @@ static Local<Object> InitModule(Environment* env,
   return exports;
 }
 
+// While building a user-land snapshot, only the bindings whose external
+// references are registered can be loaded, in addition to the ones that
+// do not have any native functions.
+static bool CanBeLoadedInSnapshot(const char* name) {
+#define V(modname)                                                             \
+  if (strcmp(name, #modname) == 0) return true;
+  EXTERNAL_REFERENCE_BINDING_LIST(V)
+  V(config)
+  V(constants)
+  V(natives)
+  V(symbols)
+#undef V
+  return false;
+}
+
 void GetInternalBinding(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -579,6 +599,19 @@ void GetInternalBinding(const FunctionCallbackInfo<Value>& args) {
   node::Utf8Value module_v(env->isolate(), module);
   Local<Object> exports;
 
+  if (per_process::cli_options->build_snapshot &&
+      !CanBeLoadedInSnapshot(*module_v)) {
+    char errmsg[1024];
+    snprintf(errmsg,
+             sizeof(errmsg),
+             "Binding %s is not supported in the user-land snapshot",
+             *module_v);
+    return THROW_ERR_NOT_SUPPORTED_IN_SNAPSHOT(env, errmsg);
+  }
+
+  // The bindings are only initialized when they are first loaded, after which
+  // internalBinding() caches them.
+  uint64_t start = uv_hrtime();
   node_module* mod = FindModule(modlist_internal, *module_v, NM_F_INTERNAL);
   if (mod != nullptr) {
     exports = InitModule(env, mod, module);
@@ -602,6 +635,9 @@ void GetInternalBinding(const FunctionCallbackInfo<Value>& args) {
     snprintf(errmsg, sizeof(errmsg), "No such module: %s", *module_v);
     return THROW_ERR_INVALID_MODULE(env, errmsg);
   }
+  Debug(env, DebugCategory::LOADER,
+        "Initialized internal binding %s in %d us\n",
+        *module_v, (uv_hrtime() - start) / 1000);
 
   args.GetReturnValue().Set(exports);
 }
@@ -3,12 +3,17 @@
 #include "base_object-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_bob-inl.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "threadpoolwork-inl.h"
+#include "util-inl.h"
 #include "v8.h"
 
+#include <fcntl.h>  // O_RDONLY
+
 #include <algorithm>
+#include <climits>
 
 namespace node {
 
@@ -16,6 +21,7 @@ using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
+using v8::BigInt;
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::Function;
@@ -26,12 +32,90 @@ using v8::Local;
 using v8::MaybeLocal;
 using v8::Number;
 using v8::Object;
-using v8::Uint32;
 using v8::Undefined;
 using v8::Value;
 
+namespace {
+// Copies the contents of the entry into dest. Returns 0 or a libuv error
+// code. This blocks for the parts of a file.
+int CopyEntry(const BlobEntry& entry, unsigned char* dest) {
+  if (entry.file)
+    return entry.file->Read(entry.offset, entry.length, dest);
+  unsigned char* src = static_cast<unsigned char*>(entry.store->Data());
+  memcpy(dest, src + entry.offset, entry.length);
+  return 0;
+}
+
+// Copies the contents of all of the entries into dest, which has room for
+// length bytes. Returns 0 or a libuv error code.
+int CopyEntries(
+    const std::vector<BlobEntry>& entries,
+    size_t length,
+    unsigned char* dest) {
+  size_t total = 0;
+  for (const auto& entry : entries) {
+    total += entry.length;
+    CHECK_LE(total, length);
+    int err = CopyEntry(entry, dest);
+    if (err != 0)
+      return err;
+    dest += entry.length;
+  }
+  return 0;
+}
+}  // namespace
+
+int BlobFile::Read(
+    uint64_t offset,
+    size_t length,
+    unsigned char* dest) const {
+  uv_fs_t req;
+  int fd = uv_fs_open(nullptr, &req, path.c_str(), O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0)
+    return fd;
+
+  auto cleanup = OnScopeLeave([&]() {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  // A file that changed would give a Blob that is not immutable.
+  int err = uv_fs_fstat(nullptr, &req, fd, nullptr);
+  if (err == 0) {
+    const uv_stat_t& stat = req.statbuf;
+    uint64_t modified =
+        static_cast<uint64_t>(stat.st_mtim.tv_sec) * 1000000000 +
+        stat.st_mtim.tv_nsec;
+    if (stat.st_size != size || modified != mtime_ns)
+      err = UV_EIO;
+  }
+  uv_fs_req_cleanup(&req);
+  if (err != 0)
+    return err;
+
+  while (length > 0) {
+    uv_buf_t buf = uv_buf_init(
+        reinterpret_cast<char*>(dest),
+        static_cast<unsigned int>(std::min<size_t>(length, INT_MAX)));
+    int nread = uv_fs_read(nullptr, &req, fd, &buf, 1, offset, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (nread < 0)
+      return nread;
+    // The file was checked to be large enough, so it shrank.
+    if (nread == 0)
+      return UV_EIO;
+    dest += nread;
+    offset += nread;
+    length -= nread;
+  }
+  return 0;
+}
+
 void Blob::Initialize(Environment* env, v8::Local<v8::Object> target) {
   env->SetMethod(target, "createBlob", New);
+  env->SetMethod(target, "createBlobFromFile", NewFromFile);
   FixedSizeBlobCopyJob::Initialize(env, target);
 }
 
@@ -76,11 +160,11 @@ BaseObjectPtr<Blob> Blob::Create(
 void Blob::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(args[0]->IsArray());  // sources
-  CHECK(args[1]->IsUint32());  // length
+  CHECK(args[1]->IsNumber());  // length
 
   std::vector<BlobEntry> entries;
 
-  size_t length = args[1].As<Uint32>()->Value();
+  size_t length = args[1].As<Number>()->Value();
   size_t len = 0;
   Local<Array> ary = args[0].As<Array>();
   for (size_t n = 0; n < ary->Length(); n++) {
@@ -94,7 +178,8 @@ void Blob::New(const FunctionCallbackInfo<Value>& args) {
       std::shared_ptr<BackingStore> store = view->Buffer()->GetBackingStore();
       size_t byte_length = view->ByteLength();
       view->Buffer()->Detach();  // The Blob will own the backing store now.
-      entries.emplace_back(BlobEntry{std::move(store), byte_length, 0});
+      entries.emplace_back(
+          BlobEntry{std::move(store), byte_length, 0, nullptr});
       len += byte_length;
     } else {
       Blob* blob;
@@ -111,6 +196,30 @@ void Blob::New(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(blob->object());
 }
 
+void Blob::NewFromFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());  // path
+  CHECK(args[1]->IsBigInt());  // size
+  CHECK(args[2]->IsBigInt());  // mtime in nanoseconds
+
+  Utf8Value path(env->isolate(), args[0]);
+  std::shared_ptr<BlobFile> file = std::make_shared<BlobFile>(BlobFile{
+      std::string(*path, path.length()),
+      args[1].As<BigInt>()->Uint64Value(),
+      args[2].As<BigInt>()->Uint64Value()});
+
+  std::vector<BlobEntry> entries;
+  if (file->size > 0) {
+    entries.emplace_back(
+        BlobEntry{nullptr, static_cast<size_t>(file->size), 0, file});
+  }
+
+  BaseObjectPtr<Blob> blob =
+      Create(env, entries, static_cast<size_t>(file->size));
+  if (blob)
+    args.GetReturnValue().Set(blob->object());
+}
+
 void Blob::ToArrayBuffer(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Blob* blob;
@@ -124,17 +233,28 @@ void Blob::ToSlice(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Blob* blob;
   ASSIGN_OR_RETURN_UNWRAP(&blob, args.Holder());
-  CHECK(args[0]->IsUint32());
-  CHECK(args[1]->IsUint32());
-  size_t start = args[0].As<Uint32>()->Value();
-  size_t end = args[1].As<Uint32>()->Value();
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  size_t start = args[0].As<Number>()->Value();
+  size_t end = args[1].As<Number>()->Value();
   BaseObjectPtr<Blob> slice = blob->Slice(env, start, end);
   if (slice)
     args.GetReturnValue().Set(slice->object());
 }
 
 void Blob::MemoryInfo(MemoryTracker* tracker) const {
-  tracker->TrackFieldWithSize("store", length_);
+  size_t size = 0;
+  for (const auto& entry : store_) {
+    if (!entry.file)
+      size += entry.length;
+  }
+  tracker->TrackFieldWithSize("store", size);
+}
+
+bool Blob::HasFileEntries() const {
+  return std::any_of(store_.begin(), store_.end(), [](const BlobEntry& entry) {
+    return static_cast<bool>(entry.file);
+  });
 }
 
 MaybeLocal<Value> Blob::GetArrayBuffer(Environment* env) {
@@ -143,15 +263,11 @@ MaybeLocal<Value> Blob::GetArrayBuffer(Environment* env) {
   std::shared_ptr<BackingStore> store =
       ArrayBuffer::NewBackingStore(env->isolate(), len);
   if (len > 0) {
-    unsigned char* dest = static_cast<unsigned char*>(store->Data());
-    size_t total = 0;
-    for (const auto& entry : entries()) {
-      unsigned char* src = static_cast<unsigned char*>(entry.store->Data());
-      src += entry.offset;
-      memcpy(dest, src, entry.length);
-      dest += entry.length;
-      total += entry.length;
-      CHECK_LE(total, len);
+    int err = CopyEntries(
+        entries(), len, static_cast<unsigned char*>(store->Data()));
+    if (err != 0) {
+      env->ThrowUVException(err, "read");
+      return MaybeLocal<Value>();
     }
   }
 
@@ -170,14 +286,14 @@ BaseObjectPtr<Blob> Blob::Slice(Environment* env, size_t start, size_t end) {
   if (total == 0) return Create(env, slices, 0);
 
   for (const auto& entry : entries()) {
-    if (start + entry.offset > entry.store->ByteLength()) {
+    if (start >= entry.length) {
       start -= entry.length;
       continue;
     }
 
-    size_t offset = entry.offset + start;
-    size_t len = std::min(remaining, entry.store->ByteLength() - offset);
-    slices.emplace_back(BlobEntry{entry.store, len, offset});
+    size_t len = std::min(remaining, entry.length - start);
+    slices.emplace_back(
+        BlobEntry{entry.store, len, entry.offset + start, entry.file});
 
     remaining -= len;
     start = 0;
@@ -220,6 +336,99 @@ std::unique_ptr<worker::TransferData> Blob::CloneForMessaging() const {
   return std::make_unique<BlobTransferData>(store_, length_);
 }
 
+class Blob::Reader::FileRead final : public ThreadPoolWork {
+ public:
+  FileRead(Environment* env,
+           bob::Next<uv_buf_t> next,
+           std::shared_ptr<BlobFile> file,
+           uint64_t offset,
+           size_t length)
+      : ThreadPoolWork(env),
+        next_(std::move(next)),
+        file_(std::move(file)),
+        offset_(offset),
+        length_(length),
+        data_(new char[length], std::default_delete<char[]>()) {}
+
+  void DoThreadPoolWork() override {
+    status_ = file_->Read(
+        offset_, length_, reinterpret_cast<unsigned char*>(data_.get()));
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<FileRead> self(this);
+    if (status == 0)
+      status = status_;
+    if (status != 0) {
+      std::move(next_)(status, nullptr, 0, [](size_t) {});
+      return;
+    }
+    uv_buf_t buf = uv_buf_init(data_.get(), length_);
+    std::shared_ptr<char> data = std::move(data_);
+    std::move(next_)(bob::STATUS_CONTINUE, &buf, 1, [data](size_t) {});
+  }
+
+ private:
+  bob::Next<uv_buf_t> next_;
+  std::shared_ptr<BlobFile> file_;
+  uint64_t offset_;
+  size_t length_;
+  std::shared_ptr<char> data_;
+  int status_ = 0;
+};
+
+Blob::Reader::Reader(Environment* env, const std::vector<BlobEntry>& entries)
+    : env_(env), entries_(entries) {}
+
+int Blob::Reader::DoPull(
+    bob::Next<uv_buf_t> next,
+    int options,
+    uv_buf_t* data,
+    size_t count,
+    size_t max_count_hint) {
+  while (index_ < entries_.size() && entries_[index_].length == 0)
+    index_++;
+  if (index_ == entries_.size()) {
+    std::move(next)(bob::STATUS_END, nullptr, 0, [](size_t) {});
+    return bob::STATUS_END;
+  }
+
+  const BlobEntry& entry = entries_[index_];
+  if (!entry.file) {
+    uv_buf_t buf = uv_buf_init(
+        static_cast<char*>(entry.store->Data()) + entry.offset, entry.length);
+    std::shared_ptr<BackingStore> store = entry.store;
+    index_++;
+    std::move(next)(bob::STATUS_CONTINUE, &buf, 1, [store](size_t) {});
+    return bob::STATUS_CONTINUE;
+  }
+
+  // The file is read on the threadpool, which cannot be done synchronously.
+  if (options & bob::OPTIONS_SYNC) {
+    std::move(next)(bob::STATUS_BLOCK, nullptr, 0, [](size_t) {});
+    return bob::STATUS_BLOCK;
+  }
+  size_t length = entry.length - entry_offset_;
+  if (length > kFileReadSize)
+    length = kFileReadSize;
+  FileRead* read = new FileRead(env_,
+                                std::move(next),
+                                entry.file,
+                                entry.offset + entry_offset_,
+                                length);
+  entry_offset_ += length;
+  if (entry_offset_ == entry.length) {
+    index_++;
+    entry_offset_ = 0;
+  }
+  read->ScheduleWork();
+  return bob::STATUS_WAIT;
+}
+
+std::unique_ptr<Blob::Reader> Blob::CreateReader(Environment* env) const {
+  return std::make_unique<Reader>(env, store_);
+}
+
 FixedSizeBlobCopyJob::FixedSizeBlobCopyJob(
     Environment* env,
     Local<Object> object,
@@ -242,8 +451,9 @@ void FixedSizeBlobCopyJob::AfterThreadPoolWork(int status) {
   Context::Scope context_scope(env->context());
   Local<Value> args[2];
 
-  if (status == UV_ECANCELED) {
-    args[0] = Number::New(env->isolate(), status),
+  if (status == UV_ECANCELED || status_ != 0) {
+    args[0] = Number::New(env->isolate(),
+                          status == UV_ECANCELED ? status : status_),
     args[1] = Undefined(env->isolate());
   } else {
     args[0] = Undefined(env->isolate());
@@ -255,17 +465,8 @@ void FixedSizeBlobCopyJob::AfterThreadPoolWork(int status) {
 
 void FixedSizeBlobCopyJob::DoThreadPoolWork() {
   unsigned char* dest = static_cast<unsigned char*>(destination_->Data());
-  if (length_ > 0) {
-    size_t total = 0;
-    for (const auto& entry : source_) {
-      unsigned char* src = static_cast<unsigned char*>(entry.store->Data());
-      src += entry.offset;
-      memcpy(dest, src, entry.length);
-      dest += entry.length;
-      total += entry.length;
-      CHECK_LE(total, length_);
-    }
-  }
+  if (length_ > 0)
+    status_ = CopyEntries(source_, length_, dest);
 }
 
 void FixedSizeBlobCopyJob::MemoryInfo(MemoryTracker* tracker) const {
@@ -298,10 +499,12 @@ void FixedSizeBlobCopyJob::New(const FunctionCallbackInfo<Value>& args) {
 
   // This is a fairly arbitrary heuristic. We want to avoid deferring to
   // the threadpool if the amount of data being copied is small and there
-  // aren't that many entries to copy.
+  // aren't that many entries to copy. Files are never read on the main
+  // thread.
   FixedSizeBlobCopyJob::Mode mode =
       (blob->length() < kMaxSyncLength &&
-       blob->entries().size() < kMaxEntryCount) ?
+       blob->entries().size() < kMaxEntryCount &&
+       !blob->HasFileEntries()) ?
           FixedSizeBlobCopyJob::Mode::SYNC :
           FixedSizeBlobCopyJob::Mode::ASYNC;
 
@@ -330,6 +533,7 @@ void FixedSizeBlobCopyJob::RegisterExternalReferences(
 
 void Blob::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Blob::New);
+  registry->Register(Blob::NewFromFile);
   registry->Register(Blob::ToArrayBuffer);
   registry->Register(Blob::ToSlice);
 }
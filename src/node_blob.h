@@ -7,18 +7,37 @@
 #include "base_object.h"
 #include "env.h"
 #include "memory_tracker.h"
+#include "node_bob.h"
 #include "node_internals.h"
 #include "node_worker.h"
 #include "v8.h"
 
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace node {
 
+// A file that parts of a Blob are read from when they are needed. The file
+// is opened again for each read, and has to be unchanged since the Blob was
+// created for the read to succeed.
+struct BlobFile {
+  std::string path;
+  uint64_t size;
+  uint64_t mtime_ns;
+
+  // Reads length bytes at offset into dest. Returns 0 or a libuv error code.
+  // This blocks, so it should not be called on the event loop thread.
+  int Read(uint64_t offset, size_t length, unsigned char* dest) const;
+};
+
 struct BlobEntry {
   std::shared_ptr<v8::BackingStore> store;
   size_t length;
   size_t offset;
+  // Set for the parts of a file, in which case there is no store and the
+  // offset is the one in the file.
+  std::shared_ptr<BlobFile> file;
 };
 
 class Blob : public BaseObject {
@@ -28,6 +47,7 @@ class Blob : public BaseObject {
   static void Initialize(Environment* env, v8::Local<v8::Object> target);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void NewFromFile(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void ToArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void ToSlice(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -56,6 +76,40 @@ class Blob : public BaseObject {
 
   inline size_t length() const { return length_; }
 
+  // Returns true if any of the parts of the Blob have to be read from a file.
+  bool HasFileEntries() const;
+
+  // Reads the contents of a Blob as a bob source. The parts that are in
+  // memory are passed on without copying them, and the parts of files are
+  // read on the threadpool in chunks of kFileReadSize bytes. Read errors are
+  // reported as negative libuv error codes. The source holds references to
+  // the parts, so it can outlive the Blob.
+  class Reader final : public bob::SourceImpl<uv_buf_t> {
+   public:
+    static constexpr size_t kFileReadSize = 64 * 1024;
+
+    Reader(Environment* env, const std::vector<BlobEntry>& entries);
+
+   protected:
+    int DoPull(
+        bob::Next<uv_buf_t> next,
+        int options,
+        uv_buf_t* data,
+        size_t count,
+        size_t max_count_hint = bob::kMaxCountHint) override;
+
+   private:
+    class FileRead;
+
+    Environment* env_;
+    std::vector<BlobEntry> entries_;
+    size_t index_ = 0;
+    // How much of the current entry was already read.
+    size_t entry_offset_ = 0;
+  };
+
+  std::unique_ptr<Reader> CreateReader(Environment* env) const;
+
   class BlobTransferData : public worker::TransferData {
    public:
     explicit BlobTransferData(
@@ -126,6 +180,7 @@ class FixedSizeBlobCopyJob : public AsyncWrap, public ThreadPoolWork {
     Mode mode = Mode::ASYNC);
 
   Mode mode_;
+  int status_ = 0;
   std::vector<BlobEntry> source_;
   std::shared_ptr<v8::BackingStore> destination_;
   size_t length_ = 0;
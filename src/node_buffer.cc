@@ -28,13 +28,18 @@
 #include "node_internals.h"
 
 #include "env-inl.h"
+#include "memory_tracker-inl.h"
 #include "string_bytes.h"
 #include "string_search.h"
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <climits>
+#include <limits>
+#include <vector>
 
 #define THROW_AND_RETURN_UNLESS_BUFFER(env, obj)                            \
   THROW_AND_RETURN_IF_NOT_BUFFER(env, obj, "argument")                      \
@@ -49,6 +54,7 @@
 namespace node {
 namespace Buffer {
 
+using v8::Array;
 using v8::ArrayBuffer;
 using v8::ArrayBufferView;
 using v8::BackingStore;
@@ -60,6 +66,7 @@ using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
+using v8::JSON;
 using v8::Just;
 using v8::Local;
 using v8::Maybe;
@@ -101,6 +108,7 @@ class CallbackInfo {
   char* const data_;
   void* const hint_;
   Environment* const env_;
+  CleanupHookSlot cleanup_hook_slot_;
 };
 
 
@@ -143,7 +151,7 @@ CallbackInfo::CallbackInfo(Environment* env,
       data_(data),
       hint_(hint),
       env_(env) {
-  env->AddCleanupHook(CleanupHook, this);
+  cleanup_hook_slot_ = env->AddCleanupHookSlot(CleanupHook, this);
   env->isolate()->AdjustAmountOfExternalAllocatedMemory(sizeof(*this));
 }
 
@@ -173,7 +181,7 @@ void CallbackInfo::CallAndResetCallback() {
   }
   if (callback != nullptr) {
     // Clean up all Environment-related state and run the callback.
-    env_->RemoveCleanupHook(CleanupHook, this);
+    env_->RemoveCleanupHookSlot(cleanup_hook_slot_, CleanupHook, this);
     int64_t change_in_bytes = -static_cast<int64_t>(sizeof(*this));
     env_->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
 
@@ -351,8 +359,14 @@ MaybeLocal<Object> New(Environment* env, size_t length) {
     return Local<Object>();
   }
 
-  return scope.EscapeMaybe(
-      AllocatedBuffer::AllocateManaged(env, length).ToBuffer());
+  // Not taken from the BufferPool, as the caller may rely on the Buffer
+  // owning its ArrayBuffer.
+  Local<ArrayBuffer> ab =
+      AllocatedBuffer::AllocateManaged(env, length).ToArrayBuffer();
+  Local<Uint8Array> ui;
+  if (!New(env, ab, 0, length).ToLocal(&ui))
+    return MaybeLocal<Object>();
+  return scope.Escape(ui);
 }
 
 
@@ -384,7 +398,12 @@ MaybeLocal<Object> Copy(Environment* env, const char* data, size_t length) {
     memcpy(ret.data(), data, length);
   }
 
-  return scope.EscapeMaybe(ret.ToBuffer());
+  // See New() above.
+  Local<ArrayBuffer> ab = ret.ToArrayBuffer();
+  Local<Uint8Array> ui;
+  if (!New(env, ab, 0, length).ToLocal(&ui))
+    return MaybeLocal<Object>();
+  return scope.Escape(ui);
 }
 
 
@@ -513,6 +532,197 @@ void StringSlice(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Copies the pieces of a concat() into the result. Large copies are split
+// into ranges of the result that are copied on the platform's worker threads,
+// with the calling thread taking part until all of them are done.
+class ConcatCopyJob final : public v8::JobTask {
+ public:
+  struct Piece {
+    const char* data;
+    size_t offset;  // In the result.
+    size_t length;
+  };
+
+  static constexpr size_t kParallelThreshold = 4 * 1024 * 1024;
+  static constexpr size_t kRangeSize = 1024 * 1024;
+
+  ConcatCopyJob(char* dest, size_t length, const std::vector<Piece>* pieces)
+    : dest_(dest),
+      length_(length),
+      pieces_(pieces),
+      ranges_((length + kRangeSize - 1) / kRangeSize) {}
+
+  static void CopyAll(MultiIsolatePlatform* platform,
+                      char* dest,
+                      size_t length,
+                      const std::vector<Piece>& pieces) {
+    if (length < kParallelThreshold || platform == nullptr) {
+      for (const Piece& piece : pieces)
+        memcpy(dest + piece.offset, piece.data, piece.length);
+      return;
+    }
+    platform->PostJob(
+        v8::TaskPriority::kUserBlocking,
+        std::make_unique<ConcatCopyJob>(dest, length, &pieces))->Join();
+  }
+
+  void Run(v8::JobDelegate* delegate) override {
+    for (;;) {
+      const size_t range = next_range_.fetch_add(1, std::memory_order_relaxed);
+      if (range >= ranges_)
+        return;
+      CopyRange(range * kRangeSize,
+                std::min(length_, (range + 1) * kRangeSize));
+      if (delegate->ShouldYield())
+        return;
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const override {
+    const size_t next = next_range_.load(std::memory_order_relaxed);
+    const size_t remaining = next < ranges_ ? ranges_ - next : 0;
+    return std::min(ranges_, remaining + worker_count);
+  }
+
+ private:
+  // Copies what the pieces contribute to [start, end) of the result.
+  void CopyRange(size_t start, size_t end) const {
+    auto it = std::upper_bound(
+        pieces_->begin(), pieces_->end(), start,
+        [](size_t offset, const Piece& piece) {
+          return offset < piece.offset;
+        });
+    if (it != pieces_->begin())
+      --it;
+    for (; it != pieces_->end() && it->offset < end; ++it) {
+      const size_t from = std::max(start, it->offset);
+      const size_t to = std::min(end, it->offset + it->length);
+      if (from < to)
+        memcpy(dest_ + from, it->data + (from - it->offset), to - from);
+    }
+  }
+
+  char* const dest_;
+  const size_t length_;
+  const std::vector<Piece>* const pieces_;
+  const size_t ranges_;
+  std::atomic<size_t> next_range_{0};
+};
+
+// concat(list, length) copies the Uint8Arrays in `list` into a new Buffer
+// of `length` bytes and zero-fills what is left. If an element of `list` is
+// not a Uint8Array, its index is returned instead.
+void Concat(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsNumber());
+  Local<Array> list = args[0].As<Array>();
+  const size_t length = static_cast<size_t>(args[1].As<Number>()->Value());
+  CHECK_LE(length, kMaxLength);
+
+  // Look at all elements before taking pointers into them, as getters could
+  // run arbitrary code.
+  std::vector<Local<Uint8Array>> views;
+  views.reserve(list->Length());
+  for (uint32_t i = 0; i < list->Length(); i++) {
+    Local<Value> element;
+    if (!list->Get(context, i).ToLocal(&element))
+      return;
+    if (!element->IsUint8Array())
+      return args.GetReturnValue().Set(i);
+    views.push_back(element.As<Uint8Array>());
+  }
+
+  AllocatedBuffer result = AllocatedBuffer::AllocateManaged(env, length);
+  std::vector<ConcatCopyJob::Piece> pieces;
+  pieces.reserve(views.size());
+  size_t pos = 0;
+  for (Local<Uint8Array> view : views) {
+    const size_t n = std::min(view->ByteLength(), length - pos);
+    if (n == 0)
+      continue;
+    const char* data =
+        static_cast<const char*>(view->Buffer()->GetBackingStore()->Data()) +
+        view->ByteOffset();
+    pieces.push_back({data, pos, n});
+    pos += n;
+  }
+  ConcatCopyJob::CopyAll(
+      env->isolate_data()->platform(), result.data(), length, pieces);
+  if (pos < length)
+    memset(result.data() + pos, 0, length - pos);
+
+  Local<Object> buf;
+  if (result.ToPooledBuffer().ToLocal(&buf))
+    args.GetReturnValue().Set(buf);
+}
+
+// Converts a Buffer that is not used afterwards to a string. If the Buffer
+// is the whole of its ArrayBuffer, the ArrayBuffer is detached and the string
+// may share its memory instead of copying it.
+void TransferToString(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  CHECK(args[0]->IsUint8Array());
+  Local<Uint8Array> buf = args[0].As<Uint8Array>();
+  enum encoding enc = ParseEncoding(isolate, args[1], UTF8);
+  Local<ArrayBuffer> ab = buf->Buffer();
+  const size_t offset = buf->ByteOffset();
+  const size_t length = buf->ByteLength();
+
+  Local<Value> error;
+  MaybeLocal<Value> maybe_ret;
+  if (offset == 0 && length == ab->ByteLength() && ab->IsDetachable()) {
+    std::shared_ptr<BackingStore> store = ab->GetBackingStore();
+    ab->Detach();
+    maybe_ret = StringBytes::Encode(
+        isolate, std::move(store), offset, length, enc, &error);
+  } else {
+    ArrayBufferViewContents<char> contents(args[0]);
+    maybe_ret = StringBytes::Encode(
+        isolate, contents.data(), contents.length(), enc, &error);
+  }
+
+  Local<Value> ret;
+  if (!maybe_ret.ToLocal(&ret)) {
+    CHECK(!error.IsEmpty());
+    isolate->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(ret);
+}
+
+// Parses UTF-8 encoded JSON text. Large pure ASCII input is parsed where it
+// is, through a string that shares the memory, rather than being copied into
+// a string first. V8's JSON parser copies everything that ends up in the
+// result, and no JS code runs while it parses.
+void ParseJSON(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsArrayBufferView());
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+
+  Local<Value> error;
+  Local<Value> source;
+  if (!StringBytes::Encode(isolate,
+                           view->Buffer()->GetBackingStore(),
+                           view->ByteOffset(),
+                           view->ByteLength(),
+                           UTF8,
+                           &error).ToLocal(&source)) {
+    CHECK(!error.IsEmpty());
+    isolate->ThrowException(error);
+    return;
+  }
+
+  Local<Value> result;
+  if (JSON::Parse(env->context(), source.As<String>()).ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+
 // bytesCopied = copy(buffer, target[, targetStart][, sourceStart][, sourceEnd])
 void Copy(const FunctionCallbackInfo<Value> &args) {
   Environment* env = Environment::GetCurrent(args);
@@ -1058,6 +1268,176 @@ void Swap64(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+namespace {
+
+// Unsigned LEB128 varints, as used by Protocol Buffers and Kafka.
+constexpr size_t kMaxVarintLength = 10;
+constexpr size_t kVarintTooLong = static_cast<size_t>(-1);
+
+// Returns the length of the varint at `data`, 0 if it is truncated, or
+// kVarintTooLong if it does not fit into 64 bits.
+inline size_t DecodeVarint(const uint8_t* data,
+                           size_t length,
+                           uint64_t* value) {
+  if (length > 0 && data[0] < 0x80) {
+    *value = data[0];
+    return 1;
+  }
+
+  // Varints of up to 8 bytes are decoded from a single word: the first byte
+  // without a continuation bit ends the varint.
+  if (length >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    if (IsBigEndian())
+      word = BSWAP_8(word);
+    const uint64_t stop = ~word & 0x8080808080808080ull;
+    if (stop != 0) {
+      const uint64_t keep = stop ^ (stop - 1);
+      word &= keep;
+      uint64_t result = 0;
+      for (size_t i = 0; i < sizeof(word); i++)
+        result |= ((word >> (8 * i)) & 0x7f) << (7 * i);
+      *value = result;
+      // The number of bytes in `keep`.
+      return ((keep & 0x0101010101010101ull) * 0x0101010101010101ull) >> 56;
+    }
+  }
+
+  uint64_t result = 0;
+  for (size_t i = 0; i < length && i < kMaxVarintLength; i++) {
+    const uint64_t byte = data[i];
+    if (i == kMaxVarintLength - 1 && byte > 1)
+      return kVarintTooLong;
+    result |= (byte & 0x7f) << (7 * i);
+    if (byte < 0x80) {
+      *value = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+// `out` must have room for kMaxVarintLength bytes.
+inline size_t EncodeVarint(uint64_t value, uint8_t* out) {
+  size_t i = 0;
+  while (value >= 0x80) {
+    out[i++] = static_cast<uint8_t>(value) | 0x80;
+    value >>= 7;
+  }
+  out[i++] = static_cast<uint8_t>(value);
+  return i;
+}
+
+template <typename T>
+void ReadVarintsImpl(Environment* env,
+                     const uint8_t* data,
+                     size_t length,
+                     size_t offset,
+                     T* target,
+                     size_t count,
+                     const FunctionCallbackInfo<Value>& args) {
+  for (size_t i = 0; i < count; i++) {
+    uint64_t value;
+    const size_t n = DecodeVarint(data + offset, length - offset, &value);
+    if (n == 0) {
+      return THROW_ERR_BUFFER_OUT_OF_BOUNDS(
+          env, "Attempt to access memory outside buffer bounds");
+    }
+    if (n == kVarintTooLong) {
+      return THROW_ERR_OUT_OF_RANGE(
+          env, "The varint at offset %d is longer than 64 bits", offset);
+    }
+    if (value > std::numeric_limits<T>::max()) {
+      return THROW_ERR_OUT_OF_RANGE(
+          env, "The varint at offset %d does not fit into %d bits",
+          offset, sizeof(T) * 8);
+    }
+    target[i] = static_cast<T>(value);
+    offset += n;
+  }
+  args.GetReturnValue().Set(static_cast<double>(offset));
+}
+
+template <typename T>
+void WriteVarintsImpl(Environment* env,
+                      uint8_t* data,
+                      size_t length,
+                      size_t offset,
+                      const T* source,
+                      size_t count,
+                      const FunctionCallbackInfo<Value>& args) {
+  for (size_t i = 0; i < count; i++) {
+    if (length - offset >= kMaxVarintLength) {
+      offset += EncodeVarint(source[i], data + offset);
+      continue;
+    }
+    uint8_t temp[kMaxVarintLength];
+    const size_t n = EncodeVarint(source[i], temp);
+    if (n > length - offset) {
+      return THROW_ERR_BUFFER_OUT_OF_BOUNDS(
+          env, "Attempt to access memory outside buffer bounds");
+    }
+    memcpy(data + offset, temp, n);
+    offset += n;
+  }
+  args.GetReturnValue().Set(static_cast<double>(offset));
+}
+
+}  // anonymous namespace
+
+// readVarints(buffer, target, offset)
+// Fills `target`, a Uint32Array or BigUint64Array, with the varints that
+// start at `offset` and returns the offset after the last one.
+void ReadVarints(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint8Array());
+  CHECK(args[1]->IsUint32Array() || args[1]->IsBigUint64Array());
+  CHECK(args[2]->IsNumber());
+
+  ArrayBufferViewContents<uint8_t> buffer(args[0]);
+  SPREAD_BUFFER_ARG(args[1], target);
+  const size_t offset = static_cast<size_t>(args[2].As<Number>()->Value());
+  CHECK_LE(offset, buffer.length());
+
+  if (args[1]->IsUint32Array()) {
+    ReadVarintsImpl(env, buffer.data(), buffer.length(), offset,
+                    reinterpret_cast<uint32_t*>(target_data),
+                    target_length / sizeof(uint32_t), args);
+  } else {
+    ReadVarintsImpl(env, buffer.data(), buffer.length(), offset,
+                    reinterpret_cast<uint64_t*>(target_data),
+                    target_length / sizeof(uint64_t), args);
+  }
+}
+
+// writeVarints(buffer, source, offset)
+// Writes the elements of `source`, a Uint32Array or BigUint64Array, as
+// varints starting at `offset` and returns the offset after the last one.
+void WriteVarints(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint8Array());
+  CHECK(args[1]->IsUint32Array() || args[1]->IsBigUint64Array());
+  CHECK(args[2]->IsNumber());
+
+  SPREAD_BUFFER_ARG(args[0], buffer);
+  SPREAD_BUFFER_ARG(args[1], source);
+  const size_t offset = static_cast<size_t>(args[2].As<Number>()->Value());
+  CHECK_LE(offset, buffer_length);
+
+  uint8_t* data = reinterpret_cast<uint8_t*>(buffer_data);
+  if (args[1]->IsUint32Array()) {
+    WriteVarintsImpl(env, data, buffer_length, offset,
+                     reinterpret_cast<const uint32_t*>(source_data),
+                     source_length / sizeof(uint32_t), args);
+  } else {
+    WriteVarintsImpl(env, data, buffer_length, offset,
+                     reinterpret_cast<const uint64_t*>(source_data),
+                     source_length / sizeof(uint64_t), args);
+  }
+}
+
+
 // Encode a single string to a UTF-8 Uint8Array (not Buffer).
 // Used in TextEncoder.prototype.encode.
 static void EncodeUtf8String(const FunctionCallbackInfo<Value>& args) {
@@ -1113,6 +1493,8 @@ static void EncodeInto(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+
+
 void SetBufferPrototype(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -1160,6 +1542,7 @@ void Initialize(Local<Object> target,
   env->SetMethodNoSideEffect(target, "createFromString", CreateFromString);
 
   env->SetMethodNoSideEffect(target, "byteLengthUtf8", ByteLengthUtf8);
+  env->SetMethod(target, "concat", Concat);
   env->SetMethod(target, "copy", Copy);
   env->SetMethodNoSideEffect(target, "compare", Compare);
   env->SetMethodNoSideEffect(target, "compareOffset", CompareOffset);
@@ -1172,6 +1555,9 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "swap32", Swap32);
   env->SetMethod(target, "swap64", Swap64);
 
+  env->SetMethod(target, "readVarints", ReadVarints);
+  env->SetMethod(target, "writeVarints", WriteVarints);
+
   env->SetMethod(target, "encodeInto", EncodeInto);
   env->SetMethodNoSideEffect(target, "encodeUtf8String", EncodeUtf8String);
 
@@ -1199,6 +1585,9 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "ucs2Write", StringWrite<UCS2>);
   env->SetMethod(target, "utf8Write", StringWrite<UTF8>);
 
+  env->SetMethod(target, "transferToString", TransferToString);
+  env->SetMethod(target, "parseJSON", ParseJSON);
+
   env->SetMethod(target, "getZeroFillToggle", GetZeroFillToggle);
 
   Blob::Initialize(env, target);
@@ -1211,6 +1600,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(CreateFromString);
 
   registry->Register(ByteLengthUtf8);
+  registry->Register(Concat);
   registry->Register(Copy);
   registry->Register(Compare);
   registry->Register(CompareOffset);
@@ -1222,6 +1612,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Swap16);
   registry->Register(Swap32);
   registry->Register(Swap64);
+  registry->Register(ReadVarints);
+  registry->Register(WriteVarints);
 
   registry->Register(EncodeInto);
   registry->Register(EncodeUtf8String);
@@ -1241,6 +1633,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(StringWrite<HEX>);
   registry->Register(StringWrite<UCS2>);
   registry->Register(StringWrite<UTF8>);
+  registry->Register(TransferToString);
+  registry->Register(ParseJSON);
   registry->Register(GetZeroFillToggle);
 
   Blob::RegisterExternalReferences(registry);
@@ -1248,6 +1642,42 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
 }
 
 }  // namespace Buffer
+
+v8::MaybeLocal<v8::Object> BufferPool::Copy(const char* data, size_t length) {
+  CHECK_LT(length, kMaxPoolAllocation);
+  v8::Isolate* isolate = env_->isolate();
+  v8::EscapableHandleScope scope(isolate);
+
+  if (array_buffer_.IsEmpty() || kSlabSize - used_ < length) {
+    NoArrayBufferZeroFillScope no_zero_fill_scope(env_->isolate_data());
+    v8::Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, kSlabSize);
+    // Like the pool in lib/buffer.js, the slab is shared by unrelated
+    // Buffers and must not be transferred or detached.
+    if (ab->SetPrivate(env_->context(),
+                       env_->untransferable_object_private_symbol(),
+                       v8::True(isolate)).IsNothing()) {
+      return v8::MaybeLocal<v8::Object>();
+    }
+    array_buffer_.Reset(isolate, ab);
+    data_ = static_cast<char*>(ab->GetBackingStore()->Data());
+    used_ = 0;
+  }
+
+  memcpy(data_ + used_, data, length);
+  v8::Local<v8::Uint8Array> ui;
+  if (!Buffer::New(env_, array_buffer_.Get(isolate), used_, length)
+          .ToLocal(&ui)) {
+    return v8::MaybeLocal<v8::Object>();
+  }
+  // Keep the next Buffer aligned, like the JS pool does.
+  used_ = std::min(RoundUp(used_ + length, sizeof(double)), kSlabSize);
+  return scope.Escape(ui);
+}
+
+void BufferPool::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("slab", array_buffer_);
+}
+
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(buffer, node::Buffer::Initialize)
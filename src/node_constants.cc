@@ -34,6 +34,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#if defined(__linux__)
+#include <sys/uio.h>
+#endif
 
 #if HAVE_OPENSSL
 #include <openssl/ec.h>
@@ -1179,6 +1182,26 @@ NODE_DEFINE_CONSTANT(target, UV_FS_O_FILEMAP);
   NODE_DEFINE_CONSTANT(target, O_DSYNC);
 #endif
 
+#ifdef RWF_HIPRI
+  NODE_DEFINE_CONSTANT(target, RWF_HIPRI);
+#endif
+
+#ifdef RWF_DSYNC
+  NODE_DEFINE_CONSTANT(target, RWF_DSYNC);
+#endif
+
+#ifdef RWF_SYNC
+  NODE_DEFINE_CONSTANT(target, RWF_SYNC);
+#endif
+
+#ifdef RWF_NOWAIT
+  NODE_DEFINE_CONSTANT(target, RWF_NOWAIT);
+#endif
+
+#ifdef RWF_APPEND
+  NODE_DEFINE_CONSTANT(target, RWF_APPEND);
+#endif
+
 
 #ifdef O_SYMLINK
   NODE_DEFINE_CONSTANT(target, O_SYMLINK);
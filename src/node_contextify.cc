@@ -25,8 +25,11 @@
 #include "node_internals.h"
 #include "node_watchdog.h"
 #include "base_object-inl.h"
+#include "compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
+#include "node_external_reference.h"
+#include "node_main_instance.h"
 #include "module_wrap.h"
 #include "util-inl.h"
 
@@ -41,6 +44,7 @@ using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::External;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -136,39 +140,21 @@ void ContextifyContext::CleanupHook(void* arg) {
 }
 
 
-// This is an object that just keeps an internal pointer to this
-// ContextifyContext.  It's passed to the NamedPropertyHandler.  If we
-// pass the main JavaScript context object we're embedded in, then the
-// NamedPropertyHandler will store a reference to it forever and keep it
-// from getting gc'd.
-MaybeLocal<Object> ContextifyContext::CreateDataWrapper(Environment* env) {
-  Local<Object> wrapper;
-  if (!env->script_data_constructor_function()
-           ->NewInstance(env->context())
-           .ToLocal(&wrapper)) {
-    return MaybeLocal<Object>();
-  }
-
-  wrapper->SetAlignedPointerInInternalField(ContextifyContext::kSlot, this);
-  return wrapper;
-}
-
-MaybeLocal<Context> ContextifyContext::CreateV8Context(
-    Environment* env,
-    Local<Object> sandbox_obj,
-    const ContextOptions& options) {
-  EscapableHandleScope scope(env->isolate());
-  Local<FunctionTemplate> function_template =
-      FunctionTemplate::New(env->isolate());
+// The template of the global object of the contexts that are contextified
+// with a sandbox. Its interceptors get the ContextifyContext from the internal
+// field of the global object, rather than from their data, so that the same
+// template can be used by all of the contexts, including the one that is
+// deserialized from the snapshot.
+Local<ObjectTemplate> ContextifyContext::CreateGlobalTemplate(
+    Isolate* isolate, Local<String> class_name) {
+  Local<FunctionTemplate> function_template = FunctionTemplate::New(isolate);
 
-  function_template->SetClassName(sandbox_obj->GetConstructorName());
+  function_template->SetClassName(class_name);
 
   Local<ObjectTemplate> object_template =
       function_template->InstanceTemplate();
-
-  Local<Object> data_wrapper;
-  if (!CreateDataWrapper(env).ToLocal(&data_wrapper))
-    return MaybeLocal<Context>();
+  object_template->SetInternalFieldCount(
+      ContextifyContext::kInternalFieldCount);
 
   NamedPropertyHandlerConfiguration config(
       PropertyGetterCallback,
@@ -177,7 +163,7 @@ MaybeLocal<Context> ContextifyContext::CreateV8Context(
       PropertyDeleterCallback,
       PropertyEnumeratorCallback,
       PropertyDefinerCallback,
-      data_wrapper,
+      {},
       PropertyHandlerFlags::kHasNoSideEffect);
 
   IndexedPropertyHandlerConfiguration indexed_config(
@@ -187,21 +173,57 @@ MaybeLocal<Context> ContextifyContext::CreateV8Context(
       IndexedPropertyDeleterCallback,
       PropertyEnumeratorCallback,
       IndexedPropertyDefinerCallback,
-      data_wrapper,
+      {},
       PropertyHandlerFlags::kHasNoSideEffect);
 
   object_template->SetHandler(config);
   object_template->SetHandler(indexed_config);
-  Local<Context> ctx = Context::New(
-      env->isolate(),
-      nullptr,  // extensions
-      object_template,
-      {},       // global object
-      {},       // deserialization callback
+  return object_template;
+}
+
+MaybeLocal<Context> ContextifyContext::CreateV8Context(
+    Environment* env,
+    Local<Object> sandbox_obj,
+    const ContextOptions& options) {
+  Isolate* isolate = env->isolate();
+  EscapableHandleScope scope(isolate);
+  MicrotaskQueue* queue =
       microtask_queue() ?
           microtask_queue().get() :
-          env->isolate()->GetCurrentContext()->GetMicrotaskQueue());
+          isolate->GetCurrentContext()->GetMicrotaskQueue();
+
+  Local<Context> ctx;
+  if (sandbox_obj.IsEmpty()) {
+    // Without a sandbox, there is nothing to intercept, and the context is
+    // the one that V8 deserializes from its own snapshot.
+    ctx = Context::New(isolate, nullptr, {}, {}, {}, queue);
+  } else {
+    Local<String> class_name = sandbox_obj->GetConstructorName();
+    // The snapshot has a context with the template of plain objects. It does
+    // not exist if Node.js was built without a snapshot, or when it is
+    // embedded with an isolate that was not deserialized from one.
+    if (!class_name->StringEquals(FIXED_ONE_BYTE_STRING(isolate, "Object")) ||
+        !Context::FromSnapshot(isolate,
+                               NodeMainInstance::kNodeVMContextIndex,
+                               {DeserializeNodeInternalFields, nullptr},
+                               nullptr,  // extensions
+                               {},       // global object
+                               queue).ToLocal(&ctx)) {
+      ctx = Context::New(isolate,
+                         nullptr,  // extensions
+                         CreateGlobalTemplate(isolate, class_name),
+                         {},       // global object
+                         {},       // deserialization callback
+                         queue);
+    }
+  }
   if (ctx.IsEmpty()) return MaybeLocal<Context>();
+  // The interceptors find the ContextifyContext through the global object,
+  // and ignore the accesses until context_ is set.
+  if (!sandbox_obj.IsEmpty()) {
+    ctx->Global()->GetPrototype().As<Object>()
+        ->SetAlignedPointerInInternalField(ContextifyContext::kSlot, this);
+  }
   // Only partially initialize the context - the primordials are left out
   // and only initialized when necessary.
   InitializeContextRuntime(ctx);
@@ -212,18 +234,24 @@ MaybeLocal<Context> ContextifyContext::CreateV8Context(
 
   ctx->SetSecurityToken(env->context()->GetSecurityToken());
 
-  // We need to tie the lifetime of the sandbox object with the lifetime of
-  // newly created context. We do this by making them hold references to each
-  // other. The context can directly hold a reference to the sandbox as an
-  // embedder data field. However, we cannot hold a reference to a v8::Context
-  // directly in an Object, we instead hold onto the new context's global
-  // object instead (which then has a reference to the context).
-  ctx->SetEmbedderData(ContextEmbedderIndex::kSandboxObject, sandbox_obj);
-  sandbox_obj->SetPrivate(env->context(),
-                          env->contextify_global_private_symbol(),
-                          ctx->Global());
-
-  Utf8Value name_val(env->isolate(), options.name);
+  if (sandbox_obj.IsEmpty()) {
+    // The global proxy takes the place of the sandbox.
+    ctx->SetEmbedderData(ContextEmbedderIndex::kSandboxObject, ctx->Global());
+  } else {
+    // We need to tie the lifetime of the sandbox object with the lifetime of
+    // newly created context. We do this by making them hold references to
+    // each other. The context can directly hold a reference to the sandbox as
+    // an embedder data field. However, we cannot hold a reference to a
+    // v8::Context directly in an Object, we instead hold onto the new
+    // context's global object instead (which then has a reference to the
+    // context).
+    ctx->SetEmbedderData(ContextEmbedderIndex::kSandboxObject, sandbox_obj);
+    sandbox_obj->SetPrivate(env->context(),
+                            env->contextify_global_private_symbol(),
+                            ctx->Global());
+  }
+
+  Utf8Value name_val(isolate, options.name);
   ctx->AllowCodeGenerationFromStrings(options.allow_code_gen_strings->IsTrue());
   ctx->SetEmbedderData(ContextEmbedderIndex::kAllowWasmCodeGeneration,
                        options.allow_code_gen_wasm);
@@ -231,7 +259,7 @@ MaybeLocal<Context> ContextifyContext::CreateV8Context(
   ContextInfo info(*name_val);
 
   if (!options.origin.IsEmpty()) {
-    Utf8Value origin_val(env->isolate(), options.origin);
+    Utf8Value origin_val(isolate, options.origin);
     info.origin = *origin_val;
   }
 
@@ -242,32 +270,48 @@ MaybeLocal<Context> ContextifyContext::CreateV8Context(
 
 
 void ContextifyContext::Init(Environment* env, Local<Object> target) {
-  Local<FunctionTemplate> function_template =
-      FunctionTemplate::New(env->isolate());
-  function_template->InstanceTemplate()->SetInternalFieldCount(
-      ContextifyContext::kInternalFieldCount);
-  env->set_script_data_constructor_function(
-      function_template->GetFunction(env->context()).ToLocalChecked());
-
   env->SetMethod(target, "makeContext", MakeContext);
   env->SetMethod(target, "isContext", IsContext);
   env->SetMethod(target, "compileFunction", CompileFunction);
 }
 
+void ContextifyContext::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(MakeContext);
+  registry->Register(IsContext);
+  registry->Register(CompileFunction);
+
+  registry->Register(PropertyGetterCallback);
+  registry->Register(PropertySetterCallback);
+  registry->Register(PropertyDescriptorCallback);
+  registry->Register(PropertyDeleterCallback);
+  registry->Register(PropertyEnumeratorCallback);
+  registry->Register(PropertyDefinerCallback);
+  registry->Register(IndexedPropertyGetterCallback);
+  registry->Register(IndexedPropertySetterCallback);
+  registry->Register(IndexedPropertyDescriptorCallback);
+  registry->Register(IndexedPropertyDeleterCallback);
+  registry->Register(IndexedPropertyDefinerCallback);
+}
+
 
-// makeContext(sandbox, name, origin, strings, wasm);
+// makeContext(sandbox, name, origin, strings, wasm, microtaskQueue);
+// If the sandbox is undefined, the context is not contextified, and its
+// global proxy is returned to be used in place of the sandbox.
 void ContextifyContext::MakeContext(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
   CHECK_EQ(args.Length(), 6);
-  CHECK(args[0]->IsObject());
-  Local<Object> sandbox = args[0].As<Object>();
-
-  // Don't allow contextifying a sandbox multiple times.
-  CHECK(
-      !sandbox->HasPrivate(
-          env->context(),
-          env->contextify_context_private_symbol()).FromJust());
+  CHECK(args[0]->IsObject() || args[0]->IsUndefined());
+  Local<Object> sandbox;
+  if (args[0]->IsObject()) {
+    sandbox = args[0].As<Object>();
+    // Don't allow contextifying a sandbox multiple times.
+    CHECK(
+        !sandbox->HasPrivate(
+            env->context(),
+            env->contextify_context_private_symbol()).FromJust());
+  }
 
   ContextOptions options;
 
@@ -304,6 +348,10 @@ void ContextifyContext::MakeContext(const FunctionCallbackInfo<Value>& args) {
   if (context_ptr->context().IsEmpty())
     return;
 
+  if (sandbox.IsEmpty()) {
+    sandbox = context_ptr->global_proxy();
+    args.GetReturnValue().Set(sandbox);
+  }
   sandbox->SetPrivate(
       env->context(),
       env->contextify_context_private_symbol(),
@@ -349,20 +397,25 @@ ContextifyContext* ContextifyContext::ContextFromContextifiedSandbox(
 // static
 template <typename T>
 ContextifyContext* ContextifyContext::Get(const PropertyCallbackInfo<T>& args) {
-  Local<Value> data = args.Data();
+  // The holder is the global object.
   return static_cast<ContextifyContext*>(
-      data.As<Object>()->GetAlignedPointerFromInternalField(
+      args.Holder()->GetAlignedPointerFromInternalField(
           ContextifyContext::kSlot));
 }
 
+// The pointer is null while V8 sets up a context that is deserialized from
+// the snapshot, e.g. when it installs extensions such as gc().
+static inline bool IsStillInitializing(const ContextifyContext* ctx) {
+  return ctx == nullptr || ctx->context().IsEmpty();
+}
+
 // static
 void ContextifyContext::PropertyGetterCallback(
     Local<Name> property,
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   Local<Context> context = ctx->context();
@@ -390,8 +443,7 @@ void ContextifyContext::PropertySetterCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   auto attributes = PropertyAttribute::None;
@@ -450,8 +502,7 @@ void ContextifyContext::PropertyDescriptorCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   Local<Context> context = ctx->context();
@@ -473,8 +524,7 @@ void ContextifyContext::PropertyDefinerCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   Local<Context> context = ctx->context();
@@ -534,8 +584,7 @@ void ContextifyContext::PropertyDeleterCallback(
     const PropertyCallbackInfo<Boolean>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   Maybe<bool> success = ctx->sandbox()->Delete(ctx->context(), property);
@@ -553,8 +602,7 @@ void ContextifyContext::PropertyEnumeratorCallback(
     const PropertyCallbackInfo<Array>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   Local<Array> properties;
@@ -571,8 +619,7 @@ void ContextifyContext::IndexedPropertyGetterCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   ContextifyContext::PropertyGetterCallback(
@@ -586,8 +633,7 @@ void ContextifyContext::IndexedPropertySetterCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   ContextifyContext::PropertySetterCallback(
@@ -600,8 +646,7 @@ void ContextifyContext::IndexedPropertyDescriptorCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   ContextifyContext::PropertyDescriptorCallback(
@@ -615,8 +660,7 @@ void ContextifyContext::IndexedPropertyDefinerCallback(
     const PropertyCallbackInfo<Value>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   ContextifyContext::PropertyDefinerCallback(
@@ -629,8 +673,7 @@ void ContextifyContext::IndexedPropertyDeleterCallback(
     const PropertyCallbackInfo<Boolean>& args) {
   ContextifyContext* ctx = ContextifyContext::Get(args);
 
-  // Still initializing
-  if (ctx->context_.IsEmpty())
+  if (IsStillInitializing(ctx))
     return;
 
   Maybe<bool> success = ctx->sandbox()->Delete(ctx->context(), index);
@@ -661,6 +704,14 @@ void ContextifyScript::Init(Environment* env, Local<Object> target) {
   env->set_script_context_constructor_template(script_tmpl);
 }
 
+void ContextifyScript::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(CreateCachedData);
+  registry->Register(RunInContext);
+  registry->Register(RunInThisContext);
+}
+
 void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -720,12 +771,25 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
         "filename", TRACE_STR_COPY(*fn));
   }
 
+  // The --experimental-vm-compile-cache cache is only used when no cached
+  // data is given.
+  std::string vm_cache_key;
+  VMCompileCache::Data vm_cache_data;
+  if (env->options()->experimental_vm_compile_cache &&
+      cached_data_buf.IsEmpty()) {
+    vm_cache_key = VMCompileCache::GetKey(
+        isolate, CachedCodeType::kVMScript, Local<String>(), code, {});
+    vm_cache_data = per_process::vm_compile_cache.Get(vm_cache_key);
+  }
+
   ScriptCompiler::CachedData* cached_data = nullptr;
   if (!cached_data_buf.IsEmpty()) {
     uint8_t* data = static_cast<uint8_t*>(
         cached_data_buf->Buffer()->GetBackingStore()->Data());
     cached_data = new ScriptCompiler::CachedData(
         data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (vm_cache_data) {
+    cached_data = VMCompileCache::CreateCachedData(vm_cache_data);
   }
 
   Local<PrimitiveArray> host_defined_options =
@@ -774,14 +838,29 @@ void ContextifyScript::New(const FunctionCallbackInfo<Value>& args) {
   }
   contextify_script->script_.Reset(isolate, v8_script.ToLocalChecked());
 
-  if (compile_options == ScriptCompiler::kConsumeCodeCache) {
+  std::unique_ptr<ScriptCompiler::CachedData> new_cached_data;
+  if (!vm_cache_key.empty()) {
+    bool rejected = vm_cache_data && source.GetCachedData()->rejected;
+    if (vm_cache_data && !rejected) {
+      per_process::vm_compile_cache.RecordHit();
+    } else {
+      new_cached_data.reset(
+          ScriptCompiler::CreateCodeCache(v8_script.ToLocalChecked()));
+      per_process::vm_compile_cache.RecordMiss(
+          vm_cache_key, new_cached_data.get(), rejected);
+    }
+  }
+
+  if (!cached_data_buf.IsEmpty()) {
     args.This()->Set(
         env->context(),
         env->cached_data_rejected_string(),
         Boolean::New(isolate, source.GetCachedData()->rejected)).Check();
   } else if (produce_cached_data) {
     std::unique_ptr<ScriptCompiler::CachedData> cached_data {
-      ScriptCompiler::CreateCodeCache(v8_script.ToLocalChecked()) };
+      new_cached_data ?
+          new_cached_data.release() :
+          ScriptCompiler::CreateCodeCache(v8_script.ToLocalChecked()) };
     bool cached_data_produced = cached_data != nullptr;
     if (cached_data_produced) {
       MaybeLocal<Object> buf = Buffer::Copy(
@@ -1077,13 +1156,12 @@ void ContextifyContext::CompileFunction(
     params_buf = args[8].As<Array>();
   }
 
-  // Read cache from cached data buffer
-  ScriptCompiler::CachedData* cached_data = nullptr;
-  if (!cached_data_buf.IsEmpty()) {
-    uint8_t* data = static_cast<uint8_t*>(
-        cached_data_buf->Buffer()->GetBackingStore()->Data());
-    cached_data = new ScriptCompiler::CachedData(
-      data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  // Argument 10: whether to use the --code-cache-dir cache (optional)
+  std::unique_ptr<CompileCacheEntry> cache_entry;
+  CompileCacheHandler* cache_handler = env->compile_cache_handler();
+  if (args[9]->IsTrue() && cache_handler != nullptr &&
+      cached_data_buf.IsEmpty() && !produce_cached_data) {
+    cache_entry = cache_handler->Get(filename, code, CachedCodeType::kCommonJS);
   }
 
   // Get the function id
@@ -1110,14 +1188,6 @@ void ContextifyContext::CompileFunction(
                       false,             // is ES Module
                       host_defined_options);
 
-  ScriptCompiler::Source source(code, origin, cached_data);
-  ScriptCompiler::CompileOptions options;
-  if (source.GetCachedData() == nullptr) {
-    options = ScriptCompiler::kNoCompileOptions;
-  } else {
-    options = ScriptCompiler::kConsumeCodeCache;
-  }
-
   TryCatchScope try_catch(env);
   Context::Scope scope(parsing_context);
 
@@ -1143,6 +1213,46 @@ void ContextifyContext::CompileFunction(
     }
   }
 
+  // The --experimental-vm-compile-cache cache is only used when no other
+  // cache is. Functions with context extensions are not cached. CommonJS
+  // modules are cached by their filename and source, so that a module that
+  // several Workers load is only compiled by the first one.
+  const bool is_module = args[9]->IsTrue();
+  std::string vm_cache_key;
+  VMCompileCache::Data vm_cache_data;
+  if (env->options()->experimental_vm_compile_cache &&
+      cached_data_buf.IsEmpty() && !cache_entry &&
+      context_extensions.empty()) {
+    vm_cache_key = VMCompileCache::GetKey(
+        isolate,
+        is_module ? CachedCodeType::kCommonJS : CachedCodeType::kVMFunction,
+        is_module ? filename : Local<String>(),
+        code,
+        params);
+    vm_cache_data = per_process::vm_compile_cache.Get(vm_cache_key);
+  }
+
+  // Read cache from cached data buffer
+  ScriptCompiler::CachedData* cached_data = nullptr;
+  if (!cached_data_buf.IsEmpty()) {
+    uint8_t* data = static_cast<uint8_t*>(
+        cached_data_buf->Buffer()->GetBackingStore()->Data());
+    cached_data = new ScriptCompiler::CachedData(
+      data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (cache_entry) {
+    cached_data = cache_entry->CreateCachedData();
+  } else if (vm_cache_data) {
+    cached_data = VMCompileCache::CreateCachedData(vm_cache_data);
+  }
+
+  ScriptCompiler::Source source(code, origin, cached_data);
+  ScriptCompiler::CompileOptions options;
+  if (source.GetCachedData() == nullptr) {
+    options = ScriptCompiler::kNoCompileOptions;
+  } else {
+    options = ScriptCompiler::kConsumeCodeCache;
+  }
+
   Local<ScriptOrModule> script;
   MaybeLocal<Function> maybe_fn = ScriptCompiler::CompileFunctionInContext(
       parsing_context, &source, params.size(), params.data(),
@@ -1158,6 +1268,26 @@ void ContextifyContext::CompileFunction(
     return;
   }
 
+  if (cache_entry) {
+    cache_handler->MaybeSave(
+        cache_entry.get(),
+        fn,
+        options == ScriptCompiler::kConsumeCodeCache &&
+            source.GetCachedData()->rejected);
+  }
+
+  std::unique_ptr<ScriptCompiler::CachedData> new_cached_data;
+  if (!vm_cache_key.empty()) {
+    bool rejected = vm_cache_data && source.GetCachedData()->rejected;
+    if (vm_cache_data && !rejected) {
+      per_process::vm_compile_cache.RecordHit();
+    } else {
+      new_cached_data.reset(ScriptCompiler::CreateCodeCacheForFunction(fn));
+      per_process::vm_compile_cache.RecordMiss(
+          vm_cache_key, new_cached_data.get(), rejected);
+    }
+  }
+
   Local<Object> cache_key;
   if (!env->compiled_fn_entry_template()->NewInstance(
            context).ToLocal(&cache_key)) {
@@ -1175,7 +1305,8 @@ void ContextifyContext::CompileFunction(
 
   if (produce_cached_data) {
     const std::unique_ptr<ScriptCompiler::CachedData> cached_data(
-        ScriptCompiler::CreateCodeCacheForFunction(fn));
+        new_cached_data ? new_cached_data.release() :
+                          ScriptCompiler::CreateCodeCacheForFunction(fn));
     bool cached_data_produced = cached_data != nullptr;
     if (cached_data_produced) {
       MaybeLocal<Object> buf = Buffer::Copy(
@@ -1210,17 +1341,60 @@ CompiledFnEntry::CompiledFnEntry(Environment* env,
                                  Local<Object> object,
                                  uint32_t id,
                                  Local<ScriptOrModule> script)
-    : BaseObject(env, object),
+    : SnapshotableObject(env, object, type_int),
       id_(id),
       script_(env->isolate(), script) {
   script_.SetWeak(this, WeakCallback, v8::WeakCallbackType::kParameter);
 }
 
+CompiledFnEntry::CompiledFnEntry(Environment* env,
+                                 Local<Object> object,
+                                 uint32_t id)
+    : SnapshotableObject(env, object, type_int), id_(id) {}
+
 CompiledFnEntry::~CompiledFnEntry() {
   env()->id_to_function_map.erase(id_);
-  script_.ClearWeak();
+  if (!script_.IsEmpty())
+    script_.ClearWeak();
+}
+
+struct CompiledFnEntryInfo : public InternalFieldInfo {
+  uint32_t id;
+};
+
+void CompiledFnEntry::PrepareForSerialization(Local<Context> context,
+                                              v8::SnapshotCreator* creator) {
+  // The id is all that is needed for ImportModuleDynamically() to find the
+  // entry again. V8 does not allow global handles to objects that are not
+  // added to the snapshot, so the script is dropped and the object is added.
+  script_.Reset();
+  creator->AddData(context, object());
 }
 
+InternalFieldInfo* CompiledFnEntry::Serialize(int index) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  CompiledFnEntryInfo* info = static_cast<CompiledFnEntryInfo*>(
+      InternalFieldInfo::New(type(), sizeof(CompiledFnEntryInfo)));
+  info->id = id_;
+  return info;
+}
+
+void CompiledFnEntry::Deserialize(Local<Context> context,
+                                  Local<Object> holder,
+                                  int index,
+                                  InternalFieldInfo* info) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  HandleScope scope(context->GetIsolate());
+  Environment* env = Environment::GetCurrent(context);
+  uint32_t id = static_cast<CompiledFnEntryInfo*>(info)->id;
+  CompiledFnEntry* entry = new CompiledFnEntry(env, holder, id);
+  env->id_to_function_map.emplace(id, entry);
+  env->reserve_function_id(id);
+}
+
+// TODO(addaleax): Remove once we're on C++17.
+constexpr FastStringKey CompiledFnEntry::type_name;
+
 static void StartSigintWatchdog(const FunctionCallbackInfo<Value>& args) {
   int ret = SigintWatchdogHelper::GetInstance()->Start();
   args.GetReturnValue().Set(ret == 0);
@@ -1259,6 +1433,25 @@ static void MeasureMemory(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(promise);
 }
 
+// Fills the Float64Array with the statistics of the
+// --experimental-vm-compile-cache cache.
+static void GetCompileCacheStatistics(
+    const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 5);
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+  VMCompileCache::Statistics statistics =
+      per_process::vm_compile_cache.GetStatistics();
+  fields[0] = statistics.hits;
+  fields[1] = statistics.misses;
+  fields[2] = statistics.rejections;
+  fields[3] = statistics.entries;
+  fields[4] = statistics.size;
+}
+
 MicrotaskQueueWrap::MicrotaskQueueWrap(Environment* env, Local<Object> obj)
   : BaseObject(env, obj),
     microtask_queue_(
@@ -1285,6 +1478,11 @@ void MicrotaskQueueWrap::Init(Environment* env, Local<Object> target) {
   env->SetConstructorFunction(target, "MicrotaskQueue", tmpl);
 }
 
+void MicrotaskQueueWrap::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 
 void Initialize(Local<Object> target,
                 Local<Value> unused,
@@ -1337,9 +1535,25 @@ void Initialize(Local<Object> target,
   target->Set(context, env->constants_string(), constants).Check();
 
   env->SetMethod(target, "measureMemory", MeasureMemory);
+  env->SetMethodNoSideEffect(
+      target, "getCompileCacheStatistics", GetCompileCacheStatistics);
+}
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  ContextifyContext::RegisterExternalReferences(registry);
+  ContextifyScript::RegisterExternalReferences(registry);
+  MicrotaskQueueWrap::RegisterExternalReferences(registry);
+
+  registry->Register(StartSigintWatchdog);
+  registry->Register(StopSigintWatchdog);
+  registry->Register(WatchdogHasPendingSigint);
+  registry->Register(MeasureMemory);
+  registry->Register(GetCompileCacheStatistics);
 }
 
 }  // namespace contextify
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(contextify, node::contextify::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(contextify,
+                               node::contextify::RegisterExternalReferences)
@@ -6,8 +6,11 @@
 #include "base_object-inl.h"
 #include "node_context_data.h"
 #include "node_errors.h"
+#include "node_snapshotable.h"
 
 namespace node {
+class ExternalReferenceRegistry;
+
 namespace contextify {
 
 class MicrotaskQueueWrap : public BaseObject {
@@ -17,6 +20,7 @@ class MicrotaskQueueWrap : public BaseObject {
   const std::shared_ptr<v8::MicrotaskQueue>& microtask_queue() const;
 
   static void Init(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // This could have methods for running the microtask queue, if we ever decide
@@ -47,11 +51,14 @@ class ContextifyContext {
   ~ContextifyContext();
   static void CleanupHook(void* arg);
 
-  v8::MaybeLocal<v8::Object> CreateDataWrapper(Environment* env);
+  // The sandbox is empty for the contexts that are not contextified.
   v8::MaybeLocal<v8::Context> CreateV8Context(Environment* env,
                                               v8::Local<v8::Object> sandbox_obj,
                                               const ContextOptions& options);
+  static v8::Local<v8::ObjectTemplate> CreateGlobalTemplate(
+      v8::Isolate* isolate, v8::Local<v8::String> class_name);
   static void Init(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static ContextifyContext* ContextFromContextifiedSandbox(
       Environment* env,
@@ -141,6 +148,7 @@ class ContextifyScript : public BaseObject {
   ~ContextifyScript() override;
 
   static void Init(Environment* env, v8::Local<v8::Object> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static bool InstanceOf(Environment* env, const v8::Local<v8::Value>& args);
   static void CreateCachedData(
@@ -162,7 +170,7 @@ class ContextifyScript : public BaseObject {
   uint32_t id_;
 };
 
-class CompiledFnEntry final : public BaseObject {
+class CompiledFnEntry final : public SnapshotableObject {
  public:
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(CompiledFnEntry)
@@ -176,7 +184,17 @@ class CompiledFnEntry final : public BaseObject {
 
   bool IsNotIndicativeOfMemoryLeakAtExit() const override { return true; }
 
+  SERIALIZABLE_OBJECT_METHODS()
+  static constexpr FastStringKey type_name{
+      "node::contextify::CompiledFnEntry"};
+  static constexpr EmbedderObjectType type_int =
+      EmbedderObjectType::k_compiled_fn_entry;
+
  private:
+  // The script is not available when the entry is deserialized from a
+  // snapshot, in which case the entry lives as long as the Environment.
+  CompiledFnEntry(Environment* env, v8::Local<v8::Object> object, uint32_t id);
+
   uint32_t id_;
   v8::Global<v8::ScriptOrModule> script_;
 
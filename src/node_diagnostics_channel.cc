@@ -0,0 +1,150 @@
+#include "node_diagnostics_channel.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_external_reference.h"
+#include "node_internals.h"
+#include "util-inl.h"
+#include "v8.h"
+
+namespace node {
+namespace diagnostics_channel {
+
+using v8::Context;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+namespace {
+
+struct SubscribersInfo : public InternalFieldInfo {
+  uint32_t subscribers[kChannelCount];
+};
+
+}  // anonymous namespace
+
+BindingData::BindingData(Environment* env, Local<Object> obj)
+    : SnapshotableObject(env, obj, type_int),
+      subscribers(env->isolate(), kChannelCount) {
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  obj->Set(context,
+           FIXED_ONE_BYTE_STRING(isolate, "subscribers"),
+           subscribers.GetJSArray()).Check();
+}
+
+void BindingData::PrepareForSerialization(Local<Context> context,
+                                          v8::SnapshotCreator* creator) {
+  // The buffer is re-created by the constructor, and the counts are copied
+  // into it after deserialization.
+  for (uint32_t i = 0; i < kChannelCount; i++)
+    serialized_subscribers_[i] = subscribers[i];
+  subscribers.Release();
+}
+
+InternalFieldInfo* BindingData::Serialize(int index) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  SubscribersInfo* info = static_cast<SubscribersInfo*>(
+      InternalFieldInfo::New(type(), sizeof(SubscribersInfo)));
+  for (uint32_t i = 0; i < kChannelCount; i++)
+    info->subscribers[i] = serialized_subscribers_[i];
+  return info;
+}
+
+void BindingData::Deserialize(Local<Context> context,
+                              Local<Object> holder,
+                              int index,
+                              InternalFieldInfo* info) {
+  DCHECK_EQ(index, BaseObject::kSlot);
+  HandleScope scope(context->GetIsolate());
+  Environment* env = Environment::GetCurrent(context);
+  BindingData* binding = env->AddBindingData<BindingData>(context, holder);
+  CHECK_NOT_NULL(binding);
+  const SubscribersInfo* subscribers_info =
+      static_cast<const SubscribersInfo*>(info);
+  for (uint32_t i = 0; i < kChannelCount; i++)
+    binding->subscribers[i] = subscribers_info->subscribers[i];
+}
+
+void BindingData::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("subscribers", subscribers);
+}
+
+// TODO(addaleax): Remove once we're on C++17.
+constexpr FastStringKey BindingData::type_name;
+
+bool HasSubscribers(Environment* env, Channel channel) {
+  BindingData* binding =
+      Environment::GetBindingData<BindingData>(env->context());
+  // Nothing can have subscribed before diagnostics_channel was loaded.
+  return binding != nullptr && binding->subscribers[channel] > 0;
+}
+
+void Publish(Environment* env, Channel channel, Local<Value> message) {
+  Local<Function> publish = env->diagnostics_channel_publish_function();
+  if (publish.IsEmpty()) return;
+  Local<Value> argv[] = {
+    Integer::NewFromUnsigned(env->isolate(), channel),
+    message
+  };
+  // The subscribers run synchronously, as they do for channels that are
+  // published to from JavaScript, and their errors are reported by
+  // lib/diagnostics_channel.js.
+  USE(MakeSyncCallback(env->isolate(),
+                       env->process_object(),
+                       publish,
+                       arraysize(argv),
+                       argv));
+}
+
+namespace {
+
+void SetPublishFunction(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFunction());
+  env->set_diagnostics_channel_publish_function(args[0].As<Function>());
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  Isolate* isolate = env->isolate();
+  BindingData* const binding_data =
+      env->AddBindingData<BindingData>(context, target);
+  if (binding_data == nullptr) return;
+
+  env->SetMethod(target, "setPublishFunction", SetPublishFunction);
+
+  Local<Object> channels = Object::New(isolate);
+#define V(id, name)                                                            \
+  channels->Set(context,                                                       \
+                FIXED_ONE_BYTE_STRING(isolate, name),                          \
+                Integer::NewFromUnsigned(isolate, id)).Check();
+  NATIVE_DIAGNOSTICS_CHANNELS(V)
+#undef V
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "nativeChannels"),
+              channels).Check();
+}
+
+}  // anonymous namespace
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SetPublishFunction);
+}
+
+}  // namespace diagnostics_channel
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(diagnostics_channel,
+                                   node::diagnostics_channel::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(
+    diagnostics_channel,
+    node::diagnostics_channel::RegisterExternalReferences)
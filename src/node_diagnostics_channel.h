@@ -0,0 +1,73 @@
+#ifndef SRC_NODE_DIAGNOSTICS_CHANNEL_H_
+#define SRC_NODE_DIAGNOSTICS_CHANNEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "aliased_buffer.h"
+#include "node_snapshotable.h"
+#include "v8.h"
+
+#include <array>
+
+namespace node {
+class Environment;
+class ExternalReferenceRegistry;
+struct InternalFieldInfo;
+
+namespace diagnostics_channel {
+
+// The diagnostics_channel channels that native code publishes to, with the
+// names that they are looked up with in JavaScript. The messages are
+// documented in doc/api/diagnostics_channel.md.
+#define NATIVE_DIAGNOSTICS_CHANNELS(V)                                         \
+  V(kFsRequestComplete, "fs.request.complete")                                 \
+  V(kHttpParserHeadersComplete, "http.parser.headers.complete")                \
+  V(kNetTcpConnect, "net.tcp.connect")
+
+enum Channel : uint32_t {
+#define V(id, _) id,
+  NATIVE_DIAGNOSTICS_CHANNELS(V)
+#undef V
+  kChannelCount
+};
+
+class BindingData : public SnapshotableObject {
+ public:
+  BindingData(Environment* env, v8::Local<v8::Object> obj);
+
+  SERIALIZABLE_OBJECT_METHODS()
+  static constexpr FastStringKey type_name{
+      "node::diagnostics_channel::BindingData"};
+  static constexpr EmbedderObjectType type_int =
+      EmbedderObjectType::k_diagnostics_channel_binding_data;
+
+  // The number of subscribers of each channel. It is kept up to date by
+  // lib/diagnostics_channel.js, so that native code can check it without
+  // calling into JavaScript.
+  AliasedUint32Array subscribers;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_SELF_SIZE(BindingData)
+  SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  // The counts of the subscribers, while `subscribers` is released for
+  // serialization.
+  std::array<uint32_t, kChannelCount> serialized_subscribers_;
+};
+
+// Returns whether the channel has subscribers. This never calls into
+// JavaScript, and the message should only be created if it returns true.
+bool HasSubscribers(Environment* env, Channel channel);
+
+// Publishes the message to the subscribers of the channel.
+void Publish(Environment* env, Channel channel, v8::Local<v8::Value> message);
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+}  // namespace diagnostics_channel
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_DIAGNOSTICS_CHANNEL_H_
@@ -41,8 +41,12 @@ class RealEnvStore final : public KVStore {
   int32_t Query(const char* key) const override;
   void Delete(Isolate* isolate, Local<String> key) override;
   Local<Array> Enumerate(Isolate* isolate) const override;
+
+  std::shared_ptr<KVStore> Clone(Isolate* isolate) const override;
 };
 
+// The map is shared between clones until one of them is modified, so that
+// starting a Worker with a copy of its parent's environment is O(1).
 class MapKVStore final : public KVStore {
  public:
   MaybeLocal<String> Get(Isolate* isolate, Local<String> key) const override;
@@ -55,12 +59,22 @@ class MapKVStore final : public KVStore {
 
   std::shared_ptr<KVStore> Clone(Isolate* isolate) const override;
 
-  MapKVStore() = default;
-  MapKVStore(const MapKVStore& other) : KVStore(), map_(other.map_) {}
+  using Map = std::unordered_map<std::string, std::string>;
+
+  MapKVStore() : map_(std::make_shared<Map>()) {}
+  explicit MapKVStore(std::shared_ptr<Map> map) : map_(std::move(map)) {}
+  MapKVStore(const MapKVStore& other) : KVStore() {
+    Mutex::ScopedLock lock(other.mutex_);
+    map_ = other.map_;
+  }
 
  private:
+  // Returns a map that is not shared with any clone. Must be called with
+  // mutex_ held.
+  Map* MutableMap();
+
   mutable Mutex mutex_;
-  std::unordered_map<std::string, std::string> map_;
+  std::shared_ptr<Map> map_;
 };
 
 namespace per_process {
@@ -192,6 +206,30 @@ Local<Array> RealEnvStore::Enumerate(Isolate* isolate) const {
   return Array::New(isolate, env_v.out(), env_v_index);
 }
 
+// Copies the environment with a single lock and without creating V8 strings
+// for every variable, unlike the generic KVStore::Clone().
+std::shared_ptr<KVStore> RealEnvStore::Clone(Isolate* isolate) const {
+  auto map = std::make_shared<MapKVStore::Map>();
+  {
+    Mutex::ScopedLock lock(per_process::env_var_mutex);
+    uv_env_item_t* items;
+    int count;
+
+    auto cleanup = OnScopeLeave([&]() { uv_os_free_environ(items, count); });
+    CHECK_EQ(uv_os_environ(&items, &count), 0);
+
+    map->reserve(count);
+    for (int i = 0; i < count; i++) {
+#ifdef _WIN32
+      if (items[i].name[0] == '=') continue;
+#endif
+      if (items[i].name[0] == '\0') continue;
+      map->emplace(items[i].name, items[i].value);
+    }
+  }
+  return std::make_shared<MapKVStore>(std::move(map));
+}
+
 std::shared_ptr<KVStore> KVStore::Clone(Isolate* isolate) const {
   HandleScope handle_scope(isolate);
   Local<Context> context = isolate->GetCurrentContext();
@@ -209,10 +247,16 @@ std::shared_ptr<KVStore> KVStore::Clone(Isolate* isolate) const {
   return copy;
 }
 
+MapKVStore::Map* MapKVStore::MutableMap() {
+  if (map_.use_count() > 1)
+    map_ = std::make_shared<Map>(*map_);
+  return map_.get();
+}
+
 Maybe<std::string> MapKVStore::Get(const char* key) const {
   Mutex::ScopedLock lock(mutex_);
-  auto it = map_.find(key);
-  return it == map_.end() ? Nothing<std::string>() : Just(it->second);
+  auto it = map_->find(key);
+  return it == map_->end() ? Nothing<std::string>() : Just(it->second);
 }
 
 MaybeLocal<String> MapKVStore::Get(Isolate* isolate, Local<String> key) const {
@@ -229,14 +273,14 @@ void MapKVStore::Set(Isolate* isolate, Local<String> key, Local<String> value) {
   Utf8Value key_str(isolate, key);
   Utf8Value value_str(isolate, value);
   if (*key_str != nullptr && key_str.length() > 0 && *value_str != nullptr) {
-    map_[std::string(*key_str, key_str.length())] =
+    (*MutableMap())[std::string(*key_str, key_str.length())] =
         std::string(*value_str, value_str.length());
   }
 }
 
 int32_t MapKVStore::Query(const char* key) const {
   Mutex::ScopedLock lock(mutex_);
-  return map_.find(key) == map_.end() ? -1 : 0;
+  return map_->find(key) == map_->end() ? -1 : 0;
 }
 
 int32_t MapKVStore::Query(Isolate* isolate, Local<String> key) const {
@@ -247,14 +291,14 @@ int32_t MapKVStore::Query(Isolate* isolate, Local<String> key) const {
 void MapKVStore::Delete(Isolate* isolate, Local<String> key) {
   Mutex::ScopedLock lock(mutex_);
   Utf8Value str(isolate, key);
-  map_.erase(std::string(*str, str.length()));
+  MutableMap()->erase(std::string(*str, str.length()));
 }
 
 Local<Array> MapKVStore::Enumerate(Isolate* isolate) const {
   Mutex::ScopedLock lock(mutex_);
   std::vector<Local<Value>> values;
-  values.reserve(map_.size());
-  for (const auto& pair : map_) {
+  values.reserve(map_->size());
+  for (const auto& pair : *map_) {
     values.emplace_back(
         String::NewFromUtf8(isolate, pair.first.data(),
                             NewStringType::kNormal, pair.first.size())
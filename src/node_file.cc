@@ -23,7 +23,10 @@
 #include "aliased_buffer.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_diagnostics_channel.h"
+#include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_options-inl.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
@@ -33,6 +36,7 @@
 #include "req_wrap-inl.h"
 #include "stream_base-inl.h"
 #include "string_bytes.h"
+#include "threadpoolwork-inl.h"
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -45,13 +49,28 @@
 # include <io.h>
 #endif
 
+#ifndef _WIN32
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#ifdef __linux__
+# include <sys/syscall.h>
+# include <sys/uio.h>
+#endif
+
+#include <atomic>
+#include <list>
 #include <memory>
+#include <unordered_map>
 
 namespace node {
 
 namespace fs {
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::BigInt;
 using v8::Boolean;
 using v8::Context;
@@ -180,6 +199,8 @@ void FileHandle::New(const FunctionCallbackInfo<Value>& args) {
     handle->read_offset_ = args[1]->IntegerValue(env->context()).FromJust();
   if (args[2]->IsNumber())
     handle->read_length_ = args[2]->IntegerValue(env->context()).FromJust();
+  if (args[3]->IsUint32())
+    handle->read_ahead_ = std::max(args[3].As<Uint32>()->Value(), 1u);
 }
 
 FileHandle::~FileHandle() {
@@ -196,7 +217,8 @@ int FileHandle::DoWrite(WriteWrap* w,
 }
 
 void FileHandle::MemoryInfo(MemoryTracker* tracker) const {
-  tracker->TrackField("current_read", current_read_);
+  for (const auto& read : reads_)
+    tracker->TrackField("read", read);
 }
 
 FileHandle::TransferMode FileHandle::GetTransferMode() const {
@@ -399,8 +421,14 @@ void FileHandle::Close(const FunctionCallbackInfo<Value>& args) {
 void FileHandle::ReleaseFD(const FunctionCallbackInfo<Value>& args) {
   FileHandle* fd;
   ASSIGN_OR_RETURN_UNWRAP(&fd, args.Holder());
+  if (!fd->reads_.empty()) {
+    fd->release_pending_ = true;
+    args.GetReturnValue().Set(false);
+    return;
+  }
   // Just act as if this FileHandle has been closed.
   fd->AfterClose();
+  args.GetReturnValue().Set(true);
 }
 
 
@@ -421,22 +449,59 @@ FileHandleReadWrap::FileHandleReadWrap(FileHandle* handle, Local<Object> obj)
   : ReqWrap(handle->env(), obj, AsyncWrap::PROVIDER_FSREQCALLBACK),
     file_handle_(handle) {}
 
+// The range of the sizes of the reads ReadStart() issues.
+constexpr int64_t kMinStreamReadSize = 64 * 1024;
+constexpr int64_t kMaxStreamReadSize = 2 * 1024 * 1024;
+
 int FileHandle::ReadStart() {
-  if (!IsAlive() || IsClosing())
+  if (!IsAlive() || IsClosing() || release_pending_)
     return UV_EOF;
 
   reading_ = true;
 
-  if (current_read_)
-    return 0;
-
-  BaseObjectPtr<FileHandleReadWrap> read_wrap;
+  if (read_size_ == 0) {
+    read_size_ = kMinStreamReadSize;
+#ifndef _WIN32
+    // Reads can only be made ahead at known positions, so start at the
+    // current position of the file. It is not moved by the reads.
+    if (read_offset_ < 0 && read_ahead_ > 1) {
+      off_t position = lseek(fd_, 0, SEEK_CUR);
+      if (position >= 0)
+        read_offset_ = position;
+    }
+#endif
+    next_read_offset_ = read_offset_;
+#ifdef POSIX_FADV_SEQUENTIAL
+    // Streams read the file from start to end, so let the kernel read ahead
+    // more aggressively. This is only a hint, so errors are ignored.
+    USE(posix_fadvise(fd_,
+                      read_offset_ >= 0 ? read_offset_ : 0,
+                      read_length_ >= 0 ? read_length_ : 0,
+                      POSIX_FADV_SEQUENTIAL));
+#endif
+  }
 
-  if (read_length_ == 0) {
-    EmitRead(UV_EOF);
-    return 0;
+  const size_t max_reads = read_offset_ >= 0 ? read_ahead_ : 1;
+  while (reading_ && reads_.size() < max_reads) {
+    int64_t remaining = read_length_;
+    if (remaining >= 0 && read_offset_ >= 0)
+      remaining -= next_read_offset_ - read_offset_;
+    if (remaining == 0) {
+      if (reads_.empty())
+        EmitRead(UV_EOF);
+      break;
+    }
+    int err = DispatchRead(remaining);
+    if (err != 0)
+      return err;
   }
 
+  return 0;
+}
+
+int FileHandle::DispatchRead(int64_t max_length) {
+  BaseObjectPtr<FileHandleReadWrap> read_wrap;
+
   {
     // Create a new FileHandleReadWrap or re-use one.
     // Either way, we need these two scopes for AsyncReset() or otherwise
@@ -466,75 +531,119 @@ int FileHandle::ReadStart() {
       read_wrap = MakeDetachedBaseObject<FileHandleReadWrap>(this, wrap_obj);
     }
   }
-  int64_t recommended_read = 65536;
-  if (read_length_ >= 0 && read_length_ <= recommended_read)
-    recommended_read = read_length_;
 
-  read_wrap->buffer_ = EmitAlloc(recommended_read);
+  int64_t recommended_read = read_size_;
+  if (max_length >= 0 && max_length <= recommended_read)
+    recommended_read = max_length;
 
-  current_read_ = std::move(read_wrap);
-
-  current_read_->Dispatch(uv_fs_read,
-                          fd_,
-                          &current_read_->buffer_,
-                          1,
-                          read_offset_,
-                          uv_fs_callback_t{[](uv_fs_t* req) {
-    FileHandle* handle;
-    {
-      FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
-      handle = req_wrap->file_handle_;
-      CHECK_EQ(handle->current_read_.get(), req_wrap);
+  read_wrap->buffer_ = EmitAlloc(recommended_read);
+  read_wrap->offset_ = next_read_offset_;
+  read_wrap->result_ = 0;
+  read_wrap->done_ = false;
+
+  if (next_read_offset_ >= 0) {
+    next_read_offset_ += read_wrap->buffer_.len;
+#ifdef POSIX_FADV_WILLNEED
+    // Have the kernel fetch the range the next read is going to ask for while
+    // this one is in progress and its data is being consumed.
+    int64_t next_read = std::min(read_size_ * 2, kMaxStreamReadSize);
+    if (max_length >= 0)
+      next_read = std::min(next_read, max_length - recommended_read);
+    if (next_read > 0) {
+      USE(posix_fadvise(fd_, next_read_offset_, next_read,
+                        POSIX_FADV_WILLNEED));
     }
+#endif
+  }
 
-    // ReadStart() checks whether current_read_ is set to determine whether
-    // a read is in progress. Moving it into a local variable makes sure that
-    // the ReadStart() call below doesn't think we're still actively reading.
-    BaseObjectPtr<FileHandleReadWrap> read_wrap =
-        std::move(handle->current_read_);
-
-    ssize_t result = req->result;
-    uv_buf_t buffer = read_wrap->buffer_;
+  reads_.emplace_back(std::move(read_wrap));
+  FileHandleReadWrap* req_wrap = reads_.back().get();
 
+  req_wrap->Dispatch(uv_fs_read,
+                     fd_,
+                     &req_wrap->buffer_,
+                     1,
+                     req_wrap->offset_,
+                     uv_fs_callback_t{[](uv_fs_t* req) {
+    FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
+    req_wrap->result_ = req->result;
+    req_wrap->done_ = true;
     uv_fs_req_cleanup(req);
+    req_wrap->file_handle_->EmitCompletedReads();
+  }});
+
+  return 0;
+}
+
+void FileHandle::EmitCompletedReads() {
+  while (!reads_.empty() && reads_.front()->done_) {
+    BaseObjectPtr<FileHandleReadWrap> read_wrap = std::move(reads_.front());
+    reads_.pop_front();
+
+    ssize_t result = read_wrap->result_;
+    uv_buf_t buffer = read_wrap->buffer_;
+    const int64_t offset = read_wrap->offset_;
 
     // Push the read wrap back to the freelist, or let it be destroyed
     // once we’re exiting the current scope.
     constexpr size_t kWantedFreelistFill = 100;
-    auto& freelist = handle->binding_data_->file_handle_read_wrap_freelist;
+    auto& freelist = binding_data_->file_handle_read_wrap_freelist;
     if (freelist.size() < kWantedFreelistFill) {
       read_wrap->Reset();
       freelist.emplace_back(std::move(read_wrap));
     }
 
+    // A read that came back short or failed leaves a gap before the reads
+    // that were started after it. Drop their data, the range is read again.
+    if (offset != read_offset_ || release_pending_) {
+      EmitRead(0, buffer);
+      continue;
+    }
+
+    // Reading sequentially, so read more at once as long as the reads are
+    // being filled.
+    if (result > 0 && static_cast<size_t>(result) == buffer.len)
+      read_size_ = std::min(read_size_ * 2, kMaxStreamReadSize);
+
     if (result >= 0) {
       // Read at most as many bytes as we originally planned to.
-      if (handle->read_length_ >= 0 && handle->read_length_ < result)
-        result = handle->read_length_;
+      if (read_length_ >= 0 && read_length_ < result)
+        result = read_length_;
 
       // If we read data and we have an expected length, decrease it by
       // how much we have read.
-      if (handle->read_length_ >= 0)
-        handle->read_length_ -= result;
+      if (read_length_ >= 0)
+        read_length_ -= result;
 
       // If we have an offset, increase it by how much we have read.
-      if (handle->read_offset_ >= 0)
-        handle->read_offset_ += result;
+      if (read_offset_ >= 0)
+        read_offset_ += result;
     }
 
+    if (result < 0 || static_cast<size_t>(result) < buffer.len)
+      next_read_offset_ = read_offset_;
+
     // Reading 0 bytes from a file always means EOF, or that we reached
     // the end of the requested range.
     if (result == 0)
       result = UV_EOF;
 
-    handle->EmitRead(result, buffer);
+    EmitRead(result, buffer);
+  }
 
-    // Start over, if EmitRead() didn’t tell us to stop.
-    if (handle->reading_)
-      handle->ReadStart();
-  }});
+  if (release_pending_) {
+    if (reads_.empty()) {
+      release_pending_ = false;
+      reading_ = false;
+      AfterClose();
+      EmitRead(UV_EOF);
+    }
+    return;
+  }
 
-  return 0;
+  // Start over, if EmitRead() didn’t tell us to stop.
+  if (reading_)
+    ReadStart();
 }
 
 int FileHandle::ReadStop() {
@@ -600,6 +709,27 @@ FSReqAfterScope::FSReqAfterScope(FSReqBase* wrap, uv_fs_t* req)
       handle_scope_(wrap->env()->isolate()),
       context_scope_(wrap->env()->context()) {
   CHECK_EQ(wrap_->req(), req);
+
+  Environment* env = wrap->env();
+  if (diagnostics_channel::HasSubscribers(
+          env, diagnostics_channel::kFsRequestComplete)) {
+    Isolate* isolate = env->isolate();
+    Local<Context> context = env->context();
+    Local<Object> message = Object::New(isolate);
+    USE(message->Set(context,
+                     env->syscall_string(),
+                     OneByteString(isolate, wrap->syscall())));
+    if (req->path != nullptr) {
+      Local<String> path;
+      if (String::NewFromUtf8(isolate, req->path).ToLocal(&path))
+        USE(message->Set(context, env->path_string(), path));
+    }
+    USE(message->Set(context,
+                     FIXED_ONE_BYTE_STRING(isolate, "result"),
+                     Number::New(isolate, static_cast<double>(req->result))));
+    diagnostics_channel::Publish(
+        env, diagnostics_channel::kFsRequestComplete, message);
+  }
 }
 
 FSReqAfterScope::~FSReqAfterScope() {
@@ -1104,6 +1234,387 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void StatPaths(uv_loop_t* loop,
+               const std::vector<std::string>& paths,
+               std::vector<uv_stat_t>* stats,
+               std::vector<int>* errors) {
+  stats->resize(paths.size());
+  errors->resize(paths.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    uv_fs_t req;
+    const int err = uv_fs_stat(loop, &req, paths[i].c_str(), nullptr);
+    if (err == 0)
+      (*stats)[i] = req.statbuf;
+    (*errors)[i] = err;
+    uv_fs_req_cleanup(&req);
+  }
+}
+
+// Returns [values, errors], where values holds the stats of each path laid
+// out like statValues and errors holds the error code of each path.
+template <typename AliasedBufferT>
+static Local<Value> StatPathsResult(Isolate* isolate,
+                                    const std::vector<uv_stat_t>& stats,
+                                    const std::vector<int>& errors) {
+  constexpr size_t kFieldsNumber =
+      static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+  AliasedBufferT values(isolate, stats.size() * kFieldsNumber);
+  AliasedInt32Array codes(isolate, stats.size());
+  for (size_t i = 0; i < stats.size(); i++) {
+    if (errors[i] == 0)
+      FillStatsArray(&values, &stats[i], i * kFieldsNumber);
+    codes.SetValue(i, errors[i]);
+  }
+  Local<Value> result[] = { values.GetJSArray(), codes.GetJSArray() };
+  return Array::New(isolate, result, arraysize(result));
+}
+
+class StatManyWork final : public ThreadPoolWork {
+ public:
+  StatManyWork(Environment* env,
+               FSReqBase* req_wrap,
+               std::vector<std::string>&& paths)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        paths_(std::move(paths)) {}
+
+  void DoThreadPoolWork() override {
+    // Without a callback, uv_fs_stat() runs synchronously and does not touch
+    // the loop.
+    StatPaths(env()->event_loop(), paths_, &stats_, &errors_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<StatManyWork> self(this);
+    Environment* env = this->env();
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+
+    if (status < 0) {
+      req_wrap->Reject(UVException(isolate, status, "stat"));
+      return;
+    }
+    req_wrap->Resolve(req_wrap->use_bigint() ?
+        StatPathsResult<AliasedBigUint64Array>(isolate, stats_, errors_) :
+        StatPathsResult<AliasedFloat64Array>(isolate, stats_, errors_));
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::vector<std::string> paths_;
+  std::vector<uv_stat_t> stats_;
+  std::vector<int> errors_;
+};
+
+/* Stat many paths at once.
+ *
+ * 0 paths       array of strings or Buffers
+ * 1 use_bigint  boolean. whether to use BigUint64Array for the values
+ * 2 req         FSReqCallback, kUsePromises or undefined for a sync call
+ */
+static void StatMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> paths_array = args[0].As<Array>();
+  std::vector<std::string> paths(paths_array->Length());
+  for (uint32_t i = 0; i < paths_array->Length(); i++) {
+    Local<Value> value;
+    if (!paths_array->Get(env->context(), i).ToLocal(&value))
+      return;
+    BufferValue path(isolate, value);
+    CHECK_NOT_NULL(*path);
+    paths[i] = path.ToString();
+  }
+
+  bool use_bigint = args[1]->IsTrue();
+  FSReqBase* req_wrap_async = GetReqWrap(args, 2, use_bigint);
+  if (req_wrap_async != nullptr) {  // statMany(paths, use_bigint, req)
+    req_wrap_async->Init("stat", nullptr, 0, UTF8);
+    req_wrap_async->SetReturnValue(args);
+    StatManyWork* work =
+        new StatManyWork(env, req_wrap_async, std::move(paths));
+    work->ScheduleWork();
+  } else {  // statMany(paths, use_bigint)
+    std::vector<uv_stat_t> stats;
+    std::vector<int> errors;
+    FS_SYNC_TRACE_BEGIN(stat);
+    StatPaths(env->event_loop(), paths, &stats, &errors);
+    FS_SYNC_TRACE_END(stat);
+    args.GetReturnValue().Set(use_bigint ?
+        StatPathsResult<AliasedBigUint64Array>(isolate, stats, errors) :
+        StatPathsResult<AliasedFloat64Array>(isolate, stats, errors));
+  }
+}
+
+#ifdef _WIN32
+constexpr char kWalkSeparator = '\\';
+#else
+constexpr char kWalkSeparator = '/';
+#endif
+
+struct WalkEntry {
+  std::string path;
+  int type;
+  uv_stat_t stat;
+};
+
+static int DirentTypeFromMode(uint64_t mode) {
+  switch (mode & S_IFMT) {
+    case S_IFREG: return UV_DIRENT_FILE;
+    case S_IFDIR: return UV_DIRENT_DIR;
+#ifdef S_IFLNK
+    case S_IFLNK: return UV_DIRENT_LINK;
+#endif
+#ifdef S_IFIFO
+    case S_IFIFO: return UV_DIRENT_FIFO;
+#endif
+#ifdef S_IFSOCK
+    case S_IFSOCK: return UV_DIRENT_SOCKET;
+#endif
+    case S_IFCHR: return UV_DIRENT_CHAR;
+#ifdef S_IFBLK
+    case S_IFBLK: return UV_DIRENT_BLOCK;
+#endif
+    default: return UV_DIRENT_UNKNOWN;
+  }
+}
+
+// Reads the directories in |pending|, which are relative to |root|, until at
+// least |batch_size| entries have been collected. Every directory is read
+// completely, and the subdirectories found are added to |pending| so that
+// the walk can be resumed by another call. Symbolic links are not followed.
+// Entries are lstat()ed if |with_stats| is set, or if the file system does
+// not report their type.
+static int WalkDirectories(uv_loop_t* loop,
+                           const std::string& root,
+                           std::vector<std::string>* pending,
+                           bool with_stats,
+                           size_t batch_size,
+                           std::vector<WalkEntry>* entries,
+                           std::string* error_path) {
+  while (!pending->empty() && entries->size() < batch_size) {
+    const std::string dir = std::move(pending->back());
+    pending->pop_back();
+    const std::string dir_path =
+        dir.empty() ? root : root + kWalkSeparator + dir;
+
+    uv_fs_t req;
+    int err = uv_fs_scandir(loop, &req, dir_path.c_str(), 0, nullptr);
+    uv_dirent_t ent;
+    while (err >= 0 && (err = uv_fs_scandir_next(&req, &ent)) != UV_EOF) {
+      if (err < 0)
+        break;
+
+      WalkEntry entry;
+      entry.path = dir.empty() ? ent.name : dir + kWalkSeparator + ent.name;
+      entry.type = ent.type;
+      if (with_stats || entry.type == UV_DIRENT_UNKNOWN) {
+        const std::string entry_path = root + kWalkSeparator + entry.path;
+        uv_fs_t stat_req;
+        err = uv_fs_lstat(loop, &stat_req, entry_path.c_str(), nullptr);
+        if (err == 0)
+          entry.stat = stat_req.statbuf;
+        uv_fs_req_cleanup(&stat_req);
+        // The entry was removed since the directory was read.
+        if (err == UV_ENOENT) {
+          err = 0;
+          continue;
+        }
+        if (err < 0) {
+          *error_path = entry_path;
+          break;
+        }
+        if (entry.type == UV_DIRENT_UNKNOWN)
+          entry.type = DirentTypeFromMode(entry.stat.st_mode);
+      }
+
+      if (entry.type == UV_DIRENT_DIR)
+        pending->push_back(entry.path);
+      entries->push_back(std::move(entry));
+    }
+    uv_fs_req_cleanup(&req);
+
+    if (err < 0 && err != UV_EOF) {
+      if (error_path->empty())
+        *error_path = dir_path;
+      return err;
+    }
+  }
+  return 0;
+}
+
+// Returns [entries, stats, pending]. entries holds the path and the type of
+// each entry, one after the other, stats holds their Stats laid out like
+// statValues, or is undefined, and pending holds the directories left to
+// read.
+static MaybeLocal<Value> WalkResult(Environment* env,
+                                    const std::vector<WalkEntry>& entries,
+                                    const std::vector<std::string>& pending,
+                                    bool with_stats,
+                                    bool use_bigint,
+                                    Local<Value>* err_out) {
+  Isolate* isolate = env->isolate();
+
+  MaybeStackBuffer<Local<Value>, 64> names(entries.size() * 2);
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (!StringBytes::Encode(isolate,
+                             entries[i].path.data(),
+                             entries[i].path.size(),
+                             UTF8,
+                             err_out).ToLocal(&names[i * 2])) {
+      return MaybeLocal<Value>();
+    }
+    names[i * 2 + 1] = Integer::New(isolate, entries[i].type);
+  }
+
+  Local<Value> stats = Undefined(isolate);
+  if (with_stats && !entries.empty()) {
+    constexpr size_t kFieldsNumber =
+        static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+    if (use_bigint) {
+      AliasedBigUint64Array values(isolate, entries.size() * kFieldsNumber);
+      for (size_t i = 0; i < entries.size(); i++)
+        FillStatsArray(&values, &entries[i].stat, i * kFieldsNumber);
+      stats = values.GetJSArray();
+    } else {
+      AliasedFloat64Array values(isolate, entries.size() * kFieldsNumber);
+      for (size_t i = 0; i < entries.size(); i++)
+        FillStatsArray(&values, &entries[i].stat, i * kFieldsNumber);
+      stats = values.GetJSArray();
+    }
+  }
+
+  Local<Value> pending_array;
+  if (!ToV8Value(env->context(), pending).ToLocal(&pending_array))
+    return MaybeLocal<Value>();
+
+  Local<Value> result[] = {
+    Array::New(isolate, names.out(), entries.size() * 2),
+    stats,
+    pending_array
+  };
+  return Array::New(isolate, result, arraysize(result));
+}
+
+class WalkDirWork final : public ThreadPoolWork {
+ public:
+  WalkDirWork(Environment* env,
+              FSReqBase* req_wrap,
+              std::string&& root,
+              std::vector<std::string>&& pending,
+              bool with_stats,
+              size_t batch_size)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        root_(std::move(root)),
+        pending_(std::move(pending)),
+        with_stats_(with_stats),
+        batch_size_(batch_size) {}
+
+  void DoThreadPoolWork() override {
+    // Without a callback the uv_fs_* functions run synchronously and do not
+    // touch the loop.
+    err_ = WalkDirectories(env()->event_loop(), root_, &pending_, with_stats_,
+                           batch_size_, &entries_, &error_path_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<WalkDirWork> self(this);
+    Environment* env = this->env();
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+
+    if (status < 0)
+      err_ = status;
+    if (err_ < 0) {
+      req_wrap->Reject(UVException(isolate, err_, "scandir", nullptr,
+                                   error_path_.c_str(), nullptr));
+      return;
+    }
+
+    Local<Value> error;
+    Local<Value> result;
+    if (!WalkResult(env, entries_, pending_, with_stats_,
+                    req_wrap->use_bigint(), &error).ToLocal(&result)) {
+      if (!error.IsEmpty())
+        req_wrap->Reject(error);
+      return;
+    }
+    req_wrap->Resolve(result);
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::string root_;
+  std::vector<std::string> pending_;
+  const bool with_stats_;
+  const size_t batch_size_;
+
+  std::vector<WalkEntry> entries_;
+  std::string error_path_;
+  int err_ = 0;
+};
+
+/* Walk a directory tree, one batch of entries at a time.
+ *
+ * 0 root        string or Buffer. path of the tree
+ * 1 pending     array of strings. directories left to read, relative to root
+ * 2 with_stats  boolean. whether to return the Stats of the entries
+ * 3 use_bigint  boolean. whether to use BigUint64Array for the Stats
+ * 4 batch_size  uint32. number of entries after which the batch ends
+ * 5 req         FSReqCallback or kUsePromises
+ */
+static void WalkDir(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 6);
+
+  BufferValue root(isolate, args[0]);
+  CHECK_NOT_NULL(*root);
+
+  CHECK(args[1]->IsArray());
+  Local<Array> pending_array = args[1].As<Array>();
+  std::vector<std::string> pending(pending_array->Length());
+  for (uint32_t i = 0; i < pending_array->Length(); i++) {
+    Local<Value> value;
+    if (!pending_array->Get(env->context(), i).ToLocal(&value))
+      return;
+    CHECK(value->IsString());
+    pending[i] = *Utf8Value(isolate, value);
+  }
+
+  const bool with_stats = args[2]->IsTrue();
+  const bool use_bigint = args[3]->IsTrue();
+
+  CHECK(args[4]->IsUint32());
+  const size_t batch_size = args[4].As<Uint32>()->Value();
+  CHECK_GT(batch_size, 0);
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 5, use_bigint);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init("scandir", nullptr, 0, UTF8);
+  req_wrap_async->SetReturnValue(args);
+  WalkDirWork* work = new WalkDirWork(env, req_wrap_async, root.ToString(),
+                                      std::move(pending), with_stats,
+                                      batch_size);
+  work->ScheduleWork();
+}
+
 static void Symlink(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1619,6 +2130,103 @@ static void RealPath(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// A size-bounded cache of the realpath() results of the module loaders. It is
+// shared by all threads of the process, so workers that load the same
+// modules do not resolve the same paths again. The least recently used
+// entries are evicted once the cache is full.
+class RealPathCache {
+ public:
+  explicit RealPathCache(size_t capacity) : capacity_(capacity) {}
+
+  bool Get(const std::string& path, std::string* real_path) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = index_.find(path);
+    if (it == index_.end())
+      return false;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    *real_path = it->second->second;
+    return true;
+  }
+
+  void Set(const std::string& path, const std::string& real_path) {
+    Mutex::ScopedLock lock(mutex_);
+    auto it = index_.find(path);
+    if (it != index_.end()) {
+      it->second->second = real_path;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+    if (entries_.size() == capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+    entries_.emplace_front(path, real_path);
+    index_.emplace(path, entries_.begin());
+  }
+
+  // Returns nullptr unless enabled through --realpath-cache-size.
+  static RealPathCache* GetInstance() {
+    static RealPathCache* const cache = []() -> RealPathCache* {
+      int64_t capacity;
+      {
+        Mutex::ScopedLock lock(per_process::cli_options_mutex);
+        capacity = per_process::cli_options->realpath_cache_size;
+      }
+      // Intentionally leaked, the cache lives as long as the process.
+      return capacity > 0 ? new RealPathCache(capacity) : nullptr;
+    }();
+    return cache;
+  }
+
+ private:
+  Mutex mutex_;
+  const size_t capacity_;
+  // Most recently used first.
+  std::list<std::pair<std::string, std::string>> entries_;
+  std::unordered_map<std::string, decltype(entries_)::iterator> index_;
+};
+
+// realpath() through the RealPathCache, for the module loaders.
+//
+// 0 path  string or Buffer. absolute path to resolve
+// 1 ctx   object filled with the error information
+static void CachedRealPath(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK_EQ(args.Length(), 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+  const std::string key = path.ToString();
+
+  RealPathCache* cache = RealPathCache::GetInstance();
+  std::string real_path;
+  if (cache == nullptr || !cache->Get(key, &real_path)) {
+    FSReqWrapSync req_wrap_sync;
+    FS_SYNC_TRACE_BEGIN(realpath);
+    int err = SyncCall(env, args[1], &req_wrap_sync, "realpath",
+                       uv_fs_realpath, *path);
+    FS_SYNC_TRACE_END(realpath);
+    if (err < 0) {
+      return;  // syscall failed, no need to continue, error info is in ctx
+    }
+    real_path = static_cast<const char*>(req_wrap_sync.req.ptr);
+    if (cache != nullptr)
+      cache->Set(key, real_path);
+  }
+
+  Local<Value> error;
+  Local<Value> result;
+  if (!StringBytes::Encode(isolate, real_path.data(), real_path.size(), UTF8,
+                           &error).ToLocal(&result)) {
+    Local<Object> ctx = args[1].As<Object>();
+    ctx->Set(env->context(), env->error_string(), error).Check();
+    return;
+  }
+  args.GetReturnValue().Set(result);
+}
+
 static void ReadDir(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1908,6 +2516,139 @@ static void WriteBuffers(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Writes bufs with pwritev2(), which unlike uv_fs_write() takes the RWF_*
+// flags of the write. Like uv_fs_write(), the buffers are written IOV_MAX at
+// a time, and the result is the number of bytes written unless nothing could
+// be written.
+static ssize_t WritevWithFlags(int fd,
+                               std::vector<uv_buf_t>* bufs,
+                               int64_t pos,
+                               int flags) {
+#if defined(__linux__) && defined(__NR_pwritev2) && defined(IOV_MAX)
+  size_t index = 0;
+  ssize_t total = 0;
+  while (index < bufs->size()) {
+    const size_t count = std::min(bufs->size() - index,
+                                  static_cast<size_t>(IOV_MAX));
+    const int64_t offset = pos < 0 ? -1 : pos + total;
+    // pwritev2() is called through syscall() since older C libraries lack
+    // it. The offset is split in two words for 32-bit architectures.
+    const ssize_t written = syscall(
+        __NR_pwritev2, fd, reinterpret_cast<struct iovec*>(&(*bufs)[index]),
+        count, static_cast<uintptr_t>(offset),
+        static_cast<uintptr_t>(static_cast<uint64_t>(offset) >> 32), flags);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return total > 0 ? total : -errno;
+    }
+    total += written;
+    // Skip what was written, which can end in the middle of a buffer.
+    size_t remaining = written;
+    while (index < bufs->size() && remaining >= (*bufs)[index].len)
+      remaining -= (*bufs)[index++].len;
+    if (remaining > 0) {
+      (*bufs)[index].base += remaining;
+      (*bufs)[index].len -= remaining;
+    }
+    if (written == 0)
+      break;
+  }
+  return total;
+#else
+  return UV_ENOSYS;
+#endif
+}
+
+class WriteBuffersWork final : public ThreadPoolWork {
+ public:
+  WriteBuffersWork(Environment* env,
+                   FSReqBase* req_wrap,
+                   int fd,
+                   std::vector<uv_buf_t>&& bufs,
+                   int64_t pos,
+                   int flags)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        fd_(fd),
+        bufs_(std::move(bufs)),
+        pos_(pos),
+        flags_(flags) {}
+
+  void DoThreadPoolWork() override {
+    result_ = WritevWithFlags(fd_, &bufs_, pos_, flags_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<WriteBuffersWork> self(this);
+    Environment* env = this->env();
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+
+    const int64_t result = status < 0 ? status : result_;
+    if (result < 0) {
+      req_wrap->Reject(UVException(isolate, result, "write"));
+      return;
+    }
+    req_wrap->Resolve(Number::New(isolate, static_cast<double>(result)));
+  }
+
+ private:
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  const int fd_;
+  std::vector<uv_buf_t> bufs_;
+  const int64_t pos_;
+  const int flags_;
+  ssize_t result_ = 0;
+};
+
+// Wrapper for pwritev2(2).
+//
+// writeBuffersWithFlags(fd, chunks, pos, flags, req)
+// 0 fd        integer. file descriptor
+// 1 chunks    array of buffers to write
+// 2 pos       if integer, position to write at in the file.
+//             if null, write from the current position
+// 3 flags     RWF_* flags of the write
+// 4 req       FSReqCallback or kUsePromises
+static void WriteBuffersWithFlags(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 5);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(args[1]->IsArray());
+  Local<Array> chunks = args[1].As<Array>();
+
+  int64_t pos = GetOffset(args[2]);
+
+  CHECK(args[3]->IsInt32());
+  const int flags = args[3].As<Int32>()->Value();
+
+  std::vector<uv_buf_t> bufs(chunks->Length());
+  for (uint32_t i = 0; i < bufs.size(); i++) {
+    Local<Value> chunk = chunks->Get(env->context(), i).ToLocalChecked();
+    CHECK(Buffer::HasInstance(chunk));
+    bufs[i] = uv_buf_init(Buffer::Data(chunk), Buffer::Length(chunk));
+  }
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 4);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init("write", nullptr, 0, UTF8);
+  req_wrap_async->SetReturnValue(args);
+  WriteBuffersWork* work = new WriteBuffersWork(
+      env, req_wrap_async, fd, std::move(bufs), pos, flags);
+  work->ScheduleWork();
+}
+
+
 // Wrapper for write(2).
 //
 // bytesWritten = write(fd, string, position, enc, callback)
@@ -2112,6 +2853,326 @@ static void ReadBuffers(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Reads a whole file in a single threadpool job: the open, fstat, reads and
+// close are performed back to back on the same thread, and the result is
+// handed to JS either as a Buffer or as a string created directly from the
+// data read.
+class ReadFileWork final : public ThreadPoolWork {
+ public:
+  ReadFileWork(Environment* env,
+               FSReqBase* req_wrap,
+               std::string&& path,
+               int flags,
+               bool utf8)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        path_(std::move(path)),
+        flags_(flags),
+        utf8_(utf8) {}
+
+  void DoThreadPoolWork() override {
+    // Without a callback the uv_fs_* functions run synchronously and do not
+    // touch the loop, so they can be called from the threadpool.
+    uv_loop_t* loop = env()->event_loop();
+    uv_fs_t req;
+
+    syscall_ = "open";
+    const uv_file file =
+        uv_fs_open(loop, &req, path_.c_str(), flags_, 0666, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (file < 0) {
+      err_ = file;
+      return;
+    }
+
+    syscall_ = "fstat";
+    err_ = uv_fs_fstat(loop, &req, file, nullptr);
+    if (err_ == 0 && (req.statbuf.st_mode & S_IFMT) == S_IFREG)
+      size_ = req.statbuf.st_size;
+    uv_fs_req_cleanup(&req);
+
+    if (err_ == 0 && size_ > kIoMaxLength)
+      too_large_ = true;
+
+    if (err_ == 0 && !too_large_)
+      ReadAll(loop, file);
+
+    const int close_err = uv_fs_close(loop, &req, file, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err_ == 0 && close_err < 0) {
+      syscall_ = "close";
+      err_ = close_err;
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadFileWork> self(this);
+    Environment* env = this->env();
+    Isolate* isolate = env->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env->context());
+
+    BaseObjectPtr<FSReqBase> req_wrap = std::move(req_wrap_);
+    req_wrap->Detach();
+
+    if (status < 0)
+      err_ = status;
+
+    Local<Value> error;
+    Local<Value> result;
+    if (too_large_) {
+      error = ERR_FS_FILE_TOO_LARGE(
+          isolate, "File size (%s) is greater than 2 GB", size_);
+    } else if (err_ < 0) {
+      // Like the FileHandle methods, only the open() error carries the path.
+      const bool is_open = strcmp(syscall_, "open") == 0;
+      error = UVException(isolate, err_, syscall_, nullptr,
+                          is_open ? path_.c_str() : nullptr, nullptr);
+    } else if (utf8_) {
+      if (!StringBytes::Encode(isolate, data_.data, length_, UTF8, &error)
+               .ToLocal(&result) && error.IsEmpty()) {
+        return;
+      }
+    } else if (length_ == 0) {
+      // Realloc(0) would free the memory, and a Buffer over nullptr would
+      // have a detached ArrayBuffer.
+      Local<Object> buffer;
+      if (!Buffer::New(isolate, 0).ToLocal(&buffer))
+        return;
+      result = buffer;
+    } else {
+      if (length_ < data_.size)
+        data_.Realloc(length_);
+      const size_t length = length_;
+      Local<Object> buffer;
+      if (!Buffer::New(env, data_.release(), length).ToLocal(&buffer))
+        return;
+      result = buffer;
+    }
+
+    if (!error.IsEmpty())
+      req_wrap->Reject(error);
+    else
+      req_wrap->Resolve(result);
+  }
+
+ private:
+  static constexpr uint64_t kIoMaxLength = (1ull << 31) - 1;
+  static constexpr size_t kUnknownSizeChunk = 64 * 1024;
+
+  void ReadAll(uv_loop_t* loop, uv_file file) {
+    syscall_ = "read";
+    size_t capacity = size_ > 0 ? size_ : kUnknownSizeChunk;
+    data_ = MallocedBuffer<char>(capacity);
+    for (;;) {
+      if (length_ == capacity) {
+        // Stop at the size reported by fstat(), the same way the JS
+        // implementation does.
+        if (size_ > 0)
+          return;
+        if (capacity >= kIoMaxLength) {
+          too_large_ = true;
+          size_ = capacity;
+          return;
+        }
+        capacity = std::min<size_t>(capacity * 2, kIoMaxLength);
+        data_.Realloc(capacity);
+      }
+      uv_fs_t req;
+      uv_buf_t buf = uv_buf_init(data_.data + length_, capacity - length_);
+      const int bytes_read = uv_fs_read(loop, &req, file, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (bytes_read < 0) {
+        err_ = bytes_read;
+        return;
+      }
+      if (bytes_read == 0)
+        return;
+      length_ += bytes_read;
+    }
+  }
+
+  BaseObjectPtr<FSReqBase> req_wrap_;
+  std::string path_;
+  const int flags_;
+  const bool utf8_;
+
+  const char* syscall_ = nullptr;
+  int err_ = 0;
+  bool too_large_ = false;
+  uint64_t size_ = 0;
+  MallocedBuffer<char> data_;
+  size_t length_ = 0;
+};
+
+/* Read a whole file through a single threadpool request.
+ *
+ * 0 path      string or Buffer. path of the file
+ * 1 flags     int32. flags to open the file with
+ * 2 req       FSReqCallback or kUsePromises
+ */
+template <bool utf8>
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  FSReqBase* req_wrap_async = GetReqWrap(args, 2);
+  CHECK_NOT_NULL(req_wrap_async);
+  req_wrap_async->Init(utf8 ? "readFileUtf8" : "readFileBuffer",
+                       nullptr, 0, utf8 ? UTF8 : BUFFER);
+  req_wrap_async->SetReturnValue(args);
+
+  ReadFileWork* work = new ReadFileWork(
+      env, req_wrap_async, path.ToString(), flags, utf8);
+  work->ScheduleWork();
+}
+
+// Bytes of files currently mapped by fs.mapFile(), shared by all threads.
+static std::atomic<size_t> mapped_file_bytes{0};
+
+static void UnmapFile(void* data, size_t length, void* deleter_data) {
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+#else
+  munmap(data, length);
+#endif
+  mapped_file_bytes -= length;
+}
+
+/* Map a range of a file into memory and return it as a Buffer.
+ *
+ * 0 fd        int32. file descriptor
+ * 1 offset    int64. position in the file where the range starts
+ * 2 length    int64. length of the range, within the file
+ * 3 populate  boolean. whether to read the range in right away
+ * 4 advice    int32. a MapFileAdvice
+ * 5 ctx       object filled with the error information
+ *
+ * The mapping is private: writes to the Buffer are never written back to
+ * the file, and the pages that are not written to stay shared with the page
+ * cache, and with the other threads and processes mapping the same file.
+ */
+static void MapFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK_EQ(args.Length(), 6);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(IsSafeJsInt(args[1]));
+  const int64_t offset = args[1].As<Integer>()->Value();
+  CHECK_GE(offset, 0);
+
+  CHECK(IsSafeJsInt(args[2]));
+  const int64_t length = args[2].As<Integer>()->Value();
+  CHECK_GT(length, 0);
+  CHECK_LE(static_cast<uint64_t>(length), v8::TypedArray::kMaxLength);
+
+  const bool populate = args[3]->IsTrue();
+
+  CHECK(args[4]->IsInt32());
+  const int advice = args[4].As<Int32>()->Value();
+
+  CHECK(args[5]->IsObject());
+
+  env->PrintSyncTrace();
+
+  // Mappings have to start at a multiple of the allocation granularity, so
+  // the Buffer starts inside of the mapping if the offset is not aligned.
+#ifdef _WIN32
+  SYSTEM_INFO system_info;
+  GetSystemInfo(&system_info);
+  const int64_t granularity = system_info.dwAllocationGranularity;
+#else
+  const int64_t granularity = sysconf(_SC_PAGESIZE);
+#endif
+  const int64_t map_offset = offset - offset % granularity;
+  const size_t map_length = static_cast<size_t>(length + offset - map_offset);
+
+  void* data = nullptr;
+  int err = 0;
+#ifdef _WIN32
+  HANDLE mapping = CreateFileMappingW(uv_get_osfhandle(fd),
+                                      nullptr,
+                                      PAGE_WRITECOPY,
+                                      0,
+                                      0,
+                                      nullptr);
+  if (mapping == nullptr) {
+    err = uv_translate_sys_error(GetLastError());
+  } else {
+    data = MapViewOfFile(mapping,
+                         FILE_MAP_COPY,
+                         static_cast<DWORD>(map_offset >> 32),
+                         static_cast<DWORD>(map_offset & 0xffffffff),
+                         map_length);
+    if (data == nullptr)
+      err = uv_translate_sys_error(GetLastError());
+    CloseHandle(mapping);
+  }
+  // There is no equivalent to the hints on Windows.
+  USE(populate);
+  USE(advice);
+#else
+  int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  if (populate)
+    flags |= MAP_POPULATE;
+#endif
+  data = mmap(nullptr, map_length, PROT_READ | PROT_WRITE, flags, fd,
+              map_offset);
+  if (data == MAP_FAILED) {
+    err = uv_translate_sys_error(errno);
+  } else {
+    int hint = MADV_NORMAL;
+    switch (static_cast<MapFileAdvice>(advice)) {
+      case kMapFileAdviceNormal: break;
+      case kMapFileAdviceSequential: hint = MADV_SEQUENTIAL; break;
+      case kMapFileAdviceRandom: hint = MADV_RANDOM; break;
+      case kMapFileAdviceWillNeed: hint = MADV_WILLNEED; break;
+      default: UNREACHABLE();
+    }
+#ifndef MAP_POPULATE
+    if (populate && hint == MADV_NORMAL)
+      hint = MADV_WILLNEED;
+#endif
+    // The advice is only a hint, so failing to apply it is not an error.
+    if (hint != MADV_NORMAL)
+      USE(madvise(data, map_length, hint));
+  }
+#endif
+
+  if (err < 0) {
+    Local<Context> context = env->context();
+    Local<Object> ctx_obj = args[5].As<Object>();
+    ctx_obj->Set(context,
+                 env->errno_string(),
+                 Integer::New(isolate, err)).Check();
+    ctx_obj->Set(context,
+                 env->syscall_string(),
+                 OneByteString(isolate, "mmap")).Check();
+    return;
+  }
+
+  mapped_file_bytes += map_length;
+  std::unique_ptr<BackingStore> backing_store =
+      ArrayBuffer::NewBackingStore(data, map_length, UnmapFile, nullptr);
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate, std::move(backing_store));
+  Local<Object> buffer;
+  if (Buffer::New(env, ab, offset - map_offset, length).ToLocal(&buffer))
+    args.GetReturnValue().Set(buffer);
+}
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -2397,6 +3458,7 @@ void BindingData::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("stats_field_bigint_array", stats_field_bigint_array);
   tracker->TrackField("file_handle_read_wrap_freelist",
                       file_handle_read_wrap_freelist);
+  tracker->TrackFieldWithSize("mapped_files", mapped_file_bytes);
 }
 
 BindingData::BindingData(Environment* env, v8::Local<v8::Object> wrap)
@@ -2459,6 +3521,9 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "openFileHandle", OpenFileHandle);
   env->SetMethod(target, "read", Read);
   env->SetMethod(target, "readBuffers", ReadBuffers);
+  env->SetMethod(target, "readFileBuffer", ReadFile<false>);
+  env->SetMethod(target, "readFileUtf8", ReadFile<true>);
+  env->SetMethod(target, "mapFile", MapFile);
   env->SetMethod(target, "fdatasync", Fdatasync);
   env->SetMethod(target, "fsync", Fsync);
   env->SetMethod(target, "rename", Rename);
@@ -2471,14 +3536,18 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "stat", Stat);
   env->SetMethod(target, "lstat", LStat);
   env->SetMethod(target, "fstat", FStat);
+  env->SetMethod(target, "statMany", StatMany);
+  env->SetMethod(target, "walkDir", WalkDir);
   env->SetMethod(target, "link", Link);
   env->SetMethod(target, "symlink", Symlink);
   env->SetMethod(target, "readlink", ReadLink);
   env->SetMethod(target, "unlink", Unlink);
   env->SetMethod(target, "writeBuffer", WriteBuffer);
   env->SetMethod(target, "writeBuffers", WriteBuffers);
+  env->SetMethod(target, "writeBuffersWithFlags", WriteBuffersWithFlags);
   env->SetMethod(target, "writeString", WriteString);
   env->SetMethod(target, "realpath", RealPath);
+  env->SetMethod(target, "cachedRealpath", CachedRealPath);
   env->SetMethod(target, "copyFile", CopyFile);
 
   env->SetMethod(target, "chmod", Chmod);
@@ -2495,6 +3564,11 @@ void Initialize(Local<Object> target,
 
   env->SetMethod(target, "mkdtemp", Mkdtemp);
 
+  NODE_DEFINE_CONSTANT(target, kMapFileAdviceNormal);
+  NODE_DEFINE_CONSTANT(target, kMapFileAdviceSequential);
+  NODE_DEFINE_CONSTANT(target, kMapFileAdviceRandom);
+  NODE_DEFINE_CONSTANT(target, kMapFileAdviceWillNeed);
+
   target
       ->Set(context,
             FIXED_ONE_BYTE_STRING(isolate, "kFsStatsFieldsNumber"),
@@ -2576,6 +3650,9 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(OpenFileHandle);
   registry->Register(Read);
   registry->Register(ReadBuffers);
+  registry->Register(ReadFile<false>);
+  registry->Register(ReadFile<true>);
+  registry->Register(MapFile);
   registry->Register(Fdatasync);
   registry->Register(Fsync);
   registry->Register(Rename);
@@ -2588,14 +3665,18 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Stat);
   registry->Register(LStat);
   registry->Register(FStat);
+  registry->Register(StatMany);
+  registry->Register(WalkDir);
   registry->Register(Link);
   registry->Register(Symlink);
   registry->Register(ReadLink);
   registry->Register(Unlink);
   registry->Register(WriteBuffer);
   registry->Register(WriteBuffers);
+  registry->Register(WriteBuffersWithFlags);
   registry->Register(WriteString);
   registry->Register(RealPath);
+  registry->Register(CachedRealPath);
   registry->Register(CopyFile);
 
   registry->Register(Chmod);
@@ -8,11 +8,25 @@
 #include "node_snapshotable.h"
 #include "stream_base.h"
 
+#include <deque>
+#include <unordered_map>
+
 namespace node {
+
+class StatWatcherGroup;
+
 namespace fs {
 
 class FileHandleReadWrap;
 
+// The hints fs.mapFile() passes on to madvise().
+enum MapFileAdvice {
+  kMapFileAdviceNormal,
+  kMapFileAdviceSequential,
+  kMapFileAdviceRandom,
+  kMapFileAdviceWillNeed
+};
+
 class BindingData : public SnapshotableObject {
  public:
   explicit BindingData(Environment* env, v8::Local<v8::Object> wrap);
@@ -23,6 +37,9 @@ class BindingData : public SnapshotableObject {
   std::vector<BaseObjectPtr<FileHandleReadWrap>>
       file_handle_read_wrap_freelist;
 
+  // The StatWatcherGroup of each of the intervals being polled.
+  std::unordered_map<uint32_t, StatWatcherGroup*> stat_watcher_groups;
+
   SERIALIZABLE_OBJECT_METHODS()
   static constexpr FastStringKey type_name{"node::fs::BindingData"};
   static constexpr EmbedderObjectType type_int =
@@ -226,6 +243,10 @@ class FileHandleReadWrap final : public ReqWrap<uv_fs_t> {
  private:
   FileHandle* file_handle_;
   uv_buf_t buffer_;
+  // The position that was read from, or -1 for the current file position.
+  int64_t offset_ = -1;
+  ssize_t result_ = 0;
+  bool done_ = false;
 
   friend class FileHandle;
 };
@@ -243,11 +264,31 @@ class FileHandle final : public AsyncWrap, public StreamBase {
 
   int GetFD() override { return fd_; }
 
+  // The position and remaining length for reading the file as a stream.
+  // A negative offset means the current file position, and a negative length
+  // means reading until the end of the file.
+  int64_t read_offset() const { return read_offset_; }
+  int64_t read_length() const { return read_length_; }
+
+  // Used by StreamPipe when it hands the file contents to the kernel directly
+  // rather than reading them through this stream.
+  void AdvanceReadPosition(int64_t nread) {
+    bytes_read_ += static_cast<uint64_t>(nread);
+    if (read_length_ >= 0)
+      read_length_ -= nread;
+    if (read_offset_ >= 0) {
+      read_offset_ += nread;
+      next_read_offset_ = read_offset_;
+    }
+  }
+
   // Will asynchronously close the FD and return a Promise that will
   // be resolved once closing is complete.
   static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
 
-  // Releases ownership of the FD.
+  // Releases ownership of the FD. If reads are in flight, this happens once
+  // they are done, which is signaled by a read of UV_EOF, and false is
+  // returned.
   static void ReleaseFD(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // StreamBase interface:
@@ -341,14 +382,33 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   // Asynchronous close
   v8::MaybeLocal<v8::Promise> ClosePromise();
 
+  // Starts a read of at most `max_length` bytes, or up to the end of the
+  // file if it is negative.
+  int DispatchRead(int64_t max_length);
+  // Emits the reads that have completed, in the order in which they were
+  // started.
+  void EmitCompletedReads();
+
   int fd_;
   bool closing_ = false;
   bool closed_ = false;
   bool reading_ = false;
   int64_t read_offset_ = -1;
   int64_t read_length_ = -1;
-
-  BaseObjectPtr<FileHandleReadWrap> current_read_;
+  // Size of the next read. It starts small and doubles for as long as the
+  // reads are completely filled, see ReadStart().
+  int64_t read_size_ = 0;
+
+  // The number of reads that are kept in flight while reading the file as a
+  // stream. More than one is only used when reading from known positions, and
+  // requires a stream listener that hands out a new buffer for each read.
+  size_t read_ahead_ = 1;
+  // The position that the next read starts at.
+  int64_t next_read_offset_ = -1;
+  // The reads in flight, in the order in which they were started.
+  std::deque<BaseObjectPtr<FileHandleReadWrap>> reads_;
+  // Set when the fd is released while reads are in flight.
+  bool release_pending_ = false;
 
   BaseObjectPtr<BindingData> binding_data_;
 };
@@ -359,6 +419,13 @@ int MKDirpSync(uv_loop_t* loop,
                int mode,
                uv_fs_cb cb = nullptr);
 
+// Runs stat() on each of the paths. Failures are recorded as the libuv error
+// code of the path instead of failing the whole batch.
+void StatPaths(uv_loop_t* loop,
+               const std::vector<std::string>& paths,
+               std::vector<uv_stat_t>* stats,
+               std::vector<int>* errors);
+
 class FSReqWrapSync {
  public:
   FSReqWrapSync() = default;
@@ -200,6 +200,16 @@ Http2Options::Http2Options(Http2State* http2_state, SessionType type) {
         option,
         static_cast<size_t>(buffer[IDX_OPTIONS_MAX_SETTINGS]));
   }
+
+  // Adaptive flow control is opt-in. The value is the upper bound for the
+  // stream and connection windows that the session may advertise.
+  if (flags & (1 << IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE)) {
+    set_max_adaptive_window_size(
+        buffer[IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE]);
+  }
+
+  if (flags & (1 << IDX_OPTIONS_LATENCY_HISTOGRAMS))
+    set_latency_histograms(buffer[IDX_OPTIONS_LATENCY_HISTOGRAMS] != 0);
 }
 
 #define GRABSETTING(entries, count, name)                                      \
@@ -481,6 +491,16 @@ Http2Session::Http2Session(Http2State* http2_state,
 
   max_outstanding_pings_ = opts.max_outstanding_pings();
   max_outstanding_settings_ = opts.max_outstanding_settings();
+  max_adaptive_window_size_ = opts.max_adaptive_window_size();
+
+  if (opts.latency_histograms()) {
+    time_to_first_header_histogram_ = std::make_shared<Histogram>(
+        1, kMaxHistogramLatency, kHistogramFigures);
+    time_to_first_byte_histogram_ = std::make_shared<Histogram>(
+        1, kMaxHistogramLatency, kHistogramFigures);
+    stream_duration_histogram_ = std::make_shared<Histogram>(
+        1, kMaxHistogramLatency, kHistogramFigures);
+  }
 
   padding_strategy_ = opts.padding_strategy();
 
@@ -518,8 +538,10 @@ Http2Session::Http2Session(Http2State* http2_state,
 Http2Session::~Http2Session() {
   CHECK(!is_in_scope());
   Debug(this, "freeing nghttp2 session");
-  // Explicitly reset session_ so the subsequent
-  // current_nghttp2_memory_ check passes.
+  // Explicitly release the cached header buffers and reset session_ so the
+  // subsequent current_nghttp2_memory_ check passes.
+  for (HeaderStringCacheEntry& entry : header_string_cache_)
+    entry.buf.reset();
   session_.reset();
   CHECK_EQ(current_nghttp2_memory_, 0);
 }
@@ -534,6 +556,12 @@ void Http2Session::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("pending_rst_streams",
                               pending_rst_streams_.size() * sizeof(int32_t));
   tracker->TrackFieldWithSize("nghttp2_memory", current_nghttp2_memory_);
+  tracker->TrackField("time_to_first_header_histogram",
+                      time_to_first_header_histogram_);
+  tracker->TrackField("time_to_first_byte_histogram",
+                      time_to_first_byte_histogram_);
+  tracker->TrackField("stream_duration_histogram",
+                      stream_duration_histogram_);
 }
 
 std::string Http2Session::diagnostic_name() const {
@@ -595,6 +623,8 @@ MaybeLocal<Object> Http2SessionPerformanceEntryTraits::GetDetails(
     return MaybeLocal<Object>();                                               \
   }
 
+  SET(adaptive_window_size_string, adaptive_window_size)
+  SET(bdp_estimate_string, bdp_estimate)
   SET(bytes_written_string, data_sent)
   SET(bytes_read_string, data_received)
   SET(frames_received_string, frame_count)
@@ -639,6 +669,32 @@ void Http2Stream::EmitStatistics() {
   });
 }
 
+void Http2Session::CountSentHeaders(const Http2Headers& headers) {
+  const nghttp2_nv* nva = headers.data();
+  size_t length = 0;
+  for (size_t i = 0; i < headers.length(); i++)
+    length += nva[i].namelen + nva[i].valuelen + 32;
+  js_fields_->header_stats[kHeaderBytesSent] += length;
+}
+
+void Http2Session::RecordStreamStatistics(
+    const Http2Stream::Statistics& statistics) {
+  if (!stream_duration_histogram_)
+    return;
+  // Streams that never saw a header or a DATA frame only count towards the
+  // duration.
+  if (statistics.first_header != 0) {
+    time_to_first_header_histogram_->Record(
+        statistics.first_header - statistics.start_time);
+  }
+  if (statistics.first_byte != 0) {
+    time_to_first_byte_histogram_->Record(
+        statistics.first_byte - statistics.start_time);
+  }
+  stream_duration_histogram_->Record(
+      statistics.end_time - statistics.start_time);
+}
+
 void Http2Session::EmitStatistics() {
   if (LIKELY(!HasHttp2Observer(env())))
     return;
@@ -735,6 +791,18 @@ void Http2Session::AddStream(Http2Stream* stream) {
   if (size > statistics_.max_concurrent_streams)
     statistics_.max_concurrent_streams = size;
   IncrementCurrentSessionMemory(sizeof(*stream));
+
+  // Streams opened after the window was grown start out with the same
+  // window as the existing ones.
+  if (adaptive_window_size_ > 0) {
+    int32_t id = stream->id();
+    if (static_cast<uint32_t>(
+            nghttp2_session_get_stream_effective_local_window_size(
+                session_.get(), id)) < adaptive_window_size_) {
+      CHECK_EQ(nghttp2_session_set_local_window_size(
+          session_.get(), NGHTTP2_FLAG_NONE, id, adaptive_window_size_), 0);
+    }
+  }
 }
 
 
@@ -897,6 +965,7 @@ int Http2Session::OnHeaderCallback(nghttp2_session* handle,
   if (!stream->is_destroyed() && !stream->AddHeader(name, value, flags)) {
     // This will only happen if the connected peer sends us more
     // than the allowed number of header items at any given time
+    session->js_fields_->header_stats[kRejectedHeaderBlocks]++;
     stream->SubmitRstStream(NGHTTP2_ENHANCE_YOUR_CALM);
     return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
   }
@@ -1093,6 +1162,8 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
   // so that it can send a WINDOW_UPDATE frame. This is a critical part of
   // the flow control process in http2
   CHECK_EQ(nghttp2_session_consume_connection(handle, len), 0);
+  if (session->max_adaptive_window_size_ > 0)
+    session->SampleBandwidthDelayProduct(len);
   BaseObjectPtr<Http2Stream> stream = session->FindStream(id);
 
   // If the stream has been destroyed, ignore this chunk
@@ -1100,6 +1171,8 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
     return 0;
 
   stream->statistics_.received_bytes += len;
+  if (stream->statistics_.first_byte == 0)
+    stream->statistics_.first_byte = uv_hrtime();
 
   // Repeatedly ask the stream's owner for memory, and copy the read data
   // into those buffers.
@@ -1270,14 +1343,35 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
   MaybeStackBuffer<Local<Value>, 32> sensitive_v(stream->headers_count());
   size_t sensitive_count = 0;
 
+  // Requests that do not use the RFC 7540 priority scheme may carry an RFC
+  // 9218 priority header instead.
+  const bool use_priority_header =
+      session_type_ == NGHTTP2_SESSION_SERVER &&
+      stream->headers_category() == NGHTTP2_HCAT_REQUEST &&
+      !(frame->hd.flags & NGHTTP2_FLAG_PRIORITY);
+
   stream->TransferHeaders([&](const Http2Header& header, size_t i) {
-    headers_v[i * 2] = header.GetName(this).ToLocalChecked();
-    headers_v[i * 2 + 1] = header.GetValue(this).ToLocalChecked();
-    if (header.flags() & NGHTTP2_NV_FLAG_NO_INDEX)
+    const bool sensitive = header.flags() & NGHTTP2_NV_FLAG_NO_INDEX;
+    if (use_priority_header &&
+        header.name_buffer().len() == 8 &&
+        memcmp(header.name_buffer().data(), "priority", 8) == 0) {
+      ApplyExtensiblePriority(stream.get(), header.value_buffer());
+    }
+    headers_v[i * 2] =
+        GetHeaderString(header.name_buffer(), sensitive).ToLocalChecked();
+    headers_v[i * 2 + 1] =
+        GetHeaderString(header.value_buffer(), sensitive).ToLocalChecked();
+    if (sensitive)
       sensitive_v[sensitive_count++] = headers_v[i * 2];
   });
   CHECK_EQ(stream->headers_count(), 0);
 
+  double* header_stats = js_fields_->header_stats;
+  const size_t headers_length = stream->current_headers_length_;
+  header_stats[kHeaderBytesReceived] += headers_length;
+  if (headers_length > header_stats[kMaxHeaderListSizeReceived])
+    header_stats[kMaxHeaderListSizeReceived] = headers_length;
+
   DecrementCurrentSessionMemory(stream->current_headers_length_);
   stream->current_headers_length_ = 0;
 
@@ -1293,6 +1387,106 @@ void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
                arraysize(args), args);
 }
 
+// Parses the urgency and incremental parameters of an RFC 9218 priority
+// header, which is a Structured Fields dictionary such as "u=1, i". Unknown
+// and malformed members are ignored, leaving the defaults in place.
+static void ParseExtensiblePriority(const uint8_t* data,
+                                    size_t len,
+                                    uint8_t* urgency,
+                                    bool* incremental) {
+  size_t i = 0;
+  while (i < len) {
+    while (i < len && (data[i] == ' ' || data[i] == '\t' || data[i] == ','))
+      i++;
+    size_t key = i;
+    while (i < len && data[i] != '=' && data[i] != ',' && data[i] != ';')
+      i++;
+    size_t key_len = i - key;
+    size_t value = i;
+    size_t value_len = 0;
+    if (i < len && data[i] == '=') {
+      value = ++i;
+      while (i < len && data[i] != ',' && data[i] != ';')
+        i++;
+      value_len = i - value;
+    }
+    // Parameters of a member, e.g. "u=1;foo", are skipped.
+    while (i < len && data[i] != ',')
+      i++;
+
+    if (key_len != 1)
+      continue;
+    if (data[key] == 'u' && value_len == 1 &&
+        data[value] >= '0' && data[value] < '0' + kUrgencyLevels) {
+      *urgency = data[value] - '0';
+    } else if (data[key] == 'i') {
+      if (value_len == 0)
+        *incremental = true;
+      else if (value_len == 2 && data[value] == '?' && data[value + 1] == '1')
+        *incremental = true;
+      else if (value_len == 2 && data[value] == '?' && data[value + 1] == '0')
+        *incremental = false;
+    }
+  }
+}
+
+// Maps an RFC 9218 priority onto the RFC 7540 dependency tree that nghttp2
+// schedules DATA frames by. Every urgency level halves the weight, starting
+// with urgency 3, the default, at the default weight of 16. Non-incremental
+// streams depend on the previous non-incremental stream of the same urgency
+// that is still open, so that they are completed in order.
+void Http2Session::ApplyExtensiblePriority(Http2Stream* stream,
+                                           const Http2RcBufferPointer& value) {
+  uint8_t urgency = 3;
+  bool incremental = false;
+  ParseExtensiblePriority(value.data(), value.len(), &urgency, &incremental);
+
+  int32_t weight = urgency <= 3 ?
+      NGHTTP2_DEFAULT_WEIGHT << (3 - urgency) :
+      NGHTTP2_DEFAULT_WEIGHT >> (urgency - 3);
+  int32_t parent = 0;
+  if (!incremental) {
+    // nghttp2 would fall back to the default priority for a parent that it
+    // no longer tracks, so only depend on streams that it still knows about.
+    int32_t previous = sequential_streams_[urgency];
+    if (previous != 0 &&
+        nghttp2_session_find_stream(session_.get(), previous) != nullptr) {
+      parent = previous;
+    }
+    sequential_streams_[urgency] = stream->id();
+  }
+
+  Debug(this, "stream %d has urgency %d, incremental %d",
+        stream->id(), urgency, incremental);
+  nghttp2_priority_spec spec;
+  nghttp2_priority_spec_init(&spec, parent, weight, 0);
+  nghttp2_session_change_stream_priority(session_.get(), stream->id(), &spec);
+}
+
+// Returns the string for a received header name or value. Buffers of moderate
+// size are looked up in header_string_cache_ first. Sensitive fields are never
+// added to the HPACK dynamic table, so they are not cached either.
+MaybeLocal<String> Http2Session::GetHeaderString(
+    const Http2RcBufferPointer& buf,
+    bool sensitive) {
+  if (sensitive || buf.IsStatic() || buf.len() == 0 ||
+      buf.len() > kMaxCachedHeaderStringLength) {
+    return Http2RcBufferPointer::External::New(this, buf);
+  }
+
+  const uintptr_t key = reinterpret_cast<uintptr_t>(buf.get());
+  HeaderStringCacheEntry& entry =
+      header_string_cache_[(key >> 4) % kHeaderStringCacheSize];
+  if (entry.buf.get() == buf.get())
+    return entry.string.Get(env()->isolate());
+
+  Local<String> string;
+  if (!Http2RcBufferPointer::External::New(this, buf).ToLocal(&string))
+    return MaybeLocal<String>();
+  entry.buf = buf;
+  entry.string.Reset(env()->isolate(), string);
+  return string;
+}
 
 // Called by OnFrameReceived when a complete PRIORITY frame has been
 // received. Notifies JS land about the priority change. Note that priorities
@@ -1426,6 +1620,14 @@ void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   Local<Value> arg;
   bool ack = frame->hd.flags & NGHTTP2_FLAG_ACK;
   if (ack) {
+    if (bdp_ping_start_ != 0 &&
+        memcmp(frame->ping.opaque_data,
+               &bdp_ping_start_,
+               sizeof(bdp_ping_start_)) == 0) {
+      HandleBandwidthDelayProductAck();
+      return;
+    }
+
     BaseObjectPtr<Http2Ping> ping = PopPing();
 
     if (!ping) {
@@ -1680,20 +1882,31 @@ uint8_t Http2Session::SendPendingData() {
 
   // Set the buffer base pointers for copied data that ended up in the
   // sessions's own storage since it might have shifted around during gathering.
-  // (Those are marked by having .base == nullptr.)
+  // (Those are marked by having .base == nullptr.) Consecutive pieces of
+  // copied data are adjacent in the storage, so they share a single buffer.
   size_t offset = 0;
   size_t i = 0;
+  bool previous_copied = false;
   for (const NgHttp2StreamWrite& write : outgoing_buffers_) {
     statistics_.data_sent += write.buf.len;
     if (write.buf.base == nullptr) {
-      bufs[i++] = uv_buf_init(
-          reinterpret_cast<char*>(outgoing_storage_.data() + offset),
-          write.buf.len);
+      if (write.buf.len == 0)
+        continue;
+      if (previous_copied) {
+        bufs[i - 1].len += write.buf.len;
+      } else {
+        bufs[i++] = uv_buf_init(
+            reinterpret_cast<char*>(outgoing_storage_.data() + offset),
+            write.buf.len);
+      }
       offset += write.buf.len;
+      previous_copied = true;
     } else {
       bufs[i++] = write.buf;
+      previous_copied = false;
     }
   }
+  count = i;
 
   chunks_sent_since_last_write_++;
 
@@ -1744,15 +1957,27 @@ int Http2Session::OnSendData(
     if (write.buf.len <= length) {
       // This write does not suffice by itself, so we can consume it completely.
       length -= write.buf.len;
+      if (write.buf.len <= kMaxCopiedDataLength) {
+        // Keep the (now empty) write around, so that it is only completed
+        // once the copied data has actually been written.
+        session->CopyDataIntoOutgoing(
+            reinterpret_cast<const uint8_t*>(write.buf.base), write.buf.len);
+        write.buf = uv_buf_init(nullptr, 0);
+      }
       session->PushOutgoingBuffer(std::move(write));
       stream->queue_.pop();
       continue;
     }
 
     // Slice off `length` bytes of the first write in the queue.
-    session->PushOutgoingBuffer(NgHttp2StreamWrite {
-      uv_buf_init(write.buf.base, length)
-    });
+    if (length <= kMaxCopiedDataLength) {
+      session->CopyDataIntoOutgoing(
+          reinterpret_cast<const uint8_t*>(write.buf.base), length);
+    } else {
+      session->PushOutgoingBuffer(NgHttp2StreamWrite {
+        uv_buf_init(write.buf.base, length)
+      });
+    }
     write.buf.base += length;
     write.buf.len -= length;
     break;
@@ -1786,8 +2011,10 @@ Http2Stream* Http2Session::SubmitRequest(
       *prov,
       nullptr);
   CHECK_NE(*ret, NGHTTP2_ERR_NOMEM);
-  if (LIKELY(*ret > 0))
+  if (LIKELY(*ret > 0)) {
+    CountSentHeaders(headers);
     stream = Http2Stream::New(this, *ret, NGHTTP2_HCAT_HEADERS, options);
+  }
   return stream;
 }
 
@@ -2066,6 +2293,7 @@ void Http2Stream::Destroy() {
   session_->statistics_.stream_average_duration =
       ((statistics_.end_time - statistics_.start_time) /
           session_->statistics_.stream_count) / 1e6;
+  session_->RecordStreamStatistics(statistics_);
   EmitStatistics();
 }
 
@@ -2090,6 +2318,8 @@ int Http2Stream::SubmitResponse(const Http2Headers& headers, int options) {
       headers.length(),
       *prov);
   CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
+  if (ret == 0)
+    session_->CountSentHeaders(headers);
   return ret;
 }
 
@@ -2108,6 +2338,8 @@ int Http2Stream::SubmitInfo(const Http2Headers& headers) {
       headers.length(),
       nullptr);
   CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
+  if (ret == 0)
+    session_->CountSentHeaders(headers);
   return ret;
 }
 
@@ -2144,6 +2376,8 @@ int Http2Stream::SubmitTrailers(const Http2Headers& headers) {
         id_,
         headers.data(),
         headers.length());
+    if (ret == 0)
+      session_->CountSentHeaders(headers);
   }
   CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
   return ret;
@@ -2214,6 +2448,7 @@ Http2Stream* Http2Stream::SubmitPushPromise(const Http2Headers& headers,
   CHECK_NE(*ret, NGHTTP2_ERR_NOMEM);
   Http2Stream* stream = nullptr;
   if (*ret > 0) {
+    session_->CountSentHeaders(headers);
     stream = Http2Stream::New(
         session_.get(), *ret, NGHTTP2_HCAT_HEADERS, options);
   }
@@ -2531,6 +2766,31 @@ void Http2Session::RefreshState(const FunctionCallbackInfo<Value>& args) {
       static_cast<double>(nghttp2_session_get_hd_inflate_dynamic_table_size(s));
 }
 
+// Returns the time to first header, time to first byte and stream duration
+// histograms as an array of Histogram handles, or undefined if the session
+// was not created with the latencyHistograms option.
+void Http2Session::GetHistograms(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Http2Session* session;
+  ASSIGN_OR_RETURN_UNWRAP(&session, args.Holder());
+  if (!session->stream_duration_histogram_)
+    return;
+
+  BaseObjectPtr<HistogramBase> histograms[] = {
+    HistogramBase::Create(env, session->time_to_first_header_histogram_),
+    HistogramBase::Create(env, session->time_to_first_byte_histogram_),
+    HistogramBase::Create(env, session->stream_duration_histogram_),
+  };
+  Local<Value> values[arraysize(histograms)];
+  for (size_t i = 0; i < arraysize(histograms); i++) {
+    if (!histograms[i])
+      return;
+    values[i] = histograms[i]->object();
+  }
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), values, arraysize(values)));
+}
+
 
 // Constructor for new Http2Session instances.
 void Http2Session::New(const FunctionCallbackInfo<Value>& args) {
@@ -2925,6 +3185,83 @@ bool Http2Session::AddPing(const uint8_t* payload, Local<Function> callback) {
   return true;
 }
 
+// Starts a new bandwidth-delay product probe unless one is outstanding, and
+// counts the received bytes towards the current one.
+void Http2Session::SampleBandwidthDelayProduct(size_t length) {
+  if (bdp_ping_start_ != 0) {
+    bdp_bytes_ += length;
+    return;
+  }
+  // Nothing left to learn once the window has reached its upper bound.
+  if (adaptive_window_size_ >= max_adaptive_window_size_ &&
+      adaptive_window_size_ > 0) {
+    return;
+  }
+
+  bdp_ping_start_ = uv_hrtime();
+  bdp_bytes_ = length;
+  uint8_t payload[8];
+  memcpy(&payload, &bdp_ping_start_, arraysize(payload));
+  Debug(this, "sending bandwidth-delay product probe");
+  CHECK_EQ(nghttp2_submit_ping(session_.get(), NGHTTP2_FLAG_NONE, payload), 0);
+}
+
+// The probe started a round trip ago, so the bytes received since then are
+// roughly what the peer is able to keep in flight. If that comes close to
+// the current window, the window is what limits the transfer: grow it to
+// twice the sample, similar to gRPC's BDP estimator.
+void Http2Session::HandleBandwidthDelayProductAck() {
+  uint64_t rtt = uv_hrtime() - bdp_ping_start_;
+  uint64_t sample = bdp_bytes_;
+  bdp_ping_start_ = 0;
+  bdp_bytes_ = 0;
+
+  statistics_.ping_rtt = rtt;
+  statistics_.bdp_estimate = sample;
+  Debug(this, "bandwidth-delay product estimate: %d bytes in %d ms",
+        sample, rtt / 1000000);
+
+  uint32_t window = adaptive_window_size_;
+  if (window == 0) {
+    window = nghttp2_session_get_local_settings(
+        session_.get(), NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE);
+  }
+  if (sample * 3 < static_cast<uint64_t>(window) * 2)
+    return;
+
+  uint64_t target = sample * 2;
+  if (target > max_adaptive_window_size_)
+    target = max_adaptive_window_size_;
+  if (target > window)
+    GrowAdaptiveWindow(static_cast<uint32_t>(target));
+}
+
+// Raises the connection window and the windows of all open streams, which
+// sends WINDOW_UPDATE frames for the difference. Windows that are already
+// larger, e.g. because of setLocalWindowSize(), are left alone.
+void Http2Session::GrowAdaptiveWindow(uint32_t window_size) {
+  Debug(this, "growing flow control windows to %d", window_size);
+  adaptive_window_size_ = window_size;
+  statistics_.adaptive_window_size = window_size;
+
+  nghttp2_session* session = session_.get();
+  if (static_cast<uint32_t>(
+          nghttp2_session_get_effective_local_window_size(session)) <
+      window_size) {
+    CHECK_EQ(nghttp2_session_set_local_window_size(
+        session, NGHTTP2_FLAG_NONE, 0, window_size), 0);
+  }
+  for (const auto& kv : streams_) {
+    int32_t id = kv.first;
+    if (static_cast<uint32_t>(
+            nghttp2_session_get_stream_effective_local_window_size(
+                session, id)) < window_size) {
+      CHECK_EQ(nghttp2_session_set_local_window_size(
+          session, NGHTTP2_FLAG_NONE, id, window_size), 0);
+    }
+  }
+}
+
 BaseObjectPtr<Http2Settings> Http2Session::PopSettings() {
   BaseObjectPtr<Http2Settings> settings;
   if (!outstanding_settings_.empty()) {
@@ -3093,6 +3430,12 @@ void Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kSessionFrameErrorListenerCount);
   NODE_DEFINE_CONSTANT(target, kSessionMaxInvalidFrames);
   NODE_DEFINE_CONSTANT(target, kSessionMaxRejectedStreams);
+  NODE_DEFINE_CONSTANT(target, kSessionHeaderStatsOffset);
+  NODE_DEFINE_CONSTANT(target, kHeaderBytesReceived);
+  NODE_DEFINE_CONSTANT(target, kHeaderBytesSent);
+  NODE_DEFINE_CONSTANT(target, kMaxHeaderListSizeReceived);
+  NODE_DEFINE_CONSTANT(target, kRejectedHeaderBlocks);
+  NODE_DEFINE_CONSTANT(target, kSessionHeaderStatsCount);
   NODE_DEFINE_CONSTANT(target, kSessionUint8FieldCount);
 
   NODE_DEFINE_CONSTANT(target, kSessionHasRemoteSettingsListeners);
@@ -3157,6 +3500,7 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(session, "updateChunksSent",
                       Http2Session::UpdateChunksSent);
   env->SetProtoMethod(session, "refreshState", Http2Session::RefreshState);
+  env->SetProtoMethod(session, "getHistograms", Http2Session::GetHistograms);
   env->SetProtoMethod(
       session, "localSettings",
       Http2Session::RefreshSettings<nghttp2_session_get_local_settings>);
@@ -10,6 +10,7 @@
 #include "env.h"
 #include "allocated_buffer.h"
 #include "aliased_struct.h"
+#include "histogram.h"
 #include "node_http2_state.h"
 #include "node_http_common.h"
 #include "node_mem.h"
@@ -39,6 +40,19 @@ constexpr size_t kDefaultMaxSettings = 10;
 // Default maximum total memory cap for Http2Session.
 constexpr uint64_t kDefaultMaxSessionMemory = 10000000;
 
+// DATA frame payloads up to this size are copied into the session's own
+// outgoing storage, next to their frame header, so that the frames of many
+// streams are written to the socket as a few large buffers.
+constexpr size_t kMaxCopiedDataLength = 1024;
+
+// Number of urgency levels of RFC 9218 extensible priorities.
+constexpr uint8_t kUrgencyLevels = 8;
+
+// Range and precision of the stream latency histograms. Latencies are
+// recorded in nanoseconds, anything above an hour counts as exceeding.
+constexpr int64_t kMaxHistogramLatency = 3600LL * 1000 * 1000 * 1000;
+constexpr int kHistogramFigures = 2;
+
 // These are the standard HTTP/2 defaults as specified by the RFC
 constexpr uint32_t DEFAULT_SETTINGS_HEADER_TABLE_SIZE = 4096;
 constexpr uint32_t DEFAULT_SETTINGS_ENABLE_PUSH = 1;
@@ -234,6 +248,23 @@ class Http2Options {
     return max_session_memory_;
   }
 
+  void set_max_adaptive_window_size(uint32_t max) {
+    max_adaptive_window_size_ =
+        max < MAX_INITIAL_WINDOW_SIZE ? max : MAX_INITIAL_WINDOW_SIZE;
+  }
+
+  uint32_t max_adaptive_window_size() const {
+    return max_adaptive_window_size_;
+  }
+
+  void set_latency_histograms(bool on) {
+    latency_histograms_ = on;
+  }
+
+  bool latency_histograms() const {
+    return latency_histograms_;
+  }
+
  private:
   Nghttp2OptionPointer options_;
   uint64_t max_session_memory_ = kDefaultMaxSessionMemory;
@@ -241,6 +272,8 @@ class Http2Options {
   PaddingStrategy padding_strategy_ = PADDING_STRATEGY_NONE;
   size_t max_outstanding_pings_ = kDefaultMaxPings;
   size_t max_outstanding_settings_ = kDefaultMaxSettings;
+  uint32_t max_adaptive_window_size_ = 0;
+  bool latency_histograms_ = false;
 };
 
 struct Http2Priority : public nghttp2_priority_spec {
@@ -535,12 +568,24 @@ class Http2Stream::Provider::Stream : public Http2Stream::Provider {
                         void* user_data);
 };
 
+// Header accounting, kept in js_fields_ so that JS can read it without
+// calling into C++. Sizes are counted like SETTINGS_MAX_HEADER_LIST_SIZE:
+// the length of name and value plus 32 bytes for each field.
+enum SessionHeaderStats {
+  kHeaderBytesReceived,
+  kHeaderBytesSent,
+  kMaxHeaderListSizeReceived,
+  kRejectedHeaderBlocks,
+  kSessionHeaderStatsCount
+};
+
 struct SessionJSFields {
   uint8_t bitfield;
   uint8_t priority_listener_count;
   uint8_t frame_error_listener_count;
   uint32_t max_invalid_frames = 1000;
   uint32_t max_rejected_streams = 100;
+  double header_stats[kSessionHeaderStatsCount] = {};
 };
 
 // Indices for js_fields_, which serves as a way to communicate data with JS
@@ -555,6 +600,7 @@ enum SessionUint8Fields {
       offsetof(SessionJSFields, frame_error_listener_count),
   kSessionMaxInvalidFrames = offsetof(SessionJSFields, max_invalid_frames),
   kSessionMaxRejectedStreams = offsetof(SessionJSFields, max_rejected_streams),
+  kSessionHeaderStatsOffset = offsetof(SessionJSFields, header_stats),
   kSessionUint8FieldCount = sizeof(SessionJSFields)
 };
 
@@ -706,6 +752,7 @@ class Http2Session : public AsyncWrap,
   static void Goaway(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void UpdateChunksSent(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RefreshState(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetHistograms(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Ping(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AltSvc(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Origin(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -763,11 +810,20 @@ class Http2Session : public AsyncWrap,
     int32_t stream_count;
     size_t max_concurrent_streams;
     double stream_average_duration;
+    uint64_t bdp_estimate;          // Bytes received during the last probe
+    uint32_t adaptive_window_size;  // Window chosen by adaptive flow control
     SessionType session_type;
   };
 
   Statistics statistics_ = {};
 
+  // Adds a header block that is about to be sent to the header statistics.
+  void CountSentHeaders(const Http2Headers& headers);
+
+  // Records the latencies of a closed stream into the session's histograms,
+  // if they are enabled.
+  void RecordStreamStatistics(const Http2Stream::Statistics& statistics);
+
  private:
   void EmitStatistics();
 
@@ -781,9 +837,18 @@ class Http2Session : public AsyncWrap,
   int HandleDataFrame(const nghttp2_frame* frame);
   void HandleGoawayFrame(const nghttp2_frame* frame);
   void HandleHeadersFrame(const nghttp2_frame* frame);
+  v8::MaybeLocal<v8::String> GetHeaderString(const Http2RcBufferPointer& buf,
+                                             bool sensitive);
   void HandlePriorityFrame(const nghttp2_frame* frame);
+  void ApplyExtensiblePriority(Http2Stream* stream,
+                               const Http2RcBufferPointer& value);
   void HandleSettingsFrame(const nghttp2_frame* frame);
   void HandlePingFrame(const nghttp2_frame* frame);
+
+  // Adaptive flow control
+  void SampleBandwidthDelayProduct(size_t length);
+  void HandleBandwidthDelayProductAck();
+  void GrowAdaptiveWindow(uint32_t window_size);
   void HandleAltSvcFrame(const nghttp2_frame* frame);
   void HandleOriginFrame(const nghttp2_frame* frame);
 
@@ -899,9 +964,44 @@ class Http2Session : public AsyncWrap,
   AllocatedBuffer stream_buf_allocation_;
   size_t stream_buf_offset_ = 0;
 
+  // Strings for received header names and values, keyed by the rcbuf they
+  // were decoded into. Fields that are served from the HPACK dynamic table
+  // share the rcbuf of the table entry, so headers that repeat on every
+  // request map to the same string. Each entry holds a reference to its
+  // rcbuf, so that the address cannot be reused for different contents.
+  struct HeaderStringCacheEntry {
+    Http2RcBufferPointer buf;
+    v8::Global<v8::String> string;
+  };
+  static constexpr size_t kHeaderStringCacheSize = 64;
+  static constexpr size_t kMaxCachedHeaderStringLength = 1024;
+  HeaderStringCacheEntry header_string_cache_[kHeaderStringCacheSize];
+
   size_t max_outstanding_pings_ = kDefaultMaxPings;
   std::queue<BaseObjectPtr<Http2Ping>> outstanding_pings_;
 
+  // When adaptive flow control is enabled, a PING is sent along with the
+  // first DATA received after the previous one was acknowledged. The bytes
+  // received until the acknowledgement arrives estimate the bandwidth-delay
+  // product of the connection. These PINGs are not Http2Ping objects, they
+  // are recognized by their payload, which is the time they were sent at.
+  uint32_t max_adaptive_window_size_ = 0;
+  uint32_t adaptive_window_size_ = 0;
+  uint64_t bdp_ping_start_ = 0;
+  uint64_t bdp_bytes_ = 0;
+
+  // The most recent non-incremental stream of each RFC 9218 urgency level.
+  // Later non-incremental streams of the same urgency depend on it, so that
+  // they are sent one after the other instead of interleaved.
+  int32_t sequential_streams_[kUrgencyLevels] = {};
+
+  // Stream latencies, in nanoseconds. Only allocated when the session was
+  // created with the latencyHistograms option, since each one is a few
+  // dozen kilobytes and sessions are plentiful.
+  std::shared_ptr<Histogram> time_to_first_header_histogram_;
+  std::shared_ptr<Histogram> time_to_first_byte_histogram_;
+  std::shared_ptr<Histogram> stream_duration_histogram_;
+
   size_t max_outstanding_settings_ = kDefaultMaxSettings;
   std::queue<BaseObjectPtr<Http2Settings>> outstanding_settings_;
 
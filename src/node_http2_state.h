@@ -55,6 +55,8 @@ namespace http2 {
     IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS,
     IDX_OPTIONS_MAX_SESSION_MEMORY,
     IDX_OPTIONS_MAX_SETTINGS,
+    IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE,
+    IDX_OPTIONS_LATENCY_HISTOGRAMS,
     IDX_OPTIONS_FLAGS
   };
 
@@ -508,6 +508,11 @@ class NgHeader final : public NgHeaderBase<typename T::allocator_t> {
   inline size_t length() const override;
   inline uint8_t flags() const override;
 
+  // The reference counted buffers holding the name and the value. The name
+  // buffer is empty for headers that are identified by a token.
+  const rcbufferpointer_t& name_buffer() const { return name_; }
+  const rcbufferpointer_t& value_buffer() const { return value_; }
+
   void MemoryInfo(MemoryTracker* tracker) const override;
 
   SET_MEMORY_INFO_NAME(NgHeader)
@@ -21,17 +21,24 @@
 
 #include "node.h"
 #include "node_buffer.h"
+#include "string_bytes.h"
 #include "util.h"
 
+#include "allocated_buffer-inl.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_diagnostics_channel.h"
+#include "node_http_common.h"
 #include "stream_base-inl.h"
 #include "v8.h"
 #include "llhttp.h"
 
+#include <cstdio>  // snprintf()
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <memory>
+#include <vector>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -50,6 +57,7 @@ namespace node {
 namespace {  // NOLINT(build/namespaces)
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -57,15 +65,19 @@ using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Number;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -76,13 +88,44 @@ const uint32_t kOnBody = 3;
 const uint32_t kOnMessageComplete = 4;
 const uint32_t kOnExecute = 5;
 const uint32_t kOnTimeout = 6;
-// Any more fields than this will be flushed into JS
-const size_t kMaxHeaderFieldsCount = 32;
+const uint32_t kOnRequestBatch = 7;
+// Header storage grows past this as needed.
+const size_t kInitialHeaderFieldsCount = 32;
 
 inline bool IsOWS(char c) {
   return c == ' ' || c == '\t';
 }
 
+// Well-known header names, taken from the tables shared with HTTP/2.
+const char* const kKnownHeaderNames[] = {
+#define V(name, value) value,
+  HTTP_REGULAR_HEADERS(V)
+  HTTP_ADDITIONAL_HEADERS(V)
+#undef V
+};
+
+const size_t kKnownHeaderLengths[] = {
+#define V(name, value) sizeof(value) - 1,
+  HTTP_REGULAR_HEADERS(V)
+  HTTP_ADDITIONAL_HEADERS(V)
+#undef V
+};
+
+constexpr size_t kKnownHeaderCount = arraysize(kKnownHeaderNames);
+
+// Whether `str` is the lowercase `name` with the first letter of every
+// dash-separated word in uppercase, e.g. `Content-Type`.
+inline bool IsTitleCaseOf(const char* str, const char* name, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    char c = name[i];
+    if ((i == 0 || name[i - 1] == '-') && c >= 'a' && c <= 'z')
+      c -= 'a' - 'A';
+    if (str[i] != c)
+      return false;
+  }
+  return true;
+}
+
 class BindingData : public BaseObject {
  public:
   BindingData(Environment* env, Local<Object> obj)
@@ -90,72 +133,154 @@ class BindingData : public BaseObject {
 
   static constexpr FastStringKey type_name { "http_parser" };
 
-  std::vector<char> parser_buffer;
+  // Shared buffer for reads from consumed streams. It is handed over to
+  // JS when a read contains body data, and reallocated on the next read.
+  AllocatedBuffer parser_buffer;
   bool parser_buffer_in_use = false;
 
+  // Returns a cached, internalized string if `str` is a well-known header
+  // name spelled either in lowercase or in Title-Case, and an empty handle
+  // otherwise.
+  Local<String> GetKnownHeaderName(const char* str, size_t length) {
+    for (size_t i = 0; i < kKnownHeaderCount; i++) {
+      if (kKnownHeaderLengths[i] != length)
+        continue;
+      const char* name = kKnownHeaderNames[i];
+      size_t slot;
+      if (memcmp(str, name, length) == 0)
+        slot = 0;
+      else if (IsTitleCaseOf(str, name, length))
+        slot = 1;
+      else
+        continue;
+      Global<String>& cached = known_header_names_[i][slot];
+      if (cached.IsEmpty()) {
+        Local<String> name_str;
+        if (!String::NewFromOneByte(env()->isolate(),
+                                    reinterpret_cast<const uint8_t*>(str),
+                                    NewStringType::kInternalized,
+                                    length).ToLocal(&name_str)) {
+          return Local<String>();
+        }
+        cached.Reset(env()->isolate(), name_str);
+        return name_str;
+      }
+      return cached.Get(env()->isolate());
+    }
+    return Local<String>();
+  }
+
   void MemoryInfo(MemoryTracker* tracker) const override {
-    tracker->TrackField("parser_buffer", parser_buffer);
+    tracker->TrackFieldWithSize("parser_buffer", parser_buffer.size());
   }
   SET_SELF_SIZE(BindingData)
   SET_MEMORY_INFO_NAME(BindingData)
+
+ private:
+  // Lowercase and Title-Case spellings of kKnownHeaderNames.
+  Global<String> known_header_names_[kKnownHeaderCount][2];
 };
 
 // TODO(addaleax): Remove once we're on C++17.
 constexpr FastStringKey BindingData::type_name;
 
-// helper class for the Parser
-struct StringPtr {
-  StringPtr() {
-    on_heap_ = false;
-    Reset();
+// Memory for header strings that need to outlive the buffer they were parsed
+// from, either because they span several chunks of input or because they
+// are kept across parser.execute() calls. Everything is released at once
+// when the next message starts.
+class HeaderArena {
+ public:
+  char* Allocate(size_t size) {
+    if (chunks_.empty() || chunks_.back().size - used_ < size) {
+      // Leave room for the allocation to grow through Extend().
+      size_t chunk_size = 2 * size > kChunkSize ? 2 * size : kChunkSize;
+      chunks_.push_back({ std::unique_ptr<char[]>(new char[chunk_size]),
+                          chunk_size });
+      used_ = 0;
+    }
+    char* ret = chunks_.back().data.get() + used_;
+    used_ += size;
+    return ret;
   }
 
+  // Grows the most recent allocation in place, if there is room for it.
+  bool Extend(const char* data, size_t size, size_t extra) {
+    if (chunks_.empty())
+      return false;
+    const Chunk& chunk = chunks_.back();
+    if (data + size != chunk.data.get() + used_ || chunk.size - used_ < extra)
+      return false;
+    used_ += extra;
+    return true;
+  }
 
-  ~StringPtr() {
+  // Keeps the first chunk around, most messages fit into it.
+  void Reset() {
+    if (chunks_.size() > 1)
+      chunks_.resize(1);
+    used_ = 0;
+  }
+
+  size_t size() const {
+    size_t ret = 0;
+    for (const Chunk& chunk : chunks_)
+      ret += chunk.size;
+    return ret;
+  }
+
+ private:
+  static constexpr size_t kChunkSize = 4096;
+
+  struct Chunk {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  std::vector<Chunk> chunks_;
+  size_t used_ = 0;
+};
+
+// helper class for the Parser
+struct StringPtr {
+  StringPtr() {
     Reset();
   }
 
 
-  // If str_ does not point to a heap string yet, this function makes it do
-  // so. This is called at the end of each http_parser_execute() so as not
+  // If str_ does not point to memory of its own yet, this function makes it
+  // do so. This is called at the end of each http_parser_execute() so as not
   // to leak references. See issue #2438 and test-http-parser-bad-ref.js.
-  void Save() {
-    if (!on_heap_ && size_ > 0) {
-      char* s = new char[size_];
+  void Save(HeaderArena* arena) {
+    if (!in_arena_ && size_ > 0) {
+      char* s = arena->Allocate(size_);
       memcpy(s, str_, size_);
       str_ = s;
-      on_heap_ = true;
+      in_arena_ = true;
     }
   }
 
 
   void Reset() {
-    if (on_heap_) {
-      delete[] str_;
-      on_heap_ = false;
-    }
-
     str_ = nullptr;
+    in_arena_ = false;
     size_ = 0;
   }
 
 
-  void Update(const char* str, size_t size) {
+  void Update(const char* str, size_t size, HeaderArena* arena) {
     if (str_ == nullptr) {
       str_ = str;
-    } else if (on_heap_ || str_ + size_ != str) {
-      // Non-consecutive input, make a copy on the heap.
-      // TODO(bnoordhuis) Use slab allocation, O(n) allocs is bad.
-      char* s = new char[size_ + size];
+    } else if (in_arena_ && arena->Extend(str_, size_, size)) {
+      // A value that is split across many chunks of input is appended to
+      // in place, rather than being copied over and over again.
+      memcpy(const_cast<char*>(str_) + size_, str, size);
+    } else if (in_arena_ || str_ + size_ != str) {
+      // Non-consecutive input, make a copy.
+      char* s = arena->Allocate(size_ + size);
       memcpy(s, str_, size_);
       memcpy(s + size_, str, size);
-
-      if (on_heap_)
-        delete[] str_;
-      else
-        on_heap_ = true;
-
       str_ = s;
+      in_arena_ = true;
     }
     size_ += size;
   }
@@ -170,31 +295,53 @@ struct StringPtr {
 
 
   // Strip trailing OWS (SPC or HTAB) from string.
-  Local<String> ToTrimmedString(Environment* env) {
+  void Trim() {
     while (size_ > 0 && IsOWS(str_[size_ - 1])) {
       size_--;
     }
+  }
+
+
+  Local<String> ToTrimmedString(Environment* env) {
+    Trim();
     return ToString(env);
   }
 
 
   const char* str_;
-  bool on_heap_;
+  bool in_arena_;
   size_t size_;
 };
 
+class ConnectionsList;
+
 class Parser : public AsyncWrap, public StreamListener {
  public:
+  // The phase a server-side connection is in, which decides the timeout that
+  // ConnectionsList applies to it.
+  enum ConnectionState {
+    kConnectionWaitingForHeaders,
+    kConnectionReadingBody,
+    kConnectionProcessing,
+    kConnectionIdle
+  };
+
   Parser(BindingData* binding_data, Local<Object> wrap)
       : AsyncWrap(binding_data->env(), wrap),
         current_buffer_len_(0),
         current_buffer_data_(nullptr),
         binding_data_(binding_data) {
+    fields_.resize(kInitialHeaderFieldsCount);
+    values_.resize(kInitialHeaderFieldsCount);
   }
 
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackField("current_buffer", current_buffer_);
+    tracker->TrackFieldWithSize(
+        "headers",
+        (fields_.capacity() + values_.capacity()) * sizeof(StringPtr));
+    tracker->TrackFieldWithSize("header_arena", header_arena_.size());
   }
 
   SET_MEMORY_INFO_NAME(Parser)
@@ -204,7 +351,24 @@ class Parser : public AsyncWrap, public StreamListener {
     num_fields_ = num_values_ = 0;
     url_.Reset();
     status_message_.Reset();
+    header_arena_.Reset();
     header_parsing_start_time_ = uv_hrtime();
+    UpdateConnectionState(kConnectionWaitingForHeaders, true);
+
+    // In batch mode, a message that is complete before the end of the input
+    // does not need the callback at all. Otherwise it is made up for before
+    // the message is passed to JS land on its own.
+    if (batch_requests_)
+      message_begin_pending_ = true;
+    else
+      CallMessageBegin();
+
+    return 0;
+  }
+
+
+  void CallMessageBegin() {
+    message_begin_pending_ = false;
 
     Local<Value> cb = object()->Get(env()->context(), kOnMessageBegin)
                               .ToLocalChecked();
@@ -217,8 +381,6 @@ class Parser : public AsyncWrap, public StreamListener {
 
       if (r.IsEmpty()) callback_scope.MarkAsFailed();
     }
-
-    return 0;
   }
 
 
@@ -228,7 +390,7 @@ class Parser : public AsyncWrap, public StreamListener {
       return rv;
     }
 
-    url_.Update(at, length);
+    url_.Update(at, length, &header_arena_);
     return 0;
   }
 
@@ -239,7 +401,7 @@ class Parser : public AsyncWrap, public StreamListener {
       return rv;
     }
 
-    status_message_.Update(at, length);
+    status_message_.Update(at, length, &header_arena_);
     return 0;
   }
 
@@ -253,19 +415,18 @@ class Parser : public AsyncWrap, public StreamListener {
     if (num_fields_ == num_values_) {
       // start of new field name
       num_fields_++;
-      if (num_fields_ == kMaxHeaderFieldsCount) {
-        // ran out of space - flush to javascript land
-        Flush();
-        num_fields_ = 1;
-        num_values_ = 0;
+      if (num_fields_ > fields_.size()) {
+        // The total size is bounded by max_http_header_size_.
+        fields_.resize(fields_.size() * 2);
+        values_.resize(values_.size() * 2);
       }
       fields_[num_fields_ - 1].Reset();
     }
 
-    CHECK_LT(num_fields_, kMaxHeaderFieldsCount);
+    CHECK_LE(num_fields_, fields_.size());
     CHECK_EQ(num_fields_, num_values_ + 1);
 
-    fields_[num_fields_ - 1].Update(at, length);
+    fields_[num_fields_ - 1].Update(at, length, &header_arena_);
 
     return 0;
   }
@@ -283,10 +444,10 @@ class Parser : public AsyncWrap, public StreamListener {
       values_[num_values_ - 1].Reset();
     }
 
-    CHECK_LT(num_values_, arraysize(values_));
+    CHECK_LE(num_values_, values_.size());
     CHECK_EQ(num_values_, num_fields_);
 
-    values_[num_values_ - 1].Update(at, length);
+    values_[num_values_ - 1].Update(at, length, &header_arena_);
 
     return 0;
   }
@@ -295,6 +456,7 @@ class Parser : public AsyncWrap, public StreamListener {
   int on_headers_complete() {
     header_nread_ = 0;
     header_parsing_start_time_ = 0;
+    UpdateConnectionState(kConnectionReadingBody, false);
 
     // Arguments for the on-headers-complete javascript callback. This
     // list needs to be kept in sync with the actual argument list for
@@ -309,6 +471,7 @@ class Parser : public AsyncWrap, public StreamListener {
       A_STATUS_MESSAGE,
       A_UPGRADE,
       A_SHOULD_KEEP_ALIVE,
+      A_HEADER_OFFSETS,
       A_MAX
     };
 
@@ -324,15 +487,18 @@ class Parser : public AsyncWrap, public StreamListener {
     for (size_t i = 0; i < arraysize(argv); i++)
       argv[i] = undefined;
 
-    if (have_flushed_) {
-      // Slow case, flush remaining headers.
-      Flush();
+    // All headers and the URL are passed to JS land at once.
+    if (lazy_headers_) {
+      MaybeLocal<Object> raw = CreateRawHeaders(&argv[A_HEADER_OFFSETS]);
+      if (!raw.ToLocal(&argv[A_HEADERS])) {
+        got_exception_ = true;
+        return -1;
+      }
     } else {
-      // Fast case, pass headers and URL to JS land.
       argv[A_HEADERS] = CreateHeaders();
-      if (parser_.type == HTTP_REQUEST)
-        argv[A_URL] = url_.ToString(env());
     }
+    if (parser_.type == HTTP_REQUEST)
+      argv[A_URL] = url_.ToString(env());
 
     num_fields_ = 0;
     num_values_ = 0;
@@ -362,6 +528,40 @@ class Parser : public AsyncWrap, public StreamListener {
 
     argv[A_UPGRADE] = Boolean::New(env()->isolate(), parser_.upgrade);
 
+    if (diagnostics_channel::HasSubscribers(
+            env(), diagnostics_channel::kHttpParserHeadersComplete)) {
+      PublishHeadersComplete(argv[A_URL], should_keep_alive);
+    }
+
+    // Requests without a body are complete right after their headers. In
+    // batch mode, collect them so that all of them are passed to JS land
+    // with a single call once the input has been parsed.
+    if (batch_requests_ && parser_.type == HTTP_REQUEST && !parser_.upgrade &&
+        parser_.content_length == 0 && (parser_.flags & F_CHUNKED) == 0) {
+      batch_meta_.insert(batch_meta_.end(), {
+        parser_.http_major,
+        parser_.http_minor,
+        parser_.method,
+        should_keep_alive
+      });
+      batch_fields_.insert(batch_fields_.end(), {
+        argv[A_HEADERS],
+        argv[A_URL],
+        argv[A_HEADER_OFFSETS]
+      });
+      message_begin_pending_ = false;
+      in_batched_message_ = true;
+      return 0;
+    }
+
+    // Everything that came before this message needs to be in JS land first.
+    if (!FlushRequestBatch()) {
+      got_exception_ = true;
+      return -1;
+    }
+    if (message_begin_pending_)
+      CallMessageBegin();
+
     MaybeLocal<Value> head_response;
     {
       InternalCallbackScope callback_scope(
@@ -384,6 +584,43 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  void PublishHeadersComplete(Local<Value> url, bool should_keep_alive) {
+    Isolate* isolate = env()->isolate();
+    Local<Context> context = env()->context();
+    Local<Object> message = Object::New(isolate);
+    USE(message->Set(context,
+                     FIXED_ONE_BYTE_STRING(isolate, "parser"),
+                     object()));
+    if (parser_.type == HTTP_REQUEST) {
+      USE(message->Set(
+          context,
+          FIXED_ONE_BYTE_STRING(isolate, "method"),
+          OneByteString(isolate,
+                        llhttp_method_name(
+                            static_cast<llhttp_method_t>(parser_.method)))));
+      USE(message->Set(context, env()->url_string(), url));
+    } else {
+      USE(message->Set(context,
+                       FIXED_ONE_BYTE_STRING(isolate, "statusCode"),
+                       Integer::New(isolate, parser_.status_code)));
+    }
+    USE(message->Set(context,
+                     FIXED_ONE_BYTE_STRING(isolate, "versionMajor"),
+                     Integer::New(isolate, parser_.http_major)));
+    USE(message->Set(context,
+                     FIXED_ONE_BYTE_STRING(isolate, "versionMinor"),
+                     Integer::New(isolate, parser_.http_minor)));
+    USE(message->Set(context,
+                     FIXED_ONE_BYTE_STRING(isolate, "upgrade"),
+                     Boolean::New(isolate, parser_.upgrade)));
+    USE(message->Set(context,
+                     FIXED_ONE_BYTE_STRING(isolate, "shouldKeepAlive"),
+                     Boolean::New(isolate, should_keep_alive)));
+    diagnostics_channel::Publish(
+        env(), diagnostics_channel::kHttpParserHeadersComplete, message);
+  }
+
+
   int on_body(const char* at, size_t length) {
     EscapableHandleScope scope(env()->isolate());
 
@@ -395,11 +632,25 @@ class Parser : public AsyncWrap, public StreamListener {
 
     // We came from consumed stream
     if (current_buffer_.IsEmpty()) {
+      Local<Object> buffer;
+      if (current_buffer_data_ == binding_data_->parser_buffer.data() &&
+          current_buffer_len_ >= kMinBodyTransferSize) {
+        // Pass the read buffer itself to JS, so that body chunks are views
+        // onto it rather than copies. OnStreamAlloc() allocates a new one.
+        AllocatedBuffer read_buffer = std::move(binding_data_->parser_buffer);
+        if (!read_buffer.ToBuffer().ToLocal(&buffer)) {
+          got_exception_ = true;
+          llhttp_set_error_reason(&parser_, "HPE_JS_EXCEPTION:JS Exception");
+          return HPE_USER;
+        }
+      } else {
+        buffer = Buffer::Copy(
+            env()->isolate(),
+            current_buffer_data_,
+            current_buffer_len_).ToLocalChecked();
+      }
       // Make sure Buffer will be in parent HandleScope
-      current_buffer_ = scope.Escape(Buffer::Copy(
-          env()->isolate(),
-          current_buffer_data_,
-          current_buffer_len_).ToLocalChecked());
+      current_buffer_ = scope.Escape(buffer);
     }
 
     Local<Value> argv[3] = {
@@ -425,6 +676,14 @@ class Parser : public AsyncWrap, public StreamListener {
   int on_message_complete() {
     HandleScope scope(env()->isolate());
 
+    UpdateConnectionState(kConnectionProcessing, false);
+
+    // The JS side completes batched messages itself.
+    if (in_batched_message_) {
+      in_batched_message_ = false;
+      return 0;
+    }
+
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
@@ -486,19 +745,32 @@ class Parser : public AsyncWrap, public StreamListener {
     // it needs to be triggered manually.
     parser->EmitTraceEventDestroy();
     parser->EmitDestroy();
+    parser->RemoveFromConnections();
+  }
+
+
+  // Called once the response to the last received request has been sent.
+  // From then on, the connection is subject to the keep-alive timeout of
+  // its ConnectionsList until the next request starts.
+  static void MarkIdle(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+
+    if (parser->connection_state_ == kConnectionProcessing)
+      parser->UpdateConnectionState(kConnectionIdle, true);
   }
 
 
   void Save() {
-    url_.Save();
-    status_message_.Save();
+    url_.Save(&header_arena_);
+    status_message_.Save(&header_arena_);
 
     for (size_t i = 0; i < num_fields_; i++) {
-      fields_[i].Save();
+      fields_[i].Save(&header_arena_);
     }
 
     for (size_t i = 0; i < num_values_; i++) {
-      values_[i].Save();
+      values_[i].Save(&header_arena_);
     }
   }
 
@@ -540,6 +812,8 @@ class Parser : public AsyncWrap, public StreamListener {
   static void Initialize(const FunctionCallbackInfo<Value>& args) {
     Environment* env = Environment::GetCurrent(args);
     bool lenient = args[3]->IsTrue();
+    bool lazy_headers = args[5]->IsTrue();
+    bool batch_requests = args[7]->IsTrue();
 
     uint64_t max_http_header_size = 0;
     uint64_t headers_timeout = 0;
@@ -577,7 +851,12 @@ class Parser : public AsyncWrap, public StreamListener {
 
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
-    parser->Init(type, max_http_header_size, lenient, headers_timeout);
+    parser->Init(type, max_http_header_size, lenient, headers_timeout,
+                 lazy_headers, batch_requests);
+
+    parser->RemoveFromConnections();
+    if (args.Length() > 6 && args[6]->IsObject())
+      parser->AddToConnections(args[6].As<Object>());
   }
 
   template <bool should_pause>
@@ -637,6 +916,9 @@ class Parser : public AsyncWrap, public StreamListener {
 
  protected:
   static const size_t kAllocBufferSize = 64 * 1024;
+  // Reads smaller than this are copied when they contain body data, so that
+  // small chunks do not keep a whole read buffer alive.
+  static const size_t kMinBodyTransferSize = kAllocBufferSize / 4;
 
   uv_buf_t OnStreamAlloc(size_t suggested_size) override {
     // For most types of streams, OnStreamRead will be immediately after
@@ -646,8 +928,10 @@ class Parser : public AsyncWrap, public StreamListener {
       return uv_buf_init(Malloc(suggested_size), suggested_size);
     binding_data_->parser_buffer_in_use = true;
 
-    if (binding_data_->parser_buffer.empty())
-      binding_data_->parser_buffer.resize(kAllocBufferSize);
+    if (binding_data_->parser_buffer.data() == nullptr) {
+      binding_data_->parser_buffer =
+          AllocatedBuffer::AllocateManaged(env(), kAllocBufferSize);
+    }
 
     return uv_buf_init(binding_data_->parser_buffer.data(), kAllocBufferSize);
   }
@@ -657,9 +941,12 @@ class Parser : public AsyncWrap, public StreamListener {
     HandleScope scope(env()->isolate());
     // Once we’re done here, either indicate that the HTTP parser buffer
     // is free for re-use, or free() the data if it didn’t come from there
-    // in the first place.
+    // in the first place. The parser buffer may have been passed on to JS
+    // by on_body() in the meantime, so check this up front.
+    const bool from_parser_buffer =
+        buf.base == binding_data_->parser_buffer.data();
     auto on_scope_leave = OnScopeLeave([&]() {
-      if (buf.base == binding_data_->parser_buffer.data())
+      if (from_parser_buffer)
         binding_data_->parser_buffer_in_use = false;
       else
         free(buf.base);
@@ -737,6 +1024,16 @@ class Parser : public AsyncWrap, public StreamListener {
     }
     execute_depth_--;
 
+    if (got_exception_) {
+      batch_meta_.clear();
+      batch_fields_.clear();
+    } else if (!FlushRequestBatch()) {
+      got_exception_ = true;
+    } else if (message_begin_pending_) {
+      // A message has started but is not complete yet.
+      CallMessageBegin();
+    }
+
     // Calculate bytes read and resume after Upgrade/CONNECT pause
     size_t nread = len;
     if (err != HPE_OK) {
@@ -804,19 +1101,99 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
   Local<Array> CreateHeaders() {
-    // There could be extra entries but the max size should be fixed
-    Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
+    MaybeStackBuffer<Local<Value>, kInitialHeaderFieldsCount * 2> headers_v(
+        num_values_ * 2);
 
     for (size_t i = 0; i < num_values_; ++i) {
-      headers_v[i * 2] = fields_[i].ToString(env());
+      headers_v[i * 2] = binding_data_->GetKnownHeaderName(fields_[i].str_,
+                                                           fields_[i].size_);
+      if (headers_v[i * 2].IsEmpty())
+        headers_v[i * 2] = fields_[i].ToString(env());
       headers_v[i * 2 + 1] = values_[i].ToTrimmedString(env());
     }
 
-    return Array::New(env()->isolate(), headers_v, num_values_ * 2);
+    return Array::New(env()->isolate(), headers_v.out(), num_values_ * 2);
   }
 
+  // Copy the headers into a single Buffer, one `name: value\r\n` line each,
+  // without creating any strings. `offsets` receives a Uint32Array holding
+  // the end of every name and value, so that JS land can decode individual
+  // headers on demand or forward the whole block as is.
+  MaybeLocal<Object> CreateRawHeaders(Local<Value>* offsets) {
+    size_t total = 0;
+    for (size_t i = 0; i < num_values_; ++i) {
+      values_[i].Trim();
+      total += fields_[i].size_ + values_[i].size_ + 4;
+    }
+
+    Local<ArrayBuffer> offsets_ab =
+        ArrayBuffer::New(env()->isolate(), num_values_ * 2 * sizeof(uint32_t));
+    uint32_t* ends =
+        static_cast<uint32_t*>(offsets_ab->GetBackingStore()->Data());
+    Local<Object> raw;
+    if (!Buffer::New(env(), total).ToLocal(&raw))
+      return MaybeLocal<Object>();
 
-  // spill headers and request path to JS land
+    char* data = Buffer::Data(raw);
+    size_t pos = 0;
+    for (size_t i = 0; i < num_values_; ++i) {
+      memcpy(data + pos, fields_[i].str_, fields_[i].size_);
+      pos += fields_[i].size_;
+      ends[i * 2] = pos;
+      data[pos++] = ':';
+      data[pos++] = ' ';
+      memcpy(data + pos, values_[i].str_, values_[i].size_);
+      pos += values_[i].size_;
+      ends[i * 2 + 1] = pos;
+      data[pos++] = '\r';
+      data[pos++] = '\n';
+    }
+    CHECK_EQ(pos, total);
+
+    *offsets = Uint32Array::New(offsets_ab, 0, num_values_ * 2);
+    return raw;
+  }
+
+
+  // Pass the requests collected in batch mode to JS land, described by a
+  // Uint32Array with the HTTP version, method and keep-alive flag of each one
+  // and an array with their headers, URL and header offsets.
+  bool FlushRequestBatch() {
+    if (batch_meta_.empty())
+      return true;
+
+    Isolate* isolate = env()->isolate();
+    size_t count = batch_meta_.size();
+    Local<ArrayBuffer> ab =
+        ArrayBuffer::New(isolate, count * sizeof(batch_meta_[0]));
+    memcpy(ab->GetBackingStore()->Data(),
+           batch_meta_.data(),
+           count * sizeof(batch_meta_[0]));
+    Local<Value> argv[] = {
+      Uint32Array::New(ab, 0, count),
+      Array::New(isolate, batch_fields_.data(), batch_fields_.size())
+    };
+    batch_meta_.clear();
+    batch_fields_.clear();
+
+    Local<Value> cb =
+        object()->Get(env()->context(), kOnRequestBatch).ToLocalChecked();
+    if (!cb->IsFunction())
+      return true;
+
+    MaybeLocal<Value> r;
+    {
+      InternalCallbackScope callback_scope(
+          this, InternalCallbackScope::kSkipTaskQueues);
+      r = cb.As<Function>()->Call(
+          env()->context(), object(), arraysize(argv), argv);
+      if (r.IsEmpty()) callback_scope.MarkAsFailed();
+    }
+    return !r.IsEmpty();
+  }
+
+
+  // spill trailing headers to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
 
@@ -839,24 +1216,30 @@ class Parser : public AsyncWrap, public StreamListener {
       got_exception_ = true;
 
     url_.Reset();
-    have_flushed_ = true;
   }
 
 
   void Init(llhttp_type_t type, uint64_t max_http_header_size,
-            bool lenient, uint64_t headers_timeout) {
+            bool lenient, uint64_t headers_timeout, bool lazy_headers,
+            bool batch_requests) {
     llhttp_init(&parser_, type, &settings);
     llhttp_set_lenient(&parser_, lenient);
     header_nread_ = 0;
     url_.Reset();
     status_message_.Reset();
+    header_arena_.Reset();
     num_fields_ = 0;
     num_values_ = 0;
-    have_flushed_ = false;
     got_exception_ = false;
     max_http_header_size_ = max_http_header_size;
     header_parsing_start_time_ = 0;
     headers_timeout_ = headers_timeout;
+    lazy_headers_ = lazy_headers;
+    batch_requests_ = batch_requests;
+    message_begin_pending_ = false;
+    in_batched_message_ = false;
+    batch_meta_.clear();
+    batch_fields_.clear();
   }
 
 
@@ -891,14 +1274,19 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  inline void AddToConnections(Local<Object> list_object);
+  inline void RemoveFromConnections();
+  inline void UpdateConnectionState(ConnectionState state, bool restart);
+
+
   llhttp_t parser_;
-  StringPtr fields_[kMaxHeaderFieldsCount];  // header fields
-  StringPtr values_[kMaxHeaderFieldsCount];  // header values
+  HeaderArena header_arena_;
+  std::vector<StringPtr> fields_;  // header fields
+  std::vector<StringPtr> values_;  // header values
   StringPtr url_;
   StringPtr status_message_;
   size_t num_fields_;
   size_t num_values_;
-  bool have_flushed_;
   bool got_exception_;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
@@ -909,6 +1297,23 @@ class Parser : public AsyncWrap, public StreamListener {
   uint64_t max_http_header_size_;
   uint64_t headers_timeout_;
   uint64_t header_parsing_start_time_ = 0;
+  bool lazy_headers_ = false;
+
+  // Batch mode state. The handles in `batch_fields_` live in the
+  // HandleScope of Execute() and never outlive it.
+  bool batch_requests_ = false;
+  bool message_begin_pending_ = false;
+  bool in_batched_message_ = false;
+  std::vector<uint32_t> batch_meta_;
+  std::vector<Local<Value>> batch_fields_;
+
+  // Bookkeeping for ConnectionsList. `connection_changed_at_` is the time of
+  // the last state change that restarted the timeout.
+  friend class ConnectionsList;
+  ListNode<Parser> connection_node_;
+  ConnectionsList* connections_ = nullptr;
+  ConnectionState connection_state_ = kConnectionProcessing;
+  uint64_t connection_changed_at_ = 0;
 
   BaseObjectPtr<BindingData> binding_data_;
 
@@ -947,6 +1352,309 @@ const llhttp_settings_t Parser::settings = {
 };
 
 
+// The server-side parsers of an http.Server, ordered by the time at which
+// their current timeout started. A single timer in JS land calls expired()
+// to find connections that ran into the headers, request or keep-alive
+// timeout, instead of keeping a timer for every socket. Because the list is
+// ordered, the scan stops at the first connection that is too young for any
+// of the timeouts.
+class ConnectionsList : public BaseObject {
+ public:
+  enum ExpiredReason {
+    kHeadersTimeout,
+    kRequestTimeout,
+    kKeepAliveTimeout
+  };
+
+  ConnectionsList(Environment* env, Local<Object> object)
+      : BaseObject(env, object) {
+    MakeWeak();
+  }
+
+  ~ConnectionsList() override {
+    while (Parser* parser = parsers_.PopFront())
+      parser->connections_ = nullptr;
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args.IsConstructCall());
+    new ConnectionsList(env, args.This());
+  }
+
+  // expired(headersTimeout, requestTimeout, keepAliveTimeout)
+  // Timeouts are in milliseconds, 0 disables one. Returns a flat array of
+  // parser objects and their ExpiredReason. Reported connections are not
+  // reported again until their next state change.
+  static void Expired(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    ConnectionsList* list;
+    ASSIGN_OR_RETURN_UNWRAP(&list, args.Holder());
+
+    CHECK(args[0]->IsNumber());
+    CHECK(args[1]->IsNumber());
+    CHECK(args[2]->IsNumber());
+    const uint64_t headers_timeout = ToNanoseconds(args[0]);
+    const uint64_t request_timeout = ToNanoseconds(args[1]);
+    const uint64_t keep_alive_timeout = ToNanoseconds(args[2]);
+
+    uint64_t min_timeout = UINT64_MAX;
+    for (uint64_t timeout : { headers_timeout, request_timeout,
+                              keep_alive_timeout }) {
+      if (timeout != 0 && timeout < min_timeout)
+        min_timeout = timeout;
+    }
+
+    const uint64_t now = uv_hrtime();
+    std::vector<Local<Value>> expired;
+    for (Parser* parser : list->parsers_) {
+      const uint64_t elapsed = now - parser->connection_changed_at_;
+      if (elapsed < min_timeout)
+        break;
+
+      int reason = -1;
+      switch (parser->connection_state_) {
+        case Parser::kConnectionWaitingForHeaders:
+          if (headers_timeout != 0 && elapsed >= headers_timeout)
+            reason = kHeadersTimeout;
+          else if (request_timeout != 0 && elapsed >= request_timeout)
+            reason = kRequestTimeout;
+          break;
+        case Parser::kConnectionReadingBody:
+          if (request_timeout != 0 && elapsed >= request_timeout)
+            reason = kRequestTimeout;
+          break;
+        case Parser::kConnectionIdle:
+          if (keep_alive_timeout != 0 && elapsed >= keep_alive_timeout)
+            reason = kKeepAliveTimeout;
+          break;
+        case Parser::kConnectionProcessing:
+          break;
+      }
+      if (reason == -1)
+        continue;
+
+      parser->connection_state_ = Parser::kConnectionProcessing;
+      expired.push_back(parser->object());
+      expired.push_back(Integer::New(env->isolate(), reason));
+    }
+
+    args.GetReturnValue().Set(
+        Array::New(env->isolate(), expired.data(), expired.size()));
+  }
+
+  void Push(Parser* parser) {
+    parsers_.PushBack(parser);
+  }
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(ConnectionsList)
+  SET_SELF_SIZE(ConnectionsList)
+
+ private:
+  static uint64_t ToNanoseconds(Local<Value> ms) {
+    const double value = ms.As<Number>()->Value();
+    return value > 0 ? static_cast<uint64_t>(value * 1e6) : 0;
+  }
+
+  ListHead<Parser, &Parser::connection_node_> parsers_;
+};
+
+
+void Parser::AddToConnections(Local<Object> list_object) {
+  ConnectionsList* list = Unwrap<ConnectionsList>(list_object);
+  CHECK_NOT_NULL(list);
+  connections_ = list;
+  connection_state_ = kConnectionWaitingForHeaders;
+  connection_changed_at_ = uv_hrtime();
+  list->Push(this);
+}
+
+
+void Parser::RemoveFromConnections() {
+  connection_node_.Remove();
+  connections_ = nullptr;
+}
+
+
+void Parser::UpdateConnectionState(ConnectionState state, bool restart) {
+  if (connections_ == nullptr)
+    return;
+
+  connection_state_ = state;
+  if (restart) {
+    // Keep the list ordered by moving the parser to its end.
+    connection_changed_at_ = uv_hrtime();
+    connection_node_.Remove();
+    connections_->Push(this);
+  }
+}
+
+
+// Copies the contents of `string` into `storage` as Latin-1. Returns false
+// if the string contains characters that do not fit into a single byte.
+bool GetOneByteContents(Isolate* isolate,
+                        Local<String> string,
+                        MaybeStackBuffer<uint8_t, 1024>* storage) {
+  if (!string->IsOneByte() && !string->ContainsOnlyOneByte())
+    return false;
+  size_t length = string->Length();
+  storage->AllocateSufficientStorage(length);
+  string->WriteOneByte(isolate, storage->out(), 0, length,
+                       String::NO_NULL_TERMINATION);
+  return true;
+}
+
+// Returns true if any of the eight bytes in `word` is below 0x20 or is 0x7f.
+// Horizontal tabs are reported as well, the caller sorts them out.
+inline bool HasControlByte(uint64_t word) {
+  constexpr uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+  const uint64_t below_space = (word - kOnes * 0x20) & ~word & kHighBits;
+  const uint64_t del = word ^ (kOnes * 0x7f);
+  const uint64_t is_del = (del - kOnes) & ~del & kHighBits;
+  return (below_space | is_del) != 0;
+}
+
+inline bool IsHeaderValueByte(uint8_t c) {
+  return c == '\t' || (c >= 0x20 && c != 0x7f);
+}
+
+// Header values are mostly free of control characters, so check them eight
+// bytes at a time and only look at single bytes when a word contains one.
+bool HasInvalidHeaderValueByte(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (!HasControlByte(word))
+      continue;
+    for (size_t j = i; j < i + sizeof(uint64_t); j++) {
+      if (!IsHeaderValueByte(data[j]))
+        return true;
+    }
+  }
+  for (; i < length; i++) {
+    if (!IsHeaderValueByte(data[i]))
+      return true;
+  }
+  return false;
+}
+
+// tchar as defined in RFC 7230, section 3.2.6.
+inline bool IsTokenByte(uint8_t c) {
+  if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+      (c >= 'A' && c <= 'Z')) {
+    return true;
+  }
+  return c != '\0' && strchr("!#$%&'*+-.^_`|~", c) != nullptr;
+}
+
+// checkInvalidHeaderChar(value)
+// Native counterpart of _http_common's checkInvalidHeaderChar() for long
+// header values.
+void CheckInvalidHeaderChar(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString());
+  MaybeStackBuffer<uint8_t, 1024> value;
+  bool invalid =
+      !GetOneByteContents(args.GetIsolate(), args[0].As<String>(), &value) ||
+      HasInvalidHeaderValueByte(value.out(), value.length());
+  args.GetReturnValue().Set(invalid);
+}
+
+// checkIsHttpToken(value)
+// Native counterpart of _http_common's checkIsHttpToken() for long tokens.
+void CheckIsHttpToken(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsString());
+  MaybeStackBuffer<uint8_t, 1024> value;
+  if (!GetOneByteContents(args.GetIsolate(), args[0].As<String>(), &value) ||
+      value.length() == 0) {
+    return args.GetReturnValue().Set(false);
+  }
+  const uint8_t* data = value.out();
+  for (size_t i = 0; i < value.length(); i++) {
+    if (!IsTokenByte(data[i]))
+      return args.GetReturnValue().Set(false);
+  }
+  args.GetReturnValue().Set(true);
+}
+
+
+// serializeMessage(head, headEncoding, body, bodyEncoding, bodyLength,
+//                  chunked, trailer)
+// Writes a message head together with the body that is sent along with it
+// into a single Buffer, so that both leave in one write without building an
+// intermediate string. `bodyLength` is the byte length of `body` in
+// `bodyEncoding`. If `chunked` is true, the body is framed as a chunk and
+// followed by the last chunk and the `trailer` fields.
+void SerializeMessage(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  CHECK(args[2]->IsString() || args[2]->IsArrayBufferView());
+  CHECK(args[4]->IsUint32());
+  Local<String> head = args[0].As<String>();
+  enum encoding head_enc = ParseEncoding(isolate, args[1], LATIN1);
+  Local<Value> body = args[2];
+  enum encoding body_enc = ParseEncoding(isolate, args[3], UTF8);
+  size_t body_length = args[4].As<Uint32>()->Value();
+  bool chunked = args[5]->IsTrue();
+  Local<String> trailer;
+  if (chunked) {
+    CHECK(args[6]->IsString());
+    trailer = args[6].As<String>();
+  }
+
+  size_t head_length;
+  if (!StringBytes::Size(isolate, head, head_enc).To(&head_length))
+    return;
+
+  char chunk_size[sizeof(body_length) * 2 + 3];
+  size_t chunk_size_length = 0;
+  if (chunked && body_length > 0) {
+    chunk_size_length = snprintf(chunk_size, sizeof(chunk_size), "%zx\r\n",
+                                 body_length);
+  }
+
+  size_t total = head_length + chunk_size_length + body_length;
+  if (chunked)
+    total += (body_length > 0 ? 2 : 0) + 5 + trailer->Length();
+
+  AllocatedBuffer buf = AllocatedBuffer::AllocateManaged(env, total);
+  char* data = buf.data();
+  size_t pos = StringBytes::Write(isolate, data, head_length, head, head_enc);
+  memcpy(data + pos, chunk_size, chunk_size_length);
+  pos += chunk_size_length;
+  if (body->IsArrayBufferView()) {
+    ArrayBufferViewContents<char> contents(body);
+    CHECK_EQ(contents.length(), body_length);
+    memcpy(data + pos, contents.data(), body_length);
+    pos += body_length;
+  } else {
+    pos += StringBytes::Write(isolate, data + pos, body_length, body,
+                              body_enc);
+  }
+  if (chunked) {
+    if (body_length > 0) {
+      memcpy(data + pos, "\r\n", 2);
+      pos += 2;
+    }
+    memcpy(data + pos, "0\r\n", 3);
+    pos += 3;
+    pos += StringBytes::Write(isolate, data + pos, trailer->Length(), trailer,
+                              LATIN1);
+    memcpy(data + pos, "\r\n", 2);
+    pos += 2;
+  }
+  CHECK_EQ(pos, total);
+
+  Local<Object> ret;
+  if (buf.ToPooledBuffer().ToLocal(&ret))
+    args.GetReturnValue().Set(ret);
+}
+
+
 void InitializeHttpParser(Local<Object> target,
                           Local<Value> unused,
                           Local<Context> context,
@@ -977,6 +1685,8 @@ void InitializeHttpParser(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnTimeout"),
          Integer::NewFromUnsigned(env->isolate(), kOnTimeout));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnRequestBatch"),
+         Integer::NewFromUnsigned(env->isolate(), kOnRequestBatch));
 
   Local<Array> methods = Array::New(env->isolate());
 #define V(num, name, string)                                                  \
@@ -999,8 +1709,25 @@ void InitializeHttpParser(Local<Object> target,
   env->SetProtoMethod(t, "consume", Parser::Consume);
   env->SetProtoMethod(t, "unconsume", Parser::Unconsume);
   env->SetProtoMethod(t, "getCurrentBuffer", Parser::GetCurrentBuffer);
+  env->SetProtoMethod(t, "markIdle", Parser::MarkIdle);
 
   env->SetConstructorFunction(target, "HTTPParser", t);
+
+  env->SetMethod(target, "serializeMessage", SerializeMessage);
+  env->SetMethod(target, "checkInvalidHeaderChar", CheckInvalidHeaderChar);
+  env->SetMethod(target, "checkIsHttpToken", CheckIsHttpToken);
+
+  Local<FunctionTemplate> c = env->NewFunctionTemplate(ConnectionsList::New);
+  c->InstanceTemplate()->SetInternalFieldCount(
+      ConnectionsList::kInternalFieldCount);
+  c->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kHeadersTimeout"),
+         Integer::New(env->isolate(), ConnectionsList::kHeadersTimeout));
+  c->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kRequestTimeout"),
+         Integer::New(env->isolate(), ConnectionsList::kRequestTimeout));
+  c->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kKeepAliveTimeout"),
+         Integer::New(env->isolate(), ConnectionsList::kKeepAliveTimeout));
+  env->SetProtoMethod(c, "expired", ConnectionsList::Expired);
+  env->SetConstructorFunction(target, "ConnectionsList", c);
 }
 
 }  // anonymous namespace
@@ -68,6 +68,11 @@
 #include <unicode/uversion.h>
 #include <unicode/ustring.h>
 
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #ifdef NODE_HAVE_SMALL_ICU
 /* if this is defined, we have a 'secondary' entry point.
    compare following to utypes.h defs for U_ICUDATA_ENTRY_POINT */
@@ -118,6 +123,294 @@ MaybeLocal<Object> ToBufferEndian(Environment* env, MaybeStackBuffer<T>* buf) {
   return ret;
 }
 
+// Opening a converter looks its name up in the ICU alias table and loads the
+// converter data. Each thread therefore keeps one opened converter per name to
+// clone from, and a few idle ones for the one-shot transcoding functions.
+class ConverterCache {
+ public:
+  static constexpr size_t kMaxNames = 64;
+  static constexpr size_t kMaxIdlePerName = 4;
+
+  // Returns an empty pointer and sets *status if there is no converter for
+  // the name.
+  ConverterPointer Open(const char* name, UErrorCode* status) {
+    auto it = entries_.find(name);
+    if (it == entries_.end()) {
+      ConverterPointer conv(ucnv_open(name, status));
+      if (U_FAILURE(*status) || entries_.size() >= kMaxNames)
+        return conv;
+      it = entries_.emplace(name, Entry { std::move(conv), {} }).first;
+    }
+    Entry& entry = it->second;
+    if (!entry.idle.empty()) {
+      ConverterPointer conv = std::move(entry.idle.back());
+      entry.idle.pop_back();
+      return conv;
+    }
+    return ConverterPointer(
+        ucnv_safeClone(entry.prototype.get(), nullptr, nullptr, status));
+  }
+
+  // Makes a converter returned by Open() available to the next call. The
+  // substitution characters are kept, but they are only used when converting
+  // from Unicode, and all callers that do that set them.
+  void Recycle(const char* name, ConverterPointer conv) {
+    auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.idle.size() >= kMaxIdlePerName)
+      return;
+    ucnv_reset(conv.get());
+    it->second.idle.emplace_back(std::move(conv));
+  }
+
+ private:
+  struct Entry {
+    ConverterPointer prototype;
+    std::vector<ConverterPointer> idle;
+  };
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+thread_local ConverterCache converter_cache;
+
+// A converter from the cache of the current thread that is returned to it
+// when it goes out of scope.
+class CachedConverter {
+ public:
+  explicit CachedConverter(const char* name, const char* sub = nullptr)
+      : name_(name) {
+    UErrorCode status = U_ZERO_ERROR;
+    conv_ = converter_cache.Open(name, &status);
+    CHECK(U_SUCCESS(status));
+    if (sub != nullptr) {
+      ucnv_setSubstChars(conv_.get(), sub, strlen(sub), &status);
+      CHECK(U_SUCCESS(status));
+    }
+  }
+
+  ~CachedConverter() {
+    converter_cache.Recycle(name_, std::move(conv_));
+  }
+
+  UConverter* conv() const { return conv_.get(); }
+
+  size_t max_char_size() const {
+    return ucnv_getMaxCharSize(conv_.get());
+  }
+
+ private:
+  const char* name_;
+  ConverterPointer conv_;
+};
+
+// The UTF-8 decoder of the WHATWG Encoding Standard, fed one byte at a time.
+// It remembers the bytes of an incomplete sequence so that they can be
+// handed back to the next call through a few bytes of state.
+class Utf8Decoder {
+ public:
+  // Processes `byte` and appends any resulting code units to `out`. Returns
+  // false if the byte is an error and `fatal` is set.
+  bool Push(uint8_t byte, bool fatal, uint16_t* out, size_t* out_length) {
+    for (;;) {
+      if (needed_ == 0) {
+        if (byte < 0x80) {
+          out[(*out_length)++] = byte;
+          return true;
+        }
+        if (byte >= 0xc2 && byte <= 0xdf) {
+          needed_ = 1;
+          code_point_ = byte & 0x1f;
+        } else if (byte >= 0xe0 && byte <= 0xef) {
+          if (byte == 0xe0) lower_ = 0xa0;
+          if (byte == 0xed) upper_ = 0x9f;
+          needed_ = 2;
+          code_point_ = byte & 0xf;
+        } else if (byte >= 0xf0 && byte <= 0xf4) {
+          if (byte == 0xf0) lower_ = 0x90;
+          if (byte == 0xf4) upper_ = 0x8f;
+          needed_ = 3;
+          code_point_ = byte & 0x7;
+        } else {
+          return Error(fatal, out, out_length);
+        }
+        bytes_[seen_++] = byte;
+        return true;
+      }
+
+      if (byte < lower_ || byte > upper_) {
+        // The byte is not consumed by the broken sequence and is processed
+        // again on its own.
+        Reset();
+        if (!Error(fatal, out, out_length)) return false;
+        continue;
+      }
+
+      lower_ = 0x80;
+      upper_ = 0xbf;
+      code_point_ = (code_point_ << 6) | (byte & 0x3f);
+      if (seen_ < needed_) {
+        bytes_[seen_++] = byte;
+        return true;
+      }
+
+      if (code_point_ > 0xffff) {
+        out[(*out_length)++] = 0xd7c0 + (code_point_ >> 10);
+        out[(*out_length)++] = 0xdc00 + (code_point_ & 0x3ff);
+      } else {
+        out[(*out_length)++] = code_point_;
+      }
+      Reset();
+      return true;
+    }
+  }
+
+  // Handles the end of the input when the stream is not continued.
+  bool Finish(bool fatal, uint16_t* out, size_t* out_length) {
+    if (needed_ == 0) return true;
+    Reset();
+    return Error(fatal, out, out_length);
+  }
+
+  bool pending() const { return needed_ != 0; }
+
+  // `state` holds the number of bytes of an incomplete sequence, followed by
+  // the bytes themselves.
+  static constexpr size_t kStateLength = 4;
+
+  void Load(const uint8_t* state) {
+    uint16_t unused;
+    size_t unused_length = 0;
+    for (size_t i = 0; i < state[0]; i++)
+      CHECK(Push(state[1 + i], true, &unused, &unused_length));
+    CHECK_EQ(unused_length, 0);
+  }
+
+  void Store(uint8_t* state) const {
+    state[0] = seen_;
+    memcpy(state + 1, bytes_, seen_);
+  }
+
+ private:
+  bool Error(bool fatal, uint16_t* out, size_t* out_length) {
+    if (fatal) return false;
+    out[(*out_length)++] = 0xfffd;
+    return true;
+  }
+
+  void Reset() {
+    code_point_ = 0;
+    needed_ = 0;
+    seen_ = 0;
+    lower_ = 0x80;
+    upper_ = 0xbf;
+  }
+
+  uint32_t code_point_ = 0;
+  uint8_t needed_ = 0;
+  uint8_t seen_ = 0;
+  uint8_t lower_ = 0x80;
+  uint8_t upper_ = 0xbf;
+  uint8_t bytes_[kStateLength - 1];
+};
+
+// Decodes a chunk of a UTF-8 stream for a TextDecoder. An incomplete
+// sequence at the end of the chunk is kept in `state` for the next call,
+// unless `flush` is set. Complete well-formed runs are handed to V8
+// directly; only the bytes around chunk boundaries and errors go through
+// Utf8Decoder. If `bom_seen` points to false, a leading U+FEFF is dropped,
+// and it is set to true once anything has been decoded. Returns an empty
+// handle with `*invalid` set if the input is an error in fatal mode.
+MaybeLocal<String> DecodeUtf8(Isolate* isolate,
+                              const uint8_t* data,
+                              size_t length,
+                              bool fatal,
+                              bool flush,
+                              uint8_t* state,
+                              bool* bom_seen,
+                              bool* invalid) {
+  CHECK_LT(state[0], Utf8Decoder::kStateLength);
+  Utf8Decoder decoder;
+  decoder.Load(state);
+  state[0] = 0;
+  *invalid = true;
+
+  // Finish a sequence that the previous chunk ended in. This takes at most
+  // three bytes.
+  uint16_t head[8];
+  size_t head_length = 0;
+  size_t i = 0;
+  while (decoder.pending() && i < length && i < 3) {
+    if (!decoder.Push(data[i++], fatal, head, &head_length))
+      return MaybeLocal<String>();
+  }
+
+  const uint8_t* body = data + i;
+  size_t valid =
+      decoder.pending() ? 0 : Utf8ValidPrefixLength(body, length - i);
+  i += valid;
+
+  // Whatever is left is either the start of a sequence that the next chunk
+  // completes, or contains an error.
+  MaybeStackBuffer<uint16_t> tail(length - i + 1);
+  size_t tail_length = 0;
+  for (; i < length; i++) {
+    if (!decoder.Push(data[i], fatal, *tail, &tail_length))
+      return MaybeLocal<String>();
+  }
+  if (flush) {
+    if (!decoder.Finish(fatal, *tail, &tail_length))
+      return MaybeLocal<String>();
+  } else {
+    decoder.Store(state);
+  }
+  *invalid = false;
+
+  if (bom_seen != nullptr && !*bom_seen &&
+      head_length + valid + tail_length > 0) {
+    // If the very first result in the stream is a BOM, and we are not
+    // explicitly told to ignore it, then we discard it.
+    if (head_length > 0) {
+      if (head[0] == 0xFEFF)
+        memmove(head, head + 1, --head_length * sizeof(head[0]));
+    } else if (valid > 0) {
+      if (valid >= 3 && memcmp(body, "\xEF\xBB\xBF", 3) == 0) {
+        body += 3;
+        valid -= 3;
+      }
+    } else if (tail[0] == 0xFEFF) {
+      memmove(*tail, *tail + 1, --tail_length * sizeof(tail[0]));
+    }
+    *bom_seen = true;
+  }
+
+  Local<String> result;
+  if (!String::NewFromUtf8(isolate,
+                           reinterpret_cast<const char*>(body),
+                           NewStringType::kNormal,
+                           valid).ToLocal(&result)) {
+    ThrowErrStringTooLong(isolate);
+    return MaybeLocal<String>();
+  }
+  if (head_length > 0) {
+    Local<String> str;
+    if (!String::NewFromTwoByte(isolate, head, NewStringType::kNormal,
+                                head_length).ToLocal(&str)) {
+      ThrowErrStringTooLong(isolate);
+      return MaybeLocal<String>();
+    }
+    result = String::Concat(isolate, str, result);
+  }
+  if (tail_length > 0) {
+    Local<String> str;
+    if (!String::NewFromTwoByte(isolate, *tail, NewStringType::kNormal,
+                                tail_length).ToLocal(&str)) {
+      ThrowErrStringTooLong(isolate);
+      return MaybeLocal<String>();
+    }
+    result = String::Concat(isolate, result, str);
+  }
+  return result;
+}
+
 // One-Shot Converters
 
 void CopySourceBuffer(MaybeStackBuffer<UChar>* dest,
@@ -148,8 +441,8 @@ MaybeLocal<Object> Transcode(Environment* env,
   *status = U_ZERO_ERROR;
   MaybeLocal<Object> ret;
   MaybeStackBuffer<char> result;
-  Converter to(toEncoding, "?");
-  Converter from(fromEncoding);
+  CachedConverter to(toEncoding, "?");
+  CachedConverter from(fromEncoding);
   const uint32_t limit = source_length * to.max_char_size();
   result.AllocateSufficientStorage(limit);
   char* target = *result;
@@ -172,7 +465,7 @@ MaybeLocal<Object> TranscodeToUcs2(Environment* env,
   *status = U_ZERO_ERROR;
   MaybeLocal<Object> ret;
   MaybeStackBuffer<UChar> destbuf(source_length);
-  Converter from(fromEncoding);
+  CachedConverter from(fromEncoding);
   const size_t length_in_chars = source_length * sizeof(UChar);
   ucnv_toUChars(from.conv(), *destbuf, length_in_chars,
                 source, source_length, status);
@@ -190,7 +483,7 @@ MaybeLocal<Object> TranscodeFromUcs2(Environment* env,
   *status = U_ZERO_ERROR;
   MaybeStackBuffer<UChar> sourcebuf;
   MaybeLocal<Object> ret;
-  Converter to(toEncoding, "?");
+  CachedConverter to(toEncoding, "?");
   const size_t length_in_chars = source_length / sizeof(UChar);
   CopySourceBuffer(&sourcebuf, source, source_length, length_in_chars);
   MaybeStackBuffer<char> destbuf(length_in_chars);
@@ -262,6 +555,78 @@ MaybeLocal<Object> TranscodeUtf8FromUcs2(Environment* env,
   return ret;
 }
 
+// Latin-1 maps each byte to the code point of the same value, so the
+// conversions between it and UTF-8 or UTF-16LE do not need ICU.
+
+MaybeLocal<Object> TranscodeUcs2FromLatin1(Environment* env,
+                                           const char* fromEncoding,
+                                           const char* toEncoding,
+                                           const char* source,
+                                           const size_t source_length,
+                                           UErrorCode* status) {
+  *status = U_ZERO_ERROR;
+  MaybeStackBuffer<UChar> destbuf(source_length);
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(source);
+  UChar* dst = *destbuf;
+  for (size_t i = 0; i < source_length; i++)
+    dst[i] = src[i];
+  return ToBufferEndian(env, &destbuf);
+}
+
+MaybeLocal<Object> TranscodeLatin1FromUcs2(Environment* env,
+                                           const char* fromEncoding,
+                                           const char* toEncoding,
+                                           const char* source,
+                                           const size_t source_length,
+                                           UErrorCode* status) {
+  *status = U_ZERO_ERROR;
+  const size_t length_in_chars = source_length / sizeof(UChar);
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(source);
+  MaybeStackBuffer<char> destbuf(length_in_chars);
+  char* dst = *destbuf;
+  size_t length = 0;
+  for (size_t i = 0; i < length_in_chars; i++) {
+    const UChar c = src[2 * i] | (src[2 * i + 1] << 8);
+    if (c <= 0xFF) {
+      dst[length++] = static_cast<char>(c);
+      continue;
+    }
+    // Like the ICU converter, substitute a single '?' for a code point
+    // outside of Latin-1, including one encoded as a surrogate pair.
+    dst[length++] = '?';
+    if (U16_IS_LEAD(c) && i + 1 < length_in_chars &&
+        U16_IS_TRAIL(src[2 * i + 2] | (src[2 * i + 3] << 8))) {
+      i++;
+    }
+  }
+  destbuf.SetLength(length);
+  return ToBufferEndian(env, &destbuf);
+}
+
+MaybeLocal<Object> TranscodeUtf8FromLatin1(Environment* env,
+                                           const char* fromEncoding,
+                                           const char* toEncoding,
+                                           const char* source,
+                                           const size_t source_length,
+                                           UErrorCode* status) {
+  *status = U_ZERO_ERROR;
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(source);
+  MaybeStackBuffer<char> destbuf(source_length * 2);
+  char* dst = *destbuf;
+  size_t length = 0;
+  for (size_t i = 0; i < source_length; i++) {
+    const uint8_t c = src[i];
+    if (c < 0x80) {
+      dst[length++] = c;
+    } else {
+      dst[length++] = 0xC0 | (c >> 6);
+      dst[length++] = 0x80 | (c & 0x3F);
+    }
+  }
+  destbuf.SetLength(length);
+  return ToBufferEndian(env, &destbuf);
+}
+
 const char* EncodingName(const enum encoding encoding) {
   switch (encoding) {
     case ASCII: return "us-ascii";
@@ -296,10 +661,15 @@ void Transcode(const FunctionCallbackInfo<Value>&args) {
     TranscodeFunc tfn = &Transcode;
     switch (fromEncoding) {
       case ASCII:
-      case LATIN1:
         if (toEncoding == UCS2)
           tfn = &TranscodeToUcs2;
         break;
+      case LATIN1:
+        if (toEncoding == UCS2)
+          tfn = &TranscodeUcs2FromLatin1;
+        else if (toEncoding == UTF8)
+          tfn = &TranscodeUtf8FromLatin1;
+        break;
       case UTF8:
         if (toEncoding == UCS2)
           tfn = &TranscodeUcs2FromUtf8;
@@ -312,6 +682,9 @@ void Transcode(const FunctionCallbackInfo<Value>&args) {
           case UTF8:
             tfn = &TranscodeUtf8FromUcs2;
             break;
+          case LATIN1:
+            tfn = &TranscodeLatin1FromUcs2;
+            break;
           default:
             tfn = &TranscodeFromUcs2;
         }
@@ -358,16 +731,17 @@ Converter::Converter(UConverter* converter, const char* sub)
 }
 
 void Converter::set_subst_chars(const char* sub) {
-  CHECK(conv_);
   UErrorCode status = U_ZERO_ERROR;
   if (sub != nullptr) {
+    CHECK(conv_);
     ucnv_setSubstChars(conv_.get(), sub, strlen(sub), &status);
     CHECK(U_SUCCESS(status));
   }
 }
 
 void Converter::reset() {
-  ucnv_reset(conv_.get());
+  if (conv_)
+    ucnv_reset(conv_.get());
 }
 
 size_t Converter::min_char_size() const {
@@ -385,9 +759,15 @@ void ConverterObject::Has(const FunctionCallbackInfo<Value>& args) {
 
   CHECK_GE(args.Length(), 1);
   Utf8Value label(env->isolate(), args[0]);
+  if (strcmp(*label, "utf-8") == 0)
+    return args.GetReturnValue().Set(true);
 
   UErrorCode status = U_ZERO_ERROR;
-  ConverterPointer conv(ucnv_open(*label, &status));
+  ConverterPointer conv = converter_cache.Open(*label, &status);
+  if (U_SUCCESS(status)) {
+    // The TextDecoder constructor calls Create() right after this.
+    converter_cache.Recycle(*label, std::move(conv));
+  }
   args.GetReturnValue().Set(!!U_SUCCESS(status));
 }
 
@@ -404,8 +784,15 @@ void ConverterObject::Create(const FunctionCallbackInfo<Value>& args) {
   bool fatal =
       (flags & CONVERTER_FLAGS_FATAL) == CONVERTER_FLAGS_FATAL;
 
+  // The TextDecoder passes the canonical name, and UTF-8 is decoded without
+  // an ICU converter.
+  if (strcmp(*label, "utf-8") == 0) {
+    new ConverterObject(env, obj, nullptr, flags);
+    return args.GetReturnValue().Set(obj);
+  }
+
   UErrorCode status = U_ZERO_ERROR;
-  UConverter* conv = ucnv_open(*label, &status);
+  UConverter* conv = converter_cache.Open(*label, &status).release();
   if (U_FAILURE(status))
     return;
 
@@ -430,21 +817,43 @@ void ConverterObject::Decode(const FunctionCallbackInfo<Value>& args) {
   int flags = args[2]->Uint32Value(env->context()).ToChecked();
 
   UErrorCode status = U_ZERO_ERROR;
-  MaybeStackBuffer<UChar> result;
-  MaybeLocal<Object> ret;
-  size_t limit = converter->min_char_size() * input.length();
-  if (limit > 0)
-    result.AllocateSufficientStorage(limit);
-
   UBool flush = (flags & CONVERTER_FLAGS_FLUSH) == CONVERTER_FLAGS_FLUSH;
   auto cleanup = OnScopeLeave([&]() {
     if (flush) {
       // Reset the converter state.
       converter->set_bom_seen(false);
       converter->reset();
+      converter->utf8_state_[0] = 0;
     }
   });
 
+  if (converter->utf8()) {
+    bool bom_seen = converter->bom_seen();
+    bool invalid;
+    Local<String> str;
+    if (!DecodeUtf8(env->isolate(),
+                    reinterpret_cast<const uint8_t*>(input.data()),
+                    input.length(),
+                    converter->fatal(),
+                    flush,
+                    converter->utf8_state_,
+                    converter->ignore_bom() ? nullptr : &bom_seen,
+                    &invalid).ToLocal(&str)) {
+      if (invalid)
+        args.GetReturnValue().Set(U_ILLEGAL_CHAR_FOUND);
+      return;
+    }
+    converter->set_bom_seen(bom_seen);
+    args.GetReturnValue().Set(str);
+    return;
+  }
+
+  MaybeStackBuffer<UChar> result;
+  MaybeLocal<Object> ret;
+  size_t limit = converter->min_char_size() * input.length();
+  if (limit > 0)
+    result.AllocateSufficientStorage(limit);
+
   const char* source = input.data();
   size_t source_length = input.length();
 
@@ -503,6 +912,11 @@ ConverterObject::ConverterObject(
       flags_(flags) {
   MakeWeak();
 
+  if (converter == nullptr) {
+    flags_ |= CONVERTER_FLAGS_UNICODE;
+    return;
+  }
+
   switch (ucnv_getType(converter)) {
     case UCNV_UTF8:
     case UCNV_UTF16_BigEndian:
@@ -129,8 +129,18 @@ class ConverterObject : public BaseObject, Converter {
     return (flags_ & CONVERTER_FLAGS_IGNORE_BOM) == CONVERTER_FLAGS_IGNORE_BOM;
   }
 
+  bool fatal() const {
+    return (flags_ & CONVERTER_FLAGS_FATAL) == CONVERTER_FLAGS_FATAL;
+  }
+
+  // UTF-8 is decoded natively, without an ICU converter.
+  bool utf8() const { return conv() == nullptr; }
+
  private:
   int flags_ = 0;
+  // The length and the bytes of an incomplete UTF-8 sequence at the end of
+  // the last chunk.
+  uint8_t utf8_state_[4] = {};
 };
 
 }  // namespace i18n
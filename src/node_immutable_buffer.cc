@@ -0,0 +1,230 @@
+#include "node_immutable_buffer.h"
+#include "base_object-inl.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_errors.h"
+#include "node_external_reference.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(SYS_memfd_create) && defined(F_ADD_SEALS)
+#define NODE_IMMUTABLE_BUFFER_USE_MEMFD 1
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#ifndef MFD_ALLOW_SEALING
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#endif
+
+namespace node {
+namespace worker {
+
+using v8::ArrayBuffer;
+using v8::BackingStore;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Local;
+using v8::Object;
+using v8::Value;
+
+struct ImmutableBuffer::Data {
+  ~Data() {
+#ifdef NODE_IMMUTABLE_BUFFER_USE_MEMFD
+    if (fd != -1)
+      CHECK_EQ(close(fd), 0);
+#endif
+    free(bytes);
+  }
+
+  // The bytes are either in the memfd or in memory of their own.
+  int fd = -1;
+  char* bytes = nullptr;
+  size_t length = 0;
+};
+
+namespace {
+
+#ifdef NODE_IMMUTABLE_BUFFER_USE_MEMFD
+// Returns a sealed memfd with the bytes, or -1 if that is not possible, e.g.
+// because the kernel is older than Linux 3.17.
+int CreateSealedMemfd(const char* data, size_t length) {
+  int fd = syscall(SYS_memfd_create,
+                   "node-immutable-buffer",
+                   MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd == -1)
+    return -1;
+
+  size_t written = 0;
+  if (ftruncate(fd, length) == 0) {
+    while (written < length) {
+      ssize_t n = pwrite(fd, data + written, length - written, written);
+      if (n == -1 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        break;
+      written += n;
+    }
+  }
+  if (written < length ||
+      fcntl(fd, F_ADD_SEALS,
+            F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0) {
+    CHECK_EQ(close(fd), 0);
+    return -1;
+  }
+  return fd;
+}
+#endif  // NODE_IMMUTABLE_BUFFER_USE_MEMFD
+
+}  // anonymous namespace
+
+void ImmutableBuffer::Initialize(Environment* env, Local<Object> target) {
+  env->SetConstructorFunction(
+      target, "ImmutableBuffer", GetConstructorTemplate(env));
+}
+
+Local<FunctionTemplate> ImmutableBuffer::GetConstructorTemplate(
+    Environment* env) {
+  Local<FunctionTemplate> tmpl = env->immutable_buffer_constructor_template();
+  if (tmpl.IsEmpty()) {
+    tmpl = env->NewFunctionTemplate(New);
+    tmpl->InstanceTemplate()->SetInternalFieldCount(
+        BaseObject::kInternalFieldCount);
+    tmpl->Inherit(BaseObject::GetConstructorTemplate(env));
+    env->SetProtoMethod(tmpl, "toArrayBuffer", ToArrayBuffer);
+    env->set_immutable_buffer_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+BaseObjectPtr<ImmutableBuffer> ImmutableBuffer::Create(
+    Environment* env,
+    std::shared_ptr<Data> data) {
+  HandleScope scope(env->isolate());
+
+  // The constructor is only called from JS, so create the object without it.
+  Local<Object> obj;
+  if (!GetConstructorTemplate(env)
+           ->InstanceTemplate()
+           ->NewInstance(env->context())
+           .ToLocal(&obj)) {
+    return BaseObjectPtr<ImmutableBuffer>();
+  }
+
+  return MakeBaseObject<ImmutableBuffer>(env, obj, std::move(data));
+}
+
+ImmutableBuffer::ImmutableBuffer(Environment* env,
+                                 Local<Object> obj,
+                                 std::shared_ptr<Data> data)
+    : BaseObject(env, obj),
+      data_(std::move(data)) {
+  MakeWeak();
+}
+
+// new ImmutableBuffer(view)
+void ImmutableBuffer::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsArrayBufferView());
+  ArrayBufferViewContents<char> source(args[0]);
+
+  std::shared_ptr<Data> data = std::make_shared<Data>();
+  data->length = source.length();
+#ifdef NODE_IMMUTABLE_BUFFER_USE_MEMFD
+  if (data->length > 0)
+    data->fd = CreateSealedMemfd(source.data(), data->length);
+#endif
+  if (data->fd == -1 && data->length > 0) {
+    data->bytes = UncheckedMalloc(data->length);
+    if (data->bytes == nullptr)
+      return THROW_ERR_MEMORY_ALLOCATION_FAILED(env);
+    memcpy(data->bytes, source.data(), data->length);
+  }
+
+  new ImmutableBuffer(env, args.This(), std::move(data));
+}
+
+// toArrayBuffer()
+// Returns a new ArrayBuffer with the bytes. The ones that are backed by the
+// memfd share its memory until they are written to.
+void ImmutableBuffer::ToArrayBuffer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ImmutableBuffer* buffer;
+  ASSIGN_OR_RETURN_UNWRAP(&buffer, args.Holder());
+  const Data& data = *buffer->data_;
+
+  std::unique_ptr<BackingStore> store;
+#ifdef NODE_IMMUTABLE_BUFFER_USE_MEMFD
+  if (data.fd != -1) {
+    void* memory = mmap(nullptr,
+                        data.length,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE,
+                        data.fd,
+                        0);
+    if (memory == MAP_FAILED)
+      return THROW_ERR_MEMORY_ALLOCATION_FAILED(env);
+    store = ArrayBuffer::NewBackingStore(
+        memory,
+        data.length,
+        [](void* memory, size_t length, void* deleter_data) {
+          CHECK_EQ(munmap(memory, length), 0);
+        },
+        nullptr);
+  }
+#endif
+  if (!store) {
+    store = ArrayBuffer::NewBackingStore(env->isolate(), data.length);
+    if (data.length > 0)
+      memcpy(store->Data(), data.bytes, data.length);
+  }
+  args.GetReturnValue().Set(ArrayBuffer::New(env->isolate(), std::move(store)));
+}
+
+void ImmutableBuffer::MemoryInfo(MemoryTracker* tracker) const {
+  // The memfd is not part of the heap of any thread.
+  tracker->TrackFieldWithSize("bytes", data_->bytes != nullptr ?
+                                           data_->length : 0);
+}
+
+BaseObject::TransferMode ImmutableBuffer::GetTransferMode() const {
+  return BaseObject::TransferMode::kCloneable;
+}
+
+std::unique_ptr<TransferData> ImmutableBuffer::CloneForMessaging() const {
+  return std::make_unique<ImmutableBufferTransferData>(data_);
+}
+
+BaseObjectPtr<BaseObject>
+ImmutableBuffer::ImmutableBufferTransferData::Deserialize(
+    Environment* env,
+    Local<Context> context,
+    std::unique_ptr<TransferData> self) {
+  if (context != env->context()) {
+    THROW_ERR_MESSAGE_TARGET_CONTEXT_UNAVAILABLE(env);
+    return {};
+  }
+  return ImmutableBuffer::Create(env, data_);
+}
+
+void ImmutableBuffer::RegisterExternalReferences(
+    ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(ToArrayBuffer);
+}
+
+}  // namespace worker
+}  // namespace node
@@ -0,0 +1,82 @@
+#ifndef SRC_NODE_IMMUTABLE_BUFFER_H_
+#define SRC_NODE_IMMUTABLE_BUFFER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "base_object.h"
+#include "env.h"
+#include "memory_tracker.h"
+#include "node_worker.h"
+#include "v8.h"
+
+#include <memory>
+
+namespace node {
+
+class ExternalReferenceRegistry;
+
+namespace worker {
+
+// Bytes that can not be changed once they are written, and that are shared
+// by all of the clones of an ImmutableBuffer, including the ones that are
+// posted to other threads. On Linux, the bytes live in a sealed memfd that
+// is mapped copy-on-write for every ArrayBuffer that is handed out, so that
+// all of them are backed by the same memory until they are written to, and
+// writes stay private to the ArrayBuffer. Elsewhere, every ArrayBuffer is a
+// copy of the bytes.
+class ImmutableBuffer : public BaseObject {
+ public:
+  struct Data;
+
+  static void RegisterExternalReferences(
+      ExternalReferenceRegistry* registry);
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ToArrayBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+
+  static BaseObjectPtr<ImmutableBuffer> Create(Environment* env,
+                                               std::shared_ptr<Data> data);
+
+  ImmutableBuffer(Environment* env,
+                  v8::Local<v8::Object> obj,
+                  std::shared_ptr<Data> data);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(ImmutableBuffer)
+  SET_SELF_SIZE(ImmutableBuffer)
+
+  class ImmutableBufferTransferData : public TransferData {
+   public:
+    explicit ImmutableBufferTransferData(std::shared_ptr<Data> data)
+        : data_(std::move(data)) {}
+
+    BaseObjectPtr<BaseObject> Deserialize(
+        Environment* env,
+        v8::Local<v8::Context> context,
+        std::unique_ptr<TransferData> self) override;
+
+    SET_MEMORY_INFO_NAME(ImmutableBufferTransferData)
+    SET_SELF_SIZE(ImmutableBufferTransferData)
+    SET_NO_MEMORY_INFO()
+
+   private:
+    std::shared_ptr<Data> data_;
+  };
+
+  BaseObject::TransferMode GetTransferMode() const override;
+  std::unique_ptr<TransferData> CloneForMessaging() const override;
+
+ private:
+  std::shared_ptr<Data> data_;
+};
+
+}  // namespace worker
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_IMMUTABLE_BUFFER_H_
@@ -97,6 +97,16 @@ void SignalExit(int signal, siginfo_t* info, void* ucontext);
 std::string GetProcessTitle(const char* default_title);
 std::string GetHumanReadableProcessName();
 
+// The CPUs that the calling thread may run on, which the threads that it
+// creates inherit. These return 0 or a libuv error code, which is UV_ENOTSUP
+// on platforms other than Linux.
+int GetCurrentThreadAffinity(std::vector<int>* cpus);
+int SetCurrentThreadAffinity(const std::vector<int>& cpus);
+// Parses a list of CPUs such as "0-3,8", as used by taskset(1).
+bool ParseCpuList(const std::string& list, std::vector<int>* cpus);
+// Starts the libuv threadpool, so that its threads only run on `cpus`.
+int StartThreadpoolWithAffinity(const std::vector<int>& cpus);
+
 void InitializeContextRuntime(v8::Local<v8::Context>);
 bool InitializePrimordials(v8::Local<v8::Context> context);
 
@@ -142,6 +152,41 @@ class DebuggingArrayBufferAllocator final : public NodeArrayBufferAllocator {
   std::unordered_map<void*, size_t> allocations_;
 };
 
+// Keeps the freed blocks of the sizes between kMinPooledSize and
+// kMaxPooledSize in free lists, one per size class, so that they are reused
+// instead of going back to the system allocator. Each thread has small free
+// lists of its own, which exchange blocks in batches with free lists that are
+// shared by the whole process. The blocks that stay unused in the shared lists
+// for a while are returned to the system allocator.
+class PoolingArrayBufferAllocator final : public NodeArrayBufferAllocator {
+ public:
+  static constexpr size_t kSizeClassStep = 1024;
+  static constexpr size_t kMinPooledSize = 1024;
+  static constexpr size_t kMaxPooledSize = 16 * 1024;
+  static constexpr size_t kSizeClassCount = kMaxPooledSize / kSizeClassStep;
+
+  struct SizeClassStatistics {
+    size_t size;
+    // The number of blocks that were handed out, and how many of them were
+    // reused from a free list.
+    uint64_t allocations;
+    uint64_t reused;
+    // The number of blocks in the shared free list.
+    size_t cached;
+  };
+
+  void* Allocate(size_t size) override;
+  void* AllocateUninitialized(size_t size) override;
+  void Free(void* data, size_t size) override;
+  void* Reallocate(void* data, size_t old_size, size_t size) override;
+
+  // The statistics are for all of the pooling allocators of the process.
+  static std::vector<SizeClassStatistics> GetStatistics();
+
+ private:
+  void* AllocatePooled(size_t size, bool zero_fill);
+};
+
 namespace Buffer {
 v8::MaybeLocal<v8::Object> Copy(Environment* env, const char* data, size_t len);
 v8::MaybeLocal<v8::Object> New(Environment* env, size_t size);
@@ -198,7 +243,8 @@ v8::MaybeLocal<v8::Value> InternalMakeCallback(
     const v8::Local<v8::Function> callback,
     int argc,
     v8::Local<v8::Value> argv[],
-    async_context asyncContext);
+    async_context asyncContext,
+    v8::Local<v8::Value> context_frame = v8::Local<v8::Value>());
 
 v8::MaybeLocal<v8::Value> MakeSyncCallback(v8::Isolate* isolate,
                                            v8::Local<v8::Object> recv,
@@ -216,12 +262,17 @@ class InternalCallbackScope {
     // This should only be used when there is no call into JS in this scope.
     // (The HTTP parser also uses it for some weird backwards
     // compatibility issues, but it shouldn't.)
-    kSkipTaskQueues = 2
+    kSkipTaskQueues = 2,
+    // Indicates that the queues should be processed right away, even if
+    // --tick-batch-size would defer them to the end of the batch.
+    kNoTaskQueueDeferral = 4
   };
   InternalCallbackScope(Environment* env,
                         v8::Local<v8::Object> object,
                         const async_context& asyncContext,
-                        int flags = kNoFlags);
+                        int flags = kNoFlags,
+                        v8::Local<v8::Value> context_frame =
+                            v8::Local<v8::Value>());
   // Utility that can be used by AsyncWrap classes.
   explicit InternalCallbackScope(AsyncWrap* async_wrap, int flags = 0);
   ~InternalCallbackScope();
@@ -234,8 +285,12 @@ class InternalCallbackScope {
   Environment* env_;
   async_context async_context_;
   v8::Local<v8::Object> object_;
+  // The async context frame that was current before the one of the
+  // callback was entered, if a frame was passed to the constructor.
+  v8::Local<v8::Value> prior_context_frame_;
   bool skip_hooks_;
   bool skip_task_queues_;
+  bool no_task_queue_deferral_;
   bool failed_ = false;
   bool pushed_ids_ = false;
   bool closed_ = false;
@@ -257,24 +312,53 @@ class DebugSealHandleScope {
 
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env) : env_(env) {
+  explicit inline ThreadPoolWork(
+      Environment* env,
+      ThreadPoolWorkClass work_class = ThreadPoolWorkClass::kOther)
+      : env_(env), work_class_(work_class) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
 
+  // If the Environment already runs as many requests of this class as
+  // --threadpool-limits allows, the work is queued until one of them is done.
   inline void ScheduleWork();
   inline int CancelWork();
 
+  // Work that waits for --threadpool-limits is started in order of priority,
+  // and in the order in which it was scheduled within a priority.
+  void set_priority(int32_t priority) { priority_ = priority; }
+
   virtual void DoThreadPoolWork() = 0;
   virtual void AfterThreadPoolWork(int status) = 0;
 
   Environment* env() const { return env_; }
 
  private:
+  inline void QueueWork();
+  // Runs on the threadpool.
+  inline void RunWork();
+
   Environment* env_;
+  ThreadPoolWorkClass work_class_;
+  int32_t priority_ = 0;
   uv_work_t work_req_;
+  // The time at which the work was scheduled, and the histograms of its
+  // class, if the class is monitored.
+  uint64_t schedule_time_ = 0;
+  std::shared_ptr<Histogram> wait_histogram_;
+  std::shared_ptr<Histogram> run_histogram_;
 };
 
+inline const char* ThreadPoolWorkClassName(ThreadPoolWorkClass work_class) {
+  switch (work_class) {
+#define V(name, string) case ThreadPoolWorkClass::name: return string;
+    THREADPOOL_WORK_CLASSES(V)
+#undef V
+    default: return "other";
+  }
+}
+
 #define TRACING_CATEGORY_NODE "node"
 #define TRACING_CATEGORY_NODE1(one)                                           \
     TRACING_CATEGORY_NODE ","                                                 \
@@ -370,7 +454,9 @@ class DiagnosticFilename {
 };
 
 namespace heap {
-bool WriteSnapshot(v8::Isolate* isolate, const char* filename);
+bool WriteSnapshot(v8::Isolate* isolate,
+                   const char* filename,
+                   bool gzip = false);
 }
 
 class TraceEventScope {
@@ -26,6 +26,7 @@ using v8::Locker;
 
 std::unique_ptr<ExternalReferenceRegistry> NodeMainInstance::registry_ =
     nullptr;
+const std::vector<intptr_t>* NodeMainInstance::external_references_ = nullptr;
 NodeMainInstance::NodeMainInstance(Isolate* isolate,
                                    uv_loop_t* event_loop,
                                    MultiIsolatePlatform* platform,
@@ -49,7 +50,12 @@ const std::vector<intptr_t>& NodeMainInstance::CollectExternalReferences() {
   // Cannot be called more than once.
   CHECK_NULL(registry_);
   registry_.reset(new ExternalReferenceRegistry());
-  return registry_->external_references();
+  external_references_ = &registry_->external_references();
+  return *external_references_;
+}
+
+const std::vector<intptr_t>* NodeMainInstance::GetExternalReferences() {
+  return external_references_;
 }
 
 std::unique_ptr<NodeMainInstance> NodeMainInstance::Create(
@@ -193,7 +199,7 @@ NodeMainInstance::CreateMainEnvironment(int* exit_code,
                               EnvironmentFlags::kDefaultFlags,
                               {}));
     context = Context::FromSnapshot(isolate_,
-                                    kNodeContextIndex,
+                                    kNodeMainContextIndex,
                                     {DeserializeNodeInternalFields, env.get()})
                   .ToLocalChecked();
 
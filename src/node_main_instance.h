@@ -71,8 +71,17 @@ class NodeMainInstance {
   static v8::StartupData* GetEmbeddedSnapshotBlob();
   static const EnvSerializeInfo* GetEnvSerializeInfo();
   static const std::vector<intptr_t>& CollectExternalReferences();
-
-  static const size_t kNodeContextIndex = 0;
+  // Returns the external references collected for the main instance, or
+  // nullptr if it was not deserialized from the snapshot. Workers can only
+  // use the snapshot in the latter case.
+  static const std::vector<intptr_t>* GetExternalReferences();
+
+  // The base context has only been through the per-context scripts, and is
+  // used by Workers. The vm context is what vm.createContext() starts out
+  // with. The main context is fully bootstrapped.
+  static const size_t kNodeBaseContextIndex = 0;
+  static const size_t kNodeVMContextIndex = kNodeBaseContextIndex + 1;
+  static const size_t kNodeMainContextIndex = kNodeVMContextIndex + 1;
   NodeMainInstance(const NodeMainInstance&) = delete;
   NodeMainInstance& operator=(const NodeMainInstance&) = delete;
   NodeMainInstance(NodeMainInstance&&) = delete;
@@ -86,6 +95,8 @@ class NodeMainInstance {
                    const std::vector<std::string>& exec_args);
 
   static std::unique_ptr<ExternalReferenceRegistry> registry_;
+  // The list that registry_ returned, which it can only do once.
+  static const std::vector<intptr_t>* external_references_;
   std::vector<std::string> args_;
   std::vector<std::string> exec_args_;
   std::unique_ptr<ArrayBufferAllocator> array_buffer_allocator_;
@@ -20,6 +20,54 @@ AllocatorStruct NgLibMemoryManager<Class, AllocatorStruct>::MakeAllocator() {
   };
 }
 
+template <typename Class, typename T>
+NgLibMemoryManager<Class, T>::~NgLibMemoryManager() {
+  for (FreeBlock*& head : free_blocks_) {
+    while (head != nullptr) {
+      FreeBlock* next = head->next;
+      free(head);
+      head = next;
+    }
+  }
+}
+
+template <typename Class, typename T>
+size_t NgLibMemoryManager<Class, T>::SizeClassFor(size_t size) {
+  size_t size_class = 0;
+  for (size_t class_size = kMinPooledSize;
+       class_size < size;
+       class_size <<= 1) {
+    if (++size_class == kSizeClassCount)
+      break;
+  }
+  return size_class;
+}
+
+template <typename Class, typename T>
+char* NgLibMemoryManager<Class, T>::TakeBlock(size_t size_class) {
+  FreeBlock* block = free_blocks_[size_class];
+  if (block == nullptr)
+    return UncheckedMalloc(kMinPooledSize << size_class);
+  free_blocks_[size_class] = block->next;
+  free_block_counts_[size_class]--;
+  return reinterpret_cast<char*>(block);
+}
+
+template <typename Class, typename T>
+void NgLibMemoryManager<Class, T>::ReleaseBlock(char* ptr, size_t size) {
+  const size_t size_class = SizeClassFor(size);
+  if (size_class == kSizeClassCount ||
+      size != kMinPooledSize << size_class ||
+      free_block_counts_[size_class] == kMaxFreeBlocks) {
+    free(ptr);
+    return;
+  }
+  FreeBlock* block = reinterpret_cast<FreeBlock*>(ptr);
+  block->next = free_blocks_[size_class];
+  free_blocks_[size_class] = block;
+  free_block_counts_[size_class]++;
+}
+
 template <typename Class, typename T>
 void* NgLibMemoryManager<Class, T>::ReallocImpl(void* ptr,
                                              size_t size,
@@ -49,7 +97,32 @@ void* NgLibMemoryManager<Class, T>::ReallocImpl(void* ptr,
 
   manager->CheckAllocatedSize(previous_size);
 
-  char* mem = UncheckedRealloc(original_ptr, size);
+  char* mem = nullptr;
+  const size_t size_class = SizeClassFor(size);
+  if (size == 0) {
+    manager->ReleaseBlock(original_ptr, previous_size);
+  } else if (size_class < kSizeClassCount) {
+    // Small blocks take up their whole size class, so shrinking or growing
+    // within it does not need a new block.
+    size = kMinPooledSize << size_class;
+    if (size == previous_size)
+      return ptr;
+    mem = manager->TakeBlock(size_class);
+  } else if (previous_size > kMaxPooledSize || original_ptr == nullptr) {
+    mem = UncheckedRealloc(original_ptr, size);
+    original_ptr = nullptr;
+  } else {
+    mem = UncheckedMalloc(size);
+  }
+
+  if (mem != nullptr && original_ptr != nullptr) {
+    // Move the contents out of a block that may be kept for reuse.
+    const size_t length = previous_size < size ? previous_size : size;
+    memcpy(mem + sizeof(size_t),
+           original_ptr + sizeof(size_t),
+           length - sizeof(size_t));
+    manager->ReleaseBlock(original_ptr, previous_size);
+  }
 
   if (mem != nullptr) {
     // Adjust the memory info counter.
@@ -12,6 +12,12 @@ namespace mem {
 // follow exactly the same structure and behavior, but
 // use different struct names. To allow for code re-use,
 // the NgLibMemoryManager template class can be used for both.
+//
+// Small allocations are rounded up to a power-of-two size class, and freed
+// blocks of each class are kept for reuse by the same manager, so that the
+// many short-lived allocations for frames, headers and stream state do not
+// all go through malloc(). The kept blocks are released together when the
+// manager is destroyed.
 
 struct NgLibMemoryManagerBase {
   virtual void StopTrackingMemory(void* ptr) = 0;
@@ -26,15 +32,43 @@ class NgLibMemoryManager : public NgLibMemoryManagerBase {
   // void DecreaseAllocatedSize(size_t size);
   // Environment* env() const;
 
+  NgLibMemoryManager() = default;
+  ~NgLibMemoryManager();
+
   AllocatorStructName MakeAllocator();
 
   void StopTrackingMemory(void* ptr) override;
 
  private:
+  // Size classes are kMinPooledSize << i bytes, including the size header.
+  static constexpr size_t kMinPooledSize = 64;
+  static constexpr size_t kSizeClassCount = 6;
+  static constexpr size_t kMaxPooledSize =
+      kMinPooledSize << (kSizeClassCount - 1);
+  // Upper bound for the number of free blocks kept per size class.
+  static constexpr size_t kMaxFreeBlocks = 32;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Returns the size class for an allocation of `size` bytes, or
+  // kSizeClassCount if it is too large to be pooled.
+  static inline size_t SizeClassFor(size_t size);
+  // Returns a block of the given size class, or nullptr if allocating
+  // one fails.
+  inline char* TakeBlock(size_t size_class);
+  // Frees the block at `ptr`, which is `size` bytes long, or keeps it
+  // for reuse.
+  inline void ReleaseBlock(char* ptr, size_t size);
+
   static void* ReallocImpl(void* ptr, size_t size, void* user_data);
   static void* MallocImpl(size_t size, void* user_data);
   static void FreeImpl(void* ptr, void* user_data);
   static void* CallocImpl(size_t nmemb, size_t size, void* user_data);
+
+  FreeBlock* free_blocks_[kSizeClassCount] = {};
+  size_t free_block_counts_[kSizeClassCount] = {};
 };
 
 }  // namespace mem
@@ -7,13 +7,18 @@
 #include "node_contextify.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
+#include "node_immutable_buffer.h"
 #include "node_process.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 using node::contextify::ContextifyContext;
 using node::errors::TryCatchScope;
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
 using v8::BackingStore;
 using v8::CompiledWasmModule;
 using v8::Context;
@@ -23,13 +28,17 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
+using v8::Integer;
 using v8::Isolate;
 using v8::Just;
+using v8::KeyConversionMode;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::Name;
 using v8::Nothing;
 using v8::Object;
+using v8::PropertyFilter;
 using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Symbol;
@@ -79,6 +88,579 @@ bool Message::IsCloseMessage() const {
 
 namespace {
 
+// Messages that only consist of primitives, plain objects, dense arrays,
+// ArrayBuffers and their views are serialized into a simpler format than the
+// one used by V8's ValueSerializer. It needs no delegate, writes the keys of
+// objects with the same layout only once per message, and lets the receiving
+// side create those objects by cloning the first one of them.
+// The format is told apart from V8's, which starts with 0xFF, by its first
+// byte.
+constexpr uint8_t kPlainDataFormat = 0x01;
+
+enum PlainDataTag : uint8_t {
+  kUndefinedTag,
+  kNullTag,
+  kTrueTag,
+  kFalseTag,
+  kInt32Tag,
+  kDoubleTag,
+  kOneByteStringTag,
+  kTwoByteStringTag,
+  // Followed by a shape id and one value per key of the shape. If the id is
+  // the number of shapes seen so far, the keys of the new shape come first.
+  kObjectTag,
+  kArrayTag,
+  kArrayBufferTag,
+  // Followed by the view type, byte offset and byte length, and then the
+  // ArrayBuffer itself.
+  kArrayBufferViewTag,
+  // A reference to an object that has been written before.
+  kReferenceTag,
+};
+
+#define PLAIN_DATA_VIEW_TYPES(V)                                              \
+  V(Uint8Array, 1)                                                            \
+  V(Uint8ClampedArray, 1)                                                     \
+  V(Int8Array, 1)                                                             \
+  V(Uint16Array, 2)                                                           \
+  V(Int16Array, 2)                                                            \
+  V(Uint32Array, 4)                                                           \
+  V(Int32Array, 4)                                                            \
+  V(Float32Array, 4)                                                          \
+  V(Float64Array, 8)                                                          \
+  V(BigInt64Array, 8)                                                         \
+  V(BigUint64Array, 8)                                                        \
+  V(DataView, 1)
+
+enum PlainDataViewType : uint8_t {
+#define V(Type, size) k##Type##View,
+  PLAIN_DATA_VIEW_TYPES(V)
+#undef V
+};
+
+constexpr PropertyFilter kPlainDataPropertyFilter =
+    static_cast<PropertyFilter>(v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS);
+
+class PlainDataSerializer {
+ public:
+  PlainDataSerializer(Isolate* isolate, Local<Context> context)
+      : isolate_(isolate), context_(context) {
+    buffer_.reserve(64);
+    buffer_.push_back(kPlainDataFormat);
+  }
+
+  // Returns Just(false) if `value` contains anything that is not supported
+  // by this format. No JS code is run while writing, so the value can be
+  // passed to the ValueSerializer instead without observable differences.
+  Maybe<bool> WriteValue(Local<Value> value) {
+    return WriteValue(value, 0);
+  }
+
+  MallocedBuffer<char> Release() {
+    MallocedBuffer<char> result(buffer_.size());
+    memcpy(result.data, buffer_.data(), buffer_.size());
+    return result;
+  }
+
+ private:
+  // Deeply nested values and long arrays are left to the ValueSerializer,
+  // which handles the former without recursion and the latter, if they are
+  // dense, without looking up each element.
+  static constexpr int kMaxDepth = 64;
+  static constexpr uint32_t kMaxArrayLength = 1024;
+
+  struct SeenObject {
+    Local<Object> object;
+    bool done;
+  };
+
+  Maybe<bool> WriteValue(Local<Value> value, int depth) {
+    if (value->IsUndefined()) {
+      WriteTag(kUndefinedTag);
+    } else if (value->IsNull()) {
+      WriteTag(kNullTag);
+    } else if (value->IsTrue()) {
+      WriteTag(kTrueTag);
+    } else if (value->IsFalse()) {
+      WriteTag(kFalseTag);
+    } else if (value->IsInt32()) {
+      int32_t number = value.As<v8::Int32>()->Value();
+      WriteTag(kInt32Tag);
+      WriteVarint((static_cast<uint32_t>(number) << 1) ^
+                  static_cast<uint32_t>(number >> 31));
+    } else if (value->IsNumber()) {
+      double number = value.As<v8::Number>()->Value();
+      WriteTag(kDoubleTag);
+      WriteBytes(&number, sizeof(number));
+    } else if (value->IsString()) {
+      WriteString(value.As<String>());
+    } else if (!value->IsObject() || depth >= kMaxDepth) {
+      // Symbols, which cannot be cloned, and BigInts.
+      return Just(false);
+    } else {
+      return WriteObjectOrReference(value.As<Object>(), depth);
+    }
+    return Just(true);
+  }
+
+  Maybe<bool> WriteObjectOrReference(Local<Object> object, int depth) {
+    int hash = object->GetIdentityHash();
+    auto range = ids_by_hash_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      uint32_t id = it->second;
+      if (seen_[id].object == object) {
+        // Cycles are left to the ValueSerializer, because objects are only
+        // created on the receiving side once their properties are known.
+        if (!seen_[id].done) return Just(false);
+        WriteTag(kReferenceTag);
+        WriteVarint(id);
+        return Just(true);
+      }
+    }
+    uint32_t id = seen_.size();
+    ids_by_hash_.emplace(hash, id);
+    seen_.push_back(SeenObject { object, false });
+
+    Maybe<bool> result = Nothing<bool>();
+    if (object->IsArray()) {
+      result = WriteArray(object.As<Array>(), depth);
+    } else if (object->IsArrayBuffer()) {
+      result = Just(WriteArrayBuffer(object.As<ArrayBuffer>()));
+    } else if (object->IsArrayBufferView()) {
+      result = WriteArrayBufferView(object.As<ArrayBufferView>(), depth);
+    } else {
+      result = WritePlainObject(object, depth);
+    }
+    seen_[id].done = true;
+    return result;
+  }
+
+  Maybe<bool> WritePlainObject(Local<Object> object, int depth) {
+    if (!IsPlainObject(object)) return Just(false);
+
+    Local<Array> keys;
+    if (!object->GetOwnPropertyNames(context_,
+                                     kPlainDataPropertyFilter,
+                                     KeyConversionMode::kKeepNumbers)
+             .ToLocal(&keys)) {
+      return Nothing<bool>();
+    }
+    uint32_t length = keys->Length();
+    MaybeStackBuffer<Local<Name>, 16> names(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> key;
+      if (!keys->Get(context_, i).ToLocal(&key)) return Nothing<bool>();
+      // Integer keys would change their order in the receiving object.
+      if (!key->IsString()) return Just(false);
+      names[i] = key.As<Name>();
+      bool is_accessor;
+      if (!object->HasRealNamedCallbackProperty(context_, names[i])
+               .To(&is_accessor)) {
+        return Nothing<bool>();
+      }
+      if (is_accessor) return Just(false);
+    }
+
+    WriteTag(kObjectTag);
+    WriteShape(names.out(), length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> value;
+      bool ok;
+      if (!object->Get(context_, names[i]).ToLocal(&value) ||
+          !WriteValue(value, depth + 1).To(&ok)) {
+        return Nothing<bool>();
+      }
+      if (!ok) return Just(false);
+    }
+    return Just(true);
+  }
+
+  bool IsPlainObject(Local<Object> object) {
+    // Looking at the prototype of a Proxy would run JS code.
+    if (object->IsProxy()) return false;
+    if (object_prototype_.IsEmpty())
+      object_prototype_ = Object::New(isolate_)->GetPrototype();
+    // Objects with a null prototype are received as ordinary objects, too.
+    Local<Value> prototype = object->GetPrototype();
+    if (prototype != object_prototype_ && !prototype->IsNull())
+      return false;
+    if (object->InternalFieldCount() != 0 ||
+        object->HasNamedLookupInterceptor() ||
+        object->HasIndexedLookupInterceptor()) {
+      return false;
+    }
+    // Other kinds of objects can only get here after their prototype has
+    // been changed, but are handled differently by the ValueSerializer.
+    return !object->IsFunction() && !object->IsExternal() &&
+           !object->IsDate() && !object->IsRegExp() &&
+           !object->IsNativeError() && !object->IsArgumentsObject() &&
+           !object->IsBigIntObject() && !object->IsBooleanObject() &&
+           !object->IsNumberObject() && !object->IsStringObject() &&
+           !object->IsSymbolObject() && !object->IsPromise() &&
+           !object->IsMap() && !object->IsSet() &&
+           !object->IsMapIterator() && !object->IsSetIterator() &&
+           !object->IsWeakMap() && !object->IsWeakSet() &&
+           !object->IsGeneratorObject() && !object->IsSharedArrayBuffer() &&
+           !object->IsWasmMemoryObject() && !object->IsWasmModuleObject() &&
+           !object->IsModuleNamespaceObject();
+  }
+
+  Maybe<bool> WriteArray(Local<Array> array, int depth) {
+    uint32_t length = array->Length();
+    if (length > kMaxArrayLength) return Just(false);
+
+    Local<Array> keys;
+    if (!array->GetOwnPropertyNames(context_,
+                                    kPlainDataPropertyFilter,
+                                    KeyConversionMode::kConvertToString)
+             .ToLocal(&keys)) {
+      return Nothing<bool>();
+    }
+    // Holes and other properties are left to the ValueSerializer. Indices
+    // are listed first, so if there are as many keys as elements and the
+    // last one is an index, the keys are exactly the indices.
+    if (keys->Length() != length) return Just(false);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> key;
+      if (!keys->Get(context_, i).ToLocal(&key)) return Nothing<bool>();
+      if (i == length - 1 && key->ToArrayIndex(context_).IsEmpty())
+        return Just(false);
+      bool is_accessor;
+      if (!array->HasRealNamedCallbackProperty(context_, key.As<Name>())
+               .To(&is_accessor)) {
+        return Nothing<bool>();
+      }
+      if (is_accessor) return Just(false);
+    }
+
+    WriteTag(kArrayTag);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> value;
+      bool ok;
+      if (!array->Get(context_, i).ToLocal(&value) ||
+          !WriteValue(value, depth + 1).To(&ok)) {
+        return Nothing<bool>();
+      }
+      if (!ok) return Just(false);
+    }
+    return Just(true);
+  }
+
+  bool WriteArrayBuffer(Local<ArrayBuffer> array_buffer) {
+    // Detached ArrayBuffers have a length of 0, too.
+    size_t length = array_buffer->ByteLength();
+    if (length == 0 || length > UINT32_MAX) return false;
+    std::shared_ptr<BackingStore> store = array_buffer->GetBackingStore();
+    WriteTag(kArrayBufferTag);
+    WriteVarint(length);
+    WriteBytes(store->Data(), length);
+    return true;
+  }
+
+  Maybe<bool> WriteArrayBufferView(Local<ArrayBufferView> view, int depth) {
+    PlainDataViewType type;
+    if (!GetViewType(view, &type)) return Just(false);
+    size_t offset = view->ByteOffset();
+    size_t length = view->ByteLength();
+    if (offset > UINT32_MAX || length > UINT32_MAX) return Just(false);
+    WriteTag(kArrayBufferViewTag);
+    buffer_.push_back(type);
+    WriteVarint(offset);
+    WriteVarint(length);
+    return WriteObjectOrReference(view->Buffer(), depth + 1);
+  }
+
+  static bool GetViewType(Local<ArrayBufferView> view,
+                          PlainDataViewType* type) {
+#define V(Type, size)                                                         \
+    if (view->Is##Type()) {                                                   \
+      *type = k##Type##View;                                                  \
+      return true;                                                            \
+    }
+    PLAIN_DATA_VIEW_TYPES(V)
+#undef V
+    return false;
+  }
+
+  void WriteShape(Local<Name>* names, uint32_t length) {
+    uint32_t hash = length;
+    for (uint32_t i = 0; i < length; i++)
+      hash = hash * 31 + names[i]->GetIdentityHash();
+    auto range = shape_ids_by_hash_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      // Property keys are internalized, so the same key is the same string.
+      const std::vector<Local<Name>>& shape = shapes_[it->second];
+      if (shape.size() == length &&
+          std::equal(shape.begin(), shape.end(), names)) {
+        WriteVarint(it->second);
+        return;
+      }
+    }
+    uint32_t id = shapes_.size();
+    shape_ids_by_hash_.emplace(hash, id);
+    shapes_.emplace_back(names, names + length);
+    WriteVarint(id);
+    WriteVarint(length);
+    for (uint32_t i = 0; i < length; i++)
+      WriteString(names[i].As<String>());
+  }
+
+  void WriteString(Local<String> string) {
+    int length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(kOneByteStringTag);
+      WriteVarint(length);
+      size_t offset = buffer_.size();
+      buffer_.resize(offset + length);
+      string->WriteOneByte(isolate_, buffer_.data() + offset, 0, length,
+                           String::NO_NULL_TERMINATION);
+    } else {
+      WriteTag(kTwoByteStringTag);
+      WriteVarint(length);
+      // Keep the characters aligned, so that they can be read in place.
+      if (buffer_.size() % sizeof(uint16_t) != 0) buffer_.push_back(0);
+      size_t offset = buffer_.size();
+      buffer_.resize(offset + length * sizeof(uint16_t));
+      string->Write(isolate_,
+                    reinterpret_cast<uint16_t*>(buffer_.data() + offset),
+                    0, length, String::NO_NULL_TERMINATION);
+    }
+  }
+
+  void WriteTag(PlainDataTag tag) { buffer_.push_back(tag); }
+
+  void WriteVarint(uint32_t value) {
+    while (value >= 0x80) {
+      buffer_.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    buffer_.push_back(static_cast<uint8_t>(value));
+  }
+
+  void WriteBytes(const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + length);
+  }
+
+  Isolate* isolate_;
+  Local<Context> context_;
+  Local<Value> object_prototype_;
+  std::vector<uint8_t> buffer_;
+  std::vector<SeenObject> seen_;
+  std::unordered_multimap<int, uint32_t> ids_by_hash_;
+  std::vector<std::vector<Local<Name>>> shapes_;
+  std::unordered_multimap<uint32_t, uint32_t> shape_ids_by_hash_;
+};
+
+class PlainDataDeserializer {
+ public:
+  PlainDataDeserializer(Isolate* isolate,
+                        Local<Context> context,
+                        const MallocedBuffer<char>& buffer)
+      : isolate_(isolate),
+        context_(context),
+        data_(reinterpret_cast<const uint8_t*>(buffer.data)),
+        size_(buffer.size) {
+    CHECK_EQ(ReadByte(), kPlainDataFormat);
+  }
+
+  MaybeLocal<Value> ReadValue() {
+    switch (ReadByte()) {
+      case kUndefinedTag:
+        return v8::Undefined(isolate_);
+      case kNullTag:
+        return v8::Null(isolate_);
+      case kTrueTag:
+        return v8::True(isolate_);
+      case kFalseTag:
+        return v8::False(isolate_);
+      case kInt32Tag: {
+        uint32_t value = ReadVarint();
+        return Integer::New(isolate_, static_cast<int32_t>(
+            (value >> 1) ^ (0 - (value & 1))));
+      }
+      case kDoubleTag: {
+        double value;
+        CHECK_LE(position_ + sizeof(value), size_);
+        memcpy(&value, data_ + position_, sizeof(value));
+        position_ += sizeof(value);
+        return v8::Number::New(isolate_, value);
+      }
+      case kOneByteStringTag:
+        return ReadOneByteString(v8::NewStringType::kNormal)
+            .FromMaybe(Local<String>());
+      case kTwoByteStringTag:
+        return ReadTwoByteString(v8::NewStringType::kNormal)
+            .FromMaybe(Local<String>());
+      case kObjectTag:
+        return ReadObject();
+      case kArrayTag:
+        return ReadArray();
+      case kArrayBufferTag:
+        return ReadArrayBuffer();
+      case kArrayBufferViewTag:
+        return ReadArrayBufferView();
+      case kReferenceTag: {
+        uint32_t id = ReadVarint();
+        CHECK_LT(id, objects_.size());
+        CHECK(!objects_[id].IsEmpty());
+        return objects_[id];
+      }
+    }
+    UNREACHABLE();
+  }
+
+ private:
+  struct Shape {
+    std::vector<Local<Name>> names;
+    // The first object of this shape, which later ones are cloned from.
+    Local<Object> first_object;
+  };
+
+  MaybeLocal<Value> ReadObject() {
+    uint32_t id = objects_.size();
+    objects_.emplace_back();
+
+    uint32_t shape_id = ReadVarint();
+    CHECK_LE(shape_id, shapes_.size());
+    if (shape_id == shapes_.size()) {
+      uint32_t length = ReadVarint();
+      std::vector<Local<Name>> names(length);
+      for (uint32_t i = 0; i < length; i++) {
+        uint8_t tag = ReadByte();
+        CHECK(tag == kOneByteStringTag || tag == kTwoByteStringTag);
+        MaybeLocal<String> name = tag == kOneByteStringTag ?
+            ReadOneByteString(v8::NewStringType::kInternalized) :
+            ReadTwoByteString(v8::NewStringType::kInternalized);
+        if (!name.ToLocal(&names[i])) return MaybeLocal<Value>();
+      }
+      shapes_.push_back(Shape { std::move(names), Local<Object>() });
+    }
+
+    size_t length = shapes_[shape_id].names.size();
+    MaybeStackBuffer<Local<Value>, 16> values(length);
+    for (size_t i = 0; i < length; i++) {
+      if (!ReadValue().ToLocal(&values[i])) return MaybeLocal<Value>();
+    }
+
+    // Cloning an object of the same shape avoids going through the map
+    // transitions for each property again.
+    Shape& shape = shapes_[shape_id];
+    Local<Object> object = shape.first_object.IsEmpty() ?
+        Object::New(isolate_) : shape.first_object->Clone();
+    for (size_t i = 0; i < length; i++) {
+      if (object->CreateDataProperty(context_, shape.names[i], values[i])
+              .IsNothing()) {
+        return MaybeLocal<Value>();
+      }
+    }
+    if (shape.first_object.IsEmpty())
+      shape.first_object = object;
+    objects_[id] = object;
+    return object;
+  }
+
+  MaybeLocal<Value> ReadArray() {
+    uint32_t id = objects_.size();
+    objects_.emplace_back();
+    uint32_t length = ReadVarint();
+    MaybeStackBuffer<Local<Value>, 16> elements(length);
+    for (uint32_t i = 0; i < length; i++) {
+      if (!ReadValue().ToLocal(&elements[i])) return MaybeLocal<Value>();
+    }
+    Local<Array> array = Array::New(isolate_, elements.out(), length);
+    objects_[id] = array;
+    return array;
+  }
+
+  MaybeLocal<Value> ReadArrayBuffer() {
+    uint32_t id = objects_.size();
+    objects_.emplace_back();
+    uint32_t length = ReadVarint();
+    CHECK_LE(position_ + length, size_);
+    Local<ArrayBuffer> array_buffer = ArrayBuffer::New(isolate_, length);
+    memcpy(array_buffer->GetBackingStore()->Data(), data_ + position_, length);
+    position_ += length;
+    objects_[id] = array_buffer;
+    return array_buffer;
+  }
+
+  MaybeLocal<Value> ReadArrayBufferView() {
+    uint32_t id = objects_.size();
+    objects_.emplace_back();
+    uint8_t type = ReadByte();
+    uint32_t offset = ReadVarint();
+    uint32_t length = ReadVarint();
+    Local<Value> array_buffer_value;
+    if (!ReadValue().ToLocal(&array_buffer_value)) return MaybeLocal<Value>();
+    CHECK(array_buffer_value->IsArrayBuffer());
+    Local<ArrayBuffer> array_buffer = array_buffer_value.As<ArrayBuffer>();
+    Local<ArrayBufferView> view;
+    switch (type) {
+#define V(Type, size)                                                         \
+      case k##Type##View:                                                     \
+        view = v8::Type::New(array_buffer, offset, length / size);            \
+        break;
+      PLAIN_DATA_VIEW_TYPES(V)
+#undef V
+      default:
+        UNREACHABLE();
+    }
+    objects_[id] = view;
+    return view;
+  }
+
+  MaybeLocal<String> ReadOneByteString(v8::NewStringType type) {
+    uint32_t length = ReadVarint();
+    CHECK_LE(position_ + length, size_);
+    const uint8_t* chars = data_ + position_;
+    position_ += length;
+    return String::NewFromOneByte(isolate_, chars, type, length);
+  }
+
+  MaybeLocal<String> ReadTwoByteString(v8::NewStringType type) {
+    uint32_t length = ReadVarint();
+    if (position_ % sizeof(uint16_t) != 0) position_++;
+    CHECK_LE(position_ + length * sizeof(uint16_t), size_);
+    const uint16_t* chars =
+        reinterpret_cast<const uint16_t*>(data_ + position_);
+    position_ += length * sizeof(uint16_t);
+    return String::NewFromTwoByte(isolate_, chars, type, length);
+  }
+
+  uint8_t ReadByte() {
+    CHECK_LT(position_, size_);
+    return data_[position_++];
+  }
+
+  uint32_t ReadVarint() {
+    uint32_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      uint8_t byte = ReadByte();
+      value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+  }
+
+  Isolate* isolate_;
+  Local<Context> context_;
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = 0;
+  std::vector<Local<Value>> objects_;
+  std::vector<Shape> shapes_;
+};
+
+bool IsPlainDataFormat(const MallocedBuffer<char>& buffer) {
+  return buffer.size > 0 &&
+         static_cast<uint8_t>(buffer.data[0]) == kPlainDataFormat;
+}
+
+}  // anonymous namespace
+
+namespace {
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -131,6 +713,16 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   Context::Scope context_scope(context);
 
   CHECK(!IsCloseMessage());
+  if (IsPlainDataFormat(main_message_buf_)) {
+    EscapableHandleScope handle_scope(env->isolate());
+    PlainDataDeserializer deserializer(env->isolate(), context,
+                                       main_message_buf_);
+    Local<Value> value;
+    if (!deserializer.ReadValue().ToLocal(&value))
+      return MaybeLocal<Value>();
+    return handle_scope.Escape(value);
+  }
+
   if (port_list != nullptr && !transferables_.empty()) {
     // Need to create this outside of the EscapableHandleScope, but inside
     // the Context::Scope.
@@ -414,6 +1006,17 @@ Maybe<bool> Message::Serialize(Environment* env,
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
+  if (transfer_list_v.length() == 0) {
+    PlainDataSerializer serializer(env->isolate(), context);
+    bool written;
+    if (!serializer.WriteValue(input).To(&written))
+      return Nothing<bool>();
+    if (written) {
+      main_message_buf_ = serializer.Release();
+      return Just(true);
+    }
+  }
+
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
@@ -614,6 +1217,13 @@ MessagePort::MessagePort(Environment* env,
     return;
   emit_message_fn_.Reset(env->isolate(), emit_message_fn);
 
+  // Messages can be delivered in batches if the prototype of the port knows
+  // how to do that, which is only the case in the main context.
+  if (!wrap->Get(context, env->onmessages_symbol()).ToLocal(&fn))
+    return;
+  if (fn->IsFunction())
+    emit_messages_fn_.Reset(env->isolate(), fn.As<Function>());
+
   succeeded = true;
   Debug(this, "Created message port");
 }
@@ -690,6 +1300,9 @@ MessagePort* MessagePort::New(
 MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
                                               MessageProcessingMode mode,
                                               Local<Value>* port_list) {
+  // Messages that are part of a batch come before the ones in the queue.
+  ReturnUndeliveredMessages();
+
   std::shared_ptr<Message> received;
   {
     // Get the head of the message queue.
@@ -724,6 +1337,103 @@ MaybeLocal<Value> MessagePort::ReceiveMessage(Local<Context> context,
   return received->Deserialize(env(), context, port_list);
 }
 
+bool MessagePort::DeliverMessageBatch(Local<Context> context,
+                                      size_t limit,
+                                      size_t* count) {
+  // Keep the amount of work that is done before the first message is
+  // delivered, and the memory that the batch takes up, bounded.
+  static constexpr size_t kMaxBatchSize = 1000;
+  static constexpr size_t kMaxBatchPayloadBytes = 1024 * 1024;
+
+  *count = 0;
+  if (!receiving_messages_ || !env()->can_call_into_js()) return true;
+  CHECK(batch_.IsEmpty());
+
+  std::vector<std::shared_ptr<Message>> messages;
+  {
+    Mutex::ScopedLock lock(data_->mutex_);
+    std::deque<std::shared_ptr<Message>>& queue = data_->incoming_messages_;
+    size_t bytes = 0;
+    limit = std::min(limit, kMaxBatchSize);
+    while (messages.size() < std::min(limit, queue.size()) &&
+           bytes < kMaxBatchPayloadBytes) {
+      const std::shared_ptr<Message>& message = queue[messages.size()];
+      if (!message->has_only_plain_data())
+        break;
+      bytes += message->payload_size();
+      messages.push_back(message);
+    }
+    if (messages.size() < 2)
+      return true;
+    queue.erase(queue.begin(), queue.begin() + messages.size());
+  }
+
+  Isolate* isolate = env()->isolate();
+  std::vector<Local<Value>> payloads;
+  {
+    // If a message can't be deserialized, it goes back into the queue and
+    // the regular code path emits the 'messageerror' event for it.
+    TryCatchScope try_catch(env());
+    for (const std::shared_ptr<Message>& message : messages) {
+      Local<Value> payload;
+      if (!message->Deserialize(env(), context).ToLocal(&payload))
+        break;
+      payloads.push_back(payload);
+    }
+  }
+  if (payloads.size() < messages.size()) {
+    Mutex::ScopedLock lock(data_->mutex_);
+    data_->incoming_messages_.insert(data_->incoming_messages_.begin(),
+                                     messages.begin() + payloads.size(),
+                                     messages.end());
+    messages.resize(payloads.size());
+  }
+  if (payloads.empty() || !env()->can_call_into_js())
+    return true;
+
+  // JS takes the payloads from the end of the array, so that its length is
+  // the number of messages that JS has not received yet.
+  std::reverse(payloads.begin(), payloads.end());
+  Local<Array> batch = Array::New(isolate, payloads.data(), payloads.size());
+  batch_.Reset(isolate, batch);
+  batch_messages_ = std::move(messages);
+  *count = payloads.size();
+
+  Local<Value> argv[] = {
+    PersistentToLocal::Strong(emit_message_fn_),
+    batch
+  };
+  const bool ok = !MakeCallback(PersistentToLocal::Strong(emit_messages_fn_),
+                                arraysize(argv),
+                                argv).IsEmpty();
+  // If a listener threw, the rest of the batch is delivered later.
+  ReturnUndeliveredMessages();
+  return ok;
+}
+
+void MessagePort::ReturnUndeliveredMessages() {
+  if (batch_.IsEmpty()) return;
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Local<Array> batch = batch_.Get(isolate);
+  const uint32_t undelivered = batch->Length();
+  CHECK_LE(undelivered, batch_messages_.size());
+  if (undelivered > 0) {
+    if (data_) {
+      Mutex::ScopedLock lock(data_->mutex_);
+      data_->incoming_messages_.insert(data_->incoming_messages_.begin(),
+                                       batch_messages_.end() - undelivered,
+                                       batch_messages_.end());
+    }
+    USE(batch->Set(object()->CreationContext(),
+                   env()->length_string(),
+                   Integer::New(isolate, 0)));
+  }
+  batch_.Reset();
+  batch_messages_.clear();
+}
+
 void MessagePort::OnMessage(MessageProcessingMode mode) {
   Debug(this, "Running MessagePort::OnMessage()");
   HandleScope handle_scope(env()->isolate());
@@ -757,6 +1467,22 @@ void MessagePort::OnMessage(MessageProcessingMode mode) {
 
     HandleScope handle_scope(env()->isolate());
     Context::Scope context_scope(context);
+
+    if (mode == MessageProcessingMode::kNormalOperation &&
+        !emit_messages_fn_.IsEmpty()) {
+      size_t count;
+      if (!DeliverMessageBatch(context, processing_limit + 1, &count)) {
+        // Re-schedule OnMessage() execution in case of failure.
+        if (data_)
+          TriggerAsync();
+        return;
+      }
+      if (count > 0) {
+        processing_limit -= std::min(processing_limit, count - 1);
+        continue;
+      }
+    }
+
     Local<Function> emit_message = PersistentToLocal::Strong(emit_message_fn_);
 
     Local<Value> payload;
@@ -813,6 +1539,8 @@ void MessagePort::OnClose() {
 
 std::unique_ptr<MessagePortData> MessagePort::Detach() {
   CHECK(data_);
+  // The messages that JS has not received yet move along with the data.
+  ReturnUndeliveredMessages();
   Mutex::ScopedLock lock(data_->mutex_);
   data_->owner_ = nullptr;
   return std::move(data_);
@@ -1001,6 +1729,7 @@ void MessagePort::Start() {
 void MessagePort::Stop() {
   Debug(this, "Stop receiving messages");
   receiving_messages_ = false;
+  ReturnUndeliveredMessages();
 }
 
 void MessagePort::Start(const FunctionCallbackInfo<Value>& args) {
@@ -1096,6 +1825,7 @@ void MessagePort::Entangle(MessagePort* a, MessagePortData* b) {
 void MessagePort::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("data", data_);
   tracker->TrackField("emit_message_fn", emit_message_fn_);
+  tracker->TrackField("emit_messages_fn", emit_messages_fn_);
 }
 
 Local<FunctionTemplate> GetMessagePortConstructorTemplate(Environment* env) {
@@ -1467,6 +2197,8 @@ static void InitMessaging(Local<Object> target,
       env->message_port_constructor_string(),
       GetMessagePortConstructorTemplate(env));
 
+  ImmutableBuffer::Initialize(env, target);
+
   // These are not methods on the MessagePort prototype, because
   // the browser equivalents do not provide them.
   env->SetMethod(target, "stopMessagePort", MessagePort::Stop);
@@ -1502,6 +2234,7 @@ static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(MessagePort::ReceiveMessage);
   registry->Register(MessagePort::MoveToContext);
   registry->Register(SetDeserializerCreateObjectFunction);
+  ImmutableBuffer::RegisterExternalReferences(registry);
 }
 
 }  // anonymous namespace
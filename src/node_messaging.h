@@ -99,6 +99,13 @@ class Message : public MemoryRetainer {
   bool has_transferables() const {
     return !transferables_.empty() || !array_buffers_.empty();
   }
+  // Whether deserializing this message only creates new JS values from the
+  // payload, so that it can be done ahead of time, and repeated.
+  bool has_only_plain_data() const {
+    return !IsCloseMessage() && !has_transferables() &&
+           shared_array_buffers_.empty() && wasm_modules_.empty();
+  }
+  size_t payload_size() const { return main_message_buf_.size; }
 
   void MemoryInfo(MemoryTracker* tracker) const override;
 
@@ -299,11 +306,26 @@ class MessagePort : public HandleWrap {
       v8::Local<v8::Context> context,
       MessageProcessingMode mode,
       v8::Local<v8::Value>* port_list = nullptr);
+  // Passes the messages at the front of the queue to JS in a single call, if
+  // there are at least two that can be delivered this way. `count` is set to
+  // the number of messages in the batch. Returns false if JS threw.
+  bool DeliverMessageBatch(v8::Local<v8::Context> context,
+                           size_t limit,
+                           size_t* count);
+  // Puts the messages of the current batch that JS has not received yet back
+  // at the front of the queue, and makes JS stop delivering the batch.
+  void ReturnUndeliveredMessages();
 
   std::unique_ptr<MessagePortData> data_ = nullptr;
   bool receiving_messages_ = false;
   uv_async_t async_;
   v8::Global<v8::Function> emit_message_fn_;
+  // Only set for ports that belong to the main context of an Environment.
+  v8::Global<v8::Function> emit_messages_fn_;
+  // The payloads of the batch that is currently being delivered, in reverse
+  // order, and the messages they came from, in order.
+  v8::Global<v8::Array> batch_;
+  std::vector<std::shared_ptr<Message>> batch_messages_;
 
   friend class MessagePortData;
 };
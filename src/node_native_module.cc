@@ -240,6 +240,13 @@ MaybeLocal<String> NativeModuleLoader::LoadBuiltinModuleSource(Isolate* isolate,
 #endif  // NODE_BUILTIN_MODULES_PATH
 }
 
+void NativeModuleLoader::RetireCodeCache(
+    std::unique_ptr<ScriptCompiler::CachedData> cached_data) {
+  // Other threads may still be compiling with a CachedData that refers to
+  // the data, so it is kept alive until the loader is destroyed.
+  retired_code_cache_.emplace_back(std::move(cached_data));
+}
+
 // Returns Local<Function> of the compiled module if return_code_cache
 // is false (we are only compiling the function).
 // Otherwise return a Local<Object> containing the cache.
@@ -270,9 +277,12 @@ MaybeLocal<Function> NativeModuleLoader::LookupAndCompile(
     Mutex::ScopedLock lock(code_cache_mutex_);
     auto cache_it = code_cache_.find(id);
     if (cache_it != code_cache_.end()) {
-      // Transfer ownership to ScriptCompiler::Source later.
-      cached_data = cache_it->second.release();
-      code_cache_.erase(cache_it);
+      // The entry stays in the map, so that other threads (e.g. Workers that
+      // are starting up at the same time) can use it while we compile. The
+      // CachedData only refers to it; entries are never freed while the
+      // process is running, see RetireCodeCache().
+      const ScriptCompiler::CachedData* entry = cache_it->second.get();
+      cached_data = new ScriptCompiler::CachedData(entry->data, entry->length);
     }
   }
 
@@ -306,20 +316,31 @@ MaybeLocal<Function> NativeModuleLoader::LookupAndCompile(
   // will never be in any of these two sets, but the two sets are only for
   // testing anyway.
 
-  *result = (has_cache && !script_source.GetCachedData()->rejected)
-                ? Result::kWithCache
-                : Result::kWithoutCache;
-  // Generate new cache for next compilation
-  std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
-      ScriptCompiler::CreateCodeCacheForFunction(fun));
-  CHECK_NOT_NULL(new_cached_data);
+  const bool rejected = has_cache && script_source.GetCachedData()->rejected;
+  *result = (has_cache && !rejected) ? Result::kWithCache
+                                     : Result::kWithoutCache;
+
+  // Generate new cache for next compilation, unless the one that was just
+  // used is still good.
+  if (!has_cache || rejected) {
+    std::unique_ptr<ScriptCompiler::CachedData> new_cached_data(
+        ScriptCompiler::CreateCodeCacheForFunction(fun));
+    CHECK_NOT_NULL(new_cached_data);
 
-  {
     Mutex::ScopedLock lock(code_cache_mutex_);
-    // The old entry should've been erased by now so we can just emplace.
-    // If another thread did the same thing in the meantime, that should not
-    // be an issue.
-    code_cache_.emplace(id, std::move(new_cached_data));
+    auto cache_it = code_cache_.find(id);
+    if (cache_it == code_cache_.end()) {
+      code_cache_.emplace(id, std::move(new_cached_data));
+    } else if (rejected) {
+      // Another thread may have replaced the entry that was rejected in the
+      // meantime, in which case that one is kept.
+      if (cache_it->second->data == cached_data->data) {
+        RetireCodeCache(std::move(cache_it->second));
+        cache_it->second = std::move(new_cached_data);
+      }
+    }
+    // Otherwise another thread has already added an entry for the module,
+    // which is just as good as ours.
   }
 
   return scope.Escape(fun);
@@ -7,6 +7,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 #include "node_mutex.h"
 #include "node_union_bytes.h"
 #include "v8.h"
@@ -66,6 +67,9 @@ class NativeModuleLoader {
   bool CannotBeRequired(const char* id);
 
   NativeModuleCacheMap* code_cache();
+  // Must be called with code_cache_mutex_ held.
+  void RetireCodeCache(
+      std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data);
   v8::ScriptCompiler::CachedData* GetCodeCache(const char* id) const;
   enum class Result { kWithCache, kWithoutCache };
   v8::MaybeLocal<v8::String> LoadBuiltinModuleSource(v8::Isolate* isolate,
@@ -85,6 +89,10 @@ class NativeModuleLoader {
   ModuleCategories module_categories_;
   NativeModuleRecordMap source_;
   NativeModuleCacheMap code_cache_;
+  // Code cache entries that were replaced in code_cache_ after V8 rejected
+  // them. They may still be in use by other threads.
+  std::vector<std::unique_ptr<v8::ScriptCompiler::CachedData>>
+      retired_code_cache_;
   UnionBytes config_;
 
   // Used to synchronize access to the code cache map
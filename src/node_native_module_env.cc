@@ -1,4 +1,5 @@
 #include "node_native_module_env.h"
+#include "debug_utils-inl.h"
 #include "env-inl.h"
 #include "node_external_reference.h"
 
@@ -136,9 +137,15 @@ void NativeModuleEnv::CompileFunction(const FunctionCallbackInfo<Value>& args) {
   node::Utf8Value id_v(env->isolate(), args[0].As<String>());
   const char* id = *id_v;
   NativeModuleLoader::Result result;
+  uint64_t start = uv_hrtime();
   MaybeLocal<Function> maybe =
       NativeModuleLoader::GetInstance()->CompileAsModule(
           env->context(), id, &result);
+  Debug(env, DebugCategory::LOADER,
+        "Compiled built-in module %s %s code cache in %d us\n",
+        id,
+        result == NativeModuleLoader::Result::kWithCache ? "with" : "without",
+        (uv_hrtime() - start) / 1000);
   RecordResult(id, result, env);
   Local<Function> fn;
   if (maybe.ToLocal(&fn)) {
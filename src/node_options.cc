@@ -3,6 +3,7 @@
 
 #include "env-inl.h"
 #include "node_binding.h"
+#include "node_external_reference.h"
 #include "node_internals.h"
 
 #include <errno.h>
@@ -80,12 +81,70 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
     if ((secure_heap_min & (secure_heap_min - 1)) != 0)
       errors->push_back("--secure-heap-min must be a power of 2");
   }
+
+  if (crypto_kdf_threads < 0 || crypto_kdf_threads > 1024)
+    errors->push_back("--crypto-kdf-threads must be between 0 and 1024");
 #endif
   if (use_largepages != "off" &&
       use_largepages != "on" &&
       use_largepages != "silent") {
     errors->push_back("invalid value for --use-largepages");
   }
+  if (use_largepages_for_heap != "off" &&
+      use_largepages_for_heap != "on" &&
+      use_largepages_for_heap != "silent") {
+    errors->push_back("invalid value for --use-largepages-for-heap");
+  }
+
+  // --threadpool-limits is a comma-separated list of class=limit pairs.
+  threadpool_work_limits.assign(kThreadPoolWorkClassCount, 0);
+  std::istringstream limits(threadpool_limits);
+  std::string limit;
+  while (std::getline(limits, limit, ',')) {
+    static const char* const names[] = {
+#define V(_, name) name,
+      THREADPOOL_WORK_CLASSES(V)
+#undef V
+    };
+    size_t separator = limit.find('=');
+    const char* const* name = std::find(
+        std::begin(names), std::end(names), limit.substr(0, separator));
+    char* end = nullptr;
+    unsigned long value = 0;  // NOLINT(runtime/int)
+    if (separator != std::string::npos) {
+      errno = 0;
+      value = strtoul(limit.c_str() + separator + 1, &end, 10);
+    }
+    if (name == std::end(names) || end == nullptr || *end != '\0' ||
+        end == limit.c_str() + separator + 1 || errno != 0 ||
+        value > 1024) {
+      errors->push_back("invalid value for --threadpool-limits: " + limit);
+      break;
+    }
+    threadpool_work_limits[name - std::begin(names)] = value;
+  }
+
+  // --report-exclude is a comma-separated list of report sections.
+  std::istringstream sections(report_exclude);
+  std::string section;
+  while (std::getline(sections, section, ',')) {
+    static const char* const names[] = {
+#define V(name) #name,
+      REPORT_EXCLUDABLE_SECTIONS(V)
+#undef V
+    };
+    if (std::find(std::begin(names), std::end(names), section) ==
+        std::end(names)) {
+      errors->push_back("invalid value for --report-exclude: " + section);
+      break;
+    }
+  }
+
+  if (!threadpool_cpu_affinity.empty() &&
+      !ParseCpuList(threadpool_cpu_affinity, &threadpool_cpus)) {
+    errors->push_back("invalid value for --threadpool-cpu-affinity: " +
+                      threadpool_cpu_affinity);
+  }
   per_isolate->CheckOptions(errors);
 }
 
@@ -138,6 +197,12 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
     errors->push_back("--heap-snapshot-near-heap-limit must not be negative");
   }
 
+  if (timer_slack < 0 || timer_slack > 60000)
+    errors->push_back("--timer-slack must be between 0 and 60000");
+
+  if (event_loop_busy_poll > 1000000)
+    errors->push_back("--event-loop-busy-poll must be at most 1000000");
+
 #if HAVE_INSPECTOR
   if (!cpu_prof) {
     if (!cpu_prof_name.empty()) {
@@ -151,6 +216,9 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
     if (cpu_prof_interval != kDefaultCpuProfInterval) {
       errors->push_back("--cpu-prof-interval must be used with --cpu-prof");
     }
+    if (cpu_prof_window != 0) {
+      errors->push_back("--cpu-prof-window must be used with --cpu-prof");
+    }
   }
 
   if (cpu_prof && cpu_prof_dir.empty() && !diagnostic_dir.empty()) {
@@ -288,6 +356,11 @@ DebugOptionsParser::DebugOptionsParser() {
 }
 
 EnvironmentOptionsParser::EnvironmentOptionsParser() {
+  AddOption("--code-cache-dir",
+            "cache the code compiled for CommonJS and ES modules in this "
+            "directory",
+            &EnvironmentOptions::code_cache_dir,
+            kAllowedInEnvironment);
   AddOption("--conditions",
             "additional user conditions for conditional exports and imports",
             &EnvironmentOptions::conditions,
@@ -303,6 +376,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             kAllowedInEnvironment);
   AddOption("--experimental-abortcontroller", "",
             NoOp{}, kAllowedInEnvironment);
+  AddOption("--experimental-async-context-frame",
+            "experimental AsyncLocalStorage that propagates its stores "
+            "without async_hooks",
+            &EnvironmentOptions::experimental_async_context_frame,
+            kAllowedInEnvironment);
   AddOption("--experimental-json-modules",
             "experimental JSON interop support for the ES Module loader",
             &EnvironmentOptions::experimental_json_modules,
@@ -342,6 +420,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental await keyword support in REPL",
             &EnvironmentOptions::experimental_repl_await,
             kAllowedInEnvironment);
+  AddOption("--experimental-vm-compile-cache",
+            "share the code compiled for vm.Script and vm.compileFunction() "
+            "among identical sources",
+            &EnvironmentOptions::experimental_vm_compile_cache,
+            kAllowedInEnvironment);
   AddOption("--experimental-vm-modules",
             "experimental ES Module support in vm module",
             &EnvironmentOptions::experimental_vm_modules,
@@ -361,6 +444,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "Generate heap snapshot on specified signal",
             &EnvironmentOptions::heap_snapshot_signal,
             kAllowedInEnvironment);
+  AddOption("--heap-prof-signal",
+            "Sample allocations for 10 seconds and write a heap profile "
+            "on specified signal",
+            &EnvironmentOptions::heap_prof_signal,
+            kAllowedInEnvironment);
   AddOption("--heapsnapshot-near-heap-limit",
             "Generate heap snapshots whenever V8 is approaching "
             "the heap limit. No more than the specified number of "
@@ -433,6 +521,10 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "specified sampling interval in microseconds for the V8 CPU "
             "profile generated with --cpu-prof. (default: 1000)",
             &EnvironmentOptions::cpu_prof_interval);
+  AddOption("--cpu-prof-window",
+            "end the V8 CPU profile generated with --cpu-prof and start a "
+            "new one every this many seconds, writing each to its own file",
+            &EnvironmentOptions::cpu_prof_window);
   AddOption("--cpu-prof-dir",
             "Directory where the V8 profiles generated by --cpu-prof will be "
             "placed. Does not affect --prof.",
@@ -470,6 +562,21 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "throw an exception on deprecations",
             &EnvironmentOptions::throw_deprecation,
             kAllowedInEnvironment);
+  AddOption("--tick-batch-size",
+            "process the nextTick and microtask queues once for up to this "
+            "many callbacks in the same event loop phase",
+            &EnvironmentOptions::tick_batch_size,
+            kAllowedInEnvironment);
+  AddOption("--timer-slack",
+            "let timers run up to this many milliseconds late, so that they "
+            "can be kept in a timing wheel",
+            &EnvironmentOptions::timer_slack,
+            kAllowedInEnvironment);
+  AddOption("--event-loop-busy-poll",
+            "poll for I/O without blocking for this many microseconds each "
+            "time the event loop wakes up, trading CPU time for latency",
+            &EnvironmentOptions::event_loop_busy_poll,
+            kAllowedInEnvironment);
   AddOption("--trace-atomics-wait",
             "trace Atomics.wait() operations",
             &EnvironmentOptions::trace_atomics_wait,
@@ -650,6 +757,11 @@ PerIsolateOptionsParser::PerIsolateOptionsParser(
 
 PerProcessOptionsParser::PerProcessOptionsParser(
   const PerIsolateOptionsParser& iop) {
+  AddOption("--realpath-cache-size",
+            "cache up to this many realpath() results of the module loaders, "
+            "shared by all threads",
+            &PerProcessOptions::realpath_cache_size,
+            kAllowedInEnvironment);
   AddOption("--title",
             "the process title to use on startup",
             &PerProcessOptions::title,
@@ -663,12 +775,21 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "data, it supports ${rotation} and ${pid}.",
             &PerProcessOptions::trace_event_file_pattern,
             kAllowedInEnvironment);
+  AddOption("--trace-event-file-gzip",
+            "compress the trace-events files with gzip",
+            &PerProcessOptions::trace_event_file_gzip,
+            kAllowedInEnvironment);
   AddAlias("--trace-events-enabled", {
     "--trace-event-categories", "v8,node,node.async_hooks" });
   AddOption("--v8-pool-size",
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--idle-gc-time",
+            "let V8 do garbage collection work for up to this many "
+            "milliseconds when the event loop is about to wait for events",
+            &PerProcessOptions::idle_gc_time,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
@@ -678,10 +799,34 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "", /* undocumented, only for debugging */
             &PerProcessOptions::debug_arraybuffer_allocations,
             kAllowedInEnvironment);
+  AddOption("--pool-array-buffers",
+            "reuse the memory of freed ArrayBuffers of up to 16 KiB",
+            &PerProcessOptions::pool_array_buffers,
+            kAllowedInEnvironment);
   AddOption("--disable-proto",
             "disable Object.prototype.__proto__",
             &PerProcessOptions::disable_proto,
             kAllowedInEnvironment);
+  AddOption("--threadpool-limits",
+            "limit how many threadpool requests of a class an event loop "
+            "may run at once, e.g. crypto=2,zlib=2",
+            &PerProcessOptions::threadpool_limits,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-cpu-affinity",
+            "run the libuv threadpool threads only on these CPUs, "
+            "e.g. 0-3,8 (Linux only)",
+            &PerProcessOptions::threadpool_cpu_affinity,
+            kAllowedInEnvironment);
+  AddOption("--build-snapshot",
+            "run the entry point script, and then write a snapshot of the "
+            "application to the file given by --snapshot-blob",
+            &PerProcessOptions::build_snapshot,
+            kDisallowedInEnvironment);
+  AddOption("--snapshot-blob",
+            "start from the snapshot in this file, or write the snapshot "
+            "to it with --build-snapshot",
+            &PerProcessOptions::snapshot_blob,
+            kAllowedInEnvironment);
 
   // 12.x renamed this inadvertently, so alias it for consistency within the
   // release line, while using the original name for consistency with older
@@ -705,6 +850,10 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "output compact single-line JSON",
             &PerProcessOptions::report_compact,
             kAllowedInEnvironment);
+  AddOption("--report-exclude",
+            "comma-separated list of sections to leave out of reports",
+            &PerProcessOptions::report_exclude,
+            kAllowedInEnvironment);
   AddOption("--report-dir",
             "define custom report pathname."
             " (default: current working directory)",
@@ -782,6 +931,11 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "minimum allocation size from the OpenSSL secure heap",
             &PerProcessOptions::secure_heap_min,
             kAllowedInEnvironment);
+  AddOption("--crypto-kdf-threads",
+            "run pbkdf2 and scrypt jobs on this many threads of their own "
+            "instead of the libuv threadpool",
+            &PerProcessOptions::crypto_kdf_threads,
+            kAllowedInEnvironment);
 #endif
   AddOption("--use-largepages",
             "Map the Node.js static code to large pages. Options are "
@@ -790,6 +944,13 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "or 'silent' (map and silently ignore failure)",
             &PerProcessOptions::use_largepages,
             kAllowedInEnvironment);
+  AddOption("--use-largepages-for-heap",
+            "Back the V8 heap and large ArrayBuffers with transparent huge "
+            "pages. Options are 'off' (the default value), "
+            "'on' (fall back to the default page size on failure, "
+            "reporting it to stderr), or 'silent' (fall back silently)",
+            &PerProcessOptions::use_largepages_for_heap,
+            kAllowedInEnvironment);
 
   AddOption("--trace-sigint",
             "enable printing JavaScript stacktrace on SIGINT",
@@ -1061,6 +1222,10 @@ void Initialize(Local<Object> target,
       .Check();
 }
 
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(GetOptions);
+}
+
 }  // namespace options_parser
 
 void HandleEnvOptions(std::shared_ptr<EnvironmentOptions> env_options) {
@@ -1127,3 +1292,5 @@ std::vector<std::string> ParseNodeOptionsEnvVar(
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(options, node::options_parser::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(options,
+                               node::options_parser::RegisterExternalReferences)
@@ -11,6 +11,17 @@
 #include "node_mutex.h"
 #include "util.h"
 
+// The sections of a diagnostic report that --report-exclude can leave out.
+#define REPORT_EXCLUDABLE_SECTIONS(V)                                         \
+  V(cpus)                                                                     \
+  V(environmentVariables)                                                     \
+  V(libuv)                                                                    \
+  V(nativeStack)                                                              \
+  V(networkInterfaces)                                                        \
+  V(sharedObjects)                                                            \
+  V(userLimits)                                                               \
+  V(workers)
+
 namespace node {
 
 class HostPort {
@@ -100,8 +111,10 @@ class DebugOptions : public Options {
 class EnvironmentOptions : public Options {
  public:
   bool abort_on_uncaught_exception = false;
+  std::string code_cache_dir;
   std::vector<std::string> conditions;
   bool enable_source_maps = false;
+  bool experimental_async_context_frame = false;
   bool experimental_json_modules = false;
   bool experimental_modules = false;
   std::string experimental_specifier_resolution;
@@ -112,11 +125,13 @@ class EnvironmentOptions : public Options {
   std::string experimental_policy_integrity;
   bool has_policy_integrity_string;
   bool experimental_repl_await = false;
+  bool experimental_vm_compile_cache = false;
   bool experimental_vm_modules = false;
   bool expose_internals = false;
   bool frozen_intrinsics = false;
   int64_t heap_snapshot_near_heap_limit = 0;
   std::string heap_snapshot_signal;
+  std::string heap_prof_signal;
   uint64_t max_http_header_size = 16 * 1024;
   bool no_deprecation = false;
   bool no_force_async_hooks_checks = false;
@@ -131,6 +146,7 @@ class EnvironmentOptions : public Options {
   static const uint64_t kDefaultCpuProfInterval = 1000;
   uint64_t cpu_prof_interval = kDefaultCpuProfInterval;
   std::string cpu_prof_name;
+  uint64_t cpu_prof_window = 0;
   bool cpu_prof = false;
   std::string heap_prof_dir;
   std::string heap_prof_name;
@@ -142,6 +158,9 @@ class EnvironmentOptions : public Options {
   std::string diagnostic_dir;
   bool test_udp_no_try_send = false;
   bool throw_deprecation = false;
+  int64_t timer_slack = 0;
+  uint64_t tick_batch_size = 0;
+  uint64_t event_loop_busy_poll = 0;
   bool trace_atomics_wait = false;
   bool trace_deprecation = false;
   bool trace_exit = false;
@@ -213,13 +232,26 @@ class PerProcessOptions : public Options {
   //     Mutex::ScopedLock lock(node::per_process::cli_options_mutex);
   std::shared_ptr<PerIsolateOptions> per_isolate { new PerIsolateOptions() };
 
+  int64_t realpath_cache_size = 0;
   std::string title;
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
+  bool trace_event_file_gzip = false;
   int64_t v8_thread_pool_size = 4;
+  uint64_t idle_gc_time = 0;
   bool zero_fill_all_buffers = false;
   bool debug_arraybuffer_allocations = false;
+  bool pool_array_buffers = false;
   std::string disable_proto;
+  std::string threadpool_limits;
+  // Parsed from threadpool_limits, indexed by ThreadPoolWorkClass. 0 means
+  // that there is no limit.
+  std::vector<uint32_t> threadpool_work_limits;
+  std::string threadpool_cpu_affinity;
+  // Parsed from threadpool_cpu_affinity.
+  std::vector<int> threadpool_cpus;
+  bool build_snapshot = false;
+  std::string snapshot_blob;
 
   std::vector<std::string> security_reverts;
   bool print_bash_completion = false;
@@ -238,6 +270,7 @@ class PerProcessOptions : public Options {
   std::string tls_cipher_list = DEFAULT_CIPHER_LIST_CORE;
   int64_t secure_heap = 0;
   int64_t secure_heap_min = 2;
+  int64_t crypto_kdf_threads = 0;
 #ifdef NODE_OPENSSL_CERT_STORE
   bool ssl_openssl_cert_store = true;
 #else
@@ -252,11 +285,13 @@ class PerProcessOptions : public Options {
   // Per-process because reports can be triggered outside a known V8 context.
   bool report_on_fatalerror = false;
   bool report_compact = false;
+  std::string report_exclude;
   std::string report_directory;
   std::string report_filename;
 
   // TODO(addaleax): Some of these could probably be per-Environment.
   std::string use_largepages = "off";
+  std::string use_largepages_for_heap = "off";
   bool trace_sigint = false;
   std::vector<std::string> cmdline;
 
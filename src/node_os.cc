@@ -20,6 +20,7 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "env-inl.h"
+#include "node_external_reference.h"
 #include "string_bytes.h"
 
 #ifdef __MINGW32__
@@ -31,6 +32,7 @@
 # include <climits>         // PATH_MAX on Solaris.
 #endif  // __POSIX__
 
+#include <algorithm>
 #include <array>
 #include <cerrno>
 #include <cstring>
@@ -135,6 +137,47 @@ static void GetCPUInfo(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Fills the times of each CPU into the Float64Array args[0], if it is given,
+// as [user, nice, sys, idle, irq, user2, nice2, ...] without creating any
+// objects. Only as many CPUs as fit into the array are written. Returns the
+// number of CPUs, or undefined with args[1] filled on failure.
+static void GetCPUTimes(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK_EQ(args.Length(), 2);
+
+  uv_cpu_info_t* cpu_infos;
+  int count;
+
+  int err = uv_cpu_info(&cpu_infos, &count);
+  if (err) {
+    CHECK(args[1]->IsObject());
+    env->CollectUVExceptionInfo(args[1], err, "uv_cpu_info");
+    return;
+  }
+
+  if (args[0]->IsFloat64Array()) {
+    Local<Float64Array> array = args[0].As<Float64Array>();
+    double* times = reinterpret_cast<double*>(
+        static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+        array->ByteOffset());
+    const size_t fits = std::min(static_cast<size_t>(count),
+                                 array->Length() / 5);
+    for (size_t i = 0; i < fits; i++) {
+      const uv_cpu_times_s& cpu_times = cpu_infos[i].cpu_times;
+      times[i * 5] = static_cast<double>(cpu_times.user);
+      times[i * 5 + 1] = static_cast<double>(cpu_times.nice);
+      times[i * 5 + 2] = static_cast<double>(cpu_times.sys);
+      times[i * 5 + 3] = static_cast<double>(cpu_times.idle);
+      times[i * 5 + 4] = static_cast<double>(cpu_times.irq);
+    }
+  }
+
+  uv_free_cpu_info(cpu_infos, count);
+  args.GetReturnValue().Set(count);
+}
+
+
 static void GetFreeMemory(const FunctionCallbackInfo<Value>& args) {
   double amount = static_cast<double>(uv_get_free_memory());
   args.GetReturnValue().Set(amount);
@@ -387,6 +430,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "getTotalMem", GetTotalMemory);
   env->SetMethod(target, "getFreeMem", GetFreeMemory);
   env->SetMethod(target, "getCPUs", GetCPUInfo);
+  env->SetMethod(target, "getCPUTimes", GetCPUTimes);
   env->SetMethod(target, "getInterfaceAddresses", GetInterfaceAddresses);
   env->SetMethod(target, "getHomeDirectory", GetHomeDirectory);
   env->SetMethod(target, "getUserInfo", GetUserInfo);
@@ -398,7 +442,24 @@ void Initialize(Local<Object> target,
               Boolean::New(env->isolate(), IsBigEndian())).Check();
 }
 
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(GetHostname);
+  registry->Register(GetLoadAvg);
+  registry->Register(GetUptime);
+  registry->Register(GetTotalMemory);
+  registry->Register(GetFreeMemory);
+  registry->Register(GetCPUInfo);
+  registry->Register(GetCPUTimes);
+  registry->Register(GetInterfaceAddresses);
+  registry->Register(GetHomeDirectory);
+  registry->Register(GetUserInfo);
+  registry->Register(SetPriority);
+  registry->Register(GetPriority);
+  registry->Register(GetOSInformation);
+}
+
 }  // namespace os
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(os, node::os::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(os, node::os::RegisterExternalReferences)
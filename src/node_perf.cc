@@ -7,12 +7,20 @@
 #include "node_buffer.h"
 #include "node_process.h"
 #include "util-inl.h"
+#include "v8-fast-api-calls.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 namespace node {
 namespace performance {
 
+using v8::ApiObject;
+using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
+using v8::CFunction;
+using v8::ConstructorBehavior;
 using v8::Context;
 using v8::DontDelete;
 using v8::Function;
@@ -20,6 +28,8 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::GCCallbackFlags;
 using v8::GCType;
+using v8::Global;
+using v8::HeapSpaceStatistics;
 using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
@@ -27,8 +37,11 @@ using v8::Local;
 using v8::MaybeLocal;
 using v8::Number;
 using v8::Object;
+using v8::ObjectTemplate;
 using v8::PropertyAttribute;
 using v8::ReadOnly;
+using v8::SideEffectType;
+using v8::Signature;
 using v8::String;
 using v8::Value;
 
@@ -200,6 +213,176 @@ static void RemoveGarbageCollectionTracking(
   GarbageCollectionCleanupHook(env);
 }
 
+// Returns the used size of the heap, and of its young generation in `young`.
+// The used and the total size of each space are stored in the fields of the
+// monitor if `update_fields` is true.
+size_t GetGCMonitorHeapUsed(Isolate* isolate,
+                            GCMonitor* monitor,
+                            size_t* young,
+                            bool update_fields) {
+  size_t used = 0;
+  *young = 0;
+  size_t count = isolate->NumberOfHeapSpaces();
+  for (size_t i = 0; i < count; i++) {
+    HeapSpaceStatistics stats;
+    isolate->GetHeapSpaceStatistics(&stats, i);
+    used += stats.space_used_size();
+    if (std::find(monitor->young_spaces.begin(),
+                  monitor->young_spaces.end(),
+                  i) != monitor->young_spaces.end()) {
+      *young += stats.space_used_size();
+    }
+    if (update_fields) {
+      monitor->fields[kGCMonitorHeapSpaceFields + 2 * i] =
+          stats.space_used_size();
+      monitor->fields[kGCMonitorHeapSpaceFields + 2 * i + 1] =
+          stats.space_size();
+    }
+  }
+  return used;
+}
+
+size_t GetGCMonitorTypeIndex(GCType type) {
+  switch (type) {
+#define V(name, gc_type, _)                                                   \
+    case gc_type: return static_cast<size_t>(GCMonitorType::name);
+    GC_MONITOR_TYPES(V)
+#undef V
+    default:
+      return kGCMonitorTypeCount;
+  }
+}
+
+void GCMonitorPrologue(Isolate* isolate,
+                       GCType type,
+                       GCCallbackFlags flags,
+                       void* data) {
+  GCMonitor* monitor = static_cast<Environment*>(data)->gc_monitor();
+  size_t index = GetGCMonitorTypeIndex(type);
+  if (index == kGCMonitorTypeCount) return;
+  uint64_t now = uv_hrtime();
+  size_t young;
+  size_t used = GetGCMonitorHeapUsed(isolate, monitor, &young, false);
+  monitor->start_time[index] = now;
+  monitor->start_used[index] = used;
+  monitor->start_young_used[index] = young;
+
+  if (used > monitor->last_end_used) {
+    size_t allocated = used - monitor->last_end_used;
+    monitor->fields[kGCMonitorBytesAllocated] += allocated;
+    if (now > monitor->last_end_time) {
+      monitor->allocation_rate_histogram->Record(
+          static_cast<int64_t>(allocated * 1e9 /
+                               (now - monitor->last_end_time)));
+    }
+  }
+  // Only the first of GCs that overlap counts the growth of the heap.
+  monitor->last_end_used = used;
+}
+
+void GCMonitorEpilogue(Isolate* isolate,
+                       GCType type,
+                       GCCallbackFlags flags,
+                       void* data) {
+  GCMonitor* monitor = static_cast<Environment*>(data)->gc_monitor();
+  size_t index = GetGCMonitorTypeIndex(type);
+  if (index == kGCMonitorTypeCount || monitor->start_time[index] == 0)
+    return;
+  uint64_t now = uv_hrtime();
+  uint64_t pause = now - monitor->start_time[index];
+  monitor->start_time[index] = 0;
+  monitor->pause_histograms[index]->Record(std::max<int64_t>(pause, 1));
+  monitor->fields[kGCMonitorTypeFields + 2 * index] += 1;
+  monitor->fields[kGCMonitorTypeFields + 2 * index + 1] += pause;
+
+  size_t young;
+  size_t used = GetGCMonitorHeapUsed(isolate, monitor, &young, true);
+  size_t start_used = monitor->start_used[index];
+  if (start_used > used)
+    monitor->fields[kGCMonitorBytesFreed] += start_used - used;
+  if (type == v8::kGCTypeScavenge) {
+    size_t start_old = start_used - monitor->start_young_used[index];
+    size_t old = used - young;
+    if (old > start_old)
+      monitor->fields[kGCMonitorBytesPromoted] += old - start_old;
+  }
+  monitor->last_end_time = now;
+  monitor->last_end_used = used;
+}
+
+void GCMonitorCleanupHook(void* data) {
+  Environment* env = static_cast<Environment*>(data);
+  env->isolate()->RemoveGCPrologueCallback(GCMonitorPrologue, data);
+  env->isolate()->RemoveGCEpilogueCallback(GCMonitorEpilogue, data);
+}
+
+// Starts recording the GCs of the isolate, and returns
+// [fields, heapSpaceNames, { [type]: pauseHistogram }, allocationRateHistogram]
+void GetGCMonitor(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  size_t space_count = isolate->NumberOfHeapSpaces();
+  GCMonitor* monitor = env->gc_monitor();
+  if (monitor == nullptr) {
+    env->set_gc_monitor(std::make_unique<GCMonitor>(isolate, space_count));
+    monitor = env->gc_monitor();
+    for (size_t i = 0; i < kGCMonitorTypeCount; i++)
+      monitor->pause_histograms[i] = std::make_shared<Histogram>(1, 3.6e12, 3);
+    monitor->allocation_rate_histogram = std::make_shared<Histogram>();
+    for (size_t i = 0; i < space_count; i++) {
+      HeapSpaceStatistics stats;
+      isolate->GetHeapSpaceStatistics(&stats, i);
+      if (strcmp(stats.space_name(), "new_space") == 0 ||
+          strcmp(stats.space_name(), "new_large_object_space") == 0) {
+        monitor->young_spaces.push_back(i);
+      }
+    }
+    size_t young;
+    monitor->last_end_time = uv_hrtime();
+    monitor->last_end_used =
+        GetGCMonitorHeapUsed(isolate, monitor, &young, true);
+    isolate->AddGCPrologueCallback(GCMonitorPrologue, env);
+    isolate->AddGCEpilogueCallback(GCMonitorEpilogue, env);
+    env->AddCleanupHook(GCMonitorCleanupHook, env);
+  }
+
+  std::vector<Local<Value>> names(space_count);
+  for (size_t i = 0; i < space_count; i++) {
+    HeapSpaceStatistics stats;
+    isolate->GetHeapSpaceStatistics(&stats, i);
+    names[i] = OneByteString(isolate, stats.space_name());
+  }
+
+  Local<Object> pause = Object::New(isolate);
+#define V(name, _, string)                                                    \
+  {                                                                           \
+    BaseObjectPtr<HistogramBase> histogram = HistogramBase::Create(           \
+        env,                                                                  \
+        monitor->pause_histograms[static_cast<size_t>(GCMonitorType::name)]); \
+    if (!histogram ||                                                         \
+        pause->Set(context,                                                   \
+                   FIXED_ONE_BYTE_STRING(isolate, string),                    \
+                   histogram->object()).IsNothing()) {                        \
+      return;                                                                 \
+    }                                                                         \
+  }
+  GC_MONITOR_TYPES(V)
+#undef V
+
+  BaseObjectPtr<HistogramBase> allocation_rate =
+      HistogramBase::Create(env, monitor->allocation_rate_histogram);
+  if (!allocation_rate) return;
+
+  Local<Value> result[] = {
+    monitor->fields.GetJSArray(),
+    Array::New(isolate, names.data(), names.size()),
+    pause,
+    allocation_rate->object(),
+  };
+  args.GetReturnValue().Set(Array::New(isolate, result, arraysize(result)));
+}
+
 // Gets the name of a function
 inline Local<Value> GetName(Local<Function> fn) {
   Local<Value> val = fn->GetDebugName();
@@ -233,6 +416,68 @@ void LoopIdleTime(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(1.0 * idle_time / 1e6);
 }
 
+// Starts recording the queue wait and run time of the threadpool work of
+// the Environment, and returns { [class]: [waitHistogram, runHistogram] }.
+void GetThreadpoolHistograms(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  Local<Object> result = Object::New(isolate);
+#define V(name, string)                                                       \
+  {                                                                           \
+    ThreadPoolWorkClassState* state =                                         \
+        env->threadpool_work_class_state(ThreadPoolWorkClass::name);          \
+    if (!state->wait_histogram) {                                             \
+      state->wait_histogram = std::make_shared<Histogram>(1, 3.6e12, 3);      \
+      state->run_histogram = std::make_shared<Histogram>(1, 3.6e12, 3);       \
+    }                                                                         \
+    BaseObjectPtr<HistogramBase> wait =                                       \
+        HistogramBase::Create(env, state->wait_histogram);                    \
+    BaseObjectPtr<HistogramBase> run =                                        \
+        HistogramBase::Create(env, state->run_histogram);                     \
+    if (!wait || !run) return;                                                \
+    Local<Value> histograms[] = { wait->object(), run->object() };            \
+    if (result->Set(context,                                                  \
+                    FIXED_ONE_BYTE_STRING(isolate, string),                   \
+                    Array::New(isolate, histograms, 2)).IsNothing()) {        \
+      return;                                                                 \
+    }                                                                         \
+  }
+  THREADPOOL_WORK_CLASSES(V)
+#undef V
+  args.GetReturnValue().Set(result);
+}
+
+// Starts recording the time and the number of calls into JavaScript of the
+// phases of the event loop, and returns
+// { [phase]: [timeHistogram, callbacksHistogram] }.
+void GetEventLoopPhaseHistograms(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  EventLoopPhaseMonitor* monitor = env->StartEventLoopPhaseMonitor();
+  if (monitor == nullptr) return;
+  Local<Object> result = Object::New(isolate);
+#define V(name, string)                                                       \
+  {                                                                           \
+    size_t index = static_cast<size_t>(EventLoopPhase::name);                 \
+    BaseObjectPtr<HistogramBase> time =                                       \
+        HistogramBase::Create(env, monitor->time_histograms[index]);          \
+    BaseObjectPtr<HistogramBase> callbacks =                                  \
+        HistogramBase::Create(env, monitor->callback_histograms[index]);      \
+    if (!time || !callbacks) return;                                          \
+    Local<Value> histograms[] = { time->object(), callbacks->object() };      \
+    if (result->Set(context,                                                  \
+                    FIXED_ONE_BYTE_STRING(isolate, string),                   \
+                    Array::New(isolate, histograms, 2)).IsNothing()) {        \
+      return;                                                                 \
+    }                                                                         \
+  }
+  EVENT_LOOP_PHASES(V)
+#undef V
+  args.GetReturnValue().Set(result);
+}
+
 // Event Loop Timing Histogram
 void ELDHistogram::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -246,7 +491,7 @@ void ELDHistogram::Initialize(Environment* env, Local<Object> target) {
   Local<FunctionTemplate> tmpl = env->NewFunctionTemplate(New);
   tmpl->Inherit(IntervalHistogram::GetConstructorTemplate(env));
   tmpl->InstanceTemplate()->SetInternalFieldCount(
-      ELDHistogram::kInternalFieldCount);
+      HistogramImpl::kInternalFieldCount);
   env->SetConstructorFunction(target, "ELDHistogram", tmpl);
 }
 
@@ -274,6 +519,80 @@ void ELDHistogram::OnInterval() {
                  "stddev", histogram()->Stddev());
 }
 
+// Backs performance.now(). The value is written into a shared buffer since
+// fast API calls can not return it, which saves the process.hrtime() array
+// that the JS implementation used to allocate on every call.
+class FastPerformanceNow : public BaseObject {
+ public:
+  static Local<Object> New(Environment* env) {
+    Local<FunctionTemplate> ctor = FunctionTemplate::New(env->isolate());
+    ctor->Inherit(BaseObject::GetConstructorTemplate(env));
+    Local<ObjectTemplate> otmpl = ctor->InstanceTemplate();
+    otmpl->SetInternalFieldCount(FastPerformanceNow::kInternalFieldCount);
+
+    CFunction cfunc = CFunction::Make(FastNow);
+    otmpl->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "now"),
+               FunctionTemplate::New(env->isolate(),
+                                     SlowNow,
+                                     Local<Value>(),
+                                     Local<Signature>(),
+                                     0,
+                                     ConstructorBehavior::kThrow,
+                                     SideEffectType::kHasNoSideEffect,
+                                     &cfunc));
+
+    Local<Object> obj = otmpl->NewInstance(env->context()).ToLocalChecked();
+
+    Local<ArrayBuffer> ab = ArrayBuffer::New(env->isolate(), sizeof(double));
+    new FastPerformanceNow(env, obj, ab);
+    obj->Set(
+           env->context(), FIXED_ONE_BYTE_STRING(env->isolate(), "buffer"), ab)
+        .ToChecked();
+
+    return obj;
+  }
+
+ private:
+  FastPerformanceNow(Environment* env,
+                     Local<Object> object,
+                     Local<ArrayBuffer> ab)
+      : BaseObject(env, object),
+        array_buffer_(env->isolate(), ab),
+        backing_store_(ab->GetBackingStore()) {
+    MakeWeak();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("array_buffer", array_buffer_);
+  }
+  SET_MEMORY_INFO_NAME(FastPerformanceNow)
+  SET_SELF_SIZE(FastPerformanceNow)
+
+  static FastPerformanceNow* FromV8ApiObject(ApiObject api_object) {
+    Object* v8_object = reinterpret_cast<Object*>(&api_object);
+    return static_cast<FastPerformanceNow*>(
+        v8_object->GetAlignedPointerFromInternalField(BaseObject::kSlot));
+  }
+
+  // Milliseconds since the time origin. The subtraction is done in integer
+  // nanoseconds so that no precision is lost to large uptimes.
+  static void NowImpl(FastPerformanceNow* receiver) {
+    double* fields = static_cast<double*>(receiver->backing_store_->Data());
+    fields[0] = (PERFORMANCE_NOW() - timeOrigin) / 1e6;
+  }
+
+  static void FastNow(ApiObject receiver) {
+    NowImpl(FromV8ApiObject(receiver));
+  }
+
+  static void SlowNow(const FunctionCallbackInfo<Value>& args) {
+    NowImpl(FromJSObject<FastPerformanceNow>(args.Holder()));
+  }
+
+  Global<ArrayBuffer> array_buffer_;
+  std::shared_ptr<BackingStore> backing_store_;
+};
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -308,6 +627,15 @@ void Initialize(Local<Object> target,
                  RemoveGarbageCollectionTracking);
   env->SetMethod(target, "notify", Notify);
   env->SetMethod(target, "loopIdleTime", LoopIdleTime);
+  env->SetMethod(target, "getThreadpoolHistograms", GetThreadpoolHistograms);
+  env->SetMethod(target,
+                 "getEventLoopPhaseHistograms",
+                 GetEventLoopPhaseHistograms);
+  env->SetMethod(target, "getGCMonitor", GetGCMonitor);
+
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "fastNow"),
+              FastPerformanceNow::New(env)).Check();
 
   Local<Object> constants = Object::New(isolate);
 
@@ -28,7 +28,10 @@ extern uint64_t performance_v8_start;
   V(V8_START, "v8Start")                                                      \
   V(LOOP_START, "loopStart")                                                  \
   V(LOOP_EXIT, "loopExit")                                                    \
-  V(BOOTSTRAP_COMPLETE, "bootstrapComplete")
+  V(BOOTSTRAP_COMPLETE, "bootstrapComplete")                                  \
+  V(CONTEXT_READY, "contextReady")                                            \
+  V(INTERNAL_BOOTSTRAP_COMPLETE, "internalBootstrapComplete")                 \
+  V(MAIN_MODULE_LOADED, "mainModuleLoaded")
 
 
 #define NODE_PERFORMANCE_ENTRY_TYPES(V)                                       \
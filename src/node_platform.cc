@@ -3,8 +3,10 @@
 
 #include "env-inl.h"
 #include "debug_utils-inl.h"
-#include <algorithm>  // find_if(), find(), move()
+#include "large_pages/node_large_page.h"
+#include <algorithm>  // find_if(), find(), move(), push_heap(), pop_heap()
 #include <cmath>  // llround()
+#include <deque>
 #include <memory>  // unique_ptr(), shared_ptr(), make_shared()
 
 namespace node {
@@ -17,20 +19,59 @@ using v8::Task;
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<Task>* task_queue;
+  WorkerThreadsTaskRunner* task_runner;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
   int id;
 };
 
-static void PlatformWorkerThread(void* data) {
+// Set on platform worker threads, so that the tasks that they post end up in
+// their own queue.
+thread_local WorkerThreadsTaskRunner* current_task_runner = nullptr;
+thread_local size_t current_queue_index = 0;
+
+}  // namespace
+
+class WorkerThreadsTaskRunner::WorkerQueue {
+ public:
+  void Push(std::unique_ptr<Task> task) {
+    Mutex::ScopedLock lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+
+  // The owning thread takes tasks from the front of its queue, other threads
+  // steal them from the back.
+  std::unique_ptr<Task> PopFront() {
+    Mutex::ScopedLock lock(mutex_);
+    if (tasks_.empty()) return nullptr;
+    std::unique_ptr<Task> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    return task;
+  }
+
+  std::unique_ptr<Task> PopBack() {
+    Mutex::ScopedLock lock(mutex_);
+    if (tasks_.empty()) return nullptr;
+    std::unique_ptr<Task> task = std::move(tasks_.back());
+    tasks_.pop_back();
+    return task;
+  }
+
+ private:
+  Mutex mutex_;
+  std::deque<std::unique_ptr<Task>> tasks_;
+};
+
+void WorkerThreadsTaskRunner::PlatformWorkerThread(void* data) {
   std::unique_ptr<PlatformWorkerData>
       worker_data(static_cast<PlatformWorkerData*>(data));
 
-  TaskQueue<Task>* pending_worker_tasks = worker_data->task_queue;
+  WorkerThreadsTaskRunner* task_runner = worker_data->task_runner;
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
+  current_task_runner = task_runner;
+  current_queue_index = worker_data->id;
 
   // Notify the main thread that the platform worker is ready.
   {
@@ -39,18 +80,17 @@ static void PlatformWorkerThread(void* data) {
     worker_data->platform_workers_ready->Signal(lock);
   }
 
-  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop()) {
+  while (std::unique_ptr<Task> task =
+             task_runner->BlockingPop(worker_data->id)) {
     task->Run();
-    pending_worker_tasks->NotifyOfCompletion();
+    task_runner->NotifyOfCompletion();
   }
 }
 
-}  // namespace
-
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<Task>* tasks)
-    : pending_worker_tasks_(tasks) {}
+  explicit DelayedTaskScheduler(WorkerThreadsTaskRunner* task_runner)
+    : task_runner_(task_runner) {}
 
   std::unique_ptr<uv_thread_t> Start() {
     auto start_thread = [](void* data) {
@@ -76,6 +116,20 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   }
 
  private:
+  // Delayed tasks are kept in a min-heap ordered by their due time, and a
+  // single timer fires for the earliest one. Tasks with the same due time
+  // keep the order in which they were posted.
+  struct TimedTask {
+    uint64_t due_time;
+    uint64_t sequence;
+    std::unique_ptr<Task> task;
+  };
+
+  static bool RunsLater(const TimedTask& a, const TimedTask& b) {
+    if (a.due_time != b.due_time) return a.due_time > b.due_time;
+    return a.sequence > b.sequence;
+  }
+
   void Run() {
     TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                           "WorkerThreadsTaskRunner::DelayedTaskScheduler");
@@ -83,6 +137,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
     CHECK_EQ(0, uv_loop_init(&loop_));
     flush_tasks_.data = this;
     CHECK_EQ(0, uv_async_init(&loop_, &flush_tasks_, FlushTasks));
+    CHECK_EQ(0, uv_timer_init(&loop_, &timer_));
     uv_sem_post(&ready_);
 
     uv_run(&loop_, UV_RUN_DEFAULT);
@@ -101,11 +156,9 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
     explicit StopTask(DelayedTaskScheduler* scheduler): scheduler_(scheduler) {}
 
     void Run() override {
-      std::vector<uv_timer_t*> timers;
-      for (uv_timer_t* timer : scheduler_->timers_)
-        timers.push_back(timer);
-      for (uv_timer_t* timer : timers)
-        scheduler_->TakeTimerTask(timer);
+      scheduler_->timed_tasks_.clear();
+      uv_close(reinterpret_cast<uv_handle_t*>(&scheduler_->timer_),
+               [](uv_handle_t* handle) {});
       uv_close(reinterpret_cast<uv_handle_t*>(&scheduler_->flush_tasks_),
                [](uv_handle_t* handle) {});
     }
@@ -125,11 +178,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
 
     void Run() override {
       uint64_t delay_millis = llround(delay_in_seconds_ * 1000);
-      std::unique_ptr<uv_timer_t> timer(new uv_timer_t());
-      CHECK_EQ(0, uv_timer_init(&scheduler_->loop_, timer.get()));
-      timer->data = task_.release();
-      CHECK_EQ(0, uv_timer_start(timer.get(), RunTask, delay_millis, 0));
-      scheduler_->timers_.insert(timer.release());
+      scheduler_->Schedule(std::move(task_),
+                           uv_now(&scheduler_->loop_) + delay_millis);
     }
 
    private:
@@ -138,29 +188,49 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
     double delay_in_seconds_;
   };
 
-  static void RunTask(uv_timer_t* timer) {
+  void Schedule(std::unique_ptr<Task> task, uint64_t due_time) {
+    timed_tasks_.push_back({due_time, next_sequence_++, std::move(task)});
+    std::push_heap(timed_tasks_.begin(), timed_tasks_.end(), RunsLater);
+    // Only the earliest task decides when the timer has to fire.
+    if (timed_tasks_.front().sequence == next_sequence_ - 1)
+      RestartTimer();
+  }
+
+  static void RunDueTasks(uv_timer_t* timer) {
     DelayedTaskScheduler* scheduler =
-        ContainerOf(&DelayedTaskScheduler::loop_, timer->loop);
-    scheduler->pending_worker_tasks_->Push(scheduler->TakeTimerTask(timer));
+        ContainerOf(&DelayedTaskScheduler::timer_, timer);
+    std::vector<TimedTask>& timed_tasks = scheduler->timed_tasks_;
+    uint64_t now = uv_now(&scheduler->loop_);
+    while (!timed_tasks.empty() && timed_tasks.front().due_time <= now) {
+      std::pop_heap(timed_tasks.begin(), timed_tasks.end(), RunsLater);
+      scheduler->task_runner_->PostTask(std::move(timed_tasks.back().task));
+      timed_tasks.pop_back();
+    }
+    scheduler->RestartTimer();
   }
 
-  std::unique_ptr<Task> TakeTimerTask(uv_timer_t* timer) {
-    std::unique_ptr<Task> task(static_cast<Task*>(timer->data));
-    uv_timer_stop(timer);
-    uv_close(reinterpret_cast<uv_handle_t*>(timer), [](uv_handle_t* handle) {
-      delete reinterpret_cast<uv_timer_t*>(handle);
-    });
-    timers_.erase(timer);
-    return task;
+  void RestartTimer() {
+    if (timed_tasks_.empty()) {
+      uv_timer_stop(&timer_);
+      return;
+    }
+    uint64_t now = uv_now(&loop_);
+    uint64_t due_time = timed_tasks_.front().due_time;
+    CHECK_EQ(0, uv_timer_start(&timer_,
+                               RunDueTasks,
+                               due_time > now ? due_time - now : 0,
+                               0));
   }
 
   uv_sem_t ready_;
-  TaskQueue<Task>* pending_worker_tasks_;
+  WorkerThreadsTaskRunner* task_runner_;
 
   TaskQueue<Task> tasks_;
   uv_loop_t loop_;
   uv_async_t flush_tasks_;
-  std::unordered_set<uv_timer_t*> timers_;
+  uv_timer_t timer_;
+  std::vector<TimedTask> timed_tasks_;
+  uint64_t next_sequence_ = 0;
 };
 
 WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
@@ -170,13 +240,16 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
   Mutex::ScopedLock lock(platform_workers_mutex);
   int pending_platform_workers = thread_pool_size;
 
-  delayed_task_scheduler_ = std::make_unique<DelayedTaskScheduler>(
-      &pending_worker_tasks_);
+  // There is always at least one queue for PostTask() to put tasks into.
+  for (int i = 0; i < std::max(thread_pool_size, 1); i++)
+    queues_.emplace_back(new WorkerQueue());
+
+  delayed_task_scheduler_ = std::make_unique<DelayedTaskScheduler>(this);
   threads_.push_back(delayed_task_scheduler_->Start());
 
   for (int i = 0; i < thread_pool_size; i++) {
     PlatformWorkerData* worker_data = new PlatformWorkerData{
-      &pending_worker_tasks_, &platform_workers_mutex,
+      this, &platform_workers_mutex,
       &platform_workers_ready, &pending_platform_workers, i
     };
     std::unique_ptr<uv_thread_t> t { new uv_thread_t() };
@@ -194,8 +267,21 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
   }
 }
 
+WorkerThreadsTaskRunner::~WorkerThreadsTaskRunner() = default;
+
 void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task) {
-  pending_worker_tasks_.Push(std::move(task));
+  size_t index = current_task_runner == this ?
+      current_queue_index :
+      next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  outstanding_tasks_++;
+  queues_[index]->Push(std::move(task));
+  queued_tasks_++;
+  // Pairs with the increment of `sleeping_threads_` in BlockingPop(): either
+  // the sleeping thread sees the new task, or the task is seen here.
+  if (sleeping_threads_.load() > 0) {
+    Mutex::ScopedLock lock(idle_mutex_);
+    tasks_available_.Signal(lock);
+  }
 }
 
 void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<Task> task,
@@ -203,12 +289,48 @@ void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<Task> task,
   delayed_task_scheduler_->PostDelayedTask(std::move(task), delay_in_seconds);
 }
 
+std::unique_ptr<Task> WorkerThreadsTaskRunner::TryPop(size_t index) {
+  if (queued_tasks_.load() <= 0) return nullptr;
+  std::unique_ptr<Task> task = queues_[index]->PopFront();
+  for (size_t i = 1; task == nullptr && i < queues_.size(); i++)
+    task = queues_[(index + i) % queues_.size()]->PopBack();
+  if (task) queued_tasks_--;
+  return task;
+}
+
+std::unique_ptr<Task> WorkerThreadsTaskRunner::BlockingPop(size_t index) {
+  while (!stopped_.load()) {
+    if (std::unique_ptr<Task> task = TryPop(index))
+      return task;
+
+    Mutex::ScopedLock lock(idle_mutex_);
+    sleeping_threads_++;
+    while (queued_tasks_.load() <= 0 && !stopped_.load())
+      tasks_available_.Wait(lock);
+    sleeping_threads_--;
+  }
+  return nullptr;
+}
+
+void WorkerThreadsTaskRunner::NotifyOfCompletion() {
+  if (--outstanding_tasks_ == 0) {
+    Mutex::ScopedLock lock(drain_mutex_);
+    tasks_drained_.Broadcast(lock);
+  }
+}
+
 void WorkerThreadsTaskRunner::BlockingDrain() {
-  pending_worker_tasks_.BlockingDrain();
+  Mutex::ScopedLock lock(drain_mutex_);
+  while (outstanding_tasks_.load() > 0)
+    tasks_drained_.Wait(lock);
 }
 
 void WorkerThreadsTaskRunner::Shutdown() {
-  pending_worker_tasks_.Stop();
+  {
+    Mutex::ScopedLock lock(idle_mutex_);
+    stopped_ = true;
+    tasks_available_.Broadcast(lock);
+  }
   delayed_task_scheduler_->Stop();
   for (size_t i = 0; i < threads_.size(); i++) {
     CHECK_EQ(0, uv_thread_join(threads_[i].get()));
@@ -220,12 +342,22 @@ int WorkerThreadsTaskRunner::NumberOfWorkerThreads() const {
 }
 
 PerIsolatePlatformData::PerIsolatePlatformData(
-    Isolate* isolate, uv_loop_t* loop)
-  : isolate_(isolate), loop_(loop) {
+    Isolate* isolate, uv_loop_t* loop, double idle_task_time)
+  : isolate_(isolate), loop_(loop), idle_task_time_(idle_task_time) {
   flush_tasks_ = new uv_async_t();
   CHECK_EQ(0, uv_async_init(loop, flush_tasks_, FlushTasks));
   flush_tasks_->data = static_cast<void*>(this);
   uv_unref(reinterpret_cast<uv_handle_t*>(flush_tasks_));
+
+  if (idle_task_time_ > 0) {
+    // libuv runs prepare handles right before it polls for events.
+    run_idle_tasks_ = new uv_prepare_t();
+    CHECK_EQ(0, uv_prepare_init(loop, run_idle_tasks_));
+    run_idle_tasks_->data = static_cast<void*>(this);
+    CHECK_EQ(0, uv_prepare_start(run_idle_tasks_, RunIdleTasks));
+    uv_unref(reinterpret_cast<uv_handle_t*>(run_idle_tasks_));
+    uv_handle_count_++;
+  }
 }
 
 std::shared_ptr<v8::TaskRunner>
@@ -239,7 +371,57 @@ void PerIsolatePlatformData::FlushTasks(uv_async_t* handle) {
 }
 
 void PerIsolatePlatformData::PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
-  UNREACHABLE();
+  CHECK(IdleTasksEnabled());
+  if (run_idle_tasks_ == nullptr) {
+    // V8 may post tasks during Isolate disposal. In that case, the only
+    // sensible path forward is to discard the task.
+    return;
+  }
+  idle_tasks_.Push(std::move(task));
+}
+
+void PerIsolatePlatformData::RunIdleTasks(uv_prepare_t* handle) {
+  auto platform_data = static_cast<PerIsolatePlatformData*>(handle->data);
+  platform_data->RunIdleTasks();
+}
+
+void PerIsolatePlatformData::RunIdleTasks() {
+  // Only use the time that the loop would otherwise spend waiting.
+  int timeout = uv_backend_timeout(loop_);
+  if (timeout == 0)
+    return;
+
+  std::queue<std::unique_ptr<v8::IdleTask>> tasks = idle_tasks_.PopAll();
+  if (tasks.empty())
+    return;
+
+  double idle_time = idle_task_time_;
+  if (timeout > 0)
+    idle_time = std::min(idle_time, timeout / 1e3);
+  const double deadline = uv_hrtime() / 1e9 + idle_time;
+
+  DebugSealHandleScope scope(isolate_);
+  Environment* env = Environment::GetCurrent(isolate_);
+  while (!tasks.empty()) {
+    // The tasks that do not fit in are run the next time.
+    if (uv_hrtime() / 1e9 >= deadline) {
+      while (!tasks.empty()) {
+        idle_tasks_.Push(std::move(tasks.front()));
+        tasks.pop();
+      }
+      break;
+    }
+    std::unique_ptr<v8::IdleTask> task = std::move(tasks.front());
+    tasks.pop();
+    if (env != nullptr) {
+      v8::HandleScope scope(isolate_);
+      InternalCallbackScope cb_scope(env, Object::New(isolate_), { 0, 0 },
+                                     InternalCallbackScope::kNoFlags);
+      task->Run(deadline);
+    } else {
+      task->Run(deadline);
+    }
+  }
 }
 
 void PerIsolatePlatformData::PostTask(std::unique_ptr<Task> task) {
@@ -296,6 +478,7 @@ void PerIsolatePlatformData::Shutdown() {
   // effectively deleting the tasks instead of running them.
   foreground_delayed_tasks_.PopAll();
   foreground_tasks_.PopAll();
+  idle_tasks_.PopAll();
   scheduled_delayed_tasks_.clear();
 
   // Both destroying the scheduled_delayed_tasks_ lists and closing
@@ -310,9 +493,19 @@ void PerIsolatePlatformData::Shutdown() {
     PerIsolatePlatformData* platform_data =
         static_cast<PerIsolatePlatformData*>(flush_tasks->data);
     platform_data->DecreaseHandleCount();
-    platform_data->self_reference_.reset();
   });
   flush_tasks_ = nullptr;
+
+  if (run_idle_tasks_ != nullptr) {
+    uv_close(reinterpret_cast<uv_handle_t*>(run_idle_tasks_),
+             [](uv_handle_t* handle) {
+      std::unique_ptr<uv_prepare_t> run_idle_tasks {
+          reinterpret_cast<uv_prepare_t*>(handle) };
+      static_cast<PerIsolatePlatformData*>(run_idle_tasks->data)
+          ->DecreaseHandleCount();
+    });
+    run_idle_tasks_ = nullptr;
+  }
 }
 
 void PerIsolatePlatformData::DecreaseHandleCount() {
@@ -320,6 +513,9 @@ void PerIsolatePlatformData::DecreaseHandleCount() {
   if (--uv_handle_count_ == 0) {
     for (const auto& callback : shutdown_callbacks_)
       callback.cb(callback.data);
+    // All handles are closed, so this object is no longer needed by them.
+    // This may delete it.
+    self_reference_.reset();
   }
 }
 
@@ -345,7 +541,8 @@ NodePlatform::~NodePlatform() {
 
 void NodePlatform::RegisterIsolate(Isolate* isolate, uv_loop_t* loop) {
   Mutex::ScopedLock lock(per_isolate_mutex_);
-  auto delegate = std::make_shared<PerIsolatePlatformData>(isolate, loop);
+  auto delegate = std::make_shared<PerIsolatePlatformData>(isolate, loop,
+                                                           idle_task_time_);
   IsolatePlatformDelegate* ptr = delegate.get();
   auto insertion = per_isolate_.emplace(
     isolate,
@@ -528,6 +725,12 @@ NodePlatform::GetForegroundTaskRunner(Isolate* isolate) {
   return ForIsolate(isolate)->GetForegroundTaskRunner();
 }
 
+v8::PageAllocator* NodePlatform::GetPageAllocator() {
+  // This is nullptr, i.e. the default allocator of V8, unless
+  // --use-largepages-for-heap is in effect.
+  return GetLargePageAllocator();
+}
+
 double NodePlatform::MonotonicallyIncreasingTime() {
   // Convert nanos to seconds.
   return uv_hrtime() / 1e9;
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -55,7 +56,9 @@ class PerIsolatePlatformData :
     public v8::TaskRunner,
     public std::enable_shared_from_this<PerIsolatePlatformData> {
  public:
-  PerIsolatePlatformData(v8::Isolate* isolate, uv_loop_t* loop);
+  PerIsolatePlatformData(v8::Isolate* isolate,
+                         uv_loop_t* loop,
+                         double idle_task_time = 0);
   ~PerIsolatePlatformData() override;
 
   std::shared_ptr<v8::TaskRunner> GetForegroundTaskRunner() override;
@@ -63,7 +66,7 @@ class PerIsolatePlatformData :
   void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override;
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds) override;
-  bool IdleTasksEnabled() override { return false; }
+  bool IdleTasksEnabled() override { return idle_task_time_ > 0; }
 
   // Non-nestable tasks are treated like regular tasks.
   bool NonNestableTasksEnabled() const override { return true; }
@@ -89,6 +92,8 @@ class PerIsolatePlatformData :
   static void FlushTasks(uv_async_t* handle);
   void RunForegroundTask(std::unique_ptr<v8::Task> task);
   static void RunForegroundTask(uv_timer_t* timer);
+  static void RunIdleTasks(uv_prepare_t* handle);
+  void RunIdleTasks();
 
   struct ShutdownCallback {
     void (*cb)(void*);
@@ -106,6 +111,13 @@ class PerIsolatePlatformData :
   TaskQueue<v8::Task> foreground_tasks_;
   TaskQueue<DelayedTask> foreground_delayed_tasks_;
 
+  // Idle tasks are run when the event loop is about to wait for events, for
+  // at most `idle_task_time_` seconds, and never for longer than it would
+  // wait. They are disabled if it is 0.
+  const double idle_task_time_;
+  uv_prepare_t* run_idle_tasks_ = nullptr;
+  TaskQueue<v8::IdleTask> idle_tasks_;
+
   // Use a custom deleter because libuv needs to close the handle first.
   typedef std::unique_ptr<DelayedTask, void(*)(DelayedTask*)>
       DelayedTaskPointer;
@@ -113,9 +125,13 @@ class PerIsolatePlatformData :
 };
 
 // This acts as the single worker thread task runner for all Isolates.
+// Every platform worker thread has a queue of its own. Tasks posted from a
+// platform worker thread go to its own queue, other ones are spread over all
+// queues, and threads whose queue is empty steal tasks from the other ones.
 class WorkerThreadsTaskRunner {
  public:
   explicit WorkerThreadsTaskRunner(int thread_pool_size);
+  ~WorkerThreadsTaskRunner();
 
   void PostTask(std::unique_ptr<v8::Task> task);
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
@@ -127,7 +143,29 @@ class WorkerThreadsTaskRunner {
   int NumberOfWorkerThreads() const;
 
  private:
-  TaskQueue<v8::Task> pending_worker_tasks_;
+  class WorkerQueue;
+
+  static void PlatformWorkerThread(void* data);
+  // Returns the next task for the thread that owns `queues_[index]`, or
+  // nullptr once the runner has been stopped.
+  std::unique_ptr<v8::Task> BlockingPop(size_t index);
+  std::unique_ptr<v8::Task> TryPop(size_t index);
+  void NotifyOfCompletion();
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::atomic<size_t> next_queue_ {0};
+  // The number of tasks that are in the queues, and the number of tasks that
+  // have been posted but have not finished running yet.
+  std::atomic<int64_t> queued_tasks_ {0};
+  std::atomic<int64_t> outstanding_tasks_ {0};
+  // Threads that have run out of tasks sleep on `tasks_available_`, which is
+  // only signalled when there are sleeping threads.
+  std::atomic<int> sleeping_threads_ {0};
+  std::atomic<bool> stopped_ {false};
+  Mutex idle_mutex_;
+  ConditionVariable tasks_available_;
+  Mutex drain_mutex_;
+  ConditionVariable tasks_drained_;
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
@@ -144,6 +182,10 @@ class NodePlatform : public MultiIsolatePlatform {
   void DrainTasks(v8::Isolate* isolate) override;
   void Shutdown();
 
+  // Enables idle tasks for the Isolates registered with a loop from now on.
+  // See PerIsolatePlatformData.
+  void set_idle_task_time(double seconds) { idle_task_time_ = seconds; }
+
   // v8::Platform implementation.
   int NumberOfWorkerThreads() override;
   void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override;
@@ -170,6 +212,7 @@ class NodePlatform : public MultiIsolatePlatform {
       v8::Isolate* isolate) override;
 
   Platform::StackTracePrinter GetStackTracePrinter() override;
+  v8::PageAllocator* GetPageAllocator() override;
 
  private:
   IsolatePlatformDelegate* ForIsolate(v8::Isolate* isolate);
@@ -182,6 +225,7 @@ class NodePlatform : public MultiIsolatePlatform {
 
   v8::TracingController* tracing_controller_;
   std::shared_ptr<WorkerThreadsTaskRunner> worker_thread_task_runner_;
+  double idle_task_time_ = 0;
   bool has_shut_down_ = false;
 };
 
@@ -1,6 +1,7 @@
 #include "base_object-inl.h"
 #include "debug_utils-inl.h"
 #include "env-inl.h"
+#include "large_pages/node_large_page.h"
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_errors.h"
@@ -183,34 +184,58 @@ static void Rss(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(static_cast<double>(rss));
 }
 
-static void MemoryUsage(const FunctionCallbackInfo<Value>& args) {
+static void ArrayBufferPoolStatistics(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
-
   Isolate* isolate = env->isolate();
-  // V8 memory usage
-  HeapStatistics v8_heap_stats;
-  isolate->GetHeapStatistics(&v8_heap_stats);
-
-  NodeArrayBufferAllocator* array_buffer_allocator =
-      env->isolate_data()->node_allocator();
+  Local<Context> context = env->context();
+  if (!per_process::cli_options->pool_array_buffers ||
+      per_process::cli_options->debug_arraybuffer_allocations) {
+    return;
+  }
 
-  // Get the double array pointer from the Float64Array argument.
-  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 5);
-  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
+  std::vector<PoolingArrayBufferAllocator::SizeClassStatistics> statistics =
+      PoolingArrayBufferAllocator::GetStatistics();
+  std::vector<Local<Value>> result;
+  result.reserve(statistics.size());
+  auto set = [&](Local<Object> target, const char* name, double value) {
+    return target->Set(context,
+                       OneByteString(isolate, name),
+                       Number::New(isolate, value)).IsJust();
+  };
+  for (const auto& size_class : statistics) {
+    Local<Object> entry = Object::New(isolate);
+    if (!set(entry, "size", size_class.size) ||
+        !set(entry, "allocations", size_class.allocations) ||
+        !set(entry, "reused", size_class.reused) ||
+        !set(entry, "cached", size_class.cached)) {
+      return;
+    }
+    result.push_back(entry);
+  }
+  args.GetReturnValue().Set(
+      Array::New(isolate, result.data(), result.size()));
+}
 
-  size_t rss;
-  int err = uv_resident_set_memory(&rss);
-  if (err)
-    return env->ThrowUVException(err, "uv_resident_set_memory");
+static void GetLargePagesUsage(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  LargePagesStatistics statistics;
+  if (!GetLargePagesStatistics(&statistics))
+    return;
 
-  fields[0] = static_cast<double>(rss);
-  fields[1] = static_cast<double>(v8_heap_stats.total_heap_size());
-  fields[2] = static_cast<double>(v8_heap_stats.used_heap_size());
-  fields[3] = static_cast<double>(v8_heap_stats.external_memory());
-  fields[4] =
-      array_buffer_allocator == nullptr
-          ? 0
-          : static_cast<double>(array_buffer_allocator->total_mem_usage());
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, double value) {
+    return result->Set(context,
+                       OneByteString(isolate, name),
+                       Number::New(isolate, value)).IsJust();
+  };
+  if (!set("heap", statistics.heap) ||
+      !set("arrayBuffers", statistics.array_buffers) ||
+      !set("anonHugePages", statistics.anonymous_huge_pages)) {
+    return;
+  }
+  args.GetReturnValue().Set(result);
 }
 
 void RawDebug(const FunctionCallbackInfo<Value>& args) {
@@ -280,33 +305,39 @@ void GetActiveHandles(const FunctionCallbackInfo<Value>& args) {
       Array::New(env->isolate(), handle_v.data(), handle_v.size()));
 }
 
-static void ResourceUsage(const FunctionCallbackInfo<Value>& args) {
+// Returns the counters of every ThreadPoolWork class of this Environment.
+static void ThreadPoolUsage(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
-
-  uv_rusage_t rusage;
-  int err = uv_getrusage(&rusage);
-  if (err)
-    return env->ThrowUVException(err, "uv_getrusage");
-
-  Local<ArrayBuffer> ab = get_fields_array_buffer(args, 0, 16);
-  double* fields = static_cast<double*>(ab->GetBackingStore()->Data());
-
-  fields[0] = MICROS_PER_SEC * rusage.ru_utime.tv_sec + rusage.ru_utime.tv_usec;
-  fields[1] = MICROS_PER_SEC * rusage.ru_stime.tv_sec + rusage.ru_stime.tv_usec;
-  fields[2] = static_cast<double>(rusage.ru_maxrss);
-  fields[3] = static_cast<double>(rusage.ru_ixrss);
-  fields[4] = static_cast<double>(rusage.ru_idrss);
-  fields[5] = static_cast<double>(rusage.ru_isrss);
-  fields[6] = static_cast<double>(rusage.ru_minflt);
-  fields[7] = static_cast<double>(rusage.ru_majflt);
-  fields[8] = static_cast<double>(rusage.ru_nswap);
-  fields[9] = static_cast<double>(rusage.ru_inblock);
-  fields[10] = static_cast<double>(rusage.ru_oublock);
-  fields[11] = static_cast<double>(rusage.ru_msgsnd);
-  fields[12] = static_cast<double>(rusage.ru_msgrcv);
-  fields[13] = static_cast<double>(rusage.ru_nsignals);
-  fields[14] = static_cast<double>(rusage.ru_nvcsw);
-  fields[15] = static_cast<double>(rusage.ru_nivcsw);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  const std::vector<uint32_t>& limits =
+      per_process::cli_options->threadpool_work_limits;
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](Local<Object> target, const char* name, double value) {
+    return target->Set(context,
+                       OneByteString(isolate, name),
+                       Number::New(isolate, value)).IsJust();
+  };
+#define V(work_class, name)                                                   \
+  {                                                                           \
+    size_t index = static_cast<size_t>(ThreadPoolWorkClass::work_class);      \
+    ThreadPoolWorkClassState* state =                                         \
+        env->threadpool_work_class_state(ThreadPoolWorkClass::work_class);    \
+    Local<Object> usage = Object::New(isolate);                               \
+    if (!set(usage, "limit", index < limits.size() ? limits[index] : 0) ||    \
+        !set(usage, "scheduled", state->scheduled) ||                        \
+        !set(usage, "queued", state->pending.size()) ||                       \
+        !set(usage, "running", state->running) ||                             \
+        !set(usage, "completed", state->completed) ||                         \
+        result->Set(context, OneByteString(isolate, name), usage)            \
+            .IsNothing()) {                                                   \
+      return;                                                                 \
+    }                                                                         \
+  }
+  THREADPOOL_WORK_CLASSES(V)
+#undef V
+  args.GetReturnValue().Set(result);
 }
 
 #ifdef __POSIX__
@@ -527,6 +558,185 @@ class FastHrtime : public BaseObject {
   std::shared_ptr<BackingStore> backing_store_;
 };
 
+// Fills the values of process.memoryUsage() and process.resourceUsage() into
+// a shared buffer, so that metrics that are collected often do not have to
+// pass an array to C++ on every call. The resident set size, which has to be
+// read from the system, is optionally taken from a cache.
+class FastUsage : public BaseObject {
+ public:
+  enum Fields {
+    kRss,
+    kHeapTotal,
+    kHeapUsed,
+    kExternal,
+    kArrayBuffers,
+    // 0 or the libuv error code of the last memoryUsage() or resourceUsage()
+    // call, since fast API calls can not return values or throw.
+    kStatus,
+    kResourceUsage,
+    kFieldsCount = kResourceUsage + 16
+  };
+
+  static Local<Object> New(Environment* env) {
+    Local<FunctionTemplate> ctor = FunctionTemplate::New(env->isolate());
+    ctor->Inherit(BaseObject::GetConstructorTemplate(env));
+    Local<ObjectTemplate> otmpl = ctor->InstanceTemplate();
+    otmpl->SetInternalFieldCount(FastUsage::kInternalFieldCount);
+
+    auto create_func = [env](auto fast_func, auto slow_func) {
+      auto cfunc = CFunction::Make(fast_func);
+      return FunctionTemplate::New(env->isolate(),
+                                   slow_func,
+                                   Local<Value>(),
+                                   Local<Signature>(),
+                                   0,
+                                   ConstructorBehavior::kThrow,
+                                   SideEffectType::kHasNoSideEffect,
+                                   &cfunc);
+    };
+
+    otmpl->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "memoryUsage"),
+               create_func(FastMemoryUsage, SlowMemoryUsage));
+    otmpl->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "heapUsage"),
+               create_func(FastHeapUsage, SlowHeapUsage));
+    otmpl->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "resourceUsage"),
+               create_func(FastResourceUsage, SlowResourceUsage));
+
+    Local<Object> obj = otmpl->NewInstance(env->context()).ToLocalChecked();
+
+    Local<ArrayBuffer> ab =
+        ArrayBuffer::New(env->isolate(), sizeof(double) * kFieldsCount);
+    new FastUsage(env, obj, ab);
+    obj->Set(
+           env->context(), FIXED_ONE_BYTE_STRING(env->isolate(), "buffer"), ab)
+        .ToChecked();
+
+    return obj;
+  }
+
+ private:
+  FastUsage(Environment* env,
+            Local<Object> object,
+            Local<ArrayBuffer> ab)
+      : BaseObject(env, object),
+        array_buffer_(env->isolate(), ab),
+        backing_store_(ab->GetBackingStore()) {
+    MakeWeak();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("array_buffer", array_buffer_);
+  }
+  SET_MEMORY_INFO_NAME(FastUsage)
+  SET_SELF_SIZE(FastUsage)
+
+  static FastUsage* FromV8ApiObject(ApiObject api_object) {
+    Object* v8_object = reinterpret_cast<Object*>(&api_object);
+    return static_cast<FastUsage*>(
+        v8_object->GetAlignedPointerFromInternalField(BaseObject::kSlot));
+  }
+
+  double* fields() const {
+    return static_cast<double*>(backing_store_->Data());
+  }
+
+  static void HeapUsageImpl(FastUsage* receiver) {
+    Environment* env = receiver->env();
+    HeapStatistics v8_heap_stats;
+    env->isolate()->GetHeapStatistics(&v8_heap_stats);
+    NodeArrayBufferAllocator* array_buffer_allocator =
+        env->isolate_data()->node_allocator();
+
+    double* fields = receiver->fields();
+    fields[kHeapTotal] = static_cast<double>(v8_heap_stats.total_heap_size());
+    fields[kHeapUsed] = static_cast<double>(v8_heap_stats.used_heap_size());
+    fields[kExternal] = static_cast<double>(v8_heap_stats.external_memory());
+    fields[kArrayBuffers] =
+        array_buffer_allocator == nullptr
+            ? 0
+            : static_cast<double>(array_buffer_allocator->total_mem_usage());
+  }
+
+  static void FastHeapUsage(ApiObject receiver) {
+    HeapUsageImpl(FromV8ApiObject(receiver));
+  }
+
+  static void SlowHeapUsage(const FunctionCallbackInfo<Value>& args) {
+    HeapUsageImpl(FromJSObject<FastUsage>(args.Holder()));
+  }
+
+  // Reads the resident set size only if the cached value is older than
+  // `max_rss_age` milliseconds.
+  static void MemoryUsageImpl(FastUsage* receiver, double max_rss_age) {
+    double* fields = receiver->fields();
+    const uint64_t now = uv_hrtime();
+    if (receiver->rss_time_ == 0 ||
+        now - receiver->rss_time_ >= max_rss_age * 1e6) {
+      size_t rss;
+      int err = uv_resident_set_memory(&rss);
+      fields[kStatus] = err;
+      if (err)
+        return;
+      receiver->rss_ = rss;
+      receiver->rss_time_ = now;
+    }
+    fields[kStatus] = 0;
+    fields[kRss] = static_cast<double>(receiver->rss_);
+    HeapUsageImpl(receiver);
+  }
+
+  static void FastMemoryUsage(ApiObject receiver, double max_rss_age) {
+    MemoryUsageImpl(FromV8ApiObject(receiver), max_rss_age);
+  }
+
+  static void SlowMemoryUsage(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args[0]->IsNumber());
+    MemoryUsageImpl(FromJSObject<FastUsage>(args.Holder()),
+                    args[0].As<Number>()->Value());
+  }
+
+  static void ResourceUsageImpl(FastUsage* receiver) {
+    uv_rusage_t rusage;
+    int err = uv_getrusage(&rusage);
+    receiver->fields()[kStatus] = err;
+    if (err)
+      return;
+
+    double* fields = receiver->fields() + kResourceUsage;
+    fields[0] =
+        MICROS_PER_SEC * rusage.ru_utime.tv_sec + rusage.ru_utime.tv_usec;
+    fields[1] =
+        MICROS_PER_SEC * rusage.ru_stime.tv_sec + rusage.ru_stime.tv_usec;
+    fields[2] = static_cast<double>(rusage.ru_maxrss);
+    fields[3] = static_cast<double>(rusage.ru_ixrss);
+    fields[4] = static_cast<double>(rusage.ru_idrss);
+    fields[5] = static_cast<double>(rusage.ru_isrss);
+    fields[6] = static_cast<double>(rusage.ru_minflt);
+    fields[7] = static_cast<double>(rusage.ru_majflt);
+    fields[8] = static_cast<double>(rusage.ru_nswap);
+    fields[9] = static_cast<double>(rusage.ru_inblock);
+    fields[10] = static_cast<double>(rusage.ru_oublock);
+    fields[11] = static_cast<double>(rusage.ru_msgsnd);
+    fields[12] = static_cast<double>(rusage.ru_msgrcv);
+    fields[13] = static_cast<double>(rusage.ru_nsignals);
+    fields[14] = static_cast<double>(rusage.ru_nvcsw);
+    fields[15] = static_cast<double>(rusage.ru_nivcsw);
+  }
+
+  static void FastResourceUsage(ApiObject receiver) {
+    ResourceUsageImpl(FromV8ApiObject(receiver));
+  }
+
+  static void SlowResourceUsage(const FunctionCallbackInfo<Value>& args) {
+    ResourceUsageImpl(FromJSObject<FastUsage>(args.Holder()));
+  }
+
+  Global<ArrayBuffer> array_buffer_;
+  std::shared_ptr<BackingStore> backing_store_;
+  size_t rss_ = 0;
+  uint64_t rss_time_ = 0;
+};
+
 static void GetFastAPIs(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Local<Object> ret = Object::New(env->isolate());
@@ -534,6 +744,10 @@ static void GetFastAPIs(const FunctionCallbackInfo<Value>& args) {
            FIXED_ONE_BYTE_STRING(env->isolate(), "hrtime"),
            FastHrtime::New(env))
       .ToChecked();
+  ret->Set(env->context(),
+           FIXED_ONE_BYTE_STRING(env->isolate(), "usage"),
+           FastUsage::New(env))
+      .ToChecked();
   args.GetReturnValue().Set(ret);
 }
 
@@ -554,10 +768,12 @@ static void InitializeProcessMethods(Local<Object> target,
 
   env->SetMethod(target, "umask", Umask);
   env->SetMethod(target, "_rawDebug", RawDebug);
-  env->SetMethod(target, "memoryUsage", MemoryUsage);
   env->SetMethod(target, "rss", Rss);
+  env->SetMethod(target, "arrayBufferPoolStatistics",
+                 ArrayBufferPoolStatistics);
+  env->SetMethod(target, "largePagesStatistics", GetLargePagesUsage);
   env->SetMethod(target, "cpuUsage", CPUUsage);
-  env->SetMethod(target, "resourceUsage", ResourceUsage);
+  env->SetMethod(target, "threadpoolUsage", ThreadPoolUsage);
 
   env->SetMethod(target, "_getActiveRequests", GetActiveRequests);
   env->SetMethod(target, "_getActiveHandles", GetActiveHandles);
@@ -581,10 +797,11 @@ void RegisterProcessMethodsExternalReferences(
 
   registry->Register(Umask);
   registry->Register(RawDebug);
-  registry->Register(MemoryUsage);
   registry->Register(Rss);
+  registry->Register(ArrayBufferPoolStatistics);
+  registry->Register(GetLargePagesUsage);
   registry->Register(CPUUsage);
-  registry->Register(ResourceUsage);
+  registry->Register(ThreadPoolUsage);
 
   registry->Register(GetActiveRequests);
   registry->Register(GetActiveHandles);
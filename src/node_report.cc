@@ -7,6 +7,7 @@
 #include "node_metadata.h"
 #include "node_mutex.h"
 #include "node_worker.h"
+#include "threadpoolwork-inl.h"
 #include "util.h"
 
 #ifdef _WIN32
@@ -17,11 +18,13 @@
 #include <dlfcn.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <ctime>
 #include <cwctype>
 #include <fstream>
+#include <sstream>
 
 constexpr int NODE_REPORT_VERSION = 2;
 constexpr int NANOS_PER_SEC = 1000 * 1000 * 1000;
@@ -37,13 +40,17 @@ using node::Mutex;
 using node::NativeSymbolDebuggingContext;
 using node::TIME_TYPE;
 using node::worker::Worker;
+using node::InternalCallbackScope;
 using v8::Array;
 using v8::Context;
+using v8::Global;
+using v8::HandleScope;
 using v8::HeapSpaceStatistics;
 using v8::HeapStatistics;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
+using v8::Promise;
 using v8::String;
 using v8::TryCatch;
 using v8::V8;
@@ -51,6 +58,23 @@ using v8::Value;
 
 namespace per_process = node::per_process;
 
+// The sections that are left out of the report, from --report-exclude.
+using ExcludedSections = std::vector<std::string>;
+
+// The facts about the event that the header of a report describes. They are
+// taken when the report is triggered, even if it is written later.
+struct ReportHeader {
+  std::string event;
+  std::string trigger;
+  std::string filename;
+  TIME_TYPE tm_struct;
+  bool has_timestamp;
+  uv_timeval64_t timestamp;
+  uv_pid_t pid;
+  bool has_thread_id;
+  uint64_t thread_id;
+};
+
 // Internal/static function declarations
 static void WriteNodeReport(Isolate* isolate,
                             Environment* env,
@@ -60,7 +84,29 @@ static void WriteNodeReport(Isolate* isolate,
                             std::ostream& out,
                             Local<Object> error,
                             bool compact);
-static void PrintVersionInformation(JSONWriter* writer);
+static std::string GetReportFilename(Environment* env,
+                                     const std::string& name);
+static std::ostream* OpenReportStream(const std::string& filename,
+                                      std::ofstream* outfile);
+static void CloseReportStream(const std::string& filename,
+                              std::ofstream* outfile);
+static ExcludedSections GetExcludedSections();
+static bool IsExcluded(const ExcludedSections& excluded, const char* section);
+static ReportHeader GetReportHeader(Environment* env,
+                                    const char* message,
+                                    const char* trigger,
+                                    const std::string& filename);
+static void PrintHeader(JSONWriter* writer,
+                        const ReportHeader& header,
+                        const ExcludedSections& excluded);
+static void PrintEnvironmentSections(JSONWriter* writer,
+                                     Isolate* isolate,
+                                     Environment* env,
+                                     Local<Object> error,
+                                     const char* trigger,
+                                     const ExcludedSections& excluded);
+static void PrintVersionInformation(JSONWriter* writer,
+                                    const ExcludedSections& excluded);
 static void PrintJavaScriptErrorStack(JSONWriter* writer,
                                       Isolate* isolate,
                                       Local<Object> error,
@@ -71,99 +117,208 @@ static void PrintJavaScriptErrorProperties(JSONWriter* writer,
 static void PrintNativeStack(JSONWriter* writer);
 static void PrintResourceUsage(JSONWriter* writer);
 static void PrintGCStatistics(JSONWriter* writer, Isolate* isolate);
-static void PrintSystemInformation(JSONWriter* writer);
+static void PrintSystemInformation(JSONWriter* writer,
+                                   const ExcludedSections& excluded);
 static void PrintLoadedLibraries(JSONWriter* writer);
 static void PrintComponentVersions(JSONWriter* writer);
 static void PrintRelease(JSONWriter* writer);
 static void PrintCpuInfo(JSONWriter* writer);
 static void PrintNetworkInterfaceInfo(JSONWriter* writer);
 
-// External function to trigger a report, writing to file.
-std::string TriggerNodeReport(Isolate* isolate,
-                              Environment* env,
-                              const char* message,
-                              const char* trigger,
-                              const std::string& name,
-                              Local<Object> error) {
-  std::string filename;
-
-  // Determine the required report filename. In order of priority:
-  //   1) supplied on API 2) configured on startup 3) default generated
-  if (!name.empty()) {
-    // Filename was specified as API parameter.
-    filename = name;
-  } else {
-    std::string report_filename;
-    {
-      Mutex::ScopedLock lock(per_process::cli_options_mutex);
-      report_filename = per_process::cli_options->report_filename;
-    }
-    if (report_filename.length() > 0) {
-      // File name was supplied via start-up option.
-      filename = report_filename;
-    } else {
-      filename = *DiagnosticFilename(env != nullptr ? env->thread_id() : 0,
-          "report", "json");
+namespace {
+
+// Writes a report from the threadpool. Only the sections that need the
+// Environment are written on its thread, into a fragment that is copied into
+// the report. Everything else, including the file I/O, is done here.
+class ReportWriteWork : public node::ThreadPoolWork {
+ public:
+  ReportWriteWork(Environment* env,
+                  Local<Promise::Resolver> resolver,
+                  ReportHeader&& header,
+                  ExcludedSections&& excluded,
+                  std::string&& environment_sections,
+                  bool compact)
+      : ThreadPoolWork(env),
+        resolver_(env->isolate(), resolver),
+        header_(std::move(header)),
+        excluded_(std::move(excluded)),
+        environment_sections_(std::move(environment_sections)),
+        compact_(compact) {}
+
+  void DoThreadPoolWork() override {
+    std::ofstream outfile;
+    std::ostream* out = OpenReportStream(header_.filename, &outfile);
+    if (out == nullptr) {
+      header_.filename = "";
+      return;
     }
+    std::ios old_state(nullptr);
+    old_state.copyfmt(*out);
+    JSONWriter writer(*out, compact_);
+    writer.json_start();
+    PrintHeader(&writer, header_, excluded_);
+    writer.json_fragment(environment_sections_);
+    PrintSystemInformation(&writer, excluded_);
+    writer.json_objectend();
+    out->copyfmt(old_state);
+    CloseReportStream(header_.filename, &outfile);
   }
 
-  // Open the report file stream for writing. Supports stdout/err,
-  // user-specified or (default) generated name
-  std::ofstream outfile;
-  std::ostream* outstream;
-  if (filename == "stdout") {
-    outstream = &std::cout;
-  } else if (filename == "stderr") {
-    outstream = &std::cerr;
-  } else {
-    std::string report_directory;
-    {
-      Mutex::ScopedLock lock(per_process::cli_options_mutex);
-      report_directory = per_process::cli_options->report_directory;
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReportWriteWork> self(this);
+    if (status == UV_ECANCELED)
+      return;
+    Isolate* isolate = env()->isolate();
+    HandleScope handle_scope(isolate);
+    Context::Scope context_scope(env()->context());
+    InternalCallbackScope callback_scope(
+        env(), Object::New(isolate), {0, 0});
+    Local<String> filename;
+    if (String::NewFromUtf8(isolate, header_.filename.c_str())
+            .ToLocal(&filename)) {
+      resolver_.Get(isolate)->Resolve(env()->context(), filename).Check();
     }
-    // Regular file. Append filename to directory path if one was specified
-    if (report_directory.length() > 0) {
-      std::string pathname = report_directory;
-      pathname += node::kPathSeparator;
-      pathname += filename;
-      outfile.open(pathname, std::ios::out | std::ios::binary);
-    } else {
-      outfile.open(filename, std::ios::out | std::ios::binary);
-    }
-    // Check for errors on the file open
-    if (!outfile.is_open()) {
-      std::cerr << "\nFailed to open Node.js report file: " << filename;
+  }
 
-      if (report_directory.length() > 0)
-        std::cerr << " directory: " << report_directory;
+ private:
+  Global<Promise::Resolver> resolver_;
+  ReportHeader header_;
+  ExcludedSections excluded_;
+  std::string environment_sections_;
+  bool compact_;
+};
 
-      std::cerr << " (errno: " << errno << ")" << std::endl;
-      return "";
-    }
-    outstream = &outfile;
-    std::cerr << "\nWriting Node.js report to file: " << filename;
+}  // anonymous namespace
+
+// Determine the required report filename. In order of priority:
+//   1) supplied on API 2) configured on startup 3) default generated
+static std::string GetReportFilename(Environment* env,
+                                     const std::string& name) {
+  if (!name.empty()) {
+    // Filename was specified as API parameter.
+    return name;
+  }
+  std::string report_filename;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    report_filename = per_process::cli_options->report_filename;
+  }
+  if (report_filename.length() > 0) {
+    // File name was supplied via start-up option.
+    return report_filename;
   }
+  return *DiagnosticFilename(env != nullptr ? env->thread_id() : 0,
+                             "report", "json");
+}
 
-  bool compact;
+// Open the report file stream for writing. Supports stdout/err,
+// user-specified or (default) generated name. Returns nullptr if the file
+// could not be opened.
+static std::ostream* OpenReportStream(const std::string& filename,
+                                      std::ofstream* outfile) {
+  if (filename == "stdout")
+    return &std::cout;
+  if (filename == "stderr")
+    return &std::cerr;
+
+  std::string report_directory;
   {
     Mutex::ScopedLock lock(per_process::cli_options_mutex);
-    compact = per_process::cli_options->report_compact;
+    report_directory = per_process::cli_options->report_directory;
   }
-  WriteNodeReport(isolate, env, message, trigger, filename, *outstream,
-                  error, compact);
+  // Regular file. Append filename to directory path if one was specified
+  if (report_directory.length() > 0) {
+    std::string pathname = report_directory;
+    pathname += node::kPathSeparator;
+    pathname += filename;
+    outfile->open(pathname, std::ios::out | std::ios::binary);
+  } else {
+    outfile->open(filename, std::ios::out | std::ios::binary);
+  }
+  // Check for errors on the file open
+  if (!outfile->is_open()) {
+    std::cerr << "\nFailed to open Node.js report file: " << filename;
+
+    if (report_directory.length() > 0)
+      std::cerr << " directory: " << report_directory;
 
+    std::cerr << " (errno: " << errno << ")" << std::endl;
+    return nullptr;
+  }
+  std::cerr << "\nWriting Node.js report to file: " << filename;
+  return outfile;
+}
+
+static void CloseReportStream(const std::string& filename,
+                              std::ofstream* outfile) {
   // Do not close stdout/stderr, only close files we opened.
-  if (outfile.is_open()) {
-    outfile.close();
+  if (outfile->is_open()) {
+    outfile->close();
   }
 
   // Do not mix JSON and free-form text on stderr.
   if (filename != "stderr") {
     std::cerr << "\nNode.js report completed" << std::endl;
   }
+}
+
+// External function to trigger a report, writing to file.
+std::string TriggerNodeReport(Isolate* isolate,
+                              Environment* env,
+                              const char* message,
+                              const char* trigger,
+                              const std::string& name,
+                              Local<Object> error) {
+  std::string filename = GetReportFilename(env, name);
+  std::ofstream outfile;
+  std::ostream* outstream = OpenReportStream(filename, &outfile);
+  if (outstream == nullptr)
+    return "";
+
+  bool compact;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    compact = per_process::cli_options->report_compact;
+  }
+  WriteNodeReport(isolate, env, message, trigger, filename, *outstream,
+                  error, compact);
+
+  CloseReportStream(filename, &outfile);
   return filename;
 }
 
+// External function to trigger a report that is written to a file from the
+// threadpool. The promise is resolved with the filename once it is written.
+void TriggerNodeReportAsync(Environment* env,
+                            const char* message,
+                            const char* trigger,
+                            const std::string& name,
+                            Local<Object> error,
+                            Local<Promise::Resolver> resolver) {
+  std::string filename = GetReportFilename(env, name);
+  ReportHeader header = GetReportHeader(env, message, trigger, filename);
+  ExcludedSections excluded = GetExcludedSections();
+  bool compact;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    compact = per_process::cli_options->report_compact;
+  }
+
+  // The fragment continues the top-level object after the header.
+  std::ostringstream environment_sections;
+  JSONWriter writer(environment_sections, compact, 1);
+  PrintEnvironmentSections(
+      &writer, env->isolate(), env, error, trigger, excluded);
+
+  auto work = new ReportWriteWork(env,
+                                  resolver,
+                                  std::move(header),
+                                  std::move(excluded),
+                                  environment_sections.str(),
+                                  compact);
+  work->ScheduleWork();
+}
+
 // External function to trigger a report, writing to a supplied stream.
 void GetNodeReport(Isolate* isolate,
                    Environment* env,
@@ -184,10 +339,8 @@ static void WriteNodeReport(Isolate* isolate,
                             std::ostream& out,
                             Local<Object> error,
                             bool compact) {
-  // Obtain the current time and the pid.
-  TIME_TYPE tm_struct;
-  DiagnosticFilename::LocalTime(&tm_struct);
-  uv_pid_t pid = uv_os_getpid();
+  ReportHeader header = GetReportHeader(env, message, trigger, filename);
+  ExcludedSections excluded = GetExcludedSections();
 
   // Save formatting for output stream.
   std::ios old_state(nullptr);
@@ -198,14 +351,65 @@ static void WriteNodeReport(Isolate* isolate,
 
   JSONWriter writer(out, compact);
   writer.json_start();
-  writer.json_objectstart("header");
-  writer.json_keyvalue("reportVersion", NODE_REPORT_VERSION);
-  writer.json_keyvalue("event", message);
-  writer.json_keyvalue("trigger", trigger);
-  if (!filename.empty())
-    writer.json_keyvalue("filename", filename);
+  PrintHeader(&writer, header, excluded);
+  PrintEnvironmentSections(&writer, isolate, env, error, trigger, excluded);
+
+  // Report operating system information
+  PrintSystemInformation(&writer, excluded);
+
+  writer.json_objectend();
+
+  // Restore output stream formatting.
+  out.copyfmt(old_state);
+}
+
+static ExcludedSections GetExcludedSections() {
+  std::string report_exclude;
+  {
+    Mutex::ScopedLock lock(per_process::cli_options_mutex);
+    report_exclude = per_process::cli_options->report_exclude;
+  }
+  ExcludedSections excluded;
+  std::istringstream sections(report_exclude);
+  std::string section;
+  while (std::getline(sections, section, ','))
+    excluded.push_back(section);
+  return excluded;
+}
+
+static bool IsExcluded(const ExcludedSections& excluded, const char* section) {
+  return std::find(excluded.begin(), excluded.end(), section) !=
+         excluded.end();
+}
+
+static ReportHeader GetReportHeader(Environment* env,
+                                    const char* message,
+                                    const char* trigger,
+                                    const std::string& filename) {
+  ReportHeader header;
+  header.event = message;
+  header.trigger = trigger;
+  header.filename = filename;
+  // Obtain the current time and the pid.
+  DiagnosticFilename::LocalTime(&header.tm_struct);
+  header.has_timestamp = uv_gettimeofday(&header.timestamp) == 0;
+  header.pid = uv_os_getpid();
+  header.has_thread_id = env != nullptr;
+  header.thread_id = env != nullptr ? env->thread_id() : 0;
+  return header;
+}
+
+static void PrintHeader(JSONWriter* writer,
+                        const ReportHeader& header,
+                        const ExcludedSections& excluded) {
+  writer->json_objectstart("header");
+  writer->json_keyvalue("reportVersion", NODE_REPORT_VERSION);
+  writer->json_keyvalue("event", header.event);
+  writer->json_keyvalue("trigger", header.trigger);
+  if (!header.filename.empty())
+    writer->json_keyvalue("filename", header.filename);
   else
-    writer.json_keyvalue("filename", JSONWriter::Null{});
+    writer->json_keyvalue("filename", JSONWriter::Null{});
 
   // Report dump event and module load date/time stamps
   char timebuf[64];
@@ -213,140 +417,147 @@ static void WriteNodeReport(Isolate* isolate,
   snprintf(timebuf,
            sizeof(timebuf),
            "%4d-%02d-%02dT%02d:%02d:%02dZ",
-           tm_struct.wYear,
-           tm_struct.wMonth,
-           tm_struct.wDay,
-           tm_struct.wHour,
-           tm_struct.wMinute,
-           tm_struct.wSecond);
-  writer.json_keyvalue("dumpEventTime", timebuf);
+           header.tm_struct.wYear,
+           header.tm_struct.wMonth,
+           header.tm_struct.wDay,
+           header.tm_struct.wHour,
+           header.tm_struct.wMinute,
+           header.tm_struct.wSecond);
+  writer->json_keyvalue("dumpEventTime", timebuf);
 #else  // UNIX, OSX
   snprintf(timebuf,
            sizeof(timebuf),
            "%4d-%02d-%02dT%02d:%02d:%02dZ",
-           tm_struct.tm_year + 1900,
-           tm_struct.tm_mon + 1,
-           tm_struct.tm_mday,
-           tm_struct.tm_hour,
-           tm_struct.tm_min,
-           tm_struct.tm_sec);
-  writer.json_keyvalue("dumpEventTime", timebuf);
+           header.tm_struct.tm_year + 1900,
+           header.tm_struct.tm_mon + 1,
+           header.tm_struct.tm_mday,
+           header.tm_struct.tm_hour,
+           header.tm_struct.tm_min,
+           header.tm_struct.tm_sec);
+  writer->json_keyvalue("dumpEventTime", timebuf);
 #endif
 
-  uv_timeval64_t ts;
-  if (uv_gettimeofday(&ts) == 0) {
-    writer.json_keyvalue("dumpEventTimeStamp",
-                         std::to_string(ts.tv_sec * 1000 + ts.tv_usec / 1000));
+  if (header.has_timestamp) {
+    const uv_timeval64_t& ts = header.timestamp;
+    writer->json_keyvalue("dumpEventTimeStamp",
+                          std::to_string(ts.tv_sec * 1000 + ts.tv_usec / 1000));
   }
 
   // Report native process ID
-  writer.json_keyvalue("processId", pid);
-  if (env != nullptr)
-    writer.json_keyvalue("threadId", env->thread_id());
+  writer->json_keyvalue("processId", header.pid);
+  if (header.has_thread_id)
+    writer->json_keyvalue("threadId", header.thread_id);
   else
-    writer.json_keyvalue("threadId", JSONWriter::Null{});
+    writer->json_keyvalue("threadId", JSONWriter::Null{});
 
   {
     // Report the process cwd.
     char buf[PATH_MAX_BYTES];
     size_t cwd_size = sizeof(buf);
     if (uv_cwd(buf, &cwd_size) == 0)
-      writer.json_keyvalue("cwd", buf);
+      writer->json_keyvalue("cwd", buf);
   }
 
   // Report out the command line.
   if (!node::per_process::cli_options->cmdline.empty()) {
-    writer.json_arraystart("commandLine");
+    writer->json_arraystart("commandLine");
     for (const std::string& arg : node::per_process::cli_options->cmdline) {
-      writer.json_element(arg);
+      writer->json_element(arg);
     }
-    writer.json_arrayend();
+    writer->json_arrayend();
   }
 
   // Report Node.js and OS version information
-  PrintVersionInformation(&writer);
-  writer.json_objectend();
+  PrintVersionInformation(writer, excluded);
+  writer->json_objectend();
+}
 
-  writer.json_objectstart("javascriptStack");
+// Report the sections that can only be collected on the thread of the
+// Environment.
+static void PrintEnvironmentSections(JSONWriter* writer,
+                                     Isolate* isolate,
+                                     Environment* env,
+                                     Local<Object> error,
+                                     const char* trigger,
+                                     const ExcludedSections& excluded) {
+  writer->json_objectstart("javascriptStack");
   // Report summary JavaScript error stack backtrace
-  PrintJavaScriptErrorStack(&writer, isolate, error, trigger);
+  PrintJavaScriptErrorStack(writer, isolate, error, trigger);
 
   // Report summary JavaScript error properties backtrace
-  PrintJavaScriptErrorProperties(&writer, isolate, error);
-  writer.json_objectend();  // the end of 'javascriptStack'
+  PrintJavaScriptErrorProperties(writer, isolate, error);
+  writer->json_objectend();  // the end of 'javascriptStack'
 
   // Report native stack backtrace
-  PrintNativeStack(&writer);
+  if (!IsExcluded(excluded, "nativeStack"))
+    PrintNativeStack(writer);
 
   // Report V8 Heap and Garbage Collector information
-  PrintGCStatistics(&writer, isolate);
+  PrintGCStatistics(writer, isolate);
 
   // Report OS and current thread resource usage
-  PrintResourceUsage(&writer);
+  PrintResourceUsage(writer);
 
-  writer.json_arraystart("libuv");
-  if (env != nullptr) {
-    uv_walk(env->event_loop(), WalkHandle, static_cast<void*>(&writer));
+  if (!IsExcluded(excluded, "libuv")) {
+    writer->json_arraystart("libuv");
+    if (env != nullptr) {
+      uv_walk(env->event_loop(), WalkHandle, static_cast<void*>(writer));
 
-    writer.json_start();
-    writer.json_keyvalue("type", "loop");
-    writer.json_keyvalue("is_active",
-        static_cast<bool>(uv_loop_alive(env->event_loop())));
-    writer.json_keyvalue("address",
-        ValueToHexString(reinterpret_cast<int64_t>(env->event_loop())));
-
-    // Report Event loop idle time
-    uint64_t idle_time = uv_metrics_idle_time(env->event_loop());
-    writer.json_keyvalue("loopIdleTimeSeconds", 1.0 * idle_time / 1e9);
-    writer.json_end();
-  }
+      writer->json_start();
+      writer->json_keyvalue("type", "loop");
+      writer->json_keyvalue("is_active",
+          static_cast<bool>(uv_loop_alive(env->event_loop())));
+      writer->json_keyvalue("address",
+          ValueToHexString(reinterpret_cast<int64_t>(env->event_loop())));
+
+      // Report Event loop idle time
+      uint64_t idle_time = uv_metrics_idle_time(env->event_loop());
+      writer->json_keyvalue("loopIdleTimeSeconds", 1.0 * idle_time / 1e9);
+      writer->json_end();
+    }
 
-  writer.json_arrayend();
-
-  writer.json_arraystart("workers");
-  if (env != nullptr) {
-    Mutex workers_mutex;
-    ConditionVariable notify;
-    std::vector<std::string> worker_infos;
-    size_t expected_results = 0;
-
-    env->ForEachWorker([&](Worker* w) {
-      expected_results += w->RequestInterrupt([&](Environment* env) {
-        std::ostringstream os;
-
-        GetNodeReport(env->isolate(),
-                      env,
-                      "Worker thread subreport",
-                      trigger,
-                      Local<Object>(),
-                      os);
-
-        Mutex::ScopedLock lock(workers_mutex);
-        worker_infos.emplace_back(os.str());
-        notify.Signal(lock);
-      });
-    });
-
-    Mutex::ScopedLock lock(workers_mutex);
-    worker_infos.reserve(expected_results);
-    while (worker_infos.size() < expected_results)
-      notify.Wait(lock);
-    for (const std::string& worker_info : worker_infos)
-      writer.json_element(JSONWriter::ForeignJSON { worker_info });
+    writer->json_arrayend();
   }
-  writer.json_arrayend();
-
-  // Report operating system information
-  PrintSystemInformation(&writer);
 
-  writer.json_objectend();
+  if (!IsExcluded(excluded, "workers")) {
+    writer->json_arraystart("workers");
+    if (env != nullptr) {
+      Mutex workers_mutex;
+      ConditionVariable notify;
+      std::vector<std::string> worker_infos;
+      size_t expected_results = 0;
+
+      env->ForEachWorker([&](Worker* w) {
+        expected_results += w->RequestInterrupt([&](Environment* env) {
+          std::ostringstream os;
+
+          GetNodeReport(env->isolate(),
+                        env,
+                        "Worker thread subreport",
+                        trigger,
+                        Local<Object>(),
+                        os);
+
+          Mutex::ScopedLock lock(workers_mutex);
+          worker_infos.emplace_back(os.str());
+          notify.Signal(lock);
+        });
+      });
 
-  // Restore output stream formatting.
-  out.copyfmt(old_state);
+      Mutex::ScopedLock lock(workers_mutex);
+      worker_infos.reserve(expected_results);
+      while (worker_infos.size() < expected_results)
+        notify.Wait(lock);
+      for (const std::string& worker_info : worker_infos)
+        writer->json_element(JSONWriter::ForeignJSON { worker_info });
+    }
+    writer->json_arrayend();
+  }
 }
 
 // Report Node.js version, OS version and machine information.
-static void PrintVersionInformation(JSONWriter* writer) {
+static void PrintVersionInformation(JSONWriter* writer,
+                                    const ExcludedSections& excluded) {
   std::ostringstream buf;
   // Report Node version
   buf << "v" << NODE_VERSION_STRING;
@@ -389,8 +600,10 @@ static void PrintVersionInformation(JSONWriter* writer) {
     writer->json_keyvalue("osMachine", os_info.machine);
   }
 
-  PrintCpuInfo(writer);
-  PrintNetworkInterfaceInfo(writer);
+  if (!IsExcluded(excluded, "cpus"))
+    PrintCpuInfo(writer);
+  if (!IsExcluded(excluded, "networkInterfaces"))
+    PrintNetworkInterfaceInfo(writer);
 
   char host[UV_MAXHOSTNAMESIZE];
   size_t host_size = sizeof(host);
@@ -659,26 +872,29 @@ static void PrintResourceUsage(JSONWriter* writer) {
 }
 
 // Report operating system information.
-static void PrintSystemInformation(JSONWriter* writer) {
-  uv_env_item_t* envitems;
-  int envcount;
-  int r;
+static void PrintSystemInformation(JSONWriter* writer,
+                                   const ExcludedSections& excluded) {
+  if (!IsExcluded(excluded, "environmentVariables")) {
+    uv_env_item_t* envitems;
+    int envcount;
+    int r;
 
-  writer->json_objectstart("environmentVariables");
+    writer->json_objectstart("environmentVariables");
 
-  {
-    Mutex::ScopedLock lock(node::per_process::env_var_mutex);
-    r = uv_os_environ(&envitems, &envcount);
-  }
+    {
+      Mutex::ScopedLock lock(node::per_process::env_var_mutex);
+      r = uv_os_environ(&envitems, &envcount);
+    }
 
-  if (r == 0) {
-    for (int i = 0; i < envcount; i++)
-      writer->json_keyvalue(envitems[i].name, envitems[i].value);
+    if (r == 0) {
+      for (int i = 0; i < envcount; i++)
+        writer->json_keyvalue(envitems[i].name, envitems[i].value);
 
-    uv_os_free_environ(envitems, envcount);
-  }
+      uv_os_free_environ(envitems, envcount);
+    }
 
-  writer->json_objectend();
+    writer->json_objectend();
+  }
 
 #ifndef _WIN32
   static struct {
@@ -705,31 +921,34 @@ static void PrintSystemInformation(JSONWriter* writer) {
 #endif
   };
 
-  writer->json_objectstart("userLimits");
-  struct rlimit limit;
-  std::string soft, hard;
+  if (!IsExcluded(excluded, "userLimits")) {
+    writer->json_objectstart("userLimits");
+    struct rlimit limit;
+    std::string soft, hard;
 
-  for (size_t i = 0; i < arraysize(rlimit_strings); i++) {
-    if (getrlimit(rlimit_strings[i].id, &limit) == 0) {
-      writer->json_objectstart(rlimit_strings[i].description);
+    for (size_t i = 0; i < arraysize(rlimit_strings); i++) {
+      if (getrlimit(rlimit_strings[i].id, &limit) == 0) {
+        writer->json_objectstart(rlimit_strings[i].description);
 
-      if (limit.rlim_cur == RLIM_INFINITY)
-        writer->json_keyvalue("soft", "unlimited");
-      else
-        writer->json_keyvalue("soft", limit.rlim_cur);
+        if (limit.rlim_cur == RLIM_INFINITY)
+          writer->json_keyvalue("soft", "unlimited");
+        else
+          writer->json_keyvalue("soft", limit.rlim_cur);
 
-      if (limit.rlim_max == RLIM_INFINITY)
-        writer->json_keyvalue("hard", "unlimited");
-      else
-        writer->json_keyvalue("hard", limit.rlim_max);
+        if (limit.rlim_max == RLIM_INFINITY)
+          writer->json_keyvalue("hard", "unlimited");
+        else
+          writer->json_keyvalue("hard", limit.rlim_max);
 
-      writer->json_objectend();
+        writer->json_objectend();
+      }
     }
+    writer->json_objectend();
   }
-  writer->json_objectend();
 #endif  // _WIN32
 
-  PrintLoadedLibraries(writer);
+  if (!IsExcluded(excluded, "sharedObjects"))
+    PrintLoadedLibraries(writer);
 }
 
 // Report a list of loaded native libraries.
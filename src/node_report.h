@@ -21,6 +21,12 @@ std::string TriggerNodeReport(v8::Isolate* isolate,
                               const char* trigger,
                               const std::string& name,
                               v8::Local<v8::Object> error);
+void TriggerNodeReportAsync(node::Environment* env,
+                            const char* message,
+                            const char* trigger,
+                            const std::string& name,
+                            v8::Local<v8::Object> error,
+                            v8::Local<v8::Promise::Resolver> resolver);
 void GetNodeReport(v8::Isolate* isolate,
                    node::Environment* env,
                    const char* message,
@@ -42,6 +48,7 @@ std::string ValueToHexString(T value) {
 
 // Function declarations - export functions in src/node_report_module.cc
 void WriteReport(const v8::FunctionCallbackInfo<v8::Value>& info);
+void WriteReportAsync(const v8::FunctionCallbackInfo<v8::Value>& info);
 void GetReport(const v8::FunctionCallbackInfo<v8::Value>& info);
 
 }  // namespace report
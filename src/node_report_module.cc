@@ -15,15 +15,19 @@
 #include <sstream>
 
 namespace report {
+using node::arraysize;
 using node::Environment;
+using node::FIXED_ONE_BYTE_STRING;
 using node::Mutex;
 using node::Utf8Value;
+using v8::Array;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
+using v8::Promise;
 using v8::String;
 using v8::Value;
 
@@ -52,6 +56,34 @@ void WriteReport(const FunctionCallbackInfo<Value>& info) {
       String::NewFromUtf8(isolate, filename.c_str()).ToLocalChecked());
 }
 
+// Like WriteReport(), but only the sections of the report that need the
+// Environment are collected synchronously. Returns a promise for the
+// filename, which is resolved once the rest is written from the threadpool.
+void WriteReportAsync(const FunctionCallbackInfo<Value>& info) {
+  Environment* env = Environment::GetCurrent(info);
+  Isolate* isolate = env->isolate();
+  HandleScope scope(isolate);
+  std::string filename;
+  Local<Object> error;
+
+  CHECK_EQ(info.Length(), 4);
+  String::Utf8Value message(isolate, info[0].As<String>());
+  String::Utf8Value trigger(isolate, info[1].As<String>());
+
+  if (info[2]->IsString())
+    filename = *String::Utf8Value(isolate, info[2]);
+  if (!info[3].IsEmpty() && info[3]->IsObject())
+    error = info[3].As<Object>();
+  else
+    error = Local<Object>();
+
+  Local<Promise::Resolver> resolver;
+  if (!Promise::Resolver::New(env->context()).ToLocal(&resolver))
+    return;
+  TriggerNodeReportAsync(env, *message, *trigger, filename, error, resolver);
+  info.GetReturnValue().Set(resolver->GetPromise());
+}
+
 // External JavaScript API for returning a report
 void GetReport(const FunctionCallbackInfo<Value>& info) {
   Environment* env = Environment::GetCurrent(info);
@@ -87,6 +119,22 @@ static void SetCompact(const FunctionCallbackInfo<Value>& info) {
   node::per_process::cli_options->report_compact = compact;
 }
 
+static void GetExclude(const FunctionCallbackInfo<Value>& info) {
+  node::Mutex::ScopedLock lock(node::per_process::cli_options_mutex);
+  Environment* env = Environment::GetCurrent(info);
+  std::string exclude = node::per_process::cli_options->report_exclude;
+  auto result = String::NewFromUtf8(env->isolate(), exclude.c_str());
+  info.GetReturnValue().Set(result.ToLocalChecked());
+}
+
+static void SetExclude(const FunctionCallbackInfo<Value>& info) {
+  node::Mutex::ScopedLock lock(node::per_process::cli_options_mutex);
+  Environment* env = Environment::GetCurrent(info);
+  CHECK(info[0]->IsString());
+  Utf8Value exclude(env->isolate(), info[0].As<String>());
+  node::per_process::cli_options->report_exclude = *exclude;
+}
+
 static void GetDirectory(const FunctionCallbackInfo<Value>& info) {
   node::Mutex::ScopedLock lock(node::per_process::cli_options_mutex);
   Environment* env = Environment::GetCurrent(info);
@@ -177,9 +225,12 @@ static void Initialize(Local<Object> exports,
   Environment* env = Environment::GetCurrent(context);
 
   env->SetMethod(exports, "writeReport", WriteReport);
+  env->SetMethod(exports, "writeReportAsync", WriteReportAsync);
   env->SetMethod(exports, "getReport", GetReport);
   env->SetMethod(exports, "getCompact", GetCompact);
   env->SetMethod(exports, "setCompact", SetCompact);
+  env->SetMethod(exports, "getExclude", GetExclude);
+  env->SetMethod(exports, "setExclude", SetExclude);
   env->SetMethod(exports, "getDirectory", GetDirectory);
   env->SetMethod(exports, "setDirectory", SetDirectory);
   env->SetMethod(exports, "getFilename", GetFilename);
@@ -194,6 +245,16 @@ static void Initialize(Local<Object> exports,
                  ShouldReportOnUncaughtException);
   env->SetMethod(exports, "setReportOnUncaughtException",
                  SetReportOnUncaughtException);
+
+  Isolate* isolate = env->isolate();
+  Local<Value> sections[] = {
+#define V(name) FIXED_ONE_BYTE_STRING(isolate, #name),
+    REPORT_EXCLUDABLE_SECTIONS(V)
+#undef V
+  };
+  exports->Set(context,
+               FIXED_ONE_BYTE_STRING(isolate, "excludableSections"),
+               Array::New(isolate, sections, arraysize(sections))).Check();
 }
 
 }  // namespace report
@@ -9,6 +9,7 @@ namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -20,6 +21,7 @@ using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
 using v8::SharedArrayBuffer;
 using v8::String;
@@ -41,6 +43,10 @@ class SerializerContext : public BaseObject,
   Maybe<bool> WriteHostObject(Isolate* isolate, Local<Object> object) override;
   Maybe<uint32_t> GetSharedArrayBufferId(
       Isolate* isolate, Local<SharedArrayBuffer> shared_array_buffer) override;
+  void* ReallocateBufferMemory(void* old_buffer,
+                               size_t size,
+                               size_t* actual_size) override;
+  void FreeBufferMemory(void* buffer) override;
 
   static void SetTreatArrayBufferViewsAsHostObjects(
       const FunctionCallbackInfo<Value>& args);
@@ -49,6 +55,8 @@ class SerializerContext : public BaseObject,
   static void WriteHeader(const FunctionCallbackInfo<Value>& args);
   static void WriteValue(const FunctionCallbackInfo<Value>& args);
   static void ReleaseBuffer(const FunctionCallbackInfo<Value>& args);
+  static void SetTarget(const FunctionCallbackInfo<Value>& args);
+  static void ReleaseTarget(const FunctionCallbackInfo<Value>& args);
   static void TransferArrayBuffer(const FunctionCallbackInfo<Value>& args);
   static void WriteUint32(const FunctionCallbackInfo<Value>& args);
   static void WriteUint64(const FunctionCallbackInfo<Value>& args);
@@ -60,6 +68,14 @@ class SerializerContext : public BaseObject,
   SET_SELF_SIZE(SerializerContext)
 
  private:
+  // The memory that is passed to _setTarget(), which the value is serialized
+  // into for as long as it fits.
+  uint8_t* target_ = nullptr;
+  size_t target_capacity_ = 0;
+  bool has_target_ = false;
+  bool target_overflowed_ = false;
+  bool buffer_allocated_ = false;
+
   ValueSerializer serializer_;
 };
 
@@ -144,6 +160,33 @@ Maybe<uint32_t> SerializerContext::GetSharedArrayBufferId(
   return id.ToLocalChecked()->Uint32Value(env()->context());
 }
 
+void* SerializerContext::ReallocateBufferMemory(void* old_buffer,
+                                                size_t size,
+                                                size_t* actual_size) {
+  buffer_allocated_ = true;
+  if (has_target_ && !target_overflowed_) {
+    if (size <= target_capacity_) {
+      *actual_size = target_capacity_;
+      return target_;
+    }
+    // The value does not fit into the target, so it is serialized on the
+    // heap from now on, in order to know how much memory it needs.
+    target_overflowed_ = true;
+    void* data = UncheckedMalloc(size);
+    if (data != nullptr && old_buffer == target_)
+      memcpy(data, target_, target_capacity_);
+    *actual_size = size;
+    return data;
+  }
+  *actual_size = size;
+  return realloc(old_buffer, size);
+}
+
+void SerializerContext::FreeBufferMemory(void* buffer) {
+  if (!has_target_ || buffer != target_)
+    free(buffer);
+}
+
 Maybe<bool> SerializerContext::WriteHostObject(Isolate* isolate,
                                                Local<Object> input) {
   MaybeLocal<Value> ret;
@@ -206,6 +249,11 @@ void SerializerContext::ReleaseBuffer(const FunctionCallbackInfo<Value>& args) {
   SerializerContext* ctx;
   ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
 
+  if (ctx->has_target_) {
+    return ctx->env()->ThrowError(
+        "releaseBuffer() cannot be used after _setTarget()");
+  }
+
   // Note: Both ValueSerializer and this Buffer::New() variant use malloc()
   // as the underlying allocator.
   std::pair<uint8_t*, size_t> ret = ctx->serializer_.Release();
@@ -218,6 +266,48 @@ void SerializerContext::ReleaseBuffer(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void SerializerContext::SetTarget(const FunctionCallbackInfo<Value>& args) {
+  SerializerContext* ctx;
+  ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+
+  if (ctx->buffer_allocated_) {
+    return ctx->env()->ThrowError(
+        "_setTarget() must be called before anything is written");
+  }
+
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK(args[1]->IsNumber());
+  Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+  size_t offset = args[1].As<Number>()->Value();
+  CHECK_LE(offset, view->ByteLength());
+
+  ctx->target_ =
+      static_cast<uint8_t*>(view->Buffer()->GetBackingStore()->Data()) +
+      view->ByteOffset() + offset;
+  ctx->target_capacity_ = view->ByteLength() - offset;
+  ctx->has_target_ = true;
+  // Keep the memory alive for as long as the serializer can write into it.
+  ctx->object()->Set(ctx->env()->context(),
+                     ctx->env()->buffer_string(),
+                     view).Check();
+}
+
+// Returns the number of bytes that were written into the target, or, if the
+// value did not fit into it, the number of bytes that it needs, negated.
+void SerializerContext::ReleaseTarget(const FunctionCallbackInfo<Value>& args) {
+  SerializerContext* ctx;
+  ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+  CHECK(ctx->has_target_);
+
+  std::pair<uint8_t*, size_t> ret = ctx->serializer_.Release();
+  double size = static_cast<double>(ret.second);
+  if (ctx->target_overflowed_) {
+    ctx->FreeBufferMemory(ret.first);
+    size = -size;
+  }
+  args.GetReturnValue().Set(size);
+}
+
 void SerializerContext::TransferArrayBuffer(
     const FunctionCallbackInfo<Value>& args) {
   SerializerContext* ctx;
@@ -465,6 +555,8 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(ser, "writeHeader", SerializerContext::WriteHeader);
   env->SetProtoMethod(ser, "writeValue", SerializerContext::WriteValue);
   env->SetProtoMethod(ser, "releaseBuffer", SerializerContext::ReleaseBuffer);
+  env->SetProtoMethod(ser, "_setTarget", SerializerContext::SetTarget);
+  env->SetProtoMethod(ser, "_releaseTarget", SerializerContext::ReleaseTarget);
   env->SetProtoMethod(ser,
                       "transferArrayBuffer",
                       SerializerContext::TransferArrayBuffer);
@@ -510,6 +602,8 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(SerializerContext::WriteHeader);
   registry->Register(SerializerContext::WriteValue);
   registry->Register(SerializerContext::ReleaseBuffer);
+  registry->Register(SerializerContext::SetTarget);
+  registry->Register(SerializerContext::ReleaseTarget);
   registry->Register(SerializerContext::TransferArrayBuffer);
   registry->Register(SerializerContext::WriteUint32);
   registry->Register(SerializerContext::WriteUint64);
@@ -1,16 +1,222 @@
 
 #include "node_snapshotable.h"
+#include <climits>
+#include <iostream>
+#include <sstream>
 #include "base_object-inl.h"
 #include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_contextify.h"
+#include "node_diagnostics_channel.h"
+#include "node_errors.h"
+#include "node_external_reference.h"
 #include "node_file.h"
+#include "node_internals.h"
+#include "node_main_instance.h"
 #include "node_v8.h"
+#include "node_v8_platform-inl.h"
+#include "node_version.h"
+
+#if HAVE_INSPECTOR
+#include "inspector/worker_inspector.h"  // ParentInspectorHandle
+#endif
 
 namespace node {
 
+using v8::Context;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::HandleScope;
+using v8::Isolate;
 using v8::Local;
+using v8::MaybeLocal;
 using v8::Object;
 using v8::SnapshotCreator;
 using v8::StartupData;
+using v8::TryCatch;
+using v8::Value;
+
+template <typename T>
+void WriteVector(std::stringstream* ss, const T* vec, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    *ss << std::to_string(vec[i]) << (i == size - 1 ? '\n' : ',');
+  }
+}
+
+std::string FormatBlob(const SnapshotData* data) {
+  std::stringstream ss;
+
+  ss << R"(#include <cstddef>
+#include "env.h"
+#include "node_main_instance.h"
+#include "v8.h"
+
+// This file is generated by tools/snapshot. Do not edit.
+
+namespace node {
+
+static const char blob_data[] = {
+)";
+  WriteVector(&ss, data->blob.data, data->blob.raw_size);
+  ss << R"(};
+
+static const int blob_size = )"
+     << data->blob.raw_size << R"(;
+static v8::StartupData blob = { blob_data, blob_size };
+)";
+
+  ss << R"(v8::StartupData* NodeMainInstance::GetEmbeddedSnapshotBlob() {
+  return &blob;
+}
+
+static const std::vector<size_t> isolate_data_indexes {
+)";
+  WriteVector(&ss,
+              data->isolate_data_indices.data(),
+              data->isolate_data_indices.size());
+  ss << R"(};
+
+const std::vector<size_t>* NodeMainInstance::GetIsolateDataIndexes() {
+  return &isolate_data_indexes;
+}
+
+static const EnvSerializeInfo env_info )"
+     << data->env_info << R"(;
+
+const EnvSerializeInfo* NodeMainInstance::GetEnvSerializeInfo() {
+  return &env_info;
+}
+
+}  // namespace node
+)";
+
+  return ss.str();
+}
+
+std::string SnapshotBuilder::Generate(
+    const std::vector<std::string> args,
+    const std::vector<std::string> exec_args) {
+  SnapshotData data;
+  CHECK_EQ(Generate(&data, args, exec_args), 0);
+  // The embedded snapshot is deserialized with a random hash seed.
+  CHECK(data.blob.CanBeRehashed());
+  return FormatBlob(&data);
+}
+
+int SnapshotBuilder::Generate(SnapshotData* out,
+                              const std::vector<std::string> args,
+                              const std::vector<std::string> exec_args) {
+  Isolate* isolate = Isolate::Allocate();
+  per_process::v8_platform.Platform()->RegisterIsolate(isolate,
+                                                       uv_default_loop());
+  std::unique_ptr<NodeMainInstance> main_instance;
+  int exit_code = 0;
+
+  {
+    const std::vector<intptr_t>& external_references =
+        NodeMainInstance::CollectExternalReferences();
+    SnapshotCreator creator(isolate, external_references.data());
+    Environment* env;
+    {
+      main_instance =
+          NodeMainInstance::Create(isolate,
+                                   uv_default_loop(),
+                                   per_process::v8_platform.Platform(),
+                                   args,
+                                   exec_args);
+
+      HandleScope scope(isolate);
+      creator.SetDefaultContext(Context::New(isolate));
+      out->isolate_data_indices =
+          main_instance->isolate_data()->Serialize(&creator);
+
+      // The base context is what Workers start out with before they run
+      // their own bootstrap.
+      Local<Context> base_context = NewContext(isolate);
+      size_t index = creator.AddContext(base_context);
+      CHECK_EQ(index, NodeMainInstance::kNodeBaseContextIndex);
+
+      // The vm context is what vm.createContext() deserializes instead of
+      // creating a new context with the interceptors of its sandbox.
+      Local<Context> vm_context = Context::New(
+          isolate,
+          nullptr,
+          contextify::ContextifyContext::CreateGlobalTemplate(
+              isolate, FIXED_ONE_BYTE_STRING(isolate, "Object")));
+      vm_context->Global()->GetPrototype().As<Object>()
+          ->SetAlignedPointerInInternalField(
+              contextify::ContextifyContext::kSlot, nullptr);
+      index = creator.AddContext(vm_context,
+                                 {SerializeNodeContextInternalFields, nullptr});
+      CHECK_EQ(index, NodeMainInstance::kNodeVMContextIndex);
+
+      Local<Context> context = NewContext(isolate);
+      Context::Scope context_scope(context);
+
+      env = new Environment(main_instance->isolate_data(),
+                            context,
+                            args,
+                            exec_args,
+                            nullptr,
+                            node::EnvironmentFlags::kDefaultFlags,
+                            {});
+      env->RunBootstrapping().ToLocalChecked();
+
+      // With --build-snapshot, lib/internal/main/mksnapshot.js runs the
+      // entry point of the application, and the event loop is run until
+      // it is empty before the snapshot is taken.
+      if (per_process::cli_options->build_snapshot) {
+        SetIsolateErrorHandlers(isolate, {});
+#if HAVE_INSPECTOR
+        env->InitializeInspector({});
+#endif
+        if (LoadEnvironment(env, StartExecutionCallback{}).IsEmpty()) {
+          exit_code = 1;
+        } else {
+          exit_code = SpinEventLoop(env).FromMaybe(1);
+        }
+        // V8 cannot serialize the message listener. The process that starts
+        // from the snapshot installs it again.
+        isolate->RemoveMessageListeners(errors::PerIsolateMessageListener);
+        if (exit_code == 0) {
+          // Get rid of the BaseObjects that are no longer referenced
+          // before checking that the remaining ones can be serialized.
+          isolate->LowMemoryNotification();
+          if (!env->VerifyBaseObjectsSnapshotable())
+            exit_code = 1;
+        }
+      }
+
+      if (exit_code == 0) {
+        if (per_process::enabled_debug_list.enabled(
+                DebugCategory::MKSNAPSHOT)) {
+          env->PrintAllBaseObjects();
+          printf("Environment = %p\n", env);
+        }
+        out->env_info = env->Serialize(&creator);
+        index = creator.AddContext(
+            context, {SerializeNodeContextInternalFields, env});
+        CHECK_EQ(index, NodeMainInstance::kNodeMainContextIndex);
+      }
+    }
+
+    // Must be out of HandleScope
+    StartupData blob =
+        creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kClear);
+    if (exit_code == 0) {
+      out->blob = blob;
+    } else {
+      delete[] blob.data;
+    }
+    // Must be done while the snapshot creator isolate is entered i.e. the
+    // creator is still alive.
+    FreeEnvironment(env);
+    main_instance->Dispose();
+  }
+
+  per_process::v8_platform.Platform()->UnregisterIsolate(isolate);
+  return exit_code;
+}
 
 SnapshotableObject::SnapshotableObject(Environment* env,
                                        Local<Object> wrap,
@@ -130,4 +336,202 @@ void SerializeBindingData(Environment* env,
   });
 }
 
+SnapshotData::~SnapshotData() {
+  delete[] blob.data;
+}
+
+namespace {
+
+// The blobs written by --build-snapshot start with this magic number, and
+// the versions of Node.js and V8 that wrote them. Everything else is in
+// the byte order and layout of the host, since a blob can only be used
+// by the binary that wrote it anyway.
+constexpr size_t kSnapshotBlobMagic = 0x143da20e;
+
+class SnapshotBlobWriter {
+ public:
+  explicit SnapshotBlobWriter(FILE* out) : out_(out) {}
+
+  bool ok() const { return ok_; }
+
+  void Write(const char* data, size_t size) {
+    ok_ = ok_ && fwrite(data, 1, size, out_) == size;
+  }
+
+  void Write(size_t value) {
+    Write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void Write(const std::string& value) {
+    Write(value.size());
+    Write(value.data(), value.size());
+  }
+
+  void Write(const PropInfo& value) {
+    Write(value.name);
+    Write(value.id);
+    Write(value.index);
+  }
+
+  template <typename T>
+  void Write(const std::vector<T>& value) {
+    Write(value.size());
+    for (const T& item : value) Write(item);
+  }
+
+ private:
+  FILE* out_;
+  bool ok_ = true;
+};
+
+class SnapshotBlobReader {
+ public:
+  explicit SnapshotBlobReader(FILE* in) : in_(in) {}
+
+  bool ok() const { return ok_; }
+
+  void Read(char* data, size_t size) {
+    ok_ = ok_ && fread(data, 1, size, in_) == size;
+  }
+
+  void Read(size_t* value) {
+    Read(reinterpret_cast<char*>(value), sizeof(*value));
+  }
+
+  void Read(std::string* value) {
+    size_t size = 0;
+    Read(&size);
+    if (!ok_) return;
+    value->resize(size);
+    Read(&(*value)[0], size);
+  }
+
+  void Read(PropInfo* value) {
+    Read(&value->name);
+    Read(&value->id);
+    Read(&value->index);
+  }
+
+  template <typename T>
+  void Read(std::vector<T>* value) {
+    size_t size = 0;
+    Read(&size);
+    for (size_t i = 0; ok_ && i < size; i++) {
+      T item;
+      Read(&item);
+      value->push_back(std::move(item));
+    }
+  }
+
+ private:
+  FILE* in_;
+  bool ok_ = true;
+};
+
+}  // anonymous namespace
+
+bool SnapshotData::ToBlob(FILE* out) const {
+  SnapshotBlobWriter w(out);
+  w.Write(kSnapshotBlobMagic);
+  w.Write(std::string(NODE_VERSION));
+  w.Write(std::string(v8::V8::GetVersion()));
+
+  w.Write(static_cast<size_t>(blob.raw_size));
+  w.Write(blob.data, blob.raw_size);
+  w.Write(isolate_data_indices);
+
+  w.Write(env_info.bindings);
+  w.Write(env_info.native_modules);
+  w.Write(env_info.async_hooks.async_ids_stack);
+  w.Write(env_info.async_hooks.fields);
+  w.Write(env_info.async_hooks.async_id_fields);
+  w.Write(env_info.async_hooks.js_execution_async_resources);
+  w.Write(env_info.async_hooks.native_execution_async_resources);
+  w.Write(env_info.tick_info.fields);
+  w.Write(env_info.immediate_info.fields);
+  w.Write(env_info.performance_state.root);
+  w.Write(env_info.performance_state.milestones);
+  w.Write(env_info.performance_state.observers);
+  w.Write(env_info.stream_base_state);
+  w.Write(env_info.should_abort_on_uncaught_toggle);
+  w.Write(env_info.persistent_templates);
+  w.Write(env_info.persistent_values);
+  w.Write(env_info.context);
+  return w.ok();
+}
+
+bool SnapshotData::FromBlob(SnapshotData* out, FILE* in) {
+  SnapshotBlobReader r(in);
+  size_t magic = 0;
+  r.Read(&magic);
+  if (!r.ok() || magic != kSnapshotBlobMagic) return false;
+  std::string node_version;
+  std::string v8_version;
+  r.Read(&node_version);
+  r.Read(&v8_version);
+  if (!r.ok() || node_version != NODE_VERSION ||
+      v8_version != v8::V8::GetVersion()) {
+    return false;
+  }
+
+  size_t blob_size = 0;
+  r.Read(&blob_size);
+  if (!r.ok() || blob_size > static_cast<size_t>(INT_MAX)) return false;
+  char* blob_data = new char[blob_size];
+  r.Read(blob_data, blob_size);
+  delete[] out->blob.data;
+  out->blob.data = blob_data;
+  out->blob.raw_size = static_cast<int>(blob_size);
+  r.Read(&out->isolate_data_indices);
+
+  EnvSerializeInfo* info = &out->env_info;
+  r.Read(&info->bindings);
+  r.Read(&info->native_modules);
+  r.Read(&info->async_hooks.async_ids_stack);
+  r.Read(&info->async_hooks.fields);
+  r.Read(&info->async_hooks.async_id_fields);
+  r.Read(&info->async_hooks.js_execution_async_resources);
+  r.Read(&info->async_hooks.native_execution_async_resources);
+  r.Read(&info->tick_info.fields);
+  r.Read(&info->immediate_info.fields);
+  r.Read(&info->performance_state.root);
+  r.Read(&info->performance_state.milestones);
+  r.Read(&info->performance_state.observers);
+  r.Read(&info->stream_base_state);
+  r.Read(&info->should_abort_on_uncaught_toggle);
+  r.Read(&info->persistent_templates);
+  r.Read(&info->persistent_values);
+  r.Read(&info->context);
+  return r.ok();
+}
+
+namespace mksnapshot {
+
+static void SetDeserializeMainFunction(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFunction());
+  env->set_snapshot_deserialize_main(args[0].As<Function>());
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethod(
+      target, "setDeserializeMainFunction", SetDeserializeMainFunction);
+}
+
+void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SetDeserializeMainFunction);
+  // Passed to lib/internal/main/mksnapshot.js, see StartExecution().
+  registry->Register(MarkBootstrapComplete);
+}
+
+}  // namespace mksnapshot
 }  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(mksnapshot, node::mksnapshot::Initialize)
+NODE_MODULE_EXTERNAL_REFERENCE(mksnapshot,
+                               node::mksnapshot::RegisterExternalReferences)
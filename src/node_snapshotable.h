@@ -11,8 +11,11 @@ namespace node {
 
 class Environment;
 struct EnvSerializeInfo;
+struct SnapshotData;
 
 #define SERIALIZABLE_OBJECT_TYPES(V)                                           \
+  V(compiled_fn_entry, contextify::CompiledFnEntry)                            \
+  V(diagnostics_channel_binding_data, diagnostics_channel::BindingData)        \
   V(fs_binding_data, fs::BindingData)                                          \
   V(v8_binding_data, v8_utils::BindingData)
 
@@ -119,6 +122,20 @@ void SerializeBindingData(Environment* env,
                           EnvSerializeInfo* info);
 
 bool IsSnapshotableType(FastStringKey key);
+
+class SnapshotBuilder {
+ public:
+  // Generates the source of the snapshot that is embedded into the binary
+  // at build time, see tools/snapshot.
+  static std::string Generate(const std::vector<std::string> args,
+                              const std::vector<std::string> exec_args);
+  // Generates a snapshot into |out|. With --build-snapshot, the entry point
+  // of the application is run before the snapshot is taken. Returns the
+  // exit code of the process.
+  static int Generate(SnapshotData* out,
+                      const std::vector<std::string> args,
+                      const std::vector<std::string> exec_args);
+};
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
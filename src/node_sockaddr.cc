@@ -5,6 +5,8 @@
 #include "memory_tracker-inl.h"
 #include "uv.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,6 +17,7 @@ using v8::Array;
 using v8::Context;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Int32;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
@@ -157,9 +160,13 @@ SocketAddress::CompareResult compare_ipv4(
   const sockaddr_in* two_in =
       reinterpret_cast<const sockaddr_in*>(two.data());
 
-  if (one_in->sin_addr.s_addr < two_in->sin_addr.s_addr)
+  // The addresses are in network byte order.
+  const uint32_t s_addr_one = ntohl(one_in->sin_addr.s_addr);
+  const uint32_t s_addr_two = ntohl(two_in->sin_addr.s_addr);
+
+  if (s_addr_one < s_addr_two)
     return SocketAddress::CompareResult::LESS_THAN;
-  else if (one_in->sin_addr.s_addr == two_in->sin_addr.s_addr)
+  else if (s_addr_one == s_addr_two)
     return SocketAddress::CompareResult::SAME;
   else
     return SocketAddress::CompareResult::GREATER_THAN;
@@ -384,6 +391,67 @@ bool SocketAddress::is_in_network(
   return false;
 }
 
+SocketAddressRateLimiter::SocketAddressRateLimiter(
+    double rate,
+    double burst,
+    size_t max_size)
+    : rate_(rate),
+      burst_(burst),
+      buckets_(max_size) {
+  CHECK_GT(rate, 0);
+  CHECK_GE(burst, 1);
+}
+
+bool SocketAddressRateLimiter::Consume(
+    const SocketAddress& address,
+    uint64_t now) {
+  // The port of a peer changes with each of its connections, so the bucket
+  // is looked up by the host alone.
+  SocketAddress host(address);
+  switch (host.family()) {
+    case AF_INET:
+      reinterpret_cast<sockaddr_in*>(host.storage())->sin_port = 0;
+      break;
+    case AF_INET6:
+      reinterpret_cast<sockaddr_in6*>(host.storage())->sin6_port = 0;
+      host.set_flow_label(0);
+      break;
+  }
+
+  Bucket* bucket = buckets_.Upsert(host);
+  if (bucket->updated == 0) {
+    bucket->tokens = burst_;
+  } else if (now > bucket->updated) {
+    bucket->tokens = std::min(
+        burst_, bucket->tokens + (now - bucket->updated) * rate_ / 1e9);
+  }
+  bucket->updated = now;
+
+  bool allowed = bucket->tokens >= 1;
+  if (allowed)
+    bucket->tokens -= 1;
+  bucket->full_at =
+      now + static_cast<uint64_t>((burst_ - bucket->tokens) / rate_ * 1e9);
+  return allowed;
+}
+
+bool SocketAddressRateLimiter::BucketTraits::CheckExpired(
+    const SocketAddress& address,
+    const Type& type) {
+  return uv_hrtime() >= type.full_at;
+}
+
+void SocketAddressRateLimiter::BucketTraits::Touch(
+    const SocketAddress& address,
+    Type* type) {
+  // Keep the bucket until Consume() has updated it.
+  type->full_at = std::numeric_limits<uint64_t>::max();
+}
+
+void SocketAddressRateLimiter::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("buckets", buckets_);
+}
+
 SocketAddressBlockList::SocketAddressBlockList(
     std::shared_ptr<SocketAddressBlockList> parent)
     : parent_(parent) {}
@@ -394,6 +462,10 @@ void SocketAddressBlockList::AddSocketAddress(
       std::make_unique<SocketAddressRule>(address);
   rules_.emplace_front(std::move(rule));
   address_rules_[address] = rules_.begin();
+
+  uint8_t key[PrefixTree::kKeyLength];
+  PrefixTree::ToKey(address, key);
+  tree_.Insert(key, PrefixTree::kKeyBits);
 }
 
 void SocketAddressBlockList::RemoveSocketAddress(
@@ -402,6 +474,10 @@ void SocketAddressBlockList::RemoveSocketAddress(
   if (it != std::end(address_rules_)) {
     rules_.erase(it->second);
     address_rules_.erase(it);
+
+    uint8_t key[PrefixTree::kKeyLength];
+    PrefixTree::ToKey(address, key);
+    tree_.Remove(key, PrefixTree::kKeyBits);
   }
 }
 
@@ -411,6 +487,12 @@ void SocketAddressBlockList::AddSocketAddressRange(
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressRangeRule>(start, end);
   rules_.emplace_front(std::move(rule));
+
+  uint8_t start_key[PrefixTree::kKeyLength];
+  uint8_t end_key[PrefixTree::kKeyLength];
+  PrefixTree::ToKey(start, start_key);
+  PrefixTree::ToKey(end, end_key);
+  tree_.InsertRange(start_key, end_key);
 }
 
 void SocketAddressBlockList::AddSocketAddressMask(
@@ -419,14 +501,194 @@ void SocketAddressBlockList::AddSocketAddressMask(
   std::unique_ptr<Rule> rule =
       std::make_unique<SocketAddressMaskRule>(network, prefix);
   rules_.emplace_front(std::move(rule));
+
+  uint8_t key[PrefixTree::kKeyLength];
+  int offset = PrefixTree::ToKey(network, key);
+  tree_.Insert(key, offset + prefix);
+}
+
+void SocketAddressBlockList::AddSocketAddressMasks(
+    const std::vector<std::pair<SocketAddress, int>>& subnets) {
+  for (const auto& subnet : subnets)
+    AddSocketAddressMask(subnet.first, subnet.second);
 }
 
 bool SocketAddressBlockList::Apply(const SocketAddress& address) {
-  for (const auto& rule : rules_) {
-    if (rule->Apply(address))
+  uint8_t key[PrefixTree::kKeyLength];
+  PrefixTree::ToKey(address, key);
+  if (tree_.Lookup(key))
+    return true;
+  return parent_ ? parent_->Apply(address) : false;
+}
+
+namespace {
+inline int GetBit(const uint8_t* key, int n) {
+  return (key[n / 8] >> (7 - n % 8)) & 1;
+}
+
+inline void SetBit(uint8_t* key, int n, int value) {
+  uint8_t bit = 1 << (7 - n % 8);
+  key[n / 8] = value ? key[n / 8] | bit : key[n / 8] & ~bit;
+}
+
+// Sets all of the bits of the key after the first length bits to value.
+void FillKey(uint8_t* key, int length, int value) {
+  constexpr int kKeyBits = SocketAddressBlockList::PrefixTree::kKeyBits;
+  for (; length < kKeyBits && length % 8 != 0; length++)
+    SetBit(key, length, value);
+  for (; length < kKeyBits; length += 8)
+    key[length / 8] = value ? 0xff : 0;
+}
+
+// Returns the number of leading bits, up to max, that a and b share.
+int CommonPrefixLength(const uint8_t* a, const uint8_t* b, int max) {
+  int n = 0;
+  while (n + 8 <= max && a[n / 8] == b[n / 8])
+    n += 8;
+  while (n < max && GetBit(a, n) == GetBit(b, n))
+    n++;
+  return n;
+}
+}  // namespace
+
+SocketAddressBlockList::PrefixTree::Node::Node(
+    const uint8_t* key_,
+    int length_)
+    : length(length_) {
+  memcpy(key, key_, kKeyLength);
+  FillKey(key, length, 0);
+}
+
+int SocketAddressBlockList::PrefixTree::ToKey(
+    const SocketAddress& address,
+    uint8_t* key) {
+  if (address.family() == AF_INET) {
+    const sockaddr_in* in =
+        reinterpret_cast<const sockaddr_in*>(address.data());
+    memcpy(key, mask, sizeof(mask));
+    memcpy(key + sizeof(mask), &in->sin_addr, sizeof(in->sin_addr));
+    return sizeof(mask) * 8;
+  }
+  const sockaddr_in6* in =
+      reinterpret_cast<const sockaddr_in6*>(address.data());
+  memcpy(key, &in->sin6_addr, kKeyLength);
+  return 0;
+}
+
+void SocketAddressBlockList::PrefixTree::Insert(
+    const uint8_t* key,
+    int length) {
+  std::unique_ptr<Node>* slot = &root_;
+  while (*slot) {
+    Node* node = slot->get();
+    int common =
+        CommonPrefixLength(node->key, key, std::min(node->length, length));
+    if (common == node->length) {
+      if (length == node->length) {
+        node->count++;
+        return;
+      }
+      slot = &node->children[GetBit(key, node->length)];
+      continue;
+    }
+
+    // The prefixes differ before the end of the node, so both move below a
+    // new node for the part that they have in common.
+    std::unique_ptr<Node> split = std::make_unique<Node>(key, common);
+    nodes_++;
+    split->children[GetBit(node->key, common)] = std::move(*slot);
+    if (common == length) {
+      split->count++;
+    } else {
+      std::unique_ptr<Node>& child = split->children[GetBit(key, common)];
+      child = std::make_unique<Node>(key, length);
+      child->count++;
+      nodes_++;
+    }
+    *slot = std::move(split);
+    return;
+  }
+  *slot = std::make_unique<Node>(key, length);
+  (*slot)->count++;
+  nodes_++;
+}
+
+void SocketAddressBlockList::PrefixTree::InsertRange(
+    const uint8_t* start,
+    const uint8_t* end) {
+  uint8_t prefix[kKeyLength] = {};
+  InsertRange(prefix, 0, start, end);
+}
+
+// Inserts the largest prefixes below the given one that are within the
+// range. At most two prefixes of each length are only partly within it, so
+// a range is split into no more than 2 * 128 prefixes.
+void SocketAddressBlockList::PrefixTree::InsertRange(
+    uint8_t* prefix,
+    int length,
+    const uint8_t* start,
+    const uint8_t* end) {
+  uint8_t last[kKeyLength];
+  memcpy(last, prefix, kKeyLength);
+  FillKey(last, length, 1);
+  if (memcmp(last, start, kKeyLength) < 0 ||
+      memcmp(prefix, end, kKeyLength) > 0) {
+    return;
+  }
+  if (memcmp(prefix, start, kKeyLength) >= 0 &&
+      memcmp(last, end, kKeyLength) <= 0) {
+    return Insert(prefix, length);
+  }
+
+  CHECK_LT(length, kKeyBits);
+  InsertRange(prefix, length + 1, start, end);
+  SetBit(prefix, length, 1);
+  InsertRange(prefix, length + 1, start, end);
+  SetBit(prefix, length, 0);
+}
+
+void SocketAddressBlockList::PrefixTree::Remove(
+    const uint8_t* key,
+    int length) {
+  std::unique_ptr<Node>* slot = &root_;
+  while (*slot && (*slot)->length < length)
+    slot = &(*slot)->children[GetBit(key, (*slot)->length)];
+
+  Node* node = slot->get();
+  if (node == nullptr ||
+      node->length != length ||
+      CommonPrefixLength(node->key, key, length) != length ||
+      node->count == 0) {
+    return;
+  }
+  if (--node->count > 0)
+    return;
+
+  // Drop the node if it no longer splits the paths of two children.
+  if (node->children[0] && node->children[1])
+    return;
+  std::unique_ptr<Node> child = std::move(
+      node->children[0] ? node->children[0] : node->children[1]);
+  *slot = std::move(child);
+  nodes_--;
+}
+
+bool SocketAddressBlockList::PrefixTree::Lookup(const uint8_t* key) const {
+  const Node* node = root_.get();
+  while (node != nullptr &&
+         CommonPrefixLength(node->key, key, node->length) == node->length) {
+    if (node->count > 0)
       return true;
+    if (node->length == kKeyBits)
+      break;
+    node = node->children[GetBit(key, node->length)].get();
   }
-  return parent_ ? parent_->Apply(address) : false;
+  return false;
+}
+
+void SocketAddressBlockList::PrefixTree::MemoryInfo(
+    node::MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("nodes", nodes_ * sizeof(Node));
 }
 
 SocketAddressBlockList::SocketAddressRule::SocketAddressRule(
@@ -500,6 +762,7 @@ MaybeLocal<Array> SocketAddressBlockList::ListRules(Environment* env) {
 
 void SocketAddressBlockList::MemoryInfo(node::MemoryTracker* tracker) const {
   tracker->TrackField("rules", rules_);
+  tracker->TrackField("tree", tree_);
 }
 
 void SocketAddressBlockList::SocketAddressRule::MemoryInfo(
@@ -635,6 +898,55 @@ void SocketAddressBlockListWrap::AddSubnet(
   args.GetReturnValue().Set(true);
 }
 
+void SocketAddressBlockListWrap::AddSubnets(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SocketAddressBlockListWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsInt32());
+
+  Local<Array> networks = args[0].As<Array>();
+  Local<Array> prefixes = args[1].As<Array>();
+  CHECK_EQ(networks->Length(), prefixes->Length());
+  int32_t family;
+  if (!args[2]->Int32Value(env->context()).To(&family))
+    return;
+
+  // All of the subnets are parsed before the first one is added, so that
+  // none of them are added if one of them is invalid.
+  std::vector<std::pair<SocketAddress, int>> subnets;
+  subnets.reserve(networks->Length());
+  for (uint32_t n = 0; n < networks->Length(); n++) {
+    Local<Value> network;
+    Local<Value> prefix;
+    if (!networks->Get(env->context(), n).ToLocal(&network) ||
+        !prefixes->Get(env->context(), n).ToLocal(&prefix)) {
+      return;
+    }
+    CHECK(network->IsString());
+    CHECK(prefix->IsInt32());
+
+    sockaddr_storage address;
+    Utf8Value value(args.GetIsolate(), network);
+    if (!SocketAddress::ToSockAddr(family, *value, 0, &address))
+      return args.GetReturnValue().Set(n);
+
+    int32_t bits = prefix.As<Int32>()->Value();
+    CHECK_IMPLIES(family == AF_INET, bits <= 32);
+    CHECK_IMPLIES(family == AF_INET6, bits <= 128);
+    CHECK_GE(bits, 0);
+    subnets.emplace_back(
+        SocketAddress(reinterpret_cast<const sockaddr*>(&address)), bits);
+  }
+
+  wrap->AddSocketAddressMasks(subnets);
+
+  args.GetReturnValue().Set(-1);
+}
+
 void SocketAddressBlockListWrap::Check(
     const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -681,6 +993,7 @@ void SocketAddressBlockListWrap::Initialize(
   env->SetProtoMethod(t, "addAddress", SocketAddressBlockListWrap::AddAddress);
   env->SetProtoMethod(t, "addRange", SocketAddressBlockListWrap::AddRange);
   env->SetProtoMethod(t, "addSubnet", SocketAddressBlockListWrap::AddSubnet);
+  env->SetProtoMethod(t, "addSubnets", SocketAddressBlockListWrap::AddSubnets);
   env->SetProtoMethod(t, "check", SocketAddressBlockListWrap::Check);
   env->SetProtoMethod(t, "getRules", SocketAddressBlockListWrap::GetRules);
 
@@ -14,6 +14,8 @@
 #include <string>
 #include <list>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace node {
 
@@ -182,6 +184,47 @@ class SocketAddressLRU : public MemoryRetainer {
   size_t max_size_;
 };
 
+// A SocketAddressRateLimiter keeps a token bucket for each of the most
+// recently seen addresses, whatever their port, and allows an event from an
+// address only while the bucket of the address holds a token. The buckets
+// are refilled at a constant rate, up to the burst size.
+class SocketAddressRateLimiter : public MemoryRetainer {
+ public:
+  // The rate is the number of tokens that are added per second. At most
+  // max_size buckets are kept, the least recently used ones are dropped.
+  SocketAddressRateLimiter(double rate, double burst, size_t max_size);
+
+  // Returns true and takes a token from the bucket of the address if it
+  // holds one, or returns false.
+  bool Consume(const SocketAddress& address, uint64_t now = uv_hrtime());
+
+  size_t size() const { return buckets_.size(); }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(SocketAddressRateLimiter)
+  SET_SELF_SIZE(SocketAddressRateLimiter)
+
+ private:
+  struct Bucket {
+    double tokens;
+    uint64_t updated;
+    // The time at which the bucket is full again. It can be dropped then,
+    // since a new bucket starts out full.
+    uint64_t full_at;
+  };
+
+  struct BucketTraits {
+    using Type = Bucket;
+
+    static bool CheckExpired(const SocketAddress& address, const Type& type);
+    static void Touch(const SocketAddress& address, Type* type);
+  };
+
+  double rate_;
+  double burst_;
+  SocketAddressLRU<BucketTraits> buckets_;
+};
+
 // A BlockList is used to evaluate whether a given
 // SocketAddress should be accepted for inbound or
 // outbound network activity.
@@ -205,6 +248,10 @@ class SocketAddressBlockList : public MemoryRetainer {
       const SocketAddress& address,
       int prefix);
 
+  // Adds a subnet rule for each of the {network, prefix} pairs.
+  void AddSocketAddressMasks(
+      const std::vector<std::pair<SocketAddress, int>>& subnets);
+
   bool Apply(const SocketAddress& address);
 
   size_t size() const { return rules_.size(); }
@@ -262,12 +309,55 @@ class SocketAddressBlockList : public MemoryRetainer {
     SET_SELF_SIZE(SocketAddressMaskRule)
   };
 
+  // A binary trie of the blocked prefixes in which the chains of nodes
+  // with a single child are collapsed into one node. IPv4 addresses are
+  // stored as IPv4-mapped IPv6 addresses, so a lookup compares at most
+  // 128 bits, whatever the number of rules.
+  class PrefixTree final : public MemoryRetainer {
+   public:
+    static constexpr int kKeyLength = 16;
+    static constexpr int kKeyBits = kKeyLength * 8;
+
+    // Returns the key of the address, and the number of bits that the
+    // prefixes of its family are offset by in the key.
+    static int ToKey(const SocketAddress& address, uint8_t* key);
+
+    void Insert(const uint8_t* key, int length);
+    void InsertRange(const uint8_t* start, const uint8_t* end);
+    void Remove(const uint8_t* key, int length);
+    bool Lookup(const uint8_t* key) const;
+
+    void MemoryInfo(node::MemoryTracker* tracker) const override;
+    SET_MEMORY_INFO_NAME(PrefixTree)
+    SET_SELF_SIZE(PrefixTree)
+
+   private:
+    struct Node {
+      Node(const uint8_t* key, int length);
+
+      uint8_t key[kKeyLength];
+      int length;
+      // The number of rules that block this whole prefix.
+      size_t count = 0;
+      std::unique_ptr<Node> children[2];
+    };
+
+    void InsertRange(uint8_t* prefix,
+                     int length,
+                     const uint8_t* start,
+                     const uint8_t* end);
+
+    std::unique_ptr<Node> root_;
+    size_t nodes_ = 0;
+  };
+
   void MemoryInfo(node::MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(SocketAddressBlockList)
   SET_SELF_SIZE(SocketAddressBlockList)
 
  private:
   std::shared_ptr<SocketAddressBlockList> parent_;
+  PrefixTree tree_;
   std::list<std::unique_ptr<Rule>> rules_;
   SocketAddress::Map<std::list<std::unique_ptr<Rule>>::iterator> address_rules_;
 };
@@ -286,6 +376,7 @@ class SocketAddressBlockListWrap :
   static void AddAddress(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddRange(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddSubnet(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void AddSubnets(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Check(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetRules(const v8::FunctionCallbackInfo<v8::Value>& args);
 
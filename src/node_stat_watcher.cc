@@ -25,10 +25,16 @@
 #include "memory_tracker-inl.h"
 #include "node_external_reference.h"
 #include "node_file-inl.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
 #include <cstring>
 #include <cstdlib>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace node {
 
@@ -43,6 +49,202 @@ using v8::Uint32;
 using v8::Value;
 
 
+// The watchers of an Environment that poll at the same interval. Each
+// interval, a timer sweeps all of their paths with a single threadpool
+// request, which stats them one after the other.
+class StatWatcherGroup {
+ public:
+  static StatWatcherGroup* Get(fs::BindingData* binding_data,
+                               uint32_t interval);
+
+  void Add(StatWatcher* watcher);
+  void Remove(StatWatcher* watcher);
+
+ private:
+  class StatWork;
+
+  StatWatcherGroup(fs::BindingData* binding_data, uint32_t interval);
+
+  void Stat(const std::vector<StatWatcher*>& watchers, bool sweep);
+  void Sweep();
+  void OnStatDone(StatWork* work, int status);
+  void MaybeDelete();
+
+  static void OnTimeout(uv_timer_t* timer);
+
+  Environment* const env_;
+  fs::BindingData* const binding_data_;
+  const uint32_t interval_;
+  uv_timer_t timer_;
+  uint64_t last_id_ = 0;
+  std::unordered_map<uint64_t, StatWatcher*> watchers_;
+  size_t pending_work_ = 0;
+  bool sweeping_ = false;
+  bool closing_ = false;
+  bool timer_closed_ = false;
+};
+
+class StatWatcherGroup::StatWork final : public ThreadPoolWork {
+ public:
+  StatWork(Environment* env,
+           StatWatcherGroup* group,
+           bool sweep,
+           std::vector<uint64_t>&& ids,
+           std::vector<std::string>&& paths)
+      : ThreadPoolWork(env),
+        group_(group),
+        sweep_(sweep),
+        ids_(std::move(ids)),
+        paths_(std::move(paths)) {}
+
+  void DoThreadPoolWork() override {
+    fs::StatPaths(env()->event_loop(), paths_, &stats_, &errors_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<StatWork> self(this);
+    group_->OnStatDone(this, status);
+  }
+
+ private:
+  friend class StatWatcherGroup;
+
+  StatWatcherGroup* const group_;
+  const bool sweep_;
+  std::vector<uint64_t> ids_;
+  std::vector<std::string> paths_;
+  std::vector<uv_stat_t> stats_;
+  std::vector<int> errors_;
+};
+
+StatWatcherGroup::StatWatcherGroup(fs::BindingData* binding_data,
+                                   uint32_t interval)
+    : env_(binding_data->env()),
+      binding_data_(binding_data),
+      interval_(interval) {
+  CHECK_EQ(0, uv_timer_init(env_->event_loop(), &timer_));
+  timer_.data = this;
+  // The uv_fs_poll_t handles of the watchers keep the loop alive.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+}
+
+StatWatcherGroup* StatWatcherGroup::Get(fs::BindingData* binding_data,
+                                        uint32_t interval) {
+  StatWatcherGroup*& group = binding_data->stat_watcher_groups[interval];
+  if (group == nullptr)
+    group = new StatWatcherGroup(binding_data, interval);
+  return group;
+}
+
+void StatWatcherGroup::Add(StatWatcher* watcher) {
+  CHECK(!closing_);
+  watcher->set_id(++last_id_);
+  watchers_[watcher->id()] = watcher;
+
+  // Like uv_fs_poll_start(), stat the path right away so that the changes
+  // are reported from then on.
+  Stat({ watcher }, false);
+  if (!sweeping_ && !uv_is_active(reinterpret_cast<uv_handle_t*>(&timer_)))
+    uv_timer_start(&timer_, OnTimeout, interval_, 0);
+}
+
+void StatWatcherGroup::Remove(StatWatcher* watcher) {
+  CHECK_EQ(watchers_.erase(watcher->id()), 1);
+  if (!watchers_.empty())
+    return;
+
+  closing_ = true;
+  binding_data_->stat_watcher_groups.erase(interval_);
+  env_->CloseHandle(&timer_, [](uv_timer_t* timer) {
+    StatWatcherGroup* group = static_cast<StatWatcherGroup*>(timer->data);
+    group->timer_closed_ = true;
+    group->MaybeDelete();
+  });
+}
+
+void StatWatcherGroup::Stat(const std::vector<StatWatcher*>& watchers,
+                            bool sweep) {
+  std::vector<uint64_t> ids;
+  std::vector<std::string> paths;
+  ids.reserve(watchers.size());
+  paths.reserve(watchers.size());
+  for (StatWatcher* watcher : watchers) {
+    watcher->set_stat_pending(true);
+    ids.push_back(watcher->id());
+    paths.push_back(watcher->path());
+  }
+  pending_work_++;
+  sweeping_ = sweeping_ || sweep;
+  StatWork* work =
+      new StatWork(env_, this, sweep, std::move(ids), std::move(paths));
+  work->ScheduleWork();
+}
+
+void StatWatcherGroup::Sweep() {
+  // The watchers that still wait for their first stat() are left out of
+  // this sweep, so that each of them only has one stat() at a time.
+  std::vector<StatWatcher*> watchers;
+  watchers.reserve(watchers_.size());
+  for (const auto& entry : watchers_) {
+    if (!entry.second->stat_pending())
+      watchers.push_back(entry.second);
+  }
+  // Otherwise, the timer is restarted once the first stat() is done, like
+  // uv_fs_poll_t does. Restarting it here would spin with an interval of 0.
+  if (!watchers.empty())
+    Stat(watchers, true);
+}
+
+void StatWatcherGroup::OnStatDone(StatWork* work, int status) {
+  pending_work_--;
+  if (work->sweep_)
+    sweeping_ = false;
+
+  // The work is only cancelled when the Environment is cleaned up.
+  if (status == 0) {
+    for (size_t i = 0; i < work->ids_.size(); i++) {
+      // The callbacks of the previous watchers can stop the next ones.
+      auto it = watchers_.find(work->ids_[i]);
+      if (it == watchers_.end())
+        continue;
+      it->second->set_stat_pending(false);
+      it->second->OnStat(work->errors_[i], &work->stats_[i]);
+    }
+  }
+
+  if (closing_)
+    return MaybeDelete();
+  if (!sweeping_ && !uv_is_active(reinterpret_cast<uv_handle_t*>(&timer_)))
+    uv_timer_start(&timer_, OnTimeout, interval_, 0);
+}
+
+void StatWatcherGroup::MaybeDelete() {
+  if (timer_closed_ && pending_work_ == 0)
+    delete this;
+}
+
+void StatWatcherGroup::OnTimeout(uv_timer_t* timer) {
+  static_cast<StatWatcherGroup*>(timer->data)->Sweep();
+}
+
+// The fields uv_fs_poll_t compares to detect changes.
+static bool StatEqual(const uv_stat_t* a, const uv_stat_t* b) {
+  return a->st_ctim.tv_nsec == b->st_ctim.tv_nsec &&
+         a->st_mtim.tv_nsec == b->st_mtim.tv_nsec &&
+         a->st_birthtim.tv_nsec == b->st_birthtim.tv_nsec &&
+         a->st_ctim.tv_sec == b->st_ctim.tv_sec &&
+         a->st_mtim.tv_sec == b->st_mtim.tv_sec &&
+         a->st_birthtim.tv_sec == b->st_birthtim.tv_sec &&
+         a->st_size == b->st_size &&
+         a->st_mode == b->st_mode &&
+         a->st_uid == b->st_uid &&
+         a->st_gid == b->st_gid &&
+         a->st_ino == b->st_ino &&
+         a->st_dev == b->st_dev &&
+         a->st_flags == b->st_flags &&
+         a->st_gen == b->st_gen;
+}
+
 void StatWatcher::Initialize(Environment* env, Local<Object> target) {
   HandleScope scope(env->isolate());
 
@@ -72,25 +274,53 @@ StatWatcher::StatWatcher(fs::BindingData* binding_data,
       use_bigint_(use_bigint),
       binding_data_(binding_data) {
   CHECK_EQ(0, uv_fs_poll_init(env()->event_loop(), &watcher_));
+  memset(&statbuf_, 0, sizeof(statbuf_));
+}
+
+
+void StatWatcher::Close(Local<Value> close_callback) {
+  if (group_ != nullptr) {
+    group_->Remove(this);
+    group_ = nullptr;
+  }
+  HandleWrap::Close(close_callback);
+}
+
+
+void StatWatcher::OnStat(int status, const uv_stat_t* stat) {
+  if (status != 0) {
+    if (poll_status_ != status) {
+      poll_status_ = status;
+      uv_stat_t zero_statbuf;
+      memset(&zero_statbuf, 0, sizeof(zero_statbuf));
+      OnChange(status, &statbuf_, &zero_statbuf);
+    }
+    return;
+  }
+
+  const uv_stat_t prev = statbuf_;
+  const int prev_status = poll_status_;
+  statbuf_ = *stat;
+  poll_status_ = 1;
+  if (prev_status < 0 || (prev_status != 0 && !StatEqual(&prev, stat)))
+    OnChange(0, &prev, stat);
 }
 
 
-void StatWatcher::Callback(uv_fs_poll_t* handle,
-                           int status,
+void StatWatcher::OnChange(int status,
                            const uv_stat_t* prev,
                            const uv_stat_t* curr) {
-  StatWatcher* wrap = ContainerOf(&StatWatcher::watcher_, handle);
-  Environment* env = wrap->env();
+  Environment* env = this->env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
   Local<Value> arr = fs::FillGlobalStatsArray(
-      wrap->binding_data_.get(), wrap->use_bigint_, curr);
+      binding_data_.get(), use_bigint_, curr);
   USE(fs::FillGlobalStatsArray(
-      wrap->binding_data_.get(), wrap->use_bigint_, prev, true));
+      binding_data_.get(), use_bigint_, prev, true));
 
   Local<Value> argv[2] = { Integer::New(env->isolate(), status), arr };
-  wrap->MakeCallback(env->onchange_string(), arraysize(argv), argv);
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
 }
 
 
@@ -107,7 +337,7 @@ void StatWatcher::Start(const FunctionCallbackInfo<Value>& args) {
 
   StatWatcher* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
-  CHECK(!uv_is_active(wrap->GetHandle()));
+  CHECK_NULL(wrap->group_);
 
   node::Utf8Value path(args.GetIsolate(), args[0]);
   CHECK_NOT_NULL(*path);
@@ -115,12 +345,21 @@ void StatWatcher::Start(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[1]->IsUint32());
   const uint32_t interval = args[1].As<Uint32>()->Value();
 
-  // Note that uv_fs_poll_start does not return ENOENT, we are handling
-  // mostly memory errors here.
-  const int err = uv_fs_poll_start(&wrap->watcher_, Callback, *path, interval);
-  if (err != 0) {
-    args.GetReturnValue().Set(err);
+  // The uv_fs_poll_t is started so that it keeps the loop alive while it is
+  // ref'ed, and so that libuv knows its path, e.g. for diagnostic reports.
+  // It polls at the longest interval there is, and its callback does
+  // nothing: the group reports the changes.
+  int err = uv_fs_poll_start(
+      &wrap->watcher_,
+      [](uv_fs_poll_t*, int, const uv_stat_t*, const uv_stat_t*) {},
+      *path,
+      std::numeric_limits<unsigned int>::max());
+  if (err == 0) {
+    wrap->path_ = *path;
+    wrap->group_ = StatWatcherGroup::Get(wrap->binding_data_.get(), interval);
+    wrap->group_->Add(wrap);
   }
+  args.GetReturnValue().Set(err);
 }
 
 }  // namespace node
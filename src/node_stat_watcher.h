@@ -29,6 +29,9 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <cstdint>
+#include <string>
+
 namespace node {
 namespace fs {
 class BindingData;
@@ -36,12 +39,30 @@ class BindingData;
 
 class Environment;
 class ExternalReferenceRegistry;
+class StatWatcherGroup;
 
+// The watchers of fs.watchFile(). Rather than each running a uv_fs_poll_t,
+// the watchers of an Environment that poll at the same interval form a
+// StatWatcherGroup, which stats all of their paths in a single threadpool
+// request each interval. The uv_fs_poll_t of a watcher only keeps the loop
+// alive and does not poll by itself.
 class StatWatcher : public HandleWrap {
  public:
   static void Initialize(Environment* env, v8::Local<v8::Object> target);
   static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
+  void Close(v8::Local<v8::Value> close_callback) override;
+
+  // Called with the result of each stat() of the path, reports the changes
+  // the same way uv_fs_poll_t does.
+  void OnStat(int status, const uv_stat_t* stat);
+
+  const std::string& path() const { return path_; }
+  uint64_t id() const { return id_; }
+  void set_id(uint64_t id) { id_ = id; }
+  bool stat_pending() const { return stat_pending_; }
+  void set_stat_pending(bool pending) { stat_pending_ = pending; }
+
  protected:
   StatWatcher(fs::BindingData* binding_data,
               v8::Local<v8::Object> wrap,
@@ -55,14 +76,19 @@ class StatWatcher : public HandleWrap {
   SET_SELF_SIZE(StatWatcher)
 
  private:
-  static void Callback(uv_fs_poll_t* handle,
-                       int status,
-                       const uv_stat_t* prev,
-                       const uv_stat_t* curr);
+  void OnChange(int status, const uv_stat_t* prev, const uv_stat_t* curr);
 
   uv_fs_poll_t watcher_;
   const bool use_bigint_;
+  uint64_t id_ = 0;
   BaseObjectPtr<fs::BindingData> binding_data_;
+  StatWatcherGroup* group_ = nullptr;
+  std::string path_;
+  // Like the busy_polling field of uv_fs_poll_t: 0 before the first stat(),
+  // then 1 while stat() succeeds, or the error code of the last failure.
+  int poll_status_ = 0;
+  bool stat_pending_ = false;
+  uv_stat_t statbuf_;
 };
 
 }  // namespace node
@@ -1,15 +1,24 @@
 #include "node_url.h"
 #include "base_object-inl.h"
+#include "node_buffer.h"
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "node_i18n.h"
 #include "util-inl.h"
 
+#include <climits>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace node {
 
 using errors::TryCatchScope;
@@ -20,6 +29,7 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -724,6 +734,194 @@ std::string PercentDecode(const char* input, size_t len) {
   return dest;
 }
 
+// Returns the index of the first '%' or '+' in the input, or `len`.
+size_t FindFormEncoded(const char* input, size_t len) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i percent = _mm_set1_epi8('%');
+  const __m128i plus = _mm_set1_epi8('+');
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const int mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(v, percent), _mm_cmpeq_epi8(v, plus)));
+    if (mask != 0)
+      return i + __builtin_ctz(mask);
+  }
+#endif
+  for (; i < len; i++) {
+    if (input[i] == '%' || input[i] == '+')
+      return i;
+  }
+  return len;
+}
+
+// https://url.spec.whatwg.org/#concept-urlencoded-parser
+// Percent-decodes the name or value at `input`, and replaces '+' with a
+// space if `plus_as_space` is set. Invalid escapes are left as they are.
+void DecodeFormComponent(const char* input,
+                         size_t len,
+                         bool plus_as_space,
+                         std::string* out) {
+  out->clear();
+  out->reserve(len);
+  size_t i = 0;
+  while (i < len) {
+    const size_t n = FindFormEncoded(input + i, len - i);
+    out->append(input + i, n);
+    i += n;
+    if (i == len)
+      break;
+    if (input[i] == '+') {
+      *out += plus_as_space ? ' ' : '+';
+      i++;
+    } else if (len - i >= 3 &&
+               IsASCIIHexDigit(input[i + 1]) &&
+               IsASCIIHexDigit(input[i + 2])) {
+      *out += static_cast<char>(hex2bin(input[i + 1]) * 16 +
+                                hex2bin(input[i + 2]));
+      i += 3;
+    } else {
+      *out += '%';
+      i++;
+    }
+  }
+}
+
+inline bool IsFormUnescaped(unsigned char ch) {
+  return IsASCIIAlphanumeric(ch) ||
+         ch == '*' || ch == '-' || ch == '.' || ch == '_';
+}
+
+// The characters that querystring.escape() leaves as they are.
+inline bool IsQueryStringUnescaped(unsigned char ch) {
+  return IsFormUnescaped(ch) ||
+         ch == '!' || ch == '\'' || ch == '(' || ch == ')' || ch == '~';
+}
+
+#if defined(__SSE2__)
+// Sets the bytes of the result for which the bytes of `v` are ASCII letters
+// or digits. Bytes >= 0x80 are negative and fall out of all of the ranges.
+inline __m128i ASCIIAlphanumericMask(__m128i v) {
+  const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+  const __m128i alpha =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                    _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+  const __m128i digit =
+      _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+  return _mm_or_si128(alpha, digit);
+}
+
+inline __m128i FormUnescapedMask(__m128i v) {
+  const __m128i other = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')),
+                   _mm_cmpeq_epi8(v, _mm_set1_epi8('-'))),
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('.')),
+                   _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))));
+  return _mm_or_si128(ASCIIAlphanumericMask(v), other);
+}
+
+inline __m128i QueryStringUnescapedMask(__m128i v) {
+  // '\'', '(', ')' and '*' are consecutive.
+  const __m128i quote_to_star =
+      _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('\'' - 1)),
+                    _mm_cmplt_epi8(v, _mm_set1_epi8('*' + 1)));
+  const __m128i other = _mm_or_si128(
+      _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('!')),
+                   _mm_cmpeq_epi8(v, _mm_set1_epi8('-'))),
+      _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('.')),
+                       _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))),
+          _mm_cmpeq_epi8(v, _mm_set1_epi8('~'))));
+  return _mm_or_si128(ASCIIAlphanumericMask(v),
+                      _mm_or_si128(quote_to_star, other));
+}
+#endif  // defined(__SSE2__)
+
+// Returns the number of bytes at the start of the input that the
+// application/x-www-form-urlencoded serializer leaves as they are.
+size_t FormUnescapedPrefixLength(const char* input, size_t len) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const int mask = _mm_movemask_epi8(FormUnescapedMask(v));
+    if (mask != 0xffff)
+      return i + __builtin_ctz(~mask);
+  }
+#endif
+  while (i < len && IsFormUnescaped(input[i]))
+    i++;
+  return i;
+}
+
+// Returns the number of bytes at the start of the input that
+// querystring.escape() leaves as they are.
+size_t QueryStringUnescapedPrefixLength(const char* input, size_t len) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  for (; i + 16 <= len; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const int mask = _mm_movemask_epi8(QueryStringUnescapedMask(v));
+    if (mask != 0xffff)
+      return i + __builtin_ctz(~mask);
+  }
+#endif
+  while (i < len && IsQueryStringUnescaped(input[i]))
+    i++;
+  return i;
+}
+
+// https://url.spec.whatwg.org/#concept-urlencoded-byte-serializer
+void AppendFormEncoded(const char* input, size_t len, std::string* out) {
+  size_t i = 0;
+  while (i < len) {
+    const size_t n = FormUnescapedPrefixLength(input + i, len - i);
+    out->append(input + i, n);
+    i += n;
+    if (i == len)
+      break;
+    const unsigned char ch = input[i++];
+    if (ch == ' ')
+      *out += '+';
+    else
+      *out += hex[ch];
+  }
+}
+
+void AppendQueryStringEscaped(const char* input,
+                              size_t len,
+                              std::string* out) {
+  size_t i = 0;
+  while (i < len) {
+    const size_t n = QueryStringUnescapedPrefixLength(input + i, len - i);
+    out->append(input + i, n);
+    i += n;
+    if (i == len)
+      break;
+    *out += hex[static_cast<unsigned char>(input[i++])];
+  }
+}
+
+// Utf8Value replaces lone surrogates with U+FFFD, which the querystring
+// functions handle differently. The callers fall back to JS when it shows up.
+bool ContainsReplacementCharacter(const char* input, size_t len) {
+  const char* const end = input + len;
+  while (len >= 3) {
+    const char* p = static_cast<const char*>(memchr(input, '\xef', len - 2));
+    if (p == nullptr)
+      return false;
+    if (p[1] == '\xbf' && p[2] == '\xbd')
+      return true;
+    input = p + 1;
+    len = end - input;
+  }
+  return false;
+}
+
 #define SPECIALS(XX)                                                          \
   XX(ftp, 21, "ftp:")                                                         \
   XX(file, -1, "file:")                                                       \
@@ -775,12 +973,84 @@ bool ToUnicode(const std::string& input, std::string* output) {
   return true;
 }
 
+// For domains that are made of ASCII characters and have no Punycode
+// labels, UTS #46 processing with the options that the URL Standard uses
+// only lowercases the input.
+bool ToASCIIWithoutIDNA(const std::string& input, std::string* output) {
+  for (size_t i = 0; i < input.size(); i++) {
+    const unsigned char ch = input[i];
+    if (ch >= 0x80)
+      return false;
+    if ((i == 0 || input[i - 1] == '.') && input.size() - i >= 4 &&
+        ASCIILowercase(input[i]) == 'x' &&
+        ASCIILowercase(input[i + 1]) == 'n' &&
+        input[i + 2] == '-' && input[i + 3] == '-') {
+      return false;
+    }
+  }
+  if (output != &input)
+    output->assign(input);
+  for (char& ch : *output)
+    ch = ASCIILowercase(ch);
+  return !output->empty();
+}
+
+// The results of ToASCII() for domains that need to go through ICU. Each
+// thread, and thus each Environment, has its own cache, so that no locking
+// is needed.
+class DomainToASCIICache {
+ public:
+  static constexpr size_t kMaxSize = 1024;
+  // Longer domains are rare enough to not be worth the memory.
+  static constexpr size_t kMaxDomainLength = 255;
+
+  // Returns nullptr if the domain is not in the cache. Otherwise the result
+  // is an empty string if ToASCII() fails for the domain.
+  const std::string* Get(const std::string& domain) {
+    auto it = map_.find(domain);
+    if (it == map_.end())
+      return nullptr;
+    list_.splice(list_.begin(), list_, it->second);
+    return &it->second->second;
+  }
+
+  void Set(const std::string& domain, const std::string& result) {
+    if (domain.size() > kMaxDomainLength)
+      return;
+    list_.emplace_front(domain, result);
+    map_[domain] = list_.begin();
+    if (map_.size() > kMaxSize) {
+      map_.erase(list_.back().first);
+      list_.pop_back();
+    }
+  }
+
+ private:
+  using Entry = std::pair<std::string, std::string>;
+  std::list<Entry> list_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> map_;
+};
+
+thread_local DomainToASCIICache domain_to_ascii_cache;
+
 bool ToASCII(const std::string& input, std::string* output) {
+  if (ToASCIIWithoutIDNA(input, output))
+    return true;
+
+  if (const std::string* cached = domain_to_ascii_cache.Get(input)) {
+    if (cached->empty())
+      return false;
+    output->assign(*cached);
+    return true;
+  }
+
   MaybeStackBuffer<char> buf;
-  if (i18n::ToASCII(&buf, input.c_str(), input.length()) < 0)
-    return false;
-  if (buf.length() == 0)
+  if (i18n::ToASCII(&buf, input.c_str(), input.length()) < 0 ||
+      buf.length() == 0) {
+    domain_to_ascii_cache.Set(input, std::string());
     return false;
+  }
+  domain_to_ascii_cache.Set(input, std::string(*buf, buf.length()));
   output->assign(*buf, buf.length());
   return true;
 }
@@ -2240,6 +2510,408 @@ void Parse(const FunctionCallbackInfo<Value>& args) {
         args[5]);
 }
 
+// Offsets that FastParse() stores into its Int32Array argument.
+enum FastParseOffset {
+  kFastParseFlags,
+  kFastParseSchemeEnd,    // The ':' after the scheme.
+  kFastParseHostStart,
+  kFastParseHostEnd,
+  kFastParsePort,         // -1 if there is no port or it is the default one.
+  kFastParsePathStart,    // The first '/' of the path, if there is one.
+  kFastParseQueryStart,   // The '?', or -1.
+  kFastParseFragmentStart,  // The '#', or -1.
+  kFastParseOffsetCount
+};
+
+// Returns true if all of the bytes are printable ASCII, other than '\'.
+// Leading and trailing spaces, tabs and newlines that the full parser
+// would remove, and any code points that it would have to percent-encode
+// or normalize above U+007E, fail this check.
+bool IsPrintableASCII(const uint8_t* data, size_t length) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i space = _mm_set1_epi8(0x20);
+  const __m128i del = _mm_set1_epi8(0x7f);
+  const __m128i back_slash = _mm_set1_epi8('\\');
+  for (; i + 16 <= length; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // Bytes >= 0x80 are negative and therefore not greater than a space.
+    const __m128i valid = _mm_andnot_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, del), _mm_cmpeq_epi8(v, back_slash)),
+        _mm_cmpgt_epi8(v, space));
+    if (_mm_movemask_epi8(valid) != 0xffff)
+      return false;
+  }
+#endif
+  for (; i < length; i++) {
+    if (data[i] <= 0x20 || data[i] >= 0x7f || data[i] == '\\')
+      return false;
+  }
+  return true;
+}
+
+bool IsDotSegment(const uint8_t* data, size_t length) {
+  if (length == 0 || length > 6 || (data[0] != '.' && data[0] != '%'))
+    return false;
+  const std::string segment(reinterpret_cast<const char*>(data), length);
+  return IsSingleDotSegment(segment) || IsDoubleDotSegment(segment);
+}
+
+// Parses the common form of absolute URLs, `scheme://host[:port][/path]
+// [?query][#fragment]` with a special scheme other than file:, a lowercase
+// ASCII domain and no characters that need to be percent-encoded, without
+// building url_data. For everything else this returns false and the full
+// parser has to be used; the result is the same in both cases.
+bool FastParse(const uint8_t* input,
+               size_t length,
+               int32_t offsets[kFastParseOffsetCount]) {
+  // Keep the offsets representable, long URLs aren't worth it anyway.
+  if (length > INT32_MAX || !IsPrintableASCII(input, length))
+    return false;
+
+  size_t i = 0;
+  while (i < length && input[i] >= 'a' && input[i] <= 'z')
+    i++;
+  if (i == 0 || length - i < 3 ||
+      input[i] != ':' || input[i + 1] != '/' || input[i + 2] != '/') {
+    return false;
+  }
+  const std::string scheme(reinterpret_cast<const char*>(input), i + 1);
+  if (!IsSpecial(scheme) || scheme == "file:")
+    return false;
+  offsets[kFastParseSchemeEnd] = i;
+
+  // The host is a domain made of non-empty labels of lowercase letters,
+  // digits and hyphens. Punycode labels have to be validated and a last
+  // label that starts with a digit may make it an IPv4 address.
+  i += 3;
+  const size_t host_start = i;
+  size_t label_start = i;
+  for (;; i++) {
+    const uint8_t ch = i < length ? input[i] : '/';
+    if ((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '-')
+      continue;
+    if (ch != '.' && ch != ':' && ch != '/' && ch != '?' && ch != '#')
+      return false;
+    if (i == label_start ||
+        (i - label_start >= 4 && input[label_start] == 'x' &&
+         input[label_start + 1] == 'n' && input[label_start + 2] == '-' &&
+         input[label_start + 3] == '-')) {
+      return false;
+    }
+    if (ch != '.') {
+      if (IsASCIIDigit(input[label_start]))
+        return false;
+      break;
+    }
+    label_start = i + 1;
+  }
+  offsets[kFastParseHostStart] = host_start;
+  offsets[kFastParseHostEnd] = i;
+
+  int32_t flags = URL_FLAGS_SPECIAL | URL_FLAGS_HAS_HOST | URL_FLAGS_HAS_PATH;
+  int port = -1;
+  if (i < length && input[i] == ':') {
+    const size_t port_start = ++i;
+    port = 0;
+    while (i < length && IsASCIIDigit(input[i]) && port <= 0xffff)
+      port = port * 10 + input[i++] - '0';
+    // Leading zeros are dropped when the port is serialized.
+    if (i == port_start || port > 0xffff ||
+        (input[port_start] == '0' && i - port_start > 1) ||
+        (i < length && input[i] != '/' && input[i] != '?' &&
+         input[i] != '#')) {
+      return false;
+    }
+    port = NormalizePort(scheme, port);
+    if (port == -1)
+      flags |= URL_FLAGS_IS_DEFAULT_SCHEME_PORT;
+  }
+  offsets[kFastParsePort] = port;
+
+  // Path segments must not be "." or "..", which would have to be removed.
+  offsets[kFastParsePathStart] = i;
+  if (i < length && input[i] == '/') {
+    size_t segment_start = ++i;
+    for (;; i++) {
+      const bool path_end = i == length || input[i] == '?' || input[i] == '#';
+      if (path_end || input[i] == '/') {
+        if (IsDotSegment(input + segment_start, i - segment_start))
+          return false;
+        if (path_end)
+          break;
+        segment_start = i + 1;
+      } else if (BitAt(PATH_ENCODE_SET, input[i])) {
+        return false;
+      }
+    }
+  }
+
+  offsets[kFastParseQueryStart] = -1;
+  if (i < length && input[i] == '?') {
+    flags |= URL_FLAGS_HAS_QUERY;
+    offsets[kFastParseQueryStart] = i;
+    for (i++; i < length && input[i] != '#'; i++) {
+      if (BitAt(QUERY_ENCODE_SET_SPECIAL, input[i]))
+        return false;
+    }
+  }
+
+  offsets[kFastParseFragmentStart] = -1;
+  if (i < length) {
+    flags |= URL_FLAGS_HAS_FRAGMENT;
+    offsets[kFastParseFragmentStart] = i;
+    for (i++; i < length; i++) {
+      if (BitAt(FRAGMENT_ENCODE_SET, input[i]))
+        return false;
+    }
+  }
+
+  offsets[kFastParseFlags] = flags;
+  return true;
+}
+
+// fastParse(input, offsets)
+// Returns true and fills `offsets`, an Int32Array, if FastParse() can
+// handle `input`.
+void FastParse(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsInt32Array());
+
+  Local<String> input = args[0].As<String>();
+  Local<Int32Array> offsets = args[1].As<Int32Array>();
+  CHECK_EQ(offsets->Length(), kFastParseOffsetCount);
+  if (!input->IsOneByte())
+    return args.GetReturnValue().Set(false);
+
+  MaybeStackBuffer<uint8_t, 1024> buffer(input->Length());
+  input->WriteOneByte(env->isolate(), buffer.out(), 0, input->Length(),
+                      String::NO_NULL_TERMINATION);
+  char* data = static_cast<char*>(offsets->Buffer()->GetBackingStore()->Data());
+  int32_t* out = reinterpret_cast<int32_t*>(data + offsets->ByteOffset());
+  args.GetReturnValue().Set(FastParse(buffer.out(), input->Length(), out));
+}
+
+// parseSearchParams(input)
+// Returns the names and values of an application/x-www-form-urlencoded
+// string as a flat array.
+void ParseSearchParams(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK(args[0]->IsString());
+
+  Utf8Value input(isolate, args[0]);
+  const char* p = *input;
+  const char* const end = p + input.length();
+  std::vector<Local<Value>> out;
+  std::string decoded;
+  auto push = [&](const char* start, const char* stop) {
+    const size_t len = stop - start;
+    const char* data = start;
+    if (FindFormEncoded(start, len) != len) {
+      DecodeFormComponent(start, len, true, &decoded);
+      data = decoded.data();
+    }
+    out.push_back(
+        String::NewFromUtf8(isolate,
+                            data,
+                            NewStringType::kNormal,
+                            data == start ? len : decoded.size())
+            .ToLocalChecked());
+  };
+
+  while (p < end) {
+    const char* amp = static_cast<const char*>(memchr(p, '&', end - p));
+    if (amp == nullptr)
+      amp = end;
+    if (amp != p) {
+      const char* eq = static_cast<const char*>(memchr(p, '=', amp - p));
+      if (eq == nullptr) {
+        push(p, amp);
+        out.push_back(String::Empty(isolate));
+      } else {
+        push(p, eq);
+        push(eq + 1, amp);
+      }
+    }
+    p = amp + 1;
+  }
+
+  args.GetReturnValue().Set(Array::New(isolate, out.data(), out.size()));
+}
+
+// serializeSearchParams(list)
+// Serializes a flat array of names and values.
+void SerializeSearchParams(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  CHECK(args[0]->IsArray());
+
+  Local<Array> list = args[0].As<Array>();
+  const uint32_t length = list->Length();
+  std::string output;
+  for (uint32_t i = 0; i < length; i++) {
+    Local<Value> value;
+    if (!list->Get(context, i).ToLocal(&value))
+      return;
+    if (i > 0)
+      output += (i & 1) ? '=' : '&';
+    Utf8Value utf8(isolate, value);
+    AppendFormEncoded(*utf8, utf8.length(), &output);
+  }
+  if (output.size() > static_cast<size_t>(String::kMaxLength))
+    return ThrowErrStringTooLong(isolate);
+  args.GetReturnValue().Set(
+      OneByteString(isolate, output.data(), output.size()));
+}
+
+// Percent-decodes a querystring key or value like querystring.unescape()
+// does. Returns false if the result would depend on how querystring.js
+// handles invalid input that contains non-ASCII characters.
+bool DecodeQueryStringComponent(const char* input,
+                                size_t len,
+                                std::string* out) {
+  DecodeFormComponent(input, len, true, out);
+  bool has_percent = false;
+  bool is_ascii = true;
+  bool has_invalid_escape = false;
+  for (size_t i = 0; i < len; i++) {
+    const unsigned char ch = input[i];
+    if (ch >= 0x80) {
+      is_ascii = false;
+    } else if (ch == '%') {
+      has_percent = true;
+      if (len - i < 3 ||
+          !IsASCIIHexDigit(input[i + 1]) ||
+          !IsASCIIHexDigit(input[i + 2])) {
+        has_invalid_escape = true;
+      }
+    }
+  }
+  // decodeURIComponent() rejects the input, and unescapeBuffer() then
+  // works on the low bytes of the UTF-16 code units.
+  if (has_percent && !is_ascii) {
+    return !has_invalid_escape &&
+           Utf8ValidPrefixLength(reinterpret_cast<const uint8_t*>(out->data()),
+                                 out->size()) == out->size();
+  }
+  return true;
+}
+
+// parseQueryString(input, sep, eq, maxKeys)
+// Returns the keys and values of a querystring with single-character ASCII
+// separators as a flat array, like querystring.parse() with the default
+// decoder. Returns undefined if querystring.js has to handle the input.
+void ParseQueryString(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsInt32());
+  CHECK(args[2]->IsInt32());
+  CHECK(args[3]->IsInt32());
+  const char sep = static_cast<char>(args[1].As<Int32>()->Value());
+  const char eq = static_cast<char>(args[2].As<Int32>()->Value());
+  // -1 means that there is no limit.
+  int64_t pairs = args[3].As<Int32>()->Value();
+
+  Utf8Value input(isolate, args[0]);
+  if (ContainsReplacementCharacter(*input, input.length()))
+    return;
+  const char* p = *input;
+  const char* const end = p + input.length();
+  std::vector<Local<Value>> out;
+  std::string decoded;
+  auto push = [&](const char* start, const char* stop) {
+    const size_t len = stop - start;
+    const char* data = start;
+    if (FindFormEncoded(start, len) != len) {
+      if (!DecodeQueryStringComponent(start, len, &decoded))
+        return false;
+      data = decoded.data();
+    }
+    out.push_back(
+        String::NewFromUtf8(isolate,
+                            data,
+                            NewStringType::kNormal,
+                            data == start ? len : decoded.size())
+            .ToLocalChecked());
+    return true;
+  };
+
+  while (p < end) {
+    const char* next = static_cast<const char*>(memchr(p, sep, end - p));
+    if (next == nullptr)
+      next = end;
+    if (next != p) {
+      const char* mid = static_cast<const char*>(memchr(p, eq, next - p));
+      if (mid == nullptr) {
+        if (!push(p, next))
+          return;
+        out.push_back(String::Empty(isolate));
+      } else if (!push(p, mid) || !push(mid + 1, next)) {
+        return;
+      }
+    }
+    // Empty pairs count towards maxKeys, too.
+    if (next == end || --pairs == 0)
+      break;
+    p = next + 1;
+  }
+
+  args.GetReturnValue().Set(Array::New(isolate, out.data(), out.size()));
+}
+
+// escapeQueryString(input)
+// Returns undefined if querystring.js has to handle the input.
+void EscapeQueryString(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  CHECK(args[0]->IsString());
+
+  Utf8Value input(isolate, args[0]);
+  if (ContainsReplacementCharacter(*input, input.length()))
+    return;
+  const size_t prefix =
+      QueryStringUnescapedPrefixLength(*input, input.length());
+  if (prefix == input.length())
+    return args.GetReturnValue().Set(args[0]);
+
+  std::string output;
+  output.reserve(input.length() + input.length() / 2);
+  output.append(*input, prefix);
+  AppendQueryStringEscaped(*input + prefix, input.length() - prefix, &output);
+  if (output.size() > static_cast<size_t>(String::kMaxLength))
+    return ThrowErrStringTooLong(isolate);
+  args.GetReturnValue().Set(
+      OneByteString(isolate, output.data(), output.size()));
+}
+
+// unescapeQueryStringBuffer(input, decodeSpaces)
+// Like querystring.unescapeBuffer(), only the low byte of each UTF-16 code
+// unit is used.
+void UnescapeQueryStringBuffer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());
+
+  Local<String> input = args[0].As<String>();
+  MaybeStackBuffer<uint8_t, 1024> buffer(input->Length());
+  input->WriteOneByte(env->isolate(), buffer.out(), 0, input->Length(),
+                      String::NO_NULL_TERMINATION);
+  std::string output;
+  DecodeFormComponent(reinterpret_cast<const char*>(buffer.out()),
+                      input->Length(),
+                      args[1]->IsTrue(),
+                      &output);
+  Local<Object> result;
+  if (Buffer::Copy(env->isolate(), output.data(), output.size())
+          .ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
 void EncodeAuthSet(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK_GE(args.Length(), 1);
@@ -2339,7 +3011,15 @@ void Initialize(Local<Object> target,
                 void* priv) {
   Environment* env = Environment::GetCurrent(context);
   env->SetMethod(target, "parse", Parse);
+  env->SetMethod(target, "fastParse", FastParse);
   env->SetMethodNoSideEffect(target, "encodeAuth", EncodeAuthSet);
+  env->SetMethodNoSideEffect(target, "parseSearchParams", ParseSearchParams);
+  env->SetMethodNoSideEffect(target, "serializeSearchParams",
+                             SerializeSearchParams);
+  env->SetMethodNoSideEffect(target, "parseQueryString", ParseQueryString);
+  env->SetMethodNoSideEffect(target, "escapeQueryString", EscapeQueryString);
+  env->SetMethodNoSideEffect(target, "unescapeQueryStringBuffer",
+                             UnescapeQueryStringBuffer);
   env->SetMethodNoSideEffect(target, "toUSVString", ToUSVString);
   env->SetMethodNoSideEffect(target, "domainToASCII", DomainToASCII);
   env->SetMethodNoSideEffect(target, "domainToUnicode", DomainToUnicode);
@@ -2357,7 +3037,13 @@ void Initialize(Local<Object> target,
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(Parse);
+  registry->Register(FastParse);
   registry->Register(EncodeAuthSet);
+  registry->Register(ParseSearchParams);
+  registry->Register(SerializeSearchParams);
+  registry->Register(ParseQueryString);
+  registry->Register(EscapeQueryString);
+  registry->Register(UnescapeQueryStringBuffer);
   registry->Register(ToUSVString);
   registry->Register(DomainToASCII);
   registry->Register(DomainToUnicode);
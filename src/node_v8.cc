@@ -197,6 +197,10 @@ void SetFlagsFromString(const FunctionCallbackInfo<Value>& args) {
   V8::SetFlagsFromString(*flags, static_cast<size_t>(flags.length()));
 }
 
+void RequestIdleGC(const FunctionCallbackInfo<Value>& args) {
+  Environment::GetCurrent(args)->RequestIdleGC();
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -249,6 +253,7 @@ void Initialize(Local<Object> target,
 
   // Export symbols used by v8.setFlagsFromString()
   env->SetMethod(target, "setFlagsFromString", SetFlagsFromString);
+  env->SetMethod(target, "requestIdleGC", RequestIdleGC);
 }
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
@@ -257,6 +262,7 @@ void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(UpdateHeapCodeStatisticsBuffer);
   registry->Register(UpdateHeapSpaceStatisticsBuffer);
   registry->Register(SetFlagsFromString);
+  registry->Register(RequestIdleGC);
 }
 
 }  // namespace v8_utils
@@ -101,6 +101,8 @@ struct V8Platform {
     }
     // Tracing must be initialized before platform threads are created.
     platform_ = new NodePlatform(thread_pool_size, controller);
+    platform_->set_idle_task_time(
+        per_process::cli_options->idle_gc_time / 1e3);
     v8::V8::InitializePlatform(platform_);
   }
 
@@ -135,7 +137,8 @@ struct V8Platform {
                                 std::make_move_iterator(categories.end())),
           std::unique_ptr<tracing::AsyncTraceWriter>(
               new tracing::NodeTraceWriter(
-                  per_process::cli_options->trace_event_file_pattern)),
+                  per_process::cli_options->trace_event_file_pattern,
+                  per_process::cli_options->trace_event_file_gzip)),
           tracing::Agent::kUseDefaultCategories);
     }
   }
@@ -10,6 +10,10 @@
 #include "uvwasi.h"
 #include "node_wasi.h"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 namespace node {
 namespace wasi {
 
@@ -72,6 +76,15 @@ inline void Debug(WASI* wasi, Args&&... args) {
     }                                                                         \
   } while (0)
 
+#define CHECK_ARRAY_BOUNDS_OR_RETURN(args, mem_size, offset, size, count)     \
+  do {                                                                        \
+    if (!uvwasi_serdes_check_array_bounds(                                    \
+            (offset), (mem_size), (size), (count))) {                         \
+      (args).GetReturnValue().Set(UVWASI_EOVERFLOW);                          \
+      return;                                                                 \
+    }                                                                         \
+  } while (0)
+
 
 using v8::Array;
 using v8::ArrayBuffer;
@@ -89,6 +102,7 @@ using v8::Object;
 using v8::String;
 using v8::Uint32;
 using v8::Value;
+using v8::WasmMemoryObject;
 
 
 static MaybeLocal<Value> WASIException(Local<Context> context,
@@ -122,7 +136,10 @@ static MaybeLocal<Value> WASIException(Local<Context> context,
 
 WASI::WASI(Environment* env,
            Local<Object> object,
-           uvwasi_options_t* options) : BaseObject(env, object) {
+           uvwasi_options_t* options,
+           bool map_read_only_files)
+    : BaseObject(env, object),
+      map_read_only_files_(map_read_only_files) {
   MakeWeak();
   alloc_info_ = MakeAllocator();
   options->allocator = &alloc_info_;
@@ -138,12 +155,15 @@ WASI::WASI(Environment* env,
 
 
 WASI::~WASI() {
+  while (!mapped_files_.empty())
+    UnmapFile(mapped_files_.begin()->first);
   uvwasi_destroy(&uvw_);
   CHECK_EQ(current_uvwasi_memory_, 0);
 }
 
 void WASI::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("memory", memory_);
+  tracker->TrackField("memory_buffer", memory_buffer_);
   tracker->TrackFieldWithSize("uvwasi_memory", current_uvwasi_memory_);
 }
 
@@ -161,11 +181,12 @@ void WASI::DecreaseAllocatedSize(size_t size) {
 
 void WASI::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
-  CHECK_EQ(args.Length(), 4);
+  CHECK_EQ(args.Length(), 5);
   CHECK(args[0]->IsArray());
   CHECK(args[1]->IsArray());
   CHECK(args[2]->IsArray());
   CHECK(args[3]->IsArray());
+  CHECK(args[4]->IsBoolean());
 
   Environment* env = Environment::GetCurrent(args);
   Local<Context> context = env->context();
@@ -228,7 +249,7 @@ void WASI::New(const FunctionCallbackInfo<Value>& args) {
     index++;
   }
 
-  new WASI(env, args.This(), &options);
+  new WASI(env, args.This(), &options, args[4]->IsTrue());
 
   if (options.argv != nullptr) {
     for (uint32_t i = 0; i < argc; i++)
@@ -269,10 +290,11 @@ void WASI::ArgsGet(const FunctionCallbackInfo<Value>& args) {
                          mem_size,
                          argv_buf_offset,
                          wasi->uvw_.argv_buf_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         argv_offset,
-                         wasi->uvw_.argc * UVWASI_SERDES_SIZE_uint32_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               argv_offset,
+                               UVWASI_SERDES_SIZE_uint32_t,
+                               wasi->uvw_.argc);
   std::vector<char*> argv(wasi->uvw_.argc);
   char* argv_buf = &memory[argv_buf_offset];
   uvwasi_errno_t err = uvwasi_args_get(&wasi->uvw_, argv.data(), argv_buf);
@@ -399,10 +421,11 @@ void WASI::EnvironGet(const FunctionCallbackInfo<Value>& args) {
                          mem_size,
                          environ_buf_offset,
                          wasi->uvw_.env_buf_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         environ_offset,
-                         wasi->uvw_.envc * UVWASI_SERDES_SIZE_uint32_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               environ_offset,
+                               UVWASI_SERDES_SIZE_uint32_t,
+                               wasi->uvw_.envc);
   std::vector<char*> environment(wasi->uvw_.envc);
   char* environ_buf = &memory[environ_buf_offset];
   uvwasi_errno_t err = uvwasi_environ_get(&wasi->uvw_,
@@ -501,6 +524,8 @@ void WASI::FdClose(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_INITIALIZED_OR_RETURN_UNWRAP(&wasi, args.This());
   Debug(wasi, "fd_close(%d)\n", fd);
   uvwasi_errno_t err = uvwasi_fd_close(&wasi->uvw_, fd);
+  if (err == UVWASI_ESUCCESS)
+    wasi->UnmapFile(fd);
   args.GetReturnValue().Set(err);
 }
 
@@ -573,6 +598,9 @@ void WASI::FdFdstatSetRights(const FunctionCallbackInfo<Value>& args) {
                                                    fd,
                                                    fs_rights_base,
                                                    fs_rights_inheriting);
+  // The rights can only be dropped, and fd_pread() may no longer be allowed.
+  if (err == UVWASI_ESUCCESS)
+    wasi->UnmapFile(fd);
   args.GetReturnValue().Set(err);
 }
 
@@ -665,18 +693,19 @@ void WASI::FdPread(const FunctionCallbackInfo<Value>& args) {
         offset,
         nread_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         iovs_ptr,
-                         iovs_len * UVWASI_SERDES_SIZE_iovec_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               iovs_ptr,
+                               UVWASI_SERDES_SIZE_iovec_t,
+                               iovs_len);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, nread_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_iovec_t> iovs(iovs_len);
+  MaybeStackBuffer<uvwasi_iovec_t, 16> iovs(iovs_len);
   uvwasi_errno_t err;
 
   err = uvwasi_serdes_readv_iovec_t(memory,
                                     mem_size,
                                     iovs_ptr,
-                                    iovs.data(),
+                                    iovs.out(),
                                     iovs_len);
   if (err != UVWASI_ESUCCESS) {
     args.GetReturnValue().Set(err);
@@ -684,7 +713,24 @@ void WASI::FdPread(const FunctionCallbackInfo<Value>& args) {
   }
 
   uvwasi_size_t nread;
-  err = uvwasi_fd_pread(&wasi->uvw_, fd, iovs.data(), iovs_len, offset, &nread);
+  auto mapped_file = wasi->mapped_files_.find(fd);
+  if (mapped_file != wasi->mapped_files_.end()) {
+    const MappedFile& file = mapped_file->second;
+    nread = 0;
+    for (uint32_t i = 0; i < iovs_len && offset < file.size; i++) {
+      size_t length = std::min<uint64_t>(iovs[i].buf_len, file.size - offset);
+      memcpy(iovs[i].buf, file.data + offset, length);
+      offset += length;
+      nread += length;
+    }
+  } else {
+    err = uvwasi_fd_pread(&wasi->uvw_,
+                          fd,
+                          iovs.out(),
+                          iovs_len,
+                          offset,
+                          &nread);
+  }
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory, nread_ptr, nread);
 
@@ -762,21 +808,22 @@ void WASI::FdPwrite(const FunctionCallbackInfo<Value>& args) {
         offset,
         nwritten_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         iovs_ptr,
-                         iovs_len * UVWASI_SERDES_SIZE_ciovec_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               iovs_ptr,
+                               UVWASI_SERDES_SIZE_ciovec_t,
+                               iovs_len);
   CHECK_BOUNDS_OR_RETURN(args,
                          mem_size,
                          nwritten_ptr,
                          UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_ciovec_t> iovs(iovs_len);
+  MaybeStackBuffer<uvwasi_ciovec_t, 16> iovs(iovs_len);
   uvwasi_errno_t err;
 
   err = uvwasi_serdes_readv_ciovec_t(memory,
                                      mem_size,
                                      iovs_ptr,
-                                     iovs.data(),
+                                     iovs.out(),
                                      iovs_len);
   if (err != UVWASI_ESUCCESS) {
     args.GetReturnValue().Set(err);
@@ -786,7 +833,7 @@ void WASI::FdPwrite(const FunctionCallbackInfo<Value>& args) {
   uvwasi_size_t nwritten;
   err = uvwasi_fd_pwrite(&wasi->uvw_,
                          fd,
-                         iovs.data(),
+                         iovs.out(),
                          iovs_len,
                          offset,
                          &nwritten);
@@ -813,18 +860,19 @@ void WASI::FdRead(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_INITIALIZED_OR_RETURN_UNWRAP(&wasi, args.This());
   Debug(wasi, "fd_read(%d, %d, %d, %d)\n", fd, iovs_ptr, iovs_len, nread_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         iovs_ptr,
-                         iovs_len * UVWASI_SERDES_SIZE_iovec_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               iovs_ptr,
+                               UVWASI_SERDES_SIZE_iovec_t,
+                               iovs_len);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, nread_ptr, UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_iovec_t> iovs(iovs_len);
+  MaybeStackBuffer<uvwasi_iovec_t, 16> iovs(iovs_len);
   uvwasi_errno_t err;
 
   err = uvwasi_serdes_readv_iovec_t(memory,
                                     mem_size,
                                     iovs_ptr,
-                                    iovs.data(),
+                                    iovs.out(),
                                     iovs_len);
   if (err != UVWASI_ESUCCESS) {
     args.GetReturnValue().Set(err);
@@ -832,7 +880,7 @@ void WASI::FdRead(const FunctionCallbackInfo<Value>& args) {
   }
 
   uvwasi_size_t nread;
-  err = uvwasi_fd_read(&wasi->uvw_, fd, iovs.data(), iovs_len, &nread);
+  err = uvwasi_fd_read(&wasi->uvw_, fd, iovs.out(), iovs_len, &nread);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory, nread_ptr, nread);
 
@@ -893,6 +941,14 @@ void WASI::FdRenumber(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_INITIALIZED_OR_RETURN_UNWRAP(&wasi, args.This());
   Debug(wasi, "fd_renumber(%d, %d)\n", from, to);
   uvwasi_errno_t err = uvwasi_fd_renumber(&wasi->uvw_, from, to);
+  if (err == UVWASI_ESUCCESS && from != to) {
+    wasi->UnmapFile(to);
+    auto it = wasi->mapped_files_.find(from);
+    if (it != wasi->mapped_files_.end()) {
+      wasi->mapped_files_.emplace(to, it->second);
+      wasi->mapped_files_.erase(it);
+    }
+  }
   args.GetReturnValue().Set(err);
 }
 
@@ -989,21 +1045,22 @@ void WASI::FdWrite(const FunctionCallbackInfo<Value>& args) {
         iovs_len,
         nwritten_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         iovs_ptr,
-                         iovs_len * UVWASI_SERDES_SIZE_ciovec_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               iovs_ptr,
+                               UVWASI_SERDES_SIZE_ciovec_t,
+                               iovs_len);
   CHECK_BOUNDS_OR_RETURN(args,
                          mem_size,
                          nwritten_ptr,
                          UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_ciovec_t> iovs(iovs_len);
+  MaybeStackBuffer<uvwasi_ciovec_t, 16> iovs(iovs_len);
   uvwasi_errno_t err;
 
   err = uvwasi_serdes_readv_ciovec_t(memory,
                                      mem_size,
                                      iovs_ptr,
-                                     iovs.data(),
+                                     iovs.out(),
                                      iovs_len);
   if (err != UVWASI_ESUCCESS) {
     args.GetReturnValue().Set(err);
@@ -1011,7 +1068,7 @@ void WASI::FdWrite(const FunctionCallbackInfo<Value>& args) {
   }
 
   uvwasi_size_t nwritten;
-  err = uvwasi_fd_write(&wasi->uvw_, fd, iovs.data(), iovs_len, &nwritten);
+  err = uvwasi_fd_write(&wasi->uvw_, fd, iovs.out(), iovs_len, &nwritten);
   if (err == UVWASI_ESUCCESS)
     uvwasi_serdes_write_size_t(memory, nwritten_ptr, nwritten);
 
@@ -1219,8 +1276,11 @@ void WASI::PathOpen(const FunctionCallbackInfo<Value>& args) {
                                         fs_rights_inheriting,
                                         static_cast<uvwasi_fdflags_t>(fs_flags),
                                         &fd);
-  if (err == UVWASI_ESUCCESS)
+  if (err == UVWASI_ESUCCESS) {
     uvwasi_serdes_write_size_t(memory, fd_ptr, fd);
+    if (wasi->map_read_only_files_)
+      wasi->MaybeMapFile(fd);
+  }
 
   args.GetReturnValue().Set(err);
 }
@@ -1417,14 +1477,16 @@ void WASI::PollOneoff(const FunctionCallbackInfo<Value>& args) {
         nsubscriptions,
         nevents_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         in_ptr,
-                         nsubscriptions * UVWASI_SERDES_SIZE_subscription_t);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         out_ptr,
-                         nsubscriptions * UVWASI_SERDES_SIZE_event_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               in_ptr,
+                               UVWASI_SERDES_SIZE_subscription_t,
+                               nsubscriptions);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               out_ptr,
+                               UVWASI_SERDES_SIZE_event_t,
+                               nsubscriptions);
   CHECK_BOUNDS_OR_RETURN(args,
                          mem_size,
                          nevents_ptr,
@@ -1536,17 +1598,18 @@ void WASI::SockRecv(const FunctionCallbackInfo<Value>& args) {
         ro_datalen_ptr,
         ro_flags_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         ri_data_ptr,
-                         ri_data_len * UVWASI_SERDES_SIZE_iovec_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               ri_data_ptr,
+                               UVWASI_SERDES_SIZE_iovec_t,
+                               ri_data_len);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, ro_datalen_ptr, 4);
   CHECK_BOUNDS_OR_RETURN(args, mem_size, ro_flags_ptr, 4);
-  std::vector<uvwasi_iovec_t> ri_data(ri_data_len);
+  MaybeStackBuffer<uvwasi_iovec_t, 16> ri_data(ri_data_len);
   uvwasi_errno_t err = uvwasi_serdes_readv_iovec_t(memory,
                                                    mem_size,
                                                    ri_data_ptr,
-                                                   ri_data.data(),
+                                                   ri_data.out(),
                                                    ri_data_len);
   if (err != UVWASI_ESUCCESS) {
     args.GetReturnValue().Set(err);
@@ -1557,7 +1620,7 @@ void WASI::SockRecv(const FunctionCallbackInfo<Value>& args) {
   uvwasi_roflags_t ro_flags;
   err = uvwasi_sock_recv(&wasi->uvw_,
                          sock,
-                         ri_data.data(),
+                         ri_data.out(),
                          ri_data_len,
                          ri_flags,
                          &ro_datalen,
@@ -1595,19 +1658,20 @@ void WASI::SockSend(const FunctionCallbackInfo<Value>& args) {
         si_flags,
         so_datalen_ptr);
   GET_BACKING_STORE_OR_RETURN(wasi, args, &memory, &mem_size);
-  CHECK_BOUNDS_OR_RETURN(args,
-                         mem_size,
-                         si_data_ptr,
-                         si_data_len * UVWASI_SERDES_SIZE_ciovec_t);
+  CHECK_ARRAY_BOUNDS_OR_RETURN(args,
+                               mem_size,
+                               si_data_ptr,
+                               UVWASI_SERDES_SIZE_ciovec_t,
+                               si_data_len);
   CHECK_BOUNDS_OR_RETURN(args,
                          mem_size,
                          so_datalen_ptr,
                          UVWASI_SERDES_SIZE_size_t);
-  std::vector<uvwasi_ciovec_t> si_data(si_data_len);
+  MaybeStackBuffer<uvwasi_ciovec_t, 16> si_data(si_data_len);
   uvwasi_errno_t err = uvwasi_serdes_readv_ciovec_t(memory,
                                                     mem_size,
                                                     si_data_ptr,
-                                                    si_data.data(),
+                                                    si_data.out(),
                                                     si_data_len);
   if (err != UVWASI_ESUCCESS) {
     args.GetReturnValue().Set(err);
@@ -1617,7 +1681,7 @@ void WASI::SockSend(const FunctionCallbackInfo<Value>& args) {
   uvwasi_size_t so_datalen;
   err = uvwasi_sock_send(&wasi->uvw_,
                          sock,
-                         si_data.data(),
+                         si_data.out(),
                          si_data_len,
                          si_flags,
                          &so_datalen);
@@ -1648,6 +1712,55 @@ void WASI::_SetMemory(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   ASSIGN_OR_RETURN_UNWRAP(&wasi, args.This());
   wasi->memory_.Reset(wasi->env()->isolate(), args[0].As<Object>());
+  wasi->memory_buffer_.Reset();
+}
+
+
+void WASI::MaybeMapFile(uvwasi_fd_t fd) {
+#ifndef _WIN32
+  constexpr uvwasi_rights_t kReadRights =
+      UVWASI_RIGHT_FD_READ | UVWASI_RIGHT_FD_SEEK;
+  constexpr uvwasi_rights_t kWriteRights =
+      UVWASI_RIGHT_FD_WRITE | UVWASI_RIGHT_FD_ALLOCATE |
+      UVWASI_RIGHT_FD_FILESTAT_SET_SIZE;
+  uvwasi_fdstat_t fdstat;
+  int host_fd;
+  if (uvwasi_fd_fdstat_get(&uvw_, fd, &fdstat) != UVWASI_ESUCCESS ||
+      fdstat.fs_filetype != UVWASI_FILETYPE_REGULAR_FILE ||
+      (fdstat.fs_rights_base & kReadRights) != kReadRights ||
+      (fdstat.fs_rights_base & kWriteRights) != 0 ||
+      uvwasi_embedder_get_host_fd(&uvw_, fd, &host_fd) != UVWASI_ESUCCESS) {
+    return;
+  }
+
+  uv_fs_t req;
+  int err = uv_fs_fstat(nullptr, &req, host_fd, nullptr);
+  uint64_t size = req.statbuf.st_size;
+  uv_fs_req_cleanup(&req);
+  if (err < 0 || size > std::numeric_limits<size_t>::max())
+    return;
+
+  char* data = nullptr;
+  if (size > 0) {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, host_fd, 0);
+    if (mapping == MAP_FAILED)
+      return;
+    data = static_cast<char*>(mapping);
+  }
+  Debug(this, "mapped %d bytes of fd %d\n", size, fd);
+  mapped_files_[fd] = MappedFile { data, static_cast<size_t>(size) };
+#endif  // _WIN32
+}
+
+void WASI::UnmapFile(uvwasi_fd_t fd) {
+  auto it = mapped_files_.find(fd);
+  if (it == mapped_files_.end())
+    return;
+#ifndef _WIN32
+  if (it->second.data != nullptr)
+    munmap(it->second.data, it->second.size);
+#endif  // _WIN32
+  mapped_files_.erase(it);
 }
 
 
@@ -1656,6 +1769,23 @@ uvwasi_errno_t WASI::backingStore(char** store, size_t* byte_length) {
   Local<Object> memory = PersistentToLocal::Strong(this->memory_);
   Local<Value> prop;
 
+  // This runs for every system call, so the buffer of a WebAssembly.Memory is
+  // read directly instead of through the `buffer` getter, and its contents
+  // are only looked up again when the buffer changes.
+  if (memory->IsWasmMemoryObject()) {
+    Local<ArrayBuffer> ab = memory.As<WasmMemoryObject>()->Buffer();
+    if (memory_buffer_ != ab) {
+      std::shared_ptr<BackingStore> backing_store = ab->GetBackingStore();
+      memory_buffer_.Reset(env->isolate(), ab);
+      memory_data_ = static_cast<char*>(backing_store->Data());
+      memory_length_ = backing_store->ByteLength();
+      CHECK_NOT_NULL(memory_data_);
+    }
+    *store = memory_data_;
+    *byte_length = memory_length_;
+    return UVWASI_ESUCCESS;
+  }
+
   if (!memory->Get(env->context(), env->buffer_string()).ToLocal(&prop))
     return UVWASI_EINVAL;
 
@@ -7,6 +7,8 @@
 #include "node_mem.h"
 #include "uvwasi.h"
 
+#include <unordered_map>
+
 namespace node {
 namespace wasi {
 
@@ -16,7 +18,8 @@ class WASI : public BaseObject,
  public:
   WASI(Environment* env,
        v8::Local<v8::Object> object,
-       uvwasi_options_t* options);
+       uvwasi_options_t* options,
+       bool map_read_only_files);
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   void MemoryInfo(MemoryTracker* tracker) const override;
@@ -93,10 +96,26 @@ class WASI : public BaseObject,
   inline void writeUInt32(char* memory, uint32_t value, uint32_t offset);
   inline void writeUInt64(char* memory, uint64_t value, uint32_t offset);
   uvwasi_errno_t backingStore(char** store, size_t* byte_length);
+  // Maps the file into memory if it is a regular file that the guest can only
+  // read from, so that fd_pread() can copy from the mapping.
+  void MaybeMapFile(uvwasi_fd_t fd);
+  void UnmapFile(uvwasi_fd_t fd);
   uvwasi_t uvw_;
   v8::Global<v8::Object> memory_;
+  // The buffer of memory_ when it is a WebAssembly.Memory, and its contents,
+  // which stay the same until the memory grows and replaces its buffer.
+  v8::Global<v8::ArrayBuffer> memory_buffer_;
+  char* memory_data_ = nullptr;
+  size_t memory_length_ = 0;
   uvwasi_mem_t alloc_info_;
   size_t current_uvwasi_memory_ = 0;
+
+  struct MappedFile {
+    char* data;
+    size_t size;
+  };
+  bool map_read_only_files_;
+  std::unordered_map<uvwasi_fd_t, MappedFile> mapped_files_;
 };
 
 
@@ -5,6 +5,7 @@
 #include "node_errors.h"
 #include "node_external_reference.h"
 #include "node_buffer.h"
+#include "node_main_instance.h"
 #include "node_options-inl.h"
 #include "node_perf.h"
 #include "util-inl.h"
@@ -23,13 +24,18 @@ using v8::Context;
 using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::GCCallbackFlags;
+using v8::GCType;
 using v8::HandleScope;
+using v8::HeapStatistics;
+using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::Locker;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::MemoryPressureLevel;
 using v8::Null;
 using v8::Number;
 using v8::Object;
@@ -148,6 +154,26 @@ class WorkerThreadData {
 
     w->UpdateResourceConstraints(&params.constraints);
 
+    // Start from the embedded snapshot, which is only possible if the main
+    // thread was deserialized from a snapshot as well. Workers do not use
+    // a user-land snapshot that the main thread was started from.
+    const std::vector<intptr_t>* external_references =
+        NodeMainInstance::GetExternalReferences();
+    v8::StartupData* blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
+    const std::vector<size_t>* indexes = nullptr;
+    bool no_node_snapshot =
+        w->per_isolate_opts_ ? w->per_isolate_opts_->no_node_snapshot
+                             : per_process::cli_options->per_isolate
+                                   ->no_node_snapshot;
+    if (external_references != nullptr && blob != nullptr &&
+        !no_node_snapshot) {
+      params.snapshot_blob = blob;
+      params.external_references = external_references->data();
+      indexes = NodeMainInstance::GetIsolateDataIndexes();
+      deserialize_mode_ = true;
+    }
+
+    isolate_start_time_ = PERFORMANCE_NOW();
     Isolate* isolate = Isolate::Allocate();
     if (isolate == nullptr) {
       // TODO(addaleax): This should be ERR_WORKER_INIT_FAILED,
@@ -158,12 +184,20 @@ class WorkerThreadData {
 
     w->platform_->RegisterIsolate(isolate, &loop_);
     Isolate::Initialize(isolate, params);
-    SetIsolateUpForNode(isolate);
+    if (deserialize_mode_) {
+      // The error handlers are set up once the context has been
+      // deserialized, as in the main thread.
+      SetIsolateMiscHandlers(isolate, {});
+    } else {
+      SetIsolateUpForNode(isolate);
+    }
 
     // Be sure it's called before Environment::InitializeDiagnostics()
     // so that this callback stays when the callback of
     // --heapsnapshot-near-heap-limit gets is popped.
     isolate->AddNearHeapLimitCallback(Worker::NearHeapLimit, w);
+    if (w->heap_growth_report_bytes_ > 0)
+      isolate->AddGCEpilogueCallback(Worker::ReportHeapGrowth, w);
 
     {
       Locker locker(isolate);
@@ -173,10 +207,11 @@ class WorkerThreadData {
       isolate->SetStackLimit(w->stack_base_);
 
       HandleScope handle_scope(isolate);
-      isolate_data_.reset(CreateIsolateData(isolate,
-                                            &loop_,
-                                            w_->platform_,
-                                            allocator.get()));
+      isolate_data_.reset(new IsolateData(isolate,
+                                          &loop_,
+                                          w_->platform_,
+                                          allocator.get(),
+                                          indexes));
       CHECK(isolate_data_);
       if (w_->per_isolate_opts_)
         isolate_data_->set_options(std::move(w_->per_isolate_opts_));
@@ -232,6 +267,8 @@ class WorkerThreadData {
   Worker* const w_;
   uv_loop_t loop_;
   bool loop_init_failed_ = true;
+  bool deserialize_mode_ = false;
+  uint64_t isolate_start_time_ = 0;
   DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data_;
 
   friend class Worker;
@@ -247,7 +284,49 @@ size_t Worker::NearHeapLimit(void* data, size_t current_heap_limit,
   return current_heap_limit + kExtraHeapAllowance;
 }
 
+void Worker::ReportHeapGrowth(Isolate* isolate,
+                              GCType type,
+                              GCCallbackFlags flags,
+                              void* data) {
+  Worker* w = static_cast<Worker*>(data);
+  HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+  size_t used = stats.used_heap_size();
+  // Growth is measured from the lowest size seen since the last report, so
+  // that a heap that shrinks and grows again is reported again.
+  if (used < w->reported_heap_size_) {
+    w->reported_heap_size_ = used;
+    return;
+  }
+  if (used - w->reported_heap_size_ < w->heap_growth_report_bytes_)
+    return;
+  w->reported_heap_size_ = used;
+
+  // The callback that deletes the Worker object is only scheduled once the
+  // thread has stopped, i.e. after this one.
+  double used_heap_size = static_cast<double>(used);
+  double heap_size_limit = static_cast<double>(stats.heap_size_limit());
+  w->env()->SetImmediateThreadsafe(
+      [w, used_heap_size, heap_size_limit](Environment* env) {
+        HandleScope handle_scope(env->isolate());
+        Context::Scope context_scope(env->context());
+        Local<Value> args[] = {
+          Number::New(env->isolate(), used_heap_size),
+          Number::New(env->isolate(), heap_size_limit)
+        };
+        w->MakeCallback(env->onheapgrowth_string(), arraysize(args), args);
+      }, CallbackFlags::kUnrefed);
+}
+
+void Worker::NotifyMemoryPressure(MemoryPressureLevel level) {
+  Mutex::ScopedLock lock(mutex_);
+  // V8 turns this into an interrupt when it is called from another thread.
+  if (isolate_ != nullptr)
+    isolate_->MemoryPressureNotification(level);
+}
+
 void Worker::Run() {
+  const uint64_t start_time = PERFORMANCE_NOW();
   std::string name = "WorkerThread ";
   name += std::to_string(thread_id_.id);
   TRACE_EVENT_METADATA1(
@@ -255,6 +334,16 @@ void Worker::Run() {
       TRACE_STR_COPY(name.c_str()));
   CHECK_NOT_NULL(platform_);
 
+  if (!cpu_affinity_.empty()) {
+    int err = SetCurrentThreadAffinity(cpu_affinity_);
+    if (err != 0) {
+      std::string message = "Failed to set the CPU affinity: ";
+      message += uv_strerror(err);
+      Exit(1, "ERR_WORKER_INIT_FAILED", message.c_str());
+      return;
+    }
+  }
+
   Debug(this, "Creating isolate for worker with id %llu", thread_id_.id);
 
   WorkerThreadData data(this);
@@ -296,7 +385,16 @@ void Worker::Run() {
         // resource constraints, we need something in place to handle it,
         // though.
         TryCatch try_catch(isolate_);
-        context = NewContext(isolate_);
+        if (data.deserialize_mode_) {
+          if (Context::FromSnapshot(isolate_,
+                                    NodeMainInstance::kNodeBaseContextIndex)
+                  .ToLocal(&context)) {
+            InitializeContextRuntime(context);
+            SetIsolateErrorHandlers(isolate_, {});
+          }
+        } else {
+          context = NewContext(isolate_);
+        }
         if (context.IsEmpty()) {
           // TODO(addaleax): This should be ERR_WORKER_INIT_FAILED,
           // ERR_WORKER_OUT_OF_MEMORY is for reaching the per-Worker heap limit.
@@ -309,6 +407,10 @@ void Worker::Run() {
       CHECK(!context.IsEmpty());
       Context::Scope context_scope(context);
       {
+        // A context from the snapshot has not run any JS yet, so bootstrapping
+        // can fail e.g. with a small stack size. The exception must not reach
+        // the process-wide handlers while the Environment is not set up.
+        TryCatch try_catch(isolate_);
         env_.reset(CreateEnvironment(
             data.isolate_data_.get(),
             context,
@@ -318,7 +420,17 @@ void Worker::Run() {
             thread_id_,
             std::move(inspector_parent_handle_)));
         if (is_stopped()) return;
-        CHECK_NOT_NULL(env_);
+        if (!env_) {
+          Exit(1, "ERR_WORKER_INIT_FAILED", "Failed to bootstrap the Worker");
+          return;
+        }
+        // The process-wide milestones are not meaningful for Workers, so
+        // report when the thread and its isolate were started instead.
+        env_->performance_state()->Mark(
+            performance::NODE_PERFORMANCE_MILESTONE_NODE_START, start_time);
+        env_->performance_state()->Mark(
+            performance::NODE_PERFORMANCE_MILESTONE_V8_START,
+            data.isolate_start_time_);
         env_->set_env_vars(std::move(env_vars_));
         SetProcessExitHandler(env_.get(), [this](Environment*, int exit_code) {
           Exit(exit_code);
@@ -562,6 +674,21 @@ void Worker::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[4]->IsBoolean());
   if (args[4]->IsTrue() || env->tracks_unmanaged_fds())
     worker->environment_flags_ |= EnvironmentFlags::kTrackUnmanagedFds;
+
+  if (args[5]->IsArray()) {
+    Local<Array> cpus = args[5].As<Array>();
+    for (uint32_t i = 0; i < cpus->Length(); i++) {
+      Local<Value> cpu;
+      if (!cpus->Get(env->context(), i).ToLocal(&cpu)) return;
+      CHECK(cpu->IsInt32());
+      worker->cpu_affinity_.push_back(cpu.As<Int32>()->Value());
+    }
+  }
+
+  if (args[6]->IsNumber()) {
+    worker->heap_growth_report_bytes_ =
+        static_cast<size_t>(args[6].As<Number>()->Value() * kMB);
+  }
 }
 
 void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
@@ -795,6 +922,16 @@ void GetEnvMessagePort(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Tell V8 in this thread and in all Workers started by it that memory is
+// running low.
+void NotifyMemoryPressure(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  MemoryPressureLevel level = args[0]->IsTrue() ?
+      MemoryPressureLevel::kCritical : MemoryPressureLevel::kModerate;
+  env->isolate()->MemoryPressureNotification(level);
+  env->ForEachWorker([&](Worker* w) { w->NotifyMemoryPressure(level); });
+}
+
 void InitWorker(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -834,6 +971,7 @@ void InitWorker(Local<Object> target,
   }
 
   env->SetMethod(target, "getEnvMessagePort", GetEnvMessagePort);
+  env->SetMethod(target, "notifyMemoryPressure", NotifyMemoryPressure);
 
   target
       ->Set(env->context(),
@@ -870,6 +1008,7 @@ void InitWorker(Local<Object> target,
 
 void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
   registry->Register(GetEnvMessagePort);
+  registry->Register(NotifyMemoryPressure);
   registry->Register(Worker::New);
   registry->Register(Worker::StartThread);
   registry->Register(Worker::StopThread);
@@ -47,6 +47,10 @@ class Worker : public AsyncWrap {
   template <typename Fn>
   inline bool RequestInterrupt(Fn&& cb);
 
+  // Tell V8 in the worker thread that memory is running low. This may be
+  // called from any thread.
+  void NotifyMemoryPressure(v8::MemoryPressureLevel level);
+
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(Worker)
   SET_SELF_SIZE(Worker)
@@ -73,10 +77,16 @@ class Worker : public AsyncWrap {
   void CreateEnvMessagePort(Environment* env);
   static size_t NearHeapLimit(void* data, size_t current_heap_limit,
                               size_t initial_heap_limit);
+  static void ReportHeapGrowth(v8::Isolate* isolate,
+                               v8::GCType type,
+                               v8::GCCallbackFlags flags,
+                               void* data);
 
   std::shared_ptr<PerIsolateOptions> per_isolate_opts_;
   std::vector<std::string> exec_argv_;
   std::vector<std::string> argv_;
+  // The CPUs that the thread is pinned to before it creates its Isolate.
+  std::vector<int> cpu_affinity_;
 
   MultiIsolatePlatform* platform_;
   v8::Isolate* isolate_ = nullptr;
@@ -84,6 +94,12 @@ class Worker : public AsyncWrap {
 
   std::unique_ptr<InspectorParentHandle> inspector_parent_handle_;
 
+  // How much the used heap size of the worker has to grow before the parent
+  // is told about it, or 0 if it is not. The last reported size is only
+  // accessed on the worker thread.
+  size_t heap_growth_report_bytes_ = 0;
+  size_t reported_heap_size_ = 0;
+
   // This mutex protects access to all variables listed below it.
   mutable Mutex mutex_;
 
@@ -23,8 +23,11 @@
 #include "node.h"
 #include "node_buffer.h"
 
+#include "allocated_buffer-inl.h"
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "node_bob-inl.h"
+#include "stream_pipe.h"
 #include "threadpoolwork-inl.h"
 #include "util-inl.h"
 
@@ -39,7 +42,13 @@
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <atomic>
+#include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 namespace node {
 
@@ -53,7 +62,10 @@ using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
 using v8::Local;
+using v8::Null;
 using v8::Object;
+using v8::String;
+using v8::Uint32;
 using v8::Uint32Array;
 using v8::Value;
 
@@ -137,12 +149,39 @@ class ZlibContext : public MemoryRetainer {
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
   CompressionError ResetStream();
 
+  // The flush values that a SourceTransform writes with.
+  enum TransformFlush : uint32_t {
+    kTransformProcess = Z_NO_FLUSH,
+    kTransformFinish = Z_FINISH
+  };
+
   // Zlib-specific:
   void Init(int level, int window_bits, int mem_level, int strategy,
             std::vector<unsigned char>&& dictionary);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
   CompressionError SetParams(int level, int strategy);
 
+  // Reuse of initialized deflate states, see ZlibContextPool:
+  using PoolKey = std::tuple<int, int, int, int, int>;
+  inline bool IsReusable() const {
+    return mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW;
+  }
+  inline PoolKey pool_key() const {
+    return PoolKey(mode_, level_, window_bits_, mem_level_, strategy_);
+  }
+  inline const std::vector<unsigned char>& dictionary() const {
+    return dictionary_;
+  }
+  // Resets the state and hands it over to the caller, along with the
+  // dictionary. Returns nullptr if it has not been initialized yet or cannot
+  // be reset.
+  std::unique_ptr<z_stream> ReleaseStream(
+      std::vector<unsigned char>* dictionary);
+  // Uses `strm`, which has been set up for pool_key(), instead of
+  // initializing a new state, and loads the dictionary into it. Must be
+  // called after Init().
+  void AdoptStream(std::unique_ptr<z_stream> strm);
+
   SET_MEMORY_INFO_NAME(ZlibContext)
   SET_SELF_SIZE(ZlibContext)
 
@@ -170,7 +209,9 @@ class ZlibContext : public MemoryRetainer {
   unsigned int gzip_id_bytes_read_ = 0;
   std::vector<unsigned char> dictionary_;
 
-  z_stream strm_;
+  // zlib requires the state to stay at the address it was initialized at, so
+  // this is held by pointer in order to be able to move it to another stream.
+  std::unique_ptr<z_stream> strm_ = std::make_unique<z_stream>();
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -184,6 +225,12 @@ class BrotliContext : public MemoryRetainer {
   void GetAfterWriteOffsets(uint32_t* avail_in, uint32_t* avail_out) const;
   inline void SetMode(node_zlib_mode mode) { mode_ = mode; }
 
+  // The flush values that a SourceTransform writes with.
+  enum TransformFlush : uint32_t {
+    kTransformProcess = BROTLI_OPERATION_PROCESS,
+    kTransformFinish = BROTLI_OPERATION_FINISH
+  };
+
   BrotliContext(const BrotliContext&) = delete;
   BrotliContext& operator=(const BrotliContext&) = delete;
 
@@ -245,13 +292,20 @@ class BrotliDecoderContext final : public BrotliContext {
 };
 
 template <typename CompressionContext>
-class CompressionStream : public AsyncWrap, public ThreadPoolWork {
+class CompressionStream : public AsyncWrap,
+                          public ThreadPoolWork,
+                          public SourceTransform {
  public:
+  enum InternalFields {
+    kInternalFieldCount = SourceTransform::kInternalFieldCount
+  };
+
   CompressionStream(Environment* env, Local<Object> wrap)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env),
+        ThreadPoolWork(env, ThreadPoolWorkClass::kZlib),
         write_result_(nullptr) {
     MakeWeak();
+    SourceTransform::AttachToObject(wrap);
   }
 
   ~CompressionStream() override {
@@ -279,9 +333,21 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
   static void Close(const FunctionCallbackInfo<Value>& args) {
     CompressionStream* ctx;
     ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    if (ctx->init_done_ && !ctx->write_in_progress_ && !ctx->closed_)
+      ctx->Recycle();
     ctx->Close();
   }
 
+  // setInlineThreshold(bytes)
+  // Asynchronous writes of fewer than `bytes` bytes of input are processed on
+  // the main thread.
+  static void SetInlineThreshold(const FunctionCallbackInfo<Value>& args) {
+    CompressionStream* ctx;
+    ASSIGN_OR_RETURN_UNWRAP(&ctx, args.Holder());
+    CHECK(args[0]->IsUint32());
+    ctx->inline_threshold_ = args[0].As<Uint32>()->Value();
+  }
+
 
   // write(flush, in, in_off, in_len, out, out_off, out_len)
   template <bool async>
@@ -364,6 +430,15 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     }
 
     // async version
+    if (in_len < inline_threshold_) {
+      // Small writes are cheaper to process right away than to hand to the
+      // threadpool. The callback is still called asynchronously.
+      DoThreadPoolWork();
+      AsyncWrap::env()->SetImmediate([this](Environment* env) {
+        AfterThreadPoolWork(0);
+      });
+      return;
+    }
     ScheduleWork();
   }
 
@@ -402,6 +477,14 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
 
     CHECK_EQ(status, 0);
 
+    if (transform_state_) {
+      if (transform_state_->source != nullptr)
+        transform_state_->source->AfterWrite();
+      if (pending_close_)
+        Close();
+      return;
+    }
+
     Environment* env = AsyncWrap::env();
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
@@ -440,6 +523,17 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
       Close();
   }
 
+  // Passes the data of a SourcePipe through the stream, without JS. One
+  // chunk of input is written at a time, and the next write waits until the
+  // consumer pulls again, so that a slow sink holds back the source. The
+  // stream is not to be written to from JS once it is used this way.
+  std::unique_ptr<bob::Source<uv_buf_t>> CreateSource(
+      std::unique_ptr<bob::Source<uv_buf_t>> upstream) override {
+    CHECK(init_done_ && "transform before init");
+    CHECK(!transform_state_);
+    return std::make_unique<TransformSource>(this, std::move(upstream));
+  }
+
   static void Reset(const FunctionCallbackInfo<Value> &args) {
     CompressionStream* wrap;
     ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -516,6 +610,21 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     CompressionStream* stream;
   };
 
+  // Called when the stream is closed from JS, before the context is closed,
+  // so that subclasses can hand its resources over to other streams.
+  virtual void Recycle() {}
+
+  // Moves the memory that has been allocated for the context out of or into
+  // the accounting of this stream. V8 has already been told about it.
+  size_t TakeZlibMemory() {
+    AdjustAmountOfExternalAllocatedMemory();
+    size_t memory = zlib_memory_;
+    zlib_memory_ = 0;
+    return memory;
+  }
+
+  void AddZlibMemory(size_t memory) { zlib_memory_ += memory; }
+
  private:
   void Ref() {
     if (++refs_ == 1) {
@@ -530,19 +639,343 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
     }
   }
 
+  // The size of the output buffers of a TransformSource.
+  static constexpr size_t kTransformChunkSize = 64 * 1024;
+
+  class TransformSource;
+
+  // The buffers of the writes of a TransformSource. They are shared with the
+  // stream, so that they stay around until the write that is in progress is
+  // done, even if the source is gone by then.
+  struct TransformState {
+    TransformSource* source = nullptr;
+    // What is left of the input that was pulled last.
+    std::vector<uv_buf_t> input;
+    size_t input_index = 0;
+    size_t input_length = 0;
+    bob::Done input_done;
+    std::shared_ptr<char> output;
+    uint32_t in_len = 0;
+    uint32_t flush = 0;
+  };
+
+  class TransformSource final : public bob::SourceImpl<uv_buf_t> {
+   public:
+    TransformSource(CompressionStream* stream,
+                    std::unique_ptr<bob::Source<uv_buf_t>> upstream)
+        : stream_(stream),
+          upstream_(std::move(upstream)),
+          state_(std::make_shared<TransformState>()) {
+      state_->source = this;
+      stream->transform_state_ = state_;
+    }
+
+    ~TransformSource() override {
+      state_->source = nullptr;
+    }
+
+    void AfterWrite() {
+      TransformState* state = state_.get();
+      const CompressionError err = stream_->ctx_.GetErrorInfo();
+      if (err.IsError()) {
+        // The JS side of the stream reports the error with its message.
+        Environment* env = stream_->AsyncWrap::env();
+        HandleScope handle_scope(env->isolate());
+        Context::Scope context_scope(env->context());
+        stream_->EmitError(err);
+        return Deliver(UV_EPROTO);
+      }
+
+      uint32_t avail_in;
+      uint32_t avail_out;
+      stream_->ctx_.GetAfterWriteOffsets(&avail_in, &avail_out);
+      uint32_t consumed = state->in_len - avail_in;
+      size_t produced = kTransformChunkSize - avail_out;
+      is_output_full_ = avail_out == 0;
+      if (consumed > 0) {
+        uv_buf_t* in = &state->input[state->input_index];
+        in->base += consumed;
+        in->len -= consumed;
+        if (in->len == 0 && ++state->input_index == state->input.size())
+          ReleaseInput();
+      }
+
+      // The output is complete once the finishing write leaves room in the
+      // buffer, or once the stream ends before its input does, e.g. because
+      // of trailing data.
+      bool is_finished = !is_output_full_ &&
+          (state->flush == CompressionContext::kTransformFinish ||
+           (state->in_len > 0 && consumed == 0 && produced == 0));
+      int status = is_finished ? bob::STATUS_END : bob::STATUS_CONTINUE;
+      if (produced > 0) {
+        uv_buf_t buf = uv_buf_init(state->output.get(), produced);
+        return Deliver(status, &buf);
+      }
+      if (is_finished)
+        return Deliver(status);
+      Process();
+    }
+
+   protected:
+    int DoPull(
+        bob::Next<uv_buf_t> next,
+        int options,
+        uv_buf_t* data,
+        size_t count,
+        size_t max_count_hint) override {
+      CHECK(!next_);
+      if (is_ended_) {
+        std::move(next)(bob::STATUS_EOS, nullptr, 0, [](size_t) {});
+        return bob::STATUS_EOS;
+      }
+      // The data is only ever processed on the threadpool.
+      if (options & bob::OPTIONS_SYNC) {
+        std::move(next)(bob::STATUS_BLOCK, nullptr, 0, [](size_t) {});
+        return bob::STATUS_BLOCK;
+      }
+      next_ = std::move(next);
+      Process();
+      return bob::STATUS_WAIT;
+    }
+
+   private:
+    // Writes the input that is left into the stream, or pulls more of it.
+    void Process() {
+      TransformState* state = state_.get();
+      if (!next_ || is_pulling_upstream_ || stream_->write_in_progress_)
+        return;
+      bool has_input = state->input_index < state->input.size();
+      if (!has_input && !is_output_full_ && !is_upstream_ended_)
+        return PullUpstream();
+      if (stream_->closed_ || stream_->pending_close_)
+        return Deliver(UV_ECANCELED);
+
+      char* in = nullptr;
+      state->in_len = 0;
+      if (has_input) {
+        const uv_buf_t& buf = state->input[state->input_index];
+        in = buf.base;
+        state->in_len = static_cast<uint32_t>(std::min<size_t>(
+            buf.len, std::numeric_limits<uint32_t>::max()));
+      }
+      state->flush = has_input || !is_upstream_ended_ ?
+          CompressionContext::kTransformProcess :
+          CompressionContext::kTransformFinish;
+      if (!state->output) {
+        state->output.reset(new char[kTransformChunkSize],
+                            std::default_delete<char[]>());
+      }
+      stream_->template Write<true>(state->flush,
+                                    in,
+                                    state->in_len,
+                                    state->output.get(),
+                                    kTransformChunkSize);
+    }
+
+    void PullUpstream() {
+      is_pulling_upstream_ = true;
+      // The upstream may call back after this source is gone.
+      std::shared_ptr<TransformState> state = state_;
+      upstream_->Pull(
+          [state](int status,
+                  const uv_buf_t* bufs,
+                  size_t count,
+                  bob::Done done) {
+            if (state->source == nullptr)
+              return std::move(done)(0);
+            state->source->OnInput(status, bufs, count, std::move(done));
+          },
+          bob::OPTIONS_NONE,
+          nullptr,
+          0);
+    }
+
+    void OnInput(int status,
+                 const uv_buf_t* bufs,
+                 size_t count,
+                 bob::Done done) {
+      is_pulling_upstream_ = false;
+      if (status < 0 && status != bob::STATUS_EOS) {
+        std::move(done)(0);
+        return Deliver(status);
+      }
+
+      TransformState* state = state_.get();
+      for (size_t n = 0; n < count; n++) {
+        if (bufs[n].len == 0)
+          continue;
+        state->input.push_back(bufs[n]);
+        state->input_length += bufs[n].len;
+      }
+      if (state->input.empty())
+        std::move(done)(0);
+      else
+        state->input_done = std::move(done);
+
+      if (status == bob::STATUS_END || status == bob::STATUS_EOS)
+        is_upstream_ended_ = true;
+      if (status == bob::STATUS_BLOCK && state->input.empty()) {
+        // The upstream has no data right now and does not tell when it
+        // will, so try again later rather than spinning.
+        std::shared_ptr<TransformState> retry = state_;
+        stream_->AsyncWrap::env()->SetImmediate([retry](Environment* env) {
+          if (retry->source != nullptr)
+            retry->source->Process();
+        });
+        return;
+      }
+      Process();
+    }
+
+    void ReleaseInput() {
+      TransformState* state = state_.get();
+      bob::Done done = std::move(state->input_done);
+      size_t length = state->input_length;
+      state->input_done = nullptr;
+      state->input.clear();
+      state->input_index = 0;
+      state->input_length = 0;
+      if (done)
+        std::move(done)(length);
+    }
+
+    void Deliver(int status, const uv_buf_t* buf = nullptr) {
+      if (status != bob::STATUS_CONTINUE) {
+        is_ended_ = true;
+        ReleaseInput();
+      }
+      bob::Next<uv_buf_t> next = std::move(next_);
+      next_ = nullptr;
+      if (buf == nullptr)
+        return std::move(next)(status, nullptr, 0, [](size_t) {});
+
+      // The output buffer is used for the next write again once the
+      // consumer is done with it, unless that write has another one.
+      std::weak_ptr<TransformState> weak_state = state_;
+      std::shared_ptr<char> output = std::move(state_->output);
+      std::move(next)(status, buf, 1, [weak_state, output](size_t) {
+        std::shared_ptr<TransformState> state = weak_state.lock();
+        if (state && !state->output)
+          state->output = output;
+      });
+    }
+
+    BaseObjectPtr<CompressionStream> stream_;
+    std::unique_ptr<bob::Source<uv_buf_t>> upstream_;
+    std::shared_ptr<TransformState> state_;
+    bob::Next<uv_buf_t> next_;
+    bool is_pulling_upstream_ = false;
+    bool is_upstream_ended_ = false;
+    bool is_output_full_ = false;
+    bool is_ended_ = false;
+  };
+
   bool init_done_ = false;
   bool write_in_progress_ = false;
   bool pending_close_ = false;
   bool closed_ = false;
   unsigned int refs_ = 0;
+  uint32_t inline_threshold_ = 0;
   uint32_t* write_result_ = nullptr;
   Global<Function> write_js_callback_;
+  std::shared_ptr<TransformState> transform_state_;
   std::atomic<ssize_t> unreported_allocations_{0};
   size_t zlib_memory_ = 0;
 
   CompressionContext ctx_;
 };
 
+// Keeps the deflate states of streams that have been closed, so that new
+// streams with the same parameters and dictionary can reset and reuse them
+// instead of allocating and initializing their own. Inflate states are not
+// pooled because inflate allocates its window lazily, and neither are Brotli
+// states, because Brotli encoders cannot be reset.
+class ZlibContextPool final : public BaseObject {
+ public:
+  static constexpr size_t kMaxStreams = 8;
+
+  ZlibContextPool(Environment* env, Local<Object> object)
+      : BaseObject(env, object) {}
+
+  ~ZlibContextPool() override {
+    // The states only own memory at this point, so there is nothing useful
+    // to do about an error here.
+    for (auto& entry : streams_)
+      deflateEnd(entry.second.strm.get());
+    env()->isolate()->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(memory_));
+  }
+
+  bool IsFull() const { return streams_.size() >= kMaxStreams; }
+
+  // `memory` is the amount of memory that has been reported to V8 for `strm`.
+  void Put(const ZlibContext::PoolKey& key,
+           std::vector<unsigned char>&& dictionary,
+           std::unique_ptr<z_stream> strm,
+           size_t memory) {
+    CHECK(!IsFull());
+    // Nothing is allocated by a deflate state after it has been initialized,
+    // but zlib rejects states without allocation functions, so that those
+    // have to stay valid while the state is in the pool.
+    strm->zalloc = AllocForPool;
+    strm->zfree = FreeForPool;
+    strm->opaque = nullptr;
+    dictionary_size_ += dictionary.size();
+    streams_.emplace(key, Entry { std::move(strm), memory,
+                                  std::move(dictionary) });
+    memory_ += memory;
+  }
+
+  // Returns nullptr if there is no state for `key` and `dictionary`.
+  std::unique_ptr<z_stream> Take(const ZlibContext::PoolKey& key,
+                                 const std::vector<unsigned char>& dictionary,
+                                 size_t* memory) {
+    auto range = streams_.equal_range(key);
+    auto it = std::find_if(range.first, range.second, [&](const auto& entry) {
+      return entry.second.dictionary == dictionary;
+    });
+    if (it == range.second) return nullptr;
+    std::unique_ptr<z_stream> strm = std::move(it->second.strm);
+    dictionary_size_ -= dictionary.size();
+    *memory = it->second.memory;
+    memory_ -= *memory;
+    streams_.erase(it);
+    return strm;
+  }
+
+  static constexpr FastStringKey type_name { "node::ZlibContextPool" };
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("streams", memory_);
+    tracker->TrackFieldWithSize("dictionaries", dictionary_size_);
+  }
+  SET_MEMORY_INFO_NAME(ZlibContextPool)
+  SET_SELF_SIZE(ZlibContextPool)
+
+ private:
+  static void* AllocForPool(void* opaque, uInt items, uInt size) {
+    return nullptr;
+  }
+
+  // Matches CompressionStream::FreeForZlib(), without the accounting.
+  static void FreeForPool(void* opaque, void* pointer) {
+    if (UNLIKELY(pointer == nullptr)) return;
+    free(static_cast<char*>(pointer) - sizeof(size_t));
+  }
+
+  struct Entry {
+    std::unique_ptr<z_stream> strm;
+    size_t memory;
+    std::vector<unsigned char> dictionary;
+  };
+
+  std::multimap<ZlibContext::PoolKey, Entry> streams_;
+  size_t memory_ = 0;
+  size_t dictionary_size_ = 0;
+};
+
+constexpr FastStringKey ZlibContextPool::type_name;
+
 class ZlibStream : public CompressionStream<ZlibContext> {
  public:
   ZlibStream(Environment* env, Local<Object> wrap, node_zlib_mode mode)
@@ -619,6 +1052,17 @@ class ZlibStream : public CompressionStream<ZlibContext> {
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
     wrap->context()->Init(level, window_bits, mem_level, strategy,
                           std::move(dictionary));
+
+    ZlibContextPool* pool = Environment::GetBindingData<ZlibContextPool>(args);
+    if (pool != nullptr && wrap->context()->IsReusable()) {
+      size_t memory;
+      std::unique_ptr<z_stream> strm = pool->Take(
+          wrap->context()->pool_key(), wrap->context()->dictionary(), &memory);
+      if (strm) {
+        wrap->context()->AdoptStream(std::move(strm));
+        wrap->AddZlibMemory(memory);
+      }
+    }
   }
 
   static void Params(const FunctionCallbackInfo<Value>& args) {
@@ -639,6 +1083,21 @@ class ZlibStream : public CompressionStream<ZlibContext> {
 
   SET_MEMORY_INFO_NAME(ZlibStream)
   SET_SELF_SIZE(ZlibStream)
+
+ private:
+  void Recycle() override {
+    ZlibContextPool* pool = Environment::GetBindingData<ZlibContextPool>(
+        AsyncWrap::env()->context());
+    if (pool == nullptr || pool->IsFull() || !context()->IsReusable())
+      return;
+    const ZlibContext::PoolKey key = context()->pool_key();
+    std::vector<unsigned char> dictionary;
+    std::unique_ptr<z_stream> strm = context()->ReleaseStream(&dictionary);
+    if (strm) {
+      pool->Put(key, std::move(dictionary), std::move(strm),
+                TakeZlibMemory());
+    }
+  }
 };
 
 template <typename CompressionContext>
@@ -734,10 +1193,10 @@ void ZlibContext::Close() {
 
   int status = Z_OK;
   if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+    status = deflateEnd(strm_.get());
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_.get());
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
@@ -762,11 +1221,11 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      err_ = deflate(strm_.get(), flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -779,7 +1238,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -812,7 +1271,7 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_.get(), flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
@@ -820,12 +1279,12 @@ void ZlibContext::DoThreadPoolWork() {
           err_ == Z_NEED_DICT &&
           !dictionary_.empty()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
+        err_ = inflateSetDictionary(strm_.get(),
                                     dictionary_.data(),
                                     dictionary_.size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_.get(), flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -834,17 +1293,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_.get(), flush_);
       }
       break;
     default:
@@ -855,10 +1314,10 @@ void ZlibContext::DoThreadPoolWork() {
 
 void ZlibContext::SetBuffers(char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = reinterpret_cast<Bytef*>(in);
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = reinterpret_cast<Bytef*>(in);
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -869,14 +1328,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -887,7 +1346,7 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
@@ -919,12 +1378,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_.get());
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_.get());
       break;
     default:
       break;
@@ -940,9 +1399,9 @@ CompressionError ZlibContext::ResetStream() {
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
 }
 
 
@@ -1003,7 +1462,7 @@ bool ZlibContext::InitZlib() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      err_ = deflateInit2(strm_.get(),
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -1014,7 +1473,7 @@ bool ZlibContext::InitZlib() {
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_.get(), window_bits_);
       break;
     default:
       UNREACHABLE();
@@ -1041,14 +1500,14 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
+      err_ = deflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
+      err_ = inflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
@@ -1075,7 +1534,7 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_.get(), level, strategy);
       break;
     default:
       break;
@@ -1085,10 +1544,43 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
     return ErrorForMessage("Failed to set parameters");
   }
 
+  // deflateParams() does not apply the parameters if it returns Z_BUF_ERROR.
+  if (err_ == Z_OK) {
+    level_ = level;
+    strategy_ = strategy;
+  }
+
   return CompressionError {};
 }
 
 
+std::unique_ptr<z_stream> ZlibContext::ReleaseStream(
+    std::vector<unsigned char>* dictionary) {
+  Mutex::ScopedLock lock(mutex_);
+  if (!zlib_init_done_ || !IsReusable() || deflateReset(strm_.get()) != Z_OK)
+    return nullptr;
+
+  zlib_init_done_ = false;
+  *dictionary = std::move(dictionary_);
+  dictionary_.clear();
+  return std::move(strm_);
+}
+
+
+void ZlibContext::AdoptStream(std::unique_ptr<z_stream> strm) {
+  Mutex::ScopedLock lock(mutex_);
+  CHECK(!zlib_init_done_);
+  CHECK(IsReusable());
+  strm->zalloc = strm_->zalloc;
+  strm->zfree = strm_->zfree;
+  strm->opaque = strm_->opaque;
+  strm_ = std::move(strm);
+  zlib_init_done_ = true;
+  // This cannot fail for a state that has just been reset.
+  CHECK(!SetDictionary().IsError());
+}
+
+
 void BrotliContext::SetBuffers(char* in, uint32_t in_len,
                                char* out, uint32_t out_len) {
   next_in_ = reinterpret_cast<uint8_t*>(in);
@@ -1260,21 +1752,360 @@ struct MakeClass {
     env->SetProtoMethod(z, "init", Stream::Init);
     env->SetProtoMethod(z, "params", Stream::Params);
     env->SetProtoMethod(z, "reset", Stream::Reset);
+    env->SetProtoMethod(z, "setInlineThreshold", Stream::SetInlineThreshold);
 
     env->SetConstructorFunction(target, name, z);
   }
 };
 
+// The number of threads of the libuv threadpool, computed the way libuv does.
+size_t ThreadpoolSize() {
+  static const size_t size = []() -> size_t {
+    char buf[16];
+    size_t length = sizeof(buf);
+    if (uv_os_getenv("UV_THREADPOOL_SIZE", buf, &length) != 0)
+      return 4;
+    int threads = atoi(buf);
+    return std::min(std::max(threads, 1), 1024);
+  }();
+  return size;
+}
+
+// Compresses a buffer into a single deflate, zlib or gzip stream by splitting
+// it into blocks that are compressed in parallel in the threadpool, the way
+// pigz does. Each block is primed with the end of the preceding input as its
+// dictionary and, except for the last one, ends with a sync flush, so that
+// the compressed blocks can be concatenated. The checksums of the blocks are
+// combined for the trailer.
+//
+// At most as many blocks as the threadpool has threads are in flight at any
+// time, so that other requests are not queued behind the whole buffer.
+class ParallelDeflate final : public AsyncWrap {
+ public:
+  ParallelDeflate(Environment* env, Local<Object> wrap)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB) {
+    MakeWeak();
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    Environment* env = Environment::GetCurrent(args);
+    new ParallelDeflate(env, args.This());
+  }
+
+  // start(mode, input, level, windowBits, memLevel, strategy, blockSize)
+  // The caller keeps `input` alive until oncomplete(errno, message, result)
+  // is called.
+  static void Start(const FunctionCallbackInfo<Value>& args) {
+    ParallelDeflate* job;
+    ASSIGN_OR_RETURN_UNWRAP(&job, args.Holder());
+    CHECK(job->blocks_.empty());
+    CHECK_EQ(args.Length(), 7);
+    CHECK(Buffer::HasInstance(args[1]));
+
+    job->mode_ = static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
+    CHECK(job->mode_ == DEFLATE ||
+          job->mode_ == GZIP ||
+          job->mode_ == DEFLATERAW);
+    job->level_ = args[2].As<Int32>()->Value();
+    // Raw streams do not support 256 byte windows, and deflate() does not use
+    // them either.
+    job->window_bits_ = std::max(args[3].As<Int32>()->Value(), 9);
+    job->mem_level_ = args[4].As<Int32>()->Value();
+    job->strategy_ = args[5].As<Int32>()->Value();
+    size_t block_size = args[6].As<Integer>()->Value();
+    CHECK_GT(block_size, 0);
+
+    const unsigned char* in =
+        reinterpret_cast<const unsigned char*>(Buffer::Data(args[1]));
+    size_t length = Buffer::Length(args[1]);
+    CHECK_GT(length, 0);
+    size_t window = static_cast<size_t>(1) << job->window_bits_;
+    for (size_t offset = 0; offset < length; offset += block_size) {
+      Block block;
+      block.in = in + offset;
+      block.in_length = std::min(block_size, length - offset);
+      block.dictionary_length = std::min(window, offset);
+      block.dictionary = block.in - block.dictionary_length;
+      job->blocks_.push_back(std::move(block));
+    }
+
+    job->ClearWeak();
+    size_t threads = std::min(ThreadpoolSize(), job->blocks_.size());
+    for (size_t i = 0; i < threads; i++)
+      job->ScheduleNext();
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("blocks", blocks_.capacity() * sizeof(Block));
+  }
+
+  SET_MEMORY_INFO_NAME(ParallelDeflate)
+  SET_SELF_SIZE(ParallelDeflate)
+
+ private:
+  struct Block {
+    const unsigned char* in;
+    size_t in_length;
+    const unsigned char* dictionary;
+    size_t dictionary_length;
+    std::vector<unsigned char> out;
+    uLong check = 0;
+    int err = Z_OK;
+  };
+
+  class BlockWork final : public ThreadPoolWork {
+   public:
+    BlockWork(ParallelDeflate* job, size_t index)
+        : ThreadPoolWork(job->env(), ThreadPoolWorkClass::kZlib),
+          job_(job),
+          index_(index) {}
+
+    void DoThreadPoolWork() override {
+      job_->Compress(index_);
+    }
+
+    void AfterThreadPoolWork(int status) override {
+      std::unique_ptr<BlockWork> self(this);
+      CHECK_EQ(status, 0);
+      job_->OnBlockDone();
+    }
+
+   private:
+    ParallelDeflate* job_;
+    size_t index_;
+  };
+
+  void ScheduleNext() {
+    in_flight_++;
+    (new BlockWork(this, next_++))->ScheduleWork();
+  }
+
+  // Runs in the threadpool.
+  void Compress(size_t index) {
+    Block* block = &blocks_[index];
+    bool last = index + 1 == blocks_.size();
+    if (mode_ == GZIP)
+      block->check = crc32(0, block->in, block->in_length);
+    else if (mode_ == DEFLATE)
+      block->check = adler32(1, block->in, block->in_length);
+
+    z_stream strm {};
+    block->err = deflateInit2(&strm, level_, Z_DEFLATED, -window_bits_,
+                              mem_level_, strategy_);
+    if (block->err != Z_OK)
+      return;
+    if (block->dictionary_length > 0) {
+      block->err = deflateSetDictionary(&strm, block->dictionary,
+                                        block->dictionary_length);
+    }
+
+    // deflateBound() does not account for the empty stored block that ends
+    // a sync flush.
+    block->out.resize(deflateBound(&strm, block->in_length) + 16);
+    strm.next_in = const_cast<Bytef*>(block->in);
+    strm.avail_in = block->in_length;
+    int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    while (block->err == Z_OK) {
+      if (strm.total_out == block->out.size())
+        block->out.resize(block->out.size() * 2);
+      strm.next_out = block->out.data() + strm.total_out;
+      strm.avail_out = block->out.size() - strm.total_out;
+      int err = deflate(&strm, flush);
+      if (err == Z_STREAM_END || (err == Z_BUF_ERROR && !last))
+        break;
+      if (err != Z_OK)
+        block->err = err;
+      else if (!last && strm.avail_out != 0)
+        break;
+    }
+    block->out.resize(strm.total_out);
+    deflateEnd(&strm);
+  }
+
+  void OnBlockDone() {
+    in_flight_--;
+    // The remaining blocks are not compressed if the Environment is being
+    // torn down.
+    if (!env()->can_call_into_js())
+      return;
+    if (next_ < blocks_.size())
+      return ScheduleNext();
+    if (in_flight_ == 0)
+      Finish();
+  }
+
+  void Finish() {
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+    Local<Value> argv[] = {
+      Null(env()->isolate()),
+      Null(env()->isolate()),
+      Null(env()->isolate())
+    };
+
+    int err = Z_OK;
+    size_t length = 0;
+    for (const Block& block : blocks_) {
+      if (err == Z_OK)
+        err = block.err;
+      length += block.out.size();
+    }
+
+    if (err != Z_OK) {
+      argv[0] = Integer::New(env()->isolate(), err);
+      argv[1] = OneByteString(env()->isolate(), zError(err));
+    } else {
+      unsigned char header[10];
+      size_t header_length = WriteHeader(header);
+      unsigned char trailer[8];
+      size_t trailer_length = WriteTrailer(trailer);
+      AllocatedBuffer result = AllocatedBuffer::AllocateManaged(
+          env(), header_length + length + trailer_length);
+      char* out = result.data();
+      memcpy(out, header, header_length);
+      out += header_length;
+      for (const Block& block : blocks_) {
+        if (!block.out.empty())
+          memcpy(out, block.out.data(), block.out.size());
+        out += block.out.size();
+      }
+      memcpy(out, trailer, trailer_length);
+      argv[2] = result.ToArrayBuffer();
+    }
+
+    blocks_.clear();
+    blocks_.shrink_to_fit();
+    MakeWeak();
+    MakeCallback(env()->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  int HeaderLevel() const {
+    return level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+  }
+
+  // The headers match the ones deflate() writes.
+  size_t WriteHeader(unsigned char* header) const {
+    int level = HeaderLevel();
+    if (mode_ == GZIP) {
+      const unsigned char gzip[] = {
+        GZIP_HEADER_ID1, GZIP_HEADER_ID2, Z_DEFLATED, 0, 0, 0, 0, 0,
+        static_cast<unsigned char>(
+            level == 9 ? 2 : (strategy_ >= Z_HUFFMAN_ONLY || level < 2) ? 4 :
+                                                                          0),
+        3  // OS_CODE of Unix systems.
+      };
+      memcpy(header, gzip, sizeof(gzip));
+      return sizeof(gzip);
+    }
+    if (mode_ == DEFLATE) {
+      unsigned int flags =
+          (strategy_ >= Z_HUFFMAN_ONLY || level < 2) ? 0 :
+          level < 6 ? 1 :
+          level == 6 ? 2 : 3;
+      unsigned int value =
+          ((Z_DEFLATED + ((window_bits_ - 8) << 4)) << 8) | (flags << 6);
+      value += 31 - (value % 31);
+      header[0] = value >> 8;
+      header[1] = value & 0xff;
+      return 2;
+    }
+    return 0;
+  }
+
+  size_t WriteTrailer(unsigned char* trailer) const {
+    uLong check = mode_ == GZIP ? crc32(0, nullptr, 0) : adler32(0, nullptr, 0);
+    uint64_t length = 0;
+    for (const Block& block : blocks_) {
+      check = mode_ == GZIP ?
+          crc32_combine(check, block.check, block.in_length) :
+          adler32_combine(check, block.check, block.in_length);
+      length += block.in_length;
+    }
+    if (mode_ == GZIP) {
+      for (int i = 0; i < 4; i++) {
+        trailer[i] = (check >> (8 * i)) & 0xff;
+        trailer[4 + i] = (length >> (8 * i)) & 0xff;
+      }
+      return 8;
+    }
+    if (mode_ == DEFLATE) {
+      for (int i = 0; i < 4; i++)
+        trailer[i] = (check >> (8 * (3 - i))) & 0xff;
+      return 4;
+    }
+    return 0;
+  }
+
+  node_zlib_mode mode_ = NONE;
+  int level_ = 0;
+  int window_bits_ = 0;
+  int mem_level_ = 0;
+  int strategy_ = 0;
+  std::vector<Block> blocks_;
+  size_t next_ = 0;
+  size_t in_flight_ = 0;
+};
+
+// crc32(data, value) and adler32(data, value)
+// `data` is an ArrayBufferView or a string, which is encoded as UTF-8, and
+// `value` is the checksum of the preceding data.
+template <uLong (*Checksum)(uLong, const Bytef*, uInt)>
+void ComputeChecksum(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsArrayBufferView() || args[0]->IsString());
+  CHECK(args[1]->IsUint32());
+  uLong value = args[1].As<Uint32>()->Value();
+
+  auto update = [&](const char* data, size_t length) {
+    // zlib only dispatches to the CRC32 instructions of ARMv8 from crc32(),
+    // which takes a 32-bit length, rather than from crc32_z(). Empty inputs
+    // are skipped because a nullptr `data` would reset the checksum.
+    while (length > 0) {
+      const uInt chunk = static_cast<uInt>(
+          std::min<size_t>(length, std::numeric_limits<uInt>::max()));
+      value = Checksum(value, reinterpret_cast<const Bytef*>(data), chunk);
+      data += chunk;
+      length -= chunk;
+    }
+  };
+
+  if (args[0]->IsArrayBufferView()) {
+    ArrayBufferViewContents<char> data(args[0]);
+    update(data.data(), data.length());
+  } else {
+    Utf8Value data(args.GetIsolate(), args[0]);
+    update(*data, data.length());
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(value));
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
                 void* priv) {
   Environment* env = Environment::GetCurrent(context);
 
+  // By convention, this makes zlib detect the CPU features that the SIMD
+  // versions of crc32() and adler32() depend on.
+  crc32(0, Z_NULL, 0);
+  env->SetMethodNoSideEffect(target, "crc32", ComputeChecksum<crc32>);
+  env->SetMethodNoSideEffect(target, "adler32", ComputeChecksum<adler32>);
+
+  env->AddBindingData<ZlibContextPool>(context, target);
+
   MakeClass<ZlibStream>::Make(env, target, "Zlib");
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
 
+  Local<FunctionTemplate> parallel_deflate =
+      env->NewFunctionTemplate(ParallelDeflate::New);
+  parallel_deflate->InstanceTemplate()->SetInternalFieldCount(
+      ParallelDeflate::kInternalFieldCount);
+  parallel_deflate->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(parallel_deflate, "start", ParallelDeflate::Start);
+  env->SetConstructorFunction(target, "ParallelDeflate", parallel_deflate);
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION)).Check();
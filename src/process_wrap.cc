@@ -255,6 +255,14 @@ class ProcessWrap : public HandleWrap {
       options.flags |= UV_PROCESS_DETACHED;
     }
 
+    // options.vfork
+    Local<Value> vfork_v =
+        js_options->Get(context, env->vfork_string()).ToLocalChecked();
+
+    if (vfork_v->IsTrue()) {
+      options.flags |= UV_PROCESS_VFORK;
+    }
+
     int err = uv_spawn(env->event_loop(), &wrap->process_, &options);
     wrap->MarkAsInitialized();
 
@@ -26,6 +26,8 @@
 #include "string_bytes.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
 
@@ -50,45 +52,43 @@ using v8::Object;
 using v8::String;
 using v8::Value;
 
-void SyncProcessOutputBuffer::OnAlloc(size_t suggested_size,
-                                      uv_buf_t* buf) const {
-  if (used() == kBufferSize)
-    *buf = uv_buf_init(nullptr, 0);
-  else
-    *buf = uv_buf_init(data_ + used(), available());
-}
-
-
-void SyncProcessOutputBuffer::OnRead(const uv_buf_t* buf, size_t nread) {
-  // If we hand out the same chunk twice, this should catch it.
-  CHECK_EQ(buf->base, data_ + used());
-  used_ += static_cast<unsigned int>(nread);
+SyncProcessOutputBuffer::~SyncProcessOutputBuffer() {
+  free(data_);
 }
 
 
-size_t SyncProcessOutputBuffer::Copy(char* dest) const {
-  memcpy(dest, data_, used());
-  return used();
-}
-
+void SyncProcessOutputBuffer::OnAlloc(size_t suggested_size, uv_buf_t* buf) {
+  if (used_ == size_) {
+    // Grow the buffer geometrically. This does not double the memory that
+    // large outputs use since realloc() remaps large allocations in place.
+    size_ = size_ == 0 ? kInitialSize : size_ * 2;
+    data_ = Realloc(data_, size_);
+  }
 
-unsigned int SyncProcessOutputBuffer::available() const {
-  return sizeof data_ - used();
+  // uv_buf_init() takes an unsigned int.
+  const size_t available = std::min<size_t>(size_ - used_, UINT_MAX);
+  *buf = uv_buf_init(data_ + used_, static_cast<unsigned int>(available));
 }
 
 
-unsigned int SyncProcessOutputBuffer::used() const {
-  return used_;
+void SyncProcessOutputBuffer::OnRead(const uv_buf_t* buf, size_t nread) {
+  // If we hand out the same chunk twice, this should catch it.
+  CHECK_EQ(buf->base, data_ + used_);
+  used_ += nread;
 }
 
 
-SyncProcessOutputBuffer* SyncProcessOutputBuffer::next() const {
-  return next_;
-}
-
+MaybeLocal<Object> SyncProcessOutputBuffer::Release(Environment* env) {
+  if (used_ == 0)
+    return Buffer::New(env, 0);
 
-void SyncProcessOutputBuffer::set_next(SyncProcessOutputBuffer* next) {
-  next_ = next;
+  // Give the unused memory back.
+  char* data = Realloc(data_, used_);
+  const size_t length = used_;
+  data_ = nullptr;
+  size_ = 0;
+  used_ = 0;
+  return Buffer::New(env, data, length);
 }
 
 
@@ -101,9 +101,6 @@ SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
       writable_(writable),
       input_buffer_(input_buffer),
 
-      first_output_buffer_(nullptr),
-      last_output_buffer_(nullptr),
-
       uv_pipe_(),
       write_req_(),
       shutdown_req_(),
@@ -115,14 +112,6 @@ SyncProcessStdioPipe::SyncProcessStdioPipe(SyncProcessRunner* process_handler,
 
 SyncProcessStdioPipe::~SyncProcessStdioPipe() {
   CHECK(lifecycle_ == kUninitialized || lifecycle_ == kClosed);
-
-  SyncProcessOutputBuffer* buf;
-  SyncProcessOutputBuffer* next;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = next) {
-    next = buf->next();
-    delete buf;
-  }
 }
 
 
@@ -184,11 +173,8 @@ void SyncProcessStdioPipe::Close() {
 }
 
 
-Local<Object> SyncProcessStdioPipe::GetOutputAsBuffer(Environment* env) const {
-  size_t length = OutputLength();
-  Local<Object> js_buffer = Buffer::New(env, length).ToLocalChecked();
-  CopyOutput(Buffer::Data(js_buffer));
-  return js_buffer;
+Local<Object> SyncProcessStdioPipe::GetOutputAsBuffer(Environment* env) {
+  return output_buffer_.Release(env).ToLocalChecked();
 }
 
 
@@ -231,45 +217,12 @@ uv_handle_t* SyncProcessStdioPipe::uv_handle() const {
 }
 
 
-size_t SyncProcessStdioPipe::OutputLength() const {
-  SyncProcessOutputBuffer* buf;
-  size_t size = 0;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = buf->next())
-    size += buf->used();
-
-  return size;
-}
-
-
-void SyncProcessStdioPipe::CopyOutput(char* dest) const {
-  SyncProcessOutputBuffer* buf;
-  size_t offset = 0;
-
-  for (buf = first_output_buffer_; buf != nullptr; buf = buf->next())
-    offset += buf->Copy(dest + offset);
-}
-
-
 void SyncProcessStdioPipe::OnAlloc(size_t suggested_size, uv_buf_t* buf) {
   // This function assumes that libuv will never allocate two buffers for the
   // same stream at the same time. There's an assert in
   // SyncProcessOutputBuffer::OnRead that would fail if this assumption was
   // ever violated.
-
-  if (last_output_buffer_ == nullptr) {
-    // Allocate the first capture buffer.
-    first_output_buffer_ = new SyncProcessOutputBuffer();
-    last_output_buffer_ = first_output_buffer_;
-
-  } else if (last_output_buffer_->available() == 0) {
-    // The current capture buffer is full so get us a new one.
-    SyncProcessOutputBuffer* buf = new SyncProcessOutputBuffer();
-    last_output_buffer_->set_next(buf);
-    last_output_buffer_ = buf;
-  }
-
-  last_output_buffer_->OnAlloc(suggested_size, buf);
+  output_buffer_.OnAlloc(suggested_size, buf);
 }
 
 
@@ -283,7 +236,7 @@ void SyncProcessStdioPipe::OnRead(const uv_buf_t* buf, ssize_t nread) {
     uv_read_stop(uv_stream());
 
   } else {
-    last_output_buffer_->OnRead(buf, nread);
+    output_buffer_.OnRead(buf, nread);
     process_handler_->IncrementBufferSizeAndCheckOverflow(nread);
   }
 }
@@ -805,6 +758,11 @@ Maybe<int> SyncProcessRunner::ParseOptions(Local<Value> js_value) {
   if (js_detached->BooleanValue(isolate))
     uv_process_options_.flags |= UV_PROCESS_DETACHED;
 
+  Local<Value> js_vfork =
+      js_options->Get(context, env()->vfork_string()).ToLocalChecked();
+  if (js_vfork->BooleanValue(isolate))
+    uv_process_options_.flags |= UV_PROCESS_VFORK;
+
   Local<Value> js_win_hide =
       js_options->Get(context, env()->windows_hide_string()).ToLocalChecked();
   if (js_win_hide->BooleanValue(isolate))
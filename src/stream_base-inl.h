@@ -128,13 +128,15 @@ int StreamBase::Shutdown(v8::Local<v8::Object> req_wrap_obj) {
 
   v8::HandleScope handle_scope(env->isolate());
 
+  v8::Global<v8::Object> recycle_handle;
   if (req_wrap_obj.IsEmpty()) {
-    if (!env->shutdown_wrap_template()
-             ->NewInstance(env->context())
+    if (!StreamReq::NewInternalObject(env,
+                                      env->shutdown_wrap_template(),
+                                      env->shutdown_wrap_objects(),
+                                      &recycle_handle)
              .ToLocal(&req_wrap_obj)) {
       return UV_EBUSY;
     }
-    StreamReq::ResetObject(req_wrap_obj);
   }
 
   BaseObjectPtr<AsyncWrap> req_wrap_ptr;
@@ -144,16 +146,20 @@ int StreamBase::Shutdown(v8::Local<v8::Object> req_wrap_obj) {
     req_wrap_ptr.reset(req_wrap->GetAsyncWrap());
   int err = DoShutdown(req_wrap);
 
-  if (err != 0 && req_wrap != nullptr) {
-    req_wrap->Dispose();
-  }
-
   const char* msg = Error();
   if (msg != nullptr) {
     req_wrap_obj->Set(
         env->context(),
         env->error_string(), OneByteString(env->isolate(), msg)).Check();
     ClearError();
+  } else if (!recycle_handle.IsEmpty() && req_wrap != nullptr &&
+             StreamReq::FromObject(req_wrap_obj) == req_wrap) {
+    req_wrap->RecycleObject(
+        env, env->shutdown_wrap_objects(), std::move(recycle_handle));
+  }
+
+  if (err != 0 && req_wrap != nullptr) {
+    req_wrap->Dispose();
   }
 
   return err;
@@ -181,13 +187,15 @@ StreamWriteResult StreamBase::Write(
 
   v8::HandleScope handle_scope(env->isolate());
 
+  v8::Global<v8::Object> recycle_handle;
   if (req_wrap_obj.IsEmpty()) {
-    if (!env->write_wrap_template()
-             ->NewInstance(env->context())
+    if (!StreamReq::NewInternalObject(env,
+                                      env->write_wrap_template(),
+                                      env->write_wrap_objects(),
+                                      &recycle_handle)
              .ToLocal(&req_wrap_obj)) {
       return StreamWriteResult { false, UV_EBUSY, nullptr, 0, {} };
     }
-    StreamReq::ResetObject(req_wrap_obj);
   }
 
   AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(GetAsyncWrap());
@@ -197,17 +205,23 @@ StreamWriteResult StreamBase::Write(
   err = DoWrite(req_wrap, bufs, count, send_handle);
   bool async = err == 0;
 
-  if (!async) {
-    req_wrap->Dispose();
-    req_wrap = nullptr;
-  }
-
   const char* msg = Error();
   if (msg != nullptr) {
     req_wrap_obj->Set(env->context(),
                       env->error_string(),
                       OneByteString(env->isolate(), msg)).Check();
     ClearError();
+  } else if (!recycle_handle.IsEmpty() &&
+             StreamReq::FromObject(req_wrap_obj) == req_wrap) {
+    // Only recycle the object if the request has not finished yet, so
+    // that an error which `Done()` may have put on it goes away with it.
+    req_wrap->RecycleObject(
+        env, env->write_wrap_objects(), std::move(recycle_handle));
+  }
+
+  if (!async) {
+    req_wrap->Dispose();
+    req_wrap = nullptr;
   }
 
   return StreamWriteResult {
@@ -283,6 +297,7 @@ void StreamReq::Done(int status, const char* error_str) {
                               env->error_string(),
                               OneByteString(env->isolate(), error_str))
                               .Check();
+    recycle_handle_.Reset();
   }
 
   OnDone(status);
@@ -295,6 +310,43 @@ void StreamReq::ResetObject(v8::Local<v8::Object> obj) {
   obj->SetAlignedPointerInInternalField(StreamReq::kStreamReqField, nullptr);
 }
 
+bool StreamReq::CanRecycleObjects(Environment* env) {
+  // Objects that were passed to an init hook or that may have been returned
+  // by executionAsyncResource() can carry state that JS code put on them.
+  AliasedUint32Array& fields = env->async_hooks()->fields();
+  return fields[AsyncHooks::kInit] == 0 &&
+         fields[AsyncHooks::kUsesExecutionAsyncResource] == 0 &&
+         !env->is_stopping();
+}
+
+v8::MaybeLocal<v8::Object> StreamReq::NewInternalObject(
+    Environment* env,
+    v8::Local<v8::ObjectTemplate> tmpl,
+    std::vector<v8::Global<v8::Object>>* pool,
+    v8::Global<v8::Object>* handle) {
+  v8::Local<v8::Object> obj;
+  if (!pool->empty()) {
+    *handle = std::move(pool->back());
+    pool->pop_back();
+    obj = handle->Get(env->isolate());
+  } else {
+    if (!tmpl->NewInstance(env->context()).ToLocal(&obj))
+      return v8::MaybeLocal<v8::Object>();
+    if (CanRecycleObjects(env))
+      handle->Reset(env->isolate(), obj);
+  }
+  StreamReq::ResetObject(obj);
+  return obj;
+}
+
+void StreamReq::RecycleObject(Environment* env,
+                              std::vector<v8::Global<v8::Object>>* pool,
+                              v8::Global<v8::Object>&& handle) {
+  recycle_env_ = env;
+  recycle_pool_ = pool;
+  recycle_handle_ = std::move(handle);
+}
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -5,6 +5,7 @@
 
 #include "env-inl.h"
 #include "js_stream.h"
+#include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_buffer.h"
 #include "node_errors.h"
@@ -13,12 +14,14 @@
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
 #include <climits>  // INT_MAX
 
 namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::Boolean;
 using v8::ConstructorBehavior;
 using v8::Context;
 using v8::DontDelete;
@@ -29,6 +32,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
@@ -39,6 +43,10 @@ using v8::Signature;
 using v8::String;
 using v8::Value;
 
+// The number of request objects per kind that are kept for reuse. A stream
+// rarely has more than a few writes in flight that Node.js made itself.
+constexpr size_t kMaxRecycledReqObjects = 16;
+
 template int StreamBase::WriteString<ASCII>(
     const FunctionCallbackInfo<Value>& args);
 template int StreamBase::WriteString<UTF8>(
@@ -66,6 +74,11 @@ int StreamBase::UseUserBuffer(const FunctionCallbackInfo<Value>& args) {
   return 0;
 }
 
+int StreamBase::UseFraming(const FunctionCallbackInfo<Value>& args) {
+  PushStreamListener(new FramedJSStreamListener());
+  return 0;
+}
+
 int StreamBase::Shutdown(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   Local<Object> req_wrap_obj = args[0].As<Object>();
@@ -402,6 +415,7 @@ void StreamBase::AddMethods(Environment* env, Local<FunctionTemplate> t) {
   env->SetProtoMethod(t,
                       "useUserBuffer",
                       JSMethod<&StreamBase::UseUserBuffer>);
+  env->SetProtoMethod(t, "useFraming", JSMethod<&StreamBase::UseFraming>);
   env->SetProtoMethod(t, "writev", JSMethod<&StreamBase::Writev>);
   env->SetProtoMethod(t, "writeBuffer", JSMethod<&StreamBase::WriteBuffer>);
   env->SetProtoMethod(
@@ -434,6 +448,7 @@ void StreamBase::RegisterExternalReferences(
   registry->Register(JSMethod<&StreamBase::ReadStopJS>);
   registry->Register(JSMethod<&StreamBase::Shutdown>);
   registry->Register(JSMethod<&StreamBase::UseUserBuffer>);
+  registry->Register(JSMethod<&StreamBase::UseFraming>);
   registry->Register(JSMethod<&StreamBase::Writev>);
   registry->Register(JSMethod<&StreamBase::WriteBuffer>);
   registry->Register(JSMethod<&StreamBase::WriteString<ASCII>>);
@@ -508,10 +523,71 @@ void StreamResource::ClearError() {
 }
 
 
+uv_buf_t StreamReadSlab::Allocate(size_t suggested_size) {
+  if (suggested_size > kMaxSlabAllocation)
+    return AllocatedBuffer::AllocateManaged(env_, suggested_size).release();
+
+  if (slabs_.empty() || kSlabSize - slabs_.back()->used < suggested_size) {
+    std::unique_ptr<Slab> slab = std::make_unique<Slab>();
+    slab->data.reset(new char[kSlabSize]());
+    slabs_.emplace_back(std::move(slab));
+  }
+
+  Slab* slab = slabs_.back().get();
+  char* data = slab->data.get() + slab->used;
+  slab->used += suggested_size;
+  slab->pending++;
+  return uv_buf_init(data, suggested_size);
+}
+
+bool StreamReadSlab::Commit(const uv_buf_t& buf,
+                            ssize_t nread,
+                            Local<ArrayBuffer>* ab,
+                            size_t* offset) {
+  if (buf.base == nullptr)
+    return false;
+
+  auto it = std::find_if(slabs_.rbegin(), slabs_.rend(),
+      [&](const std::unique_ptr<Slab>& slab) {
+        return buf.base >= slab->data.get() &&
+               buf.base < slab->data.get() + kSlabSize;
+      });
+  if (it == slabs_.rend())
+    return false;
+
+  Slab* slab = it->get();
+  size_t filled = nread > 0 ? static_cast<size_t>(nread) : 0;
+  CHECK_LE(filled, buf.len);
+  CHECK_GT(slab->pending, 0);
+
+  if (filled > 0) {
+    AllocatedBuffer copy = AllocatedBuffer::AllocateManaged(env_, filled);
+    memcpy(copy.data(), buf.base, filled);
+    *ab = copy.ToArrayBuffer();
+    *offset = 0;
+  }
+
+  // The slab can be reused from the start once none of it is in use. Older
+  // slabs, which were only kept for their pending buffers, are freed then.
+  if (--slab->pending == 0) {
+    if (slab == slabs_.back().get())
+      slab->used = 0;
+    else
+      slabs_.erase(std::next(it).base());
+  }
+  return true;
+}
+
+void StreamReadSlab::MemoryInfo(MemoryTracker* tracker) const {
+  for (size_t i = 0; i < slabs_.size(); i++)
+    tracker->TrackFieldWithSize("slab", kSlabSize, "StreamReadSlab::Slab");
+}
+
+
 uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(stream_);
   Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
-  return AllocatedBuffer::AllocateManaged(env, suggested_size).release();
+  return env->stream_read_slab()->Allocate(suggested_size);
 }
 
 void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
@@ -520,6 +596,17 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   Environment* env = stream->stream_env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
+
+  Local<ArrayBuffer> ab;
+  size_t offset;
+  if (env->stream_read_slab()->Commit(buf_, nread, &ab, &offset)) {
+    if (nread < 0)
+      stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+    else if (nread > 0)
+      stream->CallJSOnreadMethod(nread, ab, offset);
+    return;
+  }
+
   AllocatedBuffer buf(env, buf_);
 
   if (nread <= 0)  {
@@ -569,6 +656,143 @@ void CustomBufferJSListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
 }
 
 
+uv_buf_t FramedJSStreamListener::OnStreamAlloc(size_t suggested_size) {
+  CHECK_NOT_NULL(stream_);
+  if (frame_ && frame_->ByteLength() - frame_read_ >= kMinDirectRead) {
+    char* data = static_cast<char*>(frame_->Data()) + frame_read_;
+    const size_t left = frame_->ByteLength() - frame_read_;
+    return uv_buf_init(data, static_cast<unsigned int>(
+        std::min<size_t>(left, UINT_MAX)));
+  }
+  Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
+  return env->stream_read_slab()->Allocate(suggested_size);
+}
+
+
+void FramedJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  CHECK_NOT_NULL(stream_);
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  if (frame_ && buf.base == static_cast<char*>(frame_->Data()) + frame_read_) {
+    // The data was read into the frame directly.
+    if (nread < 0) {
+      stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+      return;
+    }
+    frame_read_ += nread;
+    if (frame_read_ == frame_->ByteLength())
+      EmitFrame();
+    return;
+  }
+
+  Local<ArrayBuffer> ab;
+  size_t offset = 0;
+  if (!env->stream_read_slab()->Commit(buf, nread, &ab, &offset)) {
+    AllocatedBuffer allocated(env, buf);
+    if (nread > 0) {
+      CHECK_LE(static_cast<size_t>(nread), allocated.size());
+      allocated.Resize(nread);
+      ab = allocated.ToArrayBuffer();
+    }
+  }
+
+  if (nread < 0) {
+    stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+    return;
+  }
+  if (nread > 0)
+    OnData(ab, offset, nread);
+}
+
+
+void FramedJSStreamListener::OnData(Local<ArrayBuffer> ab,
+                                    size_t offset,
+                                    size_t length) {
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  const char* data =
+      static_cast<const char*>(ab->GetBackingStore()->Data()) + offset;
+
+  size_t pos = 0;
+  while (pos < length) {
+    if (frame_) {
+      const size_t n =
+          std::min(frame_->ByteLength() - frame_read_, length - pos);
+      memcpy(static_cast<char*>(frame_->Data()) + frame_read_, data + pos, n);
+      frame_read_ += n;
+      pos += n;
+      if (frame_read_ == frame_->ByteLength())
+        EmitFrame();
+      continue;
+    }
+
+    const size_t n = std::min(kHeaderSize - header_read_, length - pos);
+    memcpy(header_ + header_read_, data + pos, n);
+    header_read_ += n;
+    pos += n;
+    if (header_read_ < kHeaderSize)
+      break;
+    header_read_ = 0;
+
+    const size_t size = static_cast<size_t>(header_[0]) << 24 |
+                        static_cast<size_t>(header_[1]) << 16 |
+                        static_cast<size_t>(header_[2]) << 8 |
+                        static_cast<size_t>(header_[3]);
+    if (size > INT32_MAX) {
+      // The size of a read that is passed to JS is an int32.
+      stream->CallJSOnreadMethod(UV_E2BIG, Local<ArrayBuffer>());
+      return;
+    }
+    if (size == 0)
+      continue;
+
+    if (length - pos >= size) {
+      // The frame is complete, pass a slice of the data that was read.
+      stream->CallJSOnreadMethod(size, ab, offset + pos);
+      pos += size;
+    } else {
+      StartFrame(size);
+    }
+  }
+
+  SetBuffering(frame_ || header_read_ > 0);
+}
+
+
+void FramedJSStreamListener::StartFrame(size_t size) {
+  Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
+  NoArrayBufferZeroFillScope no_zero_fill_scope(env->isolate_data());
+  frame_ = ArrayBuffer::NewBackingStore(env->isolate(), size);
+  frame_read_ = 0;
+}
+
+
+void FramedJSStreamListener::EmitFrame() {
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  const size_t size = frame_->ByteLength();
+  Local<ArrayBuffer> ab = ArrayBuffer::New(env->isolate(), std::move(frame_));
+  frame_read_ = 0;
+  SetBuffering(false);
+  stream->CallJSOnreadMethod(size, ab);
+}
+
+
+void FramedJSStreamListener::SetBuffering(bool buffering) {
+  if (buffering == buffering_ || stream_ == nullptr)
+    return;
+  buffering_ = buffering;
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  USE(stream->GetObject()->Set(env->context(),
+                               FIXED_ONE_BYTE_STRING(env->isolate(),
+                                                     "buffering"),
+                               Boolean::New(env->isolate(), buffering)));
+}
+
+
 void ReportWritesToJSStreamListener::OnStreamAfterReqFinished(
     StreamReq* req_wrap, int status) {
   StreamBase* stream = static_cast<StreamBase*>(stream_);
@@ -605,6 +829,16 @@ void ReportWritesToJSStreamListener::OnStreamAfterShutdown(
   OnStreamAfterReqFinished(req_wrap, status);
 }
 
+StreamReq::~StreamReq() {
+  // The object is detached from the BaseObject at this point.
+  if (recycle_handle_.IsEmpty() ||
+      recycle_pool_->size() >= kMaxRecycledReqObjects ||
+      !CanRecycleObjects(recycle_env_)) {
+    return;
+  }
+  recycle_pool_->emplace_back(std::move(recycle_handle_));
+}
+
 void ShutdownWrap::OnDone(int status) {
   stream()->EmitAfterShutdown(this, status);
   Dispose();
@@ -11,6 +11,9 @@
 
 #include "v8.h"
 
+#include <memory>
+#include <vector>
+
 namespace node {
 
 // Forward declarations
@@ -46,7 +49,7 @@ class StreamReq {
       StreamBase* stream,
       v8::Local<v8::Object> req_wrap_obj);
 
-  virtual ~StreamReq() = default;
+  virtual ~StreamReq();
   virtual AsyncWrap* GetAsyncWrap() = 0;
   inline v8::Local<v8::Object> object();
 
@@ -64,13 +67,34 @@ class StreamReq {
   // constructor explicitly.
   static inline void ResetObject(v8::Local<v8::Object> req_wrap_obj);
 
+  // Returns an object for a request that Node.js makes itself, taken from
+  // `pool` if possible. Such objects are not visible to JS code unless
+  // async_hooks are watching, so as long as they are not, `handle` is set
+  // to a handle that can be passed to `RecycleObject()`.
+  static inline v8::MaybeLocal<v8::Object> NewInternalObject(
+      Environment* env,
+      v8::Local<v8::ObjectTemplate> tmpl,
+      std::vector<v8::Global<v8::Object>>* pool,
+      v8::Global<v8::Object>* handle);
+
+  // Puts the object from `NewInternalObject()` back into `pool` once this
+  // request is gone, instead of leaving it to the garbage collector.
+  inline void RecycleObject(Environment* env,
+                            std::vector<v8::Global<v8::Object>>* pool,
+                            v8::Global<v8::Object>&& handle);
+
  protected:
   virtual void OnDone(int status) = 0;
 
   inline void AttachToObject(v8::Local<v8::Object> req_wrap_obj);
 
  private:
+  static inline bool CanRecycleObjects(Environment* env);
+
   StreamBase* const stream_;
+  Environment* recycle_env_ = nullptr;
+  std::vector<v8::Global<v8::Object>>* recycle_pool_ = nullptr;
+  v8::Global<v8::Object> recycle_handle_;
 };
 
 class ShutdownWrap : public StreamReq {
@@ -191,6 +215,50 @@ class ReportWritesToJSStreamListener : public StreamListener {
 };
 
 
+// Read buffers for EmitToJSStreamListener are carved from slabs that are
+// shared by all streams of an Environment, instead of allocating
+// suggested_size bytes for every read and shrinking them afterwards. The
+// data that a read filled is copied into an ArrayBuffer of its own, so JS
+// never sees a slab: a Buffer can neither pin one nor look at the data of
+// other streams through its `buffer`.
+class StreamReadSlab : public MemoryRetainer {
+ public:
+  explicit StreamReadSlab(Environment* env) : env_(env) {}
+
+  uv_buf_t Allocate(size_t suggested_size);
+
+  // Gives back `buf` to the slab. If any data was read, `*ab` is set to a
+  // new ArrayBuffer that holds a copy of it, and `*offset` to 0. Returns
+  // false if `buf` was not taken from a slab, in which case it is an
+  // AllocatedBuffer.
+  bool Commit(const uv_buf_t& buf,
+              ssize_t nread,
+              v8::Local<v8::ArrayBuffer>* ab,
+              size_t* offset);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(StreamReadSlab)
+  SET_SELF_SIZE(StreamReadSlab)
+
+  static constexpr size_t kSlabSize = 256 * 1024;
+  // Larger reads get memory of their own.
+  static constexpr size_t kMaxSlabAllocation = kSlabSize / 4;
+
+ private:
+  struct Slab {
+    std::unique_ptr<char[]> data;
+    size_t used = 0;
+    // Number of buffers handed out by Allocate() and not yet committed.
+    size_t pending = 0;
+  };
+
+  Environment* env_;
+  // The last slab is the one that new buffers are taken from. Older slabs
+  // are only kept here while some of their buffers are pending.
+  std::vector<std::unique_ptr<Slab>> slabs_;
+};
+
+
 // A default emitter that just pushes data chunks as Buffer instances to
 // JS land via the handle’s .ondata method.
 class EmitToJSStreamListener : public ReportWritesToJSStreamListener {
@@ -215,6 +283,37 @@ class CustomBufferJSListener : public ReportWritesToJSStreamListener {
 };
 
 
+// A listener for streams that carry frames which are prefixed with their
+// length as a big endian uint32, such as the IPC channels of child processes.
+// Every frame body is passed to the .onread method on its own. The bodies of
+// large frames are read straight into the ArrayBuffer that is passed, and the
+// others are slices of the read slab. The `buffering` property of the stream
+// object is true while a frame has only been partially read.
+class FramedJSStreamListener : public ReportWritesToJSStreamListener {
+ public:
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override { delete this; }
+
+ private:
+  static constexpr size_t kHeaderSize = 4;
+  // Frames with at least this many bytes left are read into their buffer.
+  static constexpr size_t kMinDirectRead = 64 * 1024;
+
+  void OnData(v8::Local<v8::ArrayBuffer> ab, size_t offset, size_t length);
+  void StartFrame(size_t size);
+  void EmitFrame();
+  void SetBuffering(bool buffering);
+
+  uint8_t header_[kHeaderSize];
+  size_t header_read_ = 0;
+  // The frame that is being read, if it did not arrive in one piece.
+  std::shared_ptr<v8::BackingStore> frame_;
+  size_t frame_read_ = 0;
+  bool buffering_ = false;
+};
+
+
 // A generic stream, comparable to JS land’s `Duplex` streams.
 // A stream is always controlled through one `StreamListener` instance.
 class StreamResource {
@@ -292,6 +391,7 @@ class StreamResource {
   uint64_t bytes_written_ = 0;
 
   friend class StreamListener;
+  friend class StreamPipe;  // For byte counting on the splice() path.
 };
 
 
@@ -371,6 +471,7 @@ class StreamBase : public StreamResource {
   template <enum encoding enc>
   int WriteString(const v8::FunctionCallbackInfo<v8::Value>& args);
   int UseUserBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int UseFraming(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static void GetFD(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetExternal(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -1,16 +1,29 @@
 #include "stream_pipe.h"
 #include "allocated_buffer-inl.h"
 #include "stream_base-inl.h"
+#include "stream_wrap.h"
+#include "threadpoolwork-inl.h"
+#include "node_blob.h"
+#include "node_bob-inl.h"
 #include "node_buffer.h"
+#include "node_file.h"
 #include "util-inl.h"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
 namespace node {
 
+using fs::FileHandle;
 using v8::Context;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Integer;
 using v8::Local;
 using v8::Object;
 using v8::Value;
@@ -45,6 +58,7 @@ StreamPipe::StreamPipe(StreamBase* source,
 
 StreamPipe::~StreamPipe() {
   Unpipe(true);
+  CloseKernelCopy();
 }
 
 StreamBase* StreamPipe::source() {
@@ -64,12 +78,25 @@ void StreamPipe::Unpipe(bool is_in_deletion) {
   // `OnStreamDestroy()`.
   if (!source_destroyed_)
     source()->ReadStop();
+  if (kernel_copy_ && kernel_copy_->source_poll_initialized)
+    uv_poll_stop(&kernel_copy_->source_poll);
 
   is_closed_ = true;
   is_reading_ = false;
   source()->RemoveStreamListener(&readable_listener_);
-  if (pending_writes_ == 0)
+  // Data that has been spliced out of the source but not into the sink yet
+  // is handed to the sink like any other pending write, so that it is
+  // written and counted before JS is told about the unpipe.
+  if (!is_in_deletion && !sink_destroyed_ && kernel_copy_ &&
+      kernel_copy_->buffered > 0) {
+    FallBackFromSplice();
+  }
+  // If that write finished synchronously, the sink has already been
+  // released in OnStreamAfterWrite().
+  if (pending_writes_ == 0 && writable_listener_.stream() != nullptr) {
     sink()->RemoveStreamListener(&writable_listener_);
+    CloseKernelCopy();
+  }
 
   if (is_in_deletion) return;
 
@@ -173,6 +200,7 @@ void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
       Context::Scope context_scope(env->context());
       pipe->MakeCallback(env->oncomplete_string(), 0, nullptr).ToLocalChecked();
       stream()->RemoveStreamListener(this);
+      pipe->CloseKernelCopy();
     }
     return;
   }
@@ -222,6 +250,7 @@ void StreamPipe::WritableListener::OnStreamDestroy() {
   pipe->is_eof_ = true;
   pipe->pending_writes_ = 0;
   pipe->Unpipe();
+  pipe->CloseKernelCopy();
 }
 
 void StreamPipe::WritableListener::OnStreamWantsWrite(size_t suggested_size) {
@@ -233,7 +262,10 @@ void StreamPipe::WritableListener::OnStreamWantsWrite(size_t suggested_size) {
   InternalCallbackScope callback_scope(pipe,
       InternalCallbackScope::kSkipTaskQueues);
   pipe->is_reading_ = true;
-  pipe->source()->ReadStart();
+  if (pipe->kernel_copy_)
+    pipe->StartKernelCopyRead();
+  else
+    pipe->source()->ReadStart();
 }
 
 uv_buf_t StreamPipe::WritableListener::OnStreamAlloc(size_t suggested_size) {
@@ -247,6 +279,341 @@ void StreamPipe::WritableListener::OnStreamRead(ssize_t nread,
   return previous_listener_->OnStreamRead(nread, buf);
 }
 
+StreamPipe::KernelCopy::KernelCopy(StreamPipe* pipe, bool from_file)
+    : ThreadPoolWork(pipe->env()), pipe(pipe), from_file(from_file) {}
+
+StreamPipe::KernelCopy::~KernelCopy() {
+  for (int fd : { source_fd, sink_fd, pipe_fds[0], pipe_fds[1] }) {
+    if (fd == -1) continue;
+    // These are duplicates of descriptors that the streams own, so there is
+    // nothing to report if closing them fails.
+    uv_fs_t close_req;
+    uv_fs_close(nullptr, &close_req, fd, nullptr);
+    uv_fs_req_cleanup(&close_req);
+  }
+}
+
+void StreamPipe::KernelCopy::Close() {
+  pipe = nullptr;
+  auto on_close = [](uv_poll_t* handle) {
+    KernelCopy* self = static_cast<KernelCopy*>(handle->data);
+    if (--self->open_handles == 0 && !self->sendfile_in_progress)
+      delete self;
+  };
+  if (source_poll_initialized) {
+    open_handles++;
+    env()->CloseHandle(&source_poll, on_close);
+  }
+  if (sink_poll_initialized) {
+    open_handles++;
+    env()->CloseHandle(&sink_poll, on_close);
+  }
+  if (open_handles == 0 && !sendfile_in_progress)
+    delete this;
+}
+
+void StreamPipe::KernelCopy::DoThreadPoolWork() {
+#ifdef __linux__
+  off_t offset = sendfile_offset;
+  do {
+    sendfile_result = sendfile(sink_fd,
+                               source_fd,
+                               sendfile_offset >= 0 ? &offset : nullptr,
+                               sendfile_length);
+  } while (sendfile_result == -1 && errno == EINTR);
+  if (sendfile_result == -1)
+    sendfile_result = uv_translate_sys_error(errno);
+#endif
+}
+
+void StreamPipe::KernelCopy::AfterThreadPoolWork(int status) {
+  CHECK_EQ(status, 0);
+  sendfile_in_progress = false;
+  if (pipe == nullptr) {
+    if (open_handles == 0)
+      delete this;
+    return;
+  }
+  pipe->AfterSendfile(sendfile_result);
+}
+
+bool StreamPipe::InitKernelCopy() {
+#ifdef __linux__
+  Local<FunctionTemplate> t = env()->libuv_stream_wrap_ctor_template();
+  if (t.IsEmpty() || !t->HasInstance(sink()->GetObject()))
+    return false;
+  LibuvStreamWrap* sink_wrap =
+      LibuvStreamWrap::From(env(), sink()->GetObject());
+
+  bool from_file = source()->GetAsyncWrap()->provider_type() ==
+                   AsyncWrap::PROVIDER_FILEHANDLE;
+  LibuvStreamWrap* source_wrap = nullptr;
+  if (from_file) {
+    if (!source()->IsAlive() || source()->IsClosing())
+      return false;
+  } else {
+    if (!t->HasInstance(source()->GetObject()))
+      return false;
+    source_wrap = LibuvStreamWrap::From(env(), source()->GetObject());
+    if (source_wrap->IsIPCPipe())
+      return false;
+  }
+
+  // Writes that are already queued on the sink need to go out first, and
+  // IPC pipes may need to transfer handles along with the data.
+  if (sink_wrap->IsIPCPipe() ||
+      uv_stream_get_write_queue_size(sink_wrap->stream()) > 0) {
+    return false;
+  }
+
+  int source_fd = source()->GetFD();
+  int sink_fd = sink_wrap->GetFD();
+  if (source_fd < 0 || sink_fd < 0)
+    return false;
+
+  std::unique_ptr<KernelCopy> copy =
+      std::make_unique<KernelCopy>(this, from_file);
+  copy->source_fd = fcntl(source_fd, F_DUPFD_CLOEXEC, 0);
+  copy->sink_fd = fcntl(sink_fd, F_DUPFD_CLOEXEC, 0);
+  if (copy->source_fd == -1 || copy->sink_fd == -1 ||
+      (!from_file && pipe2(copy->pipe_fds, O_NONBLOCK | O_CLOEXEC) != 0)) {
+    return false;
+  }
+
+  if (!from_file) {
+    if (uv_poll_init(env()->event_loop(),
+                     &copy->source_poll,
+                     copy->source_fd) != 0) {
+      return false;
+    }
+    copy->source_poll_initialized = true;
+    copy->source_poll.data = copy.get();
+  }
+
+  kernel_copy_ = std::move(copy);
+  if (uv_poll_init(env()->event_loop(),
+                   &kernel_copy_->sink_poll,
+                   kernel_copy_->sink_fd) != 0) {
+    CloseKernelCopy();
+    return false;
+  }
+  kernel_copy_->sink_poll_initialized = true;
+  kernel_copy_->sink_poll.data = kernel_copy_.get();
+
+  // From here on, only the kernel reads from the source.
+  source()->ReadStop();
+  return true;
+#else
+  return false;
+#endif
+}
+
+void StreamPipe::CloseKernelCopy() {
+  if (kernel_copy_)
+    kernel_copy_.release()->Close();
+}
+
+void StreamPipe::StartKernelCopyRead() {
+  KernelCopy* copy = kernel_copy_.get();
+  CHECK_EQ(copy->buffered, 0);
+  int err;
+  if (copy->from_file) {
+    // Files are always readable, so wait until the sink can take more data.
+    err = uv_poll_start(&copy->sink_poll, UV_WRITABLE, OnSinkPoll);
+  } else {
+    err = uv_poll_start(&copy->source_poll, UV_READABLE, OnSourcePoll);
+  }
+  if (err != 0)
+    readable_listener_.OnStreamRead(err, uv_buf_init(nullptr, 0));
+}
+
+void StreamPipe::OnSourcePoll(uv_poll_t* handle, int status, int events) {
+  StreamPipe* pipe = static_cast<KernelCopy*>(handle->data)->pipe;
+  HandleScope handle_scope(pipe->env()->isolate());
+  Context::Scope context_scope(pipe->env()->context());
+
+  if (status != 0) {
+    uv_poll_stop(handle);
+    pipe->readable_listener_.OnStreamRead(status, uv_buf_init(nullptr, 0));
+    return;
+  }
+
+  pipe->SpliceFromSource();
+}
+
+void StreamPipe::OnSinkPoll(uv_poll_t* handle, int status, int events) {
+  KernelCopy* copy = static_cast<KernelCopy*>(handle->data);
+  StreamPipe* pipe = copy->pipe;
+  HandleScope handle_scope(pipe->env()->isolate());
+  Context::Scope context_scope(pipe->env()->context());
+
+  if (copy->from_file) {
+    uv_poll_stop(handle);
+    if (status != 0) {
+      // Let the regular read and write paths report the error.
+      pipe->CloseKernelCopy();
+      pipe->source()->ReadStart();
+      return;
+    }
+    pipe->StartSendfile();
+    return;
+  }
+
+  if (status != 0) {
+    uv_poll_stop(handle);
+    pipe->FallBackFromSplice();
+    return;
+  }
+
+  pipe->SpliceToSink();
+}
+
+void StreamPipe::SpliceFromSource() {
+#ifdef __linux__
+  KernelCopy* copy = kernel_copy_.get();
+  CHECK_EQ(copy->buffered, 0);
+
+  ssize_t nread;
+  do {
+    nread = splice(copy->source_fd,
+                   nullptr,
+                   copy->pipe_fds[1],
+                   nullptr,
+                   std::min<size_t>(wanted_data_, 65536),
+                   SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+  } while (nread == -1 && errno == EINTR);
+
+  if (nread == -1 && errno == EAGAIN)
+    return;
+
+  if (nread == -1 && (errno == EINVAL || errno == ENOSYS)) {
+    // This combination of file types cannot be spliced; use regular reads.
+    CloseKernelCopy();
+    source()->ReadStart();
+    return;
+  }
+
+  if (nread <= 0) {
+    ssize_t err = nread == 0 ? UV_EOF : uv_translate_sys_error(errno);
+    uv_poll_stop(&copy->source_poll);
+    readable_listener_.OnStreamRead(err, uv_buf_init(nullptr, 0));
+    return;
+  }
+
+  source()->bytes_read_ += static_cast<uint64_t>(nread);
+  copy->buffered = nread;
+  is_reading_ = false;
+  uv_poll_stop(&copy->source_poll);
+  pending_writes_++;
+  SpliceToSink();
+#endif
+}
+
+void StreamPipe::SpliceToSink() {
+#ifdef __linux__
+  KernelCopy* copy = kernel_copy_.get();
+
+  while (copy->buffered > 0) {
+    ssize_t nwritten = splice(copy->pipe_fds[0],
+                              nullptr,
+                              copy->sink_fd,
+                              nullptr,
+                              copy->buffered,
+                              SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (nwritten == -1) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN) {
+        int err = uv_poll_start(&copy->sink_poll, UV_WRITABLE, OnSinkPoll);
+        if (err == 0)
+          return;
+      }
+      // Let the regular write path handle and report the error.
+      FallBackFromSplice();
+      return;
+    }
+    copy->buffered -= nwritten;
+    sink()->bytes_written_ += static_cast<uint64_t>(nwritten);
+  }
+
+  uv_poll_stop(&copy->sink_poll);
+  writable_listener_.OnStreamAfterWrite(nullptr, 0);
+#endif
+}
+
+void StreamPipe::FallBackFromSplice() {
+#ifdef __linux__
+  CHECK(kernel_copy_);
+  size_t buffered = kernel_copy_->buffered;
+  AllocatedBuffer buf;
+  if (buffered > 0) {
+    buf = AllocatedBuffer::AllocateManaged(env(), buffered);
+    ssize_t nread;
+    do {
+      nread = read(kernel_copy_->pipe_fds[0], buf.data(), buffered);
+    } while (nread == -1 && errno == EINTR);
+    CHECK_EQ(nread, static_cast<ssize_t>(buffered));
+  }
+  CloseKernelCopy();
+
+  if (buffered == 0)
+    return;
+  // Hand the data that is still in the kernel pipe to the regular write
+  // path, which takes care of reporting any errors.
+  pending_writes_--;
+  ProcessData(buffered, std::move(buf));
+#endif
+}
+
+void StreamPipe::StartSendfile() {
+  FileHandle* file = static_cast<FileHandle*>(source());
+  int64_t length = file->read_length();
+  if (length == 0) {
+    readable_listener_.OnStreamRead(UV_EOF, uv_buf_init(nullptr, 0));
+    return;
+  }
+
+  // sendfile() writes as much as the socket buffer takes and returns, so the
+  // chunk size only bounds the time that a single call may take.
+  static constexpr int64_t kSendfileChunkSize = 1024 * 1024;
+  KernelCopy* copy = kernel_copy_.get();
+  copy->sendfile_offset = file->read_offset();
+  copy->sendfile_length = length < 0 || length > kSendfileChunkSize ?
+      kSendfileChunkSize : length;
+  copy->sendfile_in_progress = true;
+  is_reading_ = false;
+  pending_writes_++;
+  copy->ScheduleWork();
+}
+
+void StreamPipe::AfterSendfile(ssize_t result) {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  if (result > 0) {
+    if (source() != nullptr)
+      static_cast<FileHandle*>(source())->AdvanceReadPosition(result);
+    sink()->bytes_written_ += static_cast<uint64_t>(result);
+  }
+
+  if (result > 0 || is_closed_ || is_eof_) {
+    writable_listener_.OnStreamAfterWrite(nullptr, 0);
+    return;
+  }
+
+  pending_writes_--;
+  is_reading_ = true;
+  if (result == UV_EAGAIN) {
+    StartKernelCopyRead();
+  } else if (result == 0) {
+    readable_listener_.OnStreamRead(UV_EOF, uv_buf_init(nullptr, 0));
+  } else {
+    // Let the regular read and write paths handle and report the error.
+    CloseKernelCopy();
+    source()->ReadStart();
+  }
+}
+
 void StreamPipe::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   CHECK(args[0]->IsObject());
@@ -261,6 +628,7 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
   pipe->is_closed_ = false;
+  pipe->InitKernelCopy();
   pipe->writable_listener_.OnStreamWantsWrite(65536);
 }
 
@@ -282,6 +650,339 @@ void StreamPipe::PendingWrites(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(pipe->pending_writes_);
 }
 
+StreamBaseSource::StreamBaseSource(StreamBase* stream) {
+  stream->PushStreamListener(this);
+}
+
+StreamBaseSource::~StreamBaseSource() {
+  if (stream() != nullptr)
+    stream()->ReadStop();
+}
+
+int StreamBaseSource::DoPull(
+    bob::Next<uv_buf_t> next,
+    int options,
+    uv_buf_t* data,
+    size_t count,
+    size_t max_count_hint) {
+  CHECK(!next_);
+  if (queued_.empty() && end_status_ == bob::STATUS_CONTINUE) {
+    if (options & bob::OPTIONS_SYNC) {
+      std::move(next)(bob::STATUS_BLOCK, nullptr, 0, [](size_t) {});
+      return bob::STATUS_BLOCK;
+    }
+    next_ = std::move(next);
+    int err = stream()->ReadStart();
+    if (err != 0) {
+      end_status_ = err;
+      Deliver();
+      return err;
+    }
+    return bob::STATUS_WAIT;
+  }
+
+  next_ = std::move(next);
+  int status = queued_.empty() ? end_status_ : bob::STATUS_CONTINUE;
+  Deliver();
+  return status;
+}
+
+// Passes the oldest queued chunk, or else the end of the stream, to the
+// pending Pull().
+void StreamBaseSource::Deliver() {
+  bob::Next<uv_buf_t> next = std::move(next_);
+  next_ = nullptr;
+  if (queued_.empty()) {
+    std::move(next)(end_status_, nullptr, 0, [](size_t) {});
+    return;
+  }
+  Chunk chunk = std::move(queued_.front());
+  queued_.pop_front();
+  uv_buf_t buf = uv_buf_init(chunk.data.get(), chunk.length);
+  std::shared_ptr<char> data = std::move(chunk.data);
+  std::move(next)(bob::STATUS_CONTINUE, &buf, 1, [data](size_t) {});
+}
+
+uv_buf_t StreamBaseSource::OnStreamAlloc(size_t suggested_size) {
+  buffer_.reset(new char[suggested_size], std::default_delete<char[]>());
+  return uv_buf_init(buffer_.get(), suggested_size);
+}
+
+void StreamBaseSource::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  std::shared_ptr<char> data = std::move(buffer_);
+  if (nread == 0)
+    return;
+  if (nread < 0) {
+    end_status_ = nread == UV_EOF ? bob::STATUS_END : static_cast<int>(nread);
+    stream()->ReadStop();
+    CHECK_NOT_NULL(previous_listener_);
+    previous_listener_->OnStreamRead(nread, uv_buf_init(nullptr, 0));
+  } else {
+    CHECK_EQ(data.get(), buf.base);
+    queued_.push_back(Chunk { std::move(data), static_cast<size_t>(nread) });
+    // Stop reading until the data is pulled, however the stream was
+    // started.
+    stream()->ReadStop();
+  }
+  if (next_)
+    Deliver();
+}
+
+void StreamBaseSource::OnStreamDestroy() {
+  if (end_status_ == bob::STATUS_CONTINUE)
+    end_status_ = UV_EPIPE;
+  if (next_)
+    Deliver();
+}
+
+SourcePipe::SourcePipe(Environment* env,
+                       Local<Object> obj,
+                       std::unique_ptr<Source> source,
+                       StreamBase* sink)
+    : AsyncWrap(env, obj, AsyncWrap::PROVIDER_STREAMPIPE),
+      source_(std::move(source)) {
+  MakeWeak();
+
+  CHECK_NOT_NULL(sink);
+  sink->PushStreamListener(&writable_listener_);
+
+  // The sink keeps the pipe alive while it is in use, as for StreamPipe.
+  obj->Set(env->context(), env->sink_string(), sink->GetObject()).Check();
+  sink->GetObject()->Set(env->context(), env->pipe_source_string(), obj)
+      .Check();
+}
+
+SourcePipe::~SourcePipe() {
+  if (!sink_destroyed_ && writable_listener_.stream() != nullptr)
+    sink()->RemoveStreamListener(&writable_listener_);
+}
+
+StreamBase* SourcePipe::sink() {
+  return static_cast<StreamBase*>(writable_listener_.stream());
+}
+
+// Pulls until the source has to wait for data or the sink for a write. The
+// calls to Next that happen synchronously continue the loop instead of
+// starting a new one.
+void SourcePipe::Pull() {
+  if (is_in_pull_loop_)
+    return;
+  is_in_pull_loop_ = true;
+  while (!is_closed_ && !is_ended_ && !is_pulling_ && !is_writing_) {
+    is_pulling_ = true;
+    // The reference keeps the pipe alive until the source is done with the
+    // callback, even if it is called after the pipe was closed.
+    BaseObjectPtr<SourcePipe> strong_ref{this};
+    source_->Pull(
+        [strong_ref](int status,
+                     const uv_buf_t* bufs,
+                     size_t count,
+                     bob::Done done) {
+          strong_ref->OnData(status, bufs, count, std::move(done));
+        },
+        bob::OPTIONS_NONE,
+        nullptr,
+        0);
+  }
+  is_in_pull_loop_ = false;
+}
+
+void SourcePipe::OnData(int status,
+                        const uv_buf_t* bufs,
+                        size_t count,
+                        bob::Done done) {
+  is_pulling_ = false;
+  if (is_closed_) {
+    std::move(done)(0);
+    return;
+  }
+  if (status < 0 && status != bob::STATUS_EOS) {
+    std::move(done)(0);
+    return Finish(status);
+  }
+
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  if (count > 0) {
+    size_t length = 0;
+    for (size_t n = 0; n < count; n++)
+      length += bufs[n].len;
+    StreamWriteResult res = sink()->Write(const_cast<uv_buf_t*>(bufs), count);
+    if (res.err != 0) {
+      std::move(done)(0);
+      return Finish(res.err);
+    }
+    if (res.async) {
+      // The data has to stay around until the write is done.
+      is_writing_ = true;
+      pending_done_ = std::move(done);
+      pending_length_ = length;
+    } else {
+      std::move(done)(length);
+    }
+  } else {
+    std::move(done)(0);
+  }
+
+  if (status == bob::STATUS_END || status == bob::STATUS_EOS)
+    is_ended_ = true;
+  if (is_ended_) {
+    if (!is_writing_)
+      Shutdown();
+    return;
+  }
+  if (status == bob::STATUS_BLOCK) {
+    // The source has no data right now and does not tell when it will, so
+    // try again later rather than spinning.
+    BaseObjectPtr<SourcePipe> strong_ref{this};
+    env()->SetImmediate([strong_ref](Environment* env) {
+      strong_ref->Pull();
+    });
+    return;
+  }
+  Pull();
+}
+
+void SourcePipe::Shutdown() {
+  int err = sink()->Shutdown();
+  if (err != 0)
+    Finish(err);
+}
+
+// Stops the pipe and reports the status to JS. The listener stays on the
+// sink until the write that is in progress, if any, is done.
+void SourcePipe::Finish(int status) {
+  if (is_closed_)
+    return;
+  is_closed_ = true;
+  if (!is_writing_ && !sink_destroyed_)
+    sink()->RemoveStreamListener(&writable_listener_);
+
+  // Delay the JS-facing part with SetImmediate, because this might be called
+  // synchronously from start(). The source is released there too, since this
+  // might be called from within its Pull().
+  BaseObjectPtr<SourcePipe> strong_ref{this};
+  env()->SetImmediate([strong_ref, status](Environment* env) {
+    strong_ref->source_.reset();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    Local<Value> arg = Integer::New(env->isolate(), status);
+    strong_ref->MakeCallback(env->oncomplete_string(), 1, &arg);
+  });
+}
+
+uv_buf_t SourcePipe::WritableListener::OnStreamAlloc(size_t suggested_size) {
+  CHECK_NOT_NULL(previous_listener_);
+  return previous_listener_->OnStreamAlloc(suggested_size);
+}
+
+void SourcePipe::WritableListener::OnStreamRead(ssize_t nread,
+                                                const uv_buf_t& buf) {
+  CHECK_NOT_NULL(previous_listener_);
+  return previous_listener_->OnStreamRead(nread, buf);
+}
+
+void SourcePipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
+                                                      int status) {
+  SourcePipe* pipe = ContainerOf(&SourcePipe::writable_listener_, this);
+  pipe->is_writing_ = false;
+  bob::Done done = std::move(pipe->pending_done_);
+  pipe->pending_done_ = nullptr;
+  std::move(done)(status == 0 ? pipe->pending_length_ : 0);
+
+  if (pipe->is_closed_) {
+    stream()->RemoveStreamListener(this);
+    return;
+  }
+  if (status != 0)
+    return pipe->Finish(status);
+  if (pipe->is_ended_)
+    return pipe->Shutdown();
+  pipe->Pull();
+}
+
+void SourcePipe::WritableListener::OnStreamAfterShutdown(ShutdownWrap* w,
+                                                         int status) {
+  SourcePipe* pipe = ContainerOf(&SourcePipe::writable_listener_, this);
+  CHECK_NOT_NULL(previous_listener_);
+  StreamListener* prev = previous_listener_;
+  pipe->Finish(status);
+  prev->OnStreamAfterShutdown(w, status);
+}
+
+void SourcePipe::WritableListener::OnStreamDestroy() {
+  SourcePipe* pipe = ContainerOf(&SourcePipe::writable_listener_, this);
+  pipe->sink_destroyed_ = true;
+  if (pipe->is_writing_) {
+    pipe->is_writing_ = false;
+    bob::Done done = std::move(pipe->pending_done_);
+    pipe->pending_done_ = nullptr;
+    std::move(done)(0);
+  }
+  pipe->Finish(UV_EPIPE);
+}
+
+void SourceTransform::AttachToObject(Local<Object> obj) {
+  obj->SetAlignedPointerInInternalField(kSourceTransformField, this);
+}
+
+SourceTransform* SourceTransform::FromObject(Local<Object> obj) {
+  if (obj->InternalFieldCount() < kInternalFieldCount ||
+      obj->GetAlignedPointerFromInternalField(kSlot) == nullptr) {
+    return nullptr;
+  }
+  return static_cast<SourceTransform*>(
+      obj->GetAlignedPointerFromInternalField(kSourceTransformField));
+}
+
+void SourcePipe::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsObject());
+
+  std::unique_ptr<Source> source;
+  if (Blob::HasInstance(env, args[0])) {
+    Blob* blob;
+    ASSIGN_OR_RETURN_UNWRAP(&blob, args[0]);
+    source = blob->CreateReader(env);
+  } else {
+    source = std::make_unique<StreamBaseSource>(
+        StreamBase::FromObject(args[0].As<Object>()));
+  }
+  StreamBase* sink = StreamBase::FromObject(args[1].As<Object>());
+
+  // new SourcePipe(source, sink[, transform])
+  if (args[2]->IsObject()) {
+    SourceTransform* transform =
+        SourceTransform::FromObject(args[2].As<Object>());
+    CHECK_NOT_NULL(transform);
+    source = transform->CreateSource(std::move(source));
+  }
+
+  new SourcePipe(env, args.This(), std::move(source), sink);
+}
+
+void SourcePipe::Start(const FunctionCallbackInfo<Value>& args) {
+  SourcePipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  CHECK(pipe->source_);
+  pipe->is_closed_ = false;
+  pipe->Pull();
+}
+
+void SourcePipe::Unpipe(const FunctionCallbackInfo<Value>& args) {
+  SourcePipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  pipe->Finish(UV_ECANCELED);
+}
+
+void SourcePipe::IsClosed(const FunctionCallbackInfo<Value>& args) {
+  SourcePipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  args.GetReturnValue().Set(pipe->is_closed_);
+}
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -300,6 +1001,16 @@ void InitializeStreamPipe(Local<Object> target,
   pipe->InstanceTemplate()->SetInternalFieldCount(
       StreamPipe::kInternalFieldCount);
   env->SetConstructorFunction(target, "StreamPipe", pipe);
+
+  Local<FunctionTemplate> source_pipe =
+      env->NewFunctionTemplate(SourcePipe::New);
+  env->SetProtoMethod(source_pipe, "unpipe", SourcePipe::Unpipe);
+  env->SetProtoMethod(source_pipe, "start", SourcePipe::Start);
+  env->SetProtoMethod(source_pipe, "isClosed", SourcePipe::IsClosed);
+  source_pipe->Inherit(AsyncWrap::GetConstructorTemplate(env));
+  source_pipe->InstanceTemplate()->SetInternalFieldCount(
+      SourcePipe::kInternalFieldCount);
+  env->SetConstructorFunction(target, "SourcePipe", source_pipe);
 }
 
 }  // anonymous namespace
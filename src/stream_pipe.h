@@ -5,6 +5,11 @@
 
 #include "stream_base.h"
 #include "allocated_buffer.h"
+#include "node_bob.h"
+#include "node_internals.h"
+
+#include <deque>
+#include <memory>
 
 namespace node {
 
@@ -45,6 +50,59 @@ class StreamPipe : public AsyncWrap {
 
   void ProcessData(size_t nread, AllocatedBuffer&& buf);
 
+  // On Linux, data can be moved from the source to the sink by the kernel
+  // rather than being read into and written out of user space memory:
+  // - Between two libuv streams, splice() is used through an intermediate
+  //   kernel pipe.
+  // - From a FileHandle into a libuv stream, sendfile() is used on the
+  //   threadpool, so that reading from disk does not block the event loop.
+  // The readiness polls use duplicated file descriptors so that they do not
+  // conflict with libuv's own watchers for the streams.
+  class KernelCopy final : public ThreadPoolWork {
+   public:
+    KernelCopy(StreamPipe* pipe, bool from_file);
+    ~KernelCopy() override;
+
+    // Free this object once the polls are closed and no sendfile() call
+    // is in progress. `pipe` is no longer used after this.
+    void Close();
+
+    void DoThreadPoolWork() override;
+    void AfterThreadPoolWork(int status) override;
+
+    StreamPipe* pipe;
+    const bool from_file;
+    int source_fd = -1;
+    int sink_fd = -1;
+    int pipe_fds[2] = { -1, -1 };
+    uv_poll_t source_poll;
+    uv_poll_t sink_poll;
+    bool source_poll_initialized = false;
+    bool sink_poll_initialized = false;
+    int open_handles = 0;
+    // Number of bytes currently held in the intermediate pipe.
+    size_t buffered = 0;
+
+    // The sendfile() call that is currently running on the threadpool.
+    bool sendfile_in_progress = false;
+    int64_t sendfile_offset = -1;
+    size_t sendfile_length = 0;
+    ssize_t sendfile_result = 0;
+  };
+
+  bool InitKernelCopy();
+  void CloseKernelCopy();
+  void StartKernelCopyRead();
+  void SpliceFromSource();
+  void SpliceToSink();
+  void StartSendfile();
+  void AfterSendfile(ssize_t result);
+  void FallBackFromSplice();
+  static void OnSourcePoll(uv_poll_t* handle, int status, int events);
+  static void OnSinkPoll(uv_poll_t* handle, int status, int events);
+
+  std::unique_ptr<KernelCopy> kernel_copy_;
+
   class ReadableListener : public StreamListener {
    public:
     uv_buf_t OnStreamAlloc(size_t suggested_size) override;
@@ -66,6 +124,127 @@ class StreamPipe : public AsyncWrap {
   WritableListener writable_listener_;
 };
 
+// Reads from a StreamBase, such as a LibuvStreamWrap or a FileHandle, as a
+// bob source. The stream is only read from while a Pull() is pending, so
+// that the consumer decides how much data is buffered. The end of the stream
+// and read errors are passed on to the previous listener as well, so that
+// the JS side learns about them. Read errors are reported as negative libuv
+// error codes.
+class StreamBaseSource final : public bob::SourceImpl<uv_buf_t>,
+                               public StreamListener {
+ public:
+  explicit StreamBaseSource(StreamBase* stream);
+  ~StreamBaseSource() override;
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override;
+
+ protected:
+  int DoPull(
+      bob::Next<uv_buf_t> next,
+      int options,
+      uv_buf_t* data,
+      size_t count,
+      size_t max_count_hint = bob::kMaxCountHint) override;
+
+ private:
+  struct Chunk {
+    std::shared_ptr<char> data;
+    size_t length;
+  };
+
+  void Deliver();
+
+  bob::Next<uv_buf_t> next_;
+  // The buffer of the read that is in progress.
+  std::shared_ptr<char> buffer_;
+  // Data that was read while no Pull() was pending, e.g. because the stream
+  // was read from by someone else.
+  std::deque<Chunk> queued_;
+  // The status of the end of the stream, once it is reached.
+  int end_status_ = bob::STATUS_CONTINUE;
+};
+
+// A transform that the data of a SourcePipe can pass through between the
+// source and the sink, such as a zlib stream. The objects of the transforms
+// keep a pointer to them in their kSourceTransformField, the way StreamBase
+// objects do.
+class SourceTransform {
+ public:
+  enum InternalFields {
+    kSlot = BaseObject::kSlot,
+    kSourceTransformField = BaseObject::kInternalFieldCount,
+    kInternalFieldCount
+  };
+
+  virtual ~SourceTransform() = default;
+
+  // Returns a source that yields the transformed data of `upstream`. A
+  // transform can only be used by one source.
+  virtual std::unique_ptr<bob::Source<uv_buf_t>> CreateSource(
+      std::unique_ptr<bob::Source<uv_buf_t>> upstream) = 0;
+
+  void AttachToObject(v8::Local<v8::Object> obj);
+  static SourceTransform* FromObject(v8::Local<v8::Object> obj);
+};
+
+// Pulls the data of a bob source, such as a Blob::Reader or a
+// StreamBaseSource, and writes it into a StreamBase without passing it
+// through JS, optionally passing it through a SourceTransform on the way. A
+// chunk is only pulled once the previous one is written, so a slow sink holds
+// back the source. Once the source ends, the sink is shut
+// down. oncomplete(status) is called when the pipe is done, with a libuv
+// error code if it failed.
+class SourcePipe : public AsyncWrap {
+ public:
+  using Source = bob::Source<uv_buf_t>;
+
+  SourcePipe(Environment* env,
+             v8::Local<v8::Object> obj,
+             std::unique_ptr<Source> source,
+             StreamBase* sink);
+  ~SourcePipe() override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void IsClosed(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(SourcePipe)
+  SET_SELF_SIZE(SourcePipe)
+
+ private:
+  inline StreamBase* sink();
+
+  void Pull();
+  void OnData(int status, const uv_buf_t* bufs, size_t count, bob::Done done);
+  void Shutdown();
+  void Finish(int status);
+
+  std::unique_ptr<Source> source_;
+  bob::Done pending_done_;
+  size_t pending_length_ = 0;
+  bool is_pulling_ = false;
+  bool is_in_pull_loop_ = false;
+  bool is_writing_ = false;
+  bool is_ended_ = false;
+  bool is_closed_ = true;
+  bool sink_destroyed_ = false;
+
+  class WritableListener : public StreamListener {
+   public:
+    uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+    void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+    void OnStreamAfterWrite(WriteWrap* w, int status) override;
+    void OnStreamAfterShutdown(ShutdownWrap* w, int status) override;
+    void OnStreamDestroy() override;
+  };
+
+  WritableListener writable_listener_;
+};
+
 }  // namespace node
 
 #endif
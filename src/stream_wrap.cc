@@ -32,6 +32,7 @@
 #include "udp_wrap.h"
 #include "util-inl.h"
 
+#include <algorithm>  // std::min(), std::max()
 #include <cstring>  // memcpy()
 #include <climits>  // INT_MAX
 
@@ -106,6 +107,8 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
 void LibuvStreamWrap::RegisterExternalReferences(
     ExternalReferenceRegistry* registry) {
   registry->Register(IsConstructCallCallback);
+  registry->Register(GetReadBufferSize);
+  registry->Register(GetReadCount);
 }
 
 LibuvStreamWrap::LibuvStreamWrap(Environment* env,
@@ -142,6 +145,26 @@ Local<FunctionTemplate> LibuvStreamWrap::GetConstructorTemplate(
         get_write_queue_size,
         Local<FunctionTemplate>(),
         static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+    Local<FunctionTemplate> get_read_buffer_size =
+        FunctionTemplate::New(env->isolate(),
+                              GetReadBufferSize,
+                              Local<Value>(),
+                              Signature::New(env->isolate(), tmpl));
+    tmpl->PrototypeTemplate()->SetAccessorProperty(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "readBufferSize"),
+        get_read_buffer_size,
+        Local<FunctionTemplate>(),
+        static_cast<PropertyAttribute>(ReadOnly | DontDelete));
+    Local<FunctionTemplate> get_read_count =
+        FunctionTemplate::New(env->isolate(),
+                              GetReadCount,
+                              Local<Value>(),
+                              Signature::New(env->isolate(), tmpl));
+    tmpl->PrototypeTemplate()->SetAccessorProperty(
+        FIXED_ONE_BYTE_STRING(env->isolate(), "readCount"),
+        get_read_count,
+        Local<FunctionTemplate>(),
+        static_cast<PropertyAttribute>(ReadOnly | DontDelete));
     env->SetProtoMethod(tmpl, "setBlocking", SetBlocking);
     StreamBase::AddMethods(env, tmpl);
     env->set_libuv_stream_wrap_ctor_template(tmpl);
@@ -209,7 +232,30 @@ void LibuvStreamWrap::OnUvAlloc(size_t suggested_size, uv_buf_t* buf) {
   HandleScope scope(env()->isolate());
   Context::Scope context_scope(env()->context());
 
-  *buf = EmitAlloc(suggested_size);
+  // libuv always suggests 64 KB, use what recent reads call for instead.
+  *buf = EmitAlloc(read_buffer_size_);
+}
+
+
+void LibuvStreamWrap::AdjustReadBufferSize(ssize_t nread,
+                                           const uv_buf_t* buf) {
+  // Listeners may provide buffers of their own size, those say nothing
+  // about how much data was available.
+  if (buf->len < read_buffer_size_)
+    return;
+
+  if (static_cast<size_t>(nread) == buf->len) {
+    small_reads_ = 0;
+    read_buffer_size_ = std::min(read_buffer_size_ * 2, kMaxReadBufferSize);
+  } else if (static_cast<size_t>(nread) <= read_buffer_size_ / 4 &&
+             read_buffer_size_ > kMinReadBufferSize) {
+    if (++small_reads_ == 2) {
+      small_reads_ = 0;
+      read_buffer_size_ = std::max(read_buffer_size_ / 2, kMinReadBufferSize);
+    }
+  } else {
+    small_reads_ = 0;
+  }
 }
 
 template <class WrapType>
@@ -252,6 +298,9 @@ void LibuvStreamWrap::OnUvRead(ssize_t nread, const uv_buf_t* buf) {
   CHECK_EQ(persistent().IsEmpty(), false);
 
   if (nread > 0) {
+    read_count_++;
+    AdjustReadBufferSize(nread, buf);
+
     MaybeLocal<Object> pending_obj;
 
     if (type == UV_TCP) {
@@ -292,6 +341,21 @@ void LibuvStreamWrap::GetWriteQueueSize(
 }
 
 
+void LibuvStreamWrap::GetReadBufferSize(
+    const FunctionCallbackInfo<Value>& info) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, info.This());
+  info.GetReturnValue().Set(static_cast<double>(wrap->read_buffer_size_));
+}
+
+
+void LibuvStreamWrap::GetReadCount(const FunctionCallbackInfo<Value>& info) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, info.This());
+  info.GetReturnValue().Set(static_cast<double>(wrap->read_count_));
+}
+
+
 void LibuvStreamWrap::SetBlocking(const FunctionCallbackInfo<Value>& args) {
   LibuvStreamWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -79,6 +79,16 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
 
   static LibuvStreamWrap* From(Environment* env, v8::Local<v8::Object> object);
 
+  // The size of the buffers to read into adapts to the size of recent reads,
+  // between these limits. A read that fills the buffer doubles the size for
+  // the next one, two reads in a row that would have fit into a quarter of it
+  // halve the size.
+  static constexpr size_t kMinReadBufferSize = 2 * 1024;
+  static constexpr size_t kInitialReadBufferSize = 64 * 1024;
+  static constexpr size_t kMaxReadBufferSize = 1024 * 1024;
+
+  inline size_t read_buffer_size() const { return read_buffer_size_; }
+
  protected:
   LibuvStreamWrap(Environment* env,
                   v8::Local<v8::Object> object,
@@ -101,17 +111,26 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
  private:
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetReadBufferSize(
+      const v8::FunctionCallbackInfo<v8::Value>& info);
+  static void GetReadCount(const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SetBlocking(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // Callbacks for libuv
   void OnUvAlloc(size_t suggested_size, uv_buf_t* buf);
   void OnUvRead(ssize_t nread, const uv_buf_t* buf);
+  void AdjustReadBufferSize(ssize_t nread, const uv_buf_t* buf);
 
   static void AfterUvWrite(uv_write_t* req, int status);
   static void AfterUvShutdown(uv_shutdown_t* req, int status);
 
   uv_stream_t* const stream_;
 
+  size_t read_buffer_size_ = kInitialReadBufferSize;
+  // Number of reads in a row that would have fit into a smaller buffer.
+  uint8_t small_reads_ = 0;
+  uint64_t read_count_ = 0;
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
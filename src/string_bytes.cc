@@ -32,6 +32,18 @@
 
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(_MSC_VER)
+#define NODE_HEX_AVX2 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NODE_HEX_NEON 1
+#include <arm_neon.h>
+#endif
+
 // When creating strings >= this length v8's gc spins up and consumes
 // most of the execution time. For these cases it's more performant to
 // use external string resources.
@@ -39,6 +51,7 @@
 
 namespace node {
 
+using v8::BackingStore;
 using v8::HandleScope;
 using v8::Isolate;
 using v8::Just;
@@ -162,6 +175,44 @@ MaybeLocal<Value> ExternTwoByteString::NewExternal(
   return String::NewExternalTwoByte(isolate, h_str).FromMaybe(Local<Value>());
 }
 
+// A one-byte string that points into the memory of an ArrayBuffer, which it
+// keeps alive.
+class ExternBackingStoreString : public String::ExternalOneByteStringResource {
+ public:
+  ExternBackingStoreString(Isolate* isolate,
+                           std::shared_ptr<BackingStore> store,
+                           size_t offset,
+                           size_t length)
+    : isolate_(isolate),
+      store_(std::move(store)),
+      data_(static_cast<const char*>(store_->Data()) + offset),
+      length_(length) {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(byte_length());
+  }
+
+  ~ExternBackingStoreString() override {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(-byte_length());
+  }
+
+  const char* data() const override {
+    return data_;
+  }
+
+  size_t length() const override {
+    return length_;
+  }
+
+  int64_t byte_length() const {
+    return store_->ByteLength();
+  }
+
+ private:
+  Isolate* isolate_;
+  std::shared_ptr<BackingStore> store_;
+  const char* data_;
+  size_t length_;
+};
+
 template <>
 MaybeLocal<Value> ExternOneByteString::NewSimpleFromCopy(Isolate* isolate,
                                                          const char* data,
@@ -243,13 +294,211 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+namespace {
+
+// Vectorized hex codecs. They stop at the first block that contains
+// anything but hex digits and leave the rest to the scalar loops, which
+// determine where exactly decoding ends.
+
+#if NODE_HEX_AVX2
+
+// Turns 16 bytes into 32 characters per iteration.
+__attribute__((target("avx2")))
+size_t HexEncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i table = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+      '0', '1', '2', '3', '4', '5', '6', '7',
+      '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+  size_t i = 0;
+  for (; i + 16 <= slen; i += 16) {
+    const __m256i in = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    // The high nibble of each byte goes into the first character.
+    const __m256i nibbles = _mm256_or_si256(
+        _mm256_srli_epi16(in, 4),
+        _mm256_slli_epi16(_mm256_and_si256(in, _mm256_set1_epi16(0x0f)), 8));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[i * 2]),
+                        _mm256_shuffle_epi8(table, nibbles));
+  }
+  return i;
+}
+
+// Decodes 32 characters into 16 bytes, unless there are characters other
+// than hex digits.
+__attribute__((target("avx2")))
+inline bool HexDecodeBlockAVX2(__m256i in, char* dst) {
+  const __m256i digits = _mm256_sub_epi8(in, _mm256_set1_epi8('0'));
+  const __m256i letters = _mm256_sub_epi8(
+      _mm256_or_si256(in, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+  const __m256i is_digit = _mm256_cmpeq_epi8(
+      _mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+  const __m256i is_letter = _mm256_cmpeq_epi8(
+      _mm256_min_epu8(letters, _mm256_set1_epi8(5)), letters);
+  if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1)
+    return false;
+
+  const __m256i values = _mm256_blendv_epi8(
+      _mm256_add_epi8(letters, _mm256_set1_epi8(10)), digits, is_digit);
+  // Combine each pair of nibbles, then gather the low bytes of the results.
+  const __m256i bytes =
+      _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+  const __m256i packed =
+      _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0xd8);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                   _mm256_castsi256_si128(packed));
+  return true;
+}
+
+__attribute__((target("avx2")))
+size_t HexDecodeAVX2(char* buf, size_t len,
+                     const char* src, size_t srcLen) {
+  size_t i = 0;
+  for (; i + 16 <= len && i * 2 + 32 <= srcLen; i += 16) {
+    const __m256i in = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&src[i * 2]));
+    if (!HexDecodeBlockAVX2(in, &buf[i]))
+      break;
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+size_t HexDecodeAVX2(char* buf, size_t len,
+                     const uint16_t* src, size_t srcLen) {
+  // Like the scalar loop, only the low byte of each character is looked at.
+  const __m256i mask = _mm256_set1_epi16(0xff);
+  size_t i = 0;
+  for (; i + 16 <= len && i * 2 + 32 <= srcLen; i += 16) {
+    const __m256i lo = _mm256_and_si256(mask, _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&src[i * 2])));
+    const __m256i hi = _mm256_and_si256(mask, _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(&src[i * 2 + 16])));
+    const __m256i in =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xd8);
+    if (!HexDecodeBlockAVX2(in, &buf[i]))
+      break;
+  }
+  return i;
+}
+
+bool HasAVX2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+const bool has_avx2 = HasAVX2();
+
+#elif NODE_HEX_NEON
+
+// Turns 16 bytes into 32 characters per iteration.
+size_t HexEncodeNEON(const char* src, size_t slen, char* dst) {
+  const uint8x16_t table =
+      vld1q_u8(reinterpret_cast<const uint8_t*>("0123456789abcdef"));
+
+  size_t i = 0;
+  for (; i + 16 <= slen; i += 16) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(&src[i]));
+    uint8x16x2_t out;
+    out.val[0] = vqtbl1q_u8(table, vshrq_n_u8(in, 4));
+    out.val[1] = vqtbl1q_u8(table, vandq_u8(in, vdupq_n_u8(0x0f)));
+    vst2q_u8(reinterpret_cast<uint8_t*>(&dst[i * 2]), out);
+  }
+  return i;
+}
+
+inline bool HexValuesNEON(uint8x16_t in, uint8x16_t* values) {
+  const uint8x16_t digits = vsubq_u8(in, vdupq_n_u8('0'));
+  const uint8x16_t letters =
+      vsubq_u8(vorrq_u8(in, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  const uint8x16_t is_digit = vcltq_u8(digits, vdupq_n_u8(10));
+  const uint8x16_t is_letter = vcltq_u8(letters, vdupq_n_u8(6));
+  if (vminvq_u8(vorrq_u8(is_digit, is_letter)) == 0)
+    return false;
+  *values = vbslq_u8(is_digit, digits, vaddq_u8(letters, vdupq_n_u8(10)));
+  return true;
+}
+
+// Decodes 32 characters, split into the first and second character of each
+// pair, into 16 bytes, unless there are characters other than hex digits.
+inline bool HexDecodeBlockNEON(uint8x16_t first, uint8x16_t second,
+                               char* dst) {
+  uint8x16_t hi;
+  uint8x16_t lo;
+  if (!HexValuesNEON(first, &hi) || !HexValuesNEON(second, &lo))
+    return false;
+  vst1q_u8(reinterpret_cast<uint8_t*>(dst), vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  return true;
+}
+
+size_t HexDecodeNEON(char* buf, size_t len,
+                     const char* src, size_t srcLen) {
+  size_t i = 0;
+  for (; i + 16 <= len && i * 2 + 32 <= srcLen; i += 16) {
+    const uint8x16x2_t in =
+        vld2q_u8(reinterpret_cast<const uint8_t*>(&src[i * 2]));
+    if (!HexDecodeBlockNEON(in.val[0], in.val[1], &buf[i]))
+      break;
+  }
+  return i;
+}
+
+size_t HexDecodeNEON(char* buf, size_t len,
+                     const uint16_t* src, size_t srcLen) {
+  size_t i = 0;
+  for (; i + 16 <= len && i * 2 + 32 <= srcLen; i += 16) {
+    // Like the scalar loop, only the low byte of each character is looked
+    // at, which is what vmovn_u16() keeps.
+    const uint16x8x2_t a = vld2q_u16(&src[i * 2]);
+    const uint16x8x2_t b = vld2q_u16(&src[i * 2 + 16]);
+    if (!HexDecodeBlockNEON(
+            vcombine_u8(vmovn_u16(a.val[0]), vmovn_u16(b.val[0])),
+            vcombine_u8(vmovn_u16(a.val[1]), vmovn_u16(b.val[1])),
+            &buf[i])) {
+      break;
+    }
+  }
+  return i;
+}
+
+#endif
+
+// Returns the number of bytes from `src` that were encoded into `dst`.
+size_t HexEncodeSIMD(const char* src, size_t slen, char* dst) {
+#if NODE_HEX_AVX2
+  if (has_avx2)
+    return HexEncodeAVX2(src, slen, dst);
+#elif NODE_HEX_NEON
+  return HexEncodeNEON(src, slen, dst);
+#endif
+  return 0;
+}
+
+// Returns the number of bytes that were decoded into `buf`.
+template <typename TypeName>
+size_t HexDecodeSIMD(char* buf, size_t len,
+                     const TypeName* src, size_t srcLen) {
+#if NODE_HEX_AVX2
+  if (has_avx2)
+    return HexDecodeAVX2(buf, len, src, srcLen);
+#elif NODE_HEX_NEON
+  return HexDecodeNEON(buf, len, src, srcLen);
+#endif
+  return 0;
+}
+
+}  // anonymous namespace
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
   size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  for (i = HexDecodeSIMD(buf, len, src, srcLen);
+       i < len && i * 2 + 1 < srcLen;
+       ++i) {
     unsigned a = unhex(static_cast<uint8_t>(src[i * 2 + 0]));
     unsigned b = unhex(static_cast<uint8_t>(src[i * 2 + 1]));
     if (!~a || !~b)
@@ -513,6 +762,18 @@ static bool contains_non_ascii(const char* src, size_t len) {
     len -= n;
   }
 
+#if defined(__SSE2__)
+  // Check 64 bytes at a time. This keeps `src` word-aligned for the loop
+  // below, which handles what is left.
+  for (; len >= 64; src += 64, len -= 64) {
+    const __m128i* srcv = reinterpret_cast<const __m128i*>(src);
+    const __m128i v = _mm_or_si128(
+        _mm_or_si128(_mm_loadu_si128(srcv), _mm_loadu_si128(srcv + 1)),
+        _mm_or_si128(_mm_loadu_si128(srcv + 2), _mm_loadu_si128(srcv + 3)));
+    if (_mm_movemask_epi8(v) != 0)
+      return true;
+  }
+#endif
 
 #if defined(_WIN64) || defined(_LP64)
   const uintptr_t mask = 0x8080808080808080ll;
@@ -600,7 +861,8 @@ size_t StringBytes::hex_encode(
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  const size_t n = HexEncodeSIMD(src, slen, dst);
+  for (size_t i = n, k = n * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -669,6 +931,10 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 
     case UTF8:
       {
+        // Pure ASCII input is also valid Latin-1, so skip the UTF-8 decoder
+        // and create a one-byte string directly.
+        if (!contains_non_ascii(buf, buflen))
+          return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
         val = String::NewFromUtf8(isolate,
                                   buf,
                                   v8::NewStringType::kNormal,
@@ -764,6 +1030,46 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 }
 
 
+MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
+                                      std::shared_ptr<BackingStore> store,
+                                      size_t offset,
+                                      size_t length,
+                                      enum encoding encoding,
+                                      Local<Value>* error) {
+  CHECK_LE(offset, store->ByteLength());
+  CHECK_LE(length, store->ByteLength() - offset);
+  char* data = static_cast<char*>(store->Data()) + offset;
+  if (length < EXTERN_APEX)
+    return Encode(isolate, data, length, encoding, error);
+
+  switch (encoding) {
+    case ASCII:
+      // Nothing else refers to the memory anymore, so it can be changed.
+      if (contains_non_ascii(data, length))
+        force_ascii(data, data, length);
+      break;
+    case UTF8:
+      if (contains_non_ascii(data, length))
+        return Encode(isolate, data, length, encoding, error);
+      break;
+    case LATIN1:
+      break;
+    default:
+      return Encode(isolate, data, length, encoding, error);
+  }
+
+  CHECK_BUFLEN_IN_RANGE(length);
+  ExternBackingStoreString* resource =
+      new ExternBackingStoreString(isolate, std::move(store), offset, length);
+  Local<String> str;
+  if (!String::NewExternalOneByte(isolate, resource).ToLocal(&str)) {
+    delete resource;
+    *error = node::ERR_STRING_TOO_LONG(isolate);
+    return MaybeLocal<Value>();
+  }
+  return str;
+}
+
 MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
                                       const uint16_t* buf,
                                       size_t buflen,
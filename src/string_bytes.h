@@ -29,6 +29,7 @@
 #include "v8.h"
 #include "env-inl.h"
 
+#include <memory>
 #include <string>
 
 namespace node {
@@ -85,6 +86,18 @@ class StringBytes {
                                           enum encoding encoding,
                                           v8::Local<v8::Value>* error);
 
+  // Like the above, but for `length` bytes at `offset` in `store`. Large
+  // ASCII, Latin-1 and pure ASCII UTF-8 input is not copied; the string
+  // keeps `store` alive instead. The caller must make sure that the memory
+  // is not modified afterwards, e.g. by detaching its ArrayBuffer.
+  static v8::MaybeLocal<v8::Value> Encode(
+      v8::Isolate* isolate,
+      std::shared_ptr<v8::BackingStore> store,
+      size_t offset,
+      size_t length,
+      enum encoding encoding,
+      v8::Local<v8::Value>* error);
+
   // Warning: This reverses endianness on BE platforms, even though the
   // signature using uint16_t implies that it should not.
   // However, the brokenness is already public API and can't therefore
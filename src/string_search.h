@@ -12,6 +12,14 @@
 #include <cstring>
 #include <algorithm>
 
+#if defined(__SSE2__) && defined(__GNUC__)
+#define NODE_STRING_SEARCH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define NODE_STRING_SEARCH_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace node {
 namespace stringsearch {
 
@@ -574,6 +582,195 @@ size_t StringSearch<Char>::InitialSearch(
   return subject.length();
 }
 
+//---------------------------------------------------------------------
+// Filter Search Strategy
+//---------------------------------------------------------------------
+
+// Short one-byte patterns are searched for by comparing their first and last
+// bytes against a block of positions of the subject at once and comparing the
+// rest only where both match, see http://0x80.pl/articles/simd-strfind.html.
+// Unlike the strategies above this needs no setup and does not degrade when
+// the first byte of the pattern is common in the subject. When the first
+// byte turns out to be rare, memchr() is used to skip ahead instead.
+static const size_t kMaxFilterSearchLength = 32;
+
+#if defined(NODE_STRING_SEARCH_SSE2) || defined(NODE_STRING_SEARCH_NEON)
+// Returns a mask of the kFilterBlockSize positions starting at `subject` at
+// which the byte is `first` and the byte `distance` bytes further is `last`.
+// Each position is represented by kFilterBitsPerPosition bits, the lowest of
+// which is set on a match.
+#if defined(NODE_STRING_SEARCH_SSE2)
+static const size_t kFilterBlockSize = 64;
+static const size_t kFilterBitsPerPosition = 1;
+
+inline uint64_t FilterCandidates16(const uint8_t* subject,
+                                   size_t distance,
+                                   __m128i first,
+                                   __m128i last) {
+  const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(subject));
+  const __m128i b =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(subject + distance));
+  return static_cast<unsigned>(_mm_movemask_epi8(
+      _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+}
+
+inline uint64_t FilterCandidates(const uint8_t* subject,
+                                 size_t distance,
+                                 uint8_t first,
+                                 uint8_t last) {
+  const __m128i first_v = _mm_set1_epi8(first);
+  const __m128i last_v = _mm_set1_epi8(last);
+  return FilterCandidates16(subject, distance, first_v, last_v) |
+         FilterCandidates16(subject + 16, distance, first_v, last_v) << 16 |
+         FilterCandidates16(subject + 32, distance, first_v, last_v) << 32 |
+         FilterCandidates16(subject + 48, distance, first_v, last_v) << 48;
+}
+#else
+static const size_t kFilterBlockSize = 16;
+static const size_t kFilterBitsPerPosition = 4;
+
+inline uint64_t FilterCandidates(const uint8_t* subject,
+                                 size_t distance,
+                                 uint8_t first,
+                                 uint8_t last) {
+  const uint8x16_t eq =
+      vandq_u8(vceqq_u8(vld1q_u8(subject), vdupq_n_u8(first)),
+               vceqq_u8(vld1q_u8(subject + distance), vdupq_n_u8(last)));
+  // Narrow each byte of the comparison result to a nibble.
+  const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) &
+         0x1111111111111111ull;
+}
+#endif
+
+// After this many bytes without a candidate, memchr() is used to find the
+// next occurrence of the first byte. The distance doubles, up to the maximum,
+// while that does not skip much.
+static const size_t kFilterMinSkipDistance = 4 * kFilterBlockSize;
+static const size_t kFilterMaxSkipDistance = 64 * kFilterBlockSize;
+#endif
+
+inline bool FilterMatches(const uint8_t* subject,
+                          const uint8_t* pattern,
+                          size_t pattern_length) {
+  return memcmp(subject + 1, pattern + 1, pattern_length - 2) == 0;
+}
+
+// Returns the first position at or after `index` at which `pattern` occurs in
+// `subject`, or `subject_length`.
+inline size_t FilterSearchForward(const uint8_t* subject,
+                                  size_t subject_length,
+                                  const uint8_t* pattern,
+                                  size_t pattern_length,
+                                  size_t index) {
+  CHECK_GT(pattern_length, 1);
+  const uint8_t first = pattern[0];
+  const uint8_t last = pattern[pattern_length - 1];
+  const size_t max_n = subject_length - pattern_length + 1;
+
+  size_t i = index;
+#if defined(NODE_STRING_SEARCH_SSE2) || defined(NODE_STRING_SEARCH_NEON)
+  size_t skip_distance = kFilterMinSkipDistance;
+  size_t misses = 0;
+  while (i + kFilterBlockSize <= max_n) {
+    uint64_t candidates =
+        FilterCandidates(subject + i, pattern_length - 1, first, last);
+    if (candidates == 0) {
+      i += kFilterBlockSize;
+      misses += kFilterBlockSize;
+      if (misses >= skip_distance && i < max_n) {
+        const void* found = memchr(subject + i, first, max_n - i);
+        if (found == nullptr)
+          return subject_length;
+        const size_t next = static_cast<const uint8_t*>(found) - subject;
+        skip_distance = next - i < kFilterMinSkipDistance ?
+            std::min(skip_distance * 2, kFilterMaxSkipDistance) :
+            kFilterMinSkipDistance;
+        misses = 0;
+        i = next;
+      }
+      continue;
+    }
+    misses = 0;
+    do {
+      const size_t pos =
+          i + __builtin_ctzll(candidates) / kFilterBitsPerPosition;
+      if (FilterMatches(subject + pos, pattern, pattern_length))
+        return pos;
+      candidates &= candidates - 1;
+    } while (candidates != 0);
+    i += kFilterBlockSize;
+  }
+#endif
+  for (; i < max_n; i++) {
+    if (subject[i] == first &&
+        subject[i + pattern_length - 1] == last &&
+        FilterMatches(subject + i, pattern, pattern_length)) {
+      return i;
+    }
+  }
+  return subject_length;
+}
+
+// Returns the last position at or before `index` at which `pattern` occurs in
+// `subject`, or `subject_length`.
+inline size_t FilterSearchBackward(const uint8_t* subject,
+                                   size_t subject_length,
+                                   const uint8_t* pattern,
+                                   size_t pattern_length,
+                                   size_t index) {
+  CHECK_GT(pattern_length, 1);
+  CHECK_LE(index + pattern_length, subject_length);
+  const uint8_t first = pattern[0];
+  const uint8_t last = pattern[pattern_length - 1];
+
+  // Positions below `end` are left to search.
+  size_t end = index + 1;
+#if defined(NODE_STRING_SEARCH_SSE2) || defined(NODE_STRING_SEARCH_NEON)
+  size_t skip_distance = kFilterMinSkipDistance;
+  size_t misses = 0;
+  while (end >= kFilterBlockSize) {
+    const size_t start = end - kFilterBlockSize;
+    uint64_t candidates =
+        FilterCandidates(subject + start, pattern_length - 1, first, last);
+    if (candidates == 0) {
+      end = start;
+      misses += kFilterBlockSize;
+      if (misses >= skip_distance && end > 0) {
+        const void* found = MemrchrFill(subject, first, end);
+        if (found == nullptr)
+          return subject_length;
+        const size_t next = static_cast<const uint8_t*>(found) - subject + 1;
+        skip_distance = end - next < kFilterMinSkipDistance ?
+            std::min(skip_distance * 2, kFilterMaxSkipDistance) :
+            kFilterMinSkipDistance;
+        misses = 0;
+        end = next;
+      }
+      continue;
+    }
+    misses = 0;
+    do {
+      const unsigned bit = 63 - __builtin_clzll(candidates);
+      const size_t pos = start + bit / kFilterBitsPerPosition;
+      if (FilterMatches(subject + pos, pattern, pattern_length))
+        return pos;
+      candidates &= ~(uint64_t{1} << bit);
+    } while (candidates != 0);
+    end = start;
+  }
+#endif
+  while (end > 0) {
+    const size_t i = --end;
+    if (subject[i] == first &&
+        subject[i + pattern_length - 1] == last &&
+        FilterMatches(subject + i, pattern, pattern_length)) {
+      return i;
+    }
+  }
+  return subject_length;
+}
+
 // Perform a single stand-alone search.
 // If searching multiple times for the same pattern, a search
 // object should be constructed once and the Search function then called
@@ -614,6 +811,19 @@ size_t SearchString(const Char* haystack,
   } else {
     relative_start_index = diff - start_index;
   }
+  if (sizeof(Char) == 1 &&
+      needle_length > 1 &&
+      needle_length <= stringsearch::kMaxFilterSearchLength) {
+    const uint8_t* haystack8 = reinterpret_cast<const uint8_t*>(haystack);
+    const uint8_t* needle8 = reinterpret_cast<const uint8_t*>(needle);
+    if (is_forward) {
+      return stringsearch::FilterSearchForward(
+          haystack8, haystack_length, needle8, needle_length, start_index);
+    }
+    return stringsearch::FilterSearchBackward(
+        haystack8, haystack_length, needle8, needle_length,
+        diff - relative_start_index);
+  }
   size_t pos = node::stringsearch::SearchString(
       v_haystack, v_needle, relative_start_index);
   if (pos == haystack_length) {
@@ -24,14 +24,27 @@
 #include "connection_wrap.h"
 #include "env-inl.h"
 #include "handle_wrap.h"
+#include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_internals.h"
+#include "node_sockaddr-inl.h"
 #include "connect_wrap.h"
 #include "stream_base-inl.h"
 #include "stream_wrap.h"
 #include "util-inl.h"
 
+#include <cstddef>  // offsetof
 #include <cstdlib>
+#include <limits>
+
+#ifndef _WIN32
+#include <fcntl.h>  // fcntl
+#endif
+
+#ifdef __linux__
+#include <netinet/tcp.h>  // tcp_info
+#include <sys/socket.h>  // getsockopt
+#endif
 
 
 namespace node {
@@ -42,10 +55,12 @@ using v8::EscapableHandleScope;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Float64Array;
 using v8::Int32;
 using v8::Integer;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::Number;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
@@ -85,8 +100,10 @@ void TCPWrap::Initialize(Local<Object> target,
   t->Inherit(LibuvStreamWrap::GetConstructorTemplate(env));
 
   env->SetProtoMethod(t, "open", Open);
+  env->SetProtoMethod(t, "dupFd", DupFd);
   env->SetProtoMethod(t, "bind", Bind);
   env->SetProtoMethod(t, "listen", Listen);
+  env->SetProtoMethod(t, "setConnectionRateLimit", SetConnectionRateLimit);
   env->SetProtoMethod(t, "connect", Connect);
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "connect6", Connect6);
@@ -96,6 +113,7 @@ void TCPWrap::Initialize(Local<Object> target,
                       GetSockOrPeerName<TCPWrap, uv_tcp_getpeername>);
   env->SetProtoMethod(t, "setNoDelay", SetNoDelay);
   env->SetProtoMethod(t, "setKeepAlive", SetKeepAlive);
+  env->SetProtoMethod(t, "getTCPInfo", GetTCPInfo);
 
 #ifdef _WIN32
   env->SetProtoMethod(t, "setSimultaneousAccepts", SetSimultaneousAccepts);
@@ -115,6 +133,8 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_TCP_REUSEPORT);
+  NODE_DEFINE_CONSTANT(constants, kTCPInfoFieldsCount);
   target->Set(context,
               env->constants_string(),
               constants).Check();
@@ -211,6 +231,105 @@ void TCPWrap::Open(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(err);
 }
 
+// Returns a duplicate of the socket's file descriptor, or a negative error
+// code. The duplicate stays valid after the handle is closed, which allows
+// handing a connection to another thread's event loop.
+void TCPWrap::DupFd(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+#ifdef _WIN32
+  args.GetReturnValue().Set(UV_ENOTSUP);
+#else
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (err == 0) {
+    int dup_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    err = dup_fd >= 0 ? dup_fd : uv_translate_sys_error(errno);
+  }
+  args.GetReturnValue().Set(err);
+#endif
+}
+
+#ifdef __linux__
+namespace {
+// The tcp_info of glibc ends at tcpi_total_retrans. Linux has been appending
+// fields to it since, these are the ones used here. Kernels that are too old
+// to know about them do not fill them in.
+struct ExtendedTCPInfo {
+  struct tcp_info base;
+  uint64_t tcpi_pacing_rate;
+  uint64_t tcpi_max_pacing_rate;
+  uint64_t tcpi_bytes_acked;
+  uint64_t tcpi_bytes_received;
+  uint32_t tcpi_segs_out;
+  uint32_t tcpi_segs_in;
+  uint32_t tcpi_notsent_bytes;
+  uint32_t tcpi_min_rtt;
+  uint32_t tcpi_data_segs_in;
+  uint32_t tcpi_data_segs_out;
+  uint64_t tcpi_delivery_rate;
+};
+}  // anonymous namespace
+#endif
+
+// Fills the Float64Array that is passed in with the TCPInfoFields, from the
+// kernel's TCP_INFO for the socket. Fields that the kernel does not report
+// are set to NaN. Returns 0 or a negative error code.
+void TCPWrap::GetTCPInfo(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), kTCPInfoFieldsCount);
+#ifdef __linux__
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (err != 0)
+    return args.GetReturnValue().Set(err);
+
+  ExtendedTCPInfo info{};
+  socklen_t len = sizeof(info);
+  if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &len) != 0)
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+
+  auto has = [&](size_t end) { return len >= end; };
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+  fields[kTCPInfoState] = info.base.tcpi_state;
+  fields[kTCPInfoRtt] = info.base.tcpi_rtt;
+  fields[kTCPInfoRttVar] = info.base.tcpi_rttvar;
+  fields[kTCPInfoMinRtt] =
+      has(offsetof(ExtendedTCPInfo, tcpi_min_rtt) + sizeof(uint32_t)) ?
+          info.tcpi_min_rtt : kNaN;
+  fields[kTCPInfoRto] = info.base.tcpi_rto;
+  fields[kTCPInfoSndCwnd] = info.base.tcpi_snd_cwnd;
+  fields[kTCPInfoSndSsthresh] = info.base.tcpi_snd_ssthresh;
+  fields[kTCPInfoSndMss] = info.base.tcpi_snd_mss;
+  fields[kTCPInfoUnacked] = info.base.tcpi_unacked;
+  fields[kTCPInfoLost] = info.base.tcpi_lost;
+  fields[kTCPInfoRetransmits] = info.base.tcpi_retransmits;
+  fields[kTCPInfoTotalRetrans] = info.base.tcpi_total_retrans;
+  fields[kTCPInfoDeliveryRate] =
+      has(offsetof(ExtendedTCPInfo, tcpi_delivery_rate) + sizeof(uint64_t)) ?
+          static_cast<double>(info.tcpi_delivery_rate) : kNaN;
+  fields[kTCPInfoBytesAcked] =
+      has(offsetof(ExtendedTCPInfo, tcpi_bytes_acked) + sizeof(uint64_t)) ?
+          static_cast<double>(info.tcpi_bytes_acked) : kNaN;
+  fields[kTCPInfoBytesReceived] =
+      has(offsetof(ExtendedTCPInfo, tcpi_bytes_received) + sizeof(uint64_t)) ?
+          static_cast<double>(info.tcpi_bytes_received) : kNaN;
+  args.GetReturnValue().Set(0);
+#else
+  args.GetReturnValue().Set(UV_ENOTSUP);
+#endif
+}
+
 template <typename T>
 void TCPWrap::Bind(
     const FunctionCallbackInfo<Value>& args,
@@ -225,7 +344,7 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
+  if ((family == AF_INET6 || !args[2]->IsUndefined()) &&
       !args[2]->Uint32Value(env->context()).To(&flags)) {
     return;
   }
@@ -266,6 +385,52 @@ void TCPWrap::Listen(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TCPWrap::SetConnectionRateLimit(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  CHECK(args[2]->IsUint32());
+  wrap->connection_rate_limiter_ = std::make_unique<SocketAddressRateLimiter>(
+      args[0].As<Number>()->Value(),
+      args[1].As<Number>()->Value(),
+      args[2].As<Uint32>()->Value());
+}
+
+
+bool TCPWrap::AllowConnection(TCPWrap* client) {
+  if (!connection_rate_limiter_)
+    return true;
+  SocketAddress peer = SocketAddress::FromPeerName(client->handle_);
+  // The peer may already be gone, the read then reports the error.
+  if (peer.family() != AF_INET && peer.family() != AF_INET6)
+    return true;
+  return connection_rate_limiter_->Consume(peer);
+}
+
+
+void TCPWrap::ApplyBusyPoll() {
+#ifdef SO_BUSY_POLL
+  const uint64_t busy_poll_us = env()->options()->event_loop_busy_poll;
+  if (busy_poll_us == 0)
+    return;
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd) != 0)
+    return;
+  // Values above net.core.busy_read need CAP_NET_ADMIN. Without it the loop
+  // still busy polls, only the socket does not.
+  int value = static_cast<int>(busy_poll_us);
+  setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &value, sizeof(value));
+#endif
+}
+
+
+void TCPWrap::MemoryInfo(MemoryTracker* tracker) const {
+  if (connection_rate_limiter_)
+    tracker->TrackField("connection_rate_limiter", *connection_rate_limiter_);
+}
+
+
 void TCPWrap::Connect(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[2]->IsUint32());
   // explicit cast to fit to libuv's type expectation
@@ -26,6 +26,9 @@
 
 #include "async_wrap.h"
 #include "connection_wrap.h"
+#include "node_sockaddr.h"
+
+#include <memory>
 
 namespace node {
 
@@ -38,6 +41,27 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
     SERVER
   };
 
+  // The fields that getTCPInfo() writes into the Float64Array it is passed.
+  // Times are in microseconds, the delivery rate in bytes per second.
+  enum TCPInfoFields {
+    kTCPInfoState,
+    kTCPInfoRtt,
+    kTCPInfoRttVar,
+    kTCPInfoMinRtt,
+    kTCPInfoRto,
+    kTCPInfoSndCwnd,
+    kTCPInfoSndSsthresh,
+    kTCPInfoSndMss,
+    kTCPInfoUnacked,
+    kTCPInfoLost,
+    kTCPInfoRetransmits,
+    kTCPInfoTotalRetrans,
+    kTCPInfoDeliveryRate,
+    kTCPInfoBytesAcked,
+    kTCPInfoBytesReceived,
+    kTCPInfoFieldsCount
+  };
+
   static v8::MaybeLocal<v8::Object> Instantiate(Environment* env,
                                                 AsyncWrap* parent,
                                                 SocketType type);
@@ -46,7 +70,15 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
                          v8::Local<v8::Context> context,
                          void* priv);
 
-  SET_NO_MEMORY_INFO()
+  // Returns false if the connection that was accepted into client has to be
+  // closed because its peer is over the connection rate limit of the server.
+  bool AllowConnection(TCPWrap* client);
+
+  // Sets SO_BUSY_POLL on an accepted socket when --event-loop-busy-poll is
+  // used, where the platform supports it.
+  void ApplyBusyPoll();
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
   SET_SELF_SIZE(TCPWrap)
   std::string MemoryInfoName() const override {
     switch (provider_type()) {
@@ -75,18 +107,24 @@ class TCPWrap : public ConnectionWrap<TCPWrap, uv_tcp_t> {
   static void Bind(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Listen(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetConnectionRateLimit(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Connect(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Connect6(const v8::FunctionCallbackInfo<v8::Value>& args);
   template <typename T>
   static void Connect(const v8::FunctionCallbackInfo<v8::Value>& args,
       std::function<int(const char* ip_address, T* addr)> uv_ip_addr);
   static void Open(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DupFd(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetTCPInfo(const v8::FunctionCallbackInfo<v8::Value>& args);
   template <typename T>
   static void Bind(
       const v8::FunctionCallbackInfo<v8::Value>& args,
       int family,
       std::function<int(const char* ip_address, int port, T* addr)> uv_ip_addr);
 
+  std::unique_ptr<SocketAddressRateLimiter> connection_rate_limiter_;
+
 #ifdef _WIN32
   static void SetSimultaneousAccepts(
       const v8::FunctionCallbackInfo<v8::Value>& args);
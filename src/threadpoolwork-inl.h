@@ -24,30 +24,111 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
-#include "util-inl.h"
+#include "env-inl.h"
+#include "histogram-inl.h"
 #include "node_internals.h"
+#include "node_options-inl.h"
+#include "util-inl.h"
+
+#include <algorithm>
 
 namespace node {
 
+inline void TraceThreadPoolWorkClassState(ThreadPoolWorkClass work_class,
+                                          ThreadPoolWorkClassState* state) {
+  TRACE_COUNTER2(TRACING_CATEGORY_NODE1(threadpool),
+                 ThreadPoolWorkClassName(work_class),
+                 "running", state->running,
+                 "queued", state->pending.size());
+}
+
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
+  ThreadPoolWorkClassState* state =
+      env_->threadpool_work_class_state(work_class_);
+  state->scheduled++;
+  wait_histogram_ = state->wait_histogram;
+  run_histogram_ = state->run_histogram;
+  if (wait_histogram_ || run_histogram_)
+    schedule_time_ = uv_hrtime();
+  const std::vector<uint32_t>& limits =
+      per_process::cli_options->threadpool_work_limits;
+  size_t index = static_cast<size_t>(work_class_);
+  if (index < limits.size() && limits[index] != 0 &&
+      state->running >= limits[index]) {
+    auto it = std::find_if(state->pending.begin(),
+                           state->pending.end(),
+                           [&](ThreadPoolWork* work) {
+                             return work->priority_ < priority_;
+                           });
+    state->pending.insert(it, this);
+    TraceThreadPoolWorkClassState(work_class_, state);
+    return;
+  }
+  QueueWork();
+  TraceThreadPoolWorkClassState(work_class_, state);
+}
+
+void ThreadPoolWork::QueueWork() {
+  env_->threadpool_work_class_state(work_class_)->running++;
   int status = uv_queue_work(
       env_->event_loop(),
       &work_req_,
       [](uv_work_t* req) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
-        self->DoThreadPoolWork();
+        self->RunWork();
       },
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
+        ThreadPoolWorkClassState* state =
+            self->env_->threadpool_work_class_state(self->work_class_);
+        state->running--;
+        state->completed++;
+        // Work that has been waiting for this slot goes first, before
+        // anything that AfterThreadPoolWork() schedules.
+        if (!state->pending.empty()) {
+          ThreadPoolWork* next = state->pending.front();
+          state->pending.pop_front();
+          next->QueueWork();
+        }
+        TraceThreadPoolWorkClassState(self->work_class_, state);
         self->env_->DecreaseWaitingRequestCounter();
         self->AfterThreadPoolWork(status);
       });
   CHECK_EQ(status, 0);
 }
 
+void ThreadPoolWork::RunWork() {
+  uint64_t start = 0;
+  if (wait_histogram_ || run_histogram_) {
+    start = uv_hrtime();
+    if (wait_histogram_)
+      wait_histogram_->Record(std::max<int64_t>(start - schedule_time_, 1));
+  }
+  {
+    TRACE_EVENT1(TRACING_CATEGORY_NODE1(threadpool), "ThreadPoolWork",
+                 "class", ThreadPoolWorkClassName(work_class_));
+    DoThreadPoolWork();
+  }
+  if (run_histogram_)
+    run_histogram_->Record(std::max<int64_t>(uv_hrtime() - start, 1));
+}
+
 int ThreadPoolWork::CancelWork() {
-  return uv_cancel(reinterpret_cast<uv_req_t*>(&work_req_));
+  ThreadPoolWorkClassState* state =
+      env_->threadpool_work_class_state(work_class_);
+  auto it = std::find(state->pending.begin(), state->pending.end(), this);
+  if (it == state->pending.end())
+    return uv_cancel(reinterpret_cast<uv_req_t*>(&work_req_));
+
+  // Like uv_cancel(), complete the work with UV_ECANCELED asynchronously.
+  state->pending.erase(it);
+  env_->SetImmediate([this](Environment* env) {
+    env->threadpool_work_class_state(work_class_)->completed++;
+    env->DecreaseWaitingRequestCounter();
+    AfterThreadPoolWork(UV_ECANCELED);
+  });
+  return 0;
 }
 
 }  // namespace node
@@ -1,5 +1,6 @@
 #include "tracing/node_trace_buffer.h"
 
+#include <algorithm>
 #include <memory>
 #include "util-inl.h"
 
@@ -8,91 +9,115 @@ namespace tracing {
 
 InternalTraceBuffer::InternalTraceBuffer(size_t max_chunks, uint32_t id,
                                          Agent* agent)
-    : flushing_(false), max_chunks_(max_chunks),
-      agent_(agent), id_(id) {
-  chunks_.resize(max_chunks);
+    : max_chunks_(max_chunks),
+      agent_(agent),
+      chunks_(new std::atomic<TraceBufferChunk*>[max_chunks]),
+      id_(id) {
+  for (size_t i = 0; i < max_chunks_; ++i)
+    chunks_[i].store(nullptr, std::memory_order_relaxed);
+}
+
+InternalTraceBuffer::~InternalTraceBuffer() {
+  for (size_t i = 0; i < max_chunks_; ++i)
+    delete chunks_[i].load(std::memory_order_relaxed);
+}
+
+TraceBufferChunk* InternalTraceBuffer::GetChunk(size_t chunk_index,
+                                                bool create) {
+  std::atomic<TraceBufferChunk*>& slot = chunks_[chunk_index];
+  TraceBufferChunk* chunk = slot.load(std::memory_order_acquire);
+  if (chunk != nullptr || !create)
+    return chunk;
+  // Threads that add the first events of a chunk at the same time race to
+  // allocate it. The chunks are kept until the buffer is destroyed.
+  std::unique_ptr<TraceBufferChunk> new_chunk =
+      std::make_unique<TraceBufferChunk>(0);
+  if (slot.compare_exchange_strong(chunk, new_chunk.get(),
+                                   std::memory_order_acq_rel)) {
+    chunk = new_chunk.release();
+  }
+  return chunk;
 }
 
 TraceObject* InternalTraceBuffer::AddTraceEvent(uint64_t* handle) {
-  Mutex::ScopedLock scoped_lock(mutex_);
-  // Create new chunk if last chunk is full or there is no chunk.
-  if (total_chunks_ == 0 || chunks_[total_chunks_ - 1]->IsFull()) {
-    auto& chunk = chunks_[total_chunks_++];
-    if (chunk) {
-      chunk->Reset(current_chunk_seq_++);
-    } else {
-      chunk = std::make_unique<TraceBufferChunk>(current_chunk_seq_++);
-    }
+  uint32_t chunk_seq = current_chunk_seq_.load(std::memory_order_acquire);
+  size_t index = next_event_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= Capacity()) {
+    // The buffer is full or being flushed.
+    *handle = 0;
+    return nullptr;
   }
-  auto& chunk = chunks_[total_chunks_ - 1];
-  size_t event_index;
-  TraceObject* trace_object = chunk->AddTraceEvent(&event_index);
-  *handle = MakeHandle(total_chunks_ - 1, chunk->seq(), event_index);
-  return trace_object;
+  TraceBufferChunk* chunk =
+      GetChunk(index / TraceBufferChunk::kChunkSize, true);
+  *handle = MakeHandle(chunk_seq, index);
+  return chunk->GetEventAt(index % TraceBufferChunk::kChunkSize);
 }
 
 TraceObject* InternalTraceBuffer::GetEventByHandle(uint64_t handle) {
-  Mutex::ScopedLock scoped_lock(mutex_);
   if (handle == 0) {
     // A handle value of zero never has a trace event associated with it.
     return nullptr;
   }
-  size_t chunk_index, event_index;
+  size_t index;
   uint32_t buffer_id, chunk_seq;
-  ExtractHandle(handle, &buffer_id, &chunk_index, &chunk_seq, &event_index);
-  if (buffer_id != id_ || chunk_index >= total_chunks_) {
-    // Either the chunk belongs to the other buffer, or is outside the current
-    // range of chunks loaded in memory (the latter being true suggests that
-    // the chunk has already been flushed and is no longer in memory.)
+  ExtractHandle(handle, &buffer_id, &chunk_seq, &index);
+  if (buffer_id != id_ ||
+      chunk_seq != current_chunk_seq_.load(std::memory_order_acquire) ||
+      index >= next_event_.load(std::memory_order_relaxed)) {
+    // Either the event belongs to the other buffer, or it has already been
+    // flushed and is no longer in memory.
     return nullptr;
   }
-  auto& chunk = chunks_[chunk_index];
-  if (chunk->seq() != chunk_seq) {
-    // Chunk is no longer in memory.
+  TraceBufferChunk* chunk =
+      GetChunk(index / TraceBufferChunk::kChunkSize, false);
+  if (chunk == nullptr)
     return nullptr;
-  }
-  return chunk->GetEventAt(event_index);
+  return chunk->GetEventAt(index % TraceBufferChunk::kChunkSize);
 }
 
 void InternalTraceBuffer::Flush(bool blocking) {
   {
-    Mutex::ScopedLock scoped_lock(mutex_);
-    if (total_chunks_ > 0) {
-      flushing_ = true;
-      for (size_t i = 0; i < total_chunks_; ++i) {
-        auto& chunk = chunks_[i];
-        for (size_t j = 0; j < chunk->size(); ++j) {
-          TraceObject* trace_event = chunk->GetEventAt(j);
-          // Another thread may have added a trace that is yet to be
-          // initialized. Skip such traces.
-          // https://github.com/nodejs/node/issues/21038.
-          if (trace_event->name()) {
-            agent_->AppendTraceEvent(trace_event);
-          }
+    Mutex::ScopedLock scoped_lock(flush_mutex_);
+    // Keep other threads from adding events while they are appended.
+    size_t total_events =
+        std::min(next_event_.exchange(Capacity(), std::memory_order_acq_rel),
+                 Capacity());
+    if (total_events > 0) {
+      flushing_.store(true, std::memory_order_relaxed);
+      for (size_t i = 0; i < total_events; ++i) {
+        TraceBufferChunk* chunk =
+            GetChunk(i / TraceBufferChunk::kChunkSize, false);
+        if (chunk == nullptr)
+          continue;
+        TraceObject* trace_event =
+            chunk->GetEventAt(i % TraceBufferChunk::kChunkSize);
+        // Another thread may have added a trace that is yet to be
+        // initialized. Skip such traces.
+        // https://github.com/nodejs/node/issues/21038.
+        if (trace_event->name()) {
+          agent_->AppendTraceEvent(trace_event);
         }
       }
-      total_chunks_ = 0;
-      flushing_ = false;
+      current_chunk_seq_.fetch_add(1, std::memory_order_acq_rel);
+      flushing_.store(false, std::memory_order_relaxed);
     }
+    next_event_.store(0, std::memory_order_release);
   }
   agent_->Flush(blocking);
 }
 
-uint64_t InternalTraceBuffer::MakeHandle(
-    size_t chunk_index, uint32_t chunk_seq, size_t event_index) const {
-  return ((static_cast<uint64_t>(chunk_seq) * Capacity() +
-          chunk_index * TraceBufferChunk::kChunkSize + event_index) << 1) + id_;
+uint64_t InternalTraceBuffer::MakeHandle(uint32_t chunk_seq,
+                                         size_t index) const {
+  return ((static_cast<uint64_t>(chunk_seq) * Capacity() + index) << 1) + id_;
 }
 
 void InternalTraceBuffer::ExtractHandle(
-    uint64_t handle, uint32_t* buffer_id, size_t* chunk_index,
-    uint32_t* chunk_seq, size_t* event_index) const {
+    uint64_t handle, uint32_t* buffer_id, uint32_t* chunk_seq,
+    size_t* index) const {
   *buffer_id = static_cast<uint32_t>(handle & 0x1);
   handle >>= 1;
   *chunk_seq = static_cast<uint32_t>(handle / Capacity());
-  size_t indices = handle % Capacity();
-  *chunk_index = indices / TraceBufferChunk::kChunkSize;
-  *event_index = indices % TraceBufferChunk::kChunkSize;
+  *index = handle % Capacity();
 }
 
 NodeTraceBuffer::NodeTraceBuffer(size_t max_chunks,
@@ -129,7 +154,12 @@ TraceObject* NodeTraceBuffer::AddTraceEvent(uint64_t* handle) {
     *handle = 0;
     return nullptr;
   }
-  return current_buf_.load()->AddTraceEvent(handle);
+  TraceObject* trace_object = current_buf_.load()->AddTraceEvent(handle);
+  // The buffer may have become full since it was checked, in which case the
+  // other one is tried.
+  if (trace_object == nullptr && TryLoadAvailableBuffer())
+    trace_object = current_buf_.load()->AddTraceEvent(handle);
+  return trace_object;
 }
 
 TraceObject* NodeTraceBuffer::GetEventByHandle(uint64_t handle) {
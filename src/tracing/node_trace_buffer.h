@@ -6,6 +6,7 @@
 #include "libplatform/v8-tracing.h"
 
 #include <atomic>
+#include <memory>
 
 namespace node {
 namespace tracing {
@@ -17,34 +18,43 @@ using v8::platform::tracing::TraceObject;
 // forward declaration
 class NodeTraceBuffer;
 
+// The events are added without taking a lock: every event reserves its slot
+// with an atomic increment, and the chunks that hold the slots are allocated
+// on first use. Only flushes, which run on the tracing thread or when
+// tracing stops, are serialized with a mutex.
 class InternalTraceBuffer {
  public:
   InternalTraceBuffer(size_t max_chunks, uint32_t id, Agent* agent);
+  ~InternalTraceBuffer();
 
   TraceObject* AddTraceEvent(uint64_t* handle);
   TraceObject* GetEventByHandle(uint64_t handle);
   void Flush(bool blocking);
   bool IsFull() const {
-    return total_chunks_ == max_chunks_ && chunks_[total_chunks_ - 1]->IsFull();
+    return next_event_.load(std::memory_order_relaxed) >= Capacity();
   }
   bool IsFlushing() const {
-    return flushing_;
+    return flushing_.load(std::memory_order_relaxed);
   }
 
  private:
-  uint64_t MakeHandle(size_t chunk_index, uint32_t chunk_seq,
-                      size_t event_index) const;
-  void ExtractHandle(uint64_t handle, uint32_t* buffer_id, size_t* chunk_index,
-                     uint32_t* chunk_seq, size_t* event_index) const;
+  uint64_t MakeHandle(uint32_t chunk_seq, size_t index) const;
+  void ExtractHandle(uint64_t handle, uint32_t* buffer_id, uint32_t* chunk_seq,
+                     size_t* index) const;
   size_t Capacity() const { return max_chunks_ * TraceBufferChunk::kChunkSize; }
+  TraceBufferChunk* GetChunk(size_t chunk_index, bool create);
 
-  Mutex mutex_;
-  bool flushing_;
+  Mutex flush_mutex_;
+  std::atomic<bool> flushing_ {false};
   size_t max_chunks_;
   Agent* agent_;
-  std::vector<std::unique_ptr<TraceBufferChunk>> chunks_;
-  size_t total_chunks_ = 0;
-  uint32_t current_chunk_seq_ = 1;
+  std::unique_ptr<std::atomic<TraceBufferChunk*>[]> chunks_;
+  // The index of the next free event slot. Flush() sets it to Capacity(), so
+  // that the buffer is full until it has been flushed.
+  std::atomic<size_t> next_event_ {0};
+  // Incremented by every flush, so that handles of events that have been
+  // flushed are no longer resolved.
+  std::atomic<uint32_t> current_chunk_seq_ {1};
   uint32_t id_;
 };
 
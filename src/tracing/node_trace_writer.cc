@@ -8,8 +8,9 @@
 namespace node {
 namespace tracing {
 
-NodeTraceWriter::NodeTraceWriter(const std::string& log_file_pattern)
-    : log_file_pattern_(log_file_pattern) {}
+NodeTraceWriter::NodeTraceWriter(const std::string& log_file_pattern,
+                                 bool gzip)
+    : log_file_pattern_(log_file_pattern), gzip_(gzip) {}
 
 void NodeTraceWriter::InitializeOnThread(uv_loop_t* loop) {
   CHECK_NULL(tracing_loop_);
@@ -58,6 +59,8 @@ NodeTraceWriter::~NodeTraceWriter() {
   while (!exited_) {
     exit_cond_.Wait(scoped_lock);
   }
+  if (zstream_initialized_)
+    deflateEnd(&zstream_);
 }
 
 void replace_substring(std::string* target,
@@ -116,6 +119,7 @@ void NodeTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
 void NodeTraceWriter::FlushPrivate() {
   std::string str;
   int highest_request_id;
+  bool end_of_file = false;
   {
     Mutex::ScopedLock stream_scoped_lock(stream_mutex_);
     if (total_traces_ >= kTracesPerFile) {
@@ -123,12 +127,15 @@ void NodeTraceWriter::FlushPrivate() {
       // Destroying the member JSONTraceWriter object appends "]}" to
       // stream_ - in other words, ending a JSON file.
       json_trace_writer_.reset();
+      end_of_file = true;
     }
     // str() makes a copy of the contents of the stream.
     str = stream_.str();
     stream_.str("");
     stream_.clear();
   }
+  if (gzip_)
+    str = Compress(str, end_of_file);
   {
     Mutex::ScopedLock request_scoped_lock(request_mutex_);
     highest_request_id = num_write_requests_;
@@ -136,6 +143,42 @@ void NodeTraceWriter::FlushPrivate() {
   WriteToFile(std::move(str), highest_request_id);
 }
 
+std::string NodeTraceWriter::Compress(const std::string& str,
+                                      bool end_of_file) {
+  if (!zstream_initialized_) {
+    memset(&zstream_, 0, sizeof(zstream_));
+    // 16 + MAX_WBITS selects the gzip format.
+    CHECK_EQ(deflateInit2(&zstream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                          16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    zstream_initialized_ = true;
+  }
+
+  std::string out;
+  out.resize(deflateBound(&zstream_, str.size()) + 64);
+  zstream_.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(str.data()));
+  zstream_.avail_in = str.size();
+  size_t written = 0;
+  int err;
+  do {
+    if (written == out.size())
+      out.resize(out.size() * 2);
+    zstream_.next_out = reinterpret_cast<Bytef*>(&out[written]);
+    zstream_.avail_out = out.size() - written;
+    err = deflate(&zstream_, end_of_file ? Z_FINISH : Z_SYNC_FLUSH);
+    CHECK_NE(err, Z_STREAM_ERROR);
+    written = out.size() - zstream_.avail_out;
+  } while (zstream_.avail_out == 0 || (end_of_file && err != Z_STREAM_END));
+  out.resize(written);
+
+  if (end_of_file) {
+    // The next file is a new gzip stream.
+    deflateEnd(&zstream_);
+    zstream_initialized_ = false;
+  }
+  return out;
+}
+
 void NodeTraceWriter::Flush(bool blocking) {
   Mutex::ScopedLock scoped_lock(request_mutex_);
   {
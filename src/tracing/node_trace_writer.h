@@ -7,6 +7,7 @@
 #include "libplatform/v8-tracing.h"
 #include "tracing/agent.h"
 #include "uv.h"
+#include "zlib.h"
 
 namespace node {
 namespace tracing {
@@ -16,7 +17,9 @@ using v8::platform::tracing::TraceWriter;
 
 class NodeTraceWriter : public AsyncTraceWriter {
  public:
-  explicit NodeTraceWriter(const std::string& log_file_pattern);
+  // With `gzip`, every file is written as a gzip stream.
+  explicit NodeTraceWriter(const std::string& log_file_pattern,
+                           bool gzip = false);
   ~NodeTraceWriter() override;
 
   void InitializeOnThread(uv_loop_t* loop) override;
@@ -36,6 +39,10 @@ class NodeTraceWriter : public AsyncTraceWriter {
   void OpenNewFileForStreaming();
   void WriteToFile(std::string&& str, int highest_request_id);
   void WriteSuffix();
+  // Runs on the tracing thread. The stream is flushed after every call, so
+  // that what has been written so far can be decompressed if the process
+  // crashes, and finished if `end_of_file` is set.
+  std::string Compress(const std::string& str, bool end_of_file);
   void FlushPrivate();
   static void ExitSignalCb(uv_async_t* signal);
 
@@ -66,6 +73,10 @@ class NodeTraceWriter : public AsyncTraceWriter {
   std::string log_file_pattern_;
   std::ostringstream stream_;
   std::unique_ptr<TraceWriter> json_trace_writer_;
+  bool gzip_;
+  // Only used on the tracing thread.
+  z_stream zstream_;
+  bool zstream_initialized_ = false;
   bool exited_ = false;
 };
 
@@ -23,14 +23,35 @@
 #include "allocated_buffer-inl.h"
 #include "env-inl.h"
 #include "node_buffer.h"
+#include "node_mutex.h"
 #include "node_sockaddr-inl.h"
 #include "handle_wrap.h"
 #include "req_wrap-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif  // __linux__
+
 namespace node {
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
 using v8::Context;
 using v8::DontDelete;
 using v8::FunctionCallbackInfo;
@@ -74,6 +95,44 @@ bool SendWrap::have_callback() const {
   return have_callback_;
 }
 
+
+// A single request object for a batch of datagrams. The datagrams that could
+// not be sent synchronously are queued with libuv one request each, and the
+// JS side is notified once the last of them has completed.
+class SendBatchWrap final : public ReqWrap<uv_udp_send_t> {
+ public:
+  SendBatchWrap(Environment* env,
+                Local<Object> req_wrap_obj,
+                bool have_callback,
+                size_t queued);
+  bool have_callback() const { return have_callback_; }
+
+  // Requests for all but the first queued datagram, which uses req_.
+  std::unique_ptr<uv_udp_send_t[]> extra_reqs;
+  size_t pending = 0;
+  size_t sent = 0;
+  int status = 0;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(SendBatchWrap)
+  SET_SELF_SIZE(SendBatchWrap)
+
+ private:
+  const bool have_callback_;
+};
+
+
+SendBatchWrap::SendBatchWrap(Environment* env,
+                             Local<Object> req_wrap_obj,
+                             bool have_callback,
+                             size_t queued)
+    : ReqWrap(env, req_wrap_obj, AsyncWrap::PROVIDER_UDPSENDWRAP),
+      have_callback_(have_callback) {
+  if (queued > 1)
+    extra_reqs.reset(new uv_udp_send_t[queued - 1]);
+}
+
+
 UDPListener::~UDPListener() {
   if (wrap_ != nullptr)
     wrap_->set_listener(nullptr);
@@ -109,7 +168,75 @@ void UDPWrapBase::AddMethods(Environment* env, Local<FunctionTemplate> t) {
   env->SetProtoMethod(t, "recvStop", RecvStop);
 }
 
-UDPWrap::UDPWrap(Environment* env, Local<Object> object)
+// libuv reads at most this many datagrams per recvmmsg() call, each into its
+// own 64 KiB chunk of the receive buffer.
+static constexpr uint32_t kMaxRecvBatchSize = 20;
+static constexpr size_t kRecvChunkSize = 64 * 1024;
+
+// Slabs that are no longer referenced from JS are kept around for reuse,
+// up to a limit. Slabs are returned from the BackingStore deleter, which may
+// run on a V8 background thread, hence the lock.
+class UDPWrap::RecvSlabPool {
+ public:
+  explicit RecvSlabPool(size_t slab_size) : slab_size_(slab_size) {}
+
+  ~RecvSlabPool() {
+    for (char* slab : free_slabs_)
+      free(slab);
+  }
+
+  size_t slab_size() const { return slab_size_; }
+
+  char* Get() {
+    {
+      Mutex::ScopedLock lock(mutex_);
+      if (!free_slabs_.empty()) {
+        char* slab = free_slabs_.back();
+        free_slabs_.pop_back();
+        return slab;
+      }
+    }
+    return UncheckedMalloc(slab_size_);
+  }
+
+  void Put(char* slab) {
+    {
+      Mutex::ScopedLock lock(mutex_);
+      if (free_slabs_.size() < kMaxFreeSlabs) {
+        free_slabs_.push_back(slab);
+        return;
+      }
+    }
+    free(slab);
+  }
+
+  // The BackingStore keeps the pool alive, the socket may be gone by the
+  // time the last slice of the slab is collected.
+  static std::unique_ptr<BackingStore> NewBackingStore(
+      const std::shared_ptr<RecvSlabPool>& pool, char* slab) {
+    return ArrayBuffer::NewBackingStore(
+        slab,
+        pool->slab_size(),
+        [](void* data, size_t length, void* deleter_data) {
+          std::unique_ptr<std::shared_ptr<RecvSlabPool>> pool(
+              static_cast<std::shared_ptr<RecvSlabPool>*>(deleter_data));
+          (*pool)->Put(static_cast<char*>(data));
+        },
+        new std::shared_ptr<RecvSlabPool>(pool));
+  }
+
+ private:
+  static constexpr size_t kMaxFreeSlabs = 4;
+
+  const size_t slab_size_;
+  Mutex mutex_;
+  std::vector<char*> free_slabs_;
+};
+
+
+UDPWrap::UDPWrap(Environment* env,
+                 Local<Object> object,
+                 uint32_t recv_batch_size)
     : HandleWrap(env,
                  object,
                  reinterpret_cast<uv_handle_t*>(&handle_),
@@ -117,9 +244,23 @@ UDPWrap::UDPWrap(Environment* env, Local<Object> object)
   object->SetAlignedPointerInInternalField(
       UDPWrapBase::kUDPWrapBaseField, static_cast<UDPWrapBase*>(this));
 
-  int r = uv_udp_init(env->event_loop(), &handle_);
+  int r;
+  if (recv_batch_size > 1) {
+    r = uv_udp_init_ex(env->event_loop(),
+                       &handle_,
+                       AF_UNSPEC | UV_UDP_RECVMMSG);
+  } else {
+    r = uv_udp_init(env->event_loop(), &handle_);
+  }
   CHECK_EQ(r, 0);  // can't fail anyway
 
+  // Without recvmmsg() support, libuv reads one datagram at a time anyway.
+  if (uv_udp_using_recvmmsg(&handle_)) {
+    recv_batch_size = std::min(recv_batch_size, kMaxRecvBatchSize);
+    recv_slab_pool_ =
+        std::make_shared<RecvSlabPool>(recv_batch_size * kRecvChunkSize);
+  }
+
   set_listener(this);
 }
 
@@ -158,6 +299,8 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "connect6", Connect6);
   env->SetProtoMethod(t, "send6", Send6);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
   env->SetProtoMethod(t, "disconnect", Disconnect);
   env->SetProtoMethod(t, "getpeername",
                       GetSockOrPeerName<UDPWrap, uv_udp_getpeername>);
@@ -175,6 +318,10 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "setBroadcast", SetBroadcast);
   env->SetProtoMethod(t, "setTTL", SetTTL);
   env->SetProtoMethod(t, "bufferSize", BufferSize);
+  env->SetProtoMethod(t, "setUDPSegment", SetUDPSegment);
+  env->SetProtoMethod(t, "setUDPGro", SetUDPGro);
+  env->SetProtoMethod(t, "ref", Ref);
+  env->SetProtoMethod(t, "unref", Unref);
 
   t->Inherit(HandleWrap::GetConstructorTemplate(env));
 
@@ -200,7 +347,10 @@ void UDPWrap::Initialize(Local<Object> target,
 void UDPWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
   Environment* env = Environment::GetCurrent(args);
-  new UDPWrap(env, args.This());
+  uint32_t recv_batch_size = 0;
+  if (args[0]->IsUint32())
+    recv_batch_size = args[0].As<Uint32>()->Value();
+  new UDPWrap(env, args.This(), recv_batch_size);
 }
 
 
@@ -377,13 +527,57 @@ void UDPWrap::Disconnect(const FunctionCallbackInfo<Value>& args) {
     args.GetReturnValue().Set(err);                                            \
   }
 
+// Generic segmentation offload: the kernel splits every datagram handed to
+// it into `size` byte segments. 0 turns it off again.
+static int uv_udp_set_segment(uv_udp_t* handle, int size) {
+#ifdef __linux__
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(handle), &fd);
+  if (err != 0)
+    return err;
+  if (setsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &size, sizeof(size)) != 0)
+    return uv_translate_sys_error(errno);
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
 X(SetTTL, uv_udp_set_ttl)
 X(SetBroadcast, uv_udp_set_broadcast)
 X(SetMulticastTTL, uv_udp_set_multicast_ttl)
 X(SetMulticastLoopback, uv_udp_set_multicast_loop)
+X(SetUDPSegment, uv_udp_set_segment)
 
 #undef X
 
+// Takes effect the next time receiving is started.
+void UDPWrap::SetUDPGro(const FunctionCallbackInfo<Value>& args) {
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  CHECK_EQ(args.Length(), 1);
+  CHECK(args[0]->IsBoolean());
+  bool enable = args[0]->IsTrue();
+
+#ifdef __linux__
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&wrap->handle_), &fd);
+  if (err == 0) {
+    int on = enable ? 1 : 0;
+    if (setsockopt(fd, IPPROTO_UDP, UDP_GRO, &on, sizeof(on)) != 0)
+      err = uv_translate_sys_error(errno);
+  }
+  if (err == 0)
+    wrap->gro_enabled_ = enable;
+#else
+  int err = enable ? UV_ENOTSUP : 0;
+#endif
+  args.GetReturnValue().Set(err);
+}
+
 void UDPWrap::SetMulticastInterface(const FunctionCallbackInfo<Value>& args) {
   UDPWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap,
@@ -617,6 +811,204 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  // sendBatch(req, list, count, hasCallback), where list holds `count`
+  // (buffer, port, address) triples. The address is undefined for
+  // connected sockets.
+  CHECK_EQ(args.Length(), 4);
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsBoolean());
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  Local<Array> list = args[1].As<Array>();
+  size_t count = args[2].As<Uint32>()->Value();
+  bool have_callback = args[3]->IsTrue();
+
+  if (wrap->IsHandleClosing())
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+  MaybeStackBuffer<sockaddr_storage, 16> addr_storage(count);
+  MaybeStackBuffer<const sockaddr*, 16> addrs(count);
+
+  // Anything after an invalid address is left for the caller to retry.
+  int err = 0;
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk;
+    Local<Value> port;
+    Local<Value> address;
+    if (!list->Get(env->context(), 3 * i).ToLocal(&chunk) ||
+        !list->Get(env->context(), 3 * i + 1).ToLocal(&port) ||
+        !list->Get(env->context(), 3 * i + 2).ToLocal(&address)) {
+      return;
+    }
+
+    bufs[i] = uv_buf_init(Buffer::Data(chunk), Buffer::Length(chunk));
+    addrs[i] = nullptr;
+    if (address->IsString()) {
+      CHECK(port->IsUint32());
+      node::Utf8Value ip(env->isolate(), address);
+      err = sockaddr_for_family(family,
+                                ip.out(),
+                                port.As<Uint32>()->Value(),
+                                &addr_storage[i]);
+      if (err != 0) {
+        count = i;
+        break;
+      }
+      addrs[i] = reinterpret_cast<const sockaddr*>(&addr_storage[i]);
+    }
+  }
+
+  size_t sent = 0;
+  int send_err = 0;
+  if (!UNLIKELY(env->options()->test_udp_no_try_send))
+    sent = wrap->TrySendBatch(*bufs, *addrs, count, &send_err);
+
+  if (send_err != 0 || sent == count) {
+    if (send_err != 0)
+      err = send_err;
+    if (err != 0) {
+      req_wrap_obj->Set(env->context(),
+                        env->sent_string(),
+                        Integer::NewFromUnsigned(env->isolate(), sent))
+          .Check();
+      return args.GetReturnValue().Set(err);
+    }
+    return args.GetReturnValue().Set(static_cast<uint32_t>(sent));
+  }
+
+  // Queue the rest. libuv writes queued datagrams with sendmmsg() as well
+  // once the socket becomes writable again.
+  size_t queued = count - sent;
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(wrap);
+  SendBatchWrap* req_wrap =
+      new SendBatchWrap(env, req_wrap_obj, have_callback, queued);
+  req_wrap->sent = sent;
+  req_wrap->status = err;
+
+  uv_udp_send_cb cb = [](uv_udp_send_t* req, int status) {
+    UDPWrap* self = ContainerOf(&UDPWrap::handle_, req->handle);
+    self->OnSendBatchDone(static_cast<SendBatchWrap*>(req->data), status);
+  };
+
+  err = req_wrap->Dispatch(uv_udp_send,
+                           &wrap->handle_,
+                           &bufs[sent],
+                           1,
+                           addrs[sent],
+                           cb);
+  if (err) {
+    delete req_wrap;
+    req_wrap_obj->Set(env->context(),
+                      env->sent_string(),
+                      Integer::NewFromUnsigned(env->isolate(), sent))
+        .Check();
+    return args.GetReturnValue().Set(err);
+  }
+  req_wrap->pending = 1;
+
+  for (size_t i = 1; i < queued; i++) {
+    uv_udp_send_t* req = &req_wrap->extra_reqs[i - 1];
+    req->data = req_wrap;
+    err = uv_udp_send(req,
+                      &wrap->handle_,
+                      &bufs[sent + i],
+                      1,
+                      addrs[sent + i],
+                      cb);
+    if (err) {
+      // Report the failure once the datagrams already queued are done.
+      req_wrap->status = err;
+      break;
+    }
+    req_wrap->pending++;
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(sent));
+}
+
+
+size_t UDPWrap::TrySendBatch(const uv_buf_t* bufs,
+                             const sockaddr* const* addrs,
+                             size_t count,
+                             int* err) {
+  size_t sent = 0;
+  *err = 0;
+
+  // Keep datagrams in order with respect to earlier asynchronous sends.
+  if (handle_.send_queue_count != 0)
+    return 0;
+
+#ifdef __linux__
+  uv_os_fd_t fd;
+  if (uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd) != 0)
+    return 0;
+
+  MaybeStackBuffer<mmsghdr, 16> msgs(count);
+  for (size_t i = 0; i < count; i++) {
+    msghdr* h = &msgs[i].msg_hdr;
+    memset(h, 0, sizeof(*h));
+    if (addrs[i] != nullptr) {
+      h->msg_name = const_cast<sockaddr*>(addrs[i]);
+      h->msg_namelen = addrs[i]->sa_family == AF_INET6 ?
+          sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+    }
+    // uv_buf_t is layout-compatible with struct iovec on Unices.
+    h->msg_iov = reinterpret_cast<iovec*>(const_cast<uv_buf_t*>(&bufs[i]));
+    h->msg_iovlen = 1;
+  }
+
+  while (sent < count) {
+    // The kernel caps the batch size at UIO_MAXIOV (1024).
+    unsigned int vlen = static_cast<unsigned int>(std::min<size_t>(
+        count - sent, 1024));
+    int r = sendmmsg(fd, &msgs[sent], vlen, 0);
+    if (r == -1) {
+      if (errno == EINTR)
+        continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOSYS)
+        *err = uv_translate_sys_error(errno);
+      break;
+    }
+    sent += r;
+  }
+#else
+  while (sent < count) {
+    int r = uv_udp_try_send(&handle_, &bufs[sent], 1, addrs[sent]);
+    if (r < 0) {
+      if (r != UV_EAGAIN && r != UV_ENOSYS)
+        *err = r;
+      break;
+    }
+    sent++;
+  }
+#endif  // __linux__
+
+  return sent;
+}
+
+
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
 AsyncWrap* UDPWrap::GetAsyncWrap() {
   return this;
 }
@@ -636,6 +1028,8 @@ void UDPWrapBase::RecvStart(const FunctionCallbackInfo<Value>& args) {
 
 int UDPWrap::RecvStart() {
   if (IsHandleClosing()) return UV_EBADF;
+  if (gro_enabled_)
+    return StartGroReceiver();
   int err = uv_udp_recv_start(&handle_, OnAlloc, OnRecv);
   // UV_EALREADY means that the socket is already bound but that's okay
   if (err == UV_EALREADY)
@@ -651,10 +1045,174 @@ void UDPWrapBase::RecvStop(const FunctionCallbackInfo<Value>& args) {
 
 int UDPWrap::RecvStop() {
   if (IsHandleClosing()) return UV_EBADF;
+  if (gro_receiver_ != nullptr) {
+    StopGroReceiver();
+    return 0;
+  }
   return uv_udp_recv_stop(&handle_);
 }
 
 
+void UDPWrap::Close(Local<Value> close_callback) {
+  StopGroReceiver();
+  ReleaseRecvSlab();
+  HandleWrap::Close(close_callback);
+}
+
+
+struct UDPWrap::GroReceiver {
+  uv_poll_t poll;
+  uv_os_fd_t fd;
+  UDPWrap* wrap;
+};
+
+
+// The GRO receiver's poll handle follows the socket's own ref state.
+void UDPWrap::Ref(const FunctionCallbackInfo<Value>& args) {
+  HandleWrap::Ref(args);
+  UDPWrap* wrap = Unwrap<UDPWrap>(args.Holder());
+  if (wrap != nullptr && wrap->gro_receiver_ != nullptr)
+    uv_ref(reinterpret_cast<uv_handle_t*>(&wrap->gro_receiver_->poll));
+}
+
+
+void UDPWrap::Unref(const FunctionCallbackInfo<Value>& args) {
+  HandleWrap::Unref(args);
+  UDPWrap* wrap = Unwrap<UDPWrap>(args.Holder());
+  if (wrap != nullptr && wrap->gro_receiver_ != nullptr)
+    uv_unref(reinterpret_cast<uv_handle_t*>(&wrap->gro_receiver_->poll));
+}
+
+
+int UDPWrap::StartGroReceiver() {
+#ifdef __linux__
+  if (gro_receiver_ != nullptr)
+    return 0;
+
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd);
+  if (err != 0)
+    return err;
+
+  // Poll a duplicate so as not to get in the way of libuv's own watcher,
+  // which still takes care of outgoing datagrams.
+  int dup_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup_fd == -1)
+    return uv_translate_sys_error(errno);
+
+  std::unique_ptr<GroReceiver> receiver{new GroReceiver()};
+  receiver->fd = dup_fd;
+  receiver->wrap = this;
+  err = uv_poll_init(env()->event_loop(), &receiver->poll, dup_fd);
+  if (err != 0) {
+    close(dup_fd);
+    return err;
+  }
+  err = uv_poll_start(&receiver->poll, UV_READABLE, OnGroReadable);
+  if (err != 0) {
+    GroReceiver* r = receiver.release();
+    env()->CloseHandle(&r->poll, [](uv_poll_t* poll) {
+      GroReceiver* r = ContainerOf(&GroReceiver::poll, poll);
+      close(r->fd);
+      delete r;
+    });
+    return err;
+  }
+
+  // Mirror uv_udp_recv_start() with respect to keeping the loop alive.
+  if (!HasRef(this))
+    uv_unref(reinterpret_cast<uv_handle_t*>(&receiver->poll));
+
+  gro_receiver_ = receiver.release();
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
+void UDPWrap::StopGroReceiver() {
+#ifdef __linux__
+  GroReceiver* receiver = gro_receiver_;
+  if (receiver == nullptr)
+    return;
+  gro_receiver_ = nullptr;
+  receiver->wrap = nullptr;
+  env()->CloseHandle(&receiver->poll, [](uv_poll_t* poll) {
+    GroReceiver* receiver = ContainerOf(&GroReceiver::poll, poll);
+    close(receiver->fd);
+    delete receiver;
+  });
+#endif  // __linux__
+}
+
+
+void UDPWrap::OnGroReadable(uv_poll_t* handle, int status, int events) {
+#ifdef __linux__
+  GroReceiver* receiver = ContainerOf(&GroReceiver::poll, handle);
+  UDPWrap* wrap = receiver->wrap;
+  if (wrap == nullptr || wrap->IsHandleClosing())
+    return;
+
+  if (status < 0) {
+    wrap->listener()->OnRecv(status, uv_buf_init(nullptr, 0), nullptr, 0);
+    return;
+  }
+
+  // Read up to 32 (super-)datagrams per wakeup, like libuv does. The read
+  // callback may well stop receiving, so re-check after each one.
+  for (int i = 0; i < 32 && wrap->gro_receiver_ == receiver; i++) {
+    uv_buf_t buf = wrap->listener()->OnAlloc(64 * 1024);
+    sockaddr_storage peer;
+    char control[CMSG_SPACE(sizeof(int))];
+    msghdr h;
+    memset(&h, 0, sizeof(h));
+    memset(&peer, 0, sizeof(peer));
+    h.msg_name = &peer;
+    h.msg_namelen = sizeof(peer);
+    h.msg_iov = reinterpret_cast<iovec*>(&buf);
+    h.msg_iovlen = 1;
+    h.msg_control = control;
+    h.msg_controllen = sizeof(control);
+
+    ssize_t nread;
+    do {
+      nread = recvmsg(receiver->fd, &h, MSG_DONTWAIT);
+    } while (nread == -1 && errno == EINTR);
+
+    if (nread == -1) {
+      int err = errno;
+      if (err == EAGAIN || err == EWOULDBLOCK)
+        wrap->listener()->OnRecv(0, buf, nullptr, 0);
+      else
+        wrap->listener()->OnRecv(uv_translate_sys_error(err), buf, nullptr, 0);
+      return;
+    }
+
+    unsigned int flags = (h.msg_flags & MSG_TRUNC) ? UV_UDP_PARTIAL : 0;
+    int segment_size = 0;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&h);
+         cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&h, cmsg)) {
+      if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO)
+        memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+    }
+
+    const sockaddr* addr = reinterpret_cast<const sockaddr*>(&peer);
+    if (segment_size > 0 && nread > segment_size &&
+        wrap->listener() == wrap) {
+      wrap->OnRecvSegments(nread, buf, addr, flags, segment_size);
+    } else {
+      wrap->listener()->OnRecv(nread, buf, addr, flags);
+    }
+
+    if (wrap->IsHandleClosing())
+      return;
+  }
+#endif  // __linux__
+}
+
+
 void UDPWrap::OnSendDone(ReqWrap<uv_udp_send_t>* req, int status) {
   std::unique_ptr<SendWrap> req_wrap{static_cast<SendWrap*>(req)};
   if (req_wrap->have_callback()) {
@@ -670,6 +1228,30 @@ void UDPWrap::OnSendDone(ReqWrap<uv_udp_send_t>* req, int status) {
 }
 
 
+void UDPWrap::OnSendBatchDone(SendBatchWrap* req_wrap, int status) {
+  if (status == 0)
+    req_wrap->sent++;
+  else if (req_wrap->status == 0)
+    req_wrap->status = status;
+
+  CHECK_GT(req_wrap->pending, 0);
+  if (--req_wrap->pending > 0)
+    return;
+
+  std::unique_ptr<SendBatchWrap> done{req_wrap};
+  if (done->have_callback()) {
+    Environment* env = done->env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    Local<Value> arg[] = {
+      Integer::New(env->isolate(), done->status),
+      Integer::NewFromUnsigned(env->isolate(), done->sent),
+    };
+    done->MakeCallback(env->oncomplete_string(), arraysize(arg), arg);
+  }
+}
+
+
 void UDPWrap::OnAlloc(uv_handle_t* handle,
                       size_t suggested_size,
                       uv_buf_t* buf) {
@@ -679,9 +1261,28 @@ void UDPWrap::OnAlloc(uv_handle_t* handle,
 }
 
 uv_buf_t UDPWrap::OnAlloc(size_t suggested_size) {
+  if (recv_slab_pool_ && !gro_enabled_) {
+    // libuv skips the UV_UDP_MMSG_FREE callback if reading was stopped
+    // halfway through a batch.
+    ReleaseRecvSlab();
+    recv_slab_ = recv_slab_pool_->Get();
+    if (recv_slab_ == nullptr)
+      return uv_buf_init(nullptr, 0);
+    return uv_buf_init(recv_slab_, recv_slab_pool_->slab_size());
+  }
   return AllocatedBuffer::AllocateManaged(env(), suggested_size).release();
 }
 
+void UDPWrap::ReleaseRecvSlab() {
+  if (!recv_slab_ab_.IsEmpty()) {
+    // The slab goes back to the pool once the last slice is collected.
+    recv_slab_ab_.Reset();
+  } else if (recv_slab_ != nullptr) {
+    recv_slab_pool_->Put(recv_slab_);
+  }
+  recv_slab_ = nullptr;
+}
+
 void UDPWrap::OnRecv(uv_udp_t* handle,
                      ssize_t nread,
                      const uv_buf_t* buf,
@@ -696,7 +1297,17 @@ void UDPWrap::OnRecv(ssize_t nread,
                      const sockaddr* addr,
                      unsigned int flags) {
   Environment* env = this->env();
-  AllocatedBuffer buf(env, buf_);
+  AllocatedBuffer buf;
+  if (recv_slab_ != nullptr &&
+      buf_.base >= recv_slab_ &&
+      buf_.base < recv_slab_ + recv_slab_pool_->slab_size()) {
+    if (flags & UV_UDP_MMSG_CHUNK)
+      return OnRecvChunk(nread, buf_, addr, flags);
+    // Either the final UV_UDP_MMSG_FREE callback, or nothing was read.
+    ReleaseRecvSlab();
+  } else {
+    buf = AllocatedBuffer(env, buf_);
+  }
   if (nread == 0 && addr == nullptr) {
     return;
   }
@@ -716,11 +1327,73 @@ void UDPWrap::OnRecv(ssize_t nread,
   }
 
   buf.Resize(nread);
-  argv[2] = buf.ToBuffer().ToLocalChecked();
+  argv[2] = buf.ToPooledBuffer().ToLocalChecked();
   argv[3] = AddressToJS(env, addr);
   MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
 
+void UDPWrap::OnRecvChunk(ssize_t nread,
+                          const uv_buf_t& buf,
+                          const sockaddr* addr,
+                          unsigned int flags) {
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<ArrayBuffer> ab;
+  if (recv_slab_ab_.IsEmpty()) {
+    ab = ArrayBuffer::New(
+        env->isolate(),
+        RecvSlabPool::NewBackingStore(recv_slab_pool_, recv_slab_));
+    recv_slab_ab_.Reset(env->isolate(), ab);
+  } else {
+    ab = recv_slab_ab_.Get(env->isolate());
+  }
+
+  Local<Value> buffer;
+  if (!Buffer::New(env, ab, buf.base - recv_slab_, nread).ToLocal(&buffer))
+    return;
+
+  Local<Value> argv[] = {
+      Integer::New(env->isolate(), static_cast<int32_t>(nread)),
+      object(),
+      buffer,
+      AddressToJS(env, addr)};
+  MakeCallback(env->onmessage_string(), arraysize(argv), argv);
+}
+
+void UDPWrap::OnRecvSegments(ssize_t nread,
+                              const uv_buf_t& buf_,
+                              const sockaddr* addr,
+                              unsigned int flags,
+                              size_t segment_size) {
+  Environment* env = this->env();
+  AllocatedBuffer buf(env, buf_);
+
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  buf.Resize(nread);
+  Local<ArrayBuffer> ab = buf.ToArrayBuffer();
+
+  for (size_t offset = 0; offset < static_cast<size_t>(nread);
+       offset += segment_size) {
+    size_t length = std::min(segment_size, nread - offset);
+    Local<Value> segment;
+    if (!Buffer::New(env, ab, offset, length).ToLocal(&segment))
+      return;
+    // Every message gets its own rinfo object, JS land mutates it.
+    Local<Value> argv[] = {
+        Integer::New(env->isolate(), static_cast<int32_t>(length)),
+        object(),
+        segment,
+        AddressToJS(env, addr)};
+    MakeCallback(env->onmessage_string(), arraysize(argv), argv);
+    if (IsHandleClosing())
+      return;
+  }
+}
+
 MaybeLocal<Object> UDPWrap::Instantiate(Environment* env,
                                         AsyncWrap* parent,
                                         UDPWrap::SocketType type) {
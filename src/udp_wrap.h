@@ -32,6 +32,7 @@
 
 namespace node {
 
+class SendBatchWrap;
 class UDPWrapBase;
 
 // A listener that can be attached to an `UDPWrapBase` object and generally
@@ -135,6 +136,8 @@ class UDPWrap final : public HandleWrap,
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Connect6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Send6(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Disconnect(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DropMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -150,6 +153,10 @@ class UDPWrap final : public HandleWrap,
   static void SetBroadcast(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetTTL(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void BufferSize(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetUDPSegment(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetUDPGro(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Ref(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Unref(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // UDPListener implementation
   uv_buf_t OnAlloc(size_t suggested_size) override;
@@ -172,6 +179,9 @@ class UDPWrap final : public HandleWrap,
 
   AsyncWrap* GetAsyncWrap() override;
 
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
   static v8::MaybeLocal<v8::Object> Instantiate(Environment* env,
                                                 AsyncWrap* parent,
                                                 SocketType type);
@@ -186,7 +196,9 @@ class UDPWrap final : public HandleWrap,
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
 
-  UDPWrap(Environment* env, v8::Local<v8::Object> object);
+  UDPWrap(Environment* env,
+          v8::Local<v8::Object> object,
+          uint32_t recv_batch_size = 0);
 
   static void DoBind(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
@@ -194,6 +206,16 @@ class UDPWrap final : public HandleWrap,
                      int family);
   static void DoSend(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
+  static void DoSendBatch(const v8::FunctionCallbackInfo<v8::Value>& args,
+                          int family);
+  // Hands the datagrams to the kernel without queueing, using a single
+  // sendmmsg() call where available. Returns the number of datagrams sent;
+  // *err is set if the send stopped for any reason but a full socket buffer.
+  size_t TrySendBatch(const uv_buf_t* bufs,
+                      const sockaddr* const* addrs,
+                      size_t count,
+                      int* err);
+  void OnSendBatchDone(SendBatchWrap* req_wrap, int status);
   static void SetMembership(const v8::FunctionCallbackInfo<v8::Value>& args,
                             uv_membership membership);
   static void SetSourceMembership(
@@ -209,7 +231,41 @@ class UDPWrap final : public HandleWrap,
                      const struct sockaddr* addr,
                      unsigned int flags);
 
+  // With UDP_GRO enabled, the kernel hands out several datagrams of the same
+  // size in one buffer. They are emitted as slices of that single buffer.
+  void OnRecvSegments(ssize_t nread,
+                      const uv_buf_t& buf,
+                      const sockaddr* addr,
+                      unsigned int flags,
+                      size_t segment_size);
+
+  // libuv does not pass the UDP_GRO control message on, so while GRO is
+  // enabled, datagrams are read from a duplicate of the socket's file
+  // descriptor instead.
+  struct GroReceiver;
+  int StartGroReceiver();
+  void StopGroReceiver();
+  static void OnGroReadable(uv_poll_t* handle, int status, int events);
+
+  // With a receive batch size, libuv reads several datagrams per
+  // recvmmsg() call into one slab, and the datagrams are emitted as slices
+  // of a single ArrayBuffer over that slab.
+  class RecvSlabPool;
+  void OnRecvChunk(ssize_t nread,
+                   const uv_buf_t& buf,
+                   const sockaddr* addr,
+                   unsigned int flags);
+  void ReleaseRecvSlab();
+
   uv_udp_t handle_;
+  bool gro_enabled_ = false;
+  GroReceiver* gro_receiver_ = nullptr;
+
+  std::shared_ptr<RecvSlabPool> recv_slab_pool_;
+  // The slab libuv currently reads into, and the ArrayBuffer that wraps it
+  // once the first datagram from it has been handed to JS.
+  char* recv_slab_ = nullptr;
+  v8::Global<v8::ArrayBuffer> recv_slab_ab_;
 
   bool current_send_has_callback_;
   v8::Local<v8::Object> current_send_req_wrap_;
@@ -44,6 +44,10 @@
 #include <sys/types.h>
 #endif
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include <atomic>
 #include <cstdio>
 #include <cstring>
@@ -164,6 +168,88 @@ std::string GetHumanReadableProcessName() {
   return SPrintF("%s[%d]", GetProcessTitle("Node.js"), uv_os_getpid());
 }
 
+int GetCurrentThreadAffinity(std::vector<int>* cpus) {
+  cpus->clear();
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    return uv_translate_sys_error(errno);
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &set))
+      cpus->push_back(cpu);
+  }
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+int SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+      return UV_EINVAL;
+    CPU_SET(cpu, &set);
+  }
+  // With the default memory policy, memory is allocated on the NUMA node of
+  // the CPU that first touches it, so a thread that is pinned before it
+  // allocates anything keeps its memory local.
+  if (sched_setaffinity(0, sizeof(set), &set) != 0)
+    return uv_translate_sys_error(errno);
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+bool ParseCpuList(const std::string& list, std::vector<int>* cpus) {
+  cpus->clear();
+  std::istringstream ranges(list);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    const char* start = range.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long first = strtol(start, &end, 10);  // NOLINT(runtime/int)
+    long last = first;  // NOLINT(runtime/int)
+    if (end != start && *end == '-') {
+      start = end + 1;
+      last = strtol(start, &end, 10);
+    }
+    if (end == start || *end != '\0' || errno != 0 || first < 0 ||
+        last < first || last >= 1024) {
+      return false;
+    }
+    for (long cpu = first; cpu <= last; cpu++)  // NOLINT(runtime/int)
+      cpus->push_back(static_cast<int>(cpu));
+  }
+  return !cpus->empty();
+}
+
+int StartThreadpoolWithAffinity(const std::vector<int>& cpus) {
+  // The threadpool threads are started by the first request, and inherit the
+  // affinity of the thread that makes it. This thread's own affinity is
+  // restored afterwards.
+  std::vector<int> previous;
+  int err = GetCurrentThreadAffinity(&previous);
+  if (err == 0)
+    err = SetCurrentThreadAffinity(cpus);
+  if (err != 0)
+    return err;
+
+  uv_loop_t loop;
+  CHECK_EQ(uv_loop_init(&loop), 0);
+  uv_work_t req;
+  CHECK_EQ(uv_queue_work(&loop, &req, [](uv_work_t*) {}, nullptr), 0);
+  CHECK_EQ(uv_run(&loop, UV_RUN_DEFAULT), 0);
+  CheckedUvLoopClose(&loop);
+
+  return SetCurrentThreadAffinity(previous);
+}
+
 std::vector<std::string> SplitString(const std::string& in, char delim) {
   std::vector<std::string> out;
   if (in.empty())
@@ -178,6 +264,56 @@ std::vector<std::string> SplitString(const std::string& in, char delim) {
   return out;
 }
 
+// Overlong forms, surrogates, code points above U+10FFFF and truncated
+// sequences end the prefix. Runs of ASCII are skipped a word at a time.
+size_t Utf8ValidPrefixLength(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  while (i < length) {
+    if (length - i >= sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, data + i, sizeof(word));
+      if ((word & 0x8080808080808080ull) == 0) {
+        i += sizeof(word);
+        continue;
+      }
+    }
+
+    const uint8_t c = data[i];
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+
+    // Number of continuation bytes and the valid range of the first one.
+    size_t n;
+    uint8_t lower = 0x80;
+    uint8_t upper = 0xbf;
+    if (c >= 0xc2 && c <= 0xdf) {
+      n = 1;
+    } else if (c >= 0xe0 && c <= 0xef) {
+      n = 2;
+      if (c == 0xe0) lower = 0xa0;
+      if (c == 0xed) upper = 0x9f;
+    } else if (c >= 0xf0 && c <= 0xf4) {
+      n = 3;
+      if (c == 0xf0) lower = 0x90;
+      if (c == 0xf4) upper = 0x8f;
+    } else {
+      break;
+    }
+
+    if (length - i <= n || data[i + 1] < lower || data[i + 1] > upper)
+      break;
+    size_t k = 2;
+    while (k <= n && (data[i + k] & 0xc0) == 0x80)
+      k++;
+    if (k <= n)
+      break;
+    i += n + 1;
+  }
+  return i;
+}
+
 void ThrowErrStringTooLong(Isolate* isolate) {
   isolate->ThrowException(ERR_STRING_TOO_LONG(isolate));
 }
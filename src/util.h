@@ -642,6 +642,10 @@ using DeleteFnPtr = typename FunctionDeleter<T, function>::Pointer;
 
 std::vector<std::string> SplitString(const std::string& in, char delim);
 
+// Returns the length of the longest prefix of `data` that consists of complete
+// well-formed UTF-8 sequences, as defined by the WHATWG Encoding Standard.
+size_t Utf8ValidPrefixLength(const uint8_t* data, size_t length);
+
 inline v8::MaybeLocal<v8::Value> ToV8Value(v8::Local<v8::Context> context,
                                            const std::string& str,
                                            v8::Isolate* isolate = nullptr);
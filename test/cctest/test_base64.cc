@@ -2,6 +2,8 @@
 
 #include <cstddef>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -140,3 +142,40 @@ TEST(Base64Test, Decode) {
        "dCBjdXBpZGF0YXQgbm9uIHByb2lkZW50LCBzdW50IGluIGN1bHBhIHF1aSBvZmZpY2lh\n"
        "IGRlc2VydW50IG1vbGxpdCBhbmltIGlkIGVzdCBsYWJvcnVtLg", text);
 }
+
+TEST(Base64Test, RoundTrip) {
+  // Long enough for the vectorized loops, with lengths that leave tails of
+  // every size.
+  std::string data;
+  for (int i = 0; i < 1000; i++)
+    data += static_cast<char>(i * 7);
+
+  for (size_t len = 0; len <= data.size(); len += 13) {
+    for (auto mode : {node::Base64Mode::NORMAL, node::Base64Mode::URL}) {
+      const size_t encoded_len = node::base64_encoded_size(len, mode);
+      std::string encoded(encoded_len, '\0');
+      base64_encode(data.data(), len, &encoded[0], encoded_len, mode);
+
+      // Bytes after the decoded data must be left alone.
+      std::string decoded(len + 32, 'x');
+      EXPECT_EQ(len, base64_decode(&decoded[0], decoded.size(),
+                                   encoded.data(), encoded.size()));
+      EXPECT_EQ(data.substr(0, len), decoded.substr(0, len));
+      EXPECT_EQ(std::string(32, 'x'), decoded.substr(len));
+
+      std::vector<uint16_t> wide(encoded.begin(), encoded.end());
+      std::string decoded_wide(len, '\0');
+      EXPECT_EQ(len, base64_decode(&decoded_wide[0], len,
+                                   wide.data(), wide.size()));
+      EXPECT_EQ(data.substr(0, len), decoded_wide);
+
+      if (len > 0) {
+        // Whitespace is skipped.
+        wide.insert(wide.begin() + wide.size() / 2, '\n');
+        EXPECT_EQ(len, base64_decode(&decoded_wide[0], len,
+                                     wide.data(), wide.size()));
+        EXPECT_EQ(data.substr(0, len), decoded_wide);
+      }
+    }
+  }
+}
@@ -1,3 +1,4 @@
+#include "env-inl.h"
 #include "node_buffer.h"
 #include "node_internals.h"
 #include "libplatform/libplatform.h"
@@ -306,6 +307,44 @@ TEST_F(EnvironmentTest, NonNodeJSContext) {
   EXPECT_EQ(node::Environment::GetCurrent(isolate_), nullptr);
 }
 
+TEST_F(EnvironmentTest, CleanupHookSlots) {
+  struct Hook {
+    std::vector<int>* calls;
+    int id;
+  };
+  auto fn = [](void* arg) {
+    Hook* hook = static_cast<Hook*>(arg);
+    hook->calls->push_back(hook->id);
+  };
+  std::vector<int> calls;
+  Hook hooks[] = {
+    { &calls, 0 }, { &calls, 1 }, { &calls, 2 }, { &calls, 3 }, { &calls, 4 }
+  };
+
+  {
+    const v8::HandleScope handle_scope(isolate_);
+    const Argv argv;
+    Env env {handle_scope, argv};
+
+    node::CleanupHookSlot slot0 = (*env)->AddCleanupHookSlot(fn, &hooks[0]);
+    node::CleanupHookSlot slot1 = (*env)->AddCleanupHookSlot(fn, &hooks[1]);
+    EXPECT_NE(slot0, slot1);
+    (*env)->RemoveCleanupHookSlot(slot0, fn, &hooks[0]);
+    // Removing a hook again does nothing, also once its slot is reused.
+    (*env)->RemoveCleanupHookSlot(slot0, fn, &hooks[0]);
+    EXPECT_EQ((*env)->AddCleanupHookSlot(fn, &hooks[2]), slot0);
+    (*env)->RemoveCleanupHookSlot(slot0, fn, &hooks[0]);
+
+    (*env)->AddCleanupHook(fn, &hooks[3]);
+    (*env)->AddCleanupHook(fn, &hooks[4]);
+    (*env)->RemoveCleanupHook(fn, &hooks[3]);
+    (*env)->RemoveCleanupHook(fn, &hooks[3]);
+  }
+
+  // The hooks run in reverse order of insertion.
+  EXPECT_EQ(calls, (std::vector<int>{ 4, 2, 1 }));
+}
+
 static void at_exit_callback1(void* arg) {
   called_cb_1 = true;
   if (arg) {
@@ -715,3 +754,35 @@ TEST_F(EnvironmentTest, NestedMicrotaskQueue) {
   node::FreeEnvironment(env);
   node::FreeIsolateData(isolate_data);
 }
+
+TEST(PoolingArrayBufferAllocatorTest, ReallocateZeroFillsGrownTail) {
+  node::PoolingArrayBufferAllocator allocator;
+  auto is_zero = [](void* data, size_t from, size_t to) {
+    const char* bytes = static_cast<const char*>(data);
+    for (size_t i = from; i < to; i++) {
+      if (bytes[i] != 0) return false;
+    }
+    return true;
+  };
+
+  // Growing within a size class returns the same block, which still holds
+  // the contents of the buffer that used it before.
+  void* dirty = allocator.AllocateUninitialized(2000);
+  memset(dirty, 0xff, 2000);
+  allocator.Free(dirty, 2000);
+  void* data = allocator.AllocateUninitialized(1100);
+  memset(data, 1, 1100);
+  data = allocator.Reallocate(data, 1100, 2000);
+  EXPECT_EQ(static_cast<char*>(data)[1099], 1);
+  EXPECT_TRUE(is_zero(data, 1100, 2000));
+
+  // Growing into another size class takes a block from that class.
+  dirty = allocator.AllocateUninitialized(4000);
+  memset(dirty, 0xff, 4000);
+  allocator.Free(dirty, 4000);
+  data = allocator.Reallocate(data, 2000, 4000);
+  EXPECT_EQ(static_cast<char*>(data)[1099], 1);
+  EXPECT_TRUE(is_zero(data, 1100, 4000));
+
+  allocator.Free(data, 4000);
+}
@@ -0,0 +1,104 @@
+#include "node_mem-inl.h"
+#include "gtest/gtest.h"
+#include "node_test_fixture.h"
+
+#include <cstring>
+
+using node::Environment;
+using node::mem::NgLibMemoryManager;
+
+// Has the same layout as nghttp2_mem and uvwasi_mem_t.
+struct TestAllocatorStruct {
+  void* user_data;
+  void* (*malloc)(size_t size, void* user_data);
+  void (*free)(void* ptr, void* user_data);
+  void* (*calloc)(size_t nmemb, size_t size, void* user_data);
+  void* (*realloc)(void* ptr, size_t size, void* user_data);
+};
+
+class TestMemoryManager
+    : public NgLibMemoryManager<TestMemoryManager, TestAllocatorStruct> {
+ public:
+  explicit TestMemoryManager(Environment* env) : env_(env) {}
+
+  void CheckAllocatedSize(size_t previous_size) const {
+    EXPECT_GE(allocated_, previous_size);
+  }
+  void IncreaseAllocatedSize(size_t size) { allocated_ += size; }
+  void DecreaseAllocatedSize(size_t size) { allocated_ -= size; }
+  Environment* env() const { return env_; }
+
+  size_t allocated_ = 0;
+
+ private:
+  Environment* env_;
+};
+
+class NgLibMemoryManagerTest : public EnvironmentTestFixture {};
+
+TEST_F(NgLibMemoryManagerTest, ReusesSmallBlocks) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env{handle_scope, argv};
+
+  TestMemoryManager manager(*env);
+  TestAllocatorStruct alloc = manager.MakeAllocator();
+
+  void* a = alloc.malloc(10, alloc.user_data);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(manager.allocated_, 64u);
+  memset(a, 'a', 10);
+
+  // Growing within the size class keeps the block.
+  EXPECT_EQ(alloc.realloc(a, 40, alloc.user_data), a);
+  EXPECT_EQ(manager.allocated_, 64u);
+
+  // Growing beyond it moves the contents into a larger block.
+  char* b = static_cast<char*>(alloc.realloc(a, 100, alloc.user_data));
+  ASSERT_NE(b, nullptr);
+  EXPECT_EQ(manager.allocated_, 128u);
+  for (int i = 0; i < 10; i++)
+    EXPECT_EQ(b[i], 'a');
+
+  // The freed 64 byte block is handed out again.
+  void* c = alloc.malloc(1, alloc.user_data);
+  EXPECT_EQ(c, a);
+
+  alloc.free(b, alloc.user_data);
+  alloc.free(c, alloc.user_data);
+  EXPECT_EQ(manager.allocated_, 0u);
+
+  void* zeroed = alloc.calloc(4, 16, alloc.user_data);
+  ASSERT_NE(zeroed, nullptr);
+  for (int i = 0; i < 64; i++)
+    EXPECT_EQ(static_cast<char*>(zeroed)[i], 0);
+  alloc.free(zeroed, alloc.user_data);
+  EXPECT_EQ(manager.allocated_, 0u);
+}
+
+TEST_F(NgLibMemoryManagerTest, LargeAndUntrackedBlocks) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env{handle_scope, argv};
+
+  TestMemoryManager manager(*env);
+  TestAllocatorStruct alloc = manager.MakeAllocator();
+
+  char* large = static_cast<char*>(alloc.malloc(10000, alloc.user_data));
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(manager.allocated_, 10000 + sizeof(size_t));
+  memset(large, 'x', 10000);
+
+  // Shrinking a large block into a size class copies what still fits.
+  char* small = static_cast<char*>(alloc.realloc(large, 20, alloc.user_data));
+  ASSERT_NE(small, nullptr);
+  EXPECT_EQ(manager.allocated_, 64u);
+  for (int i = 0; i < 20; i++)
+    EXPECT_EQ(small[i], 'x');
+
+  // Memory that is no longer tracked is not returned to the pool.
+  manager.StopTrackingMemory(small);
+  EXPECT_EQ(manager.allocated_, 0u);
+  alloc.free(small, alloc.user_data);
+  EXPECT_EQ(manager.allocated_, 0u);
+}
@@ -1,6 +1,7 @@
 #include "node_internals.h"
 #include "libplatform/libplatform.h"
 
+#include <atomic>
 #include <string>
 #include "gtest/gtest.h"
 #include "node_test_fixture.h"
@@ -37,8 +38,81 @@ class RepostingTask : public v8::Task {
   node::NodePlatform* platform_;
 };
 
+// This task increments the given counter, and posts `children` more tasks to
+// the worker threads from the worker thread that it runs on.
+class ForkingWorkerTask : public v8::Task {
+ public:
+  ForkingWorkerTask(int children,
+                    std::atomic<int>* run_count,
+                    node::NodePlatform* platform)
+      : children_(children), run_count_(run_count), platform_(platform) {}
+
+  void Run() final {
+    ++*run_count_;
+    for (int i = 0; i < children_; i++) {
+      platform_->CallOnWorkerThread(
+          std::make_unique<ForkingWorkerTask>(0, run_count_, platform_));
+    }
+  }
+
+ private:
+  int children_;
+  std::atomic<int>* run_count_;
+  node::NodePlatform* platform_;
+};
+
+// This task records whether it ran earlier than `delay_ms` after it was
+// created. Timers have a resolution of 1 ms, which is allowed for.
+class DelayedWorkerTask : public v8::Task {
+ public:
+  DelayedWorkerTask(uint64_t delay_ms,
+                    std::atomic<int>* run_count,
+                    std::atomic<int>* early_count)
+      : due_time_(uv_hrtime() + delay_ms * 1000000),
+        run_count_(run_count),
+        early_count_(early_count) {}
+
+  void Run() final {
+    if (uv_hrtime() + 1000000 < due_time_)
+      ++*early_count_;
+    ++*run_count_;
+  }
+
+ private:
+  uint64_t due_time_;
+  std::atomic<int>* run_count_;
+  std::atomic<int>* early_count_;
+};
+
 class PlatformTest : public EnvironmentTestFixture {};
 
+TEST_F(PlatformTest, WorkerThreadTasksPostedFromWorkerThreads) {
+  std::atomic<int> run_count {0};
+  for (int i = 0; i < 100; i++) {
+    platform->CallOnWorkerThread(
+        std::make_unique<ForkingWorkerTask>(10, &run_count, platform.get()));
+  }
+  platform->DrainTasks(isolate_);
+  EXPECT_EQ(1100, run_count.load());
+}
+
+TEST_F(PlatformTest, DelayedWorkerThreadTasks) {
+  std::atomic<int> run_count {0};
+  std::atomic<int> early_count {0};
+  // Posted out of order, including several tasks with the same due time.
+  for (uint64_t delay_ms : {30, 10, 20, 10, 0, 10, 50}) {
+    platform->CallDelayedOnWorkerThread(
+        std::make_unique<DelayedWorkerTask>(
+            delay_ms, &run_count, &early_count),
+        delay_ms / 1000.0);
+  }
+  while (run_count.load() < 7)
+    uv_sleep(1);
+  platform->DrainTasks(isolate_);
+  EXPECT_EQ(7, run_count.load());
+  EXPECT_EQ(0, early_count.load());
+}
+
 TEST_F(PlatformTest, SkipNewTasksInFlushForegroundTasks) {
   v8::Isolate::Scope isolate_scope(isolate_);
   const v8::HandleScope handle_scope(isolate_);
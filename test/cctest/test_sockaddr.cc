@@ -4,6 +4,7 @@
 using node::SocketAddress;
 using node::SocketAddressBlockList;
 using node::SocketAddressLRU;
+using node::SocketAddressRateLimiter;
 
 TEST(SocketAddress, SocketAddress) {
   CHECK(SocketAddress::is_numeric_host("123.123.123.123"));
@@ -189,6 +190,15 @@ TEST(SocketAddress, Comparison) {
   CHECK(addr6 >= addr1);
   CHECK(addr2 >= addr6);
   CHECK(addr2 >= addr5);
+
+  // IPv4 addresses are compared by value, not by their bytes in memory.
+  sockaddr_storage storage_ipv4[2];
+  SocketAddress::ToSockAddr(AF_INET, "172.16.0.5", 0, &storage_ipv4[0]);
+  SocketAddress::ToSockAddr(AF_INET, "172.40.0.0", 0, &storage_ipv4[1]);
+  SocketAddress addr7(reinterpret_cast<const sockaddr*>(&storage_ipv4[0]));
+  SocketAddress addr8(reinterpret_cast<const sockaddr*>(&storage_ipv4[1]));
+  CHECK_EQ(addr7.compare(addr8), SocketAddress::CompareResult::LESS_THAN);
+  CHECK_EQ(addr8.compare(addr7), SocketAddress::CompareResult::GREATER_THAN);
 }
 
 TEST(SocketAddressBlockList, Simple) {
@@ -211,3 +221,70 @@ TEST(SocketAddressBlockList, Simple) {
   CHECK(!bl.Apply(addr1));
   CHECK(bl.Apply(addr2));
 }
+
+TEST(SocketAddressBlockList, Prefixes) {
+  SocketAddressBlockList bl;
+
+  auto address = [](int family, const char* host) {
+    sockaddr_storage storage;
+    CHECK(SocketAddress::ToSockAddr(family, host, 0, &storage));
+    return SocketAddress(reinterpret_cast<const sockaddr*>(&storage));
+  };
+
+  bl.AddSocketAddressMask(address(AF_INET, "10.0.0.0"), 8);
+  bl.AddSocketAddressMask(address(AF_INET, "10.1.0.0"), 16);
+  bl.AddSocketAddressMask(address(AF_INET6, "2001:db8::"), 32);
+  bl.AddSocketAddressRange(address(AF_INET, "192.168.0.3"),
+                           address(AF_INET, "192.168.1.5"));
+  bl.AddSocketAddress(address(AF_INET6, "::1"));
+
+  CHECK(bl.Apply(address(AF_INET, "10.0.0.1")));
+  CHECK(bl.Apply(address(AF_INET, "10.255.255.255")));
+  CHECK(bl.Apply(address(AF_INET6, "::ffff:10.1.2.3")));
+  CHECK(!bl.Apply(address(AF_INET, "11.0.0.0")));
+  CHECK(bl.Apply(address(AF_INET6, "2001:db8:ffff::1")));
+  CHECK(!bl.Apply(address(AF_INET6, "2001:db9::")));
+  CHECK(!bl.Apply(address(AF_INET, "192.168.0.2")));
+  CHECK(bl.Apply(address(AF_INET, "192.168.0.3")));
+  CHECK(bl.Apply(address(AF_INET, "192.168.0.255")));
+  CHECK(bl.Apply(address(AF_INET, "192.168.1.5")));
+  CHECK(!bl.Apply(address(AF_INET, "192.168.1.6")));
+  CHECK(bl.Apply(address(AF_INET6, "::1")));
+  CHECK(!bl.Apply(address(AF_INET6, "::2")));
+
+  bl.RemoveSocketAddress(address(AF_INET6, "::1"));
+  CHECK(!bl.Apply(address(AF_INET6, "::1")));
+  CHECK(bl.Apply(address(AF_INET, "10.0.0.1")));
+}
+
+TEST(SocketAddressRateLimiter, Simple) {
+  SocketAddressRateLimiter limiter(10, 2, 2);
+
+  auto address = [](const char* host, int port) {
+    sockaddr_storage storage;
+    CHECK(SocketAddress::ToSockAddr(AF_INET, host, port, &storage));
+    return SocketAddress(reinterpret_cast<const sockaddr*>(&storage));
+  };
+
+  // The buckets are far in the future so that they are never dropped as
+  // full while the test runs.
+  uint64_t now = uv_hrtime() + 1e12;
+
+  // The port of the address is ignored.
+  CHECK(limiter.Consume(address("10.0.0.1", 1), now));
+  CHECK(limiter.Consume(address("10.0.0.1", 2), now));
+  CHECK(!limiter.Consume(address("10.0.0.1", 3), now));
+  CHECK(limiter.Consume(address("10.0.0.2", 1), now));
+  CHECK_EQ(limiter.size(), 2);
+
+  // A token is added every 100ms.
+  CHECK(!limiter.Consume(address("10.0.0.1", 1), now + 5e7));
+  CHECK(limiter.Consume(address("10.0.0.1", 1), now + 1e8));
+  CHECK(!limiter.Consume(address("10.0.0.1", 1), now + 1e8));
+
+  // The least recently used bucket is dropped, and starts out full again.
+  CHECK(limiter.Consume(address("10.0.0.3", 1), now + 1e8));
+  CHECK_EQ(limiter.size(), 2);
+  CHECK(limiter.Consume(address("10.0.0.2", 1), now + 1e8));
+  CHECK(limiter.Consume(address("10.0.0.2", 1), now + 1e8));
+}
@@ -0,0 +1,31 @@
+import { mustCall } from '../common/index.mjs';
+import tmpdir from '../common/tmpdir.js';
+import assert from 'assert';
+import { writeFileSync } from 'fs';
+import { join } from 'path';
+import { pathToFileURL } from 'url';
+
+// Modules that are read as strings are decoded the same way as the ones
+// that are read into a Buffer: a byte order mark is dropped, and invalid
+// UTF-8 is replaced.
+
+tmpdir.refresh();
+
+writeFileSync(join(tmpdir.path, 'bom.mjs'),
+              Buffer.concat([Buffer.from([0xef, 0xbb, 0xbf]),
+                             Buffer.from('export default "bom";')]));
+writeFileSync(join(tmpdir.path, 'invalid.mjs'),
+              Buffer.concat([Buffer.from('export default "'),
+                             Buffer.from([0xff]),
+                             Buffer.from('";')]));
+writeFileSync(join(tmpdir.path, 'main.mjs'),
+              'export { default as bom } from "./bom.mjs";\n' +
+              'export { default as invalid } from "./invalid.mjs";\n');
+
+import(pathToFileURL(join(tmpdir.path, 'main.mjs'))).then(mustCall((ns) => {
+  assert.strictEqual(ns.bom, 'bom');
+  assert.strictEqual(ns.invalid, '\ufffd');
+}));
+
+import(pathToFileURL(join(tmpdir.path, 'missing.mjs'))).catch(
+  mustCall((err) => assert.strictEqual(err.code, 'ERR_MODULE_NOT_FOUND')));
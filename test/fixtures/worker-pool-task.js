@@ -0,0 +1,25 @@
+'use strict';
+const { threadId, workerData } = require('worker_threads');
+
+module.exports = async function({ op, value }) {
+  switch (op) {
+    case 'echo':
+      return value;
+    case 'thread':
+      return threadId;
+    case 'workerData':
+      return workerData;
+    case 'wait':
+      await new Promise((resolve) => setTimeout(resolve, value));
+      return threadId;
+    case 'spin': {
+      const end = Date.now() + value;
+      while (Date.now() < end);
+      return threadId;
+    }
+    case 'throw':
+      throw new TypeError(value);
+    case 'exit':
+      process.exit(value);
+  }
+};
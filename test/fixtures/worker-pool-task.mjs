@@ -0,0 +1,3 @@
+export default function(value) {
+  return value * 2;
+}
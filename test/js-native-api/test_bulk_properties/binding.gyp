@@ -0,0 +1,12 @@
+{
+  "targets": [
+    {
+      "target_name": "test_bulk_properties",
+      "sources": [
+        "../common.c",
+        "../entry_point.c",
+        "test_bulk_properties.c"
+      ]
+    }
+  ]
+}
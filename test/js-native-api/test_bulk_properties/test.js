@@ -0,0 +1,48 @@
+'use strict';
+// Flags: --allow-natives-syntax
+
+const common = require('../../common');
+const assert = require('assert');
+
+const binding =
+  require(`./build/${common.buildType}/test_bulk_properties`);
+
+assert.deepStrictEqual(binding.testKeys(), {});
+
+// The cached keys can be used for any number of calls.
+for (let i = 0; i < 10; i++) {
+  assert.deepStrictEqual(binding.readPoint({ x: i, y: 'y', z: null }),
+                         [i, 'y', null]);
+}
+const none = [undefined, undefined, undefined];
+assert.deepStrictEqual(binding.readPoint({}), none);
+assert.deepStrictEqual(
+  binding.readPoint(Object.create({ x: 1 }, { y: { get: () => 2 } })),
+  [1, 2, undefined]);
+assert.deepStrictEqual(binding.readPoint([]), none);
+assert.throws(() => {
+  binding.readPoint({ x: 1, get y() { throw new Error('getter'); } });
+}, /^Error: getter$/);
+
+// The objects are ordinary objects that share their hidden class.
+const point = binding.makePoint(1, 'two', [3]);
+assert.deepStrictEqual(point, { x: 1, y: 'two', z: [3] });
+assert.strictEqual(Object.getPrototypeOf(point), Object.prototype);
+assert.deepStrictEqual(Object.getOwnPropertyDescriptor(point, 'y'), {
+  value: 'two',
+  writable: true,
+  enumerable: true,
+  configurable: true,
+});
+assert(eval('%HaveSameMap(point, binding.makePoint(4, 5, 6))'));
+
+const symbol = Symbol('symbol');
+const object = binding.makeObject(['a', symbol, 'a'], [1, 2, 3]);
+assert.deepStrictEqual(Object.keys(object), ['a']);
+assert.strictEqual(object.a, 3);
+assert.strictEqual(object[symbol], 2);
+assert.deepStrictEqual(binding.makeObject([], []), {});
+
+assert.throws(() => binding.makeObject([1], [1]), {
+  message: 'A string or symbol was expected'
+});
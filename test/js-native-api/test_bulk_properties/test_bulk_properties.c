@@ -0,0 +1,129 @@
+#define NAPI_EXPERIMENTAL
+#include <stdlib.h>
+#include <js_native_api.h>
+#include "../common.h"
+
+#define KEY_COUNT 3
+
+// The keys of a point, which are created once when the addon is loaded.
+typedef struct {
+  napi_ref keys[KEY_COUNT];
+} instance_data;
+
+static void DeleteInstanceData(napi_env env, void* data, void* hint) {
+  instance_data* d = data;
+  size_t i;
+  for (i = 0; i < KEY_COUNT; i++)
+    NODE_API_CALL_RETURN_VOID(env, napi_delete_reference(env, d->keys[i]));
+  free(d);
+}
+
+static napi_status GetKeys(napi_env env, napi_value* keys) {
+  instance_data* d;
+  napi_status status;
+  size_t i;
+  status = napi_get_instance_data(env, (void**)&d);
+  if (status != napi_ok) return status;
+  for (i = 0; i < KEY_COUNT; i++) {
+    status = napi_get_reference_value(env, d->keys[i], &keys[i]);
+    if (status != napi_ok) return status;
+  }
+  return napi_ok;
+}
+
+// Returns the array [object.x, object.y, object.z].
+static napi_value ReadPoint(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value object, keys[KEY_COUNT], values[KEY_COUNT], result;
+  size_t i;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, &object, NULL, NULL));
+  NODE_API_CALL(env, GetKeys(env, keys));
+  NODE_API_CALL(env,
+      node_api_get_properties(env, object, KEY_COUNT, keys, values));
+  NODE_API_CALL(env, napi_create_array_with_length(env, KEY_COUNT, &result));
+  for (i = 0; i < KEY_COUNT; i++)
+    NODE_API_CALL(env, napi_set_element(env, result, i, values[i]));
+  return result;
+}
+
+// Returns { x, y, z } for the arguments x, y and z.
+static napi_value MakePoint(napi_env env, napi_callback_info info) {
+  size_t argc = KEY_COUNT;
+  napi_value values[KEY_COUNT], keys[KEY_COUNT], result;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, values, NULL, NULL));
+  NODE_API_ASSERT(env, argc == KEY_COUNT, "Wrong number of arguments");
+  NODE_API_CALL(env, GetKeys(env, keys));
+  NODE_API_CALL(env, node_api_create_object_with_properties(
+      env, KEY_COUNT, keys, values, &result));
+  return result;
+}
+
+// Returns an object with the keys and values of the two arrays.
+static napi_value MakeObject(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], keys[8], values[8], result;
+  uint32_t count, i;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_array_length(env, argv[0], &count));
+  NODE_API_ASSERT(env, count <= 8, "Too many properties");
+  for (i = 0; i < count; i++) {
+    NODE_API_CALL(env, napi_get_element(env, argv[0], i, &keys[i]));
+    NODE_API_CALL(env, napi_get_element(env, argv[1], i, &values[i]));
+  }
+  NODE_API_CALL(env, node_api_create_object_with_properties(
+      env, count, keys, values, &result));
+  return result;
+}
+
+static napi_value TestKeys(napi_env env, napi_callback_info info) {
+  napi_value a, b, c, result;
+  bool same;
+  NODE_API_CALL(env, node_api_create_property_key_utf8(
+      env, "key", NAPI_AUTO_LENGTH, &a));
+  NODE_API_CALL(env, node_api_create_property_key_utf8(env, "keyed", 3, &b));
+  NODE_API_CALL(env, napi_create_string_utf8(env, "key", 3, &c));
+  NODE_API_CALL(env, napi_strict_equals(env, a, b, &same));
+  NODE_API_ASSERT(env, same, "The keys are not equal");
+  NODE_API_CALL(env, napi_strict_equals(env, a, c, &same));
+  NODE_API_ASSERT(env, same, "The key is not equal to the string");
+
+  NODE_API_ASSERT(env,
+      node_api_get_properties(env, NULL, 1, &a, &b) == napi_invalid_arg,
+      "node_api_get_properties() accepts a NULL object");
+  NODE_API_ASSERT(env,
+      node_api_create_object_with_properties(env, 1, NULL, &a, &b) ==
+          napi_invalid_arg,
+      "node_api_create_object_with_properties() accepts NULL keys");
+  NODE_API_CALL(env,
+      node_api_create_object_with_properties(env, 0, NULL, NULL, &result));
+  return result;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  static const char* names[KEY_COUNT] = { "x", "y", "z" };
+  instance_data* d = malloc(sizeof(*d));
+  size_t i;
+  NODE_API_ASSERT(env, d != NULL, "Out of memory");
+  for (i = 0; i < KEY_COUNT; i++) {
+    napi_value key;
+    NODE_API_CALL(env, node_api_create_property_key_utf8(
+        env, names[i], NAPI_AUTO_LENGTH, &key));
+    NODE_API_CALL(env, napi_create_reference(env, key, 1, &d->keys[i]));
+  }
+  NODE_API_CALL(env,
+      napi_set_instance_data(env, d, DeleteInstanceData, NULL));
+
+  napi_property_descriptor descriptors[] = {
+    DECLARE_NODE_API_PROPERTY("readPoint", ReadPoint),
+    DECLARE_NODE_API_PROPERTY("makePoint", MakePoint),
+    DECLARE_NODE_API_PROPERTY("makeObject", MakeObject),
+    DECLARE_NODE_API_PROPERTY("testKeys", TestKeys),
+  };
+
+  NODE_API_CALL(env, napi_define_properties(
+      env, exports, sizeof(descriptors) / sizeof(*descriptors), descriptors));
+
+  return exports;
+}
+EXTERN_C_END
@@ -0,0 +1,27 @@
+'use strict';
+// Flags: --expose-gc
+
+const common = require('../../common');
+const assert = require('assert');
+
+const binding =
+  require(`./build/${common.buildType}/test_external_string`);
+
+function create() {
+  const latin1 = binding.createExternal('latin1', 'café ', 100000);
+  assert.strictEqual(latin1, 'café '.repeat(100000));
+  const utf16 = binding.createExternal('utf16', 'abc', 100000);
+  assert.strictEqual(utf16, 'abc'.repeat(100000));
+
+  // The empty strings are copied, and finalized right away.
+  assert.strictEqual(binding.createExternal('latin1', '', 1), '');
+  assert.strictEqual(binding.createExternal('utf16', 'abc', 0), '');
+}
+
+create();
+
+// The buffers are freed once the strings are collected.
+global.gc();
+setImmediate(common.mustCall(() => {
+  assert.strictEqual(binding.getFinalizeCount(), 4);
+}));
@@ -0,0 +1,78 @@
+#define NAPI_EXPERIMENTAL
+#include <stdlib.h>
+#include <string.h>
+#include <js_native_api.h>
+#include "../common.h"
+
+static uint32_t finalize_count = 0;
+
+static void FinalizeString(napi_env env, void* data, void* hint) {
+  NODE_API_ASSERT_RETURN_VOID(env, hint == &finalize_count,
+                              "The finalizer got the wrong hint");
+  free(data);
+  finalize_count++;
+}
+
+// Returns the string that the argument is repeated `count` times in, in an
+// external string of the given encoding.
+static napi_value CreateExternal(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3], result;
+  char encoding[8];
+  char unit[128];
+  size_t unit_length, i;
+  uint32_t count;
+  bool copied;
+  napi_status status;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_string_utf8(
+      env, argv[0], encoding, sizeof(encoding), NULL));
+  NODE_API_CALL(env, napi_get_value_string_latin1(
+      env, argv[1], unit, sizeof(unit), &unit_length));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[2], &count));
+
+  if (strcmp(encoding, "latin1") == 0) {
+    char* str = malloc(unit_length * count + 1);
+    NODE_API_ASSERT(env, str != NULL, "Out of memory");
+    for (i = 0; i < count; i++)
+      memcpy(str + i * unit_length, unit, unit_length);
+    str[unit_length * count] = '\0';
+    status = node_api_create_external_string_latin1(
+        env, str, NAPI_AUTO_LENGTH, FinalizeString, &finalize_count, &result,
+        &copied);
+    if (status != napi_ok) free(str);
+  } else {
+    char16_t* str = malloc(sizeof(*str) * unit_length * count);
+    NODE_API_ASSERT(env, str != NULL, "Out of memory");
+    for (i = 0; i < unit_length * count; i++)
+      str[i] = (unsigned char)unit[i % unit_length];
+    status = node_api_create_external_string_utf16(
+        env, str, unit_length * count, FinalizeString, &finalize_count,
+        &result, &copied);
+    if (status != napi_ok) free(str);
+  }
+  NODE_API_CALL(env, status);
+  NODE_API_ASSERT(env, copied == (unit_length * count == 0),
+                  "Only empty strings are copied");
+  return result;
+}
+
+static napi_value GetFinalizeCount(napi_env env, napi_callback_info info) {
+  napi_value result;
+  NODE_API_CALL(env, napi_create_uint32(env, finalize_count, &result));
+  return result;
+}
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor descriptors[] = {
+    DECLARE_NODE_API_PROPERTY("createExternal", CreateExternal),
+    DECLARE_NODE_API_PROPERTY("getFinalizeCount", GetFinalizeCount),
+  };
+
+  NODE_API_CALL(env, napi_define_properties(
+      env, exports, sizeof(descriptors) / sizeof(*descriptors), descriptors));
+
+  return exports;
+}
+EXTERN_C_END
@@ -0,0 +1,12 @@
+{
+  "targets": [
+    {
+      "target_name": "test_fast_function",
+      "sources": [
+        "../common.c",
+        "../entry_point.c",
+        "test_fast_function.c"
+      ]
+    }
+  ]
+}
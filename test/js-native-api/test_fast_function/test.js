@@ -0,0 +1,41 @@
+'use strict';
+// Flags: --allow-natives-syntax --turbo-fast-api-calls
+
+const common = require('../../common');
+const assert = require('assert');
+
+const binding =
+  require(`./build/${common.buildType}/test_fast_function`);
+
+assert.strictEqual(binding.testInvalidSignatures(), true);
+assert.strictEqual(binding.add.name, 'add');
+
+// Called from unoptimized code, the slow callbacks are used.
+assert.strictEqual(binding.add(1.5, 2), 3.5);
+assert.strictEqual(binding.divide(7, 2), 3);
+assert.throws(() => binding.divide(1, 0), RangeError);
+assert.deepStrictEqual(binding.getCalls(), { fast: 0, slow: 3 });
+
+function add(a, b) {
+  return binding.add(a, b);
+}
+
+function divide(a, b) {
+  return binding.divide(a, b);
+}
+
+eval('%PrepareFunctionForOptimization(add)');
+eval('%PrepareFunctionForOptimization(divide)');
+add(1, 2);
+divide(4, 2);
+eval('%OptimizeFunctionOnNextCall(add)');
+eval('%OptimizeFunctionOnNextCall(divide)');
+
+// Whichever of the functions is called, the results are the same.
+assert.strictEqual(add(0.25, 0.5), 0.75);
+assert.strictEqual(divide(9, 3), 3);
+// The fast function falls back to the slow callback to throw.
+assert.throws(() => divide(1, 0), RangeError);
+
+const calls = binding.getCalls();
+assert.strictEqual(calls.fast + calls.slow, 8);
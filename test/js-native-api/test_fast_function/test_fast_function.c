@@ -0,0 +1,143 @@
+#define NAPI_EXPERIMENTAL
+#include <js_native_api.h>
+#include "../common.h"
+
+static uint32_t fast_calls = 0;
+static uint32_t slow_calls = 0;
+
+static double FastAdd(node_api_fast_receiver receiver,
+                      double a,
+                      double b,
+                      node_api_fast_options* options) {
+  fast_calls++;
+  return a + b;
+}
+
+static napi_value Add(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  double a, b;
+  NODE_API_CALL(env, napi_get_value_double(env, args[0], &a));
+  NODE_API_CALL(env, napi_get_value_double(env, args[1], &b));
+  slow_calls++;
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_double(env, a + b, &result));
+  return result;
+}
+
+static int32_t FastDivide(node_api_fast_receiver receiver,
+                          int32_t a,
+                          int32_t b,
+                          node_api_fast_options* options) {
+  if (b == 0) {
+    // Let the slow callback throw.
+    options->fallback = true;
+    return 0;
+  }
+  fast_calls++;
+  return a / b;
+}
+
+static napi_value Divide(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, args, NULL, NULL));
+
+  int32_t a, b;
+  NODE_API_CALL(env, napi_get_value_int32(env, args[0], &a));
+  NODE_API_CALL(env, napi_get_value_int32(env, args[1], &b));
+  slow_calls++;
+  if (b == 0) {
+    napi_throw_range_error(env, NULL, "Division by zero");
+    return NULL;
+  }
+
+  napi_value result;
+  NODE_API_CALL(env, napi_create_int32(env, a / b, &result));
+  return result;
+}
+
+static napi_value GetCalls(napi_env env, napi_callback_info info) {
+  napi_value result, fast, slow;
+  NODE_API_CALL(env, napi_create_object(env, &result));
+  NODE_API_CALL(env, napi_create_uint32(env, fast_calls, &fast));
+  NODE_API_CALL(env, napi_create_uint32(env, slow_calls, &slow));
+  NODE_API_CALL(env, napi_set_named_property(env, result, "fast", fast));
+  NODE_API_CALL(env, napi_set_named_property(env, result, "slow", slow));
+  return result;
+}
+
+static napi_value TestInvalidSignatures(napi_env env, napi_callback_info info) {
+  static const node_api_fast_type void_argument[] = { node_api_fast_void };
+  node_api_fast_function fast_function = {
+    (const void*) FastAdd, node_api_fast_float64, 1, void_argument
+  };
+  napi_value fn;
+  NODE_API_ASSERT(env,
+      node_api_create_fast_function(env, NULL, 0, Add, NULL, &fast_function,
+                                    &fn) == napi_invalid_arg,
+      "A void argument is rejected");
+
+  fast_function.argument_types = NULL;
+  NODE_API_ASSERT(env,
+      node_api_create_fast_function(env, NULL, 0, Add, NULL, &fast_function,
+                                    &fn) == napi_invalid_arg,
+      "Missing argument types are rejected");
+
+  fast_function.argument_count = 0;
+  fast_function.return_type = (node_api_fast_type) 100;
+  NODE_API_ASSERT(env,
+      node_api_create_fast_function(env, NULL, 0, Add, NULL, &fast_function,
+                                    &fn) == napi_invalid_arg,
+      "An unknown return type is rejected");
+
+  fast_function.return_type = node_api_fast_float64;
+  fast_function.function = NULL;
+  NODE_API_ASSERT(env,
+      node_api_create_fast_function(env, NULL, 0, Add, NULL, &fast_function,
+                                    &fn) == napi_invalid_arg,
+      "A missing function is rejected");
+
+  napi_value result;
+  NODE_API_CALL(env, napi_get_boolean(env, true, &result));
+  return result;
+}
+
+static const node_api_fast_type kFloat64Arguments[] = {
+  node_api_fast_float64, node_api_fast_float64
+};
+static const node_api_fast_type kInt32Arguments[] = {
+  node_api_fast_int32, node_api_fast_int32
+};
+
+EXTERN_C_START
+napi_value Init(napi_env env, napi_value exports) {
+  node_api_fast_function fast_add = {
+    (const void*) FastAdd, node_api_fast_float64, 2, kFloat64Arguments
+  };
+  node_api_fast_function fast_divide = {
+    (const void*) FastDivide, node_api_fast_int32, 2, kInt32Arguments
+  };
+
+  napi_value add, divide;
+  NODE_API_CALL(env, node_api_create_fast_function(
+      env, "add", NAPI_AUTO_LENGTH, Add, NULL, &fast_add, &add));
+  NODE_API_CALL(env, node_api_create_fast_function(
+      env, "divide", NAPI_AUTO_LENGTH, Divide, NULL, &fast_divide, &divide));
+
+  napi_property_descriptor descriptors[] = {
+    { "add", NULL, NULL, NULL, NULL, add, napi_enumerable, NULL },
+    { "divide", NULL, NULL, NULL, NULL, divide, napi_enumerable, NULL },
+    DECLARE_NODE_API_PROPERTY("getCalls", GetCalls),
+    DECLARE_NODE_API_PROPERTY("testInvalidSignatures", TestInvalidSignatures),
+  };
+
+  NODE_API_CALL(env, napi_define_properties(
+      env, exports, sizeof(descriptors) / sizeof(*descriptors), descriptors));
+
+  return exports;
+}
+EXTERN_C_END
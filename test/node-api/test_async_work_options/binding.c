@@ -0,0 +1,130 @@
+#define NAPI_EXPERIMENTAL
+#include <stdlib.h>
+#include <uv.h>
+#include <node_api.h>
+#include "../../js-native-api/common.h"
+
+typedef struct {
+  napi_async_work work;
+  napi_ref callback;
+  // The time to sleep for in execute, or 0 to wait until the work is
+  // cancelled.
+  uint32_t sleep_ms;
+  int executed;
+} work_data;
+
+static void Execute(napi_env env, void* data) {
+  work_data* w = data;
+  w->executed = 1;
+  if (w->sleep_ms > 0) {
+    uv_sleep(w->sleep_ms);
+    return;
+  }
+  // Gives up after 10 seconds, so that the test fails instead of hanging.
+  int i;
+  for (i = 0; i < 1000; i++) {
+    bool cancelled;
+    if (node_api_is_async_work_cancelled(w->work, &cancelled) != napi_ok) {
+      napi_fatal_error("Execute", NAPI_AUTO_LENGTH,
+          "node_api_is_async_work_cancelled failed", NAPI_AUTO_LENGTH);
+    }
+    if (cancelled) return;
+    uv_sleep(10);
+  }
+}
+
+// Calls the JavaScript callback with whether the work was cancelled and
+// whether execute ran.
+static void Complete(napi_env env, napi_status status, void* data) {
+  work_data* w = data;
+  napi_value callback, undefined, argv[2];
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_get_boolean(env, status == napi_cancelled, &argv[0]));
+  NODE_API_CALL_RETURN_VOID(env, napi_get_boolean(env, w->executed, &argv[1]));
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_get_reference_value(env, w->callback, &callback));
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(env, napi_delete_reference(env, w->callback));
+  NODE_API_CALL_RETURN_VOID(env, napi_delete_async_work(env, w->work));
+  free(w);
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_call_function(env, undefined, callback, 2, argv, NULL));
+}
+
+static void FinalizeWork(napi_env env, void* data, void* hint) {}
+
+// queue(priority, deadline, sleepMs, callback) returns an external that can be
+// passed to cancel() until the callback is called.
+static napi_value Queue(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4], resource_name, result;
+  uint32_t priority;
+  node_api_async_work_options options;
+  work_data* w;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_ASSERT(env, argc == 4, "Wrong number of arguments");
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[0], &priority));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[1], &options.deadline));
+  options.priority = (node_api_async_work_priority)priority;
+
+  w = calloc(1, sizeof(*w));
+  NODE_API_ASSERT(env, w != NULL, "Out of memory");
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[2], &w->sleep_ms));
+  NODE_API_CALL(env, napi_create_reference(env, argv[3], 1, &w->callback));
+  NODE_API_CALL(env, napi_create_string_utf8(env, "TestAsyncWorkOptions",
+                                             NAPI_AUTO_LENGTH,
+                                             &resource_name));
+  NODE_API_CALL(env, napi_create_async_work(env, NULL, resource_name, Execute,
+                                            Complete, w, &w->work));
+  NODE_API_CALL(env,
+      node_api_queue_async_work_with_options(env, w->work, &options));
+  NODE_API_CALL(env,
+      napi_create_external(env, w, FinalizeWork, NULL, &result));
+  return result;
+}
+
+static napi_value Cancel(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1];
+  work_data* w;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_CALL(env, napi_get_value_external(env, argv[0], (void**)&w));
+  // Fails for work that is already running, which is still asked to stop.
+  napi_cancel_async_work(env, w->work);
+  return NULL;
+}
+
+// Returns the status of queueing work with an invalid priority.
+static napi_value QueueInvalid(napi_env env, napi_callback_info info) {
+  napi_value resource_name, result;
+  napi_async_work work;
+  napi_status status;
+  node_api_async_work_options options = {
+    (node_api_async_work_priority)42, 0
+  };
+  NODE_API_CALL(env, napi_create_string_utf8(env, "TestAsyncWorkOptions",
+                                             NAPI_AUTO_LENGTH,
+                                             &resource_name));
+  NODE_API_CALL(env, napi_create_async_work(env, NULL, resource_name, Execute,
+                                            Complete, NULL, &work));
+  status = node_api_queue_async_work_with_options(env, work, &options);
+  NODE_API_CALL(env, napi_delete_async_work(env, work));
+  NODE_API_CALL(env, napi_create_uint32(env, status, &result));
+  return result;
+}
+
+NAPI_MODULE_INIT() {
+  napi_value status;
+  napi_property_descriptor properties[] = {
+    DECLARE_NODE_API_PROPERTY("queue", Queue),
+    DECLARE_NODE_API_PROPERTY("cancel", Cancel),
+    DECLARE_NODE_API_PROPERTY("queueInvalid", QueueInvalid),
+    { "napi_invalid_arg", NULL, NULL, NULL, NULL, NULL, napi_enumerable,
+      NULL },
+  };
+  NODE_API_CALL(env, napi_create_uint32(env, napi_invalid_arg, &status));
+  properties[3].value = status;
+  NODE_API_CALL(env, napi_define_properties(env, exports,
+      sizeof(properties) / sizeof(*properties), properties));
+  return exports;
+}
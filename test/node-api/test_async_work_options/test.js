@@ -0,0 +1,57 @@
+// Flags: --threadpool-limits=napi=1
+'use strict';
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/binding`);
+
+const kLow = 0;
+const kNormal = 1;
+const kHigh = 2;
+
+assert.strictEqual(binding.queueInvalid(), binding.napi_invalid_arg);
+
+function queue(priority, deadline, sleepMs, onComplete) {
+  return binding.queue(priority, deadline, sleepMs,
+                       common.mustCall(onComplete));
+}
+
+// While the only work that the limit allows runs, the work that waits for it
+// is started in order of priority, and work whose deadline passes while it
+// waits is never started.
+const order = [];
+queue(kNormal, 0, 200, (cancelled, executed) => {
+  assert.strictEqual(cancelled, false);
+  assert.strictEqual(executed, true);
+  order.push('blocker');
+});
+queue(kLow, 0, 1, (cancelled) => {
+  assert.strictEqual(cancelled, false);
+  order.push('low');
+  assert.deepStrictEqual(order,
+                         ['blocker', 'high', 'normal', 'expired', 'low']);
+  testCancelRunning();
+});
+queue(kNormal, 0, 1, (cancelled) => {
+  assert.strictEqual(cancelled, false);
+  order.push('normal');
+});
+queue(kHigh, 0, 1, (cancelled) => {
+  assert.strictEqual(cancelled, false);
+  order.push('high');
+});
+queue(kNormal, 50, 1, (cancelled, executed) => {
+  assert.strictEqual(cancelled, true);
+  assert.strictEqual(executed, false);
+  order.push('expired');
+});
+
+// Work that is already running keeps running when it is cancelled, but can
+// see that it was, and reports that it was cancelled.
+function testCancelRunning() {
+  const work = queue(kNormal, 0, 0, (cancelled, executed) => {
+    assert.strictEqual(cancelled, true);
+    assert.strictEqual(executed, true);
+  });
+  setTimeout(() => binding.cancel(work), 50);
+}
@@ -0,0 +1,135 @@
+#define NAPI_EXPERIMENTAL
+#include <stdlib.h>
+#include <uv.h>
+#include <node_api.h>
+#include "../../js-native-api/common.h"
+
+typedef struct {
+  uv_thread_t thread;
+  napi_threadsafe_function ts_fn;
+  uint32_t count;
+  uint32_t* items;
+} producer;
+
+static void ProduceItems(void* data) {
+  producer* p = data;
+  uint32_t i;
+  for (i = 0; i < p->count; i++) {
+    p->items[i] = i;
+    if (napi_call_threadsafe_function(p->ts_fn, &p->items[i],
+                                      napi_tsfn_blocking) != napi_ok) {
+      napi_fatal_error("ProduceItems", NAPI_AUTO_LENGTH,
+          "napi_call_threadsafe_function failed", NAPI_AUTO_LENGTH);
+    }
+  }
+  if (napi_release_threadsafe_function(p->ts_fn, napi_tsfn_release) !=
+      napi_ok) {
+    napi_fatal_error("ProduceItems", NAPI_AUTO_LENGTH,
+        "napi_release_threadsafe_function failed", NAPI_AUTO_LENGTH);
+  }
+}
+
+// Calls the JavaScript callback with an array of the items of the batch.
+static void CallJsBatch(napi_env env,
+                        napi_value js_callback,
+                        void* context,
+                        void** data,
+                        size_t count) {
+  if (env == NULL || js_callback == NULL) return;
+  napi_value batch, undefined;
+  size_t i;
+  NODE_API_CALL_RETURN_VOID(env, napi_create_array_with_length(env, count,
+                                                               &batch));
+  for (i = 0; i < count; i++) {
+    napi_value item;
+    NODE_API_CALL_RETURN_VOID(env,
+        napi_create_uint32(env, *(uint32_t*)data[i], &item));
+    NODE_API_CALL_RETURN_VOID(env, napi_set_element(env, batch, i, item));
+  }
+  NODE_API_CALL_RETURN_VOID(env, napi_get_undefined(env, &undefined));
+  NODE_API_CALL_RETURN_VOID(env,
+      napi_call_function(env, undefined, js_callback, 1, &batch, NULL));
+}
+
+static void CallJs(napi_env env,
+                   napi_value js_callback,
+                   void* context,
+                   void* data) {
+  napi_fatal_error("CallJs", NAPI_AUTO_LENGTH,
+      "call_js_cb is called despite the batch callback", NAPI_AUTO_LENGTH);
+}
+
+static void Finalize(napi_env env, void* data, void* context) {
+  producer* p = data;
+  if (uv_thread_join(&p->thread) != 0) {
+    napi_fatal_error("Finalize", NAPI_AUTO_LENGTH,
+        "uv_thread_join failed", NAPI_AUTO_LENGTH);
+  }
+  free(p->items);
+  free(p);
+}
+
+// produce(callback, count, maxBatchSize, maxBatchLatency) queues `count`
+// items from another thread, and delivers them to `callback` in batches.
+static napi_value Produce(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4], name;
+  uint32_t count, max_batch_size, max_batch_latency;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  NODE_API_ASSERT(env, argc == 4, "Wrong number of arguments");
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[1], &count));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[2], &max_batch_size));
+  NODE_API_CALL(env, napi_get_value_uint32(env, argv[3], &max_batch_latency));
+  NODE_API_CALL(env, napi_create_string_utf8(env, "batch", NAPI_AUTO_LENGTH,
+                                             &name));
+
+  producer* p = malloc(sizeof(*p));
+  p->count = count;
+  p->items = malloc(sizeof(*p->items) * (count > 0 ? count : 1));
+  NODE_API_CALL(env, napi_create_threadsafe_function(env, argv[0], NULL, name,
+      0, 1, p, Finalize, NULL, CallJs, &p->ts_fn));
+  NODE_API_CALL(env, node_api_set_threadsafe_function_batch(env, p->ts_fn,
+      max_batch_size, max_batch_latency, CallJsBatch));
+  NODE_API_ASSERT(env,
+      uv_thread_create(&p->thread, ProduceItems, p) == 0,
+      "Failed to create the thread");
+  return NULL;
+}
+
+static napi_value TestInvalidArguments(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value js_cb, name;
+  napi_threadsafe_function ts_fn;
+  napi_status status;
+  NODE_API_CALL(env, napi_get_cb_info(env, info, &argc, &js_cb, NULL, NULL));
+  NODE_API_CALL(env, napi_create_string_utf8(env, "batch", NAPI_AUTO_LENGTH,
+                                             &name));
+  NODE_API_CALL(env, napi_create_threadsafe_function(env, js_cb, NULL, name,
+      0, 1, NULL, NULL, NULL, NULL, &ts_fn));
+
+  status = node_api_set_threadsafe_function_batch(env, ts_fn, 0, 0,
+                                                  CallJsBatch);
+  NODE_API_ASSERT(env, status == napi_invalid_arg,
+      "A max_batch_size of 0 is rejected");
+  status = node_api_set_threadsafe_function_batch(env, ts_fn, 1, 0, NULL);
+  NODE_API_ASSERT(env, status == napi_invalid_arg,
+      "A missing callback is rejected");
+
+  NODE_API_CALL(env,
+      napi_release_threadsafe_function(ts_fn, napi_tsfn_release));
+  return NULL;
+}
+
+static napi_value Init(napi_env env, napi_value exports) {
+  napi_property_descriptor properties[] = {
+    DECLARE_NODE_API_PROPERTY("produce", Produce),
+    DECLARE_NODE_API_PROPERTY("testInvalidArguments", TestInvalidArguments),
+  };
+
+  NODE_API_CALL(env, napi_define_properties(env, exports,
+      sizeof(properties) / sizeof(properties[0]), properties));
+
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init)
@@ -0,0 +1,43 @@
+'use strict';
+
+const common = require('../../common');
+const assert = require('assert');
+const binding = require(`./build/${common.buildType}/binding`);
+
+binding.testInvalidArguments(common.mustNotCall());
+
+function produce(count, maxBatchSize, maxBatchLatency) {
+  return new Promise((resolve) => {
+    const batches = [];
+    let received = 0;
+    binding.produce((batch) => {
+      batches.push(batch);
+      received += batch.length;
+      if (received === count)
+        resolve(batches);
+    }, count, maxBatchSize, maxBatchLatency);
+  });
+}
+
+function checkBatches(batches, count, maxBatchSize) {
+  const items = [];
+  for (const batch of batches) {
+    assert(batch.length > 0);
+    assert(batch.length <= maxBatchSize);
+    items.push(...batch);
+  }
+  assert.deepStrictEqual(items, Array.from({ length: count }, (_, i) => i));
+}
+
+(async () => {
+  // The items are delivered in order, in batches of at most maxBatchSize.
+  checkBatches(await produce(1000, 16, 0), 1000, 16);
+  checkBatches(await produce(1000, 1, 0), 1000, 1);
+  checkBatches(await produce(1000, 50, 5), 1000, 50);
+
+  // With a latency that is longer than the test, the items are only
+  // delivered once the thread releases the function, all at once.
+  const batches = await produce(100, 1000, 1e6);
+  assert.strictEqual(batches.length, 1);
+  checkBatches(batches, 100, 1000);
+})().then(common.mustCall());
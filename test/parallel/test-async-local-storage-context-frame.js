@@ -0,0 +1,122 @@
+// Flags: --experimental-async-context-frame --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { AsyncLocalStorage, AsyncResource, createHook } = require('async_hooks');
+const {
+  getHookArrays,
+  initHooksExist,
+} = require('internal/async_hooks');
+
+// With --experimental-async-context-frame, the stores propagate through
+// timers, immediates, ticks, microtasks, promises and AsyncWraps without
+// enabling any async_hooks.
+
+const als = new AsyncLocalStorage();
+const other = new AsyncLocalStorage();
+
+als.run('timeout', common.mustCall(() => {
+  setTimeout(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'timeout');
+  }), 1);
+}));
+
+als.run('immediate', common.mustCall(() => {
+  setImmediate(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'immediate');
+  }));
+}));
+
+als.run('tick', common.mustCall(() => {
+  process.nextTick(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'tick');
+  }));
+  queueMicrotask(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'tick');
+  }));
+}));
+
+als.run('fs', common.mustCall(() => {
+  fs.stat(__filename, common.mustSucceed(() => {
+    assert.strictEqual(als.getStore(), 'fs');
+  }));
+}));
+
+als.run('promise', common.mustCall(async () => {
+  await Promise.resolve();
+  assert.strictEqual(als.getStore(), 'promise');
+  await new Promise((resolve) => setTimeout(resolve, 1));
+  assert.strictEqual(als.getStore(), 'promise');
+}));
+
+als.run('then', common.mustCall(() => {
+  Promise.resolve().then(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'then');
+  }));
+}));
+
+// The stores of different instances are independent, and nested runs restore
+// the outer store.
+als.run('outer', common.mustCall(() => {
+  other.run('other', common.mustCall(() => {
+    als.run('inner', common.mustCall(() => {
+      assert.strictEqual(als.getStore(), 'inner');
+      assert.strictEqual(other.getStore(), 'other');
+      setImmediate(common.mustCall(() => {
+        assert.strictEqual(als.getStore(), 'inner');
+        assert.strictEqual(other.getStore(), 'other');
+      }));
+    }));
+    assert.strictEqual(als.getStore(), 'outer');
+  }));
+  assert.strictEqual(other.getStore(), undefined);
+}));
+
+// exit() runs the callback, and everything that it schedules, without the
+// store.
+als.run('exit', common.mustCall(() => {
+  als.exit(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), undefined);
+    setImmediate(common.mustCall(() => {
+      assert.strictEqual(als.getStore(), undefined);
+    }));
+  }));
+  assert.strictEqual(als.getStore(), 'exit');
+}));
+
+// AsyncResource captures the store when it is created.
+const resource = als.run('resource', () => new AsyncResource('test'));
+resource.runInAsyncScope(common.mustCall(() => {
+  assert.strictEqual(als.getStore(), 'resource');
+}));
+assert.strictEqual(als.getStore(), undefined);
+
+// enterWith() sets the store for the rest of the callback.
+setImmediate(common.mustCall(() => {
+  als.enterWith('entered');
+  assert.strictEqual(als.getStore(), 'entered');
+  setImmediate(common.mustCall(() => {
+    assert.strictEqual(als.getStore(), 'entered');
+  }));
+}));
+setImmediate(common.mustCall(() => {
+  assert.strictEqual(als.getStore(), undefined);
+}));
+
+// None of this has enabled any hooks.
+assert.strictEqual(initHooksExist(), false);
+assert.strictEqual(getHookArrays()[0].length, 0);
+
+// The PromiseHook keeps propagating the stores while async_hooks uses one,
+// and after it stops using it.
+setTimeout(common.mustCall(() => {
+  const hook = createHook({ init() {} }).enable();
+  als.run('hook', common.mustCall(async () => {
+    await Promise.resolve();
+    assert.strictEqual(als.getStore(), 'hook');
+    hook.disable();
+    await Promise.resolve();
+    assert.strictEqual(als.getStore(), 'hook');
+  }));
+}), 10);
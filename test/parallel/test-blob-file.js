@@ -0,0 +1,70 @@
+'use strict';
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { Blob } = require('buffer');
+
+tmpdir.refresh();
+const file = path.join(tmpdir.path, 'blob.txt');
+const contents = Buffer.alloc(200 * 1024, 'abcdefghijklmnopqrstuvwxyz');
+fs.writeFileSync(file, contents);
+
+async function readStream(stream) {
+  const chunks = [];
+  for await (const chunk of stream)
+    chunks.push(chunk);
+  return chunks;
+}
+
+(async () => {
+  const blob = await fs.openAsBlob(file, { type: 'Text/Plain' });
+  assert(blob instanceof Blob);
+  assert.strictEqual(blob.size, contents.length);
+  assert.strictEqual(blob.type, 'text/plain');
+  assert.deepStrictEqual(Buffer.from(await blob.arrayBuffer()), contents);
+  assert.strictEqual(await blob.slice(26, 29).text(), 'abc');
+  assert.strictEqual(await blob.slice(-3).text(),
+                     contents.subarray(-3).toString());
+
+  // The parts of a file can be mixed with the ones in memory.
+  const mixed = new Blob(['<', blob.slice(1, 4), '>']);
+  assert.strictEqual(mixed.size, 5);
+  assert.strictEqual(await mixed.text(), '<bcd>');
+  assert.strictEqual(await mixed.slice(2, 4).text(), 'cd');
+
+  // The stream reads the contents in chunks.
+  const chunks = await readStream(blob.stream());
+  assert(chunks.length > 1);
+  assert(chunks.every((chunk) => chunk.length <= 64 * 1024));
+  assert.deepStrictEqual(Buffer.concat(chunks), contents);
+  assert.deepStrictEqual(
+    Buffer.concat(await readStream(mixed.stream())), Buffer.from('<bcd>'));
+  assert.deepStrictEqual(await readStream(new Blob([]).stream()), []);
+
+  // Empty files give empty blobs.
+  const empty = path.join(tmpdir.path, 'empty.txt');
+  fs.writeFileSync(empty, '');
+  assert.strictEqual((await fs.openAsBlob(empty)).size, 0);
+  assert.strictEqual(await (await fs.openAsBlob(empty)).text(), '');
+
+  // The blob cannot be read once the file is modified.
+  fs.writeFileSync(file, 'modified');
+  await assert.rejects(blob.arrayBuffer(), { name: 'NotReadableError' });
+  await assert.rejects(readStream(blob.stream()), {
+    name: 'NotReadableError'
+  });
+  fs.unlinkSync(file);
+  await assert.rejects(mixed.text(), { name: 'NotReadableError' });
+
+  await assert.rejects(fs.openAsBlob(file), { code: 'ENOENT' });
+  await assert.rejects(fs.openAsBlob(tmpdir.path), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+})().then(common.mustCall());
+
+assert.throws(() => fs.openAsBlob(1), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => fs.openAsBlob(file, null), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
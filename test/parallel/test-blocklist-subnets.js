@@ -0,0 +1,67 @@
+'use strict';
+
+require('../common');
+
+const { BlockList } = require('net');
+const assert = require('assert');
+
+{
+  const blockList = new BlockList();
+  const subnets = [];
+  for (let n = 0; n < 10000; n++)
+    subnets.push(`10.${n >> 8}.${n & 0xff}.0/24`);
+  blockList.addSubnets(subnets);
+  blockList.addSubnets(['8592:757c:efae:4e45::/64', '::1'], 'ipv6');
+
+  assert.strictEqual(blockList.rules.length, 10002);
+  assert.strictEqual(blockList.rules[10001], 'Subnet: IPv4 10.0.0.0/24');
+  assert.strictEqual(blockList.rules[0], 'Subnet: IPv6 ::1/128');
+
+  assert(blockList.check('10.0.0.1'));
+  assert(blockList.check('10.39.15.255'));
+  assert(!blockList.check('10.39.16.0'));
+  assert(blockList.check('::ffff:10.20.30.40', 'ipv6'));
+  assert(blockList.check('8592:757c:efae:4e45::f', 'ipv6'));
+  assert(blockList.check('::1', 'ipv6'));
+  assert(!blockList.check('::2', 'ipv6'));
+
+  // The rules that overlap each other are all applied.
+  blockList.addSubnet('172.16.0.0', 12);
+  blockList.addRange('172.16.0.5', '172.40.0.0');
+  blockList.addAddress('172.16.0.1');
+  assert(blockList.check('172.31.255.255'));
+  assert(blockList.check('172.39.1.1'));
+  assert(blockList.check('172.40.0.0'));
+  assert(!blockList.check('172.40.0.1'));
+}
+
+{
+  // None of the subnets is added when one of them is invalid.
+  const blockList = new BlockList();
+  assert.throws(() => blockList.addSubnets(['1.1.1.0/24', '1.1.1.1/33']), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+  assert.throws(() => blockList.addSubnets(['1.1.1.0/24', '1.1.1.1/']), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+  assert.throws(() => blockList.addSubnets(['1.1.1.0/24', 'nope/8']), {
+    code: 'ERR_INVALID_ARG_VALUE',
+    message: "The argument 'subnets[1]' must be an ipv4 subnet. " +
+             "Received 'nope/8'"
+  });
+  assert.throws(() => blockList.addSubnets(['::/64']), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+  assert.deepStrictEqual(blockList.rules, []);
+  assert(!blockList.check('1.1.1.1'));
+
+  assert.throws(() => blockList.addSubnets('1.1.1.0/24'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => blockList.addSubnets([1]), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => blockList.addSubnets([], 'foo'), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+}
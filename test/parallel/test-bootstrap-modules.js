@@ -9,6 +9,7 @@ const assert = require('assert');
 
 const expectedModules = new Set([
   'Internal Binding errors',
+  'Internal Binding async_context_frame',
   'Internal Binding async_wrap',
   'Internal Binding buffer',
   'Internal Binding config',
@@ -17,14 +18,12 @@ const expectedModules = new Set([
   'Internal Binding credentials',
   'Internal Binding fs',
   'Internal Binding fs_dir',
-  'Internal Binding fs_event_wrap',
   'Internal Binding heap_utils',
   'Internal Binding messaging',
   'Internal Binding module_wrap',
   'Internal Binding native_module',
   'Internal Binding options',
   'Internal Binding process_methods',
-  'Internal Binding report',
   'Internal Binding serdes',
   'Internal Binding stream_wrap',
   'Internal Binding string_decoder',
@@ -43,6 +42,7 @@ const expectedModules = new Set([
   'NativeModule fs',
   'NativeModule internal/abort_controller',
   'NativeModule internal/assert',
+  'NativeModule internal/async_context_frame',
   'NativeModule internal/async_hooks',
   'NativeModule internal/bootstrap/pre_execution',
   'NativeModule internal/buffer',
@@ -55,9 +55,6 @@ const expectedModules = new Set([
   'NativeModule internal/fixed_queue',
   'NativeModule internal/fs/dir',
   'NativeModule internal/fs/utils',
-  'NativeModule internal/fs/promises',
-  'NativeModule internal/fs/rimraf',
-  'NativeModule internal/fs/watchers',
   'NativeModule internal/heap_utils',
   'NativeModule internal/idna',
   'NativeModule internal/linkedlist',
@@ -80,7 +77,6 @@ const expectedModules = new Set([
   'NativeModule internal/process/execution',
   'NativeModule internal/process/per_thread',
   'NativeModule internal/process/promises',
-  'NativeModule internal/process/report',
   'NativeModule internal/process/signal',
   'NativeModule internal/process/task_queues',
   'NativeModule internal/process/warning',
@@ -105,8 +101,8 @@ const expectedModules = new Set([
   'NativeModule internal/util',
   'NativeModule internal/util/debuglog',
   'NativeModule internal/util/inspect',
-  'NativeModule internal/util/iterable_weak_map',
   'NativeModule internal/util/types',
+  'NativeModule internal/v8/startup_snapshot',
   'NativeModule internal/validators',
   'NativeModule internal/vm/module',
   'NativeModule internal/worker/io',
@@ -142,7 +138,10 @@ if (!common.isMainThread) {
     'NativeModule internal/streams/pipeline',
     'NativeModule internal/streams/state',
     'NativeModule internal/worker',
+    'NativeModule internal/worker/immutable_buffer',
     'NativeModule internal/worker/io',
+    'NativeModule internal/worker/pool',
+    'NativeModule internal/worker/ring_channel',
     'NativeModule stream',
     'NativeModule worker_threads',
   ].forEach(expectedModules.add.bind(expectedModules));
@@ -156,7 +155,6 @@ if (common.hasIntl) {
 
 if (process.features.inspector) {
   expectedModules.add('Internal Binding inspector');
-  expectedModules.add('NativeModule internal/inspector_async_hook');
   expectedModules.add('NativeModule internal/util/inspector');
   expectedModules.add('Internal Binding profiler');
 }
@@ -46,3 +46,21 @@ const assert = require('assert');
   const badHex = `${hex.slice(0, 256)}xx${hex.slice(256, 510)}`;
   assert.deepStrictEqual(Buffer.from(badHex, 'hex'), buf.slice(0, 128));
 }
+
+// Long inputs are decoded in blocks. Decoding still ends right before the
+// first invalid pair, wherever it is.
+{
+  const buf = Buffer.alloc(100);
+  for (let i = 0; i < buf.length; i++)
+    buf[i] = (i * 37) & 0xff;
+
+  const hex = buf.toString('hex');
+  assert.deepStrictEqual(Buffer.from(hex.toUpperCase(), 'hex'), buf);
+  for (let i = 0; i < hex.length; i++) {
+    for (const bad of ['g', 'G', '/', ':', '@', '`', ' ', 'Ā']) {
+      const badHex = `${hex.slice(0, i)}${bad}${hex.slice(i + 1)}`;
+      assert.deepStrictEqual(Buffer.from(badHex, 'hex'),
+                             buf.slice(0, i >> 1));
+    }
+  }
+}
@@ -45,3 +45,21 @@ assert.throws(() => Buffer.alloc(1).compare('abc'), {
   message: 'The "target" argument must be an instance of ' +
            "Buffer or Uint8Array. Received type string ('abc')"
 });
+
+// Short and long Buffers are compared the same way.
+for (let length = 0; length <= 20; length++) {
+  const a = Buffer.alloc(length, 0x61);
+  for (let i = 0; i < length; i++) {
+    const b = Buffer.from(a);
+    b[i] = 0x62;
+    assert.strictEqual(Buffer.compare(a, b), -1);
+    assert.strictEqual(Buffer.compare(b, a), 1);
+    assert.strictEqual(a.compare(b), -1);
+    assert.strictEqual(a.equals(b), false);
+  }
+  const longer = Buffer.alloc(length + 1, 0x61);
+  assert.strictEqual(Buffer.compare(a, longer), -1);
+  assert.strictEqual(Buffer.compare(longer, a), 1);
+  assert.strictEqual(Buffer.compare(a, new Uint8Array(a)), 0);
+  assert.strictEqual(a.equals(new Uint8Array(a)), true);
+}
@@ -98,3 +98,42 @@ assert.deepStrictEqual(
 assert.deepStrictEqual(Buffer.concat([new Uint8Array([0x41, 0x42]),
                                       new Uint8Array([0x43, 0x44])]),
                        Buffer.from('ABCD'));
+
+// Results that do not come from the pool are put together natively. Large
+// ones are copied in parallel.
+{
+  const pieces = [];
+  let total = 0;
+  for (let i = 0; total < 6 * 1024 * 1024; i++) {
+    const piece = Buffer.alloc((i * 7919) % 100000, i & 0xff);
+    pieces.push(i % 3 === 0 ? new Uint8Array(piece.buffer, piece.byteOffset,
+                                             piece.length) : piece);
+    total += piece.length;
+  }
+  const result = Buffer.concat(pieces);
+  assert.strictEqual(result.length, total);
+  let pos = 0;
+  for (const piece of pieces) {
+    assert.deepStrictEqual(result.subarray(pos, pos + piece.length),
+                           Buffer.from(piece));
+    pos += piece.length;
+  }
+
+  assert.deepStrictEqual(Buffer.concat(pieces, total - 12345),
+                         result.subarray(0, total - 12345));
+  const longer = Buffer.concat(pieces, total + 12345);
+  assert.deepStrictEqual(longer.subarray(0, total), result);
+  assert.deepStrictEqual(longer.subarray(total), Buffer.alloc(12345));
+}
+
+assert.deepStrictEqual(Buffer.concat([random10.subarray(2)], 8192),
+                       Buffer.concat([random10.subarray(2),
+                                      Buffer.alloc(8192 - 8)]));
+
+assert.throws(() => {
+  Buffer.concat([Buffer.alloc(8192), 'hello']);
+}, {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: 'The "list[1]" argument must be an instance of Buffer ' +
+           "or Uint8Array. Received type string ('hello')"
+});
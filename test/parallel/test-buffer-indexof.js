@@ -621,3 +621,26 @@ assert.strictEqual(reallyLong.lastIndexOf(pattern), 0);
              'Received an instance of lastIndexOf'
   });
 }
+
+// Short needles in long buffers, at every position relative to the blocks
+// that are compared at once, and with a first byte that is common or rare.
+{
+  const haystack = Buffer.alloc(1000, '\r\n');
+  for (const length of [2, 3, 4, 16, 17, 32, 33]) {
+    for (const fill of ['\r', 'x']) {
+      const needle = Buffer.alloc(length, fill);
+      needle[length - 1] = 0x2d;
+      for (let pos = 0; pos + length <= haystack.length; pos += 7) {
+        const buf = Buffer.from(haystack);
+        needle.copy(buf, pos);
+        assert.strictEqual(buf.indexOf(needle), pos);
+        assert.strictEqual(buf.lastIndexOf(needle), pos);
+        assert.strictEqual(buf.indexOf(needle, pos + 1), -1);
+        if (pos > 0)
+          assert.strictEqual(buf.lastIndexOf(needle, pos - 1), -1);
+        assert.strictEqual(buf.indexOf(needle.toString('latin1'), 'latin1'),
+                           pos);
+      }
+    }
+  }
+}
@@ -0,0 +1,53 @@
+'use strict';
+const common = require('../common');
+
+const assert = require('assert');
+const dgram = require('dgram');
+const { MessageChannel } = require('worker_threads');
+
+// Small UDP payloads are slices of a shared pool, like the Buffers that
+// Buffer.from() returns. Make sure that the slices don't overlap and that the
+// pool can't be transferred.
+
+const kMessages = 100;
+
+const socket = dgram.createSocket('udp4');
+const received = [];
+
+socket.on('message', common.mustCall((msg) => {
+  received.push(msg);
+  if (received.length < kMessages)
+    return;
+  socket.close();
+
+  let pair;
+  received.sort((a, b) => a.toString().localeCompare(b.toString()));
+  received.forEach((msg, i) => {
+    assert.strictEqual(msg.toString(), `message ${String(i).padStart(3, '0')}`);
+    assert.strictEqual(msg.byteOffset % 8, 0);
+  });
+  for (let i = 1; i < received.length && pair === undefined; i++) {
+    for (let j = 0; j < i; j++) {
+      if (received[i].buffer !== received[j].buffer)
+        continue;
+      const [a, b] = received[i].byteOffset < received[j].byteOffset ?
+        [received[i], received[j]] : [received[j], received[i]];
+      assert(b.byteOffset >= a.byteOffset + a.length);
+      pair = [a, b];
+      break;
+    }
+  }
+  assert(pair);
+
+  const [a, b] = pair;
+  const { port1 } = new MessageChannel();
+  port1.postMessage(a, [ a.buffer ]);
+  assert.strictEqual(a.buffer, b.buffer);
+  assert.strictEqual(a.length, 11);
+}, kMessages));
+
+socket.bind(0, common.mustCall(() => {
+  const { port } = socket.address();
+  for (let i = 0; i < kMessages; i++)
+    socket.send(`message ${String(i).padStart(3, '0')}`, port, '127.0.0.1');
+}));
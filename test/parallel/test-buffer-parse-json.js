@@ -0,0 +1,52 @@
+'use strict';
+
+// buffer.parseJSON() parses UTF-8 encoded JSON text like JSON.parse() parses
+// the decoded string.
+
+require('../common');
+const assert = require('assert');
+const { parseJSON } = require('buffer');
+
+const value = {
+  number: 1.5,
+  string: 'a\nbé€😀',
+  array: [true, false, null, -1e300],
+  nested: { empty: {}, list: [] },
+};
+
+{
+  const text = JSON.stringify(value);
+  assert.deepStrictEqual(parseJSON(Buffer.from(text)), value);
+  assert.deepStrictEqual(parseJSON(new TextEncoder().encode(text)), value);
+  const buf = Buffer.from(` ${text} `);
+  assert.deepStrictEqual(
+    parseJSON(new DataView(buf.buffer, buf.byteOffset + 1, buf.length - 2)),
+    value);
+}
+
+{
+  // Large ASCII input, which is parsed without a copy, and large input with
+  // other characters, which is decoded first.
+  for (const string of ['abc', 'abé']) {
+    const large = new Array(1e5).fill({ string, value });
+    const buf = Buffer.from(JSON.stringify(large));
+    assert(buf.length > 2 * 1024 * 1024);
+    const result = parseJSON(buf);
+    // Nothing in the result refers to the memory of the Buffer.
+    buf.fill(0);
+    assert.deepStrictEqual(result, large);
+  }
+}
+
+// Invalid UTF-8 is replaced.
+assert.strictEqual(parseJSON(Buffer.from([0x22, 0xff, 0x22])), '�');
+
+for (const text of ['', '{', '[1,]', '{"a":1}x']) {
+  assert.throws(() => parseJSON(Buffer.from(text)), SyntaxError);
+}
+assert.throws(() => parseJSON(Buffer.alloc(4 * 1024 * 1024, 'x')),
+              SyntaxError);
+
+for (const source of ['{}', {}, new ArrayBuffer(2), null]) {
+  assert.throws(() => parseJSON(source), { code: 'ERR_INVALID_ARG_TYPE' });
+}
@@ -0,0 +1,106 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// Reference encoder.
+function encode(values) {
+  const bytes = [];
+  for (let value of values) {
+    value = BigInt(value);
+    while (value >= 0x80n) {
+      bytes.push(Number(value & 0x7fn) | 0x80);
+      value >>= 7n;
+    }
+    bytes.push(Number(value));
+  }
+  return Buffer.from(bytes);
+}
+
+{
+  const values = [0, 1, 127, 128, 255, 300, 16383, 16384, 2 ** 31, 2 ** 32 - 1];
+  const expected = encode(values);
+
+  const buf = Buffer.alloc(expected.length + 3);
+  assert.strictEqual(buf.writeVarints(new Uint32Array(values), 3), buf.length);
+  assert.deepStrictEqual(buf.subarray(3), expected);
+
+  const target = new Uint32Array(values.length);
+  assert.strictEqual(buf.readVarints(target, 3), buf.length);
+  assert.deepStrictEqual(Array.from(target), values);
+
+  // Only as many values as the target has room for are read.
+  const first = new Uint32Array(2);
+  assert.strictEqual(expected.readVarints(first), 2);
+  assert.deepStrictEqual(Array.from(first), [0, 1]);
+}
+
+{
+  const values = [0n, 127n, 128n, 2n ** 35n, 2n ** 56n - 1n, 2n ** 56n,
+                  2n ** 63n, 2n ** 64n - 1n];
+  const expected = encode(values);
+
+  const buf = Buffer.alloc(expected.length);
+  assert.strictEqual(buf.writeVarints(new BigUint64Array(values)),
+                     expected.length);
+  assert.deepStrictEqual(buf, expected);
+
+  const target = new BigUint64Array(values.length);
+  assert.strictEqual(buf.readVarints(target), buf.length);
+  assert.deepStrictEqual(Array.from(target), values);
+}
+
+// Values that span the end of the Buffer at every possible position.
+for (let i = 1; i < 10; i++) {
+  const values = new BigUint64Array([2n ** BigInt(7 * i) - 1n, 2n ** 63n]);
+  const buf = encode(values);
+  for (let end = 0; end < buf.length; end++) {
+    assert.throws(() => buf.subarray(0, end).readVarints(values), {
+      code: 'ERR_BUFFER_OUT_OF_BOUNDS'
+    });
+    assert.throws(() => Buffer.alloc(end).writeVarints(values), {
+      code: 'ERR_BUFFER_OUT_OF_BOUNDS'
+    });
+  }
+}
+
+{
+  const tooLong = Buffer.from([0xff, 0xff, 0xff, 0xff, 0xff,
+                               0xff, 0xff, 0xff, 0xff, 0x02]);
+  assert.throws(() => tooLong.readVarints(new BigUint64Array(1)), {
+    code: 'ERR_OUT_OF_RANGE',
+    message: 'The varint at offset 0 is longer than 64 bits'
+  });
+
+  const tooBig = encode([1, 2 ** 32]);
+  assert.throws(() => tooBig.readVarints(new Uint32Array(2)), {
+    code: 'ERR_OUT_OF_RANGE',
+    message: 'The varint at offset 1 does not fit into 32 bits'
+  });
+}
+
+{
+  const buf = Buffer.alloc(4);
+  assert.strictEqual(buf.readVarints(new Uint32Array(0), 4), 4);
+  assert.strictEqual(buf.writeVarints(new Uint32Array(0), 4), 4);
+
+  for (const value of [[], new Uint8Array(4), new Int32Array(1)]) {
+    assert.throws(() => buf.readVarints(value), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+    assert.throws(() => buf.writeVarints(value), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+  }
+
+  for (const offset of [-1, 5, 1.5]) {
+    assert.throws(() => buf.readVarints(new Uint32Array(1), offset), {
+      code: 'ERR_OUT_OF_RANGE'
+    });
+    assert.throws(() => buf.writeVarints(new Uint32Array(1), offset), {
+      code: 'ERR_OUT_OF_RANGE'
+    });
+  }
+  assert.throws(() => buf.readVarints(new Uint32Array(1), '0'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
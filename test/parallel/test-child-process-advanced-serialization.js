@@ -12,7 +12,7 @@ if (process.argv[2] !== 'child') {
     }, {
       code: 'ERR_INVALID_ARG_VALUE',
       message: "The property 'options.serialization' " +
-        "must be one of: undefined, 'json', 'advanced'. " +
+        "must be one of: undefined, 'json', 'advanced', 'binary'. " +
         `Received ${inspect(value)}`
     });
   }
@@ -0,0 +1,99 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const child_process = require('child_process');
+const net = require('net');
+const { once } = require('events');
+
+if (process.argv[2] === 'child') {
+  process.on('message', (message, handle) => {
+    if (handle) {
+      handle.end('from the child');
+      return;
+    }
+    process.send(message);
+  });
+  return;
+}
+
+async function roundTrip(cp, message) {
+  cp.send(message);
+  const [received] = await once(cp, 'message');
+  return received;
+}
+
+(async () => {
+  const cp = child_process.fork(__filename, ['child'], {
+    serialization: 'binary'
+  });
+
+  // The views arrive as Buffers with the same bytes, whatever their size.
+  for (const size of [1, 100, 64 * 1024 - 5, 64 * 1024, 4 * 1024 * 1024]) {
+    const buffer = Buffer.alloc(size);
+    for (let i = 0; i < size; i += 997)
+      buffer[i] = i & 0xff;
+    buffer[size - 1] = 0x42;
+    const received = await roundTrip(cp, buffer);
+    assert(Buffer.isBuffer(received));
+    assert(received.equals(buffer));
+  }
+  const float64 = new Float64Array([Math.PI, Math.E]);
+  // The received Buffer may not be 8-byte aligned, so copy it into a
+  // buffer of its own before laying a Float64Array over it.
+  const received = await roundTrip(cp, float64);
+  assert.deepStrictEqual(
+    new Float64Array(new Uint8Array(received).buffer), float64);
+  assert.deepStrictEqual(
+    await roundTrip(cp, new DataView(float64.buffer, 8, 8)),
+    Buffer.from(float64.buffer, 8, 8));
+  assert.deepStrictEqual(await roundTrip(cp, new Uint8Array(0)),
+                         Buffer.alloc(0));
+
+  // Everything else is sent as JSON.
+  for (const message of [{ a: 1, b: [2, 'three'] }, 'string', 42, null]) {
+    assert.deepStrictEqual(await roundTrip(cp, message), message);
+  }
+
+  // Many messages that are sent at once are split apart again.
+  const messages = [];
+  for (let i = 0; i < 100; i++)
+    messages.push(i % 2 ? Buffer.from(`message ${i}`) : { i });
+  for (const message of messages)
+    cp.send(message);
+  for (const message of messages) {
+    const [received] = await once(cp, 'message');
+    assert.deepStrictEqual(received, message);
+  }
+
+  // Handles are still passed along with the messages.
+  const server = net.createServer(common.mustCall((socket) => {
+    cp.send('socket', socket);
+  }));
+  server.listen(0);
+  await once(server, 'listening');
+  const client = net.connect(server.address().port);
+  let data = '';
+  client.setEncoding('utf8');
+  client.on('data', (chunk) => data += chunk);
+  await once(client, 'end');
+  assert.strictEqual(data, 'from the child');
+  server.close();
+
+  cp.disconnect();
+  await once(cp, 'exit');
+})().then(common.mustCall());
+
+(async () => {
+  // Large messages are split natively in the advanced mode as well.
+  const cp = child_process.fork(__filename, ['child'], {
+    serialization: 'advanced'
+  });
+  const message = { buffer: Buffer.alloc(1024 * 1024, 'x'), map: new Map() };
+  cp.send(message);
+  cp.send(message);
+  for (let i = 0; i < 2; i++) {
+    const [received] = await once(cp, 'message');
+    assert.deepStrictEqual(received, message);
+  }
+  cp.disconnect();
+})().then(common.mustCall());
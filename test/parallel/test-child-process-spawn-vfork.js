@@ -0,0 +1,52 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { spawn, spawnSync } = require('child_process');
+const fixtures = require('../common/fixtures');
+
+const script = 'process.stdout.write(process.cwd() + " " + process.env.VFORK)';
+const options = {
+  cwd: fixtures.path(),
+  env: { ...process.env, VFORK: 'vfork' },
+  vfork: true,
+};
+const expected = `${fixtures.path()} vfork`;
+
+{
+  const child = spawn(process.execPath, ['-e', script], options);
+  let stdout = '';
+  child.stdout.setEncoding('utf8');
+  child.stdout.on('data', (data) => stdout += data);
+  child.on('close', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    assert.strictEqual(stdout, expected);
+  }));
+}
+
+{
+  const { status, stdout } = spawnSync(process.execPath, ['-e', script],
+                                       options);
+  assert.strictEqual(status, 0);
+  assert.strictEqual(stdout.toString(), expected);
+}
+
+{
+  // The file is looked up in the PATH, and the errors of the exec are
+  // reported like they are without the option.
+  const { status } = spawnSync('node', ['-e', ''], {
+    env: { PATH: require('path').dirname(process.execPath) },
+    vfork: true,
+  });
+  assert.strictEqual(status, 0);
+
+  const { error } = spawnSync('does-not-exist', { vfork: true });
+  assert.strictEqual(error.code, 'ENOENT');
+  const child = spawn('does-not-exist', { vfork: true });
+  child.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+  }));
+}
+
+assert.throws(() => spawn(process.execPath, { vfork: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
@@ -0,0 +1,27 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+// The output is collected in a single buffer that grows as it is written to,
+// whatever the size of the writes.
+const size = 5 * 1024 * 1024 + 17;
+const script = `
+  const chunk = Buffer.alloc(${size}, 'abcdefghijklmnopqrstuvwxyz');
+  for (let i = 0; i < chunk.length; i += 7777)
+    require('fs').writeSync(1, chunk, i, Math.min(7777, chunk.length - i));
+  process.stderr.write('done');
+`;
+
+const { status, stdout, stderr } = spawnSync(process.execPath, ['-e', script],
+                                             { maxBuffer: Infinity });
+assert.strictEqual(status, 0);
+assert.strictEqual(stdout.length, size);
+assert(stdout.equals(Buffer.alloc(size, 'abcdefghijklmnopqrstuvwxyz')));
+assert.strictEqual(stderr.toString(), 'done');
+
+// The buffers are writable, and empty outputs are empty buffers.
+stdout[0] = 0;
+assert.strictEqual(stdout[0], 0);
+const empty = spawnSync(process.execPath, ['-e', '']);
+assert.deepStrictEqual(empty.stdout, Buffer.alloc(0));
@@ -0,0 +1,62 @@
+'use strict';
+
+// Connections that arrive while the workers are still handling earlier ones
+// are all handed out, and spread over the workers.
+
+const common = require('../common');
+const assert = require('assert');
+const cluster = require('cluster');
+const net = require('net');
+
+cluster.schedulingPolicy = cluster.SCHED_RR;
+
+const kWorkers = 2;
+const kConnections = 40;
+
+if (cluster.isPrimary) {
+  const counts = [];
+  let listening = 0;
+  let port;
+
+  for (let i = 0; i < kWorkers; i++) {
+    const worker = cluster.fork();
+    worker.on('message', common.mustCall((msg) => {
+      counts.push(msg);
+      if (counts.length === kWorkers) {
+        assert.strictEqual(counts.reduce((a, b) => a + b), kConnections);
+        for (const count of counts)
+          assert.ok(count > 0, `${counts}`);
+        for (const id in cluster.workers)
+          cluster.workers[id].disconnect();
+      }
+    }));
+    worker.on('listening', common.mustCall((address) => {
+      port = address.port;
+      if (++listening === kWorkers)
+        connect();
+    }));
+  }
+
+  function connect() {
+    let closed = 0;
+    for (let i = 0; i < kConnections; i++) {
+      net.connect(port).on('data', common.mustCall()).on('close', () => {
+        if (++closed === kConnections) {
+          for (const id in cluster.workers)
+            cluster.workers[id].send('report');
+        }
+      });
+    }
+  }
+} else {
+  let count = 0;
+  const server = net.createServer((socket) => {
+    count++;
+    socket.end('ok');
+  });
+  server.listen(0);
+  process.on('message', common.mustCall((msg) => {
+    assert.strictEqual(msg, 'report');
+    process.send(count);
+  }));
+}
@@ -0,0 +1,85 @@
+'use strict';
+
+// Tests that --code-cache-dir caches the code compiled for CommonJS and ES
+// modules, and only uses it for the source that it was created for.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+const cacheDir = path.join(tmpdir.path, 'cache');
+const cjs = path.join(tmpdir.path, 'entry.js');
+const esm = path.join(tmpdir.path, 'dep.mjs');
+
+function run() {
+  const child = spawnSync(process.execPath, [
+    '--code-cache-dir', cacheDir, cjs,
+  ], {
+    cwd: tmpdir.path,
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+  });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return {
+    stdout: child.stdout.toString(),
+    stderr: child.stderr.toString(),
+  };
+}
+
+function cacheFiles() {
+  const [version] = fs.readdirSync(cacheDir);
+  return fs.readdirSync(path.join(cacheDir, version))
+    .map((file) => path.join(cacheDir, version, file));
+}
+
+fs.writeFileSync(cjs, `
+  import('./dep.mjs').then(({ value }) => console.log(value, 'cjs 1'));
+`);
+fs.writeFileSync(esm, 'export const value = "esm 1";');
+
+// The first run writes the cache.
+{
+  const { stdout, stderr } = run();
+  assert.strictEqual(stdout, 'esm 1 cjs 1\n');
+  assert.strictEqual((stderr.match(/Wrote \d+ bytes/g) || []).length, 2);
+  assert.doesNotMatch(stderr, /Read \d+ bytes/);
+  const files = cacheFiles();
+  assert.strictEqual(files.length, 2);
+  // No temporary files are left behind.
+  assert(files.every((file) => !file.endsWith('.tmp')));
+}
+
+// The second run reads it for both modules.
+{
+  const { stdout, stderr } = run();
+  assert.strictEqual(stdout, 'esm 1 cjs 1\n');
+  assert.match(stderr, /Read \d+ bytes of code cache for .*entry\.js/);
+  assert.match(stderr, /Read \d+ bytes of code cache for file:.*dep\.mjs/);
+  assert.doesNotMatch(stderr, /Wrote/);
+}
+
+// A changed source does not use the old cache, and replaces it.
+{
+  fs.writeFileSync(esm, 'export const value = "esm 2";');
+  const { stdout, stderr } = run();
+  assert.strictEqual(stdout, 'esm 2 cjs 1\n');
+  assert.match(stderr, /dep\.mjs in .*: source changed/);
+  assert.strictEqual((stderr.match(/Wrote/g) || []).length, 1);
+  assert.strictEqual(cacheFiles().length, 2);
+}
+
+// Corrupted entries are ignored.
+{
+  for (const file of cacheFiles()) {
+    const data = fs.readFileSync(file);
+    data[data.length - 1] ^= 0xff;
+    fs.writeFileSync(file, data);
+  }
+  const { stdout, stderr } = run();
+  assert.strictEqual(stdout, 'esm 2 cjs 1\n');
+  assert.strictEqual((stderr.match(/corrupted cache/g) || []).length, 2);
+  assert.strictEqual((stderr.match(/Wrote/g) || []).length, 2);
+}
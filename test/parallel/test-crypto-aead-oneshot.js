@@ -0,0 +1,124 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// crypto.aeadSeal() and crypto.aeadOpen() are compatible with Cipheriv and
+// Decipheriv and write into the given output buffer.
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const plaintext = Buffer.from('Hello, authenticated encryption!');
+const aad = Buffer.from('header');
+
+const ciphers = [
+  ['aes-128-gcm', 16, 12, 16],
+  ['aes-256-gcm', 32, 12, 12],
+  ['aes-256-gcm', 32, 16, 4],
+  ['aes-128-ccm', 16, 12, 16],
+  ['aes-192-ccm', 24, 7, 8],
+  ['chacha20-poly1305', 32, 12, 16],
+];
+if (crypto.getCiphers().includes('aes-128-ocb'))
+  ciphers.push(['aes-128-ocb', 16, 12, 16]);
+
+for (const [algorithm, keyLength, ivLength, authTagLength] of ciphers) {
+  const key = crypto.randomBytes(keyLength);
+  const iv = crypto.randomBytes(ivLength);
+  const options = { authTagLength };
+
+  const cipher = crypto.createCipheriv(algorithm, key, iv, options);
+  cipher.setAAD(aad, { plaintextLength: plaintext.length });
+  const expected = Buffer.concat([
+    cipher.update(plaintext), cipher.final(), cipher.getAuthTag(),
+  ]);
+
+  const sealed = Buffer.alloc(expected.length + 2, 0xaa);
+  assert.strictEqual(
+    crypto.aeadSeal(algorithm, key, iv, aad, plaintext, sealed, options),
+    expected.length);
+  assert.deepStrictEqual(sealed.subarray(0, expected.length), expected);
+  assert.strictEqual(sealed.readUInt16BE(expected.length), 0xaaaa);
+
+  const opened = Buffer.alloc(plaintext.length);
+  assert.strictEqual(
+    crypto.aeadOpen(algorithm, key, iv, aad, expected, opened, options),
+    plaintext.length);
+  assert.deepStrictEqual(opened, plaintext);
+
+  // Encryption and decryption work in place and with KeyObjects.
+  const secret = crypto.createSecretKey(key);
+  const data = Buffer.alloc(expected.length);
+  plaintext.copy(data);
+  crypto.aeadSeal(algorithm, secret, iv, aad,
+                  data.subarray(0, plaintext.length), data, options);
+  assert.deepStrictEqual(data, expected);
+  crypto.aeadOpen(algorithm, secret, iv, aad, data, data, options);
+  assert.deepStrictEqual(data.subarray(0, plaintext.length), plaintext);
+
+  // No plaintext is written if the data cannot be authenticated.
+  const tampered = Buffer.from(expected);
+  tampered[0] ^= 1;
+  const output = Buffer.alloc(plaintext.length, 0xaa);
+  assert.throws(() => {
+    crypto.aeadOpen(algorithm, key, iv, aad, tampered, output, options);
+  }, {
+    message: 'Unsupported state or unable to authenticate data',
+  });
+  assert(output.every((byte) => byte === 0 || byte === 0xaa));
+  assert.throws(() => {
+    crypto.aeadOpen(algorithm, key, iv, Buffer.from('other'), expected,
+                    output, options);
+  }, {
+    message: 'Unsupported state or unable to authenticate data',
+  });
+}
+
+{
+  // Messages without AAD and without plaintext.
+  const key = crypto.randomBytes(16);
+  const iv = crypto.randomBytes(12);
+  const tag = Buffer.alloc(16);
+  assert.strictEqual(
+    crypto.aeadSeal('aes-128-gcm', key, iv, null, Buffer.alloc(0), tag), 16);
+  assert.strictEqual(
+    crypto.aeadOpen('aes-128-gcm', key, iv, undefined, tag, Buffer.alloc(0)),
+    0);
+}
+
+{
+  const key = crypto.randomBytes(16);
+  const iv = crypto.randomBytes(12);
+
+  assert.throws(() => {
+    crypto.aeadSeal('aes-128-gcm', key, iv, aad, plaintext,
+                    Buffer.alloc(plaintext.length + 15));
+  }, { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => {
+    crypto.aeadSeal('aes-128-gcm', key, iv, aad, plaintext,
+                    new ArrayBuffer(64));
+  }, { code: 'ERR_INVALID_ARG_TYPE' });
+  assert.throws(() => {
+    crypto.aeadOpen('aes-128-gcm', key, iv, aad, Buffer.alloc(8),
+                    Buffer.alloc(8));
+  }, { code: 'ERR_CRYPTO_INVALID_AUTH_TAG' });
+  assert.throws(() => {
+    crypto.aeadSeal('aes-128-gcm', key, iv, aad, plaintext, Buffer.alloc(64),
+                    { authTagLength: 5 });
+  }, {
+    code: 'ERR_CRYPTO_INVALID_AUTH_TAG',
+    message: 'Invalid authentication tag length: 5',
+  });
+  assert.throws(() => {
+    crypto.aeadSeal('aes-128-gcm', Buffer.alloc(17), iv, aad, plaintext,
+                    Buffer.alloc(64));
+  }, { code: 'ERR_CRYPTO_INVALID_KEYLEN' });
+  assert.throws(() => {
+    crypto.aeadSeal('aes-128-cbc', key, iv, aad, plaintext, Buffer.alloc(64));
+  }, { code: 'ERR_CRYPTO_UNSUPPORTED_OPERATION' });
+  assert.throws(() => {
+    crypto.aeadSeal('foo', key, iv, aad, plaintext, Buffer.alloc(64));
+  }, { code: 'ERR_CRYPTO_UNKNOWN_CIPHER' });
+}
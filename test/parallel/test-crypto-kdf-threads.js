@@ -0,0 +1,86 @@
+// Flags: --crypto-kdf-threads=2
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With --crypto-kdf-threads, pbkdf2 and scrypt jobs run on threads of their
+// own, which are shared with Worker threads.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const { spawnSync } = require('child_process');
+const { Worker } = require('worker_threads');
+
+assert.deepStrictEqual(crypto.getKeyDerivationQueueStats(), {
+  threads: 2,
+  pending: 0,
+  running: 0,
+  completed: 0,
+});
+
+const jobs = 8;
+for (let i = 0; i < jobs; i++) {
+  crypto.pbkdf2('password', `salt${i}`, 10000, 32, 'sha256',
+                common.mustSucceed((key) => {
+                  assert.deepStrictEqual(
+                    key,
+                    crypto.pbkdf2Sync('password', `salt${i}`, 10000, 32,
+                                      'sha256'));
+                }));
+}
+crypto.scrypt('password', 'salt', 64, common.mustSucceed((key) => {
+  assert.deepStrictEqual(key, crypto.scryptSync('password', 'salt', 64));
+}));
+
+{
+  const { threads, pending, running, completed } =
+    crypto.getKeyDerivationQueueStats();
+  assert.strictEqual(threads, 2);
+  assert.strictEqual(pending + running + completed, jobs + 1);
+  assert(running <= 2);
+}
+
+const worker = new Worker(`
+  const crypto = require('crypto');
+  const { parentPort } = require('worker_threads');
+  crypto.scrypt('password', 'salt', 16, (err, key) => {
+    parentPort.postMessage(key.toString('hex'));
+  });
+`, { eval: true });
+worker.on('message', common.mustCall((hex) => {
+  assert.strictEqual(hex,
+                     crypto.scryptSync('password', 'salt', 16).toString('hex'));
+}));
+
+process.on('exit', () => {
+  assert.deepStrictEqual(crypto.getKeyDerivationQueueStats(), {
+    threads: 2,
+    pending: 0,
+    running: 0,
+    completed: jobs + 2,
+  });
+});
+
+{
+  const child = spawnSync(process.execPath, [
+    '--crypto-kdf-threads=0',
+    '-p', 'JSON.stringify(require("crypto").getKeyDerivationQueueStats())',
+  ]);
+  assert.strictEqual(child.status, 0);
+  assert.deepStrictEqual(JSON.parse(child.stdout), {
+    threads: 0,
+    pending: 0,
+    running: 0,
+    completed: 0,
+  });
+}
+
+{
+  const child = spawnSync(process.execPath, ['--crypto-kdf-threads=-1',
+                                             '-e', '']);
+  assert.strictEqual(child.status, 9);
+  assert.match(child.stderr.toString(),
+               /--crypto-kdf-threads must be between 0 and 1024/);
+}
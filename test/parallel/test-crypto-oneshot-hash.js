@@ -0,0 +1,40 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// crypto.hash() returns the same digest as createHash().update().digest().
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const inputs = [
+  '',
+  'some data',
+  'ü'.repeat(1000),
+  Buffer.alloc(65536, 'b'),
+  new Uint16Array([1, 2, 3]),
+  new DataView(new ArrayBuffer(16)),
+];
+
+for (const algorithm of ['sha1', 'sha256', 'sha512', 'md5', 'RSA-SHA256']) {
+  for (const data of inputs) {
+    const expected = crypto.createHash(algorithm).update(data);
+    assert.strictEqual(crypto.hash(algorithm, data),
+                       expected.copy().digest('hex'));
+    assert.strictEqual(crypto.hash(algorithm, data, 'base64'),
+                       expected.copy().digest('base64'));
+    assert.deepStrictEqual(crypto.hash(algorithm, data, 'buffer'),
+                           expected.digest());
+  }
+}
+
+assert.throws(() => crypto.hash('sha1024', 'data'), {
+  message: /Digest method not supported/,
+});
+assert.throws(() => crypto.hash(1, 'data'), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.hash('sha1', 1), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => crypto.hash('sha1', 'data', null), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
@@ -0,0 +1,55 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+const { MessageChannel } = require('worker_threads');
+
+// Crypto results are never slices of a Buffer pool, which could expose other
+// secrets through their .buffer. Each of them owns its ArrayBuffer and can be
+// transferred.
+
+function check(name, buf) {
+  assert(Buffer.isBuffer(buf), name);
+  assert.notStrictEqual(buf.length, 0, name);
+  assert.strictEqual(buf.byteOffset, 0, name);
+  assert.strictEqual(buf.buffer.byteLength, buf.length, name);
+  const { port1 } = new MessageChannel();
+  port1.postMessage(buf, [ buf.buffer ]);
+  assert.strictEqual(buf.length, 0, name);
+  port1.close();
+}
+
+check('hash', crypto.createHash('sha256').update('data').digest());
+check('hmac', crypto.createHmac('sha256', 'key').update('data').digest());
+
+{
+  const key = crypto.randomBytes(32);
+  const iv = crypto.randomBytes(16);
+  const cipher = crypto.createCipheriv('aes-256-cbc', key, iv);
+  check('cipher update', cipher.update(Buffer.alloc(32)));
+  check('cipher final', cipher.final());
+}
+
+{
+  const key = fixtures.readKey('rsa_private.pem');
+  check('sign', crypto.sign('sha256', Buffer.from('data'), key));
+  check('Sign', crypto.createSign('sha256').update('data').sign(key));
+}
+
+{
+  const alice = crypto.createECDH('prime256v1');
+  const bob = crypto.createECDH('prime256v1');
+  check('ECDH public key', alice.generateKeys());
+  check('ECDH secret', alice.computeSecret(bob.generateKeys()));
+}
+
+{
+  const alice = crypto.getDiffieHellman('modp5');
+  const bob = crypto.getDiffieHellman('modp5');
+  alice.generateKeys();
+  check('DH secret', alice.computeSecret(bob.generateKeys()));
+}
@@ -0,0 +1,49 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Small synchronous requests are served from a pool of random bytes that is
+// refilled in the threadpool. No bytes must be served twice, and requests
+// must only write to the requested range.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const { setImmediate } = require('timers/promises');
+
+const seen = new Set();
+function check(size) {
+  const buf = Buffer.alloc(size + 4, 0xaa);
+  crypto.randomFillSync(buf, 2, size);
+  assert.strictEqual(buf.readUInt16BE(0), 0xaaaa);
+  assert.strictEqual(buf.readUInt16BE(size + 2), 0xaaaa);
+  const hex = buf.toString('hex', 2, size + 2);
+  assert(!seen.has(hex), `${hex} was served twice`);
+  seen.add(hex);
+}
+
+(async () => {
+  // Uses up the pool several times, with and without letting the event loop
+  // run the completion of the refills.
+  for (let round = 0; round < 8; round++) {
+    for (let i = 0; i < 1024; i++)
+      check(16 + (i % 8) * 31);
+    await setImmediate();
+  }
+
+  // Larger requests are not served from the pool.
+  check(257);
+  check(4096);
+
+  const bytes = crypto.randomBytes(32);
+  assert.strictEqual(bytes.length, 32);
+  assert.notDeepStrictEqual(bytes, crypto.randomBytes(32));
+
+  const view = new Uint32Array(8);
+  crypto.randomFillSync(view, 2, 4);
+  assert.strictEqual(view[0], 0);
+  assert.strictEqual(view[1], 0);
+  assert.strictEqual(view[6], 0);
+  assert.strictEqual(view[7], 0);
+})().then(common.mustCall());
@@ -0,0 +1,80 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Operations with the same KeyObject and different options do not affect each
+// other, even though their key contexts are cached on the key.
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const { privateKey, publicKey } =
+  crypto.generateKeyPairSync('rsa', { modulusLength: 1024 });
+const data = Buffer.from('some data');
+const pss = { padding: crypto.constants.RSA_PKCS1_PSS_PADDING };
+const { RSA_PSS_SALTLEN_DIGEST } = crypto.constants;
+
+for (let i = 0; i < 3; i++) {
+  // PKCS#1 v1.5 signatures are deterministic, PSS signatures are not.
+  const pkcs1 = crypto.sign('sha256', data, privateKey);
+  assert.deepStrictEqual(crypto.sign('sha256', data, privateKey), pkcs1);
+  assert.notDeepStrictEqual(
+    crypto.sign('sha256', data, { key: privateKey, ...pss }), pkcs1);
+
+  assert(crypto.verify('sha256', data, publicKey, pkcs1));
+  assert(!crypto.verify('sha256', data, { key: publicKey, ...pss }, pkcs1));
+  assert(!crypto.verify('sha512', data, publicKey, pkcs1));
+  assert(crypto.verify(null, data, publicKey, pkcs1));
+
+  const salted = crypto.sign('sha256', data, {
+    key: privateKey, saltLength: RSA_PSS_SALTLEN_DIGEST, ...pss
+  });
+  assert(crypto.verify('sha256', data, {
+    key: publicKey, saltLength: RSA_PSS_SALTLEN_DIGEST, ...pss
+  }, salted));
+  assert(!crypto.verify('sha256', data, {
+    key: publicKey, saltLength: 0, ...pss
+  }, salted));
+
+  const signer = crypto.createSign('sha384').update(data);
+  const streamed = signer.sign(privateKey);
+  assert(crypto.createVerify('sha384').update(data)
+    .verify(publicKey, streamed));
+  assert(crypto.verify('sha384', data, publicKey, streamed));
+
+  for (const [padding, oaepHash] of [
+    [crypto.constants.RSA_PKCS1_OAEP_PADDING, 'sha1'],
+    [crypto.constants.RSA_PKCS1_OAEP_PADDING, 'sha256'],
+    [crypto.constants.RSA_PKCS1_PADDING, undefined],
+  ]) {
+    const encrypted =
+      crypto.publicEncrypt({ key: publicKey, padding, oaepHash }, data);
+    assert.deepStrictEqual(
+      crypto.privateDecrypt({ key: privateKey, padding, oaepHash }, encrypted),
+      data);
+    const oaepLabel = Buffer.from('label');
+    if (oaepHash !== undefined) {
+      const labelled = crypto.publicEncrypt(
+        { key: publicKey, padding, oaepHash, oaepLabel }, data);
+      assert.throws(() => crypto.privateDecrypt(
+        { key: privateKey, padding, oaepHash }, labelled), /Error/);
+      assert.deepStrictEqual(crypto.privateDecrypt(
+        { key: privateKey, padding, oaepHash, oaepLabel }, labelled), data);
+    }
+  }
+}
+
+for (let i = 0; i < 3; i++) {
+  // Copies of a cached context keep the salt length.
+  const salted = crypto.sign('sha256', data, {
+    key: privateKey, saltLength: 16, ...pss
+  });
+  assert(crypto.verify('sha256', data, {
+    key: publicKey, saltLength: 16, ...pss
+  }, salted));
+  assert(!crypto.verify('sha256', data, {
+    key: publicKey, saltLength: 20, ...pss
+  }, salted));
+}
@@ -0,0 +1,97 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// crypto.verifyBatch() agrees with crypto.verify() for each item.
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+function makeItems(algorithm, privateKey) {
+  const items = [];
+  for (let i = 0; i < 8; i++) {
+    const data = Buffer.from(`message ${i}`);
+    let signature = crypto.sign(algorithm, data, privateKey);
+    if (i % 3 === 1) {
+      // Corrupt some of the signatures.
+      signature = Buffer.from(signature);
+      signature[signature.length - 1] ^= 1;
+    }
+    items.push({ data, signature });
+  }
+  return items;
+}
+
+function expected(algorithm, key, items) {
+  return Uint8Array.from(items, ({ data, signature }) => {
+    return crypto.verify(algorithm, data, key, signature) ? 1 : 0;
+  });
+}
+
+const cases = [
+  ['rsa', { modulusLength: 1024 }, 'sha256'],
+  ['rsa', { modulusLength: 1024 }, null],
+  ['ec', { namedCurve: 'P-256' }, 'sha384'],
+  ['ed25519', {}, null],
+];
+
+for (const [type, options, algorithm] of cases) {
+  const { privateKey, publicKey } = crypto.generateKeyPairSync(type, options);
+  const items = makeItems(algorithm, privateKey);
+  const results = expected(algorithm, publicKey, items);
+  assert.strictEqual(results.filter((r) => r === 0).length, 3);
+
+  assert.deepStrictEqual(crypto.verifyBatch(publicKey, algorithm, items),
+                         results);
+  // Private keys can be used to verify as well.
+  assert.deepStrictEqual(crypto.verifyBatch(privateKey, algorithm, items),
+                         results);
+  crypto.verifyBatch(publicKey, algorithm, items, common.mustSucceed((r) => {
+    assert.deepStrictEqual(r, results);
+  }));
+
+  assert.deepStrictEqual(crypto.verifyBatch(publicKey, algorithm, []),
+                         new Uint8Array(0));
+}
+
+{
+  // RSA-PSS and IEEE-P1363 options are taken from the key.
+  const { privateKey, publicKey } =
+    crypto.generateKeyPairSync('rsa', { modulusLength: 1024 });
+  const key = {
+    key: publicKey,
+    padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+    saltLength: 16,
+  };
+  const items = makeItems('sha256', { ...key, key: privateKey });
+  assert.deepStrictEqual(crypto.verifyBatch(key, 'sha256', items),
+                         expected('sha256', key, items));
+}
+
+{
+  const { privateKey, publicKey } =
+    crypto.generateKeyPairSync('ec', { namedCurve: 'P-256' });
+  const items = makeItems('sha256', { key: privateKey,
+                                      dsaEncoding: 'ieee-p1363' });
+  const key = { key: publicKey, dsaEncoding: 'ieee-p1363' };
+  assert.deepStrictEqual(crypto.verifyBatch(key, 'sha256', items),
+                         expected('sha256', key, items));
+}
+
+{
+  const { publicKey } =
+    crypto.generateKeyPairSync('ec', { namedCurve: 'P-256' });
+  assert.throws(() => crypto.verifyBatch(publicKey, 'sha256', {}), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.verifyBatch(publicKey, 'sha256', [
+    { data: Buffer.alloc(1), signature: 'abc' },
+  ]), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => crypto.verifyBatch(publicKey, 'nope', []), {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+  });
+}
@@ -0,0 +1,52 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+assert.throws(() => dgram.createSocket({ type: 'udp4', recvBatchSize: 0 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => dgram.createSocket({ type: 'udp4', recvBatchSize: '8' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+// Datagrams that are read with a single recvmmsg() call are emitted as
+// slices of one ArrayBuffer. Their contents and sizes must be unaffected.
+const count = 10;
+const messages = [];
+for (let i = 0; i < count; i++)
+  messages.push(Buffer.alloc(100 + i, i));
+
+const receiver = dgram.createSocket({ type: 'udp4', recvBatchSize: 8 });
+const sender = dgram.createSocket('udp4');
+
+const received = [];
+receiver.on('message', common.mustCall((msg, rinfo) => {
+  assert.strictEqual(rinfo.size, msg.length);
+  assert.strictEqual(rinfo.port, sender.address().port);
+  received.push(msg);
+  if (received.length < count)
+    return;
+
+  received.sort((a, b) => a.length - b.length);
+  assert.deepStrictEqual(received, messages);
+  if (common.isLinux) {
+    // All datagrams were queued before the receiver got to read them.
+    assert.strictEqual(received[0].buffer, received[1].buffer);
+    assert.notStrictEqual(received[0].byteOffset, received[1].byteOffset);
+  }
+  receiver.close();
+  sender.close();
+}, count));
+
+receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+  const { port } = receiver.address();
+  sender.bind(0, common.localhostIPv4, common.mustCall(() => {
+    sender.sendBatch(messages.map((msg) => ({
+      msg, port, address: common.localhostIPv4,
+    })), common.mustSucceed((sent) => {
+      assert.strictEqual(sent, count);
+    }));
+  }));
+}));
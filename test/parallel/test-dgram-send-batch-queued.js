@@ -0,0 +1,33 @@
+// Flags: --test-udp-no-try-send
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// Datagrams that cannot be sent right away are queued and reported with a
+// single completion for the whole batch.
+
+const server = dgram.createSocket('udp4');
+const client = dgram.createSocket('udp4');
+const count = 64;
+
+server.on('message', common.mustCall(() => {
+  if (--remaining === 0) {
+    server.close();
+    client.close();
+  }
+}, count));
+let remaining = count;
+
+server.bind(0, common.localhostIPv4, common.mustCall(() => {
+  client.connect(server.address().port, common.localhostIPv4,
+                 common.mustCall(() => {
+                   const messages = [];
+                   for (let i = 0; i < count; i++)
+                     messages.push({ msg: Buffer.alloc(32, i) });
+                   client.sendBatch(messages, common.mustSucceed((sent) => {
+                     assert.strictEqual(sent, count);
+                   }));
+                 }));
+}));
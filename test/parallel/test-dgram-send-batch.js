@@ -0,0 +1,68 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// Batches started in the same tick are sent together, and each caller is
+// told how many of its own datagrams went out.
+
+const server = dgram.createSocket('udp4');
+const client = dgram.createSocket('udp4');
+
+const first = [];
+const second = [];
+for (let i = 0; i < 100; i++)
+  first.push(Buffer.from(`first ${i}`));
+for (let i = 0; i < 50; i++)
+  second.push(`second ${i}`);
+
+const received = new Set();
+server.on('message', common.mustCall((msg) => {
+  received.add(msg.toString());
+  if (received.size < first.length + second.length)
+    return;
+  for (const msg of first)
+    assert(received.has(msg.toString()));
+  for (const msg of second)
+    assert(received.has(msg));
+  server.close();
+  client.close();
+}, first.length + second.length));
+
+server.bind(0, common.localhostIPv4, common.mustCall(() => {
+  const { port } = server.address();
+  const address = common.localhostIPv4;
+
+  const batch = (list) => list.map((msg) => ({ msg, port, address }));
+  client.sendBatch(batch(first), common.mustSucceed((sent) => {
+    assert.strictEqual(sent, first.length);
+  }));
+  client.sendBatch(batch(second), common.mustSucceed((sent) => {
+    assert.strictEqual(sent, second.length);
+  }));
+}));
+
+{
+  const socket = dgram.createSocket('udp4');
+
+  assert.throws(() => socket.sendBatch('foo'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => socket.sendBatch([{ msg: 'x', port: 0 }]), {
+    code: 'ERR_SOCKET_BAD_PORT',
+  });
+  assert.throws(() => socket.sendBatch([{ msg: 42, port: 1 }]), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  assert.throws(() => {
+    socket.sendBatch([{ msg: 'x', port: 1, address: 'localhost' }]);
+  }, {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  assert.throws(() => socket.sendBatch([], 'not a function'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+
+  socket.close();
+}
@@ -0,0 +1,53 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+if (!common.isLinux) {
+  assert.throws(() => dgram.createSocket({ type: 'udp4', udpGro: true }), {
+    code: 'ERR_FEATURE_UNAVAILABLE_ON_PLATFORM',
+  });
+  common.skip('UDP_SEGMENT and UDP_GRO are Linux-specific');
+}
+
+assert.throws(() => dgram.createSocket({ type: 'udp4', udpSegmentSize: 0 }), {
+  code: 'ERR_OUT_OF_RANGE',
+});
+assert.throws(() => dgram.createSocket({ type: 'udp4', udpGro: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+// The sender hands a single 1000 byte message to the kernel, which splits it
+// into ten datagrams. The receiver gets those coalesced again, and emits them
+// as ten separate messages.
+const segmentSize = 100;
+const payload = Buffer.alloc(10 * segmentSize);
+for (let i = 0; i < payload.length; i++)
+  payload[i] = Math.floor(i / segmentSize);
+
+const receiver = dgram.createSocket({ type: 'udp4', udpGro: true });
+const sender = dgram.createSocket({
+  type: 'udp4',
+  udpSegmentSize: segmentSize,
+});
+
+const received = [];
+receiver.on('message', common.mustCall((msg, rinfo) => {
+  assert.strictEqual(msg.length, segmentSize);
+  assert.strictEqual(rinfo.size, segmentSize);
+  assert.strictEqual(rinfo.port, sender.address().port);
+  received.push(msg);
+  if (received.length < 10)
+    return;
+  assert.deepStrictEqual(Buffer.concat(received), payload);
+  receiver.close();
+  sender.close();
+}, 10));
+
+receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+  sender.bind(0, common.localhostIPv4, common.mustCall(() => {
+    sender.send(payload, receiver.address().port, common.localhostIPv4,
+                common.mustSucceed());
+  }));
+}));
@@ -0,0 +1,76 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dc = require('diagnostics_channel');
+const fs = require('fs');
+const http = require('http');
+const net = require('net');
+
+// Native code publishes to the built-in channels while they have subscribers.
+
+const fsChannel = dc.channel('fs.request.complete');
+const results = [];
+function onFsRequest(message, name) {
+  assert.strictEqual(name, 'fs.request.complete');
+  results.push(message);
+}
+fsChannel.subscribe(onFsRequest);
+
+fs.stat(__filename, common.mustSucceed(() => {
+  const message = results.find((m) => m.syscall === 'stat');
+  assert.strictEqual(message.path, __filename);
+  assert.strictEqual(message.result, 0);
+
+  const missing = `${__filename}.missing`;
+  fs.open(missing, 'r', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    const message = results.find((m) => m.syscall === 'open');
+    assert.strictEqual(message.path, missing);
+    assert(message.result < 0);
+
+    // Nothing is published once the channel has no subscribers.
+    fsChannel.unsubscribe(onFsRequest);
+    results.length = 0;
+    fs.stat(__filename, common.mustSucceed(() => {
+      assert.deepStrictEqual(results, []);
+    }));
+  }));
+}));
+
+const headers = [];
+dc.channel('http.parser.headers.complete').subscribe((message) => {
+  headers.push(message);
+});
+const connects = [];
+dc.channel('net.tcp.connect').subscribe((message) => {
+  connects.push(message);
+});
+
+const server = http.createServer(common.mustCall((req, res) => {
+  res.end('ok');
+}));
+server.listen(0, common.mustCall(() => {
+  const req = http.get({
+    port: server.address().port,
+    path: '/path'
+  }, common.mustCall((res) => {
+    res.resume();
+    res.on('end', common.mustCall(() => {
+      server.close();
+
+      const request = headers.find((m) => m.method === 'GET');
+      assert.strictEqual(request.url, '/path');
+      assert.strictEqual(request.versionMajor, 1);
+      assert.strictEqual(request.versionMinor, 1);
+      assert.strictEqual(request.upgrade, false);
+      const response = headers.find((m) => m.statusCode === 200);
+      assert.strictEqual(response.method, undefined);
+      assert.strictEqual(typeof response.shouldKeepAlive, 'boolean');
+
+      assert.strictEqual(connects.length, 1);
+      assert.strictEqual(connects[0].status, 0);
+      assert.strictEqual(connects[0].socket, req.socket);
+      assert(connects[0].socket instanceof net.Socket);
+    }));
+  }));
+}));
@@ -0,0 +1,112 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { internalBinding } = require('internal/test/binding');
+const cares = internalBinding('cares_wrap');
+const { UV_EAI_NONAME, UV_ENOMEM } = internalBinding('uv');
+const { promisify } = require('util');
+
+const sleep = promisify(setTimeout);
+
+// Stub `getaddrinfo` to count the lookups that reach it.
+const lookups = [];
+let addresses = ['1.2.3.4', '::1'];
+cares.getaddrinfo = (req, hostname, family, hints, verbatim) => {
+  lookups.push(hostname);
+  if (hostname === 'enomem.org')
+    return UV_ENOMEM;
+  setImmediate(() => {
+    if (hostname === 'missing.org')
+      req.oncomplete(UV_EAI_NONAME, null);
+    else
+      req.oncomplete(0, addresses.slice());
+  });
+  return 0;
+};
+
+const dns = require('dns');
+const dnsPromises = dns.promises;
+
+function lookupAll(hostname) {
+  return new Promise((resolve, reject) => {
+    dns.lookup(hostname, { all: true }, (err, addresses) => {
+      if (err) reject(err);
+      else resolve(addresses);
+    });
+  });
+}
+
+(async function() {
+  // Nothing is cached by default.
+  await dnsPromises.lookup('example.org');
+  await dnsPromises.lookup('example.org');
+  assert.strictEqual(lookups.length, 2);
+  assert.deepStrictEqual(dns.getLookupCacheStatistics(),
+                         { hits: 0, staleHits: 0, misses: 0, entries: 0 });
+
+  dns.setLookupCache({ ttl: 1, staleTtl: 10 });
+  lookups.length = 0;
+
+  // The callback and promise APIs share the cache, whatever the case of the
+  // host name.
+  assert.deepStrictEqual(await dnsPromises.lookup('example.org'),
+                         { address: '1.2.3.4', family: 4 });
+  assert.deepStrictEqual(await lookupAll('EXAMPLE.org'), [
+    { address: '1.2.3.4', family: 4 },
+    { address: '::1', family: 6 },
+  ]);
+  assert.deepStrictEqual(await dnsPromises.lookup('example.org', { all: true }),
+                         [
+                           { address: '1.2.3.4', family: 4 },
+                           { address: '::1', family: 6 },
+                         ]);
+  assert.deepStrictEqual(lookups, ['example.org']);
+  assert.deepStrictEqual(dns.getLookupCacheStatistics(),
+                         { hits: 2, staleHits: 0, misses: 1, entries: 1 });
+
+  // The options are part of the key.
+  await dnsPromises.lookup('example.org', { family: 4 });
+  assert.strictEqual(lookups.length, 2);
+
+  // ENOTFOUND is cached too, the other errors are not.
+  for (let i = 0; i < 2; i++) {
+    await assert.rejects(dnsPromises.lookup('missing.org'),
+                         { code: 'ENOTFOUND' });
+    await assert.rejects(dnsPromises.lookup('enomem.org'), { code: 'ENOMEM' });
+  }
+  assert.deepStrictEqual(lookups.slice(2),
+                         ['missing.org', 'enomem.org', 'enomem.org']);
+
+  // The expired results are returned while they are looked up again.
+  addresses = ['5.6.7.8'];
+  await sleep(1100);
+  assert.deepStrictEqual(await dnsPromises.lookup('example.org'),
+                         { address: '1.2.3.4', family: 4 });
+  assert.strictEqual(dns.getLookupCacheStatistics().staleHits, 1);
+  await sleep(10);
+  assert.deepStrictEqual(await dnsPromises.lookup('example.org'),
+                         { address: '5.6.7.8', family: 4 });
+  assert.deepStrictEqual(lookups.slice(5), ['example.org']);
+
+  // The least recently used results are evicted.
+  dns.setLookupCache({ maxEntries: 1 });
+  await dnsPromises.lookup('a.org');
+  await dnsPromises.lookup('b.org');
+  await dnsPromises.lookup('a.org');
+  assert.deepStrictEqual(dns.getLookupCacheStatistics(),
+                         { hits: 0, staleHits: 0, misses: 3, entries: 1 });
+
+  dns.setLookupCache(false);
+  assert.deepStrictEqual(dns.getLookupCacheStatistics(),
+                         { hits: 0, staleHits: 0, misses: 0, entries: 0 });
+})().then(common.mustCall());
+
+for (const options of [undefined, null, 1]) {
+  assert.throws(() => dns.setLookupCache(options), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+assert.throws(() => dns.setLookupCache({ ttl: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
@@ -0,0 +1,78 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const assert = require('assert');
+const dgram = require('dgram');
+const dns = require('dns');
+const dnsPromises = dns.promises;
+
+const kNXDomainFlags = 0x8183;
+const records = {
+  A: { type: 'A', address: '1.2.3.4', ttl: 300 },
+  AAAA: { type: 'AAAA', address: '::42', ttl: 300 },
+};
+
+const questions = [];
+const server = dgram.createSocket('udp4');
+server.on('message', (msg, { address, port }) => {
+  const parsed = dnstools.parseDNSPacket(msg);
+  const { domain, type } = parsed.questions[0];
+  questions.push(`${type} ${domain}`);
+  const found = domain === 'example.org';
+  server.send(dnstools.writeDNSPacket({
+    id: parsed.id,
+    flags: found ? undefined : kNXDomainFlags,
+    questions: parsed.questions,
+    answers: found ? [{ domain, ...records[type] }] : [],
+  }), port, address);
+});
+
+server.bind(0, common.mustCall(async () => {
+  const resolver = new dnsPromises.Resolver();
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+
+  assert.deepStrictEqual(
+    await dnsPromises.lookup('example.org', { resolver, family: 4 }),
+    { address: '1.2.3.4', family: 4 });
+  assert.deepStrictEqual(questions, ['A example.org']);
+  assert.deepStrictEqual(
+    await dnsPromises.lookup('example.org', { resolver, family: 6 }),
+    { address: '::42', family: 6 });
+  assert.deepStrictEqual(
+    await dnsPromises.lookup('example.org', { resolver, all: true }),
+    [{ address: '1.2.3.4', family: 4 }, { address: '::42', family: 6 }]);
+
+  await assert.rejects(
+    dnsPromises.lookup('missing.org', { resolver, family: 4 }), {
+      code: 'ENOTFOUND',
+      syscall: 'getaddrinfo',
+      hostname: 'missing.org',
+    });
+
+  // The resolver can be set for the whole process, and the callback API.
+  const callbackResolver = new dns.Resolver();
+  callbackResolver.setServers(resolver.getServers());
+  dns.setLookupResolver(callbackResolver);
+  dns.lookup('example.org', 4, common.mustSucceed((address, family) => {
+    assert.strictEqual(address, '1.2.3.4');
+    assert.strictEqual(family, 4);
+
+    dns.lookup('missing.org', 4, common.mustCall((err) => {
+      assert.strictEqual(err.code, 'ENOTFOUND');
+      dns.setLookupResolver(null);
+      server.close();
+    }));
+  }));
+}));
+
+for (const resolver of [undefined, 1, {}, { _handle: {} }]) {
+  assert.throws(() => dns.setLookupResolver(resolver), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+assert.throws(() => dns.lookup('example.org', { resolver: {} }, () => {}), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => dnsPromises.lookup('example.org', { resolver: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
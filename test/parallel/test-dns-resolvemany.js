@@ -0,0 +1,98 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const assert = require('assert');
+const dgram = require('dgram');
+const dns = require('dns');
+const { Resolver } = dns.promises;
+
+const kNXDomainFlags = 0x8183;
+
+const records = new Map([
+  ['a.example.org', [{ type: 'A', address: '1.2.3.4', ttl: 300 },
+                     { type: 'A', address: '1.2.3.5', ttl: 300 }]],
+  ['b.example.org', [{ type: 'A', address: '1.2.3.6', ttl: 300 },
+                     { type: 'MX', exchange: 'mx.example.org',
+                       priority: 10, ttl: 300 }]],
+]);
+
+let queries = 0;
+const server = dgram.createSocket('udp4');
+server.on('message', (msg, { address, port }) => {
+  queries++;
+  const parsed = dnstools.parseDNSPacket(msg);
+  const domain = parsed.questions[0].domain;
+  const type = parsed.questions[0].type;
+  const answers = records.get(domain);
+  server.send(dnstools.writeDNSPacket(answers ? {
+    id: parsed.id,
+    questions: parsed.questions,
+    answers: answers.filter((answer) => answer.type === type)
+                    .map((answer) => ({ domain, ...answer })),
+  } : {
+    id: parsed.id,
+    flags: kNXDomainFlags,
+    questions: parsed.questions,
+  }), port, address);
+});
+
+server.bind(0, common.mustCall(async () => {
+  const resolver = new Resolver();
+  resolver.setServers([`127.0.0.1:${server.address().port}`]);
+  const names = ['a.example.org', 'b.example.org', 'c.example.org'];
+
+  // Every name is answered in the order of the list, with the records or the
+  // error that the single query would report.
+  const results = await resolver.resolveMany(names);
+  assert.strictEqual(queries, 3);
+  assert.deepStrictEqual(results.slice(0, 2), [
+    { name: 'a.example.org', records: ['1.2.3.4', '1.2.3.5'] },
+    { name: 'b.example.org', records: ['1.2.3.6'] },
+  ]);
+  assert.strictEqual(results[2].name, 'c.example.org');
+  assert.strictEqual(results[2].error.code, 'ENOTFOUND');
+  assert.strictEqual(results[2].error.syscall, 'queryA');
+  assert.strictEqual(results[2].error.hostname, 'c.example.org');
+
+  const [mx] = await resolver.resolveMany(['b.example.org'], 'MX');
+  assert.deepStrictEqual(mx, {
+    name: 'b.example.org',
+    records: [{ exchange: 'mx.example.org', priority: 10 }],
+  });
+
+  assert.deepStrictEqual(await resolver.resolveMany([]), []);
+
+  // The answers are cached per name.
+  const cached = new Resolver({ cache: true });
+  cached.setServers(resolver.getServers());
+  queries = 0;
+  await cached.resolveMany(['a.example.org', 'c.example.org']);
+  const [a, b] = await cached.resolveMany(['a.example.org', 'b.example.org']);
+  assert.strictEqual(queries, 3);
+  assert.deepStrictEqual(a.records, ['1.2.3.4', '1.2.3.5']);
+  assert.deepStrictEqual(b.records, ['1.2.3.6']);
+
+  // The callback API reports all of the results at once as well.
+  const callbackResolver = new dns.Resolver();
+  callbackResolver.setServers(resolver.getServers());
+  callbackResolver.resolveMany(names, common.mustSucceed((results) => {
+    assert.deepStrictEqual(results.map(({ name }) => name), names);
+    assert.deepStrictEqual(results[0].records, ['1.2.3.4', '1.2.3.5']);
+    assert.strictEqual(results[2].error.code, 'ENOTFOUND');
+    server.close();
+  }));
+}));
+
+assert.throws(() => dns.resolveMany('example.org', common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => dns.resolveMany([1], common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => dns.resolveMany([], 'ANY', common.mustNotCall()), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.throws(() => dns.resolveMany([]), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => dns.promises.resolveMany([], 1), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
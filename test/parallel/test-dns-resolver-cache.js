@@ -0,0 +1,132 @@
+'use strict';
+const common = require('../common');
+const dnstools = require('../common/dns');
+const assert = require('assert');
+const dgram = require('dgram');
+const { Resolver } = require('dns').promises;
+const { promisify } = require('util');
+
+const sleep = promisify(setTimeout);
+const kNXDomainFlags = 0x8183;
+
+const queries = new Map();
+const addresses = new Map([
+  ['example.org', { address: '1.2.3.4', ttl: 300 }],
+  ['zero.org', { address: '1.2.3.5', ttl: 0 }],
+  ['short.org', { address: '1.2.3.6', ttl: 1 }],
+]);
+
+const server = dgram.createSocket('udp4');
+server.on('message', (msg, { address, port }) => {
+  const parsed = dnstools.parseDNSPacket(msg);
+  const domain = parsed.questions[0].domain.toLowerCase();
+  queries.set(domain, (queries.get(domain) || 0) + 1);
+
+  const answer = addresses.get(domain);
+  server.send(dnstools.writeDNSPacket(answer ? {
+    id: parsed.id,
+    questions: parsed.questions,
+    answers: [{ domain, type: 'A', ...answer }],
+  } : {
+    id: parsed.id,
+    flags: kNXDomainFlags,
+    questions: parsed.questions,
+    authorityAnswers: [{
+      domain: 'org',
+      type: 'SOA',
+      ttl: 900,
+      nsname: 'ns1.example.org',
+      hostqueen: 'admin.example.org',
+      serial: 1,
+      refresh: 900,
+      retry: 900,
+      expire: 1800,
+      minttl: 60,
+    }],
+  }), port, address);
+});
+
+server.bind(0, common.mustCall(async () => {
+  const servers = [`127.0.0.1:${server.address().port}`];
+  const resolver = new Resolver({ cache: { staleTtl: 10 } });
+  resolver.setServers(servers);
+
+  // The answers are cached, whatever the case of the name, and their TTLs
+  // count down.
+  const [first] = await resolver.resolve4('example.org', { ttl: true });
+  assert.deepStrictEqual(first, { address: '1.2.3.4', ttl: 300 });
+  const [second] = await resolver.resolve4('EXAMPLE.org', { ttl: true });
+  assert.strictEqual(second.address, '1.2.3.4');
+  assert(second.ttl <= 300);
+  assert.strictEqual(queries.get('example.org'), 1);
+  assert.deepStrictEqual(resolver.getCacheStatistics(),
+                         { hits: 1, staleHits: 0, misses: 1, entries: 1 });
+
+  // The other types are cached separately. The server answers every
+  // question with an A record, which c-ares skips when it parses an AAAA
+  // reply, so resolve6() yields [] as it does without a cache.
+  assert.deepStrictEqual(await resolver.resolve6('example.org'), []);
+  assert.strictEqual(queries.get('example.org'), 2);
+  assert.deepStrictEqual(await resolver.resolve6('example.org'), []);
+  assert.strictEqual(queries.get('example.org'), 2);
+
+  // The answers with a TTL of zero are not cached.
+  await resolver.resolve4('zero.org');
+  await resolver.resolve4('zero.org');
+  assert.strictEqual(queries.get('zero.org'), 2);
+
+  // ENOTFOUND is cached too.
+  await assert.rejects(resolver.resolve4('missing.org'), { code: 'ENOTFOUND' });
+  await assert.rejects(resolver.resolve4('missing.org'), { code: 'ENOTFOUND' });
+  assert.strictEqual(queries.get('missing.org'), 1);
+
+  // The expired answers are served while they are refreshed.
+  await resolver.resolve4('short.org');
+  addresses.set('short.org', { address: '1.2.3.7', ttl: 300 });
+  await sleep(1100);
+  assert.deepStrictEqual(await resolver.resolve4('short.org', { ttl: true }),
+                         [{ address: '1.2.3.6', ttl: 0 }]);
+  assert.strictEqual(resolver.getCacheStatistics().staleHits, 1);
+  while ((await resolver.resolve4('short.org'))[0] !== '1.2.3.7')
+    await sleep(10);
+  assert.strictEqual(queries.get('short.org'), 2);
+
+  resolver.clearCache();
+  assert.strictEqual(resolver.getCacheStatistics().entries, 0);
+  await resolver.resolve4('example.org');
+  assert.strictEqual(queries.get('example.org'), 3);
+
+  // Changing the servers clears the cache.
+  resolver.setServers(servers);
+  assert.strictEqual(resolver.getCacheStatistics().entries, 0);
+
+  // The least recently used answers are evicted.
+  const small = new Resolver({ cache: { maxEntries: 1 } });
+  small.setServers(servers);
+  await small.resolve4('example.org');
+  await small.resolve4('short.org');
+  await small.resolve4('example.org');
+  assert.deepStrictEqual(small.getCacheStatistics(),
+                         { hits: 0, staleHits: 0, misses: 3, entries: 1 });
+
+  // Without the option, nothing is cached.
+  const uncached = new Resolver();
+  uncached.setServers(servers);
+  await uncached.resolve4('example.org');
+  await uncached.resolve4('example.org');
+  assert.strictEqual(queries.get('example.org'), 7);
+  assert.deepStrictEqual(uncached.getCacheStatistics(),
+                         { hits: 0, staleHits: 0, misses: 0, entries: 0 });
+
+  server.close();
+}));
+
+assert.throws(() => new Resolver({ cache: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => new Resolver({ cache: { maxEntries: 0 } }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new Resolver({ cache: { maxTtl: -1 } }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
@@ -0,0 +1,66 @@
+// Flags: --event-loop-busy-poll=200
+'use strict';
+
+// The event loop keeps working as usual when it busy polls, on the main thread
+// and in workers.
+
+const common = require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const net = require('net');
+const { Worker } = require('worker_threads');
+
+if (process.argv[2] === 'child') {
+  // The process exits once the loop has nothing to do anymore.
+  setTimeout(() => setImmediate(() => process.stdout.write('done')), 10);
+  return;
+}
+
+{
+  const child = spawnSync(process.execPath,
+                          ['--event-loop-busy-poll=1000', __filename, 'child']);
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(child.stdout.toString(), 'done');
+}
+
+{
+  const child = spawnSync(process.execPath,
+                          ['--event-loop-busy-poll=1000001', '-e', '']);
+  assert.strictEqual(child.status, 9);
+  assert.match(child.stderr.toString(),
+               /--event-loop-busy-poll must be at most 1000000/);
+}
+
+const server = net.createServer((socket) => socket.pipe(socket));
+server.listen(0, common.mustCall(() => {
+  let round = 0;
+  const client = net.connect(server.address().port, () => client.write('x'));
+  client.on('data', () => {
+    if (++round < 100) {
+      setTimeout(() => client.write('x'), 1);
+      return;
+    }
+    client.end();
+    server.close(common.mustCall());
+  });
+}));
+
+const worker = new Worker(`
+  const { parentPort } = require('worker_threads');
+  parentPort.once('message', (value) => {
+    setTimeout(() => parentPort.postMessage(value + 1), 10);
+  });
+`, { eval: true, execArgv: ['--event-loop-busy-poll=500'] });
+worker.on('message', common.mustCall((value) => {
+  assert.strictEqual(value, 2);
+}));
+worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+worker.postMessage(1);
+
+// Terminating a worker stops its loop while it is polling.
+const busy = new Worker('setInterval(() => {}, 1);', {
+  eval: true,
+  execArgv: ['--event-loop-busy-poll=1000'],
+});
+busy.on('online', common.mustCall(() => busy.terminate()));
+busy.on('exit', common.mustCall((code) => assert.strictEqual(code, 1)));
@@ -0,0 +1,66 @@
+'use strict';
+
+require('../common');
+
+// fs.mapFile() returns a Buffer backed by a private mapping of the file.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'mapped');
+const data = Buffer.alloc(3 * 65536 + 123);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+const fd = fs.openSync(file, 'r');
+
+{
+  const buffer = fs.mapFile(fd);
+  assert.ok(Buffer.isBuffer(buffer));
+  assert.deepStrictEqual(buffer, data);
+}
+
+// Offsets do not have to be aligned.
+for (const [offset, length] of [[5, 100], [65536, 65536], [65537, 1000]]) {
+  const buffer = fs.mapFile(fd, offset, length, { advice: 'random' });
+  assert.strictEqual(buffer.length, length);
+  assert.deepStrictEqual(buffer, data.subarray(offset, offset + length));
+}
+
+{
+  const buffer = fs.mapFile(fd, data.length - 10, undefined, {
+    populate: true,
+    advice: 'sequential',
+  });
+  assert.deepStrictEqual(buffer, data.subarray(data.length - 10));
+}
+
+assert.strictEqual(fs.mapFile(fd, data.length).length, 0);
+
+// Writes are not written back to the file, and the mapping outlives the fd.
+const mapped = fs.mapFile(fd, 0, 10, { advice: 'willneed' });
+fs.closeSync(fd);
+mapped.fill(0);
+assert.deepStrictEqual(mapped, Buffer.alloc(10));
+assert.deepStrictEqual(fs.readFileSync(file), data);
+
+{
+  const fd = fs.openSync(file, 'r');
+  assert.throws(() => fs.mapFile(fd, 0, data.length + 1), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => fs.mapFile(fd, -1), { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => fs.mapFile(fd, 0, 1, { advice: 'never' }), {
+    code: 'ERR_INVALID_ARG_VALUE',
+  });
+  assert.throws(() => fs.mapFile(fd, 0, 1, { populate: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  fs.closeSync(fd);
+}
+
+assert.throws(() => fs.mapFile('fd'), { code: 'ERR_INVALID_ARG_TYPE' });
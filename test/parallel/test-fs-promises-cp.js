@@ -0,0 +1,82 @@
+'use strict';
+
+const common = require('../common');
+
+// fs.promises.cp() copies a whole tree, and reports the entries it could not
+// copy once the others are copied.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { cp } = fs.promises;
+const { COPYFILE_EXCL } = fs.constants;
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const src = path.join(tmpdir.path, 'src');
+const files = [];
+for (const dir of ['', 'a', path.join('a', 'b'), 'c']) {
+  fs.mkdirSync(path.join(src, dir), { recursive: true });
+  for (let i = 0; i < 5; i++) {
+    const file = path.join(dir, `file-${i}`);
+    fs.writeFileSync(path.join(src, file), file);
+    files.push(file);
+  }
+}
+const canCreateSymLink = common.canCreateSymLink();
+if (canCreateSymLink)
+  fs.symlinkSync('file-0', path.join(src, 'link'));
+fs.mkdirSync(path.join(src, 'empty'));
+
+function checkTree(dest) {
+  for (const file of files)
+    assert.strictEqual(fs.readFileSync(path.join(dest, file), 'utf8'), file);
+  assert.deepStrictEqual(fs.readdirSync(path.join(dest, 'empty')), []);
+  if (canCreateSymLink)
+    assert.strictEqual(fs.readlinkSync(path.join(dest, 'link')), 'file-0');
+}
+
+(async () => {
+  for (const concurrency of [1, 3, 100]) {
+    const dest = path.join(tmpdir.path, `dest-${concurrency}`);
+    await cp(src, dest, { concurrency });
+    checkTree(dest);
+  }
+
+  // Copying again replaces the destinations, unless COPYFILE_EXCL is set.
+  const dest = path.join(tmpdir.path, 'dest-1');
+  fs.writeFileSync(path.join(dest, files[0]), 'changed');
+  await cp(src, dest);
+  checkTree(dest);
+
+  fs.unlinkSync(path.join(dest, files[1]));
+  await assert.rejects(cp(src, dest, { mode: COPYFILE_EXCL }), (err) => {
+    assert.strictEqual(err.name, 'AggregateError');
+    const expected = files.length - 1 + (canCreateSymLink ? 1 : 0);
+    assert.strictEqual(err.errors.length, expected);
+    for (const error of err.errors)
+      assert.strictEqual(error.code, 'EEXIST');
+    return true;
+  });
+  // The entries that could be copied are copied.
+  assert.strictEqual(fs.readFileSync(path.join(dest, files[1]), 'utf8'),
+                     files[1]);
+
+  // A file is copied like with copyFile().
+  const file = path.join(tmpdir.path, 'single');
+  await cp(path.join(src, files[2]), file);
+  assert.strictEqual(fs.readFileSync(file, 'utf8'), files[2]);
+
+  await assert.rejects(cp(path.join(tmpdir.path, 'missing'), file), {
+    code: 'ENOENT',
+  });
+  await assert.rejects(cp(src, dest, { concurrency: 0 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  await assert.rejects(cp(src, dest, { mode: -1 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  await assert.rejects(cp(src, dest, null), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+})().then(common.mustCall());
@@ -0,0 +1,73 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// filehandle.hash() digests the file from the current position to the end.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'hash.bin');
+// Larger than the chunks in which the file is read.
+const data = crypto.randomBytes(3 * 1024 * 1024 + 17);
+fs.writeFileSync(file, data);
+
+function digest(algorithm, buffer, options) {
+  return crypto.createHash(algorithm, options).update(buffer).digest();
+}
+
+(async () => {
+  for (const algorithm of ['sha1', 'sha256', 'sha512', 'md5']) {
+    const handle = await fs.promises.open(file, 'r');
+    const result = await handle.hash(algorithm);
+    assert(Buffer.isBuffer(result));
+    assert.deepStrictEqual(result, digest(algorithm, data));
+    // The whole file was read, so there is nothing left to hash.
+    assert.deepStrictEqual(await handle.hash(algorithm),
+                           digest(algorithm, Buffer.alloc(0)));
+    await handle.close();
+  }
+
+  // Reading starts at the current file position.
+  const partial = await fs.promises.open(file, 'r');
+  await partial.read(Buffer.alloc(100), 0, 100, null);
+  assert.deepStrictEqual(await partial.hash('sha256'),
+                         digest('sha256', data.slice(100)));
+  await partial.close();
+
+  const xof = await fs.promises.open(file, 'r');
+  assert.deepStrictEqual(await xof.hash('shake256', { outputLength: 10 }),
+                         digest('shake256', data, { outputLength: 10 }));
+  await xof.close();
+
+  const invalid = await fs.promises.open(file, 'r');
+  await assert.rejects(invalid.hash('nope'), {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+  });
+  await assert.rejects(invalid.hash(1), { code: 'ERR_INVALID_ARG_TYPE' });
+  await assert.rejects(invalid.hash('sha256', { outputLength: -1 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  await assert.rejects(invalid.hash('sha256', 'hex'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+  await invalid.close();
+  await assert.rejects(invalid.hash('sha256'), { code: 'EBADF' });
+
+  // Reading a directory fails with the error of the read.
+  if (!common.isWindows) {
+    const dir = await fs.promises.open(tmpdir.path, 'r');
+    await assert.rejects(dir.hash('sha256'), {
+      code: 'EISDIR',
+      syscall: 'read',
+    });
+    await dir.close();
+  }
+})().then(common.mustCall());
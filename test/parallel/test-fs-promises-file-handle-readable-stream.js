@@ -0,0 +1,104 @@
+'use strict';
+
+const common = require('../common');
+
+// filehandle.readableStream() reads the file with several reads in flight and
+// pushes the chunks in order.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { once } = require('events');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'readable-stream.bin');
+// Larger than the largest reads, and not a multiple of their size.
+const data = Buffer.alloc(9 * 1024 * 1024 + 17);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+async function collect(stream) {
+  const chunks = [];
+  for await (const chunk of stream)
+    chunks.push(chunk);
+  return Buffer.concat(chunks);
+}
+
+(async () => {
+  const handle = await fs.promises.open(file, 'r');
+
+  for (const readAhead of [1, 2, 8]) {
+    const stream = handle.readableStream({ start: 0, readAhead });
+    assert.deepStrictEqual(await collect(stream), data);
+  }
+
+  {
+    const result = await collect(handle.readableStream({
+      start: 100,
+      end: 5 * 1024 * 1024,
+      readAhead: 4
+    }));
+    assert.deepStrictEqual(result, data.subarray(100, 5 * 1024 * 1024 + 1));
+  }
+
+  {
+    // Without `start`, the file is read from its current position, which is
+    // not moved.
+    await handle.read(Buffer.alloc(1000), 0, 1000, null);
+    const result = await collect(handle.readableStream());
+    assert.deepStrictEqual(result, data.subarray(1000));
+    const { bytesRead, buffer } =
+      await handle.read(Buffer.alloc(10), 0, 10, null);
+    assert.strictEqual(bytesRead, 10);
+    assert.deepStrictEqual(buffer, data.subarray(1000, 1010));
+  }
+
+  {
+    // Nothing is lost when the stream is paused while reads are in flight.
+    const stream = handle.readableStream({ start: 0, highWaterMark: 1024 });
+    const chunks = [];
+    stream.on('data', (chunk) => {
+      chunks.push(chunk);
+      stream.pause();
+      setImmediate(() => stream.resume());
+    });
+    await once(stream, 'end');
+    assert.deepStrictEqual(Buffer.concat(chunks), data);
+  }
+
+  {
+    // Destroying the stream while reads are in flight keeps the FileHandle
+    // usable.
+    const stream = handle.readableStream({ start: 0, readAhead: 8 });
+    stream.once('data', () => stream.destroy());
+    await once(stream, 'close');
+    const { bytesRead } = await handle.read(Buffer.alloc(10), 0, 10, 0);
+    assert.strictEqual(bytesRead, 10);
+  }
+
+  for (const options of [null, 'x']) {
+    assert.throws(() => handle.readableStream(options), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+  }
+  for (const options of [{ start: -1 }, { readAhead: 0 }, { readAhead: 65 },
+                         { start: 10, end: 5 }]) {
+    assert.throws(() => handle.readableStream(options), {
+      code: 'ERR_OUT_OF_RANGE'
+    });
+  }
+
+  {
+    // Closing the FileHandle destroys the stream. The file is closed once the
+    // stream is done with it.
+    const stream = handle.readableStream({ start: 0 });
+    stream.once('data', common.mustCall(() => handle.close()));
+    stream.on('close', common.mustCall());
+    await once(stream, 'close');
+    assert.strictEqual(handle.fd, -1);
+    assert.throws(() => handle.readableStream(), { code: 'EBADF' });
+  }
+})().then(common.mustCall());
@@ -0,0 +1,60 @@
+'use strict';
+
+const common = require('../common');
+
+// filehandle.writev() passes its flags on to pwritev2(), and writes more
+// buffers than IOV_MAX allows in a single call.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const { RWF_APPEND, RWF_DSYNC } = fs.constants;
+
+(async () => {
+  const file = path.join(tmpdir.path, 'writev-flags');
+  const handle = await fs.promises.open(file, 'w+');
+
+  await assert.rejects(handle.writev([Buffer.from('x')], 0, 'dsync'), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+
+  if (!common.isLinux) {
+    await handle.close();
+    return;
+  }
+
+  const buffers = [];
+  for (let i = 0; i < 3000; i++)
+    buffers.push(Buffer.from(`${i % 10}`));
+  const expected = Buffer.concat(buffers);
+
+  let result;
+  try {
+    result = await handle.writev(buffers, 0, RWF_DSYNC);
+  } catch (err) {
+    // Older kernels do not have pwritev2() or its flags.
+    if (err.code !== 'ENOSYS' && err.code !== 'EOPNOTSUPP')
+      throw err;
+    await handle.close();
+    common.printSkipMessage(`pwritev2() is not supported: ${err.code}`);
+    return;
+  }
+  assert.strictEqual(result.bytesWritten, expected.length);
+  assert.strictEqual(result.buffers, buffers);
+  assert.deepStrictEqual(fs.readFileSync(file), expected);
+
+  // RWF_APPEND ignores the position.
+  result = await handle.writev([Buffer.from('ab'), Buffer.from('c')], 0,
+                               RWF_APPEND);
+  assert.strictEqual(result.bytesWritten, 3);
+  assert.deepStrictEqual(fs.readFileSync(file),
+                         Buffer.concat([expected, Buffer.from('abc')]));
+
+  await handle.close();
+  await assert.rejects(handle.writev(buffers, 0, RWF_DSYNC), {
+    code: 'EBADF',
+  });
+})().then(common.mustCall());
@@ -0,0 +1,55 @@
+'use strict';
+
+const common = require('../common');
+
+// fs.promises.readFile() reads the whole file with a single native request
+// when it is not given a signal. The results and errors must be the same as
+// the ones of the chunked FileHandle implementation.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const { readFile } = fs.promises;
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const text = 'a€b\u{1F600}c'.repeat(100000);
+const file = path.join(tmpdir.path, 'text');
+fs.writeFileSync(file, text);
+
+const empty = path.join(tmpdir.path, 'empty');
+fs.writeFileSync(empty, '');
+
+(async () => {
+  assert.strictEqual(await readFile(file, 'utf8'), text);
+  assert.strictEqual(await readFile(file, { encoding: 'utf-8' }), text);
+  assert.deepStrictEqual(await readFile(file), Buffer.from(text));
+  assert.strictEqual(await readFile(file, 'base64'),
+                     Buffer.from(text).toString('base64'));
+  assert.strictEqual(await readFile(Buffer.from(file), 'utf8'), text);
+  assert.strictEqual(await readFile(pathToFileURL(file), 'utf8'), text);
+
+  assert.strictEqual(await readFile(empty, 'utf8'), '');
+  assert.deepStrictEqual(await readFile(empty), Buffer.alloc(0));
+
+  // Same as with an AbortSignal, which goes through a FileHandle.
+  const { signal } = new AbortController();
+  assert.strictEqual(await readFile(file, { encoding: 'utf8', signal }), text);
+
+  const missing = path.join(tmpdir.path, 'missing');
+  await assert.rejects(readFile(missing), {
+    code: 'ENOENT',
+    syscall: 'open',
+    path: missing,
+  });
+
+  if (!common.isWindows) {
+    await assert.rejects(readFile(tmpdir.path, 'utf8'), {
+      code: 'EISDIR',
+      syscall: 'read',
+    });
+  }
+
+  await assert.rejects(readFile(file, { flag: 'wx' }), { code: 'EEXIST' });
+})().then(common.mustCall());
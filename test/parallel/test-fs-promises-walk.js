@@ -0,0 +1,78 @@
+'use strict';
+
+const common = require('../common');
+
+// fs.promises.walk() yields every entry of a directory tree, with paths
+// relative to its root.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { walk } = fs.promises;
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'tree');
+const dirs = ['a', path.join('a', 'b'), path.join('a', 'b', 'c'), 'd'];
+const files = [];
+for (const dir of ['', ...dirs]) {
+  fs.mkdirSync(path.join(root, dir), { recursive: true });
+  for (let i = 0; i < 3; i++) {
+    const file = path.join(dir, `file-${i}`);
+    fs.writeFileSync(path.join(root, file), 'x'.repeat(i));
+    files.push(file);
+  }
+}
+if (!common.isWindows)
+  fs.symlinkSync('a', path.join(root, 'link'));
+
+async function collect(options) {
+  const entries = new Map();
+  for await (const dirent of walk(root, options)) {
+    assert.ok(dirent instanceof fs.Dirent);
+    assert.ok(!entries.has(dirent.name));
+    entries.set(dirent.name, dirent);
+  }
+  return entries;
+}
+
+(async () => {
+  for (const batchSize of [1, 2, 4096]) {
+    const entries = await collect({ batchSize });
+    const expected = [...files, ...dirs];
+    if (!common.isWindows)
+      expected.push('link');
+    assert.deepStrictEqual([...entries.keys()].sort(), expected.sort());
+    for (const file of files)
+      assert.strictEqual(entries.get(file).isFile(), true);
+    for (const dir of dirs)
+      assert.strictEqual(entries.get(dir).isDirectory(), true);
+    // Symbolic links are not followed.
+    if (!common.isWindows)
+      assert.strictEqual(entries.get('link').isSymbolicLink(), true);
+    assert.strictEqual(entries.get(files[0]).stats, undefined);
+  }
+
+  const entries = await collect({ stats: true });
+  for (const file of files) {
+    assert.deepStrictEqual(entries.get(file).stats,
+                           fs.lstatSync(path.join(root, file)));
+  }
+  const bigintEntries = await collect({ stats: true, bigint: true });
+  assert.strictEqual(typeof bigintEntries.get(files[1]).stats.size, 'bigint');
+  assert.strictEqual(bigintEntries.get(files[1]).stats.size, 1n);
+
+  const missing = path.join(tmpdir.path, 'missing');
+  await assert.rejects(walk(missing).next(), {
+    code: 'ENOENT',
+    syscall: 'scandir',
+    path: missing,
+  });
+
+  await assert.rejects(walk(root, { batchSize: 0 }).next(), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  await assert.rejects(walk(root, { stats: 1 }).next(), {
+    code: 'ERR_INVALID_ARG_TYPE',
+  });
+})().then(common.mustCall());
@@ -0,0 +1,44 @@
+'use strict';
+
+// Large files that are read as ASCII or Latin-1 strings, or as UTF-8 strings
+// that turn out to be pure ASCII, share memory with the buffer they were read
+// into. The result must be the same as for a copy.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const length = 2 * 1024 * 1024 + 3;
+const contents = {
+  ascii: Buffer.alloc(length, 'hello world '),
+  binary: Buffer.alloc(length, 'hello wörld ', 'latin1'),
+  utf8: Buffer.alloc(length, 'hello wörld '),
+};
+for (let i = 0; i < length; i += 4099)
+  contents.binary[i] = i & 0xff;
+
+for (const [name, data] of Object.entries(contents)) {
+  const file = path.join(tmpdir.path, `${name}.txt`);
+  fs.writeFileSync(file, data);
+
+  for (const encoding of ['ascii', 'latin1', 'utf8', 'utf-8', 'hex']) {
+    const expected = data.toString(encoding);
+    assert.strictEqual(fs.readFileSync(file, encoding), expected);
+    assert.strictEqual(fs.readFileSync(file, { encoding }), expected);
+    fs.readFile(file, encoding, common.mustSucceed((str) => {
+      assert.strictEqual(str, expected);
+    }));
+    fs.promises.readFile(file, encoding).then(common.mustCall((str) => {
+      assert.strictEqual(str, expected);
+    }));
+  }
+
+  // The string is independent of later reads of the same file.
+  const first = fs.readFileSync(file, 'latin1');
+  fs.readFileSync(file);
+  assert.strictEqual(first, data.toString('latin1'));
+}
@@ -0,0 +1,68 @@
+'use strict';
+
+const common = require('../common');
+
+// fs.promises.statMany() and fs.statManySync() return the same Stats as
+// stat() for each of the paths, in order.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'file');
+fs.writeFileSync(file, 'x'.repeat(100));
+const missing = path.join(tmpdir.path, 'missing');
+const paths = [file, tmpdir.path, Buffer.from(file), pathToFileURL(file)];
+
+function check(stats, bigint) {
+  assert.strictEqual(stats.length, paths.length);
+  for (let i = 0; i < paths.length; i++) {
+    const expected = fs.statSync(paths[i], { bigint });
+    assert.strictEqual(stats[i] instanceof fs.Stats, !bigint);
+    assert.deepStrictEqual(stats[i], expected);
+  }
+  assert.strictEqual(stats[0].isFile(), true);
+  assert.strictEqual(stats[1].isDirectory(), true);
+}
+
+check(fs.statManySync(paths), false);
+check(fs.statManySync(paths, { bigint: true }), true);
+assert.deepStrictEqual(fs.statManySync([]), []);
+
+assert.throws(() => fs.statManySync([file, missing]), {
+  code: 'ENOENT',
+  syscall: 'stat',
+  path: missing,
+});
+{
+  const stats = fs.statManySync([missing, file], { throwIfNoEntry: false });
+  assert.strictEqual(stats[0], undefined);
+  assert.strictEqual(stats[1].isFile(), true);
+}
+
+assert.throws(() => fs.statManySync(file), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => fs.statManySync([file, 1]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /paths\[1\]/,
+});
+
+(async () => {
+  const { statMany } = fs.promises;
+  check(await statMany(paths), false);
+  check(await statMany(paths, { bigint: true }), true);
+  assert.deepStrictEqual(await statMany([]), []);
+
+  await assert.rejects(statMany([file, missing]), {
+    code: 'ENOENT',
+    syscall: 'stat',
+    path: missing,
+  });
+  const stats = await statMany([missing, file], { throwIfNoEntry: false });
+  assert.strictEqual(stats[0], undefined);
+  assert.strictEqual(stats[1].isFile(), true);
+
+  await assert.rejects(statMany(file), { code: 'ERR_INVALID_ARG_TYPE' });
+})().then(common.mustCall());
@@ -0,0 +1,74 @@
+'use strict';
+
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('tests the inotify watcher of Linux');
+
+// On Linux, the recursive watchers share one inotify instance, and watch the
+// directories that are created below their roots.
+
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'root');
+const nested = path.join(root, 'a', 'b');
+fs.mkdirSync(nested, { recursive: true });
+
+function waitFor(watcher, filename, action) {
+  return new Promise((resolve) => {
+    watcher.on('change', function onchange(eventType, name) {
+      assert.ok(eventType === 'rename' || eventType === 'change');
+      if (name !== filename)
+        return;
+      watcher.removeListener('change', onchange);
+      resolve();
+    });
+    action();
+  });
+}
+
+(async () => {
+  const rootWatcher = fs.watch(root, { recursive: true });
+  const nestedWatcher = fs.watch(path.join(root, 'a'), { recursive: true });
+
+  // Both watchers see the events of the directories they share.
+  const file = path.join(nested, 'file.txt');
+  await Promise.all([
+    waitFor(rootWatcher, path.join('a', 'b', 'file.txt'), () => {}),
+    waitFor(nestedWatcher, path.join('b', 'file.txt'),
+            () => fs.writeFileSync(file, 'x')),
+  ]);
+
+  // The directories created after the watcher was started are watched too.
+  const created = path.join(root, 'c', 'd');
+  await waitFor(rootWatcher, 'c', () => fs.mkdirSync(created, {
+    recursive: true
+  }));
+  await waitFor(rootWatcher, path.join('c', 'd', 'new.txt'),
+                () => fs.writeFileSync(path.join(created, 'new.txt'), 'x'));
+
+  // Closing one of the watchers does not stop the other one.
+  nestedWatcher.close();
+  await waitFor(rootWatcher, path.join('a', 'b', 'file.txt'),
+                () => fs.appendFileSync(file, 'y'));
+  rootWatcher.close();
+})().then(common.mustCall());
+
+// The Buffer encoding applies to the relative filenames.
+{
+  const watcher = fs.watch(root, { recursive: true, encoding: 'buffer' });
+  watcher.once('change', common.mustCall((eventType, filename) => {
+    assert.ok(Buffer.isBuffer(filename));
+    watcher.close();
+  }));
+  fs.writeFileSync(path.join(root, 'buffer.txt'), 'x');
+}
+
+assert.throws(() => fs.watch(path.join(tmpdir.path, 'missing'),
+                             { recursive: true }),
+              { code: 'ENOENT', syscall: 'watch' });
@@ -0,0 +1,55 @@
+'use strict';
+
+const common = require('../common');
+
+// The watchers of fs.watchFile() that share an interval are polled together.
+// Each of them still reports the changes of its own file, including the
+// watchers that join or leave the group while it is being polled.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const interval = 10;
+const files = [];
+for (let i = 0; i < 20; i++) {
+  const file = path.join(tmpdir.path, `file-${i}`);
+  fs.writeFileSync(file, '');
+  files.push(file);
+}
+
+let remaining = files.length;
+for (const file of files) {
+  fs.watchFile(file, { interval }, common.mustCall(function(curr, prev) {
+    assert.strictEqual(prev.size, 0);
+    assert.strictEqual(curr.size, 3);
+    fs.unwatchFile(file);
+    if (--remaining === 0)
+      watchMissing();
+  }));
+}
+// Let the watchers stat their files before they change.
+setTimeout(() => {
+  for (const file of files)
+    fs.writeFileSync(file, 'abc');
+}, common.platformTimeout(100));
+
+// A missing file is reported once, with zeroed stats, then again when it is
+// created.
+function watchMissing() {
+  const file = path.join(tmpdir.path, 'missing');
+  let calls = 0;
+  fs.watchFile(file, { interval }, common.mustCall((curr, prev) => {
+    if (++calls === 1) {
+      assert.strictEqual(curr.nlink, 0);
+      assert.strictEqual(prev.nlink, 0);
+      fs.writeFileSync(file, 'x');
+    } else {
+      assert.strictEqual(curr.size, 1);
+      fs.unwatchFile(file);
+    }
+  }, 2));
+}
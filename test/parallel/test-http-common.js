@@ -31,3 +31,23 @@ assert.strictEqual(checkInvalidHeaderChar('tt'), false);
 assert.strictEqual(checkInvalidHeaderChar('ttt'), false);
 assert.strictEqual(checkInvalidHeaderChar('tttt'), false);
 assert.strictEqual(checkInvalidHeaderChar('ttttt'), false);
+
+// Long strings are checked natively, make sure that the result is the same
+// for each kind of character at every position.
+{
+  const tokenRegExp = /^[\^_`a-zA-Z\-0-9!#$%&'*+.|~]+$/;
+  const headerCharRegex = /[^\t\x20-\x7e\x80-\xff]/;
+  const chars = ['a', '0', '!', '~', ' ', '\t', '\n', '\x00', '\x1f', '\x7f',
+                 '\x80', '\xff', 'あ', '"', ':'];
+  for (const base of ['a'.repeat(100), '\t'.repeat(100)]) {
+    for (let i = 0; i < base.length; i += 7) {
+      for (const c of chars) {
+        const str = base.slice(0, i) + c + base.slice(i + 1);
+        assert.strictEqual(checkIsHttpToken(str),
+                           tokenRegExp.test(str), JSON.stringify(str));
+        assert.strictEqual(checkInvalidHeaderChar(str),
+                           headerCharRegex.test(str), JSON.stringify(str));
+      }
+    }
+  }
+}
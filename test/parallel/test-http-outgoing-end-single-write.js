@@ -0,0 +1,81 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// Small bodies passed to end() are written together with the message head,
+// including the chunked framing and trailers. Check the exact bytes on the
+// wire for the different kinds of bodies.
+
+const cases = [
+  {
+    handler(req, res) {
+      res.writeHead(200, { 'Content-Length': 5 });
+      res.end(Buffer.from('hello'));
+    },
+    expected: 'HTTP/1.1 200 OK\r\n' +
+              'Content-Length: 5\r\n' +
+              '\r\n' +
+              'hello',
+  },
+  {
+    handler(req, res) {
+      res.writeHead(200, { 'Transfer-Encoding': 'chunked' });
+      res.end('héllo');
+    },
+    expected: 'HTTP/1.1 200 OK\r\n' +
+              'Transfer-Encoding: chunked\r\n' +
+              '\r\n' +
+              '6\r\nhÃ©llo\r\n' +
+              '0\r\n\r\n',
+  },
+  {
+    handler(req, res) {
+      res.writeHead(200, { 'Transfer-Encoding': 'chunked',
+                           'Trailer': 'X-Checksum' });
+      res.addTrailers({ 'X-Checksum': 'abc' });
+      res.end('hello', 'latin1');
+    },
+    expected: 'HTTP/1.1 200 OK\r\n' +
+              'Transfer-Encoding: chunked\r\n' +
+              'Trailer: X-Checksum\r\n' +
+              '\r\n' +
+              '5\r\nhello\r\n' +
+              '0\r\nX-Checksum: abc\r\n\r\n',
+  },
+  {
+    handler(req, res) {
+      res.writeHead(200, { 'Transfer-Encoding': 'chunked' });
+      res.end(Buffer.alloc(0));
+    },
+    expected: 'HTTP/1.1 200 OK\r\n' +
+              'Transfer-Encoding: chunked\r\n' +
+              '\r\n' +
+              '0\r\n\r\n',
+  },
+];
+
+const server = http.createServer(common.mustCall((req, res) => {
+  res.sendDate = false;
+  res.shouldKeepAlive = false;
+  cases[+req.url.slice(1)].handler(req, res);
+}, cases.length));
+
+server.listen(0, common.mustCall(() => {
+  let pending = cases.length;
+  cases.forEach(({ expected }, i) => {
+    const client = net.connect(server.address().port);
+    let response = '';
+    client.setEncoding('latin1');
+    client.on('data', (chunk) => response += chunk);
+    client.on('end', common.mustCall(() => {
+      assert.strictEqual(
+        response,
+        expected.replace('\r\n\r\n', '\r\nConnection: close\r\n\r\n'));
+      if (--pending === 0)
+        server.close();
+    }));
+    client.end(`GET /${i} HTTP/1.1\r\nHost: localhost\r\n\r\n`);
+  });
+}));
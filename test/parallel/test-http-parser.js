@@ -30,6 +30,8 @@ const kOnHeaders = HTTPParser.kOnHeaders | 0;
 const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
 const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+const kOnMessageBegin = HTTPParser.kOnMessageBegin | 0;
+const kOnRequestBatch = HTTPParser.kOnRequestBatch | 0;
 
 // The purpose of this test is not to check HTTP compliance but to test the
 // binding. Tests for pathological http messages should be submitted
@@ -271,6 +273,37 @@ function expectBody(expected) {
 }
 
 
+//
+// Test that many headers, split across several chunks of input, are passed
+// to kOnHeadersComplete at once
+//
+{
+  const request = Buffer.from(
+    'GET /foo HTTP/1.1\r\n' +
+    Array.from({ length: 100 }, (_, i) => `X-Header-${i}: ${i}\r\n`).join('') +
+    '\r\n'
+  );
+
+  const onHeadersComplete = (versionMajor, versionMinor, headers,
+                             method, url) => {
+    assert.strictEqual(url, '/foo');
+    assert.strictEqual(headers.length, 2 * 100);
+    for (let i = 0; i < headers.length; i += 2) {
+      assert.strictEqual(headers[i], `X-Header-${i / 2}`);
+      assert.strictEqual(headers[i + 1], `${i / 2}`);
+    }
+  };
+
+  const parser = newParser(REQUEST);
+  parser[kOnHeaders] = mustNotCall();
+  parser[kOnHeadersComplete] = mustCall(onHeadersComplete);
+  for (let i = 0; i < request.length; i += 7) {
+    const chunk = request.slice(i, i + 7);
+    parser.execute(chunk, 0, chunk.length);
+  }
+}
+
+
 //
 // Test request body
 //
@@ -562,6 +595,96 @@ function expectBody(expected) {
   parser.execute(req2, 0, req2.length);
 }
 
+//
+// Well-known header names keep their spelling, whether or not they are
+// served from the parser's cache of common names.
+//
+{
+  const request = Buffer.from(
+    'GET / HTTP/1.1\r\n' +
+    'Host: a\r\n' +
+    'host: b\r\n' +
+    'HOST: c\r\n' +
+    'Content-Type: d\r\n' +
+    'content-TYPE: e\r\n' +
+    'ETag: f\r\n' +
+    'X-Unknown: g\r\n' +
+    '\r\n'
+  );
+
+  const onHeadersComplete = mustCall((versionMajor, versionMinor, headers) => {
+    assert.deepStrictEqual(headers, [
+      'Host', 'a',
+      'host', 'b',
+      'HOST', 'c',
+      'Content-Type', 'd',
+      'content-TYPE', 'e',
+      'ETag', 'f',
+      'X-Unknown', 'g',
+    ]);
+  }, 2);
+
+  const parser = newParser(REQUEST);
+  parser[kOnHeadersComplete] = onHeadersComplete;
+  parser.execute(request, 0, request.length);
+
+  // Name split across two chunks.
+  parser.initialize(REQUEST, request);
+  parser[kOnHeadersComplete] = onHeadersComplete;
+  const a = request.slice(0, 50);
+  const b = request.slice(50);
+  parser.execute(a, 0, a.length);
+  parser.execute(b, 0, b.length);
+}
+
+//
+// In batch mode, pipelined requests without a body are delivered together.
+// Everything else keeps its order relative to them.
+//
+{
+  const request = Buffer.from(
+    'GET /a HTTP/1.1\r\nHost: a\r\n\r\n' +
+    'GET /b HTTP/1.0\r\nConnection: keep-alive\r\n\r\n' +
+    'POST /c HTTP/1.1\r\nContent-Length: 4\r\n\r\nping' +
+    'GET /d HTTP/1.1\r\nX-Foo: bar\r\n\r\n' +
+    'GET /e HTTP/1.1\r\nHo'
+  );
+
+  const events = [];
+  const parser = new HTTPParser();
+  parser.initialize(REQUEST, {}, 0, false, 0, false, undefined, true);
+  parser[kOnMessageBegin] = () => events.push('begin');
+  parser[kOnHeadersComplete] = (versionMajor, versionMinor, headers,
+                                method, url) => {
+    events.push(`headers ${url}`);
+  };
+  parser[kOnBody] = expectBody('ping');
+  parser[kOnMessageComplete] = () => events.push('complete');
+  parser[kOnRequestBatch] = (meta, fields) => {
+    assert(meta instanceof Uint32Array);
+    assert.strictEqual(fields.length, meta.length / 4 * 3);
+    for (let i = 0; i < meta.length / 4; i++) {
+      const [major, minor, method, keepAlive] = meta.slice(i * 4, i * 4 + 4);
+      const [headers, url, offsets] = fields.slice(i * 3, i * 3 + 3);
+      assert.strictEqual(method, methods.indexOf('GET'));
+      assert.strictEqual(offsets, undefined);
+      events.push(`batch ${url} ${major}.${minor} ${keepAlive} ${headers}`);
+    }
+  };
+
+  assert.strictEqual(parser.execute(request, 0, request.length),
+                     request.length);
+  assert.deepStrictEqual(events, [
+    'batch /a 1.1 1 Host,a',
+    'batch /b 1.0 1 Connection,keep-alive',
+    'begin',
+    'headers /c',
+    'complete',
+    'batch /d 1.1 1 X-Foo,bar',
+    'begin',
+  ]);
+}
+
 // Test parser 'this' safety
 // https://github.com/joyent/node/issues/6690
 assert.throws(function() {
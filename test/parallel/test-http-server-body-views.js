@@ -0,0 +1,57 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// Request body chunks are views onto the buffer the data was read into,
+// for both Content-Length and chunked bodies.
+
+const body = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < body.length; i++)
+  body[i] = i % 251;
+
+const requests = [
+  'POST / HTTP/1.1\r\n' +
+  'Host: localhost\r\n' +
+  `Content-Length: ${body.length}\r\n` +
+  '\r\n',
+  'POST / HTTP/1.1\r\n' +
+  'Host: localhost\r\n' +
+  'Transfer-Encoding: chunked\r\n' +
+  'Connection: close\r\n' +
+  '\r\n',
+];
+
+const server = http.createServer(common.mustCall((req, res) => {
+  const chunks = [];
+  let views = 0;
+  req.on('data', (chunk) => {
+    if (chunk.byteOffset !== 0 || chunk.buffer.byteLength !== chunk.length)
+      views++;
+    chunks.push(chunk);
+  });
+  req.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), body);
+    assert.ok(views > 0);
+    res.end();
+  }));
+}, requests.length));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  client.on('end', common.mustCall(() => server.close()));
+  client.resume();
+
+  client.write(requests[0]);
+  client.write(body);
+
+  client.write(requests[1]);
+  for (let i = 0; i < body.length; i += 100000) {
+    const chunk = body.subarray(i, i + 100000);
+    client.write(`${chunk.length.toString(16)}\r\n`);
+    client.write(chunk);
+    client.write('\r\n');
+  }
+  client.end('0\r\n\r\n');
+}));
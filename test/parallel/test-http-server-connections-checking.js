@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// With connectionsCheckingInterval, the headers, request and keep-alive
+// timeouts are enforced by the server's native connections list.
+
+assert.throws(() => http.createServer({ connectionsCheckingInterval: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+
+const interval = common.platformTimeout(20);
+const timeout = common.platformTimeout(100);
+
+function createServer(options, handler) {
+  const server = http.createServer({
+    connectionsCheckingInterval: interval
+  }, handler);
+  server.headersTimeout = 0;
+  server.requestTimeout = 0;
+  server.keepAliveTimeout = 0;
+  Object.assign(server, options);
+  return server;
+}
+
+function connect(server, data, onEnd) {
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port);
+    let response = '';
+    client.setEncoding('latin1');
+    client.on('data', (chunk) => response += chunk);
+    client.on('close', common.mustCall(() => {
+      onEnd(response);
+      server.close();
+    }));
+    client.write(data);
+  }));
+}
+
+// Headers timeout: the headers never complete.
+{
+  const server = createServer({ headersTimeout: timeout },
+                              common.mustNotCall());
+  server.on('timeout', common.mustCall((socket) => socket.destroy()));
+  connect(server, 'GET / HTTP/1.1\r\nHost: localhost\r\n', (response) => {
+    assert.strictEqual(response, '');
+  });
+}
+
+// Request timeout: the body never arrives. The request is emitted once the
+// headers are complete, but no response is sent in time.
+{
+  const server = createServer({ requestTimeout: timeout }, common.mustCall());
+  connect(server,
+          'POST / HTTP/1.1\r\nHost: localhost\r\nContent-Length: 10\r\n\r\n',
+          (response) => {
+            assert.match(response, /^HTTP\/1\.1 408 Request Timeout\r\n/);
+          });
+}
+
+// Keep-alive timeout: the connection stays idle after a response.
+{
+  const server = createServer({ keepAliveTimeout: timeout },
+                              common.mustCall((req, res) => res.end('ok')));
+  server.on('timeout', common.mustCall((socket) => socket.destroy()));
+  connect(server, 'GET / HTTP/1.1\r\nHost: localhost\r\n\r\n', (response) => {
+    assert.match(response, /^HTTP\/1\.1 200 OK\r\n/);
+    assert.match(response, /\r\nok$/);
+  });
+}
@@ -0,0 +1,79 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// With the `lazyHeaders` option, request headers are kept as a Buffer until
+// they are accessed, and are also available in their raw form.
+
+assert.throws(() => http.createServer({ lazyHeaders: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+const request = 'POST / HTTP/1.1\r\n' +
+                'Host: localhost\r\n' +
+                'X-Foo: bar  \r\n' +
+                'x-foo: baz\r\n' +
+                'Expect: 100-continue\r\n' +
+                'Content-Length: 2\r\n' +
+                'Connection: close\r\n' +
+                '\r\n';
+
+const server = http.createServer({ lazyHeaders: true });
+
+server.on('checkContinue', common.mustCall((req, res) => {
+  assert.strictEqual(req.rawHeadersBuffer.toString('latin1'),
+                     request.replace('bar  ', 'bar').slice(17, -2));
+  assert.deepStrictEqual(req.rawHeaders, [
+    'Host', 'localhost',
+    'X-Foo', 'bar',
+    'x-foo', 'baz',
+    'Expect', '100-continue',
+    'Content-Length', '2',
+    'Connection', 'close',
+  ]);
+  assert.strictEqual(req.headers.host, 'localhost');
+  assert.strictEqual(req.headers['x-foo'], 'bar, baz');
+  assert.strictEqual(req.headers.expect, '100-continue');
+
+  res.writeContinue();
+  let body = '';
+  req.setEncoding('utf8');
+  req.on('data', (chunk) => body += chunk);
+  req.on('end', common.mustCall(() => {
+    assert.strictEqual(body, 'ok');
+    res.end();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  let response = '';
+  client.setEncoding('latin1');
+  client.on('data', (chunk) => {
+    if (response === '' && chunk.startsWith('HTTP/1.1 100 Continue'))
+      client.write('ok');
+    response += chunk;
+  });
+  client.on('end', common.mustCall(() => {
+    assert.match(response, /^HTTP\/1\.1 100 Continue\r\n\r\nHTTP\/1\.1 200 OK/);
+    server.close();
+  }));
+  client.write(request);
+}));
+
+// Without the option, there is no raw header block.
+const plain = http.createServer(common.mustCall((req, res) => {
+  assert.strictEqual(req.rawHeadersBuffer, null);
+  assert.strictEqual(req.headers.host, `localhost:${plain.address().port}`);
+  res.end();
+  plain.close();
+}));
+
+plain.listen(0, common.mustCall(() => {
+  http.get({ port: plain.address().port }, common.mustCall((res) => {
+    assert.strictEqual(res.rawHeadersBuffer, null);
+    res.resume();
+  }));
+}));
@@ -0,0 +1,49 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+// The pool of idle HTTP parsers can be resized and reports how often it was
+// able to hand out a parser for reuse.
+
+[0, -1, 1.5].forEach((max) => {
+  assert.throws(() => http.setMaxIdleHTTPParsers(max), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+});
+assert.throws(() => http.setMaxIdleHTTPParsers('10'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+assert.strictEqual(http.getIdleHTTPParsersStats().max, 1000);
+http.setMaxIdleHTTPParsers(4);
+
+const before = http.getIdleHTTPParsersStats();
+assert.strictEqual(before.max, 4);
+
+const server = http.createServer(common.mustCall((req, res) => {
+  res.end('ok');
+}));
+
+server.listen(0, common.mustCall(() => {
+  http.get({ port: server.address().port, agent: false },
+           common.mustCall((res) => {
+             res.resume();
+             res.on('end', common.mustCall(() => {
+               server.close();
+             }));
+           }));
+}));
+
+server.on('close', common.mustCall(() => {
+  setImmediate(common.mustCall(() => {
+    const after = http.getIdleHTTPParsersStats();
+    // One parser for the client, one for the server connection.
+    assert.strictEqual((after.hits + after.misses) -
+                       (before.hits + before.misses), 2);
+    assert.ok(after.idle >= 1 && after.idle <= 4);
+
+    http.setMaxIdleHTTPParsers(1);
+    assert.strictEqual(http.getIdleHTTPParsersStats().idle, 1);
+  }));
+}));
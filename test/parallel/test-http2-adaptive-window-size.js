@@ -0,0 +1,62 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+const { PerformanceObserver } = require('perf_hooks');
+
+// With maxAdaptiveWindowSize, a session that receives more data than fits
+// into its windows within a round trip grows the connection and stream
+// windows, and reports the estimates in its performance entry.
+
+const maxAdaptiveWindowSize = 1024 * 1024;
+const body = Buffer.alloc(8 * 1024 * 1024, 'x');
+
+const obs = new PerformanceObserver(common.mustCallAtLeast((items) => {
+  for (const entry of items.getEntries()) {
+    if (entry.name !== 'Http2Session')
+      continue;
+    const { adaptiveWindowSize, bdpEstimate } = entry.detail;
+    assert.strictEqual(typeof adaptiveWindowSize, 'number');
+    assert.strictEqual(typeof bdpEstimate, 'number');
+    if (entry.detail.type === 'server') {
+      assert.ok(adaptiveWindowSize > 65535);
+      assert.ok(adaptiveWindowSize <= maxAdaptiveWindowSize);
+      assert.ok(bdpEstimate > 0);
+      obs.disconnect();
+    } else {
+      // Not enabled for the client.
+      assert.strictEqual(adaptiveWindowSize, 0);
+      assert.strictEqual(bdpEstimate, 0);
+    }
+  }
+}));
+obs.observe({ type: 'http2' });
+
+const server = h2.createServer({ maxAdaptiveWindowSize });
+server.on('stream', common.mustCall((stream) => {
+  let received = 0;
+  stream.on('data', (chunk) => received += chunk.length);
+  stream.on('end', common.mustCall(() => {
+    assert.strictEqual(received, body.length);
+    const { effectiveLocalWindowSize } = stream.session.state;
+    assert.ok(effectiveLocalWindowSize > 65535);
+    assert.ok(effectiveLocalWindowSize <= maxAdaptiveWindowSize);
+    stream.respond();
+    stream.end();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`);
+  const req = client.request({ ':method': 'POST' });
+  req.on('response', common.mustCall());
+  req.resume();
+  req.on('end', common.mustCall(() => {
+    client.close();
+    server.close();
+  }));
+  req.end(body);
+}));
@@ -0,0 +1,53 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+if (common.isWindows)
+  common.skip('http2.detachSocket() is not supported on Windows');
+const assert = require('assert');
+const http2 = require('http2');
+const net = require('net');
+const { Worker } = require('worker_threads');
+
+// Connections accepted in the main thread can be served by an HTTP/2 server
+// running in a worker.
+
+assert.throws(() => http2.detachSocket({}), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => http2.detachSocket(new net.Socket()), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+
+const worker = new Worker(`
+  const http2 = require('http2');
+  const net = require('net');
+  const { parentPort, threadId } = require('worker_threads');
+  const server = http2.createServer((req, res) => res.end(String(threadId)));
+  parentPort.on('message', (fd) => {
+    server.emit('connection', new net.Socket({ fd }));
+  });
+`, { eval: true });
+
+const server = net.createServer({ pauseOnConnect: true },
+                                common.mustCall((socket) => {
+                                  const fd = http2.detachSocket(socket);
+                                  assert.ok(Number.isInteger(fd) && fd >= 0);
+                                  assert.strictEqual(socket.destroyed, true);
+                                  worker.postMessage(fd);
+                                }));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  const req = client.request();
+  let body = '';
+  req.setEncoding('utf8');
+  req.on('data', (chunk) => body += chunk);
+  req.on('end', common.mustCall(() => {
+    assert.strictEqual(body, String(worker.threadId));
+    client.close();
+    server.close();
+    worker.terminate();
+  }));
+}));
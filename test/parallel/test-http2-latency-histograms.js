@@ -0,0 +1,58 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+
+// With latencyHistograms, each session records the latencies of its streams
+// natively. They remain readable once the session is gone.
+
+const kStreams = 5;
+
+const server = h2.createServer({ latencyHistograms: true });
+server.on('session', common.mustCall((session) => {
+  const { histograms } = session;
+  assert.strictEqual(session.histograms, histograms);
+  for (const name of ['timeToFirstHeader', 'timeToFirstByte', 'streamDuration'])
+    assert.strictEqual(typeof histograms[name].percentile, 'function');
+  session.on('close', common.mustCall(() => {
+    const { timeToFirstHeader, timeToFirstByte, streamDuration } = histograms;
+    assert.strictEqual(streamDuration.exceeds, 0);
+    assert.ok(streamDuration.min > 0);
+    assert.ok(streamDuration.max >= streamDuration.min);
+    assert.ok(timeToFirstHeader.min > 0);
+    // Only the POST requests have a body.
+    assert.ok(timeToFirstByte.min > 0);
+    assert.ok(timeToFirstByte.max <= streamDuration.max);
+  }));
+}));
+server.on('stream', common.mustCall((stream) => {
+  stream.resume();
+  stream.on('end', () => {
+    stream.respond();
+    stream.end('ok');
+  });
+}, kStreams));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`);
+  // Not enabled for the client.
+  client.on('connect', common.mustCall(() => {
+    assert.strictEqual(client.histograms, undefined);
+  }));
+
+  let pending = kStreams;
+  for (let i = 0; i < kStreams; i++) {
+    const req = client.request({ ':method': i % 2 ? 'POST' : 'GET' });
+    req.resume();
+    req.on('close', common.mustCall(() => {
+      if (--pending === 0) {
+        client.close();
+        server.close();
+      }
+    }));
+    req.end(i % 2 ? 'body' : undefined);
+  }
+}));
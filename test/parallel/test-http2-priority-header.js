@@ -0,0 +1,62 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+
+// The server schedules requests according to their RFC 9218 priority header.
+// Urgency maps onto the stream weight, and non-incremental streams of the
+// same urgency are chained so that they are sent in order.
+
+const requests = [
+  { priority: 'u=0', weight: 128 },
+  { priority: 'u=7, i', weight: 1 },
+  { priority: 'i, u=5', weight: 4 },
+  { priority: 'u=3', weight: 16 },
+  { priority: 'u=9', weight: 16 },
+  { priority: 'u=1;foo=bar, i=?0', weight: 64 },
+  { priority: 'u=1', weight: 64 },
+  { weight: 16 },
+];
+
+const streams = [];
+const server = h2.createServer();
+server.on('stream', common.mustCall((stream, headers) => {
+  const { weight } = requests[headers['x-index']];
+  assert.strictEqual(stream.state.weight, weight);
+  streams[headers['x-index']] = stream;
+
+  if (streams.filter(Boolean).length < requests.length)
+    return;
+
+  // The second non-incremental urgency 1 stream depends on the first one.
+  assert.strictEqual(streams[5].state.sumDependencyWeight, 64);
+  assert.strictEqual(streams[6].state.sumDependencyWeight, 0);
+  // Incremental streams do not.
+  assert.strictEqual(streams[1].state.sumDependencyWeight, 0);
+
+  for (const stream of streams) {
+    stream.respond();
+    stream.end();
+  }
+}, requests.length));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`);
+  let pending = requests.length;
+  requests.forEach(({ priority }, i) => {
+    const headers = { 'x-index': i };
+    if (priority !== undefined)
+      headers.priority = priority;
+    const req = client.request(headers);
+    req.resume();
+    req.on('end', common.mustCall(() => {
+      if (--pending === 0) {
+        client.close();
+        server.close();
+      }
+    }));
+  });
+}));
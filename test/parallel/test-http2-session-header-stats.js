@@ -0,0 +1,55 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+
+// Sessions count the size of the header blocks they send and receive, and
+// the blocks they refuse, the same way as maxHeaderListSize does.
+
+function headerListSize(headers) {
+  let size = 0;
+  for (const [name, value] of Object.entries(headers))
+    size += name.length + String(value).length + 32;
+  return size;
+}
+
+const server = h2.createServer({ maxHeaderListPairs: 8 });
+const serverSessions = [];
+server.on('session', (session) => serverSessions.push(session));
+server.on('stream', common.mustCall((stream, headers) => {
+  const state = stream.session.state;
+  assert.strictEqual(state.headerBytesReceived, headerListSize(headers));
+  assert.strictEqual(state.maxHeaderListSizeReceived, headerListSize(headers));
+  assert.strictEqual(state.headerBytesSent, 0);
+  assert.strictEqual(state.rejectedHeaderBlocks, 0);
+
+  const response = { ':status': 200, 'x-response': 'a'.repeat(100) };
+  stream.respond(response, { sendDate: false });
+  assert.strictEqual(stream.session.state.headerBytesSent,
+                     headerListSize(response));
+  stream.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`);
+  const req = client.request({ 'x-request': 'b'.repeat(50) });
+  req.resume();
+  req.on('end', common.mustCall(() => {
+    const tooMany = {};
+    for (let i = 0; i < 10; i++)
+      tooMany[`x-header-${i}`] = 'c';
+    const rejected = client.request(tooMany);
+    rejected.on('error', common.expectsError({
+      code: 'ERR_HTTP2_STREAM_ERROR'
+    }));
+    rejected.on('close', common.mustCall(() => {
+      const [session] = serverSessions;
+      assert.strictEqual(session.state.rejectedHeaderBlocks, 1);
+      client.close();
+      server.close();
+    }));
+  }));
+}));
@@ -0,0 +1,47 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+// Small DATA frames of many streams are copied into the session's outgoing
+// storage and written together. Check that every stream still receives its
+// own data, for payloads around the size up to which they are copied.
+
+const sizes = [1, 100, 1023, 1024, 1025, 5000, 20000];
+const count = 200;
+
+function payload(i) {
+  return Buffer.alloc(sizes[i % sizes.length],
+                      String.fromCharCode(65 + i % 26));
+}
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream, headers) => {
+  const i = +headers[':path'].slice(1);
+  const data = payload(i);
+  stream.respond();
+  // Write the data in two parts, so that some frames consist of several
+  // queued writes.
+  stream.write(data.subarray(0, data.length >> 1));
+  stream.end(data.subarray(data.length >> 1));
+}, count));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  let pending = count;
+  for (let i = 0; i < count; i++) {
+    const req = client.request({ ':path': `/${i}` });
+    const chunks = [];
+    req.on('data', (chunk) => chunks.push(chunk));
+    req.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), payload(i));
+      if (--pending === 0) {
+        client.close();
+        server.close();
+      }
+    }));
+    req.end();
+  }
+}));
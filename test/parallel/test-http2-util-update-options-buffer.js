@@ -23,7 +23,9 @@ const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
 const IDX_OPTIONS_MAX_SETTINGS = 9;
-const IDX_OPTIONS_FLAGS = 10;
+const IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE = 10;
+const IDX_OPTIONS_LATENCY_HISTOGRAMS = 11;
+const IDX_OPTIONS_FLAGS = 12;
 
 {
   updateOptionsBuffer({
@@ -37,6 +39,8 @@ const IDX_OPTIONS_FLAGS = 10;
     maxOutstandingSettings: 8,
     maxSessionMemory: 9,
     maxSettings: 10,
+    maxAdaptiveWindowSize: 11,
+    latencyHistograms: true,
   });
 
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_DEFLATE_DYNAMIC_TABLE_SIZE], 1);
@@ -49,6 +53,8 @@ const IDX_OPTIONS_FLAGS = 10;
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS], 8);
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_SESSION_MEMORY], 9);
   strictEqual(optionsBuffer[IDX_OPTIONS_MAX_SETTINGS], 10);
+  strictEqual(optionsBuffer[IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE], 11);
+  strictEqual(optionsBuffer[IDX_OPTIONS_LATENCY_HISTOGRAMS], 1);
 
   const flags = optionsBuffer[IDX_OPTIONS_FLAGS];
 
@@ -61,6 +67,8 @@ const IDX_OPTIONS_FLAGS = 10;
   ok(flags & (1 << IDX_OPTIONS_MAX_OUTSTANDING_PINGS));
   ok(flags & (1 << IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS));
   ok(flags & (1 << IDX_OPTIONS_MAX_SETTINGS));
+  ok(flags & (1 << IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE));
+  ok(flags & (1 << IDX_OPTIONS_LATENCY_HISTOGRAMS));
 }
 
 {
@@ -93,4 +101,6 @@ const IDX_OPTIONS_FLAGS = 10;
 
   ok(!(flags & (1 << IDX_OPTIONS_MAX_SEND_HEADER_BLOCK_LENGTH)));
   ok(!(flags & (1 << IDX_OPTIONS_MAX_OUTSTANDING_PINGS)));
+  ok(!(flags & (1 << IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE)));
+  ok(!(flags & (1 << IDX_OPTIONS_LATENCY_HISTOGRAMS)));
 }
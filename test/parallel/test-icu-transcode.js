@@ -83,3 +83,39 @@ assert.deepStrictEqual(
   const dest = buffer.transcode(new Uint8Array(), 'utf8', 'latin1');
   assert.strictEqual(dest.length, 0);
 }
+
+// Latin-1 is converted to and from UTF-8 and UTF-16LE without ICU, the
+// results must match those of the ICU converters.
+{
+  const all = Buffer.from(Array.from({ length: 256 }, (_, i) => i));
+  assert.deepStrictEqual(
+    buffer.transcode(all, 'latin1', 'utf8'),
+    Buffer.from(all.toString('latin1'), 'utf8'));
+  assert.deepStrictEqual(
+    buffer.transcode(all, 'latin1', 'utf16le'),
+    Buffer.from(all.toString('latin1'), 'utf16le'));
+  assert.deepStrictEqual(
+    buffer.transcode(Buffer.from(all.toString('latin1'), 'utf16le'),
+                     'utf16le', 'latin1'),
+    all);
+}
+
+{
+  // A surrogate pair is replaced by a single '?', a lone surrogate as well.
+  const ucs2 = Buffer.from('a€b😀c\ud800d\udc00', 'utf16le');
+  assert.strictEqual(
+    buffer.transcode(ucs2, 'utf16le', 'latin1').toString('latin1'),
+    'a?b?c?d?');
+  // A trailing odd byte is ignored.
+  assert.strictEqual(
+    buffer.transcode(Buffer.concat([ucs2, Buffer.from([0x41])]),
+                     'utf16le', 'latin1').toString('latin1'),
+    'a?b?c?d?');
+}
+
+// Converters are reused between calls.
+for (let i = 0; i < 10; i++) {
+  assert.deepStrictEqual(
+    buffer.transcode(Buffer.from('těst', 'utf8'), 'utf8', 'latin1'),
+    Buffer.from('t?st', 'latin1'));
+}
@@ -0,0 +1,83 @@
+'use strict';
+
+const common = require('../common');
+
+common.skipIfInspectorDisabled();
+
+const assert = require('assert');
+const http = require('http');
+const { Session } = require('inspector');
+
+const session = new Session();
+session.connect();
+
+const server = http.createServer((req, res) => {
+  res.setHeader('x-test', 'response');
+  res.end('hello');
+});
+
+let requestId;
+
+session.on('Network.requestWillBeSent', common.mustCall(({ params }) => {
+  requestId = params.requestId;
+  assert.strictEqual(typeof params.timestamp, 'number');
+  assert.strictEqual(typeof params.wallTime, 'number');
+  assert.strictEqual(params.request.method, 'GET');
+  assert.strictEqual(params.request.url,
+                     `http://localhost:${server.address().port}/test`);
+  assert.strictEqual(params.request.headers['x-test'], 'request');
+}, 2));
+
+session.on('Network.responseReceived', common.mustCall(({ params }) => {
+  assert.strictEqual(params.requestId, requestId);
+  assert.strictEqual(params.response.status, 200);
+  assert.strictEqual(params.response.statusText, 'OK');
+  assert.strictEqual(params.response.headers['x-test'], 'response');
+}));
+
+session.on('Network.loadingFinished', common.mustCall(({ params }) => {
+  assert.strictEqual(params.requestId, requestId);
+  assert.strictEqual(typeof params.timestamp, 'number');
+}));
+
+session.on('Network.loadingFailed', common.mustCall(({ params }) => {
+  assert.strictEqual(params.requestId, requestId);
+  assert.strictEqual(typeof params.errorText, 'string');
+}));
+
+function get(port, callback) {
+  return http.get({
+    host: 'localhost',
+    port,
+    path: '/test',
+    headers: { 'x-test': 'request' }
+  }, callback);
+}
+
+server.listen(0, common.mustCall(() => {
+  const { port } = server.address();
+
+  // Requests made before the domain is enabled are not reported.
+  get(port, common.mustCall((res) => {
+    res.resume();
+    res.on('end', common.mustCall(enable));
+  }));
+
+  function enable() {
+    session.post('Network.enable', common.mustSucceed(() => {
+      get(port, common.mustCall((res) => {
+        res.resume();
+        res.on('end', common.mustCall(() => server.close(fail)));
+      }));
+    }));
+  }
+
+  // Nothing listens on the port once the server is closed.
+  function fail() {
+    get(port).on('error', common.mustCall(() => {
+      session.post('Network.disable', common.mustSucceed(() => {
+        get(port).on('error', common.mustCall(() => session.disconnect()));
+      }));
+    }));
+  }
+}));
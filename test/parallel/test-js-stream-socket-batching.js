@@ -0,0 +1,54 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Duplex } = require('stream');
+const JSStreamSocket = require('internal/js_stream_socket');
+
+// The chunks that a wrapped stream emits at once are passed to the handle
+// in one call, and the buffers of one write are written as a single chunk.
+
+const written = [];
+const stream = new Duplex({
+  read() {},
+  write(chunk, encoding, cb) {
+    written.push(chunk);
+    cb();
+  }
+});
+const socket = new JSStreamSocket(stream);
+
+const calls = [];
+const { readBuffer, readBuffers } = socket._handle;
+socket._handle.readBuffer = function(chunk) {
+  calls.push(1);
+  return readBuffer.call(this, chunk);
+};
+socket._handle.readBuffers = function(chunks) {
+  calls.push(chunks.length);
+  return readBuffers.call(this, chunks);
+};
+
+const received = [];
+socket.on('data', (chunk) => received.push(chunk));
+socket.on('end', common.mustCall(() => {
+  assert.deepStrictEqual(calls, [3, 1]);
+  assert.strictEqual(Buffer.concat(received).toString(), 'abcdefghij');
+}));
+
+socket.cork();
+socket.write('kl');
+socket.write('mno');
+socket.uncork();
+socket.write('p', common.mustCall(() => {
+  assert.deepStrictEqual(written.map(String), ['klmno', 'p']);
+}));
+
+stream.push('abc');
+stream.push(Buffer.alloc(0));
+stream.push('defg');
+stream.push('hi');
+setImmediate(() => {
+  stream.push('j');
+  stream.push(null);
+});
@@ -0,0 +1,6 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// The statistics are only available with --pool-array-buffers.
+assert.strictEqual(process.memoryUsage.arrayBufferPool(), undefined);
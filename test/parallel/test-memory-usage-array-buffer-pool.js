@@ -0,0 +1,43 @@
+// Flags: --pool-array-buffers --expose-gc
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+function sizeClass(size) {
+  return process.memoryUsage.arrayBufferPool().find((sizeClass) => {
+    return sizeClass.size === size;
+  });
+}
+
+const statistics = process.memoryUsage.arrayBufferPool();
+assert.deepStrictEqual(statistics.map(({ size }) => size),
+                       Array.from({ length: 16 }, (_, i) => (i + 1) * 1024));
+for (const { allocations, reused, cached } of statistics) {
+  assert(reused <= allocations);
+  assert(Number.isSafeInteger(cached));
+}
+
+{
+  // The blocks are handed out zero-filled, whatever they held before.
+  const before = sizeClass(3072);
+  const lengths = Array.from({ length: 1000 }, () => Buffer.alloc(3000, 1))
+    .map(({ length }) => length);
+  assert.strictEqual(lengths.length, 1000);
+  assert.strictEqual(sizeClass(3072).allocations - before.allocations, 1000);
+  global.gc();
+
+  setImmediate(common.mustCall(() => {
+    global.gc();
+    const reused = sizeClass(3072).reused;
+    const buffers = Array.from({ length: 1000 }, () => new ArrayBuffer(2049));
+    for (const buffer of buffers)
+      assert.deepStrictEqual(new Uint8Array(buffer), new Uint8Array(2049));
+    assert(sizeClass(3072).reused > reused);
+
+    // The sizes outside of the pool are unaffected.
+    const large = sizeClass(16384).allocations;
+    assert.strictEqual(Buffer.alloc(16385).length, 16385);
+    assert.strictEqual(Buffer.alloc(100).length, 100);
+    assert.strictEqual(sizeClass(16384).allocations, large);
+  }));
+}
@@ -0,0 +1,35 @@
+// Flags: --use-largepages-for-heap=silent
+'use strict';
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+// The statistics are only available when huge pages are supported.
+const statistics = process.memoryUsage.largePages();
+if (statistics !== undefined) {
+  assert(statistics.heap > 0);
+  assert(Number.isSafeInteger(statistics.anonHugePages));
+
+  // A backing store of 8 MiB contains at least three whole huge pages.
+  const buffer = Buffer.alloc(8 * 1024 * 1024);
+  const { arrayBuffers } = process.memoryUsage.largePages();
+  assert(arrayBuffers - statistics.arrayBuffers >= 6 * 1024 * 1024);
+  assert.strictEqual(buffer.length, 8 * 1024 * 1024);
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '-p', 'process.memoryUsage.largePages()',
+  ]);
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(child.stdout.toString().trim(), 'undefined');
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--use-largepages-for-heap=always', '-p', '1',
+  ]);
+  assert.notStrictEqual(child.status, 0);
+  assert.match(child.stderr.toString(),
+               /invalid value for --use-largepages-for-heap/);
+}
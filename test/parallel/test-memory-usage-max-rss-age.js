@@ -0,0 +1,39 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+// A value read within maxRssAge is returned from the cache.
+const first = process.memoryUsage();
+const cached = process.memoryUsage({ maxRssAge: 60 * 60 * 1000 });
+assert.strictEqual(cached.rss, first.rss);
+assert.ok(cached.heapTotal > 0);
+assert.ok(cached.heapUsed > 0);
+
+// The default reads the value again.
+if (!common.isIBMi) {
+  const buffers = [];
+  for (let i = 0; i < 16; i++)
+    buffers.push(Buffer.alloc(1024 * 1024, 1));
+  assert.notStrictEqual(process.memoryUsage().rss, first.rss);
+  assert.strictEqual(buffers.length, 16);
+}
+
+const heap = process.memoryUsage.heap();
+assert.deepStrictEqual(Object.keys(heap),
+                       ['heapTotal', 'heapUsed', 'external', 'arrayBuffers']);
+assert.ok(heap.heapTotal > 0);
+assert.ok(heap.heapUsed > 0);
+assert.ok(heap.external > 0);
+assert.strictEqual(typeof heap.arrayBuffers, 'number');
+
+[null, 1, 'foo'].forEach((options) => {
+  assert.throws(() => process.memoryUsage(options), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+});
+
+[-1, 1.5, Infinity].forEach((maxRssAge) => {
+  assert.throws(() => process.memoryUsage({ maxRssAge }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+});
@@ -0,0 +1,74 @@
+'use strict';
+
+// Tests that the CommonJS and ES module loaders share the package.json files
+// that they have read, and still report invalid ones as they used to.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+function writePackage(name, packageJSON) {
+  const dir = path.join(tmpdir.path, 'node_modules', name);
+  fs.mkdirSync(dir, { recursive: true });
+  fs.writeFileSync(path.join(dir, 'package.json'), packageJSON);
+  fs.writeFileSync(path.join(dir, 'main.js'), `module.exports = '${name}';`);
+  return dir;
+}
+
+const parent = path.join(tmpdir.path, 'parent.js');
+const requireFromParent = require('module').createRequire(parent);
+
+(async () => {
+  // Once a package.json file has been read by the CommonJS loader, the ES
+  // module loader uses the same fields without reading it again, so main.js
+  // is still loaded as a CommonJS module.
+  const shared = writePackage('shared', '{ "main": "./main.js" }');
+  assert.strictEqual(requireFromParent('shared'), 'shared');
+  fs.writeFileSync(path.join(shared, 'package.json'),
+                   '{ "main": "./main.js", "type": "module" }');
+  const ns = await import(pathToFileURL(path.join(shared, 'main.js')).href);
+  assert.strictEqual(ns.default, 'shared');
+  assert.strictEqual(
+    require.resolve('shared', { paths: [tmpdir.path] }),
+    path.join(shared, 'main.js'));
+
+  // Invalid files are reported every time that they are used, with the same
+  // message.
+  writePackage('invalid', '{ "main": ');
+  for (let i = 0; i < 2; i++) {
+    assert.throws(() => requireFromParent('invalid'), (err) => {
+      assert.strictEqual(err.name, 'SyntaxError');
+      assert.strictEqual(err.path,
+                         path.join(tmpdir.path, 'node_modules', 'invalid',
+                                   'package.json'));
+      assert.match(err.message, /^Error parsing [^:]+package\.json: /);
+      assert.doesNotMatch(err.message, /Error parsing.*Error parsing/);
+      return true;
+    });
+  }
+
+  // An invalid file without any of the fields that the loaders use is
+  // ignored by the CommonJS loader, but not by the ES module loader.
+  // Without a "main" field, the CommonJS loader falls back to index.js.
+  const ignored = writePackage('ignored', '{ "version": ');
+  fs.writeFileSync(path.join(ignored, 'index.js'), "module.exports = 'index';");
+  assert.strictEqual(requireFromParent('ignored'), 'index');
+  // The ES module loader reads it to find the format of main.js.
+  await assert.rejects(
+    import(pathToFileURL(path.join(ignored, 'main.js')).href),
+    { code: 'ERR_INVALID_PACKAGE_CONFIG' });
+
+  // Missing files and directories.
+  await assert.rejects(
+    import(pathToFileURL(path.join(tmpdir.path, 'missing.mjs')).href),
+    { code: 'ERR_MODULE_NOT_FOUND' });
+  await assert.rejects(import(pathToFileURL(ignored).href),
+                       { code: 'ERR_UNSUPPORTED_DIR_IMPORT' });
+  assert.throws(() => requireFromParent('missing'),
+                { code: 'MODULE_NOT_FOUND' });
+})().then(common.mustCall());
@@ -0,0 +1,52 @@
+// Flags: --realpath-cache-size=2
+'use strict';
+
+const common = require('../common');
+
+// With --realpath-cache-size, the module loaders resolve the real paths of
+// the modules through a cache shared by all threads.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+const { Worker, isMainThread, workerData } = require('worker_threads');
+
+if (!isMainThread) {
+  for (const link of workerData) {
+    const file = require.resolve(link);
+    assert.strictEqual(require(file).file, fs.realpathSync(file));
+  }
+  return;
+}
+
+if (!common.canCreateSymLink())
+  common.skip('insufficient privileges');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const links = [];
+for (let i = 0; i < 4; i++) {
+  const dir = path.join(tmpdir.path, `dir-${i}`);
+  fs.mkdirSync(dir);
+  fs.writeFileSync(path.join(dir, 'index.js'),
+                   'module.exports.file = __filename;');
+  const link = path.join(tmpdir.path, `link-${i}`);
+  fs.symlinkSync(dir, link, 'dir');
+  links.push(link);
+}
+
+// More modules than the cache holds, so that some of them are evicted.
+for (const link of links) {
+  const { file } = require(link);
+  assert.strictEqual(file, fs.realpathSync(path.join(link, 'index.js')));
+}
+
+new Worker(__filename, { workerData: links })
+  .on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+
+const entry = path.join(links[0], 'index.js');
+import(pathToFileURL(entry)).then(common.mustCall((ns) => {
+  assert.strictEqual(ns.default.file, fs.realpathSync(entry));
+}));
@@ -0,0 +1,96 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+function lookupAll(addresses) {
+  return common.mustCall((hostname, options, callback) => {
+    assert.strictEqual(options.all, true);
+    // Answer asynchronously like dns.lookup(), after the 'lookup' listener
+    // has been added.
+    process.nextTick(callback, null, addresses);
+  });
+}
+
+const server = net.createServer((socket) => socket.end('hello'));
+server.listen(0, '127.0.0.1', common.mustCall(async () => {
+  const { port } = server.address();
+
+  // The IPv4 address wins, whether the IPv6 one fails or the blackhole
+  // address does not answer within the attempt delay.
+  for (const addresses of [
+    [{ address: '::1', family: 6 }, { address: '127.0.0.1', family: 4 }],
+    [{ address: '10.255.255.1', family: 4 }, { address: '::1', family: 6 },
+     { address: '127.0.0.1', family: 4 }],
+  ]) {
+    await new Promise((resolve) => {
+      const lookups = [];
+      const socket = net.connect({
+        host: 'example.org',
+        port,
+        autoSelectFamily: true,
+        autoSelectFamilyAttemptDelay: 10,
+        lookup: lookupAll(addresses),
+      });
+      socket.on('lookup', (err, address, family, host) => {
+        assert.ifError(err);
+        assert.strictEqual(host, 'example.org');
+        lookups.push({ address, family });
+      });
+      socket.on('connect', common.mustCall(() => {
+        assert.deepStrictEqual(lookups, addresses);
+        assert.strictEqual(socket.remoteAddress, '127.0.0.1');
+      }));
+      socket.setEncoding('utf8');
+      socket.on('data', common.mustCall((data) => {
+        assert.strictEqual(data, 'hello');
+      }));
+      socket.on('close', common.mustCall(resolve));
+    });
+  }
+
+  // A lookup function that ignores the `all` option still works.
+  await new Promise((resolve) => {
+    net.connect({
+      host: 'example.org',
+      port,
+      autoSelectFamily: true,
+      lookup: common.mustCall((hostname, options, callback) => {
+        callback(null, '127.0.0.1', 4);
+      }),
+    }).on('connect', common.mustCall()).on('close', resolve).resume();
+  });
+
+  server.close(common.mustCall(() => {
+    // All the errors are reported when every attempt fails.
+    net.connect({
+      host: 'example.org',
+      port,
+      autoSelectFamily: true,
+      lookup: lookupAll([
+        { address: '::1', family: 6 },
+        { address: '127.0.0.1', family: 4 },
+      ]),
+    }).on('error', common.mustCall((err) => {
+      assert.strictEqual(err.code, 'ECONNREFUSED');
+      assert.strictEqual(err.address, '127.0.0.1');
+      assert.strictEqual(err.errors.length, 2);
+      assert.strictEqual(err.errors[0].address, '::1');
+      assert.strictEqual(err.errors[1], err);
+    }));
+  }));
+}));
+
+assert.strictEqual(net.getDefaultAutoSelectFamily(), false);
+net.setDefaultAutoSelectFamily(true);
+assert.strictEqual(net.getDefaultAutoSelectFamily(), true);
+net.setDefaultAutoSelectFamily(false);
+assert.throws(() => net.setDefaultAutoSelectFamily(1), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => net.connect({ port: 80, autoSelectFamily: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => {
+  net.connect({ port: 80, autoSelectFamilyAttemptDelay: 1 });
+}, { code: 'ERR_OUT_OF_RANGE' });
@@ -0,0 +1,56 @@
+'use strict';
+
+// The size of the buffers that stream handles read into grows for bulk
+// transfers and shrinks again for small messages.
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const kInitialSize = 64 * 1024;
+const kMinSize = 2 * 1024;
+const kMaxSize = 1024 * 1024;
+const kBulk = 16 * 1024 * 1024;
+const kMessages = 40;
+
+const server = net.createServer(common.mustCall((socket) => {
+  const handle = socket._handle;
+  assert.strictEqual(handle.readBufferSize, kInitialSize);
+  assert.strictEqual(handle.readCount, 0);
+
+  let received = 0;
+  let maxSize = 0;
+  socket.on('data', function onBulk(data) {
+    received += data.length;
+    maxSize = Math.max(maxSize, handle.readBufferSize);
+    if (received < kBulk)
+      return;
+    assert.strictEqual(received, kBulk);
+    assert(maxSize > kInitialSize, `${maxSize}`);
+    assert(maxSize <= kMaxSize, `${maxSize}`);
+    assert(handle.readCount > 0);
+
+    // Exchange small messages one at a time, so that each is read on its own.
+    let messages = 0;
+    socket.off('data', onBulk);
+    socket.on('data', (data) => {
+      assert.strictEqual(data.length, 100);
+      if (++messages < kMessages) {
+        socket.write('x');
+        return;
+      }
+      assert.strictEqual(handle.readBufferSize, kMinSize);
+      socket.end();
+      server.close();
+    });
+    socket.write('x');
+  });
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    client.write(Buffer.alloc(kBulk));
+  }));
+  client.on('data', () => client.write(Buffer.alloc(100)));
+  client.on('end', common.mustCall(() => client.end()));
+}));
@@ -0,0 +1,48 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Only the first `burst` connections from an address reach the server when
+// the rate is too low for the bucket to be refilled.
+const server = net.createServer({
+  connectionRateLimit: { rate: 0.001, burst: 2 }
+}, common.mustCall((socket) => {
+  socket.end('accepted');
+}, 2));
+
+server.listen(0, common.mustCall(async () => {
+  const results = [];
+  for (let n = 0; n < 4; n++) {
+    results.push(await new Promise((resolve) => {
+      let data = '';
+      const client = net.connect(server.address().port, '127.0.0.1');
+      client.setEncoding('utf8');
+      client.on('data', (chunk) => data += chunk);
+      client.on('error', () => {});
+      client.on('close', () => resolve(data));
+    }));
+  }
+  assert.deepStrictEqual(results, ['accepted', 'accepted', '', '']);
+  server.close();
+}));
+
+for (const connectionRateLimit of [1, null, 'limit']) {
+  assert.throws(() => net.createServer({ connectionRateLimit }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+assert.throws(() => net.createServer({ connectionRateLimit: {} }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+for (const rate of [0, -1, NaN, Infinity]) {
+  assert.throws(() => net.createServer({ connectionRateLimit: { rate } }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => {
+  net.createServer({ connectionRateLimit: { rate: 10, burst: 0.5 } });
+}, { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => {
+  net.createServer({ connectionRateLimit: { rate: 10, maxAddresses: 0 } });
+}, { code: 'ERR_OUT_OF_RANGE' });
@@ -0,0 +1,92 @@
+'use strict';
+
+// The sockets of a server with `ioThread: true` are read from and written to
+// on an I/O thread, and otherwise behave like other sockets.
+
+const common = require('../common');
+if (common.isWindows)
+  common.skip('The I/O thread is not used on Windows');
+
+const assert = require('assert');
+const net = require('net');
+
+assert.throws(() => net.createServer({ ioThread: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+const kBulk = 8 * 1024 * 1024;
+
+{
+  // Echo, with a bulk transfer in both directions.
+  const server = net.createServer({ ioThread: true }, common.mustCall((c) => {
+    assert.strictEqual(c._handle.constructor.name, 'IOThreadStream');
+    assert.strictEqual(c.remoteAddress, '127.0.0.1');
+    assert.strictEqual(c.localPort, server.address().port);
+    assert.strictEqual(c.getTCPInfo(), undefined);
+    c.setNoDelay(true);
+    c.pipe(c);
+  }));
+
+  server.listen(0, '127.0.0.1', common.mustCall(() => {
+    const client = net.connect(server.address().port, '127.0.0.1');
+    const data = Buffer.alloc(kBulk);
+    for (let i = 0; i < data.length; i++)
+      data[i] = i % 251;
+    client.end(data);
+
+    const chunks = [];
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), data);
+      server.close();
+    }));
+  }));
+}
+
+{
+  // Nothing is lost while the socket is paused.
+  const server = net.createServer({
+    ioThread: true,
+    pauseOnConnect: true
+  }, common.mustCall((c) => {
+    let received = 0;
+    setTimeout(() => {
+      c.on('data', (chunk) => {
+        received += chunk.length;
+        c.pause();
+        setImmediate(() => c.resume());
+      });
+      c.on('end', common.mustCall(() => {
+        assert.strictEqual(received, kBulk);
+        server.close();
+      }));
+      c.resume();
+    }, 100);
+  }));
+
+  server.listen(0, '127.0.0.1', common.mustCall(() => {
+    const client = net.connect(server.address().port, '127.0.0.1');
+    client.end(Buffer.alloc(kBulk));
+  }));
+}
+
+{
+  // Destroying a socket with writes that have not completed yet.
+  let client;
+  const server = net.createServer({ ioThread: true }, common.mustCall((c) => {
+    c.on('close', common.mustCall(() => {
+      server.close();
+      // Let the client find out that the connection is gone.
+      client.resume();
+    }));
+    c.write(Buffer.alloc(kBulk));
+    setImmediate(() => c.destroy());
+  }));
+
+  server.listen(0, '127.0.0.1', common.mustCall(() => {
+    client = net.connect(server.address().port, '127.0.0.1');
+    client.pause();
+    client.on('error', () => {});
+    client.on('close', common.mustCall());
+  }));
+}
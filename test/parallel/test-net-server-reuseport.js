@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// With reusePort, several servers can listen on the same port, and every
+// connection is accepted by exactly one of them.
+
+const supported = common.isLinux || common.isFreeBSD ||
+                  process.platform === 'dragonfly';
+
+if (!supported) {
+  net.createServer().listen({ port: 0, reusePort: true })
+    .on('error', common.mustCall((err) => {
+      assert.strictEqual(err.code, 'ENOTSUP');
+    }));
+  return;
+}
+
+const connections = 10;
+let accepted = 0;
+
+function onConnection(socket) {
+  socket.end();
+  if (++accepted === connections) {
+    server1.close();
+    server2.close();
+  }
+}
+
+const server1 = net.createServer(onConnection);
+const server2 = net.createServer(onConnection);
+
+server1.listen({
+  port: 0,
+  host: common.localhostIPv4,
+  reusePort: true,
+}, common.mustCall(() => {
+  const { port } = server1.address();
+
+  // Without reusePort on both sides, the port is taken.
+  net.createServer().listen({ port, host: common.localhostIPv4 })
+    .on('error', common.mustCall((err) => {
+      assert.strictEqual(err.code, 'EADDRINUSE');
+    }));
+
+  server2.listen({
+    port,
+    host: common.localhostIPv4,
+    reusePort: true,
+  }, common.mustCall(() => {
+    assert.strictEqual(server2.address().port, port);
+    for (let i = 0; i < connections; i++)
+      net.connect(port, common.localhostIPv4).resume();
+  }));
+}));
@@ -0,0 +1,45 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+assert.throws(() => new net.Socket({ autoCork: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => net.createServer({ autoCork: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+// Writes from the same tick reach the handle as a single writev().
+const server = net.createServer({ autoCork: true }, common.mustCall((conn) => {
+  conn._writev = common.mustCall(conn._writev);
+  conn._write = common.mustNotCall();
+  conn.write('header ');
+  conn.write('body ');
+  conn.end('trailer');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect({
+    port: server.address().port,
+    autoCork: true,
+  }, common.mustCall(() => {
+    const writev = client._writev;
+    client._writev = common.mustCall(function(chunks, cb) {
+      assert.strictEqual(chunks.length, 3);
+      return writev.call(this, chunks, cb);
+    });
+    client.write('a');
+    client.write('b');
+    assert.strictEqual(client.write('c'), true);
+  }));
+
+  let received = '';
+  client.setEncoding('utf8');
+  client.on('data', (chunk) => received += chunk);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(received, 'header body trailer');
+    client.end();
+    server.close();
+  }));
+}));
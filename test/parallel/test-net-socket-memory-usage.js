@@ -0,0 +1,37 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// socket.memoryUsage() reports the native memory of a socket, including
+// the HTTP parser that is attached to it.
+
+const server = http.createServer(common.mustCall((req, res) => {
+  const { socket } = req;
+  const usage = socket.memoryUsage();
+  assert(Number.isSafeInteger(usage));
+  assert(usage > 0);
+
+  const parser = socket.parser;
+  socket.parser = null;
+  assert(socket.memoryUsage() < usage);
+  socket.parser = parser;
+
+  res.end('ok');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port, common.mustCall(() => {
+    assert(socket.memoryUsage() > 0);
+    socket.write('GET / HTTP/1.1\r\nHost: localhost\r\n' +
+                 'Connection: close\r\n\r\n');
+  }));
+  socket.resume();
+  socket.on('close', common.mustCall(() => {
+    assert.strictEqual(socket.memoryUsage(), 0);
+    server.close();
+  }));
+}));
+
+assert.strictEqual(new net.Socket().memoryUsage(), 0);
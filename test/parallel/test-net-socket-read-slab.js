@@ -0,0 +1,42 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Small reads from sockets go through a slab that is shared by all streams.
+// Make sure that the data is copied out of it, so that each chunk owns its
+// memory and its contents survive later reads.
+
+const messages = ['first', 'second', 'third', 'fourth'];
+
+const server = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (chunk) => {
+    chunks.push(chunk);
+    socket.write('ack');
+  });
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(chunks.map(String), messages);
+    for (const chunk of chunks) {
+      assert.strictEqual(chunk.byteOffset, 0);
+      assert.strictEqual(chunk.buffer.byteLength, chunk.length);
+    }
+    assert.strictEqual(new Set(chunks.map((chunk) => chunk.buffer)).size,
+                       chunks.length);
+    socket.end();
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    let i = 0;
+    client.write(messages[i++]);
+    client.on('data', () => {
+      if (i < messages.length)
+        client.write(messages[i++]);
+      else
+        client.end();
+    });
+  }));
+}));
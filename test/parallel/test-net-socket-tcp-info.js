@@ -0,0 +1,68 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { createHistogram } = require('perf_hooks');
+
+const fields = [
+  'state', 'rtt', 'rttVar', 'minRtt', 'rto', 'sndCwnd', 'sndSsthresh',
+  'sndMss', 'unacked', 'lost', 'retransmits', 'totalRetrans', 'deliveryRate',
+  'bytesAcked', 'bytesReceived',
+];
+
+assert.throws(() => new net.Socket().setRTTHistogram({}), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+
+const histogram = createHistogram();
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.setRTTHistogram(histogram);
+  socket.on('data', common.mustCall(() => socket.end('pong')));
+  socket.on('close', common.mustCall(() => {
+    assert.strictEqual(socket.getTCPInfo(), undefined);
+    // The RTT of the connection was recorded when the socket was closed.
+    if (common.isLinux)
+      assert(histogram.max > 0);
+    else
+      assert.strictEqual(histogram.max, 0);
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    const info = client.getTCPInfo();
+    if (!common.isLinux) {
+      assert.strictEqual(info, undefined);
+      client.end('ping');
+      return;
+    }
+    assert.deepStrictEqual(Object.keys(info), fields);
+    for (const field of fields)
+      assert.strictEqual(typeof info[field], 'number');
+    // TCP_ESTABLISHED
+    assert.strictEqual(info.state, 1);
+    assert(info.sndMss > 0);
+    client.end('ping');
+  }));
+  client.resume();
+  client.on('close', common.mustCall(() => {
+    assert.strictEqual(client.getTCPInfo(), undefined);
+  }));
+}));
+
+// Pipes have no TCP_INFO.
+if (!common.isWindows) {
+  const tmpdir = require('../common/tmpdir');
+  tmpdir.refresh();
+  const pipeServer = net.createServer((socket) => socket.resume());
+  pipeServer.listen(common.PIPE, common.mustCall(() => {
+    const client = net.connect(common.PIPE, common.mustCall(() => {
+      assert.strictEqual(client.getTCPInfo(), undefined);
+      client.destroy();
+      pipeServer.close();
+    }));
+  }));
+}
@@ -0,0 +1,43 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// The requests of writes that were done synchronously are reused for later
+// writes, while the ones of pending writes are not.
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.resume();
+  socket.on('end', common.mustCall(() => socket.end()));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    const handle = client._handle;
+    const { writeUtf8String } = handle;
+    const reqs = [];
+    const pending = new Set();
+    handle.writeUtf8String = function(req, data) {
+      assert(!pending.has(req));
+      assert.strictEqual(typeof req.callback, 'function');
+      const ret = writeUtf8String.call(this, req, data);
+      reqs.push(req);
+      return ret;
+    };
+
+    let count = 0;
+    function write() {
+      if (count++ === 20) {
+        assert(new Set(reqs).size < reqs.length);
+        client.end();
+        return;
+      }
+      client.write('x', common.mustSucceed(write));
+      const req = reqs[reqs.length - 1];
+      if (req.async)
+        pending.add(req);
+    }
+    write();
+  }));
+  client.on('close', common.mustCall(() => server.close()));
+}));
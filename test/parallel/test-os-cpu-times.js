@@ -0,0 +1,42 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const os = require('os');
+
+const count = os.cpus().length;
+
+const times = os.cpuTimes();
+assert.ok(times instanceof Float64Array);
+assert.strictEqual(times.length, count * 5);
+for (const value of times)
+  assert.ok(value >= 0);
+
+// An array that is large enough is filled and returned.
+const larger = new Float64Array(count * 5 + 1).fill(-1);
+assert.strictEqual(os.cpuTimes(larger), larger);
+assert.ok(larger[0] >= 0);
+assert.strictEqual(larger[count * 5], -1);
+
+// The counters only increase.
+const later = os.cpuTimes(new Float64Array(count * 5));
+for (let i = 0; i < times.length; i++)
+  assert.ok(later[i] >= times[i]);
+
+// Views are written at their offset.
+const buffer = new ArrayBuffer((count * 5 + 1) * 8);
+const view = new Float64Array(buffer, 8);
+os.cpuTimes(view);
+assert.strictEqual(new Float64Array(buffer)[0], 0);
+assert.ok(view[0] >= 0);
+
+// A smaller array is replaced.
+const small = new Float64Array(count * 5 - 1);
+const replaced = os.cpuTimes(small);
+assert.notStrictEqual(replaced, small);
+assert.strictEqual(replaced.length, count * 5);
+
+[null, 1, [], new Uint8Array(8)].forEach((value) => {
+  assert.throws(() => os.cpuTimes(value), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+});
@@ -0,0 +1,44 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { monitorEventLoopPhases } = require('perf_hooks');
+
+const phases = monitorEventLoopPhases();
+assert.deepStrictEqual(Object.keys(phases),
+                       ['timers', 'pending', 'poll', 'check', 'close']);
+for (const { time, callbacks } of Object.values(phases)) {
+  assert.strictEqual(time.max, 0);
+  assert.strictEqual(callbacks.max, 0);
+}
+
+function spin(ms) {
+  const end = Date.now() + ms;
+  while (Date.now() < end);
+}
+
+// Each phase gets a callback that blocks the event loop for a while.
+setTimeout(common.mustCall(() => {
+  spin(50);
+  fs.stat(__filename, common.mustSucceed(() => {
+    spin(50);
+    setImmediate(common.mustCall(() => {
+      spin(50);
+      setTimeout(common.mustCall(check), 200);
+    }));
+  }));
+}), 1);
+
+function check() {
+  // Later calls report the same histograms.
+  const { timers, poll, check } = monitorEventLoopPhases();
+  for (const { time, callbacks } of [timers, poll, check]) {
+    assert(time.max >= 50e6, `${time.max}`);
+    assert(callbacks.max >= 1);
+  }
+  // The time spent waiting for the last timer is not counted in the poll
+  // phase.
+  assert(poll.time.max < 200e6, `${poll.time.max}`);
+  timers.time.reset();
+  assert.strictEqual(phases.timers.time.max, 0);
+}
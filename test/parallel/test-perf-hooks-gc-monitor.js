@@ -0,0 +1,41 @@
+// Flags: --expose-gc
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const { monitorGC } = require('perf_hooks');
+
+const monitor = monitorGC();
+assert.deepStrictEqual(Object.keys(monitor.pause).sort(), [
+  'incrementalMarking',
+  'markSweepCompact',
+  'processWeakCallbacks',
+  'scavenge',
+]);
+
+const before = monitor.stats();
+assert.strictEqual(before.markSweepCompact.count, 0);
+assert(before.heapSpaces.old_space.used > 0);
+assert(before.heapSpaces.old_space.size >= before.heapSpaces.old_space.used);
+
+let garbage = [];
+for (let i = 0; i < 1e5; i++)
+  garbage.push({ i });
+garbage = null;
+global.gc();
+global.gc({ type: 'minor' });
+
+const after = monitor.stats();
+assert(after.markSweepCompact.count >= 1);
+assert(after.markSweepCompact.pauseTime > 0);
+assert(after.scavenge.count >= 1);
+assert(after.bytesAllocated > 1e5);
+assert(after.bytesFreed > 0);
+assert(after.bytesPromoted >= 0);
+assert(monitor.pause.markSweepCompact.max > 0);
+assert(monitor.allocationRate.max > 0);
+
+// Every call returns views of the same histograms and counters.
+const other = monitorGC();
+assert.strictEqual(other.pause.scavenge.max, monitor.pause.scavenge.max);
+assert.deepStrictEqual(other.stats(), monitor.stats());
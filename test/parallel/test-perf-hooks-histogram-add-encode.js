@@ -0,0 +1,140 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const {
+  createHistogram,
+  decodeHistogram,
+  monitorEventLoopDelay,
+} = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+function assertSameHistogram(actual, expected) {
+  assert.strictEqual(actual.min, expected.min);
+  assert.strictEqual(actual.max, expected.max);
+  assert.strictEqual(actual.mean, expected.mean);
+  assert.strictEqual(actual.stddev, expected.stddev);
+  assert.deepStrictEqual(actual.percentiles, expected.percentiles);
+}
+
+{
+  const a = createHistogram();
+  const b = createHistogram();
+  a.record(1);
+  a.record(10);
+  b.record(100);
+  b.record(1e9);
+  a.add(b);
+  assert.strictEqual(a.min, 1);
+  assert.strictEqual(a.max, b.max);
+  assert.strictEqual(a.percentile(50), 10);
+  assert.strictEqual(b.min, 100);
+
+  // Adding a histogram to itself doubles its counts.
+  const c = createHistogram();
+  c.record(5);
+  c.record(6);
+  c.add(c);
+  assert.strictEqual(c.percentile(25), 5);
+  assert.strictEqual(c.percentile(75), 6);
+  assert.strictEqual(c.mean, 5.5);
+
+  // The handles of other kinds of histograms can be added as well.
+  const delay = monitorEventLoopDelay();
+  c.add(delay);
+
+  [undefined, null, 1, {}, { record() {} }].forEach((other) => {
+    assert.throws(() => a.add(other), { code: 'ERR_INVALID_ARG_TYPE' });
+  });
+}
+
+{
+  const h = createHistogram();
+  for (let n = 1; n <= 1000; n++)
+    h.record(n * n);
+  const encoded = h.encode();
+  assert.strictEqual(typeof encoded, 'string');
+  assert(encoded.startsWith('HISTF'), encoded);
+  assertSameHistogram(decodeHistogram(encoded), h);
+
+  // An empty histogram can be encoded too.
+  const empty = createHistogram();
+  assertSameHistogram(decodeHistogram(empty.encode()), empty);
+
+  // The decoded histogram can be recorded into.
+  const decoded = decodeHistogram(encoded);
+  const expected = createHistogram();
+  expected.record(2e6);
+  decoded.record(2e6);
+  assert.strictEqual(decoded.max, expected.max);
+
+  assert.strictEqual(typeof monitorEventLoopDelay().encode(), 'string');
+}
+
+{
+  // A histogram that is encoded by hand in the V2 format: 3 counts of 5,
+  // i.e. a run of 5 zeros followed by a 3, as ZigZag integers.
+  const payload = Buffer.from([9, 6]);
+  const header = Buffer.alloc(40);
+  header.writeUInt32BE(0x1c849313, 0);
+  header.writeUInt32BE(payload.length, 4);
+  header.writeUInt32BE(0, 8);
+  header.writeUInt32BE(3, 12);
+  header.writeBigUInt64BE(1n, 16);
+  header.writeBigUInt64BE(1000000n, 24);
+  header.writeDoubleBE(1, 32);
+  const compressed = zlib.deflateSync(Buffer.concat([header, payload]));
+  const prefix = Buffer.alloc(8);
+  prefix.writeUInt32BE(0x1c849314, 0);
+  prefix.writeUInt32BE(compressed.length, 4);
+  const encoded = Buffer.concat([prefix, compressed]).toString('base64');
+
+  const h = decodeHistogram(encoded);
+  assert.strictEqual(h.min, 5);
+  assert.strictEqual(h.max, 5);
+  assert.strictEqual(h.percentile(100), 5);
+
+  const expected = createHistogram();
+  expected.record(5);
+  expected.record(5);
+  expected.record(5);
+  assertSameHistogram(h, expected);
+
+  // Truncated or corrupted data is rejected.
+  const raw = Buffer.from(encoded, 'base64');
+  [
+    raw.slice(0, 4),
+    raw.slice(0, raw.length - 1),
+    Buffer.concat([Buffer.from([0, 0, 0, 0]), raw.slice(4)]),
+    Buffer.alloc(64),
+  ].forEach((data) => {
+    assert.throws(() => decodeHistogram(data.toString('base64')), {
+      code: 'ERR_INVALID_ARG_VALUE'
+    });
+  });
+  assert.throws(() => decodeHistogram(1), { code: 'ERR_INVALID_ARG_TYPE' });
+}
+
+{
+  // The histograms that are sent to workers can be aggregated without
+  // encoding them.
+  const histograms = [createHistogram(), createHistogram()];
+  let exited = 0;
+  histograms.forEach((histogram, n) => {
+    const worker = new Worker(`
+      const { workerData } = require('worker_threads');
+      workerData.record(${n + 1});
+      workerData.record(${n + 1} * 1000);
+    `, { eval: true, workerData: histogram });
+    worker.on('exit', common.mustCall(() => {
+      if (++exited < histograms.length)
+        return;
+      const total = createHistogram();
+      histograms.forEach((histogram) => total.add(histogram));
+      assert.strictEqual(total.min, 1);
+      assert.strictEqual(total.percentile(50), 2);
+      assert.strictEqual(total.max, 2000);
+    }));
+  });
+}
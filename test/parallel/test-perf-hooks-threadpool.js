@@ -0,0 +1,40 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const crypto = require('crypto');
+const zlib = require('zlib');
+const { monitorThreadpool } = require('perf_hooks');
+
+const histograms = monitorThreadpool();
+assert.deepStrictEqual(Object.keys(histograms),
+                       ['crypto', 'zlib', 'napi', 'other']);
+for (const { wait, run } of Object.values(histograms)) {
+  assert.strictEqual(wait.min, 9223372036854776000);
+  assert.strictEqual(run.max, 0);
+}
+
+const count = 4;
+let pending = count * 2;
+const done = common.mustCall(() => {
+  if (--pending > 0)
+    return;
+  // Later calls report the same histograms.
+  const { crypto: cryptoWork, zlib: zlibWork, napi } = monitorThreadpool();
+  for (const { wait, run } of [cryptoWork, zlibWork]) {
+    assert(wait.min >= 1);
+    assert(run.min >= 1);
+    assert(wait.max >= wait.min);
+    assert(run.max >= run.min);
+    assert(run.percentile(50) > 0);
+  }
+  assert.strictEqual(napi.run.max, 0);
+  cryptoWork.run.reset();
+  assert.strictEqual(histograms.crypto.run.max, 0);
+}, count * 2);
+
+for (let i = 0; i < count; i++) {
+  crypto.pbkdf2('secret', 'salt', 1000, 32, 'sha256', common.mustSucceed(done));
+  zlib.deflate(Buffer.alloc(1024), common.mustSucceed(done));
+}
@@ -0,0 +1,18 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+
+// performance.now() is relative to the time origin and monotonic.
+const start = performance.now();
+assert.strictEqual(typeof start, 'number');
+assert.ok(start > 0);
+
+let last = start;
+for (let i = 0; i < 1e5; i++) {
+  const value = performance.now();
+  assert.ok(value >= last, `${value} >= ${last}`);
+  last = value;
+}
+
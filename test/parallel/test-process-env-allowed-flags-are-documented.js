@@ -51,6 +51,7 @@ const conditionalOpts = [
         '--use-openssl-ca',
         '--secure-heap',
         '--secure-heap-min',
+        '--crypto-kdf-threads',
         '--enable-fips',
         '--force-fips',
       ].includes(opt);
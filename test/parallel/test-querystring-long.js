@@ -0,0 +1,126 @@
+'use strict';
+
+// Long inputs are parsed, escaped and unescaped in C++. Make sure that the
+// results match the ones for short inputs, which are handled in JS.
+
+require('../common');
+const assert = require('assert');
+const qs = require('querystring');
+
+const padKey = 'k'.repeat(64);
+const padValue = 'v'.repeat(64);
+
+const inputs = [
+  '',
+  'a',
+  'a=',
+  '=b',
+  '=',
+  '+',
+  'a=b=c',
+  'a=b&a=c&a=d',
+  '&&a=b&&',
+  'a+b=c+d',
+  '%61=%62',
+  '%6=%zz',
+  '%',
+  '%%41',
+  '%41%',
+  '%4+1=%4+1',
+  '%C3%A9=%E2%82%AC',
+  '%C3=%FF%FE',
+  '%ED%A0%80',
+  'é=€',
+  'é%=€%41',
+  'é%FF=%C3€',
+  '%C3©',
+  '�=�%41',
+  '\uD800=\uDC00',
+  '\uD800%41=\uDC00%zz',
+  '\u{1F600}=\u{1F601}',
+  'a\0b=c',
+  '__proto__=1&hasOwnProperty=2',
+];
+
+function parse(input, sep = '&', eq = '=', options) {
+  return { ...qs.parse(input, sep, eq, options) };
+}
+
+for (const [sep, eq] of [['&', '='], [';', ':'], ['=', '&'], ['+', '%']]) {
+  const pad = `${padKey}${eq}${padValue}`;
+  for (let input of inputs) {
+    input = input.replace(/&/g, '\u{1}').replace(/=/g, '\u{2}')
+                 .replace(/\u{1}/gu, sep).replace(/\u{2}/gu, eq);
+    const expected = parse(input, sep, eq);
+    assert.deepStrictEqual(
+      parse(`${input}${sep}${pad}`, sep, eq),
+      { ...expected, [padKey]: padValue },
+      input);
+    assert.deepStrictEqual(
+      parse(`${pad}${sep}${input}`, sep, eq),
+      { [padKey]: padValue, ...expected },
+      input);
+  }
+}
+
+// maxKeys counts empty pairs, too.
+{
+  const input = `a=1&&b=2&${padKey}=${padValue}&c=3`;
+  assert.deepStrictEqual(parse(input, '&', '=', { maxKeys: 1 }), { a: '1' });
+  assert.deepStrictEqual(parse(input, '&', '=', { maxKeys: 2 }), { a: '1' });
+  assert.deepStrictEqual(parse(input, '&', '=', { maxKeys: 3 }),
+                         { a: '1', b: '2' });
+  assert.deepStrictEqual(parse(input, '&', '=', { maxKeys: 0 }),
+                         { a: '1', b: '2', [padKey]: padValue, c: '3' });
+  assert.deepStrictEqual(parse(input, '&', '=', { maxKeys: 1.5 }),
+                         { a: '1', b: '2', [padKey]: padValue, c: '3' });
+}
+
+// A custom decoder and multi-character separators are handled in JS.
+{
+  const input = `a=%41&${padKey}=${padValue}`;
+  assert.deepStrictEqual(
+    parse(input, '&', '=', { decodeURIComponent: (s) => `[${s}]` }),
+    { '[a]': '[%41]', [`[${padKey}]`]: `[${padValue}]` });
+  assert.deepStrictEqual(parse(input.replace('&', '&&'), '&&'),
+                         { a: 'A', [padKey]: padValue });
+}
+
+// Overriding querystring.unescapeBuffer() keeps working.
+{
+  const original = qs.unescapeBuffer;
+  qs.unescapeBuffer = () => Buffer.from('override');
+  try {
+    assert.deepStrictEqual(parse(`a=%41%&${padKey}=${padValue}`),
+                           { a: 'override', [padKey]: padValue });
+  } finally {
+    qs.unescapeBuffer = original;
+  }
+}
+
+{
+  const pad = 'z'.repeat(64);
+  const values = [
+    '', 'a b', 'A-Z_a.z~0!9*\'()', '&=+%#?/', '\0\x7f\x80\xff', 'é€',
+    '\u{1F600}', '�', '%', '%4', '%41', '%4z', '%zz', '+%2B+',
+    'Ł%41', '\uD800%41',
+  ];
+  for (const value of values) {
+    if (!/[\uD800-\uDFFF]/.test(value)) {
+      assert.strictEqual(qs.escape(value + pad), qs.escape(value) + pad);
+      assert.strictEqual(qs.escape(pad + value), pad + qs.escape(value));
+    }
+    for (const decodeSpaces of [false, true]) {
+      assert.deepStrictEqual(
+        qs.unescapeBuffer(value + pad, decodeSpaces),
+        Buffer.concat([qs.unescapeBuffer(value, decodeSpaces),
+                       Buffer.from(pad)]));
+    }
+  }
+
+  assert.strictEqual(qs.escape(pad), pad);
+  assert.throws(() => qs.escape(`${pad}\uD800`), {
+    code: 'ERR_INVALID_URI',
+    name: 'URIError'
+  });
+}
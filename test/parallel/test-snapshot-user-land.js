@@ -0,0 +1,101 @@
+'use strict';
+
+// Tests that an application can be snapshotted with --build-snapshot, and
+// started again from the snapshot with --snapshot-blob.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const tmpdir = require('../common/tmpdir');
+
+// The APIs can only be used while building a snapshot.
+assert.strictEqual(v8.startupSnapshot.isBuildingSnapshot(), false);
+for (const method of ['addSerializeCallback',
+                      'addDeserializeCallback',
+                      'setDeserializeMainFunction']) {
+  assert.throws(() => v8.startupSnapshot[method](() => {}), {
+    code: 'ERR_NOT_BUILDING_SNAPSHOT',
+  });
+}
+
+tmpdir.refresh();
+const blob = path.join(tmpdir.path, 'snapshot.blob');
+const entry = path.join(tmpdir.path, 'entry.js');
+fs.writeFileSync(path.join(tmpdir.path, 'dep.js'), `
+  globalThis.depLoads = (globalThis.depLoads || 0) + 1;
+  module.exports = { words: ['a', 'b', 'c'] };
+`);
+fs.writeFileSync(entry, `
+  'use strict';
+  const v8 = require('v8');
+  const assert = require('assert');
+  const { words } = require('./dep');
+  assert.strictEqual(v8.startupSnapshot.isBuildingSnapshot(), true);
+  const state = { serialized: false, resource: 'open' };
+  v8.startupSnapshot.addSerializeCallback((data) => {
+    data.serialized = true;
+    data.resource = 'closed';
+  }, state);
+  v8.startupSnapshot.addDeserializeCallback((data) => {
+    data.resource = 'reopened';
+  }, state);
+  v8.startupSnapshot.setDeserializeMainFunction((data) => {
+    require('./dep');
+    console.log(JSON.stringify({
+      words,
+      state: data,
+      depLoads: globalThis.depLoads,
+      argv: process.argv.slice(2),
+      building: v8.startupSnapshot.isBuildingSnapshot(),
+    }));
+  }, state);
+  assert.throws(() => v8.startupSnapshot.setDeserializeMainFunction(() => {}),
+                { code: 'ERR_DUPLICATE_STARTUP_SNAPSHOT_MAIN_FUNCTION' });
+  console.log('building');
+`);
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blob, '--build-snapshot', entry,
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assert.strictEqual(child.stdout.toString().trim(), 'building');
+  assert(fs.statSync(blob).size > 0);
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', blob, 'foo', 'bar',
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assert.deepStrictEqual(JSON.parse(child.stdout.toString()), {
+    words: ['a', 'b', 'c'],
+    state: { serialized: true, resource: 'reopened' },
+    depLoads: 1,
+    argv: ['foo', 'bar'],
+    building: false,
+  });
+}
+
+// Built-in modules that cannot be snapshotted throw while building.
+{
+  const unsupported = path.join(tmpdir.path, 'unsupported.js');
+  fs.writeFileSync(unsupported, "require('zlib');");
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', path.join(tmpdir.path, 'unsupported.blob'),
+    '--build-snapshot', unsupported,
+  ], { cwd: tmpdir.path });
+  assert.notStrictEqual(child.status, 0);
+  assert.match(child.stderr.toString(), /ERR_NOT_SUPPORTED_IN_SNAPSHOT/);
+}
+
+// Starting from a file that is not a snapshot fails.
+{
+  const child = spawnSync(process.execPath, [
+    '--snapshot-blob', entry, '-e', '0',
+  ], { cwd: tmpdir.path });
+  assert.strictEqual(child.status, 1);
+}
@@ -0,0 +1,30 @@
+'use strict';
+
+// Tests that a script that does not use them does not load the bindings and
+// modules of features that are only set up on first use, and that
+// NODE_DEBUG_NATIVE=LOADER reports what is loaded at runtime.
+
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const fixtures = require('../common/fixtures');
+
+const child = spawnSync(process.execPath, [fixtures.path('empty.js')], {
+  env: { ...process.env, NODE_DEBUG_NATIVE: 'LOADER' },
+});
+assert.strictEqual(child.status, 0);
+const stderr = child.stderr.toString();
+
+assert.match(stderr, /Initialized internal binding \w+ in \d+ us/);
+assert.match(stderr,
+             /Compiled built-in module internal\/modules\/cjs\/loader with(out)? code cache in \d+ us/);
+
+for (const binding of ['crypto', 'fs_event_wrap', 'http2', 'report', 'zlib'])
+  assert.doesNotMatch(stderr, new RegExp(`internal binding ${binding} `));
+for (const id of ['internal/fs/promises', 'internal/inspector_async_hook',
+                  'internal/process/report']) {
+  assert.doesNotMatch(stderr, new RegExp(`built-in module ${id} `));
+}
+
+// The report is still available on first use.
+assert.strictEqual(typeof process.report.getReport, 'function');
@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+if (process.argv[2] === 'lines') {
+  process.stdout.setCoalescing({ size: 1024 });
+  for (let i = 0; i < 1000; i++)
+    console.log(`line ${i}`);
+  return;
+}
+
+if (process.argv[2] === 'exit') {
+  process.stdout.setCoalescing({ interval: 60 * 1000 });
+  process.stdout.write('before exit\n');
+  process.exit(0);
+}
+
+if (process.argv[2] === 'drop') {
+  process.stdout.setCoalescing({ maxBuffered: 0 });
+  process.stdout.write('dropped\n', common.mustCall());
+  console.log('dropped');
+  process.stdout.setCoalescing(false);
+  console.log(process.stdout.droppedWrites);
+  return;
+}
+
+function run(mode) {
+  const child = spawnSync(process.execPath, [__filename, mode]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return child.stdout.toString();
+}
+
+const expected = [];
+for (let i = 0; i < 1000; i++)
+  expected.push(`line ${i}\n`);
+assert.strictEqual(run('lines'), expected.join(''));
+
+assert.strictEqual(run('exit'), 'before exit\n');
+assert.strictEqual(run('drop'), '2\n');
+
+for (const stream of [process.stdout, process.stderr]) {
+  assert.strictEqual(stream.droppedWrites, 0);
+  [null, 1, 'foo'].forEach((options) => {
+    assert.throws(() => stream.setCoalescing(options), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+  });
+  ['size', 'interval', 'maxBuffered'].forEach((name) => {
+    assert.throws(() => stream.setCoalescing({ [name]: -1 }), {
+      code: 'ERR_OUT_OF_RANGE'
+    });
+  });
+}
@@ -0,0 +1,50 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+const { internalBinding } = require('internal/test/binding');
+const { FileHandle } = internalBinding('fs');
+const { StreamPipe } = internalBinding('stream_pipe');
+
+// Pipe a range of a file natively into a TCP connection. On Linux, this uses
+// sendfile() rather than reading the file contents into user space memory.
+
+tmpdir.refresh();
+const filename = path.join(tmpdir.path, 'stream-pipe-file-to-socket.bin');
+const contents = Buffer.alloc(8 * 1024 * 1024);
+for (let i = 0; i < contents.length; i++)
+  contents[i] = i % 251;
+fs.writeFileSync(filename, contents);
+
+const offset = 12345;
+const length = contents.length - 2 * offset;
+const expected = contents.subarray(offset, offset + length);
+
+const server = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), expected);
+    socket.end();
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const sink = net.connect(server.address().port, common.mustCall(() => {
+    const handle = new FileHandle(fs.openSync(filename, 'r'), offset, length);
+    handle.onread = common.mustCall();
+    const pipe = new StreamPipe(handle, sink._handle);
+    pipe.onunpipe = common.mustCall(() => {
+      assert.strictEqual(handle.bytesRead, length);
+      assert.strictEqual(sink._handle.bytesWritten, length);
+      handle.close().then(common.mustCall());
+      sink.destroy();
+    });
+    pipe.start();
+  }));
+}));
@@ -0,0 +1,49 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const { StreamPipe } = internalBinding('stream_pipe');
+
+// Pipe data natively from one TCP connection into another one. On Linux,
+// this uses splice() rather than copying the data through user space, but
+// the observable behavior, including the byte counters, is the same.
+
+const payload = Buffer.alloc(4 * 1024 * 1024, 'abcdefgh');
+
+const sinkServer = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), payload);
+    socket.end();
+    sinkServer.close();
+  }));
+}));
+
+// The source must not read anything into JS before the pipe takes over.
+const sourceServer = net.createServer({
+  pauseOnConnect: true
+}, common.mustCall((source) => {
+  const sink = net.connect(sinkServer.address().port, common.mustCall(() => {
+    const pipe = new StreamPipe(source._handle, sink._handle);
+    pipe.onunpipe = common.mustCall(() => {
+      assert.strictEqual(source._handle.bytesRead, payload.length);
+      assert.strictEqual(sink._handle.bytesWritten, payload.length);
+      assert.strictEqual(pipe.isClosed(), true);
+      source.destroy();
+      sink.destroy();
+      sourceServer.close();
+    });
+    pipe.start();
+  }));
+}));
+
+sinkServer.listen(0, common.mustCall(() => {
+  sourceServer.listen(0, common.mustCall(() => {
+    const client = net.connect(sourceServer.address().port);
+    client.end(payload);
+    client.resume();
+  }));
+}));
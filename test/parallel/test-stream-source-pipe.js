@@ -0,0 +1,125 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+const { Blob } = require('buffer');
+const { kHandle } = require('internal/blob');
+const { internalBinding } = require('internal/test/binding');
+const { FileHandle } = internalBinding('fs');
+const { SourcePipe } = internalBinding('stream_pipe');
+const { UV_EIO } = internalBinding('uv');
+
+// Native sources are pulled into a TCP connection without their data being
+// passed through JS.
+
+tmpdir.refresh();
+const filename = path.join(tmpdir.path, 'stream-source-pipe.bin');
+const contents = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < contents.length; i++)
+  contents[i] = i % 251;
+fs.writeFileSync(filename, contents);
+
+// Calls `pipeTo(sink)` with a connected socket, and checks that `expected`
+// is what the other side receives before the end of the connection.
+function testPipe(expected, pipeTo) {
+  return new Promise((resolve) => {
+    const server = net.createServer(common.mustCall((socket) => {
+      const chunks = [];
+      socket.on('data', (chunk) => chunks.push(chunk));
+      socket.on('end', common.mustCall(() => {
+        assert.deepStrictEqual(Buffer.concat(chunks), expected);
+        socket.end();
+        server.close(resolve);
+      }));
+    }));
+    server.listen(0, common.mustCall(() => {
+      const sink = net.connect(server.address().port, common.mustCall(() => {
+        pipeTo(sink);
+      }));
+    }));
+  });
+}
+
+function startPipe(source, sink, onComplete) {
+  const pipe = new SourcePipe(source, sink._handle);
+  pipe.oncomplete = common.mustCall((status) => {
+    assert.strictEqual(status, 0);
+    assert.strictEqual(pipe.isClosed(), true);
+    if (onComplete) onComplete();
+    sink.destroy();
+  });
+  pipe.start();
+  assert.strictEqual(pipe.isClosed(), false);
+}
+
+(async () => {
+  // A Blob with parts in memory and parts of a file.
+  const fileBlob = await fs.openAsBlob(filename);
+  const blob = new Blob([
+    'head',
+    fileBlob.slice(100, 300000),
+    new Uint8Array(0),
+    contents.subarray(0, 5000),
+    fileBlob,
+  ]);
+  await testPipe(Buffer.concat([
+    Buffer.from('head'),
+    contents.subarray(100, 300000),
+    contents.subarray(0, 5000),
+    contents,
+  ]), (sink) => startPipe(blob[kHandle], sink));
+
+  // An empty Blob only ends the connection.
+  await testPipe(Buffer.alloc(0), (sink) => {
+    startPipe(new Blob([])[kHandle], sink);
+  });
+
+  // A FileHandle.
+  await testPipe(contents.subarray(10, 10 + 500000), (sink) => {
+    const handle = new FileHandle(fs.openSync(filename, 'r'), 10, 500000);
+    handle.onread = common.mustCall();
+    startPipe(handle, sink, () => {
+      assert.strictEqual(handle.bytesRead, 500000);
+      handle.close().then(common.mustCall());
+    });
+  });
+
+  // Another TCP connection.
+  await testPipe(contents, (sink) => {
+    const server = net.createServer(common.mustCall((socket) => {
+      socket.end(contents);
+      server.close();
+    }));
+    server.listen(0, common.mustCall(() => {
+      const source = net.connect(server.address().port);
+      source.on('connect', common.mustCall(() => {
+        source.pause();
+        startPipe(source._handle, sink, () => source.destroy());
+      }));
+    }));
+  });
+
+  // A file that changed since the Blob was created cannot be read.
+  const changed = await fs.openAsBlob(filename);
+  fs.appendFileSync(filename, 'more');
+  await new Promise((resolve) => {
+    const server = net.createServer(common.mustCall((socket) => {
+      socket.resume();
+      socket.on('close', common.mustCall(() => server.close(resolve)));
+    }));
+    server.listen(0, common.mustCall(() => {
+      const sink = net.connect(server.address().port, common.mustCall(() => {
+        const pipe = new SourcePipe(changed[kHandle], sink._handle);
+        pipe.oncomplete = common.mustCall((status) => {
+          assert.strictEqual(status, UV_EIO);
+          sink.destroy();
+        });
+        pipe.start();
+      }));
+    }));
+  });
+})().then(common.mustCall());
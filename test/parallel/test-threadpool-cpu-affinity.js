@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+if (!common.isLinux)
+  common.skip('--threadpool-cpu-affinity is only available on Linux');
+const assert = require('assert');
+const { fork, spawnSync } = require('child_process');
+const fs = require('fs');
+
+function allowedCpus(path) {
+  return fs.readFileSync(path, 'utf8')
+    .match(/^Cpus_allowed_list:\s*(\S+)$/m)[1];
+}
+
+if (process.argv[2] === 'child') {
+  // The threadpool has been started before any JS runs. Its threads are the
+  // only ones that are restricted to the CPU.
+  const cpus = fs.readdirSync('/proc/self/task').map(
+    (tid) => allowedCpus(`/proc/self/task/${tid}/status`));
+  process.send({
+    main: allowedCpus('/proc/thread-self/status'),
+    restricted: cpus.filter((list) => list === process.argv[3]).length,
+  });
+  return;
+}
+
+const allowed = allowedCpus('/proc/thread-self/status');
+const cpu = allowed.split(/[,-]/)[0];
+const child = fork(__filename, ['child', cpu], {
+  execArgv: [`--threadpool-cpu-affinity=${cpu}`],
+  env: { ...process.env, UV_THREADPOOL_SIZE: '3' },
+});
+child.on('message', common.mustCall(({ main, restricted }) => {
+  assert.strictEqual(main, allowed);
+  assert(restricted >= 3, `${restricted} threads use CPU ${cpu}`);
+}));
+child.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+
+function run(value) {
+  const { status, stderr } = spawnSync(process.execPath, [
+    `--threadpool-cpu-affinity=${value}`, '-e', '0',
+  ]);
+  return { status, stderr: String(stderr) };
+}
+
+// A trailing comma is ignored.
+{
+  const { status, stderr } = run(`${cpu},`);
+  assert.strictEqual(status, 0, stderr);
+}
+
+{
+  const { status, stderr } = run('');
+  assert.strictEqual(status, 9);
+  assert.match(stderr, /--threadpool-cpu-affinity= requires an argument/);
+}
+
+for (const value of ['a', '3-1', '-1', '1024', '0-', ',']) {
+  const { status, stderr } = run(value);
+  assert.strictEqual(status, 9, value);
+  assert.ok(
+    stderr.includes(`invalid value for --threadpool-cpu-affinity: ${value}`),
+    stderr);
+}
+
+// CPUs that are not available make the process exit, even if others are.
+for (const value of ['1023', `${cpu},1023`]) {
+  const { status, stderr } = run(value);
+  assert.strictEqual(status, 9, value);
+  assert.match(
+    stderr,
+    /invalid value for --threadpool-cpu-affinity: CPU 1023 is not available/);
+}
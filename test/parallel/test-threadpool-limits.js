@@ -0,0 +1,59 @@
+// Flags: --threadpool-limits=crypto=1,zlib=2
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const crypto = require('crypto');
+const zlib = require('zlib');
+
+const before = process.threadpoolUsage();
+assert.deepStrictEqual(Object.keys(before),
+                       ['crypto', 'zlib', 'napi', 'other']);
+assert.deepStrictEqual(before.napi, {
+  limit: 0, scheduled: 0, queued: 0, running: 0, completed: 0
+});
+assert.strictEqual(before.crypto.limit, 1);
+assert.strictEqual(before.zlib.limit, 2);
+
+// Requests over the limit wait for the ones in the threadpool, and are then
+// run in order.
+{
+  const order = [];
+  for (let i = 0; i < 4; i++) {
+    crypto.pbkdf2('key', 'salt', 1e3, 16, 'sha256', common.mustSucceed(() => {
+      order.push(i);
+      const { crypto: usage } = process.threadpoolUsage();
+      assert(usage.running <= 1);
+      if (i === 3) {
+        assert.deepStrictEqual(order, [0, 1, 2, 3]);
+        assert.strictEqual(usage.queued, 0);
+        assert.strictEqual(usage.completed - before.crypto.completed, 4);
+      }
+    }));
+  }
+  const usage = process.threadpoolUsage().crypto;
+  assert.strictEqual(usage.scheduled - before.crypto.scheduled, 4);
+  assert.strictEqual(usage.running, 1);
+  assert.strictEqual(usage.queued, 3);
+}
+
+{
+  const input = Buffer.alloc(1024 * 1024, 'a');
+  for (let i = 0; i < 5; i++) {
+    zlib.gzip(input, common.mustSucceed((output) => {
+      assert.deepStrictEqual(zlib.gunzipSync(output), input);
+    }));
+  }
+  assert(process.threadpoolUsage().zlib.running <= 2);
+}
+
+for (const limits of ['foo=1', 'crypto', 'crypto=', 'crypto=-1',
+                      'crypto=1x', 'crypto=2000', 'zlib=1,,napi=1']) {
+  const child = spawnSync(process.execPath,
+                          [`--threadpool-limits=${limits}`, '-e', '0']);
+  assert.strictEqual(child.status, 9);
+  assert.match(child.stderr.toString(), /invalid value for --threadpool-limits/);
+}
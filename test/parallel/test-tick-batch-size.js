@@ -0,0 +1,52 @@
+// Flags: --tick-batch-size=3
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+
+// With --tick-batch-size, the tick and microtask queues are processed once
+// for up to that many callbacks that run in the same phase of the event loop.
+
+const events = [];
+let callbacks = 0;
+for (let i = 0; i < 5; i++) {
+  fs.stat(__filename, common.mustSucceed(() => {
+    const n = callbacks++;
+    events.push(`callback ${n}`);
+    process.nextTick(() => events.push(`tick ${n}`));
+    queueMicrotask(() => events.push(`microtask ${n}`));
+  }));
+}
+
+// Make sure that all of the stat calls have finished once the event loop
+// starts, so that their callbacks run in the same poll phase.
+Atomics.wait(new Int32Array(new SharedArrayBuffer(4)), 0, 0, 500);
+
+// The queues are processed after every third callback, and at the end of the
+// poll phase, before immediates run.
+setImmediate(common.mustCall(() => {
+  assert.deepStrictEqual(events, [
+    'callback 0', 'callback 1', 'callback 2',
+    'tick 0', 'tick 1', 'tick 2',
+    'microtask 0', 'microtask 1', 'microtask 2',
+    'callback 3', 'callback 4',
+    'tick 3', 'tick 4',
+    'microtask 3', 'microtask 4',
+  ]);
+
+  // Immediates and timers still process the queues after each callback.
+  const order = [];
+  setImmediate(() => {
+    order.push('immediate 0');
+    process.nextTick(() => order.push('tick 0'));
+  });
+  setImmediate(common.mustCall(() => {
+    order.push('immediate 1');
+    process.nextTick(common.mustCall(() => {
+      assert.deepStrictEqual(order, ['immediate 0', 'tick 0', 'immediate 1']);
+    }));
+  }));
+  let ticked = false;
+  setTimeout(() => process.nextTick(() => ticked = true), 1);
+  setTimeout(common.mustCall(() => assert.strictEqual(ticked, true)), 1);
+}));
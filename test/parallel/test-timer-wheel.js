@@ -0,0 +1,84 @@
+// Flags: --expose-internals
+'use strict';
+
+require('../common');
+
+const assert = require('assert');
+const L = require('internal/linkedlist');
+const TimerWheel = require('internal/timer_wheel');
+
+function createItem(start, timeout) {
+  return { _idleNext: null, _idlePrev: null, _idleStart: start,
+           _idleTimeout: timeout };
+}
+
+function expire(wheel, now) {
+  wheel.advance(now);
+  const expired = [];
+  let item;
+  while (item = L.peek(wheel.expired)) {
+    L.remove(item);
+    expired.push(item);
+  }
+  return expired;
+}
+
+{
+  // Items expire in the order of their ticks, and never early.
+  const wheel = new TimerWheel(1, 1000);
+  assert.strictEqual(wheel.nextExpiry(), Infinity);
+  const items = [5, 70, 1, 4096, 300000, 63, 64].map((timeout) => {
+    const item = createItem(1000, timeout);
+    assert.strictEqual(wheel.insert(item) <= 1000 + timeout, true);
+    return item;
+  });
+
+  const expired = [];
+  let now = 1000;
+  while (wheel.nextExpiry() !== Infinity) {
+    now = wheel.nextExpiry();
+    for (const item of expire(wheel, now)) {
+      assert.ok(item._idleStart + item._idleTimeout <= now);
+      expired.push(item._idleTimeout);
+    }
+  }
+  assert.deepStrictEqual(expired, [1, 5, 63, 64, 70, 4096, 300000]);
+  assert.strictEqual(now, 301000);
+  assert.deepStrictEqual(
+    items.map((item) => item._idleNext), items.map(() => null));
+}
+
+{
+  // Items that are due in the same tick expire together.
+  const wheel = new TimerWheel(10, 0);
+  const items = [];
+  for (let timeout = 1; timeout <= 20; timeout++) {
+    const item = createItem(0, timeout);
+    items.push(item);
+    wheel.insert(item);
+  }
+  assert.strictEqual(wheel.nextExpiry(), 10);
+  assert.strictEqual(expire(wheel, 9).length, 0);
+  assert.deepStrictEqual(expire(wheel, 10), items.slice(0, 10));
+  assert.strictEqual(wheel.nextExpiry(), 20);
+  assert.deepStrictEqual(expire(wheel, 25), items.slice(10));
+}
+
+{
+  // Items can be removed at any time, and the wheel can be advanced by more
+  // than a whole rotation at once.
+  const wheel = new TimerWheel(1, 0);
+  const removed = createItem(0, 100000);
+  const kept = createItem(0, 100001);
+  wheel.insert(removed);
+  wheel.insert(kept);
+  assert.deepStrictEqual(expire(wheel, 50000), []);
+  L.remove(removed);
+  assert.deepStrictEqual(expire(wheel, 2 ** 31), [kept]);
+  assert.strictEqual(wheel.nextExpiry(), Infinity);
+
+  // Items that are already due expire on the next tick.
+  const late = createItem(0, 1);
+  assert.strictEqual(wheel.insert(late), 2 ** 31 + 1);
+  assert.deepStrictEqual(expire(wheel, 2 ** 31 + 1), [late]);
+}
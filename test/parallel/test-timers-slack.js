@@ -0,0 +1,62 @@
+// Flags: --timer-slack=20
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+
+// With --timer-slack, timers may run late but never early. The loop time is
+// up to date in setImmediate() callbacks, unlike at startup.
+setImmediate(common.mustCall(() => {
+  const start = Date.now();
+  for (let i = 0; i < 200; i++) {
+    const timeout = 1 + (i * 7) % 150;
+    setTimeout(common.mustCall(() => {
+      // Date.now() and the loop time may be rounded differently.
+      assert.ok(Date.now() - start >= timeout - 1);
+    }), timeout);
+  }
+}));
+
+// Cleared and refreshed timers.
+const cleared = setTimeout(common.mustNotCall(), 50);
+setTimeout(common.mustCall(() => clearTimeout(cleared)), 10);
+
+// Both timers may run up to 20ms late, so the interval can come up to 40ms
+// after a refresh. The refreshed timer must not be due before that.
+let refreshes = 0;
+const refreshed = setTimeout(common.mustCall(() => {
+  assert.strictEqual(refreshes, 3);
+}), 100);
+const refresher = setInterval(common.mustCall(() => {
+  refreshed.refresh();
+  if (++refreshes === 3)
+    clearInterval(refresher);
+}, 3), 20);
+
+// The next tick queue and microtasks run in between timers that expire in
+// the same tick.
+{
+  const order = [];
+  setTimeout(() => {
+    order.push('a');
+    process.nextTick(() => order.push('tick'));
+    Promise.resolve().then(() => order.push('microtask'));
+  }, 200);
+  setTimeout(() => order.push('b'), 200);
+  setImmediate(() => {
+    setTimeout(common.mustCall(() => {
+      assert.deepStrictEqual(order, ['a', 'tick', 'microtask', 'b']);
+    }), 250);
+  });
+}
+
+// An exception thrown by one timer does not prevent the ones that expire in
+// the same tick from running.
+process.once('uncaughtException', common.mustCall((err) => {
+  assert.strictEqual(err.message, 'boom');
+}));
+setTimeout(() => { throw new Error('boom'); }, 300);
+setTimeout(common.mustCall(), 300);
+
+// Unrefed timers do not keep the process alive.
+setTimeout(common.mustNotCall(), 100000).unref();
@@ -0,0 +1,59 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Connections with the asyncPrivateKey option can be destroyed while their
+// handshake job is paused, either waiting for a private key operation or in a
+// callback into JS.
+
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const kConnections = 10;
+
+function test(name, maxVersion, destroy) {
+  return new Promise((resolve) => {
+    const server = tls.createServer({
+      key: fixtures.readKey(`${name}-key.pem`),
+      cert: fixtures.readKey(`${name}-cert.pem`),
+      asyncPrivateKey: true,
+      maxVersion,
+    }, common.mustNotCall());
+    server.on('keylog', common.mustCallAtLeast((line, socket) => {
+      if (!socket.destroyed)
+        destroy(socket);
+    }));
+
+    server.listen(0, common.mustCall(() => {
+      let closed = 0;
+      for (let i = 0; i < kConnections; i++) {
+        const client = tls.connect({
+          port: server.address().port,
+          rejectUnauthorized: false,
+        }, common.mustNotCall());
+        client.on('error', () => {});
+        client.on('close', common.mustCall(() => {
+          if (++closed === kConnections)
+            server.close(resolve);
+        }));
+      }
+    }));
+  });
+}
+
+(async () => {
+  for (const name of ['agent1', 'ec']) {
+    for (const maxVersion of ['TLSv1.2', 'TLSv1.3']) {
+      // The SSL is freed once the socket closed, usually while a private key
+      // operation is in the threadpool.
+      await test(name, maxVersion, (socket) => socket.destroy());
+      // The SSL is freed by the callback that the job waits for.
+      await test(name, maxVersion, (socket) => {
+        socket._destroySSL();
+        socket.destroy();
+      });
+    }
+  }
+})().then(common.mustCall());
@@ -0,0 +1,63 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Handshakes with the asyncPrivateKey option complete for RSA and EC keys,
+// including the callbacks into JS that OpenSSL makes during the handshake.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+function test(name, maxVersion) {
+  return new Promise((resolve) => {
+    const server = tls.createServer({
+      key: fixtures.readKey(`${name}-key.pem`),
+      cert: fixtures.readKey(`${name}-cert.pem`),
+      asyncPrivateKey: true,
+      ALPNProtocols: ['a', 'b'],
+      maxVersion,
+    }, common.mustCall((socket) => {
+      assert.strictEqual(socket.alpnProtocol, 'b');
+      socket.write('hello');
+      socket.pipe(socket);
+    }));
+    server.on('keylog', common.mustCallAtLeast());
+
+    server.listen(0, common.mustCall(() => {
+      const client = tls.connect({
+        port: server.address().port,
+        rejectUnauthorized: false,
+        ALPNProtocols: ['b'],
+      }, common.mustCall(() => {
+        assert.strictEqual(client.getProtocol(), maxVersion);
+      }));
+      // Written before the handshake is done.
+      client.write('world');
+      let received = '';
+      client.setEncoding('utf8');
+      client.on('data', (chunk) => {
+        received += chunk;
+        if (received.length === 10)
+          client.end();
+      });
+      client.on('end', common.mustCall(() => {
+        assert.strictEqual(received, 'helloworld');
+        server.close(resolve);
+      }));
+    }));
+  });
+}
+
+(async () => {
+  for (const name of ['agent1', 'ec']) {
+    await test(name, 'TLSv1.2');
+    await test(name, 'TLSv1.3');
+  }
+})().then(common.mustCall());
+
+assert.throws(() => tls.createSecureContext({ asyncPrivateKey: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
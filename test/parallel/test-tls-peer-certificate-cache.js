@@ -0,0 +1,69 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// The server converts the certificates of repeat clients once, but every
+// getPeerCertificate() call still returns objects of its own.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  ca: fixtures.readKey('ca1-cert.pem'),
+  requestCert: true,
+  rejectUnauthorized: false,
+});
+
+function connect() {
+  return new Promise((resolve) => {
+    server.once('secureConnection', (socket) => {
+      const peer = socket.getPeerCertificate();
+      const detailed = socket.getPeerCertificate(true);
+      socket.end();
+      resolve({ peer, detailed });
+    });
+    tls.connect({
+      port: server.address().port,
+      key: fixtures.readKey('agent1-key.pem'),
+      cert: fixtures.readKey('agent1-cert.pem'),
+      rejectUnauthorized: false,
+    }, function() {
+      this.end();
+    });
+  });
+}
+
+server.listen(0, common.mustCall(async () => {
+  const first = await connect();
+  assert.strictEqual(first.peer.subject.CN, 'agent1');
+  assert.strictEqual(first.peer.issuerCertificate, undefined);
+  assert.strictEqual(first.detailed.issuerCertificate.subject.CN, 'ca1');
+
+  // Modifying the results does not affect later ones.
+  const { raw, pubkey, ext_key_usage } = first.peer;
+  const expected = {
+    raw: Buffer.from(raw),
+    pubkey: Buffer.from(pubkey),
+    ext_key_usage: ext_key_usage && [...ext_key_usage],
+  };
+  raw.fill(0);
+  pubkey.fill(0);
+  if (ext_key_usage) ext_key_usage.length = 0;
+  first.peer.serialNumber = 'modified';
+
+  const second = await connect();
+  assert.notStrictEqual(second.peer, first.peer);
+  assert.deepStrictEqual(second.peer.raw, expected.raw);
+  assert.deepStrictEqual(second.peer.pubkey, expected.pubkey);
+  assert.deepStrictEqual(second.peer.ext_key_usage, expected.ext_key_usage);
+  assert.notStrictEqual(second.peer.serialNumber, 'modified');
+  assert.deepStrictEqual(second.detailed, first.detailed);
+  assert.notStrictEqual(second.detailed.issuerCertificate,
+                        first.detailed.issuerCertificate);
+  server.close();
+}));
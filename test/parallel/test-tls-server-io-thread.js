@@ -0,0 +1,39 @@
+'use strict';
+
+// TLS works on top of the sockets of a server with `ioThread: true`. The
+// encryption and decryption still happen on the main thread.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+if (common.isWindows)
+  common.skip('The I/O thread is not used on Windows');
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const server = tls.createServer({
+  ioThread: true,
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem')
+}, common.mustCall((c) => {
+  c.pipe(c);
+}));
+
+server.listen(0, '127.0.0.1', common.mustCall(() => {
+  const client = tls.connect({
+    port: server.address().port,
+    host: '127.0.0.1',
+    rejectUnauthorized: false
+  }, common.mustCall(() => {
+    client.end(Buffer.alloc(1024 * 1024, 'x'));
+  }));
+
+  let received = 0;
+  client.on('data', (chunk) => received += chunk.length);
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(received, 1024 * 1024);
+    server.close();
+  }));
+}));
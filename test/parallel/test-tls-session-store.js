@@ -0,0 +1,109 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+if (common.isWindows)
+  common.skip('sessionStore is not supported on Windows');
+
+// Servers that use the same sessionStore resume each other's sessions and
+// share their ticket keys, also across processes.
+
+const assert = require('assert');
+const { fork } = require('child_process');
+const fs = require('fs');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const name = `test-${process.argv[3] || process.pid}`;
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem'),
+  sessionIdContext: 'test-tls-session-store',
+  sessionStore: { name, size: 16 },
+  // Resume with session IDs, which are looked up in the store.
+  secureOptions: require('constants').SSL_OP_NO_TICKET,
+  maxVersion: 'TLSv1.2',
+};
+
+function removeStore() {
+  if (common.isLinux)
+    fs.rmSync(`/dev/shm/node-tls.${name}`, { force: true });
+}
+
+if (process.argv[2] === 'child') {
+  const server = tls.createServer(options, (socket) => socket.end());
+  server.listen(0, () => process.send({ port: server.address().port }));
+  process.on('message', (message) => {
+    if (message === 'keys')
+      process.send({ keys: server.getTicketKeys().toString('hex') });
+    else
+      server.close(() => process.disconnect());
+  });
+  return;
+}
+
+function connect(port, session) {
+  return new Promise((resolve) => {
+    const socket = tls.connect({
+      port,
+      session,
+      rejectUnauthorized: false,
+    }, () => {
+      const result = {
+        reused: socket.isSessionReused(),
+        session: socket.getSession(),
+      };
+      socket.end(() => resolve(result));
+    });
+  });
+}
+
+function receive(child) {
+  return new Promise((resolve) => child.once('message', resolve));
+}
+
+removeStore();
+
+const server = tls.createServer(options, (socket) => socket.end());
+server.listen(0, common.mustCall(async () => {
+  const child = fork(__filename, ['child', `${process.pid}`]);
+  const { port } = await receive(child);
+
+  const first = await connect(server.address().port);
+  assert.strictEqual(first.reused, false);
+  // The session was created by another process.
+  const second = await connect(port, first.session);
+  assert.strictEqual(second.reused, true);
+  // And the same holds the other way around.
+  const third = await connect(port);
+  assert.strictEqual(third.reused, false);
+  const fourth = await connect(server.address().port, third.session);
+  assert.strictEqual(fourth.reused, true);
+
+  child.send('keys');
+  assert.strictEqual((await receive(child)).keys,
+                     server.getTicketKeys().toString('hex'));
+  const keys = Buffer.alloc(48, 1);
+  server.setTicketKeys(keys);
+  child.send('keys');
+  assert.strictEqual((await receive(child)).keys, keys.toString('hex'));
+
+  child.send('close');
+  server.close();
+  child.on('exit', common.mustCall(removeStore));
+}));
+
+assert.throws(() => tls.createSecureContext({ sessionStore: name }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+});
+assert.throws(() => tls.createSecureContext({
+  sessionStore: { name: 'a/b' },
+}), {
+  code: 'ERR_INVALID_ARG_VALUE',
+});
+assert.throws(() => tls.createSecureContext({
+  sessionStore: { name, size: 0 },
+}), {
+  code: 'ERR_OUT_OF_RANGE',
+});
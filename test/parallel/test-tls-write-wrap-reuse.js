@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// The write requests that a TLS socket makes on the underlying TCP socket
+// may share their objects while no async_hooks are watching, but every
+// request that an init hook sees has an object of its own.
+
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem')
+};
+
+function exchange(count, cb) {
+  const server = tls.createServer(options, common.mustCall((socket) => {
+    socket.pipe(socket);
+  }));
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false
+    }, common.mustCall(() => {
+      let received = 0;
+      client.on('data', (chunk) => {
+        received += chunk.length;
+        if (received === count * 100)
+          client.end();
+      });
+      for (let i = 0; i < count; i++)
+        client.write(Buffer.alloc(100, i));
+    }));
+    client.on('close', common.mustCall(() => {
+      server.close(cb);
+    }));
+  }));
+}
+
+exchange(10, common.mustCall(() => {
+  const resources = new Set();
+  const hook = async_hooks.createHook({
+    init(id, type, triggerId, resource) {
+      if (type !== 'WRITEWRAP')
+        return;
+      assert(!resources.has(resource));
+      assert.strictEqual(resource.error, undefined);
+      resources.add(resource);
+    }
+  }).enable();
+
+  exchange(10, common.mustCall(() => {
+    hook.disable();
+    assert(resources.size > 0);
+  }));
+}));
@@ -31,6 +31,12 @@ function getEnabledCategoriesFromCommandLine() {
 const isChild = process.argv[2] === 'child';
 const enabledCategories = getEnabledCategoriesFromCommandLine();
 
+// The trace file is written to the working directory.
+if (!isChild) {
+  tmpdir.refresh();
+  process.chdir(tmpdir.path);
+}
+
 assert.strictEqual(getEnabledCategories(), enabledCategories);
 [1, 'foo', true, false, null, undefined].forEach((i) => {
   assert.throws(() => createTracing(i), {
@@ -127,10 +133,9 @@ if (isChild) {
 }
 
 function testApiInChildProcess(execArgs, cb) {
-  tmpdir.refresh();
-  // Save the current directory so we can chdir back to it later
-  const parentDir = process.cwd();
-  process.chdir(tmpdir.path);
+  const cwd = path.join(tmpdir.path, 'child');
+  fs.rmSync(cwd, { force: true, recursive: true });
+  fs.mkdirSync(cwd);
 
   const expectedBegins = [{ cat: 'foo', name: 'test1' }];
   const expectedEnds = [{ cat: 'foo', name: 'test1' }];
@@ -138,6 +143,7 @@ function testApiInChildProcess(execArgs, cb) {
   const proc = cp.fork(__filename,
                        ['child'],
                        {
+                         cwd,
                          execArgv: [
                            '--expose-gc',
                            '--expose-internals',
@@ -147,7 +153,7 @@ function testApiInChildProcess(execArgs, cb) {
                        });
 
   proc.once('exit', common.mustCall(() => {
-    const file = path.join(tmpdir.path, 'node_trace.1.log');
+    const file = path.join(cwd, 'node_trace.1.log');
 
     assert(fs.existsSync(file));
     fs.readFile(file, common.mustSucceed((data) => {
@@ -175,7 +181,6 @@ function testApiInChildProcess(execArgs, cb) {
             assert.fail('Unexpected trace event phase');
         }
       });
-      process.chdir(parentDir);
       cb && process.nextTick(cb);
     }));
   }));
@@ -12,7 +12,10 @@ const names = [
   'v8Start',
   'loopStart',
   'loopExit',
-  'bootstrapComplete'
+  'bootstrapComplete',
+  'contextReady',
+  'internalBootstrapComplete',
+  'mainModuleLoaded',
 ];
 
 if (process.argv[2] === 'child') {
@@ -0,0 +1,38 @@
+'use strict';
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+
+tmpdir.refresh();
+
+const CODE =
+  'setTimeout(() => { for (let i = 0; i < 100000; i++) { "test" + i } }, 1)';
+
+const proc = cp.spawn(process.execPath, [
+  '--trace-events-enabled',
+  '--trace-event-file-gzip',
+  '--trace-event-file-pattern',
+  // eslint-disable-next-line no-template-curly-in-string
+  'node_trace.${rotation}.log.gz',
+  '-e', CODE,
+], { cwd: tmpdir.path });
+
+proc.once('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+  const filename = path.join(tmpdir.path, 'node_trace.1.log.gz');
+  const data = fs.readFileSync(filename);
+  // The gzip magic number.
+  assert.strictEqual(data.readUInt16BE(0), 0x1f8b);
+  // gunzipSync() fails unless the gzip stream was finished on exit.
+  const traces = JSON.parse(zlib.gunzipSync(data).toString()).traceEvents;
+  assert(traces.length > 0);
+  // --trace-events-enabled selects the v8, node and node.async_hooks
+  // categories. Node.js events list all categories they belong to.
+  assert(traces.some((trace) => trace.cat === 'v8'));
+  assert(traces.some((trace) => trace.cat === 'node,node.async_hooks' &&
+                                trace.name === 'Timeout'));
+}));
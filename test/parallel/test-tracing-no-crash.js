@@ -2,15 +2,18 @@
 const common = require('../common');
 const assert = require('assert');
 const { spawn } = require('child_process');
+const tmpdir = require('../common/tmpdir');
 
 function CheckNoSignalAndErrorCodeOne(code, signal) {
   assert.strictEqual(signal, null);
   assert.strictEqual(code, 1);
 }
 
+// The trace file is written to the working directory of the child.
+tmpdir.refresh();
 const child = spawn(process.execPath, [
   '--trace-event-categories', 'madeup', '-e', 'throw new Error()'
-], { stdio: [ 'inherit', 'inherit', 'pipe' ] });
+], { cwd: tmpdir.path, stdio: [ 'inherit', 'inherit', 'pipe' ] });
 child.on('exit', common.mustCall(CheckNoSignalAndErrorCodeOne));
 
 let stderr;
@@ -0,0 +1,39 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const v8 = require('v8');
+
+assert.throws(() => v8.getHeapProfile(null), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => v8.getHeapProfile({ samplingInterval: 0 }),
+              { code: 'ERR_OUT_OF_RANGE' });
+
+// The first call starts sampling.
+const first = v8.getHeapProfile({ samplingInterval: 1024 });
+assert.strictEqual(first.head.callFrame.functionName, '(root)');
+assert(Array.isArray(first.samples));
+
+const retained = [];
+function allocateSomething() {
+  for (let i = 0; i < 10000; i++)
+    retained.push({ i, s: `item${i}` });
+}
+allocateSomething();
+
+const { head, samples } = v8.getHeapProfile();
+assert(samples.length > 0);
+const ids = new Set();
+const names = [];
+(function visit(node) {
+  assert.strictEqual(typeof node.id, 'number');
+  assert.strictEqual(typeof node.selfSize, 'number');
+  assert.strictEqual(typeof node.callFrame.scriptId, 'string');
+  ids.add(node.id);
+  names.push(node.callFrame.functionName);
+  node.children.forEach(visit);
+})(head);
+assert(names.includes('allocateSomething'));
+for (const { size, nodeId, ordinal } of samples) {
+  assert(size > 0);
+  assert(ids.has(nodeId));
+  assert.strictEqual(typeof ordinal, 'number');
+}
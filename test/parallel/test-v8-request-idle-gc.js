@@ -0,0 +1,39 @@
+'use strict';
+
+// v8.requestIdleGC() collects garbage while the event loop waits for events,
+// with and without V8 idle tasks.
+
+const common = require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const v8 = require('v8');
+
+if (process.argv[2] === 'child') {
+  // Generate garbage, so that V8 has work to schedule.
+  let retained = [];
+  const interval = setInterval(() => {
+    retained.push(new Array(1e4).fill({}));
+    if (retained.length > 50)
+      retained = [];
+  }, 1);
+  setTimeout(() => clearInterval(interval), 200);
+  return;
+}
+
+const onCollected = common.mustCall((value) => {
+  assert.strictEqual(value, 'collected');
+  clearInterval(interval);
+});
+const registry = new globalThis.FinalizationRegistry(onCollected);
+
+(function() {
+  registry.register({}, 'collected');
+})();
+
+v8.requestIdleGC();
+// Let the loop wait for events until the garbage has been collected.
+const interval = setInterval(() => {}, 10);
+
+const child = spawnSync(process.execPath,
+                        ['--idle-gc-time=5', __filename, 'child']);
+assert.strictEqual(child.status, 0, child.stderr.toString());
@@ -0,0 +1,85 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const v8 = require('v8');
+
+const value = {
+  string: 'a string',
+  array: [1, 2, { x: 3 }],
+  buffer: Buffer.from('a buffer'),
+  float64: new Float64Array([0.5, 1.5]),
+  map: new Map([[1, 2]]),
+};
+const serialized = v8.serialize(value);
+
+{
+  // The value is written in place, at the offset.
+  const memory = new Uint8Array(new SharedArrayBuffer(4096)).fill(0xff);
+  const written = v8.serialize(value, { into: memory, offset: 100 });
+  assert.strictEqual(written, serialized.length);
+  assert.deepStrictEqual(Buffer.from(memory.buffer, 100, written), serialized);
+  assert.strictEqual(memory[99], 0xff);
+  assert.strictEqual(memory[100 + written], 0xff);
+
+  assert.deepStrictEqual(
+    v8.deserialize(memory, { offset: 100, length: written }), value);
+  assert.deepStrictEqual(v8.deserialize(memory.subarray(100)), value);
+}
+
+{
+  // The views are relative to their own offset.
+  const buffer = Buffer.alloc(serialized.length + 20);
+  const view = new DataView(buffer.buffer, buffer.byteOffset + 10);
+  assert.strictEqual(v8.serialize(value, { into: view }), serialized.length);
+  assert.deepStrictEqual(buffer.subarray(10, 10 + serialized.length),
+                         serialized);
+  assert.deepStrictEqual(v8.deserialize(buffer, { offset: 10 }), value);
+
+  // A target that fits exactly is enough.
+  const exact = Buffer.alloc(serialized.length);
+  assert.strictEqual(v8.serialize(value, { into: exact }), exact.length);
+  assert.deepStrictEqual(exact, serialized);
+}
+
+{
+  // A target that is too small reports the size that is needed.
+  const small = Buffer.alloc(serialized.length + 7);
+  assert.throws(() => v8.serialize(value, { into: small, offset: 8 }), {
+    code: 'ERR_OUT_OF_RANGE',
+    message: 'The value of "options.into.byteLength" is out of range. ' +
+             `It must be >= ${serialized.length + 8}. ` +
+             `Received ${serialized.length + 7}`
+  });
+  assert.throws(() => v8.serialize(value, { into: new Uint8Array(0) }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+
+{
+  // Deserializing a shorter range fails without reading past it.
+  assert.throws(() => {
+    v8.deserialize(serialized, { length: serialized.length - 1 });
+  }, /Unable to deserialize cloned data/);
+}
+
+for (const options of [null, 1, 'options']) {
+  assert.throws(() => v8.serialize(value, options), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => v8.deserialize(serialized, options), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+assert.throws(() => v8.serialize(value, { into: [] }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => v8.serialize(value, { into: Buffer.alloc(8), offset: 9 }),
+              { code: 'ERR_OUT_OF_RANGE' });
+assert.throws(() => v8.deserialize({}, {}), { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => v8.deserialize(serialized, { offset: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => v8.deserialize(serialized, { offset: 1, length: 1e6 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
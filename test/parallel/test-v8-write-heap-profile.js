@@ -0,0 +1,39 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const v8 = require('v8');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+assert.rejects(v8.writeHeapProfile({ duration: -1 }),
+               { code: 'ERR_OUT_OF_RANGE' }).then(common.mustCall());
+assert.rejects(v8.writeHeapProfile({ samplingInterval: 0 }),
+               { code: 'ERR_OUT_OF_RANGE' }).then(common.mustCall());
+
+const retained = [];
+function allocateSomething() {
+  for (let i = 0; i < 10000; i++)
+    retained.push({ i, s: `item${i}` });
+}
+
+const file = path.join(tmpdir.path, 'test.heapprofile');
+v8.writeHeapProfile(file, { duration: 100, samplingInterval: 1024 })
+  .then(common.mustCall((filename) => {
+    assert.strictEqual(filename, file);
+    const { head, samples } = JSON.parse(fs.readFileSync(file, 'utf8'));
+    assert(samples.length > 0);
+    const names = [];
+    (function visit(node) {
+      names.push(node.callFrame.functionName);
+      node.children.forEach(visit);
+    })(head);
+    assert(names.includes('allocateSomething'));
+
+    // The profiler that the session started is stopped again, so the first
+    // call to getHeapProfile() starts a new one.
+    assert.strictEqual(v8.getHeapProfile().samples.length, 0);
+  }));
+allocateSomething();
@@ -0,0 +1,91 @@
+// Flags: --experimental-vm-compile-cache
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const vm = require('vm');
+const { Worker } = require('worker_threads');
+
+let last = vm.getCompileCacheStatistics();
+function assertStatistics(expected) {
+  const statistics = vm.getCompileCacheStatistics();
+  assert.deepStrictEqual({
+    hits: statistics.hits - last.hits,
+    misses: statistics.misses - last.misses,
+    rejections: statistics.rejections - last.rejections,
+    entries: statistics.entries - last.entries,
+  }, expected);
+  assert(statistics.size >= last.size);
+  last = statistics;
+}
+
+{
+  // Scripts with the same source share the cache, whatever their filename
+  // and context.
+  const code = 'const compileCacheTest = 1; compileCacheTest + 1';
+  const script = new vm.Script(code, { filename: 'a.js' });
+  assertStatistics({ hits: 0, misses: 1, rejections: 0, entries: 1 });
+  assert.strictEqual(script.runInThisContext(), 2);
+  assert.strictEqual(vm.runInNewContext(code, {}, 'b.js'), 2);
+  assert.strictEqual(vm.runInNewContext(code), 2);
+  assertStatistics({ hits: 2, misses: 0, rejections: 0, entries: 0 });
+  assert(last.size > code.length);
+
+  // The code that it compiles is unchanged.
+  assert.throws(() => vm.runInNewContext(`${code}; undefinedVariable`), {
+    name: 'ReferenceError'
+  });
+  assertStatistics({ hits: 0, misses: 1, rejections: 0, entries: 1 });
+  assert.throws(() => vm.runInNewContext(`${code}; undefinedVariable`), {
+    name: 'ReferenceError'
+  });
+  assertStatistics({ hits: 1, misses: 0, rejections: 0, entries: 0 });
+
+  // The cached data options keep working.
+  const produced = new vm.Script(code, { produceCachedData: true });
+  assert.strictEqual(produced.cachedDataProduced, true);
+  assert.strictEqual(produced.cachedDataRejected, undefined);
+  assertStatistics({ hits: 1, misses: 0, rejections: 0, entries: 0 });
+  const consumed = new vm.Script(code, { cachedData: produced.cachedData });
+  assert.strictEqual(consumed.cachedDataRejected, false);
+  assertStatistics({ hits: 0, misses: 0, rejections: 0, entries: 0 });
+}
+
+{
+  // Functions are keyed by their parameters too.
+  const f = vm.compileFunction('return a + b', ['a', 'b']);
+  assertStatistics({ hits: 0, misses: 1, rejections: 0, entries: 1 });
+  const g = vm.compileFunction('return a + b', ['a', 'b'], {
+    parsingContext: vm.createContext(),
+  });
+  assertStatistics({ hits: 1, misses: 0, rejections: 0, entries: 0 });
+  assert.strictEqual(f(1, 2), 3);
+  assert.strictEqual(g(1, 2), 3);
+  const h = vm.compileFunction('return a + b', ['b', 'a']);
+  assertStatistics({ hits: 0, misses: 1, rejections: 0, entries: 1 });
+  assert.strictEqual(h(1, 2), 3);
+
+  // Functions with context extensions are not cached.
+  const i = vm.compileFunction('return a + b', ['a'], {
+    contextExtensions: [{ b: 2 }],
+  });
+  assert.strictEqual(i(1), 3);
+  assertStatistics({ hits: 0, misses: 0, rejections: 0, entries: 0 });
+}
+
+{
+  // The cache is shared by the threads of the process.
+  const code = 'const compileCacheTest = 1; compileCacheTest + 1';
+  const worker = new Worker(`
+    const vm = require('vm');
+    require('worker_threads').parentPort.postMessage(vm.runInNewContext(
+      ${JSON.stringify(code)}));
+  `, { eval: true });
+  worker.on('message', common.mustCall((result) => {
+    assert.strictEqual(result, 2);
+  }));
+  worker.on('exit', common.mustCall(() => {
+    const statistics = vm.getCompileCacheStatistics();
+    assert(statistics.hits > last.hits);
+  }));
+}
@@ -0,0 +1,75 @@
+'use strict';
+
+require('../common');
+const assert = require('assert');
+const vm = require('vm');
+
+const { DONT_CONTEXTIFY } = vm.constants;
+assert.strictEqual(typeof DONT_CONTEXTIFY, 'symbol');
+assert(Object.isFrozen(vm.constants));
+
+{
+  // The returned object is the global object of the new context.
+  const context = vm.createContext(DONT_CONTEXTIFY);
+  assert(vm.isContext(context));
+  assert.strictEqual(vm.createContext(context), context);
+  assert.strictEqual(vm.runInContext('globalThis', context), context);
+  assert.strictEqual(vm.runInContext('this', context), context);
+
+  vm.runInContext('var a = 1; globalThis.b = 2; function c() {}', context);
+  assert.strictEqual(context.a, 1);
+  assert.strictEqual(context.b, 2);
+  assert.strictEqual(typeof context.c, 'function');
+  // Global declarations are instantiated before the code runs, so the order
+  // of the keys is up to V8. The array belongs to the new context, so copy it
+  // before comparing it with one of this context.
+  assert.deepStrictEqual(
+    [...vm.runInContext('Object.keys(globalThis)', context)].sort(),
+    ['a', 'b', 'c']);
+
+  context.d = 4;
+  assert.strictEqual(vm.runInContext('d', context), 4);
+
+  // The built-ins are those of the new context.
+  const array = vm.runInContext('[]', context);
+  assert.notStrictEqual(Object.getPrototypeOf(array), Array.prototype);
+  assert.strictEqual(vm.runInContext('Array', context), context.Array);
+  assert.strictEqual(context.Intl.v8BreakIterator, undefined);
+}
+
+{
+  // The options apply as they do to contextified objects.
+  const context = vm.createContext(DONT_CONTEXTIFY, {
+    codeGeneration: { strings: false },
+    microtaskMode: 'afterEvaluate',
+  });
+  assert.throws(() => vm.runInContext('eval("1")', context), {
+    name: 'EvalError'
+  });
+  vm.runInContext('Promise.resolve().then(() => { globalThis.ran = true; })',
+                  context);
+  assert.strictEqual(context.ran, true);
+
+  assert.throws(() => vm.createContext(DONT_CONTEXTIFY, { name: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+
+assert.strictEqual(vm.runInNewContext('this.x = 1; x', DONT_CONTEXTIFY), 1);
+assert.strictEqual(
+  new vm.Script('typeof globalThis').runInNewContext(DONT_CONTEXTIFY),
+  'object');
+
+{
+  // Contextified objects keep intercepting the accesses to the global object,
+  // whether the context is deserialized from the snapshot or not.
+  class Sandbox {}
+  [{ x: 1 }, Object.assign(new Sandbox(), { x: 1 })].forEach((sandbox) => {
+    vm.createContext(sandbox);
+    assert.strictEqual(vm.runInContext('x', sandbox), 1);
+    vm.runInContext('var y = 2; z = 3; this[0] = 4', sandbox);
+    assert.deepStrictEqual({ ...sandbox }, { 0: 4, x: 1, y: 2, z: 3 });
+    assert.strictEqual(vm.runInContext('delete this.x; typeof x', sandbox),
+                       'undefined');
+  });
+}
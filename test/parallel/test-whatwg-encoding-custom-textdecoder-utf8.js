@@ -0,0 +1,87 @@
+'use strict';
+
+// UTF-8 is decoded natively rather than through an ICU converter. Sequences
+// that are split between chunks and malformed input must decode as in a
+// single call.
+
+const common = require('../common');
+
+if (!common.hasIntl)
+  common.skip('missing Intl');
+
+const assert = require('assert');
+
+const strings = [
+  '',
+  'a',
+  'hello world'.repeat(100),
+  'été',
+  '\u{1F600} \u0800 \uFFFD \u{10FFFF}',
+  `${'a'.repeat(1000)}€`,
+];
+
+for (const fatal of [false, true]) {
+  for (const str of strings) {
+    const input = Buffer.from(str);
+    const decoder = new TextDecoder('utf-8', { fatal });
+    assert.strictEqual(decoder.decode(input), str);
+    assert.strictEqual(decoder.decode(input, { stream: true }), str);
+    assert.strictEqual(decoder.decode(), '');
+
+    // A leading BOM is only removed at the start of the stream.
+    const bom = Buffer.from([0xEF, 0xBB, 0xBF]);
+    const withBOM = Buffer.concat([bom, input]);
+    assert.strictEqual(decoder.decode(withBOM), str);
+    assert.strictEqual(new TextDecoder('utf-8', { fatal, ignoreBOM: true })
+                         .decode(withBOM), `\uFEFF${str}`);
+    assert.strictEqual(decoder.decode(bom, { stream: true }), '');
+    assert.strictEqual(decoder.decode(withBOM), `\uFEFF${str}`);
+
+    // Sequences that are split between calls.
+    for (let i = 0; i <= input.length; i++) {
+      const head = decoder.decode(input.subarray(0, i), { stream: true });
+      assert.strictEqual(head + decoder.decode(input.subarray(i)), str);
+    }
+  }
+}
+
+// Malformed input is still replaced or rejected.
+{
+  const input = Buffer.from([0x61, 0xED, 0xA0, 0x80, 0x62, 0xC0, 0x80]);
+  assert.strictEqual(new TextDecoder().decode(input),
+                     'a\uFFFD\uFFFD\uFFFDb\uFFFD\uFFFD');
+  assert.throws(() => new TextDecoder('utf-8', { fatal: true }).decode(input), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
+  });
+
+  const decoder = new TextDecoder('utf-8', { fatal: true });
+  assert.strictEqual(decoder.decode(Buffer.from([0xE2, 0x82]),
+                                    { stream: true }), '');
+  assert.throws(() => decoder.decode(Buffer.from('a')), {
+    code: 'ERR_ENCODING_INVALID_ENCODED_DATA',
+  });
+  assert.strictEqual(decoder.decode(Buffer.from('a')), 'a');
+}
+
+// Any split of malformed input gives the same result as a single call.
+{
+  const input = Buffer.from([
+    0xF0, 0x9F, 0x98, 0x80, 0xE0, 0x80, 0x61, 0xF4, 0x90, 0x80, 0xE2, 0x82,
+    0xC3, 0xA9, 0xF0, 0x9F, 0x98, 0xED, 0xBF, 0xBF, 0xFF, 0xE2, 0x82, 0xAC,
+    0xF0, 0x90,
+  ]);
+  const expected = new TextDecoder().decode(input);
+  assert.strictEqual(expected,
+                     '\u{1F600}\uFFFD\uFFFDa\uFFFD\uFFFD\uFFFD\uFFFD' +
+                     '\u00E9\uFFFD\uFFFD\uFFFD\uFFFD\uFFFD\u20AC\uFFFD');
+  const decoder = new TextDecoder();
+  for (let i = 0; i <= input.length; i++) {
+    for (let j = i; j <= input.length; j++) {
+      const result =
+        decoder.decode(input.subarray(0, i), { stream: true }) +
+        decoder.decode(input.subarray(i, j), { stream: true }) +
+        decoder.decode(input.subarray(j));
+      assert.strictEqual(result, expected);
+    }
+  }
+}
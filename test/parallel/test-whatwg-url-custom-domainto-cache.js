@@ -0,0 +1,54 @@
+'use strict';
+const common = require('../common');
+if (!common.hasIntl)
+  common.skip('missing Intl');
+
+const assert = require('assert');
+const { domainToASCII } = require('url');
+const fixtures = require('../common/fixtures');
+
+// ASCII domains are converted without ICU, and the results for other
+// domains are cached. Both have to match the uncached results.
+
+const tests = require('../fixtures/url-idna');
+const wptToASCIITests = require(
+  fixtures.path('wpt', 'url', 'resources', 'toascii.json')
+);
+
+function check(input, expected) {
+  const first = domainToASCII(input);
+  if (expected !== undefined)
+    assert.strictEqual(first, expected, input);
+  assert.strictEqual(domainToASCII(input), first, input);
+  return first;
+}
+
+for (const { ascii, unicode } of tests) {
+  check(unicode, ascii);
+  check(ascii, ascii);
+}
+
+for (const test of wptToASCIITests) {
+  if (typeof test === 'string')
+    continue;
+  check(test.input, test.output === null ? '' : test.output);
+}
+
+assert.strictEqual(check('EXAMPLE.Com'), 'example.com');
+assert.strictEqual(check('a_b.example'), 'a_b.example');
+assert.strictEqual(check('-a-.b--c.example'), '-a-.b--c.example');
+assert.strictEqual(check('XN--nxasmq6b.com'), 'xn--nxasmq6b.com');
+assert.strictEqual(check('xn--a.com'), '');
+assert.strictEqual(check('a.XN--a'), '');
+assert.strictEqual(check('xn-a.com'), 'xn-a.com');
+assert.strictEqual(check('a..b'), 'a..b');
+assert.strictEqual(check('a%b'), '');
+assert.strictEqual(check('ÉXAMPLE.com'), 'xn--xample-9ua.com');
+
+// Entries are evicted once the cache is full.
+const results = [];
+for (let i = 0; i < 2048; i++)
+  results.push(domainToASCII(`${i}.例え.テスト`));
+for (let i = 0; i < 2048; i++)
+  assert.strictEqual(check(`${i}.例え.テスト`), results[i]);
+assert.strictEqual(results[0], '0.xn--r8jz45g.xn--zckzah');
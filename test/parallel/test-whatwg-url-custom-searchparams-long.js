@@ -0,0 +1,84 @@
+'use strict';
+
+// Long query strings and long lists of parameters are parsed and serialized
+// in C++. Make sure that the results match the ones for short inputs, which
+// are handled in JS.
+
+require('../common');
+const assert = require('assert');
+
+const padding = `${'x'.repeat(64)}=${'y'.repeat(64)}`;
+const inputs = [
+  '',
+  'a',
+  'a=',
+  '=b',
+  '=',
+  'a=b',
+  'a=b=c',
+  '&&a=b&&',
+  'a+b=c+d',
+  '%61=%62',
+  '%6=%zz',
+  '%',
+  '%%41',
+  '%41%',
+  '%C3%A9=%E2%82%AC',
+  '%C3=%FF%FE',
+  '%F0%9F%98%80',
+  '%ED%A0%80',
+  'é=€',
+  '\u{1F600}=\u{1F601}',
+  'a\0b=c',
+  '%2B=%26&%3D=%25',
+];
+
+for (const input of inputs) {
+  const expected = [...new URLSearchParams(input)];
+  for (const long of [`${input}&${padding}`, `${padding}&${input}`]) {
+    const actual = [...new URLSearchParams(long)];
+    const pad = ['x'.repeat(64), 'y'.repeat(64)];
+    assert.deepStrictEqual(
+      actual,
+      long.startsWith(padding) ? [pad, ...expected] : [...expected, pad],
+      input);
+  }
+}
+
+// Every position of a 16-byte block is looked at.
+for (let i = 0; i < 64; i++) {
+  for (const ch of ['%41', '+', '&', '=']) {
+    const input = 'a'.repeat(i) + ch + 'b'.repeat(80 - i);
+    const expected = [];
+    for (const pair of input.split('&')) {
+      if (pair === '')
+        continue;
+      const eq = pair.indexOf('=');
+      const [name, value] = eq === -1 ?
+        [pair, ''] : [pair.slice(0, eq), pair.slice(eq + 1)];
+      expected.push([name, value].map((s) => {
+        return decodeURIComponent(s.replace(/\+/g, ' '));
+      }));
+    }
+    assert.deepStrictEqual([...new URLSearchParams(input)], expected);
+  }
+}
+
+{
+  const values = [
+    '', 'a', 'a b', 'é€', '\u{1F600}', '*-._', '~!\'()', '&=+%#?/',
+    '\0\x7f\x80', 'abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123',
+  ];
+  const pairs = [];
+  for (const name of values) {
+    for (const value of values)
+      pairs.push([name, value]);
+  }
+  const expected = pairs.map((pair) => {
+    return new URLSearchParams([pair]).toString();
+  }).join('&');
+  assert.strictEqual(new URLSearchParams(pairs).toString(), expected);
+  assert.strictEqual(
+    expected.slice(0, 64),
+    '=&=a&=a+b&=%C3%A9%E2%82%AC&=%F0%9F%98%80&=*-._&=%7E%21%27%28%29&');
+}
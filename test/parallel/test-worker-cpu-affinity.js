@@ -0,0 +1,50 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker } = require('worker_threads');
+
+for (const cpuAffinity of [[], [-1], [1024], [0.5]]) {
+  assert.throws(() => new Worker('', { eval: true, cpuAffinity }), {
+    code: cpuAffinity.length === 0 ?
+      'ERR_INVALID_ARG_VALUE' : 'ERR_OUT_OF_RANGE'
+  });
+}
+assert.throws(() => new Worker('', { eval: true, cpuAffinity: 0 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+if (!common.isLinux) {
+  assert.throws(() => new Worker('', { eval: true, cpuAffinity: [0] }), {
+    code: 'ERR_FEATURE_UNAVAILABLE_ON_PLATFORM'
+  });
+  return;
+}
+
+const fs = require('fs');
+
+function allowedCpus(status) {
+  return status.match(/^Cpus_allowed_list:\s*(\S+)$/m)[1];
+}
+
+// The worker thread only runs on the CPU it was given, the main thread is
+// not affected.
+const before = allowedCpus(fs.readFileSync('/proc/thread-self/status', 'utf8'));
+const cpu = Number(before.split(/[,-]/)[0]);
+const w = new Worker(`
+  const { parentPort } = require('worker_threads');
+  parentPort.postMessage(
+    require('fs').readFileSync('/proc/thread-self/status', 'utf8'));
+`, { eval: true, cpuAffinity: [cpu] });
+w.on('message', common.mustCall((status) => {
+  assert.strictEqual(allowedCpus(status), String(cpu));
+  assert.strictEqual(
+    allowedCpus(fs.readFileSync('/proc/thread-self/status', 'utf8')), before);
+}));
+w.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+
+// CPUs that are not available make the Worker fail to start.
+const unavailable = new Worker('', { eval: true, cpuAffinity: [1023] });
+unavailable.on('error', common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ERR_WORKER_INIT_FAILED');
+  assert.match(err.message, /CPU affinity/);
+}));
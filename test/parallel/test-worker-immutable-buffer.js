@@ -0,0 +1,78 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { inspect } = require('util');
+const {
+  ImmutableBuffer,
+  MessageChannel,
+  Worker,
+  isMainThread,
+  parentPort,
+  workerData,
+} = require('worker_threads');
+
+if (!isMainThread) {
+  // Writes in the worker do not change the data for anyone else.
+  const view = new Uint8Array(workerData.toArrayBuffer());
+  const sum = view.reduce((a, b) => a + b, 0);
+  view.fill(0);
+  parentPort.postMessage({ sum, length: workerData.byteLength });
+  return;
+}
+
+const source = Buffer.alloc(3 * 4096 + 7);
+for (let i = 0; i < source.length; i++)
+  source[i] = i % 256;
+const expectedSum = source.reduce((a, b) => a + b, 0);
+
+const shared = new ImmutableBuffer(source);
+assert.strictEqual(shared.byteLength, source.length);
+assert.strictEqual(inspect(shared), 'ImmutableBuffer { byteLength: 12295 }');
+
+// The data is copied from the source when it is created.
+source[0] = 255;
+const ab = shared.toArrayBuffer();
+assert(ab instanceof ArrayBuffer);
+assert.strictEqual(shared.toArrayBuffer(), ab);
+assert.strictEqual(new Uint8Array(ab)[0], 0);
+
+// Writes to an ArrayBuffer are private to it.
+new Uint8Array(ab).fill(1);
+{
+  const { port1, port2 } = new MessageChannel();
+  port1.postMessage(shared);
+  port2.once('message', common.mustCall((clone) => {
+    assert(clone instanceof ImmutableBuffer);
+    assert.notStrictEqual(clone, shared);
+    assert.strictEqual(clone.byteLength, source.length);
+    const view = new Uint8Array(clone.toArrayBuffer());
+    assert.strictEqual(view[0], 0);
+    assert.strictEqual(view[4096 + 5], (4096 + 5) % 256);
+    port1.close();
+  }));
+}
+
+// It is shared with any number of workers.
+for (let i = 0; i < 3; i++) {
+  const worker = new Worker(__filename, { workerData: shared });
+  worker.on('message', common.mustCall(({ sum, length }) => {
+    assert.strictEqual(sum, expectedSum);
+    assert.strictEqual(length, source.length);
+  }));
+  worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+}
+
+// Other binary sources and empty ones work as well.
+assert.deepStrictEqual(
+  new Uint8Array(new ImmutableBuffer(new Uint16Array([1, 2])).toArrayBuffer()),
+  new Uint8Array(new Uint16Array([1, 2]).buffer));
+assert.strictEqual(
+  new ImmutableBuffer(new ArrayBuffer(0)).toArrayBuffer().byteLength, 0);
+assert.strictEqual(
+  new ImmutableBuffer(new SharedArrayBuffer(8)).byteLength, 8);
+
+for (const source of [undefined, 'string', [1, 2]]) {
+  assert.throws(() => new ImmutableBuffer(source), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
@@ -0,0 +1,65 @@
+'use strict';
+
+// Workers report the growth of their heap, and can be told that memory is
+// running low.
+
+const common = require('../common');
+const assert = require('assert');
+const { Worker, notifyMemoryPressure } = require('worker_threads');
+
+assert.throws(() => notifyMemoryPressure('low'), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.throws(() => new Worker('', { eval: true, heapGrowthReportMb: '1' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => new Worker('', { eval: true, heapGrowthReportMb: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+
+notifyMemoryPressure();
+
+{
+  // The heap of the worker grows by about 16 MB, which takes a few garbage
+  // collections.
+  const w = new Worker(`
+    const retained = [];
+    for (let i = 0; i < 200; i++)
+      retained.push(new Array(1e4).fill(i + 0.5));
+  `, { eval: true, heapGrowthReportMb: 1 });
+
+  let reports = 0;
+  w.on('heapGrowth', ({ usedHeapSize, heapSizeLimit }) => {
+    reports++;
+    assert(usedHeapSize > 1024 * 1024);
+    assert(heapSizeLimit > usedHeapSize);
+  });
+  w.on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    assert(reports > 0);
+  }));
+}
+
+{
+  // The garbage of a worker is collected when memory is running low.
+  const w = new Worker(`
+    const { parentPort } = require('worker_threads');
+    const registry = new FinalizationRegistry(() => {
+      parentPort.postMessage('collected');
+    });
+    (function() {
+      registry.register({}, 'garbage');
+    })();
+    parentPort.postMessage('ready');
+    setInterval(() => {}, 10);
+  `, { eval: true });
+
+  w.on('message', common.mustCall((message) => {
+    if (message === 'ready') {
+      notifyMemoryPressure('critical');
+    } else {
+      assert.strictEqual(message, 'collected');
+      w.terminate();
+    }
+  }, 2));
+}
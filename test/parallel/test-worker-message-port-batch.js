@@ -0,0 +1,103 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const {
+  MessageChannel,
+  receiveMessageOnPort,
+} = require('worker_threads');
+
+// Messages that are queued together are passed to JS in a single call from
+// C++. Make sure that this can't be observed from JS.
+
+function post(port, count) {
+  for (let i = 0; i < count; i++)
+    port.postMessage(i);
+}
+
+// Ticks and microtasks run in between messages.
+{
+  const { port1, port2 } = new MessageChannel();
+  const events = [];
+  port1.on('message', common.mustCall((value) => {
+    events.push(`message ${value}`);
+    process.nextTick(() => events.push(`tick ${value}`));
+    queueMicrotask(() => events.push(`microtask ${value}`));
+    if (value === 2) {
+      port1.close();
+      setImmediate(common.mustCall(() => {
+        assert.deepStrictEqual(events, [
+          'message 0', 'tick 0', 'microtask 0',
+          'message 1', 'tick 1', 'microtask 1',
+          'message 2', 'tick 2', 'microtask 2',
+        ]);
+      }));
+    }
+  }, 3));
+  post(port2, 3);
+}
+
+// Messages that have not been emitted yet move along with the port when it
+// is transferred.
+{
+  const { port1, port2 } = new MessageChannel();
+  const { port1: target1, port2: target2 } = new MessageChannel();
+  const received = [];
+  port1.on('message', common.mustCall((value) => {
+    received.push(value);
+    if (value === 3)
+      target1.postMessage(port1, [port1]);
+  }, 4));
+  target2.once('message', common.mustCall((port) => {
+    port.on('message', (value) => {
+      received.push(value);
+      if (value === 9) {
+        assert.deepStrictEqual(received, [0, 1, 2, 3, 4, 5, 6, 7, 8, 9]);
+        port.close();
+        target2.close();
+      }
+    });
+  }));
+  post(port2, 10);
+}
+
+// receiveMessageOnPort() returns the next message that has not been emitted.
+{
+  const { port1, port2 } = new MessageChannel();
+  const received = [];
+  port1.on('message', common.mustCall((value) => {
+    received.push(value);
+    if (value === 1)
+      received.push(receiveMessageOnPort(port1).message);
+    if (value === 4) {
+      assert.deepStrictEqual(received, [0, 1, 2, 3, 4]);
+      port1.close();
+    }
+  }, 4));
+  post(port2, 5);
+}
+
+// A listener that throws does not cause later messages to be lost or to be
+// emitted out of order. Messages with transferables keep their place, too.
+{
+  const { port1, port2 } = new MessageChannel();
+  const received = [];
+  process.on('uncaughtException', common.mustCall((err) => {
+    assert.strictEqual(err.message, 'boom');
+  }));
+  port1.on('message', (value) => {
+    if (value instanceof ArrayBuffer)
+      value = `buffer ${value.byteLength}`;
+    received.push(value);
+    if (value === 1)
+      throw new Error('boom');
+    if (value === 5) {
+      assert.deepStrictEqual(received, [0, 1, 2, 'buffer 3', 4, 5]);
+      port1.close();
+    }
+  });
+  post(port2, 3);
+  const buffer = new ArrayBuffer(3);
+  port2.postMessage(buffer, [buffer]);
+  port2.postMessage(4);
+  port2.postMessage(5);
+}
@@ -0,0 +1,117 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const vm = require('vm');
+const { MessageChannel, receiveMessageOnPort } = require('worker_threads');
+
+// Messages without transferables that only contain primitives, plain objects,
+// arrays and ArrayBuffers are not serialized by V8's ValueSerializer. Make
+// sure that they are received the same way as the ones that are, which is
+// the case whenever there is a transfer list.
+
+const { port1, port2 } = new MessageChannel();
+
+function clone(value, transferList) {
+  port1.postMessage(value, transferList);
+  return receiveMessageOnPort(port2).message;
+}
+
+function check(value) {
+  const expected = clone(value, [new ArrayBuffer(1)]);
+  assert.deepStrictEqual(clone(value), expected);
+  return expected;
+}
+
+const pooled = Buffer.from('abc');
+const buffer = new ArrayBuffer(16);
+const shared = { shared: true };
+const nullPrototype = Object.create(null);
+nullPrototype.a = 1;
+class Foo {
+  constructor() {
+    this.a = 1;
+  }
+}
+const date = new Date(0);
+Object.setPrototypeOf(date, Object.prototype);
+const values = [
+  undefined, null, true, false, 0, -0, 1, -1, 2 ** 31 - 1, -(2 ** 31),
+  2 ** 31, 1.5, NaN, Infinity, -Infinity, Number.MAX_VALUE,
+  '', 'abc', 'é', '€', '\u{1F600}', '\uD800', 'x'.repeat(1000),
+  {}, { a: 1, b: 'c' }, { 'é': 1, '€': 2 }, { __proto__: null },
+  { ['__proto__']: 1 }, { nested: { deeply: { nested: [1, { a: 2 }] } } },
+  [], [1, 2, 3], [[], [[]]], [1, 'a', null, undefined],
+  [{ x: 1, y: 2 }, { x: 3, y: 4 }, { y: 5, x: 6 }, { x: 7 }],
+  // Integer keys, holes and extra properties.
+  { 1: 'a', b: 'c' }, [1, , 3], Object.assign([1, 2], { foo: 'bar' }),
+  new Array(5), new Array(2000).fill(1),
+  // Typed arrays that do not cover their whole buffer, and a Buffer that
+  // shares its buffer with other ones.
+  buffer, new Uint8Array(buffer, 4, 8), new Float64Array(buffer, 8, 1),
+  new DataView(buffer, 1, 3), new BigInt64Array(2), pooled, new Uint8Array(0),
+  { a: new Uint8Array(buffer), b: new Int32Array(buffer) },
+  { a: shared, b: [shared, shared] },
+  nullPrototype, date, new Date(0), /a/g, new Map([[1, 2]]), new Set([1]),
+  new Error('foo'), 1n, Object(1), Object('a'), new SharedArrayBuffer(4),
+  vm.runInNewContext('({ a: 1 })'), new Foo(),
+];
+for (const value of values)
+  check(value);
+
+// Object identity is preserved.
+{
+  const { a, b } = check({ a: shared, b: [shared, shared] });
+  assert.strictEqual(a, b[0]);
+  assert.strictEqual(a, b[1]);
+  const views = check({ a: new Uint8Array(buffer), b: new Int32Array(buffer) });
+  assert.strictEqual(views.a.buffer, views.b.buffer);
+  assert.strictEqual(check(pooled).buffer.byteLength, pooled.buffer.byteLength);
+}
+
+// Cycles.
+{
+  const object = { a: [] };
+  object.a.push(object);
+  const result = check(object);
+  assert.strictEqual(result.a[0], result);
+}
+
+// Getters are run exactly once, even if the value ends up being serialized
+// by V8.
+{
+  let calls = 0;
+  const object = {
+    get a() { calls++; return 1; },
+    b: new Map(),
+  };
+  assert.deepStrictEqual(clone(object), { a: 1, b: new Map() });
+  assert.strictEqual(calls, 1);
+
+  const array = [1, 2];
+  Object.defineProperty(array, 0, {
+    get() { calls++; return 0; },
+    enumerable: true
+  });
+  assert.deepStrictEqual(clone(array), [0, 2]);
+  assert.strictEqual(calls, 2);
+}
+
+// Values that cannot be cloned still throw.
+for (const value of [Symbol('foo'), { a: () => {} }, [new Proxy({}, {})]]) {
+  assert.throws(() => port1.postMessage(value), {
+    name: 'DataCloneError'
+  });
+}
+
+// Many objects of the same shape.
+{
+  const objects = [];
+  for (let i = 0; i < 1000; i++)
+    objects.push({ id: i, name: `item ${i}`, tags: ['a', 'b'] });
+  const result = check({ objects });
+  assert.strictEqual(result.objects[999].name, 'item 999');
+  assert.deepStrictEqual(Object.keys(result.objects[500]),
+                         ['id', 'name', 'tags']);
+}
+
+port1.close();
@@ -0,0 +1,112 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const { Pool } = require('worker_threads');
+
+const filename = fixtures.path('worker-pool-task.js');
+
+(async () => {
+  // Results, errors and the options that are passed to the workers.
+  {
+    const pool = new Pool(filename, { size: 2, workerData: { foo: 'bar' } });
+    assert.strictEqual(pool.size, 2);
+    assert.deepStrictEqual(
+      await pool.run({ op: 'echo', value: { a: [1, 2] } }), { a: [1, 2] });
+    assert.deepStrictEqual(await pool.run({ op: 'workerData' }),
+                           { foo: 'bar' });
+    await assert.rejects(pool.run({ op: 'throw', value: 'foo' }), {
+      name: 'TypeError',
+      message: 'foo'
+    });
+
+    const buffer = new ArrayBuffer(8);
+    const view = new Uint8Array(buffer);
+    const result = await pool.run({ op: 'echo', value: view },
+                                  { transferList: [buffer] });
+    assert.strictEqual(buffer.byteLength, 0);
+    assert.strictEqual(result.length, 8);
+
+    const stats = pool.stats;
+    assert.strictEqual(stats.completed, 3);
+    assert.strictEqual(stats.failed, 1);
+    assert.strictEqual(stats.queued, 0);
+    assert.strictEqual(stats.running, 0);
+    assert(stats.utilization >= 0 && stats.utilization <= 1);
+    assert.strictEqual(stats.heapUsed, 0);
+    await pool.close();
+    assert.strictEqual(pool.stats.workers, 0);
+    await assert.rejects(pool.run({ op: 'echo' }), {
+      code: 'ERR_INVALID_STATE'
+    });
+  }
+
+  // A slow task does not hold up the ones that are queued after it.
+  {
+    const pool = new Pool(filename, { size: 2 });
+    const controller = new AbortController();
+    const slow = pool.run({ op: 'wait', value: 1e6 },
+                          { signal: controller.signal });
+    const fast = [];
+    for (let i = 0; i < 10; i++)
+      fast.push(pool.run({ op: 'thread' }));
+    assert.strictEqual(pool.stats.queued, 9);
+    const threadIds = await Promise.all(fast);
+    assert.strictEqual(new Set(threadIds).size, 1);
+    assert.strictEqual(pool.stats.running, 1);
+    controller.abort();
+    await assert.rejects(slow, { name: 'AbortError' });
+    await pool.close();
+  }
+
+  // Tasks can be cancelled while they are queued or running, and workers that
+  // exit are replaced.
+  {
+    const pool = new Pool(filename, { size: 1 });
+    const running = new AbortController();
+    const queued = new AbortController();
+    const first = pool.run({ op: 'wait', value: 1e6 },
+                           { signal: running.signal });
+    const second = pool.run({ op: 'echo', value: 1 },
+                            { signal: queued.signal });
+    const third = pool.run({ op: 'echo', value: 2 });
+    queued.abort();
+    await assert.rejects(second, { name: 'AbortError' });
+    running.abort();
+    await assert.rejects(first, { name: 'AbortError' });
+    assert.strictEqual(await third, 2);
+
+    await assert.rejects(pool.run({ op: 'exit', value: 3 }), {
+      code: 'ERR_WORKER_EXITED'
+    });
+    assert.strictEqual(await pool.run({ op: 'echo', value: 4 }), 4);
+
+    const aborted = new AbortController();
+    aborted.abort();
+    await assert.rejects(pool.run({ op: 'echo' }, { signal: aborted.signal }),
+                         { name: 'AbortError' });
+    assert.strictEqual(pool.stats.cancelled, 2);
+    await pool.close();
+  }
+
+  // ES modules.
+  {
+    const pool = new Pool(fixtures.path('worker-pool-task.mjs'));
+    assert.strictEqual(await pool.run(21), 42);
+    await pool.close();
+  }
+
+  // An idle pool does not keep the process alive.
+  {
+    const pool = new Pool(filename);
+    await pool.run({ op: 'echo' });
+  }
+})().then(common.mustCall());
+
+assert.throws(() => new Pool(filename, { size: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => new Pool(filename, { eval: true }), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.throws(() => new Pool('foo.js'), { code: 'ERR_WORKER_PATH' });
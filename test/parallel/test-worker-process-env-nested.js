@@ -0,0 +1,36 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { Worker, workerData, parentPort } = require('worker_threads');
+
+// Workers started from a Worker that has its own environment share the
+// variables until one side changes them.
+
+if (!workerData) {
+  new Worker(__filename, {
+    workerData: 'parent',
+    env: { SET_IN_MAIN: 'main' }
+  }).on('exit', common.mustCall((code) => {
+    assert.strictEqual(code, 0);
+    assert.strictEqual(process.env.SET_IN_NESTED, undefined);
+  }));
+} else if (workerData === 'parent') {
+  process.env.SET_IN_PARENT = 'parent';
+  const nested = new Worker(__filename, { workerData: 'nested' });
+  process.env.SET_IN_PARENT_AFTER_CREATION = 'parent';
+  delete process.env.SET_IN_MAIN;
+  nested.on('message', common.mustCall((env) => {
+    assert.deepStrictEqual(env, {
+      SET_IN_MAIN: 'main',
+      SET_IN_PARENT: 'parent',
+      SET_IN_NESTED: 'nested'
+    });
+    assert.deepStrictEqual({ ...process.env }, {
+      SET_IN_PARENT: 'parent',
+      SET_IN_PARENT_AFTER_CREATION: 'parent'
+    });
+  }));
+} else {
+  process.env.SET_IN_NESTED = 'nested';
+  parentPort.postMessage({ ...process.env });
+}
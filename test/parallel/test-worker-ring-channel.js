@@ -0,0 +1,102 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { MessageChannel, RingChannel, Worker } = require('worker_threads');
+
+// Frames come out in order, including ones that wrap around the end of the
+// ring. Binary frames are returned as Buffers, other ones are cloned.
+{
+  const { writer, reader } = new RingChannel({ byteLength: 64 });
+  assert.strictEqual(reader.read(), undefined);
+  for (let i = 0; i < 100; i++) {
+    const data = Buffer.alloc(i % 23, i);
+    assert.strictEqual(writer.write(new Uint8Array(data)), true);
+    assert.strictEqual(writer.postMessage({ i }), true);
+    assert.deepStrictEqual(reader.read(), { message: data });
+    assert.deepStrictEqual(reader.read(), { message: { i } });
+    assert.strictEqual(reader.read(), undefined);
+  }
+  writer.write(new ArrayBuffer(3));
+  writer.write(new DataView(new ArrayBuffer(8), 2, 4));
+  assert.deepStrictEqual(reader.read(), { message: Buffer.alloc(3) });
+  assert.deepStrictEqual(reader.read(), { message: Buffer.alloc(4) });
+  reader.close();
+}
+
+// The size is rounded up to a power of two, and frames that do not fit into
+// the ring at all are rejected.
+{
+  const { writer, reader } = new RingChannel({ byteLength: 100 });
+  assert.strictEqual(writer.write(Buffer.alloc(124)), true);
+  assert.strictEqual(writer.write(Buffer.alloc(0)), false);
+  assert.strictEqual(reader.read().message.length, 124);
+  assert.throws(() => writer.write(Buffer.alloc(125)), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => writer.write('foo'), { code: 'ERR_INVALID_ARG_TYPE' });
+  writer.close();
+}
+
+for (const byteLength of [0, 2 ** 30 + 1, 1.5, '64']) {
+  assert.throws(() => new RingChannel({ byteLength }), {
+    code: typeof byteLength === 'string' ?
+      'ERR_INVALID_ARG_TYPE' : 'ERR_OUT_OF_RANGE'
+  });
+}
+
+// A full ring makes the writer wait for 'drain'.
+{
+  const { writer, reader } = new RingChannel({ byteLength: 64 });
+  let written = 0;
+  while (writer.write(Buffer.from([written])))
+    written++;
+  assert.strictEqual(written, 8);
+  writer.on('drain', common.mustCall(() => {
+    assert.strictEqual(writer.write(Buffer.from([written])), true);
+    writer.close();
+  }));
+  const received = [];
+  reader.on('message', (message) => received.push(message[0]));
+  reader.on('close', common.mustCall(() => {
+    assert.deepStrictEqual(received, [0, 1, 2, 3, 4, 5, 6, 7, 8]);
+    assert.throws(() => reader.read(), { code: 'ERR_INVALID_STATE' });
+    assert.throws(() => writer.write(Buffer.alloc(1)), {
+      code: 'ERR_INVALID_STATE'
+    });
+  }));
+}
+
+// Both ends can be moved to other threads.
+{
+  const { writer, reader } = new RingChannel({ byteLength: 1024 });
+  const { port1, port2 } = new MessageChannel();
+  port1.postMessage(reader, [reader]);
+  assert.throws(() => reader.read(), { code: 'ERR_INVALID_STATE' });
+  port2.once('message', common.mustCall((reader) => {
+    port2.close();
+    const w = new Worker(`
+      const { workerData: writer } = require('worker_threads');
+      let i = 0;
+      function write() {
+        while (i < 1000) {
+          if (!writer.write(Buffer.from(String(i))))
+            return writer.once('drain', write);
+          i++;
+        }
+        writer.postMessage({ done: true });
+        writer.close();
+      }
+      write();
+    `, { eval: true, workerData: writer, transferList: [writer] });
+    let expected = 0;
+    reader.on('message', common.mustCall((message) => {
+      if (expected === 1000) {
+        assert.deepStrictEqual(message, { done: true });
+      } else {
+        assert.strictEqual(message.toString(), String(expected++));
+      }
+    }, 1001));
+    reader.on('close', common.mustCall());
+    w.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+  }));
+}
@@ -0,0 +1,92 @@
+// Flags: --experimental-vm-compile-cache
+'use strict';
+
+// With --experimental-vm-compile-cache, the modules that Workers load are
+// compiled once, by the first Worker that loads them, and the other Workers
+// use the code cache of that compilation.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const vm = require('vm');
+const { once } = require('events');
+const { Worker } = require('worker_threads');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const cjs = path.join(tmpdir.path, 'shared-code-cache.js');
+const esm = path.join(tmpdir.path, 'shared-code-cache.mjs');
+// Make the sources unique, so that no other code shares their cache entries.
+fs.writeFileSync(cjs, `module.exports = ${process.pid} + 1;`);
+fs.writeFileSync(esm, `export default ${process.pid} + 2;`);
+
+function writeMain(filename) {
+  const source = `
+    const { parentPort } = require('worker_threads');
+    import(${JSON.stringify(filename)})
+      .then((ns) => parentPort.postMessage(ns.default));
+  `;
+  const main = path.join(tmpdir.path, `${path.basename(filename)}-main.js`);
+  fs.writeFileSync(main, source);
+  return main;
+}
+
+async function runWorker(filename, options) {
+  const worker = new Worker(filename, options);
+  // 'exit' can be emitted in the same tick as the last 'message'.
+  const message = once(worker, 'message');
+  const exit = once(worker, 'exit');
+  const [value] = await message;
+  await exit;
+  return value;
+}
+
+(async () => {
+  for (const filename of [cjs, esm]) {
+    const main = writeMain(filename);
+    const expected = process.pid + (filename === cjs ? 1 : 2);
+
+    // The first Worker compiles the modules and fills the cache.
+    const before = vm.getCompileCacheStatistics();
+    assert.strictEqual(await runWorker(main), expected);
+    const first = vm.getCompileCacheStatistics();
+    assert(first.misses > before.misses);
+    assert(first.entries > before.entries);
+
+    // The next ones use it.
+    for (let i = 0; i < 3; i++)
+      assert.strictEqual(await runWorker(main), expected);
+    const last = vm.getCompileCacheStatistics();
+    assert(last.hits >= first.hits + 6, `${last.hits} - ${first.hits}`);
+    assert.strictEqual(last.misses, first.misses);
+    assert.strictEqual(last.entries, first.entries);
+
+    // Workers without the flag do not use the cache.
+    assert.strictEqual(await runWorker(main, { execArgv: [] }), expected);
+    assert.deepStrictEqual(vm.getCompileCacheStatistics(), last);
+  }
+
+  // The main thread uses the entries of the Workers.
+  {
+    const before = vm.getCompileCacheStatistics();
+    assert.strictEqual(require(cjs), process.pid + 1);
+    const after = vm.getCompileCacheStatistics();
+    assert.strictEqual(after.hits, before.hits + 1);
+    assert.strictEqual(after.misses, before.misses);
+  }
+
+  // Modules are cached by filename and source, so the same source in another
+  // file has an entry of its own.
+  {
+    const copy = path.join(tmpdir.path, 'shared-code-cache-copy.js');
+    fs.copyFileSync(cjs, copy);
+    const before = vm.getCompileCacheStatistics();
+    assert.strictEqual(require(copy), process.pid + 1);
+    const after = vm.getCompileCacheStatistics();
+    assert.strictEqual(after.hits, before.hits);
+    assert.strictEqual(after.misses, before.misses + 1);
+    assert.strictEqual(after.entries, before.entries + 1);
+  }
+})().then(common.mustCall());
@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+// Workers start out from the base context in the startup snapshot, unless
+// --no-node-snapshot is passed to them. Both should end up the same.
+
+const code = `
+  const { parentPort } = require('worker_threads');
+  const { performance } = require('perf_hooks');
+  const timing = performance.nodeTiming.toJSON();
+  // DOMException is not a global, but the per-context one is used for this.
+  let dataCloneError;
+  try {
+    parentPort.postMessage(Symbol('foo'));
+  } catch (err) {
+    dataCloneError = { name: err.name, code: err.code };
+  }
+  parentPort.postMessage({
+    dataCloneError,
+    globals: Object.getOwnPropertyNames(globalThis).sort(),
+    atomicsWake: 'wake' in Atomics,
+    timing,
+  });
+`;
+
+function start(execArgv) {
+  return new Promise((resolve) => {
+    const worker = new Worker(code, { eval: true, execArgv });
+    worker.once('message', resolve);
+    worker.on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+  });
+}
+
+(async () => {
+  const parentTiming = performance.nodeTiming;
+  const before = performance.now();
+  const fromSnapshot = await start([]);
+  const withoutSnapshot = await start(['--no-node-snapshot']);
+  assert.deepStrictEqual(fromSnapshot.globals, withoutSnapshot.globals);
+  assert.strictEqual(fromSnapshot.atomicsWake, false);
+  assert.strictEqual(withoutSnapshot.atomicsWake, false);
+  for (const { dataCloneError } of [fromSnapshot, withoutSnapshot]) {
+    assert.deepStrictEqual(dataCloneError,
+                           { name: 'DataCloneError', code: 25 });
+  }
+
+  // The startup milestones of Workers are those of their own thread.
+  for (const { timing } of [fromSnapshot, withoutSnapshot]) {
+    assert(timing.nodeStart >= before, `${timing.nodeStart} < ${before}`);
+    assert(timing.nodeStart > parentTiming.nodeStart);
+    assert(timing.v8Start >= timing.nodeStart);
+    assert(timing.environment >= timing.v8Start);
+    assert(timing.bootstrapComplete >= timing.environment);
+  }
+})().then(common.mustCall());
@@ -0,0 +1,84 @@
+'use strict';
+
+const common = require('../common');
+
+// Deflate states of closed streams are reused by new streams with the same
+// parameters. The output must not depend on whether a state was reused.
+
+const assert = require('assert');
+const zlib = require('zlib');
+
+const input = Buffer.from('hello world '.repeat(1000));
+
+const variants = [
+  ['deflateSync', 'inflateSync', {}],
+  ['deflateSync', 'inflateSync', { level: 1 }],
+  ['deflateSync', 'inflateSync', { level: 9, memLevel: 9 }],
+  ['deflateSync', 'inflateSync', { strategy: zlib.constants.Z_RLE }],
+  ['gzipSync', 'gunzipSync', {}],
+  ['gzipSync', 'gunzipSync', { windowBits: 9 }],
+  ['deflateRawSync', 'inflateRawSync', {}],
+];
+
+const expected = variants.map(([compress, , opts]) => {
+  return zlib[compress](input, opts);
+});
+
+for (let i = 0; i < 3; i++) {
+  variants.forEach(([compress, decompress, opts], j) => {
+    const result = zlib[compress](input, opts);
+    assert.deepStrictEqual(result, expected[j]);
+    assert.deepStrictEqual(zlib[decompress](result), input);
+  });
+}
+
+// States are only shared between streams with the same dictionary.
+{
+  const dictionaries = [
+    Buffer.from('hello world '),
+    Buffer.from('world hello '),
+    Buffer.from('{"hello":"world"}'),
+  ];
+  for (const [compress, decompress] of [['deflateSync', 'inflateSync'],
+                                        ['deflateRawSync', 'inflateRawSync']]) {
+    const withDictionary = dictionaries.map((dictionary) => {
+      return zlib[compress](input, { dictionary });
+    });
+    assert.notDeepStrictEqual(withDictionary[0], withDictionary[1]);
+    for (let i = 0; i < 3; i++) {
+      assert.deepStrictEqual(zlib.deflateSync(input), expected[0]);
+      dictionaries.forEach((dictionary, j) => {
+        const result = zlib[compress](input, { dictionary });
+        assert.deepStrictEqual(result, withDictionary[j]);
+        assert.deepStrictEqual(zlib[decompress](result, { dictionary }),
+                               input);
+      });
+    }
+  }
+}
+
+// A state whose parameters were changed is not used for the old parameters.
+{
+  const deflate = zlib.createDeflate({ level: 1 });
+  deflate.write(input.slice(0, 10), common.mustCall(() => {
+    deflate.params(9, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+      deflate.end(input.slice(10));
+    }));
+  }));
+  deflate.resume();
+  deflate.on('close', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.deflateSync(input, { level: 1 }), expected[1]);
+  }));
+}
+
+// Reused states work for asynchronous streams as well.
+{
+  let pending = 20;
+  for (let i = 0; i < 20; i++) {
+    zlib.gzip(input, common.mustSucceed((result) => {
+      assert.deepStrictEqual(result, expected[4]);
+      if (--pending === 0)
+        assert.deepStrictEqual(zlib.gzipSync(input), expected[4]);
+    }));
+  }
+}
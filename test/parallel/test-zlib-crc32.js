@@ -0,0 +1,58 @@
+'use strict';
+
+require('../common');
+
+const assert = require('assert');
+const zlib = require('zlib');
+
+const bytes = Buffer.alloc(25600);
+for (let i = 0; i < bytes.length; i++)
+  bytes[i] = i & 0xff;
+
+// [data, crc32, adler32]
+const tests = [
+  ['', 0, 1],
+  ['a', 3904355907, 6422626],
+  ['hello world', 222957957, 436929629],
+  ['été', 1154575572, 167969613],
+  [bytes, 319769915, 1954533600],
+];
+
+for (const [data, crc, adler] of tests) {
+  assert.strictEqual(zlib.crc32(data), crc);
+  assert.strictEqual(zlib.adler32(data), adler);
+
+  const buffer = Buffer.from(data);
+  assert.strictEqual(zlib.crc32(buffer), crc);
+  assert.strictEqual(zlib.adler32(buffer), adler);
+  assert.strictEqual(zlib.crc32(new Uint8Array(buffer)), crc);
+  assert.strictEqual(
+    zlib.adler32(new DataView(buffer.buffer, buffer.byteOffset,
+                              buffer.byteLength)),
+    adler);
+
+  // The checksum can be computed piece by piece.
+  for (const split of [0, 1, buffer.length >> 1, buffer.length]) {
+    const head = buffer.subarray(0, split);
+    const tail = buffer.subarray(split);
+    assert.strictEqual(zlib.crc32(tail, zlib.crc32(head)), crc);
+    assert.strictEqual(zlib.adler32(tail, zlib.adler32(head)), adler);
+  }
+}
+
+// The value of the gzip trailer.
+{
+  const gzipped = zlib.gzipSync(bytes);
+  assert.strictEqual(gzipped.readUInt32LE(gzipped.length - 8),
+                     zlib.crc32(bytes));
+}
+
+for (const fn of [zlib.crc32, zlib.adler32]) {
+  for (const data of [undefined, null, 1, {}, [1, 2]]) {
+    assert.throws(() => fn(data), { code: 'ERR_INVALID_ARG_TYPE' });
+  }
+  for (const value of [-1, 2 ** 32, 1.5]) {
+    assert.throws(() => fn('a', value), { code: 'ERR_OUT_OF_RANGE' });
+  }
+  assert.throws(() => fn('a', '1'), { code: 'ERR_INVALID_ARG_TYPE' });
+}
@@ -0,0 +1,57 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With inlineThreshold, small inputs are compressed on the main thread and do
+// not wait for the threadpool, but their callbacks are still called
+// asynchronously. By default, all of them use the threadpool.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const zlib = require('zlib');
+
+const input = Buffer.from('x'.repeat(200));
+const inlineThreshold = 1024;
+const threads = +process.env.UV_THREADPOOL_SIZE || 4;
+
+const order = [];
+// Keeps every thread of the threadpool busy for a while.
+for (let i = 0; i < threads; i++) {
+  crypto.pbkdf2('password', 'salt', 3e5, 32, 'sha256',
+                common.mustSucceed(() => order.push('pbkdf2')));
+}
+
+let sync = true;
+zlib.deflate(input, { inlineThreshold }, common.mustSucceed((result) => {
+  assert.strictEqual(sync, false);
+  assert.deepStrictEqual(zlib.inflateSync(result), input);
+  order.push('inline');
+}));
+zlib.deflate(input, common.mustSucceed((result) => {
+  assert.deepStrictEqual(zlib.inflateSync(result), input);
+  order.push('threadpool');
+}));
+sync = false;
+
+// Both paths report errors the same way.
+zlib.inflate(Buffer.from('not zlib data'), { inlineThreshold },
+             common.mustCall((err) => {
+               assert.strictEqual(err.code, 'Z_DATA_ERROR');
+             }));
+zlib.inflate(Buffer.from('not zlib data'), common.mustCall((err) => {
+  assert.strictEqual(err.code, 'Z_DATA_ERROR');
+}));
+
+process.on('exit', () => {
+  assert.strictEqual(order[0], 'inline');
+  assert(order.indexOf('threadpool') > order.indexOf('pbkdf2'));
+});
+
+for (const inlineThreshold of [-1, 2 ** 32, 'a']) {
+  assert.throws(() => zlib.createDeflate({ inlineThreshold }), {
+    code: typeof inlineThreshold === 'number' ?
+      'ERR_OUT_OF_RANGE' : 'ERR_INVALID_ARG_TYPE',
+  });
+}
@@ -0,0 +1,87 @@
+'use strict';
+
+// Compressing with the parallelBlockSize option produces streams that
+// decompress to the input.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const blockSize = 32 * 1024;
+// Repetitive enough for the dictionaries to matter, and not a multiple of
+// the block size.
+const input = Buffer.from(
+  Array.from({ length: 60000 }, (_, i) => `line ${i % 997}\n`).join(''));
+assert(input.length > 4 * blockSize);
+
+const methods = [
+  ['gzip', 'gunzipSync'],
+  ['deflate', 'inflateSync'],
+  ['deflateRaw', 'inflateRawSync'],
+];
+
+for (const [compress, decompress] of methods) {
+  for (const options of [
+    {},
+    { level: 1 },
+    { level: 9, memLevel: 9 },
+    { level: 0 },
+    { strategy: zlib.constants.Z_HUFFMAN_ONLY },
+    { windowBits: 9 },
+  ]) {
+    zlib[compress](input, { ...options, parallelBlockSize: blockSize },
+                   common.mustSucceed((result) => {
+                     assert(Buffer.isBuffer(result));
+                     assert.deepStrictEqual(zlib[decompress](result, options),
+                                            input);
+                   }));
+  }
+}
+
+// The header, apart from the operating system byte, and the trailer are those
+// of a regular gzip stream.
+zlib.gzip(input, { parallelBlockSize: blockSize },
+          common.mustSucceed((result) => {
+            const regular = zlib.gzipSync(input);
+            assert.deepStrictEqual(result.slice(0, 9), regular.slice(0, 9));
+            assert.deepStrictEqual(result.slice(-8), regular.slice(-8));
+            // The blocks can be inflated as a stream, too.
+            zlib.gunzip(result, common.mustSucceed((output) => {
+              assert.deepStrictEqual(output, input);
+            }));
+          }));
+
+// Typed arrays, strings and inputs no larger than one block.
+zlib.gzip(new Uint16Array(input.buffer, input.byteOffset, input.length / 2),
+          { parallelBlockSize: blockSize }, common.mustSucceed((result) => {
+            assert.deepStrictEqual(zlib.gunzipSync(result),
+                                   input.slice(0, input.length & ~1));
+          }));
+zlib.gzip(input.toString(), { parallelBlockSize: blockSize },
+          common.mustSucceed((result) => {
+            assert.deepStrictEqual(zlib.gunzipSync(result), input);
+          }));
+zlib.gzip('small', { parallelBlockSize: blockSize },
+          common.mustSucceed((result) => {
+            assert.strictEqual(zlib.gunzipSync(result).toString(), 'small');
+          }));
+
+zlib.gzip(input, { parallelBlockSize: blockSize, maxOutputLength: 100 },
+          common.mustCall((err) => {
+            assert.strictEqual(err.code, 'ERR_BUFFER_TOO_LARGE');
+          }));
+
+for (const parallelBlockSize of [1024, 2 ** 31, 'a']) {
+  assert.throws(() => {
+    zlib.gzip(input, { parallelBlockSize }, common.mustNotCall());
+  }, {
+    code: typeof parallelBlockSize === 'number' ?
+      'ERR_OUT_OF_RANGE' : 'ERR_INVALID_ARG_TYPE',
+  });
+}
+assert.throws(() => {
+  zlib.gzip(input, { parallelBlockSize: blockSize, level: 10 },
+            common.mustNotCall());
+}, {
+  code: 'ERR_OUT_OF_RANGE',
+});
@@ -0,0 +1,69 @@
+'use strict';
+
+// Test leaving sections out of the report with --report-exclude.
+require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const sections = ['cpus', 'environmentVariables', 'libuv', 'nativeStack',
+                  'networkInterfaces', 'sharedObjects', 'userLimits',
+                  'workers'];
+
+function assertExcluded(report, excluded) {
+  assert.strictEqual('cpus' in report.header,
+                     !excluded.includes('cpus'));
+  assert.strictEqual('networkInterfaces' in report.header,
+                     !excluded.includes('networkInterfaces'));
+  for (const section of ['environmentVariables', 'libuv', 'nativeStack',
+                         'sharedObjects', 'workers']) {
+    assert.strictEqual(section in report, !excluded.includes(section),
+                       section);
+  }
+  if (process.platform !== 'win32') {
+    assert.strictEqual('userLimits' in report,
+                       !excluded.includes('userLimits'));
+  }
+  assert(report.javascriptStack);
+  assert(report.javascriptHeap);
+}
+
+assert.deepStrictEqual(process.report.exclude, []);
+assertExcluded(process.report.getReport(), []);
+
+process.report.exclude = ['networkInterfaces', 'sharedObjects'];
+assert.deepStrictEqual(process.report.exclude,
+                       ['networkInterfaces', 'sharedObjects']);
+assertExcluded(process.report.getReport(),
+               ['networkInterfaces', 'sharedObjects']);
+
+process.report.exclude = sections;
+assertExcluded(process.report.getReport(), sections);
+
+process.report.exclude = [];
+assertExcluded(process.report.getReport(), []);
+
+assert.throws(() => { process.report.exclude = 'cpus'; }, {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => { process.report.exclude = ['cpus', 'header']; }, {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+assert.deepStrictEqual(process.report.exclude, []);
+
+{
+  const child = spawnSync(process.execPath, [
+    '--report-exclude=cpus,libuv',
+    '-p', 'JSON.stringify(process.report.getReport())',
+  ]);
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  assertExcluded(JSON.parse(child.stdout), ['cpus', 'libuv']);
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--report-exclude=cpus,header', '-e', '',
+  ]);
+  assert.notStrictEqual(child.status, 0);
+  assert(child.stderr.toString().includes(
+    'invalid value for --report-exclude: header'), child.stderr.toString());
+}
@@ -0,0 +1,66 @@
+'use strict';
+
+// Test writing a report from the threadpool with writeReportAsync().
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const helper = require('../common/report');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+process.report.directory = tmpdir.path;
+
+(async () => {
+  {
+    // The report has the same sections as the one that writeReport() writes.
+    const promise = process.report.writeReportAsync(new Error('test error'));
+    assert(promise instanceof Promise);
+    const file = await promise;
+    const reports = helper.findReports(process.pid, tmpdir.path);
+    assert.deepStrictEqual(reports, [path.join(tmpdir.path, file)]);
+    helper.validate(reports[0], [['header.trigger', 'API']]);
+    const report = JSON.parse(fs.readFileSync(reports[0], 'utf8'));
+    assert.strictEqual(report.javascriptStack.message, 'Error: test error');
+    fs.unlinkSync(reports[0]);
+  }
+
+  {
+    // The JavaScript stack is taken when the report is triggered.
+    let promise;
+    function triggerReport() {
+      promise = process.report.writeReportAsync('custom-name-1.json');
+    }
+    triggerReport();
+    assert.strictEqual(await promise, 'custom-name-1.json');
+    const absolutePath = path.join(tmpdir.path, 'custom-name-1.json');
+    helper.validate(absolutePath);
+    const report = JSON.parse(fs.readFileSync(absolutePath, 'utf8'));
+    assert(report.javascriptStack.stack.some((frame) => {
+      return frame.includes('triggerReport');
+    }), report.javascriptStack.stack);
+    fs.unlinkSync(absolutePath);
+  }
+
+  {
+    // Compact reports are written on one line.
+    process.report.compact = true;
+    const file = await process.report.writeReportAsync('custom-name-2.json');
+    helper.validate(path.join(tmpdir.path, file));
+    process.report.compact = false;
+  }
+
+  {
+    // The filename is empty if the report cannot be written.
+    process.report.directory = path.join(tmpdir.path, 'missing');
+    assert.strictEqual(
+      await process.report.writeReportAsync('custom-name-3.json'), '');
+    process.report.directory = tmpdir.path;
+  }
+
+  [1, false, Symbol()].forEach((file) => {
+    assert.throws(() => process.report.writeReportAsync(file), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+  });
+})().then(common.mustCall());
@@ -59,6 +59,7 @@ const { getSystemErrorName } = require('util');
     delete providers.VERIFYREQUEST;
     delete providers.HASHREQUEST;
     delete providers.HTTPCLIENTREQUEST;
+    delete providers.IOTHREADSTREAM;
     delete providers.HTTPINCOMINGMESSAGE;
     delete providers.ELDHISTOGRAM;
     delete providers.SIGINTWATCHDOG;
@@ -0,0 +1,67 @@
+'use strict';
+
+// This tests that --cpu-prof-window writes a CPU profile for every window,
+// and that v8.takeCpuProfile() ends the current one on demand.
+
+const common = require('../common');
+common.skipIfInspectorDisabled();
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+const tmpdir = require('../common/tmpdir');
+const { kCpuProfInterval, env } = require('../common/cpu-prof');
+
+// Without --cpu-prof, there is no profile to take.
+assert.strictEqual(require('v8').takeCpuProfile(), undefined);
+
+const code = `
+  const v8 = require('v8');
+  const profile = JSON.parse(v8.takeCpuProfile());
+  if (!Array.isArray(profile.nodes) || !Array.isArray(profile.samples))
+    throw new Error('invalid profile');
+  const end = Date.now() + 2500;
+  const timer = setInterval(() => {
+    if (Date.now() > end) clearInterval(timer);
+  }, 10);
+`;
+
+{
+  tmpdir.refresh();
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof',
+    '--cpu-prof-interval',
+    kCpuProfInterval,
+    '--cpu-prof-window',
+    '1',
+    '--cpu-prof-name',
+    'test.cpuprofile',
+    '-e', code,
+  ], {
+    cwd: tmpdir.path,
+    env
+  });
+  if (output.status !== 0) {
+    console.log(output.stderr.toString());
+  }
+  assert.strictEqual(output.status, 0);
+  // The profile taken on demand, at least two windows, and the last one.
+  const names = fs.readdirSync(tmpdir.path);
+  assert(names.length >= 4, names.join());
+  for (let i = 1; i <= names.length; i++)
+    assert(names.includes(`test.cpuprofile.${i}`), names.join());
+  const last = path.join(tmpdir.path, `test.cpuprofile.${names.length}`);
+  assert(Array.isArray(JSON.parse(fs.readFileSync(last)).nodes));
+}
+
+// --cpu-prof-window must be used with --cpu-prof.
+{
+  const output = spawnSync(process.execPath, [
+    '--cpu-prof-window', '1', '-e', '0',
+  ], { env });
+  assert.strictEqual(output.status, 9);
+  assert(output.stderr.toString().includes(
+    '--cpu-prof-window must be used with --cpu-prof'));
+}
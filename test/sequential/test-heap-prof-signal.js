@@ -0,0 +1,28 @@
+'use strict';
+const common = require('../common');
+if (common.isWindows)
+  common.skip('test not supported on Windows');
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawn } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const child = spawn(process.execPath, [
+  '--heap-prof-signal=SIGUSR2',
+  '-e',
+  'process.kill(process.pid, "SIGUSR2"); setTimeout(() => {}, 100);',
+], { cwd: tmpdir.path });
+
+child.on('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+  const files = fs.readdirSync(tmpdir.path)
+    .filter((file) => file.endsWith('.heapprofile'));
+  assert.strictEqual(files.length, 1);
+  const { head } =
+    JSON.parse(fs.readFileSync(path.join(tmpdir.path, files[0]), 'utf8'));
+  assert.strictEqual(head.callFrame.functionName, '(root)');
+}));
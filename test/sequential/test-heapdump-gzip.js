@@ -0,0 +1,33 @@
+'use strict';
+require('../common');
+
+const assert = require('assert');
+const { writeHeapSnapshot } = require('v8');
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+process.chdir(tmpdir.path);
+
+{
+  const file = writeHeapSnapshot(undefined, { gzip: true });
+  assert.match(file, /\.heapsnapshot\.gz$/);
+  const snapshot = JSON.parse(zlib.gunzipSync(fs.readFileSync(file)));
+  assert(snapshot.snapshot.node_count > 0);
+}
+
+{
+  const file = path.join(tmpdir.path, 'my.heapsnapshot');
+  assert.strictEqual(writeHeapSnapshot(file, { gzip: false }), file);
+  const snapshot = JSON.parse(fs.readFileSync(file));
+  assert(snapshot.snapshot.node_count > 0);
+}
+
+[1, true, null].forEach((options) => {
+  assert.throws(() => writeHeapSnapshot(undefined, options),
+                { code: 'ERR_INVALID_ARG_TYPE' });
+});
+assert.throws(() => writeHeapSnapshot(undefined, { gzip: 1 }),
+              { code: 'ERR_INVALID_ARG_TYPE' });
@@ -49,10 +49,26 @@ checkNodeTiming({
   v8Start: { around: 0 },
   bootstrapComplete: { around: inited, delay: 2500 },
   environment: { around: 0 },
+  contextReady: { around: 0, delay: 2500 },
+  internalBootstrapComplete: { around: 0, delay: 2500 },
+  mainModuleLoaded: -1,
   loopStart: -1,
   loopExit: -1
 });
 
+// The startup milestones are in order.
+{
+  const {
+    v8Start,
+    contextReady,
+    internalBootstrapComplete,
+    bootstrapComplete,
+  } = performance.nodeTiming;
+  assert(v8Start <= contextReady);
+  assert(contextReady <= internalBootstrapComplete);
+  assert(internalBootstrapComplete <= bootstrapComplete);
+}
+
 setTimeout(() => {
   checkNodeTiming({
     name: 'node',
@@ -63,6 +79,7 @@ setTimeout(() => {
     v8Start: { around: 0 },
     bootstrapComplete: { around: inited, delay: 2500 },
     environment: { around: 0 },
+    mainModuleLoaded: { around: inited, delay: 2500 },
     loopStart: { around: inited, delay: 2500 },
     loopExit: -1
   });
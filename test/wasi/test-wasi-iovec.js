@@ -0,0 +1,83 @@
+// Flags: --experimental-wasi-unstable-preview1
+'use strict';
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const { closeSync, openSync, readFileSync, writeFileSync } = require('fs');
+const { join } = require('path');
+const { WASI } = require('wasi');
+
+const ESUCCESS = 0;
+const EOVERFLOW = 61;
+const kPageSize = 64 * 1024;
+
+tmpdir.refresh();
+const stdinFile = join(tmpdir.path, 'stdin.txt');
+const stdoutFile = join(tmpdir.path, 'stdout.txt');
+writeFileSync(stdinFile, 'abcdefghij');
+
+const stdin = openSync(stdinFile, 'r');
+const stdout = openSync(stdoutFile, 'w');
+const wasi = new WASI({ stdin, stdout });
+const memory = new WebAssembly.Memory({ initial: 1 });
+wasi.initialize({ exports: { memory } });
+const { fd_read, fd_write } = wasi.wasiImport;
+
+// Writes the iovecs for the [offset, length] pairs at `ptr`.
+function writeIovecs(ptr, iovecs) {
+  const view = new DataView(memory.buffer);
+  iovecs.forEach(([offset, length], i) => {
+    view.setUint32(ptr + i * 8, offset, true);
+    view.setUint32(ptr + i * 8 + 4, length, true);
+  });
+}
+
+function readSize(ptr) {
+  return new DataView(memory.buffer).getUint32(ptr, true);
+}
+
+{
+  // Many iovecs are written with a single call.
+  const bytes = new Uint8Array(memory.buffer);
+  const iovecs = [];
+  for (let i = 0; i < 40; i++) {
+    bytes[1000 + i] = 'a'.charCodeAt(0) + (i % 26);
+    iovecs.push([1000 + i, 1]);
+  }
+  writeIovecs(0, iovecs);
+  assert.strictEqual(fd_write(1, 0, iovecs.length, 512), ESUCCESS);
+  assert.strictEqual(readSize(512), 40);
+}
+
+{
+  // The memory can grow between the calls.
+  memory.grow(1);
+  const bytes = new Uint8Array(memory.buffer);
+  bytes.set(Buffer.from('grown'), kPageSize + 100);
+  writeIovecs(kPageSize, [[kPageSize + 100, 5]]);
+  assert.strictEqual(fd_write(1, kPageSize, 1, kPageSize + 8), ESUCCESS);
+  assert.strictEqual(readSize(kPageSize + 8), 5);
+
+  writeIovecs(kPageSize, [[kPageSize + 200, 4], [kPageSize + 300, 100]]);
+  assert.strictEqual(fd_read(0, kPageSize, 2, kPageSize + 16), ESUCCESS);
+  assert.strictEqual(readSize(kPageSize + 16), 10);
+  assert.strictEqual(
+    Buffer.from(memory.buffer, kPageSize + 200, 4).toString(), 'abcd');
+  assert.strictEqual(
+    Buffer.from(memory.buffer, kPageSize + 300, 6).toString(), 'efghij');
+}
+
+{
+  // The iovecs must be within the memory, whatever their number.
+  const size = memory.buffer.byteLength;
+  assert.strictEqual(fd_write(1, 0, 0x20000001, 512), EOVERFLOW);
+  assert.strictEqual(fd_write(1, size - 8, 2, 512), EOVERFLOW);
+  writeIovecs(0, [[size - 4, 5]]);
+  assert.strictEqual(fd_write(1, 0, 1, 512), EOVERFLOW);
+  assert.strictEqual(fd_read(0, 0, 1, size), EOVERFLOW);
+}
+
+closeSync(stdin);
+closeSync(stdout);
+assert.strictEqual(readFileSync(stdoutFile, 'utf8'),
+                   'abcdefghijklmnopqrstuvwxyzabcdefghijklmngrown');
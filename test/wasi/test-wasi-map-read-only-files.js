@@ -0,0 +1,82 @@
+// Flags: --experimental-wasi-unstable-preview1
+'use strict';
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const { writeFileSync } = require('fs');
+const { join } = require('path');
+const { WASI } = require('wasi');
+
+const ESUCCESS = 0;
+const ENOTCAPABLE = 76;
+const RIGHT_FD_READ = 1n << 1n;
+const RIGHT_FD_SEEK = 1n << 2n;
+const RIGHT_FD_WRITE = 1n << 6n;
+
+tmpdir.refresh();
+const contents = 'x'.repeat(5000) + 'the end';
+writeFileSync(join(tmpdir.path, 'file.txt'), contents);
+writeFileSync(join(tmpdir.path, 'empty.txt'), '');
+
+for (const mapReadOnlyFiles of [false, true]) {
+  const wasi = new WASI({
+    preopens: { '/sandbox': tmpdir.path },
+    mapReadOnlyFiles,
+  });
+  const memory = new WebAssembly.Memory({ initial: 1 });
+  wasi.initialize({ exports: { memory } });
+  const { fd_close, fd_fdstat_set_rights, fd_pread, path_open } =
+    wasi.wasiImport;
+  const view = new DataView(memory.buffer);
+
+  function open(path, rights) {
+    Buffer.from(memory.buffer).write(path, 0);
+    assert.strictEqual(path_open(3, 0, 0, path.length, 0, rights, 0n, 0, 100),
+                       ESUCCESS);
+    return view.getUint32(100, true);
+  }
+
+  // Reads into iovecs of the given lengths at 1024, 2048, ..., and returns
+  // what was read.
+  function pread(fd, lengths, offset) {
+    lengths.forEach((length, i) => {
+      view.setUint32(200 + i * 8, 1024 * (i + 1), true);
+      view.setUint32(200 + i * 8 + 4, length, true);
+    });
+    const err = fd_pread(fd, 200, lengths.length, offset, 300);
+    if (err !== ESUCCESS)
+      return err;
+    let nread = view.getUint32(300, true);
+    let result = '';
+    lengths.forEach((length, i) => {
+      const n = Math.min(nread, length);
+      result += Buffer.from(memory.buffer, 1024 * (i + 1), n).toString();
+      nread -= n;
+    });
+    return result;
+  }
+
+  for (const rights of [RIGHT_FD_READ | RIGHT_FD_SEEK,
+                        RIGHT_FD_READ | RIGHT_FD_SEEK | RIGHT_FD_WRITE]) {
+    const fd = open('file.txt', rights);
+    assert.strictEqual(pread(fd, [3], 0n), 'xxx');
+    assert.strictEqual(pread(fd, [4, 100], 4998n), 'xxthe end');
+    assert.strictEqual(pread(fd, [10], 5007n), '');
+    assert.strictEqual(pread(fd, [10], 1n << 40n), '');
+    assert.strictEqual(fd_close(fd), ESUCCESS);
+  }
+
+  const empty = open('empty.txt', RIGHT_FD_READ | RIGHT_FD_SEEK);
+  assert.strictEqual(pread(empty, [10], 0n), '');
+
+  // The rights are still enforced once they are dropped.
+  const fd = open('file.txt', RIGHT_FD_READ | RIGHT_FD_SEEK);
+  assert.strictEqual(fd_fdstat_set_rights(fd, RIGHT_FD_SEEK, 0n), ESUCCESS);
+  assert.strictEqual(pread(fd, [3], 0n), ENOTCAPABLE);
+  assert.strictEqual(fd_close(fd), ESUCCESS);
+  assert.notStrictEqual(fd_pread(fd, 200, 1, 0n, 300), ESUCCESS);
+}
+
+assert.throws(() => new WASI({ mapReadOnlyFiles: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});